@@ -14,6 +14,7 @@ class LotroLauncher(ConanFile):
 
     def build_requirements(self):
         self.test_requires("gtest/1.14.0")
+        self.test_requires("benchmark/1.8.3")
 
     def layout(self):
         cmake_layout(self)
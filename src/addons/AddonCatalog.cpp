@@ -0,0 +1,355 @@
+/**
+ * LOTRO Launcher - Addon Catalog Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "AddonCatalog.hpp"
+#include "core/platform/Platform.hpp"
+#include "network/HttpClient.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace lotro {
+
+namespace {
+
+QString typeName(AddonType type) {
+    switch (type) {
+        case AddonType::Plugin: return "plugins";
+        case AddonType::Skin: return "skins";
+        case AddonType::Music: return "music";
+    }
+    return "unknown";
+}
+
+// Lowercased words of a string, split on anything but letters and digits
+std::vector<QString> tokenize(const QString& text) {
+    std::vector<QString> tokens;
+    QString current;
+    for (const QChar c : text) {
+        if (c.isLetterOrNumber()) {
+            current += c.toLower();
+        } else if (!current.isEmpty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.isEmpty()) {
+        tokens.push_back(std::move(current));
+    }
+    return tokens;
+}
+
+// Append unless it's already the last entry; postings are built in order
+void addPosting(std::vector<uint32_t>& postings, uint32_t index) {
+    if (postings.empty() || postings.back() != index) {
+        postings.push_back(index);
+    }
+}
+
+std::vector<uint32_t> intersect(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    std::vector<uint32_t> result;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+void write(QDataStream& out, const RemoteAddonInfo& addon) {
+    out << addon.interfaceId << addon.name << addon.category << addon.version
+        << addon.author << addon.latestRelease << addon.downloadUrl << addon.infoUrl
+        << qint32(addon.downloads) << qint32(addon.favourites) << addon.fileSize;
+}
+
+void read(QDataStream& in, RemoteAddonInfo& addon) {
+    qint32 downloads = 0, favourites = 0;
+    in >> addon.interfaceId >> addon.name >> addon.category >> addon.version
+       >> addon.author >> addon.latestRelease >> addon.downloadUrl >> addon.infoUrl
+       >> downloads >> favourites >> addon.fileSize;
+    addon.downloads = downloads;
+    addon.favourites = favourites;
+}
+
+} // namespace
+
+AddonCatalog& AddonCatalog::shared() {
+    static AddonCatalog catalog;
+    return catalog;
+}
+
+AddonCatalog::Index& AddonCatalog::indexFor(AddonType type) {
+    switch (type) {
+        case AddonType::Skin: return m_skins;
+        case AddonType::Music: return m_music;
+        case AddonType::Plugin: break;
+    }
+    return m_plugins;
+}
+
+const AddonCatalog::Index& AddonCatalog::indexFor(AddonType type) const {
+    return const_cast<AddonCatalog*>(this)->indexFor(type);
+}
+
+bool AddonCatalog::refresh(AddonType type, bool force) {
+    QMutexLocker refreshLock(&m_refreshMutex);
+    
+    bool loaded = false;
+    qint64 refreshedAt = 0;
+    size_t count = 0;
+    {
+        QReadLocker lock(&m_lock);
+        const Index& index = indexFor(type);
+        loaded = index.loaded;
+        refreshedAt = index.refreshedAt;
+        count = index.addons.size();
+    }
+    
+    if (!loaded) {
+        Index stored;
+        load(type, stored);
+        stored.loaded = true;
+        refreshedAt = stored.refreshedAt;
+        count = stored.addons.size();
+        QWriteLocker lock(&m_lock);
+        indexFor(type) = std::move(stored);
+    }
+    
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (!force && count > 0 && now - refreshedAt < MAX_AGE_MS) {
+        return true;
+    }
+    
+    const HttpResponse reply = LotroInterfaceClient::fetchAddonListXml(type);
+    if (!reply.ok()) {
+        if (count > 0) {
+            spdlog::info("Using the stored {} catalog", typeName(type).toStdString());
+        }
+        return count > 0;
+    }
+    
+    if (reply.fromCache && count > 0) {
+        spdlog::debug("The {} catalog is unchanged", typeName(type).toStdString());
+        {
+            QWriteLocker lock(&m_lock);
+            indexFor(type).refreshedAt = now;
+        }
+        QReadLocker lock(&m_lock);
+        save(type, indexFor(type));
+        return true;
+    }
+    
+    auto addons = LotroInterfaceClient::parseAddonList(reply.body, type);
+    if (addons.empty()) {
+        spdlog::warn("The {} list came back empty, keeping the stored catalog",
+                     typeName(type).toStdString());
+        return count > 0;
+    }
+    
+    Index fresh;
+    build(fresh, std::move(addons));
+    fresh.refreshedAt = now;
+    fresh.loaded = true;
+    spdlog::info("Indexed {} {} for search", fresh.addons.size(), typeName(type).toStdString());
+    
+    {
+        QWriteLocker lock(&m_lock);
+        indexFor(type) = std::move(fresh);
+    }
+    // Writers only run under the refresh mutex, so readers can share the save
+    QReadLocker lock(&m_lock);
+    save(type, indexFor(type));
+    return true;
+}
+
+std::vector<RemoteAddonInfo> AddonCatalog::all(AddonType type) const {
+    QReadLocker lock(&m_lock);
+    return indexFor(type).addons;
+}
+
+std::optional<RemoteAddonInfo> AddonCatalog::find(AddonType type, const QString& id) const {
+    QReadLocker lock(&m_lock);
+    const Index& index = indexFor(type);
+    auto it = index.byId.constFind(id);
+    if (it == index.byId.constEnd()) {
+        return std::nullopt;
+    }
+    return index.addons[*it];
+}
+
+std::vector<RemoteAddonInfo> AddonCatalog::search(AddonType type, const QString& query) const {
+    const auto words = tokenize(query);
+    
+    QReadLocker lock(&m_lock);
+    const Index& index = indexFor(type);
+    if (words.empty()) {
+        return index.addons;
+    }
+    
+    std::vector<uint32_t> matches;
+    bool first = true;
+    for (const auto& word : words) {
+        std::vector<uint32_t> candidates;
+        if (word.size() >= 3) {
+            // Every trigram of the word narrows the candidates; the
+            // substring check then drops trigrams that only co-occur
+            bool seeded = false;
+            for (qsizetype i = 0; i + 3 <= word.size(); ++i) {
+                auto it = index.trigrams.constFind(word.mid(i, 3));
+                if (it == index.trigrams.constEnd()) {
+                    candidates.clear();
+                    break;
+                }
+                candidates = seeded ? intersect(candidates, *it) : *it;
+                seeded = true;
+                if (candidates.empty()) {
+                    break;
+                }
+            }
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                            [&](uint32_t i) { return !index.haystacks[i].contains(word); }),
+                             candidates.end());
+        } else {
+            // Too short for trigrams, so match as a word prefix
+            for (auto it = index.tokens.lower_bound(word);
+                 it != index.tokens.end() && it->first.startsWith(word); ++it) {
+                std::vector<uint32_t> merged;
+                std::set_union(candidates.begin(), candidates.end(), it->second.begin(), it->second.end(),
+                               std::back_inserter(merged));
+                candidates = std::move(merged);
+            }
+        }
+        
+        matches = first ? std::move(candidates) : intersect(matches, candidates);
+        first = false;
+        if (matches.empty()) {
+            return {};
+        }
+    }
+    
+    const QString phrase = query.trimmed().toLower();
+    auto rank = [&](uint32_t i) {
+        const QString name = index.addons[i].name.toLower();
+        return name.startsWith(phrase) ? 0 : name.contains(phrase) ? 1 : 2;
+    };
+    std::vector<std::pair<int, uint32_t>> ranked;
+    ranked.reserve(matches.size());
+    for (uint32_t i : matches) {
+        ranked.emplace_back(rank(i), i);
+    }
+    std::sort(ranked.begin(), ranked.end(), [&](const auto& a, const auto& b) {
+        if (a.first != b.first) {
+            return a.first < b.first;
+        }
+        return index.addons[a.second].downloads > index.addons[b.second].downloads;
+    });
+    
+    std::vector<RemoteAddonInfo> result;
+    result.reserve(ranked.size());
+    for (const auto& [score, i] : ranked) {
+        result.push_back(index.addons[i]);
+    }
+    return result;
+}
+
+void AddonCatalog::build(Index& index, std::vector<RemoteAddonInfo> addons) {
+    index.addons = std::move(addons);
+    index.haystacks.clear();
+    index.byId.clear();
+    index.tokens.clear();
+    index.trigrams.clear();
+    index.haystacks.reserve(index.addons.size());
+    index.byId.reserve(static_cast<qsizetype>(index.addons.size()));
+    
+    for (uint32_t i = 0; i < index.addons.size(); ++i) {
+        const auto& addon = index.addons[i];
+        index.byId.insert(addon.interfaceId, i);
+        
+        const auto words = tokenize(addon.name + ' ' + addon.author + ' ' + addon.category);
+        QString haystack;
+        for (const auto& word : words) {
+            haystack += word + ' ';
+            addPosting(index.tokens[word], i);
+            for (qsizetype j = 0; j + 3 <= word.size(); ++j) {
+                addPosting(index.trigrams[word.mid(j, 3)], i);
+            }
+        }
+        index.haystacks.push_back(std::move(haystack));
+    }
+}
+
+QString AddonCatalog::filePath(AddonType type) {
+    const QString directory = QString::fromStdString((Platform::getCachePath() / "addons").string());
+    return QDir(directory).filePath(typeName(type) + ".catalog");
+}
+
+bool AddonCatalog::load(AddonType type, Index& index) const {
+    const QString path = filePath(type);
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("Addon catalog {} is outdated, ignoring it", path.toStdString());
+        return false;
+    }
+    
+    qint64 refreshedAt = 0;
+    quint32 count = 0;
+    in >> refreshedAt >> count;
+    std::vector<RemoteAddonInfo> addons;
+    addons.reserve(std::min<quint32>(count, 100000));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        auto& addon = addons.emplace_back();
+        addon.type = type;
+        read(in, addon);
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Addon catalog {} is corrupt, ignoring it", path.toStdString());
+        return false;
+    }
+    
+    build(index, std::move(addons));
+    index.refreshedAt = refreshedAt;
+    spdlog::debug("Loaded {} {} from the catalog", index.addons.size(), typeName(type).toStdString());
+    return true;
+}
+
+void AddonCatalog::save(AddonType type, const Index& index) const {
+    const QString path = filePath(type);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write addon catalog {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << index.refreshedAt << quint32(index.addons.size());
+    for (const auto& addon : index.addons) {
+        write(out, addon);
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit addon catalog {}", path.toStdString());
+    }
+}
+
+} // namespace lotro
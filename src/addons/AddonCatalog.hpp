@@ -0,0 +1,93 @@
+/**
+ * LOTRO Launcher - Addon Catalog
+ * 
+ * Local, searchable copy of the lotrointerface.com addon lists.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "network/LotroInterfaceClient.hpp"
+
+#include <QHash>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QString>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Remote addons of every type, indexed for lookup and search
+ * 
+ * Each type's list is kept on disk and loaded by its first refresh(). refresh()
+ * revalidates it with a conditional request at most every MAX_AGE_MS;
+ * the list is only parsed and reindexed when it actually changed, so
+ * most refreshes cost one 304 or nothing at all.
+ * 
+ * find() is a hash lookup by interface ID. search() matches every word
+ * of the query against the name, author and category: whole words and
+ * word prefixes through a token index, and substrings of three or more
+ * characters through a trigram index whose candidates are then checked.
+ * Safe to use from any thread.
+ */
+class AddonCatalog {
+public:
+    static AddonCatalog& shared();
+    
+    /**
+     * Bring a type's list up to date, blocking on the network if needed
+     * 
+     * @param force Revalidate even if refreshed within MAX_AGE_MS
+     * @return false if there is no list at all, fresh or stored
+     */
+    bool refresh(AddonType type, bool force = false);
+    
+    std::vector<RemoteAddonInfo> all(AddonType type) const;
+    std::optional<RemoteAddonInfo> find(AddonType type, const QString& id) const;
+    
+    /**
+     * Addons matching every word of the query, best matches first
+     * 
+     * Names starting with the query come first, then names containing
+     * it, then the rest; ties go to the most downloaded.
+     */
+    std::vector<RemoteAddonInfo> search(AddonType type, const QString& query) const;
+    
+    static constexpr qint64 MAX_AGE_MS = 15 * 60 * 1000;
+    static constexpr quint32 MAGIC = 0x4C414343;    // "LACC"
+    static constexpr quint32 VERSION = 1;
+    
+private:
+    struct Index {
+        std::vector<RemoteAddonInfo> addons;
+        std::vector<QString> haystacks;                 // Lowercased searchable text
+        QHash<QString, uint32_t> byId;
+        std::map<QString, std::vector<uint32_t>> tokens;  // Ordered for prefix scans
+        QHash<QString, std::vector<uint32_t>> trigrams;
+        qint64 refreshedAt = 0;                         // Milliseconds since epoch
+        bool loaded = false;
+    };
+    
+    AddonCatalog() = default;
+    
+    Index& indexFor(AddonType type);
+    const Index& indexFor(AddonType type) const;
+    static void build(Index& index, std::vector<RemoteAddonInfo> addons);
+    static QString filePath(AddonType type);
+    bool load(AddonType type, Index& index) const;
+    void save(AddonType type, const Index& index) const;
+    
+    QMutex m_refreshMutex;              // One refresh at a time; later callers find it done
+    mutable QReadWriteLock m_lock;
+    Index m_plugins;
+    Index m_skins;
+    Index m_music;
+};
+
+} // namespace lotro
@@ -0,0 +1,137 @@
+/**
+ * LOTRO Launcher - Addon Install Transaction Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "AddonInstallTransaction.hpp"
+
+#include <QTemporaryDir>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro {
+
+AddonInstallTransaction::AddonInstallTransaction(const std::filesystem::path& addonDir)
+    : m_addonDir(addonDir)
+{
+    // Beside the addon directory, not in it, so scans never see half an install
+    const auto templatePath = addonDir.parent_path() / ".addon-install-XXXXXX";
+    m_root = std::make_unique<QTemporaryDir>(QString::fromStdString(templatePath.string()));
+    if (!m_root->isValid()) {
+        spdlog::error("Can't create addon staging directory: {}", m_root->errorString().toStdString());
+    }
+}
+
+AddonInstallTransaction::~AddonInstallTransaction() = default;
+
+bool AddonInstallTransaction::isValid() const {
+    return m_root->isValid();
+}
+
+std::filesystem::path AddonInstallTransaction::stage(int id) const {
+    const auto path = std::filesystem::path(m_root->path().toStdString()) / "staged" / std::to_string(id);
+    std::error_code error;
+    std::filesystem::create_directories(path, error);
+    if (error) {
+        spdlog::error("Can't create {}: {}", path.string(), error.message());
+    }
+    return path;
+}
+
+bool AddonInstallTransaction::commit(const std::vector<std::filesystem::path>& stagedInOrder) {
+    for (const auto& staged : stagedInOrder) {
+        if (!moveInto(staged)) {
+            rollback();
+            return false;
+        }
+    }
+    spdlog::info("Committed {} addon files to {}", m_moves.size(), m_addonDir.string());
+    return true;
+}
+
+bool AddonInstallTransaction::moveInto(const std::filesystem::path& staged) {
+    const auto backups = std::filesystem::path(m_root->path().toStdString()) / "replaced";
+    std::error_code error;
+    
+    // List first; files are moved out from under the iterator otherwise
+    std::vector<std::filesystem::path> files;
+    for (auto it = std::filesystem::recursive_directory_iterator(staged, error);
+         !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (!it->is_directory()) {
+            files.push_back(it->path());
+        }
+    }
+    if (error) {
+        spdlog::error("Can't read staged addon {}: {}", staged.string(), error.message());
+        return false;
+    }
+    
+    for (const auto& file : files) {
+        const auto target = m_addonDir / file.lexically_relative(staged);
+        
+        // Note each directory this creates so a rollback can remove it
+        for (auto parent = target.parent_path(); !std::filesystem::exists(parent);
+             parent = parent.parent_path()) {
+            m_createdDirs.push_back(parent);
+        }
+        std::filesystem::create_directories(target.parent_path(), error);
+        if (error) {
+            spdlog::error("Can't create {}: {}", target.parent_path().string(), error.message());
+            return false;
+        }
+        
+        Move move{target, {}};
+        if (std::filesystem::exists(target)) {
+            move.backup = backups / std::to_string(m_moves.size());
+            std::filesystem::create_directories(backups, error);
+            std::filesystem::rename(target, move.backup, error);
+            if (error) {
+                spdlog::error("Can't set aside {}: {}", target.string(), error.message());
+                return false;
+            }
+        }
+        std::filesystem::rename(file, target, error);
+        if (error) {
+            spdlog::error("Can't move {} into place: {}", target.string(), error.message());
+            if (!move.backup.empty()) {
+                std::error_code restoreError;
+                std::filesystem::rename(move.backup, target, restoreError);
+            }
+            return false;
+        }
+        m_moves.push_back(std::move(move));
+    }
+    return true;
+}
+
+void AddonInstallTransaction::rollback() {
+    std::error_code error;
+    for (auto it = m_moves.rbegin(); it != m_moves.rend(); ++it) {
+        std::filesystem::remove(it->target, error);
+        if (!it->backup.empty()) {
+            std::filesystem::rename(it->backup, it->target, error);
+            if (error) {
+                spdlog::error("Can't restore {}: {}", it->target.string(), error.message());
+            }
+        }
+    }
+    
+    // Deepest first; a directory something else wrote into stays
+    std::sort(m_createdDirs.begin(), m_createdDirs.end(), [](const auto& a, const auto& b) {
+        return a.string().size() > b.string().size();
+    });
+    for (const auto& directory : m_createdDirs) {
+        std::filesystem::remove(directory, error);
+    }
+    
+    if (!m_moves.empty()) {
+        spdlog::info("Rolled back {} addon files in {}", m_moves.size(), m_addonDir.string());
+    }
+    m_moves.clear();
+    m_createdDirs.clear();
+}
+
+} // namespace lotro
@@ -0,0 +1,78 @@
+/**
+ * LOTRO Launcher - Addon Install Transaction
+ * 
+ * Installs several addons into an addon directory as one unit.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <QString>
+
+class QTemporaryDir;
+
+namespace lotro {
+
+/**
+ * Files moved into an addon directory all together or not at all
+ * 
+ * stage() hands out an empty directory to extract one addon into. It
+ * sits next to the addon directory, so committing is a rename per file
+ * rather than a copy, and it is hidden from addon scans meanwhile.
+ * commit() moves the staged files into place, addon by addon in the
+ * order given, setting aside every file they replace. If a move fails,
+ * or rollback() is called after a commit, the moved files are taken out
+ * again, the set-aside ones restored and any directories created
+ * removed. Addons share folders such as an author's, so this works per
+ * file, never by swapping whole directories. The staging area is
+ * deleted with the transaction.
+ */
+class AddonInstallTransaction {
+public:
+    explicit AddonInstallTransaction(const std::filesystem::path& addonDir);
+    ~AddonInstallTransaction();
+    
+    AddonInstallTransaction(const AddonInstallTransaction&) = delete;
+    AddonInstallTransaction& operator=(const AddonInstallTransaction&) = delete;
+    
+    bool isValid() const;
+    
+    /**
+     * A new, empty directory to extract one addon into
+     * 
+     * Safe to call from several threads at once.
+     */
+    std::filesystem::path stage(int id) const;
+    
+    /**
+     * Move staged directories into the addon directory in order
+     * 
+     * @return false if anything failed; nothing is left changed then
+     */
+    bool commit(const std::vector<std::filesystem::path>& stagedInOrder);
+    
+    /**
+     * Undo a commit
+     */
+    void rollback();
+    
+private:
+    struct Move {
+        std::filesystem::path target;
+        std::filesystem::path backup;   // Empty if nothing was replaced
+    };
+    
+    bool moveInto(const std::filesystem::path& staged);
+    
+    std::filesystem::path m_addonDir;
+    std::unique_ptr<QTemporaryDir> m_root;
+    std::vector<Move> m_moves;
+    std::vector<std::filesystem::path> m_createdDirs;
+};
+
+} // namespace lotro
@@ -5,17 +5,31 @@
  */
 
 #include "AddonManager.hpp"
+#include "AddonCatalog.hpp"
+#include "AddonInstallTransaction.hpp"
 #include "CompendiumParser.hpp"
+#include "InstalledAddonIndex.hpp"
+#include "ZipArchive.hpp"
 #include "network/LotroInterfaceClient.hpp"
-
-#include <QDir>
-#include <QProcess>
+#include "core/TaskScheduler.hpp"
+
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QRegularExpression>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
 #include <QtConcurrent>
 
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <functional>
+#include <set>
 
 namespace lotro {
 
@@ -47,120 +61,403 @@ bool isInvalidFolderName(const std::string& name) {
     return false;
 }
 
-// Clean invalid wrapper folders from extracted addon
-// This mimics OneLauncher's clean_temp_addon_folder behavior
-void cleanTempAddonFolder(const std::filesystem::path& addonDir) {
-    while (true) {
-        std::filesystem::path invalidDir;
-        
-        for (const auto& entry : std::filesystem::directory_iterator(addonDir)) {
-            if (entry.is_directory() && 
-                isInvalidFolderName(entry.path().filename().string())) {
-                invalidDir = entry.path();
-                break;
+// Where each archive entry goes under the addon directory
+//
+// Applies OneLauncher's layout fixes to the paths before anything is
+// written: invalid wrapper folders are stripped (clean_temp_addon_folder),
+// and for music and skins, anything but a single top-level folder is
+// wrapped in a folder named after the addon (fix_improper_root_dir).
+// Entries that would land outside the addon directory are skipped.
+std::vector<ZipArchive::Target> addonLayout(
+    const std::vector<ZipEntry>& entries,
+    AddonType type,
+    const QString& addonName
+) {
+    struct Item {
+        size_t entry;
+        QStringList parts;
+        bool isDirectory;
+    };
+    std::vector<Item> items;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const QString& name = entries[i].name;
+        QStringList parts = name.split('/', Qt::SkipEmptyParts);
+        parts.removeAll(".");
+        if (parts.isEmpty()) {
+            continue;
+        }
+        if (name.startsWith('/') || parts.contains("..") || parts.first().contains(':')) {
+            spdlog::warn("Skipping unsafe archive entry: {}", name.toStdString());
+            continue;
+        }
+        items.push_back({i, parts, entries[i].isDirectory()});
+    }
+    
+    // Folders at the top level, sorted so the result doesn't depend on
+    // the order the archive lists them in
+    auto topFolders = [&items]() {
+        std::set<QString> folders;
+        for (const auto& item : items) {
+            if (item.parts.size() > 1 || item.isDirectory) {
+                folders.insert(item.parts.first());
             }
         }
-        
-        if (invalidDir.empty()) {
+        return folders;
+    };
+    
+    while (true) {
+        const auto folders = topFolders();
+        auto invalid = std::find_if(folders.begin(), folders.end(), [](const QString& folder) {
+            return isInvalidFolderName(folder.toStdString());
+        });
+        if (invalid == folders.end()) {
             break;
         }
         
-        spdlog::info("Removing invalid wrapper folder: {}", invalidDir.filename().string());
-        
-        // Move contents of invalid folder up one level
-        for (const auto& child : std::filesystem::directory_iterator(invalidDir)) {
-            auto dest = addonDir / child.path().filename();
-            try {
-                std::filesystem::rename(child.path(), dest);
-            } catch (const std::exception& e) {
-                // If rename fails (cross-device), copy and delete
-                try {
-                    if (child.is_directory()) {
-                        std::filesystem::copy(child.path(), dest, 
-                            std::filesystem::copy_options::recursive | 
-                            std::filesystem::copy_options::overwrite_existing);
-                    } else {
-                        std::filesystem::copy_file(child.path(), dest,
-                            std::filesystem::copy_options::overwrite_existing);
-                    }
-                } catch (const std::exception& e2) {
-                    spdlog::warn("Failed to move {}: {}", child.path().string(), e2.what());
-                }
+        spdlog::info("Removing invalid wrapper folder: {}", invalid->toStdString());
+        const QString folder = *invalid;
+        for (auto& item : items) {
+            if (item.parts.first() == folder) {
+                item.parts.removeFirst();
+            }
+        }
+        items.erase(std::remove_if(items.begin(), items.end(),
+                                   [](const Item& item) { return item.parts.isEmpty(); }),
+                    items.end());
+    }
+    
+    if ((type == AddonType::Music || type == AddonType::Skin) && !items.empty()) {
+        const bool looseFiles = std::any_of(items.begin(), items.end(), [](const Item& item) {
+            return item.parts.size() == 1 && !item.isDirectory;
+        });
+        if (looseFiles || topFolders().size() != 1) {
+            QString folder = addonName;
+            folder.replace(QRegularExpression(R"([\\/:*?"<>|])"), "_");
+            for (auto& item : items) {
+                item.parts.prepend(folder);
+            }
+            spdlog::info("Wrapped loose files in folder: {}", folder.toStdString());
+        }
+    }
+    
+    std::vector<ZipArchive::Target> targets;
+    targets.reserve(items.size());
+    for (const auto& item : items) {
+        targets.push_back({item.entry, item.parts.join('/').toStdString()});
+    }
+    return targets;
+}
+
+// Extract an addon archive into the addon directory, fixing its layout on the way
+bool extractAddon(
+    const std::filesystem::path& zipPath,
+    const std::filesystem::path& destDir,
+    AddonType type,
+    const QString& addonName
+) {
+    ZipArchive archive;
+    if (!archive.open(zipPath)) {
+        return false;
+    }
+    return archive.extract(addonLayout(archive.entries(), type, addonName), destDir);
+}
+
+/**
+ * Download an addon archive and check it really is one
+ * 
+ * Reports download progress as a percentage.
+ * @return Path of the downloaded archive, empty on failure
+ */
+QString downloadArchive(
+    LotroInterfaceClient& client,
+    const QString& downloadUrl,
+    const QString& addonName,
+    const AddonProgressCallback& progress
+) {
+    if (progress) {
+        progress(0, 1, QString("Downloading %1...").arg(addonName));
+    }
+    
+    // Download the addon
+    // Already on an I/O thread; waiting on another one would hold two
+    QString zipPath = client.downloadAddonFile(downloadUrl,
+        [&progress, &addonName](qint64 received, qint64 total) {
+            if (progress && total > 0) {
+                int percent = static_cast<int>((received * 100) / total);
+                progress(percent, 100, QString("Downloading %1... %2%").arg(addonName).arg(percent));
             }
+        });
+    
+    if (zipPath.isEmpty()) {
+        spdlog::error("Failed to download addon");
+        if (progress) {
+            progress(-1, 100, QString("Download failed for %1").arg(addonName));
         }
+        return {};
+    }
+    
+    // Verify the downloaded file is actually a ZIP
+    // (lotrointerface.com may return HTML error pages)
+    QFile downloadedFile(zipPath);
+    if (downloadedFile.open(QIODevice::ReadOnly)) {
+        QByteArray header = downloadedFile.read(4);
+        downloadedFile.close();
         
-        // Remove the now-empty invalid folder
-        try {
-            std::filesystem::remove_all(invalidDir);
-        } catch (const std::exception& e) {
-            spdlog::warn("Failed to remove invalid folder: {}", e.what());
+        // ZIP files start with "PK\x03\x04" signature
+        if (header.size() < 4 || 
+            header[0] != 'P' || header[1] != 'K' ||
+            header[2] != 0x03 || header[3] != 0x04) {
+            
+            // Not a ZIP - likely an HTML error page
+            QString errorMsg;
+            if (downloadedFile.open(QIODevice::ReadOnly)) {
+                QString content = QString::fromUtf8(downloadedFile.readAll());
+                downloadedFile.close();
+                
+                if (content.contains("not yet been approved", Qt::CaseInsensitive)) {
+                    errorMsg = QString("%1: File not yet approved for download on lotrointerface.com").arg(addonName);
+                } else if (content.contains("file not found", Qt::CaseInsensitive)) {
+                    errorMsg = QString("%1: File not found on lotrointerface.com").arg(addonName);
+                } else {
+                    errorMsg = QString("%1: Download failed - server returned invalid file").arg(addonName);
+                }
+            } else {
+                errorMsg = QString("%1: Download failed - file is not a valid archive").arg(addonName);
+            }
+            
+            spdlog::error("{}", errorMsg.toStdString());
+            if (progress) {
+                progress(-1, 100, errorMsg);
+            }
+            QFile::remove(zipPath);
+            return {};
         }
     }
+    return zipPath;
 }
 
-// Fix improper root directory for music/skins
-// If the extraction contains loose files instead of a single folder,
-// wrap them in a folder with the addon name (like OneLauncher does)
-std::filesystem::path fixImproperRootDir(
-    const std::filesystem::path& tempDir,
-    const std::string& addonName
+/**
+ * Download an addon archive and extract it into the addon directory
+ * 
+ * Reports download progress as a percentage.
+ */
+bool downloadAndInstall(
+    LotroInterfaceClient& client,
+    const QString& downloadUrl,
+    const QString& addonName,
+    AddonType type,
+    const std::filesystem::path& destDir,
+    const AddonProgressCallback& progress
 ) {
-    std::vector<std::filesystem::path> entries;
-    int fileCount = 0;
-    int dirCount = 0;
-    
-    for (const auto& entry : std::filesystem::directory_iterator(tempDir)) {
-        entries.push_back(entry.path());
-        if (entry.is_directory()) {
-            dirCount++;
-        } else {
-            fileCount++;
+    const QString zipPath = downloadArchive(client, downloadUrl, addonName, progress);
+    if (zipPath.isEmpty()) {
+        return false;
+    }
+    
+    if (progress) {
+        progress(100, 100, QString("Installing %1...").arg(addonName));
+    }
+    
+    // Extract straight into place; the layout is fixed as it goes
+    spdlog::info("Extracting addon to: {}", destDir.string());
+    const bool extracted = extractAddon(zipPath.toStdString(), destDir, type, addonName);
+    QFile::remove(zipPath);
+    
+    if (!extracted) {
+        if (progress) {
+            progress(-1, 100, QString("Extraction failed for %1").arg(addonName));
         }
+        return false;
     }
     
-    // If there's exactly one directory and nothing else, use it as root
-    if (dirCount == 1 && fileCount == 0) {
-        return entries[0];
+    spdlog::info("Addon {} installed successfully to {}", addonName.toStdString(), destDir.string());
+    return true;
+}
+
+AddonInfo toAddonInfo(const RemoteAddonInfo& remote, AddonType type) {
+    AddonInfo info;
+    info.id = remote.interfaceId;
+    info.name = remote.name;
+    info.type = type;
+    info.version = remote.version;
+    info.author = remote.author;
+    info.category = remote.category;
+    info.latestVersion = remote.latestRelease;
+    info.downloadUrl = remote.downloadUrl;
+    info.infoUrl = remote.infoUrl;
+    info.status = AddonStatus::NotInstalled;
+    
+    // New metadata fields
+    info.releaseDate = remote.latestRelease;
+    info.downloadCount = remote.downloads;
+    info.fileSize = remote.fileSize;
+    info.favourites = remote.favourites;
+    return info;
+}
+
+/**
+ * Install an addon along with whichever of its dependencies are missing
+ * 
+ * Dependencies are only listed in the compendium files inside the
+ * archives, so the graph is found a level at a time: each wave of addons
+ * is downloaded and extracted into staging in parallel, and the
+ * dependencies their compendiums name that are neither installed nor
+ * already planned make the next wave. Everything is then committed in
+ * dependency order as one transaction, so a failure anywhere leaves the
+ * addon directory as it was. Dependencies not in the catalog are logged
+ * and skipped; the addon may still work without them.
+ */
+bool installWithDependencies(
+    LotroInterfaceClient& client,
+    const RemoteAddonInfo& root,
+    AddonType type,
+    const std::filesystem::path& destDir,
+    const QSet<QString>& installedIds,
+    int maxConcurrent,
+    const AddonProgressCallback& progress
+) {
+    AddonInstallTransaction transaction(destDir);
+    if (!transaction.isValid()) {
+        return false;
     }
     
-    // If there are loose files, wrap everything in a folder with addon name
-    if (fileCount > 0 || dirCount > 1 || dirCount == 0) {
-        auto newRootDir = tempDir / addonName;
-        std::filesystem::create_directories(newRootDir);
-        
-        for (const auto& entry : entries) {
-            auto dest = newRootDir / entry.filename();
-            try {
-                std::filesystem::rename(entry, dest);
-            } catch (const std::exception& e) {
-                // If rename fails, copy and delete
-                try {
-                    if (std::filesystem::is_directory(entry)) {
-                        std::filesystem::copy(entry, dest,
-                            std::filesystem::copy_options::recursive);
-                        std::filesystem::remove_all(entry);
-                    } else {
-                        std::filesystem::copy_file(entry, dest);
-                        std::filesystem::remove(entry);
+    struct Node {
+        RemoteAddonInfo remote;
+        std::filesystem::path staged;
+        std::vector<QString> dependencies;
+        bool ok = false;
+    };
+    std::vector<Node> nodes{{root}};
+    QHash<QString, size_t> byId{{root.interfaceId, 0}};
+    auto& catalog = AddonCatalog::shared();
+    
+    // Workers report through the one callback, so one call at a time
+    QMutex progressMutex;
+    std::atomic<int> finished{0};
+    auto report = [&](int total, const QString& status) {
+        if (progress) {
+            QMutexLocker lock(&progressMutex);
+            progress(finished.load(), total, status);
+        }
+    };
+    
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(1, maxConcurrent));
+    for (size_t waveStart = 0; waveStart < nodes.size();) {
+        // The vector isn't resized until the wave is done, so each worker
+        // can own its node
+        const size_t waveEnd = nodes.size();
+        const int total = static_cast<int>(waveEnd);
+        QList<QFuture<void>> running;
+        for (size_t i = waveStart; i < waveEnd; ++i) {
+            nodes[i].staged = transaction.stage(static_cast<int>(i));
+            running.append(QtConcurrent::run(&pool, [&, i, total]() {
+                Node& node = nodes[i];
+                report(total, QString("Downloading %1...").arg(node.remote.name));
+                const QString zipPath = downloadArchive(client, node.remote.downloadUrl, node.remote.name, nullptr);
+                if (!zipPath.isEmpty()) {
+                    node.ok = extractAddon(zipPath.toStdString(), node.staged, type, node.remote.name);
+                    QFile::remove(zipPath);
+                }
+                if (node.ok) {
+                    const auto files = CompendiumParser::findCompendiumFiles(node.staged);
+                    for (const auto& addon : CompendiumParser::parseAll(files)) {
+                        if (!addon) {
+                            continue;
+                        }
+                        for (const auto& dependency : addon->dependencies) {
+                            if (std::find(node.dependencies.begin(), node.dependencies.end(), dependency) ==
+                                node.dependencies.end()) {
+                                node.dependencies.push_back(dependency);
+                            }
+                        }
                     }
-                } catch (const std::exception& e2) {
-                    spdlog::warn("Failed to move {}: {}", entry.string(), e2.what());
                 }
-            }
+                finished++;
+                report(total, node.ok ? QString("Fetched %1").arg(node.remote.name)
+                                      : QString("Failed to fetch %1").arg(node.remote.name));
+            }));
+        }
+        for (auto& future : running) {
+            future.waitForFinished();
         }
         
-        spdlog::info("Wrapped loose files in folder: {}", addonName);
-        return newRootDir;
+        for (size_t i = waveStart; i < waveEnd; ++i) {
+            if (!nodes[i].ok) {
+                spdlog::error("Failed to fetch {}, installing nothing", nodes[i].remote.name.toStdString());
+                if (progress) {
+                    progress(-1, 100, QString("Failed to install %1: %2 could not be fetched")
+                                          .arg(root.name, nodes[i].remote.name));
+                }
+                return false;
+            }
+            for (const auto& dependency : nodes[i].dependencies) {
+                if (installedIds.contains(dependency) || byId.contains(dependency)) {
+                    continue;
+                }
+                auto remote = catalog.find(type, dependency);
+                if (!remote || remote->downloadUrl.isEmpty()) {
+                    spdlog::warn("Dependency {} of {} is not on lotrointerface.com, skipping it",
+                                 dependency.toStdString(), nodes[i].remote.name.toStdString());
+                    continue;
+                }
+                spdlog::info("{} needs {}", nodes[i].remote.name.toStdString(), remote->name.toStdString());
+                byId.insert(dependency, nodes.size());
+                nodes.push_back({std::move(*remote)});
+            }
+        }
+        waveStart = waveEnd;
+    }
+    
+    // Dependencies before the addons that need them; a cycle is broken
+    // wherever it is found
+    std::vector<std::filesystem::path> order;
+    std::vector<int> state(nodes.size(), 0);    // 0 unvisited, 1 visiting, 2 done
+    std::function<void(size_t)> visit = [&](size_t i) {
+        if (state[i] != 0) {
+            if (state[i] == 1) {
+                spdlog::warn("Dependency cycle through {}", nodes[i].remote.name.toStdString());
+            }
+            return;
+        }
+        state[i] = 1;
+        for (const auto& dependency : nodes[i].dependencies) {
+            auto it = byId.constFind(dependency);
+            if (it != byId.constEnd()) {
+                visit(*it);
+            }
+        }
+        state[i] = 2;
+        order.push_back(nodes[i].staged);
+    };
+    visit(0);
+    
+    if (progress) {
+        progress(100, 100, QString("Installing %1...").arg(root.name));
+    }
+    if (!transaction.commit(order)) {
+        if (progress) {
+            progress(-1, 100, QString("Installation failed for %1").arg(root.name));
+        }
+        return false;
     }
     
-    return tempDir;
+    spdlog::info("Addon {} installed with {} dependencies to {}", root.name.toStdString(),
+                 nodes.size() - 1, destDir.string());
+    return true;
 }
 
 } // anonymous namespace
 
 class AddonManager::Impl {
 public:
+    explicit Impl(const std::filesystem::path& settingsDir)
+        : settingsDir(settingsDir)
+        , index(settingsDir)
+    {}
+    
     std::filesystem::path settingsDir;
+    InstalledAddonIndex index;
     
     std::vector<AddonInfo> installedPlugins;
     std::vector<AddonInfo> installedSkins;
@@ -172,12 +469,18 @@ public:
     std::vector<RemoteAddonInfo> remoteMusic;
     
     LotroInterfaceClient client;
+    
+    int maxConcurrentUpdates = AddonManager::DEFAULT_MAX_CONCURRENT_UPDATES;
+    
+    // Filesystem watching, set up by watchInstalledAddons()
+    std::unique_ptr<QFileSystemWatcher> watcher;
+    std::unique_ptr<QTimer> watchTimer;
+    std::function<void()> onInstalledChanged;
 };
 
 AddonManager::AddonManager(const std::filesystem::path& settingsDir)
-    : m_impl(std::make_unique<Impl>())
+    : m_impl(std::make_unique<Impl>(settingsDir))
 {
-    m_impl->settingsDir = settingsDir;
     
     spdlog::info("=== AddonManager initialized ===");
     spdlog::info("Settings directory: {}", settingsDir.string());
@@ -190,6 +493,7 @@ AddonManager::AddonManager(const std::filesystem::path& settingsDir)
     std::filesystem::create_directories(getAddonDirectory(AddonType::Skin));
     std::filesystem::create_directories(getAddonDirectory(AddonType::Music));
     
+    m_impl->index.load();
     refreshInstalledAddons();
 }
 
@@ -229,41 +533,10 @@ std::optional<AddonInfo> AddonManager::getInstalledAddon(
 }
 
 void AddonManager::refreshInstalledAddons() {
-    m_impl->installedPlugins.clear();
-    m_impl->installedSkins.clear();
-    m_impl->installedMusic.clear();
-    
-    // Scan for compendium files
-    auto pluginFiles = CompendiumParser::findCompendiumFiles(
-        getAddonDirectory(AddonType::Plugin));
-    for (const auto& file : pluginFiles) {
-        if (auto addon = CompendiumParser::parse(file)) {
-            addon->status = AddonStatus::Installed;
-            addon->compendiumFilePath = file;
-            m_impl->installedPlugins.push_back(*addon);
-        }
-    }
-    
-    auto skinFiles = CompendiumParser::findCompendiumFiles(
-        getAddonDirectory(AddonType::Skin));
-    for (const auto& file : skinFiles) {
-        if (auto addon = CompendiumParser::parse(file)) {
-            addon->status = AddonStatus::Installed;
-            addon->compendiumFilePath = file;
-            m_impl->installedSkins.push_back(*addon);
-        }
-    }
-    
-    // Music: scan for compendium files
-    auto musicFiles = CompendiumParser::findCompendiumFiles(
-        getAddonDirectory(AddonType::Music));
-    for (const auto& file : musicFiles) {
-        if (auto addon = CompendiumParser::parse(file)) {
-            addon->status = AddonStatus::Installed;
-            addon->compendiumFilePath = file;
-            m_impl->installedMusic.push_back(*addon);
-        }
-    }
+    // Only compendium files that changed since the last scan are parsed
+    m_impl->installedPlugins = m_impl->index.scan(getAddonDirectory(AddonType::Plugin));
+    m_impl->installedSkins = m_impl->index.scan(getAddonDirectory(AddonType::Skin));
+    m_impl->installedMusic = m_impl->index.scan(getAddonDirectory(AddonType::Music));
     
     // Also scan for music folders without compendium files (like OneLauncher does)
     auto musicDir = getAddonDirectory(AddonType::Music);
@@ -298,6 +571,101 @@ void AddonManager::refreshInstalledAddons() {
                 m_impl->installedPlugins.size(),
                 m_impl->installedSkins.size(),
                 m_impl->installedMusic.size());
+    
+    // Record the startup scripts so a launch needn't scan for them. The
+    // path comes from the plugin's compendium, so it has to resolve to a
+    // file inside the plugins directory
+    std::vector<StartupScript> scripts;
+    std::error_code ec;
+    const auto pluginsDir = std::filesystem::weakly_canonical(getAddonDirectory(AddonType::Plugin), ec);
+    for (const auto& addon : m_impl->installedPlugins) {
+        if (addon.startupScript.isEmpty() || ec) {
+            continue;
+        }
+        QString relative = addon.startupScript;
+        relative.replace('\\', '/');
+        const std::filesystem::path relativePath(relative.toStdString());
+        std::error_code scriptEc;
+        const auto script = std::filesystem::weakly_canonical(pluginsDir / relativePath, scriptEc);
+        const auto inside = script.lexically_relative(pluginsDir);
+        if (relativePath.has_root_path() || scriptEc || inside.empty()
+            || *inside.begin() == ".." || inside == ".") {
+            spdlog::warn("Ignoring startup script outside the plugins directory for {}: {}",
+                         addon.name.toStdString(), addon.startupScript.toStdString());
+            continue;
+        }
+        scripts.push_back({addon.id, addon.name, script, addon.dependencies});
+    }
+    m_impl->index.setStartupScripts(std::move(scripts));
+    
+    m_impl->index.save();
+}
+
+void AddonManager::watchInstalledAddons(std::function<void()> onChanged) {
+    m_impl->onInstalledChanged = std::move(onChanged);
+    if (m_impl->watcher) {
+        return;
+    }
+    
+    // Installs and removals come as bursts of events; refresh once they settle
+    m_impl->watchTimer = std::make_unique<QTimer>();
+    m_impl->watchTimer->setSingleShot(true);
+    m_impl->watchTimer->setInterval(WATCH_DEBOUNCE_MS);
+    QObject::connect(m_impl->watchTimer.get(), &QTimer::timeout, [this]() {
+        refreshInstalledAddons();
+        updateWatchedPaths();
+        if (m_impl->onInstalledChanged) {
+            m_impl->onInstalledChanged();
+        }
+    });
+    
+    m_impl->watcher = std::make_unique<QFileSystemWatcher>();
+    auto schedule = [timer = m_impl->watchTimer.get()]() { timer->start(); };
+    QObject::connect(m_impl->watcher.get(), &QFileSystemWatcher::directoryChanged, schedule);
+    QObject::connect(m_impl->watcher.get(), &QFileSystemWatcher::fileChanged, schedule);
+    updateWatchedPaths();
+}
+
+void AddonManager::updateWatchedPaths() {
+    // inotify isn't recursive, so watch each addon directory, the folders
+    // directly in it, and the compendium files themselves
+    QStringList paths;
+    for (AddonType type : {AddonType::Plugin, AddonType::Skin, AddonType::Music}) {
+        const auto directory = getAddonDirectory(type);
+        paths << QString::fromStdString(directory.string());
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (entry.is_directory(error)) {
+                paths << QString::fromStdString(entry.path().string());
+            }
+        }
+        for (const auto& addon : getInstalledAddons(type)) {
+            if (std::filesystem::is_regular_file(addon.compendiumFilePath, error)) {
+                paths << QString::fromStdString(addon.compendiumFilePath.string());
+            }
+        }
+    }
+    
+    auto* watcher = m_impl->watcher.get();
+    const QStringList watched = watcher->directories() + watcher->files();
+    QStringList stale;
+    for (const auto& path : watched) {
+        if (!paths.contains(path)) {
+            stale << path;
+        }
+    }
+    if (!stale.isEmpty()) {
+        watcher->removePaths(stale);
+    }
+    QStringList added;
+    for (const auto& path : paths) {
+        if (!watched.contains(path)) {
+            added << path;
+        }
+    }
+    if (!added.isEmpty()) {
+        watcher->addPaths(added);
+    }
 }
 bool AddonManager::installFromFile(
     const std::filesystem::path& zipPath,
@@ -307,25 +675,10 @@ bool AddonManager::installFromFile(
     
     spdlog::info("Installing addon from: {}", zipPath.string());
     
-    // Extract zip to destination
-    // Using unzip command for simplicity
-    QProcess process;
-    QStringList args;
-    args << "-o"  // Overwrite
-         << QString::fromStdString(zipPath.string())
-         << "-d"
-         << QString::fromStdString(destDir.string());
-    
-    process.start("unzip", args);
-    
-    if (!process.waitForFinished(60000)) {
-        spdlog::error("Extraction timed out");
-        return false;
-    }
-    
-    if (process.exitCode() != 0) {
-        spdlog::error("Extraction failed: {}", 
-                     process.readAllStandardError().toStdString());
+    // Loose music and skin files go in a folder named after the archive
+    const QString addonName = QString::fromStdString(zipPath.stem().string());
+    if (!extractAddon(zipPath, destDir, type, addonName)) {
+        spdlog::error("Extraction failed: {}", zipPath.string());
         return false;
     }
     
@@ -398,9 +751,15 @@ QFuture<std::vector<AddonInfo>> AddonManager::searchRemoteAddons(
     const QString& query,
     AddonType type
 ) {
-    // TODO: Implement lotrointerface.com search
-    return QtConcurrent::run([]() -> std::vector<AddonInfo> {
-        return {};
+    return TaskScheduler::instance().run(TaskPool::Io, [query, type]() -> std::vector<AddonInfo> {
+        auto& catalog = AddonCatalog::shared();
+        catalog.refresh(type);
+        
+        std::vector<AddonInfo> result;
+        for (const auto& remote : catalog.search(type, query)) {
+            result.push_back(toAddonInfo(remote, type));
+        }
+        return result;
     });
 }
 
@@ -408,42 +767,27 @@ QFuture<std::optional<AddonInfo>> AddonManager::getRemoteAddon(
     const QString& id,
     AddonType type
 ) {
-    // TODO: Implement lotrointerface.com lookup
-    return QtConcurrent::run([]() -> std::optional<AddonInfo> {
-        return std::nullopt;
+    return TaskScheduler::instance().run(TaskPool::Io, [id, type]() -> std::optional<AddonInfo> {
+        auto& catalog = AddonCatalog::shared();
+        catalog.refresh(type);
+        
+        auto remote = catalog.find(type, id);
+        if (!remote) {
+            return std::nullopt;
+        }
+        return toAddonInfo(*remote, type);
     });
 }
 
 QFuture<std::vector<AddonInfo>> AddonManager::fetchRemoteAddonList(AddonType type) {
-    auto* impl = m_impl.get();
-    return QtConcurrent::run([impl, type]() -> std::vector<AddonInfo> {
-        // Fetch from lotrointerface.com
-        auto future = impl->client.fetchAddonList(type);
-        future.waitForFinished();
-        auto remoteAddons = future.result();
+    return TaskScheduler::instance().run(TaskPool::Io, [type]() -> std::vector<AddonInfo> {
+        // Revalidated against lotrointerface.com at most every few minutes
+        auto& catalog = AddonCatalog::shared();
+        catalog.refresh(type);
         
-        // Convert RemoteAddonInfo to AddonInfo
         std::vector<AddonInfo> result;
-        for (const auto& remote : remoteAddons) {
-            AddonInfo info;
-            info.id = remote.interfaceId;
-            info.name = remote.name;
-            info.type = type;
-            info.version = remote.version;
-            info.author = remote.author;
-            info.category = remote.category;
-            info.latestVersion = remote.latestRelease;
-            info.downloadUrl = remote.downloadUrl;
-            info.infoUrl = remote.infoUrl;
-            info.status = AddonStatus::NotInstalled;
-            
-            // New metadata fields
-            info.releaseDate = remote.latestRelease;
-            info.downloadCount = remote.downloads;
-            info.fileSize = remote.fileSize;
-            info.favourites = remote.favourites;
-            
-            result.push_back(info);
+        for (const auto& remote : catalog.all(type)) {
+            result.push_back(toAddonInfo(remote, type));
         }
         
         spdlog::info("Fetched {} remote addons", result.size());
@@ -458,184 +802,25 @@ QFuture<bool> AddonManager::installAddon(
 ) {
     auto* impl = m_impl.get();
     auto destDir = getAddonDirectory(type);
+    QSet<QString> installedIds;
+    for (const auto& addon : getInstalledAddons(type)) {
+        installedIds.insert(addon.id);
+    }
+    const int maxConcurrent = m_impl->maxConcurrentUpdates;
     
-    return QtConcurrent::run([impl, id, type, destDir, progress]() -> bool {
+    return TaskScheduler::instance().run(TaskPool::Io, [impl, id, type, destDir, installedIds, maxConcurrent, progress]() -> bool {
         try {
-            // First, fetch addon list to get download URL
-            auto listFuture = impl->client.fetchAddonList(type);
-            listFuture.waitForFinished();
-            auto remoteAddons = listFuture.result();
-            
-            // Find the addon by ID
-            QString downloadUrl;
-            QString addonName;
-            for (const auto& addon : remoteAddons) {
-                if (addon.interfaceId == id) {
-                    downloadUrl = addon.downloadUrl;
-                    addonName = addon.name;
-                    break;
-                }
-            }
-            
-            if (downloadUrl.isEmpty()) {
+            // Look the download URL up in the catalog
+            auto& catalog = AddonCatalog::shared();
+            catalog.refresh(type);
+            auto remote = catalog.find(type, id);
+            if (!remote || remote->downloadUrl.isEmpty()) {
                 spdlog::error("Addon not found: {}", id.toStdString());
                 return false;
             }
             
-            if (progress) {
-                progress(0, 1, QString("Downloading %1...").arg(addonName));
-            }
-            
-            // Download the addon
-            auto dlFuture = impl->client.downloadAddon(downloadUrl, 
-                [&progress, &addonName](qint64 received, qint64 total) {
-                    if (progress && total > 0) {
-                        int percent = static_cast<int>((received * 100) / total);
-                        progress(percent, 100, QString("Downloading %1... %2%").arg(addonName).arg(percent));
-                    }
-                });
-            dlFuture.waitForFinished();
-            QString zipPath = dlFuture.result();
-            
-            if (zipPath.isEmpty()) {
-                spdlog::error("Failed to download addon");
-                if (progress) {
-                    progress(-1, 100, QString("Download failed for %1").arg(addonName));
-                }
-                return false;
-            }
-            
-            // Verify the downloaded file is actually a ZIP
-            // (lotrointerface.com may return HTML error pages)
-            QFile downloadedFile(zipPath);
-            if (downloadedFile.open(QIODevice::ReadOnly)) {
-                QByteArray header = downloadedFile.read(4);
-                downloadedFile.close();
-                
-                // ZIP files start with "PK\x03\x04" signature
-                if (header.size() < 4 || 
-                    header[0] != 'P' || header[1] != 'K' ||
-                    header[2] != 0x03 || header[3] != 0x04) {
-                    
-                    // Not a ZIP - likely an HTML error page
-                    QString errorMsg;
-                    if (downloadedFile.open(QIODevice::ReadOnly)) {
-                        QString content = QString::fromUtf8(downloadedFile.readAll());
-                        downloadedFile.close();
-                        
-                        if (content.contains("not yet been approved", Qt::CaseInsensitive)) {
-                            errorMsg = QString("%1: File not yet approved for download on lotrointerface.com").arg(addonName);
-                        } else if (content.contains("file not found", Qt::CaseInsensitive)) {
-                            errorMsg = QString("%1: File not found on lotrointerface.com").arg(addonName);
-                        } else {
-                            errorMsg = QString("%1: Download failed - server returned invalid file").arg(addonName);
-                        }
-                    } else {
-                        errorMsg = QString("%1: Download failed - file is not a valid archive").arg(addonName);
-                    }
-                    
-                    spdlog::error("{}", errorMsg.toStdString());
-                    if (progress) {
-                        progress(-1, 100, errorMsg);
-                    }
-                    QFile::remove(zipPath);
-                    return false;
-                }
-            }
-            
-            if (progress) {
-                progress(100, 100, QString("Installing %1...").arg(addonName));
-            }
-            
-            // Create a temporary directory for extraction
-            QString tempDirPath = QDir::tempPath() + "/lotro-launcher-addon-" + 
-                QString::number(QDateTime::currentMSecsSinceEpoch());
-            QDir tempDir(tempDirPath);
-            tempDir.mkpath(".");
-            
-            spdlog::info("Extracting addon to temp directory: {}", tempDirPath.toStdString());
-            
-            // Extract zip to temporary directory using unzip command
-            QProcess process;
-            QStringList args;
-            args << "-o"  // Overwrite
-                 << zipPath
-                 << "-d"
-                 << tempDirPath;
-            
-            process.start("unzip", args);
-            
-            if (!process.waitForFinished(60000)) {
-                spdlog::error("Extraction timed out");
-                if (progress) {
-                    progress(-1, 100, QString("Extraction timed out for %1").arg(addonName));
-                }
-                QFile::remove(zipPath);
-                tempDir.removeRecursively();
-                return false;
-            }
-            
-            if (process.exitCode() != 0) {
-                QString errorOutput = QString::fromUtf8(process.readAllStandardError());
-                spdlog::error("Extraction failed: {}", errorOutput.toStdString());
-                if (progress) {
-                    progress(-1, 100, QString("Extraction failed for %1").arg(addonName));
-                }
-                QFile::remove(zipPath);
-                tempDir.removeRecursively();
-                return false;
-            }
-            
-            // Clean up zip file
-            QFile::remove(zipPath);
-            
-            // Clean invalid wrapper folders (OneLauncher-style)
-            cleanTempAddonFolder(tempDirPath.toStdString());
-            
-            // For music and skins, ensure files are wrapped in a named folder
-            // This makes them manageable instead of being loose files
-            std::filesystem::path copySource = tempDirPath.toStdString();
-            if (type == AddonType::Music || type == AddonType::Skin) {
-                auto fixedRoot = fixImproperRootDir(
-                    tempDirPath.toStdString(), 
-                    addonName.toStdString()
-                );
-                // If fixImproperRootDir returned a subfolder, copy just that folder
-                if (fixedRoot != copySource) {
-                    // The files are now in a named folder, copy that folder to destination
-                    copySource = fixedRoot;
-                }
-            }
-            
-            // Copy contents to final destination
-            spdlog::info("Copying addon to final destination: {}", destDir.string());
-            
-            // Copy each top-level item from the temp/source directory to the destination
-            // This avoids copying the temp directory folder itself (which would create
-            // .../Plugins/lotro-launcher-addon-123/ instead of .../Plugins/AddonName/)
-            for (const auto& entry : std::filesystem::directory_iterator(copySource)) {
-                QProcess copyProcess;
-                QStringList copyArgs;
-                copyArgs << "-r" << "-f"
-                         << QString::fromStdString(entry.path().string())
-                         << QString::fromStdString(destDir.string());
-                
-                copyProcess.start("cp", copyArgs);
-                if (!copyProcess.waitForFinished(60000)) {
-                    spdlog::error("Copy to destination failed for: {}", entry.path().string());
-                    if (progress) {
-                        progress(-1, 100, QString("Failed to install %1").arg(addonName));
-                    }
-                    tempDir.removeRecursively();
-                    return false;
-                }
-            }
-            
-            // Clean up temp directory
-            tempDir.removeRecursively();
-            
-            spdlog::info("Addon {} installed successfully to {}", addonName.toStdString(), destDir.string());
-            return true;
+            return installWithDependencies(impl->client, *remote, type, destDir,
+                                           installedIds, maxConcurrent, progress);
             
         } catch (const std::exception& e) {
             spdlog::error("Exception installing addon: {}", e.what());
@@ -658,37 +843,93 @@ QFuture<int> AddonManager::updateAllAddons(
     AddonProgressCallback progress
 ) {
     auto* impl = m_impl.get();
+    auto destDir = getAddonDirectory(type);
     auto installedAddons = getInstalledAddons(type);
+    const int maxConcurrent = m_impl->maxConcurrentUpdates;
     
-    return QtConcurrent::run([this, impl, type, installedAddons, progress]() -> int {
-        int updatedCount = 0;
-        int total = static_cast<int>(installedAddons.size());
-        int current = 0;
+    return TaskScheduler::instance().run(TaskPool::Io, [impl, type, destDir, installedAddons, progress, maxConcurrent]() -> int {
+        // Latest versions come from the catalog, forced fresh for an update
+        auto& catalog = AddonCatalog::shared();
+        catalog.refresh(type, true);
         
+        struct Update {
+            AddonInfo installed;
+            RemoteAddonInfo remote;
+        };
+        std::vector<Update> updates;
         for (const auto& addon : installedAddons) {
-            if (addon.hasUpdate()) {
-                if (progress) {
-                    progress(current, total, QString("Updating %1...").arg(addon.name));
+            auto remote = catalog.find(type, addon.id);
+            if (remote && !remote->downloadUrl.isEmpty() && !remote->version.isEmpty() &&
+                remote->version != addon.installedVersion) {
+                updates.push_back({addon, std::move(*remote)});
+            }
+        }
+        
+        const int total = static_cast<int>(updates.size());
+        spdlog::info("{} of {} addons have updates, installing {} at a time",
+                     total, installedAddons.size(), maxConcurrent);
+        
+        // Every worker reports through the one callback, so one call at a time
+        QMutex progressMutex;
+        std::atomic<int> finished{0};
+        std::atomic<int> updatedCount{0};
+        auto report = [&](const QString& status) {
+            if (progress) {
+                QMutexLocker lock(&progressMutex);
+                progress(finished.load(), total, status);
+            }
+        };
+        
+        // Each addon goes through download, extract and re-parse on its own
+        // worker, so one addon's download overlaps another's extraction
+        QThreadPool pool;
+        pool.setMaxThreadCount(std::max(1, maxConcurrent));
+        QList<QFuture<void>> running;
+        for (const auto& update : updates) {
+            running.append(QtConcurrent::run(&pool, [&, update]() {
+                const QString name = update.remote.name;
+                bool ok = false;
+                try {
+                    ok = downloadAndInstall(impl->client, update.remote.downloadUrl, name, type, destDir,
+                                            [&](int, int, const QString& status) { report(status); });
+                } catch (const std::exception& e) {
+                    spdlog::error("Exception updating addon {}: {}", name.toStdString(), e.what());
                 }
                 
-                auto updateFuture = this->updateAddon(addon.id, type, nullptr);
-                updateFuture.waitForFinished();
-                if (updateFuture.result()) {
+                if (ok) {
                     updatedCount++;
+                    const auto& compendium = update.installed.compendiumFilePath;
+                    if (std::filesystem::is_regular_file(compendium)) {
+                        auto parsed = CompendiumParser::parse(compendium);
+                        if (parsed && parsed->version != update.remote.version) {
+                            spdlog::warn("{} reports version {} after updating to {}", name.toStdString(),
+                                         parsed->version.toStdString(), update.remote.version.toStdString());
+                        }
+                    }
                 }
-            }
-            current++;
+                
+                finished++;
+                report(ok ? QString("Updated %1").arg(name) : QString("Failed to update %1").arg(name));
+            }));
+        }
+        for (auto& future : running) {
+            future.waitForFinished();
         }
         
+        const int updated = updatedCount.load();
         if (progress) {
-            progress(total, total, QString("Updated %1 addons").arg(updatedCount));
+            progress(total, total, QString("Updated %1 addons").arg(updated));
         }
         
-        spdlog::info("Updated {} addons", updatedCount);
-        return updatedCount;
+        spdlog::info("Updated {} addons", updated);
+        return updated;
     });
 }
 
+void AddonManager::setMaxConcurrentUpdates(int updates) {
+    m_impl->maxConcurrentUpdates = std::max(1, updates);
+}
+
 std::optional<AddonInfo> AddonManager::parseCompendiumFile(
     const std::filesystem::path& path
 ) const {
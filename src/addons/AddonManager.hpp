@@ -127,9 +127,22 @@ public:
     
     /**
      * Refresh the list of installed addons
+     * 
+     * Compendium files are parsed only if they changed since the last
+     * refresh, in this run or an earlier one.
      */
     void refreshInstalledAddons();
     
+    /**
+     * Refresh the installed addons whenever their directories change
+     * 
+     * Changes are collected for WATCH_DEBOUNCE_MS before one refresh, after
+     * which onChanged is called. Uses the calling thread's event loop.
+     */
+    void watchInstalledAddons(std::function<void()> onChanged);
+    
+    static constexpr int WATCH_DEBOUNCE_MS = 300;
+    
     // =====================
     // Remote addon queries
     // =====================
@@ -162,6 +175,9 @@ public:
     /**
      * Install an addon from lotrointerface.com
      * 
+     * Dependencies named in its compendium that aren't installed are
+     * fetched alongside it, and all of them go in together or not at all.
+     * 
      * @param id Addon interface ID
      * @param type Addon type
      * @param progress Progress callback
@@ -197,12 +213,27 @@ public:
     
     /**
      * Update all addons with available updates
+     * 
+     * Checks the installed versions against one fetch of the remote list,
+     * then runs up to maxConcurrentUpdates addons through download,
+     * extraction and compendium re-parse at once. progress gets the number
+     * of addons finished out of those updating, with each addon's status;
+     * it is called from worker threads, one call at a time.
+     * 
+     * @return Number of addons updated
      */
     QFuture<int> updateAllAddons(
         AddonType type,
         AddonProgressCallback progress = nullptr
     );
     
+    /**
+     * Limit how many addons updateAllAddons works on at once
+     */
+    void setMaxConcurrentUpdates(int updates);
+    
+    static constexpr int DEFAULT_MAX_CONCURRENT_UPDATES = 4;
+    
     // =====================
     // Utility methods
     // =====================
@@ -223,6 +254,8 @@ public:
     std::vector<AddonInfo> getAddonsWithStartupScripts() const;
     
 private:
+    void updateWatchedPaths();
+    
     class Impl;
     std::unique_ptr<Impl> m_impl;
 };
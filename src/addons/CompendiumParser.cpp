@@ -9,9 +9,12 @@
 #include <QFile>
 #include <QXmlStreamReader>
 #include <QDir>
+#include <QtConcurrent>
 
 #include <spdlog/spdlog.h>
 
+#include <numeric>
+
 namespace lotro {
 
 std::optional<CompendiumType> CompendiumParser::getTypeFromPath(
@@ -48,13 +51,37 @@ std::optional<AddonInfo> CompendiumParser::parse(const std::filesystem::path& pa
         return std::nullopt;
     }
     
-    QString content = QString::fromUtf8(file.readAll());
-    return parseContent(content, *type);
+    // Read straight from the file; the reader decodes as it goes
+    QXmlStreamReader reader(&file);
+    return parseReader(reader, *type);
+}
+
+std::vector<std::optional<AddonInfo>> CompendiumParser::parseAll(
+    const std::vector<std::filesystem::path>& paths
+) {
+    std::vector<std::optional<AddonInfo>> results(paths.size());
+    std::vector<size_t> indices(paths.size());
+    std::iota(indices.begin(), indices.end(), size_t{0});
+    
+    // Each file is small, so the cost is opening and parsing, not reading;
+    // spread them over the global pool
+    QtConcurrent::blockingMap(indices, [&](size_t i) {
+        results[i] = parse(paths[i]);
+    });
+    return results;
 }
 
 std::optional<AddonInfo> CompendiumParser::parseContent(
     const QString& content,
     CompendiumType type
+) {
+    QXmlStreamReader reader(content);
+    return parseReader(reader, type);
+}
+
+std::optional<AddonInfo> CompendiumParser::parseReader(
+    QXmlStreamReader& reader,
+    CompendiumType type
 ) {
     AddonInfo info;
     
@@ -65,54 +92,75 @@ std::optional<AddonInfo> CompendiumParser::parseContent(
         case CompendiumType::Music:  info.type = AddonType::Music; break;
     }
     
-    QXmlStreamReader reader(content);
-    bool inDescriptors = false;
-    bool inDependencies = false;
+    // Fields are matched as views on the reader's buffer, and the parse
+    // ends once every field has been seen or the root element closes
+    enum Field : unsigned {
+        Id = 1 << 0, Name = 1 << 1, Version = 1 << 2, Author = 1 << 3,
+        Description = 1 << 4, InfoUrl = 1 << 5, DownloadUrl = 1 << 6,
+        Category = 1 << 7, StartupScript = 1 << 8, Descriptors = 1 << 9,
+        Dependencies = 1 << 10, All = (1 << 11) - 1
+    };
+    unsigned seen = 0;
+    int depth = 0;
     
-    while (!reader.atEnd()) {
-        reader.readNext();
+    while (seen != All && !reader.atEnd()) {
+        const auto token = reader.readNext();
         
-        if (reader.isStartElement()) {
-            QString name = reader.name().toString();
-            
-            if (name == "Id") {
-                info.id = reader.readElementText();
-            } else if (name == "Name") {
-                info.name = reader.readElementText();
-            } else if (name == "Version") {
-                info.version = reader.readElementText();
-                info.installedVersion = info.version;
-            } else if (name == "Author") {
-                info.author = reader.readElementText();
-            } else if (name == "Description") {
-                info.description = reader.readElementText();
-            } else if (name == "InfoUrl") {
-                info.infoUrl = reader.readElementText();
-            } else if (name == "DownloadUrl") {
-                info.downloadUrl = reader.readElementText();
-            } else if (name == "Category") {
-                info.category = reader.readElementText();
-            } else if (name == "StartupScript") {
-                info.startupScript = reader.readElementText();
-            } else if (name == "Descriptors") {
-                inDescriptors = true;
-            } else if (name == "Dependencies") {
-                inDependencies = true;
-            } else if (name == "descriptor" && inDescriptors) {
-                info.descriptors.push_back(reader.readElementText());
-            } else if (name == "dependency" && inDependencies) {
-                QString dep = reader.readElementText();
-                if (dep != "0") {  // 0 means no dependency
-                    info.dependencies.push_back(dep);
-                }
+        if (token == QXmlStreamReader::EndElement) {
+            if (--depth == 0) {
+                break;
             }
-        } else if (reader.isEndElement()) {
-            QString name = reader.name().toString();
-            if (name == "Descriptors") {
-                inDescriptors = false;
-            } else if (name == "Dependencies") {
-                inDependencies = false;
+            continue;
+        }
+        if (token != QXmlStreamReader::StartElement) {
+            continue;
+        }
+        if (++depth == 1) {
+            continue;               // PluginConfig, SkinConfig or MusicConfig
+        }
+        
+        const QStringView name = reader.name();
+        auto text = [&](QString& field, Field flag) {
+            field = reader.readElementText(QXmlStreamReader::SkipChildElements);
+            seen |= flag;
+            --depth;
+        };
+        
+        if (name == u"Id") {
+            text(info.id, Id);
+        } else if (name == u"Name") {
+            text(info.name, Name);
+        } else if (name == u"Version") {
+            text(info.version, Version);
+            info.installedVersion = info.version;
+        } else if (name == u"Author") {
+            text(info.author, Author);
+        } else if (name == u"Description") {
+            text(info.description, Description);
+        } else if (name == u"InfoUrl") {
+            text(info.infoUrl, InfoUrl);
+        } else if (name == u"DownloadUrl") {
+            text(info.downloadUrl, DownloadUrl);
+        } else if (name == u"Category") {
+            text(info.category, Category);
+        } else if (name == u"StartupScript") {
+            text(info.startupScript, StartupScript);
+        } else if (name == u"Descriptors" || name == u"Dependencies") {
+            const bool descriptors = name == u"Descriptors";
+            auto& list = descriptors ? info.descriptors : info.dependencies;
+            while (reader.readNextStartElement()) {
+                QString value = reader.readElementText(QXmlStreamReader::SkipChildElements);
+                if (!descriptors && value == u"0") {
+                    continue;       // 0 means no dependency
+                }
+                list.push_back(std::move(value));
             }
+            list.shrink_to_fit();
+            seen |= descriptors ? Descriptors : Dependencies;
+            --depth;
+        } else {
+            reader.skipCurrentElement();
+            --depth;
         }
     }
     
@@ -18,6 +18,8 @@
 
 #include "AddonManager.hpp"
 
+class QXmlStreamReader;
+
 namespace lotro {
 
 /**
@@ -62,6 +64,15 @@ public:
      */
     static std::optional<AddonInfo> parse(const std::filesystem::path& path);
     
+    /**
+     * Parse many compendium files in parallel on the global thread pool
+     * 
+     * @return One result per path, in the same order
+     */
+    static std::vector<std::optional<AddonInfo>> parseAll(
+        const std::vector<std::filesystem::path>& paths
+    );
+    
     /**
      * Parse compendium XML content
      * 
@@ -105,6 +116,12 @@ public:
      * @return XML content string
      */
     static QString generate(const AddonInfo& info);
+    
+private:
+    /**
+     * Read the known fields, stopping once all are found
+     */
+    static std::optional<AddonInfo> parseReader(QXmlStreamReader& reader, CompendiumType type);
 };
 
 /**
@@ -0,0 +1,226 @@
+/**
+ * LOTRO Launcher - Installed Addon Index Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "InstalledAddonIndex.hpp"
+#include "CompendiumParser.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+
+#include <spdlog/spdlog.h>
+
+namespace lotro {
+
+namespace {
+
+void write(QDataStream& out, const std::vector<QString>& list) {
+    out << quint32(list.size());
+    for (const auto& value : list) {
+        out << value;
+    }
+}
+
+void read(QDataStream& in, std::vector<QString>& list) {
+    quint32 count = 0;
+    in >> count;
+    list.clear();
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        in >> list.emplace_back();
+    }
+}
+
+void write(QDataStream& out, const AddonInfo& addon) {
+    out << addon.id << addon.name << qint32(addon.type) << addon.version
+        << addon.author << addon.category << addon.description << addon.infoUrl
+        << addon.downloadUrl << addon.startupScript << addon.installedVersion;
+    write(out, addon.dependencies);
+    write(out, addon.descriptors);
+}
+
+void read(QDataStream& in, AddonInfo& addon) {
+    qint32 type = 0;
+    in >> addon.id >> addon.name >> type >> addon.version
+       >> addon.author >> addon.category >> addon.description >> addon.infoUrl
+       >> addon.downloadUrl >> addon.startupScript >> addon.installedVersion;
+    addon.type = (type >= 0 && type <= qint32(AddonType::Music))
+        ? static_cast<AddonType>(type) : AddonType::Plugin;
+    read(in, addon.dependencies);
+    read(in, addon.descriptors);
+}
+
+void write(QDataStream& out, const StartupScript& script) {
+    out << script.addonId << script.addonName << QString::fromStdString(script.path.string());
+    write(out, script.dependencies);
+}
+
+void read(QDataStream& in, StartupScript& script) {
+    QString path;
+    in >> script.addonId >> script.addonName >> path;
+    script.path = path.toStdString();
+    read(in, script.dependencies);
+}
+
+} // namespace
+
+InstalledAddonIndex::InstalledAddonIndex(const std::filesystem::path& settingsDir) {
+    QString dir = QString::fromStdString(settingsDir.string());
+    m_path = QDir(QString::fromStdString(Platform::getCachePath().string())).filePath(
+        QString("installed-addons-%1.cache").arg(qHash(QDir(dir).absolutePath()), 8, 16, QChar('0')));
+}
+
+std::vector<AddonInfo> InstalledAddonIndex::scan(const std::filesystem::path& directory) {
+    const auto files = CompendiumParser::findCompendiumFiles(directory);
+    QSet<QString> seen;
+    
+    // Stat everything first so the changed files can be parsed as a batch
+    std::vector<QString> paths;
+    std::vector<std::filesystem::path> changed;
+    std::vector<std::pair<qint64, qint64>> changedStats;
+    paths.reserve(files.size());
+    for (const auto& file : files) {
+        const QString path = QString::fromStdString(file.string());
+        seen.insert(path);
+        paths.push_back(path);
+        
+        QFileInfo info(path);
+        const qint64 size = info.size();
+        const qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+        
+        auto cached = m_entries.constFind(path);
+        if (cached == m_entries.constEnd() || cached->size != size || cached->mtime != mtime) {
+            changed.push_back(file);
+            changedStats.emplace_back(size, mtime);
+        }
+    }
+    
+    auto parsed = CompendiumParser::parseAll(changed);
+    for (size_t i = 0; i < changed.size(); ++i) {
+        m_entries.insert(QString::fromStdString(changed[i].string()),
+                         {changedStats[i].first, changedStats[i].second, std::move(parsed[i])});
+    }
+    if (!changed.empty()) {
+        m_dirty = true;
+    }
+    
+    std::vector<AddonInfo> addons;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& entry = m_entries[paths[i]];
+        if (entry.addon) {
+            AddonInfo addon = *entry.addon;
+            addon.status = AddonStatus::Installed;
+            addon.compendiumFilePath = files[i];
+            addons.push_back(std::move(addon));
+        }
+    }
+    
+    // Forget files that were removed from this directory
+    const QString prefix = QString::fromStdString(directory.string()) + "/";
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it.key().startsWith(prefix) && !seen.contains(it.key())) {
+            it = m_entries.erase(it);
+            m_dirty = true;
+        } else {
+            ++it;
+        }
+    }
+    
+    spdlog::debug("Found {} compendium files in {}, {} parsed", files.size(), directory.string(), changed.size());
+    return addons;
+}
+
+void InstalledAddonIndex::setStartupScripts(std::vector<StartupScript> scripts) {
+    if (scripts != m_startupScripts) {
+        m_startupScripts = std::move(scripts);
+        m_dirty = true;
+    }
+}
+
+bool InstalledAddonIndex::save() {
+    if (!m_dirty) {
+        return true;
+    }
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write installed addon index {}: {}", m_path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << static_cast<quint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        out << it.key() << it->size << it->mtime << it->addon.has_value();
+        if (it->addon) {
+            write(out, *it->addon);
+        }
+    }
+    out << static_cast<quint32>(m_startupScripts.size());
+    for (const auto& script : m_startupScripts) {
+        write(out, script);
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit installed addon index {}", m_path.toStdString());
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool InstalledAddonIndex::load() {
+    m_entries.clear();
+    m_startupScripts.clear();
+    m_dirty = false;
+    
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version >> count;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("Installed addon index {} is outdated, rebuilding", m_path.toStdString());
+        return false;
+    }
+    m_entries.reserve(count);
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry entry;
+        bool parsed = false;
+        in >> path >> entry.size >> entry.mtime >> parsed;
+        if (parsed) {
+            read(in, entry.addon.emplace());
+        }
+        m_entries.insert(path, std::move(entry));
+    }
+    quint32 scripts = 0;
+    in >> scripts;
+    for (quint32 i = 0; i < scripts && in.status() == QDataStream::Ok; ++i) {
+        read(in, m_startupScripts.emplace_back());
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Installed addon index {} is corrupt, rebuilding", m_path.toStdString());
+        m_entries.clear();
+        m_startupScripts.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace lotro
@@ -0,0 +1,73 @@
+/**
+ * LOTRO Launcher - Installed Addon Index
+ * 
+ * Remembered compendium contents, keyed by size and modification time.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "AddonManager.hpp"
+#include "StartupScriptRunner.hpp"
+
+#include <QHash>
+#include <QString>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Parsed compendium files of one settings directory, as of their last scan
+ * 
+ * An entry stays valid while its file's size and modification time are
+ * unchanged, so scanning an untouched addon folder only lists and stats
+ * the compendium files; just the new or edited ones are parsed again,
+ * together in one parallel batch.
+ * Files that failed to parse are remembered too, so a broken compendium
+ * costs one parse rather than one per scan. The index is one small file
+ * per settings directory under the platform cache path.
+ * 
+ * The plugins' startup scripts are kept alongside, so a launch can read
+ * what to run without scanning or parsing anything.
+ */
+class InstalledAddonIndex {
+public:
+    explicit InstalledAddonIndex(const std::filesystem::path& settingsDir);
+    
+    /**
+     * Addons described by the compendium files under a directory
+     * 
+     * Entries for files under it that no longer exist are dropped.
+     */
+    std::vector<AddonInfo> scan(const std::filesystem::path& directory);
+    
+    /**
+     * Startup scripts of the installed plugins, as of the last scan
+     */
+    const std::vector<StartupScript>& startupScripts() const { return m_startupScripts; }
+    void setStartupScripts(std::vector<StartupScript> scripts);
+    
+    bool load();
+    bool save();
+    
+private:
+    struct Entry {
+        qint64 size = 0;
+        qint64 mtime = 0;           // Milliseconds since epoch
+        std::optional<AddonInfo> addon;     // Empty if the file didn't parse
+    };
+    
+    static constexpr quint32 MAGIC = 0x4941414C;    // "LAAI"
+    static constexpr quint32 VERSION = 2;
+    
+    QString m_path;
+    QHash<QString, Entry> m_entries;
+    std::vector<StartupScript> m_startupScripts;
+    bool m_dirty = false;
+};
+
+} // namespace lotro
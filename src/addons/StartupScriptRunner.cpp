@@ -0,0 +1,210 @@
+/**
+ * LOTRO Launcher - Startup Script Runner Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "StartupScriptRunner.hpp"
+
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTimer>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace lotro {
+
+StartupScriptRunner::StartupScriptRunner(QObject* parent)
+    : QObject(parent)
+{
+}
+
+StartupScriptRunner::~StartupScriptRunner() {
+    cancel();
+}
+
+void StartupScriptRunner::setMaxConcurrent(int scripts) {
+    m_maxConcurrent = std::max(1, scripts);
+}
+
+void StartupScriptRunner::setTimeout(int milliseconds) {
+    m_timeout = milliseconds;
+}
+
+QString StartupScriptRunner::findInterpreter() {
+    QString interpreter = QStandardPaths::findExecutable("python3");
+    if (interpreter.isEmpty()) {
+        interpreter = QStandardPaths::findExecutable("python");
+    }
+    return interpreter;
+}
+
+void StartupScriptRunner::start(const std::vector<StartupScript>& scripts, const QString& interpreter) {
+    cancel();
+    m_interpreter = interpreter.isEmpty() ? findInterpreter() : interpreter;
+    m_jobs.clear();
+    m_ready.clear();
+    m_running = 0;
+    m_remaining = scripts.size();
+    if (scripts.empty()) {
+        emit finished({});
+        return;
+    }
+    if (m_interpreter.isEmpty()) {
+        spdlog::warn("No Python interpreter found, skipping {} startup scripts", scripts.size());
+        m_remaining = 0;
+        emit finished({});
+        return;
+    }
+    
+    // Dependencies only order scripts; an addon without a script is no wait
+    QHash<QString, size_t> byAddon;
+    m_jobs.resize(scripts.size());
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        m_jobs[i].script = scripts[i];
+        m_jobs[i].result.addonName = scripts[i].addonName;
+        if (!scripts[i].addonId.isEmpty()) {
+            byAddon.insert(scripts[i].addonId, i);
+        }
+    }
+    for (size_t i = 0; i < m_jobs.size(); ++i) {
+        for (const QString& dependency : m_jobs[i].script.dependencies) {
+            auto it = byAddon.constFind(dependency);
+            if (it != byAddon.constEnd() && it.value() != i) {
+                m_jobs[it.value()].dependents.push_back(i);
+                ++m_jobs[i].waitingOn;
+            }
+        }
+        if (m_jobs[i].waitingOn == 0) {
+            m_ready.push_back(i);
+        }
+    }
+    
+    spdlog::info("Running {} startup scripts, {} at a time", m_jobs.size(), m_maxConcurrent);
+    startReady();
+}
+
+void StartupScriptRunner::cancel() {
+    for (Job& job : m_jobs) {
+        if (QProcess* process = std::exchange(job.process, nullptr)) {
+            process->disconnect(this);
+            process->kill();
+            process->waitForFinished(1000);
+            process->deleteLater();
+        }
+    }
+    m_remaining = 0;
+    m_running = 0;
+}
+
+void StartupScriptRunner::startReady() {
+    // Ready scripts go in list order
+    std::sort(m_ready.begin(), m_ready.end(), std::greater<size_t>());
+    while (!m_ready.empty() && m_running < m_maxConcurrent) {
+        size_t index = m_ready.back();
+        m_ready.pop_back();
+        startScript(index);
+    }
+    
+    // Nothing running or ready but scripts left: they wait on each other
+    if (m_running == 0 && m_ready.empty() && m_remaining > 0) {
+        for (size_t i = 0; i < m_jobs.size(); ++i) {
+            if (!m_jobs[i].started) {
+                spdlog::warn("Startup script dependency cycle, running {} anyway",
+                             m_jobs[i].script.addonName.toStdString());
+                m_jobs[i].waitingOn = 0;
+                m_ready.push_back(i);
+                break;
+            }
+        }
+        startReady();
+    }
+}
+
+void StartupScriptRunner::startScript(size_t index) {
+    Job& job = m_jobs[index];
+    job.started = true;
+    ++m_running;
+    
+    const QString path = QString::fromStdString(job.script.path.string());
+    spdlog::info("Running startup script for {}: {}", job.script.addonName.toStdString(), path.toStdString());
+    
+    auto* process = new QProcess(this);
+    job.process = process;
+    process->setWorkingDirectory(QString::fromStdString(job.script.path.parent_path().string()));
+    process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    process->setStandardOutputFile(QProcess::nullDevice());
+    
+    connect(process, &QProcess::finished, this, [this, index](int exitCode, QProcess::ExitStatus status) {
+        Job& job = m_jobs[index];
+        if (status == QProcess::NormalExit) {
+            job.result.exitCode = exitCode;
+        }
+        scriptDone(index);
+    });
+    connect(process, &QProcess::errorOccurred, this, [this, index](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            m_jobs[index].result.failedToStart = true;
+            scriptDone(index);
+        }
+    });
+    if (m_timeout > 0) {
+        QTimer::singleShot(m_timeout, process, [this, index, process]() {
+            if (process->state() != QProcess::NotRunning) {
+                m_jobs[index].result.timedOut = true;
+                process->kill();
+            }
+        });
+    }
+    
+    job.clock.start();
+    process->start(m_interpreter, {path});
+}
+
+void StartupScriptRunner::scriptDone(size_t index) {
+    Job& job = m_jobs[index];
+    QProcess* process = std::exchange(job.process, nullptr);
+    if (!process) {
+        return;         // Already counted (failed to start, then finished)
+    }
+    process->disconnect(this);
+    process->deleteLater();
+    job.result.elapsedMs = job.clock.elapsed();
+    --m_running;
+    --m_remaining;
+    
+    if (job.result.ok()) {
+        spdlog::info("Startup script for {} finished in {} ms", job.script.addonName.toStdString(),
+                     job.result.elapsedMs);
+    } else {
+        spdlog::warn("Startup script for {} {} after {} ms", job.script.addonName.toStdString(),
+                     job.result.timedOut ? "timed out"
+                         : job.result.failedToStart ? "failed to start"
+                         : "failed with exit code " + std::to_string(job.result.exitCode),
+                     job.result.elapsedMs);
+    }
+    
+    for (size_t dependent : job.dependents) {
+        if (--m_jobs[dependent].waitingOn == 0 && !m_jobs[dependent].started) {
+            m_ready.push_back(dependent);
+        }
+    }
+    
+    if (m_remaining == 0) {
+        std::vector<StartupScriptResult> results;
+        results.reserve(m_jobs.size());
+        for (const Job& done : m_jobs) {
+            results.push_back(done.result);
+        }
+        emit finished(results);
+        return;
+    }
+    startReady();
+}
+
+} // namespace lotro
@@ -0,0 +1,117 @@
+/**
+ * LOTRO Launcher - Startup Script Runner
+ * 
+ * Runs the Python startup scripts plugins declare in their compendium.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+#include <filesystem>
+#include <vector>
+
+class QProcess;
+
+namespace lotro {
+
+/**
+ * One plugin's startup script, as recorded in the installed addon index
+ */
+struct StartupScript {
+    QString addonId;
+    QString addonName;
+    std::filesystem::path path;             // Absolute
+    std::vector<QString> dependencies;      // Interface IDs of required addons
+    
+    bool operator==(const StartupScript&) const = default;
+};
+
+/**
+ * Outcome of one script
+ */
+struct StartupScriptResult {
+    QString addonName;
+    int exitCode = -1;
+    bool timedOut = false;
+    bool failedToStart = false;
+    qint64 elapsedMs = 0;
+    
+    bool ok() const { return !timedOut && !failedToStart && exitCode == 0; }
+};
+
+/**
+ * Runs startup scripts side by side
+ * 
+ * Up to maxConcurrent scripts run at once, each as its own interpreter
+ * process in the script's directory, killed after the timeout. A script
+ * whose addon depends on other addons with scripts starts once those
+ * have finished, however they ended; scripts caught in a dependency
+ * cycle run in list order once nothing else can. Runs on the thread it
+ * lives on, driven by its processes' signals, so the game process can
+ * start while scripts are still going.
+ */
+class StartupScriptRunner : public QObject {
+    Q_OBJECT
+    
+public:
+    explicit StartupScriptRunner(QObject* parent = nullptr);
+    ~StartupScriptRunner() override;
+    
+    void setMaxConcurrent(int scripts);
+    void setTimeout(int milliseconds);
+    
+    /**
+     * Start running, abandoning any run still going
+     * @param interpreter Python executable; found on PATH when empty
+     */
+    void start(const std::vector<StartupScript>& scripts, const QString& interpreter = {});
+    
+    /**
+     * Kill running scripts without emitting finished()
+     */
+    void cancel();
+    
+    bool isRunning() const { return m_remaining > 0; }
+    
+    /**
+     * python3, or python, from PATH; empty if neither is installed
+     */
+    static QString findInterpreter();
+    
+    static constexpr int DEFAULT_MAX_CONCURRENT = 4;
+    static constexpr int DEFAULT_TIMEOUT_MS = 30000;
+    
+signals:
+    void finished(const std::vector<StartupScriptResult>& results);
+    
+private:
+    void startReady();
+    void startScript(size_t index);
+    void scriptDone(size_t index);
+    
+    struct Job {
+        StartupScript script;
+        StartupScriptResult result;
+        std::vector<size_t> dependents;
+        int waitingOn = 0;              // Unfinished scripts this one depends on
+        bool started = false;
+        QProcess* process = nullptr;
+        QElapsedTimer clock;
+    };
+    
+    QString m_interpreter;
+    std::vector<Job> m_jobs;
+    std::vector<size_t> m_ready;
+    size_t m_remaining = 0;
+    int m_running = 0;
+    int m_maxConcurrent = DEFAULT_MAX_CONCURRENT;
+    int m_timeout = DEFAULT_TIMEOUT_MS;
+};
+
+} // namespace lotro
@@ -0,0 +1,323 @@
+/**
+ * LOTRO Launcher - ZIP Archive Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ZipArchive.hpp"
+
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <QtEndian>
+
+#include <spdlog/spdlog.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+
+namespace lotro {
+
+namespace {
+    constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+    constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+    constexpr uint32_t END_SIGNATURE = 0x06054b50;
+    constexpr uint32_t ZIP64_END_SIGNATURE = 0x06064b50;
+    constexpr uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+    constexpr uint16_t ZIP64_EXTRA_ID = 0x0001;
+    constexpr uint16_t METHOD_STORED = 0;
+    constexpr uint16_t METHOD_DEFLATED = 8;
+    
+    constexpr qint64 END_SIZE = 22;
+    constexpr qint64 MAX_COMMENT_SIZE = 0xFFFF;
+    constexpr qint64 CHUNK_SIZE = 256 * 1024;
+    
+    uint16_t u16(const uchar* p) { return qFromLittleEndian<quint16>(p); }
+    uint32_t u32(const uchar* p) { return qFromLittleEndian<quint32>(p); }
+    uint64_t u64(const uchar* p) { return qFromLittleEndian<quint64>(p); }
+    
+    // Whether [offset, offset + length) lies within size bytes, without
+    // overflowing on the untrusted offsets and lengths archives carry
+    bool inBounds(uint64_t offset, uint64_t length, qint64 size) {
+        const uint64_t limit = static_cast<uint64_t>(size);
+        return offset <= limit && length <= limit - offset;
+    }
+    
+    /**
+     * Fill in the sizes and offset a ZIP64 entry keeps in its extra field
+     */
+    void readZip64Extra(const uchar* extra, uint16_t length, ZipEntry& entry) {
+        const uchar* end = extra + length;
+        while (extra + 4 <= end) {
+            const uint16_t id = u16(extra);
+            const uint16_t size = u16(extra + 2);
+            const uchar* field = extra + 4;
+            extra = field + size;
+            if (id != ZIP64_EXTRA_ID || extra > end) {
+                continue;
+            }
+            
+            // Only the fields that overflowed are present, in this order
+            const uchar* fieldEnd = field + size;
+            if (entry.size == 0xFFFFFFFF && field + 8 <= fieldEnd) {
+                entry.size = u64(field);
+                field += 8;
+            }
+            if (entry.compressedSize == 0xFFFFFFFF && field + 8 <= fieldEnd) {
+                entry.compressedSize = u64(field);
+                field += 8;
+            }
+            if (entry.localHeaderOffset == 0xFFFFFFFF && field + 8 <= fieldEnd) {
+                entry.localHeaderOffset = u64(field);
+            }
+            return;
+        }
+    }
+}
+
+ZipArchive::~ZipArchive() {
+    if (m_data) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+    }
+}
+
+bool ZipArchive::open(const std::filesystem::path& path) {
+    m_file.setFileName(QString::fromStdString(path.string()));
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        spdlog::error("Can't open archive {}: {}", path.string(), m_file.errorString().toStdString());
+        return false;
+    }
+    m_size = m_file.size();
+    m_data = m_size > 0 ? m_file.map(0, m_size) : nullptr;
+    if (!m_data) {
+        spdlog::error("Can't map archive {}", path.string());
+        return false;
+    }
+    if (!readCentralDirectory()) {
+        spdlog::error("Not a valid ZIP archive: {}", path.string());
+        m_entries.clear();
+        return false;
+    }
+    spdlog::debug("Opened archive {} with {} entries", path.string(), m_entries.size());
+    return true;
+}
+
+bool ZipArchive::readCentralDirectory() {
+    if (m_size < END_SIZE) {
+        return false;
+    }
+    
+    // The end record sits behind a comment of up to 64 KiB
+    qint64 end = -1;
+    const qint64 lowest = std::max<qint64>(0, m_size - END_SIZE - MAX_COMMENT_SIZE);
+    for (qint64 pos = m_size - END_SIZE; pos >= lowest; --pos) {
+        if (u32(m_data + pos) == END_SIGNATURE) {
+            end = pos;
+            break;
+        }
+    }
+    if (end < 0) {
+        return false;
+    }
+    
+    uint64_t count = u16(m_data + end + 10);
+    uint64_t directorySize = u32(m_data + end + 12);
+    uint64_t directoryOffset = u32(m_data + end + 16);
+    
+    if ((count == 0xFFFF || directorySize == 0xFFFFFFFF || directoryOffset == 0xFFFFFFFF) &&
+        end >= 20 && u32(m_data + end - 20) == ZIP64_LOCATOR_SIGNATURE) {
+        const uint64_t zip64End = u64(m_data + end - 20 + 8);
+        if (!inBounds(zip64End, 56, m_size) || u32(m_data + zip64End) != ZIP64_END_SIGNATURE) {
+            return false;
+        }
+        count = u64(m_data + zip64End + 32);
+        directorySize = u64(m_data + zip64End + 40);
+        directoryOffset = u64(m_data + zip64End + 48);
+    }
+    if (!inBounds(directoryOffset, directorySize, m_size)) {
+        return false;
+    }
+    
+    m_entries.clear();
+    m_entries.reserve(std::min<uint64_t>(count, directorySize / 46));
+    const uchar* p = m_data + directoryOffset;
+    const uchar* directoryEnd = p + directorySize;
+    for (uint64_t i = 0; i < count; ++i) {
+        if (p + 46 > directoryEnd || u32(p) != CENTRAL_HEADER_SIGNATURE) {
+            return false;
+        }
+        const uint16_t flags = u16(p + 8);
+        const uint16_t nameLength = u16(p + 28);
+        const uint16_t extraLength = u16(p + 30);
+        const uint16_t commentLength = u16(p + 32);
+        if (p + 46 + nameLength + extraLength + commentLength > directoryEnd) {
+            return false;
+        }
+        
+        ZipEntry entry;
+        entry.method = u16(p + 10);
+        entry.crc = u32(p + 16);
+        entry.compressedSize = u32(p + 20);
+        entry.size = u32(p + 24);
+        entry.localHeaderOffset = u32(p + 42);
+        entry.encrypted = flags & 0x0001;
+        
+        // Bit 11 marks UTF-8 names; older tools wrote the OEM code page,
+        // which agrees with Latin-1 on the ASCII names addons use
+        const char* name = reinterpret_cast<const char*>(p + 46);
+        entry.name = (flags & 0x0800) ? QString::fromUtf8(name, nameLength)
+                                      : QString::fromLatin1(name, nameLength);
+        entry.name.replace('\\', '/');
+        readZip64Extra(p + 46 + nameLength, extraLength, entry);
+        
+        m_entries.push_back(std::move(entry));
+        p += 46 + nameLength + extraLength + commentLength;
+    }
+    return true;
+}
+
+bool ZipArchive::extract(const std::vector<Target>& targets,
+                         const std::filesystem::path& destination) const {
+    // Create every directory up front so the workers only write files
+    std::set<std::filesystem::path> directories;
+    std::vector<const Target*> files;
+    for (const auto& target : targets) {
+        if (m_entries[target.entry].isDirectory()) {
+            directories.insert(destination / target.path);
+        } else {
+            directories.insert((destination / target.path).parent_path());
+            files.push_back(&target);
+        }
+    }
+    for (const auto& directory : directories) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            spdlog::error("Can't create {}: {}", directory.string(), error.message());
+            return false;
+        }
+    }
+    
+    std::atomic<int> failed{0};
+    QtConcurrent::blockingMap(files, [&](const Target* target) {
+        if (!extractFile(m_entries[target->entry], destination / target->path)) {
+            failed.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    
+    if (failed > 0) {
+        spdlog::error("{} of {} files failed to extract", failed.load(), files.size());
+        return false;
+    }
+    return true;
+}
+
+bool ZipArchive::extractFile(const ZipEntry& entry, const std::filesystem::path& path) const {
+    const std::string name = entry.name.toStdString();
+    if (entry.encrypted) {
+        spdlog::error("Encrypted archive entry not supported: {}", name);
+        return false;
+    }
+    if (entry.method != METHOD_STORED && entry.method != METHOD_DEFLATED) {
+        spdlog::error("Unsupported compression method {} for {}", entry.method, name);
+        return false;
+    }
+    
+    // The local header's own name and extra lengths can differ from the
+    // central directory's, so the data offset comes from it
+    const uint64_t header = entry.localHeaderOffset;
+    if (!inBounds(header, 30, m_size) || u32(m_data + header) != LOCAL_HEADER_SIGNATURE) {
+        spdlog::error("Bad local header for {}", name);
+        return false;
+    }
+    const uint64_t dataOffset = header + 30 + u16(m_data + header + 26) + u16(m_data + header + 28);
+    if (!inBounds(dataOffset, entry.compressedSize, m_size)) {
+        spdlog::error("Truncated archive entry: {}", name);
+        return false;
+    }
+    const uchar* data = m_data + dataOffset;
+    
+    QSaveFile file(QString::fromStdString(path.string()));
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::error("Can't write {}: {}", path.string(), file.errorString().toStdString());
+        return false;
+    }
+    
+    // Output is capped at the declared size, so a crafted entry can't
+    // inflate into more disk than the directory admits to
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uint64_t written = 0;
+    bool oversized = false;
+    auto write = [&](const char* bytes, qint64 length) {
+        if (static_cast<uint64_t>(length) > entry.size - written) {
+            oversized = true;
+            return false;
+        }
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(bytes), static_cast<uInt>(length));
+        written += length;
+        return file.write(bytes, length) == length;
+    };
+    
+    bool ok = true;
+    if (entry.method == METHOD_STORED) {
+        for (uint64_t pos = 0; ok && pos < entry.compressedSize; pos += CHUNK_SIZE) {
+            const qint64 length = static_cast<qint64>(std::min<uint64_t>(CHUNK_SIZE, entry.compressedSize - pos));
+            ok = write(reinterpret_cast<const char*>(data + pos), length);
+        }
+    } else {
+        z_stream stream{};
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+            spdlog::error("Can't initialise inflate for {}", name);
+            return false;
+        }
+        QByteArray buffer(CHUNK_SIZE, Qt::Uninitialized);
+        uint64_t consumed = 0;
+        int result = Z_OK;
+        while (ok && result == Z_OK) {
+            if (stream.avail_in == 0 && consumed < entry.compressedSize) {
+                const uint64_t length = std::min<uint64_t>(UINT32_MAX, entry.compressedSize - consumed);
+                stream.next_in = const_cast<Bytef*>(data + consumed);
+                stream.avail_in = static_cast<uInt>(length);
+                consumed += length;
+            }
+            stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+            stream.avail_out = static_cast<uInt>(buffer.size());
+            result = inflate(&stream, Z_NO_FLUSH);
+            if (result == Z_BUF_ERROR && stream.avail_in == 0 && consumed == entry.compressedSize) {
+                break;              // Ran out of input before the stream ended
+            }
+            ok = write(buffer.constData(), buffer.size() - stream.avail_out);
+        }
+        inflateEnd(&stream);
+        if (oversized) {
+            spdlog::error("Archive entry {} inflates past its declared {} bytes", name, entry.size);
+            return false;
+        }
+        if (ok && result != Z_STREAM_END) {
+            spdlog::error("Failed to inflate {}, zlib error: {}", name, result);
+            return false;
+        }
+    }
+    
+    if (oversized) {
+        spdlog::error("Corrupt archive entry {}: CRC or size mismatch", name);
+        return false;
+    }
+    if (!ok) {
+        spdlog::error("Can't write {}: {}", path.string(), file.errorString().toStdString());
+        return false;
+    }
+    if (written != entry.size || crc != entry.crc) {
+        spdlog::error("Corrupt archive entry {}: CRC or size mismatch", name);
+        return false;
+    }
+    if (!file.commit()) {
+        spdlog::error("Can't write {}: {}", path.string(), file.errorString().toStdString());
+        return false;
+    }
+    return true;
+}
+
+} // namespace lotro
@@ -0,0 +1,84 @@
+/**
+ * LOTRO Launcher - ZIP Archive
+ * 
+ * Native reader for the ZIP archives addons are distributed as.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <QFile>
+#include <QString>
+
+namespace lotro {
+
+/**
+ * One file or directory in a ZIP archive
+ */
+struct ZipEntry {
+    QString name;                       // As stored, with '/' separators
+    uint16_t method = 0;                // 0 stored, 8 deflated
+    uint32_t crc = 0;
+    uint64_t compressedSize = 0;
+    uint64_t size = 0;
+    uint64_t localHeaderOffset = 0;
+    bool encrypted = false;
+    
+    bool isDirectory() const { return name.endsWith('/'); }
+};
+
+/**
+ * Memory-mapped ZIP archive
+ * 
+ * open() reads the central directory only; nothing is decompressed until
+ * extract(), which inflates every file straight from the mapping into
+ * its place on disk, several entries at once on the global thread pool.
+ * Each file is written under a temporary name and renamed when its CRC
+ * checks out, so an interrupted extraction never leaves a truncated
+ * file where a good one was. Stored and deflated entries are supported,
+ * as are ZIP64 archives; encrypted entries are not.
+ */
+class ZipArchive {
+public:
+    /**
+     * Where to put one entry, relative to the extraction directory
+     */
+    struct Target {
+        size_t entry;
+        std::filesystem::path path;
+    };
+    
+    ZipArchive() = default;
+    ~ZipArchive();
+    
+    ZipArchive(const ZipArchive&) = delete;
+    ZipArchive& operator=(const ZipArchive&) = delete;
+    
+    bool open(const std::filesystem::path& path);
+    
+    const std::vector<ZipEntry>& entries() const { return m_entries; }
+    
+    /**
+     * Extract the given entries under a directory
+     * 
+     * Directories are created first; files are then inflated in parallel.
+     * @return false if any entry failed; the others are still extracted
+     */
+    bool extract(const std::vector<Target>& targets, const std::filesystem::path& destination) const;
+    
+private:
+    bool readCentralDirectory();
+    bool extractFile(const ZipEntry& entry, const std::filesystem::path& path) const;
+    
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+    std::vector<ZipEntry> m_entries;
+};
+
+} // namespace lotro
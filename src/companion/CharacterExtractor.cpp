@@ -5,23 +5,198 @@
  */
 
 #include "CharacterExtractor.hpp"
-#include "PatternScanner.hpp"
+#include "core/AllocationProfiler.hpp"
+#include "core/platform/Platform.hpp"
 
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStringList>
 #include <spdlog/spdlog.h>
 #include <map>
 #include <set>
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <tuple>
 
 namespace lotro {
 
+namespace {
+
+// 64-bit client signatures, in scanner order
+enum Signature64 : size_t {
+    ENTITIES_SIGNATURE,
+    CLIENT_DATA_SIGNATURE,
+    STORAGE_DATA_SIGNATURE,
+    REFERENCES_SIGNATURE,
+};
+
+constexpr auto SIGNATURES_64 = std::tuple{
+    "48895c2408574883ec40488bd9488b0d?3"_pattern,
+    "48893d?3b201b900010000"_pattern,
+    "4883EC28BA02000000488D0D?3"_pattern,
+    "488b05?3488b08488b0cd1428d14c500000000488b4910"_pattern,
+};
+
+// Signature texts, which key the signature cache
+constexpr auto SIGNATURE_TEXTS_64 = std::apply([](const auto&... pattern) {
+    return std::array<const char*, sizeof...(pattern)>{pattern.text...};
+}, SIGNATURES_64);
+
+// Notes saved with memory captures
+constexpr const char* CAPTURE_IS64BIT_NOTE = "client.is64Bit";
+constexpr const char* CAPTURE_SIGNATURES_NOTE = "client.signatures";
+
+
+// Extended-data property tables; names are resolved to IDs once, in
+// resolveExtendedPropertyIds(), and extractFullData() reads the IDs by index
+
+// Property names like "Trait_Virtue_Rank_Charity", "Trait_Virtue_XP_Charity".
+// The suffix is the property name's spelling (from XML analysis).
+struct VirtueDef { const char* key; const char* name; const char* propSuffix; };
+constexpr VirtueDef VIRTUES[] = {
+    {"CHARITY",       "Charity",       "Charity"},
+    {"COMPASSION",    "Compassion",    "Compassionate"},
+    {"CONFIDENCE",    "Confidence",    "Confidence"},
+    {"DETERMINATION", "Determination", "Determination"},
+    {"DISCIPLINE",    "Discipline",    "Discipline"},
+    {"EMPATHY",       "Empathy",       "Empathy"},
+    {"FIDELITY",      "Fidelity",      "Fidelity"},
+    {"FORTITUDE",     "Fortitude",     "Fortitude"},
+    {"HONESTY",       "Honesty",       "Honesty"},
+    {"HONOUR",        "Honour",        "Honour"},
+    {"IDEALISM",      "Idealism",      "Idealism"},
+    {"INNOCENCE",     "Innocence",     "Innocence"},
+    {"JUSTICE",       "Justice",       "Just"},
+    {"LOYALTY",       "Loyalty",       "Loyalty"},
+    {"MERCY",         "Mercy",         "Merciful"},
+    {"PATIENCE",      "Patience",      "Patience"},
+    {"TOLERANCE",     "Tolerance",     "Tolerant"},
+    {"VALOUR",        "Valour",        "Valor"},
+    {"WISDOM",        "Wisdom",        "Wisdom"},
+    {"WIT",           "Wit",           "Wit"},
+    {"ZEAL",          "Zeal",          "Zeal"},
+};
+
+// Property names like "Reputation_Faction_Breeland_Men_CurrentTier"
+// Faction keys: {key, display_name, property_prefix, category}
+// Property prefixes must exactly match factions.xml currentTierProperty/currentReputationProperty
+struct FactionDef { const char* key; const char* name; const char* propPrefix; const char* category; };
+constexpr FactionDef FACTIONS[] = {
+    // Eriador
+    {"BREE", "Men of Bree", "Reputation_Faction_Breeland_Men", "Eriador"},
+    {"SHIRE", "The Mathom Society", "Reputation_Faction_Shire_Mathoms", "Eriador"},
+    {"DWARVES", "Thorin's Hall", "Reputation_Faction_Eredluin_Dwarves", "Eriador"},
+    {"EGLAIN", "The Eglain", "Reputation_Faction_Lonelands_Eglain", "Eriador"},
+    {"ESTELDIN", "Rangers of Esteldín", "Reputation_Faction_Northdowns_Esteldin", "Eriador"},
+    {"RIVENDELL", "Elves of Rivendell", "Reputation_Faction_Rivendell_Elves", "Eriador"},
+    {"ANNUMINAS", "The Wardens of Annúminas", "Reputation_Faction_Evendim_Rangers", "Eriador"},
+    {"COUNCIL_OF_THE_NORTH", "Council of the North", "Reputation_Faction_Angmar_Free_People", "Eriador"},
+    {"LOSSOTH", "Lossoth of Forochel", "Reputation_Faction_Forochel_Lossoth", "Eriador"},
+    // Rhovanion
+    {"MORIA_GUARDS", "Iron Garrison Guards", "Reputation_Faction_Moria_Dwarves_Fast", "Rhovanion"},
+    {"MORIA_MINERS", "Iron Garrison Miners", "Reputation_Faction_Moria_Dwarves_Slow", "Rhovanion"},
+    {"GALADHRIM", "Galadhrim", "Reputation_Faction_Lorien_Elves", "Rhovanion"},
+    {"MALLEDHRIM", "Malledhrim", "Reputation_Faction_Mirkwood_Offensive", "Rhovanion"},
+    {"ELVES_OF_FELEGOTH", "Elves of Felegoth", "Reputation_Faction_Mirkwood_North_Elves", "Rhovanion"},
+    {"MEN_OF_DALE", "Men of Dale", "Reputation_Faction_Mirkwood_North_Men", "Rhovanion"},
+    {"DWARVES_OF_EREBOR", "Dwarves of Erebor", "Reputation_Faction_Mirkwood_North_Dwarves", "Rhovanion"},
+    {"GREY_MOUNTAINS_EXPEDITION", "Grey Mountains Expedition", "Reputation_Faction_Dwarfholds_Eredmithrin", "Rhovanion"},
+    {"WILDERFOLK", "Wilderfolk", "Reputation_Faction_Vales_Of_Anduin", "Rhovanion"},
+    // Dunland
+    {"ALGRAIG", "Algraig, Men of Enedwaith", "Reputation_Faction_Enedwaith_Dunlendings", "Dunland"},
+    {"GREY_COMPANY", "The Grey Company", "Reputation_Faction_Enedwaith_Grey_Company", "Dunland"},
+    {"DUNLAND", "Men of Dunland", "Reputation_Faction_Dunland_Dunlendings", "Dunland"},
+    {"THEODRED_RIDERS", "Théodred's Riders", "Reputation_Faction_Dunland_Theodred", "Dunland"},
+    // Rohan
+    {"STANGARD_RIDERS", "The Riders of Stangard", "Reputation_Faction_Greatriver_Stangard", "Rohan"},
+    {"WOLD", "Men of the Wold", "Reputation_Faction_Rohan_Wold", "Rohan"},
+    {"NORCROFTS", "Men of the Norcrofts", "Reputation_Faction_Rohan_Norcrofts", "Rohan"},
+    {"ENTWASH_VALE", "Men of the Entwash Vale", "Reputation_Faction_Rohan_Entwashvale", "Rohan"},
+    {"SUTCROFTS", "Men of the Sutcrofts", "Reputation_Faction_Rohan_Sutcrofts", "Rohan"},
+    {"EORLINGAS", "The Eorlingas", "Reputation_Faction_Rohan_West_Eorlingas", "Rohan"},
+    {"HELMINGAS", "The Helmingas", "Reputation_Faction_Rohan_West_Helmingas", "Rohan"},
+    {"FANGORN", "The Ents of Fangorn Forest", "Reputation_Faction_Rohan_West_Fangorn", "Rohan"},
+    {"PEOPLE_WILDERMORE", "People of Wildermore", "Reputation_Faction_Wildermore_Basic", "Rohan"},
+    // Gondor
+    {"DOL_AMROTH", "Dol Amroth", "Reputation_Faction_Gondor_West_Amroth", "Gondor"},
+    {"PELARGIR", "Pelargir", "Reputation_Faction_Gondor_Central_Pelargir", "Gondor"},
+    {"RANGERS_ITHILIEN", "Rangers of Ithilien", "Reputation_Faction_Gondor_East_Rangers", "Gondor"},
+    {"MINAS_TIRITH", "Defenders of Minas Tirith", "Reputation_Faction_Gondor_Minas_Tirith", "Gondor"},
+    // Mordor
+    {"HOST_OF_THE_WEST", "Host of the West", "Reputation_Faction_Mountains_Shadow_Host_West", "Mordor"},
+    {"GORGOROTH", "Conquest of Gorgoroth", "Reputation_Faction_Mordor_Gorgoroth", "Mordor"},
+};
+
+// Property names like "Craft_Scholar_MasteryLevel", "Craft_Scholar_ProficiencyLevel"
+constexpr const char* PROFESSIONS[] = {
+    "Scholar", "Metalsmith", "Jeweller", "Tailor", "Weaponsmith",
+    "Woodworker", "Cook", "Farmer", "Forester", "Prospector",
+};
+
+// Equipment slots use Inventory_SlotCache_Eq_* property names (type 7 = entity ID)
+struct EquipmentSlotDef { const char* slot; const char* property; };
+constexpr EquipmentSlotDef EQUIPMENT_SLOTS[] = {
+    {"HEAD",       "Inventory_SlotCache_Eq_Head"},
+    {"SHOULDERS",  "Inventory_SlotCache_Eq_Shoulder"},
+    {"CHEST",      "Inventory_SlotCache_Eq_Chest"},
+    {"HANDS",      "Inventory_SlotCache_Eq_Gloves"},
+    {"LEGS",       "Inventory_SlotCache_Eq_Legs"},
+    {"FEET",       "Inventory_SlotCache_Eq_Boots"},
+    {"BACK",       "Inventory_SlotCache_Eq_Back"},
+    {"MAIN_HAND",  "Inventory_SlotCache_Eq_Weapon_Primary"},
+    {"OFF_HAND",   "Inventory_SlotCache_Eq_Weapon_Secondary"},
+    {"RANGED",     "Inventory_SlotCache_Eq_RangedWeapon"},
+    {"POCKET",     "Inventory_SlotCache_Eq_Pocket1"},
+    {"EAR1",       "Inventory_SlotCache_Eq_Earring1"},
+    {"EAR2",       "Inventory_SlotCache_Eq_Earring2"},
+    {"NECK",       "Inventory_SlotCache_Eq_Necklace"},
+    {"WRIST1",     "Inventory_SlotCache_Eq_Bracelet1"},
+    {"WRIST2",     "Inventory_SlotCache_Eq_Bracelet2"},
+    {"RING1",      "Inventory_SlotCache_Eq_Ring1"},
+    {"RING2",      "Inventory_SlotCache_Eq_Ring2"},
+    {"CLASS_SLOT", "Inventory_SlotCache_Eq_Class"},
+    {"CRAFT_TOOL", "Inventory_SlotCache_Eq_CraftTool"},
+};
+
+// Common wallet currencies with their property names
+struct CurrencyDef { int id; const char* property; };
+constexpr CurrencyDef CURRENCIES[] = {
+    {1, "Wallet_Currency_Marks"},
+    {2, "Wallet_Currency_Medallions"},
+    {3, "Wallet_Currency_Seals"},
+    {4, "Wallet_Currency_MithrilCoins"},
+    {5, "Wallet_Currency_Commendations"},
+    {6, "Wallet_Currency_Skirmish_Marks"},
+    {7, "Wallet_Currency_Fate_Tokens"},
+    {8, "Wallet_Currency_Hobbit_Presents"},
+    {9, "Wallet_Currency_Silver_Tokens"},
+    {10, "Wallet_Currency_Gift_Mathom"},
+    {11, "Wallet_Currency_Crafting_Guild"},
+    {12, "Wallet_Currency_AnniversaryTokens"},
+    {13, "Wallet_Currency_FestivalTokens"},
+    {14, "Wallet_Currency_Figments"},
+    {15, "Wallet_Currency_MoriaShards"},
+};
+
+constexpr const char* TITLE_CANDIDATES[] = {
+    "Title_ActiveTitleDID",       // Confirmed working - contains title DID
+    "Advancement_CurrentTitle", "AdvTable_CurrentTitle", "Player_CurrentTitle",
+    "Agent_CurrentTitle", "CurrentTitle"
+};
+
+} // anonymous namespace
+
 CharacterExtractor::CharacterExtractor(const QString& gamePath)
     : m_memory(std::make_unique<ProcessMemory>())
     , m_gamePath(gamePath)
 {
     // Initialize DataFacade if game path is provided
     if (!m_gamePath.isEmpty()) {
-        m_datFacade = std::make_unique<dat::DataFacade>(m_gamePath);
+        m_datFacade = dat::DataFacade::shared(m_gamePath);
         if (m_datFacade->initialize()) {
             // Resolve property IDs
             if (auto* registry = m_datFacade->getPropertiesRegistry()) {
@@ -138,7 +313,8 @@ CharacterExtractor::CharacterExtractor(const QString& gamePath)
                     searchAndLog("Gold", 20);
                     searchAndLog("Wallet", 20);
                 }
-
+                
+                resolveExtendedPropertyIds(*registry);
             }
         } else {
             spdlog::warn("Failed to initialize DAT file access");
@@ -150,7 +326,71 @@ CharacterExtractor::~CharacterExtractor() {
     disconnect();
 }
 
+void CharacterExtractor::resolveExtendedPropertyIds(const dat::PropertiesRegistry& registry) {
+    auto id = [&registry](const QString& name) { return registry.getPropertyId(name); };
+    
+    ExtendedPropertyIds ids;
+    
+    for (const auto& virtue : VIRTUES) {
+        ids.virtues.push_back({
+            id(QStringLiteral("Trait_Virtue_Rank_%1").arg(QLatin1String(virtue.propSuffix))),
+            id(QStringLiteral("Trait_Virtue_XP_%1").arg(QLatin1String(virtue.propSuffix))),
+        });
+    }
+    
+    for (const auto& faction : FACTIONS) {
+        ids.factions.push_back({
+            id(QStringLiteral("%1_CurrentTier").arg(QLatin1String(faction.propPrefix))),
+            id(QStringLiteral("%1_EarnedReputation").arg(QLatin1String(faction.propPrefix))),
+        });
+    }
+    
+    for (const char* profession : PROFESSIONS) {
+        QLatin1String name(profession);
+        ids.professions.push_back({
+            id(QStringLiteral("Craft_%1_Enabled").arg(name)),
+            id(QStringLiteral("Craft_%1_MasteryLevel").arg(name)),
+            id(QStringLiteral("Craft_%1_ProficiencyLevel").arg(name)),
+            id(QStringLiteral("Craft_%1_MasteryXP").arg(name)),
+            id(QStringLiteral("Craft_%1_ProficiencyXP").arg(name)),
+        });
+    }
+    
+    for (const auto& slot : EQUIPMENT_SLOTS) {
+        int propId = id(QString::fromLatin1(slot.property));
+        if (propId == -1) {
+            spdlog::debug("Equipment property '{}' not found in registry", slot.property);
+        }
+        ids.equipment.push_back(propId);
+    }
+    
+    for (const auto& currency : CURRENCIES) {
+        ids.currencies.push_back(id(QString::fromLatin1(currency.property)));
+    }
+    
+    for (int i = 0; i < static_cast<int>(std::size(TITLE_CANDIDATES)); ++i) {
+        int propId = id(QString::fromLatin1(TITLE_CANDIDATES[i]));
+        if (propId != -1) {
+            ids.title = propId;
+            ids.titleCandidate = i;
+            spdlog::info("Title property '{}' resolved to ID {}", TITLE_CANDIDATES[i], propId);
+            break;
+        }
+    }
+    
+    ids.emotes = id(QStringLiteral("Emote_GrantedList"));
+    if (ids.emotes == -1) {
+        spdlog::debug("Emote_GrantedList property not found in registry");
+    }
+    
+    ids.resolved = true;
+    m_extendedIds = std::move(ids);
+}
+
 bool CharacterExtractor::connect() {
+    // A new connection reports everything once
+    m_haveGroupHashes = false;
+    
     // Find LOTRO client process
     auto clientInfo = ProcessMemory::findLotroClient();
     if (!clientInfo) {
@@ -168,15 +408,40 @@ bool CharacterExtractor::connect() {
         return false;
     }
     
+    if (m_dirtyPageTracking && !m_memory->enableDirtyTracking()) {
+        spdlog::info("Dirty page tracking unavailable, syncs read every page");
+    }
+    
+    if (!m_capturePath.isEmpty()) {
+        m_memory->startRecording();
+        m_memory->setRecordingNote(CAPTURE_IS64BIT_NOTE, clientInfo->is64Bit ? "1" : "0");
+    }
+    return finishConnect(clientInfo->is64Bit);
+}
+
+bool CharacterExtractor::connectRecording(const QString& path) {
+    m_haveGroupHashes = false;
+    
+    if (!m_memory->openRecording(path.toStdString())) {
+        m_lastError = QString("Failed to open memory capture %1").arg(path);
+        return false;
+    }
+    // The architecture as the client was found, which can differ from the
+    // Wine loader's that ProcessMemory sees
+    bool is64Bit = m_memory->recordingNote(CAPTURE_IS64BIT_NOTE).value_or("1") == "1";
+    return finishConnect(is64Bit);
+}
+
+bool CharacterExtractor::finishConnect(bool is64Bit) {
     // Set configuration based on architecture
-    if (clientInfo->is64Bit) {
+    if (is64Bit) {
         m_config = LotroMemoryConfig::config64Bit();
     } else {
         m_config = LotroMemoryConfig::config32Bit();
     }
     
     // Get module base address
-    std::string moduleName = clientInfo->is64Bit ? "lotroclient64.exe" : "lotroclient.exe";
+    std::string moduleName = is64Bit ? "lotroclient64.exe" : "lotroclient.exe";
     auto baseAddr = m_memory->getModuleBaseAddress(moduleName);
     if (!baseAddr) {
         m_lastError = QString("Failed to find %1 module").arg(QString::fromStdString(moduleName));
@@ -208,6 +473,9 @@ bool CharacterExtractor::connect() {
 
 void CharacterExtractor::disconnect() {
     m_memory->close();
+    m_tables.clear();
+    m_playerCache.reset();
+    m_haveGroupHashes = false;
     m_server.clear();
     m_account.clear();
 }
@@ -216,22 +484,26 @@ bool CharacterExtractor::isConnected() const {
     return m_memory->isOpen();
 }
 
+bool CharacterExtractor::isGameActive() const {
+    return m_memory->isActive();
+}
+
 bool CharacterExtractor::readClientData() {
     // Try to read client data structure
     // The client data contains server name, language, etc.
     
     uint64_t clientDataAddr = m_config.clientDataAddress();
-    spdlog::debug("Reading client data from 0x{:X}", clientDataAddr);
+    SPDLOG_DEBUG("Reading client data from 0x{:X}", clientDataAddr);
     
     // 1. Dereference global pointer to get ClientData struct address
     auto clientDataStructPtr = m_memory->readPointer(clientDataAddr);
     if (!clientDataStructPtr || *clientDataStructPtr == 0) {
-        spdlog::debug("Client data struct pointer is null");
+        SPDLOG_DEBUG("Client data struct pointer is null");
         return false;
     }
     
     uint64_t dataStructAddr = *clientDataStructPtr;
-    spdlog::debug("ClientData struct at 0x{:X}", dataStructAddr);
+    SPDLOG_DEBUG("ClientData struct at 0x{:X}", dataStructAddr);
     
     // 2. Read Server Name
     // It's a pointer at offset 312 (64-bit) or 180 (32-bit)
@@ -295,70 +567,29 @@ std::optional<QString> CharacterExtractor::getAccountName() {
 }
 
 std::optional<uint64_t> CharacterExtractor::readHashtableValue(uint64_t hashtableBaseAddr, uint32_t propId) {
-    // 64-bit hashtable layout:
-    // +16: Buckets Array Pointer
-    // +32: NbBuckets (int)
-    
-    // Read header (enough for buckets ptr and nbBuckets)
-    auto headBuf = m_memory->readMemory(hashtableBaseAddr, 48);
-    if (!headBuf) return std::nullopt;
-    
-    // TODO: Handle 32-bit offsets if needed (for now focused on 64-bit)
-    uint64_t bucketsPtr = headBuf->readPointer(16, true);
-    uint32_t nbBuckets = headBuf->read<uint32_t>(32);
-    
-    if (bucketsPtr == 0 || nbBuckets == 0 || nbBuckets > 100000) return std::nullopt;
-    
-    uint32_t bucketIdx = propId % nbBuckets;
-    
-    // Read bucket head pointer
-    auto bucketHeadPtrBuf = m_memory->readPointer(bucketsPtr + bucketIdx * 8);
-    if (!bucketHeadPtrBuf) return std::nullopt;
-    
-    uint64_t nodePtr = *bucketHeadPtrBuf;
-    
-    // Traverse bucket (hashed lookup)
-    int iterations = 0;
-    while (nodePtr != 0 && iterations++ < 50) {
-        auto nodeBuf = m_memory->readMemory(nodePtr, 32);
-        if (!nodeBuf) break;
-        
-        // ID is at 0 (aligned to 8 bytes in 64-bit map node)
-        uint32_t id = nodeBuf->read<uint32_t>(0);
-        if (id == propId) {
-            // Value is at offset 24
-            return nodeBuf->read<uint64_t>(24);
-        }
-        
-        // Next pointer at offset 8
-        nodePtr = nodeBuf->readPointer(8, true);
+    const RemoteHashtable* table = propertyTable(hashtableBaseAddr);
+    return table ? table->find(propId) : std::nullopt;
+}
+
+const RemoteHashtable* CharacterExtractor::propertyTable(uint64_t hashtableBaseAddr) {
+    if (!m_memory->inSnapshot() || m_memory->snapshotGeneration() != m_tablesGeneration) {
+        m_tables.clear();
+        m_tablesGeneration = m_memory->snapshotGeneration();
     }
     
-    // Hashed bucket failed — try linear scan of ALL buckets 
-    // This handles cases where the hash function differs from simple modulo
-    for (uint32_t i = 0; i < nbBuckets && i < 2048; i++) {
-        if (i == bucketIdx) continue; // Already checked
+    auto [it, inserted] = m_tables.try_emplace(hashtableBaseAddr);
+    if (inserted) {
+        QElapsedTimer timer;
+        timer.start();
+        it->second.load(*m_memory, hashtableBaseAddr, m_hops, m_nextHops);
         
-        auto bpBuf = m_memory->readPointer(bucketsPtr + i * 8);
-        if (!bpBuf) continue;
-        
-        uint64_t np = *bpBuf;
-        int iter2 = 0;
-        while (np != 0 && iter2++ < 50) {
-            auto nb = m_memory->readMemory(np, 32);
-            if (!nb) break;
-            
-            uint32_t id = nb->read<uint32_t>(0);
-            if (id == propId) {
-                spdlog::info("Property {} found in bucket {} (expected bucket {} with {} total buckets)",
-                             propId, i, bucketIdx, nbBuckets);
-                return nb->read<uint64_t>(24);
-            }
-            np = nb->readPointer(8, true);
+        uint64_t elapsedUs = static_cast<uint64_t>(timer.nsecsElapsed() / 1000);
+        m_propertyReadUs += elapsedUs;
+        if (m_metrics) {
+            m_metrics->record(SyncStage::PropertyRead, elapsedUs);
         }
     }
-    
-    return std::nullopt;
+    return it->second.isValid() ? &it->second : nullptr;
 }
 
 std::optional<uint64_t> CharacterExtractor::readAccountPropertyValue(uint32_t propId) {
@@ -449,11 +680,28 @@ std::optional<uint64_t> CharacterExtractor::readStoragePropertyValue(uint32_t pr
     return std::nullopt;
 }
 std::optional<uint64_t> CharacterExtractor::findPlayerEntity() {
+    // One read of the player's table node: while it still maps the same
+    // instance to the same entity (no zone change, no character switch)
+    // the entity is still the player
+    if (m_playerCache) {
+        auto node = m_memory->readMemory(m_playerCache->nodeAddress, 24);
+        if (node && node->read<uint64_t>(0) == m_playerCache->instanceId
+            && node->readPointer(16, true) == m_playerCache->address) {
+            return m_playerCache->address;
+        }
+        spdlog::info("Cached player entity 0x{:X} is gone, rescanning entities table", m_playerCache->address);
+        m_playerCache.reset();
+    }
+    return scanEntitiesTable();
+}
+
+std::optional<uint64_t> CharacterExtractor::scanEntitiesTable() {
     // The entities table contains all game entities including the player
     // We need to traverse the table to find the player entity
+    m_entityScanGeneration = m_memory->snapshotGeneration();
     
     uint64_t entitiesTableAddr = m_config.entitiesTableAddress();
-    spdlog::debug("Searching entities table at 0x{:X}", entitiesTableAddr);
+    SPDLOG_DEBUG("Searching entities table at 0x{:X}", entitiesTableAddr);
     
 
     // Scan entities to find the main player
@@ -461,13 +709,14 @@ std::optional<uint64_t> CharacterExtractor::findPlayerEntity() {
     // We also look for specific string properties (Name).
     
     struct EntityCandidate {
-        uint64_t address;
-        uint64_t instanceId;
-        int propertyCount;
-        std::map<uint32_t, std::string> stringProperties;
+        uint64_t nodeAddress = 0;
+        uint64_t address = 0;
+        uint64_t instanceId = 0;
+        int propertyCount = 0;
     };
     
-    std::vector<EntityCandidate> candidates;
+    EntityCandidate best;
+    int candidateCount = 0;
     
 
     // Read table header
@@ -481,7 +730,7 @@ std::optional<uint64_t> CharacterExtractor::findPlayerEntity() {
     }
     
     uint64_t tableAddr = *tablePtrBuf;
-    spdlog::debug("Entities Table at 0x{:X}", tableAddr);
+    SPDLOG_DEBUG("Entities Table at 0x{:X}", tableAddr);
 
     auto tableHeader = m_memory->readMemory(tableAddr, 8 * 8); // Read enough for header
     if (!tableHeader) {
@@ -501,7 +750,7 @@ std::optional<uint64_t> CharacterExtractor::findPlayerEntity() {
     uint32_t nbBuckets = tableHeader->read<uint32_t>(5 * 8);
     uint32_t nbElements = tableHeader->read<uint32_t>(5 * 8 + 4);
     
-    spdlog::debug("Entities Table: buckets={}, elements={}, array=0x{:X}", nbBuckets, nbElements, bucketsArrayPtr);
+    SPDLOG_DEBUG("Entities Table: buckets={}, elements={}, array=0x{:X}", nbBuckets, nbElements, bucketsArrayPtr);
     
     if (bucketsArrayPtr == 0 || nbBuckets == 0 || nbBuckets > 100000) {
         spdlog::warn("Invalid Entities Table data");
@@ -518,90 +767,107 @@ std::optional<uint64_t> CharacterExtractor::findPlayerEntity() {
     
     int scannedCount = 0;
     
+    // Node layout (EntityTableController.java, 64-bit defaults):
+    // 0: InstanceID, 8: Next, 16: WorldEntityPtr
+    m_entityNodes.clear();
+    
+    // Walk all bucket chains in lockstep, so each hop down the chains is a
+    // single batched read instead of one read per node
+    m_hops.clear();
     for (uint32_t i = 0; i < nbBuckets; i++) {
         uint64_t nodePtr = bucketsBuffer->readPointer(i * 8, true);
-        
-        while (nodePtr != 0) {
-            // Read node: [InstanceID (8)] [WorldEntityPtr (8)] [NextPtr (8)] ... maybe
-            // EntityTableController:
-            // entryBuffer.getLong(0L) -> instanceID
-            // entryBuffer.getPointer(WorldEntityOffset) -> worldEntityPointer
-            // entryBuffer.getPointer(8L) -> next ?? Wait.
-            
-            // Check EntityTableController.java line 87: bucketSize = 24 (default? prop says 24).
-            // line 94: entity = loadTableEntry(instanceID, worldEntityPointer = entryBuffer.getPointer(WorldEntityOffset))
-            // line 98: next = entryBuffer.getPointer(8L)
-            
-            // If WorldEntityOffset is 16 (from 64bits.properties defaults in code), and Next is at 8.
-            // Layout: 0: ID, 8: Next, 16: WorldEntityPtr.
-            
-            auto nodeBuf = m_memory->readMemory(nodePtr, 32);
-            if (!nodeBuf) break;
+        if (nodePtr != 0) {
+            m_hops.add(nodePtr, 32);
+        }
+    }
+    
+    while (!m_hops.empty() && scannedCount <= 5000) { // Safety
+        m_hops.run(*m_memory);
+        m_nextHops.clear();
+        for (size_t k = 0; k < m_hops.size(); k++) {
+            MemoryView nodeBuf = m_hops.view(k);
+            if (nodeBuf.empty()) continue;
             
-            uint64_t instanceId = nodeBuf->read<uint64_t>(0);
-            uint64_t nextPtr = nodeBuf->readPointer(8, true);
-            uint64_t worldEntityPtr = nodeBuf->readPointer(16, true); // Assuming Offset 16
+            uint64_t instanceId = nodeBuf.read<uint64_t>(0);
+            uint64_t nextPtr = nodeBuf.readPointer(8, true);
+            uint64_t worldEntityPtr = nodeBuf.readPointer(16, true); // Assuming Offset 16
             
             if (worldEntityPtr != 0) {
-                // Read ConstructionInfo DataID for ALL entities (for equipment lookup)
-                // ConstructionInfo pointer at offset 288 (64-bit) / 152 (32-bit)
-                auto entityBuf = m_memory->readMemory(worldEntityPtr, 300);
-                if (entityBuf) {
-                    uint64_t ciOffset = m_config.is64Bit ? 288 : 152;
-                    uint64_t ciPtr = entityBuf->readPointer(ciOffset, true);
-                    if (ciPtr != 0) {
-                        int ptrSize = m_config.is64Bit ? 8 : 4;
-                        auto ciBuf = m_memory->readMemory(ciPtr, ptrSize + 8);
-                        if (ciBuf) {
-                            uint32_t dataId = ciBuf->read<uint32_t>(ptrSize + 4);
-                            if (dataId != 0) {
-                                m_entityDataIds[instanceId] = dataId;
-                            }
-                        }
-                    }
-                    
-                    // Also check if this entity has many properties (player candidate)
-                    uint64_t eppPtr = entityBuf->readPointer(192, true);
-                    if (eppPtr != 0) {
-                        auto eppBuf = m_memory->readMemory(eppPtr, 256);
-                        if (eppBuf) {
-                             uint64_t propBucketsPtr = eppBuf->readPointer(72, true);
-                             uint32_t propNbBuckets = eppBuf->read<uint32_t>(88);
-                             uint32_t propNbElements = eppBuf->read<uint32_t>(88 + 4);
-                             
-                             if (propNbElements > 10) {
-                                 EntityCandidate candidate;
-                                 candidate.address = worldEntityPtr;
-                                 candidate.instanceId = instanceId;
-                                 candidate.propertyCount = (int)propNbElements;
-                                 candidates.push_back(candidate);
-                             }
-                        }
-                    }
-                }
+                m_entityNodes.push_back({m_hops.address(k), instanceId, worldEntityPtr});
+            }
+            if (nextPtr != 0) {
+                m_nextHops.add(nextPtr, 32);
             }
-            
-            nodePtr = nextPtr;
             scannedCount++;
-            if (scannedCount > 5000) break; // Safety
         }
+        std::swap(m_hops, m_nextHops);
+    }
+    
+    // Read every world entity in one batch
+    m_entityReads.clear();
+    for (const auto& node : m_entityNodes) {
+        m_entityReads.add(node.worldEntityPtr, 300);
+    }
+    m_entityReads.run(*m_memory);
+    
+    // Then their ConstructionInfo and property providers in another.
+    // ConstructionInfo pointer at offset 288 (64-bit) / 152 (32-bit)
+    const uint64_t ciOffset = m_config.is64Bit ? 288 : 152;
+    const int ptrSize = m_config.is64Bit ? 8 : 4;
+    m_entityLinks.clear();
+    m_linkReads.clear();
+    for (size_t i = 0; i < m_entityReads.size(); ++i) {
+        MemoryView entity = m_entityReads.view(i);
+        if (entity.empty()) continue;
+        EntityLinks entry{i};
+        uint64_t ciPtr = entity.readPointer(ciOffset, true);
+        if (ciPtr != 0) {
+            entry.ciRead = static_cast<int>(m_linkReads.add(ciPtr, static_cast<size_t>(ptrSize + 8)));
+        }
+        // Also check if this entity has many properties (player candidate)
+        uint64_t eppPtr = entity.readPointer(192, true);
+        if (eppPtr != 0) {
+            entry.eppRead = static_cast<int>(m_linkReads.add(eppPtr, 256));
+        }
+        m_entityLinks.push_back(entry);
     }
+    m_linkReads.run(*m_memory);
     
-
-    spdlog::info("Scanned {} entities, found {} candidates with props > 10, {} entity DataIDs collected", 
-                 scannedCount, candidates.size(), m_entityDataIds.size());
+    for (const auto& entry : m_entityLinks) {
+        const EntityNode& node = m_entityNodes[entry.node];
+        
+        // ConstructionInfo DataID for ALL entities (for equipment lookup)
+        if (entry.ciRead >= 0 && m_linkReads.ok(entry.ciRead)) {
+            uint32_t dataId = m_linkReads.view(entry.ciRead).read<uint32_t>(ptrSize + 4);
+            if (dataId != 0) {
+                m_entityDataIds[node.instanceId] = dataId;
+            }
+        }
+        
+        if (entry.eppRead >= 0 && m_linkReads.ok(entry.eppRead)) {
+            uint32_t propNbElements = m_linkReads.view(entry.eppRead).read<uint32_t>(88 + 4);
+            if (propNbElements > 10) {
+                // Keep the entity with the most properties
+                candidateCount++;
+                if ((int)propNbElements > best.propertyCount) {
+                    best.nodeAddress = node.nodeAddress;
+                    best.address = node.worldEntityPtr;
+                    best.instanceId = node.instanceId;
+                    best.propertyCount = (int)propNbElements;
+                }
+            }
+        }
+    }
     
-    // Sort by property count desc
-    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
-        return a.propertyCount > b.propertyCount;
-    });
+    spdlog::info("Scanned {} entities, found {} candidates with props > 10, {} entity DataIDs collected", 
+                 scannedCount, candidateCount, m_entityDataIds.size());
     
     // Return the top candidate
-    if (!candidates.empty()) {
-        auto& top = candidates[0];
+    if (candidateCount > 0) {
         spdlog::info("Found Player Entity candidate: ID {:X}, Props {}, Addr 0x{:X}", 
-                     top.instanceId, top.propertyCount, top.address);
-        return top.address;
+                     best.instanceId, best.propertyCount, best.address);
+        m_playerCache = PlayerEntityCache{best.nodeAddress, best.instanceId, best.address};
+        return best.address;
     }
     
     return std::nullopt;
@@ -645,11 +911,77 @@ static QString mapRaceId(int id) {
 }
 
 std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
+    allocation::Scope allocScope(allocation::Tag::Sync);
     if (!isConnected()) {
         m_lastError = "Not connected to LOTRO client";
         return std::nullopt;
     }
     
+    // One consistent read of the client; repeated reads hit the page cache
+    ProcessMemory::SnapshotScope snapshot(*m_memory);
+    
+    // Find player entity
+    std::optional<uint64_t> playerEntity;
+    {
+        SyncMetrics::ScopedTimer timer(m_metrics, SyncStage::PlayerLookup);
+        playerEntity = findPlayerEntity();
+    }
+    if (!playerEntity) {
+        m_lastError = "Player entity not found";
+        return std::nullopt;
+    }
+    
+    QElapsedTimer decodeTimer;
+    decodeTimer.start();
+    uint64_t propertyReadUs = m_propertyReadUs;
+    CharacterInfo info = decodeCharacter(*playerEntity);
+    recordDecode(decodeTimer, propertyReadUs);
+    finishCapture(info);
+    return info;
+}
+
+void CharacterExtractor::finishCapture(const CharacterInfo& info) {
+    if (!m_memory->isRecording()) {
+        return;
+    }
+    m_memory->setRecordingNote("character.name", info.name.toStdString());
+    m_memory->setRecordingNote("character.class", info.className.toStdString());
+    m_memory->setRecordingNote("character.level", std::to_string(info.level));
+    m_memory->setRecordingNote("character.copper", std::to_string(info.totalCopper()));
+    m_memory->saveRecording(m_capturePath.toStdString());
+    m_capturePath.clear();
+}
+
+std::optional<CharacterInfo> CharacterExtractor::capturedCharacter() const {
+    auto name = m_memory->recordingNote("character.name");
+    if (!name) {
+        return std::nullopt;
+    }
+    auto number = [this](const std::string& key) {
+        return std::atoll(m_memory->recordingNote(key).value_or("0").c_str());
+    };
+    
+    CharacterInfo info;
+    info.name = QString::fromStdString(*name);
+    info.className = QString::fromStdString(m_memory->recordingNote("character.class").value_or(""));
+    info.level = static_cast<int>(number("character.level"));
+    const long long copper = number("character.copper");
+    info.gold = static_cast<int>(copper / 100000);
+    info.silver = static_cast<int>(copper / 100 % 1000);
+    info.copper = static_cast<int>(copper % 100);
+    return info;
+}
+
+void CharacterExtractor::recordDecode(const QElapsedTimer& timer, uint64_t propertyReadUsBefore) {
+    if (!m_metrics) {
+        return;
+    }
+    uint64_t elapsedUs = static_cast<uint64_t>(timer.nsecsElapsed() / 1000);
+    uint64_t readUs = m_propertyReadUs - propertyReadUsBefore;
+    m_metrics->record(SyncStage::Decode, elapsedUs > readUs ? elapsedUs - readUs : 0);
+}
+
+CharacterInfo CharacterExtractor::decodeCharacter(uint64_t playerEntity) {
     CharacterInfo info;
     
     // Get server name
@@ -684,106 +1016,78 @@ std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
         auto val = readAccountIntProperty(m_destinyPointsPropertyId);
         if (val) {
             info.destinyPoints = *val;
-            spdlog::info("Destiny Points: {}", *val);
+            SPDLOG_DEBUG("Destiny Points: {}", *val);
         } else {
             spdlog::warn("Failed to read destiny points (propId={})", m_destinyPointsPropertyId);
         }
     } else {
         spdlog::warn("Destiny points property ID not resolved from DAT");
     }
-
-    
-    // Find player entity
-    auto playerEntity = findPlayerEntity();
-    if (!playerEntity) {
-        m_lastError = "Player entity not found";
-        return std::nullopt;
-    }
     
     // One-shot property discovery: scan ALL properties on the entity
     // to find the actual property IDs for class, race, money, vitals
     static bool propertyDiscoveryDone = false;
     if (!propertyDiscoveryDone && m_datFacade) {
         propertyDiscoveryDone = true;
-        spdlog::info("=== ENTITY PROPERTY DISCOVERY (Entity 0x{:X}) ===", *playerEntity);
+        spdlog::info("=== ENTITY PROPERTY DISCOVERY (Entity 0x{:X}) ===", playerEntity);
         
         // Get EPP
         uint64_t eppOffset = m_config.is64Bit ? 192 : 108;
-        auto entBuf = m_memory->readMemory(*playerEntity, 256);
+        auto entBuf = m_memory->readMemory(playerEntity, 256);
         if (entBuf) {
             uint64_t eppPtr = entBuf->readPointer(eppOffset, true);
-            if (eppPtr != 0) {
-                auto eppBuf = m_memory->readMemory(eppPtr, 128);
-                if (eppBuf) {
-                    uint64_t bucketsPtr = eppBuf->readPointer(72, true);
-                    uint32_t nbBuckets = eppBuf->read<uint32_t>(88);
+            const RemoteHashtable* table = eppPtr != 0 ? propertyTable(eppPtr + 56) : nullptr;
+            if (table) {
+                spdlog::info("EPP hashtable: {} properties", table->size());
+                
+                int totalProps = 0;
+                int matchedProps = 0;
+                auto* registry = m_datFacade->getPropertiesRegistry();
+                
+                // Keywords to filter for 
+                std::vector<std::string> keywords = {
+                    "class", "race", "species", "money", "currency", "gold", "silver", "copper",
+                    "vital", "morale", "power", "health", "mana",
+                    "level", "wallet", "inventory", "lotro", "mithril",
+                    "advancement", "advtable", "agent", "title", "rank", "surname"
+                };
+                
+                for (const RemoteHashtable::Entry& entry : table->entries()) {
+                    uint32_t id = entry.id;
+                    uint64_t value = entry.value;
+                    totalProps++;
                     
-                    spdlog::info("EPP hashtable: bucketsPtr=0x{:X}, nbBuckets={}", bucketsPtr, nbBuckets);
+                    // Resolve name from DAT registry
+                    std::string propName = "UNKNOWN";
+                    dat::PropertyType propType = dat::PropertyType::UNKNOWN;
+                    if (registry) {
+                        auto def = registry->getPropertyDef(id);
+                        if (def) {
+                            propName = def->name().toStdString();
+                            propType = def->type();
+                        }
+                    }
                     
-                    if (bucketsPtr != 0 && nbBuckets > 0 && nbBuckets < 10000) {
-                        auto bucketsBuf = m_memory->readMemory(bucketsPtr, nbBuckets * 8);
-                        if (bucketsBuf) {
-                            int totalProps = 0;
-                            int matchedProps = 0;
-                            auto* registry = m_datFacade->getPropertiesRegistry();
-                            
-                            // Keywords to filter for 
-                            std::vector<std::string> keywords = {
-                                "class", "race", "species", "money", "currency", "gold", "silver", "copper",
-                                "vital", "morale", "power", "health", "mana",
-                                "level", "wallet", "inventory", "lotro", "mithril",
-                                "advancement", "advtable", "agent", "title", "rank", "surname"
-                            };
-                            
-                            for (uint32_t i = 0; i < nbBuckets; i++) {
-                                uint64_t nodePtr = bucketsBuf->readPointer(i * 8, true);
-                                
-                                while (nodePtr != 0) {
-                                    auto nodeBuf = m_memory->readMemory(nodePtr, 32);
-                                    if (!nodeBuf) break;
-                                    
-                                    uint32_t id = nodeBuf->read<uint32_t>(0);
-                                    uint64_t value = nodeBuf->read<uint64_t>(24);
-                                    uint64_t nextPtr = nodeBuf->readPointer(8, true);
-                                    totalProps++;
-                                    
-                                    // Resolve name from DAT registry
-                                    std::string propName = "UNKNOWN";
-                                    dat::PropertyType propType = dat::PropertyType::UNKNOWN;
-                                    if (registry) {
-                                        auto def = registry->getPropertyDef(id);
-                                        if (def) {
-                                            propName = def->name().toStdString();
-                                            propType = def->type();
-                                        }
-                                    }
-                                    
-                                    // Check if name matches any keyword
-                                    std::string lowerName = propName;
-                                    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-                                    
-                                    bool matches = false;
-                                    for (const auto& kw : keywords) {
-                                        if (lowerName.find(kw) != std::string::npos) {
-                                            matches = true;
-                                            break;
-                                        }
-                                    }
-                                    
-                                    if (matches) {
-                                        spdlog::info("  MATCH: {} (ID={}, type={}, value=0x{:X}, int32={})",
-                                                     propName, id, static_cast<int>(propType), value, static_cast<int32_t>(value));
-                                        matchedProps++;
-                                    }
-                                    
-                                    nodePtr = nextPtr;
-                                }
-                            }
-                            spdlog::info("=== Discovery complete: {} total properties, {} keyword matches ===", 
-                                         totalProps, matchedProps);
+                    // Check if name matches any keyword
+                    std::string lowerName = propName;
+                    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+                    
+                    bool matches = false;
+                    for (const auto& kw : keywords) {
+                        if (lowerName.find(kw) != std::string::npos) {
+                            matches = true;
+                            break;
                         }
                     }
+                    
+                    if (matches) {
+                        spdlog::info("  MATCH: {} (ID={}, type={}, value=0x{:X}, int32={})",
+                                     propName, id, static_cast<int>(propType), value, static_cast<int32_t>(value));
+                        matchedProps++;
+                    }
                 }
+                spdlog::info("=== Discovery complete: {} total properties, {} keyword matches ===", 
+                             totalProps, matchedProps);
             }
         }
     }
@@ -791,7 +1095,7 @@ std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
     // Read basic info via properties
     // Read Name
     if (m_namePropertyId != -1) {
-        auto name = readStringProperty(*playerEntity, m_namePropertyId);
+        auto name = readStringProperty(playerEntity, m_namePropertyId);
         if (name) {
             info.name = *name;
         } else {
@@ -803,7 +1107,7 @@ std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
     
     // Read Level
     if (m_levelPropertyId != -1) {
-        auto level = readIntProperty(*playerEntity, m_levelPropertyId);
+        auto level = readIntProperty(playerEntity, m_levelPropertyId);
         if (level) {
             info.level = *level;
         }
@@ -812,14 +1116,14 @@ std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
     // Read Class
     if (m_classPropertyId != -1) {
         // Try as raw value first for diagnostics
-        auto rawVal = readPropertyValue(*playerEntity, m_classPropertyId);
+        auto rawVal = readPropertyValue(playerEntity, m_classPropertyId);
         if (rawVal) {
-            spdlog::info("Class raw property value: 0x{:X} (int32={})", *rawVal, static_cast<int>(*rawVal));
+            SPDLOG_DEBUG("Class raw property value: 0x{:X} (int32={})", *rawVal, static_cast<int>(*rawVal));
             int classId = static_cast<int>(*rawVal);
             info.className = mapClassId(classId);
-            spdlog::info("Class ID {} -> {}", classId, info.className.toStdString());
+            SPDLOG_DEBUG("Class ID {} -> {}", classId, info.className.toStdString());
         } else {
-            spdlog::warn("Failed to read class property {} from entity 0x{:X}", m_classPropertyId, *playerEntity);
+            spdlog::warn("Failed to read class property {} from entity 0x{:X}", m_classPropertyId, playerEntity);
         }
     } else {
         spdlog::warn("Class property ID not resolved from DAT (name='Agent_Class')");
@@ -828,14 +1132,14 @@ std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
     // Read Race via Agent_Species property (confirmed working from entity property discovery)
     // Known race codes: Man=23, Elf=65, Dwarf=73, Hobbit=81, Beorning=114, High Elf=151, Stout-axe=152, River Hobbit=153
     if (m_racePropertyId != -1) {
-        auto rawVal = readPropertyValue(*playerEntity, m_racePropertyId);
+        auto rawVal = readPropertyValue(playerEntity, m_racePropertyId);
         if (rawVal) {
-            spdlog::info("Race raw property value: 0x{:X} (int32={})", *rawVal, static_cast<int>(*rawVal));
+            SPDLOG_DEBUG("Race raw property value: 0x{:X} (int32={})", *rawVal, static_cast<int>(*rawVal));
             int raceId = static_cast<int>(*rawVal);
             info.race = mapRaceId(raceId);
-            spdlog::info("Race ID {} -> {}", raceId, info.race.toStdString());
+            SPDLOG_DEBUG("Race ID {} -> {}", raceId, info.race.toStdString());
         } else {
-            spdlog::warn("Failed to read race property {} from entity 0x{:X}", m_racePropertyId, *playerEntity);
+            spdlog::warn("Failed to read race property {} from entity 0x{:X}", m_racePropertyId, playerEntity);
         }
     } else {
         spdlog::warn("Race property ID not resolved from DAT");
@@ -844,30 +1148,30 @@ std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
     // Read Vitals (Morale/Power)
     // LOTRO stores vitals as FLOAT properties, not INT
     if (m_currentMoralePropertyId != -1) {
-        auto val = readFloatProperty(*playerEntity, m_currentMoralePropertyId);
+        auto val = readFloatProperty(playerEntity, m_currentMoralePropertyId);
         if (val) {
             info.morale = static_cast<int>(*val);
-            spdlog::debug("Current Morale (float): {} -> {}", *val, info.morale);
+            SPDLOG_DEBUG("Current Morale (float): {} -> {}", *val, info.morale);
         } else {
-            spdlog::debug("Failed to read current morale property {}", m_currentMoralePropertyId);
+            SPDLOG_DEBUG("Failed to read current morale property {}", m_currentMoralePropertyId);
         }
     }
     if (m_currentPowerPropertyId != -1) {
-        auto val = readFloatProperty(*playerEntity, m_currentPowerPropertyId);
+        auto val = readFloatProperty(playerEntity, m_currentPowerPropertyId);
         if (val) {
             info.power = static_cast<int>(*val);
-            spdlog::debug("Current Power (float): {} -> {}", *val, info.power);
+            SPDLOG_DEBUG("Current Power (float): {} -> {}", *val, info.power);
         } else {
-            spdlog::debug("Failed to read current power property {}", m_currentPowerPropertyId);
+            SPDLOG_DEBUG("Failed to read current power property {}", m_currentPowerPropertyId);
         }
     }
     
     // Read Money (Copper) - stored as Long (INT64)
     // If Long fails, try Int (some versions store as 32-bit)
     if (m_moneyPropertyId != -1) {
-        auto rawVal = readPropertyValue(*playerEntity, m_moneyPropertyId);
+        auto rawVal = readPropertyValue(playerEntity, m_moneyPropertyId);
         if (rawVal) {
-            spdlog::info("Money raw property value: 0x{:X}", *rawVal);
+            SPDLOG_DEBUG("Money raw property value: 0x{:X}", *rawVal);
             // Try interpreting as signed 64-bit first
             int64_t copperTotal = static_cast<int64_t>(*rawVal);
             if (copperTotal > 0 && copperTotal < 100000000000LL) {
@@ -876,7 +1180,7 @@ std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
                 info.gold = static_cast<int>(copperTotal / 100000);
                 info.silver = static_cast<int>((copperTotal / 100) % 1000);
                 info.copper = static_cast<int>(copperTotal % 100);
-                spdlog::info("Money: {} copper = {}g {}s {}c", copperTotal, info.gold, info.silver, info.copper);
+                SPDLOG_DEBUG("Money: {} copper = {}g {}s {}c", copperTotal, info.gold, info.silver, info.copper);
             } else {
                 // Try as 32-bit int
                 int copperInt = static_cast<int>(*rawVal);
@@ -884,7 +1188,7 @@ std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
                     info.gold = copperInt / 100000;
                     info.silver = (copperInt / 100) % 1000;
                     info.copper = copperInt % 100;
-                    spdlog::info("Money (32-bit): {} copper = {}g {}s {}c", copperInt, info.gold, info.silver, info.copper);
+                    SPDLOG_DEBUG("Money (32-bit): {} copper = {}g {}s {}c", copperInt, info.gold, info.silver, info.copper);
                 } else {
                     spdlog::warn("Money value doesn't look valid: raw=0x{:X}, int64={}, int32={}",
                                  *rawVal, copperTotal, copperInt);
@@ -898,93 +1202,96 @@ std::optional<CharacterInfo> CharacterExtractor::extractCharacter() {
     }
 
     
-    spdlog::info("Extracted: {} Lv{} {} {}, Morale {}, Power {}", 
+    SPDLOG_DEBUG("Extracted: {} Lv{} {} {}, Morale {}, Power {}", 
                  info.name.toStdString(), info.level, info.race.toStdString(), info.className.toStdString(),
                  info.morale, info.power);
     
     return info;
 }
 
+CharacterChangeSet CharacterExtractor::diffCharacter(const CharacterInfo& info) {
+    auto groupHash = [&info](CharacterGroup group) -> size_t {
+        switch (group) {
+        case CharacterGroup::Identity:
+            return qHashMulti(0, info.name, info.surname, info.className, info.race, info.server, info.account);
+        case CharacterGroup::Level:
+            return qHash(info.level);
+        case CharacterGroup::Vitals:
+            return qHashMulti(0, info.morale, info.power, info.maxMorale, info.maxPower);
+        case CharacterGroup::Money:
+            return qHashMulti(0, info.gold, info.silver, info.copper);
+        case CharacterGroup::Account:
+            return qHashMulti(0, static_cast<int>(info.accountType), info.destinyPoints, info.lotroPoints);
+        case CharacterGroup::Count:
+            break;
+        }
+        return 0;
+    };
+    
+    CharacterChangeSet changes;
+    for (size_t i = 0; i < m_groupHashes.size(); ++i) {
+        auto group = static_cast<CharacterGroup>(i);
+        size_t hash = groupHash(group);
+        if (!m_haveGroupHashes || hash != m_groupHashes[i]) {
+            changes.mark(group);
+            m_groupHashes[i] = hash;
+        }
+    }
+    m_haveGroupHashes = true;
+    return changes;
+}
+
 std::optional<CharacterData> CharacterExtractor::extractFullData() {
-    // First get basic character info
-    auto basicInfo = extractCharacter();
-    if (!basicInfo) {
+    allocation::Scope allocScope(allocation::Tag::Sync);
+    if (!isConnected()) {
+        m_lastError = "Not connected to LOTRO client";
         return std::nullopt;
     }
     
-    CharacterData data;
-    data.basic = *basicInfo;
+    // One snapshot for both halves: the player entity is found once, its
+    // property table is copied once, and every property below is decoded
+    // from that copy
+    ProcessMemory::SnapshotScope snapshot(*m_memory);
     
-    // Find player entity again for extended properties
-    auto playerEntity = findPlayerEntity();
+    std::optional<uint64_t> playerEntity;
+    {
+        SyncMetrics::ScopedTimer timer(m_metrics, SyncStage::PlayerLookup);
+        playerEntity = findPlayerEntity();
+    }
     if (!playerEntity) {
-        return data;  // Return basic info only
+        m_lastError = "Player entity not found";
+        return std::nullopt;
     }
     
-    auto* registry = m_datFacade ? m_datFacade->getPropertiesRegistry() : nullptr;
-    if (!registry) {
+    QElapsedTimer decodeTimer;
+    decodeTimer.start();
+    uint64_t propertyReadUs = m_propertyReadUs;
+    
+    CharacterData data;
+    data.basic = decodeCharacter(*playerEntity);
+    
+    if (!m_extendedIds.resolved) {
         spdlog::warn("No property registry available for extended extraction");
+        recordDecode(decodeTimer, propertyReadUs);
+        finishCapture(data.basic);
         return data;
     }
+    const auto& ids = m_extendedIds;
     
     // === Extract Virtues ===
-    // Property names like "Trait_Virtue_Rank_Charity", "Trait_Virtue_XP_Charity"
-    const std::vector<std::pair<QString, QString>> virtueKeys = {
-        {"CHARITY",      "Charity"},
-        {"COMPASSION",   "Compassion"},
-        {"CONFIDENCE",   "Confidence"},
-        {"DETERMINATION","Determination"},
-        {"DISCIPLINE",   "Discipline"},
-        {"EMPATHY",      "Empathy"},
-        {"FIDELITY",     "Fidelity"},
-        {"FORTITUDE",    "Fortitude"},
-        {"HONESTY",      "Honesty"},
-        {"HONOUR",       "Honour"},
-        {"IDEALISM",     "Idealism"},
-        {"INNOCENCE",    "Innocence"},
-        {"JUSTICE",      "Justice"},
-        {"LOYALTY",      "Loyalty"},
-        {"MERCY",        "Mercy"},
-        {"PATIENCE",     "Patience"},
-        {"TOLERANCE",    "Tolerance"},
-        {"VALOUR",       "Valour"},
-        {"WISDOM",       "Wisdom"},
-        {"WIT",          "Wit"},
-        {"ZEAL",         "Zeal"}
-    };
-    
-    // Virtue property name suffixes (from XML analysis)
-    const std::map<QString, QString> virtueRankSuffix = {
-        {"CHARITY", "Charity"}, {"COMPASSION", "Compassionate"}, {"CONFIDENCE", "Confidence"},
-        {"DETERMINATION", "Determination"}, {"DISCIPLINE", "Discipline"}, {"EMPATHY", "Empathy"},
-        {"FIDELITY", "Fidelity"}, {"FORTITUDE", "Fortitude"}, {"HONESTY", "Honesty"},
-        {"HONOUR", "Honour"}, {"IDEALISM", "Idealism"}, {"INNOCENCE", "Innocence"},
-        {"JUSTICE", "Just"}, {"LOYALTY", "Loyalty"}, {"MERCY", "Merciful"},
-        {"PATIENCE", "Patience"}, {"TOLERANCE", "Tolerant"}, {"VALOUR", "Valor"},
-        {"WISDOM", "Wisdom"}, {"WIT", "Wit"}, {"ZEAL", "Zeal"}
-    };
-    
-    for (const auto& [key, displayName] : virtueKeys) {
+    for (size_t i = 0; i < std::size(VIRTUES); ++i) {
         VirtueStatus vs;
-        vs.key = key;
-        vs.name = displayName;
-        
-        // Get property IDs
-        QString suffixIt = virtueRankSuffix.count(key) ? virtueRankSuffix.at(key) : displayName;
-        QString rankProp = QString("Trait_Virtue_Rank_%1").arg(suffixIt);
-        QString xpProp = QString("Trait_Virtue_XP_%1").arg(suffixIt);
-        
-        int rankPropId = registry->getPropertyId(rankProp.toStdString().c_str());
-        int xpPropId = registry->getPropertyId(xpProp.toStdString().c_str());
+        vs.key = QString::fromLatin1(VIRTUES[i].key);
+        vs.name = QString::fromLatin1(VIRTUES[i].name);
         
-        if (rankPropId != -1) {
-            if (auto rank = readIntProperty(*playerEntity, rankPropId)) {
+        if (ids.virtues[i].rank != -1) {
+            if (auto rank = readIntProperty(*playerEntity, ids.virtues[i].rank)) {
                 vs.rank = *rank;
             }
         }
         
-        if (xpPropId != -1) {
-            if (auto xp = readIntProperty(*playerEntity, xpPropId)) {
+        if (ids.virtues[i].xp != -1) {
+            if (auto xp = readIntProperty(*playerEntity, ids.virtues[i].xp)) {
                 vs.xp = *xp;
             }
         }
@@ -995,81 +1302,26 @@ std::optional<CharacterData> CharacterExtractor::extractFullData() {
     spdlog::info("Extracted {} virtues", data.virtues.size());
     
     // === Extract Reputation ===
-    // Property names like "Reputation_Faction_Breeland_Men_CurrentTier"
-    // Faction keys: {key, display_name, property_prefix, category}
-    // Property prefixes must exactly match factions.xml currentTierProperty/currentReputationProperty
-    struct FactionDef { QString key; QString name; QString propPrefix; QString category; };
-    const std::vector<FactionDef> factionKeys = {
-        // Eriador
-        {"BREE", "Men of Bree", "Reputation_Faction_Breeland_Men", "Eriador"},
-        {"SHIRE", "The Mathom Society", "Reputation_Faction_Shire_Mathoms", "Eriador"},
-        {"DWARVES", "Thorin's Hall", "Reputation_Faction_Eredluin_Dwarves", "Eriador"},
-        {"EGLAIN", "The Eglain", "Reputation_Faction_Lonelands_Eglain", "Eriador"},
-        {"ESTELDIN", "Rangers of Esteldín", "Reputation_Faction_Northdowns_Esteldin", "Eriador"},
-        {"RIVENDELL", "Elves of Rivendell", "Reputation_Faction_Rivendell_Elves", "Eriador"},
-        {"ANNUMINAS", "The Wardens of Annúminas", "Reputation_Faction_Evendim_Rangers", "Eriador"},
-        {"COUNCIL_OF_THE_NORTH", "Council of the North", "Reputation_Faction_Angmar_Free_People", "Eriador"},
-        {"LOSSOTH", "Lossoth of Forochel", "Reputation_Faction_Forochel_Lossoth", "Eriador"},
-        // Rhovanion
-        {"MORIA_GUARDS", "Iron Garrison Guards", "Reputation_Faction_Moria_Dwarves_Fast", "Rhovanion"},
-        {"MORIA_MINERS", "Iron Garrison Miners", "Reputation_Faction_Moria_Dwarves_Slow", "Rhovanion"},
-        {"GALADHRIM", "Galadhrim", "Reputation_Faction_Lorien_Elves", "Rhovanion"},
-        {"MALLEDHRIM", "Malledhrim", "Reputation_Faction_Mirkwood_Offensive", "Rhovanion"},
-        {"ELVES_OF_FELEGOTH", "Elves of Felegoth", "Reputation_Faction_Mirkwood_North_Elves", "Rhovanion"},
-        {"MEN_OF_DALE", "Men of Dale", "Reputation_Faction_Mirkwood_North_Men", "Rhovanion"},
-        {"DWARVES_OF_EREBOR", "Dwarves of Erebor", "Reputation_Faction_Mirkwood_North_Dwarves", "Rhovanion"},
-        {"GREY_MOUNTAINS_EXPEDITION", "Grey Mountains Expedition", "Reputation_Faction_Dwarfholds_Eredmithrin", "Rhovanion"},
-        {"WILDERFOLK", "Wilderfolk", "Reputation_Faction_Vales_Of_Anduin", "Rhovanion"},
-        // Dunland
-        {"ALGRAIG", "Algraig, Men of Enedwaith", "Reputation_Faction_Enedwaith_Dunlendings", "Dunland"},
-        {"GREY_COMPANY", "The Grey Company", "Reputation_Faction_Enedwaith_Grey_Company", "Dunland"},
-        {"DUNLAND", "Men of Dunland", "Reputation_Faction_Dunland_Dunlendings", "Dunland"},
-        {"THEODRED_RIDERS", "Théodred's Riders", "Reputation_Faction_Dunland_Theodred", "Dunland"},
-        // Rohan
-        {"STANGARD_RIDERS", "The Riders of Stangard", "Reputation_Faction_Greatriver_Stangard", "Rohan"},
-        {"WOLD", "Men of the Wold", "Reputation_Faction_Rohan_Wold", "Rohan"},
-        {"NORCROFTS", "Men of the Norcrofts", "Reputation_Faction_Rohan_Norcrofts", "Rohan"},
-        {"ENTWASH_VALE", "Men of the Entwash Vale", "Reputation_Faction_Rohan_Entwashvale", "Rohan"},
-        {"SUTCROFTS", "Men of the Sutcrofts", "Reputation_Faction_Rohan_Sutcrofts", "Rohan"},
-        {"EORLINGAS", "The Eorlingas", "Reputation_Faction_Rohan_West_Eorlingas", "Rohan"},
-        {"HELMINGAS", "The Helmingas", "Reputation_Faction_Rohan_West_Helmingas", "Rohan"},
-        {"FANGORN", "The Ents of Fangorn Forest", "Reputation_Faction_Rohan_West_Fangorn", "Rohan"},
-        {"PEOPLE_WILDERMORE", "People of Wildermore", "Reputation_Faction_Wildermore_Basic", "Rohan"},
-        // Gondor
-        {"DOL_AMROTH", "Dol Amroth", "Reputation_Faction_Gondor_West_Amroth", "Gondor"},
-        {"PELARGIR", "Pelargir", "Reputation_Faction_Gondor_Central_Pelargir", "Gondor"},
-        {"RANGERS_ITHILIEN", "Rangers of Ithilien", "Reputation_Faction_Gondor_East_Rangers", "Gondor"},
-        {"MINAS_TIRITH", "Defenders of Minas Tirith", "Reputation_Faction_Gondor_Minas_Tirith", "Gondor"},
-        // Mordor
-        {"HOST_OF_THE_WEST", "Host of the West", "Reputation_Faction_Mountains_Shadow_Host_West", "Mordor"},
-        {"GORGOROTH", "Conquest of Gorgoroth", "Reputation_Faction_Mordor_Gorgoroth", "Mordor"},
-    };
-    
-    for (const auto& fd : factionKeys) {
+    for (size_t i = 0; i < std::size(FACTIONS); ++i) {
+        const auto& fd = FACTIONS[i];
         FactionStatus fs;
-        fs.key = fd.key;
-        fs.name = fd.name;
-        fs.category = fd.category;
-        
-        QString tierProp = QString("%1_CurrentTier").arg(fd.propPrefix);
-        QString repProp = QString("%1_EarnedReputation").arg(fd.propPrefix);
-        
-        int tierPropId = registry->getPropertyId(tierProp.toStdString().c_str());
-        int repPropId = registry->getPropertyId(repProp.toStdString().c_str());
         
-        if (tierPropId != -1) {
-            if (auto tier = readIntProperty(*playerEntity, tierPropId)) {
+        if (ids.factions[i].tier != -1) {
+            if (auto tier = readIntProperty(*playerEntity, ids.factions[i].tier)) {
                 fs.tier = *tier;
             }
         }
         
-        if (repPropId != -1) {
-            if (auto rep = readIntProperty(*playerEntity, repPropId)) {
+        if (ids.factions[i].reputation != -1) {
+            if (auto rep = readIntProperty(*playerEntity, ids.factions[i].reputation)) {
                 fs.reputation = *rep;
             }
         }
         
         if (fs.tier > 0 || fs.reputation > 0) {
+            fs.key = QString::fromLatin1(fd.key);
+            fs.name = QString::fromUtf8(fd.name);
+            fs.category = QString::fromLatin1(fd.category);
             data.factions.push_back(fs);
         }
     }
@@ -1077,62 +1329,37 @@ std::optional<CharacterData> CharacterExtractor::extractFullData() {
     spdlog::info("Extracted {} faction reputations", data.factions.size());
     
     // === Extract Crafting Professions ===
-    // Property names like "Craft_Scholar_MasteryLevel", "Craft_Scholar_ProficiencyLevel"
-    const std::vector<std::pair<QString, QString>> professionKeys = {
-        {"SCHOLAR",     "Scholar"},
-        {"METALSMITH",  "Metalsmith"},
-        {"JEWELLER",    "Jeweller"},
-        {"TAILOR",      "Tailor"},
-        {"WEAPONSMITH", "Weaponsmith"},
-        {"WOODWORKER",  "Woodworker"},
-        {"COOK",        "Cook"},
-        {"FARMER",      "Farmer"},
-        {"FORESTER",    "Forester"},
-        {"PROSPECTOR",  "Prospector"}
-    };
-    
-    for (const auto& [key, name] : professionKeys) {
-        QString enabledProp = QString("Craft_%1_Enabled").arg(name);
-        int enabledPropId = registry->getPropertyId(enabledProp.toStdString().c_str());
+    for (size_t i = 0; i < std::size(PROFESSIONS); ++i) {
+        const auto& prof = ids.professions[i];
         
         bool isEnabled = false;
-        if (enabledPropId != -1) {
-            if (auto val = readIntProperty(*playerEntity, enabledPropId)) {
+        if (prof.enabled != -1) {
+            if (auto val = readIntProperty(*playerEntity, prof.enabled)) {
                 isEnabled = *val != 0;
             }
         }
         
         if (isEnabled) {
             CraftingProfessionStatus cps;
-            cps.name = name;
-            
-            QString masteryProp = QString("Craft_%1_MasteryLevel").arg(name);
-            QString profProp = QString("Craft_%1_ProficiencyLevel").arg(name);
-            QString masteryXpProp = QString("Craft_%1_MasteryXP").arg(name);
-            QString profXpProp = QString("Craft_%1_ProficiencyXP").arg(name);
-            
-            int masteryPropId = registry->getPropertyId(masteryProp.toStdString().c_str());
-            int profPropId = registry->getPropertyId(profProp.toStdString().c_str());
-            int masteryXpPropId = registry->getPropertyId(masteryXpProp.toStdString().c_str());
-            int profXpPropId = registry->getPropertyId(profXpProp.toStdString().c_str());
+            cps.name = QString::fromLatin1(PROFESSIONS[i]);
             
-            if (masteryPropId != -1) {
-                if (auto val = readIntProperty(*playerEntity, masteryPropId)) {
+            if (prof.mastery != -1) {
+                if (auto val = readIntProperty(*playerEntity, prof.mastery)) {
                     cps.mastery = *val;
                 }
             }
-            if (profPropId != -1) {
-                if (auto val = readIntProperty(*playerEntity, profPropId)) {
+            if (prof.proficiency != -1) {
+                if (auto val = readIntProperty(*playerEntity, prof.proficiency)) {
                     cps.tier = *val;
                 }
             }
-            if (masteryXpPropId != -1) {
-                if (auto val = readIntProperty(*playerEntity, masteryXpPropId)) {
+            if (prof.masteryXp != -1) {
+                if (auto val = readIntProperty(*playerEntity, prof.masteryXp)) {
                     cps.hasMastered = (*val > 0);
                 }
             }
-            if (profXpPropId != -1) {
-                if (auto val = readIntProperty(*playerEntity, profXpPropId)) {
+            if (prof.proficiencyXp != -1) {
+                if (auto val = readIntProperty(*playerEntity, prof.proficiencyXp)) {
                     cps.proficiency = *val;
                 }
             }
@@ -1144,103 +1371,65 @@ std::optional<CharacterData> CharacterExtractor::extractFullData() {
     spdlog::info("Extracted {} crafting professions", data.crafting.professions.size());
     
     // === Extract Equipment ===
-    // Equipment slots use Inventory_SlotCache_Eq_* property names (type 7 = entity ID).
     // The value is an entity ID pointing to the item entity in the entities table.
     // To get the actual item DID, we follow the entity pointer and read its
     // ConstructionInfo.DataID (offset 288+8=296 from entity base, 64-bit).
-    const std::vector<std::pair<QString, QString>> equipmentSlots = {
-        {"HEAD",       "Inventory_SlotCache_Eq_Head"},
-        {"SHOULDERS",  "Inventory_SlotCache_Eq_Shoulder"},
-        {"CHEST",      "Inventory_SlotCache_Eq_Chest"},
-        {"HANDS",      "Inventory_SlotCache_Eq_Gloves"},
-        {"LEGS",       "Inventory_SlotCache_Eq_Legs"},
-        {"FEET",       "Inventory_SlotCache_Eq_Boots"},
-        {"BACK",       "Inventory_SlotCache_Eq_Back"},
-        {"MAIN_HAND",  "Inventory_SlotCache_Eq_Weapon_Primary"},
-        {"OFF_HAND",   "Inventory_SlotCache_Eq_Weapon_Secondary"},
-        {"RANGED",     "Inventory_SlotCache_Eq_RangedWeapon"},
-        {"POCKET",     "Inventory_SlotCache_Eq_Pocket1"},
-        {"EAR1",       "Inventory_SlotCache_Eq_Earring1"},
-        {"EAR2",       "Inventory_SlotCache_Eq_Earring2"},
-        {"NECK",       "Inventory_SlotCache_Eq_Necklace"},
-        {"WRIST1",     "Inventory_SlotCache_Eq_Bracelet1"},
-        {"WRIST2",     "Inventory_SlotCache_Eq_Bracelet2"},
-        {"RING1",      "Inventory_SlotCache_Eq_Ring1"},
-        {"RING2",      "Inventory_SlotCache_Eq_Ring2"},
-        {"CLASS_SLOT", "Inventory_SlotCache_Eq_Class"},
-        {"CRAFT_TOOL", "Inventory_SlotCache_Eq_CraftTool"},
-    };
-    
-    for (const auto& [slotName, propName] : equipmentSlots) {
-        int propId = registry->getPropertyId(propName);
-        if (propId == -1) {
-            spdlog::debug("Equipment property '{}' not found in registry", propName.toStdString());
+    //
+    // The value at offset 24 in the hashtable entry is a POINTER to a
+    // ref-counted Long64 struct (slot cache properties are INSTANCE_ID,
+    // type 7):
+    //   +0: vtable/refcount header (refCountTemplateSize = ptrSize + intSize = 16 for 64-bit)
+    //   +16: 64-bit entity instance ID
+    // All slots' structs are fetched in one batch, then each instance ID is
+    // looked up in the entities table DataID map.
+    int refCountSize = m_config.is64Bit ? 16 : 8;
+    m_equipmentReads.clear();
+    m_equipmentSlots.clear();
+    for (size_t i = 0; i < std::size(EQUIPMENT_SLOTS); ++i) {
+        if (ids.equipment[i] == -1) {
             continue;
         }
+        auto rawVal = readPropertyValue(*playerEntity, ids.equipment[i]);
+        if (rawVal && *rawVal != 0) {
+            m_equipmentReads.add(*rawVal, refCountSize + 8);
+            m_equipmentSlots.push_back(i);
+        }
+    }
+    m_equipmentReads.run(*m_memory);
+    
+    for (size_t read = 0; read < m_equipmentSlots.size(); ++read) {
+        if (!m_equipmentReads.ok(read)) continue;
+        const auto& slot = EQUIPMENT_SLOTS[m_equipmentSlots[read]];
         
-        // Slot cache properties are INSTANCE_ID type (type 7).
-        // The value at offset 24 in the hashtable entry is a POINTER to a
-        // ref-counted Long64 struct:
-        //   +0: vtable/refcount header (refCountTemplateSize = ptrSize + intSize = 16 for 64-bit)
-        //   +16: 64-bit entity instance ID
-        // We then look up this instance ID in the entities table DataID map.
-        
-        auto rawVal = readPropertyValue(*playerEntity, propId);
-        if (!rawVal || *rawVal == 0) continue;
-        
-        uint64_t instanceIdPtr = *rawVal;
-        
-        // Read the entity instance ID from the ref-counted Long64 struct
-        // refCountTemplateSize = pointerSize + intSize (from Java Constants.CONFIG)
-        // For 64-bit: 8 + 8 = 16
-        int refCountSize = m_config.is64Bit ? 16 : 8;
-        auto instanceBuf = m_memory->readMemory(instanceIdPtr, refCountSize + 8);
-        if (!instanceBuf) continue;
-        
-        uint64_t entityInstanceId = instanceBuf->read<uint64_t>(refCountSize);
+        uint64_t entityInstanceId = m_equipmentReads.view(read).read<uint64_t>(refCountSize);
         if (entityInstanceId == 0) continue;
         
-        // Look up the entity instance ID in our DataID map (populated during entity scan)
+        // With the player cached the map can predate a gear change: rescan
+        // the entities table once per sync on a miss.
         auto it = m_entityDataIds.find(entityInstanceId);
+        if (it == m_entityDataIds.end() && m_entityScanGeneration != m_memory->snapshotGeneration()) {
+            scanEntitiesTable();
+            it = m_entityDataIds.find(entityInstanceId);
+        }
         if (it != m_entityDataIds.end()) {
             uint32_t dataId = it->second;
-            data.equippedGear[slotName] = static_cast<int>(dataId);
-            spdlog::info("Slot {}: instanceId 0x{:X} -> item DID 0x{:X} ({})", 
-                         slotName.toStdString(), entityInstanceId, dataId, dataId);
+            data.equippedGear[QString::fromLatin1(slot.slot)] = static_cast<int>(dataId);
+            SPDLOG_DEBUG("Slot {}: instanceId 0x{:X} -> item DID 0x{:X} ({})", 
+                         slot.slot, entityInstanceId, dataId, dataId);
         } else {
-            spdlog::debug("Slot {}: instanceId 0x{:X} not found in entity DataID map ({} entries)", 
-                         slotName.toStdString(), entityInstanceId, m_entityDataIds.size());
+            SPDLOG_DEBUG("Slot {}: instanceId 0x{:X} not found in entity DataID map ({} entries)", 
+                         slot.slot, entityInstanceId, m_entityDataIds.size());
         }
     }
     
     spdlog::info("Extracted {} equipped items", data.equippedGear.size());
     
     // === Extract Wallet Currencies ===
-    // Common wallet currencies with their property names
-    const std::vector<std::pair<int, QString>> currencyProperties = {
-        {1, "Wallet_Currency_Marks"},
-        {2, "Wallet_Currency_Medallions"},
-        {3, "Wallet_Currency_Seals"},
-        {4, "Wallet_Currency_MithrilCoins"},
-        {5, "Wallet_Currency_Commendations"},
-        {6, "Wallet_Currency_Skirmish_Marks"},
-        {7, "Wallet_Currency_Fate_Tokens"},
-        {8, "Wallet_Currency_Hobbit_Presents"},
-        {9, "Wallet_Currency_Silver_Tokens"},
-        {10, "Wallet_Currency_Gift_Mathom"},
-        {11, "Wallet_Currency_Crafting_Guild"},
-        {12, "Wallet_Currency_AnniversaryTokens"},
-        {13, "Wallet_Currency_FestivalTokens"},
-        {14, "Wallet_Currency_Figments"},
-        {15, "Wallet_Currency_MoriaShards"},
-    };
-    
-    for (const auto& [currencyId, propName] : currencyProperties) {
-        int propId = registry->getPropertyId(propName.toStdString().c_str());
-        if (propId != -1) {
-            if (auto val = readIntProperty(*playerEntity, propId)) {
+    for (size_t i = 0; i < std::size(CURRENCIES); ++i) {
+        if (ids.currencies[i] != -1) {
+            if (auto val = readIntProperty(*playerEntity, ids.currencies[i])) {
                 if (*val > 0) {
-                    data.wallet[currencyId] = *val;
+                    data.wallet[CURRENCIES[i].id] = *val;
                 }
             }
         }
@@ -1253,23 +1442,8 @@ std::optional<CharacterData> CharacterExtractor::extractFullData() {
     // Title_ActiveTitleString contains the display string (type 13 = STRING_INFO)
     // Discovered via entity property dump: value 0x70020442 = 1879180354 = "Eglan-friend"
     {
-        static const std::vector<std::string> titleCandidates = {
-            "Title_ActiveTitleDID",       // Confirmed working - contains title DID
-            "Advancement_CurrentTitle", "AdvTable_CurrentTitle", "Player_CurrentTitle",
-            "Agent_CurrentTitle", "CurrentTitle"
-        };
-        
-        int titlePropId = -1;
-        std::string resolvedName;
-        for (const auto& name : titleCandidates) {
-            int id = registry->getPropertyId(QString::fromStdString(name));
-            if (id != -1) {
-                titlePropId = id;
-                resolvedName = name;
-                spdlog::info("Title property '{}' resolved to ID {}", name, id);
-                break;
-            }
-        }
+        int titlePropId = ids.title;
+        const char* resolvedName = ids.titleCandidate >= 0 ? TITLE_CANDIDATES[ids.titleCandidate] : "";
         
         if (titlePropId != -1) {
             // Read as raw property value (DATA_FILE type stores a DID reference)
@@ -1291,7 +1465,7 @@ std::optional<CharacterData> CharacterExtractor::extractFullData() {
             }
         } else {
             spdlog::warn("No title property name resolved from DAT. Tried: {}", 
-                        [&]() { std::string s; for (const auto& n : titleCandidates) { if (!s.empty()) s += ", "; s += n; } return s; }());
+                        []() { std::string s; for (const char* n : TITLE_CANDIDATES) { if (!s.empty()) s += ", "; s += n; } return s; }());
         }
     }
     
@@ -1318,7 +1492,7 @@ std::optional<CharacterData> CharacterExtractor::extractFullData() {
     // === Extract Emotes ===
     // Emote_GrantedList is an ARRAY property containing emote IDs
     {
-        int emotePropId = registry->getPropertyId("Emote_GrantedList");
+        int emotePropId = ids.emotes;
         if (emotePropId != -1) {
             auto emoteIds = readArrayProperty(*playerEntity, emotePropId);
             for (int emoteId : emoteIds) {
@@ -1332,6 +1506,8 @@ std::optional<CharacterData> CharacterExtractor::extractFullData() {
         }
     }
     
+    recordDecode(decodeTimer, propertyReadUs);
+    finishCapture(data.basic);
     return data;
 }
 
@@ -1342,16 +1518,23 @@ std::optional<uint64_t> CharacterExtractor::readPropertyValue(uint64_t entityAdd
     // TODO: Handle 32-bit offset (108)
     uint64_t eppOffset = m_config.is64Bit ? 192 : 108;
     
-    auto entBuf = m_memory->readMemory(entityAddress, 256);
-    if (!entBuf) return std::nullopt;
-    
-    uint64_t eppPtr = entBuf->readPointer(eppOffset, true);
-    if (eppPtr == 0) return std::nullopt;
-    
-    // Hashtable base for entities is at eppPtr + 56 (for 64-bit)
-    uint64_t hashtableBase = eppPtr + (m_config.is64Bit ? 56 : 32); 
+    // Within a snapshot the entity's table is located once
+    bool cached = m_memory->inSnapshot() && entityAddress == m_propertyOwner.entity
+                  && m_propertyOwner.generation == m_memory->snapshotGeneration();
+    if (!cached) {
+        auto entBuf = m_memory->readMemory(entityAddress, 256);
+        if (!entBuf) return std::nullopt;
+        
+        uint64_t eppPtr = entBuf->readPointer(eppOffset, true);
+        if (eppPtr == 0) return std::nullopt;
+        
+        // Hashtable base for entities is at eppPtr + 56 (for 64-bit)
+        m_propertyOwner.entity = entityAddress;
+        m_propertyOwner.generation = m_memory->snapshotGeneration();
+        m_propertyOwner.hashtableBase = eppPtr + (m_config.is64Bit ? 56 : 32);
+    }
     
-    return readHashtableValue(hashtableBase, propId);
+    return readHashtableValue(m_propertyOwner.hashtableBase, propId);
 }
 
 std::optional<QString> CharacterExtractor::readStringProperty(uint64_t entityAddress, uint32_t propId) {
@@ -1732,7 +1915,7 @@ std::map<int, int> CharacterExtractor::decodeNativeIntIntHashtable(uint64_t nati
     if (bucketsPtr == 0 || nbBuckets <= 0 || nbBuckets > 100000) return result;
     if (nbElements <= 0 || nbElements > 100000) return result;
     
-    spdlog::debug("IntInt hashtable: {} buckets, {} elements", nbBuckets, nbElements);
+    SPDLOG_DEBUG("IntInt hashtable: {} buckets, {} elements", nbBuckets, nbElements);
     
     // Read buckets array
     auto bucketsBuf = m_memory->readMemory(bucketsPtr, nbBuckets * ptrSize);
@@ -1768,7 +1951,7 @@ std::map<int, int> CharacterExtractor::decodeNativeIntIntHashtable(uint64_t nati
     }
     
     if (static_cast<int>(result.size()) != nbElements) {
-        spdlog::debug("Hashtable size mismatch: got {}, expected {}", result.size(), nbElements);
+        SPDLOG_DEBUG("Hashtable size mismatch: got {}, expected {}", result.size(), nbElements);
     }
     
     return result;
@@ -1889,27 +2072,59 @@ bool CharacterExtractor::scanPatterns() {
         return false;
     }
     
-    // Read module content (limit to e.g. 60MB to cover code section)
+    // Scan the module content (limit to e.g. 60MB to cover code section),
+    // streamed from the process in chunks
     size_t scanSize = std::min<size_t>(modInfo->size, 60 * 1024 * 1024);
-    auto buffer = m_memory->readMemory(modInfo->baseAddress, scanSize);
-    if (!buffer) {
-        spdlog::error("Failed to read module memory for scanning");
-        return false;
-    }
-    
-    // Copy data to vector for scanner
-    std::vector<uint8_t> data(buffer->data(), buffer->data() + buffer->size());
+    const uint64_t moduleBase = modInfo->baseAddress;
+    auto readChunk = [this, moduleBase](size_t offset, std::span<uint8_t> out) {
+        return m_memory->readInto(moduleBase + offset, out);
+    };
+    // RIP-relative displacement of a matched instruction
+    auto readRel = [this, moduleBase](size_t offset) {
+        return m_memory->read<int32_t>(moduleBase + offset).value_or(0);
+    };
     
     bool allFound = true;
     
     if (m_config.is64Bit) {
-        // 64-bit patterns
+        // 64-bit patterns, all matched in a single pass over the module.
+        // The match offsets only change when the client is patched, so
+        // they are cached per build and spot-checked on reconnect.
+        PatternScanner scanner;
+        std::apply([&scanner](const auto&... pattern) { (scanner.addPattern(pattern), ...); }, SIGNATURES_64);
+        
+        std::vector<std::optional<size_t>> matches;
+        auto buildKey = moduleBuildKey(*m_memory, moduleBase);
+        if (m_memory->isReplaying()) {
+            // Matches come with the capture, so a replay doesn't depend on
+            // this machine's signature cache or need the module image
+            QStringList offsets = QString::fromStdString(
+                m_memory->recordingNote(CAPTURE_SIGNATURES_NOTE).value_or("")).split(',');
+            for (size_t i = 0; i < SIGNATURE_TEXTS_64.size(); ++i) {
+                bool ok = false;
+                qulonglong offset = offsets.value(static_cast<int>(i)).toULongLong(&ok, 16);
+                matches.push_back(ok ? std::optional<size_t>(offset) : std::nullopt);
+            }
+        } else if (!buildKey || !loadSignatureCache(*buildKey, scanner, SIGNATURE_TEXTS_64, moduleBase, matches)) {
+            matches = scanner.scanStream(scanSize, readChunk);
+            if (buildKey) {
+                saveSignatureCache(*buildKey, SIGNATURE_TEXTS_64, matches);
+            }
+        }
+        if (m_memory->isRecording()) {
+            QStringList offsets;
+            for (const auto& match : matches) {
+                offsets.append(match ? QString::number(*match, 16) : QString("-"));
+            }
+            m_memory->setRecordingNote(CAPTURE_SIGNATURES_NOTE, offsets.join(',').toStdString());
+        }
+        
         // Entities Table: 48895c2408574883ec40488bd9488b0d?3
-        auto entitiesIdx = PatternScanner::find(data, "48895c2408574883ec40488bd9488b0d?3");
+        auto entitiesIdx = matches[ENTITIES_SIGNATURE];
         if (entitiesIdx) {
             // Offset calculation matching Java: index + 16 (offset to ?3) + 4 + value
             size_t instrOffset = *entitiesIdx + 16;
-            int32_t relOffset = buffer->read<int32_t>(instrOffset);
+            int32_t relOffset = readRel(instrOffset);
             uint64_t finalAddr = modInfo->baseAddress + instrOffset + 4 + relOffset;
             
             m_config.entitiesTableOffset = finalAddr - m_config.baseAddress; // Store relative offset
@@ -1920,11 +2135,11 @@ bool CharacterExtractor::scanPatterns() {
         }
         
         // Client Data: 48893d?3b201b900010000
-        auto clientIdx = PatternScanner::find(data, "48893d?3b201b900010000");
+        auto clientIdx = matches[CLIENT_DATA_SIGNATURE];
         if (clientIdx) {
             // Offset calculation: index + 3 + 4 + value
             size_t instrOffset = *clientIdx + 3;
-            int32_t relOffset = buffer->read<int32_t>(instrOffset);
+            int32_t relOffset = readRel(instrOffset);
             uint64_t finalAddr = modInfo->baseAddress + instrOffset + 4 + relOffset;
             
             m_config.clientDataOffset = finalAddr - m_config.baseAddress;
@@ -1938,11 +2153,11 @@ bool CharacterExtractor::scanPatterns() {
         }
         
         // Storage Data: 4883EC28BA02000000488D0D?3
-        auto storageIdx = PatternScanner::find(data, "4883EC28BA02000000488D0D?3");
+        auto storageIdx = matches[STORAGE_DATA_SIGNATURE];
         if (storageIdx) {
             // Offset calculation: index + 12 + 4 + value
             size_t instrOffset = *storageIdx + 12;
-            int32_t relOffset = buffer->read<int32_t>(instrOffset);
+            int32_t relOffset = readRel(instrOffset);
             uint64_t finalAddr = modInfo->baseAddress + instrOffset + 4 + relOffset;
             
             m_config.storageDataOffset = finalAddr - m_config.baseAddress;
@@ -1953,11 +2168,11 @@ bool CharacterExtractor::scanPatterns() {
         }
         
         // References Table: 488b05?3488b08488b0cd1428d14c500000000488b4910
-        auto refsIdx = PatternScanner::find(data, "488b05?3488b08488b0cd1428d14c500000000488b4910");
+        auto refsIdx = matches[REFERENCES_SIGNATURE];
         if (refsIdx) {
             // Offset calculation: index + 3 + 4 + value
             size_t instrOffset = *refsIdx + 3;
-            int32_t relOffset = buffer->read<int32_t>(instrOffset);
+            int32_t relOffset = readRel(instrOffset);
             uint64_t finalAddr = modInfo->baseAddress + instrOffset + 4 + relOffset;
             
             m_config.referencesTableOffset = finalAddr - m_config.baseAddress;
@@ -1977,6 +2192,124 @@ bool CharacterExtractor::scanPatterns() {
     return allFound;
 }
 
+std::optional<QString> CharacterExtractor::moduleBuildKey(ProcessMemory& memory, uint64_t moduleBase) {
+    // PE header fields that change with every client build:
+    // COFF TimeDateStamp, then SizeOfImage and CheckSum in the optional header
+    auto dosHeader = memory.readMemory(moduleBase, 0x40);
+    if (!dosHeader) {
+        return std::nullopt;
+    }
+    uint32_t e_lfanew = dosHeader->read<uint32_t>(0x3C);
+    if (e_lfanew == 0 || e_lfanew > 0x1000) {
+        return std::nullopt;
+    }
+    auto peHeader = memory.readMemory(moduleBase + e_lfanew, 24 + 68);
+    if (!peHeader || peHeader->read<uint32_t>(0) != 0x00004550) { // "PE\0\0"
+        return std::nullopt;
+    }
+    uint32_t timeDateStamp = peHeader->read<uint32_t>(8);
+    uint32_t sizeOfImage = peHeader->read<uint32_t>(24 + 56);
+    uint32_t checkSum = peHeader->read<uint32_t>(24 + 64);
+    return QString("%1-%2-%3")
+        .arg(timeDateStamp, 8, 16, QChar('0'))
+        .arg(sizeOfImage, 8, 16, QChar('0'))
+        .arg(checkSum, 8, 16, QChar('0'));
+}
+
+QString CharacterExtractor::signatureCachePath(const QString& buildKey) {
+    auto cacheDir = Platform::getCachePath() / "signatures";
+    return QDir(QString::fromStdString(cacheDir.string())).filePath(
+        QString("lotroclient-%1.cache").arg(buildKey));
+}
+
+bool CharacterExtractor::loadSignatureCache(const QString& buildKey, const PatternScanner& scanner,
+                                            std::span<const char* const> patterns, uint64_t moduleBase,
+                                            std::vector<std::optional<size_t>>& matches) {
+    QString path = signatureCachePath(buildKey);
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, count = 0;
+    QString storedKey;
+    in >> magic >> version >> storedKey >> count;
+    if (magic != SIGNATURE_CACHE_MAGIC || version != SIGNATURE_CACHE_VERSION
+        || storedKey != buildKey || count != patterns.size()) {
+        spdlog::info("Signature cache {} is from another format, rescanning", path.toStdString());
+        return false;
+    }
+    
+    std::vector<std::optional<size_t>> cached(patterns.size());
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        QString pattern;
+        bool found = false;
+        quint64 offset = 0;
+        in >> pattern >> found >> offset;
+        if (pattern != QLatin1String(patterns[i])) {
+            spdlog::info("Signature cache {} has other signatures, rescanning", path.toStdString());
+            return false;
+        }
+        if (found) {
+            cached[i] = static_cast<size_t>(offset);
+        }
+    }
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Signature cache {} is corrupt", path.toStdString());
+        return false;
+    }
+    
+    // Spot check: every cached match must still be there
+    for (size_t i = 0; i < cached.size(); ++i) {
+        if (!cached[i]) {
+            continue;
+        }
+        auto bytes = m_memory->readMemory(moduleBase + *cached[i], scanner.patternLength(i));
+        if (!bytes || !scanner.matches(i, std::span<const uint8_t>(bytes->data(), bytes->size()))) {
+            spdlog::info("Signature cache {} failed its spot check, rescanning", path.toStdString());
+            return false;
+        }
+    }
+    
+    spdlog::info("Using cached signature matches for client build {}", buildKey.toStdString());
+    matches = std::move(cached);
+    return true;
+}
+
+void CharacterExtractor::saveSignatureCache(const QString& buildKey, std::span<const char* const> patterns,
+                                            const std::vector<std::optional<size_t>>& matches) {
+    // A scan that found nothing is more likely a read problem than a build
+    // without any of the signatures; don't pin it
+    if (std::none_of(matches.begin(), matches.end(), [](const auto& match) { return match.has_value(); })) {
+        return;
+    }
+    
+    QString path = signatureCachePath(buildKey);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write signature cache {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << SIGNATURE_CACHE_MAGIC << SIGNATURE_CACHE_VERSION << buildKey
+        << static_cast<quint32>(patterns.size());
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        out << QString::fromLatin1(patterns[i]) << matches[i].has_value()
+            << static_cast<quint64>(matches[i].value_or(0));
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit signature cache {}", path.toStdString());
+    }
+}
+
 void CharacterExtractor::debugDumpProperties(uint64_t entityAddress) {
     if (!isConnected()) return;
 
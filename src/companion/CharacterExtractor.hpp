@@ -9,11 +9,16 @@
 #pragma once
 
 #include "LotroMemoryConfig.hpp"
+#include "PatternScanner.hpp"
 #include "ProcessMemory.hpp"
+#include "RemoteHashtable.hpp"
+#include "SyncMetrics.hpp"
 #include "dat/DataFacade.hpp"
 
+#include <QHash>
 #include <QString>
 
+#include <array>
 #include <map>
 #include <memory>
 #include <optional>
@@ -78,6 +83,32 @@ struct CharacterInfo {
     }
 };
 
+/**
+ * Groups of CharacterInfo fields, tracked for changes between syncs
+ */
+enum class CharacterGroup {
+    Identity,   // Name, surname, class, race, server, account
+    Level,
+    Vitals,     // Morale and power, current and max
+    Money,
+    Account,    // Account type, destiny and LOTRO points
+    Count
+};
+
+/**
+ * Field groups that changed since the previous sync
+ */
+struct CharacterChangeSet {
+    uint32_t groups = 0;
+    
+    bool any() const { return groups != 0; }
+    bool has(CharacterGroup group) const { return (groups & bit(group)) != 0; }
+    void mark(CharacterGroup group) { groups |= bit(group); }
+    
+private:
+    static uint32_t bit(CharacterGroup group) { return 1u << static_cast<int>(group); }
+};
+
 /**
  * Single virtue status
  */
@@ -86,6 +117,8 @@ struct VirtueStatus {
     QString name;      // Display name
     int rank = 0;      // Current rank (0-80+)
     int xp = 0;        // Current XP
+    
+    bool operator==(const VirtueStatus&) const = default;
 };
 
 /**
@@ -98,6 +131,8 @@ struct FactionStatus {
     QString category;  // e.g., "Eriador", "Rhovanion"
     int tier = 0;      // Current tier (1-7 typically: Enemy to Kindred)
     int reputation = 0; // Total earned reputation
+    
+    bool operator==(const FactionStatus&) const = default;
 };
 
 /**
@@ -109,6 +144,8 @@ struct CraftingProfessionStatus {
     int proficiency = 0;  // Proficiency points in current tier
     int mastery = 0;      // Mastery points in current tier
     bool hasMastered = false;
+    
+    bool operator==(const CraftingProfessionStatus&) const = default;
 };
 
 /**
@@ -117,6 +154,8 @@ struct CraftingProfessionStatus {
 struct CraftingStatus {
     QString vocation;
     std::vector<CraftingProfessionStatus> professions;
+    
+    bool operator==(const CraftingStatus&) const = default;
 };
 
 /**
@@ -176,6 +215,33 @@ public:
      */
     bool connect();
     
+    /**
+     * Connect to a memory capture instead of a running client
+     * 
+     * Extraction then reads the captured memory, so its cost and results
+     * can be measured without the game running.
+     */
+    bool connectRecording(const QString& path);
+    
+    /**
+     * Capture every read of the next connection and its first extraction
+     * to a file, for connectRecording() to replay
+     */
+    void setCapturePath(const QString& path) { m_capturePath = path; }
+    
+    /**
+     * Keep memory read by one extraction for the next, refetching only the
+     * pages the client wrote to in between; takes effect on connect()
+     */
+    void setDirtyPageTracking(bool enabled) { m_dirtyPageTracking = enabled; }
+    
+    /**
+     * The character decoded while the replayed capture was made, to
+     * compare a replay's result against; only the identity, level and
+     * money fields are kept
+     */
+    std::optional<CharacterInfo> capturedCharacter() const;
+    
     /**
      * Disconnect from LOTRO client
      */
@@ -186,12 +252,36 @@ public:
      */
     bool isConnected() const;
     
+    /**
+     * Check whether the client is running and not minimized or stopped
+     */
+    bool isGameActive() const;
+    
+    /**
+     * Record stage timings into metrics (nullptr to stop)
+     */
+    void setMetrics(SyncMetrics* metrics) { m_metrics = metrics; }
+    
+    /**
+     * Remote read counters of the current connection
+     */
+    const ProcessMemory::ReadStats& readStats() const { return m_memory->readStats(); }
+    
     /**
      * Get current character info
      * @return Character info or nullopt if extraction failed
      */
     std::optional<CharacterInfo> extractCharacter();
     
+    /**
+     * Compare a character with the one passed to the previous call
+     * 
+     * Each field group is reduced to a value hash; only the hashes are
+     * kept between calls. The first call after connecting reports every
+     * group as changed.
+     */
+    CharacterChangeSet diffCharacter(const CharacterInfo& info);
+    
     /**
      * Extract full character data including virtues, reputation, crafting
      * @return Complete character data or nullopt if extraction failed
@@ -224,20 +314,45 @@ private:
     std::optional<float> readFloatProperty(uint64_t entityAddress, uint32_t propId);
     std::vector<int> readArrayProperty(uint64_t entityAddress, uint32_t propId);
     
-    // Find player entity in entities table
+    // Find player entity in entities table; the last result is reused
+    // while its table node still maps the same instance to it
     std::optional<uint64_t> findPlayerEntity();
     
+    // Full entities table scan: refreshes m_entityDataIds and the player cache
+    std::optional<uint64_t> scanEntitiesTable();
+    
     // Read client data structure
     bool readClientData();
     
+    // Pattern scan, client data and the rest of connecting once the
+    // process (or capture) is open
+    bool finishConnect(bool is64Bit);
+    
     // Scan for memory patterns
     bool scanPatterns();
     
+    // Save the capture once an extraction has finished, noting what it decoded
+    void finishCapture(const CharacterInfo& info);
+    
+    // Signature match cache, keyed by the client build
+    static std::optional<QString> moduleBuildKey(ProcessMemory& memory, uint64_t moduleBase);
+    static QString signatureCachePath(const QString& buildKey);
+    bool loadSignatureCache(const QString& buildKey, const PatternScanner& scanner,
+                            std::span<const char* const> patterns, uint64_t moduleBase,
+                            std::vector<std::optional<size_t>>& matches);
+    static void saveSignatureCache(const QString& buildKey, std::span<const char* const> patterns,
+                                   const std::vector<std::optional<size_t>>& matches);
+    
+    static constexpr quint32 SIGNATURE_CACHE_MAGIC = 0x4749534C; // "LSIG"
+    static constexpr quint32 SIGNATURE_CACHE_VERSION = 1;
+    
     // Debug: Dump all properties of an entity to find string values
     void debugDumpProperties(uint64_t entityAddress);
     
     std::unique_ptr<ProcessMemory> m_memory;
     LotroMemoryConfig m_config;
+    QString m_capturePath;
+    bool m_dirtyPageTracking = false;
     QString m_lastError;
     
     // Cached data
@@ -246,7 +361,7 @@ private:
     
     // DAT file access for property resolution
     QString m_gamePath;
-    std::unique_ptr<dat::DataFacade> m_datFacade;
+    std::shared_ptr<dat::DataFacade> m_datFacade;   // shared with other consumers
     
     // Cached property IDs (resolved from DAT files)
     int m_namePropertyId = -1;
@@ -270,9 +385,61 @@ private:
     int m_destinyPointsPropertyId = -1;
     int m_lotroPointsPropertyId = -1;
     
+    // Property IDs read by extractFullData(), resolved once per registry.
+    // Each list is indexed like the matching name table in the .cpp.
+    struct ExtendedPropertyIds {
+        struct Virtue { int rank = -1; int xp = -1; };
+        struct Faction { int tier = -1; int reputation = -1; };
+        struct Profession {
+            int enabled = -1;
+            int mastery = -1;
+            int proficiency = -1;
+            int masteryXp = -1;
+            int proficiencyXp = -1;
+        };
+        
+        std::vector<Virtue> virtues;
+        std::vector<Faction> factions;
+        std::vector<Profession> professions;
+        std::vector<int> equipment;
+        std::vector<int> currencies;
+        int title = -1;
+        int titleCandidate = -1;    // Index of the title name that resolved
+        int emotes = -1;
+        bool resolved = false;
+    };
+    ExtendedPropertyIds m_extendedIds;
+    
+    void resolveExtendedPropertyIds(const dat::PropertiesRegistry& registry);
+    
+    // Basic info of a found player entity, read within the caller's snapshot
+    CharacterInfo decodeCharacter(uint64_t playerEntity);
+    
+    // Entity whose property table readPropertyValue() last located
+    struct PropertyOwner {
+        uint64_t entity = 0;
+        uint64_t generation = 0;
+        uint64_t hashtableBase = 0;
+    };
+    PropertyOwner m_propertyOwner;
+    
+    SyncMetrics* m_metrics = nullptr;
+    uint64_t m_propertyReadUs = 0;   // Running total of table loads, so Decode can exclude them
+    
+    // Record a decode started at timer, minus the table loads it triggered
+    void recordDecode(const QElapsedTimer& timer, uint64_t propertyReadUsBefore);
+    
+    // Equipment slot structs fetched in one batch by extractFullData()
+    MemoryBatch m_equipmentReads;
+    std::vector<size_t> m_equipmentSlots;   // EQUIPMENT_SLOTS index per read
+    
     // Internal helper to read value from a generic properties hashtable
     std::optional<uint64_t> readHashtableValue(uint64_t hashtableBaseAddr, uint32_t propId);
     
+    // Local copy of the hashtable at an address, read once per memory
+    // snapshot (and afresh on every call outside one); nullptr if invalid
+    const RemoteHashtable* propertyTable(uint64_t hashtableBaseAddr);
+    
     // Helper to read account property
     std::optional<uint64_t> readAccountPropertyValue(uint32_t propId);
     std::optional<QString> readAccountStringProperty(uint32_t propId);
@@ -284,6 +451,41 @@ private:
     // Entity instance ID → DataID mapping (populated during entity scan)
     std::map<uint64_t, uint32_t> m_entityDataIds;
     
+    // Hashtable walk scratch, kept across syncs so the walks stop
+    // allocating once they have seen the largest tables
+    struct EntityNode {
+        uint64_t nodeAddress;
+        uint64_t instanceId;
+        uint64_t worldEntityPtr;
+    };
+    struct EntityLinks {
+        size_t node;
+        int ciRead = -1;
+        int eppRead = -1;
+    };
+    MemoryBatch m_hops;
+    MemoryBatch m_nextHops;
+    std::vector<EntityNode> m_entityNodes;
+    MemoryBatch m_entityReads;
+    std::vector<EntityLinks> m_entityLinks;
+    MemoryBatch m_linkReads;
+    
+    std::unordered_map<uint64_t, RemoteHashtable> m_tables;
+    uint64_t m_tablesGeneration = 0;
+    
+    // Value hash per CharacterGroup of the last diffCharacter() call
+    std::array<size_t, static_cast<size_t>(CharacterGroup::Count)> m_groupHashes{};
+    bool m_haveGroupHashes = false;
+    
+    // Player entity found by the last full scan
+    struct PlayerEntityCache {
+        uint64_t nodeAddress = 0;
+        uint64_t instanceId = 0;
+        uint64_t address = 0;
+    };
+    std::optional<PlayerEntityCache> m_playerCache;
+    uint64_t m_entityScanGeneration = 0;   // Snapshot of the last full scan
+    
     // WSL References Table helpers for title extraction
     std::vector<int> extractTitlesFromWSL();
     
@@ -0,0 +1,474 @@
+/**
+ * LOTRO Launcher - Character History Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "CharacterHistory.hpp"
+#include "CharacterTracker.hpp"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace lotro {
+
+namespace {
+
+constexpr quint32 HISTORY_MAGIC = 0x5349484C;   // "LHIS"
+constexpr quint16 HISTORY_VERSION = 1;
+constexpr qint64 HEADER_SIZE = 32;
+
+void putVarint(QByteArray& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+bool getVarint(const char*& p, const char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(*p++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+int64_t toSeconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromSeconds(int64_t seconds) {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+}
+
+QString fileSafe(const QString& text) {
+    QString result;
+    result.reserve(text.size());
+    for (QChar c : text) {
+        result.append(c.isLetterOrNumber() || c == '-' ? c : QChar('_'));
+    }
+    return result;
+}
+
+struct BlockHeader {
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint16 seriesCount = 0;
+    quint32 rowCount = 0;
+    qint64 firstTime = 0;
+    qint64 lastTime = 0;
+    quint32 payloadSize = 0;
+};
+
+// Stored block decoded up to the start of the columns
+struct DecodedBlock {
+    struct Series {
+        QString key;
+        size_t firstRow = 0;
+        size_t bytes = 0;
+    };
+    
+    QByteArray raw;
+    std::vector<Series> series;
+    std::vector<int64_t> times;
+    const char* columns = nullptr;
+    const char* end = nullptr;
+};
+
+bool decodeDictionary(DecodedBlock& block, bool withTimes, quint32 rowCount) {
+    const char* p = block.raw.constData();
+    block.end = p + block.raw.size();
+    
+    uint64_t count = 0;
+    if (!getVarint(p, block.end, count)) {
+        return false;
+    }
+    block.series.reserve(static_cast<size_t>(count));
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t length = 0, firstRow = 0, bytes = 0;
+        if (!getVarint(p, block.end, length) || length > static_cast<uint64_t>(block.end - p)) {
+            return false;
+        }
+        QString key = QString::fromUtf8(p, static_cast<qsizetype>(length));
+        p += length;
+        if (!getVarint(p, block.end, firstRow) || !getVarint(p, block.end, bytes)) {
+            return false;
+        }
+        block.series.push_back({key, static_cast<size_t>(firstRow), static_cast<size_t>(bytes)});
+    }
+    if (!withTimes) {
+        return true;
+    }
+    
+    block.times.reserve(rowCount);
+    int64_t time = 0;
+    for (quint32 i = 0; i < rowCount; ++i) {
+        uint64_t delta = 0;
+        if (!getVarint(p, block.end, delta)) {
+            return false;
+        }
+        time += unzigzag(delta);
+        block.times.push_back(time);
+    }
+    block.columns = p;
+    return true;
+}
+
+} // anonymous namespace
+
+void CharacterHistory::OpenBlock::clear() {
+    times.clear();
+    series.clear();
+    seriesIndex.clear();
+    firstRow.clear();
+    values.clear();
+}
+
+CharacterHistory::CharacterHistory(const std::filesystem::path& directory)
+    : m_directory(directory)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+    if (ec) {
+        spdlog::warn("Failed to create history directory {}: {}", m_directory.string(), ec.message());
+    }
+}
+
+CharacterHistory::~CharacterHistory() {
+    flush();
+}
+
+std::vector<std::pair<QString, int64_t>> CharacterHistory::sample(const Character& character) {
+    std::vector<std::pair<QString, int64_t>> values;
+    values.emplace_back("level", character.level);
+    values.emplace_back("money", static_cast<int64_t>(character.gold) * 100000
+                                 + static_cast<int64_t>(character.silver) * 100 + character.copper);
+    values.emplace_back("destinyPoints", character.destinyPoints);
+    values.emplace_back("lotroPoints", character.lotroPoints);
+    
+    if (character.hasExtendedData) {
+        for (const auto& virtue : character.virtues) {
+            values.emplace_back("virtue." + virtue.key + ".rank", virtue.rank);
+            values.emplace_back("virtue." + virtue.key + ".xp", virtue.xp);
+        }
+        for (const auto& faction : character.factions) {
+            QString key = faction.key.isEmpty() ? QString::number(faction.factionId) : faction.key;
+            values.emplace_back("faction." + key + ".tier", faction.tier);
+            values.emplace_back("faction." + key + ".reputation", faction.reputation);
+        }
+        for (const auto& profession : character.crafting.professions) {
+            values.emplace_back("craft." + profession.name + ".tier", profession.tier);
+            values.emplace_back("craft." + profession.name + ".proficiency", profession.proficiency);
+            values.emplace_back("craft." + profession.name + ".mastery", profession.mastery);
+        }
+    }
+    return values;
+}
+
+CharacterHistory::Track& CharacterHistory::track(const QString& name, const QString& server) const {
+    Key key(server, name);
+    auto it = m_tracks.find(key);
+    if (it == m_tracks.end()) {
+        Track created;
+        created.file = m_directory / (fileSafe(server) + "_" + fileSafe(name) + ".hist").toStdString();
+        it = m_tracks.insert(key, std::move(created));
+    }
+    if (!it->indexed) {
+        index(*it);
+    }
+    return *it;
+}
+
+void CharacterHistory::index(Track& track) const {
+    track.indexed = true;
+    track.blocks.clear();
+    
+    QFile file(QString::fromStdString(track.file.string()));
+    if (!file.exists()) {
+        return;
+    }
+    if (!file.open(QIODevice::ReadWrite)) {
+        spdlog::warn("Failed to open history {}", track.file.string());
+        return;
+    }
+    
+    // Only the headers are read; payloads are skipped over
+    const qint64 size = file.size();
+    qint64 offset = 0;
+    while (size - offset >= HEADER_SIZE) {
+        file.seek(offset);
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_6_0);
+        BlockHeader header;
+        in >> header.magic >> header.version >> header.seriesCount >> header.rowCount
+           >> header.firstTime >> header.lastTime >> header.payloadSize;
+        if (in.status() != QDataStream::Ok || header.magic != HISTORY_MAGIC
+            || header.version != HISTORY_VERSION
+            || offset + HEADER_SIZE + header.payloadSize > size) {
+            break;
+        }
+        track.blocks.push_back({offset, header.firstTime, header.lastTime, header.payloadSize});
+        offset += HEADER_SIZE + header.payloadSize;
+    }
+    
+    // A block cut short by a crash would hide everything appended after it
+    if (offset < size) {
+        spdlog::warn("Truncating damaged history {} at {} bytes", track.file.string(), offset);
+        file.resize(offset);
+    }
+}
+
+void CharacterHistory::record(const Character& character, std::chrono::system_clock::time_point time) {
+    if (character.name.isEmpty() || character.server.isEmpty()) {
+        return;
+    }
+    
+    QMutexLocker lock(&m_mutex);
+    Track& t = track(character.name, character.server);
+    auto values = sample(character);
+    
+    bool changed = t.last.isEmpty();
+    for (const auto& [key, value] : values) {
+        auto it = t.last.constFind(key);
+        if (it == t.last.constEnd() || it.value() != value) {
+            changed = true;
+            break;
+        }
+    }
+    if (!changed) {
+        return;
+    }
+    
+    OpenBlock& open = t.open;
+    const size_t row = open.rows();
+    open.times.push_back(toSeconds(time));
+    for (const auto& [key, value] : values) {
+        t.last.insert(key, value);
+        auto it = open.seriesIndex.constFind(key);
+        if (it == open.seriesIndex.constEnd()) {
+            it = open.seriesIndex.insert(key, open.series.size());
+            open.series.push_back(key);
+            open.firstRow.push_back(row);
+            open.values.emplace_back();
+        }
+        open.values[it.value()].push_back(value);
+    }
+    
+    // Series missing from this sample keep their previous value
+    for (size_t s = 0; s < open.series.size(); ++s) {
+        auto& column = open.values[s];
+        if (open.firstRow[s] + column.size() <= row) {
+            column.push_back(column.back());
+        }
+    }
+    
+    if (open.rows() >= BLOCK_ROWS || open.times.back() - open.times.front() >= FLUSH_AFTER_SECONDS) {
+        writeBlock(t);
+    }
+}
+
+bool CharacterHistory::writeBlock(Track& track) const {
+    OpenBlock& open = track.open;
+    if (open.rows() == 0) {
+        return true;
+    }
+    
+    std::vector<QByteArray> columns(open.series.size());
+    for (size_t s = 0; s < open.series.size(); ++s) {
+        int64_t previous = 0;
+        for (int64_t value : open.values[s]) {
+            putVarint(columns[s], zigzag(value - previous));
+            previous = value;
+        }
+    }
+    
+    QByteArray raw;
+    putVarint(raw, open.series.size());
+    for (size_t s = 0; s < open.series.size(); ++s) {
+        QByteArray key = open.series[s].toUtf8();
+        putVarint(raw, static_cast<uint64_t>(key.size()));
+        raw.append(key);
+        putVarint(raw, open.firstRow[s]);
+        putVarint(raw, static_cast<uint64_t>(columns[s].size()));
+    }
+    int64_t previous = 0;
+    for (int64_t time : open.times) {
+        putVarint(raw, zigzag(time - previous));
+        previous = time;
+    }
+    for (const auto& column : columns) {
+        raw.append(column);
+    }
+    QByteArray payload = qCompress(raw);
+    
+    QByteArray block;
+    {
+        QDataStream out(&block, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << HISTORY_MAGIC << HISTORY_VERSION << static_cast<quint16>(open.series.size())
+            << static_cast<quint32>(open.rows()) << static_cast<qint64>(open.times.front())
+            << static_cast<qint64>(open.times.back()) << static_cast<quint32>(payload.size());
+    }
+    block.append(payload);
+    
+    QFile file(QString::fromStdString(track.file.string()));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        spdlog::error("Failed to open history {} for writing", track.file.string());
+        return false;
+    }
+    qint64 offset = file.size();
+    if (file.write(block) != block.size()) {
+        spdlog::error("Failed to append to history {}", track.file.string());
+        file.resize(offset);
+        return false;
+    }
+    
+    track.blocks.push_back({offset, open.times.front(), open.times.back(),
+                            static_cast<quint32>(payload.size())});
+    spdlog::debug("History block for {}: {} rows, {} series, {} bytes", track.file.filename().string(),
+                  open.rows(), open.series.size(), block.size());
+    open.clear();
+    return true;
+}
+
+bool CharacterHistory::readBlock(const Track& track, const BlockInfo& info, const QString& series,
+                                 int64_t from, int64_t to, std::vector<HistoryPoint>& out) const {
+    QFile file(QString::fromStdString(track.file.string()));
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(info.offset)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    BlockHeader header;
+    in >> header.magic >> header.version >> header.seriesCount >> header.rowCount
+       >> header.firstTime >> header.lastTime >> header.payloadSize;
+    
+    DecodedBlock block;
+    block.raw = qUncompress(file.read(info.payloadSize));
+    if (block.raw.isEmpty() || !decodeDictionary(block, true, header.rowCount)) {
+        spdlog::warn("Corrupt history block at {} in {}", info.offset, track.file.string());
+        return false;
+    }
+    
+    // Skip the columns before the requested one
+    const char* p = block.columns;
+    for (const auto& s : block.series) {
+        if (static_cast<size_t>(block.end - p) < s.bytes) {
+            return false;
+        }
+        if (s.key != series) {
+            p += s.bytes;
+            continue;
+        }
+        const char* end = p + s.bytes;
+        int64_t value = 0;
+        for (size_t row = s.firstRow; row < block.times.size(); ++row) {
+            uint64_t delta = 0;
+            if (!getVarint(p, end, delta)) {
+                return false;
+            }
+            value += unzigzag(delta);
+            if (block.times[row] >= from && block.times[row] <= to) {
+                out.push_back({fromSeconds(block.times[row]), value});
+            }
+        }
+        return true;
+    }
+    return true;
+}
+
+std::vector<HistoryPoint> CharacterHistory::query(const QString& name, const QString& server,
+                                                  const QString& series,
+                                                  std::chrono::system_clock::time_point from,
+                                                  std::chrono::system_clock::time_point to) const {
+    QMutexLocker lock(&m_mutex);
+    Track& t = track(name, server);
+    const int64_t fromTime = toSeconds(from);
+    const int64_t toTime = toSeconds(to);
+    
+    std::vector<HistoryPoint> result;
+    for (const auto& block : t.blocks) {
+        if (block.lastTime < fromTime || block.firstTime > toTime) {
+            continue;
+        }
+        readBlock(t, block, series, fromTime, toTime, result);
+    }
+    
+    const OpenBlock& open = t.open;
+    auto it = open.seriesIndex.constFind(series);
+    if (it != open.seriesIndex.constEnd()) {
+        const size_t s = it.value();
+        for (size_t i = 0; i < open.values[s].size(); ++i) {
+            int64_t time = open.times[open.firstRow[s] + i];
+            if (time >= fromTime && time <= toTime) {
+                result.push_back({fromSeconds(time), open.values[s][i]});
+            }
+        }
+    }
+    return result;
+}
+
+QStringList CharacterHistory::readSeriesNames(const Track& track, const BlockInfo& info) const {
+    QFile file(QString::fromStdString(track.file.string()));
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(info.offset + HEADER_SIZE)) {
+        return {};
+    }
+    DecodedBlock block;
+    block.raw = qUncompress(file.read(info.payloadSize));
+    if (block.raw.isEmpty() || !decodeDictionary(block, false, 0)) {
+        return {};
+    }
+    QStringList names;
+    for (const auto& s : block.series) {
+        names.append(s.key);
+    }
+    return names;
+}
+
+QStringList CharacterHistory::seriesNames(const QString& name, const QString& server) const {
+    QMutexLocker lock(&m_mutex);
+    Track& t = track(name, server);
+    QStringList names;
+    if (!t.blocks.empty()) {
+        names = readSeriesNames(t, t.blocks.back());
+    }
+    for (const auto& key : t.open.series) {
+        if (!names.contains(key)) {
+            names.append(key);
+        }
+    }
+    return names;
+}
+
+void CharacterHistory::flush() {
+    QMutexLocker lock(&m_mutex);
+    for (auto it = m_tracks.begin(); it != m_tracks.end(); ++it) {
+        writeBlock(*it);
+    }
+}
+
+void CharacterHistory::remove(const QString& name, const QString& server) {
+    QMutexLocker lock(&m_mutex);
+    Track& t = track(name, server);
+    std::error_code ec;
+    std::filesystem::remove(t.file, ec);
+    m_tracks.remove(Key(server, name));
+}
+
+} // namespace lotro
@@ -0,0 +1,145 @@
+/**
+ * LOTRO Launcher - Character History
+ * 
+ * Time-series store of character progression (level, wallet, virtues,
+ * reputation, crafting) for progress charts.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+namespace lotro {
+
+struct Character;
+
+/**
+ * One value of a series at a point in time
+ */
+struct HistoryPoint {
+    std::chrono::system_clock::time_point time;
+    int64_t value = 0;
+};
+
+/**
+ * Columnar progression history, one file per character
+ * 
+ * Every save records a sample: named series such as "level", "money" (in
+ * copper), "virtue.<key>.rank", "faction.<key>.reputation" or
+ * "craft.<profession>.proficiency". Samples equal to the previous one are
+ * dropped. Rows collect in an open block that is appended to the file
+ * once it holds BLOCK_ROWS rows or spans FLUSH_AFTER_SECONDS, and on
+ * flush() or destruction.
+ * 
+ * A block is a fixed header (row count, first and last time, payload size)
+ * followed by a zlib-compressed payload: a dictionary of series with the
+ * byte length of each column, delta-encoded timestamps, then one column
+ * of zigzag varint deltas per series. A series missing from a sample
+ * keeps its previous value. Opening a character reads only the block
+ * headers, and a range query decompresses just the blocks it overlaps and
+ * decodes just the requested column, so months of samples are never held
+ * in memory at once.
+ * 
+ * All methods may be called from any thread.
+ */
+class CharacterHistory {
+public:
+    explicit CharacterHistory(const std::filesystem::path& directory);
+    ~CharacterHistory();
+    
+    CharacterHistory(const CharacterHistory&) = delete;
+    CharacterHistory& operator=(const CharacterHistory&) = delete;
+    
+    /**
+     * Record a sample of a character's progression
+     */
+    void record(const Character& character,
+                std::chrono::system_clock::time_point time = std::chrono::system_clock::now());
+    
+    /**
+     * Values of one series within [from, to], oldest first
+     */
+    std::vector<HistoryPoint> query(const QString& name, const QString& server,
+                                    const QString& series,
+                                    std::chrono::system_clock::time_point from,
+                                    std::chrono::system_clock::time_point to) const;
+    
+    /**
+     * Series recorded for a character in its most recent block
+     */
+    QStringList seriesNames(const QString& name, const QString& server) const;
+    
+    /**
+     * Write every open block to disk
+     */
+    void flush();
+    
+    /**
+     * Drop a character's history
+     */
+    void remove(const QString& name, const QString& server);
+    
+    /**
+     * Series values of a character, as record() stores them
+     */
+    static std::vector<std::pair<QString, int64_t>> sample(const Character& character);
+    
+    static constexpr size_t BLOCK_ROWS = 512;
+    static constexpr int64_t FLUSH_AFTER_SECONDS = 60 * 60;
+
+private:
+    using Key = std::pair<QString, QString>;   // (server, name)
+    
+    struct BlockInfo {
+        qint64 offset = 0;          // Of the header
+        int64_t firstTime = 0;      // Seconds since epoch
+        int64_t lastTime = 0;
+        quint32 payloadSize = 0;
+    };
+    
+    // Rows not yet written, kept in the same shape as a decoded block
+    struct OpenBlock {
+        std::vector<int64_t> times;
+        std::vector<QString> series;
+        QHash<QString, size_t> seriesIndex;
+        std::vector<size_t> firstRow;             // Per series
+        std::vector<std::vector<int64_t>> values; // Per series, from firstRow
+        
+        size_t rows() const { return times.size(); }
+        void clear();
+    };
+    
+    struct Track {
+        std::filesystem::path file;
+        bool indexed = false;
+        std::vector<BlockInfo> blocks;
+        OpenBlock open;
+        QHash<QString, int64_t> last;   // Latest value per series
+    };
+    
+    Track& track(const QString& name, const QString& server) const;
+    void index(Track& track) const;
+    bool writeBlock(Track& track) const;
+    
+    // Decode one series of a stored block, calling out for each row in range
+    bool readBlock(const Track& track, const BlockInfo& block, const QString& series,
+                   int64_t from, int64_t to, std::vector<HistoryPoint>& out) const;
+    QStringList readSeriesNames(const Track& track, const BlockInfo& block) const;
+    
+    std::filesystem::path m_directory;
+    mutable QMutex m_mutex;
+    mutable QHash<Key, Track> m_tracks;
+};
+
+} // namespace lotro
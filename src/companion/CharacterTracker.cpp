@@ -7,7 +7,10 @@
  */
 
 #include "CharacterTracker.hpp"
+#include "CompletionIndex.hpp"
 
+#include <QHash>
+#include <QRecursiveMutex>
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <spdlog/spdlog.h>
@@ -161,6 +164,7 @@ static json characterToJson(const Character& c) {
         j["titles"] = c.titles;
         j["emotes"] = c.emotes;
         j["skills"] = c.skills;
+        j["completion"] = c.completion.toJson();
         
         // Trait points
         json traitJson = json::object();
@@ -263,6 +267,9 @@ static Character characterFromJson(const json& j) {
         if (j.contains("skills")) {
             c.skills = j["skills"].get<std::vector<int>>();
         }
+        if (j.contains("completion")) {
+            c.completion = CharacterCompletion::fromJson(j["completion"]);
+        }
         
         // Trait points
         if (j.contains("traitPoints")) {
@@ -275,16 +282,215 @@ static Character characterFromJson(const json& j) {
     return c;
 }
 
+// ============ Roster Aggregates ============
+
+// Running totals over a group of characters. Every character is added
+// once and removed with the same values it was added with; maxima keep a
+// count per value so a removal can fall back to the next best.
+class RosterAggregate {
+public:
+    void add(const Character& c) { apply(c, 1); }
+    void subtract(const Character& c) { apply(c, -1); }
+    
+    bool isEmpty() const { return m_characters == 0; }
+    
+    RosterSummary summary() const {
+        RosterSummary s;
+        s.characterCount = m_characters;
+        s.highestLevel = m_levelCounts.empty() ? 0 : m_levelCounts.rbegin()->first;
+        s.totalLevels = m_levels;
+        s.totalCopper = m_copper;
+        s.totalDestinyPoints = m_destinyPoints;
+        s.classCounts = m_classCounts;
+        for (const auto& [profession, tiers] : m_craftingTiers) {
+            s.bestCraftingTier[profession] = tiers.rbegin()->first;
+        }
+        s.bestFactions.reserve(m_factions.size());
+        for (const auto& [id, standings] : m_factions) {
+            SavedFaction best = standings.info;
+            best.tier = standings.counts.rbegin()->first.first;
+            best.reputation = standings.counts.rbegin()->first.second;
+            s.bestFactions.push_back(best);
+        }
+        return s;
+    }
+    
+private:
+    template<typename Map, typename Key>
+    static void bump(Map& counts, const Key& key, int delta) {
+        auto it = counts.try_emplace(key, 0).first;
+        it->second += delta;
+        if (it->second <= 0) {
+            counts.erase(it);
+        }
+    }
+    
+    void apply(const Character& c, int delta) {
+        m_characters += delta;
+        m_levels += delta * static_cast<int64_t>(c.level);
+        m_copper += delta * (static_cast<int64_t>(c.gold) * 100000 + static_cast<int64_t>(c.silver) * 100 + c.copper);
+        m_destinyPoints += delta * static_cast<int64_t>(c.destinyPoints);
+        bump(m_levelCounts, c.level, delta);
+        bump(m_classCounts, c.characterClass, delta);
+        
+        for (const SavedCraftingProfession& profession : c.crafting.professions) {
+            auto& tiers = m_craftingTiers[profession.name];
+            bump(tiers, profession.tier, delta);
+            if (tiers.empty()) {
+                m_craftingTiers.erase(profession.name);
+            }
+        }
+        
+        for (const SavedFaction& faction : c.factions) {
+            FactionStandings& standings = m_factions[faction.factionId];
+            if (delta > 0) {
+                standings.info = faction;
+            }
+            bump(standings.counts, std::make_pair(faction.tier, faction.reputation), delta);
+            if (standings.counts.empty()) {
+                m_factions.erase(faction.factionId);
+            }
+        }
+    }
+    
+    struct FactionStandings {
+        SavedFaction info;                              // Names from the latest character added
+        std::map<std::pair<int, int>, int> counts;      // (tier, reputation) -> characters
+    };
+    
+    int m_characters = 0;
+    int64_t m_levels = 0;
+    int64_t m_copper = 0;
+    int64_t m_destinyPoints = 0;
+    std::map<int, int> m_levelCounts;
+    std::map<CharacterClass, int> m_classCounts;
+    std::map<QString, std::map<int, int>> m_craftingTiers;  // Profession -> tier -> characters
+    std::map<int, FactionStandings> m_factions;
+};
+
 // ============ Implementation Class ============
 
+// characters.json holds a compacted snapshot; every change since then is a
+// line in characters.journal ({"op": "put" | "remove" | "lastPlayed", ...}).
+// Loading replays the journal over the snapshot, and once it has grown past
+// COMPACT_AFTER entries the snapshot is rewritten and the journal dropped.
 class CharacterTracker::Impl {
 public:
+    using Key = std::pair<QString, QString>;   // (server, name)
+    
+    static constexpr size_t COMPACT_AFTER = 256;
+    
+    // Held by every public method; the live-sync saver writes from a
+    // background thread while the UI reads
+    mutable QRecursiveMutex mutex;
+    
     std::filesystem::path dataDir;
     std::vector<Character> characters;
+    QHash<Key, size_t> index;                  // Key -> position in characters
+    size_t journalEntries = 0;
+    std::unique_ptr<CharacterHistory> history;
+    
+    // Maintained by put() and remove()
+    RosterAggregate everyone;
+    QHash<QString, RosterAggregate> byAccount;
+    QHash<QString, RosterAggregate> byServer;
     
     std::filesystem::path getFilePath() const {
         return dataDir / "characters.json";
     }
+    
+    std::filesystem::path getJournalPath() const {
+        return dataDir / "characters.journal";
+    }
+    
+    Character* find(const QString& name, const QString& server) {
+        auto it = index.constFind(Key(server, name));
+        return it != index.constEnd() ? &characters[it.value()] : nullptr;
+    }
+    
+    void put(const Character& character) {
+        if (Character* existing = find(character.name, character.server)) {
+            aggregate(*existing, false);
+            *existing = character;
+        } else {
+            index.insert(Key(character.server, character.name), characters.size());
+            characters.push_back(character);
+        }
+        aggregate(character, true);
+    }
+    
+    void aggregate(const Character& character, bool add) {
+        auto update = [&](RosterAggregate& totals) {
+            add ? totals.add(character) : totals.subtract(character);
+        };
+        update(everyone);
+        update(byAccount[character.accountName]);
+        update(byServer[character.server]);
+        if (!add) {
+            if (byAccount[character.accountName].isEmpty()) {
+                byAccount.remove(character.accountName);
+            }
+            if (byServer[character.server].isEmpty()) {
+                byServer.remove(character.server);
+            }
+        }
+    }
+    
+    void rebuildAggregates() {
+        everyone = RosterAggregate();
+        byAccount.clear();
+        byServer.clear();
+        for (const Character& c : characters) {
+            aggregate(c, true);
+        }
+    }
+    
+    bool remove(const QString& name, const QString& server) {
+        auto it = index.constFind(Key(server, name));
+        if (it == index.constEnd()) {
+            return false;
+        }
+        aggregate(characters[it.value()], false);
+        characters.erase(characters.begin() + static_cast<std::ptrdiff_t>(it.value()));
+        reindex();
+        return true;
+    }
+    
+    void reindex() {
+        index.clear();
+        index.reserve(static_cast<qsizetype>(characters.size()));
+        for (size_t i = 0; i < characters.size(); ++i) {
+            index.insert(Key(characters[i].server, characters[i].name), i);
+        }
+    }
+    
+    // Apply one journal entry; false if it is malformed
+    bool replay(const json& entry) {
+        std::string op = entry.value("op", "");
+        if (op == "put" && entry.contains("character")) {
+            Character c = characterFromJson(entry["character"]);
+            if (c.name.isEmpty() || c.server.isEmpty()) {
+                return false;
+            }
+            put(c);
+            return true;
+        }
+        
+        QString name = QString::fromStdString(entry.value("name", ""));
+        QString server = QString::fromStdString(entry.value("server", ""));
+        if (op == "remove") {
+            remove(name, server);
+            return true;
+        }
+        if (op == "lastPlayed") {
+            if (Character* c = find(name, server)) {
+                c->lastPlayed = std::chrono::system_clock::time_point(
+                    std::chrono::seconds(entry.value("time", int64_t(0))));
+            }
+            return true;
+        }
+        return false;
+    }
 };
 
 CharacterTracker::CharacterTracker(const std::filesystem::path& dataDir)
@@ -295,19 +501,25 @@ CharacterTracker::CharacterTracker(const std::filesystem::path& dataDir)
     if (!std::filesystem::exists(dataDir)) {
         std::filesystem::create_directories(dataDir);
     }
+    m_impl->history = std::make_unique<CharacterHistory>(dataDir / "history");
     
     load();
 }
 
 CharacterTracker::~CharacterTracker() {
-    save();
+    QMutexLocker lock(&m_impl->mutex);
+    if (m_impl->journalEntries > 0) {
+        save();
+    }
 }
 
 std::vector<Character> CharacterTracker::getCharacters() const {
+    QMutexLocker lock(&m_impl->mutex);
     return m_impl->characters;
 }
 
 std::vector<Character> CharacterTracker::getCharacters(const QString& server) const {
+    QMutexLocker lock(&m_impl->mutex);
     std::vector<Character> result;
     for (const auto& c : m_impl->characters) {
         if (c.server == server) {
@@ -318,6 +530,7 @@ std::vector<Character> CharacterTracker::getCharacters(const QString& server) co
 }
 
 std::vector<Character> CharacterTracker::getCharactersByAccount(const QString& account) const {
+    QMutexLocker lock(&m_impl->mutex);
     std::vector<Character> result;
     for (const auto& c : m_impl->characters) {
         if (c.accountName == account) {
@@ -327,63 +540,90 @@ std::vector<Character> CharacterTracker::getCharactersByAccount(const QString& a
     return result;
 }
 
+RosterSummary CharacterTracker::summary() const {
+    QMutexLocker lock(&m_impl->mutex);
+    return m_impl->everyone.summary();
+}
+
+RosterSummary CharacterTracker::accountSummary(const QString& account) const {
+    QMutexLocker lock(&m_impl->mutex);
+    auto it = m_impl->byAccount.constFind(account);
+    return it != m_impl->byAccount.constEnd() ? it->summary() : RosterSummary();
+}
+
+RosterSummary CharacterTracker::serverSummary(const QString& server) const {
+    QMutexLocker lock(&m_impl->mutex);
+    auto it = m_impl->byServer.constFind(server);
+    return it != m_impl->byServer.constEnd() ? it->summary() : RosterSummary();
+}
+
 std::optional<Character> CharacterTracker::getCharacter(const QString& name, const QString& server) const {
-    for (const auto& c : m_impl->characters) {
-        if (c.name == name && c.server == server) {
-            return c;
-        }
+    QMutexLocker lock(&m_impl->mutex);
+    if (const Character* c = m_impl->find(name, server)) {
+        return *c;
     }
     return std::nullopt;
 }
 
 void CharacterTracker::saveCharacter(const Character& character) {
-    // Check if character already exists
-    for (auto& c : m_impl->characters) {
-        if (c.name == character.name && c.server == character.server) {
-            c = character;
-            save();
-            spdlog::info("Updated character: {} on {}", character.name.toStdString(), character.server.toStdString());
-            return;
-        }
+    QMutexLocker lock(&m_impl->mutex);
+    bool existed = m_impl->find(character.name, character.server) != nullptr;
+    Character stored = character;
+    if (stored.hasExtendedData) {
+        CompletionIndex::instance().rebuild(stored);
     }
+    m_impl->put(stored);
+    appendJournal({{"op", "put"}, {"character", characterToJson(stored)}});
+    m_impl->history->record(stored);
     
-    // Add new character
-    m_impl->characters.push_back(character);
-    save();
-    spdlog::info("Added new character: {} on {}", character.name.toStdString(), character.server.toStdString());
+    if (existed) {
+        spdlog::info("Updated character: {} on {}", character.name.toStdString(), character.server.toStdString());
+    } else {
+        spdlog::info("Added new character: {} on {}", character.name.toStdString(), character.server.toStdString());
+    }
 }
 
 bool CharacterTracker::removeCharacter(const QString& name, const QString& server) {
-    auto it = std::remove_if(m_impl->characters.begin(), m_impl->characters.end(),
-        [&](const Character& c) {
-            return c.name == name && c.server == server;
-        });
-    
-    if (it != m_impl->characters.end()) {
-        m_impl->characters.erase(it, m_impl->characters.end());
-        save();
-        spdlog::info("Removed character: {} on {}", name.toStdString(), server.toStdString());
-        return true;
+    QMutexLocker lock(&m_impl->mutex);
+    if (!m_impl->remove(name, server)) {
+        return false;
     }
-    return false;
+    appendJournal({{"op", "remove"}, {"name", name.toStdString()}, {"server", server.toStdString()}});
+    m_impl->history->remove(name, server);
+    spdlog::info("Removed character: {} on {}", name.toStdString(), server.toStdString());
+    return true;
 }
 
 void CharacterTracker::updateLastPlayed(const QString& name, const QString& server, 
                                          std::chrono::system_clock::time_point time) {
-    for (auto& c : m_impl->characters) {
-        if (c.name == name && c.server == server) {
-            c.lastPlayed = time;
-            save();
-            return;
-        }
+    QMutexLocker lock(&m_impl->mutex);
+    Character* c = m_impl->find(name, server);
+    if (!c) {
+        return;
     }
+    c->lastPlayed = time;
+    appendJournal({
+        {"op", "lastPlayed"},
+        {"name", name.toStdString()},
+        {"server", server.toStdString()},
+        {"time", std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count()}
+    });
 }
 
 int CharacterTracker::importFromClient() {
     return 0;
 }
 
+CharacterHistory& CharacterTracker::history() {
+    return *m_impl->history;
+}
+
+const CharacterHistory& CharacterTracker::history() const {
+    return *m_impl->history;
+}
+
 QString CharacterTracker::exportToJson() const {
+    QMutexLocker lock(&m_impl->mutex);
     json j = json::array();
     for (const auto& c : m_impl->characters) {
         j.push_back(characterToJson(c));
@@ -392,6 +632,7 @@ QString CharacterTracker::exportToJson() const {
 }
 
 int CharacterTracker::importFromJson(const QString& jsonStr) {
+    QMutexLocker lock(&m_impl->mutex);
     try {
         json j = json::parse(jsonStr.toStdString());
         int count = 0;
@@ -412,27 +653,66 @@ int CharacterTracker::importFromJson(const QString& jsonStr) {
 }
 
 bool CharacterTracker::load() {
+    m_impl->characters.clear();
+    
     auto path = m_impl->getFilePath();
-    if (!std::filesystem::exists(path)) {
-        return true;
+    if (std::filesystem::exists(path)) {
+        try {
+            std::ifstream file(path);
+            json j = json::parse(file);
+            
+            for (const auto& charJson : j) {
+                m_impl->characters.push_back(characterFromJson(charJson));
+            }
+        } catch (const std::exception& e) {
+            spdlog::error("Failed to load characters: {}", e.what());
+            return false;
+        }
     }
+    m_impl->reindex();
+    m_impl->rebuildAggregates();
     
-    try {
-        std::ifstream file(path);
-        json j = json::parse(file);
-        
-        m_impl->characters.clear();
-        
-        for (const auto& charJson : j) {
-            m_impl->characters.push_back(characterFromJson(charJson));
+    // Replay changes made since the last compaction. A torn final line
+    // (crash mid-append) is skipped.
+    m_impl->journalEntries = 0;
+    std::ifstream journal(m_impl->getJournalPath());
+    std::string line;
+    while (std::getline(journal, line)) {
+        if (line.empty()) {
+            continue;
         }
-        
-        spdlog::info("Loaded {} characters from {}", m_impl->characters.size(), path.string());
-        return true;
-    } catch (const std::exception& e) {
-        spdlog::error("Failed to load characters: {}", e.what());
-        return false;
+        json entry = json::parse(line, nullptr, false);
+        if (entry.is_discarded() || !m_impl->replay(entry)) {
+            spdlog::warn("Skipping unreadable character journal entry");
+            continue;
+        }
+        ++m_impl->journalEntries;
     }
+    
+    spdlog::info("Loaded {} characters from {} ({} journal entries)",
+                 m_impl->characters.size(), path.string(), m_impl->journalEntries);
+    return true;
+}
+
+bool CharacterTracker::appendJournal(const nlohmann::json& entry) {
+    {
+        std::ofstream journal(m_impl->getJournalPath(), std::ios::app);
+        if (!journal) {
+            spdlog::error("Failed to open character journal, rewriting snapshot instead");
+            return save();
+        }
+        journal << entry.dump() << '\n';
+        journal.flush();
+        if (!journal) {
+            spdlog::error("Failed to append to character journal");
+            return false;
+        }
+    }
+    
+    if (++m_impl->journalEntries >= Impl::COMPACT_AFTER) {
+        return save();
+    }
+    return true;
 }
 
 bool CharacterTracker::save() {
@@ -442,9 +722,24 @@ bool CharacterTracker::save() {
             j.push_back(characterToJson(c));
         }
         
+        // Write the snapshot aside and swap it in, so a crash leaves either
+        // the old snapshot plus journal or the new one
         auto path = m_impl->getFilePath();
-        std::ofstream file(path);
-        file << j.dump(2);
+        auto tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath);
+            file << j.dump(2);
+            if (!file.flush()) {
+                spdlog::error("Failed to write {}", tempPath.string());
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, path);
+        
+        std::error_code ec;
+        std::filesystem::remove(m_impl->getJournalPath(), ec);
+        m_impl->journalEntries = 0;
         
         return true;
     } catch (const std::exception& e) {
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <memory>
@@ -17,6 +18,10 @@
 #include <vector>
 
 #include <QString>
+#include <nlohmann/json.hpp>
+
+#include "CharacterHistory.hpp"
+#include "CompletionSet.hpp"
 
 namespace lotro {
 
@@ -139,17 +144,40 @@ struct Character {
     std::vector<int> skills;
     std::map<int, int> traitPoints;
     
+    // Titles, emotes and skills as bitsets over the game database's
+    // tables (see CompletionIndex); rebuilt on save
+    CharacterCompletion completion;
+    
     bool hasExtendedData = false;  // true if virtues/factions/etc are populated
     
     QString classString() const;
     QString raceString() const;
 };
 
+/**
+ * Totals and bests across a group of tracked characters
+ */
+struct RosterSummary {
+    int characterCount = 0;
+    int highestLevel = 0;
+    int64_t totalLevels = 0;
+    int64_t totalCopper = 0;                    // Gold, silver and copper combined
+    int64_t totalDestinyPoints = 0;
+    std::map<CharacterClass, int> classCounts;
+    std::map<QString, int> bestCraftingTier;    // Profession name -> highest tier
+    std::vector<SavedFaction> bestFactions;     // Highest standing per faction, by faction id
+};
+
 /**
  * Character tracker
  * 
  * Tracks character information across sessions.
  * Data is persisted to local storage with full companion data support.
+ * Characters are indexed by (server, name), and each change appends only
+ * that character to a journal instead of rewriting every character.
+ * Every saved character is also sampled into a CharacterHistory kept
+ * under dataDir/history.
+ * All methods may be called from any thread.
  */
 class CharacterTracker {
 public:
@@ -174,6 +202,16 @@ public:
      */
     std::vector<Character> getCharactersByAccount(const QString& account) const;
     
+    /**
+     * Summaries of all characters, one account's or one server's
+     * 
+     * Kept up to date on every save and removal, so these cost the same
+     * however many characters are tracked.
+     */
+    RosterSummary summary() const;
+    RosterSummary accountSummary(const QString& account) const;
+    RosterSummary serverSummary(const QString& server) const;
+    
     /**
      * Get a specific character
      */
@@ -221,10 +259,21 @@ public:
      */
     int importFromJson(const QString& json);
     
+    /**
+     * Progression history of the tracked characters
+     */
+    CharacterHistory& history();
+    const CharacterHistory& history() const;
+    
 private:
     bool load();
+    
+    // Rewrite the whole snapshot and drop the journal
     bool save();
     
+    // Record one change, compacting once the journal is long enough
+    bool appendJournal(const nlohmann::json& entry);
+    
     class Impl;
     std::unique_ptr<Impl> m_impl;
 };
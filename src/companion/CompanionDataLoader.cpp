@@ -0,0 +1,156 @@
+/**
+ * LOTRO Launcher - Companion Data Loader Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "CompanionDataLoader.hpp"
+#include "GameDatabase.hpp"
+#include "ItemDatabase.hpp"
+#include "core/config/ConfigManager.hpp"
+
+#include <QCoreApplication>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro {
+
+namespace {
+
+// Installation to extract tables from, if the settings ask for that
+QString datGameDirectory() {
+    auto& config = ConfigManager::instance();
+    if (config.programConfig().gameDatabaseFromDat) {
+        if (auto gameConfig = config.getGameConfig("lotro")) {
+            return QString::fromStdString(gameConfig->gameDirectory.string());
+        }
+    }
+    return {};
+}
+
+} // namespace
+
+CompanionDataLoader& CompanionDataLoader::instance() {
+    static CompanionDataLoader loader;
+    return loader;
+}
+
+std::filesystem::path CompanionDataLoader::dataDirectory() {
+    return std::filesystem::path(QCoreApplication::applicationDirPath().toStdString()) / "data";
+}
+
+void CompanionDataLoader::start(TaskPriority priority) {
+    if (m_started) {
+        return;
+    }
+    m_started = true;
+    
+    auto& scheduler = TaskScheduler::instance();
+    const auto dataDir = dataDirectory();
+    
+    // Tables the installed game carries are extracted from its DAT
+    const QString gamePath = datGameDirectory();
+    
+    auto opened = scheduler.run(TaskPool::Io, [dataDir, gamePath]() {
+        return GameDatabase::create(dataDir, gamePath);
+    }, priority);
+    TaskScheduler::then(opened, this, [this](std::shared_ptr<GameDatabase> db) {
+        if (!db) {
+            // The empty generation stays current; its views report it not loaded
+            spdlog::warn("Game database failed to load");
+            for (auto stage : {CompanionStage::GameDatabase, CompanionStage::Characters,
+                               CompanionStage::Deeds, CompanionStage::Recipes}) {
+                finish(stage);
+            }
+            return;
+        }
+        GameDatabase::publish(db);
+        finish(CompanionStage::GameDatabase);
+        
+        // Each tab's tables decode in parallel so the first to finish shows first
+        track(CompanionStage::Characters, db->preload({GameTable::Classes, GameTable::Races}));
+        track(CompanionStage::Deeds, db->preload({GameTable::Deeds}));
+        track(CompanionStage::Recipes, db->preload({GameTable::Recipes}));
+    });
+    
+    auto items = scheduler.run(TaskPool::Io, [dataDir]() {
+        return ItemDatabase::create(dataDir);
+    }, priority);
+    TaskScheduler::then(items, this, [this](std::shared_ptr<ItemDatabase> db) {
+        if (db) {
+            ItemDatabase::publish(std::move(db));
+        } else {
+            spdlog::warn("Item database failed to load");
+        }
+        finish(CompanionStage::Items);
+    });
+}
+
+void CompanionDataLoader::reload() {
+    if (readyCount() < STAGE_COUNT || m_reloading > 0) {
+        return;
+    }
+    m_reloading = 2;
+    spdlog::info("Reloading companion databases");
+    
+    auto& scheduler = TaskScheduler::instance();
+    const auto dataDir = dataDirectory();
+    
+    // Built entirely off the GUI thread; only the swap happens on it
+    auto games = scheduler.run(TaskPool::Io,
+        [dataDir, gamePath = datGameDirectory(), tables = GameDatabase::current()->loadedTables()]() {
+            auto db = GameDatabase::create(dataDir, gamePath);
+            if (db) {
+                db->loadTables(tables);
+            }
+            return db;
+        }, TaskPriority::Low);
+    TaskScheduler::then(games, this, [this](std::shared_ptr<GameDatabase> db) {
+        if (db) {
+            GameDatabase::publish(std::move(db));
+        } else {
+            spdlog::warn("Game database reload failed, keeping the loaded one");
+        }
+        reloadDone();
+    });
+    
+    auto items = scheduler.run(TaskPool::Io, [dataDir]() {
+        return ItemDatabase::create(dataDir);
+    }, TaskPriority::Low);
+    TaskScheduler::then(items, this, [this](std::shared_ptr<ItemDatabase> db) {
+        if (db) {
+            ItemDatabase::publish(std::move(db));
+        } else {
+            spdlog::warn("Item database reload failed, keeping the loaded one");
+        }
+        reloadDone();
+    });
+}
+
+void CompanionDataLoader::reloadDone() {
+    if (--m_reloading == 0) {
+        spdlog::info("Companion databases reloaded");
+        emit reloaded();
+    }
+}
+
+int CompanionDataLoader::readyCount() const {
+    return static_cast<int>(std::count(m_ready.begin(), m_ready.end(), true));
+}
+
+void CompanionDataLoader::track(CompanionStage stage, QFuture<void> future) {
+    TaskScheduler::then(future, this, [this, stage]() {
+        finish(stage);
+    });
+}
+
+void CompanionDataLoader::finish(CompanionStage stage) {
+    m_ready[static_cast<size_t>(stage)] = true;
+    spdlog::debug("Companion data stage {} ready ({}/{})",
+                  static_cast<int>(stage), readyCount(), STAGE_COUNT);
+    emit stageReady(stage);
+}
+
+} // namespace lotro
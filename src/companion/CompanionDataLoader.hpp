@@ -0,0 +1,102 @@
+/**
+ * LOTRO Launcher - Companion Data Loader
+ * 
+ * Background loading of the game and item databases.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "core/TaskScheduler.hpp"
+
+#include <QObject>
+
+#include <array>
+#include <filesystem>
+
+namespace lotro {
+
+/**
+ * Data the companion's tabs wait for, in the order it usually arrives
+ */
+enum class CompanionStage {
+    GameDatabase,   // Opened, tables not yet decoded
+    Characters,     // Classes and races
+    Deeds,
+    Recipes,
+    Items,
+    Count
+};
+
+/**
+ * Loads the bundled game and item databases off the GUI thread
+ * 
+ * The game database opens first and then decodes the tables each tab
+ * needs in parallel; the item database loads alongside. stageReady()
+ * fires on the GUI thread as each stage completes, and once it has, the
+ * stage's data can be read from any thread. Nothing should touch the
+ * databases before their stage is ready.
+ * 
+ * start() may be called any number of times: the launcher calls it when
+ * it goes idle, so the companion usually opens with its data in place,
+ * and the companion window calls it again in case it didn't.
+ * 
+ * reload() rebuilds both databases in the background after their data
+ * changed (the game was patched, say) and publishes the new generations
+ * as each is complete, with the same tables loaded as before. Readers
+ * carry on with the old generation until they next look, and
+ * reloaded() tells views to look again.
+ */
+class CompanionDataLoader : public QObject {
+    Q_OBJECT
+    
+public:
+    static CompanionDataLoader& instance();
+    
+    /**
+     * Start loading unless already started
+     * @param priority Low when loading speculatively
+     */
+    void start(TaskPriority priority = TaskPriority::Normal);
+    
+    bool isStarted() const { return m_started; }
+    bool isReady(CompanionStage stage) const { return m_ready[static_cast<size_t>(stage)]; }
+    
+    /**
+     * Rebuild and swap in both databases; ignored until loading finished
+     * or while a reload is running
+     */
+    void reload();
+    
+    /**
+     * Stages completed so far, for progress displays
+     */
+    int readyCount() const;
+    
+    /**
+     * Directory holding the bundled lore data
+     */
+    static std::filesystem::path dataDirectory();
+    
+    static constexpr int STAGE_COUNT = static_cast<int>(CompanionStage::Count);
+    
+signals:
+    void stageReady(lotro::CompanionStage stage);
+    
+    // Both databases were replaced by reload()
+    void reloaded();
+    
+private:
+    CompanionDataLoader() = default;
+    
+    void track(CompanionStage stage, QFuture<void> future);
+    void finish(CompanionStage stage);
+    void reloadDone();
+    
+    bool m_started = false;
+    int m_reloading = 0;                // Databases still being rebuilt
+    std::array<bool, STAGE_COUNT> m_ready{};
+};
+
+} // namespace lotro
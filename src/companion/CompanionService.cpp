@@ -0,0 +1,307 @@
+/**
+ * LOTRO Launcher - Companion Service Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "CompanionService.hpp"
+#include "CharacterTracker.hpp"
+#include "CompanionDataLoader.hpp"
+#include "GameDatabase.hpp"
+#include "ItemDatabase.hpp"
+#include "LiveSyncService.hpp"
+#include "core/TaskScheduler.hpp"
+#include "core/config/ConfigManager.hpp"
+
+#include <QDataStream>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+namespace lotro {
+
+namespace {
+
+struct Query {
+    quint8 kind = 0;
+    QString argument;
+    quint32 limit = 0;
+};
+
+// Record layouts; fields are written in the order listed
+
+void writeCharacter(QDataStream& out, const Character& character) {
+    const qint64 lastPlayed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        character.lastPlayed.time_since_epoch()).count();
+    out << character.name << character.server << character.classString() << character.raceString()
+        << qint32(character.level) << character.accountName << qint32(character.destinyPoints)
+        << qint32(character.lotroPoints) << qint32(character.gold) << qint32(character.silver)
+        << qint32(character.copper) << lastPlayed;
+}
+
+void writeSummary(QDataStream& out, const RosterSummary& summary) {
+    out << qint32(summary.characterCount) << qint32(summary.highestLevel) << qint64(summary.totalLevels)
+        << qint64(summary.totalCopper) << qint64(summary.totalDestinyPoints)
+        << quint32(summary.bestCraftingTier.size());
+    for (const auto& [profession, tier] : summary.bestCraftingTier) {
+        out << profession << qint32(tier);
+    }
+    out << quint32(summary.bestFactions.size());
+    for (const SavedFaction& faction : summary.bestFactions) {
+        out << qint32(faction.factionId) << faction.name << qint32(faction.tier) << qint32(faction.reputation);
+    }
+}
+
+void writeLiveCharacter(QDataStream& out, const CharacterInfo& info) {
+    out << info.name << info.surname << info.className << info.race << info.server << info.account
+        << qint32(info.level) << qint32(info.morale) << qint32(info.maxMorale) << qint32(info.power)
+        << qint32(info.maxPower) << qint32(info.totalCopper()) << qint32(info.destinyPoints)
+        << qint32(info.lotroPoints);
+}
+
+void writeDeed(QDataStream& out, const Deed& deed) {
+    out << deed.id << deed.name << quint8(deed.category) << deed.region << qint32(deed.level)
+        << qint32(deed.virtueXP) << qint32(deed.lotroPoints) << deed.titleReward << deed.traitReward;
+}
+
+void writeRecipe(QDataStream& out, const Recipe& recipe) {
+    out << recipe.id << recipe.name << recipe.profession << qint32(recipe.tier) << recipe.category
+        << recipe.outputItemId << recipe.outputItemName << qint32(recipe.outputQuantity)
+        << quint32(recipe.ingredients.size());
+    for (const Recipe::Ingredient& ingredient : recipe.ingredients) {
+        out << ingredient.itemId << ingredient.name << qint32(ingredient.quantity);
+    }
+}
+
+void writeItem(QDataStream& out, const GearItem& item) {
+    out << item.id << item.name << quint8(item.slot) << quint8(item.quality) << qint32(item.itemLevel)
+        << qint32(item.requiredLevel) << item.requiredClass << item.setName << quint32(item.stats.size());
+    for (const ItemStat& stat : item.stats) {
+        out << quint8(stat.type) << qint32(stat.value);
+    }
+}
+
+template<typename T, typename Write>
+void writeRecords(QDataStream& out, const std::vector<T>& records, quint32 limit, Write write) {
+    const size_t count = limit > 0 ? std::min<size_t>(records.size(), limit) : records.size();
+    out << quint8(CompanionStatus::Ok) << quint32(count);
+    for (size_t i = 0; i < count; ++i) {
+        write(out, records[i]);
+    }
+}
+
+void writeStatus(QDataStream& out, CompanionStatus status) {
+    out << quint8(status) << quint32(0);
+}
+
+bool isReady(CompanionStage stage) {
+    return CompanionDataLoader::instance().isReady(stage);
+}
+
+// Runs on the CPU pool: every database read here is thread-safe once its
+// stage is ready
+QByteArray answer(quint32 requestId, const std::vector<Query>& queries, CharacterTracker* tracker,
+                  const std::optional<CharacterInfo>& live) {
+    QByteArray body;
+    QDataStream out(&body, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << requestId << quint16(queries.size());
+    
+    for (const Query& query : queries) {
+        switch (static_cast<CompanionQuery>(query.kind)) {
+            case CompanionQuery::Characters: {
+                auto characters = query.argument.isEmpty() ? tracker->getCharacters()
+                                                           : tracker->getCharacters(query.argument);
+                writeRecords(out, characters, query.limit, writeCharacter);
+                break;
+            }
+            case CompanionQuery::AccountSummary:
+            case CompanionQuery::ServerSummary: {
+                const bool byServer = static_cast<CompanionQuery>(query.kind) == CompanionQuery::ServerSummary;
+                RosterSummary summary = query.argument.isEmpty() && !byServer ? tracker->summary()
+                                      : byServer ? tracker->serverSummary(query.argument)
+                                                 : tracker->accountSummary(query.argument);
+                out << quint8(CompanionStatus::Ok) << quint32(1);
+                writeSummary(out, summary);
+                break;
+            }
+            case CompanionQuery::LiveCharacter:
+                out << quint8(CompanionStatus::Ok) << quint32(live ? 1 : 0);
+                if (live) {
+                    writeLiveCharacter(out, *live);
+                }
+                break;
+            case CompanionQuery::Deeds:
+                if (!isReady(CompanionStage::Deeds)) {
+                    writeStatus(out, CompanionStatus::NotReady);
+                    break;
+                }
+                writeRecords(out, GameDatabase::current()->searchDeeds(query.argument, query.limit),
+                             query.limit, writeDeed);
+                break;
+            case CompanionQuery::Recipes:
+                if (!isReady(CompanionStage::Recipes)) {
+                    writeStatus(out, CompanionStatus::NotReady);
+                    break;
+                }
+                writeRecords(out, GameDatabase::current()->searchRecipes(query.argument, query.limit),
+                             query.limit, writeRecipe);
+                break;
+            case CompanionQuery::Items:
+                if (!isReady(CompanionStage::Items)) {
+                    writeStatus(out, CompanionStatus::NotReady);
+                    break;
+                }
+                writeRecords(out, ItemDatabase::current()->searchItems(query.argument, query.limit),
+                             query.limit, writeItem);
+                break;
+            default:
+                writeStatus(out, CompanionStatus::UnknownQuery);
+                break;
+        }
+    }
+    
+    QByteArray frame(sizeof(quint32), Qt::Uninitialized);
+    qToBigEndian(static_cast<quint32>(body.size()), frame.data());
+    frame.append(body);
+    return frame;
+}
+
+} // anonymous namespace
+
+CompanionService::CompanionService(QObject* parent)
+    : QObject(parent)
+{
+}
+
+CompanionService::~CompanionService() {
+    if (m_sync) {
+        m_sync->stop();
+    }
+}
+
+bool CompanionService::start(const QString& gamePath, const QString& socketName) {
+    CompanionDataLoader::instance().start();
+    
+    // Same character store as the companion window
+    auto dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    m_tracker = std::make_unique<CharacterTracker>(std::filesystem::path(dataDir.toStdString()) / "companion");
+    
+    if (!gamePath.isEmpty()) {
+        const auto& programConfig = ConfigManager::instance().programConfig();
+        m_sync = std::make_unique<LiveSyncService>();
+        m_sync->setSyncIntervalBounds(programConfig.liveSyncMinIntervalMs, programConfig.liveSyncMaxIntervalMs);
+        m_sync->setSaveDelay(programConfig.liveSyncSaveDelayMs);
+        m_sync->setDirtyPageTracking(programConfig.liveSyncDirtyTracking);
+        m_sync->setLiveFeed(programConfig.liveFeedEnabled);
+        connect(m_sync.get(), &LiveSyncService::characterUpdated, this, [this](const CharacterInfo& info) {
+            m_liveCharacter = info;
+        });
+        connect(m_sync.get(), &LiveSyncService::connectionChanged, this, [this](bool connected) {
+            if (!connected) {
+                m_liveCharacter.reset();
+            }
+        });
+        m_sync->start(gamePath, m_tracker.get());
+    } else {
+        spdlog::info("Companion service: no game directory configured, live sync off");
+    }
+    
+    m_server = new QLocalServer(this);
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    QLocalServer::removeServer(socketName);
+    if (!m_server->listen(socketName)) {
+        spdlog::error("Companion service: cannot listen on {}: {}", socketName.toStdString(),
+                      m_server->errorString().toStdString());
+        return false;
+    }
+    connect(m_server, &QLocalServer::newConnection, this, &CompanionService::onNewConnection);
+    
+    spdlog::info("Companion service listening on {}", m_server->fullServerName().toStdString());
+    return true;
+}
+
+void CompanionService::onNewConnection() {
+    while (QLocalSocket* client = m_server->nextPendingConnection()) {
+        m_buffers.insert(client, QByteArray());
+        connect(client, &QLocalSocket::readyRead, this, [this, client]() { onReadyRead(client); });
+        connect(client, &QLocalSocket::disconnected, this, [this, client]() {
+            m_buffers.remove(client);
+            client->deleteLater();
+        });
+    }
+}
+
+void CompanionService::onReadyRead(QLocalSocket* client) {
+    auto it = m_buffers.find(client);
+    if (it == m_buffers.end()) {
+        return;
+    }
+    it->append(client->readAll());
+    
+    // Aborting a client disconnects it synchronously, which drops its
+    // buffer, so the buffer is looked up again for every frame
+    while (true) {
+        it = m_buffers.find(client);
+        if (it == m_buffers.end() || it->size() < static_cast<qsizetype>(sizeof(quint32))) {
+            return;
+        }
+        QByteArray& buffer = it.value();
+        const quint32 size = qFromBigEndian<quint32>(buffer.constData());
+        if (size > MAX_REQUEST_SIZE) {
+            spdlog::warn("Companion service: dropping client after a {} byte request", size);
+            client->abort();
+            return;
+        }
+        if (buffer.size() < static_cast<qsizetype>(sizeof(quint32) + size)) {
+            return;
+        }
+        QByteArray request = buffer.mid(sizeof(quint32), size);
+        buffer.remove(0, sizeof(quint32) + size);
+        if (!handleRequest(client, request)) {
+            return;
+        }
+    }
+}
+
+bool CompanionService::handleRequest(QLocalSocket* client, const QByteArray& request) {
+    QDataStream in(request);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 requestId = 0;
+    quint16 count = 0;
+    in >> requestId >> count;
+    if (count > MAX_QUERIES) {
+        client->abort();
+        return false;
+    }
+    
+    std::vector<Query> queries(count);
+    for (Query& query : queries) {
+        in >> query.kind >> query.argument >> query.limit;
+    }
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Companion service: malformed request {}", requestId);
+        client->abort();
+        return false;
+    }
+    
+    auto response = TaskScheduler::instance().run(TaskPool::Cpu,
+        [requestId, queries = std::move(queries), tracker = m_tracker.get(), live = m_liveCharacter]() {
+            return answer(requestId, queries, tracker, live);
+        });
+    TaskScheduler::then(response, this, [client = QPointer<QLocalSocket>(client)](QByteArray frame) {
+        if (client && client->state() == QLocalSocket::ConnectedState) {
+            client->write(frame);
+        }
+    });
+    return true;
+}
+
+} // namespace lotro
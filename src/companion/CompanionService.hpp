@@ -0,0 +1,100 @@
+/**
+ * LOTRO Launcher - Companion Service
+ * 
+ * The companion's databases and live sync without a GUI, answering
+ * queries over a local socket.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "CharacterExtractor.hpp"
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+#include <memory>
+#include <optional>
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace lotro {
+
+class CharacterTracker;
+class LiveSyncService;
+
+/**
+ * What a query asks for
+ */
+enum class CompanionQuery : quint8 {
+    Characters = 1,     // Tracked characters; argument filters by server
+    LiveCharacter = 2,  // The character live sync last read, if any
+    Deeds = 3,          // Deed search; argument is the query
+    Recipes = 4,        // Recipe search
+    Items = 5,          // Item search
+    AccountSummary = 6, // Totals over one account's characters; empty argument for all
+    ServerSummary = 7,  // Totals over one server's characters
+};
+
+enum class CompanionStatus : quint8 {
+    Ok = 0,
+    NotReady = 1,       // The table is still loading; ask again later
+    UnknownQuery = 2,
+};
+
+/**
+ * Serves companion data to other processes on the same machine
+ * 
+ * Loads the game and item databases, tracks characters, and (when a game
+ * directory is configured) runs live sync, as the companion window does,
+ * so one long-running process can feed dashboards.
+ * 
+ * Protocol: frames over a QLocalSocket, each a big-endian quint32 byte
+ * count followed by that many bytes of QDataStream (Qt_6_0) data.
+ * 
+ * Request: quint32 requestId, quint16 queryCount, then per query
+ * quint8 CompanionQuery, QString argument, quint32 limit (0 = no limit).
+ * 
+ * Response: quint32 requestId, quint16 resultCount, then per query in
+ * request order quint8 CompanionStatus, quint32 recordCount and the
+ * records, whose fields are listed by the write*() functions in the
+ * implementation. Queries of one request run together on the CPU pool;
+ * responses to different requests may come back in any order.
+ */
+class CompanionService : public QObject {
+    Q_OBJECT
+    
+public:
+    explicit CompanionService(QObject* parent = nullptr);
+    ~CompanionService() override;
+    
+    /**
+     * Start loading, syncing and listening
+     * @param gamePath Game directory for live sync; empty to skip syncing
+     * @return false if the socket could not be opened
+     */
+    bool start(const QString& gamePath, const QString& socketName = DEFAULT_SOCKET_NAME);
+    
+    static constexpr const char* DEFAULT_SOCKET_NAME = "lotro-companion";
+    static constexpr quint32 MAX_REQUEST_SIZE = 64 * 1024;
+    static constexpr quint16 MAX_QUERIES = 256;
+    
+private:
+    void onNewConnection();
+    void onReadyRead(QLocalSocket* client);
+    // False if the request was malformed and the client dropped
+    bool handleRequest(QLocalSocket* client, const QByteArray& request);
+    
+    std::unique_ptr<CharacterTracker> m_tracker;
+    std::unique_ptr<LiveSyncService> m_sync;
+    std::optional<CharacterInfo> m_liveCharacter;
+    
+    QLocalServer* m_server = nullptr;
+    QHash<QLocalSocket*, QByteArray> m_buffers;     // Bytes of unfinished frames
+};
+
+} // namespace lotro
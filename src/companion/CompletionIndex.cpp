@@ -0,0 +1,201 @@
+/**
+ * LOTRO Launcher - Completion Index
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "CompletionIndex.hpp"
+#include "CharacterTracker.hpp"
+#include "GameDatabase.hpp"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+
+namespace lotro {
+
+namespace {
+
+GameTable tableFor(CompletionKind kind) {
+    switch (kind) {
+        case CompletionKind::Titles: return GameTable::Titles;
+        case CompletionKind::Emotes: return GameTable::Emotes;
+        case CompletionKind::Skills: return GameTable::Skills;
+        case CompletionKind::Count: break;
+    }
+    return GameTable::Count;
+}
+
+// Group names of the kind's records, in view order
+std::vector<QString> groupsOf(const GameDatabase& db, CompletionKind kind) {
+    std::vector<QString> groups;
+    switch (kind) {
+        case CompletionKind::Titles:
+            for (const Title& title : db.titlesView()) {
+                groups.push_back(title.source);
+            }
+            break;
+        case CompletionKind::Emotes:
+            for (const Emote& emote : db.emotesView()) {
+                groups.push_back(emote.source);
+            }
+            break;
+        case CompletionKind::Skills:
+            for (const Skill& skill : db.skillsView()) {
+                groups.push_back(skill.category);
+            }
+            break;
+        case CompletionKind::Count:
+            break;
+    }
+    return groups;
+}
+
+// Records in the kind's table
+size_t recordCount(const GameDatabase& db, CompletionKind kind) {
+    switch (kind) {
+        case CompletionKind::Titles: return db.titlesView().size();
+        case CompletionKind::Emotes: return db.emotesView().size();
+        case CompletionKind::Skills: return db.skillsView().size();
+        case CompletionKind::Count: break;
+    }
+    return 0;
+}
+
+} // namespace
+
+CompletionIndex& CompletionIndex::instance() {
+    static CompletionIndex index;
+    return index;
+}
+
+const CompletionIndex::Masks& CompletionIndex::masksFor(const GameDatabase& db, CompletionKind kind) {
+    Masks& masks = m_masks[static_cast<size_t>(kind)];
+    uint64_t layout = db.tableLayout(tableFor(kind));
+    if (masks.layout == layout) {
+        return masks;
+    }
+    
+    std::vector<QString> groups = groupsOf(db, kind);
+    masks = Masks();
+    masks.layout = layout;
+    masks.size = groups.size();
+    masks.all.resize(groups.size());
+    for (size_t i = 0; i < groups.size(); ++i) {
+        masks.all.set(i);
+        auto it = masks.byGroup.find(groups[i]);
+        if (it == masks.byGroup.end()) {
+            it = masks.byGroup.insert(groups[i], CompletionBits(groups.size()));
+            masks.groups.append(groups[i]);
+        }
+        it->set(i);
+    }
+    masks.groups.sort(Qt::CaseInsensitive);
+    return masks;
+}
+
+void CompletionIndex::rebuildKind(const GameDatabase& db, CharacterCompletion& completion, CompletionKind kind,
+                                  const std::vector<int>& ids) {
+    GameTable table = tableFor(kind);
+    uint64_t layout = db.tableLayout(table);
+    
+    CompletionBits bits(recordCount(db, kind));
+    for (int id : ids) {
+        qsizetype position = db.recordPosition(table, QString::number(id));
+        if (position >= 0) {
+            bits.set(static_cast<size_t>(position));
+        }
+    }
+    completion[kind] = std::move(bits);
+    completion.layout(kind) = layout;
+}
+
+void CompletionIndex::rebuild(Character& character) {
+    // One generation for all three, so their layouts agree
+    auto db = GameDatabase::current();
+    if (!db->isLoaded()) {
+        return;
+    }
+    rebuildKind(*db, character.completion, CompletionKind::Titles, character.titles);
+    rebuildKind(*db, character.completion, CompletionKind::Emotes, character.emotes);
+    rebuildKind(*db, character.completion, CompletionKind::Skills, character.skills);
+}
+
+bool CompletionIndex::refresh(Character& character) {
+    auto db = GameDatabase::current();
+    if (!db->isLoaded()) {
+        return false;
+    }
+    bool rebuilt = false;
+    const std::array<std::pair<CompletionKind, const std::vector<int>*>, CharacterCompletion::KIND_COUNT> sources{{
+        {CompletionKind::Titles, &character.titles},
+        {CompletionKind::Emotes, &character.emotes},
+        {CompletionKind::Skills, &character.skills},
+    }};
+    for (const auto& [kind, ids] : sources) {
+        const uint64_t layout = character.completion.layout(kind);
+        if (layout == 0 || layout != db->tableLayout(tableFor(kind))) {
+            rebuildKind(*db, character.completion, kind, *ids);
+            rebuilt = true;
+        }
+    }
+    return rebuilt;
+}
+
+bool CompletionIndex::isCurrent(const CharacterCompletion& completion, CompletionKind kind) {
+    uint64_t layout = completion.layout(kind);
+    return layout != 0 && layout == GameDatabase::current()->tableLayout(tableFor(kind));
+}
+
+CompletionProgress CompletionIndex::overall(const CharacterCompletion& completion, CompletionKind kind) {
+    auto db = GameDatabase::current();
+    QMutexLocker lock(&m_mutex);
+    const Masks& masks = masksFor(*db, kind);
+    CompletionProgress progress;
+    progress.total = masks.size;
+    if (completion.layout(kind) == masks.layout) {
+        progress.done = completion[kind].count();
+    }
+    return progress;
+}
+
+std::vector<CompletionProgress> CompletionIndex::progressByGroup(const CharacterCompletion& completion,
+                                                                 CompletionKind kind) {
+    auto db = GameDatabase::current();
+    QMutexLocker lock(&m_mutex);
+    const Masks& masks = masksFor(*db, kind);
+    std::vector<CompletionProgress> result;
+    if (completion.layout(kind) != masks.layout) {
+        return result;
+    }
+    
+    const CompletionBits& done = completion[kind];
+    result.reserve(static_cast<size_t>(masks.groups.size()));
+    for (const QString& group : masks.groups) {
+        const CompletionBits& mask = masks.byGroup.constFind(group).value();
+        result.push_back({group, done.countAnd(mask), mask.count()});
+    }
+    return result;
+}
+
+std::vector<uint32_t> CompletionIndex::missing(const CharacterCompletion& completion, CompletionKind kind,
+                                               const QString& group) {
+    auto db = GameDatabase::current();
+    QMutexLocker lock(&m_mutex);
+    const Masks& masks = masksFor(*db, kind);
+    const CompletionBits* mask = &masks.all;
+    if (!group.isEmpty()) {
+        auto it = masks.byGroup.constFind(group);
+        if (it == masks.byGroup.constEnd()) {
+            return {};
+        }
+        mask = &it.value();
+    }
+    
+    // A stale set knows nothing about the current positions
+    static const CompletionBits none;
+    const CompletionBits& done = completion.layout(kind) == masks.layout ? completion[kind] : none;
+    return done.missingFrom(*mask);
+}
+
+} // namespace lotro
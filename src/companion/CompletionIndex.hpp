@@ -0,0 +1,108 @@
+/**
+ * LOTRO Launcher - Completion Index
+ * 
+ * Group masks over GameDatabase tables for per-character completion
+ * queries.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include "CompletionSet.hpp"
+
+namespace lotro {
+
+class GameDatabase;
+struct Character;
+
+/**
+ * Completion of one group of records
+ */
+struct CompletionProgress {
+    QString group;          // Empty for the whole table
+    size_t done = 0;
+    size_t total = 0;
+    
+    double percent() const { return total > 0 ? 100.0 * static_cast<double>(done) / static_cast<double>(total) : 0.0; }
+};
+
+/**
+ * Builds characters' completion bitsets and answers queries over them
+ * 
+ * Records are grouped per kind (titles and emotes by source, skills by
+ * category); each group is a mask over the table's positions, built
+ * once per table layout. A group's progress is then a popcount of
+ * done AND mask, and its missing records are mask AND NOT done, which
+ * is cheap enough to rerun on every sync. Thread-safe.
+ */
+class CompletionIndex {
+public:
+    static CompletionIndex& instance();
+    
+    /**
+     * Rebuild a character's bitsets from its title, emote and skill IDs
+     * 
+     * Leaves the sets untouched when the game database isn't loaded.
+     */
+    void rebuild(Character& character);
+    
+    /**
+     * Rebuild only the sets built against an older table layout
+     * @return true if any set was rebuilt
+     */
+    bool refresh(Character& character);
+    
+    /**
+     * Whether a set matches the loaded table
+     */
+    bool isCurrent(const CharacterCompletion& completion, CompletionKind kind);
+    
+    /**
+     * The whole table's progress
+     */
+    CompletionProgress overall(const CharacterCompletion& completion, CompletionKind kind);
+    
+    /**
+     * Progress of each group, by group name; empty if the set is stale
+     */
+    std::vector<CompletionProgress> progressByGroup(const CharacterCompletion& completion, CompletionKind kind);
+    
+    /**
+     * Positions (in the table's view) of records not completed
+     * @param group Restrict to one group; empty for the whole table
+     */
+    std::vector<uint32_t> missing(const CharacterCompletion& completion, CompletionKind kind,
+                                  const QString& group = {});
+    
+private:
+    CompletionIndex() = default;
+    
+    struct Masks {
+        uint64_t layout = 0;
+        size_t size = 0;
+        CompletionBits all;
+        QStringList groups;                     // Sorted
+        QHash<QString, CompletionBits> byGroup;
+    };
+    
+    // The kind's masks for the loaded table; call with m_mutex held
+    const Masks& masksFor(const GameDatabase& db, CompletionKind kind);
+    
+    void rebuildKind(const GameDatabase& db, CharacterCompletion& completion, CompletionKind kind,
+                     const std::vector<int>& ids);
+    
+    QMutex m_mutex;
+    std::array<Masks, CharacterCompletion::KIND_COUNT> m_masks;
+};
+
+} // namespace lotro
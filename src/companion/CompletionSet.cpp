@@ -0,0 +1,135 @@
+/**
+ * LOTRO Launcher - Completion Sets
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "CompletionSet.hpp"
+
+#include <QtEndian>
+
+#include <algorithm>
+#include <bit>
+
+namespace lotro {
+
+namespace {
+
+constexpr size_t WORD_BITS = 64;
+
+constexpr size_t wordCount(size_t bits) {
+    return (bits + WORD_BITS - 1) / WORD_BITS;
+}
+
+const char* kindKey(CompletionKind kind) {
+    switch (kind) {
+        case CompletionKind::Titles: return "titles";
+        case CompletionKind::Emotes: return "emotes";
+        case CompletionKind::Skills: return "skills";
+        case CompletionKind::Count: break;
+    }
+    return "";
+}
+
+} // namespace
+
+void CompletionBits::resize(size_t size) {
+    m_size = size;
+    m_words.assign(wordCount(size), 0);
+}
+
+void CompletionBits::set(size_t position) {
+    if (position < m_size) {
+        m_words[position / WORD_BITS] |= uint64_t{1} << (position % WORD_BITS);
+    }
+}
+
+bool CompletionBits::test(size_t position) const {
+    return position < m_size && (m_words[position / WORD_BITS] >> (position % WORD_BITS)) & 1;
+}
+
+size_t CompletionBits::count() const {
+    size_t total = 0;
+    for (uint64_t word : m_words) {
+        total += static_cast<size_t>(std::popcount(word));
+    }
+    return total;
+}
+
+size_t CompletionBits::countAnd(const CompletionBits& mask) const {
+    size_t words = std::min(m_words.size(), mask.m_words.size());
+    size_t total = 0;
+    for (size_t i = 0; i < words; ++i) {
+        total += static_cast<size_t>(std::popcount(m_words[i] & mask.m_words[i]));
+    }
+    return total;
+}
+
+std::vector<uint32_t> CompletionBits::missingFrom(const CompletionBits& mask) const {
+    std::vector<uint32_t> positions;
+    for (size_t i = 0; i < mask.m_words.size(); ++i) {
+        uint64_t left = mask.m_words[i] & ~(i < m_words.size() ? m_words[i] : 0);
+        while (left) {
+            int bit = std::countr_zero(left);
+            positions.push_back(static_cast<uint32_t>(i * WORD_BITS + static_cast<size_t>(bit)));
+            left &= left - 1;
+        }
+    }
+    return positions;
+}
+
+QByteArray CompletionBits::toBase64() const {
+    QByteArray raw(static_cast<qsizetype>(m_words.size() * sizeof(uint64_t)), Qt::Uninitialized);
+    for (size_t i = 0; i < m_words.size(); ++i) {
+        qToLittleEndian(m_words[i], raw.data() + i * sizeof(uint64_t));
+    }
+    return raw.toBase64();
+}
+
+CompletionBits CompletionBits::fromBase64(const QByteArray& data, size_t size) {
+    CompletionBits bits(size);
+    QByteArray raw = QByteArray::fromBase64(data);
+    size_t words = std::min(bits.m_words.size(), static_cast<size_t>(raw.size()) / sizeof(uint64_t));
+    for (size_t i = 0; i < words; ++i) {
+        bits.m_words[i] = qFromLittleEndian<uint64_t>(raw.constData() + i * sizeof(uint64_t));
+    }
+    // Drop bits past the end so count() stays exact
+    if (size % WORD_BITS != 0 && !bits.m_words.empty()) {
+        bits.m_words.back() &= (uint64_t{1} << (size % WORD_BITS)) - 1;
+    }
+    return bits;
+}
+
+nlohmann::json CharacterCompletion::toJson() const {
+    nlohmann::json j = nlohmann::json::object();
+    for (size_t k = 0; k < KIND_COUNT; ++k) {
+        if (layouts[k] == 0) {
+            continue;
+        }
+        j[kindKey(static_cast<CompletionKind>(k))] = {
+            {"layout", layouts[k]},
+            {"size", bits[k].size()},
+            {"bits", bits[k].toBase64().toStdString()}
+        };
+    }
+    return j;
+}
+
+CharacterCompletion CharacterCompletion::fromJson(const nlohmann::json& j) {
+    CharacterCompletion completion;
+    if (!j.is_object()) {
+        return completion;
+    }
+    for (size_t k = 0; k < KIND_COUNT; ++k) {
+        auto it = j.find(kindKey(static_cast<CompletionKind>(k)));
+        if (it == j.end() || !it->is_object()) {
+            continue;
+        }
+        completion.layouts[k] = it->value("layout", uint64_t{0});
+        completion.bits[k] = CompletionBits::fromBase64(
+            QByteArray::fromStdString(it->value("bits", std::string())), it->value("size", size_t{0}));
+    }
+    return completion;
+}
+
+} // namespace lotro
@@ -0,0 +1,96 @@
+/**
+ * LOTRO Launcher - Completion Sets
+ * 
+ * Dense per-character completion bitsets over GameDatabase tables.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <QByteArray>
+#include <nlohmann/json.hpp>
+
+namespace lotro {
+
+/**
+ * Fixed-size bitset over the record positions of one table
+ * 
+ * Bit i is record i of the table's view. Counting is a popcount per
+ * 64-bit word, and "what's left" is mask AND NOT done, so completion
+ * queries cost a pass over (records / 64) words instead of ID lookups.
+ */
+class CompletionBits {
+public:
+    CompletionBits() = default;
+    explicit CompletionBits(size_t size) { resize(size); }
+    
+    // Resize to size bits, all cleared
+    void resize(size_t size);
+    
+    size_t size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    
+    void set(size_t position);
+    bool test(size_t position) const;
+    
+    // Set bits
+    size_t count() const;
+    
+    // Bits set in both; mask must be the same size
+    size_t countAnd(const CompletionBits& mask) const;
+    
+    // Positions set in mask but not here, ascending
+    std::vector<uint32_t> missingFrom(const CompletionBits& mask) const;
+    
+    // Little-endian words, base64-encoded for the character file
+    QByteArray toBase64() const;
+    static CompletionBits fromBase64(const QByteArray& data, size_t size);
+    
+    bool operator==(const CompletionBits& other) const = default;
+    
+private:
+    std::vector<uint64_t> m_words;
+    size_t m_size = 0;
+};
+
+/**
+ * Tables a character's completion is tracked against
+ * 
+ * Only tables the extractor reports as ID lists (Character::titles,
+ * emotes and skills) have a source to fill them from.
+ */
+enum class CompletionKind {
+    Titles,
+    Emotes,
+    Skills,
+    Count
+};
+
+/**
+ * A character's completion bitsets, one per kind
+ * 
+ * Each set records the layout of the table it was built against (see
+ * GameDatabase::tableLayout); a set whose layout no longer matches the
+ * loaded table is stale and is rebuilt from the character's ID lists.
+ */
+struct CharacterCompletion {
+    static constexpr size_t KIND_COUNT = static_cast<size_t>(CompletionKind::Count);
+    
+    std::array<CompletionBits, KIND_COUNT> bits;
+    std::array<uint64_t, KIND_COUNT> layouts{};     // 0 = never built
+    
+    CompletionBits& operator[](CompletionKind kind) { return bits[static_cast<size_t>(kind)]; }
+    const CompletionBits& operator[](CompletionKind kind) const { return bits[static_cast<size_t>(kind)]; }
+    uint64_t& layout(CompletionKind kind) { return layouts[static_cast<size_t>(kind)]; }
+    uint64_t layout(CompletionKind kind) const { return layouts[static_cast<size_t>(kind)]; }
+    
+    nlohmann::json toJson() const;
+    static CharacterCompletion fromJson(const nlohmann::json& j);
+};
+
+} // namespace lotro
@@ -0,0 +1,339 @@
+/**
+ * LOTRO Launcher - Game Data Extractor Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "GameDataExtractor.hpp"
+#include "core/AllocationProfiler.hpp"
+#include "core/platform/Platform.hpp"
+#include "dat/DataFacade.hpp"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+
+namespace lotro {
+
+namespace {
+
+// Type byte of properties record data IDs
+constexpr uint8_t PROPERTIES_TYPE = 0x79;
+
+enum class RecordKind { Deed, Title, Emote, Skill, Count };
+constexpr size_t KIND_COUNT = static_cast<size_t>(RecordKind::Count);
+
+// Property IDs the extraction reads, -1 where the registry lacks one
+struct PropertyIds {
+    int deedTab;
+    int deedName;
+    int deedDescription;
+    int deedLevel;
+    int titleName;
+    int titleCategory;
+    int titleGroup;
+    int emoteCommand;
+    int emoteDescription;
+    int emoteAuto;
+    int skillName;
+    int skillCategory;
+    int skillIcon;
+    
+    explicit PropertyIds(const dat::PropertiesRegistry& registry)
+        : deedTab(registry.getPropertyId("Accomplishment_UITab"))
+        , deedName(registry.getPropertyId("Quest_Name"))
+        , deedDescription(registry.getPropertyId("Quest_Description"))
+        , deedLevel(registry.getPropertyId("Accomplishment_MinLevelToStart"))
+        , titleName(registry.getPropertyId("Title_String"))
+        , titleCategory(registry.getPropertyId("Title_Category"))
+        , titleGroup(registry.getPropertyId("Title_ExclusionGroup"))
+        , emoteCommand(registry.getPropertyId("Emote_Command"))
+        , emoteDescription(registry.getPropertyId("Emote_Description"))
+        , emoteAuto(registry.getPropertyId("Emote_Automatic"))
+        , skillName(registry.getPropertyId("Skill_Name"))
+        , skillCategory(registry.getPropertyId("Skill_Category"))
+        , skillIcon(registry.getPropertyId("Skill_Icon"))
+    {
+    }
+    
+    // Titles are checked before deeds: deeds that grant a title don't carry Title_String
+    std::optional<RecordKind> classify(const dat::PropertiesSet& props) const {
+        if (titleName >= 0 && props.contains(titleName)) return RecordKind::Title;
+        if (deedTab >= 0 && props.contains(deedTab)) return RecordKind::Deed;
+        if (emoteCommand >= 0 && props.contains(emoteCommand)) return RecordKind::Emote;
+        if (skillName >= 0 && props.contains(skillName)) return RecordKind::Skill;
+        return std::nullopt;
+    }
+};
+
+struct Record {
+    QString id;                 // Game object ID, as in the LOTRO Companion data
+    dat::PropertiesSet props;
+};
+
+// Deed log tabs, numbered in the order of DeedCategory
+DeedCategory deedCategory(int64_t tab) {
+    if (tab >= 1 && tab <= static_cast<int64_t>(DeedCategory::Lore) + 1) {
+        return static_cast<DeedCategory>(tab - 1);
+    }
+    return DeedCategory::Unknown;
+}
+
+/**
+ * String fields of one record type, resolved a string table at a time
+ * 
+ * Targets must stay put until resolve(), so rows are sized up front.
+ */
+class PendingStrings {
+public:
+    explicit PendingStrings(dat::DataFacade& facade) : m_facade(facade) {}
+    
+    void add(const dat::PropertiesSet& props, int propertyId, QString& target) {
+        const dat::PropertyValue* value = propertyId >= 0 ? props.find(propertyId) : nullptr;
+        if (!value) {
+            return;
+        }
+        if (value->isToken()) {
+            m_byTable[value->tableId].push_back({value->tokenId, &target});
+        } else {
+            target = value->text;
+        }
+    }
+    
+    void resolve() {
+        std::vector<uint32_t> tokens;
+        for (auto& [tableId, pending] : m_byTable) {
+            tokens.clear();
+            for (const Pending& entry : pending) {
+                tokens.push_back(entry.tokenId);
+            }
+            std::vector<QString> strings = m_facade.resolveStrings(tableId, tokens);
+            for (size_t i = 0; i < pending.size(); ++i) {
+                *pending[i].target = std::move(strings[i]);
+            }
+        }
+        m_byTable.clear();
+    }
+    
+private:
+    struct Pending {
+        uint32_t tokenId;
+        QString* target;
+    };
+    
+    dat::DataFacade& m_facade;
+    std::unordered_map<uint32_t, std::vector<Pending>> m_byTable;
+};
+
+// Drop rows the XML loaders would also have skipped
+template<typename T, typename Keep>
+void dropIncomplete(std::vector<T>& rows, Keep keep) {
+    rows.erase(std::remove_if(rows.begin(), rows.end(), [&keep](const T& row) { return !keep(row); }),
+               rows.end());
+}
+
+} // anonymous namespace
+
+GameDataExtractor::GameDataExtractor(dat::DataFacade& facade)
+    : m_facade(facade)
+{
+}
+
+bool GameDataExtractor::extract(Tables& tables) {
+    allocation::Scope allocScope(allocation::Tag::Dat);
+    QElapsedTimer timer;
+    timer.start();
+    
+    // Loaded once here, before the workers share it
+    dat::PropertiesRegistry* registry = m_facade.getPropertiesRegistry();
+    if (!registry) {
+        spdlog::warn("Game data extraction: no properties registry");
+        return false;
+    }
+    const PropertyIds ids(*registry);
+    
+    // Decode and classify every properties record, a chunk per task
+    std::vector<uint64_t> dataIds = m_facade.listDataIds(PROPERTIES_TYPE);
+    struct Chunk {
+        size_t begin;
+        size_t end;
+        std::array<std::vector<Record>, KIND_COUNT> records;
+    };
+    std::vector<Chunk> chunks;
+    for (size_t begin = 0; begin < dataIds.size(); begin += CHUNK_SIZE) {
+        chunks.push_back({begin, std::min(begin + CHUNK_SIZE, dataIds.size()), {}});
+    }
+    
+    QtConcurrent::blockingMap(chunks, [this, &dataIds, &ids](Chunk& chunk) {
+        allocation::Scope scope(allocation::Tag::Dat);
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+            auto props = m_facade.loadProperties(dataIds[i]);
+            if (!props) {
+                continue;
+            }
+            if (auto kind = ids.classify(*props)) {
+                const uint64_t objectId = dataIds[i] - dat::DataFacade::DB_PROPERTIES_OFFSET;
+                chunk.records[static_cast<size_t>(*kind)].push_back(
+                    {QString::number(objectId), std::move(*props)});
+            }
+        }
+    });
+    const qint64 decodeMs = timer.elapsed();
+    
+    // Chunks are in ID order, so the buckets are too
+    std::array<std::vector<Record>, KIND_COUNT> buckets;
+    for (Chunk& chunk : chunks) {
+        for (size_t kind = 0; kind < KIND_COUNT; ++kind) {
+            auto& bucket = buckets[kind];
+            bucket.insert(bucket.end(), std::make_move_iterator(chunk.records[kind].begin()),
+                          std::make_move_iterator(chunk.records[kind].end()));
+        }
+    }
+    chunks.clear();
+    
+    // One task per record type; each fills only its own table
+    auto bucket = [&buckets](RecordKind kind) -> const std::vector<Record>& {
+        return buckets[static_cast<size_t>(kind)];
+    };
+    std::array<RecordKind, KIND_COUNT> kinds = {
+        RecordKind::Deed, RecordKind::Title, RecordKind::Emote, RecordKind::Skill
+    };
+    QtConcurrent::blockingMap(kinds, [&](RecordKind kind) {
+        allocation::Scope scope(allocation::Tag::Db);
+        const std::vector<Record>& records = bucket(kind);
+        PendingStrings strings(m_facade);
+        
+        switch (kind) {
+            case RecordKind::Deed:
+                tables.deeds.resize(records.size());
+                for (size_t i = 0; i < records.size(); ++i) {
+                    Deed& deed = tables.deeds[i];
+                    deed.id = records[i].id;
+                    deed.category = deedCategory(records[i].props.integer(ids.deedTab, 0));
+                    deed.level = static_cast<int>(records[i].props.integer(ids.deedLevel, 0));
+                    strings.add(records[i].props, ids.deedName, deed.name);
+                    strings.add(records[i].props, ids.deedDescription, deed.description);
+                }
+                strings.resolve();
+                dropIncomplete(tables.deeds, [](const Deed& deed) { return !deed.name.isEmpty(); });
+                break;
+            case RecordKind::Title:
+                tables.titles.resize(records.size());
+                for (size_t i = 0; i < records.size(); ++i) {
+                    Title& title = tables.titles[i];
+                    title.id = records[i].id;
+                    // Codes, as the Companion XML's category and exclusionGroup attributes
+                    if (records[i].props.contains(ids.titleCategory)) {
+                        title.description = QString::number(records[i].props.integer(ids.titleCategory));
+                    }
+                    if (records[i].props.contains(ids.titleGroup)) {
+                        title.source = QString::number(records[i].props.integer(ids.titleGroup));
+                    }
+                    strings.add(records[i].props, ids.titleName, title.name);
+                }
+                strings.resolve();
+                dropIncomplete(tables.titles, [](const Title& title) { return !title.name.isEmpty(); });
+                break;
+            case RecordKind::Emote:
+                tables.emotes.resize(records.size());
+                for (size_t i = 0; i < records.size(); ++i) {
+                    Emote& emote = tables.emotes[i];
+                    emote.id = records[i].id;
+                    emote.source = records[i].props.integer(ids.emoteAuto, 0) != 0 ? "Default" : "Special";
+                    strings.add(records[i].props, ids.emoteCommand, emote.command);
+                    strings.add(records[i].props, ids.emoteDescription, emote.description);
+                }
+                strings.resolve();
+                dropIncomplete(tables.emotes, [](const Emote& emote) { return !emote.command.isEmpty(); });
+                for (Emote& emote : tables.emotes) {
+                    emote.name = emote.command;
+                }
+                break;
+            case RecordKind::Skill:
+                tables.skills.resize(records.size());
+                for (size_t i = 0; i < records.size(); ++i) {
+                    Skill& skill = tables.skills[i];
+                    skill.id = records[i].id;
+                    skill.category = QString::number(records[i].props.integer(ids.skillCategory, 0));
+                    skill.iconId = static_cast<int>(records[i].props.integer(ids.skillIcon, 0));
+                    strings.add(records[i].props, ids.skillName, skill.name);
+                }
+                strings.resolve();
+                dropIncomplete(tables.skills, [](const Skill& skill) { return !skill.name.isEmpty(); });
+                break;
+            case RecordKind::Count:
+                break;
+        }
+    });
+    
+    spdlog::info("Extracted game data from {} DAT records in {} ms ({} ms decoding): "
+                 "{} deeds, {} titles, {} emotes, {} skills",
+                 dataIds.size(), timer.elapsed(), decodeMs, tables.deeds.size(),
+                 tables.titles.size(), tables.emotes.size(), tables.skills.size());
+    return true;
+}
+
+QString GameDataExtractor::snapshotPathFor(const QString& gamePath) {
+    auto cacheDir = Platform::getCachePath() / "game-database";
+    return QDir(QString::fromStdString(cacheDir.string())).filePath(
+        QString("gamedb-dat-%1.snapshot").arg(qHash(QDir(gamePath).absolutePath()), 8, 16, QChar('0')));
+}
+
+std::vector<SnapshotSource> GameDataExtractor::stampSources(const QString& gamePath) {
+    // The archives DataFacade reads game logic and strings from
+    QDir gameDir(gamePath);
+    std::vector<QString> names;
+    const QStringList archives = gameDir.entryList(
+        {"client_gamelogic.dat", "client_local_*.dat", "client_general.dat"}, QDir::Files, QDir::Name);
+    for (const QString& name : archives) {
+        names.push_back(name);
+    }
+    
+    std::vector<SnapshotSource> sources =
+        GameDatabaseSnapshot::stampSources(gamePath.toStdString(), names);
+    SnapshotSource version;
+    version.fileName = "extractor";
+    version.size = EXTRACTOR_VERSION;
+    sources.push_back(version);
+    return sources;
+}
+
+bool GameDataExtractor::writeSnapshot(const QString& path, const std::vector<SnapshotSource>& sources,
+                                      const Tables& tables) {
+    std::array<QByteArray, GameDatabaseSnapshot::TABLE_COUNT> blobs;
+    std::array<int, GameDatabaseSnapshot::TABLE_COUNT> counts{};
+    std::array<QByteArray, GameDatabaseSnapshot::TABLE_COUNT> texts;
+    
+    // Empty tables still need a valid blob, so the snapshot decodes as a whole
+    for (size_t i = 0; i < GameDatabaseSnapshot::TABLE_COUNT; ++i) {
+        blobs[i] = encodeSnapshotTable(std::vector<Race>{});
+    }
+    auto put = [&](GameTable table, const auto& rows) {
+        blobs[static_cast<size_t>(table)] = encodeSnapshotTable(rows);
+        counts[static_cast<size_t>(table)] = static_cast<int>(rows.size());
+    };
+    auto putTexts = [&](GameTable table, const auto& rows) {
+        std::vector<QString> descriptions;
+        descriptions.reserve(rows.size());
+        for (const auto& row : rows) {
+            descriptions.push_back(row.description);
+        }
+        texts[static_cast<size_t>(table)] = GameDatabaseSnapshot::encodeTexts(descriptions);
+    };
+    put(GameTable::Deeds, tables.deeds);
+    put(GameTable::Titles, tables.titles);
+    put(GameTable::Emotes, tables.emotes);
+    put(GameTable::Skills, tables.skills);
+    putTexts(GameTable::Deeds, tables.deeds);
+    putTexts(GameTable::Titles, tables.titles);
+    putTexts(GameTable::Emotes, tables.emotes);
+    
+    return GameDatabaseSnapshot::write(path, sources, blobs, counts, texts);
+}
+
+} // namespace lotro
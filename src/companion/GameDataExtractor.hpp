@@ -0,0 +1,84 @@
+/**
+ * LOTRO Launcher - Game Data Extractor
+ * 
+ * Builds GameDatabase tables from the installed game's DAT files instead
+ * of the LOTRO Companion XML.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "GameDatabase.hpp"
+#include "GameDatabaseSnapshot.hpp"
+
+#include <QString>
+
+#include <vector>
+
+namespace lotro {
+
+namespace dat { class DataFacade; }
+
+/**
+ * Extracts deeds, titles, emotes and skills from properties records
+ * 
+ * Every properties record (data ID type 0x79) is decoded once, in
+ * parallel chunks, and sorted into a record type by a marker property
+ * (Accomplishment_UITab, Title_String, Emote_Command, Skill_Name). Each
+ * type is then built on its own task, resolving its names through the
+ * facade's indexed string tables one table at a time. The result goes
+ * straight into a GameDatabaseSnapshot, stamped with the DAT archives it
+ * came from, so it is only rebuilt after the game is patched.
+ * 
+ * Fields the DAT doesn't carry in a simple form (deed regions and
+ * rewards) are left empty.
+ */
+class GameDataExtractor {
+public:
+    struct Tables {
+        std::vector<Deed> deeds;
+        std::vector<Title> titles;
+        std::vector<Emote> emotes;
+        std::vector<Skill> skills;
+    };
+    
+    explicit GameDataExtractor(dat::DataFacade& facade);
+    
+    /**
+     * Decode every properties record and build the tables
+     * @return false if the properties registry could not be loaded
+     */
+    bool extract(Tables& tables);
+    
+    /**
+     * Snapshot path for a game installation (inside the launcher cache)
+     */
+    static QString snapshotPathFor(const QString& gamePath);
+    
+    /**
+     * Stamp the DAT archives the tables are extracted from
+     * 
+     * Every patch rewrites the archives, so their sizes and mtimes change
+     * whenever the DAT iteration does. The extractor's own version is
+     * stamped too, so a changed extraction invalidates old snapshots.
+     */
+    static std::vector<SnapshotSource> stampSources(const QString& gamePath);
+    
+    /**
+     * Write extracted tables as a snapshot; tables not extracted are empty
+     */
+    static bool writeSnapshot(const QString& path, const std::vector<SnapshotSource>& sources,
+                              const Tables& tables);
+    
+private:
+    dat::DataFacade& m_facade;
+    
+    // Bump when the extraction changes, to rebuild existing snapshots
+    static constexpr qint64 EXTRACTOR_VERSION = 1;
+    
+    // Records decoded per task
+    static constexpr size_t CHUNK_SIZE = 512;
+};
+
+} // namespace lotro
@@ -7,20 +7,154 @@
  */
 
 #include "GameDatabase.hpp"
-
+#include "GameDatabaseSnapshot.hpp"
+#include "GameDataExtractor.hpp"
+#include "core/AllocationProfiler.hpp"
+#include "core/Metrics.hpp"
+#include "core/StallWatchdog.hpp"
+#include "core/TaskScheduler.hpp"
+#include "dat/DataFacade.hpp"
+
+#include <QElapsedTimer>
 #include <QFile>
+#include <QHash>
+#include <QStringList>
 #include <QXmlStreamReader>
+#include <QtConcurrent>
+#include <algorithm>
 #include <fstream>
 #include <spdlog/spdlog.h>
 
 namespace lotro {
 
-GameDatabase& GameDatabase::instance() {
-    static GameDatabase instance;
-    return instance;
+std::atomic<std::shared_ptr<GameDatabase>>& GameDatabase::generation() {
+    static std::atomic<std::shared_ptr<GameDatabase>> current{
+        std::shared_ptr<GameDatabase>(new GameDatabase(), [](GameDatabase* db) { delete db; })};
+    return current;
+}
+
+std::shared_ptr<const GameDatabase> GameDatabase::current() {
+    return generation().load(std::memory_order_acquire);
+}
+
+std::shared_ptr<GameDatabase> GameDatabase::create(const std::filesystem::path& dataDir, const QString& gamePath) {
+    std::shared_ptr<GameDatabase> db(new GameDatabase(), [](GameDatabase* generation) { delete generation; });
+    db->setGameDirectory(gamePath);
+    if (!db->initialize(dataDir)) {
+        return nullptr;
+    }
+    return db;
+}
+
+void GameDatabase::publish(std::shared_ptr<GameDatabase> db) {
+    static metrics::Counter& published = metrics::counter("gamedb.generations");
+    published.add();
+    generation().store(std::move(db), std::memory_order_release);
+}
+
+namespace {
+
+// Source XML file of each table, indexed by GameTable
+const std::vector<QString>& tableFileNames() {
+    static const std::vector<QString> names = {
+        "deeds.xml", "recipes.xml", "titles.xml", "emotes.xml",
+        "skills.xml", "traits.xml", "quests.xml", "collections.xml",
+        "cosmetics.xml", "factions.xml", "landmarks.xml", "geoAreas.xml",
+        "crafting.xml", "virtues.xml", "classes.xml", "races.xml"
+    };
+    return names;
 }
 
+// Map each record's key to its position; the first record wins on duplicates,
+// matching the old front-to-back scans
+template<typename Key, typename T, typename KeyFn>
+void indexBy(QHash<Key, qsizetype>& index, const std::vector<T>& rows, KeyFn keyOf) {
+    index.clear();
+    index.reserve(static_cast<qsizetype>(rows.size()));
+    for (size_t i = 0; i < rows.size(); ++i) {
+        Key key = keyOf(rows[i]);
+        if (!index.contains(key)) {
+            index.insert(key, static_cast<qsizetype>(i));
+        }
+    }
+}
+
+template<typename T, typename Key>
+const T* findIndexed(const std::vector<T>& rows, const QHash<Key, qsizetype>& index, const Key& key) {
+    auto it = index.constFind(key);
+    if (it == index.constEnd()) {
+        return nullptr;
+    }
+    return &rows[static_cast<size_t>(it.value())];
+}
+
+// FNV-1a over the ids and their count; qHash is seeded per process
+template<typename T>
+uint64_t layoutOf(const std::vector<T>& rows) {
+    constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash = (hash ^ ((value >> (i * 8)) & 0xff)) * FNV_PRIME;
+        }
+    };
+    mix(rows.size());
+    for (const T& row : rows) {
+        for (QChar ch : row.id) {
+            mix(ch.unicode());
+        }
+        mix(0);
+    }
+    return hash != 0 ? hash : 1;
+}
+
+template<typename T>
+std::optional<T> copyOf(const T* row) {
+    if (!row) {
+        return std::nullopt;
+    }
+    return *row;
+}
+
+// Classes and races are looked up by key or display name, case-insensitively
+template<typename T>
+void indexByKeyOrName(QHash<QString, qsizetype>& index, const std::vector<T>& rows) {
+    index.clear();
+    for (size_t i = 0; i < rows.size(); ++i) {
+        for (const QString& key : {rows[i].key.toCaseFolded(), rows[i].name.toCaseFolded()}) {
+            if (!index.contains(key)) {
+                index.insert(key, static_cast<qsizetype>(i));
+            }
+        }
+    }
+}
+
+// Append a record position to the postings list of a dense (pooled) id
+void addPosting(std::vector<std::vector<uint32_t>>& postings, uint32_t id, size_t position) {
+    if (id >= postings.size()) {
+        postings.resize(static_cast<size_t>(id) + 1);
+    }
+    postings[id].push_back(static_cast<uint32_t>(position));
+}
+
+template<typename T>
+std::vector<T> rowsAt(const std::vector<T>& rows, std::span<const uint32_t> positions) {
+    std::vector<T> results;
+    results.reserve(positions.size());
+    for (uint32_t position : positions) {
+        results.push_back(rows[position]);
+    }
+    return results;
+}
+
+} // anonymous namespace
+
+GameDatabase::GameDatabase() = default;
+GameDatabase::~GameDatabase() = default;
+
 bool GameDatabase::initialize(const std::filesystem::path& dataDir) {
+    allocation::Scope allocScope(allocation::Tag::Db);
+    StallScope stallScope("GameDatabase::initialize");
     if (m_loaded) {
         return true;
     }
@@ -29,47 +163,50 @@ bool GameDatabase::initialize(const std::filesystem::path& dataDir) {
     
     bool success = true;
     
+    if (!m_gameDirectory.isEmpty()) {
+        openDatSnapshot();
+    }
+    
     // Try LOTRO Companion XML format first (lore subdirectory)
     auto loreDir = dataDir / "lore";
+    m_loreDir = loreDir;
+    QString snapshotPath = GameDatabaseSnapshot::pathFor(dataDir);
+    if (std::filesystem::exists(loreDir) && openSnapshot(snapshotPath, loreDir)) {
+        // Tables are decoded from the snapshot on first use
+        m_loaded = true;
+        return true;
+    }
+    
     if (std::filesystem::exists(loreDir)) {
         spdlog::info("Found LOTRO Companion lore directory, loading XML data...");
+        success = loadTablesXml(loreDir);
         
-        auto deedsXml = loreDir / "deeds.xml";
-        if (std::filesystem::exists(deedsXml)) {
-            if (!loadDeedsXml(deedsXml)) {
-                spdlog::warn("Failed to load deeds from {}", deedsXml.string());
-                success = false;
-            }
-        }
-        
-        auto recipesXml = loreDir / "recipes.xml";
-        if (std::filesystem::exists(recipesXml)) {
-            if (!loadRecipesXml(recipesXml)) {
-                spdlog::warn("Failed to load recipes from {}", recipesXml.string());
-            }
+        // Swap the parsed descriptions for views of the fresh snapshot, so
+        // they leave the heap already on this first run
+        if (success && saveSnapshot(snapshotPath, loreDir) && openSnapshot(snapshotPath, loreDir)) {
+            attachTexts(GameTable::Deeds, *m_snapshot);
+            attachTexts(GameTable::Titles, *m_snapshot);
+            attachTexts(GameTable::Emotes, *m_snapshot);
         }
-        
-        // Load core data types
-        loadTitles(loreDir);
-        loadEmotes(loreDir);
-        loadSkills(loreDir);
-        loadTraits(loreDir);
-        loadQuests(loreDir);
-        loadCollections(loreDir);
-        loadCosmetics(loreDir);
-        
-        // Load new data types from LOTRO Companion
-        loadFactions(loreDir);
-        loadLandmarks(loreDir);
-        loadGeoAreas(loreDir);
-        loadCrafting(loreDir);
-        loadVirtues(loreDir);
-        loadClasses(loreDir);
-        loadRaces(loreDir);
     } else {
         spdlog::info("No lore directory found, will use JSON fallback if available");
     }
     
+    // The lore snapshot keeps the XML tables; the DAT ones replace them in memory
+    for (size_t i = 0; i < TABLE_COUNT; ++i) {
+        auto table = static_cast<GameTable>(i);
+        if (fromDat(table) && !decodeTable(table, *m_datSnapshot)) {
+            spdlog::warn("DAT snapshot table for {} is corrupt", tableFileNames()[i].toStdString());
+            loadTableXml(table, loreDir);
+        }
+    }
+    
+    // Everything is in memory now; nothing left to load lazily
+    for (size_t i = 0; i < TABLE_COUNT; ++i) {
+        compactTable(static_cast<GameTable>(i));
+        buildIndex(static_cast<GameTable>(i));
+        m_tableLoaded[i].store(true, std::memory_order_release);
+    }
     m_loaded = true;
     spdlog::info("Game database loaded: {} deeds, {} recipes, {} titles, {} emotes, "
                  "{} skills, {} traits, {} quests, {} collections, {} cosmetics, "
@@ -84,6 +221,606 @@ bool GameDatabase::initialize(const std::filesystem::path& dataDir) {
     return success;
 }
 
+QFuture<void> GameDatabase::preload(std::vector<GameTable> tables) {
+    // Reading waits on the disk; parsing fans out over the CPU pool
+    return TaskScheduler::instance().run(TaskPool::Io, [self = shared_from_this(), tables = std::move(tables)]() {
+        self->loadTables(tables);
+    });
+}
+
+void GameDatabase::loadTables(std::vector<GameTable> tables) {
+    QtConcurrent::blockingMap(tables, [this](GameTable table) {
+        ensureTable(table);
+    });
+}
+
+bool GameDatabase::isTableLoaded(GameTable table) const {
+    return m_tableLoaded[static_cast<size_t>(table)].load(std::memory_order_acquire);
+}
+
+std::vector<GameTable> GameDatabase::loadedTables() const {
+    std::vector<GameTable> tables;
+    for (size_t i = 0; i < TABLE_COUNT; ++i) {
+        if (isTableLoaded(static_cast<GameTable>(i))) {
+            tables.push_back(static_cast<GameTable>(i));
+        }
+    }
+    return tables;
+}
+
+void GameDatabase::ensureTable(GameTable table) const {
+    if (isTableLoaded(table) || !m_loaded) {
+        return;
+    }
+    
+    size_t index = static_cast<size_t>(table);
+    QMutexLocker lock(&m_tableMutexes[index]);
+    if (m_tableLoaded[index].load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    // Tables are a load-once cache behind the const lookups
+    const_cast<GameDatabase*>(this)->loadTable(table);
+    m_tableLoaded[index].store(true, std::memory_order_release);
+}
+
+void GameDatabase::loadTable(GameTable table) {
+    allocation::Scope allocScope(allocation::Tag::Db);
+    QElapsedTimer timer;
+    timer.start();
+    
+    const QString& name = tableFileNames()[static_cast<size_t>(table)];
+    if (fromDat(table)) {
+        if (decodeTable(table, *m_datSnapshot)) {
+            compactTable(table);
+            buildIndex(table);
+            spdlog::debug("Loaded {} from DAT snapshot: {} records in {} ms",
+                          name.toStdString(), loadedSize(table), timer.elapsed());
+            return;
+        }
+        spdlog::warn("DAT snapshot table for {} is corrupt", name.toStdString());
+    }
+    if (m_snapshot && m_snapshot->isOpen()) {
+        if (decodeTable(table, *m_snapshot)) {
+            compactTable(table);
+            buildIndex(table);
+            spdlog::debug("Loaded {} from snapshot: {} records in {} ms",
+                          name.toStdString(), loadedSize(table), timer.elapsed());
+            return;
+        }
+        spdlog::warn("Snapshot table for {} is corrupt, loading XML", name.toStdString());
+    }
+    
+    loadTableXml(table, m_loreDir);
+    compactTable(table);
+    buildIndex(table);
+    spdlog::debug("Loaded {} from XML: {} records in {} ms",
+                  name.toStdString(), loadedSize(table), timer.elapsed());
+}
+
+void GameDatabase::compactTable(GameTable table) {
+    switch (table) {
+        case GameTable::Deeds:
+            m_deedStrings.clear();
+            m_deedsByCategory = {};
+            m_deedsByRegion.clear();
+            for (size_t i = 0; i < m_deeds.size(); ++i) {
+                Deed& deed = m_deeds[i];
+                m_deedsByCategory[static_cast<size_t>(deed.category)].push_back(static_cast<uint32_t>(i));
+                addPosting(m_deedsByRegion, m_deedStrings.intern(deed.region), i);
+            }
+            break;
+        case GameTable::Recipes:
+            m_recipeStrings.clear();
+            m_recipesByProfession.clear();
+            for (size_t i = 0; i < m_recipes.size(); ++i) {
+                Recipe& recipe = m_recipes[i];
+                m_recipeStrings.intern(recipe.profession);
+                m_recipeStrings.intern(recipe.category);
+                for (Recipe::Ingredient& ingredient : recipe.ingredients) {
+                    m_recipeStrings.intern(ingredient.itemId);
+                    m_recipeStrings.intern(ingredient.name);
+                }
+                // Profession filters are case-insensitive, so post under the folded key
+                QString professionKey = recipe.profession.toCaseFolded();
+                addPosting(m_recipesByProfession, m_recipeStrings.intern(professionKey), i);
+            }
+            break;
+        case GameTable::Titles: {
+            StringPool sources;
+            for (Title& title : m_titles) {
+                sources.intern(title.source);
+            }
+            break;
+        }
+        case GameTable::Quests: {
+            StringPool strings;
+            for (Quest& quest : m_quests) {
+                strings.intern(quest.category);
+                strings.intern(quest.questArc);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void GameDatabase::buildIndex(GameTable table) {
+    auto byId = [](const auto& row) { return row.id; };
+    auto& layout = m_tableLayouts[static_cast<size_t>(table)];
+    switch (table) {
+        case GameTable::Deeds:
+            indexBy(m_deedIndex, m_deeds, byId);
+            layout = layoutOf(m_deeds);
+            m_deedSearch.clear();
+            m_deedSearch.reserve(m_deeds.size());
+            for (const Deed& deed : m_deeds) {
+                m_deedSearch.add(deed.name, {deed.description, deed.region});
+            }
+            break;
+        case GameTable::Recipes:
+            indexBy(m_recipeIndex, m_recipes, byId);
+            layout = layoutOf(m_recipes);
+            m_recipeGraph.build(m_recipes);
+            m_recipeSearch.clear();
+            m_recipeSearch.reserve(m_recipes.size());
+            for (const Recipe& recipe : m_recipes) {
+                m_recipeSearch.add(recipe.name, {recipe.outputItemName});
+            }
+            break;
+        case GameTable::Titles:
+            indexBy(m_titleIndex, m_titles, byId);
+            layout = layoutOf(m_titles);
+            m_titleSearch.clear();
+            m_titleSearch.reserve(m_titles.size());
+            for (const Title& title : m_titles) {
+                m_titleSearch.add(title.name, {title.description});
+            }
+            break;
+        case GameTable::Emotes:
+            indexBy(m_emoteIndex, m_emotes, byId);
+            layout = layoutOf(m_emotes);
+            break;
+        case GameTable::Skills:
+            indexBy(m_skillIndex, m_skills, byId);
+            layout = layoutOf(m_skills);
+            m_skillSearch.clear();
+            m_skillSearch.reserve(m_skills.size());
+            for (const Skill& skill : m_skills) {
+                m_skillSearch.add(skill.name);
+            }
+            break;
+        case GameTable::Traits:
+            indexBy(m_traitIndex, m_traits, byId);
+            layout = layoutOf(m_traits);
+            m_traitSearch.clear();
+            m_traitSearch.reserve(m_traits.size());
+            for (const Trait& trait : m_traits) {
+                m_traitSearch.add(trait.name);
+            }
+            break;
+        case GameTable::Factions:
+            indexBy(m_factionIndex, m_factions, byId);
+            m_factionsByCategory.clear();
+            for (size_t i = 0; i < m_factions.size(); ++i) {
+                m_factionsByCategory[m_factions[i].category.toCaseFolded()].push_back(static_cast<uint32_t>(i));
+            }
+            break;
+        case GameTable::Landmarks:
+            indexBy(m_landmarkIndex, m_landmarks, byId);
+            m_landmarkSearch.clear();
+            m_landmarkSearch.reserve(m_landmarks.size());
+            for (const Landmark& landmark : m_landmarks) {
+                m_landmarkSearch.add(landmark.name);
+            }
+            break;
+        case GameTable::GeoAreas:
+            indexBy(m_geoAreaIndex, m_geoAreas, byId);
+            m_territoriesByRegion.clear();
+            for (size_t i = 0; i < m_geoAreas.size(); ++i) {
+                if (m_geoAreas[i].type == GeoAreaType::Territory) {
+                    m_territoriesByRegion[m_geoAreas[i].parentId].push_back(static_cast<uint32_t>(i));
+                }
+            }
+            break;
+        case GameTable::Professions:
+            indexBy(m_professionIndex, m_professions,
+                    [](const CraftingProfession& p) { return p.key.toCaseFolded(); });
+            break;
+        case GameTable::Virtues: indexBy(m_virtueIndex, m_virtues, byId); break;
+        case GameTable::Classes:
+            indexByKeyOrName(m_classIndex, m_classes);
+            indexBy(m_classCodeIndex, m_classes, [](const GameClass& c) { return c.code; });
+            break;
+        case GameTable::Races:
+            indexByKeyOrName(m_raceIndex, m_races);
+            indexBy(m_raceCodeIndex, m_races, [](const Race& r) { return r.code; });
+            break;
+        // No point lookups on these
+        case GameTable::Quests:
+        case GameTable::Collections:
+        case GameTable::Cosmetics:
+        case GameTable::Count:
+            break;
+    }
+}
+
+size_t GameDatabase::loadedSize(GameTable table) const {
+    switch (table) {
+        case GameTable::Deeds: return m_deeds.size();
+        case GameTable::Recipes: return m_recipes.size();
+        case GameTable::Titles: return m_titles.size();
+        case GameTable::Emotes: return m_emotes.size();
+        case GameTable::Skills: return m_skills.size();
+        case GameTable::Traits: return m_traits.size();
+        case GameTable::Quests: return m_quests.size();
+        case GameTable::Collections: return m_collections.size();
+        case GameTable::Cosmetics: return m_cosmetics.size();
+        case GameTable::Factions: return m_factions.size();
+        case GameTable::Landmarks: return m_landmarks.size();
+        case GameTable::GeoAreas: return m_geoAreas.size();
+        case GameTable::Professions: return m_professions.size();
+        case GameTable::Virtues: return m_virtues.size();
+        case GameTable::Classes: return m_classes.size();
+        case GameTable::Races: return m_races.size();
+        case GameTable::Count: break;
+    }
+    return 0;
+}
+
+int GameDatabase::tableCount(GameTable table) const {
+    // The snapshot directory knows every table's size without decoding it
+    if (!isTableLoaded(table) && fromDat(table)) {
+        return m_datSnapshot->recordCount(table);
+    }
+    if (!isTableLoaded(table) && m_snapshot && m_snapshot->isOpen()) {
+        return m_snapshot->recordCount(table);
+    }
+    return static_cast<int>(loadedSize(table));
+}
+
+bool GameDatabase::loadTableXml(GameTable table, const std::filesystem::path& loreDir) {
+    switch (table) {
+        case GameTable::Deeds: {
+            auto deedsXml = loreDir / "deeds.xml";
+            if (!std::filesystem::exists(deedsXml)) {
+                return true;
+            }
+            if (!loadDeedsXml(deedsXml)) {
+                spdlog::warn("Failed to load deeds from {}", deedsXml.string());
+                return false;
+            }
+            return true;
+        }
+        case GameTable::Recipes: {
+            auto recipesXml = loreDir / "recipes.xml";
+            if (std::filesystem::exists(recipesXml) && !loadRecipesXml(recipesXml)) {
+                spdlog::warn("Failed to load recipes from {}", recipesXml.string());
+            }
+            return true;
+        }
+        // The remaining loaders are best-effort, as before
+        case GameTable::Titles: loadTitles(loreDir); return true;
+        case GameTable::Emotes: loadEmotes(loreDir); return true;
+        case GameTable::Skills: loadSkills(loreDir); return true;
+        case GameTable::Traits: loadTraits(loreDir); return true;
+        case GameTable::Quests: loadQuests(loreDir); return true;
+        case GameTable::Collections: loadCollections(loreDir); return true;
+        case GameTable::Cosmetics: loadCosmetics(loreDir); return true;
+        case GameTable::Factions: loadFactions(loreDir); return true;
+        case GameTable::Landmarks: loadLandmarks(loreDir); return true;
+        case GameTable::GeoAreas: loadGeoAreas(loreDir); return true;
+        case GameTable::Professions: loadCrafting(loreDir); return true;
+        case GameTable::Virtues: loadVirtues(loreDir); return true;
+        case GameTable::Classes: loadClasses(loreDir); return true;
+        case GameTable::Races: loadRaces(loreDir); return true;
+        case GameTable::Count: break;
+    }
+    return true;
+}
+
+bool GameDatabase::loadTablesXml(const std::filesystem::path& loreDir) {
+    QElapsedTimer wall;
+    wall.start();
+    
+    // Every loader fills only its own vector, so they can all run at once
+    struct TableLoad {
+        GameTable table;
+        bool ok = true;
+        qint64 elapsedMs = 0;
+    };
+    std::vector<TableLoad> loads;
+    for (int i = 0; i < static_cast<int>(GameTable::Count); ++i) {
+        loads.push_back({static_cast<GameTable>(i)});
+    }
+    
+    QtConcurrent::blockingMap(loads, [this, &loreDir](TableLoad& load) {
+        QElapsedTimer timer;
+        timer.start();
+        load.ok = loadTableXml(load.table, loreDir);
+        load.elapsedMs = timer.elapsed();
+    });
+    
+    std::sort(loads.begin(), loads.end(), [](const TableLoad& a, const TableLoad& b) {
+        return a.elapsedMs > b.elapsedMs;
+    });
+    
+    QStringList breakdown;
+    bool success = true;
+    for (const TableLoad& load : loads) {
+        breakdown << QString("%1 %2 ms").arg(tableFileNames()[static_cast<size_t>(load.table)]).arg(load.elapsedMs);
+        success = success && load.ok;
+    }
+    spdlog::info("Game database XML loaded in {} ms wall time ({})",
+                 wall.elapsed(), breakdown.join(", ").toStdString());
+    return success;
+}
+
+bool GameDatabase::openSnapshot(const QString& snapshotPath, const std::filesystem::path& loreDir) {
+    auto snapshot = std::make_unique<GameDatabaseSnapshot>();
+    if (!snapshot->open(snapshotPath, GameDatabaseSnapshot::stampSources(loreDir, tableFileNames()))) {
+        return false;
+    }
+    
+    m_snapshot = std::move(snapshot);
+    spdlog::info("Game database snapshot opened: {} deeds, {} recipes, {} titles, "
+                 "{} skills, {} traits, {} quests (loaded on demand)",
+                 m_snapshot->recordCount(GameTable::Deeds), m_snapshot->recordCount(GameTable::Recipes),
+                 m_snapshot->recordCount(GameTable::Titles), m_snapshot->recordCount(GameTable::Skills),
+                 m_snapshot->recordCount(GameTable::Traits), m_snapshot->recordCount(GameTable::Quests));
+    return true;
+}
+
+bool GameDatabase::decodeTable(GameTable table, const GameDatabaseSnapshot& snapshot) {
+    QByteArray blob = snapshot.table(table);
+    switch (table) {
+        case GameTable::Deeds: return decodeSnapshotTable(blob, m_deeds) && attachTexts(table, snapshot);
+        case GameTable::Recipes: return decodeSnapshotTable(blob, m_recipes);
+        case GameTable::Titles: return decodeSnapshotTable(blob, m_titles) && attachTexts(table, snapshot);
+        case GameTable::Emotes: return decodeSnapshotTable(blob, m_emotes) && attachTexts(table, snapshot);
+        case GameTable::Skills: return decodeSnapshotTable(blob, m_skills);
+        case GameTable::Traits: return decodeSnapshotTable(blob, m_traits);
+        case GameTable::Quests: return decodeSnapshotTable(blob, m_quests);
+        case GameTable::Collections: return decodeSnapshotTable(blob, m_collections);
+        case GameTable::Cosmetics: return decodeSnapshotTable(blob, m_cosmetics);
+        case GameTable::Factions: return decodeSnapshotTable(blob, m_factions);
+        case GameTable::Landmarks: return decodeSnapshotTable(blob, m_landmarks);
+        case GameTable::GeoAreas: return decodeSnapshotTable(blob, m_geoAreas);
+        case GameTable::Professions: return decodeSnapshotTable(blob, m_professions);
+        case GameTable::Virtues: return decodeSnapshotTable(blob, m_virtues);
+        case GameTable::Classes: return decodeSnapshotTable(blob, m_classes);
+        case GameTable::Races: return decodeSnapshotTable(blob, m_races);
+        case GameTable::Count: break;
+    }
+    return false;
+}
+
+bool GameDatabase::attachTexts(GameTable table, const GameDatabaseSnapshot& snapshot) {
+    std::vector<QString> texts = snapshot.texts(table);
+    auto attach = [&texts](auto& rows) {
+        if (texts.size() != rows.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < rows.size(); ++i) {
+            rows[i].description = std::move(texts[i]);
+        }
+        return true;
+    };
+    switch (table) {
+        case GameTable::Deeds: return attach(m_deeds);
+        case GameTable::Titles: return attach(m_titles);
+        case GameTable::Emotes: return attach(m_emotes);
+        default: return true;
+    }
+}
+
+bool GameDatabase::openDatSnapshot() {
+    const QString path = GameDataExtractor::snapshotPathFor(m_gameDirectory);
+    const std::vector<SnapshotSource> sources = GameDataExtractor::stampSources(m_gameDirectory);
+    if (sources.size() <= 1) {
+        spdlog::debug("No DAT archives in {}, using XML tables", m_gameDirectory.toStdString());
+        return false;
+    }
+    
+    auto snapshot = std::make_unique<GameDatabaseSnapshot>();
+    if (!snapshot->open(path, sources)) {
+        // First run, or the game was patched since
+        spdlog::info("Extracting game data from the DAT files in {}", m_gameDirectory.toStdString());
+        auto facade = dat::DataFacade::shared(m_gameDirectory);
+        GameDataExtractor::Tables tables;
+        if (!facade->initialize() || !GameDataExtractor(*facade).extract(tables)
+            || !GameDataExtractor::writeSnapshot(path, sources, tables) || !snapshot->open(path, sources)) {
+            spdlog::warn("Game data extraction failed, using XML tables");
+            return false;
+        }
+    }
+    
+    m_datSnapshot = std::move(snapshot);
+    return true;
+}
+
+bool GameDatabase::fromDat(GameTable table) const {
+    return m_datSnapshot && m_datSnapshot->recordCount(table) > 0;
+}
+
+bool GameDatabase::saveSnapshot(const QString& snapshotPath, const std::filesystem::path& loreDir) const {
+    std::array<QByteArray, GameDatabaseSnapshot::TABLE_COUNT> tables;
+    std::array<int, GameDatabaseSnapshot::TABLE_COUNT> counts{};
+    
+    std::array<QByteArray, GameDatabaseSnapshot::TABLE_COUNT> texts;
+    
+    auto put = [&](GameTable table, const auto& rows) {
+        tables[static_cast<size_t>(table)] = encodeSnapshotTable(rows);
+        counts[static_cast<size_t>(table)] = static_cast<int>(rows.size());
+    };
+    auto putTexts = [&](GameTable table, const auto& rows) {
+        std::vector<QString> descriptions;
+        descriptions.reserve(rows.size());
+        for (const auto& row : rows) {
+            descriptions.push_back(row.description);
+        }
+        texts[static_cast<size_t>(table)] = GameDatabaseSnapshot::encodeTexts(descriptions);
+    };
+    putTexts(GameTable::Deeds, m_deeds);
+    putTexts(GameTable::Titles, m_titles);
+    putTexts(GameTable::Emotes, m_emotes);
+    put(GameTable::Deeds, m_deeds);
+    put(GameTable::Recipes, m_recipes);
+    put(GameTable::Titles, m_titles);
+    put(GameTable::Emotes, m_emotes);
+    put(GameTable::Skills, m_skills);
+    put(GameTable::Traits, m_traits);
+    put(GameTable::Quests, m_quests);
+    put(GameTable::Collections, m_collections);
+    put(GameTable::Cosmetics, m_cosmetics);
+    put(GameTable::Factions, m_factions);
+    put(GameTable::Landmarks, m_landmarks);
+    put(GameTable::GeoAreas, m_geoAreas);
+    put(GameTable::Professions, m_professions);
+    put(GameTable::Virtues, m_virtues);
+    put(GameTable::Classes, m_classes);
+    put(GameTable::Races, m_races);
+    
+    return GameDatabaseSnapshot::write(snapshotPath, GameDatabaseSnapshot::stampSources(loreDir, tableFileNames()),
+                                tables, counts, texts);
+}
+
+// ============ Views ============
+
+std::span<const Deed> GameDatabase::deedsView() const {
+    ensureTable(GameTable::Deeds);
+    return m_deeds;
+}
+
+std::vector<uint32_t> GameDatabase::searchDeedPositions(const QString& query, size_t limit) const {
+    ensureTable(GameTable::Deeds);
+    return m_deedSearch.search(query, limit);
+}
+
+std::span<const uint32_t> GameDatabase::deedPositionsByCategory(DeedCategory category) const {
+    ensureTable(GameTable::Deeds);
+    return m_deedsByCategory[static_cast<size_t>(category)];
+}
+
+std::span<const Recipe> GameDatabase::recipesView() const {
+    ensureTable(GameTable::Recipes);
+    return m_recipes;
+}
+
+std::vector<uint32_t> GameDatabase::searchRecipePositions(const QString& query, size_t limit) const {
+    ensureTable(GameTable::Recipes);
+    return m_recipeSearch.search(query, limit);
+}
+
+std::vector<uint32_t> GameDatabase::refineRecipePositions(const QString& query,
+                                                          std::span<const uint32_t> previous) const {
+    ensureTable(GameTable::Recipes);
+    return m_recipeSearch.refine(query, previous);
+}
+
+std::span<const uint32_t> GameDatabase::recipePositionsByProfession(const QString& profession) const {
+    ensureTable(GameTable::Recipes);
+    uint32_t professionId = m_recipeStrings.find(profession.toCaseFolded());
+    if (professionId >= m_recipesByProfession.size()) {
+        return {};
+    }
+    return m_recipesByProfession[professionId];
+}
+
+std::span<const Title> GameDatabase::titlesView() const {
+    ensureTable(GameTable::Titles);
+    return m_titles;
+}
+
+std::span<const Emote> GameDatabase::emotesView() const {
+    ensureTable(GameTable::Emotes);
+    return m_emotes;
+}
+
+std::span<const Skill> GameDatabase::skillsView() const {
+    ensureTable(GameTable::Skills);
+    return m_skills;
+}
+
+std::span<const Trait> GameDatabase::traitsView() const {
+    ensureTable(GameTable::Traits);
+    return m_traits;
+}
+
+std::span<const Quest> GameDatabase::questsView() const {
+    ensureTable(GameTable::Quests);
+    return m_quests;
+}
+
+std::span<const CollectionItem> GameDatabase::collectionsView() const {
+    ensureTable(GameTable::Collections);
+    return m_collections;
+}
+
+std::span<const Cosmetic> GameDatabase::cosmeticsView() const {
+    ensureTable(GameTable::Cosmetics);
+    return m_cosmetics;
+}
+
+std::span<const Faction> GameDatabase::factionsView() const {
+    ensureTable(GameTable::Factions);
+    return m_factions;
+}
+
+std::span<const Landmark> GameDatabase::landmarksView() const {
+    ensureTable(GameTable::Landmarks);
+    return m_landmarks;
+}
+
+std::span<const GeoArea> GameDatabase::geoAreasView() const {
+    ensureTable(GameTable::GeoAreas);
+    return m_geoAreas;
+}
+
+std::span<const CraftingProfession> GameDatabase::professionsView() const {
+    ensureTable(GameTable::Professions);
+    return m_professions;
+}
+
+std::span<const VirtueDef> GameDatabase::virtuesView() const {
+    ensureTable(GameTable::Virtues);
+    return m_virtues;
+}
+
+std::span<const GameClass> GameDatabase::classesView() const {
+    ensureTable(GameTable::Classes);
+    return m_classes;
+}
+
+std::span<const Race> GameDatabase::racesView() const {
+    ensureTable(GameTable::Races);
+    return m_races;
+}
+
+qsizetype GameDatabase::recordPosition(GameTable table, const QString& id) const {
+    const QHash<QString, qsizetype>* index = nullptr;
+    switch (table) {
+        case GameTable::Deeds: index = &m_deedIndex; break;
+        case GameTable::Recipes: index = &m_recipeIndex; break;
+        case GameTable::Titles: index = &m_titleIndex; break;
+        case GameTable::Emotes: index = &m_emoteIndex; break;
+        case GameTable::Skills: index = &m_skillIndex; break;
+        case GameTable::Traits: index = &m_traitIndex; break;
+        default: return -1;
+    }
+    ensureTable(table);
+    return index->value(id, -1);
+}
+
+uint64_t GameDatabase::tableLayout(GameTable table) const {
+    if (table == GameTable::Count) {
+        return 0;
+    }
+    ensureTable(table);
+    return m_tableLayouts[static_cast<size_t>(table)];
+}
+
 // Helper to parse deed type from LOTRO Companion format
 static DeedCategory parseDeedType(const QString& type) {
     if (type == "CLASS") return DeedCategory::Class;
@@ -572,225 +1309,187 @@ bool GameDatabase::loadCosmetics(const std::filesystem::path& path) {
 
 // ============ Deed Lookups ============
 
-std::vector<Deed> GameDatabase::searchDeeds(const QString& query) const {
-    std::vector<Deed> results;
-    QString lowerQuery = query.toLower();
-    
-    for (const auto& deed : m_deeds) {
-        if (deed.name.toLower().contains(lowerQuery) ||
-            deed.description.toLower().contains(lowerQuery) ||
-            deed.region.toLower().contains(lowerQuery)) {
-            results.push_back(deed);
-        }
-    }
-    
-    return results;
+std::vector<Deed> GameDatabase::searchDeeds(const QString& query, size_t limit) const {
+    ensureTable(GameTable::Deeds);
+    return rowsAt(m_deeds, m_deedSearch.search(query, limit));
 }
 
 std::vector<Deed> GameDatabase::getDeedsByCategory(DeedCategory category) const {
-    std::vector<Deed> results;
-    
-    for (const auto& deed : m_deeds) {
-        if (deed.category == category) {
-            results.push_back(deed);
-        }
-    }
-    
-    return results;
+    ensureTable(GameTable::Deeds);
+    return rowsAt(m_deeds, m_deedsByCategory[static_cast<size_t>(category)]);
 }
 
 std::vector<Deed> GameDatabase::getDeedsByRegion(const QString& region) const {
-    std::vector<Deed> results;
-    
-    for (const auto& deed : m_deeds) {
-        if (deed.region == region) {
-            results.push_back(deed);
-        }
+    ensureTable(GameTable::Deeds);
+    uint32_t regionId = m_deedStrings.find(region);
+    if (regionId >= m_deedsByRegion.size()) {
+        return {};
     }
-    
-    return results;
+    return rowsAt(m_deeds, m_deedsByRegion[regionId]);
+}
+
+const Deed* GameDatabase::findDeed(const QString& id) const {
+    ensureTable(GameTable::Deeds);
+    return findIndexed(m_deeds, m_deedIndex, id);
 }
 
 std::optional<Deed> GameDatabase::getDeed(const QString& id) const {
-    for (const auto& deed : m_deeds) {
-        if (deed.id == id) {
-            return deed;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findDeed(id));
 }
 
 // ============ Recipe Lookups ============
 
-std::vector<Recipe> GameDatabase::searchRecipes(const QString& query) const {
-    std::vector<Recipe> results;
-    QString lowerQuery = query.toLower();
-    
-    for (const auto& recipe : m_recipes) {
-        if (recipe.name.toLower().contains(lowerQuery) ||
-            recipe.outputItemName.toLower().contains(lowerQuery)) {
-            results.push_back(recipe);
-        }
-    }
-    
-    return results;
+std::vector<Recipe> GameDatabase::searchRecipes(const QString& query, size_t limit) const {
+    ensureTable(GameTable::Recipes);
+    return rowsAt(m_recipes, m_recipeSearch.search(query, limit));
 }
 
 std::vector<Recipe> GameDatabase::getRecipesByProfession(const QString& profession) const {
-    std::vector<Recipe> results;
-    
-    for (const auto& recipe : m_recipes) {
-        if (recipe.profession.compare(profession, Qt::CaseInsensitive) == 0) {
-            results.push_back(recipe);
-        }
+    ensureTable(GameTable::Recipes);
+    uint32_t professionId = m_recipeStrings.find(profession.toCaseFolded());
+    if (professionId >= m_recipesByProfession.size()) {
+        return {};
     }
-    
-    return results;
+    return rowsAt(m_recipes, m_recipesByProfession[professionId]);
 }
 
 std::vector<Recipe> GameDatabase::getRecipesForItem(const QString& outputItemId) const {
-    std::vector<Recipe> results;
-    
-    for (const auto& recipe : m_recipes) {
-        if (recipe.outputItemId == outputItemId) {
-            results.push_back(recipe);
-        }
-    }
-    
-    return results;
+    ensureTable(GameTable::Recipes);
+    return rowsAt(m_recipes, m_recipeGraph.producers(outputItemId));
+}
+
+const Recipe* GameDatabase::findRecipe(const QString& id) const {
+    ensureTable(GameTable::Recipes);
+    return findIndexed(m_recipes, m_recipeIndex, id);
 }
 
 std::optional<Recipe> GameDatabase::getRecipe(const QString& id) const {
-    for (const auto& recipe : m_recipes) {
-        if (recipe.id == id) {
-            return recipe;
-        }
+    return copyOf(findRecipe(id));
+}
+
+std::vector<Recipe> GameDatabase::getRecipesConsuming(const QString& recipeId) const {
+    ensureTable(GameTable::Recipes);
+    auto it = m_recipeIndex.constFind(recipeId);
+    if (it == m_recipeIndex.constEnd()) {
+        return {};
     }
-    return std::nullopt;
+    return rowsAt(m_recipes, m_recipeGraph.consumers(static_cast<uint32_t>(it.value())));
 }
 
-// ============ Title Lookups ============
+BillOfMaterials GameDatabase::getBillOfMaterials(const QString& itemId, int quantity) const {
+    ensureTable(GameTable::Recipes);
+    return m_recipeGraph.expandItem(m_recipes, itemId, quantity);
+}
 
-std::vector<Title> GameDatabase::searchTitles(const QString& query) const {
-    std::vector<Title> results;
-    QString lowerQuery = query.toLower();
-    
-    for (const auto& title : m_titles) {
-        if (title.name.toLower().contains(lowerQuery) ||
-            title.description.toLower().contains(lowerQuery)) {
-            results.push_back(title);
-        }
+BillOfMaterials GameDatabase::getRecipeBillOfMaterials(const QString& recipeId, int crafts) const {
+    ensureTable(GameTable::Recipes);
+    auto it = m_recipeIndex.constFind(recipeId);
+    if (it == m_recipeIndex.constEnd()) {
+        return {};
     }
-    
-    return results;
+    return m_recipeGraph.expandRecipe(m_recipes, static_cast<uint32_t>(it.value()), crafts);
+}
+
+// ============ Title Lookups ============
+
+std::vector<Title> GameDatabase::searchTitles(const QString& query, size_t limit) const {
+    ensureTable(GameTable::Titles);
+    return rowsAt(m_titles, m_titleSearch.search(query, limit));
+}
+
+const Title* GameDatabase::findTitle(const QString& id) const {
+    ensureTable(GameTable::Titles);
+    return findIndexed(m_titles, m_titleIndex, id);
 }
 
 std::optional<Title> GameDatabase::getTitle(const QString& id) const {
-    for (const auto& title : m_titles) {
-        if (title.id == id) {
-            return title;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findTitle(id));
 }
 
 // ============ Emote Lookups ============
 
 std::vector<Emote> GameDatabase::getAllEmotes() const {
+    ensureTable(GameTable::Emotes);
     return m_emotes;
 }
 
+const Emote* GameDatabase::findEmote(const QString& id) const {
+    ensureTable(GameTable::Emotes);
+    return findIndexed(m_emotes, m_emoteIndex, id);
+}
+
 std::optional<Emote> GameDatabase::getEmote(const QString& id) const {
-    for (const auto& emote : m_emotes) {
-        if (emote.id == id) {
-            return emote;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findEmote(id));
 }
 
 // ============ Statistics ============
 
 int GameDatabase::deedCount() const {
-    return static_cast<int>(m_deeds.size());
+    return tableCount(GameTable::Deeds);
 }
 
 int GameDatabase::recipeCount() const {
-    return static_cast<int>(m_recipes.size());
+    return tableCount(GameTable::Recipes);
 }
 
 int GameDatabase::titleCount() const {
-    return static_cast<int>(m_titles.size());
+    return tableCount(GameTable::Titles);
 }
 
 int GameDatabase::emoteCount() const {
-    return static_cast<int>(m_emotes.size());
+    return tableCount(GameTable::Emotes);
 }
 
 // ============ Skill Lookups ============
 
-std::vector<Skill> GameDatabase::searchSkills(const QString& query) const {
-    std::vector<Skill> results;
-    QString lowerQuery = query.toLower();
-    
-    for (const auto& skill : m_skills) {
-        if (query.isEmpty() || skill.name.toLower().contains(lowerQuery)) {
-            results.push_back(skill);
-        }
-    }
-    return results;
+std::vector<Skill> GameDatabase::searchSkills(const QString& query, size_t limit) const {
+    ensureTable(GameTable::Skills);
+    return rowsAt(m_skills, m_skillSearch.search(query, limit));
+}
+
+const Skill* GameDatabase::findSkill(const QString& id) const {
+    ensureTable(GameTable::Skills);
+    return findIndexed(m_skills, m_skillIndex, id);
 }
 
 std::optional<Skill> GameDatabase::getSkill(const QString& id) const {
-    for (const auto& skill : m_skills) {
-        if (skill.id == id) {
-            return skill;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findSkill(id));
 }
 
 // ============ Trait Lookups ============
 
-std::vector<Trait> GameDatabase::searchTraits(const QString& query) const {
-    std::vector<Trait> results;
-    QString lowerQuery = query.toLower();
-    
-    for (const auto& trait : m_traits) {
-        if (query.isEmpty() || trait.name.toLower().contains(lowerQuery)) {
-            results.push_back(trait);
-        }
-    }
-    return results;
+std::vector<Trait> GameDatabase::searchTraits(const QString& query, size_t limit) const {
+    ensureTable(GameTable::Traits);
+    return rowsAt(m_traits, m_traitSearch.search(query, limit));
+}
+
+const Trait* GameDatabase::findTrait(const QString& id) const {
+    ensureTable(GameTable::Traits);
+    return findIndexed(m_traits, m_traitIndex, id);
 }
 
 std::optional<Trait> GameDatabase::getTrait(const QString& id) const {
-    for (const auto& trait : m_traits) {
-        if (trait.id == id) {
-            return trait;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findTrait(id));
 }
 
 int GameDatabase::skillCount() const {
-    return static_cast<int>(m_skills.size());
+    return tableCount(GameTable::Skills);
 }
 
 int GameDatabase::traitCount() const {
-    return static_cast<int>(m_traits.size());
+    return tableCount(GameTable::Traits);
 }
 
 int GameDatabase::questCount() const {
-    return static_cast<int>(m_quests.size());
+    return tableCount(GameTable::Quests);
 }
 
 int GameDatabase::collectionCount() const {
-    return static_cast<int>(m_collections.size());
+    return tableCount(GameTable::Collections);
 }
 
 int GameDatabase::cosmeticCount() const {
-    return static_cast<int>(m_cosmetics.size());
+    return tableCount(GameTable::Cosmetics);
 }
 
 // ============ Faction Loading & Lookups ============
@@ -857,30 +1556,26 @@ bool GameDatabase::loadFactions(const std::filesystem::path& path) {
 }
 
 std::vector<Faction> GameDatabase::getAllFactions() const {
+    ensureTable(GameTable::Factions);
     return m_factions;
 }
 
 std::vector<Faction> GameDatabase::getFactionsByCategory(const QString& category) const {
-    std::vector<Faction> results;
-    for (const auto& f : m_factions) {
-        if (f.category.compare(category, Qt::CaseInsensitive) == 0) {
-            results.push_back(f);
-        }
-    }
-    return results;
+    ensureTable(GameTable::Factions);
+    return rowsAt(m_factions, m_factionsByCategory.value(category.toCaseFolded()));
+}
+
+const Faction* GameDatabase::findFaction(const QString& id) const {
+    ensureTable(GameTable::Factions);
+    return findIndexed(m_factions, m_factionIndex, id);
 }
 
 std::optional<Faction> GameDatabase::getFaction(const QString& id) const {
-    for (const auto& f : m_factions) {
-        if (f.id == id) {
-            return f;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findFaction(id));
 }
 
 int GameDatabase::factionCount() const {
-    return static_cast<int>(m_factions.size());
+    return tableCount(GameTable::Factions);
 }
 
 // ============ Landmark Loading & Lookups ============
@@ -923,29 +1618,22 @@ bool GameDatabase::loadLandmarks(const std::filesystem::path& path) {
     return true;
 }
 
-std::vector<Landmark> GameDatabase::searchLandmarks(const QString& query) const {
-    std::vector<Landmark> results;
-    QString lowerQuery = query.toLower();
-    
-    for (const auto& lm : m_landmarks) {
-        if (query.isEmpty() || lm.name.toLower().contains(lowerQuery)) {
-            results.push_back(lm);
-        }
-    }
-    return results;
+std::vector<Landmark> GameDatabase::searchLandmarks(const QString& query, size_t limit) const {
+    ensureTable(GameTable::Landmarks);
+    return rowsAt(m_landmarks, m_landmarkSearch.search(query, limit));
+}
+
+const Landmark* GameDatabase::findLandmark(const QString& id) const {
+    ensureTable(GameTable::Landmarks);
+    return findIndexed(m_landmarks, m_landmarkIndex, id);
 }
 
 std::optional<Landmark> GameDatabase::getLandmark(const QString& id) const {
-    for (const auto& lm : m_landmarks) {
-        if (lm.id == id) {
-            return lm;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findLandmark(id));
 }
 
 int GameDatabase::landmarkCount() const {
-    return static_cast<int>(m_landmarks.size());
+    return tableCount(GameTable::Landmarks);
 }
 
 // ============ GeoArea Loading & Lookups ============
@@ -1002,6 +1690,7 @@ bool GameDatabase::loadGeoAreas(const std::filesystem::path& path) {
 }
 
 std::vector<GeoArea> GameDatabase::getAllRegions() const {
+    ensureTable(GameTable::GeoAreas);
     std::vector<GeoArea> results;
     for (const auto& area : m_geoAreas) {
         if (area.type == GeoAreaType::Region) {
@@ -1012,26 +1701,21 @@ std::vector<GeoArea> GameDatabase::getAllRegions() const {
 }
 
 std::vector<GeoArea> GameDatabase::getTerritoriesForRegion(const QString& regionId) const {
-    std::vector<GeoArea> results;
-    for (const auto& area : m_geoAreas) {
-        if (area.type == GeoAreaType::Territory && area.parentId == regionId) {
-            results.push_back(area);
-        }
-    }
-    return results;
+    ensureTable(GameTable::GeoAreas);
+    return rowsAt(m_geoAreas, m_territoriesByRegion.value(regionId));
+}
+
+const GeoArea* GameDatabase::findGeoArea(const QString& id) const {
+    ensureTable(GameTable::GeoAreas);
+    return findIndexed(m_geoAreas, m_geoAreaIndex, id);
 }
 
 std::optional<GeoArea> GameDatabase::getGeoArea(const QString& id) const {
-    for (const auto& area : m_geoAreas) {
-        if (area.id == id) {
-            return area;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findGeoArea(id));
 }
 
 int GameDatabase::geoAreaCount() const {
-    return static_cast<int>(m_geoAreas.size());
+    return tableCount(GameTable::GeoAreas);
 }
 
 // ============ Crafting Loading & Lookups ============
@@ -1103,20 +1787,21 @@ bool GameDatabase::loadCrafting(const std::filesystem::path& path) {
 }
 
 std::vector<CraftingProfession> GameDatabase::getAllProfessions() const {
+    ensureTable(GameTable::Professions);
     return m_professions;
 }
 
+const CraftingProfession* GameDatabase::findProfession(const QString& key) const {
+    ensureTable(GameTable::Professions);
+    return findIndexed(m_professions, m_professionIndex, key.toCaseFolded());
+}
+
 std::optional<CraftingProfession> GameDatabase::getProfession(const QString& key) const {
-    for (const auto& prof : m_professions) {
-        if (prof.key.compare(key, Qt::CaseInsensitive) == 0) {
-            return prof;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findProfession(key));
 }
 
 int GameDatabase::professionCount() const {
-    return static_cast<int>(m_professions.size());
+    return tableCount(GameTable::Professions);
 }
 
 // ============ Virtue Loading & Lookups ============
@@ -1162,20 +1847,21 @@ bool GameDatabase::loadVirtues(const std::filesystem::path& path) {
 }
 
 std::vector<VirtueDef> GameDatabase::getAllVirtues() const {
+    ensureTable(GameTable::Virtues);
     return m_virtues;
 }
 
+const VirtueDef* GameDatabase::findVirtue(const QString& id) const {
+    ensureTable(GameTable::Virtues);
+    return findIndexed(m_virtues, m_virtueIndex, id);
+}
+
 std::optional<VirtueDef> GameDatabase::getVirtue(const QString& id) const {
-    for (const auto& v : m_virtues) {
-        if (v.id == id) {
-            return v;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findVirtue(id));
 }
 
 int GameDatabase::virtueCount() const {
-    return static_cast<int>(m_virtues.size());
+    return tableCount(GameTable::Virtues);
 }
 
 // ============ Class Loading & Lookups ============
@@ -1223,30 +1909,30 @@ bool GameDatabase::loadClasses(const std::filesystem::path& path) {
 }
 
 std::vector<GameClass> GameDatabase::getAllClasses() const {
+    ensureTable(GameTable::Classes);
     return m_classes;
 }
 
+const GameClass* GameDatabase::findGameClass(const QString& key) const {
+    ensureTable(GameTable::Classes);
+    return findIndexed(m_classes, m_classIndex, key.toCaseFolded());
+}
+
 std::optional<GameClass> GameDatabase::getGameClass(const QString& key) const {
-    for (const auto& c : m_classes) {
-        if (c.key.compare(key, Qt::CaseInsensitive) == 0 ||
-            c.name.compare(key, Qt::CaseInsensitive) == 0) {
-            return c;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findGameClass(key));
 }
 
 int GameDatabase::classCount() const {
-    return static_cast<int>(m_classes.size());
+    return tableCount(GameTable::Classes);
+}
+
+const GameClass* GameDatabase::findClassByCode(int code) const {
+    ensureTable(GameTable::Classes);
+    return findIndexed(m_classes, m_classCodeIndex, code);
 }
 
 std::optional<GameClass> GameDatabase::getClassByCode(int code) const {
-    for (const auto& c : m_classes) {
-        if (c.code == code) {
-            return c;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findClassByCode(code));
 }
 
 // ============ Race Loading & Lookups ============
@@ -1293,30 +1979,30 @@ bool GameDatabase::loadRaces(const std::filesystem::path& path) {
 }
 
 std::vector<Race> GameDatabase::getAllRaces() const {
+    ensureTable(GameTable::Races);
     return m_races;
 }
 
+const Race* GameDatabase::findRace(const QString& key) const {
+    ensureTable(GameTable::Races);
+    return findIndexed(m_races, m_raceIndex, key.toCaseFolded());
+}
+
 std::optional<Race> GameDatabase::getRace(const QString& key) const {
-    for (const auto& r : m_races) {
-        if (r.key.compare(key, Qt::CaseInsensitive) == 0 ||
-            r.name.compare(key, Qt::CaseInsensitive) == 0) {
-            return r;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findRace(key));
 }
 
 int GameDatabase::raceCount() const {
-    return static_cast<int>(m_races.size());
+    return tableCount(GameTable::Races);
+}
+
+const Race* GameDatabase::findRaceByCode(int code) const {
+    ensureTable(GameTable::Races);
+    return findIndexed(m_races, m_raceCodeIndex, code);
 }
 
 std::optional<Race> GameDatabase::getRaceByCode(int code) const {
-    for (const auto& r : m_races) {
-        if (r.code == code) {
-            return r;
-        }
-    }
-    return std::nullopt;
+    return copyOf(findRaceByCode(code));
 }
 
 } // namespace lotro
@@ -9,16 +9,28 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
 #include <QString>
 
+#include "RecipeGraph.hpp"
+#include "StringPool.hpp"
+#include "TextSearchIndex.hpp"
+
 namespace lotro {
 
+class GameDatabaseSnapshot;
+
 /**
  * Deed category
  */
@@ -254,53 +266,151 @@ struct Race {
     int iconId = 0;
 };
 
+/**
+ * Tables held by the game database, one per LOTRO Companion XML file
+ */
+enum class GameTable {
+    Deeds,
+    Recipes,
+    Titles,
+    Emotes,
+    Skills,
+    Traits,
+    Quests,
+    Collections,
+    Cosmetics,
+    Factions,
+    Landmarks,
+    GeoAreas,
+    Professions,
+    Virtues,
+    Classes,
+    Races,
+    Count
+};
+
 /**
  * Game database
  * 
  * Provides lookup for game data similar to LOTRO Companion.
- * Data is loaded from bundled JSON/XML files.
+ * Data is loaded from bundled JSON/XML files. The parsed tables are
+ * cached in a binary snapshot, which later starts load instead of the
+ * XML as long as no source file changed.
+ * 
+ * With a valid snapshot, each table is decoded on the first call to one
+ * of its accessors; the *Count() methods answer from the snapshot header
+ * without loading anything. Without one, all tables are parsed up front.
+ * Descriptions are views of the memory-mapped snapshot rather than heap
+ * copies, so they cost resident memory only while being read.
+ * 
+ * Given a game directory, deeds, titles, emotes and skills come from the
+ * installed DAT files instead (see GameDataExtractor), through a second
+ * snapshot that is rebuilt only after the game is patched. A table the
+ * DAT yields nothing for still comes from the XML.
+ * 
+ * The database is published in generations. A reload builds a complete
+ * new one off the GUI thread with create() and swaps it in with
+ * publish(), one atomic pointer store; readers are never locked out and
+ * never see a half-built table. A generation lives as long as anyone
+ * holds the pointer current() returns, and everything read from it
+ * borrows from it: record pointers, views, and the descriptions inside
+ * records returned by value. Hold that pointer for as long as any of
+ * them is used, and deep-copy a description that must outlive it.
  */
-class GameDatabase {
+class GameDatabase : public std::enable_shared_from_this<GameDatabase> {
 public:
     /**
-     * Get the singleton instance
+     * Pin the current generation
+     */
+    static std::shared_ptr<const GameDatabase> current();
+    
+    /**
+     * Build a new, unpublished generation from the data directory
+     * @param gamePath Installation to extract tables from; empty for the XML only
+     * @return nullptr if it failed to load
      */
-    static GameDatabase& instance();
+    static std::shared_ptr<GameDatabase> create(const std::filesystem::path& dataDir, const QString& gamePath);
+    
+    /**
+     * Make a generation current; the one it replaces is freed once its
+     * last holder lets go. Call on the GUI thread.
+     */
+    static void publish(std::shared_ptr<GameDatabase> generation);
     
     /**
      * Initialize the database from the data directory
      */
     bool initialize(const std::filesystem::path& dataDir);
     
+    /**
+     * Extract the tables GameDataExtractor covers from this installation;
+     * empty (the default) to use the XML only. Call before initialize().
+     */
+    void setGameDirectory(const QString& gamePath) { m_gameDirectory = gamePath; }
+    
     /**
      * Check if database is loaded
      */
     bool isLoaded() const { return m_loaded; }
     
+    /**
+     * Load tables in the background so their first lookup doesn't block
+     */
+    QFuture<void> preload(std::vector<GameTable> tables);
+    
+    /**
+     * Load tables on the calling thread (and the global pool), blocking
+     */
+    void loadTables(std::vector<GameTable> tables);
+    
+    /**
+     * Check if a table's records are in memory
+     */
+    bool isTableLoaded(GameTable table) const;
+    
+    /**
+     * Tables whose records are in memory, for a new generation to match
+     */
+    std::vector<GameTable> loadedTables() const;
+    
     // =================
     // Deed lookups
     // =================
+    // The search* methods use a full-text index: queries of three or more
+    // characters match anywhere in the indexed fields, shorter ones match
+    // word prefixes. Results are ranked (name matches first) and capped at
+    // limit when it is non-zero; an empty query returns every record.
     
-    std::vector<Deed> searchDeeds(const QString& query) const;
+    std::vector<Deed> searchDeeds(const QString& query, size_t limit = 0) const;
     std::vector<Deed> getDeedsByCategory(DeedCategory category) const;
     std::vector<Deed> getDeedsByRegion(const QString& region) const;
     std::optional<Deed> getDeed(const QString& id) const;
+    const Deed* findDeed(const QString& id) const;
     
     // =================
     // Recipe lookups
     // =================
     
-    std::vector<Recipe> searchRecipes(const QString& query) const;
+    std::vector<Recipe> searchRecipes(const QString& query, size_t limit = 0) const;
     std::vector<Recipe> getRecipesByProfession(const QString& profession) const;
     std::vector<Recipe> getRecipesForItem(const QString& outputItemId) const;
     std::optional<Recipe> getRecipe(const QString& id) const;
+    const Recipe* findRecipe(const QString& id) const;
+    
+    // Recipes using the given recipe's output as an ingredient
+    std::vector<Recipe> getRecipesConsuming(const QString& recipeId) const;
+    
+    // Full crafting tree down to raw materials, from the compiled recipe graph
+    BillOfMaterials getBillOfMaterials(const QString& itemId, int quantity = 1) const;
+    BillOfMaterials getRecipeBillOfMaterials(const QString& recipeId, int crafts = 1) const;
     
     // =================
     // Title lookups
     // =================
     
-    std::vector<Title> searchTitles(const QString& query) const;
+    std::vector<Title> searchTitles(const QString& query, size_t limit = 0) const;
     std::optional<Title> getTitle(const QString& id) const;
+    const Title* findTitle(const QString& id) const;
     
     // =================
     // Emote lookups
@@ -308,20 +418,23 @@ public:
     
     std::vector<Emote> getAllEmotes() const;
     std::optional<Emote> getEmote(const QString& id) const;
+    const Emote* findEmote(const QString& id) const;
     
     // =================
     // Skill lookups
     // =================
     
-    std::vector<Skill> searchSkills(const QString& query) const;
+    std::vector<Skill> searchSkills(const QString& query, size_t limit = 0) const;
     std::optional<Skill> getSkill(const QString& id) const;
+    const Skill* findSkill(const QString& id) const;
     
     // =================
     // Trait lookups
     // =================
     
-    std::vector<Trait> searchTraits(const QString& query) const;
+    std::vector<Trait> searchTraits(const QString& query, size_t limit = 0) const;
     std::optional<Trait> getTrait(const QString& id) const;
+    const Trait* findTrait(const QString& id) const;
     
     // =================
     // Faction lookups
@@ -330,13 +443,15 @@ public:
     std::vector<Faction> getAllFactions() const;
     std::vector<Faction> getFactionsByCategory(const QString& category) const;
     std::optional<Faction> getFaction(const QString& id) const;
+    const Faction* findFaction(const QString& id) const;
     
     // =================
     // Landmark lookups
     // =================
     
-    std::vector<Landmark> searchLandmarks(const QString& query) const;
+    std::vector<Landmark> searchLandmarks(const QString& query, size_t limit = 0) const;
     std::optional<Landmark> getLandmark(const QString& id) const;
+    const Landmark* findLandmark(const QString& id) const;
     
     // =================
     // GeoArea lookups
@@ -345,6 +460,7 @@ public:
     std::vector<GeoArea> getAllRegions() const;
     std::vector<GeoArea> getTerritoriesForRegion(const QString& regionId) const;
     std::optional<GeoArea> getGeoArea(const QString& id) const;
+    const GeoArea* findGeoArea(const QString& id) const;
     
     // =================
     // Crafting lookups
@@ -352,6 +468,7 @@ public:
     
     std::vector<CraftingProfession> getAllProfessions() const;
     std::optional<CraftingProfession> getProfession(const QString& key) const;
+    const CraftingProfession* findProfession(const QString& key) const;
     
     // =================
     // Virtue lookups
@@ -359,6 +476,7 @@ public:
     
     std::vector<VirtueDef> getAllVirtues() const;
     std::optional<VirtueDef> getVirtue(const QString& id) const;
+    const VirtueDef* findVirtue(const QString& id) const;
     
     // =================
     // Class/Race lookups
@@ -366,10 +484,59 @@ public:
     
     std::vector<GameClass> getAllClasses() const;
     std::optional<GameClass> getGameClass(const QString& key) const;
+    const GameClass* findGameClass(const QString& key) const;
     std::optional<GameClass> getClassByCode(int code) const;
+    const GameClass* findClassByCode(int code) const;
     std::vector<Race> getAllRaces() const;
     std::optional<Race> getRace(const QString& key) const;
+    const Race* findRace(const QString& key) const;
     std::optional<Race> getRaceByCode(int code) const;
+    const Race* findRaceByCode(int code) const;
+    
+    // =================
+    // Views
+    // =================
+    // Read-only access without copying. Records never change after their
+    // table loads, so spans and pointers stay valid for the lifetime of the
+    // generation; the find* lookups return nullptr when nothing matches.
+    
+    std::span<const Deed> deedsView() const;
+    
+    // Positions in deedsView() instead of copies; search order is by rank
+    std::vector<uint32_t> searchDeedPositions(const QString& query, size_t limit = 0) const;
+    std::span<const uint32_t> deedPositionsByCategory(DeedCategory category) const;
+    
+    std::span<const Recipe> recipesView() const;
+    
+    // Positions in recipesView(); refine narrows the uncapped results of
+    // an earlier search (see TextSearchIndex::narrows)
+    std::vector<uint32_t> searchRecipePositions(const QString& query, size_t limit = 0) const;
+    std::vector<uint32_t> refineRecipePositions(const QString& query, std::span<const uint32_t> previous) const;
+    std::span<const uint32_t> recipePositionsByProfession(const QString& profession) const;
+    
+    std::span<const Title> titlesView() const;
+    std::span<const Emote> emotesView() const;
+    std::span<const Skill> skillsView() const;
+    std::span<const Trait> traitsView() const;
+    std::span<const Quest> questsView() const;
+    std::span<const CollectionItem> collectionsView() const;
+    std::span<const Cosmetic> cosmeticsView() const;
+    std::span<const Faction> factionsView() const;
+    std::span<const Landmark> landmarksView() const;
+    std::span<const GeoArea> geoAreasView() const;
+    std::span<const CraftingProfession> professionsView() const;
+    std::span<const VirtueDef> virtuesView() const;
+    std::span<const GameClass> classesView() const;
+    std::span<const Race> racesView() const;
+    
+    // Position of a record in its table's view, or -1; for the tables
+    // with id lookups (Deeds, Recipes, Titles, Emotes, Skills, Traits)
+    qsizetype recordPosition(GameTable table, const QString& id) const;
+    
+    // Fingerprint of those tables' ids in view order, stable across runs:
+    // it changes exactly when positions might, so bitsets over positions
+    // can be kept and checked against it. Never 0 once the table loads.
+    uint64_t tableLayout(GameTable table) const;
     
     // =================
     // Statistics
@@ -393,11 +560,14 @@ public:
     int raceCount() const;
     
 private:
-    GameDatabase() = default;
-    ~GameDatabase() = default;
+    GameDatabase();
+    ~GameDatabase();
     GameDatabase(const GameDatabase&) = delete;
     GameDatabase& operator=(const GameDatabase&) = delete;
     
+    // Holds the current generation
+    static std::atomic<std::shared_ptr<GameDatabase>>& generation();
+    
     bool loadDeedsXml(const std::filesystem::path& path);
     bool loadRecipesXml(const std::filesystem::path& path);
     bool loadDeeds(const std::filesystem::path& path);
@@ -417,7 +587,48 @@ private:
     bool loadClasses(const std::filesystem::path& path);
     bool loadRaces(const std::filesystem::path& path);
     
+    // Load one table from its XML file; false only for a fatal load failure
+    bool loadTableXml(GameTable table, const std::filesystem::path& loreDir);
+    
+    // Load all tables concurrently, logging a per-table timing breakdown
+    bool loadTablesXml(const std::filesystem::path& loreDir);
+    
+    // Binary snapshot of all tables, keyed by the source files' size and mtime
+    bool openSnapshot(const QString& snapshotPath, const std::filesystem::path& loreDir);
+    bool decodeTable(GameTable table, const GameDatabaseSnapshot& snapshot);
+    bool saveSnapshot(const QString& snapshotPath, const std::filesystem::path& loreDir) const;
+    
+    // Point a table's descriptions at the snapshot's text section
+    bool attachTexts(GameTable table, const GameDatabaseSnapshot& snapshot);
+    
+    // Tables extracted from the DAT, re-extracted when the archives changed
+    bool openDatSnapshot();
+    bool fromDat(GameTable table) const;
+    
+    // Load a table on first use, from the snapshot or else its XML file
+    void ensureTable(GameTable table) const;
+    void loadTable(GameTable table);
+    
+    // Intern a table's repetitive strings and fill its pooled-id postings
+    void compactTable(GameTable table);
+    
+    // Rebuild a table's point-lookup indexes after it loads
+    void buildIndex(GameTable table);
+    
+    // Records held in memory / known to exist for a table
+    size_t loadedSize(GameTable table) const;
+    int tableCount(GameTable table) const;
+    
+    static constexpr size_t TABLE_COUNT = static_cast<size_t>(GameTable::Count);
+    
     bool m_loaded = false;
+    std::filesystem::path m_loreDir;
+    std::unique_ptr<GameDatabaseSnapshot> m_snapshot;
+    QString m_gameDirectory;
+    std::unique_ptr<GameDatabaseSnapshot> m_datSnapshot;
+    mutable std::array<QMutex, TABLE_COUNT> m_tableMutexes;
+    mutable std::array<std::atomic<bool>, TABLE_COUNT> m_tableLoaded{};
+    std::array<uint64_t, TABLE_COUNT> m_tableLayouts{};     // See tableLayout()
     
     std::vector<Deed> m_deeds;
     std::vector<Recipe> m_recipes;
@@ -435,6 +646,45 @@ private:
     std::vector<VirtueDef> m_virtues;
     std::vector<GameClass> m_classes;
     std::vector<Race> m_races;
+    
+    // Filter postings: sorted record positions per key, so a filter costs
+    // its result size. Deed regions and folded recipe professions are keyed
+    // by their id in the table's string pool.
+    static constexpr size_t DEED_CATEGORY_COUNT = static_cast<size_t>(DeedCategory::Unknown) + 1;
+    StringPool m_deedStrings;
+    std::array<std::vector<uint32_t>, DEED_CATEGORY_COUNT> m_deedsByCategory;
+    std::vector<std::vector<uint32_t>> m_deedsByRegion;
+    StringPool m_recipeStrings;
+    std::vector<std::vector<uint32_t>> m_recipesByProfession;
+    RecipeGraph m_recipeGraph;      // Also the recipes-by-output-item postings
+    QHash<QString, std::vector<uint32_t>> m_territoriesByRegion;   // Territories by parent region
+    QHash<QString, std::vector<uint32_t>> m_factionsByCategory;    // Case-folded category
+    
+    // Point-lookup indexes: record position by id, key or code.
+    // Case-insensitive keys are stored case-folded.
+    QHash<QString, qsizetype> m_deedIndex;
+    QHash<QString, qsizetype> m_recipeIndex;
+    QHash<QString, qsizetype> m_titleIndex;
+    QHash<QString, qsizetype> m_emoteIndex;
+    QHash<QString, qsizetype> m_skillIndex;
+    QHash<QString, qsizetype> m_traitIndex;
+    QHash<QString, qsizetype> m_factionIndex;
+    QHash<QString, qsizetype> m_landmarkIndex;
+    QHash<QString, qsizetype> m_geoAreaIndex;
+    QHash<QString, qsizetype> m_professionIndex;
+    QHash<QString, qsizetype> m_virtueIndex;
+    QHash<QString, qsizetype> m_classIndex;     // key or name
+    QHash<int, qsizetype> m_classCodeIndex;
+    QHash<QString, qsizetype> m_raceIndex;      // key or name
+    QHash<int, qsizetype> m_raceCodeIndex;
+    
+    // Full-text indexes behind the search* methods
+    TextSearchIndex m_deedSearch;
+    TextSearchIndex m_recipeSearch;
+    TextSearchIndex m_titleSearch;
+    TextSearchIndex m_skillSearch;
+    TextSearchIndex m_traitSearch;
+    TextSearchIndex m_landmarkSearch;
 };
 
 } // namespace lotro
@@ -0,0 +1,460 @@
+/**
+ * LOTRO Launcher - Game Database Snapshot Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "GameDatabaseSnapshot.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+
+namespace lotro {
+
+GameDatabaseSnapshot::~GameDatabaseSnapshot() {
+    close();
+}
+
+QString GameDatabaseSnapshot::pathFor(const std::filesystem::path& dataDir) {
+    QString absolute = QDir(QString::fromStdString(dataDir.string())).absolutePath();
+    auto cacheDir = Platform::getCachePath() / "game-database";
+    return QDir(QString::fromStdString(cacheDir.string())).filePath(
+        QString("gamedb-%1.snapshot").arg(qHash(absolute), 8, 16, QChar('0')));
+}
+
+std::vector<SnapshotSource> GameDatabaseSnapshot::stampSources(const std::filesystem::path& dir,
+                                                               const std::vector<QString>& fileNames) {
+    std::vector<SnapshotSource> sources;
+    sources.reserve(fileNames.size());
+    QDir base(QString::fromStdString(dir.string()));
+    for (const QString& name : fileNames) {
+        SnapshotSource source;
+        source.fileName = name;
+        QFileInfo info(base.filePath(name));
+        if (info.exists()) {
+            source.size = info.size();
+            source.modifiedMs = info.lastModified().toMSecsSinceEpoch();
+        }
+        sources.push_back(source);
+    }
+    return sources;
+}
+
+void GameDatabaseSnapshot::close() {
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_size = 0;
+    m_tables = {};
+}
+
+bool GameDatabaseSnapshot::open(const QString& path, const std::vector<SnapshotSource>& sources) {
+    close();
+    
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    
+    m_size = m_file.size();
+    m_map = m_file.map(0, m_size);
+    if (!m_map) {
+        close();
+        return false;
+    }
+    
+    QDataStream in(QByteArray::fromRawData(reinterpret_cast<const char*>(m_map), m_size));
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, tableCount = 0, sourceCount = 0;
+    in >> magic >> version >> tableCount >> sourceCount;
+    if (magic != MAGIC || version != FORMAT_VERSION || tableCount != TABLE_COUNT
+        || sourceCount != sources.size()) {
+        spdlog::info("Game database snapshot {} is from another format, rebuilding", path.toStdString());
+        close();
+        return false;
+    }
+    
+    for (const SnapshotSource& expected : sources) {
+        SnapshotSource stored;
+        in >> stored.fileName >> stored.size >> stored.modifiedMs;
+        if (!(stored == expected)) {
+            spdlog::info("Game database snapshot is stale ({} changed)", expected.fileName.toStdString());
+            close();
+            return false;
+        }
+    }
+    
+    auto inFile = [this](quint64 offset, quint64 size) {
+        return offset <= static_cast<quint64>(m_size) && size <= static_cast<quint64>(m_size) - offset;
+    };
+    for (TableEntry& entry : m_tables) {
+        quint64 offset = 0, size = 0, textOffset = 0, textSize = 0;
+        qint32 count = 0;
+        in >> offset >> size >> count >> textOffset >> textSize;
+        if (!inFile(offset, size) || !inFile(textOffset, textSize) || textOffset % 2 != 0) {
+            in.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+        entry = {offset, size, count, textOffset, textSize};
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Game database snapshot {} is corrupt", path.toStdString());
+        close();
+        return false;
+    }
+    return true;
+}
+
+QByteArray GameDatabaseSnapshot::table(GameTable table) const {
+    if (!m_map) {
+        return QByteArray();
+    }
+    const TableEntry& entry = m_tables[static_cast<size_t>(table)];
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(m_map + entry.offset),
+                                   static_cast<qsizetype>(entry.size));
+}
+
+std::vector<QString> GameDatabaseSnapshot::texts(GameTable table) const {
+    std::vector<QString> result;
+    if (!m_map) {
+        return result;
+    }
+    const TableEntry& entry = m_tables[static_cast<size_t>(table)];
+    if (entry.textSize < 4) {
+        return result;
+    }
+    
+    const uchar* base = m_map + entry.textOffset;
+    quint32 count = qFromLittleEndian<quint32>(base);
+    quint64 refsEnd = 4 + static_cast<quint64>(count) * 8;
+    if (refsEnd > entry.textSize) {
+        return result;
+    }
+    
+    // The character data follows the refs, which keeps it 2-byte aligned
+    const char16_t* chars = reinterpret_cast<const char16_t*>(base + refsEnd);
+    quint64 charCount = (entry.textSize - refsEnd) / 2;
+    result.reserve(count);
+    for (quint32 i = 0; i < count; ++i) {
+        quint32 start = qFromLittleEndian<quint32>(base + 4 + i * 8);
+        quint32 length = qFromLittleEndian<quint32>(base + 8 + i * 8);
+        if (static_cast<quint64>(start) + length > charCount) {
+            return {};
+        }
+        result.push_back(length ? QString::fromRawData(reinterpret_cast<const QChar*>(chars + start), length)
+                                : QString());
+    }
+    return result;
+}
+
+QByteArray GameDatabaseSnapshot::encodeTexts(const std::vector<QString>& texts) {
+    qsizetype charCount = 0;
+    for (const QString& text : texts) {
+        charCount += text.size();
+    }
+    
+    QByteArray blob(4 + static_cast<qsizetype>(texts.size()) * 8 + charCount * 2, Qt::Uninitialized);
+    uchar* out = reinterpret_cast<uchar*>(blob.data());
+    qToLittleEndian<quint32>(static_cast<quint32>(texts.size()), out);
+    
+    // Stored in native UTF-16 so the strings can view the mapping directly;
+    // the snapshot is a local cache and never moves between machines
+    char16_t* chars = reinterpret_cast<char16_t*>(out + 4 + texts.size() * 8);
+    quint32 start = 0;
+    for (size_t i = 0; i < texts.size(); ++i) {
+        const QString& text = texts[i];
+        qToLittleEndian<quint32>(start, out + 4 + i * 8);
+        qToLittleEndian<quint32>(static_cast<quint32>(text.size()), out + 8 + i * 8);
+        std::memcpy(chars + start, text.utf16(), static_cast<size_t>(text.size()) * 2);
+        start += static_cast<quint32>(text.size());
+    }
+    return blob;
+}
+
+int GameDatabaseSnapshot::recordCount(GameTable table) const {
+    return m_map ? m_tables[static_cast<size_t>(table)].count : 0;
+}
+
+bool GameDatabaseSnapshot::write(const QString& path, const std::vector<SnapshotSource>& sources,
+                                 const std::array<QByteArray, TABLE_COUNT>& tables,
+                                 const std::array<int, TABLE_COUNT>& counts,
+                                 const std::array<QByteArray, TABLE_COUNT>& texts) {
+    // Header and directory first, so table offsets are known up front
+    QByteArray head;
+    {
+        QDataStream out(&head, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << MAGIC << FORMAT_VERSION << static_cast<quint32>(TABLE_COUNT)
+            << static_cast<quint32>(sources.size());
+        for (const SnapshotSource& source : sources) {
+            out << source.fileName << source.size << source.modifiedMs;
+        }
+    }
+    
+    // Each directory entry is quint64 + quint64 + qint32 + quint64 + quint64.
+    // Blobs are padded to 8 bytes so text sections stay aligned for UTF-16.
+    constexpr qsizetype entrySize = 8 + 8 + 4 + 8 + 8;
+    auto padded = [](quint64 size) { return (size + 7) & ~quint64(7); };
+    quint64 offset = padded(static_cast<quint64>(head.size() + entrySize * static_cast<qsizetype>(TABLE_COUNT)));
+    {
+        QDataStream out(&head, QIODevice::Append);
+        out.setVersion(QDataStream::Qt_6_0);
+        for (size_t i = 0; i < TABLE_COUNT; ++i) {
+            quint64 textOffset = offset + padded(static_cast<quint64>(tables[i].size()));
+            out << offset << static_cast<quint64>(tables[i].size()) << static_cast<qint32>(counts[i])
+                << textOffset << static_cast<quint64>(texts[i].size());
+            offset = textOffset + padded(static_cast<quint64>(texts[i].size()));
+        }
+    }
+    head.append(QByteArray(static_cast<qsizetype>(padded(head.size()) - head.size()), '\0'));
+    
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write game database snapshot {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    
+    auto writePadded = [&file, &padded](const QByteArray& blob) {
+        file.write(blob);
+        file.write(QByteArray(static_cast<qsizetype>(padded(blob.size()) - blob.size()), '\0'));
+    };
+    file.write(head);
+    for (size_t i = 0; i < TABLE_COUNT; ++i) {
+        writePadded(tables[i]);
+        writePadded(texts[i]);
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit game database snapshot {}", path.toStdString());
+        return false;
+    }
+    
+    spdlog::info("Wrote game database snapshot {} ({} KB)", path.toStdString(), offset / 1024);
+    return true;
+}
+
+// ============ Record Serialization ============
+// Descriptions are not part of the records; they live in the table's
+// text section (see GameDatabaseSnapshot::texts)
+
+QDataStream& operator<<(QDataStream& out, const Deed& v) {
+    return out << v.id << v.name << static_cast<qint32>(v.category) << v.region
+               << v.level << v.virtueXP << v.lotroPoints << v.titleReward << v.traitReward;
+}
+
+QDataStream& operator>>(QDataStream& in, Deed& v) {
+    qint32 category = 0;
+    in >> v.id >> v.name >> category >> v.region
+       >> v.level >> v.virtueXP >> v.lotroPoints >> v.titleReward >> v.traitReward;
+    v.category = static_cast<DeedCategory>(category);
+    return in;
+}
+
+QDataStream& operator<<(QDataStream& out, const Recipe::Ingredient& v) {
+    return out << v.itemId << v.name << v.quantity;
+}
+
+QDataStream& operator>>(QDataStream& in, Recipe::Ingredient& v) {
+    return in >> v.itemId >> v.name >> v.quantity;
+}
+
+QDataStream& operator<<(QDataStream& out, const Recipe& v) {
+    out << v.id << v.name << v.profession << v.tier << v.category
+        << static_cast<quint32>(v.ingredients.size());
+    for (const auto& ingredient : v.ingredients) {
+        out << ingredient;
+    }
+    return out << v.outputItemId << v.outputItemName << v.outputQuantity;
+}
+
+QDataStream& operator>>(QDataStream& in, Recipe& v) {
+    quint32 count = 0;
+    in >> v.id >> v.name >> v.profession >> v.tier >> v.category >> count;
+    if (in.status() != QDataStream::Ok || count > 4096) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return in;
+    }
+    v.ingredients.resize(count);
+    for (auto& ingredient : v.ingredients) {
+        in >> ingredient;
+    }
+    return in >> v.outputItemId >> v.outputItemName >> v.outputQuantity;
+}
+
+QDataStream& operator<<(QDataStream& out, const Title& v) {
+    return out << v.id << v.name << v.source;
+}
+
+QDataStream& operator>>(QDataStream& in, Title& v) {
+    return in >> v.id >> v.name >> v.source;
+}
+
+QDataStream& operator<<(QDataStream& out, const Emote& v) {
+    return out << v.id << v.name << v.command << v.source;
+}
+
+QDataStream& operator>>(QDataStream& in, Emote& v) {
+    return in >> v.id >> v.name >> v.command >> v.source;
+}
+
+QDataStream& operator<<(QDataStream& out, const Skill& v) {
+    return out << v.id << v.name << v.category << v.iconId;
+}
+
+QDataStream& operator>>(QDataStream& in, Skill& v) {
+    return in >> v.id >> v.name >> v.category >> v.iconId;
+}
+
+QDataStream& operator<<(QDataStream& out, const Trait& v) {
+    return out << v.id << v.name << v.category << v.iconId << v.minLevel << v.cosmetic;
+}
+
+QDataStream& operator>>(QDataStream& in, Trait& v) {
+    return in >> v.id >> v.name >> v.category >> v.iconId >> v.minLevel >> v.cosmetic;
+}
+
+QDataStream& operator<<(QDataStream& out, const Quest& v) {
+    return out << v.id << v.name << v.category << v.level << v.questArc;
+}
+
+QDataStream& operator>>(QDataStream& in, Quest& v) {
+    return in >> v.id >> v.name >> v.category >> v.level >> v.questArc;
+}
+
+QDataStream& operator<<(QDataStream& out, const CollectionItem& v) {
+    return out << v.id << v.name << v.collectionName << v.category;
+}
+
+QDataStream& operator>>(QDataStream& in, CollectionItem& v) {
+    return in >> v.id >> v.name >> v.collectionName >> v.category;
+}
+
+QDataStream& operator<<(QDataStream& out, const Cosmetic& v) {
+    return out << v.id << v.name << v.category << v.iconId;
+}
+
+QDataStream& operator>>(QDataStream& in, Cosmetic& v) {
+    return in >> v.id >> v.name >> v.category >> v.iconId;
+}
+
+QDataStream& operator<<(QDataStream& out, const FactionTier& v) {
+    return out << v.tier << v.key << v.requiredReputation << v.lotroPoints << v.deedKey;
+}
+
+QDataStream& operator>>(QDataStream& in, FactionTier& v) {
+    return in >> v.tier >> v.key >> v.requiredReputation >> v.lotroPoints >> v.deedKey;
+}
+
+QDataStream& operator<<(QDataStream& out, const Faction& v) {
+    out << v.id << v.key << v.name << v.category << v.lowestTier << v.initialTier << v.highestTier
+        << v.currentTierProperty << v.currentReputationProperty << static_cast<quint32>(v.tiers.size());
+    for (const auto& tier : v.tiers) {
+        out << tier;
+    }
+    return out;
+}
+
+QDataStream& operator>>(QDataStream& in, Faction& v) {
+    quint32 count = 0;
+    in >> v.id >> v.key >> v.name >> v.category >> v.lowestTier >> v.initialTier >> v.highestTier
+       >> v.currentTierProperty >> v.currentReputationProperty >> count;
+    if (in.status() != QDataStream::Ok || count > 256) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return in;
+    }
+    v.tiers.resize(count);
+    for (auto& tier : v.tiers) {
+        in >> tier;
+    }
+    return in;
+}
+
+QDataStream& operator<<(QDataStream& out, const Landmark& v) {
+    return out << v.id << v.name;
+}
+
+QDataStream& operator>>(QDataStream& in, Landmark& v) {
+    return in >> v.id >> v.name;
+}
+
+QDataStream& operator<<(QDataStream& out, const GeoArea& v) {
+    return out << v.id << v.name << static_cast<qint32>(v.type) << v.parentId;
+}
+
+QDataStream& operator>>(QDataStream& in, GeoArea& v) {
+    qint32 type = 0;
+    in >> v.id >> v.name >> type >> v.parentId;
+    v.type = static_cast<GeoAreaType>(type);
+    return in;
+}
+
+QDataStream& operator<<(QDataStream& out, const CraftingTier& v) {
+    return out << v.identifier << v.name << v.proficiencyXp << v.masteryXp;
+}
+
+QDataStream& operator>>(QDataStream& in, CraftingTier& v) {
+    return in >> v.identifier >> v.name >> v.proficiencyXp >> v.masteryXp;
+}
+
+QDataStream& operator<<(QDataStream& out, const CraftingProfession& v) {
+    out << v.identifier << v.key << v.name << static_cast<quint32>(v.tiers.size());
+    for (const auto& tier : v.tiers) {
+        out << tier;
+    }
+    return out;
+}
+
+QDataStream& operator>>(QDataStream& in, CraftingProfession& v) {
+    quint32 count = 0;
+    in >> v.identifier >> v.key >> v.name >> count;
+    if (in.status() != QDataStream::Ok || count > 256) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return in;
+    }
+    v.tiers.resize(count);
+    for (auto& tier : v.tiers) {
+        in >> tier;
+    }
+    return in;
+}
+
+QDataStream& operator<<(QDataStream& out, const VirtueDef& v) {
+    return out << v.id << v.key << v.name << v.maxRank;
+}
+
+QDataStream& operator>>(QDataStream& in, VirtueDef& v) {
+    return in >> v.id >> v.key >> v.name >> v.maxRank;
+}
+
+QDataStream& operator<<(QDataStream& out, const GameClass& v) {
+    return out << v.id << v.code << v.key << v.name << v.abbreviation << v.iconId;
+}
+
+QDataStream& operator>>(QDataStream& in, GameClass& v) {
+    return in >> v.id >> v.code >> v.key >> v.name >> v.abbreviation >> v.iconId;
+}
+
+QDataStream& operator<<(QDataStream& out, const Race& v) {
+    return out << v.id << v.code << v.key << v.name << v.iconId;
+}
+
+QDataStream& operator>>(QDataStream& in, Race& v) {
+    return in >> v.id >> v.code >> v.key >> v.name >> v.iconId;
+}
+
+} // namespace lotro
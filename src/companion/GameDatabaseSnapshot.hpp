@@ -0,0 +1,218 @@
+/**
+ * LOTRO Launcher - Game Database Snapshot
+ * 
+ * Binary cache of the parsed GameDatabase tables, so later starts
+ * don't have to parse the LOTRO Companion XML files again.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "GameDatabase.hpp"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QString>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Size and modification time of one source XML file
+ */
+struct SnapshotSource {
+    QString fileName;
+    qint64 size = -1;       // -1 if the file does not exist
+    qint64 modifiedMs = 0;
+    
+    bool operator==(const SnapshotSource&) const = default;
+};
+
+/**
+ * Memory-mapped snapshot of the GameDatabase tables
+ * 
+ * File layout: a fixed header, the source file stamps the snapshot was
+ * built from, a directory of (offset, size, record count, text offset,
+ * text size) per table, then per table a QDataStream-encoded record blob
+ * and a text section. A snapshot is rejected if any source file's size or
+ * mtime changed. Tables can be decoded one at a time straight from the
+ * mapping.
+ * 
+ * Long text fields (descriptions) are kept out of the records, in the
+ * text section as raw UTF-16. texts() returns strings that view the
+ * mapping, so descriptions stay in the page cache instead of the heap
+ * and are only paged in when read.
+ */
+class GameDatabaseSnapshot {
+public:
+    static constexpr size_t TABLE_COUNT = static_cast<size_t>(GameTable::Count);
+    
+    GameDatabaseSnapshot() = default;
+    ~GameDatabaseSnapshot();
+    
+    GameDatabaseSnapshot(const GameDatabaseSnapshot&) = delete;
+    GameDatabaseSnapshot& operator=(const GameDatabaseSnapshot&) = delete;
+    
+    /**
+     * Snapshot path for a data directory (inside the launcher cache)
+     */
+    static QString pathFor(const std::filesystem::path& dataDir);
+    
+    /**
+     * Stat the given source files in a directory
+     */
+    static std::vector<SnapshotSource> stampSources(const std::filesystem::path& dir,
+                                                    const std::vector<QString>& fileNames);
+    
+    /**
+     * Map a snapshot and check it against the current source files
+     * @return true if the snapshot is usable
+     */
+    bool open(const QString& path, const std::vector<SnapshotSource>& sources);
+    
+    /**
+     * Unmap the snapshot; table() views become invalid
+     */
+    void close();
+    
+    bool isOpen() const { return m_map != nullptr; }
+    
+    /**
+     * Encoded bytes of one table, viewing the mapping (no copy)
+     */
+    QByteArray table(GameTable table) const;
+    
+    /**
+     * Long text of each record of a table, viewing the mapping (no copy)
+     * 
+     * The strings are only valid while the snapshot stays open.
+     * @return One string per record, or empty if the section is missing or corrupt
+     */
+    std::vector<QString> texts(GameTable table) const;
+    
+    /**
+     * Encode one string per record into a text section
+     */
+    static QByteArray encodeTexts(const std::vector<QString>& texts);
+    
+    /**
+     * Number of records in a table, from the directory alone
+     */
+    int recordCount(GameTable table) const;
+    
+    /**
+     * Write a snapshot atomically
+     * @param tables Encoded table blobs, indexed by GameTable
+     * @param counts Record count per table
+     * @param texts Text sections (see encodeTexts), indexed by GameTable
+     */
+    static bool write(const QString& path, const std::vector<SnapshotSource>& sources,
+                      const std::array<QByteArray, TABLE_COUNT>& tables,
+                      const std::array<int, TABLE_COUNT>& counts,
+                      const std::array<QByteArray, TABLE_COUNT>& texts);
+    
+private:
+    struct TableEntry {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        int32_t count = 0;
+        uint64_t textOffset = 0;
+        uint64_t textSize = 0;
+    };
+    
+    QFile m_file;
+    uchar* m_map = nullptr;
+    qint64 m_size = 0;
+    std::array<TableEntry, TABLE_COUNT> m_tables{};
+    
+    static constexpr quint32 MAGIC = 0x4244474C; // "LGDB"
+    static constexpr quint32 FORMAT_VERSION = 2;
+};
+
+// Record serialization used by the snapshot tables
+QDataStream& operator<<(QDataStream& out, const Deed& v);
+QDataStream& operator>>(QDataStream& in, Deed& v);
+QDataStream& operator<<(QDataStream& out, const Recipe::Ingredient& v);
+QDataStream& operator>>(QDataStream& in, Recipe::Ingredient& v);
+QDataStream& operator<<(QDataStream& out, const Recipe& v);
+QDataStream& operator>>(QDataStream& in, Recipe& v);
+QDataStream& operator<<(QDataStream& out, const Title& v);
+QDataStream& operator>>(QDataStream& in, Title& v);
+QDataStream& operator<<(QDataStream& out, const Emote& v);
+QDataStream& operator>>(QDataStream& in, Emote& v);
+QDataStream& operator<<(QDataStream& out, const Skill& v);
+QDataStream& operator>>(QDataStream& in, Skill& v);
+QDataStream& operator<<(QDataStream& out, const Trait& v);
+QDataStream& operator>>(QDataStream& in, Trait& v);
+QDataStream& operator<<(QDataStream& out, const Quest& v);
+QDataStream& operator>>(QDataStream& in, Quest& v);
+QDataStream& operator<<(QDataStream& out, const CollectionItem& v);
+QDataStream& operator>>(QDataStream& in, CollectionItem& v);
+QDataStream& operator<<(QDataStream& out, const Cosmetic& v);
+QDataStream& operator>>(QDataStream& in, Cosmetic& v);
+QDataStream& operator<<(QDataStream& out, const FactionTier& v);
+QDataStream& operator>>(QDataStream& in, FactionTier& v);
+QDataStream& operator<<(QDataStream& out, const Faction& v);
+QDataStream& operator>>(QDataStream& in, Faction& v);
+QDataStream& operator<<(QDataStream& out, const Landmark& v);
+QDataStream& operator>>(QDataStream& in, Landmark& v);
+QDataStream& operator<<(QDataStream& out, const GeoArea& v);
+QDataStream& operator>>(QDataStream& in, GeoArea& v);
+QDataStream& operator<<(QDataStream& out, const CraftingTier& v);
+QDataStream& operator>>(QDataStream& in, CraftingTier& v);
+QDataStream& operator<<(QDataStream& out, const CraftingProfession& v);
+QDataStream& operator>>(QDataStream& in, CraftingProfession& v);
+QDataStream& operator<<(QDataStream& out, const VirtueDef& v);
+QDataStream& operator>>(QDataStream& in, VirtueDef& v);
+QDataStream& operator<<(QDataStream& out, const GameClass& v);
+QDataStream& operator>>(QDataStream& in, GameClass& v);
+QDataStream& operator<<(QDataStream& out, const Race& v);
+QDataStream& operator>>(QDataStream& in, Race& v);
+
+/**
+ * Encode a table's records into a snapshot blob
+ */
+template<typename T>
+QByteArray encodeSnapshotTable(const std::vector<T>& rows) {
+    QByteArray blob;
+    QDataStream out(&blob, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << static_cast<quint32>(rows.size());
+    for (const T& row : rows) {
+        out << row;
+    }
+    return blob;
+}
+
+/**
+ * Decode a snapshot blob into records
+ * @return false (and rows left empty) if the blob is truncated or corrupt
+ */
+template<typename T>
+bool decodeSnapshotTable(const QByteArray& blob, std::vector<T>& rows) {
+    QDataStream in(blob);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 count = 0;
+    in >> count;
+    if (in.status() != QDataStream::Ok || count > static_cast<quint32>(blob.size())) {
+        return false;
+    }
+    rows.clear();
+    rows.resize(count);
+    for (T& row : rows) {
+        in >> row;
+    }
+    if (in.status() != QDataStream::Ok) {
+        rows.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace lotro
@@ -0,0 +1,397 @@
+/**
+ * LOTRO Launcher - Gear Optimizer Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "GearOptimizer.hpp"
+
+#include <QHash>
+#include <QMutexLocker>
+#include <QtConcurrent>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace lotro {
+
+namespace {
+
+// Weighted sum without caps, used to rank candidates within a slot
+double linearScore(const OptimizerRequest& request, const StatVector& stats) {
+    double total = 0.0;
+    for (size_t i = 0; i < StatVector::STAT_COUNT; ++i) {
+        total += request.weights[i] * stats.values[i];
+    }
+    return total;
+}
+
+const std::vector<EquipSlot>& allSlots() {
+    static const std::vector<EquipSlot> slots = {
+        EquipSlot::Head, EquipSlot::Shoulders, EquipSlot::Chest,
+        EquipSlot::Hands, EquipSlot::Legs, EquipSlot::Feet,
+        EquipSlot::Back, EquipSlot::MainHand, EquipSlot::OffHand,
+        EquipSlot::Ranged, EquipSlot::Necklace, EquipSlot::Earring,
+        EquipSlot::Bracelet, EquipSlot::Ring, EquipSlot::Pocket,
+        EquipSlot::ClassSlot
+    };
+    return slots;
+}
+
+} // anonymous namespace
+
+GearOptimizer::GearOptimizer(OptimizerRequest request)
+    : m_request(std::move(request))
+{
+    if (m_request.topN == 0) {
+        m_request.topN = 1;
+    }
+}
+
+double GearOptimizer::score(const StatVector& totals) const {
+    double total = 0.0;
+    for (size_t i = 0; i < StatVector::STAT_COUNT; ++i) {
+        double weight = m_request.weights[i];
+        int value = totals.values[i];
+        if (weight > 0.0 && m_request.caps[i] > 0) {
+            value = std::min(value, m_request.caps[i]);
+        }
+        total += weight * value;
+    }
+    return total;
+}
+
+std::vector<OptimizedBuild> GearOptimizer::run(ProgressCallback callback) {
+    m_cancelled = false;
+    m_callback = std::move(callback);
+    m_best.clear();
+    m_threshold = -std::numeric_limits<double>::infinity();
+    m_bestFull = false;
+    m_bestChanged = false;
+    m_evaluated = 0;
+    m_pruned = 0;
+    m_branchesDone = 0;
+    m_lastReportMs = 0;
+    m_clock.start();
+    
+    gatherCandidates();
+    if (m_slots.empty()) {
+        spdlog::info("Gear optimizer: no candidate items for {} at level {}",
+                     m_request.characterClass.toStdString(), m_request.level);
+        m_callback = nullptr;
+        return {};
+    }
+    computeBounds();
+    
+    // The first slot's candidates are the parallel work items
+    std::vector<uint32_t> branches(m_slots.front().items.size());
+    std::iota(branches.begin(), branches.end(), 0u);
+    
+    QtConcurrent::blockingMap(branches, [this](uint32_t branch) {
+        if (m_cancelled) {
+            return;
+        }
+        
+        Walk walk;
+        walk.partial = m_request.baseStats;
+        walk.picks.assign(m_slots.size(), 0);
+        walk.setCounts.assign(m_sets.size(), 0);
+        
+        const Candidate& candidate = m_slots.front().items[branch];
+        walk.picks[0] = branch;
+        walk.partial += candidate.stats;
+        if (candidate.setIndex >= 0) {
+            ++walk.setCounts[candidate.setIndex];
+        }
+        search(1, walk);
+        
+        ++m_branchesDone;
+        flush(walk);
+    });
+    
+    if (m_callback) {
+        m_callback(progress());
+    }
+    m_callback = nullptr;
+    
+    spdlog::info("Gear optimizer {} in {} ms: {} builds evaluated, {} branches pruned",
+                 m_cancelled ? "cancelled" : "finished", m_clock.elapsed(),
+                 m_evaluated.load(), m_pruned.load());
+    
+    QMutexLocker locker(&m_bestMutex);
+    std::vector<OptimizedBuild> results;
+    results.reserve(m_best.size());
+    for (const Entry& entry : m_best) {
+        results.push_back(materialize(entry));
+    }
+    return results;
+}
+
+void GearOptimizer::gatherCandidates() {
+    m_slots.clear();
+    m_sets.clear();
+    
+    const std::vector<EquipSlot>& wanted = m_request.slots.empty() ? allSlots() : m_request.slots;
+    
+    auto itemDb = ItemDatabase::current();
+    std::vector<GearItem> items = itemDb->getItemsForClass(m_request.characterClass);
+    
+    std::vector<SlotCandidates> slots;
+    for (EquipSlot slot : wanted) {
+        if (slot != EquipSlot::Unknown
+            && std::none_of(slots.begin(), slots.end(),
+                            [slot](const SlotCandidates& s) { return s.slot == slot; })) {
+            slots.push_back({slot, {}});
+        }
+    }
+    
+    for (GearItem& item : items) {
+        if (item.requiredLevel > m_request.level) {
+            continue;
+        }
+        auto it = std::find_if(slots.begin(), slots.end(),
+                               [&item](const SlotCandidates& s) { return s.slot == item.slot; });
+        if (it == slots.end()) {
+            continue;
+        }
+        Candidate candidate;
+        candidate.stats = StatVector::fromStats(item.stats);
+        candidate.item = std::move(item);
+        it->items.push_back(std::move(candidate));
+    }
+    
+    // Best candidates first so good builds are found early and prune hard
+    for (SlotCandidates& slot : slots) {
+        std::stable_sort(slot.items.begin(), slot.items.end(),
+                         [this](const Candidate& a, const Candidate& b) {
+            return linearScore(m_request, a.stats) > linearScore(m_request, b.stats);
+        });
+        if (m_request.candidatesPerSlot > 0 && slot.items.size() > m_request.candidatesPerSlot) {
+            slot.items.resize(m_request.candidatesPerSlot);
+        }
+    }
+    std::erase_if(slots, [](const SlotCandidates& s) { return s.items.empty(); });
+    
+    // Widest slot at the top of the tree: it is split over the thread pool
+    std::stable_sort(slots.begin(), slots.end(), [](const SlotCandidates& a, const SlotCandidates& b) {
+        return a.items.size() > b.items.size();
+    });
+    
+    // Resolve the sets the candidates belong to
+    QHash<QString, int> setIndexes;
+    for (SlotCandidates& slot : slots) {
+        for (Candidate& candidate : slot.items) {
+            const QString& setName = candidate.item.setName;
+            if (setName.isEmpty()) {
+                continue;
+            }
+            auto it = setIndexes.constFind(setName);
+            if (it != setIndexes.constEnd()) {
+                candidate.setIndex = it.value();
+                continue;
+            }
+            auto bonuses = itemDb->getSetBonuses(setName);
+            if (bonuses.empty()) {
+                setIndexes.insert(setName, -1);
+                continue;
+            }
+            std::vector<SetTier> tiers;
+            for (const auto& bonus : bonuses) {
+                tiers.push_back({bonus.piecesRequired, StatVector::fromStats(bonus.bonusStats)});
+            }
+            candidate.setIndex = static_cast<int>(m_sets.size());
+            setIndexes.insert(setName, candidate.setIndex);
+            m_sets.push_back(std::move(tiers));
+        }
+    }
+    
+    m_slots = std::move(slots);
+    
+    size_t total = 0;
+    for (const SlotCandidates& slot : m_slots) {
+        total += slot.items.size();
+    }
+    spdlog::debug("Gear optimizer: {} slots, {} candidates, {} sets",
+                  m_slots.size(), total, m_sets.size());
+}
+
+void GearOptimizer::computeBounds() {
+    // Set bonuses could kick in at any depth, so their extremes are added
+    // to every level's range
+    StatVector setMax;
+    StatVector setMin;
+    for (const auto& tiers : m_sets) {
+        for (const SetTier& tier : tiers) {
+            for (size_t i = 0; i < StatVector::LANES; ++i) {
+                setMax.values[i] += std::max(tier.stats.values[i], 0);
+                setMin.values[i] += std::min(tier.stats.values[i], 0);
+            }
+        }
+    }
+    
+    m_remainingMax.assign(m_slots.size() + 1, setMax);
+    m_remainingMin.assign(m_slots.size() + 1, setMin);
+    for (size_t depth = m_slots.size(); depth-- > 0;) {
+        StatVector slotMax;
+        StatVector slotMin;
+        slotMax.values.fill(std::numeric_limits<int32_t>::min());
+        slotMin.values.fill(std::numeric_limits<int32_t>::max());
+        for (const Candidate& candidate : m_slots[depth].items) {
+            for (size_t i = 0; i < StatVector::LANES; ++i) {
+                slotMax.values[i] = std::max(slotMax.values[i], candidate.stats.values[i]);
+                slotMin.values[i] = std::min(slotMin.values[i], candidate.stats.values[i]);
+            }
+        }
+        m_remainingMax[depth] = m_remainingMax[depth + 1];
+        m_remainingMax[depth] += slotMax;
+        m_remainingMin[depth] = m_remainingMin[depth + 1];
+        m_remainingMin[depth] += slotMin;
+    }
+}
+
+double GearOptimizer::upperBound(size_t depth, const StatVector& partial) const {
+    const StatVector& gainMax = m_remainingMax[depth];
+    const StatVector& gainMin = m_remainingMin[depth];
+    double bound = 0.0;
+    for (size_t i = 0; i < StatVector::STAT_COUNT; ++i) {
+        double weight = m_request.weights[i];
+        if (weight > 0.0) {
+            int high = partial.values[i] + gainMax.values[i];
+            if (m_request.caps[i] > 0) {
+                high = std::min(high, m_request.caps[i]);
+            }
+            bound += weight * high;
+        } else if (weight < 0.0) {
+            bound += weight * (partial.values[i] + gainMin.values[i]);
+        }
+    }
+    return bound;
+}
+
+StatVector GearOptimizer::setBonusTotals(const std::vector<int>& setCounts) const {
+    StatVector totals;
+    for (size_t set = 0; set < m_sets.size(); ++set) {
+        if (setCounts[set] == 0) {
+            continue;
+        }
+        for (const SetTier& tier : m_sets[set]) {
+            if (setCounts[set] >= tier.piecesRequired) {
+                totals += tier.stats;
+            }
+        }
+    }
+    return totals;
+}
+
+void GearOptimizer::search(size_t depth, Walk& walk) {
+    if (depth == m_slots.size()) {
+        StatVector totals = walk.partial;
+        totals += setBonusTotals(walk.setCounts);
+        double buildScore = score(totals);
+        if (!m_bestFull || buildScore > m_threshold) {
+            offer(buildScore, walk.picks);
+        }
+        if (++walk.evaluated % FLUSH_EVERY == 0) {
+            flush(walk);
+        }
+        return;
+    }
+    
+    const std::vector<Candidate>& candidates = m_slots[depth].items;
+    for (uint32_t i = 0; i < candidates.size() && !m_cancelled; ++i) {
+        const Candidate& candidate = candidates[i];
+        walk.partial += candidate.stats;
+        if (candidate.setIndex >= 0) {
+            ++walk.setCounts[candidate.setIndex];
+        }
+        
+        if (m_bestFull && upperBound(depth + 1, walk.partial) <= m_threshold) {
+            ++walk.pruned;
+        } else {
+            walk.picks[depth] = i;
+            search(depth + 1, walk);
+        }
+        
+        if (candidate.setIndex >= 0) {
+            --walk.setCounts[candidate.setIndex];
+        }
+        walk.partial -= candidate.stats;
+    }
+}
+
+void GearOptimizer::offer(double buildScore, const std::vector<uint32_t>& picks) {
+    QMutexLocker locker(&m_bestMutex);
+    if (m_best.size() >= m_request.topN && buildScore <= m_best.back().score) {
+        return;
+    }
+    
+    auto pos = std::upper_bound(m_best.begin(), m_best.end(), buildScore,
+                                [](double s, const Entry& e) { return s > e.score; });
+    m_best.insert(pos, Entry{buildScore, picks});
+    if (m_best.size() > m_request.topN) {
+        m_best.pop_back();
+    }
+    if (m_best.size() == m_request.topN) {
+        m_threshold = m_best.back().score;
+        m_bestFull = true;
+    }
+    m_bestChanged = true;
+}
+
+void GearOptimizer::flush(Walk& walk) {
+    m_evaluated += walk.evaluated;
+    m_pruned += walk.pruned;
+    walk.evaluated = 0;
+    walk.pruned = 0;
+    
+    if (!m_callback) {
+        return;
+    }
+    qint64 now = m_clock.elapsed();
+    qint64 last = m_lastReportMs;
+    if (!m_bestChanged || now - last < PROGRESS_INTERVAL_MS) {
+        return;
+    }
+    // One worker reports per interval
+    if (!m_lastReportMs.compare_exchange_strong(last, now)) {
+        return;
+    }
+    m_bestChanged = false;
+    m_callback(progress());
+}
+
+OptimizerProgress GearOptimizer::progress() const {
+    OptimizerProgress progress;
+    progress.buildsEvaluated = m_evaluated;
+    progress.branchesPruned = m_pruned;
+    progress.branchesDone = m_branchesDone;
+    progress.totalBranches = m_slots.empty() ? 0 : static_cast<int>(m_slots.front().items.size());
+    
+    QMutexLocker locker(&m_bestMutex);
+    progress.best.reserve(m_best.size());
+    for (const Entry& entry : m_best) {
+        progress.best.push_back(materialize(entry));
+    }
+    return progress;
+}
+
+OptimizedBuild GearOptimizer::materialize(const Entry& entry) const {
+    OptimizedBuild result;
+    result.score = entry.score;
+    result.build.level = m_request.level;
+    result.build.characterClass = m_request.characterClass;
+    for (size_t i = 0; i < StatVector::STAT_COUNT; ++i) {
+        if (m_request.baseStats.values[i] != 0) {
+            result.build.baseStats[static_cast<StatType>(i)] = m_request.baseStats.values[i];
+        }
+    }
+    for (size_t depth = 0; depth < m_slots.size(); ++depth) {
+        result.build.equip(m_slots[depth].items[entry.picks[depth]].item);
+    }
+    result.stats = m_calculator.calculate(result.build);
+    return result;
+}
+
+} // namespace lotro
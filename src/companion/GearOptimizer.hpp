@@ -0,0 +1,188 @@
+/**
+ * LOTRO Launcher - Gear Optimizer
+ * 
+ * Best-in-slot search over ItemDatabase candidates.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "StatCalculator.hpp"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * What to optimize for
+ * 
+ * A build scores sum(weight * stat) over its stat totals. A stat with a
+ * cap stops counting once the cap is reached, so rating past a soft cap
+ * is worth nothing. Caps only apply to positively weighted stats.
+ */
+struct OptimizerRequest {
+    QString characterClass;
+    int level = 150;
+    
+    std::array<double, StatVector::STAT_COUNT> weights{};
+    std::array<int, StatVector::STAT_COUNT> caps{};   // 0 = uncapped
+    
+    // Slots to fill; empty means every slot with candidates
+    std::vector<EquipSlot> slots;
+    
+    // Stats before gear, counted towards caps
+    StatVector baseStats;
+    
+    // Builds to keep
+    size_t topN = 10;
+    
+    // Per slot, only the best items by uncapped weighted score are
+    // searched (0 = all). Keeps the search tractable on the full item table.
+    size_t candidatesPerSlot = 24;
+    
+    void setWeight(StatType type, double weight) { weights[static_cast<size_t>(type)] = weight; }
+    void setCap(StatType type, int cap) { caps[static_cast<size_t>(type)] = cap; }
+};
+
+/**
+ * One build found by the optimizer
+ */
+struct OptimizedBuild {
+    double score = 0.0;
+    CharacterBuild build;
+    CalculatedStats stats;
+};
+
+/**
+ * Progress of a running optimization
+ */
+struct OptimizerProgress {
+    uint64_t buildsEvaluated = 0;
+    uint64_t branchesPruned = 0;
+    int branchesDone = 0;          // First-level branches searched so far
+    int totalBranches = 0;
+    std::vector<OptimizedBuild> best;   // Best first
+    
+    int percentage() const {
+        return totalBranches > 0 ? (branchesDone * 100) / totalBranches : 0;
+    }
+};
+
+/**
+ * Branch-and-bound gear search
+ * 
+ * Candidates are gathered per slot from ItemDatabase, flattened to
+ * StatVectors and sorted best first. The search walks one slot per level
+ * and drops a branch as soon as the best score it could still reach,
+ * computed from per-slot stat maxima and the set bonuses in play, cannot
+ * beat the current N-th best build. The first slot's candidates are
+ * spread over the global thread pool; all workers share the top-N list
+ * and its pruning threshold.
+ */
+class GearOptimizer {
+public:
+    /**
+     * Progress callback, invoked from worker threads whenever the top
+     * builds change (at most every PROGRESS_INTERVAL_MS) and once at the end
+     */
+    using ProgressCallback = std::function<void(const OptimizerProgress&)>;
+    
+    explicit GearOptimizer(OptimizerRequest request);
+    
+    /**
+     * Run the search (blocks until done or cancelled)
+     * @return The best builds, best first
+     */
+    std::vector<OptimizedBuild> run(ProgressCallback progress = nullptr);
+    
+    /**
+     * Stop a running search after the branches in flight
+     */
+    void cancel() { m_cancelled = true; }
+    
+    /**
+     * Score a stat total with the request's weights and caps
+     */
+    double score(const StatVector& totals) const;
+
+private:
+    struct Candidate {
+        GearItem item;
+        StatVector stats;
+        int setIndex = -1;
+    };
+    
+    struct SlotCandidates {
+        EquipSlot slot = EquipSlot::Unknown;
+        std::vector<Candidate> items;
+    };
+    
+    struct SetTier {
+        int piecesRequired = 0;
+        StatVector stats;
+    };
+    
+    struct Entry {
+        double score = 0.0;
+        std::vector<uint32_t> picks;    // Candidate index per slot
+    };
+    
+    // State of one depth-first walk
+    struct Walk {
+        StatVector partial;
+        std::vector<uint32_t> picks;
+        std::vector<int> setCounts;
+        uint64_t evaluated = 0;
+        uint64_t pruned = 0;
+    };
+    
+    void gatherCandidates();
+    void computeBounds();
+    
+    // Depth-first search below a partial build
+    void search(size_t depth, Walk& walk);
+    double upperBound(size_t depth, const StatVector& partial) const;
+    StatVector setBonusTotals(const std::vector<int>& setCounts) const;
+    void offer(double score, const std::vector<uint32_t>& picks);
+    
+    // Fold a walk's counters into the totals and report if due
+    void flush(Walk& walk);
+    
+    OptimizedBuild materialize(const Entry& entry) const;
+    OptimizerProgress progress() const;
+    
+    OptimizerRequest m_request;
+    StatCalculator m_calculator;
+    std::vector<SlotCandidates> m_slots;
+    std::vector<std::vector<SetTier>> m_sets;
+    
+    // Per depth: the most and least each stat can still gain from the
+    // remaining slots, set bonuses included
+    std::vector<StatVector> m_remainingMax;
+    std::vector<StatVector> m_remainingMin;
+    
+    mutable QMutex m_bestMutex;
+    std::vector<Entry> m_best;                // Sorted best first
+    std::atomic<double> m_threshold{0.0};     // Score to beat once m_best is full
+    std::atomic<bool> m_bestFull{false};
+    std::atomic<bool> m_bestChanged{false};
+    std::atomic<bool> m_cancelled{false};
+    
+    // Progress reporting
+    ProgressCallback m_callback;
+    QElapsedTimer m_clock;
+    std::atomic<qint64> m_lastReportMs{0};
+    std::atomic<uint64_t> m_evaluated{0};
+    std::atomic<uint64_t> m_pruned{0};
+    std::atomic<int> m_branchesDone{0};
+    
+    static constexpr qint64 PROGRESS_INTERVAL_MS = 100;
+    static constexpr uint64_t FLUSH_EVERY = 4096;   // Leaves between counter flushes
+};
+
+} // namespace lotro
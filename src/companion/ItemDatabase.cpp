@@ -7,11 +7,21 @@
  */
 
 #include "ItemDatabase.hpp"
+#include "GameDatabaseSnapshot.hpp"
+#include "core/AllocationProfiler.hpp"
+#include "core/platform/Platform.hpp"
 
+#include <QDataStream>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QXmlStreamReader>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 namespace lotro {
 
 // ============ Helper functions ============
@@ -153,12 +163,29 @@ StatType parseStat(const QString& str) {
 
 // ============ ItemDatabase ============
 
-ItemDatabase& ItemDatabase::instance() {
-    static ItemDatabase instance;
-    return instance;
+std::atomic<std::shared_ptr<ItemDatabase>>& ItemDatabase::generation() {
+    static std::atomic<std::shared_ptr<ItemDatabase>> current{std::shared_ptr<ItemDatabase>(new ItemDatabase())};
+    return current;
+}
+
+std::shared_ptr<const ItemDatabase> ItemDatabase::current() {
+    return generation().load(std::memory_order_acquire);
+}
+
+std::shared_ptr<ItemDatabase> ItemDatabase::create(const std::filesystem::path& dataDir) {
+    std::shared_ptr<ItemDatabase> db(new ItemDatabase());
+    if (!db->initialize(dataDir)) {
+        return nullptr;
+    }
+    return db;
+}
+
+void ItemDatabase::publish(std::shared_ptr<ItemDatabase> db) {
+    generation().store(std::move(db), std::memory_order_release);
 }
 
 bool ItemDatabase::initialize(const std::filesystem::path& dataDir) {
+    allocation::Scope allocScope(allocation::Tag::Db);
     if (m_loaded) {
         return true;
     }
@@ -167,13 +194,24 @@ bool ItemDatabase::initialize(const std::filesystem::path& dataDir) {
     
     // Try LOTRO Companion XML format first (lore subdirectory)
     auto loreDir = dataDir / "lore";
+    QString cacheFile = cachePath(dataDir);
+    if (std::filesystem::exists(loreDir) && loadCache(cacheFile, loreDir)) {
+        buildIndexes();
+        m_loaded = true;
+        return true;
+    }
+    
     if (std::filesystem::exists(loreDir)) {
         spdlog::info("Found LOTRO Companion lore directory, loading XML data...");
         
+        bool itemsOk = true;
+        bool setsOk = true;
+        
         auto itemsXml = loreDir / "items.xml";
         if (std::filesystem::exists(itemsXml)) {
             if (!loadItemsXml(itemsXml)) {
                 spdlog::warn("Failed to load items from {}", itemsXml.string());
+                itemsOk = false;
             }
         }
         
@@ -181,8 +219,13 @@ bool ItemDatabase::initialize(const std::filesystem::path& dataDir) {
         if (std::filesystem::exists(setsXml)) {
             if (!loadSetsXml(setsXml)) {
                 spdlog::warn("Failed to load sets from {}", setsXml.string());
+                setsOk = false;
             }
         }
+        
+        if (itemsOk && setsOk) {
+            saveCache(cacheFile, loreDir);
+        }
     } else {
         // Fallback to JSON
         auto itemsPath = dataDir / "items.json";
@@ -193,6 +236,7 @@ bool ItemDatabase::initialize(const std::filesystem::path& dataDir) {
         }
     }
     
+    buildIndexes();
     m_loaded = true;
     spdlog::info("Item database loaded: {} items, {} sets", m_items.size(), m_sets.size());
     
@@ -357,63 +401,110 @@ bool ItemDatabase::loadSets(const std::filesystem::path& path) {
     return true;
 }
 
-std::vector<GearItem> ItemDatabase::searchItems(const QString& query) const {
+std::vector<GearItem> ItemDatabase::itemsAt(const std::vector<uint32_t>& positions) const {
     std::vector<GearItem> results;
-    QString lowerQuery = query.toLower();
-    
-    for (const auto& item : m_items) {
-        if (item.name.toLower().contains(lowerQuery) ||
-            item.description.toLower().contains(lowerQuery)) {
-            results.push_back(item);
-        }
+    results.reserve(positions.size());
+    for (uint32_t position : positions) {
+        results.push_back(m_items[position]);
     }
-    
     return results;
 }
 
-std::vector<GearItem> ItemDatabase::getItemsBySlot(EquipSlot slot) const {
-    std::vector<GearItem> results;
+void ItemDatabase::buildIndexes() {
+    QElapsedTimer timer;
+    timer.start();
     
-    for (const auto& item : m_items) {
-        if (item.slot == slot) {
-            results.push_back(item);
+    m_itemByKey.clear();
+    m_itemById.clear();
+    m_itemsBySlot = {};
+    m_itemsByQuality = {};
+    m_itemsByClass.clear();
+    m_classlessItems.clear();
+    m_itemSearch.clear();
+    
+    m_itemByKey.reserve(static_cast<qsizetype>(m_items.size()));
+    m_itemById.reserve(static_cast<qsizetype>(m_items.size()));
+    m_itemSearch.reserve(m_items.size());
+    for (size_t i = 0; i < m_items.size(); ++i) {
+        const GearItem& item = m_items[i];
+        uint32_t position = static_cast<uint32_t>(i);
+        
+        // First record wins on duplicates, like the old front-to-back scans
+        if (!m_itemByKey.contains(item.id)) {
+            m_itemByKey.insert(item.id, position);
+        }
+        bool numeric = false;
+        int numericId = item.id.toInt(&numeric);
+        if (numeric && !m_itemById.contains(numericId)) {
+            m_itemById.insert(numericId, position);
         }
+        
+        m_itemsBySlot[static_cast<size_t>(item.slot)].push_back(position);
+        m_itemsByQuality[static_cast<size_t>(item.quality)].push_back(position);
+        if (item.requiredClass.isEmpty()) {
+            m_classlessItems.push_back(position);
+        } else {
+            m_itemsByClass[item.requiredClass].push_back(position);
+        }
+        m_itemSearch.add(item.name, {item.description});
     }
     
-    return results;
+    spdlog::debug("Item database indexes built in {} ms", timer.elapsed());
+}
+
+std::vector<GearItem> ItemDatabase::searchItems(const QString& query, size_t limit) const {
+    std::vector<uint32_t> positions = m_itemSearch.search(query, limit);
+    return itemsAt(positions);
+}
+
+std::vector<uint32_t> ItemDatabase::searchItemPositions(const QString& query, size_t limit) const {
+    return m_itemSearch.search(query, limit);
+}
+
+std::vector<uint32_t> ItemDatabase::refineItemPositions(const QString& query,
+                                                        std::span<const uint32_t> previous) const {
+    return m_itemSearch.refine(query, previous);
+}
+
+std::span<const uint32_t> ItemDatabase::itemPositionsBySlot(EquipSlot slot) const {
+    return m_itemsBySlot[static_cast<size_t>(slot)];
+}
+
+std::vector<GearItem> ItemDatabase::getItemsBySlot(EquipSlot slot) const {
+    return itemsAt(m_itemsBySlot[static_cast<size_t>(slot)]);
 }
 
 std::vector<GearItem> ItemDatabase::getItemsByQuality(ItemQuality quality) const {
-    std::vector<GearItem> results;
-    
-    for (const auto& item : m_items) {
-        if (item.quality == quality) {
-            results.push_back(item);
-        }
-    }
-    
-    return results;
+    return itemsAt(m_itemsByQuality[static_cast<size_t>(quality)]);
 }
 
 std::vector<GearItem> ItemDatabase::getItemsForClass(const QString& className) const {
-    std::vector<GearItem> results;
-    
-    for (const auto& item : m_items) {
-        if (item.requiredClass.isEmpty() || item.requiredClass == className) {
-            results.push_back(item);
-        }
+    // Items for any class plus the class's own, merged back into table order
+    auto it = m_itemsByClass.constFind(className);
+    if (it == m_itemsByClass.constEnd()) {
+        return itemsAt(m_classlessItems);
     }
-    
-    return results;
+    std::vector<uint32_t> positions;
+    positions.reserve(m_classlessItems.size() + it.value().size());
+    std::merge(m_classlessItems.begin(), m_classlessItems.end(),
+               it.value().begin(), it.value().end(), std::back_inserter(positions));
+    return itemsAt(positions);
 }
 
 std::optional<GearItem> ItemDatabase::getItem(const QString& id) const {
-    for (const auto& item : m_items) {
-        if (item.id == id) {
-            return item;
-        }
+    auto it = m_itemByKey.constFind(id);
+    if (it == m_itemByKey.constEnd()) {
+        return std::nullopt;
+    }
+    return m_items[it.value()];
+}
+
+const GearItem* ItemDatabase::findItem(int itemId) const {
+    auto it = m_itemById.constFind(itemId);
+    if (it == m_itemById.constEnd()) {
+        return nullptr;
     }
-    return std::nullopt;
+    return &m_items[it.value()];
 }
 
 std::vector<SetBonus> ItemDatabase::getSetBonuses(const QString& setName) const {
@@ -424,4 +515,188 @@ std::vector<SetBonus> ItemDatabase::getSetBonuses(const QString& setName) const
     return {};
 }
 
+// ============ Binary cache ============
+
+namespace {
+
+const std::vector<QString>& cacheSourceNames() {
+    static const std::vector<QString> names = {"items.xml", "sets.xml"};
+    return names;
+}
+
+QDataStream& operator<<(QDataStream& out, const ItemStat& v) {
+    return out << static_cast<qint32>(v.type) << v.value;
+}
+
+QDataStream& operator>>(QDataStream& in, ItemStat& v) {
+    qint32 type = 0;
+    in >> type >> v.value;
+    v.type = static_cast<StatType>(type);
+    return in;
+}
+
+QDataStream& operator<<(QDataStream& out, const std::vector<ItemStat>& stats) {
+    out << static_cast<quint32>(stats.size());
+    for (const ItemStat& stat : stats) {
+        out << stat;
+    }
+    return out;
+}
+
+QDataStream& operator>>(QDataStream& in, std::vector<ItemStat>& stats) {
+    quint32 count = 0;
+    in >> count;
+    if (in.status() != QDataStream::Ok || count > 1024) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return in;
+    }
+    stats.resize(count);
+    for (ItemStat& stat : stats) {
+        in >> stat;
+    }
+    return in;
+}
+
+QDataStream& operator<<(QDataStream& out, const GearItem& v) {
+    return out << v.id << v.name << v.description << static_cast<qint32>(v.slot)
+               << static_cast<qint32>(v.quality) << v.itemLevel << v.requiredLevel
+               << v.requiredClass << v.stats << v.setName;
+}
+
+QDataStream& operator>>(QDataStream& in, GearItem& v) {
+    qint32 slot = 0, quality = 0;
+    in >> v.id >> v.name >> v.description >> slot >> quality >> v.itemLevel
+       >> v.requiredLevel >> v.requiredClass >> v.stats >> v.setName;
+    if (slot < 0 || slot > static_cast<qint32>(EquipSlot::Unknown)
+        || quality < 0 || quality > static_cast<qint32>(ItemQuality::Unknown)) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return in;
+    }
+    v.slot = static_cast<EquipSlot>(slot);
+    v.quality = static_cast<ItemQuality>(quality);
+    return in;
+}
+
+QDataStream& operator<<(QDataStream& out, const SetBonus& v) {
+    return out << v.setName << v.piecesRequired << v.bonusStats << v.description;
+}
+
+QDataStream& operator>>(QDataStream& in, SetBonus& v) {
+    return in >> v.setName >> v.piecesRequired >> v.bonusStats >> v.description;
+}
+
+} // anonymous namespace
+
+QString ItemDatabase::cachePath(const std::filesystem::path& dataDir) {
+    QString absolute = QDir(QString::fromStdString(dataDir.string())).absolutePath();
+    auto cacheDir = Platform::getCachePath() / "item-database";
+    return QDir(QString::fromStdString(cacheDir.string())).filePath(
+        QString("items-%1.cache").arg(qHash(absolute), 8, 16, QChar('0')));
+}
+
+bool ItemDatabase::loadCache(const QString& path, const std::filesystem::path& loreDir) {
+    QElapsedTimer timer;
+    timer.start();
+    
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, sourceCount = 0;
+    in >> magic >> version >> sourceCount;
+    auto expected = GameDatabaseSnapshot::stampSources(loreDir, cacheSourceNames());
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || sourceCount != expected.size()) {
+        spdlog::info("Item database cache {} is from another format, rebuilding", path.toStdString());
+        return false;
+    }
+    for (const SnapshotSource& source : expected) {
+        SnapshotSource stored;
+        in >> stored.fileName >> stored.size >> stored.modifiedMs;
+        if (!(stored == source)) {
+            spdlog::info("Item database cache is stale ({} changed)", source.fileName.toStdString());
+            return false;
+        }
+    }
+    
+    quint32 itemCount = 0;
+    in >> itemCount;
+    if (in.status() != QDataStream::Ok || itemCount > static_cast<quint32>(file.size())) {
+        spdlog::warn("Item database cache {} is corrupt", path.toStdString());
+        return false;
+    }
+    std::vector<GearItem> items(itemCount);
+    for (GearItem& item : items) {
+        in >> item;
+    }
+    
+    quint32 setCount = 0;
+    in >> setCount;
+    std::unordered_map<std::string, std::vector<SetBonus>> sets;
+    for (quint32 i = 0; i < setCount && in.status() == QDataStream::Ok; ++i) {
+        QString name;
+        quint32 bonusCount = 0;
+        in >> name >> bonusCount;
+        if (bonusCount > 64) {
+            in.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+        auto& bonuses = sets[name.toStdString()];
+        bonuses.resize(bonusCount);
+        for (SetBonus& bonus : bonuses) {
+            in >> bonus;
+        }
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Item database cache {} is corrupt", path.toStdString());
+        return false;
+    }
+    
+    m_items = std::move(items);
+    m_sets = std::move(sets);
+    spdlog::info("Item database loaded from cache in {} ms: {} items, {} sets",
+                 timer.elapsed(), m_items.size(), m_sets.size());
+    return true;
+}
+
+void ItemDatabase::saveCache(const QString& path, const std::filesystem::path& loreDir) const {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write item database cache {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    
+    auto sources = GameDatabaseSnapshot::stampSources(loreDir, cacheSourceNames());
+    out << CACHE_MAGIC << CACHE_VERSION << static_cast<quint32>(sources.size());
+    for (const SnapshotSource& source : sources) {
+        out << source.fileName << source.size << source.modifiedMs;
+    }
+    
+    out << static_cast<quint32>(m_items.size());
+    for (const GearItem& item : m_items) {
+        out << item;
+    }
+    
+    out << static_cast<quint32>(m_sets.size());
+    for (const auto& [name, bonuses] : m_sets) {
+        out << QString::fromStdString(name) << static_cast<quint32>(bonuses.size());
+        for (const SetBonus& bonus : bonuses) {
+            out << bonus;
+        }
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit item database cache {}", path.toStdString());
+    }
+}
+
 } // namespace lotro
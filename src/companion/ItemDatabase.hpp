@@ -8,12 +8,19 @@
 
 #pragma once
 
+#include <QHash>
 #include <QString>
+#include <array>
+#include <atomic>
 #include <filesystem>
+#include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 #include <unordered_map>
 
+#include "TextSearchIndex.hpp"
+
 namespace lotro {
 
 /**
@@ -139,10 +146,28 @@ struct SetBonus {
 
 /**
  * Item database for gear
+ * 
+ * Published in generations like GameDatabase: a reload builds a new one
+ * with create() and swaps it in with publish(), and readers hold the
+ * pointer current() returns for as long as they use anything read
+ * from it.
  */
 class ItemDatabase {
 public:
-    static ItemDatabase& instance();
+    /**
+     * Pin the current generation
+     */
+    static std::shared_ptr<const ItemDatabase> current();
+    
+    /**
+     * Build a new, unpublished generation; nullptr if it failed to load
+     */
+    static std::shared_ptr<ItemDatabase> create(const std::filesystem::path& dataDir);
+    
+    /**
+     * Make a generation current; call on the GUI thread
+     */
+    static void publish(std::shared_ptr<ItemDatabase> generation);
     
     /**
      * Initialize from data directory
@@ -151,13 +176,29 @@ public:
     
     bool isLoaded() const { return m_loaded; }
     
-    // Item lookups
-    std::vector<GearItem> searchItems(const QString& query) const;
+    // Item lookups. Slot, quality, class and id lookups use indexes built
+    // at load time; searchItems ranks matches like GameDatabase searches.
+    std::vector<GearItem> searchItems(const QString& query, size_t limit = 0) const;
     std::vector<GearItem> getItemsBySlot(EquipSlot slot) const;
     std::vector<GearItem> getItemsByQuality(ItemQuality quality) const;
     std::vector<GearItem> getItemsForClass(const QString& className) const;
     std::optional<GearItem> getItem(const QString& id) const;
     
+    /**
+     * Look up an item by its numeric game id without copying it
+     * @return The item, or nullptr if unknown
+     */
+    const GearItem* findItem(int itemId) const;
+    
+    // Read-only access without copying, valid for the generation's lifetime
+    std::span<const GearItem> itemsView() const { return m_items; }
+    
+    // Positions in itemsView(). Searches are ranked; refine narrows the
+    // uncapped results of an earlier search (see TextSearchIndex::narrows).
+    std::vector<uint32_t> searchItemPositions(const QString& query, size_t limit = 0) const;
+    std::vector<uint32_t> refineItemPositions(const QString& query, std::span<const uint32_t> previous) const;
+    std::span<const uint32_t> itemPositionsBySlot(EquipSlot slot) const;
+    
     // Set lookups
     std::vector<SetBonus> getSetBonuses(const QString& setName) const;
     
@@ -167,14 +208,41 @@ public:
 private:
     ItemDatabase() = default;
     
+    // Holds the current generation
+    static std::atomic<std::shared_ptr<ItemDatabase>>& generation();
+    
     bool loadItemsXml(const std::filesystem::path& path);
     bool loadSetsXml(const std::filesystem::path& path);
     bool loadItems(const std::filesystem::path& path);
     bool loadSets(const std::filesystem::path& path);
     
+    // Binary cache of the parsed XML, keyed by the source files' size and mtime
+    static QString cachePath(const std::filesystem::path& dataDir);
+    bool loadCache(const QString& path, const std::filesystem::path& loreDir);
+    void saveCache(const QString& path, const std::filesystem::path& loreDir) const;
+    
+    // Rebuild the lookup indexes after m_items changes
+    void buildIndexes();
+    
+    std::vector<GearItem> itemsAt(const std::vector<uint32_t>& positions) const;
+    
     bool m_loaded = false;
     std::vector<GearItem> m_items;
     std::unordered_map<std::string, std::vector<SetBonus>> m_sets;
+    
+    // Indexes: record positions, in table order
+    static constexpr size_t SLOT_COUNT = static_cast<size_t>(EquipSlot::Unknown) + 1;
+    static constexpr size_t QUALITY_COUNT = static_cast<size_t>(ItemQuality::Unknown) + 1;
+    QHash<QString, uint32_t> m_itemByKey;
+    QHash<int, uint32_t> m_itemById;
+    std::array<std::vector<uint32_t>, SLOT_COUNT> m_itemsBySlot;
+    std::array<std::vector<uint32_t>, QUALITY_COUNT> m_itemsByQuality;
+    QHash<QString, std::vector<uint32_t>> m_itemsByClass;
+    std::vector<uint32_t> m_classlessItems;
+    TextSearchIndex m_itemSearch;
+    
+    static constexpr quint32 CACHE_MAGIC = 0x4244494C; // "LIDB"
+    static constexpr quint32 CACHE_VERSION = 1;
 };
 
 // Helper functions
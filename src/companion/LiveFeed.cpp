@@ -0,0 +1,306 @@
+/**
+ * LOTRO Launcher - Live Character Feed Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "LiveFeed.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QtEndian>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace lotro {
+
+namespace {
+
+// Clients that stop reading notifications are dropped past this backlog
+constexpr qint64 MAX_CLIENT_BACKLOG = 4096;
+
+// Truncate to the field without splitting a UTF-8 sequence
+template<size_t N>
+void copyString(char (&field)[N], const QString& value) {
+    const QByteArray utf8 = value.toUtf8();
+    size_t size = std::min<size_t>(static_cast<size_t>(utf8.size()), N - 1);
+    while (size > 0 && size < static_cast<size_t>(utf8.size())
+           && (static_cast<uint8_t>(utf8[static_cast<qsizetype>(size)]) & 0xC0) == 0x80) {
+        --size;
+    }
+    std::memcpy(field, utf8.constData(), size);
+    std::memset(field + size, 0, N - size);
+}
+
+QByteArray extendedJson(const CharacterData& data) {
+    QJsonArray virtues;
+    for (const VirtueStatus& virtue : data.virtues) {
+        virtues.append(QJsonObject{{"key", virtue.key}, {"name", virtue.name},
+                                   {"rank", virtue.rank}, {"xp", virtue.xp}});
+    }
+    
+    QJsonArray factions;
+    for (const FactionStatus& faction : data.factions) {
+        factions.append(QJsonObject{{"id", faction.factionId}, {"key", faction.key}, {"name", faction.name},
+                                    {"category", faction.category}, {"tier", faction.tier},
+                                    {"reputation", faction.reputation}});
+    }
+    
+    QJsonArray professions;
+    for (const CraftingProfessionStatus& profession : data.crafting.professions) {
+        professions.append(QJsonObject{{"name", profession.name}, {"tier", profession.tier},
+                                       {"proficiency", profession.proficiency},
+                                       {"mastery", profession.mastery},
+                                       {"mastered", profession.hasMastered}});
+    }
+    
+    QJsonObject gear;
+    for (const auto& [slot, itemId] : data.equippedGear) {
+        gear.insert(slot, itemId);
+    }
+    auto intMap = [](const std::map<int, int>& values) {
+        QJsonObject object;
+        for (const auto& [key, value] : values) {
+            object.insert(QString::number(key), value);
+        }
+        return object;
+    };
+    auto intList = [](const std::vector<int>& values) {
+        QJsonArray array;
+        for (int value : values) {
+            array.append(value);
+        }
+        return array;
+    };
+    
+    QJsonObject root{
+        {"virtues", virtues},
+        {"factions", factions},
+        {"crafting", QJsonObject{{"vocation", data.crafting.vocation}, {"professions", professions}}},
+        {"equippedGear", gear},
+        {"wallet", intMap(data.wallet)},
+        {"skills", intList(data.skills)},
+        {"titles", intList(data.titles)},
+        {"emotes", intList(data.emotes)},
+        {"traitPoints", intMap(data.traitPoints)},
+    };
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+} // anonymous namespace
+
+LiveFeed& LiveFeed::instance() {
+    static LiveFeed feed;
+    return feed;
+}
+
+LiveFeed::LiveFeed() = default;
+
+LiveFeed::~LiveFeed() {
+    close();
+}
+
+bool LiveFeed::open() {
+    if (isOpen()) {
+        return true;
+    }
+
+#ifdef _WIN32
+    const std::wstring name = L"Local\\" + QString(NAME).toStdWString();
+    HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, SEGMENT_SIZE,
+                                        name.c_str());
+    if (!mapping) {
+        spdlog::warn("Live feed: failed to create shared memory: error {}", GetLastError());
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, SEGMENT_SIZE);
+    if (!view) {
+        spdlog::warn("Live feed: failed to map shared memory: error {}", GetLastError());
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+#else
+    const std::string name = std::string("/") + NAME;
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        spdlog::warn("Live feed: failed to create shared memory: {}", strerror(errno));
+        return false;
+    }
+    void* view = MAP_FAILED;
+    if (ftruncate(fd, SEGMENT_SIZE) == 0) {
+        view = mmap(nullptr, SEGMENT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        spdlog::warn("Live feed: failed to map shared memory: {}", strerror(errno));
+        shm_unlink(name.c_str());
+        return false;
+    }
+#endif
+
+    m_segment = static_cast<uint8_t*>(view);
+    std::memset(m_segment, 0, sizeof(LiveFeedHeader));
+    m_header = new (m_segment) LiveFeedHeader{};
+    m_header->version = LIVE_FEED_VERSION;
+    m_header->headerSize = sizeof(LiveFeedHeader);
+    m_header->segmentSize = SEGMENT_SIZE;
+    m_header->characterOffset = sizeof(LiveFeedHeader);
+    m_header->extendedOffset = sizeof(LiveFeedHeader) + sizeof(LiveFeedCharacter);
+    m_header->writerPid = static_cast<uint32_t>(QCoreApplication::applicationPid());
+    // Magic last, so a reader that sees it sees a filled-in header
+    std::atomic_thread_fence(std::memory_order_release);
+    m_header->magic = LIVE_FEED_MAGIC;
+    
+    // Sockets must go before the event loop does
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &LiveFeed::close, Qt::UniqueConnection);
+    
+    // Notifications are a convenience; the segment works without them
+    m_server = new QLocalServer(this);
+    QLocalServer::removeServer(NAME);
+    if (m_server->listen(NAME)) {
+        connect(m_server, &QLocalServer::newConnection, this, [this]() {
+            while (QLocalSocket* client = m_server->nextPendingConnection()) {
+                m_clients.append(client);
+                connect(client, &QLocalSocket::disconnected, this, [this, client]() {
+                    m_clients.removeOne(client);
+                    client->deleteLater();
+                });
+            }
+        });
+    } else {
+        spdlog::warn("Live feed: notification socket unavailable: {}", m_server->errorString().toStdString());
+    }
+    
+    spdlog::info("Live feed publishing to shared memory {}", NAME);
+    return true;
+}
+
+void LiveFeed::close() {
+    if (m_server) {
+        for (QLocalSocket* client : m_clients) {
+            // Children of the server, deleted with it
+            client->disconnect(this);
+            client->abort();
+        }
+        m_clients.clear();
+        delete m_server;
+        m_server = nullptr;
+    }
+    if (!m_segment) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_segment);
+    CloseHandle(m_mapping);
+    m_mapping = nullptr;
+#else
+    munmap(m_segment, SEGMENT_SIZE);
+    shm_unlink((std::string("/") + NAME).c_str());
+#endif
+    m_segment = nullptr;
+    m_header = nullptr;
+    m_extendedName.clear();
+    m_extendedServer.clear();
+}
+
+void LiveFeed::publish(const CharacterInfo& info, CharacterChangeSet changes) {
+    if (!isOpen()) {
+        return;
+    }
+    const bool sameCharacter = info.name == m_extendedName && info.server == m_extendedServer;
+    write(info, changes.groups, nullptr, sameCharacter);
+}
+
+void LiveFeed::publish(const CharacterData& data) {
+    if (!isOpen()) {
+        return;
+    }
+    const QByteArray extended = extendedJson(data);
+    write(data.basic, (1u << static_cast<int>(CharacterGroup::Count)) - 1, &extended, false);
+}
+
+void LiveFeed::write(const CharacterInfo& info, uint32_t changes, const QByteArray* extended, bool keepExtended) {
+    const size_t extendedCapacity = SEGMENT_SIZE - m_header->extendedOffset;
+    if (extended && static_cast<size_t>(extended->size()) > extendedCapacity) {
+        spdlog::warn("Live feed: extended data of {} bytes doesn't fit, dropped", extended->size());
+        extended = nullptr;
+    }
+    
+    // Seqlock write: odd while inside
+    const uint64_t sequence = m_header->sequence.load(std::memory_order_relaxed);
+    m_header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    auto* character = reinterpret_cast<LiveFeedCharacter*>(m_segment + m_header->characterOffset);
+    copyString(character->name, info.name);
+    copyString(character->surname, info.surname);
+    copyString(character->className, info.className);
+    copyString(character->race, info.race);
+    copyString(character->server, info.server);
+    copyString(character->account, info.account);
+    character->level = info.level;
+    character->morale = info.morale;
+    character->maxMorale = info.maxMorale;
+    character->power = info.power;
+    character->maxPower = info.maxPower;
+    character->gold = info.gold;
+    character->silver = info.silver;
+    character->copper = info.copper;
+    character->destinyPoints = info.destinyPoints;
+    character->lotroPoints = info.lotroPoints;
+    character->accountType = static_cast<int32_t>(info.accountType);
+    character->reserved = 0;
+    
+    uint32_t flags = m_header->flags | LIVE_FEED_VALID;
+    if (extended) {
+        std::memcpy(m_segment + m_header->extendedOffset, extended->constData(),
+                    static_cast<size_t>(extended->size()));
+        m_header->extendedSize = static_cast<uint32_t>(extended->size());
+        flags |= LIVE_FEED_EXTENDED;
+        m_extendedName = info.name;
+        m_extendedServer = info.server;
+    } else if (!keepExtended) {
+        m_header->extendedSize = 0;
+        flags &= ~LIVE_FEED_EXTENDED;
+        m_extendedName.clear();
+        m_extendedServer.clear();
+    }
+    m_header->flags = flags;
+    m_header->changes = changes;
+    m_header->publishedAtMs = static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
+    
+    m_header->sequence.store(sequence + 2, std::memory_order_release);
+    notifyClients(sequence + 2);
+}
+
+void LiveFeed::notifyClients(uint64_t sequence) {
+    const uint64_t value = qToLittleEndian(sequence);
+    for (QLocalSocket* client : std::as_const(m_clients)) {
+        if (client->bytesToWrite() > MAX_CLIENT_BACKLOG) {
+            // Not reading; the disconnected handler removes it
+            client->abort();
+            continue;
+        }
+        client->write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+} // namespace lotro
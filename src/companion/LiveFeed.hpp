@@ -0,0 +1,150 @@
+/**
+ * LOTRO Launcher - Live Character Feed
+ * 
+ * Publishes the synced character into shared memory for overlays and
+ * other external tools.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "CharacterExtractor.hpp"
+
+#include <QList>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace lotro {
+
+/**
+ * Layout of the shared segment, for readers
+ * 
+ * The segment starts with a LiveFeedHeader, followed by a LiveFeedCharacter
+ * at characterOffset and, when LIVE_FEED_EXTENDED is set, extendedSize
+ * bytes of UTF-8 JSON with the rest of CharacterData at extendedOffset.
+ * Every integer is little-endian and every string UTF-8, NUL-padded.
+ * 
+ * Updates are guarded by a seqlock: sequence is odd while the writer is
+ * inside the segment. A reader loads sequence (acquire), skips the read
+ * while it is odd, copies what it needs, and keeps the copy only if a
+ * second load of sequence (after an acquire fence) returns the same value.
+ */
+struct LiveFeedHeader {
+    uint32_t magic;                     // LIVE_FEED_MAGIC
+    uint16_t version;                   // LIVE_FEED_VERSION; other versions must not be read
+    uint16_t headerSize;                // sizeof(LiveFeedHeader)
+    uint32_t segmentSize;
+    uint32_t flags;                     // LIVE_FEED_* bits
+    std::atomic<uint64_t> sequence;
+    uint64_t publishedAtMs;             // Unix time of the last publish
+    uint32_t changes;                   // CharacterChangeSet bits of the last publish
+    uint32_t characterOffset;
+    uint32_t extendedOffset;
+    uint32_t extendedSize;
+    uint32_t writerPid;
+    uint32_t reserved[7];
+};
+
+struct LiveFeedCharacter {
+    char name[64];
+    char surname[64];
+    char className[32];
+    char race[32];
+    char server[64];
+    char account[64];
+    int32_t level;
+    int32_t morale;
+    int32_t maxMorale;
+    int32_t power;
+    int32_t maxPower;
+    int32_t gold;
+    int32_t silver;
+    int32_t copper;
+    int32_t destinyPoints;
+    int32_t lotroPoints;
+    int32_t accountType;                // CharacterInfo::AccountType
+    int32_t reserved;
+};
+
+constexpr uint32_t LIVE_FEED_MAGIC = 0x4445464C;   // "LFED"
+constexpr uint16_t LIVE_FEED_VERSION = 1;
+constexpr uint32_t LIVE_FEED_VALID = 1u << 0;       // A character has been published
+constexpr uint32_t LIVE_FEED_EXTENDED = 1u << 1;    // The extended section is current
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(sizeof(LiveFeedHeader) == 80);
+static_assert(sizeof(LiveFeedCharacter) == 368);
+
+/**
+ * Writes each synced character into a named shared-memory segment
+ * 
+ * The segment is "/lotro-launcher-feed" (shm_open, so /dev/shm on Linux)
+ * or "Local\lotro-launcher-feed" (a file mapping on Windows); readers map
+ * it read-only and never block the launcher. Tools that would rather not
+ * poll can connect to the local socket of the same name: each publish
+ * writes the new sequence number, 8 bytes, to every connected client.
+ * 
+ * Only the GUI thread publishes, so the seqlock has a single writer. The
+ * basic fields come from every live sync; the extended section is only
+ * refreshed by full extractions and dropped when a different character
+ * is published.
+ */
+class LiveFeed : public QObject {
+    Q_OBJECT
+    
+public:
+    static LiveFeed& instance();
+    
+    /**
+     * Create the segment and start the notification socket
+     * @return false if the segment could not be created; the socket is
+     * optional and only logged
+     */
+    bool open();
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+    
+    /**
+     * Publish a sync's character; extended data is kept for the same character
+     */
+    void publish(const CharacterInfo& info, CharacterChangeSet changes);
+    
+    /**
+     * Publish a full extraction, extended section included
+     */
+    void publish(const CharacterData& data);
+    
+    static constexpr const char* NAME = "lotro-launcher-feed";
+    static constexpr uint32_t SEGMENT_SIZE = 1024 * 1024;
+    
+private:
+    LiveFeed();
+    ~LiveFeed() override;
+    
+    // Extended data replaces the section when given, else the section is
+    // kept or dropped
+    void write(const CharacterInfo& info, uint32_t changes, const QByteArray* extended, bool keepExtended);
+    void notifyClients(uint64_t sequence);
+    
+    LiveFeedHeader* m_header = nullptr;
+    uint8_t* m_segment = nullptr;
+#ifdef _WIN32
+    void* m_mapping = nullptr;
+#endif
+
+    QLocalServer* m_server = nullptr;
+    QList<QLocalSocket*> m_clients;
+    
+    // Whose extended section the segment holds
+    QString m_extendedName;
+    QString m_extendedServer;
+};
+
+} // namespace lotro
@@ -7,21 +7,32 @@
 #include "LiveSyncService.hpp"
 #include "CharacterExtractor.hpp"
 #include "CharacterTracker.hpp"
+#include "LiveFeed.hpp"
+#include "core/StallWatchdog.hpp"
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 namespace lotro {
 
 LiveSyncService::LiveSyncService(QObject* parent)
     : QObject(parent)
     , m_syncTimer(new QTimer(this))
     , m_connectionTimer(new QTimer(this))
+    , m_saveTimer(new QTimer(this))
 {
+    // Re-armed after every sync with the adaptive delay
+    m_syncTimer->setSingleShot(true);
     connect(m_syncTimer, &QTimer::timeout, this, &LiveSyncService::onSyncTimer);
     connect(m_connectionTimer, &QTimer::timeout, this, &LiveSyncService::onConnectionCheck);
     
     // Connection check is less frequent (every 10 seconds)
     m_connectionTimer->setInterval(10000);
+    
+    m_saveTimer->setSingleShot(true);
+    connect(m_saveTimer, &QTimer::timeout, this, &LiveSyncService::flushSaves);
+    m_savePool.setMaxThreadCount(1);
 }
 
 LiveSyncService::~LiveSyncService() {
@@ -37,8 +48,27 @@ void LiveSyncService::start(const QString& gamePath, CharacterTracker* tracker)
     m_tracker = tracker;
     m_running = true;
     
-    // Create extractor
+    // Create extractor; from here on only the worker thread touches it
     m_extractor = std::make_unique<CharacterExtractor>(gamePath);
+    m_metrics.reset();
+    m_extractor->setMetrics(&m_metrics);
+    m_extractor->setDirtyPageTracking(m_dirtyPageTracking);
+    if (m_liveFeed) {
+        LiveFeed::instance().open();
+    }
+    
+    // Capture the first sync's memory reads for offline replay, when asked
+    const QString capturePath = qEnvironmentVariable("LOTRO_MEMORY_CAPTURE");
+    if (!capturePath.isEmpty()) {
+        spdlog::info("Capturing the first sync to {}", capturePath.toStdString());
+        m_extractor->setCapturePath(capturePath);
+    }
+    
+    m_worker = new QObject;
+    m_worker->moveToThread(&m_workerThread);
+    connect(&m_workerThread, &QThread::finished, m_worker, &QObject::deleteLater);
+    m_workerThread.setObjectName("LiveSync");
+    m_workerThread.start();
     
     // Try to connect immediately
     tryConnect();
@@ -61,41 +91,70 @@ void LiveSyncService::stop() {
     m_syncTimer->stop();
     m_connectionTimer->stop();
     
+    // Autosaves still held back are written now
+    m_saveTimer->stop();
+    flushSaves();
+    m_savePool.waitForDone();
+    
+    // Jobs still queued are dropped with the worker; the one running
+    // finishes first
+    m_workerThread.quit();
+    m_workerThread.wait();
+    m_worker = nullptr;
+    m_syncPending = false;
+    m_connectPending = false;
+    
     if (m_extractor) {
         m_extractor->disconnect();
         m_extractor.reset();
     }
+    m_snapshot.take();
+    m_notifyPending = false;
     
     emit connectionChanged(false);
     emit statusChanged(tr("Sync service stopped"));
     spdlog::info("LiveSyncService stopped");
 }
 
-void LiveSyncService::setSyncInterval(int ms) {
-    m_syncInterval = ms;
+void LiveSyncService::setSyncIntervalBounds(int minMs, int maxMs) {
+    m_minSyncInterval = std::max(minMs, 100);
+    m_maxSyncInterval = std::max(maxMs, m_minSyncInterval);
+    m_syncInterval = std::clamp(m_syncInterval, m_minSyncInterval, m_maxSyncInterval);
     if (m_syncTimer->isActive()) {
-        m_syncTimer->setInterval(ms);
+        m_syncTimer->start(m_syncInterval);
     }
 }
 
 void LiveSyncService::tryConnect() {
-    if (!m_extractor) {
+    if (!m_worker || m_connectPending.exchange(true)) {
         return;
     }
     
     emit statusChanged(tr("Connecting to game..."));
+    QMetaObject::invokeMethod(m_worker, [this]() { connectWorker(); }, Qt::QueuedConnection);
+}
+
+void LiveSyncService::requestSync() {
+    // Skip the tick if the previous walk is still going
+    if (!m_worker || m_syncPending.exchange(true)) {
+        return;
+    }
+    QMetaObject::invokeMethod(m_worker, [this]() { syncWorker(); }, Qt::QueuedConnection);
+}
+
+void LiveSyncService::onConnectResult(bool connected) {
+    if (!m_running) {
+        return;
+    }
     
-    if (m_extractor->connect()) {
+    if (connected) {
         m_connected = true;
         emit connectionChanged(true);
         emit statusChanged(tr("Connected to LOTRO"));
         
-        // Start sync timer
-        m_syncTimer->setInterval(m_syncInterval);
-        m_syncTimer->start();
-        
-        // Do immediate sync
-        syncCharacter();
+        // Do immediate sync; it arms the timer when done
+        m_syncInterval = m_minSyncInterval;
+        requestSync();
         
         spdlog::info("LiveSyncService connected to game");
     } else {
@@ -107,6 +166,19 @@ void LiveSyncService::tryConnect() {
     }
 }
 
+void LiveSyncService::onConnectionLost() {
+    if (!m_running || !m_connected) {
+        return;
+    }
+    
+    m_connected = false;
+    emit connectionChanged(false);
+    emit statusChanged(tr("Connection lost - reconnecting..."));
+    m_syncTimer->stop();
+    
+    spdlog::info("LiveSyncService lost connection");
+}
+
 void LiveSyncService::onConnectionCheck() {
     if (!m_running) {
         return;
@@ -115,59 +187,132 @@ void LiveSyncService::onConnectionCheck() {
     // If not connected, try to connect
     if (!m_connected) {
         tryConnect();
-    } else if (m_extractor && !m_extractor->isConnected()) {
-        // Lost connection
-        m_connected = false;
-        emit connectionChanged(false);
-        emit statusChanged(tr("Connection lost - reconnecting..."));
-        m_syncTimer->stop();
-        
-        spdlog::info("LiveSyncService lost connection");
+    } else if (m_worker && !m_connectPending.exchange(true)) {
+        QMetaObject::invokeMethod(m_worker, [this]() { checkConnectionWorker(); },
+                                  Qt::QueuedConnection);
     }
 }
 
 void LiveSyncService::onSyncTimer() {
     if (m_connected) {
-        syncCharacter();
+        requestSync();
     }
 }
 
-void LiveSyncService::syncCharacter() {
-    if (!m_extractor || !m_connected) {
+void LiveSyncService::connectWorker() {
+    bool connected;
+    {
+        SyncMetrics::ScopedTimer timer(&m_metrics, SyncStage::Connect);
+        connected = m_extractor->connect();
+    }
+    m_connectPending = false;
+    QMetaObject::invokeMethod(this, [this, connected]() { onConnectResult(connected); },
+                              Qt::QueuedConnection);
+}
+
+void LiveSyncService::checkConnectionWorker() {
+    bool connected = m_extractor->isConnected();
+    m_connectPending = false;
+    if (!connected) {
+        QMetaObject::invokeMethod(this, [this]() { onConnectionLost(); }, Qt::QueuedConnection);
+    }
+}
+
+void LiveSyncService::syncWorker() {
+    SyncOutcome outcome = SyncOutcome::Unchanged;
+    
+    if (!m_extractor->isGameActive()) {
+        outcome = SyncOutcome::Paused;
+    } else {
+        SyncMetrics::ScopedTimer timer(&m_metrics, SyncStage::Tick);
+        if (auto info = m_extractor->extractCharacter(); info && info->isValid()) {
+            // Nothing to refresh or save while the character stands still.
+            // No valid character data might just mean character select.
+            CharacterChangeSet changes = m_extractor->diffCharacter(*info);
+            if (changes.any()) {
+                publishSnapshot(std::make_unique<SyncSnapshot>(SyncSnapshot{std::move(*info), changes}));
+                outcome = SyncOutcome::Changed;
+            }
+        }
+    }
+    m_metrics.setReadStats(m_extractor->readStats());
+    
+    m_syncPending = false;
+    QMetaObject::invokeMethod(this, [this, outcome]() { onSyncFinished(outcome); },
+                              Qt::QueuedConnection);
+}
+
+void LiveSyncService::onSyncFinished(SyncOutcome outcome) {
+    if (!m_running || !m_connected) {
         return;
     }
     
-    auto info = m_extractor->extractCharacter();
-    if (!info || !info->isValid()) {
-        // No valid character data - might be at character select
+    if (outcome == SyncOutcome::Changed) {
+        m_syncInterval = m_minSyncInterval;
+    } else {
+        m_syncInterval = std::min(m_syncInterval * 2, m_maxSyncInterval);
+    }
+    m_syncTimer->start(m_syncInterval);
+    
+    emit metricsUpdated();
+}
+
+void LiveSyncService::publishSnapshot(std::unique_ptr<SyncSnapshot> snapshot) {
+    // Fold in whatever the GUI has not picked up, so no change is lost
+    if (auto missed = m_snapshot.take()) {
+        snapshot->changes.groups |= missed->changes.groups;
+    }
+    m_snapshot.publish(std::move(snapshot));
+    
+    if (!m_notifyPending.exchange(true)) {
+        QMetaObject::invokeMethod(this, [this]() { onSnapshotReady(); }, Qt::QueuedConnection);
+    }
+}
+
+void LiveSyncService::onSnapshotReady() {
+    StallScope stallScope("LiveSyncService::onSnapshotReady");
+    // Clear the flag first: a snapshot published after this point posts
+    // a fresh notification
+    m_notifyPending = false;
+    auto snapshot = m_snapshot.take();
+    if (!snapshot || !m_running) {
         return;
     }
     
-    emit characterUpdated(*info);
+    const CharacterInfo& info = snapshot->info;
+    const CharacterChangeSet& changes = snapshot->changes;
+    
+    emit characterUpdated(info);
+    if (m_liveFeed) {
+        LiveFeed::instance().publish(info, changes);
+    }
     
     // Check if character changed or leveled up
-    bool characterChanged = (info->name != m_lastCharacterName || 
-                            info->server != m_lastCharacterServer);
-    bool leveledUp = (info->level > m_lastLevel && !m_lastCharacterName.isEmpty());
+    bool characterChanged = (info.name != m_lastCharacterName || 
+                            info.server != m_lastCharacterServer);
+    bool leveledUp = (info.level > m_lastLevel && !m_lastCharacterName.isEmpty());
     
     if (characterChanged) {
         spdlog::info("Character changed: {} on {}", 
-                     info->name.toStdString(), info->server.toStdString());
+                     info.name.toStdString(), info.server.toStdString());
         
         // Auto-save on character change
-        autoSaveCharacter(*info);
+        autoSaveCharacter(info);
     } else if (leveledUp) {
         spdlog::info("Character {} leveled up to {}", 
-                     info->name.toStdString(), info->level);
+                     info.name.toStdString(), info.level);
         
         // Auto-save on level up
-        autoSaveCharacter(*info);
+        autoSaveCharacter(info);
+    } else if (changes.has(CharacterGroup::Identity) || changes.has(CharacterGroup::Account)) {
+        // Saved fields changed (class, race, account, destiny points)
+        autoSaveCharacter(info);
     }
     
     // Update tracking
-    m_lastCharacterName = info->name;
-    m_lastCharacterServer = info->server;
-    m_lastLevel = info->level;
+    m_lastCharacterName = info.name;
+    m_lastCharacterServer = info.server;
+    m_lastLevel = info.level;
 }
 
 void LiveSyncService::autoSaveCharacter(const CharacterInfo& info) {
@@ -185,10 +330,35 @@ void LiveSyncService::autoSaveCharacter(const CharacterInfo& info) {
     character.destinyPoints = info.destinyPoints;
     character.lastPlayed = std::chrono::system_clock::now();
     
-    m_tracker->saveCharacter(character);
+    // Replace any state of this character still waiting; the window runs
+    // from the first change, so a steady stream still saves once per delay
+    m_pendingSaves.insert({info.server, info.name}, character);
+    if (!m_saveTimer->isActive()) {
+        m_saveTimer->start(m_saveDelay);
+    }
+}
+
+void LiveSyncService::flushSaves() {
+    if (m_pendingSaves.isEmpty() || !m_tracker) {
+        return;
+    }
+    
+    QList<Character> batch = m_pendingSaves.values();
+    m_pendingSaves.clear();
     
-    emit characterSaved(info.name, info.server);
-    emit statusChanged(tr("Auto-saved: %1").arg(info.name));
+    CharacterTracker* tracker = m_tracker;
+    m_savePool.start([this, tracker, batch]() {
+        for (const Character& character : batch) {
+            {
+                SyncMetrics::ScopedTimer timer(&m_metrics, SyncStage::Save);
+                tracker->saveCharacter(character);
+            }
+            QMetaObject::invokeMethod(this, [this, name = character.name, server = character.server]() {
+                emit characterSaved(name, server);
+                emit statusChanged(tr("Auto-saved: %1").arg(name));
+            }, Qt::QueuedConnection);
+        }
+    });
 }
 
 } // namespace lotro
@@ -9,21 +9,44 @@
 
 #pragma once
 
+#include "CharacterExtractor.hpp"
+#include "CharacterTracker.hpp"
+#include "SnapshotSlot.hpp"
+#include "SyncMetrics.hpp"
+
+#include <QHash>
 #include <QObject>
+#include <QThread>
+#include <QThreadPool>
 #include <QTimer>
+#include <algorithm>
+#include <atomic>
 #include <memory>
 
 namespace lotro {
 
-class CharacterExtractor;
-class CharacterTracker;
-struct CharacterInfo;
-
 /**
  * Live synchronization service
  * 
  * Monitors the LOTRO client in the background and syncs
  * character data automatically when changes are detected.
+ * 
+ * The timers live on the GUI thread but only schedule work: connecting
+ * and every memory walk run on a dedicated worker thread that owns the
+ * extractor. A changed character is handed back through a SnapshotSlot
+ * and one queued notification, so the event loop never waits on the
+ * game process. Snapshots the GUI has not picked up yet are merged into
+ * the next one rather than queued.
+ * 
+ * Polling is adaptive: each snapshot identical to the last doubles the
+ * delay before the next one, up to the maximum interval, and any change
+ * drops it back to the minimum. While the client is minimized or stopped
+ * no memory is walked at all and the delay keeps backing off.
+ * 
+ * Autosaves are written behind: the newest state of each character is
+ * held for the save delay, so a burst of level-ups or currency changes
+ * becomes one write, and the batch is saved on a background thread.
+ * stop() flushes whatever is still pending.
  */
 class LiveSyncService : public QObject {
     Q_OBJECT
@@ -55,14 +78,45 @@ public:
     bool isConnected() const { return m_connected; }
     
     /**
-     * Set sync interval in milliseconds
+     * Sync at a fixed interval in milliseconds
+     */
+    void setSyncInterval(int ms) { setSyncIntervalBounds(ms, ms); }
+    
+    /**
+     * Set the adaptive sync bounds in milliseconds
+     * @param minMs Interval after a change
+     * @param maxMs Longest delay reached while idle
      */
-    void setSyncInterval(int ms);
+    void setSyncIntervalBounds(int minMs, int maxMs);
     
     /**
-     * Get current sync interval
+     * Get the delay before the next sync
      */
     int syncInterval() const { return m_syncInterval; }
+    
+    /**
+     * Stage timings and read counters since start()
+     */
+    const SyncMetrics& metrics() const { return m_metrics; }
+    
+    /**
+     * Set how long changes are collected before an autosave is written
+     */
+    void setSaveDelay(int ms) { m_saveDelay = std::max(ms, 0); }
+    int saveDelay() const { return m_saveDelay; }
+    
+    /**
+     * Have syncs copy only the client pages written since the previous
+     * sync, where the platform can tell (see ProcessMemory::enableDirtyTracking);
+     * applies from the next start()
+     */
+    void setDirtyPageTracking(bool enabled) { m_dirtyPageTracking = enabled; }
+    
+    /**
+     * Publish every synced character to the shared-memory LiveFeed;
+     * applies from the next start()
+     */
+    void setLiveFeed(bool enabled) { m_liveFeed = enabled; }
 
 signals:
     /**
@@ -89,24 +143,73 @@ signals:
      * Emitted with status updates
      */
     void statusChanged(const QString& status);
+    
+    /**
+     * Emitted after each sync once metrics() has been updated
+     */
+    void metricsUpdated();
 
 private slots:
     void onSyncTimer();
     void onConnectionCheck();
 
 private:
+    enum class SyncOutcome {
+        Changed,
+        Unchanged,
+        Paused      // Client minimized or stopped, nothing was read
+    };
+    
+    // Character that changed since the last snapshot the GUI took
+    struct SyncSnapshot {
+        CharacterInfo info;
+        CharacterChangeSet changes;
+    };
+    
+    // Run on the GUI thread
     void tryConnect();
-    void syncCharacter();
+    void requestSync();
+    void onConnectResult(bool connected);
+    void onConnectionLost();
+    void onSnapshotReady();
+    void onSyncFinished(SyncOutcome outcome);
     void autoSaveCharacter(const CharacterInfo& info);
+    void flushSaves();
+    
+    // Run on the worker thread
+    void connectWorker();
+    void checkConnectionWorker();
+    void syncWorker();
+    void publishSnapshot(std::unique_ptr<SyncSnapshot> snapshot);
     
+    // Only touched from the worker thread while it runs
     std::unique_ptr<CharacterExtractor> m_extractor;
     CharacterTracker* m_tracker = nullptr;
     
+    QThread m_workerThread;
+    QObject* m_worker = nullptr;            // Context for jobs on m_workerThread
+    std::atomic<bool> m_syncPending{false};     // A sync job is queued or running
+    std::atomic<bool> m_connectPending{false};  // A connect or check job is queued or running
+    
+    // Write-behind autosave: newest state per (server, name)
+    QTimer* m_saveTimer = nullptr;
+    QHash<std::pair<QString, QString>, Character> m_pendingSaves;
+    QThreadPool m_savePool;                 // One thread, so batches land in order
+    int m_saveDelay = 10000;
+    bool m_dirtyPageTracking = false;
+    bool m_liveFeed = false;
+    
+    SyncMetrics m_metrics;
+    SnapshotSlot<SyncSnapshot> m_snapshot;
+    std::atomic<bool> m_notifyPending{false};   // onSnapshotReady is queued
+    
     QTimer* m_syncTimer = nullptr;
     QTimer* m_connectionTimer = nullptr;
     
     QString m_gamePath;
-    int m_syncInterval = 5000;  // 5 seconds default
+    int m_minSyncInterval = 2000;
+    int m_maxSyncInterval = 60000;
+    int m_syncInterval = 2000;  // Current adaptive delay
     bool m_running = false;
     bool m_connected = false;
     
@@ -6,11 +6,176 @@
 
 #include "PatternScanner.hpp"
 
+#include <QThreadPool>
+#include <QtConcurrent>
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LOTRO_SCAN_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(LOTRO_SCAN_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define LOTRO_SCAN_SSE2 1
+#endif
+
+#if defined(LOTRO_SCAN_X86) && (defined(__GNUC__) || defined(__clang__))
+#define LOTRO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LOTRO_TARGET_AVX2
+#endif
 
 namespace lotro {
 
+namespace {
+
+// Distinct anchor bytes compared per vector; more fall back to a lookup table
+constexpr size_t MAX_VECTOR_ANCHORS = 8;
+
+bool cpuHasAvx2() {
+#if defined(LOTRO_SCAN_X86) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_cpu_supports("avx2");
+#elif defined(LOTRO_SCAN_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+template<typename OnHit>
+bool scanTable(const uint8_t* data, size_t begin, size_t size, const std::vector<uint8_t>& anchors, OnHit& onHit) {
+    std::array<bool, 256> isAnchor{};
+    for (uint8_t byte : anchors) {
+        isAnchor[byte] = true;
+    }
+    for (size_t pos = begin; pos < size; ++pos) {
+        if (isAnchor[data[pos]] && onHit(pos)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename OnHit>
+bool scanMemchr(const uint8_t* data, size_t size, uint8_t anchor, OnHit& onHit) {
+    const uint8_t* pos = data;
+    const uint8_t* end = data + size;
+    while (pos < end) {
+        pos = static_cast<const uint8_t*>(std::memchr(pos, anchor, static_cast<size_t>(end - pos)));
+        if (!pos) {
+            return false;
+        }
+        if (onHit(static_cast<size_t>(pos - data))) {
+            return true;
+        }
+        ++pos;
+    }
+    return false;
+}
+
+#ifdef LOTRO_SCAN_X86
+template<typename OnHit>
+LOTRO_TARGET_AVX2 bool scanAvx2(const uint8_t* data, size_t size, const std::vector<uint8_t>& anchors,
+                                OnHit& onHit) {
+    __m256i needles[MAX_VECTOR_ANCHORS];
+    const size_t count = anchors.size();
+    for (size_t k = 0; k < count; ++k) {
+        needles[k] = _mm256_set1_epi8(static_cast<char>(anchors[k]));
+    }
+    
+    size_t pos = 0;
+    for (; pos + 32 <= size; pos += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        __m256i hits = _mm256_cmpeq_epi8(chunk, needles[0]);
+        for (size_t k = 1; k < count; ++k) {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chunk, needles[k]));
+        }
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        while (bits != 0) {
+            if (onHit(pos + static_cast<size_t>(std::countr_zero(bits)))) {
+                return true;
+            }
+            bits &= bits - 1;
+        }
+    }
+    return scanTable(data, pos, size, anchors, onHit);
+}
+#endif
+
+#ifdef LOTRO_SCAN_SSE2
+template<typename OnHit>
+bool scanSse2(const uint8_t* data, size_t size, const std::vector<uint8_t>& anchors, OnHit& onHit) {
+    __m128i needles[MAX_VECTOR_ANCHORS];
+    const size_t count = anchors.size();
+    for (size_t k = 0; k < count; ++k) {
+        needles[k] = _mm_set1_epi8(static_cast<char>(anchors[k]));
+    }
+    
+    size_t pos = 0;
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i hits = _mm_cmpeq_epi8(chunk, needles[0]);
+        for (size_t k = 1; k < count; ++k) {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, needles[k]));
+        }
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        while (bits != 0) {
+            if (onHit(pos + static_cast<size_t>(std::countr_zero(bits)))) {
+                return true;
+            }
+            bits &= bits - 1;
+        }
+    }
+    return scanTable(data, pos, size, anchors, onHit);
+}
+#endif
+
+/**
+ * Call onHit(pos) for every position holding one of the anchor bytes, in
+ * order, until it returns true
+ */
+template<typename OnHit>
+void scanAnchors(std::span<const uint8_t> data, const std::vector<uint8_t>& anchors, OnHit& onHit) {
+    if (anchors.size() <= MAX_VECTOR_ANCHORS) {
+#ifdef LOTRO_SCAN_X86
+        static const bool hasAvx2 = cpuHasAvx2();
+        if (hasAvx2) {
+            scanAvx2(data.data(), data.size(), anchors, onHit);
+            return;
+        }
+#endif
+        if (anchors.size() == 1) {
+            scanMemchr(data.data(), data.size(), anchors.front(), onHit);
+            return;
+        }
+#ifdef LOTRO_SCAN_SSE2
+        scanSse2(data.data(), data.size(), anchors, onHit);
+        return;
+#endif
+    }
+    scanTable(data.data(), 0, data.size(), anchors, onHit);
+}
+
+} // anonymous namespace
+
 BytePattern BytePattern::fromString(const std::string& pattern) {
     BytePattern result;
     size_t i = 0;
@@ -33,13 +198,14 @@ BytePattern BytePattern::fromString(const std::string& pattern) {
             }
         } else {
             // Hex byte
-            if (i + 1 < pattern.length() && isxdigit(pattern[i]) && isxdigit(pattern[i+1])) {
-                std::string byteStr = pattern.substr(i, 2);
-                uint8_t byte = static_cast<uint8_t>(std::stoul(byteStr, nullptr, 16));
-                result.entries.push_back({byte, false});
+            int high = i + 1 < pattern.length() ? detail::hexValue(pattern[i]) : -1;
+            int low = high >= 0 ? detail::hexValue(pattern[i+1]) : -1;
+            if (low >= 0) {
+                result.entries.push_back({static_cast<uint8_t>(high * 16 + low), false});
                 i += 2;
             } else {
-                // Skip invalid char
+                // Skip invalid char; literals use operator""_pattern, which rejects these
+                spdlog::warn("Pattern \"{}\": skipping invalid character at {}", pattern, i);
                 i++;
             }
         }
@@ -47,31 +213,236 @@ BytePattern BytePattern::fromString(const std::string& pattern) {
     return result;
 }
 
-std::optional<size_t> PatternScanner::find(const std::vector<uint8_t>& data, const BytePattern& pattern) {
-    if (pattern.entries.empty() || data.size() < pattern.entries.size()) {
-        return std::nullopt;
+size_t PatternScanner::addPattern(const BytePattern& pattern) {
+    Compiled compiled;
+    compiled.bytes.reserve(pattern.entries.size());
+    compiled.mask.reserve(pattern.entries.size());
+    for (const auto& entry : pattern.entries) {
+        if (!entry.isWildcard) {
+            compiled.fixedOffsets.push_back(compiled.bytes.size());
+        }
+        compiled.bytes.push_back(entry.isWildcard ? 0 : entry.byte);
+        compiled.mask.push_back(entry.isWildcard ? 0 : 0xFF);
+    }
+    m_patterns.push_back(std::move(compiled));
+    return m_patterns.size() - 1;
+}
+
+size_t PatternScanner::addPattern(const std::string& patternStr) {
+    return addPattern(BytePattern::fromString(patternStr));
+}
+
+std::vector<std::optional<size_t>> PatternScanner::scan(std::span<const uint8_t> data) const {
+    return scanWith(makePlan(data), data);
+}
+
+std::vector<std::optional<size_t>> PatternScanner::scanStream(size_t totalSize, const ChunkReader& read,
+                                                              size_t chunkSize) const {
+    std::vector<std::optional<size_t>> results(m_patterns.size());
+    if (m_patterns.empty() || totalSize == 0) {
+        return results;
     }
     
-    for (size_t i = 0; i <= data.size() - pattern.entries.size(); ++i) {
-        bool match = true;
-        for (size_t j = 0; j < pattern.entries.size(); ++j) {
-            const auto& entry = pattern.entries[j];
-            if (!entry.isWildcard && data[i + j] != entry.byte) {
-                match = false;
-                break;
+    size_t longest = 0;
+    for (const Compiled& pattern : m_patterns) {
+        longest = std::max(longest, pattern.bytes.size());
+    }
+    const size_t overlap = longest > 0 ? longest - 1 : 0;
+    chunkSize = std::max<size_t>(chunkSize, 1);
+    
+    struct Slot {
+        std::vector<uint8_t> buffer;
+        size_t offset = 0;
+        bool busy = false;
+        QFuture<std::vector<std::optional<size_t>>> scan;
+    };
+    const int inFlight = std::clamp(QThreadPool::globalInstance()->maxThreadCount(), 1, MAX_CHUNKS_IN_FLIGHT);
+    std::vector<Slot> slots(static_cast<size_t>(inFlight));
+    
+    auto merge = [&results](Slot& slot) {
+        const auto found = slot.scan.result();
+        for (size_t i = 0; i < found.size(); ++i) {
+            if (found[i] && (!results[i] || slot.offset + *found[i] < *results[i])) {
+                results[i] = slot.offset + *found[i];
             }
         }
+        slot.busy = false;
+    };
+    auto allFound = [&results]() {
+        return std::all_of(results.begin(), results.end(), [](const auto& r) { return r.has_value(); });
+    };
+    
+    // Anchors come from the first chunk read; later chunks share the plan
+    std::optional<Plan> plan;
+    size_t next = 0;
+    size_t slotIndex = 0;
+    while (next < totalSize) {
+        // Reuse the oldest slot, waiting for its scan
+        Slot& slot = slots[slotIndex];
+        slotIndex = (slotIndex + 1) % slots.size();
+        if (slot.busy) {
+            merge(slot);
+        }
+        // Chunks start in order, so nothing further on can beat a match
+        if (allFound()) {
+            break;
+        }
         
-        if (match) {
-            return i;
+        slot.offset = next;
+        slot.buffer.assign(std::min(chunkSize + overlap, totalSize - next), 0);
+        next += chunkSize;
+        if (!read(slot.offset, slot.buffer)) {
+            spdlog::debug("Pattern scan: chunk at +0x{:X} unreadable, skipped", slot.offset);
+            continue;
+        }
+        
+        if (!plan) {
+            plan = makePlan(slot.buffer);
+        }
+        const Plan& shared = *plan;
+        slot.busy = true;
+        slot.scan = QtConcurrent::run([this, &shared, &slot]() {
+            return scanWith(shared, slot.buffer);
+        });
+    }
+    
+    for (Slot& slot : slots) {
+        if (slot.busy) {
+            merge(slot);
         }
     }
+    return results;
+}
+
+PatternScanner::Plan PatternScanner::makePlan(std::span<const uint8_t> sample) const {
+    Plan plan;
+    Histogram histogram = sampleHistogram(sample);
+    for (size_t i = 0; i < m_patterns.size(); ++i) {
+        const Compiled& pattern = m_patterns[i];
+        if (pattern.fixedOffsets.empty()) {
+            continue;
+        }
+        size_t anchor = chooseAnchor(pattern, histogram);
+        plan.active.push_back({pattern.bytes[anchor], anchor, i});
+    }
+    std::sort(plan.active.begin(), plan.active.end(), [](const Plan::Active& a, const Plan::Active& b) {
+        return a.anchorByte < b.anchorByte;
+    });
+    for (const Plan::Active& entry : plan.active) {
+        if (plan.anchors.empty() || plan.anchors.back() != entry.anchorByte) {
+            plan.anchors.push_back(entry.anchorByte);
+        }
+    }
+    return plan;
+}
+
+std::vector<std::optional<size_t>> PatternScanner::scanWith(const Plan& plan, std::span<const uint8_t> data) const {
+    std::vector<std::optional<size_t>> results(m_patterns.size());
+    for (size_t i = 0; i < m_patterns.size(); ++i) {
+        const Compiled& pattern = m_patterns[i];
+        if (pattern.fixedOffsets.empty() && !pattern.bytes.empty() && pattern.bytes.size() <= data.size()) {
+            results[i] = 0;   // All wildcards: matches anywhere
+        }
+    }
+    if (plan.active.empty()) {
+        return results;
+    }
+    
+    size_t remaining = plan.active.size();
+    auto onHit = [&](size_t pos) {
+        uint8_t byte = data[pos];
+        auto it = std::lower_bound(plan.active.begin(), plan.active.end(), byte,
+                                   [](const Plan::Active& a, uint8_t b) { return a.anchorByte < b; });
+        for (; it != plan.active.end() && it->anchorByte == byte; ++it) {
+            if (results[it->index] || pos < it->anchor) {
+                continue;
+            }
+            const Compiled& pattern = m_patterns[it->index];
+            size_t start = pos - it->anchor;
+            if (pattern.bytes.size() > data.size() - start) {
+                continue;
+            }
+            if (matchesAt(data.data() + start, pattern)) {
+                // Anchor hits come in order, so this is the pattern's first match
+                results[it->index] = start;
+                --remaining;
+            }
+        }
+        return remaining == 0;
+    };
+    scanAnchors(data, plan.anchors, onHit);
     
-    return std::nullopt;
+    return results;
+}
+
+bool PatternScanner::matches(size_t index, std::span<const uint8_t> data) const {
+    const Compiled& pattern = m_patterns[index];
+    return !pattern.bytes.empty() && data.size() >= pattern.bytes.size() && matchesAt(data.data(), pattern);
 }
 
-std::optional<size_t> PatternScanner::find(const std::vector<uint8_t>& data, const std::string& patternStr) {
+std::optional<size_t> PatternScanner::find(std::span<const uint8_t> data, const BytePattern& pattern) {
+    PatternScanner scanner;
+    scanner.addPattern(pattern);
+    return scanner.scan(data).front();
+}
+
+std::optional<size_t> PatternScanner::find(std::span<const uint8_t> data, const std::string& patternStr) {
     return find(data, BytePattern::fromString(patternStr));
 }
 
+PatternScanner::Histogram PatternScanner::sampleHistogram(std::span<const uint8_t> data) {
+    Histogram histogram{};
+    if (data.size() <= SAMPLE_CHUNKS * SAMPLE_CHUNK_SIZE) {
+        for (uint8_t byte : data) {
+            ++histogram[byte];
+        }
+        return histogram;
+    }
+    
+    // Evenly spaced chunks, so code, data and padding all get a say
+    size_t stride = (data.size() - SAMPLE_CHUNK_SIZE) / (SAMPLE_CHUNKS - 1);
+    for (size_t chunk = 0; chunk < SAMPLE_CHUNKS; ++chunk) {
+        const uint8_t* begin = data.data() + chunk * stride;
+        for (size_t i = 0; i < SAMPLE_CHUNK_SIZE; ++i) {
+            ++histogram[begin[i]];
+        }
+    }
+    return histogram;
+}
+
+size_t PatternScanner::chooseAnchor(const Compiled& pattern, const Histogram& histogram) {
+    size_t best = 0;
+    uint32_t bestCount = UINT32_MAX;
+    for (size_t offset : pattern.fixedOffsets) {
+        if (histogram[pattern.bytes[offset]] < bestCount) {
+            best = offset;
+            bestCount = histogram[pattern.bytes[offset]];
+        }
+    }
+    return best;
+}
+
+bool PatternScanner::matchesAt(const uint8_t* data, const Compiled& pattern) {
+    const size_t size = pattern.bytes.size();
+    const uint8_t* bytes = pattern.bytes.data();
+    const uint8_t* mask = pattern.mask.data();
+    
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t value, expected, bits;
+        std::memcpy(&value, data + i, 8);
+        std::memcpy(&expected, bytes + i, 8);
+        std::memcpy(&bits, mask + i, 8);
+        if ((value ^ expected) & bits) {
+            return false;
+        }
+    }
+    for (; i < size; ++i) {
+        if ((data[i] ^ bytes[i]) & mask[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace lotro
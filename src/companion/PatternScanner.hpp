@@ -9,13 +9,144 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <functional>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace lotro {
 
+namespace detail {
+
+constexpr int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// Signature text carried as a template argument
+template<size_t L>
+struct PatternText {
+    char chars[L]{};
+    
+    consteval PatternText(const char (&text)[L]) {
+        for (size_t i = 0; i < L; ++i) {
+            chars[i] = text[i];
+        }
+    }
+    
+    constexpr std::string_view view() const { return {chars, L - 1}; }
+};
+
+/**
+ * Walk a signature in the fromString() syntax, calling sink(byte, fixed)
+ * per pattern byte. Anything else in the text throws, which turns a
+ * constant evaluation into a compile error.
+ */
+template<typename Sink>
+constexpr void parsePattern(std::string_view text, Sink&& sink) {
+    size_t i = 0;
+    while (i < text.size()) {
+        if (text[i] == '?') {
+            int hole = 1;
+            if (i + 1 < text.size() && text[i + 1] >= '0' && text[i + 1] <= '9') {
+                hole = text[i + 1] - '0' + 1;
+                ++i;
+            }
+            ++i;
+            for (int j = 0; j < hole; ++j) {
+                sink(uint8_t{0}, false);
+            }
+        } else {
+            if (i + 1 >= text.size() || hexValue(text[i]) < 0 || hexValue(text[i + 1]) < 0) {
+                throw "signature holds something other than hex byte pairs and ?n wildcards";
+            }
+            sink(static_cast<uint8_t>(hexValue(text[i]) * 16 + hexValue(text[i + 1])), true);
+            i += 2;
+        }
+    }
+}
+
+struct PatternShape {
+    size_t size = 0;
+    size_t fixed = 0;
+};
+
+consteval PatternShape patternShape(std::string_view text) {
+    PatternShape shape;
+    parsePattern(text, [&shape](uint8_t, bool fixed) {
+        ++shape.size;
+        shape.fixed += fixed ? 1 : 0;
+    });
+    if (shape.fixed == 0) {
+        throw "signature has no fixed bytes";
+    }
+    return shape;
+}
+
+} // namespace detail
+
+/**
+ * Byte pattern parsed at compile time, see operator""_pattern
+ */
+template<size_t N, size_t Fixed>
+struct StaticPattern {
+    std::array<uint8_t, N> bytes{};         // Wildcards are 0
+    std::array<uint8_t, N> mask{};          // 0xFF for fixed bytes, 0 for wildcards
+    std::array<size_t, Fixed> fixedOffsets{};  // Anchor candidates, in order
+    const char* text = nullptr;             // The signature as written
+    
+    static constexpr size_t size() { return N; }
+    
+    constexpr bool matches(std::span<const uint8_t> data) const {
+        if (data.size() < N) {
+            return false;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            if ((data[i] ^ bytes[i]) & mask[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * Signature literal, e.g. "4883EC28?3488D0D"_pattern
+ * 
+ * Same syntax as BytePattern::fromString(), but parsed by the compiler
+ * into fixed-size byte and mask arrays, so a malformed signature fails
+ * the build instead of having characters skipped at runtime.
+ */
+template<detail::PatternText Text>
+consteval auto operator""_pattern() {
+    constexpr detail::PatternShape shape = detail::patternShape(Text.view());
+    StaticPattern<shape.size, shape.fixed> result;
+    result.text = Text.chars;
+    size_t pos = 0;
+    size_t fixed = 0;
+    detail::parsePattern(Text.view(), [&](uint8_t byte, bool isFixed) {
+        if (isFixed) {
+            result.bytes[pos] = byte;
+            result.mask[pos] = 0xFF;
+            result.fixedOffsets[fixed++] = pos;
+        }
+        ++pos;
+    });
+    return result;
+}
+
 /**
  * Byte pattern for scanning
  */
@@ -38,20 +169,129 @@ struct BytePattern {
 };
 
 /**
- * Pattern scanner
+ * Multi-pattern scanner
+ * 
+ * Patterns are compiled into byte/mask arrays plus one anchor: the fixed
+ * byte that is rarest in the scanned data, estimated from a sample. A
+ * single pass over the buffer looks for every pattern's anchor at once
+ * (32 or 16 bytes per compare with AVX2/SSE2, memchr for a lone pattern
+ * elsewhere), and each anchor hit is verified with 8-byte masked compares.
+ * Each pattern reports its first match, as the old per-pattern loop did.
+ * 
+ * scanStream() does the same over a range it never holds in full: chunks
+ * are pulled through a reader on the calling thread and scanned on the
+ * global thread pool while the next ones are read.
  */
 class PatternScanner {
 public:
+    /**
+     * Add a pattern to look for
+     * @return Index of the pattern in scan() results
+     */
+    size_t addPattern(const BytePattern& pattern);
+    size_t addPattern(const std::string& patternStr);
+    
+    template<size_t N, size_t Fixed>
+    size_t addPattern(const StaticPattern<N, Fixed>& pattern) {
+        Compiled compiled;
+        compiled.bytes.assign(pattern.bytes.begin(), pattern.bytes.end());
+        compiled.mask.assign(pattern.mask.begin(), pattern.mask.end());
+        compiled.fixedOffsets.assign(pattern.fixedOffsets.begin(), pattern.fixedOffsets.end());
+        m_patterns.push_back(std::move(compiled));
+        return m_patterns.size() - 1;
+    }
+    
+    size_t patternCount() const { return m_patterns.size(); }
+    size_t patternLength(size_t index) const { return m_patterns[index].bytes.size(); }
+    
+    /**
+     * Check whether a pattern matches at the start of data
+     */
+    bool matches(size_t index, std::span<const uint8_t> data) const;
+    
+    /**
+     * Find every added pattern in one pass
+     * @return First match offset per pattern, nullopt where not found
+     */
+    std::vector<std::optional<size_t>> scan(std::span<const uint8_t> data) const;
+    
+    /**
+     * Fills a chunk of the scanned range at an offset, returns false if it
+     * could not be read
+     */
+    using ChunkReader = std::function<bool(size_t offset, std::span<uint8_t> out)>;
+    
+    /**
+     * Find every added pattern in a range read chunk by chunk
+     * 
+     * Chunks overlap by the longest pattern minus one byte, so matches
+     * spanning a boundary are still found. At most MAX_CHUNKS_IN_FLIGHT
+     * chunks are held at once, and reading stops once every pattern has
+     * matched. Unreadable chunks are skipped.
+     * @param totalSize Size of the range
+     * @param read Called on the calling thread, in offset order
+     * @return First match offset per pattern, nullopt where not found
+     */
+    std::vector<std::optional<size_t>> scanStream(size_t totalSize, const ChunkReader& read,
+                                                  size_t chunkSize = DEFAULT_CHUNK_SIZE) const;
+    
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+    static constexpr int MAX_CHUNKS_IN_FLIGHT = 4;
+    
     /**
      * Scan buffer for pattern
      * @return Offset of match, or nullopt if not found
      */
-    static std::optional<size_t> find(const std::vector<uint8_t>& data, const BytePattern& pattern);
+    static std::optional<size_t> find(std::span<const uint8_t> data, const BytePattern& pattern);
     
     /**
      * Scan buffer for pattern string
      */
-    static std::optional<size_t> find(const std::vector<uint8_t>& data, const std::string& patternStr);
+    static std::optional<size_t> find(std::span<const uint8_t> data, const std::string& patternStr);
+    
+    template<size_t N, size_t Fixed>
+    static std::optional<size_t> find(std::span<const uint8_t> data, const StaticPattern<N, Fixed>& pattern) {
+        PatternScanner scanner;
+        scanner.addPattern(pattern);
+        return scanner.scan(data).front();
+    }
+    
+private:
+    struct Compiled {
+        std::vector<uint8_t> bytes;   // Wildcards are 0
+        std::vector<uint8_t> mask;    // 0xFF for fixed bytes, 0 for wildcards
+        std::vector<size_t> fixedOffsets;   // Where mask is set
+    };
+    
+    // Patterns that need the anchor search, sorted by anchor byte
+    struct Plan {
+        struct Active {
+            uint8_t anchorByte;
+            size_t anchor;
+            size_t index;
+        };
+        std::vector<Active> active;
+        std::vector<uint8_t> anchors;   // Distinct anchor bytes
+    };
+    
+    using Histogram = std::array<uint32_t, 256>;
+    
+    static constexpr size_t SAMPLE_CHUNKS = 64;
+    static constexpr size_t SAMPLE_CHUNK_SIZE = 4096;
+    
+    // Byte frequencies over a spread-out sample of the data
+    static Histogram sampleHistogram(std::span<const uint8_t> data);
+    
+    // Choose the rarest fixed byte of a pattern as its anchor
+    static size_t chooseAnchor(const Compiled& pattern, const Histogram& histogram);
+    
+    static bool matchesAt(const uint8_t* data, const Compiled& pattern);
+    
+    // Choose anchors from a sample of the data to be scanned
+    Plan makePlan(std::span<const uint8_t> sample) const;
+    std::vector<std::optional<size_t>> scanWith(const Plan& plan, std::span<const uint8_t> data) const;
+    
+    std::vector<Compiled> m_patterns;
 };
 
 } // namespace lotro
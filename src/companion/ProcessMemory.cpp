@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cstring>
 #include <fstream>
+#include <map>
 #include <regex>
 
 #ifdef _WIN32
@@ -18,6 +19,7 @@
 #include <tlhelp32.h>
 #include <psapi.h>
 #else
+#include <climits>
 #include <dirent.h>
 #include <fcntl.h>
 #include <sys/ptrace.h>
@@ -29,44 +31,31 @@
 namespace lotro {
 
 // ============================================================================
-// MemoryBuffer implementation
+// MemoryView / MemoryBuffer / MemoryBatch implementation
 // ============================================================================
 
-MemoryBuffer::MemoryBuffer(size_t size)
-    : m_data(size, 0)
-{
-}
-
-uint64_t MemoryBuffer::readPointer(size_t offset, bool is64Bit) const {
-    if (is64Bit) {
-        return read<uint64_t>(offset);
-    } else {
-        return read<uint32_t>(offset);
-    }
-}
-
-std::string MemoryBuffer::readString(size_t offset, size_t maxLen) const {
-    if (offset >= m_data.size()) {
+std::string MemoryView::readString(size_t offset, size_t maxLen) const {
+    if (offset >= m_size) {
         return "";
     }
     
     size_t len = 0;
-    while (offset + len < m_data.size() && len < maxLen && m_data[offset + len] != 0) {
+    while (offset + len < m_size && len < maxLen && m_data[offset + len] != 0) {
         ++len;
     }
     
-    return std::string(reinterpret_cast<const char*>(m_data.data() + offset), len);
+    return std::string(reinterpret_cast<const char*>(m_data + offset), len);
 }
 
-std::wstring MemoryBuffer::readWideString(size_t offset, size_t maxLen) const {
-    if (offset >= m_data.size()) {
+std::wstring MemoryView::readWideString(size_t offset, size_t maxLen) const {
+    if (offset >= m_size) {
         return L"";
     }
     
     std::wstring result;
     size_t chars = 0;
     
-    while (offset + chars * 2 + 1 < m_data.size() && chars < maxLen) {
+    while (offset + chars * 2 + 1 < m_size && chars < maxLen) {
         wchar_t ch = read<uint16_t>(offset + chars * 2);
         if (ch == 0) break;
         result += ch;
@@ -76,15 +65,126 @@ std::wstring MemoryBuffer::readWideString(size_t offset, size_t maxLen) const {
     return result;
 }
 
+MemoryBuffer::MemoryBuffer(size_t size)
+    : m_size(size)
+{
+    if (size <= INLINE_CAPACITY) {
+        std::memset(m_inline.data(), 0, size);
+    } else {
+        m_heap.assign(size, 0);
+    }
+}
+
+void MemoryBatch::clear() {
+    m_reads.clear();
+    m_offsets.clear();
+    m_used = 0;
+}
+
+size_t MemoryBatch::add(uint64_t address, size_t size) {
+    m_reads.push_back({address, size});
+    m_offsets.push_back(m_used);
+    // Keep regions 8-byte aligned within the storage
+    m_used += (size + 7) & ~size_t(7);
+    return m_reads.size() - 1;
+}
+
+size_t MemoryBatch::run(ProcessMemory& memory) {
+    if (m_storage.size() < m_used) {
+        m_storage.resize(m_used);
+    }
+    std::memset(m_storage.data(), 0, m_used);
+    for (size_t i = 0; i < m_reads.size(); ++i) {
+        m_reads[i].destination = m_storage.data() + m_offsets[i];
+    }
+    return memory.readBatch(m_reads);
+}
+
 // ============================================================================
 // ProcessMemory implementation - Platform specific
 // ============================================================================
 
 class ProcessMemory::Impl {
 public:
-    // Platform specific implementation details
+    // Captured or replayed memory: disjoint regions by start address
+    std::map<uint64_t, std::vector<uint8_t>> regions;
+    std::map<std::string, ModuleInfo> modules;      // By lower-case name
+    std::map<std::string, std::string> notes;
+    bool recording = false;
+    bool replaying = false;
+    
+    void clear() {
+        regions.clear();
+        modules.clear();
+        notes.clear();
+    }
+    
+    void record(uint64_t address, const uint8_t* data, size_t size);
+    
+    // Copy what the capture holds from address on, up to size bytes
+    size_t replay(uint64_t address, size_t size, uint8_t* destination) const;
 };
 
+void ProcessMemory::Impl::record(uint64_t address, const uint8_t* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    const uint64_t end = address + size;
+    
+    // Most reads re-read part of one region: refresh its bytes in place
+    auto it = regions.upper_bound(address);
+    if (it != regions.begin()) {
+        auto before = std::prev(it);
+        uint64_t beforeEnd = before->first + before->second.size();
+        if (beforeEnd >= end) {
+            std::memcpy(before->second.data() + (address - before->first), data, size);
+            return;
+        }
+        if (beforeEnd > address) {
+            it = before;
+        }
+    }
+    
+    // Otherwise merge every region the read overlaps, its bytes on top
+    auto first = it;
+    uint64_t start = address;
+    uint64_t last = end;
+    for (; it != regions.end() && it->first < end; ++it) {
+        start = std::min(start, it->first);
+        last = std::max<uint64_t>(last, it->first + it->second.size());
+    }
+    std::vector<uint8_t> merged(static_cast<size_t>(last - start));
+    for (auto region = first; region != it; ++region) {
+        std::memcpy(merged.data() + (region->first - start), region->second.data(), region->second.size());
+    }
+    std::memcpy(merged.data() + (address - start), data, size);
+    regions.erase(first, it);
+    regions.emplace(start, std::move(merged));
+}
+
+size_t ProcessMemory::Impl::replay(uint64_t address, size_t size, uint8_t* destination) const {
+    auto it = regions.upper_bound(address);
+    if (it == regions.begin()) {
+        return 0;
+    }
+    --it;
+    
+    // Adjacent regions are kept apart, so a read may continue into the next
+    size_t served = 0;
+    while (served < size && it != regions.end()) {
+        uint64_t current = address + served;
+        if (current < it->first || current >= it->first + it->second.size()) {
+            break;
+        }
+        size_t offset = static_cast<size_t>(current - it->first);
+        size_t chunk = std::min(size - served, it->second.size() - offset);
+        std::memcpy(destination + served, it->second.data() + offset, chunk);
+        served += chunk;
+        ++it;
+    }
+    return served;
+}
+
 ProcessMemory::ProcessMemory()
     : m_impl(std::make_unique<Impl>())
 {
@@ -186,10 +286,45 @@ void ProcessMemory::close() {
         m_handle = nullptr;
     }
     m_processInfo = ProcessInfo{};
+    m_stats = ReadStats{};
+    m_modules.clear();
+    clearPages();
+    endReplay();
 }
 
 bool ProcessMemory::isOpen() const {
-    return m_handle != nullptr;
+    return m_handle != nullptr || isReplaying();
+}
+
+bool ProcessMemory::isActive() const {
+    if (!isOpen()) {
+        return false;
+    }
+    if (isReplaying()) {
+        return true;
+    }
+    
+    struct WindowState {
+        DWORD pid;
+        bool anyVisible = false;
+        bool anyRestored = false;
+    } state{static_cast<DWORD>(m_processInfo.pid)};
+    
+    EnumWindows([](HWND hwnd, LPARAM param) -> BOOL {
+        auto* state = reinterpret_cast<WindowState*>(param);
+        DWORD windowPid = 0;
+        GetWindowThreadProcessId(hwnd, &windowPid);
+        if (windowPid == state->pid && IsWindowVisible(hwnd)) {
+            state->anyVisible = true;
+            if (!IsIconic(hwnd)) {
+                state->anyRestored = true;
+                return FALSE;
+            }
+        }
+        return TRUE;
+    }, reinterpret_cast<LPARAM>(&state));
+    
+    return !state.anyVisible || state.anyRestored;
 }
 
 std::optional<uint64_t> ProcessMemory::getModuleBaseAddress(const std::string& moduleName) {
@@ -200,39 +335,68 @@ std::optional<uint64_t> ProcessMemory::getModuleBaseAddress(const std::string& m
     return std::nullopt;
 }
 
-std::optional<ProcessMemory::ModuleInfo> ProcessMemory::getModuleEx(const std::string& moduleName) {
+std::optional<ProcessMemory::ModuleInfo> ProcessMemory::findModule(const std::string& moduleName) {
     if (!isOpen()) {
         return std::nullopt;
     }
     
-    HMODULE modules[1024];
-    DWORD cbNeeded;
-    
-    if (EnumProcessModulesEx(m_handle, modules, sizeof(modules), &cbNeeded, LIST_MODULES_ALL)) {
-        for (unsigned int i = 0; i < (cbNeeded / sizeof(HMODULE)); i++) {
-            char szModName[MAX_PATH];
-            
-            if (GetModuleBaseNameA(m_handle, modules[i], szModName, sizeof(szModName))) {
-                if (_stricmp(szModName, moduleName.c_str()) == 0) {
-                    MODULEINFO modInfo;
-                    if (GetModuleInformation(m_handle, modules[i], &modInfo, sizeof(modInfo))) {
-                        ModuleInfo result;
-                        result.baseAddress = reinterpret_cast<uint64_t>(modInfo.lpBaseOfDll);
-                        result.size = modInfo.SizeOfImage;
-                        spdlog::info("Module {} found: Base=0x{:X}, Size=0x{:X}", 
-                                     moduleName, result.baseAddress, result.size);
-                        return result;
-                    }
-                }
+    auto lookup = [this, &moduleName]() -> const ModuleInfo* {
+        for (const CachedModule& module : m_modules) {
+            if (_stricmp(module.name.c_str(), moduleName.c_str()) == 0) {
+                return &module.info;
             }
         }
+        return nullptr;
+    };
+    
+    const ModuleInfo* found = lookup();
+    if (!found) {
+        // Not loaded when we last looked, or never enumerated
+        refreshModules();
+        found = lookup();
+    }
+    
+    if (found) {
+        spdlog::info("Module {} found: Base=0x{:X}, Size=0x{:X}", 
+                     moduleName, found->baseAddress, found->size);
+        return *found;
     }
     
     spdlog::error("Module {} not found", moduleName);
     return std::nullopt;
 }
 
-std::optional<MemoryBuffer> ProcessMemory::readMemory(uint64_t address, size_t size) {
+void ProcessMemory::refreshModules() {
+    m_modules.clear();
+    
+    HMODULE modules[1024];
+    DWORD cbNeeded;
+    
+    if (!EnumProcessModulesEx(m_handle, modules, sizeof(modules), &cbNeeded, LIST_MODULES_ALL)) {
+        spdlog::debug("EnumProcessModulesEx failed: error {}", GetLastError());
+        return;
+    }
+    
+    size_t count = std::min<size_t>(cbNeeded / sizeof(HMODULE), std::size(modules));
+    for (size_t i = 0; i < count; i++) {
+        char szModName[MAX_PATH];
+        MODULEINFO modInfo;
+        
+        if (GetModuleBaseNameA(m_handle, modules[i], szModName, sizeof(szModName))
+            && GetModuleInformation(m_handle, modules[i], &modInfo, sizeof(modInfo))) {
+            CachedModule module;
+            module.name = szModName;
+            module.info.baseAddress = reinterpret_cast<uint64_t>(modInfo.lpBaseOfDll);
+            module.info.size = modInfo.SizeOfImage;
+            m_modules.push_back(std::move(module));
+        }
+    }
+}
+
+std::optional<MemoryBuffer> ProcessMemory::readMemoryDirect(uint64_t address, size_t size) {
+    if (isReplaying()) {
+        return replayMemory(address, size);
+    }
     if (!isOpen()) {
         return std::nullopt;
     }
@@ -240,8 +404,12 @@ std::optional<MemoryBuffer> ProcessMemory::readMemory(uint64_t address, size_t s
     MemoryBuffer buffer(size);
     SIZE_T bytesRead = 0;
     
-    if (!ReadProcessMemory(m_handle, reinterpret_cast<LPCVOID>(address), 
-                          buffer.data(), size, &bytesRead)) {
+    BOOL readOk = ReadProcessMemory(m_handle, reinterpret_cast<LPCVOID>(address), 
+                                    buffer.data(), size, &bytesRead);
+    ++m_stats.syscalls;
+    m_stats.remoteBytes += bytesRead;
+    recordRead(address, buffer.data(), bytesRead);
+    if (!readOk) {
         DWORD error = GetLastError();
         if (error != 299) { // Partial read OK
             spdlog::debug("ReadProcessMemory failed at 0x{:X}: error {}", address, error);
@@ -254,6 +422,95 @@ std::optional<MemoryBuffer> ProcessMemory::readMemory(uint64_t address, size_t s
     return buffer;
 }
 
+size_t ProcessMemory::readBatchDirect(std::span<MemoryRead> reads) {
+    if (isReplaying()) {
+        return replayBatch(reads);
+    }
+    for (MemoryRead& read : reads) {
+        read.ok = false;
+    }
+    if (!isOpen()) {
+        return 0;
+    }
+    
+    auto readOne = [this](MemoryRead& read) -> size_t {
+        SIZE_T bytesRead = 0;
+        read.ok = ReadProcessMemory(m_handle, reinterpret_cast<LPCVOID>(read.address),
+                                    read.destination, read.size, &bytesRead) || bytesRead > 0;
+        ++m_stats.syscalls;
+        m_stats.remoteBytes += bytesRead;
+        recordRead(read.address, read.destination, bytesRead);
+        return read.ok ? 1 : 0;
+    };
+    
+    // Walk the regions in address order so neighbours can share a call
+    m_readOrder.clear();
+    for (size_t i = 0; i < reads.size(); ++i) {
+        if (reads[i].size > 0) {
+            m_readOrder.push_back(i);
+        }
+    }
+    std::sort(m_readOrder.begin(), m_readOrder.end(), [&reads](size_t a, size_t b) {
+        return reads[a].address < reads[b].address;
+    });
+    
+    size_t completed = 0;
+    size_t next = 0;
+    while (next < m_readOrder.size()) {
+        // Extend the span while the next region starts within the gap
+        size_t first = next;
+        uint64_t start = reads[m_readOrder[first]].address;
+        uint64_t end = start + reads[m_readOrder[first]].size;
+        for (++next; next < m_readOrder.size(); ++next) {
+            const MemoryRead& read = reads[m_readOrder[next]];
+            uint64_t readEnd = std::max(end, read.address + read.size);
+            if (read.address > end + COALESCE_GAP || readEnd - start > MAX_CACHED_READ) {
+                break;
+            }
+            end = readEnd;
+        }
+        
+        if (next - first == 1) {
+            completed += readOne(reads[m_readOrder[first]]);
+            continue;
+        }
+        
+        m_coalesceBuffer.resize(end - start);
+        SIZE_T bytesRead = 0;
+        bool whole = ReadProcessMemory(m_handle, reinterpret_cast<LPCVOID>(start),
+                                       m_coalesceBuffer.data(), m_coalesceBuffer.size(), &bytesRead)
+                     && bytesRead == m_coalesceBuffer.size();
+        ++m_stats.syscalls;
+        m_stats.remoteBytes += bytesRead;
+        for (size_t i = first; i < next; ++i) {
+            MemoryRead& read = reads[m_readOrder[i]];
+            if (whole) {
+                std::memcpy(read.destination, m_coalesceBuffer.data() + (read.address - start), read.size);
+                recordRead(read.address, read.destination, read.size);
+                read.ok = true;
+                ++completed;
+            } else {
+                // Part of the span is unmapped: fall back to region by region
+                completed += readOne(read);
+            }
+        }
+    }
+    return completed;
+}
+
+bool ProcessMemory::enableDirtyTracking() {
+    // No way to see another process's written pages without debugging it
+    return false;
+}
+
+bool ProcessMemory::clearSoftDirty() {
+    return false;
+}
+
+bool ProcessMemory::queryDirtyPages(std::span<const PageEntry>, std::vector<uint8_t>&) {
+    return false;
+}
+
 #else
 // ============================================================================
 // Linux Implementation (for Wine processes)
@@ -378,15 +635,44 @@ bool ProcessMemory::open(uint64_t pid) {
 }
 
 void ProcessMemory::close() {
+    stopDirtyTracking();
     if (m_memFd >= 0) {
         ::close(m_memFd);
         m_memFd = -1;
     }
     m_processInfo = ProcessInfo{};
+    m_stats = ReadStats{};
+    clearPages();
+    endReplay();
 }
 
 bool ProcessMemory::isOpen() const {
-    return m_memFd >= 0;
+    return m_memFd >= 0 || isReplaying();
+}
+
+bool ProcessMemory::isActive() const {
+    if (!isOpen()) {
+        return false;
+    }
+    if (isReplaying()) {
+        return true;
+    }
+    
+    // The state letter follows the parenthesised command name, which may
+    // itself contain spaces or parentheses
+    std::ifstream stat("/proc/" + std::to_string(m_processInfo.pid) + "/stat");
+    std::string line;
+    if (!std::getline(stat, line)) {
+        return true;
+    }
+    size_t pos = line.rfind(')');
+    if (pos == std::string::npos || pos + 2 >= line.size()) {
+        return true;
+    }
+    
+    // T = stopped by a signal, t = stopped by a tracer
+    char state = line[pos + 2];
+    return state != 'T' && state != 't';
 }
 
 std::optional<uint64_t> ProcessMemory::getModuleBaseAddress(const std::string& moduleName) {
@@ -397,7 +683,7 @@ std::optional<uint64_t> ProcessMemory::getModuleBaseAddress(const std::string& m
     return std::nullopt;
 }
 
-std::optional<ProcessMemory::ModuleInfo> ProcessMemory::getModuleEx(const std::string& moduleName) {
+std::optional<ProcessMemory::ModuleInfo> ProcessMemory::findModule(const std::string& moduleName) {
     if (!isOpen()) {
         return std::nullopt;
     }
@@ -474,7 +760,10 @@ std::optional<ProcessMemory::ModuleInfo> ProcessMemory::getModuleEx(const std::s
     return std::nullopt;
 }
 
-std::optional<MemoryBuffer> ProcessMemory::readMemory(uint64_t address, size_t size) {
+std::optional<MemoryBuffer> ProcessMemory::readMemoryDirect(uint64_t address, size_t size) {
+    if (isReplaying()) {
+        return replayMemory(address, size);
+    }
     if (!isOpen()) {
         return std::nullopt;
     }
@@ -491,21 +780,430 @@ std::optional<MemoryBuffer> ProcessMemory::readMemory(uint64_t address, size_t s
     remote.iov_len = size;
     
     ssize_t nread = process_vm_readv(m_processInfo.pid, &local, 1, &remote, 1, 0);
+    ++m_stats.syscalls;
     
     if (nread < 0) {
         spdlog::debug("process_vm_readv failed at 0x{:X}: {}", address, strerror(errno));
         return std::nullopt;
     }
+    m_stats.remoteBytes += static_cast<uint64_t>(nread);
+    recordRead(address, buffer.data(), static_cast<size_t>(nread));
     
     return buffer;
 }
 
+size_t ProcessMemory::readBatchDirect(std::span<MemoryRead> reads) {
+    if (isReplaying()) {
+        return replayBatch(reads);
+    }
+    for (MemoryRead& read : reads) {
+        read.ok = false;
+    }
+    if (!isOpen()) {
+        return 0;
+    }
+    
+    const pid_t pid = static_cast<pid_t>(m_processInfo.pid);
+    std::vector<struct iovec>& local = m_localIov;
+    std::vector<struct iovec>& remote = m_remoteIov;
+    size_t completed = 0;
+    size_t next = 0;
+    
+    while (next < reads.size()) {
+        // Gather up to IOV_MAX non-empty regions
+        local.clear();
+        remote.clear();
+        size_t first = next;
+        size_t end = next;
+        while (end < reads.size() && local.size() < IOV_MAX) {
+            MemoryRead& read = reads[end++];
+            if (read.size == 0) {
+                continue;
+            }
+            local.push_back({read.destination, read.size});
+            remote.push_back({reinterpret_cast<void*>(read.address), read.size});
+        }
+        if (local.empty()) {
+            break;
+        }
+        
+        ssize_t nread = process_vm_readv(pid, local.data(), local.size(), remote.data(), remote.size(), 0);
+        size_t transferred = nread > 0 ? static_cast<size_t>(nread) : 0;
+        ++m_stats.syscalls;
+        m_stats.remoteBytes += transferred;
+        
+        // Mark the regions the kernel got through
+        size_t index = first;
+        for (; index < end; ++index) {
+            MemoryRead& read = reads[index];
+            if (read.size == 0) {
+                continue;
+            }
+            if (transferred < read.size) {
+                break;
+            }
+            transferred -= read.size;
+            recordRead(read.address, read.destination, read.size);
+            read.ok = true;
+            ++completed;
+        }
+        
+        if (index == end) {
+            next = end;
+            continue;
+        }
+        
+        // The kernel stopped at this region: retry it alone (a partial read
+        // counts, as in readMemory) and carry on with the rest
+        MemoryRead& failed = reads[index];
+        struct iovec one = {failed.destination, failed.size};
+        struct iovec remoteOne = {reinterpret_cast<void*>(failed.address), failed.size};
+        ssize_t retried = process_vm_readv(pid, &one, 1, &remoteOne, 1, 0);
+        ++m_stats.syscalls;
+        if (retried > 0) {
+            m_stats.remoteBytes += static_cast<uint64_t>(retried);
+            recordRead(failed.address, failed.destination, static_cast<size_t>(retried));
+            failed.ok = true;
+            ++completed;
+        }
+        next = index + 1;
+    }
+    
+    return completed;
+}
+
+bool ProcessMemory::enableDirtyTracking() {
+    if (m_dirtyTracking) {
+        return true;
+    }
+    if (m_memFd < 0) {
+        return false;
+    }
+    
+    const std::string procPath = "/proc/" + std::to_string(m_processInfo.pid);
+    m_pagemapFd = ::open((procPath + "/pagemap").c_str(), O_RDONLY | O_CLOEXEC);
+    m_clearRefsFd = ::open((procPath + "/clear_refs").c_str(), O_WRONLY | O_CLOEXEC);
+    if (m_pagemapFd < 0 || m_clearRefsFd < 0) {
+        spdlog::warn("Dirty page tracking unavailable: {}", strerror(errno));
+        stopDirtyTracking();
+        return false;
+    }
+    // Fails with EINVAL on kernels built without soft-dirty support
+    if (!clearSoftDirty()) {
+        spdlog::warn("Dirty page tracking unavailable: clearing soft-dirty bits failed: {}", strerror(errno));
+        stopDirtyTracking();
+        return false;
+    }
+    
+    // Pages cached before the clear can't be vouched for
+    clearPages();
+    m_dirtyTracking = true;
+    spdlog::info("Tracking pages written by process {}", m_processInfo.pid);
+    return true;
+}
+
+void ProcessMemory::stopDirtyTracking() {
+    if (m_pagemapFd >= 0) {
+        ::close(m_pagemapFd);
+        m_pagemapFd = -1;
+    }
+    if (m_clearRefsFd >= 0) {
+        ::close(m_clearRefsFd);
+        m_clearRefsFd = -1;
+    }
+    m_dirtyTracking = false;
+}
+
+bool ProcessMemory::clearSoftDirty() {
+    // "4" clears the soft-dirty bit of every page of the process
+    ++m_stats.syscalls;
+    return ::write(m_clearRefsFd, "4", 1) == 1;
+}
+
+bool ProcessMemory::queryDirtyPages(std::span<const PageEntry> pages, std::vector<uint8_t>& dirty) {
+    constexpr uint64_t PAGEMAP_PRESENT = 1ULL << 63;
+    constexpr uint64_t PAGEMAP_SWAPPED = 1ULL << 62;
+    constexpr uint64_t PAGEMAP_SOFT_DIRTY = 1ULL << 55;
+    
+    // One 8-byte pagemap entry per page; runs of adjacent pages are one read
+    dirty.assign(pages.size(), 1);
+    size_t begin = 0;
+    while (begin < pages.size()) {
+        size_t end = begin + 1;
+        while (end < pages.size() && pages[end].page == pages[end - 1].page + 1) {
+            ++end;
+        }
+        const size_t count = end - begin;
+        m_pagemapEntries.resize(count);
+        ssize_t bytes = ::pread(m_pagemapFd, m_pagemapEntries.data(), count * sizeof(uint64_t),
+                                static_cast<off_t>(pages[begin].page * sizeof(uint64_t)));
+        ++m_stats.syscalls;
+        if (bytes != static_cast<ssize_t>(count * sizeof(uint64_t))) {
+            return false;
+        }
+        
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t entry = m_pagemapEntries[i];
+            // A page neither present nor swapped out may have been unmapped
+            const bool mapped = (entry & (PAGEMAP_PRESENT | PAGEMAP_SWAPPED)) != 0;
+            dirty[begin + i] = !mapped || (entry & PAGEMAP_SOFT_DIRTY) != 0;
+        }
+        begin = end;
+    }
+    return true;
+}
+
 #endif
 
 // ============================================================================
 // Common implementation
 // ============================================================================
 
+std::optional<MemoryBuffer> ProcessMemory::readMemory(uint64_t address, size_t size) {
+    if (m_snapshotDepth > 0 && size > 0 && size <= MAX_CACHED_READ) {
+        collectMissingPages(address, size, m_missingPages);
+        fetchPages(m_missingPages);
+        
+        MemoryBuffer buffer(size);
+        if (copyFromPages(address, size, buffer.data())) {
+            ++m_cachedReads;
+            ++m_stats.cachedReads;
+            return buffer;
+        }
+        // Touches an unreadable page: let the direct read handle the partial case
+    }
+    ++m_stats.uncachedReads;
+    return readMemoryDirect(address, size);
+}
+
+bool ProcessMemory::readInto(uint64_t address, std::span<uint8_t> out) {
+    MemoryRead read{address, out.size(), out.data()};
+    return readBatch(std::span<MemoryRead>(&read, 1)) == 1;
+}
+
+size_t ProcessMemory::readBatch(std::span<MemoryRead> reads) {
+    if (m_snapshotDepth == 0) {
+        m_stats.uncachedReads += reads.size();
+        return readBatchDirect(reads);
+    }
+    
+    // Fetch every page the batch needs in one go
+    m_missingPages.clear();
+    for (const MemoryRead& read : reads) {
+        if (read.size > 0 && read.size <= MAX_CACHED_READ) {
+            collectMissingPages(read.address, read.size, m_missingPages);
+        }
+    }
+    std::sort(m_missingPages.begin(), m_missingPages.end());
+    m_missingPages.erase(std::unique(m_missingPages.begin(), m_missingPages.end()), m_missingPages.end());
+    fetchPages(m_missingPages);
+    
+    size_t completed = 0;
+    m_directReads.clear();
+    m_directIndexes.clear();
+    for (size_t i = 0; i < reads.size(); ++i) {
+        MemoryRead& read = reads[i];
+        read.ok = false;
+        if (read.size == 0) {
+            continue;
+        }
+        if (read.size <= MAX_CACHED_READ && copyFromPages(read.address, read.size, read.destination)) {
+            read.ok = true;
+            ++completed;
+            ++m_cachedReads;
+            ++m_stats.cachedReads;
+        } else {
+            m_directReads.push_back(read);
+            m_directIndexes.push_back(i);
+        }
+    }
+    
+    if (!m_directReads.empty()) {
+        m_stats.uncachedReads += m_directReads.size();
+        completed += readBatchDirect(m_directReads);
+        for (size_t k = 0; k < m_directReads.size(); ++k) {
+            reads[m_directIndexes[k]].ok = m_directReads[k].ok;
+        }
+    }
+    return completed;
+}
+
+void ProcessMemory::beginSnapshot() {
+    if (m_snapshotDepth++ > 0) {
+        return;
+    }
+    ++m_snapshotGeneration;
+    if (!m_dirtyTracking || m_snapshotGeneration % DIRTY_TRACKING_REFRESH == 0 || !retainCleanPages()) {
+        // Keep the page storage allocated across snapshots
+        clearPages();
+        if (m_dirtyTracking) {
+            clearSoftDirty();
+        }
+    }
+    m_cachedReads = 0;
+    m_pageFetches = 0;
+}
+
+void ProcessMemory::endSnapshot() {
+    if (m_snapshotDepth == 0 || --m_snapshotDepth > 0) {
+        return;
+    }
+    spdlog::debug("Memory snapshot: {} reads served from {} fetched pages",
+                  m_cachedReads, m_pageFetches);
+    if (!m_dirtyTracking) {
+        clearPages();
+    }
+}
+
+bool ProcessMemory::retainCleanPages() {
+    m_retainedPages.clear();
+    for (const PageEntry& entry : m_pageTable) {
+        // Unreadable pages are tried again, they may have been mapped since
+        if (entry.page != EMPTY_PAGE && entry.slot != UNREADABLE_PAGE) {
+            m_retainedPages.push_back(entry);
+        }
+    }
+    std::sort(m_retainedPages.begin(), m_retainedPages.end(),
+              [](const PageEntry& a, const PageEntry& b) { return a.page < b.page; });
+    if (!queryDirtyPages(m_retainedPages, m_dirtyFlags)) {
+        return false;
+    }
+    
+    size_t kept = 0;
+    for (size_t i = 0; i < m_retainedPages.size(); ++i) {
+        if (!m_dirtyFlags[i]) {
+            m_retainedPages[kept++] = m_retainedPages[i];
+        }
+    }
+    const size_t dirty = m_retainedPages.size() - kept;
+    m_retainedPages.resize(kept);
+    // Dirty pages are fetched again on first touch; clear the bits before
+    // that, so writes made after the new copy show up next time
+    if (dirty > 0 && !clearSoftDirty()) {
+        return false;
+    }
+    
+    // Move the clean pages down to the front of the storage, in slot order
+    // so none is overwritten before it has moved
+    std::sort(m_retainedPages.begin(), m_retainedPages.end(),
+              [](const PageEntry& a, const PageEntry& b) { return a.slot < b.slot; });
+    clearPages();
+    for (size_t i = 0; i < m_retainedPages.size(); ++i) {
+        const PageEntry& entry = m_retainedPages[i];
+        if (static_cast<size_t>(entry.slot) != i) {
+            std::memcpy(m_pageData.data() + i * PAGE_SIZE,
+                        m_pageData.data() + static_cast<size_t>(entry.slot) * PAGE_SIZE, PAGE_SIZE);
+        }
+        insertPage(entry.page, static_cast<int32_t>(i));
+    }
+    m_pagesUsed = m_retainedPages.size();
+    m_stats.retainedPages += kept;
+    m_stats.dirtyPages += dirty;
+    return true;
+}
+
+void ProcessMemory::collectMissingPages(uint64_t address, size_t size, std::vector<uint64_t>& pages) const {
+    uint64_t first = address / PAGE_SIZE;
+    uint64_t last = (address + size - 1) / PAGE_SIZE;
+    for (uint64_t page = first; page <= last; ++page) {
+        if (!findPage(page)) {
+            pages.push_back(page);
+        }
+    }
+}
+
+void ProcessMemory::fetchPages(std::vector<uint64_t>& pages) {
+    if (pages.empty()) {
+        return;
+    }
+    
+    size_t needed = (m_pagesUsed + pages.size()) * PAGE_SIZE;
+    if (m_pageData.size() < needed) {
+        m_pageData.resize(needed);
+    }
+    
+    m_pageReads.clear();
+    for (size_t i = 0; i < pages.size(); ++i) {
+        m_pageReads.push_back({pages[i] * PAGE_SIZE, PAGE_SIZE,
+                               m_pageData.data() + (m_pagesUsed + i) * PAGE_SIZE});
+    }
+    readBatchDirect(m_pageReads);
+    
+    for (size_t i = 0; i < pages.size(); ++i) {
+        insertPage(pages[i], m_pageReads[i].ok ? static_cast<int32_t>(m_pagesUsed + i) : UNREADABLE_PAGE);
+    }
+    m_pagesUsed += pages.size();
+    m_pageFetches += pages.size();
+    m_stats.pageFetches += pages.size();
+    pages.clear();
+}
+
+bool ProcessMemory::copyFromPages(uint64_t address, size_t size, uint8_t* destination) const {
+    size_t copied = 0;
+    while (copied < size) {
+        uint64_t current = address + copied;
+        const PageEntry* entry = findPage(current / PAGE_SIZE);
+        if (!entry || entry->slot == UNREADABLE_PAGE) {
+            return false;
+        }
+        size_t offset = static_cast<size_t>(current % PAGE_SIZE);
+        size_t chunk = std::min(size - copied, PAGE_SIZE - offset);
+        std::memcpy(destination + copied,
+                    m_pageData.data() + static_cast<size_t>(entry->slot) * PAGE_SIZE + offset, chunk);
+        copied += chunk;
+    }
+    return true;
+}
+
+const ProcessMemory::PageEntry* ProcessMemory::findPage(uint64_t page) const {
+    if (m_pageTable.empty()) {
+        return nullptr;
+    }
+    size_t mask = m_pageTable.size() - 1;
+    for (size_t i = static_cast<size_t>(page * 0x9E3779B97F4A7C15ULL) & mask;; i = (i + 1) & mask) {
+        const PageEntry& entry = m_pageTable[i];
+        if (entry.page == page) {
+            return &entry;
+        }
+        if (entry.page == EMPTY_PAGE) {
+            return nullptr;
+        }
+    }
+}
+
+void ProcessMemory::insertPage(uint64_t page, int32_t slot) {
+    // Grow at half load; only happens until the largest snapshot has been seen
+    if ((m_pageTableUsed + 1) * 2 > m_pageTable.size()) {
+        std::vector<PageEntry> old = std::move(m_pageTable);
+        m_pageTable.assign(std::max<size_t>(old.size() * 2, 256), PageEntry{});
+        m_pageTableUsed = 0;
+        for (const PageEntry& entry : old) {
+            if (entry.page != EMPTY_PAGE) {
+                insertPage(entry.page, entry.slot);
+            }
+        }
+    }
+    
+    size_t mask = m_pageTable.size() - 1;
+    for (size_t i = static_cast<size_t>(page * 0x9E3779B97F4A7C15ULL) & mask;; i = (i + 1) & mask) {
+        PageEntry& entry = m_pageTable[i];
+        if (entry.page == EMPTY_PAGE || entry.page == page) {
+            if (entry.page == EMPTY_PAGE) {
+                ++m_pageTableUsed;
+            }
+            entry.page = page;
+            entry.slot = slot;
+            return;
+        }
+    }
+}
+
+void ProcessMemory::clearPages() {
+    std::fill(m_pageTable.begin(), m_pageTable.end(), PageEntry{});
+    m_pageTableUsed = 0;
+    m_pagesUsed = 0;
+}
+
 std::optional<uint64_t> ProcessMemory::readPointer(uint64_t address) {
     if (m_processInfo.is64Bit) {
         return read<uint64_t>(address);
@@ -535,4 +1233,259 @@ std::optional<std::wstring> ProcessMemory::readWideString(uint64_t address, size
     return buffer->readWideString(0, maxLen);
 }
 
+// ============================================================================
+// Recording and replay
+// ============================================================================
+
+namespace {
+
+// Capture file: magic, version, process info, modules, notes, then the
+// regions as address, size and bytes. Host byte order throughout.
+constexpr uint32_t RECORDING_MAGIC = 0x4352534C; // "LSRC"
+constexpr uint32_t RECORDING_VERSION = 1;
+
+std::string lowerName(std::string name) {
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return name;
+}
+
+template<typename T>
+void writeValue(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeText(std::ofstream& out, const std::string& text) {
+    writeValue<uint32_t>(out, static_cast<uint32_t>(text.size()));
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+template<typename T>
+bool readValue(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool readText(std::ifstream& in, std::string& text) {
+    uint32_t size = 0;
+    if (!readValue(in, size) || size > 64 * 1024) {
+        return false;
+    }
+    text.resize(size);
+    return static_cast<bool>(in.read(text.data(), size));
+}
+
+} // namespace
+
+std::optional<ProcessMemory::ModuleInfo> ProcessMemory::getModuleEx(const std::string& moduleName) {
+    if (isReplaying()) {
+        auto it = m_impl->modules.find(lowerName(moduleName));
+        if (it == m_impl->modules.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+    
+    auto info = findModule(moduleName);
+    if (info && m_impl->recording) {
+        m_impl->modules[lowerName(moduleName)] = *info;
+    }
+    return info;
+}
+
+void ProcessMemory::startRecording() {
+    if (isReplaying()) {
+        spdlog::warn("Cannot record while replaying a capture");
+        return;
+    }
+    m_impl->clear();
+    m_impl->recording = true;
+}
+
+bool ProcessMemory::isRecording() const {
+    return m_impl->recording;
+}
+
+void ProcessMemory::setRecordingNote(const std::string& key, const std::string& value) {
+    if (m_impl->recording) {
+        m_impl->notes[key] = value;
+    }
+}
+
+void ProcessMemory::recordRead(uint64_t address, const uint8_t* data, size_t size) {
+    if (m_impl->recording) {
+        m_impl->record(address, data, size);
+    }
+}
+
+bool ProcessMemory::saveRecording(const std::string& path) {
+    if (!m_impl->recording) {
+        return false;
+    }
+    m_impl->recording = false;
+    
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    writeValue(out, RECORDING_MAGIC);
+    writeValue(out, RECORDING_VERSION);
+    writeValue<uint64_t>(out, m_processInfo.pid);
+    writeValue<uint8_t>(out, m_processInfo.is64Bit ? 1 : 0);
+    writeText(out, m_processInfo.name);
+    writeText(out, m_processInfo.path);
+    
+    writeValue<uint32_t>(out, static_cast<uint32_t>(m_impl->modules.size()));
+    for (const auto& [name, info] : m_impl->modules) {
+        writeText(out, name);
+        writeValue(out, info.baseAddress);
+        writeValue(out, info.size);
+    }
+    writeValue<uint32_t>(out, static_cast<uint32_t>(m_impl->notes.size()));
+    for (const auto& [key, value] : m_impl->notes) {
+        writeText(out, key);
+        writeText(out, value);
+    }
+    
+    uint64_t bytes = 0;
+    writeValue<uint64_t>(out, m_impl->regions.size());
+    for (const auto& [address, data] : m_impl->regions) {
+        writeValue(out, address);
+        writeValue<uint64_t>(out, data.size());
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        bytes += data.size();
+    }
+    
+    const size_t regions = m_impl->regions.size();
+    m_impl->clear();
+    out.close();
+    if (!out) {
+        spdlog::error("Failed to write memory capture {}", path);
+        return false;
+    }
+    spdlog::info("Saved memory capture {}: {} regions, {} bytes", path, regions, bytes);
+    return true;
+}
+
+bool ProcessMemory::openRecording(const std::string& path) {
+    close();
+    m_impl->recording = false;
+    m_impl->clear();
+    
+    std::ifstream in(path, std::ios::binary);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (!readValue(in, magic) || magic != RECORDING_MAGIC
+        || !readValue(in, version) || version != RECORDING_VERSION) {
+        spdlog::error("{} is not a memory capture", path);
+        return false;
+    }
+    
+    ProcessInfo info;
+    uint8_t is64Bit = 1;
+    bool ok = readValue(in, info.pid) && readValue(in, is64Bit)
+              && readText(in, info.name) && readText(in, info.path);
+    info.is64Bit = is64Bit != 0;
+    
+    uint32_t moduleCount = 0;
+    ok = ok && readValue(in, moduleCount);
+    for (uint32_t i = 0; ok && i < moduleCount; ++i) {
+        std::string name;
+        ModuleInfo module;
+        ok = readText(in, name) && readValue(in, module.baseAddress) && readValue(in, module.size);
+        m_impl->modules[name] = module;
+    }
+    
+    uint32_t noteCount = 0;
+    ok = ok && readValue(in, noteCount);
+    for (uint32_t i = 0; ok && i < noteCount; ++i) {
+        std::string key;
+        std::string value;
+        ok = readText(in, key) && readText(in, value);
+        m_impl->notes[key] = std::move(value);
+    }
+    
+    uint64_t regionCount = 0;
+    ok = ok && readValue(in, regionCount);
+    for (uint64_t i = 0; ok && i < regionCount; ++i) {
+        uint64_t address = 0;
+        uint64_t size = 0;
+        ok = readValue(in, address) && readValue(in, size) && size <= (1ULL << 32);
+        if (ok) {
+            std::vector<uint8_t> data(static_cast<size_t>(size));
+            ok = static_cast<bool>(in.read(reinterpret_cast<char*>(data.data()),
+                                           static_cast<std::streamsize>(size)));
+            m_impl->regions.emplace(address, std::move(data));
+        }
+    }
+    
+    if (!ok) {
+        spdlog::error("Memory capture {} is truncated", path);
+        m_impl->clear();
+        return false;
+    }
+    
+    m_processInfo = info;
+    m_impl->replaying = true;
+    spdlog::info("Replaying memory capture {} ({} regions, process {})",
+                 path, m_impl->regions.size(), info.pid);
+    return true;
+}
+
+bool ProcessMemory::isReplaying() const {
+    return m_impl->replaying;
+}
+
+std::optional<std::string> ProcessMemory::recordingNote(const std::string& key) const {
+    auto it = m_impl->notes.find(key);
+    if (!isReplaying() || it == m_impl->notes.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void ProcessMemory::endReplay() {
+    if (m_impl->replaying) {
+        m_impl->replaying = false;
+        m_impl->clear();
+    }
+}
+
+std::optional<MemoryBuffer> ProcessMemory::replayMemory(uint64_t address, size_t size) {
+    MemoryBuffer buffer(size);
+    size_t served = m_impl->replay(address, size, buffer.data());
+    ++m_stats.syscalls;
+    m_stats.remoteBytes += served;
+    if (served == 0) {
+        return std::nullopt;
+    }
+    return buffer;
+}
+
+size_t ProcessMemory::replayBatch(std::span<MemoryRead> reads) {
+    // Count calls as the Linux reader makes them: up to a full iovec list
+    // each, and a short region is retried alone with the batch resuming
+    // after it
+    size_t completed = 0;
+    size_t inCall = 0;
+    for (MemoryRead& read : reads) {
+        read.ok = false;
+        if (read.size == 0) {
+            continue;
+        }
+        if (inCall++ == 0) {
+            ++m_stats.syscalls;
+        }
+        
+        size_t served = m_impl->replay(read.address, read.size, read.destination);
+        m_stats.remoteBytes += served;
+        if (served > 0) {
+            read.ok = true;
+            ++completed;
+        }
+        if (served < read.size) {
+            ++m_stats.syscalls;
+            inCall = 0;
+        } else if (inCall == REPLAY_BATCH_REGIONS) {
+            inCall = 0;
+        }
+    }
+    return completed;
+}
+
 } // namespace lotro
@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -18,6 +21,7 @@
 #include <windows.h>
 #else
 #include <sys/types.h>
+#include <sys/uio.h>
 #endif
 
 namespace lotro {
@@ -32,11 +36,77 @@ struct ProcessInfo {
     bool is64Bit = true;
 };
 
+/**
+ * One region of a batched read
+ */
+struct MemoryRead {
+    uint64_t address = 0;
+    size_t size = 0;
+    uint8_t* destination = nullptr;   // At least size bytes
+    bool ok = false;                  // Set by ProcessMemory::readBatch
+};
+
+/**
+ * Read-only view over bytes copied from the target process
+ * 
+ * Carries the MemoryBuffer read helpers without owning the storage, so
+ * regions of a MemoryBatch or a caller's stack buffer can be decoded the
+ * same way. Reads past the end return zero / empty.
+ */
+class MemoryView {
+public:
+    MemoryView() = default;
+    MemoryView(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    
+    /**
+     * Read value at offset
+     */
+    template<typename T>
+    T read(size_t offset) const {
+        T value{};
+        if (offset <= m_size && sizeof(T) <= m_size - offset) {
+            std::memcpy(&value, m_data + offset, sizeof(T));
+        }
+        return value;
+    }
+    
+    /**
+     * Read pointer (4 or 8 bytes depending on process architecture)
+     */
+    uint64_t readPointer(size_t offset, bool is64Bit) const {
+        return is64Bit ? read<uint64_t>(offset) : read<uint32_t>(offset);
+    }
+    
+    /**
+     * Read null-terminated string at offset
+     */
+    std::string readString(size_t offset, size_t maxLen = 256) const;
+    
+    /**
+     * Read wide string at offset
+     */
+    std::wstring readWideString(size_t offset, size_t maxLen = 256) const;
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
 /**
  * Memory buffer for reading data
+ * 
+ * Buffers of up to INLINE_CAPACITY bytes live inside the object, so the
+ * small reads the extractor makes (values, nodes, entity headers) never
+ * touch the heap.
  */
 class MemoryBuffer {
 public:
+    static constexpr size_t INLINE_CAPACITY = 320;
+    
     explicit MemoryBuffer(size_t size);
     ~MemoryBuffer() = default;
     
@@ -48,42 +118,93 @@ public:
     /**
      * Get raw data pointer
      */
-    const uint8_t* data() const { return m_data.data(); }
-    uint8_t* data() { return m_data.data(); }
+    const uint8_t* data() const { return m_size <= INLINE_CAPACITY ? m_inline.data() : m_heap.data(); }
+    uint8_t* data() { return m_size <= INLINE_CAPACITY ? m_inline.data() : m_heap.data(); }
     
     /**
      * Get buffer size
      */
-    size_t size() const { return m_data.size(); }
+    size_t size() const { return m_size; }
+    
+    MemoryView view() const { return MemoryView(data(), m_size); }
     
     /**
      * Read value at offset
      */
     template<typename T>
     T read(size_t offset) const {
-        if (offset + sizeof(T) > m_data.size()) {
-            return T{};
-        }
-        return *reinterpret_cast<const T*>(m_data.data() + offset);
+        return view().read<T>(offset);
     }
     
     /**
      * Read pointer (4 or 8 bytes depending on process architecture)
      */
-    uint64_t readPointer(size_t offset, bool is64Bit) const;
+    uint64_t readPointer(size_t offset, bool is64Bit) const { return view().readPointer(offset, is64Bit); }
     
     /**
      * Read null-terminated string at offset
      */
-    std::string readString(size_t offset, size_t maxLen = 256) const;
+    std::string readString(size_t offset, size_t maxLen = 256) const { return view().readString(offset, maxLen); }
     
     /**
      * Read wide string at offset
      */
-    std::wstring readWideString(size_t offset, size_t maxLen = 256) const;
+    std::wstring readWideString(size_t offset, size_t maxLen = 256) const {
+        return view().readWideString(offset, maxLen);
+    }
 
 private:
-    std::vector<uint8_t> m_data;
+    size_t m_size = 0;
+    std::array<uint8_t, INLINE_CAPACITY> m_inline;
+    std::vector<uint8_t> m_heap;
+};
+
+class ProcessMemory;
+
+/**
+ * Reusable set of regions read together with ProcessMemory::readBatch
+ * 
+ * Regions are copied into one flat buffer that keeps its capacity across
+ * clear(), so a batch run every sync stops allocating once it has seen
+ * the largest sync.
+ */
+class MemoryBatch {
+public:
+    /**
+     * Drop all regions, keeping the storage
+     */
+    void clear();
+    
+    /**
+     * Queue a region, returns its index
+     */
+    size_t add(uint64_t address, size_t size);
+    
+    size_t size() const { return m_reads.size(); }
+    bool empty() const { return m_reads.empty(); }
+    
+    /**
+     * Read every queued region
+     * @return Number of regions read
+     */
+    size_t run(ProcessMemory& memory);
+    
+    bool ok(size_t index) const { return m_reads[index].ok; }
+    uint64_t address(size_t index) const { return m_reads[index].address; }
+    
+    /**
+     * Bytes of a region after run(), empty if its read failed
+     */
+    MemoryView view(size_t index) const {
+        const MemoryRead& read = m_reads[index];
+        return read.ok ? MemoryView(m_storage.data() + m_offsets[index], read.size) : MemoryView();
+    }
+    
+private:
+    std::vector<uint8_t> m_storage;
+    std::vector<MemoryRead> m_reads;
+    std::vector<size_t> m_offsets;
+    size_t m_used = 0;
 };
 
 /**
@@ -122,6 +243,13 @@ public:
      */
     bool isOpen() const;
     
+    /**
+     * Check whether the open process is worth polling: false while it is
+     * stopped, or (on Windows) while all of its visible windows are
+     * minimized. True when the state cannot be determined.
+     */
+    bool isActive() const;
+    
     /**
      * Get the process info
      */
@@ -150,16 +278,101 @@ public:
      */
     std::optional<MemoryBuffer> readMemory(uint64_t address, size_t size);
     
+    /**
+     * Start a snapshot generation: until the matching endSnapshot(), reads
+     * of up to MAX_CACHED_READ bytes are served from a local copy of the
+     * remote pages, fetching each 4 KiB page on first touch
+     * 
+     * Calls nest; the cache is cleared when the outermost snapshot begins
+     * and ends. Use when the target's state is read as one consistent
+     * picture and re-reading the same structures is expected.
+     */
+    void beginSnapshot();
+    void endSnapshot();
+    bool inSnapshot() const { return m_snapshotDepth > 0; }
+    
+    /**
+     * Incremented whenever an outermost snapshot begins, so callers can
+     * tell whether something they derived belongs to the current one
+     */
+    uint64_t snapshotGeneration() const { return m_snapshotGeneration; }
+    
+    /**
+     * Read counters since the process was opened
+     */
+    struct ReadStats {
+        uint64_t remoteBytes = 0;     // Bytes copied out of the target
+        uint64_t syscalls = 0;        // process_vm_readv / ReadProcessMemory calls
+        uint64_t cachedReads = 0;     // Reads served from the snapshot page cache
+        uint64_t uncachedReads = 0;   // Reads that went to the target directly
+        uint64_t pageFetches = 0;     // Pages copied into the snapshot cache
+        uint64_t retainedPages = 0;   // Clean pages carried into a snapshot by dirty tracking
+        uint64_t dirtyPages = 0;      // Cached pages dropped because the target wrote to them
+    };
+    const ReadStats& readStats() const { return m_stats; }
+    
+    /**
+     * RAII helper for beginSnapshot()/endSnapshot()
+     */
+    class SnapshotScope {
+    public:
+        explicit SnapshotScope(ProcessMemory& memory) : m_memory(memory) { m_memory.beginSnapshot(); }
+        ~SnapshotScope() { m_memory.endSnapshot(); }
+        SnapshotScope(const SnapshotScope&) = delete;
+        SnapshotScope& operator=(const SnapshotScope&) = delete;
+    private:
+        ProcessMemory& m_memory;
+    };
+    
+    /**
+     * Keep the snapshot page cache from one snapshot to the next, fetching
+     * again only the pages the target wrote to in between
+     * 
+     * Linux only: the kernel's soft-dirty bits are cleared through
+     * /proc/<pid>/clear_refs and read back from /proc/<pid>/pagemap, so a
+     * snapshot over unchanged structures costs a pagemap read instead of a
+     * copy of every page. Clearing write-protects all of the target's
+     * pages, costing it a minor fault on its next write to each, so the
+     * bits are only cleared when a cached page was dirty. A write landing
+     * between the pagemap read and the clear would go unseen, so the cache
+     * is dropped outright every DIRTY_TRACKING_REFRESH snapshots, which
+     * also sheds pages no longer read.
+     * @return false where unsupported (not Linux, a kernel without
+     * CONFIG_MEM_SOFT_DIRTY, a replay) or not permitted; lasts until close()
+     */
+    bool enableDirtyTracking();
+    bool isDirtyTracking() const { return m_dirtyTracking; }
+    
+    static constexpr uint64_t DIRTY_TRACKING_REFRESH = 64;
+    
+    /**
+     * Read many regions with as few system calls as possible
+     * 
+     * On Linux the regions go to process_vm_readv as one iovec each, up to
+     * IOV_MAX per call. The kernel stops at the first region it cannot
+     * read; that region is retried on its own and the batch resumes after
+     * it, so one bad pointer doesn't fail its neighbours. On Windows each
+     * region is one ReadProcessMemory call.
+     * @return Number of regions read (each marked with ok)
+     */
+    size_t readBatch(std::span<MemoryRead> reads);
+    
+    /**
+     * Read into a caller-supplied buffer without allocating
+     * @return true if the whole range was read
+     */
+    bool readInto(uint64_t address, std::span<uint8_t> out);
+    
     /**
      * Read a value from memory
      */
     template<typename T>
     std::optional<T> read(uint64_t address) {
-        auto buffer = readMemory(address, sizeof(T));
-        if (!buffer) {
+        std::array<uint8_t, sizeof(T)> bytes;
+        if (!readInto(address, bytes)) {
             return std::nullopt;
         }
-        return buffer->read<T>(0);
+        return MemoryView(bytes.data(), bytes.size()).read<T>(0);
     }
     
     /**
@@ -176,14 +389,132 @@ public:
      * Read wide string (UTF-16) from memory
      */
     std::optional<std::wstring> readWideString(uint64_t address, size_t maxLen = 256);
+    
+    /**
+     * Capture every region read from the target from now on
+     * 
+     * Captured regions are merged as they come in, later reads winning
+     * where they overlap, so re-reading the same structures every sync
+     * doesn't grow the capture. Modules looked up are captured too.
+     */
+    void startRecording();
+    bool isRecording() const;
+    
+    /**
+     * Attach a note to the capture, such as what was decoded from it, so
+     * a replay can check that it decodes the same
+     */
+    void setRecordingNote(const std::string& key, const std::string& value);
+    
+    /**
+     * Stop capturing and write the capture to a file
+     */
+    bool saveRecording(const std::string& path);
+    
+    /**
+     * Serve reads from a saved capture in place of a live process
+     * 
+     * Reads inside captured regions return the captured bytes and all
+     * others fail, as an unmapped address would; a read that runs past
+     * the end of a region gets the captured part, like a partial read.
+     * The read counters count the system calls the Linux reader would
+     * have made, so captures can be compared across changes. Lasts until
+     * close().
+     */
+    bool openRecording(const std::string& path);
+    bool isReplaying() const;
+    
+    /**
+     * A note saved with the capture being replayed
+     */
+    std::optional<std::string> recordingNote(const std::string& key) const;
 
 private:
+    // Platform module lookup behind getModuleEx()
+    std::optional<ModuleInfo> findModule(const std::string& moduleName);
+    
+    // Reads served from a capture, and captured reads
+    std::optional<MemoryBuffer> replayMemory(uint64_t address, size_t size);
+    size_t replayBatch(std::span<MemoryRead> reads);
+    void recordRead(uint64_t address, const uint8_t* data, size_t size);
+    void endReplay();
+    
+    // Uncached platform reads
+    std::optional<MemoryBuffer> readMemoryDirect(uint64_t address, size_t size);
+    size_t readBatchDirect(std::span<MemoryRead> reads);
+    
+    // Snapshot page cache
+    void fetchPages(std::vector<uint64_t>& pages);
+    bool copyFromPages(uint64_t address, size_t size, uint8_t* destination) const;
+    void collectMissingPages(uint64_t address, size_t size, std::vector<uint64_t>& pages) const;
+    
+    // Open-addressing page table: page number -> slot in m_pageData
+    struct PageEntry {
+        uint64_t page = EMPTY_PAGE;
+        int32_t slot = UNREADABLE_PAGE;
+    };
+    const PageEntry* findPage(uint64_t page) const;
+    void insertPage(uint64_t page, int32_t slot);
+    void clearPages();
+    
+    // Dirty tracking: keep the cached pages the target hasn't written to,
+    // false if the page states could not be read
+    bool retainCleanPages();
+    bool clearSoftDirty();
+    bool queryDirtyPages(std::span<const PageEntry> pages, std::vector<uint8_t>& dirty);
+    
     ProcessInfo m_processInfo;
     
+    static constexpr size_t PAGE_SIZE = 4096;
+    static constexpr size_t MAX_CACHED_READ = 64 * 1024;
+    static constexpr int32_t UNREADABLE_PAGE = -1;
+    static constexpr uint64_t EMPTY_PAGE = ~0ULL;
+    static constexpr size_t REPLAY_BATCH_REGIONS = 1024;   // IOV_MAX on Linux
+    
+    int m_snapshotDepth = 0;
+    uint64_t m_snapshotGeneration = 0;
+    std::vector<PageEntry> m_pageTable;   // Power-of-two size, cleared in place
+    size_t m_pageTableUsed = 0;
+    std::vector<uint8_t> m_pageData;
+    size_t m_pagesUsed = 0;
+    uint64_t m_cachedReads = 0;
+    uint64_t m_pageFetches = 0;
+    bool m_dirtyTracking = false;
+    ReadStats m_stats;
+    
+    // Scratch reused by every read, so steady-state syncs don't allocate
+    std::vector<uint64_t> m_missingPages;
+    std::vector<MemoryRead> m_pageReads;
+    std::vector<MemoryRead> m_directReads;
+    std::vector<size_t> m_directIndexes;
+    std::vector<PageEntry> m_retainedPages;
+    std::vector<uint8_t> m_dirtyFlags;
+    
 #ifdef _WIN32
     HANDLE m_handle = nullptr;
+    
+    // Module list of the open process, enumerated on first lookup and
+    // again only when a name is missing from it
+    struct CachedModule {
+        std::string name;
+        ModuleInfo info;
+    };
+    std::vector<CachedModule> m_modules;
+    void refreshModules();
+    
+    // ReadProcessMemory has no scatter-gather form: batched regions this
+    // close together are fetched with one call and copied out
+    static constexpr size_t COALESCE_GAP = 256;
+    std::vector<size_t> m_readOrder;
+    std::vector<uint8_t> m_coalesceBuffer;
 #else
     int m_memFd = -1;
+    int m_pagemapFd = -1;
+    int m_clearRefsFd = -1;
+    std::vector<uint64_t> m_pagemapEntries;
+    void stopDirtyTracking();
+    std::vector<struct iovec> m_localIov;
+    std::vector<struct iovec> m_remoteIov;
 #endif
     
     class Impl;
@@ -0,0 +1,166 @@
+/**
+ * LOTRO Launcher - Recipe Graph
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "RecipeGraph.hpp"
+#include "GameDatabase.hpp"
+
+#include <algorithm>
+
+namespace lotro {
+
+void RecipeGraph::clear() {
+    m_producers.clear();
+    m_consumers.clear();
+    m_inputProducers.clear();
+}
+
+void RecipeGraph::build(std::span<const Recipe> recipes) {
+    clear();
+    
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        if (!recipes[i].outputItemId.isEmpty()) {
+            m_producers[recipes[i].outputItemId].push_back(static_cast<uint32_t>(i));
+        }
+    }
+    
+    m_consumers.resize(recipes.size());
+    m_inputProducers.resize(recipes.size());
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        const auto& ingredients = recipes[i].ingredients;
+        auto& inputs = m_inputProducers[i];
+        inputs.reserve(ingredients.size());
+        for (const auto& ingredient : ingredients) {
+            auto it = m_producers.constFind(ingredient.itemId);
+            if (it == m_producers.constEnd()) {
+                inputs.push_back(NO_RECIPE);
+                continue;
+            }
+            inputs.push_back(it.value().front());
+            for (uint32_t producer : it.value()) {
+                auto& consumers = m_consumers[producer];
+                if (consumers.empty() || consumers.back() != i) {
+                    consumers.push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+    }
+}
+
+std::span<const uint32_t> RecipeGraph::producers(const QString& itemId) const {
+    auto it = m_producers.constFind(itemId);
+    if (it == m_producers.constEnd()) {
+        return {};
+    }
+    return it.value();
+}
+
+std::span<const uint32_t> RecipeGraph::consumers(uint32_t recipe) const {
+    if (recipe >= m_consumers.size()) {
+        return {};
+    }
+    return m_consumers[recipe];
+}
+
+BillOfMaterials RecipeGraph::expandItem(std::span<const Recipe> recipes, const QString& itemId,
+                                        int quantity) const {
+    auto producing = producers(itemId);
+    if (producing.empty()) {
+        BillOfMaterials bom;
+        bom.materials.push_back({itemId, QString(), quantity});
+        return bom;
+    }
+    return expand(recipes, producing.front(), quantity);
+}
+
+BillOfMaterials RecipeGraph::expandRecipe(std::span<const Recipe> recipes, uint32_t recipe,
+                                          int crafts) const {
+    if (recipe >= recipes.size() || recipe >= m_inputProducers.size()) {
+        return {};
+    }
+    return expand(recipes, recipe, crafts * std::max(1, recipes[recipe].outputQuantity));
+}
+
+BillOfMaterials RecipeGraph::expand(std::span<const Recipe> recipes, uint32_t root, int demand) const {
+    BillOfMaterials bom;
+    
+    // Depth-first walk from the root collecting recipes in post-order, so
+    // reversing it lists every recipe before the ones it depends on
+    enum : uint8_t { Unvisited, OnStack, Done };
+    std::vector<uint8_t> state(recipes.size(), Unvisited);
+    std::vector<uint32_t> order;
+    
+    struct Frame {
+        uint32_t recipe;
+        size_t next;
+    };
+    std::vector<Frame> stack{{root, 0}};
+    state[root] = OnStack;
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        const auto& inputs = m_inputProducers[frame.recipe];
+        if (frame.next == inputs.size()) {
+            state[frame.recipe] = Done;
+            order.push_back(frame.recipe);
+            stack.pop_back();
+            continue;
+        }
+        uint32_t producer = inputs[frame.next++];
+        if (producer == NO_RECIPE) {
+            continue;
+        }
+        if (state[producer] == OnStack) {
+            bom.cyclic = true;
+        } else if (state[producer] == Unvisited) {
+            state[producer] = OnStack;
+            stack.push_back({producer, 0});
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    
+    // Push demand down in topological order, so a shared intermediate
+    // collects everything its consumers need before its crafts are rounded
+    std::vector<uint32_t> rank(recipes.size(), NO_RECIPE);
+    for (size_t i = 0; i < order.size(); ++i) {
+        rank[order[i]] = static_cast<uint32_t>(i);
+    }
+    std::vector<long long> needed(recipes.size(), 0);
+    needed[root] = demand;
+    
+    QHash<QString, size_t> materialIndex;
+    for (uint32_t position : order) {
+        const Recipe& recipe = recipes[position];
+        int perCraft = std::max(1, recipe.outputQuantity);
+        int crafts = static_cast<int>((needed[position] + perCraft - 1) / perCraft);
+        if (crafts <= 0) {
+            continue;
+        }
+        bom.steps.push_back({&recipe, crafts});
+        
+        const auto& inputs = m_inputProducers[position];
+        for (size_t k = 0; k < recipe.ingredients.size(); ++k) {
+            const auto& ingredient = recipe.ingredients[k];
+            long long amount = static_cast<long long>(crafts) * ingredient.quantity;
+            uint32_t producer = inputs[k];
+            // A producer ranked earlier closes a loop; buy that ingredient instead
+            if (producer != NO_RECIPE && rank[producer] > rank[position]) {
+                needed[producer] += amount;
+                continue;
+            }
+            auto it = materialIndex.constFind(ingredient.itemId);
+            if (it == materialIndex.constEnd()) {
+                materialIndex.insert(ingredient.itemId, bom.materials.size());
+                bom.materials.push_back({ingredient.itemId, ingredient.name, static_cast<int>(amount)});
+            } else {
+                bom.materials[it.value()].quantity += static_cast<int>(amount);
+            }
+        }
+    }
+    
+    std::reverse(bom.steps.begin(), bom.steps.end());
+    return bom;
+}
+
+} // namespace lotro
@@ -0,0 +1,101 @@
+/**
+ * LOTRO Launcher - Recipe Graph
+ * 
+ * Crafting dependency graph compiled from recipe ingredients.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace lotro {
+
+struct Recipe;
+
+/**
+ * Everything needed to craft an item from raw materials
+ */
+struct BillOfMaterials {
+    struct Step {
+        const Recipe* recipe = nullptr;
+        int crafts = 0;         // Times the recipe has to be made
+    };
+    
+    struct Material {
+        QString itemId;
+        QString name;
+        int quantity = 0;
+    };
+    
+    // Intermediate crafts come before the recipes that use them; the
+    // requested item's recipe is last
+    std::vector<Step> steps;
+    
+    // Ingredients no recipe produces, in first-use order
+    std::vector<Material> materials;
+    
+    // True if the recipes form a loop; the looping ingredient is then
+    // listed as a raw material
+    bool cyclic = false;
+    
+    bool isCraftable() const { return !steps.empty(); }
+};
+
+/**
+ * Producer/consumer links between recipes
+ * 
+ * Built once per recipe table. Each ingredient is resolved up front to
+ * the first recipe producing it, so expanding a crafting tree walks
+ * integer edges instead of searching the table for every ingredient.
+ */
+class RecipeGraph {
+public:
+    static constexpr uint32_t NO_RECIPE = UINT32_MAX;
+    
+    /**
+     * Compile the graph; positions refer to the given table
+     */
+    void build(std::span<const Recipe> recipes);
+    
+    void clear();
+    
+    /**
+     * Positions of the recipes producing an item, in table order
+     */
+    std::span<const uint32_t> producers(const QString& itemId) const;
+    
+    /**
+     * Positions of the recipes using a recipe's output as an ingredient
+     */
+    std::span<const uint32_t> consumers(uint32_t recipe) const;
+    
+    /**
+     * Expand the full tree for a quantity of an item
+     * 
+     * Uses the item's first producing recipe; an item nothing produces
+     * comes back as a single raw material.
+     */
+    BillOfMaterials expandItem(std::span<const Recipe> recipes, const QString& itemId, int quantity) const;
+    
+    /**
+     * Expand the full tree for a number of crafts of one recipe
+     */
+    BillOfMaterials expandRecipe(std::span<const Recipe> recipes, uint32_t recipe, int crafts) const;
+    
+private:
+    // Expand from root with demand expressed in output items
+    BillOfMaterials expand(std::span<const Recipe> recipes, uint32_t root, int demand) const;
+    
+    QHash<QString, std::vector<uint32_t>> m_producers;
+    std::vector<std::vector<uint32_t>> m_consumers;
+    std::vector<std::vector<uint32_t>> m_inputProducers;  // Per recipe, per ingredient
+};
+
+} // namespace lotro
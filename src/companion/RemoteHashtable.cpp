@@ -0,0 +1,75 @@
+/**
+ * LOTRO Launcher - Remote Hashtable Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "RemoteHashtable.hpp"
+
+#include <spdlog/spdlog.h>
+
+namespace lotro {
+
+bool RemoteHashtable::load(ProcessMemory& memory, uint64_t hashtableBase, MemoryBatch& hops, MemoryBatch& nextHops) {
+    clear();
+    
+    // TODO: Handle 32-bit offsets if needed (for now focused on 64-bit)
+    auto header = memory.readMemory(hashtableBase, 48);
+    if (!header) {
+        return false;
+    }
+    uint64_t bucketsPtr = header->readPointer(16, true);
+    uint32_t nbBuckets = header->read<uint32_t>(32);
+    if (bucketsPtr == 0 || nbBuckets == 0 || nbBuckets > MAX_BUCKETS) {
+        return false;
+    }
+    
+    auto buckets = memory.readMemory(bucketsPtr, static_cast<size_t>(nbBuckets) * 8);
+    if (!buckets) {
+        return false;
+    }
+    m_valid = true;
+    
+    hops.clear();
+    for (uint32_t i = 0; i < nbBuckets; ++i) {
+        uint64_t nodePtr = buckets->readPointer(i * 8, true);
+        if (nodePtr != 0) {
+            hops.add(nodePtr, 32);
+        }
+    }
+    
+    // Breadth-first: every chain advances one node per batched read
+    for (int hop = 0; hop < MAX_CHAIN_LENGTH && !hops.empty(); ++hop) {
+        hops.run(memory);
+        nextHops.clear();
+        for (size_t k = 0; k < hops.size(); ++k) {
+            MemoryView node = hops.view(k);
+            if (node.empty()) {
+                continue;
+            }
+            if (m_entries.size() >= MAX_ENTRIES) {
+                spdlog::warn("Hashtable at 0x{:X} has over {} entries, truncated", hashtableBase, MAX_ENTRIES);
+                return true;
+            }
+            
+            Entry entry{node.read<uint32_t>(0), node.read<uint64_t>(24)};
+            m_entries.push_back(entry);
+            m_values.emplace(entry.id, entry.value);
+            
+            uint64_t nextPtr = node.readPointer(8, true);
+            if (nextPtr != 0) {
+                nextHops.add(nextPtr, 32);
+            }
+        }
+        std::swap(hops, nextHops);
+    }
+    return true;
+}
+
+void RemoteHashtable::clear() {
+    m_entries.clear();
+    m_values.clear();
+    m_valid = false;
+}
+
+} // namespace lotro
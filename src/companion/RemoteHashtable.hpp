@@ -0,0 +1,73 @@
+/**
+ * LOTRO Launcher - Remote Hashtable
+ * 
+ * Local copy of a property hashtable in the client's memory.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "ProcessMemory.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Property hashtable read in bulk
+ * 
+ * load() reads the header and the bucket array, then walks every chain
+ * breadth-first, one batched read per hop, and keeps the id -> value
+ * pairs locally. Lookups after that are local hash probes, independent
+ * of how the client hashes its keys.
+ * 
+ * 64-bit layout: +16 bucket array pointer, +32 bucket count. Nodes are
+ * 32 bytes: id at 0, next at 8, value at 24.
+ */
+class RemoteHashtable {
+public:
+    struct Entry {
+        uint32_t id = 0;
+        uint64_t value = 0;
+    };
+    
+    /**
+     * Read the table at a hashtable base address
+     * @param hops, nextHops Scratch batches, reused across tables
+     * @return false if the header doesn't look like a hashtable
+     */
+    bool load(ProcessMemory& memory, uint64_t hashtableBase, MemoryBatch& hops, MemoryBatch& nextHops);
+    
+    void clear();
+    
+    bool isValid() const { return m_valid; }
+    size_t size() const { return m_entries.size(); }
+    
+    /**
+     * Look up a property value by id
+     */
+    std::optional<uint64_t> find(uint32_t id) const {
+        auto it = m_values.find(id);
+        return it != m_values.end() ? std::optional<uint64_t>(it->second) : std::nullopt;
+    }
+    
+    /**
+     * All entries, in the order they were read
+     */
+    const std::vector<Entry>& entries() const { return m_entries; }
+    
+    static constexpr uint32_t MAX_BUCKETS = 100000;
+    static constexpr int MAX_CHAIN_LENGTH = 50;
+    static constexpr size_t MAX_ENTRIES = 65536;
+
+private:
+    std::vector<Entry> m_entries;
+    std::unordered_map<uint32_t, uint64_t> m_values;
+    bool m_valid = false;
+};
+
+} // namespace lotro
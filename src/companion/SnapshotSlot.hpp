@@ -0,0 +1,53 @@
+/**
+ * LOTRO Launcher - Snapshot Slot
+ * 
+ * Lock-free handoff of the latest value from one producer thread.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace lotro {
+
+/**
+ * Single-producer, single-consumer mailbox holding only the newest value
+ * 
+ * publish() swaps a heap snapshot into the slot with one atomic exchange
+ * and hands back whatever the consumer had not taken yet, so the producer
+ * can fold it into the new value or drop it. take() empties the slot the
+ * same way. Neither side ever waits on the other.
+ */
+template<typename T>
+class SnapshotSlot {
+public:
+    SnapshotSlot() = default;
+    SnapshotSlot(const SnapshotSlot&) = delete;
+    SnapshotSlot& operator=(const SnapshotSlot&) = delete;
+    
+    ~SnapshotSlot() { delete m_value.load(std::memory_order_acquire); }
+    
+    /**
+     * Store a new value (producer side)
+     * @return The previous value if it was never taken
+     */
+    std::unique_ptr<T> publish(std::unique_ptr<T> value) {
+        return std::unique_ptr<T>(m_value.exchange(value.release(), std::memory_order_acq_rel));
+    }
+    
+    /**
+     * Take the newest value, leaving the slot empty (consumer side)
+     * @return nullptr if nothing was published since the last take
+     */
+    std::unique_ptr<T> take() {
+        return std::unique_ptr<T>(m_value.exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+private:
+    std::atomic<T*> m_value{nullptr};
+};
+
+} // namespace lotro
@@ -6,15 +6,71 @@
 
 #include "StatCalculator.hpp"
 
+#include <algorithm>
+
 namespace lotro {
 
+namespace {
+
+/**
+ * Per-level coefficients of the simplified rating formulas
+ * 
+ * Crit chance is rating / (200 + 20 * level) * 100; mitigation is
+ * rating / (rating + 100 + 40 * level) * 100. The cap ratings are where
+ * the results reach the caps, so capped ratings skip the division.
+ */
+struct RatingCurve {
+    double critScale = 0.0;
+    double critCapRating = 0.0;
+    double mitigationFactor = 0.0;
+    double mitigationCapRating = 0.0;
+};
+
+constexpr RatingCurve makeRatingCurve(int level) {
+    double critFactor = 200.0 + (level * 20.0);
+    double mitigationFactor = 100.0 + (level * 40.0);
+    RatingCurve curve;
+    curve.critScale = 100.0 / critFactor;
+    curve.critCapRating = critFactor * (StatCalculator::CRIT_CAP / 100.0);
+    curve.mitigationFactor = mitigationFactor;
+    // r / (r + f) = cap  <=>  r = f * cap / (1 - cap)
+    curve.mitigationCapRating = mitigationFactor * StatCalculator::MITIGATION_CAP
+                              / (100.0 - StatCalculator::MITIGATION_CAP);
+    return curve;
+}
+
+constexpr int MAX_CURVE_LEVEL = 200;
+
+constexpr std::array<RatingCurve, MAX_CURVE_LEVEL + 1> RATING_CURVES = [] {
+    std::array<RatingCurve, MAX_CURVE_LEVEL + 1> curves{};
+    for (int level = 0; level <= MAX_CURVE_LEVEL; ++level) {
+        curves[static_cast<size_t>(level)] = makeRatingCurve(level);
+    }
+    return curves;
+}();
+
+RatingCurve ratingCurve(int level) {
+    if (level >= 0 && level <= MAX_CURVE_LEVEL) {
+        return RATING_CURVES[static_cast<size_t>(level)];
+    }
+    // Out-of-table levels are rare enough to compute on the fly
+    return makeRatingCurve(level);
+}
+
+} // anonymous namespace
+
 CalculatedStats StatCalculator::calculate(const CharacterBuild& build) const {
-    // Gather all stat totals
-    std::unordered_map<StatType, int> totals;
+    return derive(totals(build), build.level);
+}
+
+StatVector StatCalculator::totals(const CharacterBuild& build) const {
+    StatVector totals;
     
     // Add base stats
     for (const auto& [type, value] : build.baseStats) {
-        totals[type] += value;
+        if (type != StatType::Unknown) {
+            totals[type] += value;
+        }
     }
     
     // Add gear stats
@@ -23,9 +79,37 @@ CalculatedStats StatCalculator::calculate(const CharacterBuild& build) const {
     // Add set bonuses
     addSetBonuses(totals, build);
     
-    // Build result
+    return totals;
+}
+
+CalculatedStats StatCalculator::derive(const StatVector& totals, int level) const {
     CalculatedStats result;
+    deriveRatings(totals, result);
+    
+    // Calculate derived percentages
+    result.criticalChance = calculateCritChance(result.criticalRating, level);
+    result.physicalMitigationPercent = calculateMitigation(result.physicalMitigation, level);
+    result.tacticalMitigationPercent = calculateMitigation(result.tacticalMitigation, level);
     
+    return result;
+}
+
+void StatCalculator::rederive(const StatVector& totals, const StatVector& previous, int level,
+                              CalculatedStats& stats) const {
+    deriveRatings(totals, stats);
+    
+    if (totals[StatType::CriticalRating] != previous[StatType::CriticalRating]) {
+        stats.criticalChance = calculateCritChance(stats.criticalRating, level);
+    }
+    if (totals[StatType::PhysicalMitigation] != previous[StatType::PhysicalMitigation]) {
+        stats.physicalMitigationPercent = calculateMitigation(stats.physicalMitigation, level);
+    }
+    if (totals[StatType::TacticalMitigation] != previous[StatType::TacticalMitigation]) {
+        stats.tacticalMitigationPercent = calculateMitigation(stats.tacticalMitigation, level);
+    }
+}
+
+void StatCalculator::deriveRatings(const StatVector& totals, CalculatedStats& result) const {
     // Primary stats
     result.might = totals[StatType::Might];
     result.agility = totals[StatType::Agility];
@@ -62,13 +146,6 @@ CalculatedStats StatCalculator::calculate(const CharacterBuild& build) const {
     result.incomingHealing = totals[StatType::IncomingHealing];
     result.outgoingHealing = totals[StatType::OutgoingHealing];
     result.lightOfEarendil = totals[StatType::LightOfEarendil];
-    
-    // Calculate derived percentages
-    result.criticalChance = calculateCritChance(result.criticalRating, build.level);
-    result.physicalMitigationPercent = calculateMitigation(result.physicalMitigation, build.level);
-    result.tacticalMitigationPercent = calculateMitigation(result.tacticalMitigation, build.level);
-    
-    return result;
 }
 
 int StatCalculator::getStatTotal(const CharacterBuild& build, StatType type) const {
@@ -89,45 +166,51 @@ int StatCalculator::getStatTotal(const CharacterBuild& build, StatType type) con
 }
 
 double StatCalculator::calculateCritChance(int rating, int level) const {
-    // Simplified LOTRO crit formula
-    // Real formula is more complex with caps and curves
-    double levelFactor = 200.0 + (level * 20.0);
-    double chance = (rating / levelFactor) * 100.0;
+    const RatingCurve curve = ratingCurve(level);
     
     // Cap at 25% (can be modified by virtues/traits)
-    if (chance > 25.0) {
-        chance = 25.0;
+    if (rating >= curve.critCapRating) {
+        return CRIT_CAP;
     }
-    
-    return chance;
+    return rating * curve.critScale;
 }
 
 double StatCalculator::calculateMitigation(int rating, int level) const {
-    // Simplified mitigation formula
-    // Against level-appropriate enemies
-    double targetLevel = static_cast<double>(level);
-    double levelFactor = 100.0 + (targetLevel * 40.0);
-    double mitigation = (rating / (rating + levelFactor)) * 100.0;
+    const RatingCurve curve = ratingCurve(level);
     
     // Cap at 60% base (can be higher with armor type bonuses)
-    if (mitigation > 60.0) {
-        mitigation = 60.0;
+    if (rating >= curve.mitigationCapRating) {
+        return MITIGATION_CAP;
     }
-    
-    return mitigation;
+    return std::min((rating / (rating + curve.mitigationFactor)) * 100.0, MITIGATION_CAP);
 }
 
-void StatCalculator::addGearStats(std::unordered_map<StatType, int>& totals,
-                                  const CharacterBuild& build) const {
+void StatCalculator::calculateCritChances(std::span<const int> ratings, int level,
+                                          std::span<double> out) const {
+    const RatingCurve curve = ratingCurve(level);
+    size_t count = std::min(ratings.size(), out.size());
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = std::min(ratings[i] * curve.critScale, CRIT_CAP);
+    }
+}
+
+void StatCalculator::calculateMitigations(std::span<const int> ratings, int level,
+                                          std::span<double> out) const {
+    const RatingCurve curve = ratingCurve(level);
+    size_t count = std::min(ratings.size(), out.size());
+    for (size_t i = 0; i < count; ++i) {
+        double rating = ratings[i];
+        out[i] = std::min((rating / (rating + curve.mitigationFactor)) * 100.0, MITIGATION_CAP);
+    }
+}
+
+void StatCalculator::addGearStats(StatVector& totals, const CharacterBuild& build) const {
     for (const auto& [slot, item] : build.equipment) {
-        for (const auto& stat : item.stats) {
-            totals[stat.type] += stat.value;
-        }
+        totals.addStats(item.stats);
     }
 }
 
-void StatCalculator::addSetBonuses(std::unordered_map<StatType, int>& totals,
-                                   const CharacterBuild& build) const {
+void StatCalculator::addSetBonuses(StatVector& totals, const CharacterBuild& build) const {
     // Count pieces per set
     std::unordered_map<std::string, int> setPieces;
     for (const auto& [slot, item] : build.equipment) {
@@ -137,17 +220,228 @@ void StatCalculator::addSetBonuses(std::unordered_map<StatType, int>& totals,
     }
     
     // Apply set bonuses
-    auto& itemDb = ItemDatabase::instance();
+    auto itemDb = ItemDatabase::current();
     for (const auto& [setName, count] : setPieces) {
-        auto bonuses = itemDb.getSetBonuses(QString::fromStdString(setName));
+        auto bonuses = itemDb->getSetBonuses(QString::fromStdString(setName));
         for (const auto& bonus : bonuses) {
             if (count >= bonus.piecesRequired) {
-                for (const auto& stat : bonus.bonusStats) {
-                    totals[stat.type] += stat.value;
-                }
+                totals.addStats(bonus.bonusStats);
+            }
+        }
+    }
+}
+
+// ============ IncrementalStatCalculator ============
+
+void IncrementalStatCalculator::reset(const CharacterBuild& build) {
+    m_level = build.level;
+    m_equipped = {};
+    m_setPieces.clear();
+    
+    for (const auto& [slot, item] : build.equipment) {
+        size_t index = static_cast<size_t>(slot);
+        if (index >= SLOT_COUNT) {
+            continue;
+        }
+        m_equipped[index] = Equipped{StatVector::fromStats(item.stats), item.setName};
+        if (!item.setName.isEmpty()) {
+            ++m_setPieces[item.setName];
+        }
+    }
+    
+    m_totals = m_calculator.totals(build);
+    m_stats = m_calculator.derive(m_totals, m_level);
+}
+
+void IncrementalStatCalculator::setLevel(int level) {
+    if (level == m_level) {
+        return;
+    }
+    m_level = level;
+    m_stats = m_calculator.derive(m_totals, m_level);
+}
+
+void IncrementalStatCalculator::equip(const GearItem& item) {
+    apply(item.slot, &item);
+}
+
+void IncrementalStatCalculator::unequip(EquipSlot slot) {
+    apply(slot, nullptr);
+}
+
+CalculatedStats IncrementalStatCalculator::preview(const GearItem& item) const {
+    CalculatedStats stats = m_stats;
+    m_calculator.rederive(totalsWith(item.slot, &item), m_totals, m_level, stats);
+    return stats;
+}
+
+StatVector IncrementalStatCalculator::totalsWith(EquipSlot slot, const GearItem* item) const {
+    StatVector totals = m_totals;
+    size_t index = static_cast<size_t>(slot);
+    if (index >= SLOT_COUNT) {
+        return totals;
+    }
+    
+    const std::optional<Equipped>& old = m_equipped[index];
+    if (old) {
+        totals -= old->stats;
+    }
+    if (item) {
+        totals.addStats(item->stats);
+    }
+    
+    // Move the piece between sets, swapping the active tiers of both
+    QString oldSet = old ? old->setName : QString();
+    QString newSet = item ? item->setName : QString();
+    if (oldSet != newSet) {
+        if (!oldSet.isEmpty()) {
+            int pieces = setPieces(oldSet);
+            totals -= setBonus(oldSet, pieces);
+            totals += setBonus(oldSet, pieces - 1);
+        }
+        if (!newSet.isEmpty()) {
+            int pieces = setPieces(newSet);
+            totals -= setBonus(newSet, pieces);
+            totals += setBonus(newSet, pieces + 1);
+        }
+    }
+    return totals;
+}
+
+void IncrementalStatCalculator::apply(EquipSlot slot, const GearItem* item) {
+    size_t index = static_cast<size_t>(slot);
+    if (index >= SLOT_COUNT) {
+        return;
+    }
+    
+    StatVector previous = m_totals;
+    m_totals = totalsWith(slot, item);
+    
+    std::optional<Equipped>& equipped = m_equipped[index];
+    if (equipped && !equipped->setName.isEmpty()) {
+        if (--m_setPieces[equipped->setName] <= 0) {
+            m_setPieces.remove(equipped->setName);
+        }
+    }
+    if (item) {
+        equipped = Equipped{StatVector::fromStats(item->stats), item->setName};
+        if (!item->setName.isEmpty()) {
+            ++m_setPieces[item->setName];
+        }
+    } else {
+        equipped.reset();
+    }
+    
+    m_calculator.rederive(m_totals, previous, m_level, m_stats);
+}
+
+UpgradeRanker IncrementalStatCalculator::ranker(EquipSlot slot, const UpgradeRanker::Weights& weights) const {
+    UpgradeRanker ranker;
+    for (size_t i = 0; i < StatVector::STAT_COUNT; ++i) {
+        ranker.m_weights[i] = static_cast<float>(weights[i]);
+    }
+    
+    StatVector emptied = totalsWith(slot, nullptr);
+    emptied -= m_totals;
+    ranker.m_baseValue = ranker.dot(emptied);
+    
+    ranker.m_setPieces = m_setPieces;
+    size_t index = static_cast<size_t>(slot);
+    if (index < SLOT_COUNT && m_equipped[index] && !m_equipped[index]->setName.isEmpty()) {
+        --ranker.m_setPieces[m_equipped[index]->setName];
+    }
+    return ranker;
+}
+
+float UpgradeRanker::dot(const StatVector& stats) const {
+    // Eight independent sums, one per lane, so the loop vectorizes
+    // without reassociating a single float sum
+    std::array<float, 8> sums{};
+    for (size_t i = 0; i < StatVector::LANES; i += 8) {
+        for (size_t lane = 0; lane < 8; ++lane) {
+            sums[lane] += static_cast<float>(stats.values[i + lane]) * m_weights[i + lane];
+        }
+    }
+    float total = 0.0f;
+    for (float sum : sums) {
+        total += sum;
+    }
+    return total;
+}
+
+float UpgradeRanker::setValue(const ItemDatabase& db, const QString& setName) const {
+    int pieces = m_setPieces.value(setName, 0);
+    StatVector gained;
+    for (const auto& bonus : db.getSetBonuses(setName)) {
+        if (bonus.piecesRequired == pieces + 1) {
+            gained.addStats(bonus.bonusStats);
+        }
+    }
+    return dot(gained);
+}
+
+void UpgradeRanker::evaluate(const ItemDatabase& db, std::span<const uint32_t> positions,
+                             std::span<float> out) const {
+    std::span<const GearItem> items = db.itemsView();
+    QHash<QString, float> setValues;
+    
+    StatVector stats;
+    for (size_t i = 0; i < positions.size() && i < out.size(); ++i) {
+        const GearItem& item = items[positions[i]];
+        stats.values.fill(0);
+        stats.addStats(item.stats);
+        float value = m_baseValue + dot(stats);
+        
+        if (!item.setName.isEmpty()) {
+            auto it = setValues.constFind(item.setName);
+            if (it == setValues.constEnd()) {
+                it = setValues.insert(item.setName, setValue(db, item.setName));
             }
+            value += it.value();
         }
+        out[i] = value;
+    }
+}
+
+void UpgradeRanker::rank(const ItemDatabase& db, std::vector<uint32_t>& positions,
+                         std::vector<float>& values) const {
+    std::vector<float> scores(positions.size());
+    evaluate(db, positions, scores);
+    
+    std::vector<uint32_t> order(positions.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return scores[a] > scores[b]; });
+    
+    std::vector<uint32_t> ranked;
+    ranked.reserve(order.size());
+    values.clear();
+    values.reserve(order.size());
+    for (uint32_t i : order) {
+        ranked.push_back(positions[i]);
+        values.push_back(scores[i]);
     }
+    positions = std::move(ranked);
+}
+
+StatVector IncrementalStatCalculator::setBonus(const QString& setName, int pieces) const {
+    auto it = m_setTiers.find(setName);
+    if (it == m_setTiers.end()) {
+        std::vector<std::pair<int, StatVector>> tiers;
+        for (const auto& bonus : ItemDatabase::current()->getSetBonuses(setName)) {
+            tiers.emplace_back(bonus.piecesRequired, StatVector::fromStats(bonus.bonusStats));
+        }
+        it = m_setTiers.insert(setName, std::move(tiers));
+    }
+    
+    StatVector total;
+    for (const auto& [required, stats] : it.value()) {
+        if (pieces >= required) {
+            total += stats;
+        }
+    }
+    return total;
 }
 
 } // namespace lotro
@@ -10,10 +10,71 @@
 #pragma once
 
 #include "ItemDatabase.hpp"
+#include <QHash>
+#include <array>
+#include <cstdint>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace lotro {
 
+/**
+ * Dense stat totals indexed by StatType
+ * 
+ * One int32 lane per stat, padded to a multiple of eight lanes, so adding
+ * two vectors is a fixed-length loop the compiler turns into a handful of
+ * SIMD adds. Items and set bonuses are flattened into this layout once and
+ * then summed per build.
+ */
+struct alignas(32) StatVector {
+    static constexpr size_t STAT_COUNT = static_cast<size_t>(StatType::Unknown);
+    static constexpr size_t LANES = (STAT_COUNT + 7) & ~size_t(7);
+    
+    std::array<int32_t, LANES> values{};
+    
+    /**
+     * Flatten a list of item stats (duplicates add up, Unknown is dropped)
+     */
+    static StatVector fromStats(const std::vector<ItemStat>& stats) {
+        StatVector v;
+        v.addStats(stats);
+        return v;
+    }
+    
+    void addStats(const std::vector<ItemStat>& stats) {
+        for (const auto& stat : stats) {
+            size_t lane = static_cast<size_t>(stat.type);
+            if (lane < STAT_COUNT) {
+                values[lane] += stat.value;
+            }
+        }
+    }
+    
+    int32_t operator[](StatType type) const {
+        size_t lane = static_cast<size_t>(type);
+        return lane < STAT_COUNT ? values[lane] : 0;
+    }
+    
+    int32_t& operator[](StatType type) { return values[static_cast<size_t>(type)]; }
+    
+    StatVector& operator+=(const StatVector& other) {
+        for (size_t i = 0; i < LANES; ++i) {
+            values[i] += other.values[i];
+        }
+        return *this;
+    }
+    
+    StatVector& operator-=(const StatVector& other) {
+        for (size_t i = 0; i < LANES; ++i) {
+            values[i] -= other.values[i];
+        }
+        return *this;
+    }
+    
+    bool operator==(const StatVector&) const = default;
+};
+
 /**
  * Character build for stat calculation
  */
@@ -106,6 +167,25 @@ public:
      */
     CalculatedStats calculate(const CharacterBuild& build) const;
     
+    /**
+     * Sum base stats, gear and active set bonuses into a dense vector
+     */
+    StatVector totals(const CharacterBuild& build) const;
+    
+    /**
+     * Derive the final stats (resources, mastery, percentages) from totals
+     */
+    CalculatedStats derive(const StatVector& totals, int level) const;
+    
+    /**
+     * Update derived stats after the totals moved from previous to totals
+     * 
+     * Ratings are copied over; the crit and mitigation percentages are only
+     * re-evaluated if their ratings changed.
+     */
+    void rederive(const StatVector& totals, const StatVector& previous, int level,
+                  CalculatedStats& stats) const;
+    
     /**
      * Get total value of a stat type from build
      */
@@ -120,12 +200,135 @@ public:
      * Calculate mitigation percentage from rating
      */
     double calculateMitigation(int rating, int level) const;
+    
+    /**
+     * Crit chance for many ratings at one level (out[i] for ratings[i])
+     */
+    void calculateCritChances(std::span<const int> ratings, int level, std::span<double> out) const;
+    
+    /**
+     * Mitigation percentage for many ratings at one level (out[i] for ratings[i])
+     */
+    void calculateMitigations(std::span<const int> ratings, int level, std::span<double> out) const;
+    
+    static constexpr double CRIT_CAP = 25.0;
+    static constexpr double MITIGATION_CAP = 60.0;
+
+private:
+    void addGearStats(StatVector& totals, const CharacterBuild& build) const;
+    void addSetBonuses(StatVector& totals, const CharacterBuild& build) const;
+    
+    // Everything in derive() except the percentages
+    void deriveRatings(const StatVector& totals, CalculatedStats& result) const;
+};
+
+/**
+ * Scores candidates for one slot by the weighted stat change of equipping them
+ * 
+ * A candidate's value is sum(weight * delta) over the change in stat totals
+ * from swapping it into the slot, set tiers gained or lost included. The
+ * part that doesn't depend on the candidate (taking the equipped item and
+ * its set tier out) is scored once; per candidate the stats are flattened
+ * into a StatVector and dotted with the weights eight lanes at a time, and
+ * each set's tier change is scored once per call. Weights are float lanes
+ * so the dot product vectorizes. Made from IncrementalStatCalculator::
+ * ranker() on the owning thread; evaluate() may then run on any thread.
+ */
+class UpgradeRanker {
+public:
+    using Weights = std::array<double, StatVector::STAT_COUNT>;
+    
+    /**
+     * Values of the items at positions in db.itemsView() (out[i] for positions[i])
+     */
+    void evaluate(const ItemDatabase& db, std::span<const uint32_t> positions, std::span<float> out) const;
+    
+    /**
+     * Positions ordered by descending value, with their values
+     */
+    void rank(const ItemDatabase& db, std::vector<uint32_t>& positions, std::vector<float>& values) const;
+    
+private:
+    friend class IncrementalStatCalculator;
+    UpgradeRanker() = default;
+    
+    float dot(const StatVector& stats) const;
+    
+    // Value of the set tier change from adding one piece of setName
+    float setValue(const ItemDatabase& db, const QString& setName) const;
+    
+    alignas(32) std::array<float, StatVector::LANES> m_weights{};
+    float m_baseValue = 0.0f;                   // Emptying the slot
+    QHash<QString, int> m_setPieces;            // With the slot emptied
+};
 
+/**
+ * Stateful calculator that applies gear changes as deltas
+ * 
+ * Keeps the stat totals and set-piece counts of the current loadout.
+ * Equipping or removing an item subtracts the old item and its set tier,
+ * adds the new ones and re-derives only what changed, so previewing an
+ * item costs a few vector adds instead of a full recalculation.
+ * Set bonus tiers are fetched from ItemDatabase once per set.
+ * Not thread-safe; meant for one UI owner.
+ */
+class IncrementalStatCalculator {
+public:
+    IncrementalStatCalculator() = default;
+    
+    /**
+     * Start over from a full build
+     */
+    void reset(const CharacterBuild& build);
+    
+    void setLevel(int level);
+    
+    /**
+     * Put an item in its slot, replacing what was there
+     */
+    void equip(const GearItem& item);
+    
+    void unequip(EquipSlot slot);
+    
+    /**
+     * Stats of the current loadout
+     */
+    const CalculatedStats& stats() const { return m_stats; }
+    
+    /**
+     * Stats the loadout would have with item equipped, without changing it
+     */
+    CalculatedStats preview(const GearItem& item) const;
+    
+    /**
+     * Upgrade ranking of candidates for a slot against the current loadout
+     */
+    UpgradeRanker ranker(EquipSlot slot, const UpgradeRanker::Weights& weights) const;
+    
 private:
-    void addGearStats(std::unordered_map<StatType, int>& totals, 
-                     const CharacterBuild& build) const;
-    void addSetBonuses(std::unordered_map<StatType, int>& totals,
-                      const CharacterBuild& build) const;
+    struct Equipped {
+        StatVector stats;
+        QString setName;
+    };
+    
+    // Totals after putting item (or nothing) into slot
+    StatVector totalsWith(EquipSlot slot, const GearItem* item) const;
+    void apply(EquipSlot slot, const GearItem* item);
+    
+    int setPieces(const QString& setName) const { return m_setPieces.value(setName, 0); }
+    StatVector setBonus(const QString& setName, int pieces) const;
+    
+    static constexpr size_t SLOT_COUNT = static_cast<size_t>(EquipSlot::Unknown);
+    
+    StatCalculator m_calculator;
+    int m_level = 150;
+    std::array<std::optional<Equipped>, SLOT_COUNT> m_equipped;
+    QHash<QString, int> m_setPieces;
+    StatVector m_totals;
+    CalculatedStats m_stats;
+    
+    // Set name -> (pieces required, bonus) tiers
+    mutable QHash<QString, std::vector<std::pair<int, StatVector>>> m_setTiers;
 };
 
 } // namespace lotro
@@ -0,0 +1,68 @@
+/**
+ * LOTRO Launcher - String Pool
+ * 
+ * Interning for the repetitive string fields of game database records.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Interned strings with dense integer ids
+ * 
+ * intern() swaps a string for the pooled instance with the same text.
+ * QString is implicitly shared, so every record holding that value then
+ * points at one buffer instead of its own copy. The returned id lets
+ * filters compare integers instead of strings.
+ */
+class StringPool {
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+    
+    /**
+     * Replace value with its pooled instance, adding it if new
+     * @return The string's id
+     */
+    uint32_t intern(QString& value) {
+        auto it = m_ids.constFind(value);
+        if (it != m_ids.constEnd()) {
+            value = m_strings[it.value()];
+            return it.value();
+        }
+        uint32_t id = static_cast<uint32_t>(m_strings.size());
+        m_strings.push_back(value);
+        m_ids.insert(value, id);
+        return id;
+    }
+    
+    /**
+     * Id of a string, NOT_FOUND if it was never interned
+     */
+    uint32_t find(const QString& value) const {
+        return m_ids.value(value, NOT_FOUND);
+    }
+    
+    const QString& at(uint32_t id) const { return m_strings[id]; }
+    
+    size_t size() const { return m_strings.size(); }
+    
+    void clear() {
+        m_strings.clear();
+        m_ids.clear();
+    }
+    
+private:
+    std::vector<QString> m_strings;
+    QHash<QString, uint32_t> m_ids;
+};
+
+} // namespace lotro
@@ -0,0 +1,167 @@
+/**
+ * LOTRO Launcher - Sync Metrics Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "SyncMetrics.hpp"
+#include "core/Metrics.hpp"
+
+#include <QObject>
+#include <QSaveFile>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace lotro {
+
+const char* syncStageName(SyncStage stage) {
+    switch (stage) {
+        case SyncStage::Connect: return "connect";
+        case SyncStage::PlayerLookup: return "playerLookup";
+        case SyncStage::PropertyRead: return "propertyRead";
+        case SyncStage::Decode: return "decode";
+        case SyncStage::Save: return "save";
+        case SyncStage::Tick: return "tick";
+        case SyncStage::Count: break;
+    }
+    return "unknown";
+}
+
+void SyncMetrics::Histogram::add(uint64_t microseconds) {
+    size_t bucket = std::min<size_t>(std::bit_width(microseconds), BUCKETS - 1);
+    ++buckets[bucket];
+    ++count;
+    totalUs += microseconds;
+    maxUs = std::max(maxUs, microseconds);
+}
+
+uint64_t SyncMetrics::Histogram::percentileUs(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * count + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= target) {
+            // The open last bucket and coarse top buckets are capped by the max
+            return std::min(i == 0 ? 0 : (uint64_t(1) << i) - 1, maxUs);
+        }
+    }
+    return maxUs;
+}
+
+double SyncMetrics::Snapshot::cacheHitRate() const {
+    uint64_t total = reads.cachedReads + reads.uncachedReads;
+    return total > 0 ? static_cast<double>(reads.cachedReads) / total : 0.0;
+}
+
+void SyncMetrics::record(SyncStage stage, uint64_t microseconds) {
+    // Also kept process-wide, where they outlive a stopped sync
+    static const auto stageHistograms = [] {
+        std::array<metrics::Histogram*, static_cast<size_t>(SyncStage::Count)> histograms{};
+        for (size_t i = 0; i < histograms.size(); ++i) {
+            histograms[i] = &metrics::histogram(
+                QString("sync.%1_us").arg(syncStageName(static_cast<SyncStage>(i))));
+        }
+        return histograms;
+    }();
+    stageHistograms[static_cast<size_t>(stage)]->record(microseconds);
+    
+    QMutexLocker lock(&m_mutex);
+    m_data.stages[static_cast<size_t>(stage)].add(microseconds);
+}
+
+void SyncMetrics::setReadStats(const ProcessMemory::ReadStats& stats) {
+    QMutexLocker lock(&m_mutex);
+    m_data.reads = stats;
+}
+
+SyncMetrics::Snapshot SyncMetrics::snapshot() const {
+    QMutexLocker lock(&m_mutex);
+    return m_data;
+}
+
+void SyncMetrics::reset() {
+    QMutexLocker lock(&m_mutex);
+    m_data = Snapshot{};
+}
+
+QString SyncMetrics::summary(const Snapshot& snapshot) {
+    const Histogram& tick = snapshot.stage(SyncStage::Tick);
+    if (tick.count == 0) {
+        return QObject::tr("No syncs yet");
+    }
+    
+    auto ms = [](uint64_t us) { return QString::number(us / 1000.0, 'f', 1); };
+    uint64_t bytesPerSync = snapshot.reads.remoteBytes / tick.count;
+    uint64_t callsPerSync = snapshot.reads.syscalls / tick.count;
+    
+    return QObject::tr("Sync %1 ms p50, %2 ms p95 | %3 KiB, %4 reads per sync | cache hits %5%")
+        .arg(ms(tick.percentileUs(0.5)))
+        .arg(ms(tick.percentileUs(0.95)))
+        .arg(QString::number(bytesPerSync / 1024.0, 'f', 1))
+        .arg(callsPerSync)
+        .arg(qRound(snapshot.cacheHitRate() * 100));
+}
+
+nlohmann::json SyncMetrics::toJson(const Snapshot& snapshot) {
+    nlohmann::json stages = nlohmann::json::object();
+    for (size_t i = 0; i < snapshot.stages.size(); ++i) {
+        const Histogram& h = snapshot.stages[i];
+        
+        // Bucket upper bounds in microseconds, trailing empty buckets dropped
+        nlohmann::json buckets = nlohmann::json::array();
+        size_t used = h.buckets.size();
+        while (used > 0 && h.buckets[used - 1] == 0) {
+            --used;
+        }
+        for (size_t b = 0; b < used; ++b) {
+            buckets.push_back({{"belowUs", uint64_t(1) << b}, {"count", h.buckets[b]}});
+        }
+        
+        stages[syncStageName(static_cast<SyncStage>(i))] = {
+            {"count", h.count},
+            {"meanUs", h.meanUs()},
+            {"p50Us", h.percentileUs(0.5)},
+            {"p95Us", h.percentileUs(0.95)},
+            {"p99Us", h.percentileUs(0.99)},
+            {"maxUs", h.maxUs},
+            {"buckets", buckets},
+        };
+    }
+    
+    return {
+        {"stages", stages},
+        {"reads", {
+            {"remoteBytes", snapshot.reads.remoteBytes},
+            {"syscalls", snapshot.reads.syscalls},
+            {"cachedReads", snapshot.reads.cachedReads},
+            {"uncachedReads", snapshot.reads.uncachedReads},
+            {"pageFetches", snapshot.reads.pageFetches},
+            {"retainedPages", snapshot.reads.retainedPages},
+            {"dirtyPages", snapshot.reads.dirtyPages},
+            {"cacheHitRate", snapshot.cacheHitRate()},
+        }},
+    };
+}
+
+bool SyncMetrics::saveJson(const QString& path) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::error("Failed to open {} for writing", path.toStdString());
+        return false;
+    }
+    
+    file.write(QByteArray::fromStdString(toJson(snapshot()).dump(2)));
+    if (!file.commit()) {
+        spdlog::error("Failed to commit sync metrics {}", path.toStdString());
+        return false;
+    }
+    return true;
+}
+
+} // namespace lotro
@@ -0,0 +1,119 @@
+/**
+ * LOTRO Launcher - Sync Metrics
+ * 
+ * Per-stage timing and remote read counters for the live sync.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "ProcessMemory.hpp"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace lotro {
+
+/**
+ * Timed parts of a sync
+ */
+enum class SyncStage {
+    Connect,        // Attach and signature scan
+    PlayerLookup,   // Finding the player entity
+    PropertyRead,   // Copying property hashtables out of the client
+    Decode,         // Turning properties into CharacterInfo/CharacterData
+    Save,           // CharacterTracker autosave
+    Tick,           // One whole sync on the worker
+    Count
+};
+
+const char* syncStageName(SyncStage stage);
+
+/**
+ * Timing histograms and read counters, shared by the sync worker and the GUI
+ * 
+ * Durations go into power-of-two microsecond buckets, so percentiles are
+ * upper bounds within a factor of two; that is plenty to tell a 200 us
+ * sync from a 20 ms one. Recording takes a short lock.
+ */
+class SyncMetrics {
+public:
+    struct Histogram {
+        static constexpr size_t BUCKETS = 25;   // Bucket i holds < 2^i us; the last is open
+        
+        std::array<uint64_t, BUCKETS> buckets{};
+        uint64_t count = 0;
+        uint64_t totalUs = 0;
+        uint64_t maxUs = 0;
+        
+        void add(uint64_t microseconds);
+        double meanUs() const { return count > 0 ? static_cast<double>(totalUs) / count : 0.0; }
+        
+        /**
+         * Upper bound of the bucket holding the given fraction of samples
+         */
+        uint64_t percentileUs(double fraction) const;
+    };
+    
+    struct Snapshot {
+        std::array<Histogram, static_cast<size_t>(SyncStage::Count)> stages;
+        ProcessMemory::ReadStats reads;
+        
+        const Histogram& stage(SyncStage s) const { return stages[static_cast<size_t>(s)]; }
+        double cacheHitRate() const;
+    };
+    
+    /**
+     * Times a scope into a stage; does nothing without metrics
+     */
+    class ScopedTimer {
+    public:
+        ScopedTimer(SyncMetrics* metrics, SyncStage stage) : m_metrics(metrics), m_stage(stage) {
+            if (m_metrics) {
+                m_timer.start();
+            }
+        }
+        ~ScopedTimer() {
+            if (m_metrics) {
+                m_metrics->record(m_stage, static_cast<uint64_t>(m_timer.nsecsElapsed() / 1000));
+            }
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    
+    private:
+        SyncMetrics* m_metrics;
+        SyncStage m_stage;
+        QElapsedTimer m_timer;
+    };
+    
+    void record(SyncStage stage, uint64_t microseconds);
+    
+    /**
+     * Replace the read counters with the extractor's current totals
+     */
+    void setReadStats(const ProcessMemory::ReadStats& stats);
+    
+    Snapshot snapshot() const;
+    void reset();
+    
+    /**
+     * One-line summary for the status widget
+     */
+    static QString summary(const Snapshot& snapshot);
+    
+    static nlohmann::json toJson(const Snapshot& snapshot);
+    bool saveJson(const QString& path) const;
+
+private:
+    mutable QMutex m_mutex;
+    Snapshot m_data;
+};
+
+} // namespace lotro
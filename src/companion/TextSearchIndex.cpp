@@ -0,0 +1,216 @@
+/**
+ * LOTRO Launcher - Text Search Index
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "TextSearchIndex.hpp"
+
+#include <algorithm>
+
+namespace lotro {
+
+namespace {
+
+// Joins a record's fields; never part of a query, so no match spans two fields
+constexpr QChar FIELD_SEPARATOR = QChar(0x0001);
+
+enum Rank {
+    RankExactName = 0,
+    RankNamePrefix,
+    RankNameWordPrefix,
+    RankNameSubstring,
+    RankOtherField
+};
+
+bool isWordChar(QChar c) {
+    return c.isLetterOrNumber();
+}
+
+} // anonymous namespace
+
+void TextSearchIndex::clear() {
+    m_docs.clear();
+    m_fields.clear();
+    m_trigrams.clear();
+    m_wordPrefixes.clear();
+}
+
+quint64 TextSearchIndex::gramKey(const QChar* chars, qsizetype count) {
+    quint64 key = static_cast<quint64>(count) << 48;
+    for (qsizetype i = 0; i < count; ++i) {
+        key |= static_cast<quint64>(chars[i].unicode()) << (16 * i);
+    }
+    return key;
+}
+
+void TextSearchIndex::post(QHash<quint64, std::vector<uint32_t>>& postings, quint64 key, uint32_t id) {
+    // Records are added in order, so each list stays sorted
+    auto& list = postings[key];
+    if (list.empty() || list.back() != id) {
+        list.push_back(id);
+    }
+}
+
+void TextSearchIndex::add(const QString& name, std::initializer_list<QString> fields) {
+    const uint32_t id = static_cast<uint32_t>(m_docs.size());
+    
+    Doc doc;
+    doc.name = name.toCaseFolded();
+    doc.firstField = static_cast<uint32_t>(m_fields.size());
+    
+    // Postings are built from a folded copy of all fields that is dropped
+    // afterwards; only the name is kept folded
+    QString text = doc.name;
+    for (const QString& field : fields) {
+        if (!field.isEmpty()) {
+            m_fields.push_back(field);
+            ++doc.fieldCount;
+            text += FIELD_SEPARATOR;
+            text += field.toCaseFolded();
+        }
+    }
+    
+    const QChar* chars = text.constData();
+    const qsizetype length = text.size();
+    for (qsizetype i = 0; i + 3 <= length; ++i) {
+        post(m_trigrams, gramKey(chars + i, 3), id);
+    }
+    for (qsizetype i = 0; i < length; ++i) {
+        if (!isWordChar(chars[i]) || (i > 0 && isWordChar(chars[i - 1]))) {
+            continue;
+        }
+        post(m_wordPrefixes, gramKey(chars + i, 1), id);
+        if (i + 1 < length && isWordChar(chars[i + 1])) {
+            post(m_wordPrefixes, gramKey(chars + i, 2), id);
+        }
+    }
+    
+    m_docs.push_back(std::move(doc));
+}
+
+std::vector<uint32_t> TextSearchIndex::trigramCandidates(const QString& folded) const {
+    std::vector<const std::vector<uint32_t>*> lists;
+    for (qsizetype i = 0; i + 3 <= folded.size(); ++i) {
+        auto it = m_trigrams.constFind(gramKey(folded.constData() + i, 3));
+        if (it == m_trigrams.constEnd()) {
+            return {};
+        }
+        lists.push_back(&it.value());
+    }
+    
+    // Intersect smallest first so the working set only shrinks
+    std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) {
+        return a->size() < b->size();
+    });
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+    
+    std::vector<uint32_t> result = *lists.front();
+    std::vector<uint32_t> scratch;
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        scratch.clear();
+        std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(),
+                              std::back_inserter(scratch));
+        result.swap(scratch);
+    }
+    return result;
+}
+
+int TextSearchIndex::rank(const Doc& doc, const QString& folded) const {
+    const QString& name = doc.name;
+    qsizetype pos = name.indexOf(folded);
+    if (pos == 0) {
+        return name.size() == folded.size() ? RankExactName : RankNamePrefix;
+    }
+    if (pos > 0) {
+        for (qsizetype at = pos; at > 0; at = name.indexOf(folded, at + 1)) {
+            if (!isWordChar(name[at - 1])) {
+                return RankNameWordPrefix;
+            }
+        }
+        return RankNameSubstring;
+    }
+    for (uint32_t i = 0; i < doc.fieldCount; ++i) {
+        if (m_fields[doc.firstField + i].contains(folded, Qt::CaseInsensitive)) {
+            return RankOtherField;
+        }
+    }
+    return -1;
+}
+
+std::vector<uint32_t> TextSearchIndex::search(const QString& query, size_t limit) const {
+    std::vector<uint32_t> results;
+    const size_t total = m_docs.size();
+    
+    if (query.isEmpty()) {
+        results.resize(limit > 0 ? std::min(limit, total) : total);
+        for (size_t i = 0; i < results.size(); ++i) {
+            results[i] = static_cast<uint32_t>(i);
+        }
+        return results;
+    }
+    
+    const QString folded = query.toCaseFolded();
+    std::vector<uint32_t> candidates;
+    if (folded.size() >= 3) {
+        candidates = trigramCandidates(folded);
+    } else if (std::all_of(folded.begin(), folded.end(), isWordChar)) {
+        auto it = m_wordPrefixes.constFind(gramKey(folded.constData(), folded.size()));
+        if (it != m_wordPrefixes.constEnd()) {
+            candidates = it.value();
+        }
+    } else {
+        // Short punctuation queries aren't indexed; check every record
+        candidates.resize(total);
+        for (size_t i = 0; i < total; ++i) {
+            candidates[i] = static_cast<uint32_t>(i);
+        }
+    }
+    
+    return ranked(folded, candidates, limit);
+}
+
+std::vector<uint32_t> TextSearchIndex::refine(const QString& query, std::span<const uint32_t> candidates,
+                                              size_t limit) const {
+    if (query.isEmpty()) {
+        return search(query, limit);
+    }
+    return ranked(query.toCaseFolded(), candidates, limit);
+}
+
+bool TextSearchIndex::narrows(const QString& previous, const QString& query) {
+    const QString before = previous.toCaseFolded();
+    const QString after = query.toCaseFolded();
+    if (before.isEmpty() || !after.startsWith(before)) {
+        return false;
+    }
+    // Short word queries match word prefixes, which rank() doesn't check,
+    // and "ab" doesn't cover everything "abc" matches anywhere. Past that
+    // every query is a substring match, and a longer one matches less.
+    return before.size() >= 3 || !std::all_of(before.begin(), before.end(), isWordChar);
+}
+
+std::vector<uint32_t> TextSearchIndex::ranked(const QString& folded, std::span<const uint32_t> candidates,
+                                              size_t limit) const {
+    std::vector<std::pair<int, uint32_t>> scored;
+    scored.reserve(candidates.size());
+    for (uint32_t id : candidates) {
+        int score = rank(m_docs[id], folded);
+        if (score >= 0) {
+            scored.emplace_back(score, id);
+        }
+    }
+    
+    // Positions are unique, so (rank, position) is a total order
+    size_t count = limit > 0 ? std::min(limit, scored.size()) : scored.size();
+    std::partial_sort(scored.begin(), scored.begin() + static_cast<std::ptrdiff_t>(count), scored.end());
+    
+    std::vector<uint32_t> results;
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        results.push_back(scored[i].second);
+    }
+    return results;
+}
+
+} // namespace lotro
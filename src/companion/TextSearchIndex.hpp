@@ -0,0 +1,107 @@
+/**
+ * LOTRO Launcher - Text Search Index
+ * 
+ * Inverted trigram/token index behind the GameDatabase search APIs.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Full-text index over the records of one table
+ * 
+ * Each record is added as a name plus optional secondary fields, matched
+ * case-insensitively. Queries of three or more characters are substring matches:
+ * candidates come from intersecting the query's trigram posting lists and
+ * are then verified against the text. One- and two-character queries
+ * match word prefixes, which is what type-ahead wants after a keystroke
+ * or two.
+ * 
+ * Results are ranked: exact name, name prefix, word prefix in the name,
+ * anywhere in the name, then secondary fields only. Ties keep record
+ * order, so an empty query lists every record in order.
+ */
+class TextSearchIndex {
+public:
+    /**
+     * Drop all records
+     */
+    void clear();
+    
+    /**
+     * Reserve room for a number of records
+     */
+    void reserve(size_t count) { m_docs.reserve(count); }
+    
+    /**
+     * Add the next record; its position in the table is its insertion order
+     * @param name Primary field, ranked above the others
+     * @param fields Secondary fields that also match
+     */
+    void add(const QString& name, std::initializer_list<QString> fields = {});
+    
+    /**
+     * Find matching records
+     * @param limit Maximum number of results, 0 for all
+     * @return Record positions, best match first
+     */
+    std::vector<uint32_t> search(const QString& query, size_t limit = 0) const;
+    
+    /**
+     * Like search(), but only among the given records, which must include
+     * every match; for narrowing the results of an earlier query
+     */
+    std::vector<uint32_t> refine(const QString& query, std::span<const uint32_t> candidates,
+                                 size_t limit = 0) const;
+    
+    /**
+     * Whether every match of query is also a match of previous, so the
+     * uncapped results of previous can be refined instead of searching
+     */
+    static bool narrows(const QString& previous, const QString& query);
+    
+    size_t size() const { return m_docs.size(); }
+    
+private:
+    struct Doc {
+        QString name;           // Case-folded
+        uint32_t firstField = 0;
+        uint32_t fieldCount = 0;
+    };
+    
+    // Records containing every trigram of a query (not yet verified)
+    std::vector<uint32_t> trigramCandidates(const QString& folded) const;
+    
+    // Rank of a record for a query, -1 if it doesn't match
+    int rank(const Doc& doc, const QString& folded) const;
+    
+    // Matching candidates, best first
+    std::vector<uint32_t> ranked(const QString& folded, std::span<const uint32_t> candidates,
+                                 size_t limit) const;
+    
+    // Pack up to three UTF-16 units and their count into a posting key
+    static quint64 gramKey(const QChar* chars, qsizetype count);
+    
+    static void post(QHash<quint64, std::vector<uint32_t>>& postings, quint64 key, uint32_t id);
+    
+    std::vector<Doc> m_docs;
+    // Secondary fields as given: shared with the records rather than
+    // folded copies, so long descriptions aren't held twice
+    std::vector<QString> m_fields;
+    // Posting lists hold sorted, unique record positions
+    QHash<quint64, std::vector<uint32_t>> m_trigrams;
+    QHash<quint64, std::vector<uint32_t>> m_wordPrefixes;   // One- and two-character word prefixes
+};
+
+} // namespace lotro
@@ -1,6 +1,11 @@
 #include "DataExporter.hpp"
-#include <QThread>
+#include "ExportSnapshot.hpp"
+#include "ExportWriter.hpp"
+#include <QCoreApplication>
 #include <QFile>
+#include <QFutureWatcher>
+#include <QSaveFile>
+#include <QtConcurrent>
 #include <QDir>
 #include <QDateTime>
 #include <QStandardPaths>
@@ -10,21 +15,27 @@
 
 #include "dat/DataFacade.hpp"
 #include "companion/CharacterExtractor.hpp"
+#include "companion/CharacterTracker.hpp"
 #include "companion/ProcessMemory.hpp"
 #include "companion/GameDatabase.hpp"
 
 #include <spdlog/spdlog.h>
+#include <atomic>
 
 namespace lotro {
 
-DataExporter::DataExporter(dat::DataFacade* facade, ProcessMemory* memory, QObject* parent)
-    : QObject(parent), m_facade(facade), m_memory(memory)
+DataExporter::DataExporter(std::shared_ptr<dat::DataFacade> facade, ProcessMemory* memory, QObject* parent)
+    : QObject(parent), m_facade(std::move(facade)), m_memory(memory)
 {
     // Default output path: ~/Documents/lotro-launcher/exports/
     m_outputPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) 
                    + "/lotro-launcher/exports";
 }
 
+DataExporter::~DataExporter() {
+    m_batch.waitForFinished();
+}
+
 std::vector<ElementDefinition> DataExporter::getSupportedElements() {
     return {
         {ExtractableElement::BasicInfo, "Basic Info (Character/Account)", true},
@@ -54,6 +65,14 @@ void DataExporter::setOutputPath(const QString& path) {
     m_outputPath = path;
 }
 
+void DataExporter::setFormat(ExportFormat format) {
+    m_format = format;
+}
+
+void DataExporter::setIncremental(bool incremental) {
+    m_incremental = incremental;
+}
+
 void DataExporter::extract(const std::vector<ExtractableElement>& elements) {
     emit logMessage("Starting extraction process...");
     emit logMessage(QString("Output directory: %1").arg(m_outputPath));
@@ -85,29 +104,326 @@ void DataExporter::extract(const std::vector<ExtractableElement>& elements) {
                     .arg(charInfo->className));
     emit logMessage("-----------------------------------");
     
-    // Create JSON export structure
-    QJsonObject exportData;
-    exportData["exportTimestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-    exportData["exporterVersion"] = "1.0.0";
-    exportData["characterName"] = charInfo->name;
-    exportData["server"] = charInfo->server;
+    exportCharacter(*charInfo, fullData, elements, true);
     
-    // Process each element
-    for (const auto& el : elements) {
-        extractElement(el, *charInfo, fullData, exportData);
-        QThread::msleep(50); // Allow UI updates
+    emit logMessage("===================================");
+    emit logMessage("Extraction complete!");
+    emit extractionFinished();
+}
+
+void DataExporter::exportStoredCharacters(const std::vector<Character>& characters,
+                                          const std::vector<ExtractableElement>& elements) {
+    emit logMessage(QString("Exporting %1 saved characters...").arg(characters.size()));
+    emit logMessage(QString("Output directory: %1").arg(m_outputPath));
+    
+    struct Job {
+        CharacterData data;
+        bool ok = false;
+    };
+    // Shared by the pool tasks and the completion slot, which outlive this call
+    struct Batch {
+        std::vector<Job> jobs;
+        std::vector<ExtractableElement> elements;
+        std::atomic<int> done{0};
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->elements = elements;
+    batch->jobs.reserve(characters.size());
+    for (const auto& character : characters) {
+        batch->jobs.push_back({characterDataFrom(character), false});
     }
     
-    // Save to file
-    emit logMessage("-----------------------------------");
-    saveExportToFile(exportData, *charInfo);
+    // One task per character on the global pool; elements within a
+    // character are built in turn so tasks never wait on each other.
+    // The summary is logged from finished(), so the GUI thread never waits
+    const int total = static_cast<int>(batch->jobs.size());
+    emit batchProgress(0, total);
     
-    emit logMessage("===================================");
-    emit logMessage("Extraction complete!");
+    auto* watcher = new QFutureWatcher<void>(this);
+    connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, batch, total]() {
+        watcher->deleteLater();
+        
+        int failed = 0;
+        for (const auto& job : batch->jobs) {
+            if (!job.ok) {
+                ++failed;
+            }
+        }
+        emit logMessage("===================================");
+        emit logMessage(QString("Exported %1 of %2 characters.").arg(total - failed).arg(total));
+        emit extractionFinished();
+    });
+    m_batch = QtConcurrent::map(batch->jobs, [this, batch, total](Job& job) {
+        job.ok = exportCharacter(job.data.basic, job.data, batch->elements, false);
+        emit batchProgress(++batch->done, total);
+    });
+    watcher->setFuture(m_batch);
+}
+
+bool DataExporter::exportCharacter(const CharacterInfo& info, const std::optional<CharacterData>& fullData,
+                                   const std::vector<ExtractableElement>& elements, bool interactive) {
+    // Incremental exports are deltas against the snapshot of the last one,
+    // or full exports when there is none yet
+    ExportSnapshot snapshot;
+    const QString snapshotFile = snapshotPath(info);
+    const bool delta = m_incremental && snapshot.load(snapshotFile);
+    const QDateTime timestamp = QDateTime::currentDateTime();
+    
+    const QString filepath = exportFilePath(info, delta);
+    if (filepath.isEmpty()) {
+        return false;
+    }
+    
+    // Stream straight into the export file: each element is written as
+    // soon as it is ready instead of collecting one document first
+    QSaveFile file(filepath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        emit logMessage(QString("[ERROR] Failed to save export to: %1").arg(filepath));
+        spdlog::error("Failed to save export to: {}", filepath.toStdString());
+        return false;
+    }
+    
+    auto output = createExportWriter(m_format, &file);
+    ExportWriter& writer = *output;
+    writer.beginObject();
+    writer.value("schemaVersion", SCHEMA_VERSION);
+    writer.value("exportTimestamp", timestamp.toString(Qt::ISODate));
+    writer.value("exporterVersion", "1.0.0");
+    writer.value("characterName", info.name);
+    writer.value("server", info.server);
+    if (m_incremental) {
+        writer.value("exportType", delta ? "delta" : "full");
+    }
+    if (delta) {
+        writer.value("baseTimestamp", snapshot.timestamp().toString(Qt::ISODate));
+    }
+    
+    // In interactive runs every element is built as its own task, and the
+    // results are written in request order as they come in
+    std::vector<QFuture<ElementResult>> tasks;
+    if (interactive) {
+        m_elementsTotal = static_cast<int>(elements.size());
+        m_elementsDone = 0;
+        emit progress(0, m_elementsTotal, writer.bytesWritten());
+        for (const auto& el : elements) {
+            tasks.push_back(QtConcurrent::run([el, &info, &fullData]() {
+                return buildElement(el, info, fullData);
+            }));
+        }
+    }
+    
+    std::vector<ExportElement> recorded;
+    for (size_t i = 0; i < elements.size(); ++i) {
+        ElementResult result = interactive ? tasks[i].result() : buildElement(elements[i], info, fullData);
+        if (m_incremental && result.streamed) {
+            // Hashing needs the whole element as a value
+            JsonValueWriter tree;
+            tree.beginObject();
+            streamElement(result, tree, false);
+            tree.endObject();
+            const QJsonObject members = tree.result().toObject();
+            if (!members.isEmpty()) {
+                result.key = members.constBegin().key();
+                result.value = members.constBegin().value();
+            }
+            result.streamed = false;
+        }
+        if (m_incremental) {
+            recorded.push_back({static_cast<int>(result.element), result.key, result.value});
+        }
+        
+        if (result.streamed) {
+            streamElement(result, writer, interactive);
+        } else if (!result.key.isEmpty() && !delta) {
+            writer.value(result.key, result.value);
+        }
+        writer.flush();
+        
+        if (interactive) {
+            for (const auto& line : result.log) {
+                emit logMessage(line);
+            }
+            emit progress(++m_elementsDone, m_elementsTotal, writer.bytesWritten());
+            QCoreApplication::processEvents(); // Allow UI updates
+        }
+    }
+    
+    if (delta) {
+        const QJsonObject changes = snapshot.diff(recorded);
+        for (auto it = changes.constBegin(); it != changes.constEnd(); ++it) {
+            writer.value(it.key(), it.value());
+        }
+        if (interactive) {
+            emit logMessage(QString("Changes since %1: %2 added, %3 changed, %4 removed.")
+                            .arg(snapshot.timestamp().toString(Qt::ISODate))
+                            .arg(changes.value("added").toObject().size())
+                            .arg(changes.value("changed").toObject().size())
+                            .arg(changes.value("removed").toArray().size()));
+        }
+    }
+    writer.endObject();
+    
+    if (interactive) {
+        emit logMessage("-----------------------------------");
+    }
+    if (!writer.ok() || !file.commit()) {
+        emit logMessage(QString("[ERROR] Failed to save export to: %1").arg(filepath));
+        spdlog::error("Failed to commit export {}", filepath.toStdString());
+        return false;
+    }
+    if (interactive) {
+        emit logMessage(QString("Saved export to:"));
+        emit logMessage(QString("  %1 (%2 KB)").arg(filepath).arg(writer.bytesWritten() / 1024));
+    } else {
+        emit logMessage(QString("  %1 on %2 -> %3").arg(info.name, info.server, filepath));
+    }
+    spdlog::info("Exported character data to: {}", filepath.toStdString());
+    
+    if (m_incremental) {
+        snapshot.update(recorded, timestamp);
+        if (!snapshot.save(snapshotFile)) {
+            emit logMessage("[WARNING] Failed to save the export snapshot; the next export will be a full one.");
+        }
+    }
+    return true;
+}
+
+void DataExporter::rebuildExport(const QStringList& files) {
+    emit logMessage(QString("Rebuilding full export from %1 files...").arg(files.size()));
+    
+    QString error;
+    auto state = ExportSnapshot::reconstruct(files, &error);
+    if (!state) {
+        emit logMessage(QString("[ERROR] %1").arg(error));
+        emit extractionFinished();
+        return;
+    }
+    
+    CharacterInfo info;
+    info.name = state->value("characterName").toString();
+    info.server = state->value("server").toString();
+    QString filepath = exportFilePath(info, false);
+    if (filepath.isEmpty()) {
+        emit extractionFinished();
+        return;
+    }
+    
+    QSaveFile file(filepath);
+    bool saved = file.open(QIODevice::WriteOnly);
+    if (saved) {
+        auto output = createExportWriter(m_format, &file);
+        output->value(*state);
+        output->flush();
+        saved = output->ok() && file.commit();
+    }
+    if (saved) {
+        emit logMessage(QString("Saved full export as of %1 to:").arg(state->value("exportTimestamp").toString()));
+        emit logMessage(QString("  %1").arg(filepath));
+    } else {
+        emit logMessage(QString("[ERROR] Failed to save export to: %1").arg(filepath));
+        spdlog::error("Failed to commit export {}", filepath.toStdString());
+    }
     emit extractionFinished();
 }
 
-void DataExporter::extractElement(ExtractableElement element, const CharacterInfo& info, const std::optional<CharacterData>& fullData, QJsonObject& exportData) {
+void DataExporter::reportItems(size_t count, ExportWriter& writer, bool interactive) {
+    if (interactive && count % PROGRESS_ITEMS == 0) {
+        emit itemsWritten(static_cast<qint64>(count), writer.bytesWritten());
+        emit progress(m_elementsDone, m_elementsTotal, writer.bytesWritten());
+        QCoreApplication::processEvents();
+    }
+}
+
+void DataExporter::streamElement(ElementResult& result, ExportWriter& writer, bool interactive) {
+    switch (result.element) {
+        case ExtractableElement::Titles:
+            {
+                // Every known title from GameDatabase, streamed one by one
+                auto db = GameDatabase::current();
+                writer.beginObject("titles");
+                writer.value("available", static_cast<qint64>(db->titleCount()));
+                writer.beginArray("titles");
+                size_t count = 0;
+                for (const auto& t : db->titlesView()) {
+                    QJsonObject tj;
+                    tj["id"] = t.id;
+                    tj["name"] = t.name;
+                    tj["category"] = t.description;
+                    writer.value(tj);
+                    reportItems(++count, writer, interactive);
+                }
+                writer.endArray();
+                writer.endObject();
+                result.log << QString("  Exported %1 known titles.").arg(count);
+            }
+            break;
+            
+        case ExtractableElement::Emotes:
+            {
+                // Every known emote from GameDatabase, streamed one by one
+                auto db = GameDatabase::current();
+                writer.beginObject("emotes");
+                writer.beginArray("emotes");
+                size_t count = 0;
+                for (const auto& e : db->emotesView()) {
+                    QJsonObject ej;
+                    ej["id"] = e.id;
+                    ej["command"] = e.command;
+                    ej["type"] = e.source; // Default or Special
+                    writer.value(ej);
+                    reportItems(++count, writer, interactive);
+                }
+                writer.endArray();
+                writer.endObject();
+                result.log << QString("  Exported %1 known emotes.").arg(count);
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
+CharacterData DataExporter::characterDataFrom(const Character& character) {
+    CharacterData data;
+    CharacterInfo& info = data.basic;
+    info.name = character.name;
+    info.className = character.classString();
+    info.race = character.raceString();
+    info.server = character.server;
+    info.account = character.accountName;
+    info.level = character.level;
+    info.morale = character.morale;
+    info.maxMorale = character.maxMorale;
+    info.power = character.power;
+    info.maxPower = character.maxPower;
+    info.gold = character.gold;
+    info.silver = character.silver;
+    info.copper = character.copper;
+    info.destinyPoints = character.destinyPoints;
+    info.lotroPoints = character.lotroPoints;
+    
+    for (const auto& v : character.virtues) {
+        data.virtues.push_back({v.key, v.name, v.rank, v.xp});
+    }
+    for (const auto& f : character.factions) {
+        data.factions.push_back({f.factionId, f.key, f.name, f.category, f.tier, f.reputation});
+    }
+    data.crafting.vocation = character.crafting.vocation;
+    for (const auto& p : character.crafting.professions) {
+        data.crafting.professions.push_back({p.name, p.tier, p.proficiency, p.mastery, p.hasMastered});
+    }
+    data.equippedGear = character.equippedGear;
+    data.titles = character.titles;
+    data.emotes = character.emotes;
+    data.skills = character.skills;
+    data.traitPoints = character.traitPoints;
+    return data;
+}
+
+ElementResult DataExporter::buildElement(ExtractableElement element, const CharacterInfo& info, const std::optional<CharacterData>& fullData) {
+    ElementResult result;
+    result.element = element;
     QString name = "Unknown";
     for(const auto& def : getSupportedElements()) {
         if(def.id == element) {
@@ -116,7 +432,7 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
         }
     }
     
-    emit logMessage(QString("Extracting %1...").arg(name));
+    result.log << QString("Extracting %1...").arg(name);
     
     switch(element) {
         case ExtractableElement::BasicInfo:
@@ -139,15 +455,16 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                 vitals["maxPower"] = info.maxPower;
                 basicInfo["vitals"] = vitals;
                 
-                exportData["basicInfo"] = basicInfo;
+                result.key = "basicInfo";
+                result.value = basicInfo;
                 
-                emit logMessage(QString("  Name: %1 %2").arg(info.name).arg(info.surname));
-                emit logMessage(QString("  Level: %1 %2 %3").arg(info.level).arg(info.race).arg(info.className));
-                emit logMessage(QString("  Server: %1").arg(info.server));
-                emit logMessage(QString("  Account: %1 (Type: %2)").arg(info.account).arg(static_cast<int>(info.accountType)));
-                emit logMessage(QString("  Morale: %1/%2").arg(info.morale).arg(info.maxMorale));
-                emit logMessage(QString("  Power: %1/%2").arg(info.power).arg(info.maxPower));
-                emit logMessage("  [OK] Basic Info extracted.");
+                result.log << QString("  Name: %1 %2").arg(info.name).arg(info.surname);
+                result.log << QString("  Level: %1 %2 %3").arg(info.level).arg(info.race).arg(info.className);
+                result.log << QString("  Server: %1").arg(info.server);
+                result.log << QString("  Account: %1 (Type: %2)").arg(info.account).arg(static_cast<int>(info.accountType));
+                result.log << QString("  Morale: %1/%2").arg(info.morale).arg(info.maxMorale);
+                result.log << QString("  Power: %1/%2").arg(info.power).arg(info.maxPower);
+                result.log << "  [OK] Basic Info extracted.";
             }
             break;
             
@@ -175,15 +492,16 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                         wallet[name] = it->second;
                     }
                     currency["wallet"] = wallet;
-                    emit logMessage(QString("  Wallet currencies: %1").arg(fullData->wallet.size()));
+                    result.log << QString("  Wallet currencies: %1").arg(fullData->wallet.size());
                 }
                 
-                exportData["currency"] = currency;
+                result.key = "currency";
+                result.value = currency;
                 
-                emit logMessage(QString("  Money: %1").arg(info.formattedMoney()));
-                emit logMessage(QString("  Total Copper: %1").arg(info.totalCopper()));
-                emit logMessage(QString("  Destiny Points: %1").arg(info.destinyPoints));
-                emit logMessage("  [OK] Currency extracted.");
+                result.log << QString("  Money: %1").arg(info.formattedMoney());
+                result.log << QString("  Total Copper: %1").arg(info.totalCopper());
+                result.log << QString("  Destiny Points: %1").arg(info.destinyPoints);
+                result.log << "  [OK] Currency extracted.";
             }
             break;
             
@@ -202,10 +520,11 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                         professions.append(p);
                     }
                     crafting["professions"] = professions;
-                    exportData["crafting"] = crafting;
-                    emit logMessage(QString("  Extracted %1 crafting professions.").arg(fullData->crafting.professions.size()));
+                    result.key = "crafting";
+                    result.value = crafting;
+                    result.log << QString("  Extracted %1 crafting professions.").arg(fullData->crafting.professions.size());
                 } else {
-                    emit logMessage("  [SKIP] No crafting professions found.");
+                    result.log << "  [SKIP] No crafting professions found.";
                 }
             }
             break;
@@ -224,10 +543,11 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                         factions.append(fj);
                     }
                     reputation["factions"] = factions;
-                    exportData["reputation"] = reputation;
-                    emit logMessage(QString("  Extracted %1 faction reputations.").arg(fullData->factions.size()));
+                    result.key = "reputation";
+                    result.value = reputation;
+                    result.log << QString("  Extracted %1 faction reputations.").arg(fullData->factions.size());
                 } else {
-                    emit logMessage("  [SKIP] No faction reputations found.");
+                    result.log << "  [SKIP] No faction reputations found.";
                 }
             }
             break;
@@ -248,10 +568,11 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                         }
                     }
                     virtues["virtues"] = virtueArray;
-                    exportData["virtues"] = virtues;
-                    emit logMessage(QString("  Extracted %1 virtue statuses.").arg(virtueArray.size()));
+                    result.key = "virtues";
+                    result.value = virtues;
+                    result.log << QString("  Extracted %1 virtue statuses.").arg(virtueArray.size());
                 } else {
-                    emit logMessage("  [SKIP] No virtue data found.");
+                    result.log << "  [SKIP] No virtue data found.";
                 }
             }
             break;
@@ -263,10 +584,11 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                     for (auto it = fullData->equippedGear.begin(); it != fullData->equippedGear.end(); ++it) {
                         gear[it->first] = it->second;
                     }
-                    exportData["gear"] = gear;
-                    emit logMessage(QString("  Extracted %1 equipped items.").arg(fullData->equippedGear.size()));
+                    result.key = "gear";
+                    result.value = gear;
+                    result.log << QString("  Extracted %1 equipped items.").arg(fullData->equippedGear.size());
                 } else {
-                    emit logMessage("  [SKIP] No equipped gear found.");
+                    result.log << "  [SKIP] No equipped gear found.";
                 }
             }
             break;
@@ -276,98 +598,67 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                 QJsonObject items;
                 items["status"] = "not_implemented";
                 items["note"] = "Bag extraction requires container traversal";
-                exportData["bags"] = items;
-                emit logMessage("  [PENDING] Bag extraction requires container traversal.");
+                result.key = "bags";
+                result.value = items;
+                result.log << "  [PENDING] Bag extraction requires container traversal.";
             }
             break;
             
         case ExtractableElement::Titles:
-            {
-                // Export all known titles from GameDatabase
-                auto& db = GameDatabase::instance();
-                QJsonObject titlesObj;
-                QJsonArray titlesArray;
-                int count = 0;
-                for (const auto& t : db.searchTitles("")) {
-                    QJsonObject tj;
-                    tj["id"] = t.id;
-                    tj["name"] = t.name;
-                    tj["category"] = t.description;
-                    titlesArray.append(tj);
-                    count++;
-                    if (count >= 100) break; // Limit for export
-                }
-                titlesObj["available"] = db.titleCount();
-                titlesObj["sample"] = titlesArray;
-                exportData["titles"] = titlesObj;
-                emit logMessage(QString("  Database contains %1 known titles.").arg(db.titleCount()));
-            }
-            break;
-            
         case ExtractableElement::Emotes:
-            {
-                // Export all known emotes from GameDatabase
-                auto& db = GameDatabase::instance();
-                QJsonObject emotesObj;
-                QJsonArray emotesArray;
-                for (const auto& e : db.getAllEmotes()) {
-                    QJsonObject ej;
-                    ej["id"] = e.id;
-                    ej["command"] = e.command;
-                    ej["type"] = e.source; // Default or Special
-                    emotesArray.append(ej);
-                }
-                emotesObj["emotes"] = emotesArray;
-                exportData["emotes"] = emotesObj;
-                emit logMessage(QString("  Database contains %1 known emotes.").arg(db.emoteCount()));
-            }
+            // Database-wide lists, written item by item by streamElement()
+            result.streamed = true;
             break;
             
         case ExtractableElement::Skills:
             {
-                auto& db = GameDatabase::instance();
+                auto db = GameDatabase::current();
                 QJsonObject skills;
-                skills["totalKnown"] = db.skillCount();
+                skills["totalKnown"] = db->skillCount();
                 skills["status"] = "database_only";
                 skills["note"] = "Skills data loaded - character-specific skills require memory array extraction";
-                exportData["skills"] = skills;
-                emit logMessage(QString("  Database contains %1 known skills.").arg(db.skillCount()));
+                result.key = "skills";
+                result.value = skills;
+                result.log << QString("  Database contains %1 known skills.").arg(db->skillCount());
             }
             break;
             
         case ExtractableElement::Traits:
             {
-                auto& db = GameDatabase::instance();
+                auto db = GameDatabase::current();
                 QJsonObject traits;
-                traits["totalKnown"] = db.traitCount();
+                traits["totalKnown"] = db->traitCount();
                 traits["status"] = "database_only";
                 traits["note"] = "Traits data loaded - character-specific traits require memory array extraction";
-                exportData["traits"] = traits;
-                emit logMessage(QString("  Database contains %1 known traits.").arg(db.traitCount()));
+                result.key = "traits";
+                result.value = traits;
+                result.log << QString("  Database contains %1 known traits.").arg(db->traitCount());
             }
             break;
             
         case ExtractableElement::Deeds:
             {
-                auto& db = GameDatabase::instance();
+                auto db = GameDatabase::current();
                 QJsonObject deedsObj;
-                deedsObj["totalKnown"] = db.deedCount();
+                deedsObj["totalKnown"] = db->deedCount();
                 deedsObj["status"] = "database_only";
                 deedsObj["note"] = "Deed completion status requires memory extraction";
-                exportData["deeds"] = deedsObj;
-                emit logMessage(QString("  Database contains %1 known deeds.").arg(db.deedCount()));
+                result.key = "deeds";
+                result.value = deedsObj;
+                result.log << QString("  Database contains %1 known deeds.").arg(db->deedCount());
             }
             break;
             
         case ExtractableElement::Quests:
             {
-                auto& db = GameDatabase::instance();
+                auto db = GameDatabase::current();
                 QJsonObject quests;
-                quests["totalKnown"] = db.questCount();
+                quests["totalKnown"] = db->questCount();
                 quests["status"] = "database_only";
                 quests["note"] = "Quest completion requires memory extraction";
-                exportData["quests"] = quests;
-                emit logMessage(QString("  Database contains %1 known quests.").arg(db.questCount()));
+                result.key = "quests";
+                result.value = quests;
+                result.log << QString("  Database contains %1 known quests.").arg(db->questCount());
             }
             break;
             
@@ -376,8 +667,9 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                 QJsonObject skirmish;
                 skirmish["status"] = "not_implemented";
                 skirmish["note"] = "Skirmish stats require memory extraction";
-                exportData["skirmishStats"] = skirmish;
-                emit logMessage("  Skirmish stats pending implementation.");
+                result.key = "skirmishStats";
+                result.value = skirmish;
+                result.log << "  Skirmish stats pending implementation.";
             }
             break;
             
@@ -386,8 +678,9 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                 QJsonObject housing;
                 housing["status"] = "not_implemented";
                 housing["note"] = "Housing data requires memory extraction";
-                exportData["housing"] = housing;
-                emit logMessage("  Housing data pending implementation.");
+                result.key = "housing";
+                result.value = housing;
+                result.log << "  Housing data pending implementation.";
             }
             break;
             
@@ -396,8 +689,9 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                 QJsonObject friends;
                 friends["status"] = "not_implemented";
                 friends["note"] = "Friend list requires memory extraction";
-                exportData["friends"] = friends;
-                emit logMessage("  Friend list pending implementation.");
+                result.key = "friends";
+                result.value = friends;
+                result.log << "  Friend list pending implementation.";
             }
             break;
             
@@ -406,20 +700,22 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                 QJsonObject kinship;
                 kinship["status"] = "not_implemented";
                 kinship["note"] = "Kinship data requires memory extraction";
-                exportData["kinship"] = kinship;
-                emit logMessage("  Kinship data pending implementation.");
+                result.key = "kinship";
+                result.value = kinship;
+                result.log << "  Kinship data pending implementation.";
             }
             break;
             
         case ExtractableElement::Wardrobe:
             {
-                auto& db = GameDatabase::instance();
+                auto db = GameDatabase::current();
                 QJsonObject wardrobe;
-                wardrobe["totalCosmetics"] = db.cosmeticCount();
+                wardrobe["totalCosmetics"] = db->cosmeticCount();
                 wardrobe["status"] = "database_only";
                 wardrobe["note"] = "Cosmetics database loaded - character wardrobe requires memory extraction";
-                exportData["wardrobe"] = wardrobe;
-                emit logMessage(QString("  Database contains %1 known cosmetic items.").arg(db.cosmeticCount()));
+                result.key = "wardrobe";
+                result.value = wardrobe;
+                result.log << QString("  Database contains %1 known cosmetic items.").arg(db->cosmeticCount());
             }
             break;
             
@@ -428,70 +724,67 @@ void DataExporter::extractElement(ExtractableElement element, const CharacterInf
                 QJsonObject outfits;
                 outfits["status"] = "pending";
                 outfits["note"] = "Outfits require equipped cosmetic slot reading";
-                exportData["outfits"] = outfits;
-                emit logMessage("  Outfits pending memory extraction.");
+                result.key = "outfits";
+                result.value = outfits;
+                result.log << "  Outfits pending memory extraction.";
             }
             break;
             
         case ExtractableElement::Mounts:
             {
-                auto& db = GameDatabase::instance();
+                auto db = GameDatabase::current();
                 QJsonObject mounts;
-                mounts["totalCollections"] = db.collectionCount();
+                mounts["totalCollections"] = db->collectionCount();
                 mounts["status"] = "database_only";
                 mounts["note"] = "Collections database loaded - character mounts require memory extraction";
-                exportData["mounts"] = mounts;
-                emit logMessage(QString("  Database contains %1 collection items (mounts/pets).").arg(db.collectionCount()));
+                result.key = "mounts";
+                result.value = mounts;
+                result.log << QString("  Database contains %1 collection items (mounts/pets).").arg(db->collectionCount());
             }
             break;
             
         default:
             {
-                emit logMessage("  [SKIP] Unknown element type.");
+                result.log << "  [SKIP] Unknown element type.";
             }
             break;
     }
+    return result;
 }
 
-void DataExporter::saveExportToFile(const QJsonObject& data, const CharacterInfo& info) {
+QString DataExporter::characterStem(const CharacterInfo& info) {
+    QString charName = info.name.isEmpty() ? "Unknown" : info.name;
+    QString server = info.server.isEmpty() ? "Server" : info.server;
+    
+    // Sanitize names for filesystem
+    charName.replace(QRegularExpression("[^a-zA-Z0-9]"), "_");
+    server.replace(QRegularExpression("[^a-zA-Z0-9]"), "_");
+    return QString("%1_%2").arg(charName, server);
+}
+
+QString DataExporter::snapshotPath(const CharacterInfo& info) const {
+    return m_outputPath + "/.snapshots/" + characterStem(info) + ".snapshot";
+}
+
+QString DataExporter::exportFilePath(const CharacterInfo& info, bool delta) {
     // Create output directory if needed
     QDir dir(m_outputPath);
     if (!dir.exists()) {
         if (!dir.mkpath(".")) {
             emit logMessage(QString("[ERROR] Failed to create output directory: %1").arg(m_outputPath));
-            return;
+            return {};
         }
     }
     
-    // Generate filename: CharacterName_Server_YYYYMMDD_HHMMSS.json
+    // Generate filename: CharacterName_Server_YYYYMMDD_HHMMSS[_delta].json (or .cbor)
     QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
-    QString charName = info.name.isEmpty() ? "Unknown" : info.name;
-    QString server = info.server.isEmpty() ? "Server" : info.server;
-    
-    // Sanitize names for filesystem
-    charName.replace(QRegularExpression("[^a-zA-Z0-9]"), "_");
-    server.replace(QRegularExpression("[^a-zA-Z0-9]"), "_");
+    QString filename = QString("%1_%2%3.%4")
+                       .arg(characterStem(info))
+                       .arg(timestamp)
+                       .arg(delta ? "_delta" : "")
+                       .arg(exportFileExtension(m_format));
     
-    QString filename = QString("%1_%2_%3.json")
-                       .arg(charName)
-                       .arg(server)
-                       .arg(timestamp);
-    
-    QString filepath = m_outputPath + "/" + filename;
-    
-    QFile file(filepath);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QJsonDocument doc(data);
-        file.write(doc.toJson(QJsonDocument::Indented));
-        file.close();
-        
-        emit logMessage(QString("Saved export to:"));
-        emit logMessage(QString("  %1").arg(filepath));
-        spdlog::info("Exported character data to: {}", filepath.toStdString());
-    } else {
-        emit logMessage(QString("[ERROR] Failed to save export to: %1").arg(filepath));
-        spdlog::error("Failed to save export to: {}", filepath.toStdString());
-    }
+    return m_outputPath + "/" + filename;
 }
 
 } // namespace lotro
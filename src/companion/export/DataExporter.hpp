@@ -1,18 +1,25 @@
 #pragma once
 
 #include <QObject>
+#include <QFuture>
 #include <QString>
 #include <QJsonObject>
+#include <QJsonValue>
+#include <QStringList>
 #include <vector>
 #include <map>
+#include <memory>
 #include <optional>
 
+#include "ExportWriter.hpp"
+
 namespace lotro {
 
 namespace dat { class DataFacade; }
 class ProcessMemory;
 struct CharacterInfo;
 struct CharacterData;
+struct Character;
 
 enum class ExtractableElement {
     BasicInfo,
@@ -44,10 +51,20 @@ struct ElementDefinition {
     bool enabledByDefault;
 };
 
+// One element, built off the writing thread
+struct ElementResult {
+    ExtractableElement element = ExtractableElement::BasicInfo;
+    QString key;                // Member to write, empty if nothing was produced
+    QJsonValue value;
+    QStringList log;
+    bool streamed = false;      // Written item by item by the writing thread instead
+};
+
 class DataExporter : public QObject {
     Q_OBJECT
 public:
-    explicit DataExporter(dat::DataFacade* facade, ProcessMemory* memory, QObject* parent = nullptr);
+    explicit DataExporter(std::shared_ptr<dat::DataFacade> facade, ProcessMemory* memory, QObject* parent = nullptr);
+    ~DataExporter() override;
     
     // Get all supported elements
     static std::vector<ElementDefinition> getSupportedElements();
@@ -55,20 +72,63 @@ public:
     // Set output directory for exports
     void setOutputPath(const QString& path);
     
-    // Start extraction
+    // Set the encoding of new exports; both carry the same tree
+    void setFormat(ExportFormat format);
+    ExportFormat format() const { return m_format; }
+    
+    // Write only what changed since the character's previous export
+    void setIncremental(bool incremental);
+    bool incremental() const { return m_incremental; }
+    
+    // Start extraction; the export file is written as elements complete
     void extract(const std::vector<ExtractableElement>& elements);
+    
+    // Export characters saved by the tracker, one file each, several at a time.
+    // Returns at once; extractionFinished() follows the last character
+    void exportStoredCharacters(const std::vector<Character>& characters,
+                                const std::vector<ExtractableElement>& elements);
+    
+    // Rebuild a full export from a full one and the deltas after it
+    void rebuildExport(const QStringList& files);
+    
+    // Items between progress reports while streaming a large element
+    static constexpr size_t PROGRESS_ITEMS = 500;
+    
+    // Written first in every export as "schemaVersion"; bump on layout changes
+    static constexpr int SCHEMA_VERSION = 1;
 
 signals:
     void logMessage(const QString& msg);
     void extractionFinished();
+    
+    // After each element, and every PROGRESS_ITEMS items of a large one
+    void progress(int elementsDone, int elementsTotal, qint64 bytesWritten);
+    void itemsWritten(qint64 items, qint64 bytesWritten);
+    
+    // After each character of exportStoredCharacters(); may come from a pool thread
+    void batchProgress(int done, int total);
 
 private:
-    dat::DataFacade* m_facade;
+    std::shared_ptr<dat::DataFacade> m_facade;
     ProcessMemory* m_memory;
     QString m_outputPath;
+    ExportFormat m_format = ExportFormat::Json;
+    bool m_incremental = false;
+    int m_elementsDone = 0;
+    int m_elementsTotal = 0;
+    QFuture<void> m_batch;      // Running exportStoredCharacters() tasks, which use this
     
-    void extractElement(ExtractableElement element, const CharacterInfo& info, const std::optional<CharacterData>& fullData, QJsonObject& exportData);
-    void saveExportToFile(const QJsonObject& data, const CharacterInfo& info);
+    // Interactive exports build elements in parallel and report progress;
+    // batch exports build them in turn and only log the outcome
+    bool exportCharacter(const CharacterInfo& info, const std::optional<CharacterData>& fullData,
+                         const std::vector<ExtractableElement>& elements, bool interactive);
+    static ElementResult buildElement(ExtractableElement element, const CharacterInfo& info, const std::optional<CharacterData>& fullData);
+    void streamElement(ElementResult& result, ExportWriter& writer, bool interactive);
+    void reportItems(size_t count, ExportWriter& writer, bool interactive);
+    static CharacterData characterDataFrom(const Character& character);
+    QString exportFilePath(const CharacterInfo& info, bool delta);
+    QString snapshotPath(const CharacterInfo& info) const;
+    static QString characterStem(const CharacterInfo& info);
 };
 
 } // namespace lotro
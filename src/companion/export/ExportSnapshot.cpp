@@ -0,0 +1,373 @@
+/**
+ * LOTRO Launcher - Export Snapshot Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ExportSnapshot.hpp"
+
+#include <QCborValue>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QSet>
+#include <QtEndian>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro {
+
+quint64 ExportSnapshot::hash(const QJsonValue& value) {
+    // Wrapped so scalars serialize too; object members come out sorted
+    const QByteArray bytes = QJsonDocument(QJsonArray{value}).toJson(QJsonDocument::Compact);
+    const QByteArray digest = QCryptographicHash::hash(bytes, QCryptographicHash::Md5);
+    return qFromLittleEndian<quint64>(digest.constData());
+}
+
+QString ExportSnapshot::recordField(const QJsonArray& array) {
+    if (array.isEmpty()) {
+        return {};
+    }
+    for (const QString field : {QStringLiteral("id"), QStringLiteral("key")}) {
+        QSet<QString> seen;
+        bool usable = true;
+        for (const auto& item : array) {
+            QString id = recordId(item, field);
+            if (id.isEmpty() || seen.contains(id)) {
+                usable = false;
+                break;
+            }
+            seen.insert(id);
+        }
+        if (usable) {
+            return field;
+        }
+    }
+    return {};
+}
+
+QString ExportSnapshot::recordId(const QJsonValue& record, const QString& field) {
+    const QJsonValue id = record.toObject().value(field);
+    if (id.isString()) {
+        return id.toString();
+    }
+    if (id.isDouble()) {
+        return QString::number(id.toInteger());
+    }
+    return {};
+}
+
+ExportSnapshot::Element ExportSnapshot::describe(const QJsonValue& value) {
+    Element element;
+    element.hash = hash(value);
+    if (value.isObject()) {
+        const QJsonObject object = value.toObject();
+        element.keyed = true;
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            element.records.insert(it.key(), hash(it.value()));
+        }
+    } else if (value.isArray()) {
+        const QJsonArray array = value.toArray();
+        element.by = recordField(array);
+        element.keyed = !element.by.isEmpty();
+        if (element.keyed) {
+            for (const auto& item : array) {
+                element.records.insert(recordId(item, element.by), hash(item));
+            }
+        }
+    }
+    return element;
+}
+
+QJsonObject ExportSnapshot::diff(const std::vector<ExportElement>& elements) const {
+    QJsonObject added;
+    QJsonObject changed;
+    QJsonArray removed;
+    
+    for (const auto& element : elements) {
+        auto previous = m_elements.constFind(element.id);
+        const bool had = previous != m_elements.constEnd();
+        if (had && previous->key != element.key) {
+            removed.append(previous->key);
+        }
+        if (element.key.isEmpty()) {
+            continue;
+        }
+        if (!had || previous->key != element.key) {
+            added.insert(element.key, element.value);
+            continue;
+        }
+        
+        const Element current = describe(element.value);
+        if (current.hash == previous->hash) {
+            continue;
+        }
+        if (!current.keyed || !previous->keyed || current.by != previous->by) {
+            changed.insert(element.key, QJsonObject{{"value", element.value}});
+            continue;
+        }
+        
+        QJsonObject set;
+        QJsonArray unset;
+        auto visit = [&](const QString& id, const QJsonValue& record) {
+            auto old = previous->records.constFind(id);
+            if (old == previous->records.constEnd() || old.value() != current.records.value(id)) {
+                set.insert(id, record);
+            }
+        };
+        if (current.by.isEmpty()) {
+            const QJsonObject object = element.value.toObject();
+            for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+                visit(it.key(), it.value());
+            }
+        } else {
+            for (const auto& item : element.value.toArray()) {
+                visit(recordId(item, current.by), item);
+            }
+        }
+        for (auto it = previous->records.constBegin(); it != previous->records.constEnd(); ++it) {
+            if (!current.records.contains(it.key())) {
+                unset.append(it.key());
+            }
+        }
+        
+        QJsonObject change{{"set", set}, {"unset", unset}};
+        if (!current.by.isEmpty()) {
+            change.insert("by", current.by);
+        }
+        changed.insert(element.key, change);
+    }
+    
+    return QJsonObject{{"added", added}, {"changed", changed}, {"removed", removed}};
+}
+
+void ExportSnapshot::update(const std::vector<ExportElement>& elements, const QDateTime& timestamp) {
+    for (const auto& element : elements) {
+        if (element.key.isEmpty()) {
+            m_elements.remove(element.id);
+            continue;
+        }
+        Element described = describe(element.value);
+        described.key = element.key;
+        m_elements.insert(element.id, std::move(described));
+    }
+    m_timestamp = timestamp;
+}
+
+bool ExportSnapshot::save(const QString& path) const {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write export snapshot {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << m_timestamp << static_cast<quint32>(m_elements.size());
+    for (auto it = m_elements.constBegin(); it != m_elements.constEnd(); ++it) {
+        const Element& element = it.value();
+        out << static_cast<qint32>(it.key()) << element.key << element.hash << element.keyed << element.by
+            << static_cast<quint32>(element.records.size());
+        for (auto record = element.records.constBegin(); record != element.records.constEnd(); ++record) {
+            out << record.key() << record.value();
+        }
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit export snapshot {}", path.toStdString());
+        return false;
+    }
+    return true;
+}
+
+bool ExportSnapshot::load(const QString& path) {
+    m_elements.clear();
+    m_timestamp = QDateTime();
+    
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("Export snapshot {} is outdated, writing a full export", path.toStdString());
+        return false;
+    }
+    in >> m_timestamp >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        qint32 id = 0;
+        quint32 records = 0;
+        Element element;
+        in >> id >> element.key >> element.hash >> element.keyed >> element.by >> records;
+        for (quint32 j = 0; j < records && in.status() == QDataStream::Ok; ++j) {
+            QString record;
+            quint64 hash = 0;
+            in >> record >> hash;
+            element.records.insert(record, hash);
+        }
+        m_elements.insert(id, std::move(element));
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Export snapshot {} is corrupt, writing a full export", path.toStdString());
+        m_elements.clear();
+        m_timestamp = QDateTime();
+        return false;
+    }
+    return true;
+}
+
+QJsonObject ExportSnapshot::apply(const QJsonObject& document, const QJsonObject& delta) {
+    QJsonObject result = document;
+    for (const auto& key : {"exportTimestamp", "exporterVersion", "schemaVersion", "characterName", "server"}) {
+        if (delta.contains(key)) {
+            result.insert(key, delta.value(key));
+        }
+    }
+    result.insert("exportType", "full");
+    result.remove("baseTimestamp");
+    
+    for (const auto& key : delta.value("removed").toArray()) {
+        result.remove(key.toString());
+    }
+    const QJsonObject added = delta.value("added").toObject();
+    for (auto it = added.constBegin(); it != added.constEnd(); ++it) {
+        result.insert(it.key(), it.value());
+    }
+    
+    const QJsonObject changed = delta.value("changed").toObject();
+    for (auto it = changed.constBegin(); it != changed.constEnd(); ++it) {
+        const QJsonObject change = it.value().toObject();
+        if (change.contains("value")) {
+            result.insert(it.key(), change.value("value"));
+            continue;
+        }
+        
+        const QJsonObject set = change.value("set").toObject();
+        const QJsonArray unset = change.value("unset").toArray();
+        const QString by = change.value("by").toString();
+        if (by.isEmpty()) {
+            QJsonObject object = result.value(it.key()).toObject();
+            for (const auto& id : unset) {
+                object.remove(id.toString());
+            }
+            for (auto record = set.constBegin(); record != set.constEnd(); ++record) {
+                object.insert(record.key(), record.value());
+            }
+            result.insert(it.key(), object);
+            continue;
+        }
+        
+        // Keep the existing order, replacing records in place
+        QSet<QString> gone;
+        for (const auto& id : unset) {
+            gone.insert(id.toString());
+        }
+        QSet<QString> placed;
+        QJsonArray array;
+        for (const auto& item : result.value(it.key()).toArray()) {
+            const QString id = recordId(item, by);
+            if (gone.contains(id)) {
+                continue;
+            }
+            auto replacement = set.constFind(id);
+            array.append(replacement != set.constEnd() ? replacement.value() : item);
+            placed.insert(id);
+        }
+        for (auto record = set.constBegin(); record != set.constEnd(); ++record) {
+            if (!placed.contains(record.key())) {
+                array.append(record.value());
+            }
+        }
+        result.insert(it.key(), array);
+    }
+    return result;
+}
+
+std::optional<QJsonObject> ExportSnapshot::readExport(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        spdlog::warn("Failed to open export {}", path.toStdString());
+        return std::nullopt;
+    }
+    const QByteArray data = file.readAll();
+    
+    // CBOR exports start with the self-describe tag, d9 d9 f7
+    if (data.startsWith("\xd9\xd9\xf7")) {
+        QCborParserError error;
+        QCborValue value = QCborValue::fromCbor(data, &error);
+        if (error.error != QCborError::NoError) {
+            spdlog::warn("Failed to parse export {}: {}", path.toStdString(), error.errorString().toStdString());
+            return std::nullopt;
+        }
+        if (value.isTag()) {
+            value = value.taggedValue();
+        }
+        return value.toJsonValue().toObject();
+    }
+    
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(data, &error);
+    if (error.error != QJsonParseError::NoError || !document.isObject()) {
+        spdlog::warn("Failed to parse export {}: {}", path.toStdString(), error.errorString().toStdString());
+        return std::nullopt;
+    }
+    return document.object();
+}
+
+std::optional<QJsonObject> ExportSnapshot::reconstruct(const QStringList& files, QString* error) {
+    auto fail = [error](const QString& message) -> std::optional<QJsonObject> {
+        if (error) {
+            *error = message;
+        }
+        return std::nullopt;
+    };
+    
+    std::vector<std::pair<QString, QJsonObject>> exports;
+    for (const auto& path : files) {
+        auto document = readExport(path);
+        if (!document) {
+            return fail(QString("Could not read %1").arg(path));
+        }
+        exports.emplace_back(path, std::move(*document));
+    }
+    if (exports.empty()) {
+        return fail("No exports given");
+    }
+    std::stable_sort(exports.begin(), exports.end(), [](const auto& a, const auto& b) {
+        return a.second.value("exportTimestamp").toString() < b.second.value("exportTimestamp").toString();
+    });
+    
+    if (exports.front().second.value("exportType").toString() == "delta") {
+        return fail(QString("%1 is a delta; the oldest export must be a full one").arg(exports.front().first));
+    }
+    QJsonObject state = exports.front().second;
+    for (size_t i = 1; i < exports.size(); ++i) {
+        const auto& [path, document] = exports[i];
+        if (document.value("exportType").toString() != "delta") {
+            state = document;       // A later full export supersedes everything before it
+            continue;
+        }
+        if (document.value("baseTimestamp") != state.value("exportTimestamp")) {
+            return fail(QString("%1 is based on the export of %2, which is missing")
+                        .arg(path, document.value("baseTimestamp").toString()));
+        }
+        state = apply(state, document);
+    }
+    return state;
+}
+
+} // namespace lotro
@@ -0,0 +1,117 @@
+/**
+ * LOTRO Launcher - Export Snapshot
+ * 
+ * Content hashes of a previous export, for writing only what changed.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * One element of an export, as written
+ */
+struct ExportElement {
+    int id = 0;                 // ExtractableElement
+    QString key;                // Member name, empty if the element produced nothing
+    QJsonValue value;
+};
+
+/**
+ * What the previous export of a character contained
+ * 
+ * Only hashes are kept: one per element, and one per record where the
+ * element has a record structure (the members of an object, or the items
+ * of an array of objects that all carry a distinct "id" or "key"). That
+ * is enough to tell which records of a new export differ, so a delta
+ * document needs to hold just those.
+ * 
+ * A delta document is a normal export whose elements are replaced by
+ *   "added":   { key: value }           elements new since the base
+ *   "changed": { key: change }          elements that differ
+ *   "removed": [ key ]                  elements no longer produced
+ * where a change is either { "value": v } for a whole replacement, or
+ * { "set": { record: v }, "unset": [ record ] } with "by" naming the id
+ * member for arrays. Records are matched by member name or id; array
+ * items that are new are appended in order. apply() turns a full export
+ * plus a delta back into the full export the delta was taken from.
+ */
+class ExportSnapshot {
+public:
+    bool isEmpty() const { return m_elements.isEmpty(); }
+    
+    /**
+     * exportTimestamp of the export the snapshot describes
+     */
+    const QDateTime& timestamp() const { return m_timestamp; }
+    
+    /**
+     * Delta from the snapshot to a new set of elements
+     * 
+     * Elements not in the list are left out, not reported as removed.
+     * @return Object with "added", "changed" and "removed"
+     */
+    QJsonObject diff(const std::vector<ExportElement>& elements) const;
+    
+    /**
+     * Take in the elements of a new export; others keep their state
+     */
+    void update(const std::vector<ExportElement>& elements, const QDateTime& timestamp);
+    
+    bool save(const QString& path) const;
+    bool load(const QString& path);
+    
+    /**
+     * Apply a delta document to the full export it was taken against
+     */
+    static QJsonObject apply(const QJsonObject& document, const QJsonObject& delta);
+    
+    /**
+     * Rebuild a full export from one full export and the deltas after it
+     * 
+     * Files may be JSON or CBOR and in any order; they are sorted by
+     * exportTimestamp and each delta must follow the export it is based on.
+     */
+    static std::optional<QJsonObject> reconstruct(const QStringList& files, QString* error = nullptr);
+    
+    /**
+     * Read a JSON or CBOR export
+     */
+    static std::optional<QJsonObject> readExport(const QString& path);
+    
+    static quint64 hash(const QJsonValue& value);
+
+private:
+    struct Element {
+        QString key;
+        quint64 hash = 0;
+        bool keyed = false;
+        QString by;                     // Id member of array records; empty for objects
+        QHash<QString, quint64> records;
+    };
+    
+    static Element describe(const QJsonValue& value);
+    static QString recordField(const QJsonArray& array);
+    static QString recordId(const QJsonValue& record, const QString& field);
+    
+    static constexpr quint32 MAGIC = 0x4E53584C;    // "LXSN"
+    static constexpr quint32 VERSION = 1;
+    
+    QHash<int, Element> m_elements;
+    QDateTime m_timestamp;
+};
+
+} // namespace lotro
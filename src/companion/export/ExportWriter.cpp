@@ -0,0 +1,295 @@
+/**
+ * LOTRO Launcher - Export Writer Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ExportWriter.hpp"
+
+#include <QCborValue>
+#include <QIODevice>
+
+#include <cmath>
+
+namespace lotro {
+
+JsonExportWriter::JsonExportWriter(QIODevice* device)
+    : m_device(device)
+{
+    m_buffer.reserve(FLUSH_THRESHOLD + 4096);
+}
+
+JsonExportWriter::~JsonExportWriter() {
+    flush();
+}
+
+void JsonExportWriter::next(const QString* key) {
+    if (m_stack.empty()) {
+        return;
+    }
+    Level& level = m_stack.back();
+    if (level.count++ > 0) {
+        m_buffer.append(',');
+    }
+    m_buffer.append('\n');
+    m_buffer.append(QByteArray(static_cast<qsizetype>(m_stack.size()) * 4, ' '));
+    if (key && !level.array) {
+        writeString(*key);
+        m_buffer.append(": ");
+    }
+}
+
+void JsonExportWriter::open(const QString* key, bool array) {
+    next(key);
+    m_buffer.append(array ? '[' : '{');
+    m_stack.push_back({array, 0});
+}
+
+void JsonExportWriter::close(bool array) {
+    if (m_stack.empty()) {
+        return;
+    }
+    bool empty = m_stack.back().count == 0;
+    m_stack.pop_back();
+    if (!empty) {
+        m_buffer.append('\n');
+        m_buffer.append(QByteArray(static_cast<qsizetype>(m_stack.size()) * 4, ' '));
+    }
+    m_buffer.append(array ? ']' : '}');
+    if (m_stack.empty()) {
+        m_buffer.append('\n');
+        flush();
+    } else {
+        maybeFlush();
+    }
+}
+
+void JsonExportWriter::beginObject() { open(nullptr, false); }
+void JsonExportWriter::beginObject(const QString& key) { open(&key, false); }
+void JsonExportWriter::endObject() { close(false); }
+
+void JsonExportWriter::beginArray() { open(nullptr, true); }
+void JsonExportWriter::beginArray(const QString& key) { open(&key, true); }
+void JsonExportWriter::endArray() { close(true); }
+
+void JsonExportWriter::value(const QJsonValue& value) { write(nullptr, value); }
+void JsonExportWriter::value(const QString& key, const QJsonValue& value) { write(&key, value); }
+
+void JsonExportWriter::write(const QString* key, const QJsonValue& value) {
+    if (value.isObject()) {
+        const QJsonObject object = value.toObject();
+        open(key, false);
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            const QString member = it.key();
+            write(&member, it.value());
+        }
+        close(false);
+    } else if (value.isArray()) {
+        const QJsonArray array = value.toArray();
+        open(key, true);
+        for (const auto& element : array) {
+            write(nullptr, element);
+        }
+        close(true);
+    } else {
+        next(key);
+        writeScalar(value);
+        maybeFlush();
+    }
+}
+
+void JsonExportWriter::writeString(const QString& text) {
+    static const char HEX[] = "0123456789abcdef";
+    const QByteArray utf8 = text.toUtf8();
+    m_buffer.append('"');
+    for (char c : utf8) {
+        switch (c) {
+            case '"': m_buffer.append("\\\""); break;
+            case '\\': m_buffer.append("\\\\"); break;
+            case '\b': m_buffer.append("\\b"); break;
+            case '\f': m_buffer.append("\\f"); break;
+            case '\n': m_buffer.append("\\n"); break;
+            case '\r': m_buffer.append("\\r"); break;
+            case '\t': m_buffer.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    m_buffer.append("\\u00");
+                    m_buffer.append(HEX[(c >> 4) & 0xF]);
+                    m_buffer.append(HEX[c & 0xF]);
+                } else {
+                    m_buffer.append(c);
+                }
+                break;
+        }
+    }
+    m_buffer.append('"');
+}
+
+void JsonExportWriter::writeScalar(const QJsonValue& value) {
+    switch (value.type()) {
+        case QJsonValue::Bool:
+            m_buffer.append(value.toBool() ? "true" : "false");
+            break;
+        case QJsonValue::Double: {
+            double d = value.toDouble();
+            if (!std::isfinite(d)) {
+                m_buffer.append("null");
+            } else if (d == static_cast<double>(value.toInteger()) && std::fabs(d) < 9007199254740992.0) {
+                m_buffer.append(QByteArray::number(value.toInteger()));
+            } else {
+                m_buffer.append(QByteArray::number(d, 'g', 17));
+            }
+            break;
+        }
+        case QJsonValue::String:
+            writeString(value.toString());
+            break;
+        default:
+            m_buffer.append("null");
+            break;
+    }
+}
+
+void JsonExportWriter::maybeFlush() {
+    if (m_buffer.size() >= FLUSH_THRESHOLD) {
+        flush();
+    }
+}
+
+void JsonExportWriter::flush() {
+    if (m_buffer.isEmpty()) {
+        return;
+    }
+    if (m_ok && m_device->write(m_buffer) != m_buffer.size()) {
+        m_ok = false;
+    }
+    m_written += m_buffer.size();
+    m_buffer.resize(0);     // Keeps the capacity
+}
+
+CborExportWriter::CborExportWriter(QIODevice* device)
+    : m_device(device)
+    , m_sink(&m_buffer)
+    , m_cbor(&m_sink)
+{
+    m_buffer.reserve(JsonExportWriter::FLUSH_THRESHOLD + 4096);
+    m_sink.open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+    m_cbor.append(QCborTag(SELF_DESCRIBE_TAG));
+}
+
+CborExportWriter::~CborExportWriter() {
+    flush();
+}
+
+void CborExportWriter::beginObject() {
+    m_cbor.startMap();
+    ++m_depth;
+}
+
+void CborExportWriter::beginObject(const QString& key) {
+    m_cbor.append(key);
+    beginObject();
+}
+
+void CborExportWriter::endObject() { close(false); }
+
+void CborExportWriter::beginArray() {
+    m_cbor.startArray();
+    ++m_depth;
+}
+
+void CborExportWriter::beginArray(const QString& key) {
+    m_cbor.append(key);
+    beginArray();
+}
+
+void CborExportWriter::endArray() { close(true); }
+
+void CborExportWriter::close(bool array) {
+    if (m_depth == 0) {
+        return;
+    }
+    if (array) {
+        m_cbor.endArray();
+    } else {
+        m_cbor.endMap();
+    }
+    if (--m_depth == 0) {
+        flush();
+    } else {
+        maybeFlush();
+    }
+}
+
+void CborExportWriter::value(const QJsonValue& value) {
+    QCborValue::fromJsonValue(value).toCbor(m_cbor);
+    maybeFlush();
+}
+
+void CborExportWriter::value(const QString& key, const QJsonValue& value) {
+    m_cbor.append(key);
+    this->value(value);
+}
+
+void CborExportWriter::maybeFlush() {
+    if (m_buffer.size() >= JsonExportWriter::FLUSH_THRESHOLD) {
+        flush();
+    }
+}
+
+void CborExportWriter::flush() {
+    if (m_buffer.isEmpty()) {
+        return;
+    }
+    if (m_ok && m_device->write(m_buffer) != m_buffer.size()) {
+        m_ok = false;
+    }
+    m_written += m_buffer.size();
+    m_sink.seek(0);
+    m_buffer.resize(0);     // Keeps the capacity
+}
+
+void JsonValueWriter::open(const QString* key, bool array) {
+    Level level;
+    level.array = array;
+    if (key) {
+        level.key = *key;
+    }
+    m_stack.push_back(std::move(level));
+}
+
+void JsonValueWriter::close() {
+    if (m_stack.empty()) {
+        return;
+    }
+    Level level = std::move(m_stack.back());
+    m_stack.pop_back();
+    QJsonValue value = level.array ? QJsonValue(level.elements) : QJsonValue(level.object);
+    insert(&level.key, value);
+}
+
+void JsonValueWriter::insert(const QString* key, const QJsonValue& value) {
+    if (m_stack.empty()) {
+        m_result = value;
+    } else if (m_stack.back().array) {
+        m_stack.back().elements.append(value);
+    } else if (key) {
+        m_stack.back().object.insert(*key, value);
+    }
+}
+
+std::unique_ptr<ExportWriter> createExportWriter(ExportFormat format, QIODevice* device) {
+    switch (format) {
+        case ExportFormat::Cbor:
+            return std::make_unique<CborExportWriter>(device);
+        case ExportFormat::Json:
+        default:
+            return std::make_unique<JsonExportWriter>(device);
+    }
+}
+
+QString exportFileExtension(ExportFormat format) {
+    return format == ExportFormat::Cbor ? QStringLiteral("cbor") : QStringLiteral("json");
+}
+
+} // namespace lotro
@@ -0,0 +1,221 @@
+/**
+ * LOTRO Launcher - Export Writer
+ * 
+ * Streaming writers for character data exports.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QCborStreamWriter>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+class QIODevice;
+
+namespace lotro {
+
+/**
+ * On-disk encodings of an export
+ */
+enum class ExportFormat {
+    Json,
+    Cbor
+};
+
+/**
+ * Writes an export document piece by piece
+ * 
+ * Containers are opened and closed explicitly and values are written as
+ * they are produced, so an export never has to exist as one tree in
+ * memory. Inside an object every value needs a key; inside an array none
+ * does. A QJsonObject or QJsonArray passed as a value is written as the
+ * equivalent sequence of calls.
+ */
+class ExportWriter {
+public:
+    virtual ~ExportWriter() = default;
+    
+    virtual void beginObject() = 0;
+    virtual void beginObject(const QString& key) = 0;
+    virtual void endObject() = 0;
+    
+    virtual void beginArray() = 0;
+    virtual void beginArray(const QString& key) = 0;
+    virtual void endArray() = 0;
+    
+    virtual void value(const QJsonValue& value) = 0;
+    virtual void value(const QString& key, const QJsonValue& value) = 0;
+    
+    /**
+     * Push buffered output to the device
+     */
+    virtual void flush() = 0;
+    
+    /**
+     * Bytes handed to the device so far
+     */
+    virtual qint64 bytesWritten() const = 0;
+    
+    /**
+     * False once a write to the device has failed
+     */
+    virtual bool ok() const = 0;
+};
+
+/**
+ * Indented JSON, laid out as QJsonDocument::Indented would
+ */
+class JsonExportWriter : public ExportWriter {
+public:
+    explicit JsonExportWriter(QIODevice* device);
+    ~JsonExportWriter() override;
+    
+    void beginObject() override;
+    void beginObject(const QString& key) override;
+    void endObject() override;
+    
+    void beginArray() override;
+    void beginArray(const QString& key) override;
+    void endArray() override;
+    
+    void value(const QJsonValue& value) override;
+    void value(const QString& key, const QJsonValue& value) override;
+    
+    void flush() override;
+    qint64 bytesWritten() const override { return m_written + m_buffer.size(); }
+    bool ok() const override { return m_ok; }
+    
+    static constexpr qsizetype FLUSH_THRESHOLD = 64 * 1024;
+
+private:
+    struct Level {
+        bool array = false;
+        int count = 0;
+    };
+    
+    // Separator, newline and indentation before the next member or element
+    void next(const QString* key);
+    void open(const QString* key, bool array);
+    void close(bool array);
+    void write(const QString* key, const QJsonValue& value);
+    void writeString(const QString& text);
+    void writeScalar(const QJsonValue& value);
+    void maybeFlush();
+    
+    QIODevice* m_device;
+    QByteArray m_buffer;
+    std::vector<Level> m_stack;
+    qint64 m_written = 0;
+    bool m_ok = true;
+};
+
+/**
+ * CBOR (RFC 8949), for machine consumers
+ * 
+ * The document starts with the self-describe tag (55799) so the file can
+ * be recognised from its first three bytes. Objects and arrays opened with
+ * begin*() are indefinite-length, since their size isn't known up front;
+ * everything else, strings included, is definite-length, so a reader that
+ * maps the file can take every key and text value as a view into it
+ * without copying. Integral numbers are written as CBOR integers.
+ */
+class CborExportWriter : public ExportWriter {
+public:
+    explicit CborExportWriter(QIODevice* device);
+    ~CborExportWriter() override;
+    
+    void beginObject() override;
+    void beginObject(const QString& key) override;
+    void endObject() override;
+    
+    void beginArray() override;
+    void beginArray(const QString& key) override;
+    void endArray() override;
+    
+    void value(const QJsonValue& value) override;
+    void value(const QString& key, const QJsonValue& value) override;
+    
+    void flush() override;
+    qint64 bytesWritten() const override { return m_written + m_buffer.size(); }
+    bool ok() const override { return m_ok; }
+    
+    static constexpr quint64 SELF_DESCRIBE_TAG = 55799;
+
+private:
+    void close(bool array);
+    void maybeFlush();
+    
+    // The stream writer appends to m_buffer through m_sink
+    QIODevice* m_device;
+    QByteArray m_buffer;
+    QBuffer m_sink;
+    QCborStreamWriter m_cbor;
+    int m_depth = 0;
+    qint64 m_written = 0;
+    bool m_ok = true;
+};
+
+/**
+ * Builds the document in memory
+ * 
+ * For callers that need a streamed element as a value after all, such as
+ * incremental exports comparing it against the previous one.
+ */
+class JsonValueWriter : public ExportWriter {
+public:
+    void beginObject() override { open(nullptr, false); }
+    void beginObject(const QString& key) override { open(&key, false); }
+    void endObject() override { close(); }
+    
+    void beginArray() override { open(nullptr, true); }
+    void beginArray(const QString& key) override { open(&key, true); }
+    void endArray() override { close(); }
+    
+    void value(const QJsonValue& value) override { insert(nullptr, value); }
+    void value(const QString& key, const QJsonValue& value) override { insert(&key, value); }
+    
+    void flush() override {}
+    qint64 bytesWritten() const override { return 0; }
+    bool ok() const override { return true; }
+    
+    /**
+     * The outermost value, once closed
+     */
+    const QJsonValue& result() const { return m_result; }
+
+private:
+    struct Level {
+        bool array = false;
+        QString key;                // Member name in the parent
+        QJsonObject object;
+        QJsonArray elements;
+    };
+    
+    void open(const QString* key, bool array);
+    void close();
+    void insert(const QString* key, const QJsonValue& value);
+    
+    std::vector<Level> m_stack;
+    QJsonValue m_result;
+};
+
+/**
+ * Writer for a format
+ */
+std::unique_ptr<ExportWriter> createExportWriter(ExportFormat format, QIODevice* device);
+
+/**
+ * File extension for a format, without the dot
+ */
+QString exportFileExtension(ExportFormat format);
+
+} // namespace lotro
@@ -0,0 +1,256 @@
+/**
+ * LOTRO Launcher - Allocation Profiler Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "AllocationProfiler.hpp"
+
+#ifdef LOTRO_ALLOCATION_PROFILING
+#include "Metrics.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace lotro::allocation {
+
+const char* tagName(Tag tag) {
+    switch (tag) {
+        case Tag::Other: return "other";
+        case Tag::Dat: return "dat";
+        case Tag::Sync: return "sync";
+        case Tag::Db: return "db";
+        case Tag::Net: return "net";
+        case Tag::Ui: return "ui";
+        case Tag::Count: break;
+    }
+    return "other";
+}
+
+#ifdef LOTRO_ALLOCATION_PROFILING
+
+namespace {
+
+constexpr size_t TAG_COUNT = static_cast<size_t>(Tag::Count);
+
+struct Counters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<int64_t> live{0};
+    std::atomic<int64_t> peak{0};
+};
+
+// Constant-initialised, so allocations made before main() can use them
+constinit std::array<Counters, TAG_COUNT> g_counters{};
+constinit thread_local Tag t_threadTag = Tag::Other;
+constinit thread_local Tag t_scopeTag = Tag::Count;    // Count: no scope open
+
+// Sits right before every block handed out
+struct Header {
+    uint64_t size;
+    uint32_t offset;        // From the start of the underlying allocation
+    uint8_t tag;
+    uint8_t aligned;        // Came from the aligned allocator
+};
+
+constexpr size_t MALLOC_ALIGNMENT = alignof(std::max_align_t);
+constexpr size_t HEADER_SPACE = sizeof(Header) > MALLOC_ALIGNMENT ? sizeof(Header) : MALLOC_ALIGNMENT;
+
+Tag currentTag() {
+    return t_scopeTag != Tag::Count ? t_scopeTag : t_threadTag;
+}
+
+void charge(Tag tag, size_t size) {
+    Counters& counters = g_counters[static_cast<size_t>(tag)];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+    const int64_t live = counters.live.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed)
+                         + static_cast<int64_t>(size);
+    int64_t peak = counters.peak.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void* allocate(size_t size, size_t alignment) {
+    // Alignments up to the default need no more than malloc gives; larger
+    // ones reserve a whole alignment unit so the block stays aligned
+    const bool aligned = alignment > MALLOC_ALIGNMENT;
+    const size_t space = aligned && alignment > HEADER_SPACE ? alignment : HEADER_SPACE;
+    void* raw = nullptr;
+    if (aligned) {
+        const size_t total = (size + space + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+        raw = _aligned_malloc(total, alignment);
+#else
+        raw = std::aligned_alloc(alignment, total);
+#endif
+    } else {
+        raw = std::malloc(size + space);
+    }
+    if (!raw) {
+        return nullptr;
+    }
+    
+    auto* block = static_cast<unsigned char*>(raw) + space;
+    const Tag tag = currentTag();
+    auto* header = reinterpret_cast<Header*>(block) - 1;
+    header->size = size;
+    header->offset = static_cast<uint32_t>(space);
+    header->tag = static_cast<uint8_t>(tag);
+    header->aligned = aligned ? 1 : 0;
+    charge(tag, size);
+    return block;
+}
+
+void deallocate(void* block) {
+    if (!block) {
+        return;
+    }
+    const Header* header = static_cast<const Header*>(block) - 1;
+    g_counters[header->tag].live.fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+    
+    void* raw = static_cast<unsigned char*>(block) - header->offset;
+    if (header->aligned) {
+#ifdef _WIN32
+        _aligned_free(raw);
+#else
+        std::free(raw);
+#endif
+    } else {
+        std::free(raw);
+    }
+}
+
+void* allocateOrThrow(size_t size, size_t alignment) {
+    while (true) {
+        if (void* block = allocate(size, alignment)) {
+            return block;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+} // namespace
+
+Scope::Scope(Tag tag)
+    : m_previous(t_scopeTag)
+{
+    t_scopeTag = tag;
+}
+
+Scope::~Scope() {
+    t_scopeTag = m_previous;
+}
+
+void setThreadTag(Tag tag) {
+    t_threadTag = tag;
+}
+
+TagStats stats(Tag tag) {
+    const Counters& counters = g_counters[static_cast<size_t>(tag)];
+    TagStats result;
+    result.allocations = counters.allocations.load(std::memory_order_relaxed);
+    result.bytes = counters.bytes.load(std::memory_order_relaxed);
+    result.liveBytes = counters.live.load(std::memory_order_relaxed);
+    result.peakBytes = counters.peak.load(std::memory_order_relaxed);
+    return result;
+}
+
+void publish() {
+    struct Gauges {
+        metrics::Gauge* count;
+        metrics::Gauge* bytes;
+        metrics::Gauge* live;
+        metrics::Gauge* peak;
+    };
+    static const std::array<Gauges, TAG_COUNT> gauges = []() {
+        std::array<Gauges, TAG_COUNT> result;
+        for (size_t i = 0; i < TAG_COUNT; ++i) {
+            const QString prefix = QString("alloc.%1.").arg(tagName(static_cast<Tag>(i)));
+            result[i] = {&metrics::gauge(prefix + "count"), &metrics::gauge(prefix + "bytes"),
+                         &metrics::gauge(prefix + "live_bytes"), &metrics::gauge(prefix + "peak_bytes")};
+        }
+        return result;
+    }();
+    
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        const TagStats current = stats(static_cast<Tag>(i));
+        gauges[i].count->set(static_cast<int64_t>(current.allocations));
+        gauges[i].bytes->set(static_cast<int64_t>(current.bytes));
+        gauges[i].live->set(current.liveBytes);
+        gauges[i].peak->set(current.peakBytes);
+    }
+}
+
+#endif
+
+} // namespace lotro::allocation
+
+#ifdef LOTRO_ALLOCATION_PROFILING
+
+// Replacements for the global allocation functions; every form funnels
+// into the two above. Sized deletes ignore the size, as the header has it.
+
+namespace {
+constexpr size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+void* operator new(std::size_t size) {
+    return lotro::allocation::allocateOrThrow(size, DEFAULT_ALIGNMENT);
+}
+
+void* operator new[](std::size_t size) {
+    return lotro::allocation::allocateOrThrow(size, DEFAULT_ALIGNMENT);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return lotro::allocation::allocate(size, DEFAULT_ALIGNMENT);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return lotro::allocation::allocate(size, DEFAULT_ALIGNMENT);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return lotro::allocation::allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return lotro::allocation::allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return lotro::allocation::allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return lotro::allocation::allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* block) noexcept { lotro::allocation::deallocate(block); }
+void operator delete[](void* block) noexcept { lotro::allocation::deallocate(block); }
+void operator delete(void* block, std::size_t) noexcept { lotro::allocation::deallocate(block); }
+void operator delete[](void* block, std::size_t) noexcept { lotro::allocation::deallocate(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { lotro::allocation::deallocate(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { lotro::allocation::deallocate(block); }
+void operator delete(void* block, std::align_val_t) noexcept { lotro::allocation::deallocate(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { lotro::allocation::deallocate(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { lotro::allocation::deallocate(block); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept { lotro::allocation::deallocate(block); }
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept {
+    lotro::allocation::deallocate(block);
+}
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept {
+    lotro::allocation::deallocate(block);
+}
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * LOTRO Launcher - Allocation Profiler
+ * 
+ * Heap allocation counts per subsystem, in builds configured with
+ * ENABLE_ALLOCATION_PROFILING.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace lotro::allocation {
+
+/**
+ * Subsystem an allocation is charged to
+ */
+enum class Tag : uint8_t {
+    Other,
+    Dat,        // DAT archive reads and decoding
+    Sync,       // Character extraction from the client
+    Db,         // Companion game and item databases
+    Net,        // HTTP replies
+    Ui,         // Default for the GUI thread
+    Count
+};
+
+const char* tagName(Tag tag);
+
+/**
+ * Allocation totals of one tag since startup
+ */
+struct TagStats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    int64_t liveBytes = 0;      // Allocated under the tag and not yet freed
+    int64_t peakBytes = 0;      // High-water mark of liveBytes
+};
+
+#ifdef LOTRO_ALLOCATION_PROFILING
+
+/**
+ * Charges the calling thread's allocations to a tag for its lifetime
+ * 
+ * Global operator new and delete are replaced in this build: every block
+ * carries its size and tag in a small header, so a free is charged to the
+ * tag that allocated it, whichever thread frees it. Scopes nest; the
+ * innermost wins. Allocations outside any scope go to the thread's tag,
+ * Other unless set with setThreadTag().
+ */
+class Scope {
+public:
+    explicit Scope(Tag tag);
+    ~Scope();
+    
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    
+private:
+    Tag m_previous;
+};
+
+/**
+ * Tag for the calling thread's allocations outside any Scope
+ */
+void setThreadTag(Tag tag);
+
+TagStats stats(Tag tag);
+
+/**
+ * Copy the totals into the metrics registry as alloc.<tag>.count, .bytes,
+ * .live_bytes and .peak_bytes gauges; the registry calls this before
+ * every snapshot
+ */
+void publish();
+
+#else
+
+// Without the build option scopes compile away and nothing is counted
+class Scope {
+public:
+    explicit Scope(Tag) {}
+    
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+inline void setThreadTag(Tag) {}
+inline TagStats stats(Tag) { return {}; }
+inline void publish() {}
+
+#endif
+
+} // namespace lotro::allocation
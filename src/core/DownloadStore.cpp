@@ -0,0 +1,316 @@
+/**
+ * LOTRO Launcher - Download Store Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "DownloadStore.hpp"
+#include "platform/Platform.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace lotro {
+
+DownloadStore& DownloadStore::shared() {
+    static DownloadStore store(Platform::getCachePath() / "downloads");
+    return store;
+}
+
+DownloadStore::DownloadStore(const std::filesystem::path& root)
+    : m_root(root)
+    , m_indexPath(QString::fromStdString((root / "store.idx").string()))
+{
+    load();
+}
+
+DownloadStore::~DownloadStore() {
+    QMutexLocker lock(&m_mutex);
+    save();
+}
+
+QString DownloadStore::key(QCryptographicHash::Algorithm algorithm, const QString& hexDigest) {
+    const char* name = "sha256";
+    switch (algorithm) {
+    case QCryptographicHash::Md5: name = "md5"; break;
+    case QCryptographicHash::Sha1: name = "sha1"; break;
+    default: break;
+    }
+    return QString("%1:%2").arg(QLatin1String(name), hexDigest.toLower());
+}
+
+std::filesystem::path DownloadStore::objectPath(const QString& key) const {
+    // Keys become paths, so nothing but "<name>:<hex>" is accepted
+    const qsizetype colon = key.indexOf(':');
+    const QString algorithm = key.left(colon);
+    const QString digest = key.mid(colon + 1);
+    if (colon <= 0 || digest.size() < 8) {
+        return {};
+    }
+    auto isHex = [](QChar c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); };
+    if (!std::all_of(digest.begin(), digest.end(), isHex)
+        || !std::all_of(algorithm.begin(), algorithm.end(), [](QChar c) { return c.isLetterOrNumber(); })) {
+        return {};
+    }
+    return m_root / "objects" / algorithm.toStdString() / digest.left(2).toStdString() / digest.toStdString();
+}
+
+bool DownloadStore::contains(const QString& key) const {
+    const auto path = objectPath(key);
+    std::error_code ec;
+    return !path.empty() && std::filesystem::is_regular_file(path, ec);
+}
+
+bool DownloadStore::place(const std::filesystem::path& source, const std::filesystem::path& destination,
+                          Link link, bool allowCopy) {
+    std::error_code ec;
+    std::filesystem::create_directories(destination.parent_path(), ec);
+    auto temp = destination;
+    temp += ".store-tmp";
+    std::filesystem::remove(temp, ec);
+    
+    bool placed = false;
+    if (link == Link::Shared) {
+        std::filesystem::create_hard_link(source, temp, ec);
+        placed = !ec;
+    }
+    if (!placed) {
+        placed = Platform::cloneFile(source, temp);
+    }
+    if (!placed && allowCopy) {
+        placed = std::filesystem::copy_file(source, temp, std::filesystem::copy_options::overwrite_existing, ec);
+    }
+    if (!placed) {
+        return false;
+    }
+    
+    std::filesystem::rename(temp, destination, ec);
+    if (ec) {
+        spdlog::warn("Failed to place {}: {}", destination.string(), ec.message());
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+void DownloadStore::touch(const QString& key, qint64 size) {
+    QMutexLocker lock(&m_mutex);
+    m_entries.insert(key, {size, QDateTime::currentMSecsSinceEpoch()});
+    m_dirty = true;
+}
+
+bool DownloadStore::materialize(const QString& key, const std::filesystem::path& destination,
+                                Link link, qint64 expectedSize) {
+    const auto object = objectPath(key);
+    std::error_code ec;
+    if (object.empty() || !std::filesystem::is_regular_file(object, ec)) {
+        return false;
+    }
+    const qint64 size = static_cast<qint64>(std::filesystem::file_size(object, ec));
+    if (ec || (expectedSize >= 0 && size != expectedSize)) {
+        spdlog::warn("Stored object {} has the wrong size, dropping it", key.toStdString());
+        std::filesystem::remove(object, ec);
+        return false;
+    }
+    if (!place(object, destination, link, true)) {
+        return false;
+    }
+    touch(key, size);
+    spdlog::debug("Took {} from the download store", destination.string());
+    return true;
+}
+
+bool DownloadStore::insert(const std::filesystem::path& source, const QString& key, Link link) {
+    const auto object = objectPath(key);
+    std::error_code ec;
+    const qint64 size = static_cast<qint64>(std::filesystem::file_size(source, ec));
+    if (object.empty() || ec) {
+        return false;
+    }
+    if (!std::filesystem::is_regular_file(object, ec)
+        && !place(source, object, link, link == Link::Shared || size <= MAX_PRIVATE_COPY_SIZE)) {
+        return false;
+    }
+    touch(key, size);
+    return true;
+}
+
+QString DownloadStore::insertHashed(const std::filesystem::path& source, Link link) {
+    QFile file(QString::fromStdString(source.string()));
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!file.open(QIODevice::ReadOnly) || !hash.addData(&file)) {
+        return {};
+    }
+    const QString digestKey = key(QCryptographicHash::Sha256, QString::fromLatin1(hash.result().toHex()));
+    return insert(source, digestKey, link) ? digestKey : QString();
+}
+
+std::optional<DownloadStore::Alias> DownloadStore::alias(const QString& url) const {
+    Alias found;
+    {
+        QMutexLocker lock(&m_mutex);
+        auto it = m_aliases.constFind(url);
+        if (it == m_aliases.constEnd()) {
+            return std::nullopt;
+        }
+        found = it.value();
+    }
+    if (!contains(found.key)) {
+        return std::nullopt;
+    }
+    return found;
+}
+
+void DownloadStore::setAlias(const QString& url, const QString& key, const QString& validator) {
+    QMutexLocker lock(&m_mutex);
+    m_aliases.insert(url, {key, validator});
+    m_dirty = true;
+}
+
+void DownloadStore::setMaxSize(qint64 bytes) {
+    QMutexLocker lock(&m_mutex);
+    m_maxSize = std::max<qint64>(0, bytes);
+}
+
+qint64 DownloadStore::trim() {
+    QMutexLocker lock(&m_mutex);
+    
+    // The directory is the truth; another launcher may have added objects
+    struct Object {
+        QString key;
+        QString path;
+        qint64 size;
+        qint64 lastUsed;
+    };
+    std::vector<Object> objects;
+    qint64 total = 0;
+    const QString objectsDir = QString::fromStdString((m_root / "objects").string());
+    QDirIterator it(objectsDir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QFileInfo info(it.nextFileInfo());
+        if (info.fileName().endsWith(".store-tmp")) {
+            continue;
+        }
+        const QString algorithm = info.dir().absolutePath().section('/', -2, -2);
+        Object object{algorithm + ':' + info.fileName(), info.absoluteFilePath(), info.size(),
+                      info.lastModified().toMSecsSinceEpoch()};
+        auto entry = m_entries.constFind(object.key);
+        if (entry != m_entries.constEnd()) {
+            object.lastUsed = entry->lastUsed;
+        }
+        total += object.size;
+        objects.push_back(std::move(object));
+    }
+    
+    QHash<QString, Entry> present;
+    for (const Object& object : objects) {
+        present.insert(object.key, {object.size, object.lastUsed});
+    }
+    
+    qint64 freed = 0;
+    if (total > m_maxSize) {
+        std::sort(objects.begin(), objects.end(),
+                  [](const Object& a, const Object& b) { return a.lastUsed < b.lastUsed; });
+        for (const Object& object : objects) {
+            if (total - freed <= m_maxSize) {
+                break;
+            }
+            if (QFile::remove(object.path)) {
+                freed += object.size;
+                present.remove(object.key);
+            }
+        }
+        spdlog::info("Evicted {} bytes from the download store", freed);
+    }
+    
+    for (auto alias = m_aliases.begin(); alias != m_aliases.end();) {
+        alias = present.contains(alias->key) ? std::next(alias) : m_aliases.erase(alias);
+    }
+    m_entries = std::move(present);
+    m_dirty = true;
+    save();
+    return freed;
+}
+
+bool DownloadStore::save() {
+    if (!m_dirty) {
+        return true;
+    }
+    QDir().mkpath(QFileInfo(m_indexPath).absolutePath());
+    
+    QSaveFile file(m_indexPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write download store index {}: {}", m_indexPath.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << static_cast<quint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        out << it.key() << it->size << it->lastUsed;
+    }
+    out << static_cast<quint32>(m_aliases.size());
+    for (auto it = m_aliases.constBegin(); it != m_aliases.constEnd(); ++it) {
+        out << it.key() << it->key << it->validator;
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit download store index {}", m_indexPath.toStdString());
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool DownloadStore::load() {
+    QFile file(m_indexPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("Download store index {} is outdated, rebuilding", m_indexPath.toStdString());
+        return false;
+    }
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString key;
+        Entry entry;
+        in >> key >> entry.size >> entry.lastUsed;
+        m_entries.insert(key, entry);
+    }
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString url;
+        Alias alias;
+        in >> url >> alias.key >> alias.validator;
+        m_aliases.insert(url, alias);
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Download store index {} is corrupt, rebuilding", m_indexPath.toStdString());
+        m_entries.clear();
+        m_aliases.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace lotro
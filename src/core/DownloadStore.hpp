@@ -0,0 +1,125 @@
+/**
+ * LOTRO Launcher - Download Store
+ * 
+ * Content-addressed cache of downloaded files, shared by every installation.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QCryptographicHash>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <filesystem>
+#include <optional>
+
+namespace lotro {
+
+/**
+ * Downloads kept by content hash under the cache path
+ * 
+ * Anything fetched once - patch files, Wine and DXVK tarballs, addon
+ * archives - is kept as objects/<algorithm>/<xx>/<digest>, so another
+ * installation or prefix that needs the same bytes gets them from disk.
+ * Keys are "<algorithm>:<hex digest>", e.g. "md5:0cc1...".
+ * 
+ * Files are handed out by hardlink where the caller allows it, else by
+ * reflink, else by copy. A hardlink shares the inode, so it is only safe
+ * for files that are replaced rather than written in place; Link::Private
+ * never hardlinks, and only stores files it can reflink or that are
+ * small enough to copy.
+ * 
+ * URLs can be aliased to a key together with the response's validator,
+ * for downloads whose hash isn't known in advance.
+ * 
+ * Last use is tracked in store.idx and the least recently used objects
+ * are evicted by trim() once the store outgrows its size limit. Safe to
+ * use from several threads.
+ */
+class DownloadStore {
+public:
+    enum class Link {
+        Shared,         // The destination is only ever replaced; hardlinks are fine
+        Private         // The destination may be modified in place
+    };
+    
+    struct Alias {
+        QString key;
+        QString validator;      // ETag or Last-Modified, empty if none
+    };
+    
+    static DownloadStore& shared();
+    
+    explicit DownloadStore(const std::filesystem::path& root);
+    ~DownloadStore();
+    
+    static QString key(QCryptographicHash::Algorithm algorithm, const QString& hexDigest);
+    
+    bool contains(const QString& key) const;
+    
+    /**
+     * Put a stored object at destination, replacing whatever is there
+     * @param expectedSize Refuse the object unless it has this size; -1 for any
+     */
+    bool materialize(const QString& key, const std::filesystem::path& destination,
+                     Link link, qint64 expectedSize = -1);
+    
+    /**
+     * Store a file whose content the caller has already verified
+     */
+    bool insert(const std::filesystem::path& source, const QString& key, Link link);
+    
+    /**
+     * Hash a file with SHA-256 and store it
+     * @return The key, empty on failure
+     */
+    QString insertHashed(const std::filesystem::path& source, Link link);
+    
+    /**
+     * What a URL fetched last time, if that object is still stored
+     */
+    std::optional<Alias> alias(const QString& url) const;
+    void setAlias(const QString& url, const QString& key, const QString& validator = {});
+    
+    void setMaxSize(qint64 bytes);
+    qint64 maxSize() const { return m_maxSize; }
+    
+    /**
+     * Evict least recently used objects until under the size limit, and
+     * save the index
+     * @return Bytes freed
+     */
+    qint64 trim();
+    
+    static constexpr qint64 DEFAULT_MAX_SIZE = 20LL * 1024 * 1024 * 1024;
+    static constexpr qint64 MAX_PRIVATE_COPY_SIZE = 256LL * 1024 * 1024;
+
+private:
+    struct Entry {
+        qint64 size = 0;
+        qint64 lastUsed = 0;        // Milliseconds since epoch
+    };
+    
+    std::filesystem::path objectPath(const QString& key) const;
+    static bool place(const std::filesystem::path& source, const std::filesystem::path& destination,
+                      Link link, bool allowCopy);
+    void touch(const QString& key, qint64 size);
+    bool load();
+    bool save();
+    
+    std::filesystem::path m_root;
+    QString m_indexPath;
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    QHash<QString, Alias> m_aliases;
+    qint64 m_maxSize = DEFAULT_MAX_SIZE;
+    bool m_dirty = false;
+    
+    static constexpr quint32 MAGIC = 0x5453444C;    // "LDST"
+    static constexpr quint32 VERSION = 1;
+};
+
+} // namespace lotro
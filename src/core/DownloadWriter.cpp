@@ -0,0 +1,152 @@
+/**
+ * LOTRO Launcher - Download Writer Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "DownloadWriter.hpp"
+#include "Metrics.hpp"
+
+#include <spdlog/spdlog.h>
+
+#ifdef PLATFORM_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(PLATFORM_WINDOWS)
+#include <io.h>
+#include <windows.h>
+#endif
+
+namespace lotro {
+
+DownloadWriter::DownloadWriter(const QString& path)
+    : m_file(path)
+{
+}
+
+DownloadWriter::~DownloadWriter() {
+    close();
+}
+
+bool DownloadWriter::open(bool append, qint64 expectedSize) {
+    const QIODevice::OpenMode mode = append ? QIODevice::WriteOnly | QIODevice::Append
+                                            : QIODevice::WriteOnly | QIODevice::Truncate;
+    if (!m_file.open(mode)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    m_buffer.reserve(COALESCE_BYTES);
+    if (expectedSize > m_file.size()) {
+        preallocate(expectedSize);
+    }
+    return true;
+}
+
+void DownloadWriter::preallocate(qint64 size) {
+    // Best effort: where the file system can't, the file grows as usual
+#ifdef PLATFORM_LINUX
+    if (::fallocate(m_file.handle(), FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size)) != 0) {
+        spdlog::debug("Could not preallocate {} bytes for {}", size, m_file.fileName().toStdString());
+        return;
+    }
+#elif defined(PLATFORM_WINDOWS)
+    FILE_ALLOCATION_INFO info{};
+    info.AllocationSize.QuadPart = size;
+    auto handle = reinterpret_cast<HANDLE>(::_get_osfhandle(m_file.handle()));
+    if (!::SetFileInformationByHandle(handle, FileAllocationInfo, &info, sizeof(info))) {
+        spdlog::debug("Could not preallocate {} bytes for {}", size, m_file.fileName().toStdString());
+        return;
+    }
+#else
+    (void)size;
+    return;
+#endif
+    static metrics::Counter& preallocated = metrics::counter("download.preallocated");
+    preallocated.add();
+}
+
+bool DownloadWriter::write(const QByteArray& data) {
+    if (m_buffer.size() + data.size() > COALESCE_BYTES && !flush()) {
+        return false;
+    }
+    if (data.size() >= COALESCE_BYTES) {
+        if (m_file.write(data) != data.size()) {
+            m_error = m_file.errorString();
+            return false;
+        }
+        return true;
+    }
+    m_buffer.append(data);
+    return true;
+}
+
+bool DownloadWriter::flush() {
+    if (m_buffer.isEmpty()) {
+        return true;
+    }
+    const bool ok = m_file.write(m_buffer) == m_buffer.size();
+    m_buffer.clear();
+    if (!ok) {
+        m_error = m_file.errorString();
+    }
+    return ok;
+}
+
+bool DownloadWriter::truncate() {
+    m_buffer.clear();
+    if (!m_file.resize(0)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool DownloadWriter::close() {
+    if (!m_file.isOpen()) {
+        return true;
+    }
+    bool ok = flush();
+    m_file.close();
+    if (ok && m_file.error() != QFileDevice::NoError) {
+        m_error = m_file.errorString();
+        ok = false;
+    }
+    return ok;
+}
+
+bool DownloadWriter::rename(const QString& target) {
+    if (!close()) {
+        return false;
+    }
+    if (!m_file.rename(target)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool DownloadWriter::sync(const QStringList& paths) {
+    bool ok = true;
+    for (const QString& path : paths) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadWrite)) {
+            spdlog::warn("Failed to open {} to sync it: {}", path.toStdString(), file.errorString().toStdString());
+            ok = false;
+            continue;
+        }
+#ifdef PLATFORM_LINUX
+        if (::fdatasync(file.handle()) != 0) {
+            spdlog::error("Failed to sync {}", path.toStdString());
+            ok = false;
+        }
+#elif defined(PLATFORM_WINDOWS)
+        if (::_commit(file.handle()) != 0) {
+            spdlog::error("Failed to sync {}", path.toStdString());
+            ok = false;
+        }
+#endif
+    }
+    return ok;
+}
+
+} // namespace lotro
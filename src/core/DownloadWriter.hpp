@@ -0,0 +1,86 @@
+/**
+ * LOTRO Launcher - Download Writer
+ * 
+ * Writes a downloading file in large, preallocated extents.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+namespace lotro {
+
+/**
+ * Sequential writer for a file arriving over the network
+ * 
+ * Network data comes in small pieces, and written as it comes a large
+ * file ends up in many small extents on ext4 and btrfs. Given the final
+ * size, open() reserves the space up front (fallocate with KEEP_SIZE on
+ * Linux, the allocation size on Windows) without changing the file's
+ * length, so a part file's size is still the bytes actually written.
+ * Writes are gathered into COALESCE_BYTES blocks. Nothing is synced here;
+ * whoever finishes a batch of downloads calls sync() on all of them at
+ * once, which lets the file system flush them together.
+ */
+class DownloadWriter {
+public:
+    explicit DownloadWriter(const QString& path);
+    ~DownloadWriter();
+    
+    DownloadWriter(const DownloadWriter&) = delete;
+    DownloadWriter& operator=(const DownloadWriter&) = delete;
+    
+    /**
+     * Open for writing, appending when resuming
+     * @param append Keep the current contents and write after them
+     * @param expectedSize Final size to reserve space for; 0 if unknown
+     */
+    bool open(bool append, qint64 expectedSize = 0);
+    
+    /**
+     * Queue data; written once a block is full or on flush()
+     */
+    bool write(const QByteArray& data);
+    
+    bool flush();
+    
+    /**
+     * Drop everything written and buffered, to start the file over
+     */
+    bool truncate();
+    
+    /**
+     * Flush and close; a no-op when already closed
+     */
+    bool close();
+    
+    /**
+     * Close and move the file into place
+     */
+    bool rename(const QString& target);
+    
+    QString fileName() const { return m_file.fileName(); }
+    QString errorString() const { return m_error; }
+    
+    /**
+     * Write each file's data through to the disk
+     * @return false if any file couldn't be synced
+     */
+    static bool sync(const QStringList& paths);
+    
+    static constexpr qsizetype COALESCE_BYTES = 4 * 1024 * 1024;
+    
+private:
+    void preallocate(qint64 size);
+    
+    QFile m_file;
+    QByteArray m_buffer;
+    QString m_error;
+};
+
+} // namespace lotro
@@ -10,7 +10,9 @@
 
 #include <QString>
 #include <QDateTime>
+#include <QJsonArray>
 #include <QJsonObject>
+#include <QStringList>
 #include <QUuid>
 
 namespace lotro {
@@ -24,6 +26,7 @@ struct JournalEntry {
     QString content;      // Entry content (plain text or HTML)
     QDateTime createdAt;  // When entry was created
     QDateTime modifiedAt; // When entry was last modified
+    QStringList tags;     // Free-form labels
     
     /**
      * Create a new entry with default values
@@ -39,15 +42,26 @@ struct JournalEntry {
     }
     
     /**
-     * Serialize to JSON
+     * Serialize everything but the content
      */
-    QJsonObject toJson() const {
+    QJsonObject toMetadataJson() const {
         QJsonObject obj;
         obj["id"] = id;
         obj["title"] = title;
-        obj["content"] = content;
         obj["createdAt"] = createdAt.toString(Qt::ISODate);
         obj["modifiedAt"] = modifiedAt.toString(Qt::ISODate);
+        if (!tags.isEmpty()) {
+            obj["tags"] = QJsonArray::fromStringList(tags);
+        }
+        return obj;
+    }
+    
+    /**
+     * Serialize to JSON
+     */
+    QJsonObject toJson() const {
+        QJsonObject obj = toMetadataJson();
+        obj["content"] = content;
         return obj;
     }
     
@@ -61,6 +75,9 @@ struct JournalEntry {
         entry.content = obj["content"].toString();
         entry.createdAt = QDateTime::fromString(obj["createdAt"].toString(), Qt::ISODate);
         entry.modifiedAt = QDateTime::fromString(obj["modifiedAt"].toString(), Qt::ISODate);
+        for (const auto& tag : obj["tags"].toArray()) {
+            entry.tags.append(tag.toString());
+        }
         return entry;
     }
 };
@@ -7,15 +7,48 @@
 #include "JournalManager.hpp"
 #include "platform/Platform.hpp"
 
+#include <QDir>
 #include <QFile>
-#include <QJsonDocument>
+#include <QFileInfo>
 #include <QJsonArray>
-#include <QDir>
+#include <QJsonDocument>
+#include <QSaveFile>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <utility>
+
 namespace lotro {
 
+namespace {
+
+bool writeJson(const QString& path, const QJsonDocument& doc, QJsonDocument::JsonFormat format) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::error("Failed to open {}: {}", path.toStdString(), file.errorString().toStdString());
+        return false;
+    }
+    file.write(doc.toJson(format));
+    if (!file.commit()) {
+        spdlog::error("Failed to commit {}", path.toStdString());
+        return false;
+    }
+    return true;
+}
+
+QJsonDocument readJson(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return QJsonDocument::fromJson(file.readAll());
+}
+
+} // anonymous namespace
+
 JournalManager& JournalManager::instance() {
     static JournalManager instance;
     return instance;
@@ -25,23 +58,70 @@ JournalManager::JournalManager() {
     load();
 }
 
-QString JournalManager::getStoragePath() const {
+QString JournalManager::getStorageDir() const {
+    auto dataPath = Platform::getDataPath();
+    return QString::fromStdString((dataPath / "journal").string());
+}
+
+QString JournalManager::getIndexPath() const {
+    return getStorageDir() + "/index.json";
+}
+
+QString JournalManager::getEntryPath(const QString& id) const {
+    return getStorageDir() + "/entries/" + id + ".json";
+}
+
+QString JournalManager::getLegacyPath() const {
     auto dataPath = Platform::getDataPath();
     return QString::fromStdString((dataPath / "journals.json").string());
 }
 
+QString JournalManager::getSearchIndexPath() const {
+    return getStorageDir() + "/search.idx";
+}
+
+void JournalManager::reindex() {
+    m_index.clear();
+    m_index.reserve(m_entries.size());
+    for (int i = 0; i < m_entries.size(); ++i) {
+        m_index.insert(m_entries[i].id, i);
+    }
+}
+
 JournalEntry* JournalManager::getEntry(const QString& id) {
-    for (auto& entry : m_entries) {
-        if (entry.id == id) {
-            return &entry;
-        }
+    auto it = m_index.constFind(id);
+    if (it == m_index.constEnd()) {
+        return nullptr;
+    }
+    JournalEntry& entry = m_entries[it.value()];
+    if (!m_loaded.contains(id)) {
+        loadContent(entry);
+    }
+    return &entry;
+}
+
+bool JournalManager::loadContent(JournalEntry& entry) {
+    // Marked loaded even on failure so a missing body reads as empty once
+    m_loaded.insert(entry.id);
+    
+    QString path = getEntryPath(entry.id);
+    QJsonDocument doc = readJson(path);
+    if (!doc.isObject()) {
+        spdlog::warn("Journal entry body missing or invalid: {}", path.toStdString());
+        return false;
     }
-    return nullptr;
+    entry.content = doc.object()["content"].toString();
+    return true;
 }
 
 JournalEntry JournalManager::createEntry(const QString& title) {
     JournalEntry entry = JournalEntry::create(title);
+    m_index.insert(entry.id, m_entries.size());
     m_entries.append(entry);
+    m_loaded.insert(entry.id);
+    m_dirty.insert(entry.id);
+    m_indexDirty = true;
+    m_search.update(entry);
     save();
     
     emit entryAdded(entry.id);
@@ -52,91 +132,262 @@ JournalEntry JournalManager::createEntry(const QString& title) {
 }
 
 bool JournalManager::updateEntry(const JournalEntry& entry) {
-    for (int i = 0; i < m_entries.size(); ++i) {
-        if (m_entries[i].id == entry.id) {
-            m_entries[i] = entry;
-            m_entries[i].modifiedAt = QDateTime::currentDateTime();
-            save();
-            
-            emit entryUpdated(entry.id);
-            emit entriesChanged();
-            return true;
+    auto it = m_index.constFind(entry.id);
+    if (it == m_index.constEnd()) {
+        return false;
+    }
+    
+    JournalEntry& stored = m_entries[it.value()];
+    stored = entry;
+    stored.modifiedAt = QDateTime::currentDateTime();
+    m_loaded.insert(entry.id);
+    m_dirty.insert(entry.id);
+    m_indexDirty = true;
+    m_unindexed.remove(entry.id);
+    m_search.update(stored);
+    save();
+    
+    emit entryUpdated(entry.id);
+    emit entriesChanged();
+    return true;
+}
+
+bool JournalManager::applyEdit(const QString& id, int position, int removed, const QString& inserted) {
+    auto it = m_index.constFind(id);
+    if (it == m_index.constEnd()) {
+        return false;
+    }
+    
+    JournalEntry& stored = m_entries[it.value()];
+    if (!m_loaded.contains(id)) {
+        loadContent(stored);
+    }
+    if (position < 0 || removed < 0 || position + removed > stored.content.size()) {
+        return false;
+    }
+    
+    stored.content.replace(position, removed, inserted);
+    stored.modifiedAt = QDateTime::currentDateTime();
+    m_dirty.insert(id);
+    m_unindexed.insert(id);
+    m_indexDirty = true;
+    
+    emit entryUpdated(id);
+    return true;
+}
+
+void JournalManager::indexEdited() {
+    for (const auto& id : std::as_const(m_unindexed)) {
+        auto it = m_index.constFind(id);
+        if (it != m_index.constEnd()) {
+            m_search.update(m_entries[it.value()]);
         }
     }
-    return false;
+    m_unindexed.clear();
 }
 
 bool JournalManager::deleteEntry(const QString& id) {
-    for (int i = 0; i < m_entries.size(); ++i) {
-        if (m_entries[i].id == id) {
-            QString title = m_entries[i].title;
-            m_entries.removeAt(i);
-            save();
-            
-            emit entryRemoved(id);
-            emit entriesChanged();
-            
-            spdlog::info("Deleted journal entry: {}", title.toStdString());
-            return true;
-        }
+    auto it = m_index.constFind(id);
+    if (it == m_index.constEnd()) {
+        return false;
     }
-    return false;
+    
+    QString title = m_entries[it.value()].title;
+    m_entries.removeAt(it.value());
+    reindex();
+    m_loaded.remove(id);
+    m_dirty.remove(id);
+    m_unindexed.remove(id);
+    m_indexDirty = true;
+    m_search.remove(id);
+    
+    save();
+    QFile::remove(getEntryPath(id));
+    
+    emit entryRemoved(id);
+    emit entriesChanged();
+    
+    spdlog::info("Deleted journal entry: {}", title.toStdString());
+    return true;
 }
 
-void JournalManager::save() {
+bool JournalManager::writeEntry(const JournalEntry& entry) {
+    return writeJson(getEntryPath(entry.id), QJsonDocument(entry.toJson()), QJsonDocument::Indented);
+}
+
+bool JournalManager::writeIndex() {
     QJsonArray array;
     for (const auto& entry : m_entries) {
-        array.append(entry.toJson());
+        array.append(entry.toMetadataJson());
+    }
+    return writeJson(getIndexPath(), QJsonDocument(array), QJsonDocument::Compact);
+}
+
+void JournalManager::save() {
+    // Bodies first, so the index never lists an entry whose file is missing
+    int written = 0;
+    for (auto it = m_dirty.begin(); it != m_dirty.end();) {
+        auto pos = m_index.constFind(*it);
+        if (pos == m_index.constEnd()) {
+            it = m_dirty.erase(it);
+            continue;
+        }
+        if (!writeEntry(m_entries[pos.value()])) {
+            ++it;
+            continue;
+        }
+        ++written;
+        it = m_dirty.erase(it);
     }
     
-    QJsonDocument doc(array);
-    QString path = getStoragePath();
-    
-    // Ensure directory exists
-    QFileInfo fileInfo(path);
-    QDir().mkpath(fileInfo.absolutePath());
-    
-    QFile file(path);
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(doc.toJson());
-        file.close();
-        spdlog::debug("Saved {} journal entries", m_entries.size());
-    } else {
-        spdlog::error("Failed to save journals to: {}", path.toStdString());
+    if (m_indexDirty && writeIndex()) {
+        m_indexDirty = false;
     }
+    indexEdited();
+    if (m_search.isDirty()) {
+        m_search.save(getSearchIndexPath());
+    }
+    spdlog::debug("Saved {} of {} journal entries", written, m_entries.size());
 }
 
 void JournalManager::load() {
-    QString path = getStoragePath();
-    QFile file(path);
+    m_entries.clear();
+    m_loaded.clear();
+    m_dirty.clear();
+    m_unindexed.clear();
+    m_indexDirty = false;
     
-    if (!file.exists()) {
-        spdlog::debug("No journal file found at: {}", path.toStdString());
+    QString indexPath = getIndexPath();
+    if (!QFile::exists(indexPath)) {
+        if (QFile::exists(getLegacyPath())) {
+            migrateLegacy();
+        } else if (QDir(getStorageDir() + "/entries").exists()) {
+            rebuildIndex();
+        } else {
+            spdlog::debug("No journal found at: {}", getStorageDir().toStdString());
+        }
+        reindex();
+        syncSearchIndex();
         return;
     }
     
-    if (!file.open(QIODevice::ReadOnly)) {
-        spdlog::error("Failed to open journals file: {}", path.toStdString());
+    QJsonDocument doc = readJson(indexPath);
+    if (!doc.isArray()) {
+        spdlog::error("Invalid journal index, rebuilding from entries");
+        rebuildIndex();
+        reindex();
+        syncSearchIndex();
         return;
     }
     
-    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-    file.close();
+    const QJsonArray array = doc.array();
+    m_entries.reserve(array.size());
+    for (const auto& value : array) {
+        if (value.isObject()) {
+            m_entries.append(JournalEntry::fromJson(value.toObject()));
+        }
+    }
+    reindex();
+    syncSearchIndex();
     
+    spdlog::info("Loaded {} journal entries", m_entries.size());
+}
+
+void JournalManager::syncSearchIndex() {
+    m_search.load(getSearchIndexPath());
+    
+    int reindexed = 0;
+    for (auto& entry : m_entries) {
+        if (m_search.isCurrent(entry)) {
+            continue;
+        }
+        if (!m_loaded.contains(entry.id)) {
+            loadContent(entry);
+        }
+        m_search.update(entry);
+        ++reindexed;
+    }
+    for (const auto& id : m_search.ids()) {
+        if (!m_index.contains(id)) {
+            m_search.remove(id);
+        }
+    }
+    
+    if (m_search.isDirty()) {
+        m_search.save(getSearchIndexPath());
+        spdlog::info("Reindexed {} journal entries for search", reindexed);
+    }
+}
+
+QVector<JournalSearchHit> JournalManager::search(const QString& query, int limit) {
+    indexEdited();
+    QStringList words = JournalSearchIndex::tokenize(query);
+    QVector<JournalSearchHit> hits;
+    for (const auto& [id, score] : m_search.search(query, static_cast<size_t>(std::max(limit, 0)))) {
+        JournalEntry* entry = getEntry(id);
+        if (!entry) {
+            continue;
+        }
+        JournalSearchHit hit;
+        hit.id = id;
+        hit.title = entry->title;
+        hit.score = score;
+        hit.titleHighlights = JournalSearchIndex::highlight(entry->title, words);
+        hit.snippet = JournalSearchIndex::snippet(entry->content, words, hit.snippetHighlights);
+        hits.append(hit);
+    }
+    return hits;
+}
+
+void JournalManager::rebuildIndex() {
+    QDir dir(getStorageDir() + "/entries");
+    const auto files = dir.entryInfoList({"*.json"}, QDir::Files, QDir::Name);
+    for (const auto& info : files) {
+        QJsonDocument doc = readJson(info.absoluteFilePath());
+        if (!doc.isObject()) {
+            spdlog::warn("Skipping invalid journal entry: {}", info.fileName().toStdString());
+            continue;
+        }
+        JournalEntry entry = JournalEntry::fromJson(doc.object());
+        if (!entry.id.isEmpty()) {
+            m_loaded.insert(entry.id);
+            m_entries.append(entry);
+        }
+    }
+    std::sort(m_entries.begin(), m_entries.end(), [](const JournalEntry& a, const JournalEntry& b) {
+        return a.createdAt < b.createdAt;
+    });
+    
+    m_indexDirty = true;
+    save();
+    spdlog::info("Rebuilt journal index with {} entries", m_entries.size());
+}
+
+void JournalManager::migrateLegacy() {
+    QString legacyPath = getLegacyPath();
+    QJsonDocument doc = readJson(legacyPath);
     if (!doc.isArray()) {
         spdlog::error("Invalid journals file format");
         return;
     }
     
-    m_entries.clear();
-    QJsonArray array = doc.array();
-    for (const auto& value : array) {
+    for (const auto& value : doc.array()) {
         if (value.isObject()) {
-            m_entries.append(JournalEntry::fromJson(value.toObject()));
+            JournalEntry entry = JournalEntry::fromJson(value.toObject());
+            m_loaded.insert(entry.id);
+            m_dirty.insert(entry.id);
+            m_entries.append(entry);
         }
     }
+    reindex();
+    m_indexDirty = true;
+    save();
     
-    spdlog::info("Loaded {} journal entries", m_entries.size());
+    // Keep the old file around unless every entry made it across
+    if (m_dirty.isEmpty() && !m_indexDirty) {
+        QFile::rename(legacyPath, legacyPath + ".migrated");
+    }
+    spdlog::info("Migrated {} journal entries from {}", m_entries.size(), legacyPath.toStdString());
 }
 
 } // namespace lotro
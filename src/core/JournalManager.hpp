@@ -9,8 +9,11 @@
 #pragma once
 
 #include "JournalEntry.hpp"
+#include "JournalSearchIndex.hpp"
 
+#include <QHash>
 #include <QObject>
+#include <QSet>
 #include <QVector>
 #include <QString>
 
@@ -19,21 +22,34 @@ namespace lotro {
 /**
  * Manages player journal entries
  * 
- * Provides CRUD operations and persistence to JSON file.
+ * Provides CRUD operations and persistence under the data directory's
+ * journal/ folder. index.json holds the metadata (id, title, dates, tags)
+ * of every entry and is all that is read at startup; each body lives in
+ * entries/<id>.json and is read the first time the entry is opened.
+ * Changes rewrite only the touched entry's file plus the index, both
+ * through QSaveFile. A journals.json from older versions is migrated on
+ * first load.
+ * 
+ * A JournalSearchIndex over titles and bodies is kept in step with every
+ * change and persisted as search.idx next to the index; on load only the
+ * entries modified since it was written are reindexed. Edits applied with
+ * applyEdit() are indexed on the next save() or search instead.
  */
 class JournalManager : public QObject {
     Q_OBJECT
-    
+
 public:
     static JournalManager& instance();
     
     /**
-     * Get all journal entries
+     * Get all journal entries, in creation order
+     * 
+     * Only metadata is filled in; use getEntry() for the content.
      */
     QVector<JournalEntry> entries() const { return m_entries; }
     
     /**
-     * Get entry by ID
+     * Get entry by ID, loading its content if needed
      */
     JournalEntry* getEntry(const QString& id);
     
@@ -47,34 +63,75 @@ public:
      */
     bool updateEntry(const JournalEntry& entry);
     
+    /**
+     * Replace part of an entry's content, as an editor reports a change
+     * 
+     * Patches the stored body in place and marks the entry for the next
+     * save(), so an open editor never has to hand over the whole text.
+     * Returns false if the entry is unknown or the range is out of bounds.
+     */
+    bool applyEdit(const QString& id, int position, int removed, const QString& inserted);
+    
     /**
      * Delete an entry
      */
     bool deleteEntry(const QString& id);
     
     /**
-     * Save entries to disk
+     * Search titles and content, best match first
+     * 
+     * Every word of the query must start a word of the entry.
+     */
+    QVector<JournalSearchHit> search(const QString& query, int limit = 50);
+    
+    /**
+     * Write entries changed since the last save, and the index
      */
     void save();
     
     /**
-     * Load entries from disk
+     * Load the entry index from disk
      */
     void load();
-    
+
 signals:
     void entriesChanged();
     void entryAdded(const QString& id);
     void entryUpdated(const QString& id);
     void entryRemoved(const QString& id);
-    
+
 private:
     JournalManager();
     ~JournalManager() = default;
     
-    QString getStoragePath() const;
+    QString getStorageDir() const;
+    QString getIndexPath() const;
+    QString getEntryPath(const QString& id) const;
+    QString getLegacyPath() const;
+    QString getSearchIndexPath() const;
+    
+    bool loadContent(JournalEntry& entry);
+    bool writeEntry(const JournalEntry& entry);
+    bool writeIndex();
+    
+    // Rebuild the index from entry files when index.json is missing
+    void rebuildIndex();
+    void migrateLegacy();
+    void reindex();
+    
+    // Bring the search index up to date with the loaded entries
+    void syncSearchIndex();
+    
+    // Index entries changed through applyEdit() since the last call
+    void indexEdited();
     
     QVector<JournalEntry> m_entries;
+    QHash<QString, int> m_index;       // id -> position in m_entries
+    QSet<QString> m_loaded;            // Entries whose content has been read
+    QSet<QString> m_dirty;             // Entries to write on the next save()
+    QSet<QString> m_unindexed;         // Edited entries the search index is behind on
+    bool m_indexDirty = false;
+    JournalSearchIndex m_search;
 };
 
 } // namespace lotro
@@ -0,0 +1,356 @@
+/**
+ * LOTRO Launcher - Journal Search Index Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "JournalSearchIndex.hpp"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace lotro {
+
+namespace {
+
+// Visit each run of letters and digits as (start, length)
+template <typename Fn>
+void forEachWord(const QString& text, Fn&& fn) {
+    const qsizetype length = text.size();
+    qsizetype start = -1;
+    for (qsizetype i = 0; i <= length; ++i) {
+        bool wordChar = i < length && text[i].isLetterOrNumber();
+        if (wordChar && start < 0) {
+            start = i;
+        } else if (!wordChar && start >= 0) {
+            fn(static_cast<int>(start), static_cast<int>(i - start));
+            start = -1;
+        }
+    }
+}
+
+uint16_t saturatingIncrement(uint16_t value) {
+    return value == UINT16_MAX ? value : static_cast<uint16_t>(value + 1);
+}
+
+} // anonymous namespace
+
+QStringList JournalSearchIndex::tokenize(const QString& text) {
+    QStringList words;
+    forEachWord(text, [&](int start, int length) {
+        words.append(text.mid(start, length).toCaseFolded());
+    });
+    return words;
+}
+
+void JournalSearchIndex::update(const JournalEntry& entry) {
+    uint32_t doc;
+    auto existing = m_ids.constFind(entry.id);
+    if (existing != m_ids.constEnd()) {
+        doc = existing.value();
+        removeDoc(doc);
+    } else if (!m_freeDocs.empty()) {
+        doc = m_freeDocs.back();
+        m_freeDocs.pop_back();
+    } else {
+        doc = static_cast<uint32_t>(m_docs.size());
+        m_docs.emplace_back();
+    }
+    
+    QHash<QString, Hit> counts;
+    const QStringList titleWords = tokenize(entry.title);
+    const QStringList bodyWords = tokenize(entry.content);
+    for (const auto& word : titleWords) {
+        Hit& hit = counts[word];
+        hit.title = saturatingIncrement(hit.title);
+    }
+    for (const auto& word : bodyWords) {
+        Hit& hit = counts[word];
+        hit.body = saturatingIncrement(hit.body);
+    }
+    
+    Doc& d = m_docs[doc];
+    d.id = entry.id;
+    d.stamp = entry.modifiedAt.toSecsSinceEpoch();
+    d.length = static_cast<uint32_t>(TITLE_WEIGHT * titleWords.size() + bodyWords.size());
+    d.words = counts.keys();
+    d.alive = true;
+    for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) {
+        m_words[it.key()].insert(doc, it.value());
+    }
+    
+    m_ids.insert(entry.id, doc);
+    m_totalLength += d.length;
+    m_dirty = true;
+}
+
+void JournalSearchIndex::remove(const QString& id) {
+    auto it = m_ids.constFind(id);
+    if (it == m_ids.constEnd()) {
+        return;
+    }
+    uint32_t doc = it.value();
+    removeDoc(doc);
+    m_freeDocs.push_back(doc);
+    m_dirty = true;
+}
+
+void JournalSearchIndex::removeDoc(uint32_t doc) {
+    Doc& d = m_docs[doc];
+    for (const auto& word : d.words) {
+        auto it = m_words.find(word);
+        if (it == m_words.end()) {
+            continue;
+        }
+        it->second.remove(doc);
+        if (it->second.isEmpty()) {
+            m_words.erase(it);
+        }
+    }
+    m_ids.remove(d.id);
+    m_totalLength -= d.length;
+    d = Doc();
+}
+
+bool JournalSearchIndex::isCurrent(const JournalEntry& entry) const {
+    auto it = m_ids.constFind(entry.id);
+    return it != m_ids.constEnd() && m_docs[it.value()].stamp == entry.modifiedAt.toSecsSinceEpoch();
+}
+
+double JournalSearchIndex::bm25(const Hit& hit, const Doc& doc, size_t postingCount) const {
+    const double docs = static_cast<double>(m_ids.size());
+    const double n = static_cast<double>(postingCount);
+    const double idf = std::log(1.0 + (docs - n + 0.5) / (n + 0.5));
+    const double tf = TITLE_WEIGHT * hit.title + hit.body;
+    const double averageLength = std::max(1.0, static_cast<double>(m_totalLength) / docs);
+    return idf * tf * (K1 + 1.0) / (tf + K1 * (1.0 - B + B * doc.length / averageLength));
+}
+
+std::vector<std::pair<QString, double>> JournalSearchIndex::search(const QString& query, size_t limit) const {
+    QStringList words = tokenize(query);
+    words.removeDuplicates();
+    if (words.isEmpty() || m_ids.isEmpty()) {
+        return {};
+    }
+    
+    // Per query word, the best score of each entry over the words it prefixes
+    QHash<uint32_t, double> scores;
+    for (qsizetype i = 0; i < words.size(); ++i) {
+        const QString& word = words[i];
+        QHash<uint32_t, double> wordScores;
+        for (auto it = m_words.lower_bound(word); it != m_words.end() && it->first.startsWith(word); ++it) {
+            const double weight = it->first.size() == word.size() ? 1.0 : PREFIX_WEIGHT;
+            const size_t count = static_cast<size_t>(it->second.size());
+            for (auto hit = it->second.constBegin(); hit != it->second.constEnd(); ++hit) {
+                if (i > 0 && !scores.contains(hit.key())) {
+                    continue;
+                }
+                double score = weight * bm25(hit.value(), m_docs[hit.key()], count);
+                double& best = wordScores[hit.key()];
+                best = std::max(best, score);
+            }
+        }
+        
+        if (i == 0) {
+            scores = std::move(wordScores);
+        } else {
+            for (auto it = scores.begin(); it != scores.end();) {
+                auto found = wordScores.constFind(it.key());
+                if (found == wordScores.constEnd()) {
+                    it = scores.erase(it);
+                } else {
+                    it.value() += found.value();
+                    ++it;
+                }
+            }
+        }
+        if (scores.isEmpty()) {
+            return {};
+        }
+    }
+    
+    std::vector<std::pair<uint32_t, double>> ranked(scores.constKeyValueBegin(), scores.constKeyValueEnd());
+    auto better = [this](const auto& a, const auto& b) {
+        if (a.second != b.second) {
+            return a.second > b.second;
+        }
+        return m_docs[a.first].stamp > m_docs[b.first].stamp;
+    };
+    if (limit > 0 && ranked.size() > limit) {
+        std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(limit), ranked.end(), better);
+        ranked.resize(limit);
+    } else {
+        std::sort(ranked.begin(), ranked.end(), better);
+    }
+    
+    std::vector<std::pair<QString, double>> result;
+    result.reserve(ranked.size());
+    for (const auto& [doc, score] : ranked) {
+        result.emplace_back(m_docs[doc].id, score);
+    }
+    return result;
+}
+
+TextHighlights JournalSearchIndex::highlight(const QString& text, const QStringList& words) {
+    TextHighlights highlights;
+    forEachWord(text, [&](int start, int length) {
+        QString folded = text.mid(start, length).toCaseFolded();
+        for (const auto& word : words) {
+            if (folded.startsWith(word)) {
+                highlights.append({start, length});
+                break;
+            }
+        }
+    });
+    return highlights;
+}
+
+QString JournalSearchIndex::snippet(const QString& text, const QStringList& words,
+                                    TextHighlights& highlights, int radius) {
+    highlights.clear();
+    TextHighlights all = highlight(text, words);
+    const int length = static_cast<int>(text.size());
+    
+    int start = 0;
+    int end = std::min(length, 2 * radius);
+    if (!all.isEmpty()) {
+        start = std::max(0, all.first().first - radius);
+        end = std::min(length, all.first().first + all.first().second + radius);
+    }
+    
+    // Don't cut words in half at either end
+    while (start > 0 && text[start - 1].isLetterOrNumber()) {
+        --start;
+    }
+    while (end < length && text[end].isLetterOrNumber()) {
+        ++end;
+    }
+    
+    QString prefix = start > 0 ? QString::fromUtf8("…") : QString();
+    QString excerpt = prefix + text.mid(start, end - start);
+    if (end < length) {
+        excerpt += QString::fromUtf8("…");
+    }
+    excerpt.replace('\n', ' ').replace('\r', ' ').replace('\t', ' ');
+    
+    const int shift = static_cast<int>(prefix.size()) - start;
+    for (const auto& range : all) {
+        if (range.first >= start && range.first + range.second <= end) {
+            highlights.append({range.first + shift, range.second});
+        }
+    }
+    return excerpt;
+}
+
+bool JournalSearchIndex::save(const QString& path) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write journal search index {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    
+    // Live entries are renumbered densely, dropping freed slots
+    QHash<uint32_t, quint32> remap;
+    remap.reserve(m_ids.size());
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << static_cast<quint32>(m_ids.size());
+    for (uint32_t doc = 0; doc < m_docs.size(); ++doc) {
+        const Doc& d = m_docs[doc];
+        if (!d.alive) {
+            continue;
+        }
+        remap.insert(doc, static_cast<quint32>(remap.size()));
+        out << d.id << d.stamp << d.length;
+    }
+    
+    out << static_cast<quint32>(m_words.size());
+    for (const auto& [word, postings] : m_words) {
+        out << word << static_cast<quint32>(postings.size());
+        for (auto it = postings.constBegin(); it != postings.constEnd(); ++it) {
+            out << remap.value(it.key()) << it.value().title << it.value().body;
+        }
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit journal search index {}", path.toStdString());
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool JournalSearchIndex::load(const QString& path) {
+    m_docs.clear();
+    m_freeDocs.clear();
+    m_ids.clear();
+    m_words.clear();
+    m_totalLength = 0;
+    m_dirty = false;
+    
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, docCount = 0;
+    in >> magic >> version >> docCount;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("Journal search index {} is outdated, rebuilding", path.toStdString());
+        return false;
+    }
+    
+    m_docs.resize(docCount);
+    for (quint32 doc = 0; doc < docCount && in.status() == QDataStream::Ok; ++doc) {
+        Doc& d = m_docs[doc];
+        in >> d.id >> d.stamp >> d.length;
+        d.alive = true;
+        m_ids.insert(d.id, doc);
+        m_totalLength += d.length;
+    }
+    
+    quint32 wordCount = 0;
+    in >> wordCount;
+    for (quint32 i = 0; i < wordCount && in.status() == QDataStream::Ok; ++i) {
+        QString word;
+        quint32 count = 0;
+        in >> word >> count;
+        Postings& postings = m_words[word];
+        for (quint32 j = 0; j < count && in.status() == QDataStream::Ok; ++j) {
+            quint32 doc = 0;
+            Hit hit;
+            in >> doc >> hit.title >> hit.body;
+            if (doc >= docCount) {
+                in.setStatus(QDataStream::ReadCorruptData);
+                break;
+            }
+            postings.insert(doc, hit);
+            m_docs[doc].words.append(word);
+        }
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Journal search index {} is corrupt, rebuilding", path.toStdString());
+        m_docs.clear();
+        m_ids.clear();
+        m_words.clear();
+        m_totalLength = 0;
+        return false;
+    }
+    return true;
+}
+
+} // namespace lotro
@@ -0,0 +1,145 @@
+/**
+ * LOTRO Launcher - Journal Search Index
+ * 
+ * Incremental inverted index over journal entry titles and bodies.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "JournalEntry.hpp"
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Text ranges to highlight, as (start, length)
+ */
+using TextHighlights = QVector<QPair<int, int>>;
+
+/**
+ * One search result with what to highlight
+ */
+struct JournalSearchHit {
+    QString id;
+    QString title;
+    double score = 0.0;
+    TextHighlights titleHighlights;
+    QString snippet;                    // Excerpt of the content around the first match
+    TextHighlights snippetHighlights;
+};
+
+/**
+ * Inverted index over journal entries
+ * 
+ * Titles and bodies are split into case-folded words. Each word maps to
+ * the entries containing it, with separate title and body counts, and
+ * words are kept sorted so a query word matches every indexed word it is
+ * a prefix of. An entry matches when all query words do; results are
+ * ranked with BM25, title hits weighted above body hits and whole-word
+ * matches above prefix matches.
+ * 
+ * Entries are added, replaced and removed one at a time. Each remembers
+ * the modification time it was indexed at, so a persisted index can be
+ * brought up to date by reindexing only the entries that changed since.
+ */
+class JournalSearchIndex {
+public:
+    /**
+     * Add an entry, or replace its previous version
+     */
+    void update(const JournalEntry& entry);
+    
+    /**
+     * Drop an entry
+     */
+    void remove(const QString& id);
+    
+    /**
+     * Whether an entry is indexed as of its modification time
+     */
+    bool isCurrent(const JournalEntry& entry) const;
+    
+    /**
+     * Ids of every indexed entry
+     */
+    QStringList ids() const { return m_ids.keys(); }
+    
+    /**
+     * Find entries matching every word of a query
+     * @param limit Maximum number of results, 0 for all
+     * @return (id, score), best first
+     */
+    std::vector<std::pair<QString, double>> search(const QString& query, size_t limit = 0) const;
+    
+    /**
+     * Split text into case-folded words
+     */
+    static QStringList tokenize(const QString& text);
+    
+    /**
+     * Words of text starting with any of the (folded) query words
+     */
+    static TextHighlights highlight(const QString& text, const QStringList& words);
+    
+    /**
+     * Excerpt of text around its first highlighted word
+     * @param highlights Set to the highlights within the excerpt
+     */
+    static QString snippet(const QString& text, const QStringList& words,
+                           TextHighlights& highlights, int radius = SNIPPET_RADIUS);
+    
+    bool save(const QString& path);
+    bool load(const QString& path);
+    
+    bool isDirty() const { return m_dirty; }
+    size_t size() const { return static_cast<size_t>(m_ids.size()); }
+    
+    static constexpr int SNIPPET_RADIUS = 60;
+
+private:
+    struct Doc {
+        QString id;
+        qint64 stamp = 0;           // modifiedAt, seconds since epoch
+        uint32_t length = 0;        // Words, title weighted
+        QStringList words;          // Distinct words, for removal
+        bool alive = false;
+    };
+    
+    struct Hit {
+        uint16_t title = 0;
+        uint16_t body = 0;
+    };
+    
+    using Postings = QHash<uint32_t, Hit>;
+    
+    void removeDoc(uint32_t doc);
+    double bm25(const Hit& hit, const Doc& doc, size_t postingCount) const;
+    
+    static constexpr double K1 = 1.2;
+    static constexpr double B = 0.75;
+    static constexpr int TITLE_WEIGHT = 3;
+    static constexpr double PREFIX_WEIGHT = 0.6;
+    static constexpr quint32 MAGIC = 0x4A534958;    // "JSIX"
+    static constexpr quint32 VERSION = 1;
+    
+    std::vector<Doc> m_docs;
+    std::vector<uint32_t> m_freeDocs;
+    QHash<QString, uint32_t> m_ids;
+    std::map<QString, Postings> m_words;
+    uint64_t m_totalLength = 0;
+    bool m_dirty = false;
+};
+
+} // namespace lotro
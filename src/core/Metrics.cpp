@@ -0,0 +1,186 @@
+/**
+ * LOTRO Launcher - Metrics Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "Metrics.hpp"
+#include "AllocationProfiler.hpp"
+#include "TaskScheduler.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QTimer>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace lotro::metrics {
+
+namespace {
+
+bool writeDump(const QString& path, const QByteArray& json) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write metrics {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    file.write(json);
+    return file.commit();
+}
+
+} // namespace
+
+void Histogram::record(uint64_t value) {
+    m_buckets[bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+    
+    uint64_t seen = m_max.load(std::memory_order_relaxed);
+    while (value > seen && !m_max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+double Histogram::mean() const {
+    const uint64_t n = count();
+    return n > 0 ? static_cast<double>(sum()) / n : 0.0;
+}
+
+uint64_t Histogram::percentile(double fraction) const {
+    std::array<uint64_t, BUCKETS> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    
+    const uint64_t wanted = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += counts[i];
+        if (seen >= wanted) {
+            return std::min(bucketUpperBound(i), max());
+        }
+    }
+    return max();
+}
+
+size_t Histogram::bucketFor(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+    // The top SUB_BUCKET_BITS + 1 bits pick the bucket; the rest is rounding
+    const int shift = std::bit_width(value) - 1 - SUB_BUCKET_BITS;
+    const size_t sub = static_cast<size_t>(value >> shift) & (SUB_BUCKETS - 1);
+    return (shift + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t Histogram::bucketUpperBound(size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    const int shift = static_cast<int>(bucket / SUB_BUCKETS) - 1;
+    const uint64_t lower = (SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+Registry& Registry::instance() {
+    static Registry registry;
+    return registry;
+}
+
+Counter& Registry::counter(const QString& name) {
+    QMutexLocker lock(&m_mutex);
+    auto& slot = m_counters[name];
+    if (!slot) {
+        slot = std::make_unique<Counter>();
+    }
+    return *slot;
+}
+
+Gauge& Registry::gauge(const QString& name) {
+    QMutexLocker lock(&m_mutex);
+    auto& slot = m_gauges[name];
+    if (!slot) {
+        slot = std::make_unique<Gauge>();
+    }
+    return *slot;
+}
+
+Histogram& Registry::histogram(const QString& name) {
+    QMutexLocker lock(&m_mutex);
+    auto& slot = m_histograms[name];
+    if (!slot) {
+        slot = std::make_unique<Histogram>();
+    }
+    return *slot;
+}
+
+QJsonObject Registry::snapshot() const {
+    allocation::publish();
+    
+    QJsonObject counters;
+    QJsonObject gauges;
+    QJsonObject histograms;
+    
+    QMutexLocker lock(&m_mutex);
+    for (const auto& [name, counter] : m_counters) {
+        counters[name] = static_cast<qint64>(counter->value());
+    }
+    for (const auto& [name, gauge] : m_gauges) {
+        gauges[name] = static_cast<qint64>(gauge->value());
+    }
+    for (const auto& [name, histogram] : m_histograms) {
+        histograms[name] = QJsonObject{
+            {"count", static_cast<qint64>(histogram->count())},
+            {"mean", histogram->mean()},
+            {"p50", static_cast<qint64>(histogram->percentile(0.50))},
+            {"p90", static_cast<qint64>(histogram->percentile(0.90))},
+            {"p99", static_cast<qint64>(histogram->percentile(0.99))},
+            {"max", static_cast<qint64>(histogram->max())}
+        };
+    }
+    lock.unlock();
+    
+    return QJsonObject{
+        {"time", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+        {"counters", counters},
+        {"gauges", gauges},
+        {"histograms", histograms}
+    };
+}
+
+QString Registry::dumpPath() {
+    return QDir(QString::fromStdString(Platform::getCachePath().string())).filePath("metrics.json");
+}
+
+void Registry::startPeriodicDump(int intervalMs) {
+    auto* app = QCoreApplication::instance();
+    auto* timer = new QTimer(app);
+    // Snapshot here, write on the I/O pool so a slow disk doesn't stall the GUI
+    QObject::connect(timer, &QTimer::timeout, app, [this]() {
+        QByteArray json = QJsonDocument(snapshot()).toJson();
+        TaskScheduler::instance().run(TaskPool::Io, [json = std::move(json)]() {
+            writeDump(dumpPath(), json);
+        }, TaskPriority::Low);
+    });
+    QObject::connect(app, &QCoreApplication::aboutToQuit, app, [this]() {
+        writeDump(dumpPath(), QJsonDocument(snapshot()).toJson());
+    });
+    timer->start(intervalMs);
+}
+
+} // namespace lotro::metrics
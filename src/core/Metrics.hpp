@@ -0,0 +1,149 @@
+/**
+ * LOTRO Launcher - Metrics
+ * 
+ * Process-wide counters, gauges and latency histograms.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+namespace lotro::metrics {
+
+/**
+ * Monotonic count of events or bytes
+ */
+class Counter {
+public:
+    void add(uint64_t n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return m_value.load(std::memory_order_relaxed); }
+    
+private:
+    std::atomic<uint64_t> m_value{0};
+};
+
+/**
+ * Current level of something, such as bytes held by a cache
+ */
+class Gauge {
+public:
+    void set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+    void add(int64_t delta) { m_value.fetch_add(delta, std::memory_order_relaxed); }
+    int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+    
+private:
+    std::atomic<int64_t> m_value{0};
+};
+
+/**
+ * Distribution of non-negative values, usually microseconds
+ * 
+ * Log-linear buckets in the manner of HdrHistogram: values below 16 are
+ * exact, above that every power of two is split into 16 buckets, so a
+ * percentile is within about 6% of the true value over the whole 64-bit
+ * range. Recording is two relaxed atomic adds and a compare-exchange
+ * loop for the maximum; reads may see a sample half-recorded, which is
+ * fine for a dashboard.
+ */
+class Histogram {
+public:
+    void record(uint64_t value);
+    
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return m_sum.load(std::memory_order_relaxed); }
+    uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+    double mean() const;
+    
+    /**
+     * Upper bound of the bucket holding the given fraction of samples
+     */
+    uint64_t percentile(double fraction) const;
+    
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+    
+private:
+    static size_t bucketFor(uint64_t value);
+    static uint64_t bucketUpperBound(size_t bucket);
+    
+    std::array<std::atomic<uint64_t>, BUCKETS> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+/**
+ * Records the lifetime of a scope into a histogram in microseconds
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& histogram) : m_histogram(histogram) { m_timer.start(); }
+    ~ScopedTimer() { m_histogram.record(static_cast<uint64_t>(m_timer.nsecsElapsed() / 1000)); }
+    
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+    
+private:
+    Histogram& m_histogram;
+    QElapsedTimer m_timer;
+};
+
+/**
+ * Named metrics for the whole process
+ * 
+ * Looking a metric up takes a lock, so callers keep the reference in a
+ * function-local static; metrics are never removed and references stay
+ * valid for the life of the process. Recording into a metric takes no
+ * lock. Names are dotted, subsystem first ("dat.read_us"), with the unit
+ * as a suffix where there is one.
+ */
+class Registry {
+public:
+    static Registry& instance();
+    
+    Counter& counter(const QString& name);
+    Gauge& gauge(const QString& name);
+    Histogram& histogram(const QString& name);
+    
+    /**
+     * Current values: {"counters": {...}, "gauges": {...}, "histograms":
+     * {name: {count, mean, p50, p90, p99, max}}}
+     */
+    QJsonObject snapshot() const;
+    
+    /**
+     * Write the snapshot to metrics.json in the cache directory every
+     * intervalMs and at exit. Call once, from the GUI thread.
+     */
+    void startPeriodicDump(int intervalMs = DUMP_INTERVAL_MS);
+    
+    static QString dumpPath();
+    
+    static constexpr int DUMP_INTERVAL_MS = 60000;
+    
+private:
+    Registry() = default;
+    
+    mutable QMutex m_mutex;
+    std::map<QString, std::unique_ptr<Counter>> m_counters;
+    std::map<QString, std::unique_ptr<Gauge>> m_gauges;
+    std::map<QString, std::unique_ptr<Histogram>> m_histograms;
+};
+
+inline Counter& counter(const QString& name) { return Registry::instance().counter(name); }
+inline Gauge& gauge(const QString& name) { return Registry::instance().gauge(name); }
+inline Histogram& histogram(const QString& name) { return Registry::instance().histogram(name); }
+
+} // namespace lotro::metrics
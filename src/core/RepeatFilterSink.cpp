@@ -0,0 +1,63 @@
+/**
+ * LOTRO Launcher - Repeat Filter Sink Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "RepeatFilterSink.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+namespace lotro {
+
+RepeatFilterSink::RepeatFilterSink(std::chrono::milliseconds window)
+    : m_window(window)
+{
+}
+
+void RepeatFilterSink::sink_it_(const spdlog::details::log_msg& msg) {
+    std::string message(msg.payload.data(), msg.payload.size());
+    auto it = m_seen.find(message);
+    if (it != m_seen.end()) {
+        if (msg.time - it->second.since < m_window) {
+            it->second.suppressed++;
+            return;
+        }
+        reportSuppressed(it->first, it->second, msg);
+        it->second = Seen{msg.time, msg.level, 0};
+    } else {
+        if (m_seen.size() >= MAX_TRACKED) {
+            forgetExpired(msg.time);
+        }
+        // Still full of live messages: pass this one through untracked
+        if (m_seen.size() < MAX_TRACKED) {
+            m_seen.emplace(std::move(message), Seen{msg.time, msg.level, 0});
+        }
+    }
+    dist_sink<std::mutex>::sink_it_(msg);
+}
+
+void RepeatFilterSink::reportSuppressed(const std::string& message, const Seen& seen,
+                                        const spdlog::details::log_msg& context) {
+    if (seen.suppressed == 0) {
+        return;
+    }
+    const std::string text = fmt::format("Suppressed {} repeats of: {}", seen.suppressed, message);
+    spdlog::details::log_msg notice(context.time, spdlog::source_loc{}, context.logger_name,
+                                    seen.level, text);
+    dist_sink<std::mutex>::sink_it_(notice);
+}
+
+void RepeatFilterSink::forgetExpired(spdlog::log_clock::time_point now) {
+    for (auto it = m_seen.begin(); it != m_seen.end();) {
+        if (now - it->second.since >= m_window) {
+            spdlog::details::log_msg context(now, spdlog::source_loc{}, {}, it->second.level, {});
+            reportSuppressed(it->first, it->second, context);
+            it = m_seen.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace lotro
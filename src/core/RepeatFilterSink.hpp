@@ -0,0 +1,54 @@
+/**
+ * LOTRO Launcher - Repeat Filter Sink
+ * 
+ * Log sink that drops messages repeated within a time window.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <spdlog/sinks/dist_sink.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace lotro {
+
+/**
+ * Forwards each distinct message at most once per window to its sinks
+ * 
+ * Unlike spdlog's dup_filter_sink, which only catches a message repeated
+ * back to back, this remembers every message seen in the window, so a
+ * warning logged on each sync tick between other lines is still caught.
+ * When the message next gets through, or is forgotten, a line saying how
+ * many copies were dropped goes out with it. Meant to sit behind the
+ * async logger, so the bookkeeping runs on the logging thread.
+ */
+class RepeatFilterSink : public spdlog::sinks::dist_sink<std::mutex> {
+public:
+    explicit RepeatFilterSink(std::chrono::milliseconds window);
+    
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    
+private:
+    struct Seen {
+        spdlog::log_clock::time_point since;
+        spdlog::level::level_enum level = spdlog::level::info;
+        size_t suppressed = 0;
+    };
+    
+    void reportSuppressed(const std::string& message, const Seen& seen,
+                          const spdlog::details::log_msg& context);
+    void forgetExpired(spdlog::log_clock::time_point now);
+    
+    std::chrono::milliseconds m_window;
+    std::unordered_map<std::string, Seen> m_seen;
+    
+    static constexpr size_t MAX_TRACKED = 512;
+};
+
+} // namespace lotro
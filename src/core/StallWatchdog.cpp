@@ -0,0 +1,132 @@
+/**
+ * LOTRO Launcher - Stall Watchdog Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "StallWatchdog.hpp"
+#include "Metrics.hpp"
+
+#include <QCoreApplication>
+#include <QMetaObject>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace lotro {
+
+namespace stall {
+
+std::atomic<const char*> currentScope{nullptr};
+thread_local bool isWatchedThread = false;
+
+} // namespace stall
+
+StallWatchdog& StallWatchdog::instance() {
+    static StallWatchdog watchdog;
+    return watchdog;
+}
+
+StallWatchdog::~StallWatchdog() {
+    if (m_thread.joinable()) {
+        m_stopping = true;
+        m_thread.join();
+    }
+}
+
+void StallWatchdog::start(int thresholdMs) {
+    if (isRunning() || !QCoreApplication::instance()) {
+        return;
+    }
+    
+    stall::isWatchedThread = true;
+    m_thresholdMs = std::max(thresholdMs, POLL_MS);
+    m_stopping = false;
+    m_clock.start();
+    m_thread = std::thread([this]() { run(); });
+    spdlog::info("Stall watchdog started ({} ms threshold)", m_thresholdMs);
+}
+
+void StallWatchdog::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    
+    m_stopping = true;
+    m_thread.join();
+    stall::isWatchedThread = false;
+    stall::currentScope.store(nullptr, std::memory_order_relaxed);
+    logOffenders();
+}
+
+void StallWatchdog::run() {
+    const auto poll = std::chrono::milliseconds(POLL_MS);
+    while (!m_stopping) {
+        // The GUI thread echoes the heartbeat when its event loop gets to it
+        const uint64_t beat = ++m_sent;
+        const qint64 sentAt = m_clock.elapsed();
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [this, beat]() {
+            m_answered.store(beat, std::memory_order_release);
+        }, Qt::QueuedConnection);
+        
+        // Charge the stall to the first scope seen while it lasts
+        const char* scope = nullptr;
+        bool stalled = false;
+        while (!m_stopping && m_answered.load(std::memory_order_acquire) < beat) {
+            std::this_thread::sleep_for(poll);
+            if (m_clock.elapsed() - sentAt >= m_thresholdMs) {
+                stalled = true;
+                if (!scope) {
+                    scope = stall::currentScope.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        
+        if (stalled && !m_stopping) {
+            recordStall(m_clock.elapsed() - sentAt, scope);
+        }
+        std::this_thread::sleep_for(poll);
+    }
+}
+
+void StallWatchdog::recordStall(qint64 durationMs, const char* scope) {
+    static metrics::Histogram& stallTime = metrics::histogram("ui.stall_us");
+    static metrics::Counter& stalls = metrics::counter("ui.stalls");
+    
+    const std::string name = scope ? scope : "unattributed";
+    QString metricName = QString::fromStdString(name).replace(QLatin1String("::"), QLatin1String("."));
+    const uint64_t durationUs = static_cast<uint64_t>(durationMs) * 1000;
+    stallTime.record(durationUs);
+    stalls.add();
+    metrics::histogram(QStringLiteral("ui.stall.%1_us").arg(metricName)).record(durationUs);
+    
+    Offender& offender = m_offenders[name];
+    offender.stalls++;
+    offender.totalMs += durationMs;
+    offender.worstMs = std::max(offender.worstMs, durationMs);
+    
+    spdlog::warn("GUI thread stalled for {} ms in {}", durationMs, name);
+}
+
+void StallWatchdog::logOffenders() const {
+    if (m_offenders.empty()) {
+        spdlog::info("Stall watchdog: no stalls over {} ms", m_thresholdMs);
+        return;
+    }
+    
+    std::vector<std::pair<std::string, Offender>> ranked(m_offenders.begin(), m_offenders.end());
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+        return a.second.totalMs > b.second.totalMs;
+    });
+    
+    spdlog::info("Stall watchdog: worst offenders by stalled time");
+    for (size_t i = 0; i < std::min(ranked.size(), OFFENDERS_LOGGED); ++i) {
+        const auto& [name, offender] = ranked[i];
+        spdlog::info("  {}: {} stalls, {} ms total, worst {} ms", name, offender.stalls,
+                     offender.totalMs, offender.worstMs);
+    }
+}
+
+} // namespace lotro
@@ -0,0 +1,121 @@
+/**
+ * LOTRO Launcher - Stall Watchdog
+ * 
+ * Detects stalls of the GUI thread's event loop and names the code that
+ * held it.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+
+namespace lotro {
+
+namespace stall {
+
+// Innermost StallScope open on the GUI thread; written only by that thread
+extern std::atomic<const char*> currentScope;
+
+// Set on the GUI thread by StallWatchdog::start()
+extern thread_local bool isWatchedThread;
+
+} // namespace stall
+
+/**
+ * Names the GUI-thread work a stall is charged to, for its lifetime
+ * 
+ * Scopes nest; the innermost wins. Off the GUI thread, or with the
+ * watchdog stopped, a scope costs one thread-local read. The name must
+ * be a string literal, conventionally "Class::method".
+ */
+class StallScope {
+public:
+    explicit StallScope(const char* name) {
+        if (stall::isWatchedThread) {
+            m_previous = stall::currentScope.exchange(name, std::memory_order_relaxed);
+            m_active = true;
+        }
+    }
+    
+    ~StallScope() {
+        if (m_active) {
+            stall::currentScope.store(m_previous, std::memory_order_relaxed);
+        }
+    }
+    
+    StallScope(const StallScope&) = delete;
+    StallScope& operator=(const StallScope&) = delete;
+    
+private:
+    const char* m_previous = nullptr;
+    bool m_active = false;
+};
+
+/**
+ * Heartbeats the GUI thread from a background thread
+ * 
+ * Every POLL_MS the watchdog posts a heartbeat to the GUI thread's event
+ * queue. A heartbeat that isn't answered within the threshold is a stall
+ * in progress; while it lasts, the watchdog samples the open StallScope
+ * and charges the whole stall to the first one it saw (or "unattributed").
+ * Each stall is logged and recorded in the metrics registry as
+ * ui.stall_us, ui.stall.<scope>_us and the ui.stalls counter; at stop()
+ * the scopes with the most stalled time are logged. Opt-in through the
+ * stallWatchdog setting.
+ */
+class StallWatchdog {
+public:
+    static StallWatchdog& instance();
+    
+    /**
+     * Start watching; call from the GUI thread once the event loop runs
+     */
+    void start(int thresholdMs = DEFAULT_THRESHOLD_MS);
+    
+    /**
+     * Stop the thread and log the worst offenders
+     */
+    void stop();
+    
+    bool isRunning() const { return m_thread.joinable(); }
+    
+    static constexpr int DEFAULT_THRESHOLD_MS = 50;
+    static constexpr int POLL_MS = 10;
+    
+private:
+    StallWatchdog() = default;
+    ~StallWatchdog();
+    
+    void run();
+    void recordStall(qint64 durationMs, const char* scope);
+    void logOffenders() const;
+    
+    std::thread m_thread;
+    std::atomic<bool> m_stopping{false};
+    int m_thresholdMs = DEFAULT_THRESHOLD_MS;
+    
+    // Heartbeat sequence numbers: sent by the watchdog, echoed by the GUI thread
+    std::atomic<uint64_t> m_sent{0};
+    std::atomic<uint64_t> m_answered{0};
+    QElapsedTimer m_clock;
+    
+    // Stall totals per scope; touched by the watchdog thread, read after it joins
+    struct Offender {
+        uint64_t stalls = 0;
+        qint64 totalMs = 0;
+        qint64 worstMs = 0;
+    };
+    std::map<std::string, Offender> m_offenders;
+    
+    static constexpr size_t OFFENDERS_LOGGED = 5;
+};
+
+} // namespace lotro
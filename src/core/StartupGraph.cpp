@@ -0,0 +1,136 @@
+/**
+ * LOTRO Launcher - Startup Graph Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "StartupGraph.hpp"
+
+#include <QPointer>
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+
+namespace lotro {
+
+StartupGraph::StartupGraph(const QString& name, QObject* parent)
+    : QObject(parent)
+    , m_name(name)
+{
+}
+
+int StartupGraph::indexOf(const QString& name) const {
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void StartupGraph::add(const QString& name, const QStringList& after, Task task) {
+    Node node;
+    node.name = name;
+    node.task = std::move(task);
+    for (const auto& dependency : after) {
+        if (indexOf(dependency) >= 0) {
+            node.after << dependency;
+        } else {
+            spdlog::warn("{}: {} depends on unknown task {}", m_name.toStdString(),
+                         name.toStdString(), dependency.toStdString());
+        }
+    }
+    node.waiting = node.after.size();
+    m_nodes.push_back(std::move(node));
+}
+
+void StartupGraph::start() {
+    m_clock.start();
+    m_remaining = m_nodes.size();
+    if (m_remaining == 0) {
+        emit finished();
+        return;
+    }
+    
+    // Collect first: a task may finish synchronously and release others
+    std::vector<int> ready;
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes[i].waiting == 0) {
+            ready.push_back(static_cast<int>(i));
+        }
+    }
+    for (int index : ready) {
+        run(index);
+    }
+}
+
+void StartupGraph::run(int index) {
+    Node& node = m_nodes[index];
+    node.startedAt = m_clock.elapsed();
+    spdlog::debug("{}: starting {} at {} ms", m_name.toStdString(),
+                  node.name.toStdString(), node.startedAt);
+    
+    QPointer<StartupGraph> self(this);
+    node.task([self, index]() {
+        if (self) {
+            self->complete(index);
+        }
+    });
+}
+
+void StartupGraph::complete(int index) {
+    if (m_nodes[index].finishedAt >= 0) {
+        return;
+    }
+    m_nodes[index].finishedAt = m_clock.elapsed();
+    const QString name = m_nodes[index].name;
+    
+    std::vector<int> ready;
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        Node& node = m_nodes[i];
+        if (node.after.contains(name)) {
+            node.releasedBy = index;
+            if (--node.waiting == 0) {
+                ready.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    for (int next : ready) {
+        run(next);
+    }
+    
+    if (--m_remaining > 0) {
+        return;
+    }
+    
+    m_elapsed = m_clock.elapsed();
+    std::string path;
+    for (const auto& step : criticalPath()) {
+        const Node& node = m_nodes[indexOf(step)];
+        if (!path.empty()) {
+            path += " -> ";
+        }
+        path += step.toStdString() + " " + std::to_string(node.finishedAt - node.startedAt) + " ms";
+    }
+    spdlog::info("{} done in {} ms, critical path: {}", m_name.toStdString(), m_elapsed, path);
+    emit finished();
+}
+
+QStringList StartupGraph::criticalPath() const {
+    int last = -1;
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes[i].finishedAt >= 0 &&
+            (last < 0 || m_nodes[i].finishedAt > m_nodes[last].finishedAt)) {
+            last = static_cast<int>(i);
+        }
+    }
+    
+    QStringList path;
+    for (int index = last; index >= 0; index = m_nodes[index].releasedBy) {
+        path.prepend(m_nodes[index].name);
+    }
+    return path;
+}
+
+} // namespace lotro
@@ -0,0 +1,92 @@
+/**
+ * LOTRO Launcher - Startup Graph
+ * 
+ * Dependency-ordered startup tasks with critical path reporting.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Startup work as a graph of asynchronous tasks
+ * 
+ * Each task is started as soon as everything it depends on has finished,
+ * so independent requests all go out at t=0 and only true dependencies
+ * wait. A task is handed a done callback to call from its continuation;
+ * calling it more than once, or after the graph is gone, is harmless.
+ * 
+ * Once every task is done, finished() is emitted and the critical path -
+ * the chain of tasks that held up the last one to finish - is logged with
+ * each task's duration. Runs on the thread it lives on.
+ */
+class StartupGraph : public QObject {
+    Q_OBJECT
+
+public:
+    using Done = std::function<void()>;
+    using Task = std::function<void(Done done)>;
+    
+    explicit StartupGraph(const QString& name, QObject* parent = nullptr);
+    
+    /**
+     * Add a task, to run after every task named in after
+     * 
+     * Unknown names in after are ignored. Tasks must be added before
+     * start().
+     */
+    void add(const QString& name, const QStringList& after, Task task);
+    
+    /**
+     * Start every task with nothing to wait for
+     */
+    void start();
+    
+    bool isFinished() const { return m_remaining == 0 && m_clock.isValid(); }
+    
+    /**
+     * Milliseconds from start() to the last task finishing
+     */
+    qint64 elapsed() const { return m_elapsed; }
+    
+    /**
+     * Names of the tasks on the critical path, first to last
+     */
+    QStringList criticalPath() const;
+
+signals:
+    void finished();
+
+private:
+    struct Node {
+        QString name;
+        QStringList after;
+        Task task;
+        int waiting = 0;                // Dependencies not yet done
+        int releasedBy = -1;            // Dependency that finished last
+        qint64 startedAt = -1;          // Milliseconds since start()
+        qint64 finishedAt = -1;
+    };
+    
+    int indexOf(const QString& name) const;
+    void run(int index);
+    void complete(int index);
+    
+    QString m_name;
+    std::vector<Node> m_nodes;
+    QElapsedTimer m_clock;
+    size_t m_remaining = 0;
+    qint64 m_elapsed = 0;
+};
+
+} // namespace lotro
@@ -0,0 +1,144 @@
+/**
+ * LOTRO Launcher - Startup Profiler Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "StartupProfiler.hpp"
+
+#include <QEvent>
+#include <QFile>
+#include <QStringList>
+#include <QWidget>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#ifdef PLATFORM_LINUX
+#include <unistd.h>
+#endif
+
+namespace lotro {
+
+namespace {
+
+/**
+ * Milliseconds since the process was started, 0 if unknown
+ */
+qint64 processAgeMs() {
+#ifdef PLATFORM_LINUX
+    QFile statFile("/proc/self/stat");
+    QFile uptimeFile("/proc/uptime");
+    if (!statFile.open(QIODevice::ReadOnly) || !uptimeFile.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    // The command name may hold spaces; the fields after it don't
+    const QByteArray stat = statFile.readAll();
+    const QList<QByteArray> fields = stat.mid(stat.lastIndexOf(')') + 2).split(' ');
+    const double uptime = uptimeFile.readAll().split(' ').value(0).toDouble();
+    const long ticks = sysconf(_SC_CLK_TCK);
+    // starttime is field 22; fields here start at field 3
+    if (fields.size() < 20 || ticks <= 0 || uptime <= 0) {
+        return 0;
+    }
+    const double startedAt = fields[19].toDouble() / ticks;
+    return std::max<qint64>(0, static_cast<qint64>((uptime - startedAt) * 1000));
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Calls back on the first paint of the watched window, then goes away
+ */
+class FirstPaintFilter : public QObject {
+public:
+    FirstPaintFilter(QWidget* window, std::function<void()> onPaint)
+        : QObject(window)
+        , m_onPaint(std::move(onPaint))
+    {
+        window->installEventFilter(this);
+    }
+    
+    bool eventFilter(QObject* watched, QEvent* event) override {
+        if (event->type() == QEvent::Paint && m_onPaint) {
+            watched->removeEventFilter(this);
+            auto onPaint = std::move(m_onPaint);
+            m_onPaint = nullptr;
+            deleteLater();
+            onPaint();
+        }
+        return false;
+    }
+    
+private:
+    std::function<void()> m_onPaint;
+};
+
+} // namespace
+
+StartupProfiler::Span::Span(StartupProfiler& profiler, const QString& name)
+    : m_profiler(profiler)
+{
+    m_index = profiler.m_stages.size();
+    profiler.m_stages.push_back({name, profiler.now(), -1});
+}
+
+void StartupProfiler::Span::end() {
+    Stage& stage = m_profiler.m_stages[m_index];
+    if (stage.durationMs < 0) {
+        stage.durationMs = m_profiler.now() - stage.startMs;
+    }
+}
+
+StartupProfiler& StartupProfiler::instance() {
+    static StartupProfiler profiler;
+    return profiler;
+}
+
+void StartupProfiler::start() {
+    m_clock.start();
+    m_preMainMs = processAgeMs();
+    if (m_preMainMs > 0) {
+        m_stages.push_back({"Before main", 0, m_preMainMs});
+    }
+}
+
+void StartupProfiler::finishOnPaint(QWidget* window, std::function<void()> done) {
+    new FirstPaintFilter(window, [this, done = std::move(done)]() {
+        finish();
+        if (done) {
+            done();
+        }
+    });
+}
+
+void StartupProfiler::finish() {
+    if (isFinished()) {
+        return;
+    }
+    m_totalMs = now();
+    for (auto& stage : m_stages) {
+        if (stage.durationMs < 0) {
+            stage.durationMs = m_totalMs - stage.startMs;
+        }
+    }
+    
+    spdlog::info("Started in {} ms (first paint)", m_totalMs);
+    for (const auto& stage : m_stages) {
+        spdlog::debug("  {}: {} ms", stage.name.toStdString(), stage.durationMs);
+    }
+}
+
+QString StartupProfiler::report() const {
+    QStringList lines;
+    lines << QString("%1 %2  %3").arg("start", 8).arg("ms", 8).arg("stage");
+    for (const auto& stage : m_stages) {
+        lines << QString("%1 %2  %3").arg(stage.startMs, 8).arg(stage.durationMs, 8).arg(stage.name);
+    }
+    lines << QString("%1 %2  %3").arg(m_totalMs, 8).arg("", 8).arg("First paint");
+    return lines.join("\n");
+}
+
+} // namespace lotro
@@ -0,0 +1,92 @@
+/**
+ * LOTRO Launcher - Startup Profiler
+ * 
+ * Timing of application startup, from process start to first paint.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include <functional>
+#include <vector>
+
+class QWidget;
+
+namespace lotro {
+
+/**
+ * Times the stages of startup in main()
+ * 
+ * Times are relative to process start, so the time the loader and static
+ * initializers take before main() shows up as the first stage. Stages are
+ * opened with span() and closed when the guard goes out of scope. The
+ * profile ends at the first paint of the window given to finishOnPaint(),
+ * which is when the launcher looks started to the user; what runs after
+ * that is not part of it. Used from the GUI thread only.
+ */
+class StartupProfiler {
+public:
+    class Span {
+    public:
+        Span(StartupProfiler& profiler, const QString& name);
+        ~Span() { end(); }
+        
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+        
+        void end();
+    
+    private:
+        StartupProfiler& m_profiler;
+        size_t m_index = 0;
+    };
+    
+    static StartupProfiler& instance();
+    
+    /**
+     * Start the clock; first thing in main()
+     */
+    void start();
+    
+    [[nodiscard]] Span span(const QString& name) { return Span(*this, name); }
+    
+    /**
+     * End the profile at the window's first paint, then call done
+     */
+    void finishOnPaint(QWidget* window, std::function<void()> done = {});
+    
+    bool isFinished() const { return m_totalMs >= 0; }
+    
+    /**
+     * Milliseconds from process start to first paint, -1 until then
+     */
+    qint64 totalMs() const { return m_totalMs; }
+    
+    /**
+     * Stages with their start and duration, one per line
+     */
+    QString report() const;
+    
+private:
+    struct Stage {
+        QString name;
+        qint64 startMs = 0;
+        qint64 durationMs = -1;
+    };
+    
+    StartupProfiler() = default;
+    
+    qint64 now() const { return m_preMainMs + m_clock.elapsed(); }
+    void finish();
+    
+    QElapsedTimer m_clock;
+    qint64 m_preMainMs = 0;             // Process start to start()
+    qint64 m_totalMs = -1;
+    std::vector<Stage> m_stages;
+};
+
+} // namespace lotro
@@ -0,0 +1,25 @@
+/**
+ * LOTRO Launcher - Task Scheduler Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "TaskScheduler.hpp"
+
+namespace lotro {
+
+TaskScheduler& TaskScheduler::instance() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler() {
+    m_ioPool.setMaxThreadCount(IO_THREADS);
+    m_ioPool.setObjectName("io");
+}
+
+QThreadPool* TaskScheduler::pool(TaskPool pool) {
+    return pool == TaskPool::Io ? &m_ioPool : QThreadPool::globalInstance();
+}
+
+} // namespace lotro
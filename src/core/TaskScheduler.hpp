@@ -0,0 +1,138 @@
+/**
+ * LOTRO Launcher - Task Scheduler
+ * 
+ * Application-wide thread pools for background work.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QObject>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace lotro {
+
+enum class TaskPool {
+    Io,                 // Network requests and file access; mostly waiting
+    Cpu                 // Parsing, hashing, searching; one thread per core
+};
+
+/**
+ * Order among tasks waiting for a thread of the same pool
+ */
+enum class TaskPriority {
+    Low = -1,           // Prefetching and warming caches
+    Normal = 0,
+    High = 1            // Someone is waiting on the result
+};
+
+/**
+ * Shared flag for abandoning work, copied into every stage that checks it
+ * 
+ * Work already running is not interrupted; long tasks poll isCancelled()
+ * between steps, and stages not yet started are skipped.
+ */
+class CancellationToken {
+public:
+    CancellationToken() : m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+    
+    void cancel() const { *m_cancelled = true; }
+    bool isCancelled() const { return *m_cancelled; }
+    
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+/**
+ * Runs background work on one of two pools
+ * 
+ * I/O work spends its time waiting on sockets and disks, so it gets a
+ * pool of its own with more threads than cores. CPU work stays on Qt's
+ * global pool, sized to the core count. Keeping them apart means a
+ * handful of slow servers can't hold every thread while DAT hashing or
+ * searches wait, and vice versa.
+ * 
+ * Results come back as QFutures. then() continues on a context object's
+ * thread, usually the GUI thread, and is dropped if the context is
+ * destroyed first. Tasks should not block on other tasks of the same
+ * pool; chain them with then() instead.
+ */
+class TaskScheduler {
+public:
+    static TaskScheduler& instance();
+    
+    QThreadPool* pool(TaskPool pool);
+    
+    template<typename Fn>
+    auto run(TaskPool pool, Fn&& fn, TaskPriority priority = TaskPriority::Normal) {
+        return QtConcurrent::task(std::forward<Fn>(fn))
+            .onThreadPool(*this->pool(pool))
+            .withPriority(static_cast<int>(priority))
+            .spawn();
+    }
+    
+    /**
+     * Run fn unless the token is cancelled by the time a thread is free;
+     * a skipped task yields a default-constructed result
+     */
+    template<typename Fn>
+    auto run(TaskPool pool, const CancellationToken& token, Fn&& fn,
+             TaskPriority priority = TaskPriority::Normal) {
+        using Result = std::invoke_result_t<std::decay_t<Fn>>;
+        return run(pool, [token, fn = std::forward<Fn>(fn)]() mutable -> Result {
+            if (token.isCancelled()) {
+                if constexpr (std::is_void_v<Result>) {
+                    return;
+                } else {
+                    return Result{};
+                }
+            }
+            return fn();
+        }, priority);
+    }
+    
+    /**
+     * Continue with the future's result on the context's thread
+     */
+    template<typename T, typename Fn>
+    static auto then(QFuture<T> future, QObject* context, Fn&& fn) {
+        return future.then(context, std::forward<Fn>(fn));
+    }
+    
+    /**
+     * Like then(), but skipped if the token has been cancelled meanwhile
+     */
+    template<typename T, typename Fn>
+    static auto then(QFuture<T> future, QObject* context, const CancellationToken& token, Fn&& fn) {
+        if constexpr (std::is_void_v<T>) {
+            return future.then(context, [token, fn = std::forward<Fn>(fn)]() mutable {
+                if (!token.isCancelled()) {
+                    fn();
+                }
+            });
+        } else {
+            return future.then(context, [token, fn = std::forward<Fn>(fn)](T result) mutable {
+                if (!token.isCancelled()) {
+                    fn(std::move(result));
+                }
+            });
+        }
+    }
+    
+    static constexpr int IO_THREADS = 16;
+    
+private:
+    TaskScheduler();
+    
+    QThreadPool m_ioPool;
+};
+
+} // namespace lotro
@@ -7,6 +7,13 @@
 #include "ConfigManager.hpp"
 #include "GameConfig.hpp"
 
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTimer>
+#include <QtConcurrent>
+
 #include <fstream>
 
 #include <spdlog/spdlog.h>
@@ -17,6 +24,117 @@ namespace lotro {
 namespace {
     constexpr const char* PROGRAM_CONFIG_FILE = "config.json";
     constexpr const char* GAMES_DIR = "games";
+    constexpr const char* GAME_CONFIG_FILE = "config.json";
+    constexpr const char* ACCOUNTS_FILE = "accounts.json";
+    constexpr const char* WINE_CONFIG_FILE = "wine.json";
+    
+    struct PendingWrite {
+        std::filesystem::path path;
+        std::string content;
+        bool remove = false;            // Delete the file instead
+    };
+    
+    /**
+     * Everything read from one game's directory
+     */
+    struct LoadedGame {
+        std::string id;
+        std::optional<GameConfig> config;
+        std::vector<AccountConfig> accounts;
+#ifdef PLATFORM_LINUX
+        std::optional<WineConfig> wineConfig;
+#endif
+    };
+    
+    std::optional<std::string> readFile(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+        return std::string((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+    }
+    
+    LoadedGame loadGame(const std::filesystem::path& gameDir) {
+        LoadedGame game;
+        game.id = gameDir.filename().string();
+        
+        // Load game config
+        if (auto content = readFile(gameDir / GAME_CONFIG_FILE)) {
+            auto config = GameConfig::fromJson(*content);
+            if (!config.gameDirectory.empty()) {
+                config.id = game.id;
+                game.config = config;
+                spdlog::debug("Loaded game config: {} ({})", 
+                             game.id, config.gameDirectory.string());
+            } else {
+                spdlog::warn("Game config {} has empty game directory", game.id);
+            }
+        }
+        
+        // Load account configs
+        if (auto content = readFile(gameDir / ACCOUNTS_FILE)) {
+            try {
+                nlohmann::json j = nlohmann::json::parse(*content);
+                if (j.is_array()) {
+                    for (const auto& accountJson : j) {
+                        auto account = AccountConfig::fromJson(accountJson.dump());
+                        if (!account.username.empty()) {
+                            game.accounts.push_back(account);
+                        }
+                    }
+                }
+                spdlog::debug("Loaded {} accounts for game: {}", 
+                             game.accounts.size(), game.id);
+            } catch (const std::exception& e) {
+                spdlog::warn("Failed to parse accounts.json for {}: {}", 
+                            game.id, e.what());
+            }
+        }
+        
+#ifdef PLATFORM_LINUX
+        if (auto content = readFile(gameDir / WINE_CONFIG_FILE)) {
+            game.wineConfig = WineConfig::fromJson(*content);
+        }
+#endif
+        return game;
+    }
+    
+    /**
+     * Runs on the writer thread. Each file goes through QSaveFile, which
+     * writes a temporary file and renames it over the old one.
+     */
+    bool writeFiles(const std::vector<PendingWrite>& writes) {
+        bool ok = true;
+        for (const auto& write : writes) {
+            const QString path = QString::fromStdString(write.path.string());
+            if (write.remove) {
+                if (QFile::exists(path) && !QFile::remove(path)) {
+                    spdlog::error("Failed to remove {}", write.path.string());
+                    ok = false;
+                }
+                continue;
+            }
+            
+            QDir().mkpath(QFileInfo(path).absolutePath());
+            QSaveFile file(path);
+            if (!file.open(QIODevice::WriteOnly)) {
+                spdlog::error("Failed to write {}: {}", write.path.string(),
+                              file.errorString().toStdString());
+                ok = false;
+                continue;
+            }
+            file.write(write.content.data(), static_cast<qint64>(write.content.size()));
+            if (!file.commit()) {
+                spdlog::error("Failed to commit {}: {}", write.path.string(),
+                              file.errorString().toStdString());
+                ok = false;
+                continue;
+            }
+            spdlog::debug("Saved {}", write.path.string());
+        }
+        return ok;
+    }
 }
 
 ConfigManager& ConfigManager::instance() {
@@ -24,6 +142,20 @@ ConfigManager& ConfigManager::instance() {
     return instance;
 }
 
+ConfigManager::ConfigManager() {
+    m_writer.setMaxThreadCount(1);
+}
+
+ConfigManager::~ConfigManager() {
+    // Changes still inside the debounce window are written here, since
+    // only the GUI's close handler calls save(). The queued writes go
+    // first so the last change lands last.
+    m_writer.waitForDone();
+    if (m_programDirty || !m_dirty.empty()) {
+        flushDirty(true);
+    }
+}
+
 bool ConfigManager::initialize(const std::filesystem::path& configDirectory) {
     m_configDirectory = configDirectory;
     m_gamesDirectory = configDirectory / GAMES_DIR;
@@ -50,17 +182,29 @@ bool ConfigManager::initialize(const std::filesystem::path& configDirectory) {
         }
     }
     
+    // Restarted by every change, so a burst of setters becomes one write
+    m_saveTimer = std::make_unique<QTimer>();
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SAVE_DELAY_MS);
+    QObject::connect(m_saveTimer.get(), &QTimer::timeout, [this]() { flushDirty(); });
+    
     spdlog::info("ConfigManager initialized at: {}", m_configDirectory.string());
     return true;
 }
 
 bool ConfigManager::save() {
-    return saveProgramConfig() && saveGameConfigs();
+    // The first save creates config.json, which marks setup as done
+    if (!std::filesystem::exists(m_configDirectory / PROGRAM_CONFIG_FILE)) {
+        m_programDirty = true;
+    }
+    flushDirty();
+    m_writer.waitForDone();
+    return !m_writeFailed.exchange(false);
 }
 
 void ConfigManager::setProgramConfig(const ProgramConfig& config) {
     m_programConfig = config;
-    saveProgramConfig();
+    markProgramDirty();
 }
 
 std::vector<std::string> ConfigManager::getGameIds() const {
@@ -82,12 +226,12 @@ std::optional<GameConfig> ConfigManager::getGameConfig(const std::string& gameId
 
 void ConfigManager::setGameConfig(const std::string& gameId, const GameConfig& config) {
     m_gameConfigs[gameId] = config;
-    saveGameConfigs();
+    markDirty(gameId, ConfigFile::Game);
 }
 
 void ConfigManager::removeGameConfig(const std::string& gameId) {
     m_gameConfigs.erase(gameId);
-    saveGameConfigs();
+    markDirty(gameId, ConfigFile::Game);
 }
 
 std::vector<AccountConfig> ConfigManager::getAccounts(const std::string& gameId) const {
@@ -100,7 +244,7 @@ std::vector<AccountConfig> ConfigManager::getAccounts(const std::string& gameId)
 
 void ConfigManager::setAccounts(const std::string& gameId, const std::vector<AccountConfig>& accounts) {
     m_accountConfigs[gameId] = accounts;
-    saveGameConfigs();
+    markDirty(gameId, ConfigFile::Accounts);
 }
 
 void ConfigManager::addAccount(const std::string& gameId, const AccountConfig& account) {
@@ -113,7 +257,7 @@ void ConfigManager::addAccount(const std::string& gameId, const AccountConfig& a
     } else {
         accounts.push_back(account);
     }
-    saveGameConfigs();
+    markDirty(gameId, ConfigFile::Accounts);
 }
 
 void ConfigManager::removeAccount(const std::string& gameId, const std::string& username) {
@@ -127,7 +271,7 @@ void ConfigManager::removeAccount(const std::string& gameId, const std::string&
                 }),
             accounts.end()
         );
-        saveGameConfigs();
+        markDirty(gameId, ConfigFile::Accounts);
     }
 }
 
@@ -142,7 +286,7 @@ std::optional<WineConfig> ConfigManager::getWineConfig(const std::string& gameId
 
 void ConfigManager::setWineConfig(const std::string& gameId, const WineConfig& config) {
     m_wineConfigs[gameId] = config;
-    saveGameConfigs();
+    markDirty(gameId, ConfigFile::Wine);
 }
 #endif
 
@@ -172,10 +316,61 @@ bool ConfigManager::loadProgramConfig() {
         if (j.contains("logVerbosity")) {
             m_programConfig.logVerbosity = j["logVerbosity"].get<std::string>();
         }
+        if (j.contains("liveSyncMinIntervalMs")) {
+            m_programConfig.liveSyncMinIntervalMs = j["liveSyncMinIntervalMs"].get<int>();
+        }
+        if (j.contains("liveSyncMaxIntervalMs")) {
+            m_programConfig.liveSyncMaxIntervalMs = j["liveSyncMaxIntervalMs"].get<int>();
+        }
+        if (j.contains("liveSyncSaveDelayMs")) {
+            m_programConfig.liveSyncSaveDelayMs = j["liveSyncSaveDelayMs"].get<int>();
+        }
+        if (j.contains("liveSyncDirtyTracking")) {
+            m_programConfig.liveSyncDirtyTracking = j["liveSyncDirtyTracking"].get<bool>();
+        }
+        if (j.contains("liveFeedEnabled")) {
+            m_programConfig.liveFeedEnabled = j["liveFeedEnabled"].get<bool>();
+        }
+        if (j.contains("downloadLimitKBps")) {
+            m_programConfig.downloadLimitKBps = j["downloadLimitKBps"].get<int>();
+        }
+        if (j.contains("sortWorldsByLatency")) {
+            m_programConfig.sortWorldsByLatency = j["sortWorldsByLatency"].get<bool>();
+        }
+        if (j.contains("autoSelectFastestWorld")) {
+            m_programConfig.autoSelectFastestWorld = j["autoSelectFastestWorld"].get<bool>();
+        }
+        if (j.contains("addonUpdateConcurrency")) {
+            m_programConfig.addonUpdateConcurrency = j["addonUpdateConcurrency"].get<int>();
+        }
+        if (j.contains("runStartupScripts")) {
+            m_programConfig.runStartupScripts = j["runStartupScripts"].get<bool>();
+        }
+        if (j.contains("prewarmDatFiles")) {
+            m_programConfig.prewarmDatFiles = j["prewarmDatFiles"].get<bool>();
+        }
+        if (j.contains("prewarmRateMBps")) {
+            m_programConfig.prewarmRateMBps = j["prewarmRateMBps"].get<int>();
+        }
+        if (j.contains("preloadCompanionData")) {
+            m_programConfig.preloadCompanionData = j["preloadCompanionData"].get<bool>();
+        }
+        if (j.contains("gameDatabaseFromDat")) {
+            m_programConfig.gameDatabaseFromDat = j["gameDatabaseFromDat"].get<bool>();
+        }
+        if (j.contains("stallWatchdog")) {
+            m_programConfig.stallWatchdog = j["stallWatchdog"].get<bool>();
+        }
+        if (j.contains("stallThresholdMs")) {
+            m_programConfig.stallThresholdMs = j["stallThresholdMs"].get<int>();
+        }
 #ifdef PLATFORM_LINUX
         if (j.contains("steamIntegrationEnabled")) {
             m_programConfig.steamIntegrationEnabled = j["steamIntegrationEnabled"].get<bool>();
         }
+        if (j.contains("wineserverWarmStart")) {
+            m_programConfig.wineserverWarmStart = j["wineserverWarmStart"].get<bool>();
+        }
 #endif
         
         return true;
@@ -185,136 +380,144 @@ bool ConfigManager::loadProgramConfig() {
     }
 }
 
-bool ConfigManager::saveProgramConfig() {
-    auto configPath = m_configDirectory / PROGRAM_CONFIG_FILE;
-    
-    try {
-        nlohmann::json j;
-        j["defaultLocale"] = m_programConfig.defaultLocale;
-        j["alwaysUseDefaultLocaleForUI"] = m_programConfig.alwaysUseDefaultLocaleForUI;
-        j["gamesSortingMode"] = m_programConfig.gamesSortingMode;
-        j["onGameStart"] = m_programConfig.onGameStart;
-        j["logVerbosity"] = m_programConfig.logVerbosity;
+std::string ConfigManager::programConfigJson() const {
+    nlohmann::json j;
+    j["defaultLocale"] = m_programConfig.defaultLocale;
+    j["alwaysUseDefaultLocaleForUI"] = m_programConfig.alwaysUseDefaultLocaleForUI;
+    j["gamesSortingMode"] = m_programConfig.gamesSortingMode;
+    j["onGameStart"] = m_programConfig.onGameStart;
+    j["logVerbosity"] = m_programConfig.logVerbosity;
+    j["liveSyncMinIntervalMs"] = m_programConfig.liveSyncMinIntervalMs;
+    j["liveSyncMaxIntervalMs"] = m_programConfig.liveSyncMaxIntervalMs;
+    j["liveSyncSaveDelayMs"] = m_programConfig.liveSyncSaveDelayMs;
+    j["liveSyncDirtyTracking"] = m_programConfig.liveSyncDirtyTracking;
+    j["liveFeedEnabled"] = m_programConfig.liveFeedEnabled;
+    j["downloadLimitKBps"] = m_programConfig.downloadLimitKBps;
+    j["sortWorldsByLatency"] = m_programConfig.sortWorldsByLatency;
+    j["autoSelectFastestWorld"] = m_programConfig.autoSelectFastestWorld;
+    j["addonUpdateConcurrency"] = m_programConfig.addonUpdateConcurrency;
+    j["runStartupScripts"] = m_programConfig.runStartupScripts;
+    j["prewarmDatFiles"] = m_programConfig.prewarmDatFiles;
+    j["prewarmRateMBps"] = m_programConfig.prewarmRateMBps;
+    j["preloadCompanionData"] = m_programConfig.preloadCompanionData;
+    j["gameDatabaseFromDat"] = m_programConfig.gameDatabaseFromDat;
+    j["stallWatchdog"] = m_programConfig.stallWatchdog;
+    j["stallThresholdMs"] = m_programConfig.stallThresholdMs;
 #ifdef PLATFORM_LINUX
-        j["steamIntegrationEnabled"] = m_programConfig.steamIntegrationEnabled;
+    j["steamIntegrationEnabled"] = m_programConfig.steamIntegrationEnabled;
+    j["wineserverWarmStart"] = m_programConfig.wineserverWarmStart;
 #endif
-        
-        std::ofstream file(configPath);
-        file << j.dump(2);
-        
-        return true;
-    } catch (const std::exception& e) {
-        spdlog::error("Failed to save program config: {}", e.what());
-        return false;
-    }
+    return j.dump(2);
 }
 
 bool ConfigManager::loadGameConfigs() {
-    // Load each game config from games directory
+    QList<std::filesystem::path> gameDirs;
     try {
         for (const auto& entry : std::filesystem::directory_iterator(m_gamesDirectory)) {
             if (entry.is_directory()) {
-                auto gameId = entry.path().filename().string();
-                
-                // Load game config
-                auto configFile = entry.path() / "config.json";
-                if (std::filesystem::exists(configFile)) {
-                    std::ifstream file(configFile);
-                    if (file.is_open()) {
-                        std::string content((std::istreambuf_iterator<char>(file)),
-                                            std::istreambuf_iterator<char>());
-                        
-                        auto config = GameConfig::fromJson(content);
-                        if (!config.gameDirectory.empty()) {
-                            config.id = gameId;
-                            m_gameConfigs[gameId] = config;
-                            spdlog::debug("Loaded game config: {} ({})", 
-                                         gameId, config.gameDirectory.string());
-                        } else {
-                            spdlog::warn("Game config {} has empty game directory", gameId);
-                        }
-                    }
-                }
-                
-                // Load account configs
-                auto accountsFile = entry.path() / "accounts.json";
-                if (std::filesystem::exists(accountsFile)) {
-                    std::ifstream file(accountsFile);
-                    if (file.is_open()) {
-                        try {
-                            nlohmann::json j = nlohmann::json::parse(file);
-                            std::vector<AccountConfig> accounts;
-                            
-                            if (j.is_array()) {
-                                for (const auto& accountJson : j) {
-                                    auto account = AccountConfig::fromJson(accountJson.dump());
-                                    if (!account.username.empty()) {
-                                        accounts.push_back(account);
-                                    }
-                                }
-                            }
-                            
-                            if (!accounts.empty()) {
-                                m_accountConfigs[gameId] = accounts;
-                                spdlog::debug("Loaded {} accounts for game: {}", 
-                                             accounts.size(), gameId);
-                            }
-                        } catch (const std::exception& e) {
-                            spdlog::warn("Failed to parse accounts.json for {}: {}", 
-                                        gameId, e.what());
-                        }
-                    }
-                }
+                gameDirs.append(entry.path());
             }
         }
-        return true;
     } catch (const std::exception& e) {
         spdlog::error("Failed to load game configs: {}", e.what());
         return false;
     }
+    
+    // A handful of small files per game; reading the games side by side
+    // hides the latency of a cold disk or a network home directory
+    const QList<LoadedGame> games = QtConcurrent::blockingMapped(gameDirs, loadGame);
+    for (const auto& game : games) {
+        if (game.config) {
+            m_gameConfigs[game.id] = *game.config;
+        }
+        if (!game.accounts.empty()) {
+            m_accountConfigs[game.id] = game.accounts;
+        }
+#ifdef PLATFORM_LINUX
+        if (game.wineConfig) {
+            m_wineConfigs[game.id] = *game.wineConfig;
+        }
+#endif
+    }
+    return true;
+}
+
+void ConfigManager::markDirty(const std::string& gameId, ConfigFile file) {
+    m_dirty.insert({gameId, file});
+    if (m_saveTimer) {
+        m_saveTimer->start();
+    }
+}
+
+void ConfigManager::markProgramDirty() {
+    m_programDirty = true;
+    if (m_saveTimer) {
+        m_saveTimer->start();
+    }
 }
 
-bool ConfigManager::saveGameConfigs() {
+void ConfigManager::flushDirty(bool onThisThread) {
+    if (m_saveTimer) {
+        m_saveTimer->stop();
+    }
+    
+    // Serialized here so the writer never touches the maps
+    std::vector<PendingWrite> writes;
     try {
-        for (const auto& [gameId, config] : m_gameConfigs) {
-            auto gameDir = m_gamesDirectory / gameId;
-            std::filesystem::create_directories(gameDir);
-            
-            // Save game config
-            auto configFile = gameDir / "config.json";
-            std::ofstream file(configFile);
-            file << config.toJson();
-            
-            spdlog::debug("Saved game config: {} -> {}", gameId, configFile.string());
+        if (m_programDirty) {
+            writes.push_back({m_configDirectory / PROGRAM_CONFIG_FILE, programConfigJson()});
         }
-        
-        // Save account configs (includes games that might not have a game config yet)
-        for (const auto& [gameId, accounts] : m_accountConfigs) {
-            if (accounts.empty()) {
-                continue;
+        for (const auto& [gameId, file] : m_dirty) {
+            const auto gameDir = m_gamesDirectory / gameId;
+            switch (file) {
+            case ConfigFile::Game: {
+                auto it = m_gameConfigs.find(gameId);
+                if (it != m_gameConfigs.end()) {
+                    writes.push_back({gameDir / GAME_CONFIG_FILE, it->second.toJson()});
+                } else {
+                    writes.push_back({gameDir / GAME_CONFIG_FILE, {}, true});
+                }
+                break;
             }
-            
-            auto gameDir = m_gamesDirectory / gameId;
-            std::filesystem::create_directories(gameDir);
-            
-            nlohmann::json accountsJson = nlohmann::json::array();
-            for (const auto& account : accounts) {
-                accountsJson.push_back(nlohmann::json::parse(account.toJson()));
+            case ConfigFile::Accounts: {
+                // Written even when empty, so removing the last account sticks
+                nlohmann::json accountsJson = nlohmann::json::array();
+                for (const auto& account : getAccounts(gameId)) {
+                    accountsJson.push_back(nlohmann::json::parse(account.toJson()));
+                }
+                writes.push_back({gameDir / ACCOUNTS_FILE, accountsJson.dump(2)});
+                break;
+            }
+            case ConfigFile::Wine:
+#ifdef PLATFORM_LINUX
+                if (auto it = m_wineConfigs.find(gameId); it != m_wineConfigs.end()) {
+                    writes.push_back({gameDir / WINE_CONFIG_FILE, it->second.toJson()});
+                }
+#endif
+                break;
             }
-            
-            auto accountsFile = gameDir / "accounts.json";
-            std::ofstream file(accountsFile);
-            file << accountsJson.dump(2);
-            
-            spdlog::debug("Saved {} accounts for game: {} -> {}", 
-                         accounts.size(), gameId, accountsFile.string());
         }
-        
-        return true;
     } catch (const std::exception& e) {
-        spdlog::error("Failed to save game configs: {}", e.what());
-        return false;
+        spdlog::error("Failed to serialize configuration: {}", e.what());
+        m_writeFailed = true;
+    }
+    m_programDirty = false;
+    m_dirty.clear();
+    
+    if (writes.empty()) {
+        return;
     }
+    if (onThisThread) {
+        if (!writeFiles(writes)) {
+            m_writeFailed = true;
+        }
+        return;
+    }
+    m_writer.start([this, writes = std::move(writes)]() {
+        if (!writeFiles(writes)) {
+            m_writeFailed = true;
+        }
+    });
 }
 
 } // namespace lotro
@@ -8,10 +8,16 @@
 
 #pragma once
 
+#include <QThreadPool>
+
+#include <atomic>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -20,6 +26,8 @@
 #include "AccountConfig.hpp"
 #include "WineConfig.hpp"
 
+class QTimer;
+
 namespace lotro {
 
 /**
@@ -31,8 +39,25 @@ struct ProgramConfig {
     std::string gamesSortingMode = "last-played";  // priority, last-played, alphabetical
     std::string onGameStart = "stay";              // stay, close
     std::string logVerbosity = "info";             // debug, info, warning, error
+    int liveSyncMinIntervalMs = 2000;              // Sync cadence while the character changes
+    int liveSyncMaxIntervalMs = 60000;             // Backed-off cadence while idle
+    int liveSyncSaveDelayMs = 10000;               // Autosave coalescing window
+    bool liveSyncDirtyTracking = false;            // Refetch only written pages (Linux soft-dirty)
+    bool liveFeedEnabled = false;                  // Publish the synced character to shared memory
+    int downloadLimitKBps = 0;                     // Shared cap on patch downloads, 0 for none
+    bool sortWorldsByLatency = false;              // Nearest servers first in the list
+    bool autoSelectFastestWorld = true;            // For accounts with no last used world
+    int addonUpdateConcurrency = 4;                // Addons updated at once by Update All
+    bool runStartupScripts = false;                // Run installed plugins' startup scripts at launch
+    bool prewarmDatFiles = false;                  // Read hot DAT regions into the page cache before launch
+    int prewarmRateMBps = 0;                       // Prewarm read rate, 0 to suit the disk
+    bool preloadCompanionData = true;              // Load the companion's databases once the launcher is idle
+    bool gameDatabaseFromDat = true;               // Extract deeds, titles, emotes and skills from the game's DAT
+    bool stallWatchdog = false;                    // Log GUI thread stalls and the code that caused them
+    int stallThresholdMs = 50;                     // Shortest stall the watchdog reports
 #ifdef PLATFORM_LINUX
     bool steamIntegrationEnabled = true;           // Show as playing in Steam
+    bool wineserverWarmStart = true;               // Start the prefix's wineserver with the launcher
 #endif
 };
 
@@ -41,6 +66,11 @@ struct ProgramConfig {
  * 
  * Handles loading, saving, and providing access to all configuration data.
  * Based on OneLauncher's config_manager.py
+ * 
+ * Setters only mark the files they touch as dirty. Dirty files are written
+ * in one batch shortly after the last change, on a background thread and
+ * through an atomic rename, so a crash never leaves a half-written file.
+ * Setters must be called from the GUI thread.
  */
 class ConfigManager {
 public:
@@ -48,6 +78,11 @@ public:
     
     // Lifecycle
     bool initialize(const std::filesystem::path& configDirectory);
+    
+    /**
+     * Write everything still pending and wait for it; for shutdown and
+     * for callers that need the files on disk now
+     */
     bool save();
     
     // State queries
@@ -78,15 +113,25 @@ public:
 #endif
 
 private:
-    ConfigManager() = default;
-    ~ConfigManager() = default;
+    enum class ConfigFile { Game, Accounts, Wine };
+    
+    ConfigManager();
+    ~ConfigManager();
     ConfigManager(const ConfigManager&) = delete;
     ConfigManager& operator=(const ConfigManager&) = delete;
     
     bool loadProgramConfig();
-    bool saveProgramConfig();
+    std::string programConfigJson() const;
     bool loadGameConfigs();
-    bool saveGameConfigs();
+    
+    void markDirty(const std::string& gameId, ConfigFile file);
+    void markProgramDirty();
+    
+    /**
+     * Serialize the dirty files and queue them for the writer thread, or
+     * write them on the calling thread when it is shutting down
+     */
+    void flushDirty(bool onThisThread = false);
     
     std::filesystem::path m_configDirectory;
     std::filesystem::path m_gamesDirectory;
@@ -99,6 +144,14 @@ private:
 #ifdef PLATFORM_LINUX
     std::map<std::string, WineConfig> m_wineConfigs;
 #endif
+    
+    bool m_programDirty = false;
+    std::set<std::pair<std::string, ConfigFile>> m_dirty;
+    std::unique_ptr<QTimer> m_saveTimer;
+    QThreadPool m_writer;                   // One thread, so batches land in order
+    std::atomic<bool> m_writeFailed{false};
+    
+    static constexpr int SAVE_DELAY_MS = 500;
 };
 
 } // namespace lotro
@@ -42,6 +42,9 @@ WineConfig WineConfig::fromJson(const std::string& json) {
         if (j.contains("fsyncEnabled")) {
             config.fsyncEnabled = j["fsyncEnabled"].get<bool>();
         }
+        if (j.contains("launchProfile")) {
+            config.launchProfile = j["launchProfile"].get<std::string>();
+        }
         
     } catch (const std::exception& e) {
         // Return default on error
@@ -61,6 +64,7 @@ std::string WineConfig::toJson() const {
     j["dxvkVersion"] = dxvkVersion;
     j["esyncEnabled"] = esyncEnabled;
     j["fsyncEnabled"] = fsyncEnabled;
+    j["launchProfile"] = launchProfile;
     
     return j.dump(2);
 }
@@ -49,6 +49,7 @@ struct WineConfig {
     // Performance tweaks
     bool esyncEnabled = true;
     bool fsyncEnabled = true;
+    std::string launchProfile = "Default";       // Name of a LaunchProfile
     
     // Serialization
     static WineConfig fromJson(const std::string& json);
@@ -6,10 +6,46 @@
 
 #include "CredentialStore.hpp"
 
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+#include <QtConcurrent>
+
 #include <spdlog/spdlog.h>
 
 namespace lotro {
 
+namespace {
+
+/**
+ * Wraps a callback so that calling the wrapper once, from any thread, runs
+ * it on the context's thread if the context still exists by then. Create
+ * it on the context's thread.
+ * 
+ * The call is posted to a relay object of our own rather than to the
+ * context, which another thread could destroy between a check and the
+ * post; the context is only checked on its own thread.
+ */
+template<typename T>
+std::function<void(T)> onContextThread(QObject* context, std::function<void(T)> done) {
+    if (!done || !context) {
+        return [](T) {};
+    }
+    QPointer<QObject> guard(context);
+    QObject* relay = new QObject();
+    relay->moveToThread(context->thread());
+    return [guard, relay, done = std::move(done)](T result) {
+        QMetaObject::invokeMethod(relay, [guard, relay, done, result = std::move(result)]() {
+            if (guard) {
+                done(result);
+            }
+            relay->deleteLater();
+        }, Qt::QueuedConnection);
+    };
+}
+
+} // namespace
+
 // Factory method - creates platform-appropriate implementation
 std::unique_ptr<CredentialStore> CredentialStore::create() {
 #ifdef PLATFORM_LINUX
@@ -28,4 +64,183 @@ std::unique_ptr<CredentialStore> CredentialStore::create() {
 #endif
 }
 
+CredentialStore::CredentialStore()
+    : m_cache(std::make_shared<Cache>())
+{
+    // Keyring calls are serialized by the keyring anyway
+    m_pool.setMaxThreadCount(1);
+}
+
+void CredentialStore::waitForPending() {
+    m_pool.waitForDone();
+}
+
+std::string CredentialStore::cacheKey(const std::string& service, const std::string& username) {
+    return service + '\n' + username;
+}
+
+uint64_t CredentialStore::Cache::generation(const std::string& key) {
+    std::lock_guard lock(mutex);
+    auto it = generations.find(key);
+    return it == generations.end() ? 0 : it->second;
+}
+
+std::optional<std::string> CredentialStore::Cache::get(const std::string& key) {
+    std::lock_guard lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return std::nullopt;
+    }
+    if (it->second.expires < std::chrono::steady_clock::now()) {
+        entries.erase(it);
+        return std::nullopt;
+    }
+    return it->second.password;
+}
+
+void CredentialStore::Cache::put(const std::string& key, std::string password) {
+    std::lock_guard lock(mutex);
+    entries[key] = {std::move(password), std::chrono::steady_clock::now() + CACHE_TTL};
+}
+
+void CredentialStore::Cache::putIfCurrent(const std::string& key, std::string password, uint64_t since) {
+    std::lock_guard lock(mutex);
+    auto it = generations.find(key);
+    if ((it == generations.end() ? 0 : it->second) != since) {
+        return;
+    }
+    entries[key] = {std::move(password), std::chrono::steady_clock::now() + CACHE_TTL};
+}
+
+void CredentialStore::Cache::erase(const std::string& key) {
+    std::lock_guard lock(mutex);
+    entries.erase(key);
+    ++generations[key];
+}
+
+bool CredentialStore::storePassword(
+    const std::string& service,
+    const std::string& username,
+    const std::string& password
+) {
+    const bool stored = writeSecret(service, username, password);
+    if (stored) {
+        m_cache->put(cacheKey(service, username), password);
+    } else {
+        m_cache->erase(cacheKey(service, username));
+    }
+    return stored;
+}
+
+std::optional<std::string> CredentialStore::getPassword(
+    const std::string& service,
+    const std::string& username
+) {
+    const std::string key = cacheKey(service, username);
+    if (auto cached = m_cache->get(key)) {
+        return cached;
+    }
+    const uint64_t generation = m_cache->generation(key);
+    auto password = readSecret(service, username);
+    if (password) {
+        m_cache->putIfCurrent(key, *password, generation);
+    }
+    return password;
+}
+
+bool CredentialStore::deletePassword(
+    const std::string& service,
+    const std::string& username
+) {
+    m_cache->erase(cacheKey(service, username));
+    return clearSecret(service, username);
+}
+
+void CredentialStore::getPasswordAsync(
+    const std::string& service,
+    const std::string& username,
+    QObject* context,
+    PasswordCallback done
+) {
+    auto deliver = onContextThread(context, std::move(done));
+    const std::string key = cacheKey(service, username);
+    if (auto cached = m_cache->get(key)) {
+        deliver(std::move(cached));
+        return;
+    }
+    // A delete issued while this read is in flight wins over its result
+    const uint64_t generation = m_cache->generation(key);
+    readSecretAsync(service, username,
+        [cache = m_cache, key, generation, deliver](std::optional<std::string> password) {
+            if (password) {
+                cache->putIfCurrent(key, *password, generation);
+            }
+            deliver(std::move(password));
+        });
+}
+
+void CredentialStore::storePasswordAsync(
+    const std::string& service,
+    const std::string& username,
+    const std::string& password,
+    QObject* context,
+    ResultCallback done
+) {
+    auto deliver = onContextThread(context, std::move(done));
+    const std::string key = cacheKey(service, username);
+    // Lookups made while the write is in flight see the new password
+    m_cache->put(key, password);
+    writeSecretAsync(service, username, password,
+        [cache = m_cache, key, deliver](bool stored) {
+            if (!stored) {
+                cache->erase(key);
+            }
+            deliver(stored);
+        });
+}
+
+void CredentialStore::deletePasswordAsync(
+    const std::string& service,
+    const std::string& username,
+    QObject* context,
+    ResultCallback done
+) {
+    auto deliver = onContextThread(context, std::move(done));
+    m_cache->erase(cacheKey(service, username));
+    clearSecretAsync(service, username, [deliver](bool deleted) {
+        deliver(deleted);
+    });
+}
+
+void CredentialStore::readSecretAsync(
+    const std::string& service,
+    const std::string& username,
+    PasswordCallback done
+) {
+    QtConcurrent::run(&m_pool, [this, service, username, done]() {
+        done(readSecret(service, username));
+    });
+}
+
+void CredentialStore::writeSecretAsync(
+    const std::string& service,
+    const std::string& username,
+    const std::string& password,
+    ResultCallback done
+) {
+    QtConcurrent::run(&m_pool, [this, service, username, password, done]() {
+        done(writeSecret(service, username, password));
+    });
+}
+
+void CredentialStore::clearSecretAsync(
+    const std::string& service,
+    const std::string& username,
+    ResultCallback done
+) {
+    QtConcurrent::run(&m_pool, [this, service, username, done]() {
+        done(clearSecret(service, username));
+    });
+}
+
 } // namespace lotro
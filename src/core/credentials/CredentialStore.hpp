@@ -8,10 +8,19 @@
 
 #pragma once
 
+#include <QThreadPool>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 
+class QObject;
+
 namespace lotro {
 
 /**
@@ -20,9 +29,20 @@ namespace lotro {
  * Implementations:
  * - LibSecretStore (Linux): Uses libsecret/gnome-keyring/kwallet
  * - WindowsCredentialStore (Windows): Uses Windows Credential Manager
+ * 
+ * Passwords found or stored are remembered in memory for CACHE_TTL, so
+ * switching between accounts doesn't go back to the keyring. A lookup
+ * that finds nothing isn't remembered, since the keyring may simply have
+ * been locked or unavailable at the time. The async
+ * variants never block the caller: they deliver the result on the
+ * context object's thread, and not at all if the context is destroyed
+ * first. The blocking variants are for worker threads.
  */
 class CredentialStore {
 public:
+    using PasswordCallback = std::function<void(std::optional<std::string>)>;
+    using ResultCallback = std::function<void(bool)>;
+    
     virtual ~CredentialStore() = default;
     
     /**
@@ -33,11 +53,11 @@ public:
      * @param password The password to store
      * @return true if stored successfully
      */
-    virtual bool storePassword(
+    bool storePassword(
         const std::string& service,
         const std::string& username,
         const std::string& password
-    ) = 0;
+    );
     
     /**
      * Retrieve a password for the given service and username
@@ -46,10 +66,10 @@ public:
      * @param username The account username
      * @return The password if found, nullopt otherwise
      */
-    virtual std::optional<std::string> getPassword(
+    std::optional<std::string> getPassword(
         const std::string& service,
         const std::string& username
-    ) = 0;
+    );
     
     /**
      * Delete a password for the given service and username
@@ -58,10 +78,31 @@ public:
      * @param username The account username
      * @return true if deleted successfully
      */
-    virtual bool deletePassword(
+    bool deletePassword(
         const std::string& service,
         const std::string& username
-    ) = 0;
+    );
+    
+    // Non-blocking variants; a null callback is allowed for store and delete
+    void getPasswordAsync(
+        const std::string& service,
+        const std::string& username,
+        QObject* context,
+        PasswordCallback done
+    );
+    void storePasswordAsync(
+        const std::string& service,
+        const std::string& username,
+        const std::string& password,
+        QObject* context = nullptr,
+        ResultCallback done = {}
+    );
+    void deletePasswordAsync(
+        const std::string& service,
+        const std::string& username,
+        QObject* context = nullptr,
+        ResultCallback done = {}
+    );
     
     /**
      * Check if the credential store is available
@@ -73,8 +114,82 @@ public:
      */
     static std::unique_ptr<CredentialStore> create();
     
+    static constexpr std::chrono::minutes CACHE_TTL{5};
+    
 protected:
-    CredentialStore() = default;
+    CredentialStore();
+    
+    /**
+     * Wait for keyring calls still running on worker threads. Called from
+     * the implementations' destructors, while their overrides still exist.
+     */
+    void waitForPending();
+    
+    // Keyring access, blocking
+    virtual bool writeSecret(
+        const std::string& service,
+        const std::string& username,
+        const std::string& password
+    ) = 0;
+    virtual std::optional<std::string> readSecret(
+        const std::string& service,
+        const std::string& username
+    ) = 0;
+    virtual bool clearSecret(
+        const std::string& service,
+        const std::string& username
+    ) = 0;
+    
+    /**
+     * Keyring access without blocking; the callbacks may run on any thread.
+     * By default the blocking calls are run on a worker thread.
+     */
+    virtual void readSecretAsync(
+        const std::string& service,
+        const std::string& username,
+        PasswordCallback done
+    );
+    virtual void writeSecretAsync(
+        const std::string& service,
+        const std::string& username,
+        const std::string& password,
+        ResultCallback done
+    );
+    virtual void clearSecretAsync(
+        const std::string& service,
+        const std::string& username,
+        ResultCallback done
+    );
+    
+private:
+    /**
+     * Shared with callbacks still in flight, which may outlive the store
+     */
+    struct Cache {
+        struct Entry {
+            std::string password;
+            std::chrono::steady_clock::time_point expires;
+        };
+        
+        std::optional<std::string> get(const std::string& key);
+        void put(const std::string& key, std::string password);
+        void erase(const std::string& key);
+        
+        // Bumped by every erase, so a lookup that started before one
+        // doesn't put back what was erased: take generation() before
+        // reading the keyring and pass it to putIfCurrent()
+        uint64_t generation(const std::string& key);
+        void putIfCurrent(const std::string& key, std::string password, uint64_t since);
+        
+        std::mutex mutex;
+        std::map<std::string, Entry> entries;
+        std::map<std::string, uint64_t> generations;
+    };
+    
+    static std::string cacheKey(const std::string& service, const std::string& username);
+    
+    std::shared_ptr<Cache> m_cache;
+    QThreadPool m_pool;
 };
 
 // Service identifier for LOTRO passwords
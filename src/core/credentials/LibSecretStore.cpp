@@ -10,11 +10,18 @@
 
 #include "CredentialStore.hpp"
 
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QThread>
+#include <QtConcurrent>
+
 #include <libsecret/secret.h>
 #include <glib.h>
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
+
 namespace lotro {
 
 namespace {
@@ -33,25 +40,138 @@ const SecretSchema* getCredentialSchema() {
     return &schema;
 }
 
+/**
+ * libsecret's async calls complete on the calling thread's GLib main
+ * context. That is only dispatched if Qt runs on GLib, the default on
+ * Linux, and the call is made from the GUI thread.
+ */
+bool canUseAsyncApi() {
+    auto* app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() != app->thread()) {
+        return false;
+    }
+    auto* dispatcher = QAbstractEventDispatcher::instance();
+    return dispatcher && dispatcher->inherits("QEventDispatcherGlib");
+}
+
+bool probeSecretService() {
+    GError* error = nullptr;
+    SecretService* service = secret_service_get_sync(
+        SECRET_SERVICE_LOAD_COLLECTIONS,
+        nullptr,
+        &error
+    );
+    
+    if (error) {
+        spdlog::debug("LibSecret not available: {}", error->message);
+        g_error_free(error);
+        return false;
+    }
+    
+    if (service) {
+        g_object_unref(service);
+    }
+    
+    return true;
+}
+
+template<typename Callback>
+struct AsyncRequest {
+    std::string username;
+    Callback done;
+};
+
+using LookupRequest = AsyncRequest<CredentialStore::PasswordCallback>;
+using ResultRequest = AsyncRequest<CredentialStore::ResultCallback>;
+
+void onLookupFinished(GObject*, GAsyncResult* result, gpointer data) {
+    std::unique_ptr<LookupRequest> request(static_cast<LookupRequest*>(data));
+    GError* error = nullptr;
+    gchar* password = secret_password_lookup_finish(result, &error);
+    
+    if (error) {
+        spdlog::warn("Failed to retrieve password: {}", error->message);
+        g_error_free(error);
+        request->done(std::nullopt);
+        return;
+    }
+    if (!password) {
+        spdlog::debug("No password found for: {}", request->username);
+        request->done(std::nullopt);
+        return;
+    }
+    
+    std::string value(password);
+    secret_password_free(password);
+    spdlog::debug("Retrieved password for: {}", request->username);
+    request->done(std::move(value));
+}
+
+void onStoreFinished(GObject*, GAsyncResult* result, gpointer data) {
+    std::unique_ptr<ResultRequest> request(static_cast<ResultRequest*>(data));
+    GError* error = nullptr;
+    gboolean stored = secret_password_store_finish(result, &error);
+    
+    if (error) {
+        spdlog::error("Failed to store password: {}", error->message);
+        g_error_free(error);
+        request->done(false);
+        return;
+    }
+    spdlog::debug("Stored password for: {}", request->username);
+    request->done(stored == TRUE);
+}
+
+void onClearFinished(GObject*, GAsyncResult* result, gpointer data) {
+    std::unique_ptr<ResultRequest> request(static_cast<ResultRequest*>(data));
+    GError* error = nullptr;
+    gboolean cleared = secret_password_clear_finish(result, &error);
+    
+    if (error) {
+        spdlog::warn("Failed to delete password: {}", error->message);
+        g_error_free(error);
+        request->done(false);
+        return;
+    }
+    spdlog::debug("Deleted password for: {}", request->username);
+    request->done(cleared == TRUE);
+}
+
 } // anonymous namespace
 
 class LibSecretStore : public CredentialStore {
 public:
-    LibSecretStore() {
-        m_available = checkAvailability();
-        if (m_available) {
-            spdlog::info("LibSecret credential store initialized");
-        } else {
-            spdlog::warn("LibSecret not available");
-        }
+    LibSecretStore()
+        : m_available(std::make_shared<std::atomic<bool>>(true))
+    {
+        // Connecting to the service can wait on D-Bus activation; assume it
+        // is there until the probe says otherwise
+        auto available = m_available;
+        QtConcurrent::run([available]() {
+            *available = probeSecretService();
+            if (*available) {
+                spdlog::info("LibSecret credential store initialized");
+            } else {
+                spdlog::warn("LibSecret not available");
+            }
+        });
+    }
+    
+    ~LibSecretStore() override {
+        waitForPending();
+    }
+    
+    bool isAvailable() const override {
+        return *m_available;
     }
     
-    bool storePassword(
+protected:
+    bool writeSecret(
         const std::string& service,
         const std::string& username,
         const std::string& password
     ) override {
-        if (!m_available) {
+        if (!*m_available) {
             return false;
         }
         
@@ -79,11 +199,11 @@ public:
         return result == TRUE;
     }
     
-    std::optional<std::string> getPassword(
+    std::optional<std::string> readSecret(
         const std::string& service,
         const std::string& username
     ) override {
-        if (!m_available) {
+        if (!*m_available) {
             return std::nullopt;
         }
         
@@ -116,11 +236,11 @@ public:
         return result;
     }
     
-    bool deletePassword(
+    bool clearSecret(
         const std::string& service,
         const std::string& username
     ) override {
-        if (!m_available) {
+        if (!*m_available) {
             return false;
         }
         
@@ -145,34 +265,84 @@ public:
         return result == TRUE;
     }
     
-    bool isAvailable() const override {
-        return m_available;
+    void readSecretAsync(
+        const std::string& service,
+        const std::string& username,
+        PasswordCallback done
+    ) override {
+        if (!*m_available) {
+            done(std::nullopt);
+            return;
+        }
+        if (!canUseAsyncApi()) {
+            CredentialStore::readSecretAsync(service, username, std::move(done));
+            return;
+        }
+        secret_password_lookup(
+            getCredentialSchema(),
+            nullptr,  // Cancellable
+            onLookupFinished,
+            new LookupRequest{username, std::move(done)},
+            "service", service.c_str(),
+            "username", username.c_str(),
+            nullptr
+        );
     }
     
-private:
-    bool checkAvailability() {
-        // Try to access the default collection
-        GError* error = nullptr;
-        SecretService* service = secret_service_get_sync(
-            SECRET_SERVICE_LOAD_COLLECTIONS,
-            nullptr,
-            &error
+    void writeSecretAsync(
+        const std::string& service,
+        const std::string& username,
+        const std::string& password,
+        ResultCallback done
+    ) override {
+        if (!*m_available) {
+            done(false);
+            return;
+        }
+        if (!canUseAsyncApi()) {
+            CredentialStore::writeSecretAsync(service, username, password, std::move(done));
+            return;
+        }
+        secret_password_store(
+            getCredentialSchema(),
+            SECRET_COLLECTION_DEFAULT,
+            (service + " - " + username).c_str(),  // Label
+            password.c_str(),
+            nullptr,  // Cancellable
+            onStoreFinished,
+            new ResultRequest{username, std::move(done)},
+            "service", service.c_str(),
+            "username", username.c_str(),
+            nullptr
         );
-        
-        if (error) {
-            spdlog::debug("LibSecret not available: {}", error->message);
-            g_error_free(error);
-            return false;
+    }
+    
+    void clearSecretAsync(
+        const std::string& service,
+        const std::string& username,
+        ResultCallback done
+    ) override {
+        if (!*m_available) {
+            done(false);
+            return;
         }
-        
-        if (service) {
-            g_object_unref(service);
+        if (!canUseAsyncApi()) {
+            CredentialStore::clearSecretAsync(service, username, std::move(done));
+            return;
         }
-        
-        return true;
+        secret_password_clear(
+            getCredentialSchema(),
+            nullptr,  // Cancellable
+            onClearFinished,
+            new ResultRequest{username, std::move(done)},
+            "service", service.c_str(),
+            "username", username.c_str(),
+            nullptr
+        );
     }
     
-    bool m_available = false;
+private:
+    std::shared_ptr<std::atomic<bool>> m_available;     // Shared with the startup probe
 };
 
 std::unique_ptr<CredentialStore> createLibSecretStore() {
@@ -23,7 +23,19 @@ public:
         spdlog::info("Windows credential store initialized");
     }
     
-    bool storePassword(
+    ~WindowsCredentialStore() override {
+        waitForPending();
+    }
+    
+    bool isAvailable() const override {
+        // Windows Credential Manager is always available on Windows
+        return true;
+    }
+    
+protected:
+    // Credential Manager has no async API; the async variants run these
+    // on the store's worker thread
+    bool writeSecret(
         const std::string& service,
         const std::string& username,
         const std::string& password
@@ -49,7 +61,7 @@ public:
         return true;
     }
     
-    std::optional<std::string> getPassword(
+    std::optional<std::string> readSecret(
         const std::string& service,
         const std::string& username
     ) override {
@@ -76,7 +88,7 @@ public:
         return password;
     }
     
-    bool deletePassword(
+    bool clearSecret(
         const std::string& service,
         const std::string& username
     ) override {
@@ -94,11 +106,6 @@ public:
         return true;
     }
     
-    bool isAvailable() const override {
-        // Windows Credential Manager is always available on Windows
-        return true;
-    }
-    
 private:
     std::wstring buildTargetName(const std::string& service, const std::string& username) {
         std::string combined = service + ":" + username;
@@ -7,15 +7,28 @@
 #ifdef PLATFORM_LINUX
 
 #include "Platform.hpp"
+#include "steam/VdfParser.hpp"
 
+#include <algorithm>
 #include <cstdlib>
-#include <fstream>
-#include <regex>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
 #include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
+#include <QDataStream>
 #include <QDesktopServices>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSaveFile>
 #include <QStandardPaths>
+#include <QStorageInfo>
 #include <QUrl>
+#include <QtConcurrent>
 
 #include <spdlog/spdlog.h>
 
@@ -73,17 +86,37 @@ std::filesystem::path Platform::getDocumentsPath() {
 
 namespace {
 
+using StampList = std::vector<std::pair<std::string, std::string>>;
+
+constexpr quint32 INSTALL_CACHE_MAGIC = 0x47494443;  // "GIDC"
+constexpr quint32 INSTALL_CACHE_VERSION = 1;
+
+/**
+ * Size and modification time of a path, "missing" if it doesn't exist.
+ * A directory's changes whenever an entry is added to or removed from it,
+ * so the stamps of every directory a search looked at tell whether
+ * running it again could find anything different.
+ */
+std::string pathStamp(const std::filesystem::path& path) {
+    struct stat info {};
+    if (::stat(path.c_str(), &info) != 0) {
+        return "missing";
+    }
+    return std::to_string(info.st_size) + ":" + std::to_string(info.st_mtim.tv_sec) + "." +
+           std::to_string(info.st_mtim.tv_nsec);
+}
+
+void addStamp(StampList& stamps, const std::filesystem::path& path) {
+    stamps.emplace_back(path.string(), pathStamp(path));
+}
+
 /**
  * Parse Steam's libraryfolders.vdf to find all Steam library paths
  */
-std::vector<std::filesystem::path> getSteamLibraryPaths() {
+std::vector<std::filesystem::path> getSteamLibraryPaths(const std::filesystem::path& homePath,
+                                                         StampList& stamps) {
     std::vector<std::filesystem::path> libraries;
     
-    const char* home = std::getenv("HOME");
-    if (!home) return libraries;
-    
-    std::filesystem::path homePath(home);
-    
     // Possible locations for libraryfolders.vdf
     std::vector<std::filesystem::path> vdfPaths = {
         homePath / ".steam/steam/steamapps/libraryfolders.vdf",
@@ -93,32 +126,31 @@ std::vector<std::filesystem::path> getSteamLibraryPaths() {
         homePath / ".var/app/com.valvesoftware.Steam/.steam/steam/steamapps/libraryfolders.vdf",
     };
     
+    auto addLibrary = [&](const std::filesystem::path& libPath) {
+        addStamp(stamps, libPath / "steamapps");
+        if (std::filesystem::exists(libPath / "steamapps")) {
+            libraries.push_back(libPath);
+            spdlog::debug("Found Steam library: {}", libPath.string());
+        }
+    };
+    
     for (const auto& vdfPath : vdfPaths) {
-        if (!std::filesystem::exists(vdfPath)) {
+        addStamp(stamps, vdfPath);
+        auto root = parseVdfFile(vdfPath);
+        const VdfNode* folders = root ? root->find("libraryfolders") : nullptr;
+        if (!folders) {
             continue;
         }
         
-        try {
-            std::ifstream file(vdfPath);
-            std::string content((std::istreambuf_iterator<char>(file)),
-                                std::istreambuf_iterator<char>());
-            
-            // Simple VDF parser - look for "path" entries
-            // Format: "path"		"/path/to/library"
-            std::regex pathRegex("\"path\"\\s+\"([^\"]+)\"");
-            std::smatch match;
-            std::string::const_iterator searchStart(content.cbegin());
-            
-            while (std::regex_search(searchStart, content.cend(), match, pathRegex)) {
-                std::filesystem::path libPath = match[1].str();
-                if (std::filesystem::exists(libPath / "steamapps")) {
-                    libraries.push_back(libPath);
-                    spdlog::debug("Found Steam library: {}", libPath.string());
-                }
-                searchStart = match.suffix().first;
+        for (const auto& [key, entry] : folders->children) {
+            // Current format: "0" { "path" "/library" ... }
+            // Before 2021:    "1" "/library"
+            if (const VdfNode* path = entry.find("path")) {
+                addLibrary(path->value);
+            } else if (!entry.value.empty() && !key.empty() &&
+                       std::all_of(key.begin(), key.end(), ::isdigit)) {
+                addLibrary(entry.value);
             }
-        } catch (const std::exception& e) {
-            spdlog::warn("Error parsing {}: {}", vdfPath.string(), e.what());
         }
         
         // Only need to find one working vdf file
@@ -129,14 +161,8 @@ std::vector<std::filesystem::path> getSteamLibraryPaths() {
     
     // If no libraries found from VDF, add default paths
     if (libraries.empty()) {
-        auto defaultSteam = homePath / ".steam/steam";
-        if (std::filesystem::exists(defaultSteam / "steamapps")) {
-            libraries.push_back(defaultSteam);
-        }
-        auto localSteam = homePath / ".local/share/Steam";
-        if (std::filesystem::exists(localSteam / "steamapps")) {
-            libraries.push_back(localSteam);
-        }
+        addLibrary(homePath / ".steam/steam");
+        addLibrary(homePath / ".local/share/Steam");
     }
     
     return libraries;
@@ -159,21 +185,30 @@ bool isValidGameInstall(const std::filesystem::path& path) {
     return false;
 }
 
+/**
+ * A directory to search, to the given depth; 0 only checks the directory
+ */
+struct SearchRoot {
+    std::filesystem::path path;
+    int depth = 0;
+};
+
+struct SearchResult {
+    std::vector<std::filesystem::path> installations;
+    StampList stamps;
+};
+
 /**
  * Recursively search for game installations
  */
 void findGameDirsRecursive(
     const std::filesystem::path& searchDir,
-    std::vector<std::filesystem::path>& results,
+    SearchResult& result,
     int maxDepth = 5
 ) {
     if (maxDepth <= 0) return;
     
     try {
-        if (!std::filesystem::exists(searchDir) || !std::filesystem::is_directory(searchDir)) {
-            return;
-        }
-        
         // Skip hidden directories and common non-game directories
         std::string dirName = searchDir.filename().string();
         if (dirName.empty() || dirName[0] == '.' || 
@@ -182,16 +217,21 @@ void findGameDirsRecursive(
             return;
         }
         
+        addStamp(result.stamps, searchDir);
+        if (!std::filesystem::exists(searchDir) || !std::filesystem::is_directory(searchDir)) {
+            return;
+        }
+        
         // Check if this directory is a game install
         if (isValidGameInstall(searchDir)) {
-            results.push_back(searchDir);
+            result.installations.push_back(searchDir);
             return; // Don't recurse into game directories
         }
         
         // Recurse into subdirectories
         for (const auto& entry : std::filesystem::directory_iterator(searchDir)) {
             if (entry.is_directory()) {
-                findGameDirsRecursive(entry.path(), results, maxDepth - 1);
+                findGameDirsRecursive(entry.path(), result, maxDepth - 1);
             }
         }
     } catch (const std::exception& e) {
@@ -200,58 +240,47 @@ void findGameDirsRecursive(
     }
 }
 
-} // anonymous namespace
-
-std::vector<std::filesystem::path> Platform::detectGameInstallations() {
-    std::vector<std::filesystem::path> installations;
-    
-    const char* home = std::getenv("HOME");
-    if (!home) {
-        spdlog::warn("HOME environment variable not set");
-        return installations;
+SearchResult searchRoot(const SearchRoot& root) {
+    SearchResult result;
+    if (root.depth == 0) {
+        addStamp(result.stamps, root.path);
+        if (isValidGameInstall(root.path)) {
+            result.installations.push_back(root.path);
+        }
+    } else {
+        findGameDirsRecursive(root.path, result, root.depth);
     }
-    
-    std::filesystem::path homePath(home);
-    spdlog::info("Searching for game installations...");
+    return result;
+}
+
+/**
+ * Every directory worth searching; the listings this needs are stamped too
+ */
+QList<SearchRoot> collectSearchRoots(const std::filesystem::path& homePath, StampList& stamps) {
+    QList<SearchRoot> roots;
     
     // 1. Search Steam library locations
-    auto steamLibraries = getSteamLibraryPaths();
-    for (const auto& lib : steamLibraries) {
+    for (const auto& lib : getSteamLibraryPaths(homePath, stamps)) {
         auto commonPath = lib / "steamapps/common";
         
         // Check known game folder names
-        std::vector<std::string> gameNames = {
-            "Lord of the Rings Online",
-            "Dungeons & Dragons Online",
-            "DDO",
-            "LOTRO"
-        };
-        
-        for (const auto& name : gameNames) {
-            auto gamePath = commonPath / name;
-            if (isValidGameInstall(gamePath)) {
-                installations.push_back(gamePath);
-                spdlog::info("Found game in Steam library: {}", gamePath.string());
-            }
+        for (const char* name : {"Lord of the Rings Online", "Dungeons & Dragons Online", "DDO", "LOTRO"}) {
+            roots.append({commonPath / name, 0});
         }
         
         // Also search compatdata for Proton prefixes
         auto compatData = lib / "steamapps/compatdata";
-        if (std::filesystem::exists(compatData)) {
-            for (const auto& entry : std::filesystem::directory_iterator(compatData)) {
-                if (!entry.is_directory()) continue;
-                
-                // Check both pfx/drive_c and drive_c paths
-                std::vector<std::filesystem::path> prefixPaths = {
-                    entry.path() / "pfx/drive_c/Program Files/Standing Stone Games",
-                    entry.path() / "pfx/drive_c/Program Files (x86)/Standing Stone Games",
-                    entry.path() / "drive_c/Program Files/Standing Stone Games",
-                    entry.path() / "drive_c/Program Files (x86)/Standing Stone Games",
-                };
-                
-                for (const auto& prefix : prefixPaths) {
-                    findGameDirsRecursive(prefix, installations, 3);
-                }
+        addStamp(stamps, compatData);
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(compatData, ec)) {
+            if (!entry.is_directory()) continue;
+            
+            // Check both pfx/drive_c and drive_c paths
+            for (const char* prefix : {"pfx/drive_c/Program Files/Standing Stone Games",
+                                       "pfx/drive_c/Program Files (x86)/Standing Stone Games",
+                                       "drive_c/Program Files/Standing Stone Games",
+                                       "drive_c/Program Files (x86)/Standing Stone Games"}) {
+                roots.append({entry.path() / prefix, 3});
             }
         }
     }
@@ -264,6 +293,7 @@ std::vector<std::filesystem::path> Platform::detectGameInstallations() {
     };
     
     // Also search for any directory containing "wine" in home
+    addStamp(stamps, homePath);
     try {
         for (const auto& entry : std::filesystem::directory_iterator(homePath)) {
             if (entry.is_directory()) {
@@ -277,48 +307,157 @@ std::vector<std::filesystem::path> Platform::detectGameInstallations() {
     } catch (...) {}
     
     for (const auto& prefix : winePrefixRoots) {
-        std::vector<std::filesystem::path> searchPaths = {
-            prefix / "drive_c/Program Files/Standing Stone Games",
-            prefix / "drive_c/Program Files (x86)/Standing Stone Games",
-            prefix / "drive_c/Program Files/Turbine",
-            prefix / "drive_c/Program Files (x86)/Turbine",
-        };
-        
-        for (const auto& path : searchPaths) {
-            findGameDirsRecursive(path, installations, 3);
+        for (const char* path : {"drive_c/Program Files/Standing Stone Games",
+                                 "drive_c/Program Files (x86)/Standing Stone Games",
+                                 "drive_c/Program Files/Turbine",
+                                 "drive_c/Program Files (x86)/Turbine"}) {
+            roots.append({prefix / path, 3});
         }
     }
     
-    // 3. Search ~/games
-    auto gamesDir = homePath / "games";
-    if (std::filesystem::exists(gamesDir)) {
-        findGameDirsRecursive(gamesDir, installations, 5);
+    // 3. Search ~/games and ~/Games
+    roots.append({homePath / "games", 5});
+    roots.append({homePath / "Games", 5});
+    
+    return roots;
+}
+
+bool stampsMatch(const StampList& stamps) {
+    return std::all_of(stamps.begin(), stamps.end(), [](const auto& stamp) {
+        return pathStamp(stamp.first) == stamp.second;
+    });
+}
+
+std::filesystem::path installCachePath() {
+    return Platform::getCachePath() / "game-installations.cache";
+}
+
+std::optional<SearchResult> loadInstallCache() {
+    QFile file(QString::fromStdString(installCachePath().string()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version;
+    if (magic != INSTALL_CACHE_MAGIC || version != INSTALL_CACHE_VERSION) {
+        spdlog::info("Game installation cache is outdated, ignoring it");
+        return std::nullopt;
+    }
+    
+    SearchResult cached;
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path, stamp;
+        in >> path >> stamp;
+        cached.stamps.emplace_back(path.toStdString(), stamp.toStdString());
+    }
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        in >> path;
+        cached.installations.emplace_back(path.toStdString());
+    }
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Game installation cache is corrupt, ignoring it");
+        return std::nullopt;
+    }
+    return cached;
+}
+
+void saveInstallCache(const SearchResult& result) {
+    QString path = QString::fromStdString(installCachePath().string());
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write game installation cache: {}", file.errorString().toStdString());
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << INSTALL_CACHE_MAGIC << INSTALL_CACHE_VERSION;
+    out << static_cast<quint32>(result.stamps.size());
+    for (const auto& [stampPath, stamp] : result.stamps) {
+        out << QString::fromStdString(stampPath) << QString::fromStdString(stamp);
+    }
+    out << static_cast<quint32>(result.installations.size());
+    for (const auto& installation : result.installations) {
+        out << QString::fromStdString(installation.string());
+    }
+    file.commit();
+}
+
+/**
+ * A cached result is good while nothing it looked at has changed and
+ * every installation it found is still there
+ */
+bool isCacheCurrent(const SearchResult& cached) {
+    return stampsMatch(cached.stamps) &&
+           std::all_of(cached.installations.begin(), cached.installations.end(), isValidGameInstall);
+}
+
+} // anonymous namespace
+
+std::vector<std::filesystem::path> Platform::detectGameInstallations() {
+    // The wizard and settings window ask repeatedly; the last result is
+    // kept in memory and on disk, and stands until a stamp changes
+    static QMutex cacheMutex;
+    static std::optional<SearchResult> memoryCache;
+    QMutexLocker lock(&cacheMutex);
+    
+    if (!memoryCache) {
+        memoryCache = loadInstallCache();
+    }
+    if (memoryCache && isCacheCurrent(*memoryCache)) {
+        spdlog::debug("Using cached game installations ({} paths checked)", memoryCache->stamps.size());
+        return memoryCache->installations;
     }
     
-    // 4. Search ~/Games (case variation)
-    auto GamesDir = homePath / "Games";
-    if (std::filesystem::exists(GamesDir)) {
-        findGameDirsRecursive(GamesDir, installations, 5);
+    const char* home = std::getenv("HOME");
+    if (!home) {
+        spdlog::warn("HOME environment variable not set");
+        return {};
+    }
+    
+    std::filesystem::path homePath(home);
+    spdlog::info("Searching for game installations...");
+    
+    // Roots are independent and mostly I/O bound, so they're searched in parallel
+    SearchResult result;
+    QList<SearchRoot> roots = collectSearchRoots(homePath, result.stamps);
+    QList<SearchResult> searches = QtConcurrent::blockingMapped(roots, searchRoot);
+    
+    std::vector<std::filesystem::path> installations;
+    for (auto& search : searches) {
+        for (auto& path : search.installations) {
+            installations.push_back(std::move(path));
+        }
+        for (auto& stamp : search.stamps) {
+            result.stamps.push_back(std::move(stamp));
+        }
     }
     
     // Remove duplicates (preserve order)
-    std::vector<std::filesystem::path> unique;
+    std::vector<std::filesystem::path> canonicalPaths;
     for (const auto& path : installations) {
-        auto canonical = std::filesystem::canonical(path);
-        bool found = false;
-        for (const auto& existing : unique) {
-            if (std::filesystem::canonical(existing) == canonical) {
-                found = true;
-                break;
-            }
+        std::error_code ec;
+        auto canonical = std::filesystem::canonical(path, ec);
+        if (ec) {
+            canonical = path;
         }
-        if (!found) {
-            unique.push_back(path);
+        if (std::find(canonicalPaths.begin(), canonicalPaths.end(), canonical) == canonicalPaths.end()) {
+            canonicalPaths.push_back(canonical);
+            result.installations.push_back(path);
+            spdlog::info("Found game installation: {}", path.string());
         }
     }
     
-    spdlog::info("Found {} game installation(s)", unique.size());
-    return unique;
+    spdlog::info("Found {} game installation(s)", result.installations.size());
+    saveInstallCache(result);
+    memoryCache = std::move(result);
+    return memoryCache->installations;
 }
 
 std::filesystem::path Platform::getDefaultLotroSettingsPath() {
@@ -333,6 +472,46 @@ std::optional<size_t> Platform::getOpenFileLimit() {
     return std::nullopt;
 }
 
+std::optional<bool> Platform::isRotationalStorage(const std::filesystem::path& path) {
+    // /dev/sda2 -> /sys/class/block/sda2, whose queue/ lives on the parent
+    // disk for partitions; mapper names resolve to their dm-N node
+    QStorageInfo storage(QString::fromStdString(path.string()));
+    QString device = QFileInfo(QString::fromUtf8(storage.device())).canonicalFilePath();
+    if (!device.startsWith("/dev/")) {
+        return std::nullopt;
+    }
+    QString block = QFileInfo("/sys/class/block/" + device.mid(5)).canonicalFilePath();
+    for (QString dir = block; !dir.isEmpty() && dir != "/sys"; dir = QFileInfo(dir).path()) {
+        QFile rotational(dir + "/queue/rotational");
+        if (rotational.open(QIODevice::ReadOnly)) {
+            return rotational.readAll().trimmed() == "1";
+        }
+    }
+    return std::nullopt;
+}
+
+bool Platform::cloneFile(const std::filesystem::path& source, const std::filesystem::path& destination) {
+    // FICLONE works on btrfs, XFS and bcachefs; elsewhere it fails with
+    // EOPNOTSUPP or EXDEV and the caller copies instead
+    int in = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return false;
+    }
+    int out = ::open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+    bool cloned = ::ioctl(out, FICLONE, in) == 0;
+    ::close(in);
+    ::close(out);
+    if (!cloned) {
+        std::error_code ec;
+        std::filesystem::remove(destination, ec);
+    }
+    return cloned;
+}
+
 bool Platform::openUrl(const std::string& url) {
     return QDesktopServices::openUrl(QUrl(QString::fromStdString(url)));
 }
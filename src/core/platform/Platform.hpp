@@ -62,7 +62,9 @@ public:
     /**
      * Detect existing LOTRO installation paths
      * 
-     * Searches common locations for LOTRO installations
+     * Searches common locations for LOTRO installations. The result is
+     * cached with the modification times of everything searched and
+     * reused until one of them changes.
      */
     static std::vector<std::filesystem::path> detectGameInstallations();
     
@@ -100,6 +102,17 @@ public:
      */
     static std::optional<size_t> getOpenFileLimit();
     
+    /**
+     * Whether a path lives on a spinning disk, if that can be told
+     */
+    static std::optional<bool> isRotationalStorage(const std::filesystem::path& path);
+    
+    /**
+     * Make destination a copy-on-write clone of source (reflink), sharing
+     * its blocks; false if the filesystem can't, leaving no destination
+     */
+    static bool cloneFile(const std::filesystem::path& source, const std::filesystem::path& destination);
+    
     /**
      * Open a URL in the default browser
      */
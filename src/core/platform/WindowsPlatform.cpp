@@ -97,6 +97,16 @@ std::optional<size_t> Platform::getOpenFileLimit() {
     return std::nullopt;
 }
 
+std::optional<bool> Platform::isRotationalStorage(const std::filesystem::path&) {
+    // Would need IOCTL_STORAGE_QUERY_PROPERTY; treated as unknown
+    return std::nullopt;
+}
+
+bool Platform::cloneFile(const std::filesystem::path&, const std::filesystem::path&) {
+    // ReFS block cloning would need FSCTL_DUPLICATE_EXTENTS_TO_FILE; callers copy
+    return false;
+}
+
 bool Platform::openUrl(const std::string& url) {
     return QDesktopServices::openUrl(QUrl(QString::fromStdString(url)));
 }
@@ -142,4 +142,112 @@ uint16_t BufferUtils::getWordAt(const char* buffer, size_t offset) {
     return (high << 8) | low;
 }
 
+// BufferCursor
+
+bool BufferCursor::readUInt32Array(uint32_t* out, size_t count) {
+    if (count > remaining() / 4) {
+        m_ok = false;
+        m_ptr = m_end;
+        return false;
+    }
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    std::memcpy(out, m_ptr, count * 4);
+#else
+    qFromLittleEndian<uint32_t>(m_ptr, static_cast<qsizetype>(count), out);
+#endif
+    m_ptr += count * 4;
+    return true;
+}
+
+int BufferCursor::readVle() {
+    int a = readUInt8();
+    
+    if (a == 0xE0) {
+        // Full 4-byte value follows
+        return static_cast<int>(readUInt32());
+    }
+    
+    if ((a & 0x80) == 0) {
+        // Single byte value
+        return a;
+    }
+    
+    int b = readUInt8();
+    
+    if ((a & 0x40) == 0) {
+        // Two-byte value
+        return b | ((a & 0x7F) << 8);
+    }
+    
+    // Four-byte value with 6-bit prefix
+    int c = readUInt16();
+    return ((a & 0x3F) << 24) | (b << 16) | c;
+}
+
+int BufferCursor::readTSize() {
+    skip(1);
+    return readVle();
+}
+
+QString BufferCursor::readPascalString() {
+    int length = readVle();
+    if (length < 0 || length > MAX_PASCAL_STRING_LENGTH) {
+        fail();
+        return QString();
+    }
+    if (length == 0 || !require(static_cast<size_t>(length))) {
+        return QString();
+    }
+    
+    // Read as ISO-8859-1 (Latin-1)
+    QString result = QString::fromLatin1(m_ptr, length);
+    m_ptr += length;
+    return result;
+}
+
+bool BufferCursor::skipPascalString() {
+    int length = readVle();
+    if (length < 0 || length > MAX_PASCAL_STRING_LENGTH) {
+        fail();
+        return false;
+    }
+    return m_ok && (length == 0 || skip(static_cast<size_t>(length)));
+}
+
+QString BufferCursor::readPrefixedUtf16String() {
+    QString result;
+    appendPrefixedUtf16String(result);
+    return result;
+}
+
+bool BufferCursor::appendPrefixedUtf16String(QString& out) {
+    uint32_t len = readUInt32();
+    if (!m_ok) {
+        return false;
+    }
+    if (len == 0) {
+        return true;
+    }
+    if (!require(static_cast<size_t>(len) * 2)) {
+        return false;
+    }
+    
+    // Grow once, then copy the code units straight into the string's storage
+    qsizetype start = out.size();
+    out.resize(start + static_cast<qsizetype>(len));
+    char16_t* dest = reinterpret_cast<char16_t*>(out.data()) + start;
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    std::memcpy(dest, m_ptr, static_cast<size_t>(len) * 2);
+#else
+    qFromLittleEndian<uint16_t>(m_ptr, static_cast<qsizetype>(len), dest);
+#endif
+    m_ptr += static_cast<size_t>(len) * 2;
+    return true;
+}
+
+bool BufferCursor::skipPrefixedUtf16String() {
+    uint32_t len = readUInt32();
+    return m_ok && skip(static_cast<size_t>(len) * 2);
+}
+
 } // namespace lotro::dat
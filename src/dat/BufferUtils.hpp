@@ -10,7 +10,9 @@
 
 #include <QByteArray>
 #include <QString>
+#include <QtEndian>
 #include <cstdint>
+#include <cstring>
 
 namespace lotro::dat {
 
@@ -109,4 +111,144 @@ public:
     static uint16_t getWordAt(const char* buffer, size_t offset);
 };
 
+/**
+ * @class BufferCursor
+ * @brief Bounds-checked little-endian reader over a byte range
+ * 
+ * Unlike the BufferUtils helpers, every read checks the remaining length.
+ * A read past the end returns 0 (or an empty string), moves the cursor to
+ * the end and clears ok(), so a parser can run a whole record and check
+ * once afterwards. Fixed-width reads are single unaligned loads and
+ * strings are copied in bulk into preallocated storage.
+ */
+class BufferCursor {
+public:
+    BufferCursor(const char* data, size_t size)
+        : m_begin(data), m_ptr(data), m_end(data + size) {}
+    
+    explicit BufferCursor(const QByteArray& data)
+        : BufferCursor(data.constData(), static_cast<size_t>(data.size())) {}
+    
+    /**
+     * @brief False once any read or skip ran past the end, or a string
+     * claimed an implausible length
+     */
+    bool ok() const { return m_ok; }
+    
+    bool atEnd() const { return m_ptr >= m_end; }
+    size_t remaining() const { return static_cast<size_t>(m_end - m_ptr); }
+    size_t position() const { return static_cast<size_t>(m_ptr - m_begin); }
+    const char* current() const { return m_ptr; }
+    
+    uint8_t readUInt8() { return read<uint8_t>(); }
+    uint16_t readUInt16() { return read<uint16_t>(); }
+    uint32_t readUInt32() { return read<uint32_t>(); }
+    uint64_t readUInt64() { return read<uint64_t>(); }
+    bool readBoolean() { return readUInt8() != 0; }
+    
+    float readFloat() {
+        uint32_t bits = readUInt32();
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+    
+    double readDouble() {
+        uint64_t bits = readUInt64();
+        double result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+    
+    /**
+     * @brief Read count consecutive UInt32 values into out
+     * @return false (and nothing written) if fewer than count remain
+     */
+    bool readUInt32Array(uint32_t* out, size_t count);
+    
+    /**
+     * @brief Read a variable-length encoded integer (see BufferUtils::readVle)
+     */
+    int readVle();
+    
+    /**
+     * @brief Read a TSize value (skip 1 byte, then read VLE)
+     */
+    int readTSize();
+    
+    /**
+     * @brief Read a Pascal-style string (VLE length prefix, ISO-8859-1 encoded)
+     * 
+     * A length over MAX_PASCAL_STRING_LENGTH, or a four-byte one that
+     * reads as negative, means the record is corrupt; it fails the cursor
+     * like a read past the end.
+     */
+    QString readPascalString();
+    
+    /**
+     * @brief Skip a Pascal-style string without decoding it
+     * @return false on the same lengths readPascalString() rejects
+     */
+    bool skipPascalString();
+    
+    static constexpr int MAX_PASCAL_STRING_LENGTH = 10000;
+    
+    /**
+     * @brief Read a length-prefixed UTF-16 string (UInt32 length, then Unicode chars)
+     */
+    QString readPrefixedUtf16String();
+    
+    /**
+     * @brief Append a length-prefixed UTF-16 string to out without a temporary
+     * @return false if the string runs past the end
+     */
+    bool appendPrefixedUtf16String(QString& out);
+    
+    /**
+     * @brief Skip a length-prefixed UTF-16 string
+     */
+    bool skipPrefixedUtf16String();
+    
+    /**
+     * @brief Skip a number of bytes
+     * @return false if fewer than count remain
+     */
+    bool skip(size_t count) {
+        if (!require(count)) {
+            return false;
+        }
+        m_ptr += count;
+        return true;
+    }
+    
+private:
+    bool require(size_t count) {
+        if (static_cast<size_t>(m_end - m_ptr) < count) {
+            fail();
+            return false;
+        }
+        return true;
+    }
+    
+    void fail() {
+        m_ok = false;
+        m_ptr = m_end;
+    }
+    
+    template<typename T>
+    T read() {
+        if (!require(sizeof(T))) {
+            return 0;
+        }
+        T value = qFromLittleEndian<T>(m_ptr);
+        m_ptr += sizeof(T);
+        return value;
+    }
+    
+    const char* m_begin;
+    const char* m_ptr;
+    const char* m_end;
+    bool m_ok = true;
+};
+
 } // namespace lotro::dat
@@ -5,11 +5,24 @@
 
 #include "DatArchive.hpp"
 #include "BufferUtils.hpp"
+#include "UringReader.hpp"
+#include "core/AllocationProfiler.hpp"
+#include "core/Metrics.hpp"
 
 #include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QtConcurrent>
+#include <numeric>
 #include <zlib.h>
 #include <spdlog/spdlog.h>
 
+#ifdef PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace lotro::dat {
 
 DatArchive::DatArchive(const QString& path)
@@ -28,38 +41,165 @@ bool DatArchive::open() {
         return false;
     }
     
+    m_ioUring = m_wantIoUring && UringReader::isAvailable();
+    if (m_wantIoUring && !m_ioUring) {
+        spdlog::warn("io_uring not available for {}, using positional reads", m_path.toStdString());
+    }
+    
+    if (m_useMemoryMap && !m_wantIoUring) {
+        m_mapSize = m_file.size();
+        m_map = m_file.map(0, m_mapSize);
+        if (!m_map) {
+            spdlog::warn("Failed to memory-map DAT file {}, using buffered reads: {}",
+                         m_path.toStdString(), m_file.errorString().toStdString());
+            m_mapSize = 0;
+        }
+    }
+    
     int rootOffset = readSuperBlock();
     if (rootOffset < 0) {
         spdlog::error("Failed to read DAT superblock");
-        m_file.close();
+        close();
         return false;
     }
     
-    m_rootEntry = std::make_shared<DirectoryEntry>(nullptr, rootOffset, 2460);
-    spdlog::info("Opened DAT archive: {} (block size: {})", m_path.toStdString(), m_blockSize);
+    m_rootOffset = rootOffset;
+    m_directories.reset(rootOffset, ROOT_BLOCK_SIZE);
+    
+    if (!m_indexDirectory.isEmpty()) {
+        loadOrBuildIndex();
+    }
+    
+    spdlog::info("Opened DAT archive: {} (block size: {}, mapped: {}, indexed: {})",
+                 m_path.toStdString(), m_blockSize, isMemoryMapped(), m_index.isLoaded());
     return true;
 }
 
 void DatArchive::close() {
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_mapSize = 0;
+    }
     if (m_file.isOpen()) {
         m_file.close();
     }
-    m_loadedDirs.clear();
-    m_rootEntry.reset();
+    m_directories.clear();
+    m_index.close();
+    m_ioUring = false;
     m_blockSize = 0;
+    m_superblockVersion = 0;
+    m_datPackVersion = 0;
 }
 
-int DatArchive::readSuperBlock() {
-    if (!m_file.seek(320)) {
-        return -1;
+qint64 DatArchive::readAt(uint64_t offset, char* dest, qint64 length) {
+    if (length <= 0) {
+        return 0;
     }
     
-    QByteArray buffer = m_file.read(104);
-    if (buffer.size() != 104) {
-        return -1;
+    if (m_map) {
+        if (offset >= static_cast<uint64_t>(m_mapSize)) {
+            return 0;
+        }
+        qint64 available = qMin(length, m_mapSize - static_cast<qint64>(offset));
+        memcpy(dest, m_map + offset, available);
+        return available;
     }
     
-    const char* data = buffer.constData();
+#ifdef PLATFORM_LINUX
+    // Positional read: no shared cursor, safe to call concurrently
+    qint64 total = 0;
+    while (total < length) {
+        ssize_t n = ::pread(m_file.handle(), dest + total, length - total, offset + total);
+        if (n <= 0) {
+            break;
+        }
+        total += n;
+    }
+    return total;
+#else
+    QMutexLocker lock(&m_fileMutex);
+    if (!m_file.seek(offset)) {
+        return 0;
+    }
+    return qMax<qint64>(0, m_file.read(dest, length));
+#endif
+}
+
+namespace {
+
+#ifdef PLATFORM_LINUX
+// madvise needs a page-aligned start address
+void adviseMemory(const void* address, size_t length) {
+    static const uintptr_t pageMask = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE)) - 1;
+    uintptr_t start = reinterpret_cast<uintptr_t>(address) & ~pageMask;
+    uintptr_t end = reinterpret_cast<uintptr_t>(address) + length;
+    ::madvise(reinterpret_cast<void*>(start), end - start, MADV_WILLNEED);
+}
+#else
+// Touch one byte per page to fault the range in
+void adviseMemory(const void* address, size_t length) {
+    const volatile char* bytes = static_cast<const volatile char*>(address);
+    char sink = 0;
+    for (size_t i = 0; i < length; i += 4096) {
+        sink ^= bytes[i];
+    }
+    (void)sink;
+}
+#endif
+
+} // anonymous namespace
+
+void DatArchive::adviseWillNeed(uint64_t offset, qint64 length) {
+    if (length <= 0 || offset >= static_cast<uint64_t>(m_file.size())) {
+        return;
+    }
+    
+    if (m_map) {
+        length = qMin(length, m_mapSize - static_cast<qint64>(offset));
+        adviseMemory(m_map + offset, static_cast<size_t>(length));
+        return;
+    }
+    
+#ifdef PLATFORM_LINUX
+    ::posix_fadvise(m_file.handle(), static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+#else
+    // No readahead hint available: read the range once to pull it into the page cache
+    QByteArray scratch(static_cast<qsizetype>(qMin<qint64>(length, 1024 * 1024)), Qt::Uninitialized);
+    for (qint64 done = 0; done < length; done += scratch.size()) {
+        if (readAt(offset + done, scratch.data(), qMin<qint64>(scratch.size(), length - done)) <= 0) {
+            break;
+        }
+    }
+#endif
+}
+
+void DatArchive::prewarm(std::span<const uint64_t> fileIds) {
+    if (!isOpen()) {
+        return;
+    }
+    
+    adviseWillNeed(0, SUPERBLOCK_REGION_SIZE);
+    
+    std::span<const DatIndexRecord> records = m_index.records();
+    if (!records.empty()) {
+        adviseMemory(records.data(), records.size_bytes());
+    } else {
+        adviseWillNeed(m_rootOffset, ROOT_BLOCK_SIZE);
+    }
+    
+    for (uint64_t fileId : fileIds) {
+        if (auto entry = findEntry(fileId)) {
+            adviseWillNeed(entry->fileOffset(), entry->blockSize());
+        }
+    }
+}
+
+int DatArchive::readSuperBlock() {
+    char data[104];
+    if (readAt(320, data, sizeof(data)) != sizeof(data)) {
+        return -1;
+    }
     
     int magic = BufferUtils::getDoubleWordAt(data, 0);
     if (magic != MAGIC) {
@@ -68,23 +208,24 @@ int DatArchive::readSuperBlock() {
     
     m_blockSize = BufferUtils::getDoubleWordAt(data, 4);
     uint64_t totalFileSize = BufferUtils::getDoubleWordAtAsLong(data, 8);
-    int version = BufferUtils::getDoubleWordAt(data, 12);
+    m_superblockVersion = BufferUtils::getDoubleWordAt(data, 12);
     int rootNodeOffset = BufferUtils::getDoubleWordAt(data, 32);
     m_datPackVersion = BufferUtils::getDoubleWordAt(data, 52);
     
     spdlog::debug("DAT: block_size={}, version=0x{:04X}, datpack_version={}, root_offset={}",
-                  m_blockSize, version, m_datPackVersion, rootNodeOffset);
+                  m_blockSize, m_superblockVersion, m_datPackVersion, rootNodeOffset);
     
     return rootNodeOffset;
 }
 
-void DatArchive::readDirectory(DirectoryEntryPtr entry) {
-    uint64_t offset = entry->offset();
+void DatArchive::readDirectory(uint32_t node) {
+    allocation::Scope allocScope(allocation::Tag::Dat);
+    uint64_t offset = m_directories.node(node).offset;
     if (offset == 0 || static_cast<int64_t>(offset) < 0) {
         return;
     }
     
-    int dirBlockSize = entry->blockSize();
+    int dirBlockSize = m_directories.node(node).blockSize;
     QByteArray dirData = readBlockAt(offset, dirBlockSize, DIRECTORY_RAW_SIZE);
     if (dirData.size() < DIRECTORY_RAW_SIZE) {
         spdlog::warn("Failed to read directory at offset {}", offset);
@@ -99,18 +240,26 @@ void DatArchive::readDirectory(DirectoryEntryPtr entry) {
         return;
     }
     
-    // Read subdirectory pointers
+    // Read subdirectory pointers. Child nodes are appended first and linked
+    // afterwards so the node's child range stays contiguous.
+    uint32_t children[MAX_ENTRIES + 1];
+    int childCount = 0;
     for (int i = 0; i <= filesCount; ++i) {
         int blockSize = BufferUtils::getDoubleWordAt(data, i * 8);
         uint64_t dirOffset = BufferUtils::getDoubleWordAtAsLong(data, 4 + i * 8);
         
         if (blockSize != 0) {
-            auto subDir = std::make_shared<DirectoryEntry>(entry.get(), dirOffset, blockSize);
-            entry->addDirectory(subDir);
+            children[childCount++] = m_directories.addNode(node, dirOffset, blockSize);
         }
     }
     
+    m_directories.beginChildren(node);
+    for (int i = 0; i < childCount; ++i) {
+        m_directories.addChild(node, children[i]);
+    }
+    
     // Read file entries
+    m_directories.beginFiles(node);
     for (int i = 0; i < filesCount; ++i) {
         int baseOffset = 500 + i * ENTRY_RAW_SIZE;
         
@@ -124,70 +273,88 @@ void DatArchive::readDirectory(DirectoryEntryPtr entry) {
         int blockSize = BufferUtils::getDoubleWordAt(data, baseOffset + 24);
         
         FileEntry fileEntry(i, fileId, fileOffset, version, timestamp, size, blockSize, flags, policy);
-        entry->addFile(fileEntry);
+        m_directories.addFile(node, fileEntry);
     }
 }
 
-void DatArchive::ensureLoaded(DirectoryEntryPtr entry) {
-    uint64_t offset = entry->offset();
-    if (!m_loadedDirs.contains(offset)) {
-        readDirectory(entry);
-        m_loadedDirs[offset] = entry;
+void DatArchive::ensureLoaded(uint32_t node) {
+    if (!m_directories.node(node).loaded) {
+        readDirectory(node);
+        m_directories.node(node).loaded = true;
     }
 }
 
-FileEntry* DatArchive::getFileById(DirectoryEntryPtr dir, uint64_t fileId) {
-    ensureLoaded(dir);
-    
-    const auto& files = dir->files();
-    int nbFiles = files.size();
-    int l = 0;
-    int u = nbFiles - 1;
-    
-    // Binary search through file entries
-    while (l <= u) {
-        int p = (l + u) / 2;
-        const FileEntry& entry = files[p];
-        uint64_t currentId = entry.fileId();
+const FileEntry* DatArchive::getFileById(uint32_t node, uint64_t fileId, uint32_t* foundNode) {
+    // Iterative descent: each level either finds the ID or picks one child
+    for (;;) {
+        ensureLoaded(node);
         
-        if (currentId < fileId) {
-            l = p + 1;
-        } else if (currentId > fileId) {
-            u = p - 1;
-        } else {
-            // Found it - need to return non-const pointer
-            // We'll use a workaround since QVector doesn't give us a mutable ref easily
-            return const_cast<FileEntry*>(&files[p]);
+        std::span<const FileEntry> files = m_directories.files(node);
+        int l = 0;
+        int u = static_cast<int>(files.size()) - 1;
+        
+        // Binary search through file entries
+        while (l <= u) {
+            int p = (l + u) / 2;
+            uint64_t currentId = files[p].fileId();
+            
+            if (currentId < fileId) {
+                l = p + 1;
+            } else if (currentId > fileId) {
+                u = p - 1;
+            } else {
+                if (foundNode) {
+                    *foundNode = node;
+                }
+                return &files[p];
+            }
         }
+        
+        // Not found in this directory, check subdirectories
+        std::span<const uint32_t> subDirs = m_directories.children(node);
+        if (subDirs.empty() || l >= static_cast<int>(subDirs.size())) {
+            return nullptr;
+        }
+        node = subDirs[l];
     }
-    
-    // Not found in this directory, check subdirectories
-    const auto& subDirs = dir->directories();
-    if (!subDirs.isEmpty() && l < subDirs.size()) {
-        return getFileById(subDirs[l], fileId);
+}
+
+bool DatArchive::isSingleBlock(uint64_t offset) {
+    char hdr[8];
+    if (readAt(offset, hdr, sizeof(hdr)) != sizeof(hdr)) {
+        return false;
     }
-    
-    return nullptr;
+    return BufferUtils::getDoubleWordAt(hdr, 0) == 0 && BufferUtils::getDoubleWordAt(hdr, 4) == 0;
 }
 
 QByteArray DatArchive::readBlockAt(uint64_t offset, int blockSize, int size) {
-    if (!m_file.seek(offset)) {
-        return QByteArray();
-    }
-    
+    QByteArray result;
+    readBlockInto(offset, blockSize, size, result);
+    return result;
+}
+
+bool DatArchive::readBlockInto(uint64_t offset, int blockSize, int size, QByteArray& result) {
     // Read header
-    QByteArray header = m_file.read(8);
-    if (header.size() != 8) {
-        return QByteArray();
+    char hdr[8];
+    if (readAt(offset, hdr, sizeof(hdr)) != sizeof(hdr)) {
+        result.clear();
+        return false;
     }
     
-    const char* hdr = header.constData();
     int numExtraBlocks = BufferUtils::getDoubleWordAt(hdr, 0);
     int legacy = BufferUtils::getDoubleWordAt(hdr, 4);
     
     if (legacy != 0) {
         // Old format
-        return readOldBlockAt(offset, blockSize, size);
+        return readOldBlockInto(offset, blockSize, size, result);
+    }
+    
+    // The extra block pointers follow the first chunk inside the first
+    // block, so a count that can't fit there is corrupt; checked before
+    // anything is sized from it
+    if (size <= 0 || numExtraBlocks < 0 || numExtraBlocks > (blockSize - 8) / 8) {
+        result.clear();
+        return false;
     }
     
     // Calculate first chunk size
@@ -195,22 +362,31 @@ QByteArray DatArchive::readBlockAt(uint64_t offset, int blockSize, int size) {
     if (firstChunkSize > size) {
         firstChunkSize = size;
     }
+    if (firstChunkSize < 0) {
+        result.clear();
+        return false;
+    }
     
-    // Read first chunk
-    QByteArray firstChunk = m_file.read(firstChunkSize);
-    if (firstChunk.size() != firstChunkSize) {
-        return QByteArray();
+    // Read first chunk straight into the result (resize keeps existing capacity)
+    result.resize(size);
+    uint64_t position = offset + sizeof(hdr);
+    if (readAt(position, result.data(), firstChunkSize) != firstChunkSize) {
+        result.clear();
+        return false;
     }
+    position += firstChunkSize;
     
-    // Read extra block info
-    QByteArray extraInfo = m_file.read(numExtraBlocks * 8);
-    if (extraInfo.size() != numExtraBlocks * 8) {
-        return firstChunk; // Return what we have
+    if (numExtraBlocks == 0) {
+        result.truncate(firstChunkSize);
+        return true;
     }
     
-    // Build result
-    QByteArray result(size, Qt::Uninitialized);
-    memcpy(result.data(), firstChunk.constData(), firstChunkSize);
+    // Read extra block info
+    QByteArray extraInfo(numExtraBlocks * 8, Qt::Uninitialized);
+    if (readAt(position, extraInfo.data(), extraInfo.size()) != extraInfo.size()) {
+        result.truncate(firstChunkSize);
+        return true; // Return what we have
+    }
     
     int index = firstChunkSize;
     const char* extra = extraInfo.constData();
@@ -219,117 +395,511 @@ QByteArray DatArchive::readBlockAt(uint64_t offset, int blockSize, int size) {
         int extraBlockSize = BufferUtils::getDoubleWordAt(extra, i * 8);
         uint64_t extraOffset = BufferUtils::getDoubleWordAtAsLong(extra, i * 8 + 4);
         
-        if (!m_file.seek(extraOffset)) {
+        int sizeToRead = qMin(extraBlockSize, size - index);
+        qint64 bytesRead = readAt(extraOffset, result.data() + index, sizeToRead);
+        if (bytesRead <= 0) {
             break;
         }
-        
-        int sizeToRead = qMin(extraBlockSize, size - index);
-        QByteArray chunk = m_file.read(sizeToRead);
-        memcpy(result.data() + index, chunk.constData(), chunk.size());
-        index += chunk.size();
+        index += bytesRead;
     }
     
-    return result;
+    return true;
 }
 
-QByteArray DatArchive::readOldBlockAt(uint64_t offset, int blockSize, int totalSize) {
-    QByteArray result(totalSize, Qt::Uninitialized);
+bool DatArchive::readOldBlockInto(uint64_t offset, int blockSize, int totalSize, QByteArray& result) {
+    if (totalSize <= 0) {
+        result.clear();
+        return false;
+    }
+    
+    result.resize(totalSize);
     int bytesRead = 0;
     int pos = totalSize;
     
-    if (!m_file.seek(offset)) {
-        return QByteArray();
-    }
-    
+    uint64_t position = offset;
     int currentBlockSize = blockSize;
     
     for (int steps = 0; steps < 1000 && bytesRead < totalSize; ++steps) {
-        QByteArray header = m_file.read(8);
-        if (header.size() != 8) {
+        char hdr[8];
+        if (readAt(position, hdr, sizeof(hdr)) != sizeof(hdr)) {
             break;
         }
+        position += sizeof(hdr);
         
-        const char* hdr = header.constData();
         int nextBlockSize = BufferUtils::getDoubleWordAt(hdr, 0);
         int nextOffset = BufferUtils::getDoubleWordAt(hdr, 4);
         
         if (nextBlockSize == 0) {
             int toRead = totalSize - bytesRead;
             if (toRead > 0) {
-                QByteArray chunk = m_file.read(toRead);
-                memcpy(result.data(), chunk.constData(), chunk.size());
+                readAt(position, result.data(), toRead);
             }
-            return result;
+            return true;
         }
         
         int toRead = currentBlockSize - 8;
+        if (toRead <= 0 || toRead > pos) {
+            break;
+        }
         pos -= toRead;
         
-        QByteArray chunk = m_file.read(toRead);
-        memcpy(result.data() + pos, chunk.constData(), chunk.size());
-        bytesRead += chunk.size();
+        bytesRead += readAt(position, result.data() + pos, toRead);
         
-        if (!m_file.seek(nextOffset)) {
-            break;
-        }
+        position = static_cast<uint32_t>(nextOffset);
         currentBlockSize = nextBlockSize;
     }
     
-    return result;
+    return true;
 }
 
-QByteArray DatArchive::loadEntry(const FileEntry& entry) {
-    QByteArray data = readBlockAt(entry.fileOffset(), entry.blockSize(), entry.size());
+const char* DatArchive::mappedBlock(uint64_t offset, int blockSize, int size) const {
+    if (!m_map || size <= 0 || offset + 8 + size > static_cast<uint64_t>(m_mapSize)) {
+        return nullptr;
+    }
     
-    if (data.isEmpty()) {
-        return data;
+    // Only new-format blocks without extra blocks are contiguous on disk
+    const char* hdr = reinterpret_cast<const char*>(m_map + offset);
+    int numExtraBlocks = BufferUtils::getDoubleWordAt(hdr, 0);
+    int legacy = BufferUtils::getDoubleWordAt(hdr, 4);
+    if (legacy != 0 || numExtraBlocks != 0 || blockSize - 8 < size) {
+        return nullptr;
+    }
+    return hdr + 8;
+}
+
+bool DatArchive::inflateInto(const char* source, qsizetype sourceSize, qsizetype sizeHint, QByteArray& out) {
+    z_stream stream{};
+    if (inflateInit(&stream) != Z_OK) {
+        out.clear();
+        return false;
     }
     
-    if (entry.isCompressed()) {
-        // Skip first 4 bytes and decompress
-        if (data.size() <= 4) {
-            return QByteArray();
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(source));
+    stream.avail_in = static_cast<uInt>(sourceSize);
+    
+    // Inflate in place into the caller's buffer, growing it when the hint was too small
+    out.resize(qMax<qsizetype>(sizeHint, 256));
+    qsizetype produced = 0;
+    int result = Z_OK;
+    
+    while (result == Z_OK) {
+        if (produced == out.size()) {
+            out.resize(out.size() * 2);
         }
+        stream.next_out = reinterpret_cast<Bytef*>(out.data() + produced);
+        stream.avail_out = static_cast<uInt>(out.size() - produced);
         
-        // Use zlib to decompress
-        QByteArray compressed = data.mid(4);
+        result = inflate(&stream, Z_NO_FLUSH);
+        produced = out.size() - stream.avail_out;
+    }
+    
+    inflateEnd(&stream);
+    
+    if (result != Z_STREAM_END) {
+        spdlog::warn("Failed to decompress entry, zlib error: {}", result);
+        out.clear();
+        return false;
+    }
+    
+    out.resize(produced);
+    return true;
+}
+
+bool DatArchive::loadEntryInto(const FileEntry& entry, QByteArray& out) {
+    allocation::Scope allocScope(allocation::Tag::Dat);
+    static metrics::Histogram& readTime = metrics::histogram("dat.read_us");
+    static metrics::Counter& readBytes = metrics::counter("dat.read_bytes");
+    metrics::ScopedTimer timer(readTime);
+    readBytes.add(entry.size());
+    
+    if (!entry.isCompressed()) {
+        return readBlockInto(entry.fileOffset(), entry.blockSize(), entry.size(), out) && !out.isEmpty();
+    }
+    
+    // Inflate straight from the mapping when the block is contiguous,
+    // otherwise gather it into a per-thread scratch buffer that is reused
+    thread_local QByteArray scratch;
+    
+    const char* source = mappedBlock(entry.fileOffset(), entry.blockSize(), entry.size());
+    qsizetype sourceSize = entry.size();
+    if (!source) {
+        if (!readBlockInto(entry.fileOffset(), entry.blockSize(), entry.size(), scratch)) {
+            out.clear();
+            return false;
+        }
+        source = scratch.constData();
+        sourceSize = scratch.size();
+    }
+    
+    // Skip first 4 bytes (uncompressed size) and decompress
+    if (sourceSize <= 4) {
+        out.clear();
+        return false;
+    }
+    
+    qsizetype sizeHint = BufferUtils::getDoubleWordAt(source, 0);
+    if (sizeHint <= 0 || sizeHint > MAX_INFLATE_HINT) {
+        sizeHint = sourceSize * 4;
+    }
+    
+    bool ok = inflateInto(source + 4, sourceSize - 4, sizeHint, out);
+    
+    // Don't let one huge entry pin memory on this thread forever
+    if (scratch.capacity() > MAX_SCRATCH_CAPACITY) {
+        scratch = QByteArray();
+    }
+    return ok;
+}
+
+bool DatArchive::readEntryRaw(const FileEntry& entry, QByteArray& out) {
+    allocation::Scope allocScope(allocation::Tag::Dat);
+    static metrics::Counter& readBytes = metrics::counter("dat.read_bytes");
+    readBytes.add(entry.size());
+    return readBlockInto(entry.fileOffset(), entry.blockSize(), entry.size(), out) && !out.isEmpty();
+}
+
+size_t DatArchive::readEntriesRaw(std::span<const FileEntry> entries, std::vector<QByteArray>& out) {
+    out.resize(entries.size());
+    // The ring is per thread and may fail to set up on a thread other
+    // than the one that probed it at open
+    UringReader* reader = m_ioUring ? UringReader::forThisThread() : nullptr;
+    if (!reader) {
+        size_t read = 0;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (readEntryRaw(entries[i], out[i])) {
+                read++;
+            } else {
+                out[i].clear();
+            }
+        }
+        return read;
+    }
+    
+    allocation::Scope allocScope(allocation::Tag::Dat);
+    static metrics::Counter& readBytes = metrics::counter("dat.read_bytes");
+    const int fd = m_file.handle();
+    const uint64_t fileSize = static_cast<uint64_t>(m_file.size());
+    
+    // Pass 1: every entry's first block, which holds its header, the start
+    // of the payload and the extra block pointers
+    std::vector<UringRead> reads;
+    std::vector<size_t> owners;
+    reads.reserve(entries.size());
+    owners.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const FileEntry& entry = entries[i];
+        uint64_t offset = entry.fileOffset();
+        if (entry.size() <= 0 || entry.blockSize() < 8 || offset >= fileSize) {
+            out[i].clear();
+            continue;
+        }
+        uint32_t length = static_cast<uint32_t>(qMin<uint64_t>(entry.blockSize(), fileSize - offset));
+        out[i].resize(qMax<qsizetype>(length, entry.size()));
+        reads.push_back({fd, offset, out[i].data(), length, 0});
+        owners.push_back(i);
+    }
+    if (!reader->read(reads)) {
+        for (QByteArray& buffer : out) {
+            buffer.clear();
+        }
+        return 0;
+    }
+    
+    // Pass 2: move payloads into place and queue the extra blocks
+    std::vector<UringRead> extras;
+    std::vector<size_t> extraOwners;
+    std::vector<char> pointers;
+    std::vector<bool> viaFallback(entries.size(), false);
+    for (size_t r = 0; r < reads.size(); ++r) {
+        size_t i = owners[r];
+        const FileEntry& entry = entries[i];
+        QByteArray& buffer = out[i];
+        if (reads[r].result < 8) {
+            buffer.clear();
+            continue;
+        }
+        
+        int numExtraBlocks = BufferUtils::getDoubleWordAt(buffer.constData(), 0);
+        int legacy = BufferUtils::getDoubleWordAt(buffer.constData(), 4);
+        if (legacy != 0) {
+            viaFallback[i] = true;
+            if (!readEntryRaw(entry, buffer)) {
+                buffer.clear();
+            }
+            continue;
+        }
         
-        // Get uncompressed size from first 4 bytes (if available in format)
-        // For now, we'll try to decompress with a reasonable buffer
-        uLongf destLen = entry.size() * 10; // Estimate
-        QByteArray decompressed(destLen, Qt::Uninitialized);
+        // The pointers sit inside the first block, and what was read of it
+        // stops at the end of the file; a count that fits in neither is
+        // corrupt, and is rejected before anything is sized from it
+        if (numExtraBlocks < 0 || numExtraBlocks > (entry.blockSize() - 8) / 8
+            || static_cast<qint64>(numExtraBlocks) * 8 > reads[r].result - 8) {
+            buffer.clear();
+            continue;
+        }
         
-        int result = uncompress(
-            reinterpret_cast<Bytef*>(decompressed.data()),
-            &destLen,
-            reinterpret_cast<const Bytef*>(compressed.constData()),
-            compressed.size()
-        );
+        int size = entry.size();
+        int firstChunkSize = qMin(entry.blockSize() - 8 - numExtraBlocks * 8, size);
+        qint64 pointersEnd = 8 + static_cast<qint64>(firstChunkSize) + numExtraBlocks * 8;
+        if (firstChunkSize < 0 || reads[r].result < 8 + firstChunkSize
+            || (numExtraBlocks > 0 && reads[r].result < pointersEnd)) {
+            buffer.clear();
+            continue;
+        }
         
-        if (result == Z_OK) {
-            decompressed.resize(destLen);
-            return decompressed;
-        } else {
-            spdlog::warn("Failed to decompress entry, zlib error: {}", result);
-            return QByteArray();
+        pointers.assign(buffer.constData() + 8 + firstChunkSize, buffer.constData() + pointersEnd);
+        std::memmove(buffer.data(), buffer.constData() + 8, static_cast<size_t>(firstChunkSize));
+        if (numExtraBlocks == 0) {
+            buffer.truncate(firstChunkSize);
+            continue;
+        }
+        
+        buffer.resize(size);
+        int index = firstChunkSize;
+        for (int b = 0; b < numExtraBlocks && index < size; ++b) {
+            int extraBlockSize = BufferUtils::getDoubleWordAt(pointers.data(), b * 8);
+            uint64_t extraOffset = BufferUtils::getDoubleWordAtAsLong(pointers.data(), b * 8 + 4);
+            int sizeToRead = qMin(extraBlockSize, size - index);
+            if (sizeToRead <= 0) {
+                break;
+            }
+            extras.push_back({fd, extraOffset, buffer.data() + index, static_cast<uint32_t>(sizeToRead), 0});
+            extraOwners.push_back(i);
+            index += sizeToRead;
+        }
+        if (index < size) {
+            buffer.truncate(index);
         }
     }
     
+    if (!extras.empty() && !reader->read(extras)) {
+        extras.clear();
+        for (size_t i : extraOwners) {
+            out[i].clear();
+        }
+    }
+    for (size_t e = 0; e < extras.size(); ++e) {
+        if (extras[e].result != static_cast<qint64>(extras[e].length)) {
+            out[extraOwners[e]].clear();
+        }
+    }
+    
+    size_t read = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (!out[i].isEmpty()) {
+            if (!viaFallback[i]) {
+                readBytes.add(entries[i].size());
+            }
+            read++;
+        }
+    }
+    return read;
+}
+
+qsizetype DatArchive::decodedSizeHint(const FileEntry& entry, const QByteArray& raw) {
+    if (!entry.isCompressed()) {
+        return raw.size();
+    }
+    qsizetype sizeHint = raw.size() > 4 ? BufferUtils::getDoubleWordAt(raw.constData(), 0) : 0;
+    if (sizeHint <= 0 || sizeHint > MAX_INFLATE_HINT) {
+        sizeHint = raw.size() * 4;
+    }
+    return sizeHint;
+}
+
+bool DatArchive::decodeEntry(const FileEntry& entry, QByteArray& raw, QByteArray& out) {
+    allocation::Scope allocScope(allocation::Tag::Dat);
+    if (!entry.isCompressed()) {
+        out = std::move(raw);
+        return !out.isEmpty();
+    }
+    
+    // Skip first 4 bytes (uncompressed size) and decompress
+    if (raw.size() <= 4) {
+        out.clear();
+        return false;
+    }
+    return inflateInto(raw.constData() + 4, raw.size() - 4, decodedSizeHint(entry, raw), out);
+}
+
+QByteArray DatArchive::loadEntry(const FileEntry& entry) {
+    QByteArray data;
+    loadEntryInto(entry, data);
     return data;
 }
 
+void DatArchive::loadOrBuildIndex() {
+    QFileInfo info(m_path);
+    QString indexPath = DatIndex::pathFor(m_indexDirectory, m_path);
+    
+    DatIndexKey key;
+    key.superblockVersion = static_cast<uint32_t>(m_superblockVersion);
+    key.datPackVersion = static_cast<uint32_t>(m_datPackVersion);
+    key.archiveSize = static_cast<uint64_t>(m_file.size());
+    
+    if (m_index.open(indexPath, key)) {
+        return;
+    }
+    
+    spdlog::info("Building file index for {}", info.fileName().toStdString());
+    
+    std::vector<DatIndexRecord> records;
+    {
+        QMutexLocker lock(&m_directoryMutex);
+        collectEntries(ROOT_NODE, records);
+        
+        // The walk loaded every directory; drop the tree now that the index covers it
+        m_directories.reset(m_rootOffset, ROOT_BLOCK_SIZE);
+    }
+    
+    m_index.build(indexPath, key, std::move(records));
+}
+
+void DatArchive::collectEntries(uint32_t node, std::vector<DatIndexRecord>& records) {
+    ensureLoaded(node);
+    
+    for (const FileEntry& file : m_directories.files(node)) {
+        DatIndexRecord record;
+        record.fileId = file.fileId();
+        record.offset = file.fileOffset();
+        record.size = static_cast<uint32_t>(file.size());
+        record.blockSize = static_cast<uint32_t>(file.blockSize());
+        record.flags = static_cast<uint16_t>(file.flags());
+        record.policy = static_cast<uint16_t>(file.policy());
+        record.version = static_cast<uint32_t>(file.version());
+        records.push_back(record);
+    }
+    
+    // Copy the child range: loading a child appends to the arena
+    std::span<const uint32_t> children = m_directories.children(node);
+    std::vector<uint32_t> subDirs(children.begin(), children.end());
+    for (uint32_t subDir : subDirs) {
+        collectEntries(subDir, records);
+    }
+}
+
+std::vector<FileEntry> DatArchive::listEntries() {
+    std::vector<DatIndexRecord> walked;
+    std::span<const DatIndexRecord> records = m_index.records();
+    if (records.empty() && isOpen()) {
+        QMutexLocker lock(&m_directoryMutex);
+        collectEntries(ROOT_NODE, walked);
+        records = walked;
+    }
+    
+    std::vector<FileEntry> entries;
+    entries.reserve(records.size());
+    for (const DatIndexRecord& record : records) {
+        entries.emplace_back(0, record.fileId, record.offset, static_cast<int>(record.version), 0,
+                             static_cast<int>(record.size), static_cast<int>(record.blockSize),
+                             record.flags, record.policy);
+    }
+    return entries;
+}
+
+std::optional<DatEntrySlot> DatArchive::locateEntry(uint64_t fileId) {
+    DatEntrySlot slot;
+    uint64_t dirOffset = 0;
+    int dirBlockSize = 0;
+    {
+        QMutexLocker lock(&m_directoryMutex);
+        if (m_directories.isEmpty()) {
+            return std::nullopt;
+        }
+        uint32_t node = ROOT_NODE;
+        const FileEntry* entry = getFileById(ROOT_NODE, fileId, &node);
+        if (!entry) {
+            return std::nullopt;
+        }
+        slot.entry = *entry;
+        dirOffset = m_directories.node(node).offset;
+        dirBlockSize = m_directories.node(node).blockSize;
+    }
+    
+    // Records sit after the 8-byte block header, past the child pointers and count
+    if (dirBlockSize - 8 < DIRECTORY_RAW_SIZE || !isSingleBlock(dirOffset)) {
+        return slot;
+    }
+    slot.recordOffset = dirOffset + 8 + BASE_FILE_ENTRIES_OFFSET + 4
+                      + static_cast<uint64_t>(slot.entry.index()) * ENTRY_RAW_SIZE;
+    
+    if (slot.entry.blockSize() > 8 && isSingleBlock(slot.entry.fileOffset())) {
+        slot.capacity = slot.entry.blockSize() - 8;
+    }
+    return slot;
+}
+
+std::optional<FileEntry> DatArchive::findEntry(uint64_t fileId) {
+    if (m_index.isLoaded()) {
+        const DatIndexRecord* record = m_index.find(fileId);
+        if (!record) {
+            return std::nullopt;
+        }
+        return FileEntry(0, record->fileId, record->offset, static_cast<int>(record->version), 0,
+                         static_cast<int>(record->size), static_cast<int>(record->blockSize),
+                         record->flags, record->policy);
+    }
+    
+    QMutexLocker lock(&m_directoryMutex);
+    if (m_directories.isEmpty()) {
+        return std::nullopt;
+    }
+    
+    const FileEntry* entry = getFileById(ROOT_NODE, fileId);
+    if (!entry) {
+        return std::nullopt;
+    }
+    return *entry;
+}
+
 QByteArray DatArchive::loadData(uint64_t fileId) {
-    if (!isOpen() || !m_rootEntry) {
+    if (!isOpen()) {
         return QByteArray();
     }
     
-    FileEntry* entry = getFileById(m_rootEntry, fileId);
+    auto entry = findEntry(fileId);
     if (!entry) {
-        spdlog::debug("File ID 0x{:08X} not found in DAT archive", fileId);
+        SPDLOG_DEBUG("File ID 0x{:08X} not found in DAT archive", fileId);
         return QByteArray();
     }
     
     return loadEntry(*entry);
 }
 
+bool DatArchive::loadDataInto(uint64_t fileId, QByteArray& out) {
+    if (!isOpen()) {
+        out.clear();
+        return false;
+    }
+    
+    auto entry = findEntry(fileId);
+    if (!entry) {
+        out.clear();
+        return false;
+    }
+    
+    return loadEntryInto(*entry, out);
+}
+
+std::vector<QByteArray> DatArchive::loadDataBatch(std::span<const uint64_t> fileIds) {
+    std::vector<QByteArray> results(fileIds.size());
+    if (!isOpen() || fileIds.empty()) {
+        return results;
+    }
+    
+    if (fileIds.size() == 1) {
+        results[0] = loadData(fileIds[0]);
+        return results;
+    }
+    
+    // Each slot is written by exactly one task, so no locking is needed here
+    std::vector<size_t> indices(fileIds.size());
+    std::iota(indices.begin(), indices.end(), size_t{0});
+    QtConcurrent::blockingMap(indices, [this, fileIds, &results](size_t i) {
+        results[i] = loadData(fileIds[i]);
+    });
+    
+    return results;
+}
+
 } // namespace lotro::dat
@@ -7,23 +7,40 @@
 
 #pragma once
 
+#include "DatIndex.hpp"
 #include "DirectoryEntry.hpp"
 #include "FileEntry.hpp"
 
 #include <QFile>
 #include <QString>
 #include <QByteArray>
-#include <QMap>
+#include <QMutex>
 #include <memory>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace lotro::dat {
 
+/**
+ * @brief Where an entry is stored, for rewriting it in place
+ */
+struct DatEntrySlot {
+    FileEntry entry;
+    uint64_t recordOffset = 0;  // Absolute offset of the entry's 32-byte directory record; 0 if not writable
+    int capacity = 0;           // Payload bytes the entry's block can hold; 0 if not writable
+};
+
 /**
  * @class DatArchive
  * @brief Reads files from a LOTRO DAT archive
  * 
  * DAT archives are binary files that store game data using a B-tree
  * structure for efficient lookup by data ID.
+ * 
+ * Once opened, loadData() and loadDataBatch() may be called from several
+ * threads at once: block reads are positional (no shared file cursor) and
+ * directory loading is serialized internally.
  */
 class DatArchive {
 public:
@@ -32,6 +49,10 @@ public:
     
     /**
      * @brief Open the DAT archive for reading
+     * 
+     * When memory mapping is enabled (the default) the whole archive is
+     * mapped and blocks are resolved directly from the mapping. If the
+     * mapping fails the archive falls back to seek/read access.
      * @return true if successful
      */
     bool open();
@@ -46,6 +67,57 @@ public:
      */
     bool isOpen() const { return m_file.isOpen(); }
     
+    /**
+     * @brief Enable or disable memory-mapped access
+     * 
+     * Takes effect on the next call to open().
+     */
+    void setMemoryMapped(bool enabled) { m_useMemoryMap = enabled; }
+    
+    /**
+     * @brief Check if the archive is currently served from a memory mapping
+     */
+    bool isMemoryMapped() const { return m_map != nullptr; }
+    
+    /**
+     * @brief Serve readEntriesRaw() through io_uring instead of a mapping
+     * 
+     * For bulk scans where a mapping does poorly (archives larger than
+     * memory, network storage). Takes effect on the next call to open(),
+     * which then skips the mapping; if io_uring is unavailable the archive
+     * falls back to positional reads.
+     */
+    void setIoUring(bool enabled) { m_wantIoUring = enabled; }
+    
+    /**
+     * @brief Check if batched reads go through io_uring
+     */
+    bool usesIoUring() const { return m_ioUring; }
+    
+    /**
+     * @brief Set the directory holding persistent file-ID indexes
+     * 
+     * When set before open(), the archive maps its flat index from this
+     * directory, or walks the whole B-tree once and writes one, and then
+     * serves lookups by binary search instead of directory traversal.
+     */
+    void setIndexDirectory(const QString& directory) { m_indexDirectory = directory; }
+    
+    /**
+     * @brief Get the flat file-ID index (empty if not in use)
+     */
+    const DatIndex& index() const { return m_index; }
+    
+    /**
+     * @brief Get the superblock version of the open archive
+     */
+    int superblockVersion() const { return m_superblockVersion; }
+    
+    /**
+     * @brief Get the datpack version of the open archive
+     */
+    int datPackVersion() const { return m_datPackVersion; }
+    
     /**
      * @brief Load data by file ID
      * @param fileId The data ID to load
@@ -53,6 +125,105 @@ public:
      */
     QByteArray loadData(uint64_t fileId);
     
+    /**
+     * @brief Look up a file entry's metadata without loading its data
+     * @return A copy of the entry, or nullopt if the ID is not in this archive
+     */
+    std::optional<FileEntry> findEntry(uint64_t fileId);
+    
+    /**
+     * @brief Find where an entry and its directory record are stored
+     * 
+     * Always descends the B-tree, since the flat index doesn't record
+     * directory positions. The directory block and the entry's data block
+     * only count as writable when each is stored in one piece.
+     * @return The slot, or nullopt if the ID is not in this archive
+     */
+    std::optional<DatEntrySlot> locateEntry(uint64_t fileId);
+    
+    /**
+     * @brief Load data by file ID into a caller-provided buffer
+     * 
+     * The buffer's existing capacity is reused, so loading many entries
+     * through the same buffer avoids an allocation per entry.
+     * @param fileId The data ID to load
+     * @param out Receives the data (cleared if not found)
+     * @return true if the entry was found and decoded
+     */
+    bool loadDataInto(uint64_t fileId, QByteArray& out);
+    
+    /**
+     * @brief Load an entry obtained from findEntry() or listEntries()
+     * @return true if the entry's blocks were read and decoded
+     */
+    bool loadEntryInto(const FileEntry& entry, QByteArray& out);
+    
+    /**
+     * @brief Read an entry's stored bytes without decompressing them
+     * 
+     * Together with decodeEntry() this splits loadEntryInto() in two, so
+     * reads and decompression can run on different threads.
+     * @return true if the entry's blocks were read
+     */
+    bool readEntryRaw(const FileEntry& entry, QByteArray& out);
+    
+    /**
+     * @brief Turn bytes from readEntryRaw() into the entry's data
+     * 
+     * Compressed entries are inflated into out; others are moved from raw.
+     * Needs no archive state, so any thread may call it.
+     * @return true if the data decoded
+     */
+    static bool decodeEntry(const FileEntry& entry, QByteArray& raw, QByteArray& out);
+    
+    /**
+     * @brief Expected size of the data decodeEntry() makes from raw bytes
+     */
+    static qsizetype decodedSizeHint(const FileEntry& entry, const QByteArray& raw);
+    
+    /**
+     * @brief readEntryRaw() for many entries at once
+     * 
+     * With io_uring, the first block of every entry is read in one batch
+     * and their extra blocks in a second, straight into the buffers; old
+     * format entries are read one by one. Otherwise this is a loop over
+     * readEntryRaw().
+     * @param out One buffer per entry, resized in place so capacity is reused
+     * @return Number of entries read; failed ones are left empty
+     */
+    size_t readEntriesRaw(std::span<const FileEntry> entries, std::vector<QByteArray>& out);
+    
+    /**
+     * @brief List every file entry in the archive
+     * 
+     * Served from the flat index when one is loaded, otherwise by walking
+     * the whole B-tree.
+     */
+    std::vector<FileEntry> listEntries();
+    
+    /**
+     * @brief Get the size of the archive file in bytes
+     */
+    qint64 fileSize() const { return m_file.size(); }
+    
+    /**
+     * @brief Load many files at once, spreading the work over the thread pool
+     * @param fileIds The data IDs to load
+     * @return One entry per requested ID, in the same order (empty if not found)
+     */
+    std::vector<QByteArray> loadDataBatch(std::span<const uint64_t> fileIds);
+    
+    /**
+     * @brief Ask the OS to page in the archive's hot regions ahead of use
+     * 
+     * Covers the superblock, the root directory, the flat index and the
+     * first block of each listed entry. Uses madvise/posix_fadvise where
+     * available and plain reads elsewhere; safe to run on a worker thread
+     * while the archive is being read.
+     * @param fileIds Entries expected to be loaded soon
+     */
+    void prewarm(std::span<const uint64_t> fileIds);
+    
     /**
      * @brief Get the input file path
      */
@@ -62,18 +233,41 @@ private:
     // Read the superblock (header) and return root node offset
     int readSuperBlock();
     
-    // Read a directory entry from the given offset
-    void readDirectory(DirectoryEntryPtr entry);
+    // Read a directory node from its offset into the arena
+    void readDirectory(uint32_t node);
     
     // Ensure a directory is loaded
-    void ensureLoaded(DirectoryEntryPtr entry);
+    void ensureLoaded(uint32_t node);
+    
+    // Find a file entry by ID using binary search, descending from a node;
+    // foundNode receives the directory holding it
+    const FileEntry* getFileById(uint32_t node, uint64_t fileId, uint32_t* foundNode = nullptr);
+    
+    // Whether the block at an offset is new-format with no extra blocks
+    bool isSingleBlock(uint64_t offset);
+    
+    // Map the flat index from the index directory, building it if needed
+    void loadOrBuildIndex();
     
-    // Find a file entry by ID using binary search
-    FileEntry* getFileById(DirectoryEntryPtr dir, uint64_t fileId);
+    // Recursively collect every file entry below a directory
+    void collectEntries(uint32_t node, std::vector<DatIndexRecord>& records);
+    
+    // Hint that a byte range of the archive will be read soon
+    void adviseWillNeed(uint64_t offset, qint64 length);
+    
+    // Read raw bytes at an absolute offset, returns the number of bytes copied
+    qint64 readAt(uint64_t offset, char* dest, qint64 length);
     
     // Read a block of data
     QByteArray readBlockAt(uint64_t offset, int blockSize, int size);
-    QByteArray readOldBlockAt(uint64_t offset, int blockSize, int totalSize);
+    bool readBlockInto(uint64_t offset, int blockSize, int size, QByteArray& result);
+    bool readOldBlockInto(uint64_t offset, int blockSize, int totalSize, QByteArray& result);
+    
+    // Pointer to a block's payload inside the mapping, if it is stored contiguously
+    const char* mappedBlock(uint64_t offset, int blockSize, int size) const;
+    
+    // Streaming zlib inflate into a reusable buffer
+    static bool inflateInto(const char* source, qsizetype sourceSize, qsizetype sizeHint, QByteArray& out);
     
     // Load an entry's data
     QByteArray loadEntry(const FileEntry& entry);
@@ -81,17 +275,32 @@ private:
 private:
     QString m_path;
     QFile m_file;
+    uchar* m_map = nullptr;
+    qint64 m_mapSize = 0;
+    bool m_useMemoryMap = true;
+    bool m_wantIoUring = false;
+    bool m_ioUring = false;
+    QMutex m_fileMutex;      // guards the QFile cursor when pread/mmap is unavailable
+    QMutex m_directoryMutex; // guards lazy directory loading
     int m_blockSize = 0;
+    int m_superblockVersion = 0;
     int m_datPackVersion = 0;
-    DirectoryEntryPtr m_rootEntry;
-    QMap<uint64_t, DirectoryEntryPtr> m_loadedDirs;
+    int m_rootOffset = 0;
+    DirectoryArena m_directories; // node 0 is the root once open
+    QString m_indexDirectory;
+    DatIndex m_index;
     
     static constexpr int MAGIC = 21570;
     static constexpr int MAX_ENTRIES = 61;
     static constexpr int ENTRY_RAW_SIZE = 32;
     static constexpr int POINTER_RAW_SIZE = 8;
     static constexpr int DIRECTORY_RAW_SIZE = 2452;
+    static constexpr int ROOT_BLOCK_SIZE = 2460;
+    static constexpr qint64 SUPERBLOCK_REGION_SIZE = 1024;
+    static constexpr uint32_t ROOT_NODE = 0;
     static constexpr int BASE_FILE_ENTRIES_OFFSET = 496;
+    static constexpr qsizetype MAX_INFLATE_HINT = 256 * 1024 * 1024;
+    static constexpr qsizetype MAX_SCRATCH_CAPACITY = 16 * 1024 * 1024;
 };
 
 } // namespace lotro::dat
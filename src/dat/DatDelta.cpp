@@ -0,0 +1,165 @@
+/**
+ * @file DatDelta.cpp
+ * @brief Implementation of entry-level DAT patching
+ */
+
+#include "DatDelta.hpp"
+#include "DatIndex.hpp"
+#include "DatPatchWriter.hpp"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QList>
+#include <QtEndian>
+#include <spdlog/spdlog.h>
+
+namespace lotro::dat {
+
+namespace {
+
+bool fail(QString* error, const QString& message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+} // namespace
+
+bool DatDelta::parseListing(const QByteArray& data, std::vector<DatRemoteEntry>& entries, QString* error) {
+    entries.clear();
+    int lineNumber = 0;
+    for (const QByteArray& raw : data.split('\n')) {
+        ++lineNumber;
+        const QByteArray line = raw.trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        
+        const QList<QByteArray> fields = line.simplified().split(' ');
+        bool ok[5] = {};
+        DatRemoteEntry entry;
+        if (fields.size() == 7) {
+            entry.fileId = fields[0].toULongLong(&ok[0], 16);
+            entry.version = fields[1].toInt(&ok[1]);
+            entry.timestamp = fields[2].toULongLong(&ok[2]);
+            entry.flags = fields[3].toInt(&ok[3], 16);
+            entry.size = fields[4].toInt(&ok[4]);
+            entry.md5 = QString::fromLatin1(fields[5]).toLower();
+            entry.url = QString::fromUtf8(fields[6]);
+        }
+        if (fields.size() != 7 || !(ok[0] && ok[1] && ok[2] && ok[3] && ok[4]) || entry.size < 0) {
+            return fail(error, QString("Malformed iteration entry on line %1").arg(lineNumber));
+        }
+        entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+DatDeltaPlan DatDelta::plan(DatArchive& archive, const std::vector<DatRemoteEntry>& remote) {
+    DatDeltaPlan plan;
+    for (const DatRemoteEntry& entry : remote) {
+        std::optional<FileEntry> local = archive.findEntry(entry.fileId);
+        if (!local) {
+            plan.fallback = QString("entry %1 is new").arg(entry.fileId, 8, 16, QChar('0'));
+            break;
+        }
+        if (local->version() >= entry.version) {
+            ++plan.unchanged;
+            continue;
+        }
+        
+        std::optional<DatEntrySlot> slot = archive.locateEntry(entry.fileId);
+        if (!slot || slot->recordOffset == 0 || entry.size > slot->capacity) {
+            plan.fallback = QString("entry %1 doesn't fit in place").arg(entry.fileId, 8, 16, QChar('0'));
+            break;
+        }
+        plan.changed.push_back(entry);
+        plan.slots.push_back(*slot);
+        plan.bytes += entry.size;
+    }
+    
+    if (!plan.inPlace()) {
+        plan.changed.clear();
+        plan.slots.clear();
+        plan.bytes = 0;
+    }
+    return plan;
+}
+
+bool DatDelta::apply(const QString& archivePath, const DatDeltaPlan& plan,
+                     const std::function<bool(size_t, QByteArray&)>& load,
+                     const QString& indexDirectory, bool* written, QString* error) {
+    if (written) {
+        *written = false;
+    }
+    if (!plan.inPlace()) {
+        return fail(error, plan.fallback);
+    }
+    
+    // Everything that can fail short of I/O happens before the first write.
+    // Each entry is staged under its single-block header.
+    std::vector<QByteArray> blocks(plan.changed.size());
+    QByteArray data;
+    for (size_t i = 0; i < plan.changed.size(); ++i) {
+        const DatRemoteEntry& entry = plan.changed[i];
+        if (!load(i, data)) {
+            return fail(error, QString("Could not fetch entry %1").arg(entry.fileId, 8, 16, QChar('0')));
+        }
+        if (data.size() != entry.size
+            || (!entry.md5.isEmpty()
+                && QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex() != entry.md5.toLatin1())) {
+            return fail(error, QString("Entry %1 doesn't match the listing").arg(entry.fileId, 8, 16, QChar('0')));
+        }
+        blocks[i].reserve(8 + data.size());
+        blocks[i].fill('\0', 8);
+        blocks[i].append(data);
+    }
+    
+    DatPatchWriter writer(archivePath);
+    if (!writer.open()) {
+        return fail(error, writer.errorString());
+    }
+    if (!indexDirectory.isEmpty()) {
+        QFile::remove(DatIndex::pathFor(indexDirectory, archivePath));
+    }
+    if (written) {
+        *written = true;
+    }
+    
+    // Data first, then the records pointing at it
+    for (size_t i = 0; i < plan.changed.size(); ++i) {
+        if (!writer.write(plan.slots[i].entry.fileOffset(), blocks[i])) {
+            return fail(error, writer.errorString());
+        }
+        blocks[i] = QByteArray();
+    }
+    if (!writer.flush()) {
+        return fail(error, writer.errorString());
+    }
+    
+    for (size_t i = 0; i < plan.changed.size(); ++i) {
+        const DatRemoteEntry& entry = plan.changed[i];
+        const uint64_t record = plan.slots[i].recordOffset;
+        
+        char flags[2];
+        qToLittleEndian<quint16>(static_cast<quint16>(entry.flags), flags);
+        char fields[12];    // size, timestamp, version
+        qToLittleEndian<quint32>(static_cast<quint32>(entry.size), fields);
+        qToLittleEndian<quint32>(static_cast<quint32>(entry.timestamp), fields + 4);
+        qToLittleEndian<quint32>(static_cast<quint32>(entry.version), fields + 8);
+        if (!writer.write(record, flags, sizeof(flags)) || !writer.write(record + 12, fields, sizeof(fields))) {
+            return fail(error, writer.errorString());
+        }
+    }
+    if (!writer.close()) {
+        return fail(error, writer.errorString());
+    }
+    
+    spdlog::info("Patched {} entries of {} in place ({} bytes, {} syncs)", plan.changed.size(),
+                 QFileInfo(archivePath).fileName().toStdString(), writer.bytesWritten(), writer.syncCount());
+    return true;
+}
+
+} // namespace lotro::dat
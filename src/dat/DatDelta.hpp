@@ -0,0 +1,97 @@
+/**
+ * @file DatDelta.hpp
+ * @brief Entry-level patching of DAT archives from iteration data
+ * 
+ * When the patch server publishes, for an archive, the current version
+ * of every entry (its "iteration listing"), only the entries whose
+ * version moved need to be fetched. This compares a listing against the
+ * archive's flat index and writes the changed entries into the archive
+ * in place.
+ */
+
+#pragma once
+
+#include "DatArchive.hpp"
+
+#include <QByteArray>
+#include <QString>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace lotro::dat {
+
+/**
+ * @brief One entry as the server has it
+ */
+struct DatRemoteEntry {
+    uint64_t fileId = 0;
+    int version = 0;
+    uint64_t timestamp = 0;
+    int flags = 0;
+    int size = 0;           // Stored (possibly compressed) size
+    QString md5;            // Of the stored bytes
+    QString url;            // Relative to the listing
+};
+
+/**
+ * @brief What it takes to bring an archive up to a listing
+ */
+struct DatDeltaPlan {
+    std::vector<DatRemoteEntry> changed;   // Newer on the server, in listing order
+    std::vector<DatEntrySlot> slots;       // Where each changed entry goes, same order
+    size_t unchanged = 0;
+    qint64 bytes = 0;                      // Total stored size of the changed entries
+    QString fallback;                      // Why the whole file is needed instead; empty if not
+    
+    bool inPlace() const { return fallback.isEmpty(); }
+};
+
+/**
+ * @class DatDelta
+ * @brief Plans and applies entry-level archive patches
+ */
+class DatDelta {
+public:
+    /**
+     * @brief Parse an iteration listing
+     * 
+     * One entry per line, fields separated by whitespace:
+     * "<fileId hex> <version> <timestamp> <flags hex> <size> <md5> <url>".
+     * Blank lines and lines starting with '#' are skipped.
+     * @return false (with the failing line in error) on malformed input
+     */
+    static bool parseListing(const QByteArray& data, std::vector<DatRemoteEntry>& entries,
+                             QString* error = nullptr);
+    
+    /**
+     * @brief Compare a listing with an open archive
+     * 
+     * Versions are compared through the flat index when one is loaded.
+     * The plan falls back to a whole-file patch if the listing adds an
+     * entry, or if a changed entry doesn't fit the block it occupies now.
+     */
+    static DatDeltaPlan plan(DatArchive& archive, const std::vector<DatRemoteEntry>& remote);
+    
+    /**
+     * @brief Write a plan's entries into a closed archive
+     * 
+     * Every entry is loaded and checked against the listing before the
+     * archive is opened, so a missing or bad entry fails the patch with
+     * the archive untouched. After that, only I/O can fail. The new data
+     * goes over each entry's current block, and is synced before any
+     * directory record changes. So a failure or crash once writing has
+     * started leaves an archive whose blocks and records disagree. The
+     * caller must then treat the archive as damaged and replace it whole.
+     * The archive's flat index is removed from the index directory before
+     * the first write, since in-place writes leave its key unchanged.
+     * @param load Fills in the stored bytes of plan.changed[i]
+     * @param written Set once the archive has been written to, whether or
+     *        not the patch then succeeds
+     */
+    static bool apply(const QString& archivePath, const DatDeltaPlan& plan,
+                      const std::function<bool(size_t, QByteArray&)>& load,
+                      const QString& indexDirectory, bool* written = nullptr, QString* error = nullptr);
+};
+
+} // namespace lotro::dat
@@ -0,0 +1,382 @@
+/**
+ * @file DatExtractor.cpp
+ * @brief Implementation of the bulk DAT extractor
+ */
+
+#include "DatExtractor.hpp"
+#include "DatArchive.hpp"
+#include "DatIndex.hpp"
+#include "core/TaskScheduler.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSet>
+#include <QWaitCondition>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <spdlog/spdlog.h>
+
+namespace lotro::dat {
+
+namespace {
+
+// Entries and stored bytes read per batch; the budget may be overrun by one batch
+constexpr size_t READ_BATCH = 64;
+constexpr qint64 READ_BATCH_BYTES = 4 * 1024 * 1024;
+
+bool parseNumber(const QString& text, uint64_t& value) {
+    bool ok = false;
+    value = text.trimmed().toULongLong(&ok, 0);
+    return ok;
+}
+
+/**
+ * Destination for extracted entries; used from the writer thread only
+ */
+class ExtractSink {
+public:
+    virtual ~ExtractSink() = default;
+    virtual bool write(const QString& name, const QByteArray& data) = 0;
+    virtual bool finish() = 0;
+};
+
+class DirectorySink : public ExtractSink {
+public:
+    explicit DirectorySink(const QString& root) : m_root(root) {}
+    
+    bool write(const QString& name, const QByteArray& data) override {
+        QString path = m_root.filePath(name);
+        QString dir = QFileInfo(path).path();
+        if (!m_created.contains(dir)) {
+            if (!QDir().mkpath(dir)) {
+                return false;
+            }
+            m_created.insert(dir);
+        }
+        QFile file(path);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            && file.write(data) == data.size();
+    }
+    
+    bool finish() override { return true; }
+    
+private:
+    QDir m_root;
+    QSet<QString> m_created;
+};
+
+/**
+ * ustar stream: a 512-byte header per entry, data padded to 512 bytes,
+ * and two zero blocks at the end
+ */
+class TarSink : public ExtractSink {
+public:
+    explicit TarSink(const QString& path)
+        : m_file(path)
+        , m_mtime(QDateTime::currentSecsSinceEpoch())
+    {
+    }
+    
+    bool open() { return m_file.open(QIODevice::WriteOnly | QIODevice::Truncate); }
+    
+    bool write(const QString& name, const QByteArray& data) override {
+        QByteArray header = makeHeader(name.toUtf8(), data.size());
+        if (m_file.write(header) != header.size() || m_file.write(data) != data.size()) {
+            return false;
+        }
+        qsizetype padding = (BLOCK - data.size() % BLOCK) % BLOCK;
+        return padding == 0 || m_file.write(QByteArray(padding, '\0')) == padding;
+    }
+    
+    bool finish() override {
+        bool ok = m_file.write(QByteArray(2 * BLOCK, '\0')) == 2 * BLOCK;
+        m_file.close();
+        return ok && m_file.error() == QFileDevice::NoError;
+    }
+    
+private:
+    QByteArray makeHeader(const QByteArray& name, qint64 size) const {
+        QByteArray header(BLOCK, '\0');
+        char* h = header.data();
+        std::memcpy(h, name.constData(), std::min<qsizetype>(name.size(), 100));
+        std::snprintf(h + 100, 8, "%07o", 0644u);
+        std::snprintf(h + 108, 8, "%07o", 0u);
+        std::snprintf(h + 116, 8, "%07o", 0u);
+        std::snprintf(h + 124, 12, "%011llo", static_cast<unsigned long long>(size));
+        std::snprintf(h + 136, 12, "%011llo", static_cast<unsigned long long>(m_mtime));
+        h[156] = '0';
+        std::memcpy(h + 257, "ustar", 6);
+        std::memcpy(h + 263, "00", 2);
+        
+        // Checksum over the header with the checksum field read as spaces
+        std::memset(h + 148, ' ', 8);
+        unsigned sum = 0;
+        for (int i = 0; i < BLOCK; ++i) {
+            sum += static_cast<unsigned char>(h[i]);
+        }
+        std::snprintf(h + 148, 8, "%06o", sum);
+        h[155] = ' ';
+        return header;
+    }
+    
+    static constexpr qsizetype BLOCK = 512;
+    
+    QFile m_file;
+    qint64 m_mtime;
+};
+
+} // namespace
+
+bool DatExtractSelection::matches(uint64_t dataId) const {
+    if (isEmpty() || types.test((dataId >> 24) & 0xFF)) {
+        return true;
+    }
+    return std::any_of(ranges.begin(), ranges.end(), [dataId](const auto& range) {
+        return dataId >= range.first && dataId <= range.second;
+    });
+}
+
+std::optional<DatExtractSelection> DatExtractSelection::parse(const QStringList& specs, QString* error) {
+    DatExtractSelection selection;
+    for (const QString& spec : specs) {
+        for (const QString& term : spec.split(',', Qt::SkipEmptyParts)) {
+            uint64_t first = 0;
+            uint64_t last = 0;
+            int dash = term.indexOf('-');
+            bool ok = dash < 0
+                ? parseNumber(term, first)
+                : parseNumber(term.left(dash), first) && parseNumber(term.mid(dash + 1), last);
+            
+            if (ok && dash < 0 && first <= 0xFF) {
+                selection.types.set(first);
+                continue;
+            }
+            if (dash < 0) {
+                last = first;
+            }
+            if (!ok || last < first) {
+                if (error) {
+                    *error = term.trimmed();
+                }
+                return std::nullopt;
+            }
+            selection.ranges.emplace_back(first, last);
+        }
+    }
+    return selection;
+}
+
+DatExtractor::DatExtractor(const QString& gamePath)
+    : m_gamePath(gamePath)
+{
+}
+
+DatExtractReport DatExtractor::run(const DatExtractSelection& selection, const DatExtractOptions& options,
+                                   ProgressCallback callback) {
+    m_cancelled = false;
+    
+    DatExtractReport report;
+    QElapsedTimer timer;
+    timer.start();
+    
+    // Stage 1: look the selection up in every archive's index
+    struct Job {
+        DatArchive* archive;
+        QString prefix;
+        FileEntry entry;
+    };
+    std::vector<std::unique_ptr<DatArchive>> archives;
+    std::vector<Job> jobs;
+    
+    QDir gameDir(m_gamePath);
+    for (const QFileInfo& fi : gameDir.entryInfoList({"*.dat"}, QDir::Files, QDir::Name)) {
+        auto archive = std::make_unique<DatArchive>(fi.absoluteFilePath());
+        archive->setIndexDirectory(DatIndex::defaultDirectory());
+        archive->setIoUring(options.ioUring);
+        if (!archive->open()) {
+            spdlog::error("Extract: cannot open {}", fi.fileName().toStdString());
+            continue;
+        }
+        report.archivesOpened++;
+        
+        size_t first = jobs.size();
+        QString prefix = fi.completeBaseName() + '/';
+        for (const FileEntry& entry : archive->listEntries()) {
+            if (selection.matches(entry.fileId())) {
+                jobs.push_back({archive.get(), prefix, entry});
+            }
+        }
+        
+        // Offset order keeps each archive's reads close to sequential
+        std::sort(jobs.begin() + static_cast<std::ptrdiff_t>(first), jobs.end(), [](const Job& a, const Job& b) {
+            return a.entry.fileOffset() < b.entry.fileOffset();
+        });
+        archives.push_back(std::move(archive));
+    }
+    report.entriesSelected = jobs.size();
+    
+    std::unique_ptr<ExtractSink> sink;
+    if (options.outputPath.endsWith(QLatin1String(".tar"), Qt::CaseInsensitive)) {
+        auto tar = std::make_unique<TarSink>(options.outputPath);
+        if (tar->open()) {
+            sink = std::move(tar);
+        }
+    } else if (QDir().mkpath(options.outputPath)) {
+        sink = std::make_unique<DirectorySink>(options.outputPath);
+    }
+    if (!sink) {
+        spdlog::error("Extract: cannot write to {}", options.outputPath.toStdString());
+        report.outputFailed = true;
+        report.elapsedMs = timer.elapsed();
+        return report;
+    }
+    
+    // Shared between the reader, the inflate tasks and the writer
+    struct Result {
+        QString name;
+        QByteArray data;
+        size_t charge = 0;
+        bool ok = false;
+    };
+    QMutex mutex;
+    QWaitCondition budgetFreed;
+    QWaitCondition resultReady;
+    std::deque<Result> results;
+    size_t inFlight = 0;
+    size_t pendingDecodes = 0;
+    bool readingDone = false;
+    DatExtractProgress progress;
+    progress.totalEntries = jobs.size();
+    
+    // Stage 4: a single writer drains decoded entries in completion order
+    auto writer = TaskScheduler::instance().run(TaskPool::Io, [&]() {
+        for (;;) {
+            Result result;
+            {
+                QMutexLocker lock(&mutex);
+                while (results.empty() && !(readingDone && pendingDecodes == 0)) {
+                    resultReady.wait(&mutex);
+                }
+                if (results.empty()) {
+                    return;
+                }
+                result = std::move(results.front());
+                results.pop_front();
+            }
+            
+            bool written = result.ok && !report.outputFailed && sink->write(result.name, result.data);
+            if (result.ok && !written && !report.outputFailed) {
+                spdlog::error("Extract: writing {} failed", result.name.toStdString());
+                report.outputFailed = true;
+                m_cancelled = true;
+            }
+            
+            DatExtractProgress snapshot;
+            {
+                QMutexLocker lock(&mutex);
+                inFlight -= result.charge;
+                budgetFreed.wakeAll();
+                if (written) {
+                    report.entriesWritten++;
+                    report.bytesWritten += static_cast<uint64_t>(result.data.size());
+                } else if (!result.ok) {
+                    report.entriesFailed++;
+                }
+                progress.entriesDone++;
+                progress.bytesWritten = report.bytesWritten;
+                snapshot = progress;
+            }
+            if (callback) {
+                callback(snapshot);
+            }
+        }
+    });
+    
+    // Stage 2: read on this thread in small batches of one archive (a
+    // single io_uring submission when enabled), within the memory budget
+    std::vector<FileEntry> batch;
+    std::vector<QByteArray> raws;
+    for (size_t begin = 0; begin < jobs.size() && !m_cancelled;) {
+        size_t end = begin;
+        qint64 batchBytes = 0;
+        batch.clear();
+        while (end < jobs.size() && jobs[end].archive == jobs[begin].archive
+               && batch.size() < READ_BATCH && batchBytes < READ_BATCH_BYTES) {
+            batch.push_back(jobs[end].entry);
+            batchBytes += jobs[end].entry.size();
+            ++end;
+        }
+        jobs[begin].archive->readEntriesRaw(batch, raws);
+        
+        for (size_t b = 0; b < batch.size(); ++b) {
+            const Job& job = jobs[begin + b];
+            QString name = job.prefix + QString::number(job.entry.fileId(), 16).rightJustified(8, '0').toUpper()
+                + QStringLiteral(".bin");
+            QByteArray raw = std::move(raws[b]);
+            bool read = !raw.isEmpty();
+            size_t charge = static_cast<size_t>(raw.size());
+            if (read && job.entry.isCompressed()) {
+                charge += static_cast<size_t>(DatArchive::decodedSizeHint(job.entry, raw));
+            }
+            
+            {
+                QMutexLocker lock(&mutex);
+                // An entry larger than the whole budget still goes through, alone
+                while (inFlight > 0 && inFlight + charge > options.memoryBudget) {
+                    budgetFreed.wait(&mutex);
+                }
+                inFlight += charge;
+                report.peakInFlightBytes = std::max(report.peakInFlightBytes, inFlight);
+                if (!read) {
+                    results.push_back({name, {}, charge, false});
+                    resultReady.wakeOne();
+                    continue;
+                }
+                report.bytesRead += static_cast<uint64_t>(raw.size());
+                pendingDecodes++;
+            }
+            
+            // Stage 3: inflate on the CPU pool
+            TaskScheduler::instance().run(TaskPool::Cpu, [&, name, charge, entry = job.entry, raw = std::move(raw)]() mutable {
+                Result result;
+                result.name = name;
+                result.charge = charge;
+                result.ok = DatArchive::decodeEntry(entry, raw, result.data);
+                
+                QMutexLocker lock(&mutex);
+                pendingDecodes--;
+                results.push_back(std::move(result));
+                resultReady.wakeOne();
+            });
+        }
+        begin = end;
+    }
+    
+    {
+        QMutexLocker lock(&mutex);
+        readingDone = true;
+        resultReady.wakeAll();
+    }
+    writer.waitForFinished();
+    
+    if (!sink->finish()) {
+        report.outputFailed = true;
+    }
+    report.cancelled = m_cancelled && !report.outputFailed;
+    report.elapsedMs = timer.elapsed();
+    
+    spdlog::info("DAT extraction {}: {} of {} entries written ({} failed), {} MB in {} ms, peak {} KB in flight",
+                 report.outputFailed ? "failed" : report.cancelled ? "cancelled" : "finished",
+                 report.entriesWritten, report.entriesSelected, report.entriesFailed,
+                 report.bytesWritten / (1024 * 1024), report.elapsedMs, report.peakInFlightBytes / 1024);
+    return report;
+}
+
+} // namespace lotro::dat
@@ -0,0 +1,123 @@
+/**
+ * @file DatExtractor.hpp
+ * @brief Bulk extraction of DAT entries to a directory or a tar file
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace lotro::dat {
+
+/**
+ * @brief Which data IDs to extract
+ * 
+ * An ID is selected if its type (high byte) is selected or it falls in
+ * one of the ranges; an empty selection selects everything.
+ */
+struct DatExtractSelection {
+    std::bitset<256> types;
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;   // Inclusive
+    
+    bool isEmpty() const { return types.none() && ranges.empty(); }
+    bool matches(uint64_t dataId) const;
+    
+    /**
+     * @brief Parse selection specs, each a comma-separated list of terms
+     * 
+     * A term is a type ("0x79", any value up to 0xFF), a single ID
+     * ("0x79000123") or an inclusive range ("0x79000000-0x7900FFFF").
+     * Numbers are decimal unless prefixed with 0x.
+     * @param error Receives the offending term on failure
+     */
+    static std::optional<DatExtractSelection> parse(const QStringList& specs, QString* error = nullptr);
+};
+
+/**
+ * @brief Where and how to write extracted entries
+ */
+struct DatExtractOptions {
+    QString outputPath;                 // A directory, or a file ending in .tar
+    size_t memoryBudget = 64 * 1024 * 1024;  // Read and decoded bytes not yet written
+    bool ioUring = false;               // Read through io_uring (see DatArchive::setIoUring)
+};
+
+/**
+ * @brief Progress of a running extraction
+ */
+struct DatExtractProgress {
+    uint64_t entriesDone = 0;           // Written or failed
+    uint64_t totalEntries = 0;          // Selected, across all archives
+    uint64_t bytesWritten = 0;
+};
+
+/**
+ * @brief Outcome of an extraction run
+ */
+struct DatExtractReport {
+    int archivesOpened = 0;
+    uint64_t entriesSelected = 0;
+    uint64_t entriesWritten = 0;
+    uint64_t entriesFailed = 0;         // Unreadable or undecodable
+    uint64_t bytesRead = 0;             // Stored (compressed) bytes
+    uint64_t bytesWritten = 0;          // Entry data, without tar framing
+    size_t peakInFlightBytes = 0;
+    qint64 elapsedMs = 0;
+    bool outputFailed = false;
+    bool cancelled = false;
+    
+    bool isComplete() const { return !outputFailed && !cancelled && entriesFailed == 0; }
+};
+
+/**
+ * @class DatExtractor
+ * @brief Dumps the selected entries of a game's DAT archives
+ * 
+ * Runs as a pipeline: the selected entries are looked up once in each
+ * archive's index and read in file-offset order, in small batches, on
+ * the calling thread; their stored bytes are inflated on the CPU pool,
+ * and a single writer
+ * drains the results into one file per entry (archive/XXXXXXXX.bin) or
+ * a tar stream with the same names. Reads block while the bytes read or
+ * decoded but not yet written exceed the memory budget, so memory stays
+ * bounded however many entries are selected, and disk reads, inflate
+ * and writes overlap instead of taking turns.
+ */
+class DatExtractor {
+public:
+    /**
+     * @brief Progress callback, invoked from the writer thread
+     */
+    using ProgressCallback = std::function<void(const DatExtractProgress&)>;
+    
+    /**
+     * @brief Extract from all archives in a game installation
+     * @param gamePath Path to the LOTRO installation directory
+     */
+    explicit DatExtractor(const QString& gamePath);
+    
+    /**
+     * @brief Run the extraction (blocks until done or cancelled)
+     */
+    DatExtractReport run(const DatExtractSelection& selection, const DatExtractOptions& options,
+                         ProgressCallback progress = nullptr);
+    
+    /**
+     * @brief Stop a running extraction after the entries in flight
+     */
+    void cancel() { m_cancelled = true; }
+    
+private:
+    QString m_gamePath;
+    std::atomic<bool> m_cancelled{false};
+};
+
+} // namespace lotro::dat
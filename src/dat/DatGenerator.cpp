@@ -0,0 +1,421 @@
+/**
+ * @file DatGenerator.cpp
+ * @brief Implementation of synthetic DAT archive generation
+ */
+
+#include "DatGenerator.hpp"
+
+#include <QFile>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+
+namespace lotro::dat {
+
+namespace {
+
+constexpr qint64 SUPERBLOCK_REGION_SIZE = 1024;
+constexpr int SUPERBLOCK_OFFSET = 320;
+constexpr int LP_MAGIC_OFFSET = 0x101;
+constexpr uint32_t MAGIC = 21570;
+constexpr uint32_t LP_MAGIC = 0x4C50;
+
+constexpr int POINTER_RAW_SIZE = 8;
+constexpr int BASE_FILE_ENTRIES_OFFSET = 496;
+constexpr int ENTRY_RAW_SIZE = 32;
+constexpr int COMPRESSED_FLAG = 0x100;
+
+constexpr qint64 MAX_ARCHIVE_SIZE = std::numeric_limits<uint32_t>::max();
+constexpr int RUN_LENGTH = 64;
+
+enum class Layout { Contiguous, ExtraBlocks, Legacy };
+
+struct PlannedEntry {
+    uint32_t fileId;
+    int size;
+    bool compressed;
+    Layout layout;
+};
+
+struct WrittenEntry {
+    uint32_t offset = 0;
+    int storedSize = 0;
+    int blockSize = 0;
+};
+
+struct DirectoryNode {
+    std::vector<uint32_t> entries;      // Positions in the plan
+    std::vector<uint32_t> children;     // Positions in the node list
+};
+
+void putWord(char* dest, int offset, uint16_t value) {
+    qToLittleEndian(value, dest + offset);
+}
+
+void putDword(char* dest, int offset, uint32_t value) {
+    qToLittleEndian(value, dest + offset);
+}
+
+qint64 alignUp(qint64 value, qint64 unit) {
+    return (value + unit - 1) / unit * unit;
+}
+
+bool chance(std::mt19937_64& rng, double probability) {
+    return static_cast<double>(rng() >> 11) * 0x1.0p-53 < probability;
+}
+
+// Generous bound on the bytes an entry takes, headers and padding included
+qint64 footprint(qint64 storedSize, int blockSize) {
+    return alignUp(storedSize + (storedSize / (blockSize - 16) + 2) * 8, blockSize) + blockSize;
+}
+
+// Entries a directory tree of this height holds
+uint64_t capacity(int height, int perNode) {
+    uint64_t total = perNode;
+    for (int h = 1; h < height; ++h) {
+        total = total * (perNode + 1) + perNode;
+    }
+    return total;
+}
+
+int heightFor(uint64_t count, int perNode) {
+    int height = 1;
+    while (capacity(height, perNode) < count) {
+        ++height;
+    }
+    return height;
+}
+
+// Lay out a balanced B-tree over plan positions [begin, end). Each child
+// range sits between two of its parent's entries, which is the order
+// DatArchive's search descends in.
+uint32_t buildNode(std::vector<DirectoryNode>& nodes, uint32_t begin, uint32_t end, int perNode) {
+    const auto index = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    
+    const uint64_t count = end - begin;
+    const int height = heightFor(count, perNode);
+    if (height == 1) {
+        for (uint32_t i = begin; i < end; ++i) {
+            nodes[index].entries.push_back(i);
+        }
+        return index;
+    }
+    
+    const uint64_t below = capacity(height - 1, perNode);
+    const auto childCount = static_cast<uint32_t>(
+        std::min<uint64_t>(perNode + 1, (count + 1 + below) / (below + 1)));
+    const auto spread = static_cast<uint32_t>(count - (childCount - 1));
+    
+    uint32_t next = begin;
+    for (uint32_t i = 0; i < childCount; ++i) {
+        const uint32_t share = spread / childCount + (i < spread % childCount ? 1 : 0);
+        const uint32_t child = buildNode(nodes, next, next + share, perNode);
+        nodes[index].children.push_back(child);
+        next += share;
+        if (i + 1 < childCount) {
+            nodes[index].entries.push_back(next++);
+        }
+    }
+    return index;
+}
+
+class ArchiveFile {
+public:
+    explicit ArchiveFile(const QString& path) : m_file(path) {}
+    
+    bool open() { return m_file.open(QIODevice::WriteOnly | QIODevice::Truncate); }
+    
+    bool writeAt(qint64 offset, const char* data, qint64 size) {
+        if (offset + size > MAX_ARCHIVE_SIZE) {
+            m_error = "Archive would exceed the format's 4 GiB limit";
+            return false;
+        }
+        if (!m_file.seek(offset) || m_file.write(data, size) != size) {
+            m_error = m_file.errorString();
+            return false;
+        }
+        return true;
+    }
+    
+    // A block header followed by data
+    bool writeBlock(qint64 offset, uint32_t first, uint32_t second, const char* data, qint64 size) {
+        char header[8];
+        putDword(header, 0, first);
+        putDword(header, 4, second);
+        return writeAt(offset, header, sizeof(header)) && writeAt(offset + 8, data, size);
+    }
+    
+    bool close() {
+        if (!m_file.flush()) {
+            m_error = m_file.errorString();
+            return false;
+        }
+        m_file.close();
+        return true;
+    }
+    
+    QString errorString() const { return m_error; }
+    
+private:
+    QFile m_file;
+    QString m_error;
+};
+
+} // namespace
+
+DatGenerator::DatGenerator(DatGeneratorOptions options)
+    : m_options(options)
+{
+}
+
+QByteArray DatGenerator::payload(const DatGeneratorOptions& options, uint32_t fileId, int size) {
+    std::mt19937_64 rng(options.seed ^ (static_cast<uint64_t>(fileId) * 0x9E3779B97F4A7C15ULL));
+    
+    // Random runs barely compress and repeated bytes almost vanish, so the
+    // share of random runs is roughly the compressed size
+    QByteArray data(size, Qt::Uninitialized);
+    char* out = data.data();
+    for (int position = 0; position < size; position += RUN_LENGTH) {
+        const int run = std::min(RUN_LENGTH, size - position);
+        if (chance(rng, options.compressionRatio)) {
+            for (int i = 0; i < run; i += 8) {
+                const uint64_t bits = rng();
+                std::memcpy(out + position + i, &bits, std::min(8, run - i));
+            }
+        } else {
+            std::memset(out + position, static_cast<int>(rng() & 0xFF), run);
+        }
+    }
+    return data;
+}
+
+bool DatGenerator::write(const QString& path) {
+    const DatGeneratorOptions& opt = m_options;
+    m_result = {};
+    m_error.clear();
+    
+    if (opt.entryCount == 0 && opt.targetSize <= 0) {
+        m_error = "Either an entry count or a target size is required";
+    } else if (opt.minPayloadSize < 1 || opt.maxPayloadSize < opt.minPayloadSize) {
+        m_error = "Payload sizes must satisfy 1 <= min <= max";
+    } else if (opt.blockSize < 256) {
+        m_error = "Block size must be at least 256 bytes";
+    } else if (opt.entriesPerDirectory < 2 || opt.entriesPerDirectory > MAX_DIRECTORY_ENTRIES) {
+        m_error = QString("Entries per directory must be between 2 and %1").arg(MAX_DIRECTORY_ENTRIES);
+    }
+    if (!m_error.isEmpty()) {
+        return false;
+    }
+    
+    // Plan every entry first, so the directory region can be sized before
+    // any data is written behind it
+    std::mt19937_64 rng(opt.seed);
+    const int sizeSpan = opt.maxPayloadSize - opt.minPayloadSize + 1;
+    std::vector<PlannedEntry> plan;
+    qint64 estimate = SUPERBLOCK_REGION_SIZE;
+    uint64_t nextId = opt.firstFileId;
+    
+    while ((opt.entryCount == 0 || plan.size() < opt.entryCount)
+           && (opt.targetSize <= 0 || estimate < opt.targetSize)
+           && nextId <= std::numeric_limits<uint32_t>::max()) {
+        PlannedEntry entry;
+        entry.fileId = static_cast<uint32_t>(nextId);
+        entry.size = opt.minPayloadSize + static_cast<int>(rng() % sizeSpan);
+        entry.compressed = chance(rng, opt.compressedFraction);
+        
+        const double roll = static_cast<double>(rng() >> 11) * 0x1.0p-53;
+        entry.layout = roll < opt.oldFormatFraction ? Layout::Legacy
+            : roll < opt.oldFormatFraction + opt.extraBlockFraction ? Layout::ExtraBlocks
+            : Layout::Contiguous;
+        
+        // Worst case for the format limit, expected size for the target;
+        // both count a share of directory nodes at least half full
+        const qint64 bound = entry.compressed ? compressBound(entry.size) + 4 : entry.size;
+        const qint64 expected = entry.compressed ? static_cast<qint64>(entry.size * opt.compressionRatio) + 4 : entry.size;
+        const qint64 directoryShare = 2 * DIRECTORY_BLOCK_SIZE / opt.entriesPerDirectory;
+        if (estimate + footprint(bound, opt.blockSize) + directoryShare + DIRECTORY_BLOCK_SIZE > MAX_ARCHIVE_SIZE) {
+            break;
+        }
+        estimate += footprint(expected, opt.blockSize) + directoryShare;
+        
+        plan.push_back(entry);
+        nextId += 1 + rng() % 16;
+    }
+    
+    std::vector<DirectoryNode> nodes;
+    buildNode(nodes, 0, static_cast<uint32_t>(plan.size()), opt.entriesPerDirectory);
+    
+    ArchiveFile file(path);
+    if (!file.open()) {
+        m_error = QString("Could not create %1").arg(path);
+        return false;
+    }
+    
+    // Directory nodes in build order from just past the superblock, so the
+    // root comes first
+    const qint64 directoryStart = SUPERBLOCK_REGION_SIZE;
+    auto nodeOffset = [&](uint32_t node) {
+        return static_cast<uint32_t>(directoryStart + static_cast<qint64>(node) * DIRECTORY_BLOCK_SIZE);
+    };
+    qint64 position = alignUp(directoryStart + static_cast<qint64>(nodes.size()) * DIRECTORY_BLOCK_SIZE,
+                              opt.blockSize);
+    
+    // Data blocks
+    const int bs = opt.blockSize;
+    std::vector<WrittenEntry> written(plan.size());
+    m_result.entries.reserve(plan.size());
+    
+    for (size_t i = 0; i < plan.size(); ++i) {
+        const PlannedEntry& entry = plan[i];
+        const QByteArray data = payload(opt, entry.fileId, entry.size);
+        
+        GeneratedDatEntry generated;
+        generated.fileId = entry.fileId;
+        generated.size = entry.size;
+        generated.crc = static_cast<uint32_t>(crc32(0, reinterpret_cast<const Bytef*>(data.constData()),
+                                                    static_cast<uInt>(data.size())));
+        generated.compressed = entry.compressed;
+        
+        QByteArray stored = data;
+        if (entry.compressed) {
+            uLongf packedSize = compressBound(static_cast<uLong>(data.size()));
+            stored.resize(4 + static_cast<qsizetype>(packedSize));
+            putDword(stored.data(), 0, static_cast<uint32_t>(data.size()));
+            if (compress2(reinterpret_cast<Bytef*>(stored.data() + 4), &packedSize,
+                          reinterpret_cast<const Bytef*>(data.constData()),
+                          static_cast<uLong>(data.size()), Z_DEFAULT_COMPRESSION) != Z_OK) {
+                m_error = QString("Failed to compress entry %1").arg(entry.fileId, 8, 16, QChar('0'));
+                return false;
+            }
+            stored.resize(4 + static_cast<qsizetype>(packedSize));
+        }
+        
+        const int storedSize = static_cast<int>(stored.size());
+        const char* source = stored.constData();
+        WrittenEntry& out = written[i];
+        out.offset = static_cast<uint32_t>(position);
+        out.storedSize = storedSize;
+        bool ok = true;
+        
+        if (entry.layout == Layout::Legacy && storedSize > bs - 8) {
+            // A chain of full blocks read back to front: the first holds the
+            // end of the data and the last, with no successor, its start
+            const int chunk = bs - 8;
+            const int blocks = (storedSize + chunk - 1) / chunk;
+            for (int b = 0; b < blocks && ok; ++b) {
+                const qint64 blockOffset = position + static_cast<qint64>(b) * bs;
+                if (b + 1 < blocks) {
+                    const int end = storedSize - b * chunk;
+                    ok = file.writeBlock(blockOffset, bs, static_cast<uint32_t>(blockOffset + bs),
+                                         source + end - chunk, chunk);
+                } else {
+                    ok = file.writeBlock(blockOffset, 0, 0, source, storedSize - b * chunk);
+                }
+            }
+            out.blockSize = bs;
+            generated.oldFormat = true;
+            position += static_cast<qint64>(blocks) * bs;
+        } else if (entry.layout == Layout::ExtraBlocks && storedSize > bs - 16) {
+            // A first block ending in pointers to headerless extra blocks
+            const int maxExtra = (bs - 16) / POINTER_RAW_SIZE;
+            int extra = 1;
+            while (extra < maxExtra && bs - 8 - extra * POINTER_RAW_SIZE + extra * bs < storedSize) {
+                ++extra;
+            }
+            const int first = bs - 8 - extra * POINTER_RAW_SIZE;
+            const int extraSize = std::max(bs, (storedSize - first + extra - 1) / extra);
+            
+            QByteArray block(bs - 8, '\0');
+            std::memcpy(block.data(), source, first);
+            qint64 extraOffset = position + bs;
+            int index = first;
+            for (int e = 0; e < extra && ok; ++e) {
+                const int length = std::min(extraSize, storedSize - index);
+                putDword(block.data(), first + e * POINTER_RAW_SIZE, static_cast<uint32_t>(length));
+                putDword(block.data(), first + e * POINTER_RAW_SIZE + 4, static_cast<uint32_t>(extraOffset));
+                ok = file.writeAt(extraOffset, source + index, length);
+                index += length;
+                extraOffset = alignUp(extraOffset + length, bs);
+            }
+            ok = ok && file.writeBlock(position, static_cast<uint32_t>(extra), 0, block.constData(), block.size());
+            out.blockSize = bs;
+            generated.extraBlocks = extra;
+            position = extraOffset;
+        } else {
+            out.blockSize = static_cast<int>(alignUp(8 + storedSize, bs));
+            ok = file.writeBlock(position, 0, 0, source, storedSize);
+            position += out.blockSize;
+        }
+        
+        if (!ok) {
+            m_error = file.errorString();
+            return false;
+        }
+        m_result.entries.push_back(generated);
+    }
+    
+    // Directory nodes
+    QByteArray block(DIRECTORY_BLOCK_SIZE - 8, '\0');
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        const DirectoryNode& node = nodes[n];
+        block.fill('\0');
+        char* raw = block.data();
+        
+        for (size_t c = 0; c < node.children.size(); ++c) {
+            const int at = static_cast<int>(c) * POINTER_RAW_SIZE;
+            putDword(raw, at, DIRECTORY_BLOCK_SIZE);
+            putDword(raw, at + 4, nodeOffset(node.children[c]));
+        }
+        putDword(raw, BASE_FILE_ENTRIES_OFFSET, static_cast<uint32_t>(node.entries.size()));
+        
+        for (size_t e = 0; e < node.entries.size(); ++e) {
+            const PlannedEntry& entry = plan[node.entries[e]];
+            const WrittenEntry& out = written[node.entries[e]];
+            const int at = BASE_FILE_ENTRIES_OFFSET + 4 + static_cast<int>(e) * ENTRY_RAW_SIZE;
+            putWord(raw, at, static_cast<uint16_t>(entry.compressed ? COMPRESSED_FLAG : 0));
+            putWord(raw, at + 2, 0);
+            putDword(raw, at + 4, entry.fileId);
+            putDword(raw, at + 8, out.offset);
+            putDword(raw, at + 12, static_cast<uint32_t>(out.storedSize));
+            putDword(raw, at + 16, 0);
+            putDword(raw, at + 20, 1);
+            putDword(raw, at + 24, static_cast<uint32_t>(out.blockSize));
+        }
+        
+        if (!file.writeBlock(nodeOffset(n), 0, 0, block.constData(), block.size())) {
+            m_error = file.errorString();
+            return false;
+        }
+    }
+    
+    // Superblock, with the magic both DatArchive and DatFile check
+    char superblock[SUPERBLOCK_REGION_SIZE] = {};
+    putDword(superblock, LP_MAGIC_OFFSET, LP_MAGIC);
+    char* sb = superblock + SUPERBLOCK_OFFSET;
+    putDword(sb, 0, MAGIC);
+    putDword(sb, 4, static_cast<uint32_t>(bs));
+    putDword(sb, 8, static_cast<uint32_t>(position));
+    putDword(sb, 12, static_cast<uint32_t>(opt.version));
+    putDword(sb, 32, nodeOffset(0));
+    putDword(sb, 52, static_cast<uint32_t>(opt.datPackVersion));
+    
+    if (!file.writeAt(0, superblock, sizeof(superblock)) || !file.close()) {
+        m_error = file.errorString();
+        return false;
+    }
+    
+    m_result.fileSize = position;
+    m_result.directoryDepth = heightFor(plan.size(), opt.entriesPerDirectory);
+    m_result.directoryCount = static_cast<int>(nodes.size());
+    
+    spdlog::info("Generated DAT archive: {} ({} entries, {} bytes, directory depth {})",
+                 path.toStdString(), plan.size(), position, m_result.directoryDepth);
+    return true;
+}
+
+} // namespace lotro::dat
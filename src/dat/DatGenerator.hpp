@@ -0,0 +1,114 @@
+/**
+ * @file DatGenerator.hpp
+ * @brief Writes synthetic DAT archives for tests and benchmarks
+ */
+
+#pragma once
+
+#include <QString>
+#include <cstdint>
+#include <vector>
+
+namespace lotro::dat {
+
+/**
+ * @brief Shape of an archive to generate
+ * 
+ * Entries are written until entryCount is reached or the archive grows
+ * past targetSize, whichever comes first; zero means no limit, but at
+ * least one of the two must be set. The archive format stores offsets
+ * in 32 bits, so archives stop short of 4 GiB regardless.
+ */
+struct DatGeneratorOptions {
+    uint64_t entryCount = 1000;
+    qint64 targetSize = 0;
+    
+    int minPayloadSize = 64;
+    int maxPayloadSize = 64 * 1024;
+    
+    int blockSize = 2048;               // Allocation unit of data blocks
+    int entriesPerDirectory = 61;       // 1..61; fewer means a deeper tree
+    
+    double oldFormatFraction = 0.0;     // Entries stored as legacy block chains
+    double extraBlockFraction = 0.0;    // Entries split over extra blocks
+    double compressedFraction = 0.5;    // Entries stored zlib-compressed
+    double compressionRatio = 0.4;      // Approximate compressed / raw size
+    
+    uint32_t firstFileId = 0x07000000;
+    uint64_t seed = 1;
+    
+    int version = 0x200;
+    int datPackVersion = 1;
+};
+
+/**
+ * @brief An entry written by DatGenerator and what reading it must return
+ */
+struct GeneratedDatEntry {
+    uint32_t fileId = 0;
+    int size = 0;                   // Of the payload, after inflating
+    uint32_t crc = 0;               // zlib crc32 of the payload
+    bool compressed = false;
+    bool oldFormat = false;
+    int extraBlocks = 0;
+};
+
+/**
+ * @brief What DatGenerator wrote
+ */
+struct GeneratedDat {
+    std::vector<GeneratedDatEntry> entries;     // Ascending by file ID
+    qint64 fileSize = 0;
+    int directoryDepth = 0;
+    int directoryCount = 0;
+};
+
+/**
+ * @class DatGenerator
+ * @brief Writes valid DAT archives of a chosen size and layout
+ * 
+ * Lets the archive, index, cache and verification code be exercised at
+ * any scale without shipping game data. Payloads are pseudo-random from
+ * the seed, mixing random and repeated runs to approach the requested
+ * compression ratio, and are streamed to disk one entry at a time, so
+ * multi-GB archives need no more memory than the directory tree.
+ * 
+ * The entries are planned before anything is written, so the directory
+ * B-tree can go in a region right after the superblock: the reader takes
+ * the root offset as a signed 32-bit value. Data blocks follow in file ID
+ * order, using every block layout DatArchive reads: contiguous new-format
+ * blocks, new-format blocks with extra blocks, and legacy chains whose
+ * first block holds the end of the data.
+ */
+class DatGenerator {
+public:
+    explicit DatGenerator(DatGeneratorOptions options = {});
+    
+    /**
+     * @brief Write a new archive, replacing any file at the path
+     * @return false on invalid options or a write error, see errorString()
+     */
+    bool write(const QString& path);
+    
+    /**
+     * @brief Entries and layout of the last archive written
+     */
+    const GeneratedDat& result() const { return m_result; }
+    
+    QString errorString() const { return m_error; }
+    
+    /**
+     * @brief The payload generated for an entry, to compare reads against
+     */
+    static QByteArray payload(const DatGeneratorOptions& options, uint32_t fileId, int size);
+    
+    static constexpr int DIRECTORY_BLOCK_SIZE = 2460;
+    static constexpr int MAX_DIRECTORY_ENTRIES = 61;
+    
+private:
+    DatGeneratorOptions m_options;
+    GeneratedDat m_result;
+    QString m_error;
+};
+
+} // namespace lotro::dat
@@ -0,0 +1,150 @@
+/**
+ * @file DatIndex.cpp
+ * @brief Implementation of the persistent flat file-ID index
+ */
+
+#include "DatIndex.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace lotro::dat {
+
+DatIndex::~DatIndex() {
+    close();
+}
+
+QString DatIndex::defaultDirectory() {
+    return QString::fromStdString((Platform::getCachePath() / "dat-index").string());
+}
+
+QString DatIndex::pathFor(const QString& indexDirectory, const QString& archivePath) {
+    QFileInfo info(archivePath);
+    return QDir(indexDirectory).filePath(
+        QString("%1-%2.idx").arg(info.completeBaseName())
+                            .arg(qHash(info.absoluteFilePath()), 8, 16, QChar('0')));
+}
+
+void DatIndex::close() {
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_ownedRecords.clear();
+    m_ownedRecords.shrink_to_fit();
+    m_records = nullptr;
+    m_count = 0;
+    m_key = {};
+}
+
+bool DatIndex::open(const QString& indexPath, const DatIndexKey& key) {
+    close();
+
+    m_file.setFileName(indexPath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    qint64 fileSize = m_file.size();
+    if (fileSize < static_cast<qint64>(sizeof(Header))) {
+        close();
+        return false;
+    }
+
+    m_map = m_file.map(0, fileSize);
+    if (!m_map) {
+        spdlog::warn("Failed to map DAT index {}", indexPath.toStdString());
+        close();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, m_map, sizeof(header));
+
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+        && header.formatVersion == FORMAT_VERSION
+        && header.superblockVersion == key.superblockVersion
+        && header.datPackVersion == key.datPackVersion
+        && header.archiveSize == key.archiveSize
+        && fileSize == static_cast<qint64>(sizeof(Header) + header.recordCount * sizeof(DatIndexRecord));
+
+    if (!valid) {
+        spdlog::info("DAT index {} is stale, it will be rebuilt", indexPath.toStdString());
+        close();
+        return false;
+    }
+
+    m_records = reinterpret_cast<const DatIndexRecord*>(m_map + sizeof(Header));
+    m_count = static_cast<size_t>(header.recordCount);
+    m_key = key;
+    spdlog::debug("Mapped DAT index {} ({} entries)", indexPath.toStdString(), m_count);
+    return true;
+}
+
+bool DatIndex::build(const QString& indexPath, const DatIndexKey& key,
+                     std::vector<DatIndexRecord> records) {
+    close();
+
+    std::sort(records.begin(), records.end(), [](const DatIndexRecord& a, const DatIndexRecord& b) {
+        return a.fileId < b.fileId;
+    });
+
+    m_ownedRecords = std::move(records);
+    m_records = m_ownedRecords.data();
+    m_count = m_ownedRecords.size();
+    m_key = key;
+
+    QDir().mkpath(QFileInfo(indexPath).absolutePath());
+
+    QSaveFile file(indexPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write DAT index {}: {}", indexPath.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.superblockVersion = key.superblockVersion;
+    header.datPackVersion = key.datPackVersion;
+    header.archiveSize = key.archiveSize;
+    header.recordCount = m_count;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_ownedRecords.data()),
+               static_cast<qint64>(m_count * sizeof(DatIndexRecord)));
+
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit DAT index {}", indexPath.toStdString());
+        return false;
+    }
+
+    spdlog::info("Wrote DAT index {} ({} entries)", indexPath.toStdString(), m_count);
+    return true;
+}
+
+const DatIndexRecord* DatIndex::find(uint64_t fileId) const {
+    if (!m_records) {
+        return nullptr;
+    }
+
+    const DatIndexRecord* end = m_records + m_count;
+    const DatIndexRecord* it = std::lower_bound(m_records, end, fileId,
+        [](const DatIndexRecord& record, uint64_t id) { return record.fileId < id; });
+
+    if (it != end && it->fileId == fileId) {
+        return it;
+    }
+    return nullptr;
+}
+
+} // namespace lotro::dat
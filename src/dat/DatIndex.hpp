@@ -0,0 +1,144 @@
+/**
+ * @file DatIndex.hpp
+ * @brief Persistent flat file-ID index for DAT archives
+ *
+ * A sorted array of fixed-size records, one per file entry, written to the
+ * cache directory after a one-time walk of the archive's B-tree. Later opens
+ * map the index file and binary-search it instead of descending the tree.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace lotro::dat {
+
+/**
+ * @brief One file entry in the flat index (32 bytes on disk)
+ */
+struct DatIndexRecord {
+    uint64_t fileId;
+    uint64_t offset;
+    uint32_t size;
+    uint32_t blockSize;
+    uint16_t flags;
+    uint16_t policy;
+    uint32_t version;
+};
+static_assert(sizeof(DatIndexRecord) == 32, "DatIndexRecord must stay 32 bytes");
+
+/**
+ * @brief Identifies the archive state an index was built from
+ *
+ * An index is only valid for the exact superblock version and file size
+ * it was built from; any patch changes at least one of them.
+ */
+struct DatIndexKey {
+    uint32_t superblockVersion = 0;
+    uint32_t datPackVersion = 0;
+    uint64_t archiveSize = 0;
+};
+
+/**
+ * @class DatIndex
+ * @brief Sorted, memory-mapped file-ID index
+ */
+class DatIndex {
+public:
+    DatIndex() = default;
+    ~DatIndex();
+
+    DatIndex(const DatIndex&) = delete;
+    DatIndex& operator=(const DatIndex&) = delete;
+
+    /**
+     * @brief Default directory for index files (inside the launcher cache)
+     */
+    static QString defaultDirectory();
+
+    /**
+     * @brief Path of the index file for an archive
+     *
+     * Includes a hash of the archive's absolute path so that several
+     * installations with identically named archives don't collide.
+     */
+    static QString pathFor(const QString& indexDirectory, const QString& archivePath);
+
+    /**
+     * @brief Map an existing index file
+     * @param indexPath Path of the index file
+     * @param key Expected archive state; the file is rejected on mismatch
+     * @return true if the index is usable
+     */
+    bool open(const QString& indexPath, const DatIndexKey& key);
+
+    /**
+     * @brief Adopt freshly collected records and persist them
+     *
+     * Records are sorted by file ID. If writing the file fails the index
+     * stays usable from memory for this session.
+     * @return true if the file was written
+     */
+    bool build(const QString& indexPath, const DatIndexKey& key,
+               std::vector<DatIndexRecord> records);
+
+    /**
+     * @brief Release the mapping and any in-memory records
+     */
+    void close();
+
+    /**
+     * @brief Check if the index holds records
+     */
+    bool isLoaded() const { return m_records != nullptr; }
+
+    /**
+     * @brief Binary-search for a file ID
+     * @return The record, or nullptr if the ID is not in the archive
+     */
+    const DatIndexRecord* find(uint64_t fileId) const;
+
+    /**
+     * @brief All records, sorted by file ID
+     */
+    std::span<const DatIndexRecord> records() const {
+        return {m_records, m_count};
+    }
+
+    /**
+     * @brief Number of file entries
+     */
+    size_t size() const { return m_count; }
+
+    /**
+     * @brief Key of the archive state this index describes
+     */
+    const DatIndexKey& key() const { return m_key; }
+
+private:
+    struct Header {
+        char magic[4];
+        uint32_t formatVersion;
+        uint32_t superblockVersion;
+        uint32_t datPackVersion;
+        uint64_t archiveSize;
+        uint64_t recordCount;
+    };
+    static_assert(sizeof(Header) == 32, "Header must stay 32 bytes");
+
+    static constexpr char MAGIC[4] = {'L', 'D', 'A', 'X'};
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    QFile m_file;
+    uchar* m_map = nullptr;
+    std::vector<DatIndexRecord> m_ownedRecords;
+    const DatIndexRecord* m_records = nullptr;
+    size_t m_count = 0;
+    DatIndexKey m_key;
+};
+
+} // namespace lotro::dat
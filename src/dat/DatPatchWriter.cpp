@@ -0,0 +1,136 @@
+/**
+ * @file DatPatchWriter.cpp
+ * @brief Implementation of batched in-place DAT writes
+ */
+
+#include "DatPatchWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+#ifdef PLATFORM_LINUX
+#include <unistd.h>
+#elif defined(PLATFORM_WINDOWS)
+#include <io.h>
+#endif
+
+namespace lotro::dat {
+
+DatPatchWriter::DatPatchWriter(const QString& path, qsizetype batchSize)
+    : m_file(path)
+    , m_buffer(std::max<qsizetype>(batchSize, 4096), Qt::Uninitialized)
+{
+}
+
+DatPatchWriter::~DatPatchWriter() {
+    close();
+}
+
+bool DatPatchWriter::open() {
+    // ReadWrite keeps the existing contents; WriteOnly would truncate
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        m_error = m_file.errorString();
+        spdlog::error("Failed to open DAT file for patching: {} ({})",
+                      m_file.fileName().toStdString(), m_error.toStdString());
+        return false;
+    }
+    return true;
+}
+
+bool DatPatchWriter::write(uint64_t offset, const char* data, qsizetype size) {
+    if (!m_file.isOpen() || size < 0 || offset + static_cast<uint64_t>(size) > static_cast<uint64_t>(m_file.size())) {
+        m_error = QString("Write of %1 bytes at %2 is outside the archive").arg(size).arg(offset);
+        return false;
+    }
+    if (size > m_buffer.size() - m_used && !flush()) {
+        return false;
+    }
+    if (size > m_buffer.size()) {
+        return writeAt(offset, data, size) && sync();
+    }
+    
+    std::memcpy(m_buffer.data() + m_used, data, static_cast<size_t>(size));
+    m_pending.push_back({offset, m_used, size});
+    m_used += size;
+    return true;
+}
+
+bool DatPatchWriter::flush() {
+    if (m_pending.empty()) {
+        return true;
+    }
+    
+    // Offset order turns scattered entry updates into one forward sweep;
+    // the sort is stable so overlapping writes still land in staging order
+    std::stable_sort(m_pending.begin(), m_pending.end(),
+                     [](const Pending& a, const Pending& b) { return a.offset < b.offset; });
+    
+    bool ok = true;
+    for (const Pending& pending : m_pending) {
+        if (!writeAt(pending.offset, m_buffer.constData() + pending.position, pending.size)) {
+            ok = false;
+            break;
+        }
+    }
+    m_pending.clear();
+    m_used = 0;
+    return ok && sync();
+}
+
+bool DatPatchWriter::close() {
+    if (!m_file.isOpen()) {
+        return true;
+    }
+    bool ok = flush();
+    m_file.close();
+    return ok;
+}
+
+bool DatPatchWriter::writeAt(uint64_t offset, const char* data, qsizetype size) {
+#ifdef PLATFORM_LINUX
+    qsizetype total = 0;
+    while (total < size) {
+        ssize_t n = ::pwrite(m_file.handle(), data + total, static_cast<size_t>(size - total),
+                             static_cast<off_t>(offset + total));
+        if (n <= 0) {
+            m_error = QString("Write failed at offset %1").arg(offset + total);
+            spdlog::error("Failed to write DAT file {}: {}", m_file.fileName().toStdString(), m_error.toStdString());
+            return false;
+        }
+        total += n;
+    }
+#else
+    if (!m_file.seek(static_cast<qint64>(offset)) || m_file.write(data, size) != size) {
+        m_error = m_file.errorString();
+        spdlog::error("Failed to write DAT file {}: {}", m_file.fileName().toStdString(), m_error.toStdString());
+        return false;
+    }
+#endif
+    m_bytesWritten += size;
+    return true;
+}
+
+bool DatPatchWriter::sync() {
+    if (!m_file.flush()) {
+        m_error = m_file.errorString();
+        return false;
+    }
+#ifdef PLATFORM_LINUX
+    if (::fdatasync(m_file.handle()) != 0) {
+        m_error = "fdatasync failed";
+        spdlog::error("Failed to sync DAT file {}", m_file.fileName().toStdString());
+        return false;
+    }
+#elif defined(PLATFORM_WINDOWS)
+    if (::_commit(m_file.handle()) != 0) {
+        m_error = "_commit failed";
+        spdlog::error("Failed to sync DAT file {}", m_file.fileName().toStdString());
+        return false;
+    }
+#endif
+    ++m_syncs;
+    return true;
+}
+
+} // namespace lotro::dat
@@ -0,0 +1,92 @@
+/**
+ * @file DatPatchWriter.hpp
+ * @brief Batched in-place writes into an existing DAT archive
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <cstdint>
+#include <vector>
+
+namespace lotro::dat {
+
+/**
+ * @class DatPatchWriter
+ * @brief Collects small positional writes and commits them in durable batches
+ * 
+ * Writes are copied into a buffer allocated once up front. When the buffer
+ * fills, or on flush(), the staged writes go to disk in offset order and
+ * the file is synced, so a patch touching thousands of entries costs a
+ * handful of syncs rather than one per entry. A write larger than the
+ * whole buffer is flushed ahead of the rest and goes straight through.
+ * 
+ * Only ever overwrites bytes inside the archive; it never grows or
+ * truncates the file.
+ */
+class DatPatchWriter {
+public:
+    explicit DatPatchWriter(const QString& path, qsizetype batchSize = DEFAULT_BATCH_SIZE);
+    ~DatPatchWriter();
+    
+    DatPatchWriter(const DatPatchWriter&) = delete;
+    DatPatchWriter& operator=(const DatPatchWriter&) = delete;
+    
+    /**
+     * @brief Open the archive for writing without truncating it
+     */
+    bool open();
+    
+    /**
+     * @brief Stage bytes to be written at an absolute offset
+     * @return false if the range lies outside the archive or a flush failed
+     */
+    bool write(uint64_t offset, const char* data, qsizetype size);
+    bool write(uint64_t offset, const QByteArray& data) { return write(offset, data.constData(), data.size()); }
+    
+    /**
+     * @brief Write everything staged so far and sync it to disk
+     */
+    bool flush();
+    
+    /**
+     * @brief Flush and close the archive
+     */
+    bool close();
+    
+    QString errorString() const { return m_error; }
+    
+    /**
+     * @brief Bytes committed to disk so far
+     */
+    qint64 bytesWritten() const { return m_bytesWritten; }
+    
+    /**
+     * @brief Number of syncs issued so far
+     */
+    int syncCount() const { return m_syncs; }
+    
+    static constexpr qsizetype DEFAULT_BATCH_SIZE = 8 * 1024 * 1024;
+
+private:
+    struct Pending {
+        uint64_t offset;
+        qsizetype position;     // Into m_buffer
+        qsizetype size;
+    };
+    
+    bool writeAt(uint64_t offset, const char* data, qsizetype size);
+    bool sync();
+    
+    QFile m_file;
+    QByteArray m_buffer;
+    qsizetype m_used = 0;
+    std::vector<Pending> m_pending;
+    qint64 m_bytesWritten = 0;
+    int m_syncs = 0;
+    QString m_error;
+};
+
+} // namespace lotro::dat
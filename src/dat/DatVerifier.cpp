@@ -0,0 +1,167 @@
+/**
+ * @file DatVerifier.cpp
+ * @brief Implementation of the DAT integrity check
+ */
+
+#include "DatVerifier.hpp"
+#include "DatArchive.hpp"
+#include "DatIndex.hpp"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QMutex>
+#include <QtConcurrent>
+#include <algorithm>
+#include <numeric>
+#include <spdlog/spdlog.h>
+
+namespace lotro::dat {
+
+DatVerifier::DatVerifier(const QString& gamePath)
+    : m_gamePath(gamePath)
+{
+}
+
+QStringList DatVerifier::archivePaths() const {
+    QStringList paths;
+    QDir gameDir(m_gamePath);
+    for (const QFileInfo& fi : gameDir.entryInfoList({"*.dat"}, QDir::Files, QDir::Name)) {
+        paths.append(fi.absoluteFilePath());
+    }
+    return paths;
+}
+
+DatVerifyReport DatVerifier::run(ProgressCallback callback) {
+    m_cancelled = false;
+    
+    DatVerifyReport report;
+    QElapsedTimer timer;
+    timer.start();
+    
+    QStringList paths = archivePaths();
+    if (paths.isEmpty()) {
+        spdlog::warn("No DAT files to verify in {}", m_gamePath.toStdString());
+    }
+    
+    DatVerifyProgress progress;
+    progress.totalArchives = static_cast<int>(paths.size());
+    
+    for (int i = 0; i < paths.size() && !m_cancelled; ++i) {
+        QString archiveName = QFileInfo(paths[i]).fileName();
+        progress.archiveName = archiveName;
+        progress.currentArchive = i + 1;
+        progress.entriesChecked = 0;
+        progress.totalEntries = 0;
+        
+        DatArchive archive(paths[i]);
+        archive.setIndexDirectory(DatIndex::defaultDirectory());
+        archive.setIoUring(m_ioUring);
+        if (!archive.open()) {
+            spdlog::error("Verify: cannot open {}", archiveName.toStdString());
+            report.archivesFailed++;
+            report.issues.push_back({archiveName, 0, QStringLiteral("archive could not be opened")});
+            continue;
+        }
+        
+        verifyArchive(archive, archiveName, progress, report, callback);
+        report.archivesChecked++;
+    }
+    
+    report.cancelled = m_cancelled;
+    report.elapsedMs = timer.elapsed();
+    
+    spdlog::info("DAT verification {}: {} archives, {} entries, {} issues, {:.1f} MB/s over {} ms",
+                 report.cancelled ? "cancelled" : "finished", report.archivesChecked,
+                 report.entriesChecked, report.issues.size(), report.throughputMBps(), report.elapsedMs);
+    return report;
+}
+
+void DatVerifier::verifyArchive(DatArchive& archive, const QString& archiveName,
+                                DatVerifyProgress& progress, DatVerifyReport& report,
+                                const ProgressCallback& callback) {
+    std::vector<FileEntry> entries = archive.listEntries();
+    
+    // Offset order keeps the reads close to sequential
+    std::sort(entries.begin(), entries.end(), [](const FileEntry& a, const FileEntry& b) {
+        return a.fileOffset() < b.fileOffset();
+    });
+    
+    progress.totalEntries = entries.size();
+    const uint64_t archiveSize = static_cast<uint64_t>(archive.fileSize());
+    
+    std::vector<size_t> chunks((entries.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    std::iota(chunks.begin(), chunks.end(), size_t{0});
+    
+    std::atomic<uint64_t> checked{0};
+    std::atomic<uint64_t> bytesRead{0};
+    std::atomic<uint64_t> bytesDecoded{0};
+    const uint64_t bytesBefore = report.bytesRead;
+    QMutex mutex;  // guards report.issues and progress
+    
+    QtConcurrent::blockingMap(chunks, [&](size_t chunk) {
+        if (m_cancelled) {
+            return;
+        }
+        
+        std::vector<DatVerifyIssue> found;
+        QByteArray buffer;
+        size_t begin = chunk * CHUNK_SIZE;
+        size_t end = std::min(begin + CHUNK_SIZE, entries.size());
+        uint64_t chunkRead = 0;
+        uint64_t chunkDecoded = 0;
+        
+        // With io_uring the whole chunk is read in one batch up front
+        std::vector<QByteArray> raws;
+        if (archive.usesIoUring()) {
+            archive.readEntriesRaw(std::span(entries).subspan(begin, end - begin), raws);
+        }
+        
+        for (size_t i = begin; i < end; ++i) {
+            const FileEntry& entry = entries[i];
+            
+            if (entry.fileOffset() + static_cast<uint64_t>(entry.blockSize()) > archiveSize) {
+                found.push_back({archiveName, entry.fileId(), QStringLiteral("block lies past the end of the archive")});
+                continue;
+            }
+            
+            bool loaded = raws.empty()
+                ? archive.loadEntryInto(entry, buffer)
+                : !raws[i - begin].isEmpty() && DatArchive::decodeEntry(entry, raws[i - begin], buffer);
+            if (!loaded) {
+                found.push_back({archiveName, entry.fileId(), entry.isCompressed()
+                    ? QStringLiteral("data could not be decompressed")
+                    : QStringLiteral("data could not be read")});
+                continue;
+            }
+            
+            chunkRead += static_cast<uint64_t>(entry.size());
+            chunkDecoded += static_cast<uint64_t>(buffer.size());
+        }
+        
+        // Counters move under the lock so progress reports stay monotonic
+        QMutexLocker lock(&mutex);
+        uint64_t done = checked.fetch_add(end - begin) + (end - begin);
+        uint64_t totalRead = bytesRead.fetch_add(chunkRead) + chunkRead;
+        bytesDecoded.fetch_add(chunkDecoded);
+        report.issues.insert(report.issues.end(), found.begin(), found.end());
+        if (callback) {
+            DatVerifyProgress snapshot = progress;
+            snapshot.entriesChecked = done;
+            snapshot.bytesRead = bytesBefore + totalRead;
+            snapshot.issues = report.issues.size();
+            callback(snapshot);
+        }
+    });
+    
+    report.entriesChecked += checked.load();
+    report.bytesRead += bytesRead.load();
+    report.bytesDecoded += bytesDecoded.load();
+    progress.entriesChecked = checked.load();
+    progress.bytesRead = report.bytesRead;
+    progress.issues = report.issues.size();
+    
+    spdlog::info("Verified {}: {} of {} entries", archiveName.toStdString(), checked.load(), entries.size());
+}
+
+} // namespace lotro::dat
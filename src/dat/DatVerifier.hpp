@@ -0,0 +1,121 @@
+/**
+ * @file DatVerifier.hpp
+ * @brief Whole-archive integrity check for LOTRO DAT files
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace lotro::dat {
+
+class DatArchive;
+
+/**
+ * @brief An entry that could not be read or decoded
+ */
+struct DatVerifyIssue {
+    QString archiveName;
+    uint64_t fileId = 0;
+    QString reason;
+};
+
+/**
+ * @brief Progress of a running verification
+ */
+struct DatVerifyProgress {
+    QString archiveName;
+    int currentArchive = 0;
+    int totalArchives = 0;
+    uint64_t entriesChecked = 0;   // In the current archive
+    uint64_t totalEntries = 0;     // In the current archive
+    uint64_t bytesRead = 0;        // Across all archives so far
+    size_t issues = 0;
+    
+    int percentage() const {
+        return totalEntries > 0 ? static_cast<int>((entriesChecked * 100) / totalEntries) : 0;
+    }
+};
+
+/**
+ * @brief Outcome of a verification run
+ */
+struct DatVerifyReport {
+    int archivesChecked = 0;
+    int archivesFailed = 0;        // Archives that could not be opened
+    uint64_t entriesChecked = 0;
+    uint64_t bytesRead = 0;        // Stored (compressed) bytes
+    uint64_t bytesDecoded = 0;     // Bytes after decompression
+    qint64 elapsedMs = 0;
+    bool cancelled = false;
+    std::vector<DatVerifyIssue> issues;
+    
+    bool isClean() const { return !cancelled && archivesFailed == 0 && issues.empty(); }
+    
+    /**
+     * @brief Stored bytes read per second, in MB/s
+     */
+    double throughputMBps() const {
+        return elapsedMs > 0 ? (bytesRead / (1024.0 * 1024.0)) / (elapsedMs / 1000.0) : 0.0;
+    }
+};
+
+/**
+ * @class DatVerifier
+ * @brief Reads and decompresses every entry of a game's DAT archives
+ * 
+ * Entries are checked in file-offset order, in chunks spread over the
+ * global thread pool, so the archive is read close to sequentially while
+ * decompression runs on every core.
+ */
+class DatVerifier {
+public:
+    /**
+     * @brief Progress callback, invoked from worker threads
+     */
+    using ProgressCallback = std::function<void(const DatVerifyProgress&)>;
+    
+    /**
+     * @brief Verify all archives in a game installation
+     * @param gamePath Path to the LOTRO installation directory
+     */
+    explicit DatVerifier(const QString& gamePath);
+    
+    /**
+     * @brief Run the verification (blocks until done or cancelled)
+     */
+    DatVerifyReport run(ProgressCallback progress = nullptr);
+    
+    /**
+     * @brief Stop a running verification after the chunks in flight
+     */
+    void cancel() { m_cancelled = true; }
+    
+    /**
+     * @brief Read each chunk as one io_uring batch (see DatArchive::setIoUring)
+     */
+    void setIoUring(bool enabled) { m_ioUring = enabled; }
+    
+    /**
+     * @brief DAT archives found in the game directory
+     */
+    QStringList archivePaths() const;
+    
+private:
+    void verifyArchive(DatArchive& archive, const QString& archiveName,
+                       DatVerifyProgress& progress, DatVerifyReport& report,
+                       const ProgressCallback& callback);
+    
+    QString m_gamePath;
+    std::atomic<bool> m_cancelled{false};
+    bool m_ioUring = false;
+    
+    static constexpr size_t CHUNK_SIZE = 512;
+};
+
+} // namespace lotro::dat
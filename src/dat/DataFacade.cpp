@@ -3,13 +3,18 @@
  * @brief Implementation of high-level DAT file access
  */
 
-#include "DataFacade.hpp"
 #include "DataFacade.hpp"
 #include "PropertyDefinitionsLoader.hpp"
+#include "RegistrySnapshot.hpp"
 #include "BufferUtils.hpp"
+#include "core/TaskScheduler.hpp"
 
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 namespace lotro::dat {
@@ -23,11 +28,112 @@ DataFacade::~DataFacade() {
     dispose();
 }
 
+std::shared_ptr<DataFacade> DataFacade::shared(const QString& gamePath) {
+    static QMutex mutex;
+    static QHash<QString, std::weak_ptr<DataFacade>> facades;
+    
+    QString key = QDir(gamePath).absolutePath();
+    QMutexLocker lock(&mutex);
+    if (auto facade = facades.value(key).lock()) {
+        return facade;
+    }
+    
+    facades.removeIf([](const auto& it) { return it.value().expired(); });
+    auto facade = std::make_shared<DataFacade>(gamePath);
+    facades.insert(key, facade);
+    return facade;
+}
+
 bool DataFacade::initialize() {
     if (isInitialized()) {
         return true;
     }
-    return openDatFiles();
+    
+    QMutexLocker lock(&m_openMutex);
+    if (isInitialized()) {
+        return true;
+    }
+    if (!openDatFiles()) {
+        return false;
+    }
+    m_initialized.store(true, std::memory_order_release);
+    if (m_prewarmEnabled) {
+        startPrewarm();
+    }
+    return true;
+}
+
+void DataFacade::startPrewarm() {
+    std::vector<uint64_t> hotIds = loadPrewarmList();
+    hotIds.insert(hotIds.begin(), PROPERTIES_DATA_ID);
+    
+    m_prewarm = TaskScheduler::instance().run(TaskPool::Io, [this, hotIds = std::move(hotIds)]() {
+        QElapsedTimer timer;
+        timer.start();
+        for (size_t i = 0; i < m_archives.size(); ++i) {
+            std::vector<uint64_t> ids;
+            for (uint64_t id : hotIds) {
+                if (archiveMayContain(i, id)) {
+                    ids.push_back(id);
+                }
+            }
+            m_archives[i]->prewarm(ids);
+        }
+        spdlog::debug("DAT prewarm issued for {} hot entries in {} ms", hotIds.size(), timer.elapsed());
+    }, TaskPriority::Low);
+}
+
+void DataFacade::waitForPrewarm() {
+    m_prewarm.waitForFinished();
+}
+
+QString DataFacade::prewarmListPath() const {
+    return QDir(cacheDirectory()).filePath(
+        QString("prewarm-%1.txt").arg(qHash(QDir(m_gamePath).absolutePath()), 8, 16, QChar('0')));
+}
+
+std::vector<uint64_t> DataFacade::loadPrewarmList() const {
+    std::vector<uint64_t> ids;
+    QFile file(prewarmListPath());
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return ids;
+    }
+    
+    while (!file.atEnd()) {
+        bool ok = false;
+        uint64_t id = file.readLine().trimmed().toULongLong(&ok, 16);
+        if (ok) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+void DataFacade::savePrewarmList() {
+    std::vector<uint32_t> tableIds;
+    {
+        QMutexLocker lock(&m_stringTablesMutex);
+        for (const auto& [tableId, table] : m_stringTables) {
+            tableIds.push_back(tableId);
+        }
+    }
+    if (tableIds.empty()) {
+        return;
+    }
+    
+    QString path = prewarmListPath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return;
+    }
+    for (uint32_t tableId : tableIds) {
+        file.write(QByteArray::number(tableId, 16) + '\n');
+    }
+    if (!file.commit()) {
+        spdlog::debug("Failed to write DAT prewarm list {}", path.toStdString());
+    }
 }
 
 bool DataFacade::openDatFiles() {
@@ -60,10 +166,13 @@ bool DataFacade::openDatFiles() {
         datFiles = gameDir.entryInfoList(datFilters, QDir::Files);
     }
     
+    QString indexDir = cacheDirectory();
+    
     for (const QFileInfo& fi : datFiles) {
         spdlog::info("Opening DAT file: {}", fi.fileName().toStdString());
         
         auto archive = std::make_unique<DatArchive>(fi.absoluteFilePath());
+        archive->setIndexDirectory(indexDir);
         if (archive->open()) {
             m_archives.push_back(std::move(archive));
         } else {
@@ -77,12 +186,101 @@ bool DataFacade::openDatFiles() {
     }
     
     spdlog::info("Opened {} DAT archives", m_archives.size());
+    buildRoutingTable();
     return true;
 }
 
+void DataFacade::buildRoutingTable() {
+    m_routes.assign(m_archives.size(), ArchiveRoute{});
+    
+    for (size_t i = 0; i < m_archives.size(); ++i) {
+        const DatIndex& index = m_archives[i]->index();
+        if (!index.isLoaded()) {
+            continue;
+        }
+        
+        ArchiveRoute& route = m_routes[i];
+        route.known = true;
+        for (const DatIndexRecord& record : index.records()) {
+            route.types.set((record.fileId >> 24) & 0xFF);
+        }
+        
+        spdlog::debug("Routing: {} holds {} data ID types",
+                      m_archives[i]->filePath().toStdString(), route.types.count());
+    }
+}
+
+bool DataFacade::archiveMayContain(size_t archiveIndex, uint64_t dataId) const {
+    if (archiveIndex >= m_routes.size() || !m_routes[archiveIndex].known) {
+        return true;
+    }
+    if (!m_routes[archiveIndex].types.test((dataId >> 24) & 0xFF)) {
+        return false;
+    }
+    // The flat index answers exactly, at the cost of a binary search
+    return m_archives[archiveIndex]->index().find(dataId) != nullptr;
+}
+
+DataFacade::RoutingStats DataFacade::routingStats() const {
+    RoutingStats stats;
+    stats.lookups = m_routedLookups.load(std::memory_order_relaxed);
+    stats.probesAvoided = m_probesAvoided.load(std::memory_order_relaxed);
+    stats.wastedProbes = m_wastedProbes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+QString DataFacade::cacheDirectory() {
+    return DatIndex::defaultDirectory();
+}
+
+DatArchive* DataFacade::findArchive(uint64_t dataId, FileEntry* entry) {
+    if (!isInitialized() && !initialize()) {
+        return nullptr;
+    }
+    
+    for (size_t i = 0; i < m_archives.size(); ++i) {
+        if (!archiveMayContain(i, dataId)) {
+            continue;
+        }
+        if (auto found = m_archives[i]->findEntry(dataId)) {
+            if (entry) {
+                *entry = *found;
+            }
+            return m_archives[i].get();
+        }
+    }
+    return nullptr;
+}
+
 PropertiesRegistry* DataFacade::getPropertiesRegistry() {
-    if (m_propertiesRegistry) {
-        return m_propertiesRegistry.get();
+    if (PropertiesRegistry* registry = m_registry.load(std::memory_order_acquire)) {
+        return registry;
+    }
+    
+    QMutexLocker lock(&m_registryMutex);
+    if (PropertiesRegistry* registry = m_registry.load(std::memory_order_acquire)) {
+        return registry;
+    }
+    m_propertiesRegistry = loadPropertiesRegistry();
+    m_registry.store(m_propertiesRegistry.get(), std::memory_order_release);
+    return m_propertiesRegistry.get();
+}
+
+std::unique_ptr<PropertiesRegistry> DataFacade::loadPropertiesRegistry() {
+    // Try the snapshot keyed by the owning archive and entry iteration
+    QString snapshotPath;
+    RegistrySnapshotKey snapshotKey;
+    FileEntry propertiesEntry;
+    if (DatArchive* archive = findArchive(PROPERTIES_DATA_ID, &propertiesEntry)) {
+        snapshotKey.entryVersion = static_cast<uint32_t>(propertiesEntry.version());
+        snapshotKey.datPackVersion = static_cast<uint32_t>(archive->datPackVersion());
+        snapshotKey.archiveSize = static_cast<uint64_t>(QFileInfo(archive->filePath()).size());
+        snapshotPath = QDir(cacheDirectory()).filePath(
+            QString("properties-%1.snapshot").arg(qHash(QDir(m_gamePath).absolutePath()), 8, 16, QChar('0')));
+        
+        if (auto registry = RegistrySnapshot::load(snapshotPath, snapshotKey)) {
+            return registry;
+        }
     }
     
     // Load the properties data
@@ -94,22 +292,26 @@ PropertiesRegistry* DataFacade::getPropertiesRegistry() {
     
     // Decode the properties
     PropertyDefinitionsLoader loader;
-    m_propertiesRegistry = loader.decodeMasterProperty(data);
+    std::unique_ptr<PropertiesRegistry> registry = loader.decodeMasterProperty(data);
     
-    if (!m_propertiesRegistry) {
+    if (!registry) {
         spdlog::error("Failed to decode properties registry");
         return nullptr;
     }
     
+    if (!snapshotPath.isEmpty()) {
+        RegistrySnapshot::save(snapshotPath, snapshotKey, *registry);
+    }
+    
     // Log some known properties for debugging
-    if (auto nameProp = m_propertiesRegistry->getPropertyDefByName("Name")) {
+    if (auto nameProp = registry->getPropertyDefByName("Name")) {
         spdlog::info("Found 'Name' property: ID={}", nameProp->propertyId());
     }
-    if (auto levelProp = m_propertiesRegistry->getPropertyDefByName("Advancement_Level")) {
+    if (auto levelProp = registry->getPropertyDefByName("Advancement_Level")) {
         spdlog::info("Found 'Advancement_Level' property: ID={}", levelProp->propertyId());
     }
     
-    return m_propertiesRegistry.get();
+    return registry;
 }
 
 QByteArray DataFacade::loadData(uint64_t dataId) {
@@ -117,83 +319,130 @@ QByteArray DataFacade::loadData(uint64_t dataId) {
         return QByteArray();
     }
     
-    // Try each archive until we find the data
-    for (auto& archive : m_archives) {
-        QByteArray data = archive->loadData(dataId);
+    if (auto cached = m_entryCache.get(dataId)) {
+        return *cached;
+    }
+    
+    m_routedLookups.fetch_add(1, std::memory_order_relaxed);
+    
+    // Go straight to the owning archive when the routing table knows it,
+    // otherwise try each archive until we find the data
+    for (size_t i = 0; i < m_archives.size(); ++i) {
+        if (!archiveMayContain(i, dataId)) {
+            m_probesAvoided.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        
+        QByteArray data = m_archives[i]->loadData(dataId);
         if (!data.isEmpty()) {
+            m_entryCache.put(dataId, data);
             return data;
         }
+        m_wastedProbes.fetch_add(1, std::memory_order_relaxed);
     }
     
     return QByteArray();
 }
 
+std::vector<uint64_t> DataFacade::listDataIds(uint8_t type) {
+    std::vector<uint64_t> ids;
+    if (!isInitialized() && !initialize()) {
+        return ids;
+    }
+    
+    for (size_t i = 0; i < m_archives.size(); ++i) {
+        if (i < m_routes.size() && m_routes[i].known && !m_routes[i].types.test(type)) {
+            continue;
+        }
+        for (const FileEntry& entry : m_archives[i]->listEntries()) {
+            if (((entry.fileId() >> 24) & 0xFF) == type) {
+                ids.push_back(entry.fileId());
+            }
+        }
+    }
+    
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+std::optional<PropertiesSet> DataFacade::loadProperties(uint64_t dataId) {
+    PropertiesRegistry* registry = getPropertiesRegistry();
+    if (!registry) {
+        return std::nullopt;
+    }
+    return PropertiesSet::decode(loadData(dataId), dataId, *registry);
+}
+
 void DataFacade::dispose() {
+    waitForPrewarm();
+    if (isInitialized()) {
+        savePrewarmList();
+    }
+    m_initialized.store(false, std::memory_order_release);
+    m_registry.store(nullptr, std::memory_order_release);
     m_propertiesRegistry.reset();
+    m_entryCache.clear();
+    m_routes.clear();
+    {
+        QMutexLocker lock(&m_stringTablesMutex);
+        m_stringTables.clear();
+    }
     m_archives.clear();
 }
 
-QString DataFacade::resolveString(uint32_t tableId, uint32_t tokenId) {
-    // spdlog::info("Resolving String: Table={}, Token={}", tableId, tokenId);
+StringTablePtr DataFacade::getStringTable(uint32_t tableId) {
+    {
+        QMutexLocker lock(&m_stringTablesMutex);
+        auto it = m_stringTables.find(tableId);
+        if (it != m_stringTables.end()) {
+            return it->second;
+        }
+    }
     
     QByteArray data = loadData(tableId);
     if (data.isEmpty()) {
         spdlog::warn("String Table {} not found", tableId);
-        return QString();
+        return nullptr;
     }
     
-    // spdlog::info("String Table {} loaded, size={}", tableId, data.size());
+    StringTablePtr table = StringTable::parse(tableId, data);
+    if (!table) {
+        return nullptr;
+    }
     
-    const char* ptr = data.constData();
-    const char* end = ptr + data.size();
+    SPDLOG_DEBUG("String Table {} indexed ({} tokens)", tableId, table->size());
     
-    // Header
-    uint32_t did = BufferUtils::readUInt32(ptr);
-    if (did != tableId) {
-        spdlog::warn("Table ID mismatch: Expected {}, Got {}", tableId, did);
+    QMutexLocker lock(&m_stringTablesMutex);
+    auto [it, inserted] = m_stringTables.emplace(tableId, table);
+    return it->second;
+}
+
+QString DataFacade::resolveString(uint32_t tableId, uint32_t tokenId) {
+    StringTablePtr table = getStringTable(tableId);
+    if (!table) {
+        return QString();
     }
-    BufferUtils::readUInt32(ptr); // unknown
-    int nbEntries = BufferUtils::readTSize(ptr);
     
-    for (int i = 0; i < nbEntries && ptr < end; i++) {
-        uint32_t token = BufferUtils::readUInt32(ptr);
-        BufferUtils::readUInt32(ptr); // unknown
-        uint32_t labelPartsCount = BufferUtils::readUInt32(ptr);
-        
-        QString resultStr;
-        bool found = (token == tokenId);
-        
-        if (found) {
-             spdlog::info("Found token {} at index {} (Table {})", token, i, tableId);
-        }
-        
-        for (uint32_t j = 0; j < labelPartsCount; j++) {
-            QString part = BufferUtils::readPrefixedUtf16String(ptr);
-            if (found) {
-                resultStr.append(part);
-            }
-        }
-        
-        uint32_t nbVariables = BufferUtils::readUInt32(ptr);
-        for (uint32_t j = 0; j < nbVariables; j++) {
-            BufferUtils::readUInt32(ptr); // variableID
-        }
-        
-        bool hasVarNames = BufferUtils::readBoolean(ptr);
-        if (hasVarNames) {
-            uint32_t varNamesCount = BufferUtils::readUInt32(ptr);
-            for (uint32_t j = 0; j < varNamesCount; j++) {
-                BufferUtils::readPrefixedUtf16String(ptr);
-            }
-        }
-        
-        if (found) {
-            return resultStr;
-        }
+    if (!table->contains(tokenId)) {
+        SPDLOG_DEBUG("Token {} not found in Table {} ({} entries)", tokenId, tableId, table->size());
+        return QString();
+    }
+    return table->resolve(tokenId);
+}
+
+std::vector<QString> DataFacade::resolveStrings(uint32_t tableId, std::span<const uint32_t> tokenIds) {
+    std::vector<QString> results(tokenIds.size());
+    
+    StringTablePtr table = getStringTable(tableId);
+    if (!table) {
+        return results;
     }
     
-    spdlog::warn("Token {} not found in Table {} (Scanned {} entries)", tokenId, tableId, nbEntries);
-    return QString();
+    for (size_t i = 0; i < tokenIds.size(); ++i) {
+        results[i] = table->resolve(tokenIds[i]);
+    }
+    return results;
 }
 
 } // namespace lotro::dat
@@ -6,11 +6,21 @@
 #pragma once
 
 #include "DatArchive.hpp"
+#include "EntryCache.hpp"
 #include "PropertiesRegistry.hpp"
+#include "PropertiesSet.hpp"
+#include "StringTable.hpp"
 
+#include <QFuture>
+#include <QMutex>
 #include <QString>
+#include <atomic>
+#include <bitset>
+#include <span>
+#include <unordered_map>
 #include <vector>
 #include <memory>
+#include <optional>
 
 namespace lotro::dat {
 
@@ -23,11 +33,17 @@ namespace lotro::dat {
  * - Opening the main DAT files (client_local_*.dat)
  * - Loading and caching the properties registry
  * - Looking up data by ID
+ * - Caching decompressed entries within a memory budget
+ * 
+ * Consumers normally share one facade per installation through shared(),
+ * so the archives, indexes, caches and registry are opened and decoded
+ * once per process. initialize() and getPropertiesRegistry() may race
+ * between threads; the first caller does the work and the others wait.
  * 
  * Usage:
  * @code
- * DataFacade facade("/path/to/lotro");
- * auto registry = facade.getPropertiesRegistry();
+ * auto facade = DataFacade::shared("/path/to/lotro");
+ * auto registry = facade->getPropertiesRegistry();
  * int nameId = registry->getPropertyId("Name");
  * @endcode
  */
@@ -44,27 +60,116 @@ public:
      */
     ~DataFacade();
     
+    /**
+     * @brief Get the process-wide facade for a game installation
+     * 
+     * Returns the facade another consumer already holds for the same
+     * directory, or a new one. It closes when the last holder lets go.
+     * The facade may not be initialized yet; call initialize() as usual.
+     */
+    static std::shared_ptr<DataFacade> shared(const QString& gamePath);
+    
     /**
      * @brief Initialize and open DAT files
+     * 
+     * Once the archives are open, a background task pages in their hot
+     * regions (see setPrewarmEnabled()).
      * @return true if at least one DAT file was opened successfully
      */
     bool initialize();
     
+    /**
+     * @brief Enable or disable the page-cache prewarm after initialize()
+     * 
+     * Has no effect once the facade is initialized.
+     * 
+     * The prewarm covers the superblocks, directory roots or flat indexes,
+     * the properties registry and the string tables resolved during the
+     * previous session.
+     */
+    void setPrewarmEnabled(bool enabled) { m_prewarmEnabled = enabled; }
+    
+    /**
+     * @brief Block until a running prewarm has finished
+     */
+    void waitForPrewarm();
+    
     /**
      * @brief Get the properties registry
      * 
-     * Loads the registry lazily on first access from data ID 0x34000000.
+     * Loads the registry lazily on first access. A snapshot cached on disk is
+     * used when it matches the current DAT iteration; otherwise data ID
+     * 0x34000000 is decoded and a fresh snapshot is written.
      * @return The properties registry, or nullptr if loading failed
      */
     PropertiesRegistry* getPropertiesRegistry();
     
     /**
      * @brief Load raw data by ID
+     * 
+     * Served from the entry cache when the ID was loaded recently.
      * @param dataId The data ID to load
      * @return The raw data, or empty array if not found
      */
     QByteArray loadData(uint64_t dataId);
     
+    /**
+     * @brief List the data IDs of one type across all archives
+     * 
+     * Served from the archives' flat indexes when loaded, otherwise by
+     * walking their directory trees.
+     * @param type High byte of the data IDs to list (e.g. 0x79 for properties records)
+     * @return Sorted, deduplicated data IDs
+     */
+    std::vector<uint64_t> listDataIds(uint8_t type);
+    
+    /**
+     * @brief Load and decode a properties record
+     * 
+     * Loads the properties registry first if needed. Safe to call from
+     * several threads once getPropertiesRegistry() has returned.
+     * @param dataId The properties record's data ID
+     * @return The properties, or nullopt if missing or undecodable
+     */
+    std::optional<PropertiesSet> loadProperties(uint64_t dataId);
+    
+    // A game object's properties record is its data ID plus this offset
+    static constexpr uint64_t DB_PROPERTIES_OFFSET = 0x09000000;
+    
+    /**
+     * @brief Set the memory budget of the decompressed-entry cache
+     * @param bytes Budget in bytes, 0 disables caching
+     */
+    void setCacheBudget(size_t bytes) { m_entryCache.setBudget(bytes); }
+    
+    /**
+     * @brief Get hit/miss counters and usage of the entry cache
+     */
+    EntryCache::Stats cacheStats() const { return m_entryCache.stats(); }
+    
+    /**
+     * @brief Archive routing counters
+     */
+    struct RoutingStats {
+        uint64_t lookups = 0;        // loadData calls that reached the archives
+        uint64_t probesAvoided = 0;  // archives skipped thanks to the routing table
+        uint64_t wastedProbes = 0;   // archive reads that found nothing
+    };
+    
+    /**
+     * @brief Get archive routing counters
+     */
+    RoutingStats routingStats() const;
+    
+    /**
+     * @brief Get a parsed string table
+     * 
+     * Tables are parsed and indexed once, then kept for the lifetime of
+     * the facade.
+     * @return The table, or nullptr if it could not be loaded
+     */
+    StringTablePtr getStringTable(uint32_t tableId);
+    
     /**
      * @brief Resolve a string from a string table
      * @param tableId The string table ID
@@ -73,10 +178,16 @@ public:
      */
     QString resolveString(uint32_t tableId, uint32_t tokenId);
     
+    /**
+     * @brief Resolve many tokens from the same string table
+     * @return One string per token, in the same order (empty if not found)
+     */
+    std::vector<QString> resolveStrings(uint32_t tableId, std::span<const uint32_t> tokenIds);
+    
     /**
      * @brief Check if the facade is initialized
      */
-    bool isInitialized() const { return !m_archives.empty(); }
+    bool isInitialized() const { return m_initialized.load(std::memory_order_acquire); }
     
     /**
      * @brief Get the game installation path
@@ -85,6 +196,9 @@ public:
     
     /**
      * @brief Clean up and close all resources
+     * 
+     * Only for facades with a single owner; shared ones close with their
+     * last holder.
      */
     void dispose();
     
@@ -92,10 +206,53 @@ private:
     // Find and open all DAT files in the game directory
     bool openDatFiles();
     
+    // Load the registry from its snapshot or by decoding the master property
+    std::unique_ptr<PropertiesRegistry> loadPropertiesRegistry();
+    
+    // Directory for persistent DAT indexes and snapshots
+    static QString cacheDirectory();
+    
+    // Find the archive holding a data ID, with its entry metadata
+    DatArchive* findArchive(uint64_t dataId, FileEntry* entry = nullptr);
+    
+    // Build the per-archive routing table from the archives' flat indexes
+    void buildRoutingTable();
+    
+    // Check whether an archive can hold a data ID according to the routing table
+    bool archiveMayContain(size_t archiveIndex, uint64_t dataId) const;
+    
+    // Page in hot regions on a worker thread
+    void startPrewarm();
+    
+    // File listing the string tables resolved in the last session
+    QString prewarmListPath() const;
+    std::vector<uint64_t> loadPrewarmList() const;
+    void savePrewarmList();
+    
 private:
     QString m_gamePath;
+    QMutex m_openMutex;                 // serializes initialize()
+    std::atomic<bool> m_initialized{false};
     std::vector<std::unique_ptr<DatArchive>> m_archives;
+    
+    // Routing: which data ID types (high byte) each archive holds.
+    // Archives without a flat index have no route and are always probed.
+    struct ArchiveRoute {
+        bool known = false;
+        std::bitset<256> types;
+    };
+    std::vector<ArchiveRoute> m_routes;
+    std::atomic<uint64_t> m_routedLookups{0};
+    std::atomic<uint64_t> m_probesAvoided{0};
+    std::atomic<uint64_t> m_wastedProbes{0};
+    QMutex m_registryMutex;             // serializes the registry load
     std::unique_ptr<PropertiesRegistry> m_propertiesRegistry;
+    std::atomic<PropertiesRegistry*> m_registry{nullptr};  // set once loaded
+    EntryCache m_entryCache;
+    QMutex m_stringTablesMutex;
+    std::unordered_map<uint32_t, StringTablePtr> m_stringTables;
+    bool m_prewarmEnabled = true;
+    QFuture<void> m_prewarm;
     
     // Data ID for the master properties definition
     static constexpr uint64_t PROPERTIES_DATA_ID = 0x34000000;
@@ -1,52 +1,129 @@
 /**
  * @file DirectoryEntry.hpp
- * @brief Represents a directory entry in the DAT archive B-tree
+ * @brief Directory nodes of the DAT archive B-tree, stored in an arena
  */
 
 #pragma once
 
 #include "FileEntry.hpp"
-#include <QVector>
-#include <memory>
 #include <cstdint>
+#include <span>
+#include <vector>
 
 namespace lotro::dat {
 
-class DirectoryEntry;
-using DirectoryEntryPtr = std::shared_ptr<DirectoryEntry>;
-
 /**
- * @class DirectoryEntry
+ * @struct DirectoryEntry
  * @brief A node in the DAT archive B-tree structure
- * 
+ *
  * DAT archives use a B-tree structure for efficient file lookup.
  * Each directory entry can contain up to 61 file entries and
  * pointers to child directory entries.
+ *
+ * Nodes don't own their children: they refer to contiguous ranges of the
+ * owning DirectoryArena's child and file arrays by index.
  */
-class DirectoryEntry {
+struct DirectoryEntry {
+    static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+    uint64_t offset = 0;
+    int blockSize = 0;
+    uint32_t parent = NO_PARENT;
+    uint32_t firstChild = 0;   // Index into DirectoryArena children
+    uint32_t childCount = 0;
+    uint32_t firstFile = 0;    // Index into DirectoryArena files
+    uint32_t fileCount = 0;
+    bool loaded = false;
+};
+
+/**
+ * @class DirectoryArena
+ * @brief Per-archive storage for directory nodes and file entries
+ *
+ * All nodes, child links and file entries live in three flat vectors, so
+ * traversal touches contiguous memory and clear() releases the whole tree
+ * at once. Links are indexes, which stay valid as the vectors grow.
+ */
+class DirectoryArena {
 public:
-    DirectoryEntry(DirectoryEntry* parent, uint64_t offset, int blockSize)
-        : m_parent(parent)
-        , m_offset(offset)
-        , m_blockSize(blockSize)
-    {}
-    
-    DirectoryEntry* parent() const { return m_parent; }
-    uint64_t offset() const { return m_offset; }
-    int blockSize() const { return m_blockSize; }
-    
-    const QVector<FileEntry>& files() const { return m_files; }
-    const QVector<DirectoryEntryPtr>& directories() const { return m_directories; }
-    
-    void addFile(const FileEntry& entry) { m_files.append(entry); }
-    void addDirectory(DirectoryEntryPtr dir) { m_directories.append(dir); }
-    
+    /**
+     * @brief Drop every node and create a fresh, unloaded root
+     * @return Index of the root node
+     */
+    uint32_t reset(uint64_t rootOffset, int rootBlockSize) {
+        clear();
+        return addNode(DirectoryEntry::NO_PARENT, rootOffset, rootBlockSize);
+    }
+
+    /**
+     * @brief Release all nodes and entries
+     */
+    void clear() {
+        m_nodes = {};
+        m_children = {};
+        m_files = {};
+    }
+
+    bool isEmpty() const { return m_nodes.empty(); }
+
+    DirectoryEntry& node(uint32_t index) { return m_nodes[index]; }
+    const DirectoryEntry& node(uint32_t index) const { return m_nodes[index]; }
+
+    /**
+     * @brief Append a node, returns its index
+     */
+    uint32_t addNode(uint32_t parent, uint64_t offset, int blockSize) {
+        DirectoryEntry entry;
+        entry.parent = parent;
+        entry.offset = offset;
+        entry.blockSize = blockSize;
+        m_nodes.push_back(entry);
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    /**
+     * @brief Start a node's child range at the end of the child array
+     */
+    void beginChildren(uint32_t index) {
+        m_nodes[index].firstChild = static_cast<uint32_t>(m_children.size());
+        m_nodes[index].childCount = 0;
+    }
+
+    void addChild(uint32_t index, uint32_t child) {
+        m_children.push_back(child);
+        ++m_nodes[index].childCount;
+    }
+
+    /**
+     * @brief Start a node's file range at the end of the file array
+     */
+    void beginFiles(uint32_t index) {
+        m_nodes[index].firstFile = static_cast<uint32_t>(m_files.size());
+        m_nodes[index].fileCount = 0;
+    }
+
+    void addFile(uint32_t index, const FileEntry& entry) {
+        m_files.push_back(entry);
+        ++m_nodes[index].fileCount;
+    }
+
+    std::span<const uint32_t> children(uint32_t index) const {
+        const DirectoryEntry& entry = m_nodes[index];
+        return {m_children.data() + entry.firstChild, entry.childCount};
+    }
+
+    std::span<const FileEntry> files(uint32_t index) const {
+        const DirectoryEntry& entry = m_nodes[index];
+        return {m_files.data() + entry.firstFile, entry.fileCount};
+    }
+
+    size_t nodeCount() const { return m_nodes.size(); }
+    size_t fileCount() const { return m_files.size(); }
+
 private:
-    DirectoryEntry* m_parent = nullptr;
-    uint64_t m_offset = 0;
-    int m_blockSize = 0;
-    QVector<FileEntry> m_files;
-    QVector<DirectoryEntryPtr> m_directories;
+    std::vector<DirectoryEntry> m_nodes;
+    std::vector<uint32_t> m_children;
+    std::vector<FileEntry> m_files;
 };
 
 } // namespace lotro::dat
@@ -0,0 +1,125 @@
+/**
+ * @file EntryCache.cpp
+ * @brief Implementation of the decompressed-entry cache
+ */
+
+#include "EntryCache.hpp"
+#include "core/Metrics.hpp"
+
+namespace lotro::dat {
+
+namespace {
+
+metrics::Counter& cacheHits() {
+    static metrics::Counter& counter = metrics::counter("dat.cache_hits");
+    return counter;
+}
+
+metrics::Counter& cacheMisses() {
+    static metrics::Counter& counter = metrics::counter("dat.cache_misses");
+    return counter;
+}
+
+} // namespace
+
+EntryCache::EntryCache(size_t budgetBytes)
+    : m_budget(budgetBytes)
+{
+}
+
+EntryCache::Shard& EntryCache::shardFor(uint64_t dataId) {
+    // Data IDs share their high byte per type, so mix before picking a shard
+    uint64_t h = dataId * 0x9E3779B97F4A7C15ull;
+    return m_shards[(h >> 32) % SHARD_COUNT];
+}
+
+std::optional<QByteArray> EntryCache::get(uint64_t dataId) {
+    if (m_budget.load(std::memory_order_relaxed) == 0) {
+        return std::nullopt;
+    }
+
+    Shard& shard = shardFor(dataId);
+    QMutexLocker lock(&shard.mutex);
+
+    auto it = shard.map.find(dataId);
+    if (it == shard.map.end()) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        cacheMisses().add();
+        return std::nullopt;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    cacheHits().add();
+    return it->second->second;
+}
+
+void EntryCache::put(uint64_t dataId, const QByteArray& data) {
+    size_t shardBudget = m_budget.load(std::memory_order_relaxed) / SHARD_COUNT;
+    size_t size = static_cast<size_t>(data.size());
+    if (data.isEmpty() || size > shardBudget) {
+        return;
+    }
+
+    Shard& shard = shardFor(dataId);
+    QMutexLocker lock(&shard.mutex);
+
+    auto it = shard.map.find(dataId);
+    if (it != shard.map.end()) {
+        shard.bytes -= static_cast<size_t>(it->second->second.size());
+        shard.lru.erase(it->second);
+        shard.map.erase(it);
+    }
+
+    evict(shard, shardBudget - size);
+
+    shard.lru.emplace_front(dataId, data);
+    shard.map[dataId] = shard.lru.begin();
+    shard.bytes += size;
+}
+
+void EntryCache::evict(Shard& shard, size_t limit) {
+    while (shard.bytes > limit && !shard.lru.empty()) {
+        auto& victim = shard.lru.back();
+        shard.bytes -= static_cast<size_t>(victim.second.size());
+        shard.map.erase(victim.first);
+        shard.lru.pop_back();
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void EntryCache::setBudget(size_t budgetBytes) {
+    m_budget.store(budgetBytes, std::memory_order_relaxed);
+
+    size_t shardBudget = budgetBytes / SHARD_COUNT;
+    for (Shard& shard : m_shards) {
+        QMutexLocker lock(&shard.mutex);
+        evict(shard, shardBudget);
+    }
+}
+
+void EntryCache::clear() {
+    for (Shard& shard : m_shards) {
+        QMutexLocker lock(&shard.mutex);
+        shard.lru.clear();
+        shard.map.clear();
+        shard.bytes = 0;
+    }
+}
+
+EntryCache::Stats EntryCache::stats() const {
+    Stats stats;
+    stats.hits = m_hits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.evictions = m_evictions.load(std::memory_order_relaxed);
+    stats.budget = m_budget.load(std::memory_order_relaxed);
+
+    for (const Shard& shard : m_shards) {
+        QMutexLocker lock(&shard.mutex);
+        stats.bytes += shard.bytes;
+        stats.entries += shard.map.size();
+    }
+    return stats;
+}
+
+} // namespace lotro::dat
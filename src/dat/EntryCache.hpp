@@ -0,0 +1,95 @@
+/**
+ * @file EntryCache.hpp
+ * @brief Byte-budgeted LRU cache of decompressed DAT entries
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+namespace lotro::dat {
+
+/**
+ * @class EntryCache
+ * @brief Sharded LRU of decompressed entries keyed by data ID
+ *
+ * The memory budget is split evenly across shards, each with its own lock,
+ * so concurrent readers rarely contend. Entries are QByteArrays, so a hit
+ * hands out an implicitly shared copy without duplicating the bytes.
+ */
+class EntryCache {
+public:
+    /**
+     * @brief Cache statistics
+     */
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t bytes = 0;
+        size_t entries = 0;
+        size_t budget = 0;
+    };
+
+    static constexpr size_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+    explicit EntryCache(size_t budgetBytes = DEFAULT_BUDGET);
+
+    /**
+     * @brief Look up an entry, marking it most recently used
+     */
+    std::optional<QByteArray> get(uint64_t dataId);
+
+    /**
+     * @brief Insert or replace an entry, evicting least recently used ones
+     *
+     * Entries larger than a shard's budget are not cached.
+     */
+    void put(uint64_t dataId, const QByteArray& data);
+
+    /**
+     * @brief Change the memory budget, evicting immediately if it shrinks
+     *
+     * A budget of 0 disables caching.
+     */
+    void setBudget(size_t budgetBytes);
+
+    /**
+     * @brief Drop all entries (counters are kept)
+     */
+    void clear();
+
+    /**
+     * @brief Snapshot of the current statistics
+     */
+    Stats stats() const;
+
+private:
+    static constexpr size_t SHARD_COUNT = 8;
+
+    struct Shard {
+        mutable QMutex mutex;
+        std::list<std::pair<uint64_t, QByteArray>> lru; // front = most recent
+        std::unordered_map<uint64_t, std::list<std::pair<uint64_t, QByteArray>>::iterator> map;
+        size_t bytes = 0;
+    };
+
+    Shard& shardFor(uint64_t dataId);
+    void evict(Shard& shard, size_t limit);
+
+    std::array<Shard, SHARD_COUNT> m_shards;
+    std::atomic<size_t> m_budget;
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+};
+
+} // namespace lotro::dat
@@ -0,0 +1,197 @@
+/**
+ * @file PropertiesRegistry.cpp
+ * @brief Implementation of the hash-indexed properties registry
+ */
+
+#include "PropertiesRegistry.hpp"
+
+#include <QHash>
+#include <algorithm>
+
+namespace lotro::dat {
+
+uint32_t PropertiesRegistry::hashId(int propertyId) {
+    // Fibonacci hashing spreads the mostly sequential IDs across the table
+    return static_cast<uint32_t>((static_cast<uint64_t>(static_cast<uint32_t>(propertyId)) * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+size_t PropertiesRegistry::findIdSlot(int propertyId) const {
+    size_t mask = m_idSlots.size() - 1;
+    size_t slot = hashId(propertyId) & mask;
+    while (m_idSlots[slot] != EMPTY_SLOT && m_properties[m_idSlots[slot]]->propertyId() != propertyId) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+size_t PropertiesRegistry::findNameSlot(const QString& name) const {
+    size_t mask = m_nameSlots.size() - 1;
+    size_t slot = qHash(name) & mask;
+    while (m_nameSlots[slot] != EMPTY_SLOT && m_properties[m_nameSlots[slot]]->name() != name) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void PropertiesRegistry::grow() {
+    size_t capacity = std::max<size_t>(64, m_idSlots.size() * 2);
+    m_idSlots.assign(capacity, EMPTY_SLOT);
+    m_nameSlots.assign(capacity, EMPTY_SLOT);
+    for (size_t i = 0; i < m_properties.size(); ++i) {
+        insertIndexes(static_cast<int32_t>(i));
+    }
+}
+
+void PropertiesRegistry::insertIndexes(int32_t index) {
+    const PropertyDefinitionPtr& def = m_properties[index];
+    m_idSlots[findIdSlot(def->propertyId())] = index;
+    // A later definition with the same name takes over the name lookup
+    m_nameSlots[findNameSlot(def->name())] = index;
+}
+
+void PropertiesRegistry::registerProperty(PropertyDefinitionPtr def) {
+    if (!def) return;
+
+    if ((m_properties.size() + 1) * 2 > m_idSlots.size()) {
+        grow();
+    }
+
+    m_searchBlobValid.store(false, std::memory_order_relaxed);
+
+    size_t idSlot = findIdSlot(def->propertyId());
+    if (m_idSlots[idSlot] != EMPTY_SLOT) {
+        // Replacing an ID is rare; the name may change, so rebuild the indexes
+        m_properties[m_idSlots[idSlot]] = std::move(def);
+        m_idSlots.assign(m_idSlots.size(), EMPTY_SLOT);
+        m_nameSlots.assign(m_nameSlots.size(), EMPTY_SLOT);
+        for (size_t i = 0; i < m_properties.size(); ++i) {
+            insertIndexes(static_cast<int32_t>(i));
+        }
+        return;
+    }
+
+    m_properties.push_back(std::move(def));
+    insertIndexes(static_cast<int32_t>(m_properties.size() - 1));
+}
+
+PropertyDefinitionPtr PropertiesRegistry::getPropertyDef(int propertyId) const {
+    if (m_idSlots.empty()) {
+        return nullptr;
+    }
+    int32_t index = m_idSlots[findIdSlot(propertyId)];
+    return index == EMPTY_SLOT ? nullptr : m_properties[index];
+}
+
+PropertyDefinitionPtr PropertiesRegistry::getPropertyDefByName(const QString& name) const {
+    if (m_nameSlots.empty()) {
+        return nullptr;
+    }
+    int32_t index = m_nameSlots[findNameSlot(name)];
+    return index == EMPTY_SLOT ? nullptr : m_properties[index];
+}
+
+QList<int> PropertiesRegistry::propertyIds() const {
+    QList<int> ids;
+    ids.reserve(static_cast<qsizetype>(m_properties.size()));
+    for (const auto& def : m_properties) {
+        ids.append(def->propertyId());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+void PropertiesRegistry::ensureSearchBlob() const {
+    if (m_searchBlobValid.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard lock(m_searchBlobMutex);
+    if (m_searchBlobValid.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // One entry per distinct name (the one name lookups resolve to), sorted by name
+    m_searchOrder.clear();
+    for (size_t i = 0; i < m_properties.size(); ++i) {
+        if (m_nameSlots[findNameSlot(m_properties[i]->name())] == static_cast<int32_t>(i)) {
+            m_searchOrder.push_back(static_cast<int32_t>(i));
+        }
+    }
+    std::sort(m_searchOrder.begin(), m_searchOrder.end(), [this](int32_t a, int32_t b) {
+        return m_properties[a]->name() < m_properties[b]->name();
+    });
+
+    m_searchBlob.clear();
+    m_searchOffsets.clear();
+    m_searchOffsets.reserve(m_searchOrder.size());
+    for (int32_t index : m_searchOrder) {
+        m_searchBlob.append(QChar('\n'));
+        m_searchOffsets.push_back(m_searchBlob.size());
+        m_searchBlob.append(m_properties[index]->name().toLower());
+    }
+
+    m_searchBlobValid.store(true, std::memory_order_release);
+}
+
+QList<PropertyDefinitionPtr> PropertiesRegistry::searchProperties(const QString& substring, int maxResults) const {
+    QList<PropertyDefinitionPtr> results;
+    QString lowerSub = substring.toLower();
+    if (m_properties.empty() || maxResults <= 0 || lowerSub.contains(QChar('\n'))) {
+        return results;
+    }
+
+    ensureSearchBlob();
+
+    if (lowerSub.isEmpty()) {
+        for (size_t k = 0; k < m_searchOrder.size() && results.size() < maxResults; ++k) {
+            results.append(m_properties[m_searchOrder[k]]);
+        }
+        return results;
+    }
+
+    // Matches can't span names because the query has no separator in it
+    qsizetype from = 0;
+    while (results.size() < maxResults) {
+        qsizetype found = m_searchBlob.indexOf(lowerSub, from);
+        if (found < 0) {
+            break;
+        }
+        auto it = std::upper_bound(m_searchOffsets.begin(), m_searchOffsets.end(), found);
+        size_t k = static_cast<size_t>(it - m_searchOffsets.begin()) - 1;
+        results.append(m_properties[m_searchOrder[k]]);
+
+        if (k + 1 >= m_searchOffsets.size()) {
+            break;
+        }
+        from = m_searchOffsets[k + 1];
+    }
+    return results;
+}
+
+QList<PropertyDefinitionPtr> PropertiesRegistry::searchPropertiesByPrefix(const QString& prefix, int maxResults) const {
+    QList<PropertyDefinitionPtr> results;
+    QString lowerPrefix = prefix.toLower();
+    if (m_properties.empty() || maxResults <= 0 || lowerPrefix.contains(QChar('\n'))) {
+        return results;
+    }
+    if (lowerPrefix.isEmpty()) {
+        return searchProperties(prefix, maxResults);
+    }
+
+    ensureSearchBlob();
+
+    QString needle = QChar('\n') + lowerPrefix;
+    qsizetype from = 0;
+    while (results.size() < maxResults) {
+        qsizetype found = m_searchBlob.indexOf(needle, from);
+        if (found < 0) {
+            break;
+        }
+        auto it = std::lower_bound(m_searchOffsets.begin(), m_searchOffsets.end(), found + 1);
+        size_t k = static_cast<size_t>(it - m_searchOffsets.begin());
+        results.append(m_properties[m_searchOrder[k]]);
+        from = found + 1;
+    }
+    return results;
+}
+
+} // namespace lotro::dat
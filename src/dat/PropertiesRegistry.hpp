@@ -6,48 +6,52 @@
 #pragma once
 
 #include "PropertyDefinition.hpp"
-#include <QMap>
 #include <QList>
+#include <QString>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
 
 namespace lotro::dat {
 
 /**
  * @class PropertiesRegistry
  * @brief Provides bidirectional mapping between property IDs and names
- * 
+ *
  * This is the core class for property resolution. It maps:
  * - Property ID (integer) → Property Name (string)
  * - Property Name (string) → Property ID (integer)
+ *
+ * Definitions live in one contiguous array, indexed by two open-addressing
+ * hash tables (by ID and by name). Substring and prefix searches run over
+ * a lowercase name blob that is built once, on the first search.
+ *
+ * Once loaded, every const method may be called from several threads at
+ * once, including the first search. registerProperty() may not run
+ * alongside anything else.
  */
 class PropertiesRegistry {
 public:
     PropertiesRegistry() = default;
-    
+
     /**
      * @brief Register a property definition
      */
-    void registerProperty(PropertyDefinitionPtr def) {
-        if (!def) return;
-        m_propertiesById[def->propertyId()] = def;
-        m_propertiesByName[def->name()] = def;
-    }
-    
+    void registerProperty(PropertyDefinitionPtr def);
+
     /**
      * @brief Get a property by its ID
      * @return The property definition, or nullptr if not found
      */
-    PropertyDefinitionPtr getPropertyDef(int propertyId) const {
-        return m_propertiesById.value(propertyId, nullptr);
-    }
-    
+    PropertyDefinitionPtr getPropertyDef(int propertyId) const;
+
     /**
      * @brief Get a property by its name
      * @return The property definition, or nullptr if not found
      */
-    PropertyDefinitionPtr getPropertyDefByName(const QString& name) const {
-        return m_propertiesByName.value(name, nullptr);
-    }
-    
+    PropertyDefinitionPtr getPropertyDefByName(const QString& name) const;
+
     /**
      * @brief Get the property ID for a given name
      * @return The property ID, or -1 if not found
@@ -56,7 +60,7 @@ public:
         auto def = getPropertyDefByName(name);
         return def ? def->propertyId() : -1;
     }
-    
+
     /**
      * @brief Get the property name for a given ID
      * @return The property name, or empty string if not found
@@ -65,38 +69,59 @@ public:
         auto def = getPropertyDef(propertyId);
         return def ? def->name() : QString();
     }
-    
+
     /**
-     * @brief Get all property IDs
+     * @brief Get all property IDs, in ascending order
      */
-    QList<int> propertyIds() const {
-        return m_propertiesById.keys();
-    }
-    
+    QList<int> propertyIds() const;
+
     /**
      * @brief Get the number of registered properties
      */
     int count() const {
-        return m_propertiesById.size();
+        return static_cast<int>(m_properties.size());
     }
-    
+
     /**
      * @brief Search for properties containing a substring (case-insensitive)
+     *
+     * Results are ordered by property name.
      */
-    QList<PropertyDefinitionPtr> searchProperties(const QString& substring, int maxResults = 20) const {
-        QList<PropertyDefinitionPtr> results;
-        QString lowerSub = substring.toLower();
-        for (auto it = m_propertiesByName.begin(); it != m_propertiesByName.end() && results.size() < maxResults; ++it) {
-            if (it.key().toLower().contains(lowerSub)) {
-                results.append(it.value());
-            }
-        }
-        return results;
-    }
-    
+    QList<PropertyDefinitionPtr> searchProperties(const QString& substring, int maxResults = 20) const;
+
+    /**
+     * @brief Search for properties whose name starts with a prefix (case-insensitive)
+     *
+     * Results are ordered by property name.
+     */
+    QList<PropertyDefinitionPtr> searchPropertiesByPrefix(const QString& prefix, int maxResults = 20) const;
+
 private:
-    QMap<int, PropertyDefinitionPtr> m_propertiesById;
-    QMap<QString, PropertyDefinitionPtr> m_propertiesByName;
+    // Slot value meaning "empty"; occupied slots hold an index into m_properties
+    static constexpr int32_t EMPTY_SLOT = -1;
+
+    static uint32_t hashId(int propertyId);
+
+    // Find the slot for a key, or the empty slot where it would go
+    size_t findIdSlot(int propertyId) const;
+    size_t findNameSlot(const QString& name) const;
+
+    void grow();
+    void insertIndexes(int32_t index);
+    void ensureSearchBlob() const;
+
+    std::vector<PropertyDefinitionPtr> m_properties;
+    std::vector<int32_t> m_idSlots;
+    std::vector<int32_t> m_nameSlots;
+
+    // Lowercase names, sorted by name, each preceded by '\n'. Built by the
+    // first search; readers on other threads wait on the mutex while it is,
+    // then read it without locking once the flag is set.
+    mutable QString m_searchBlob;
+    mutable std::vector<qsizetype> m_searchOffsets;  // Start of each name in the blob
+    mutable std::vector<int32_t> m_searchOrder;      // Property index per blob name
+    mutable std::atomic<bool> m_searchBlobValid{false};
+    mutable std::mutex m_searchBlobMutex;
 };
 
 } // namespace lotro::dat
@@ -0,0 +1,224 @@
+/**
+ * @file PropertiesSet.cpp
+ * @brief Implementation of the properties record decoder
+ */
+
+#include "PropertiesSet.hpp"
+
+#include <spdlog/spdlog.h>
+
+namespace lotro::dat {
+
+std::optional<PropertiesSet> PropertiesSet::decode(const QByteArray& data, uint64_t dataId,
+                                                   const PropertiesRegistry& registry) {
+    if (data.size() < 9) {
+        return std::nullopt;
+    }
+    
+    BufferCursor cursor(data);
+    uint32_t did = cursor.readUInt32();
+    if (did != static_cast<uint32_t>(dataId)) {
+        SPDLOG_DEBUG("Properties ID mismatch: expected 0x{:08X}, got 0x{:08X}", dataId, did);
+        return std::nullopt;
+    }
+    cursor.readUInt32(); // reference count
+    
+    PropertiesSet set;
+    int count = cursor.readTSize();
+    if (count < 0 || !decodeValues(cursor, count, registry, set.m_values, 0)) {
+        return std::nullopt;
+    }
+    return set;
+}
+
+bool PropertiesSet::decodeValues(BufferCursor& cursor, int count, const PropertiesRegistry& registry,
+                                 std::vector<PropertyValue>& out, int depth) {
+    if (depth > MAX_DEPTH || static_cast<size_t>(count) > cursor.remaining()) {
+        return false;
+    }
+    out.reserve(out.size() + static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        int propertyId = static_cast<int>(cursor.readUInt32());
+        int repeatedId = static_cast<int>(cursor.readUInt32());
+        if (!cursor.ok() || propertyId != repeatedId) {
+            return false;
+        }
+        
+        PropertyValue value;
+        value.propertyId = propertyId;
+        if (!decodeValue(cursor, registry, value, depth)) {
+            return false;
+        }
+        out.push_back(std::move(value));
+    }
+    return cursor.ok();
+}
+
+bool PropertiesSet::decodeValue(BufferCursor& cursor, const PropertiesRegistry& registry,
+                                PropertyValue& value, int depth) {
+    auto def = registry.getPropertyDef(value.propertyId);
+    if (!def) {
+        SPDLOG_DEBUG("Unknown property {} in properties record", value.propertyId);
+        return false;
+    }
+    value.type = def->type();
+    
+    // Sizes as in PropertyDefinitionsLoader::skipPropertyValue, except for
+    // the containers, which hold full values here
+    switch (value.type) {
+        case PropertyType::TRI_STATE:
+        case PropertyType::BOOLEAN:
+            value.integer = cursor.readUInt8();
+            break;
+        
+        case PropertyType::INT:
+        case PropertyType::ENUM_MAPPER:
+        case PropertyType::PROPERTY_ID:
+        case PropertyType::BIT_FIELD32:
+        case PropertyType::DATA_FILE:
+            value.integer = cursor.readUInt32();
+            break;
+        
+        case PropertyType::STRING_TOKEN:
+            value.tokenId = cursor.readUInt32();
+            value.integer = value.tokenId;
+            break;
+        
+        case PropertyType::FLOAT:
+            value.real = cursor.readFloat();
+            break;
+        
+        case PropertyType::TIMESTAMP:
+            value.real = cursor.readDouble();
+            break;
+        
+        case PropertyType::INSTANCE_ID:
+        case PropertyType::BITFIELD_64:
+        case PropertyType::LONG64:
+            value.integer = static_cast<int64_t>(cursor.readUInt64());
+            break;
+        
+        case PropertyType::STRING:
+            value.text = cursor.readPascalString();
+            break;
+        
+        case PropertyType::STRING_INFO:
+            decodeStringInfo(cursor, value);
+            break;
+        
+        case PropertyType::COLOR:
+            cursor.skip(4);
+            break;
+        
+        case PropertyType::VECTOR:
+            cursor.skip(12);
+            break;
+        
+        case PropertyType::POSITION: {
+            int flags = cursor.readUInt8();
+            size_t size = 0;
+            if (flags & 0x01) size += 1;
+            if (flags & 0x02) size += 2;
+            if (flags & 0x04) size += 2;
+            if (flags & 0x08) size += 2;
+            if (flags & 0x10) size += 12;
+            if (flags & 0x20) size += 16;
+            cursor.skip(size);
+            break;
+        }
+        
+        case PropertyType::BIT_FIELD: {
+            int bitCount = cursor.readVle();
+            cursor.skip(static_cast<size_t>(bitCount / 8 + (bitCount % 8 != 0 ? 1 : 0)));
+            break;
+        }
+        
+        case PropertyType::WAVE_FORM: {
+            uint32_t form = cursor.readUInt32();
+            if (form == 10) {
+                cursor.skip(10 * 4 + 4 + 1);
+                cursor.skip(static_cast<size_t>(cursor.readUInt32()) * 2 * 4);
+            } else if (form == 1) {
+                cursor.skip(4);
+            } else if (form > 1) {
+                cursor.skip(10 * 4);
+            }
+            break;
+        }
+        
+        case PropertyType::ARRAY: {
+            // Elements carry their own property IDs, like top-level values
+            int count = cursor.readTSize();
+            if (count < 0 || !decodeValues(cursor, count, registry, value.children, depth + 1)) {
+                return false;
+            }
+            break;
+        }
+        
+        case PropertyType::STRUCT: {
+            cursor.readUInt8(); // unknown
+            int count = cursor.readTSize();
+            if (count < 0 || !decodeValues(cursor, count, registry, value.children, depth + 1)) {
+                return false;
+            }
+            break;
+        }
+        
+        case PropertyType::UNKNOWN:
+            return false;
+    }
+    return cursor.ok();
+}
+
+void PropertiesSet::decodeStringInfo(BufferCursor& cursor, PropertyValue& value) {
+    // PropertyUtils.readStringInfoProperty; only the main string is kept
+    bool isLiteral = cursor.readBoolean();
+    if (isLiteral) {
+        value.text = cursor.readPrefixedUtf16String();
+    } else {
+        value.tokenId = cursor.readUInt32();
+        value.tableId = cursor.readUInt32();
+    }
+    
+    bool hasStrings = cursor.readBoolean();
+    if (!hasStrings) {
+        cursor.skip(2);
+        return;
+    }
+    cursor.skipPascalString();
+    cursor.skipPascalString();
+    cursor.skipPascalString();
+    
+    int replacements = cursor.readVle();
+    for (int i = 0; i < replacements && cursor.ok(); ++i) {
+        int dataType = cursor.readUInt8();
+        cursor.skip(4);
+        if (dataType != 1) {
+            cursor.skip(1);
+        }
+        if (dataType == 4) {
+            cursor.readVle();
+        } else if (dataType == 1) {
+            PropertyValue nested;
+            decodeStringInfo(cursor, nested);
+        } else if (dataType == 2) {
+            cursor.skip(4);
+        }
+    }
+}
+
+const PropertyValue* PropertiesSet::find(int propertyId) const {
+    for (const PropertyValue& value : m_values) {
+        if (value.propertyId == propertyId) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+int64_t PropertiesSet::integer(int propertyId, int64_t fallback) const {
+    const PropertyValue* value = find(propertyId);
+    return value ? value->integer : fallback;
+}
+
+} // namespace lotro::dat
@@ -0,0 +1,103 @@
+/**
+ * @file PropertiesSet.hpp
+ * @brief Property values decoded from a DAT properties record
+ */
+
+#pragma once
+
+#include "BufferUtils.hpp"
+#include "PropertiesRegistry.hpp"
+
+#include <QByteArray>
+#include <QString>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace lotro::dat {
+
+/**
+ * @brief One decoded property value
+ * 
+ * Which member holds the value depends on type: integer for the integral
+ * and enum types, real for FLOAT and TIMESTAMP, text for STRING and
+ * literal STRING_INFO, tableId/tokenId for a STRING_INFO or STRING_TOKEN
+ * that points into a string table, and children for ARRAY and STRUCT.
+ * Types without a use here (vectors, positions, wave forms, colors) are
+ * skipped over and left empty.
+ */
+struct PropertyValue {
+    int propertyId = 0;
+    PropertyType type = PropertyType::UNKNOWN;
+    int64_t integer = 0;
+    double real = 0.0;
+    QString text;
+    uint32_t tableId = 0;
+    uint32_t tokenId = 0;
+    std::vector<PropertyValue> children;
+    
+    /**
+     * @brief Whether the value is a string table reference to resolve
+     */
+    bool isToken() const { return tableId != 0; }
+};
+
+/**
+ * @class PropertiesSet
+ * @brief The top-level properties of one DAT record
+ * 
+ * Records hold a handful of properties, so lookups scan a flat vector.
+ * 
+ * Usage:
+ * @code
+ * auto props = PropertiesSet::decode(facade.loadData(id), id, *facade.getPropertiesRegistry());
+ * int levelId = registry->getPropertyId("Accomplishment_MinLevelToStart");
+ * int level = props ? props->integer(levelId) : 0;
+ * @endcode
+ */
+class PropertiesSet {
+public:
+    /**
+     * @brief Decode a properties record
+     * 
+     * Follows PropertiesSet decoding in delta-lotro-dat-utils: the record's
+     * data ID, a reference count, then a TSize-counted list of (property ID,
+     * property ID, value). Properties missing from the registry end the
+     * decode, since their size can't be known.
+     * @param data Raw record data as returned by DataFacade::loadData
+     * @param dataId Expected data ID of the record
+     * @return The properties, or nullopt if the data is empty or malformed
+     */
+    static std::optional<PropertiesSet> decode(const QByteArray& data, uint64_t dataId,
+                                               const PropertiesRegistry& registry);
+    
+    /**
+     * @brief Find a property's value
+     * @return The value, or nullptr if the record doesn't set it
+     */
+    const PropertyValue* find(int propertyId) const;
+    
+    bool contains(int propertyId) const { return find(propertyId) != nullptr; }
+    
+    /**
+     * @brief Integer value of a property, or fallback if absent
+     */
+    int64_t integer(int propertyId, int64_t fallback = 0) const;
+    
+    const std::vector<PropertyValue>& values() const { return m_values; }
+    
+private:
+    // Decode count values into out; false if the data ran out or a property is unknown
+    static bool decodeValues(BufferCursor& cursor, int count, const PropertiesRegistry& registry,
+                             std::vector<PropertyValue>& out, int depth);
+    static bool decodeValue(BufferCursor& cursor, const PropertiesRegistry& registry,
+                            PropertyValue& value, int depth);
+    static void decodeStringInfo(BufferCursor& cursor, PropertyValue& value);
+    
+    std::vector<PropertyValue> m_values;
+    
+    // Nested arrays and structs deeper than this are treated as corrupt
+    static constexpr int MAX_DEPTH = 16;
+};
+
+} // namespace lotro::dat
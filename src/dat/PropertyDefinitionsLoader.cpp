@@ -4,7 +4,6 @@
  */
 
 #include "PropertyDefinitionsLoader.hpp"
-#include "BufferUtils.hpp"
 
 #include <spdlog/spdlog.h>
 
@@ -16,61 +15,67 @@ std::unique_ptr<PropertiesRegistry> PropertyDefinitionsLoader::decodeMasterPrope
         return nullptr;
     }
     
-    const char* ptr = data.constData();
-    const char* end = ptr + data.size();
+    BufferCursor cursor(data);
     
     // Read header
-    uint32_t did = BufferUtils::readUInt32(ptr);
-    BufferUtils::skip(ptr, 8); // Skip 8 bytes
+    uint32_t did = cursor.readUInt32();
+    cursor.skip(8); // Skip 8 bytes
     
     if (did != 0x34000000) {
         spdlog::warn("Property DID mismatch: got 0x{:08X}, expected 0x34000000", did);
     }
     
     // Read property names first
-    int numStrings = BufferUtils::readTSize(ptr);
+    int numStrings = cursor.readTSize();
     spdlog::debug("Loading {} property names...", numStrings);
     
     auto registry = std::make_unique<PropertiesRegistry>();
     
-    for (int i = 0; i < numStrings && ptr < end; ++i) {
-        int pid = BufferUtils::readUInt32(ptr);
-        QString name = BufferUtils::readPascalString(ptr);
+    for (int i = 0; i < numStrings && !cursor.atEnd(); ++i) {
+        int pid = cursor.readUInt32();
+        QString name = cursor.readPascalString();
+        if (!cursor.ok()) {
+            break;
+        }
         
         auto def = std::make_shared<PropertyDefinition>(pid, name);
         registry->registerProperty(def);
     }
     
     // Skip 2 bytes
-    BufferUtils::skip(ptr, 2);
+    cursor.skip(2);
     
     // Read property definitions
-    int nbPropertyDefs = BufferUtils::readTSize(ptr);
+    int nbPropertyDefs = cursor.readTSize();
     spdlog::debug("Loading {} property definitions...", nbPropertyDefs);
     
-    for (int i = 0; i < nbPropertyDefs && ptr < end; ++i) {
-        int pid = BufferUtils::readUInt32(ptr);
-        readPropertyDefinition(ptr, pid, registry.get());
+    for (int i = 0; i < nbPropertyDefs && !cursor.atEnd(); ++i) {
+        int pid = cursor.readUInt32();
+        readPropertyDefinition(cursor, pid, registry.get());
+    }
+    
+    if (!cursor.ok()) {
+        spdlog::warn("Property data truncated at offset {} of {}", cursor.position(), data.size());
     }
     
     spdlog::info("Loaded {} properties from DAT file", registry->count());
     return registry;
 }
 
-void PropertyDefinitionsLoader::readPropertyDefinition(const char*& ptr, int expectedPid, PropertiesRegistry* registry) {
+void PropertyDefinitionsLoader::readPropertyDefinition(BufferCursor& cursor, int expectedPid, PropertiesRegistry* registry) {
     auto def = registry->getPropertyDef(expectedPid);
     if (!def) {
         spdlog::warn("Property {} not found in registry", expectedPid);
         return;
     }
     
-    int pid = BufferUtils::readUInt32(ptr);
+    int pid = cursor.readUInt32();
     if (pid != expectedPid) {
         spdlog::error("PID mismatch: expected {}, got {}", expectedPid, pid);
         return;
     }
     
-    int propertyTypeCode = BufferUtils::readUInt32(ptr);
+    int propertyTypeCode = cursor.readUInt32();
     if (propertyTypeCode < 1 || propertyTypeCode > 22) {
         spdlog::error("Invalid property type code: {}", propertyTypeCode);
         return;
@@ -80,40 +85,40 @@ void PropertyDefinitionsLoader::readPropertyDefinition(const char*& ptr, int exp
     def->setType(propertyType);
     
     // Read additional metadata
-    /*int group =*/ BufferUtils::readUInt32(ptr);
-    /*int provider =*/ BufferUtils::readUInt32(ptr);
-    int dataId = BufferUtils::readUInt32(ptr);
+    /*int group =*/ cursor.readUInt32();
+    /*int provider =*/ cursor.readUInt32();
+    int dataId = cursor.readUInt32();
     def->setData(dataId);
     
-    /*int ePatchFlags =*/ BufferUtils::readUInt32(ptr);
-    int v5 = BufferUtils::readUInt32(ptr);
+    /*int ePatchFlags =*/ cursor.readUInt32();
+    int v5 = cursor.readUInt32();
     int flags = (v5 >> 8) & 0xFF;
     
     // Skip optional values based on flags
     // Skip optional values based on flags
     if (flags & 0x08) {
         // Default value
-        skipPropertyValue(ptr, propertyTypeCode);
+        skipPropertyValue(cursor, propertyTypeCode);
     }
     if (flags & 0x10) {
         // Min value
-        skipPropertyValue(ptr, propertyTypeCode);
+        skipPropertyValue(cursor, propertyTypeCode);
     }
     if (flags & 0x20) {
         // Max value
-        skipPropertyValue(ptr, propertyTypeCode);
+        skipPropertyValue(cursor, propertyTypeCode);
     }
     
     // Skip more metadata
-    BufferUtils::skip(ptr, 4); // predictionTimeout (float)
-    BufferUtils::skip(ptr, 4); // inheritanceType, datFileType, propagationType, cachingType (4 bytes)
-    BufferUtils::skip(ptr, 1); // padding
+    cursor.skip(4); // predictionTimeout (float)
+    cursor.skip(4); // inheritanceType, datFileType, propagationType, cachingType (4 bytes)
+    cursor.skip(1); // padding
     
     // Read child properties
-    int nbChildren = BufferUtils::readVle(ptr);
-    for (int i = 0; i < nbChildren; ++i) {
-        int childPid1 = BufferUtils::readUInt32(ptr);
-        int childPid2 = BufferUtils::readUInt32(ptr);
+    int nbChildren = cursor.readVle();
+    for (int i = 0; i < nbChildren && cursor.ok(); ++i) {
+        int childPid1 = cursor.readUInt32();
+        int childPid2 = cursor.readUInt32();
         
         if (childPid1 != childPid2) {
             spdlog::warn("Child PID mismatch: {} != {}", childPid1, childPid2);
@@ -126,26 +131,24 @@ void PropertyDefinitionsLoader::readPropertyDefinition(const char*& ptr, int exp
     }
     
     // Read required properties
-    int nbRequired = BufferUtils::readUInt32(ptr);
-    for (int i = 0; i < nbRequired; ++i) {
-        /*int requiredPid =*/ BufferUtils::readUInt32(ptr);
-    }
+    uint32_t nbRequired = cursor.readUInt32();
+    cursor.skip(static_cast<size_t>(nbRequired) * 4); // requiredPids
     
     // Final check
-    int shouldBeZero = BufferUtils::readUInt32(ptr);
+    int shouldBeZero = cursor.readUInt32();
     if (shouldBeZero != 0) {
         spdlog::warn("Expected 0 at end of property def, got {}", shouldBeZero);
     }
 }
 
-void PropertyDefinitionsLoader::skipPropertyValue(const char*& data, int propertyType) {
+void PropertyDefinitionsLoader::skipPropertyValue(BufferCursor& cursor, int propertyType) {
     // Based on PropertyUtils.readPropertyValue in delta-lotro-dat-utils
     // propertyType code mapping from PropertyType.java
     
     switch (propertyType) {
         case 5: // TRI_STATE (UInt8)
         case 21: // BOOLEAN (UInt8)
-            data += 1;
+            cursor.skip(1);
             break;
             
         case 2: // STRING_TOKEN (UInt32)
@@ -157,125 +160,117 @@ void PropertyDefinitionsLoader::skipPropertyValue(const char*& data, int propert
         case 16: // COLOR (4 bytes)
         case 18: // BIT_FIELD32 (UInt32)
         case 20: // DATA_FILE (UInt32)
-            data += 4;
+            cursor.skip(4);
             break;
             
         case 4: // TIMESTAMP (Double)
         case 7: // INSTANCE_ID (Long64)
         case 14: // BITFIELD_64 (Long64)
         case 19: // LONG64
-            data += 8;
+            cursor.skip(8);
             break;
             
         case 1: // STRING (PascalString)
-            BufferUtils::readPascalString(data);
+            cursor.skipPascalString();
             break;
             
         case 3: // WAVE_FORM
         {
-            uint32_t type = BufferUtils::readUInt32(data);
+            uint32_t type = cursor.readUInt32();
             if (type == 10) {
-                data += 10 * 4; // 10 floats
-                data += 4; // extra float
-                data += 1; // bool
-                uint32_t pairCount = BufferUtils::readUInt32(data);
-                data += pairCount * 2 * 4; // pairCount * 2 floats
+                cursor.skip(10 * 4); // 10 floats
+                cursor.skip(4); // extra float
+                cursor.skip(1); // bool
+                uint32_t pairCount = cursor.readUInt32();
+                cursor.skip(static_cast<size_t>(pairCount) * 2 * 4); // pairCount * 2 floats
             } else if (type == 1) {
-                data += 4; // 1 float
+                cursor.skip(4); // 1 float
             } else if (type > 1) {
-                data += 10 * 4; // 10 floats
+                cursor.skip(10 * 4); // 10 floats
             }
             break;
         }
             
         case 6: // VECTOR (3 floats)
-            data += 12;
+            cursor.skip(12);
             break;
             
         case 11: // STRUCT
-            data += 2; // read(), readUInt8()
+            cursor.skip(2); // read(), readUInt8()
             break;
             
         case 13: // STRING_INFO
-            skipStringInfo(data);
+            skipStringInfo(cursor);
             break;
             
         case 17: // POSITION
-            skipPosition(data);
+            skipPosition(cursor);
             break;
             
         case 22: // BIT_FIELD
         {
-            int bitCount = BufferUtils::readVle(data);
+            int bitCount = cursor.readVle();
             int byteCount = bitCount / 8 + (bitCount % 8 != 0 ? 1 : 0);
-            data += byteCount;
+            cursor.skip(byteCount);
             break;
         }
             
         default:
             spdlog::warn("Skipping unknown property type definition: {} (defaulting to 4 bytes)", propertyType);
-            data += 4;
+            cursor.skip(4);
             break;
     }
 }
 
-void PropertyDefinitionsLoader::skipStringInfo(const char*& data) {
+void PropertyDefinitionsLoader::skipStringInfo(BufferCursor& cursor) {
     // PropertyUtils.readStringInfoProperty
-    bool isLiteral = (BufferUtils::readUInt8(data) != 0);
+    bool isLiteral = (cursor.readUInt8() != 0);
     if (isLiteral) {
-        // UTF-16 pascal string with 4-byte len? 
-        // BufferUtils.readPrefixedUtf16String logic:
-        // Reads uint32 length? No, usually not.
-        // Let's assume standard Pascal string but UTF-16
-        // Wait, PropertyUtils says readPrefixedUtf16String.
-        // We need to implement that skip manually if BufferUtils doesn't have it.
-        // Checking BufferUtils... it doesn't.
-        // Usually it's: uint32 len, then len * 2 bytes.
-        uint32_t len = BufferUtils::readUInt32(data);
-        data += len * 2;
+        // PropertyUtils reads this with readPrefixedUtf16String
+        cursor.skipPrefixedUtf16String();
     } else {
-        data += 8; // token (4) + dataId (4)
+        cursor.skip(8); // token (4) + dataId (4)
     }
     
-    bool hasStrings = (BufferUtils::readUInt8(data) != 0);
+    bool hasStrings = (cursor.readUInt8() != 0);
     if (hasStrings) {
-        BufferUtils::readPascalString(data); // p1
-        BufferUtils::readPascalString(data); // p2
-        BufferUtils::readPascalString(data); // p3
+        cursor.skipPascalString(); // p1
+        cursor.skipPascalString(); // p2
+        cursor.skipPascalString(); // p3
         
-        int numReplacements = BufferUtils::readVle(data);
-        for (int i = 0; i < numReplacements; ++i) {
-            int dataType = BufferUtils::readUInt8(data);
-            data += 4; // replacementToken
+        int numReplacements = cursor.readVle();
+        for (int i = 0; i < numReplacements && cursor.ok(); ++i) {
+            int dataType = cursor.readUInt8();
+            cursor.skip(4); // replacementToken
             
             if (dataType != 1) {
-                data += 1; // is1
+                cursor.skip(1); // is1
             }
             
             if (dataType == 4) {
-                BufferUtils::readVle(data);
+                cursor.readVle();
             } else if (dataType == 1) {
-                skipStringInfo(data); // Recursive
+                skipStringInfo(cursor); // Recursive
             } else if (dataType == 2) {
-                data += 4; // float
+                cursor.skip(4); // float
             }
         }
     } else {
-        data += 2; // remainder1 + remainder2
+        cursor.skip(2); // remainder1 + remainder2
     }
 }
 
-void PropertyDefinitionsLoader::skipPosition(const char*& data) {
+void PropertyDefinitionsLoader::skipPosition(BufferCursor& cursor) {
     // GeoLoader.readPosition
-    int flags = BufferUtils::readUInt8(data);
+    int flags = cursor.readUInt8();
     if (flags == 0) return;
     
-    if (flags & 1) data += 1; // region
-    if (flags & 2) data += 2; // bx, by
-    if (flags & 4) data += 2; // instance
-    if (flags & 8) data += 2; // cell
-    if (flags & 0x10) data += 12; // 3 floats
-    if (flags & 0x20) data += 16; // 4 floats
+    if (flags & 1) cursor.skip(1); // region
+    if (flags & 2) cursor.skip(2); // bx, by
+    if (flags & 4) cursor.skip(2); // instance
+    if (flags & 8) cursor.skip(2); // cell
+    if (flags & 0x10) cursor.skip(12); // 3 floats
+    if (flags & 0x20) cursor.skip(16); // 4 floats
 }
 
 } // namespace lotro::dat
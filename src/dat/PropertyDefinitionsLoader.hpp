@@ -6,6 +6,7 @@
 #pragma once
 
 #include "PropertiesRegistry.hpp"
+#include "BufferUtils.hpp"
 #include <QByteArray>
 #include <memory>
 
@@ -29,16 +30,16 @@ public:
     
 private:
     // Read a single property definition
-    void readPropertyDefinition(const char*& ptr, int expectedPid, PropertiesRegistry* registry);
+    void readPropertyDefinition(BufferCursor& cursor, int expectedPid, PropertiesRegistry* registry);
     
     // Skip over a property value based on type
-    void skipPropertyValue(const char*& ptr, int propertyType);
+    void skipPropertyValue(BufferCursor& cursor, int propertyType);
     
     // Helper to skip StringInfo structure
-    void skipStringInfo(const char*& ptr);
+    void skipStringInfo(BufferCursor& cursor);
     
     // Helper to skip Position structure
-    void skipPosition(const char*& ptr);
+    void skipPosition(BufferCursor& cursor);
 };
 
 } // namespace lotro::dat
@@ -0,0 +1,191 @@
+/**
+ * @file RegistrySnapshot.cpp
+ * @brief Implementation of the properties registry snapshot
+ */
+
+#include "RegistrySnapshot.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace lotro::dat {
+
+namespace {
+
+struct Header {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t entryVersion;
+    uint32_t datPackVersion;
+    uint64_t archiveSize;
+    uint32_t count;
+    uint32_t reserved;
+};
+static_assert(sizeof(Header) == 32, "Header must stay 32 bytes");
+
+// Fixed part of each property record; name bytes and child IDs follow
+struct RecordHeader {
+    int32_t propertyId;
+    int32_t type;
+    int32_t data;
+    uint16_t nameLength;
+    uint16_t childCount;
+};
+static_assert(sizeof(RecordHeader) == 16, "RecordHeader must stay 16 bytes");
+
+template <typename T>
+void append(QByteArray& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+} // anonymous namespace
+
+std::unique_ptr<PropertiesRegistry> RegistrySnapshot::load(const QString& path, const RegistrySnapshotKey& key) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    qint64 size = file.size();
+    if (size < static_cast<qint64>(sizeof(Header))) {
+        return nullptr;
+    }
+
+    uchar* map = file.map(0, size);
+    if (!map) {
+        return nullptr;
+    }
+
+    const char* ptr = reinterpret_cast<const char*>(map);
+    const char* end = ptr + size;
+
+    Header header;
+    std::memcpy(&header, ptr, sizeof(header));
+    ptr += sizeof(header);
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+        || header.formatVersion != FORMAT_VERSION
+        || header.entryVersion != key.entryVersion
+        || header.datPackVersion != key.datPackVersion
+        || header.archiveSize != key.archiveSize) {
+        spdlog::info("Properties registry snapshot is stale, decoding from DAT");
+        file.unmap(map);
+        return nullptr;
+    }
+
+    auto registry = std::make_unique<PropertiesRegistry>();
+    std::vector<std::pair<PropertyDefinitionPtr, std::vector<int>>> pendingChildren;
+
+    bool ok = true;
+    for (uint32_t i = 0; i < header.count; ++i) {
+        RecordHeader record;
+        if (end - ptr < static_cast<qint64>(sizeof(record))) {
+            ok = false;
+            break;
+        }
+        std::memcpy(&record, ptr, sizeof(record));
+        ptr += sizeof(record);
+
+        qint64 payload = record.nameLength + static_cast<qint64>(record.childCount) * sizeof(int32_t);
+        if (end - ptr < payload) {
+            ok = false;
+            break;
+        }
+
+        QString name = QString::fromUtf8(ptr, record.nameLength);
+        ptr += record.nameLength;
+
+        auto def = std::make_shared<PropertyDefinition>(record.propertyId, name,
+                                                        getPropertyTypeByCode(record.type));
+        def->setData(record.data);
+        registry->registerProperty(def);
+
+        if (record.childCount > 0) {
+            std::vector<int> children(record.childCount);
+            std::memcpy(children.data(), ptr, record.childCount * sizeof(int32_t));
+            pendingChildren.emplace_back(def, std::move(children));
+            ptr += record.childCount * sizeof(int32_t);
+        }
+    }
+
+    file.unmap(map);
+
+    if (!ok) {
+        spdlog::warn("Properties registry snapshot {} is truncated", path.toStdString());
+        return nullptr;
+    }
+
+    // Children may refer to properties stored later in the file
+    for (auto& [def, children] : pendingChildren) {
+        for (int childId : children) {
+            def->addChildProperty(registry->getPropertyDef(childId));
+        }
+    }
+
+    spdlog::info("Loaded {} properties from registry snapshot", registry->count());
+    return registry;
+}
+
+bool RegistrySnapshot::save(const QString& path, const RegistrySnapshotKey& key, const PropertiesRegistry& registry) {
+    QByteArray out;
+    out.reserve(registry.count() * 48);
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.entryVersion = key.entryVersion;
+    header.datPackVersion = key.datPackVersion;
+    header.archiveSize = key.archiveSize;
+    header.count = 0;
+    header.reserved = 0;
+    append(out, header);
+
+    for (int id : registry.propertyIds()) {
+        PropertyDefinitionPtr def = registry.getPropertyDef(id);
+        if (!def) {
+            continue;
+        }
+
+        QByteArray name = def->name().toUtf8();
+        const auto& children = def->children();
+
+        RecordHeader record;
+        record.propertyId = def->propertyId();
+        record.type = getCodeFromPropertyType(def->type());
+        record.data = def->data();
+        record.nameLength = static_cast<uint16_t>(qMin<qsizetype>(name.size(), UINT16_MAX));
+        record.childCount = static_cast<uint16_t>(qMin<qsizetype>(children.size(), UINT16_MAX));
+        append(out, record);
+
+        out.append(name.constData(), record.nameLength);
+        for (int i = 0; i < record.childCount; ++i) {
+            append(out, static_cast<int32_t>(children[i]->propertyId()));
+        }
+        ++header.count;
+    }
+
+    std::memcpy(out.data() + offsetof(Header, count), &header.count, sizeof(header.count));
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write properties registry snapshot {}", path.toStdString());
+        return false;
+    }
+    file.write(out);
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit properties registry snapshot {}", path.toStdString());
+        return false;
+    }
+
+    spdlog::debug("Wrote properties registry snapshot ({} properties, {} bytes)", header.count, out.size());
+    return true;
+}
+
+} // namespace lotro::dat
@@ -0,0 +1,52 @@
+/**
+ * @file RegistrySnapshot.hpp
+ * @brief On-disk snapshot of a decoded PropertiesRegistry
+ */
+
+#pragma once
+
+#include "PropertiesRegistry.hpp"
+
+#include <QString>
+#include <cstdint>
+#include <memory>
+
+namespace lotro::dat {
+
+/**
+ * @brief Identifies the DAT state a registry snapshot was decoded from
+ */
+struct RegistrySnapshotKey {
+    uint32_t entryVersion = 0;    // Iteration of the 0x34000000 entry
+    uint32_t datPackVersion = 0;  // Datpack version of the owning archive
+    uint64_t archiveSize = 0;     // Size of the owning archive
+};
+
+/**
+ * @class RegistrySnapshot
+ * @brief Saves and loads a compact binary form of the properties registry
+ *
+ * The snapshot holds every property's ID, name, type, data ID and child IDs.
+ * Loading maps the file once and rebuilds the registry without running
+ * PropertyDefinitionsLoader over the master property blob.
+ */
+class RegistrySnapshot {
+public:
+    /**
+     * @brief Load a snapshot if it matches the given key
+     * @return The registry, or nullptr if the file is missing, corrupt or stale
+     */
+    static std::unique_ptr<PropertiesRegistry> load(const QString& path, const RegistrySnapshotKey& key);
+
+    /**
+     * @brief Write a snapshot atomically
+     * @return true if the file was written
+     */
+    static bool save(const QString& path, const RegistrySnapshotKey& key, const PropertiesRegistry& registry);
+
+private:
+    static constexpr char MAGIC[4] = {'L', 'P', 'R', 'S'};
+    static constexpr uint32_t FORMAT_VERSION = 1;
+};
+
+} // namespace lotro::dat
@@ -0,0 +1,106 @@
+/**
+ * @file StringTable.cpp
+ * @brief Implementation of the indexed string table
+ */
+
+#include "StringTable.hpp"
+#include "BufferUtils.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro::dat {
+
+StringTablePtr StringTable::parse(uint32_t tableId, const QByteArray& data) {
+    if (data.size() < 9) {
+        return nullptr;
+    }
+
+    auto table = std::shared_ptr<StringTable>(new StringTable());
+    table->m_tableId = tableId;
+    table->m_data = data;
+
+    BufferCursor cursor(table->m_data);
+
+    // Header
+    uint32_t did = cursor.readUInt32();
+    if (did != tableId) {
+        spdlog::warn("Table ID mismatch: Expected {}, Got {}", tableId, did);
+    }
+    cursor.readUInt32(); // unknown
+    int nbEntries = cursor.readTSize();
+
+    // The count is untrusted; an entry takes at least 17 bytes (token,
+    // unknown, part count, variable count and the names flag)
+    constexpr size_t MIN_ENTRY_BYTES = 17;
+    table->m_index.reserve(nbEntries > 0
+        ? std::min<size_t>(static_cast<size_t>(nbEntries), cursor.remaining() / MIN_ENTRY_BYTES)
+        : 0);
+
+    // Counted separately from the index, where a repeated token takes one slot
+    int entriesRead = 0;
+    for (int i = 0; i < nbEntries && cursor.ok(); i++) {
+        uint32_t token = cursor.readUInt32();
+        cursor.readUInt32(); // unknown
+        uint32_t labelPartsCount = cursor.readUInt32();
+
+        Location location{static_cast<uint32_t>(cursor.position()), labelPartsCount};
+
+        for (uint32_t j = 0; j < labelPartsCount && cursor.ok(); j++) {
+            cursor.skipPrefixedUtf16String();
+        }
+
+        uint32_t nbVariables = cursor.readUInt32();
+        cursor.skip(static_cast<size_t>(nbVariables) * 4); // variableIDs
+
+        bool hasVarNames = cursor.readBoolean();
+        if (hasVarNames) {
+            uint32_t varNamesCount = cursor.readUInt32();
+            for (uint32_t j = 0; j < varNamesCount && cursor.ok(); j++) {
+                cursor.skipPrefixedUtf16String();
+            }
+        }
+
+        if (!cursor.ok()) {
+            break;
+        }
+        table->m_index.emplace(token, location);
+        entriesRead++;
+    }
+
+    if (entriesRead != qMax(nbEntries, 0)) {
+        spdlog::warn("String Table {} truncated: read {} of {} entries",
+                     tableId, entriesRead, nbEntries);
+    }
+
+    return table;
+}
+
+std::vector<uint32_t> StringTable::tokenIds() const {
+    std::vector<uint32_t> ids;
+    ids.reserve(m_index.size());
+    for (const auto& [tokenId, location] : m_index) {
+        ids.push_back(tokenId);
+    }
+    return ids;
+}
+
+QString StringTable::resolve(uint32_t tokenId) const {
+    auto it = m_index.find(tokenId);
+    if (it == m_index.end()) {
+        return QString();
+    }
+
+    BufferCursor cursor(m_data.constData() + it->second.offset,
+                        static_cast<size_t>(m_data.size()) - it->second.offset);
+    QString result;
+    for (uint32_t j = 0; j < it->second.partCount; j++) {
+        if (!cursor.appendPrefixedUtf16String(result)) {
+            break;
+        }
+    }
+    return result;
+}
+
+} // namespace lotro::dat
@@ -0,0 +1,78 @@
+/**
+ * @file StringTable.hpp
+ * @brief Parsed and indexed LOTRO string table
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace lotro::dat {
+
+class StringTable;
+using StringTablePtr = std::shared_ptr<const StringTable>;
+
+/**
+ * @class StringTable
+ * @brief Token index over the raw bytes of a string table
+ *
+ * Parsing walks the table once, skipping over label parts and variables
+ * without decoding them, and records where each token's label parts start.
+ * Resolving a token then decodes only that token's UTF-16 parts.
+ */
+class StringTable {
+public:
+    /**
+     * @brief Build the token index for a string table
+     * @param tableId Expected table ID (a mismatch is logged)
+     * @param data Raw table data as returned by DataFacade::loadData
+     * @return The parsed table, or nullptr if the data is empty
+     */
+    static StringTablePtr parse(uint32_t tableId, const QByteArray& data);
+
+    /**
+     * @brief Resolve a token to its label
+     * @return The label, or empty string if the token is not in this table
+     */
+    QString resolve(uint32_t tokenId) const;
+
+    /**
+     * @brief Check if the table contains a token
+     */
+    bool contains(uint32_t tokenId) const { return m_index.count(tokenId) != 0; }
+
+    /**
+     * @brief Get the table ID
+     */
+    uint32_t tableId() const { return m_tableId; }
+
+    /**
+     * @brief Number of indexed tokens
+     */
+    size_t size() const { return m_index.size(); }
+
+    /**
+     * @brief Get every indexed token ID, in no particular order
+     */
+    std::vector<uint32_t> tokenIds() const;
+
+private:
+    struct Location {
+        uint32_t offset;     // Offset of the first label part
+        uint32_t partCount;  // Number of label parts
+    };
+
+    StringTable() = default;
+
+    uint32_t m_tableId = 0;
+    QByteArray m_data;
+    std::unordered_map<uint32_t, Location> m_index;
+};
+
+} // namespace lotro::dat
@@ -0,0 +1,184 @@
+/**
+ * @file SurfaceImage.cpp
+ * @brief Implementation of the render surface decoder
+ */
+
+#include "SurfaceImage.hpp"
+#include "BufferUtils.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+
+namespace lotro::dat {
+
+namespace {
+
+// Guard against garbage headers before allocating
+constexpr uint32_t MAX_DIMENSION = 4096;
+
+QRgb rgb565(uint16_t color) {
+    int r = (color >> 11) & 0x1F;
+    int g = (color >> 5) & 0x3F;
+    int b = color & 0x1F;
+    return qRgb((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+// Expand the colour half of a DXT block into a 4x4 patch of the image.
+// DXT1 blocks with color0 <= color1 have three colours and transparent black.
+void decodeColorBlock(const uchar* block, QImage& image, int x, int y, bool dxt1) {
+    uint16_t c0 = qFromLittleEndian<uint16_t>(block);
+    uint16_t c1 = qFromLittleEndian<uint16_t>(block + 2);
+    uint32_t indices = qFromLittleEndian<uint32_t>(block + 4);
+
+    std::array<QRgb, 4> palette;
+    palette[0] = rgb565(c0);
+    palette[1] = rgb565(c1);
+    auto mix = [&](int w0, int w1, int total) {
+        return qRgb((qRed(palette[0]) * w0 + qRed(palette[1]) * w1) / total,
+                    (qGreen(palette[0]) * w0 + qGreen(palette[1]) * w1) / total,
+                    (qBlue(palette[0]) * w0 + qBlue(palette[1]) * w1) / total);
+    };
+    if (c0 > c1 || !dxt1) {
+        palette[2] = mix(2, 1, 3);
+        palette[3] = mix(1, 2, 3);
+    } else {
+        palette[2] = mix(1, 1, 2);
+        palette[3] = qRgba(0, 0, 0, 0);
+    }
+
+    for (int row = 0; row < 4 && y + row < image.height(); ++row) {
+        auto* line = reinterpret_cast<QRgb*>(image.scanLine(y + row));
+        for (int col = 0; col < 4 && x + col < image.width(); ++col) {
+            line[x + col] = palette[(indices >> (2 * (row * 4 + col))) & 0x3];
+        }
+    }
+}
+
+// Apply the explicit 4-bit alpha of a DXT3 block
+void decodeExplicitAlpha(const uchar* block, QImage& image, int x, int y) {
+    uint64_t bits = qFromLittleEndian<uint64_t>(block);
+    for (int row = 0; row < 4 && y + row < image.height(); ++row) {
+        auto* line = reinterpret_cast<QRgb*>(image.scanLine(y + row));
+        for (int col = 0; col < 4 && x + col < image.width(); ++col) {
+            int alpha = static_cast<int>((bits >> (4 * (row * 4 + col))) & 0xF) * 17;
+            QRgb& pixel = line[x + col];
+            pixel = qRgba(qRed(pixel), qGreen(pixel), qBlue(pixel), alpha);
+        }
+    }
+}
+
+// Apply the interpolated alpha of a DXT5 block
+void decodeInterpolatedAlpha(const uchar* block, QImage& image, int x, int y) {
+    std::array<int, 8> alpha;
+    alpha[0] = block[0];
+    alpha[1] = block[1];
+    if (alpha[0] > alpha[1]) {
+        for (int i = 1; i < 7; ++i) {
+            alpha[i + 1] = ((7 - i) * alpha[0] + i * alpha[1]) / 7;
+        }
+    } else {
+        for (int i = 1; i < 5; ++i) {
+            alpha[i + 1] = ((5 - i) * alpha[0] + i * alpha[1]) / 5;
+        }
+        alpha[6] = 0;
+        alpha[7] = 255;
+    }
+
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i) {
+        indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    }
+    for (int row = 0; row < 4 && y + row < image.height(); ++row) {
+        auto* line = reinterpret_cast<QRgb*>(image.scanLine(y + row));
+        for (int col = 0; col < 4 && x + col < image.width(); ++col) {
+            QRgb& pixel = line[x + col];
+            pixel = qRgba(qRed(pixel), qGreen(pixel), qBlue(pixel),
+                          alpha[(indices >> (3 * (row * 4 + col))) & 0x7]);
+        }
+    }
+}
+
+QImage decodeDxt(const uchar* payload, size_t size, int width, int height, SurfaceFormat format) {
+    const size_t blockSize = format == SurfaceFormat::Dxt1 ? 8 : 16;
+    const int blocksWide = (width + 3) / 4;
+    const int blocksHigh = (height + 3) / 4;
+    if (size < blockSize * static_cast<size_t>(blocksWide) * static_cast<size_t>(blocksHigh)) {
+        return {};
+    }
+
+    QImage image(width, height, QImage::Format_ARGB32);
+    const uchar* block = payload;
+    for (int by = 0; by < blocksHigh; ++by) {
+        for (int bx = 0; bx < blocksWide; ++bx, block += blockSize) {
+            switch (format) {
+                case SurfaceFormat::Dxt1:
+                    decodeColorBlock(block, image, bx * 4, by * 4, true);
+                    break;
+                case SurfaceFormat::Dxt3:
+                    decodeColorBlock(block + 8, image, bx * 4, by * 4, false);
+                    decodeExplicitAlpha(block, image, bx * 4, by * 4);
+                    break;
+                default:
+                    decodeColorBlock(block + 8, image, bx * 4, by * 4, false);
+                    decodeInterpolatedAlpha(block, image, bx * 4, by * 4);
+                    break;
+            }
+        }
+    }
+    return image;
+}
+
+// Wrap tightly packed rows, then copy so the image owns its pixels
+QImage decodePacked(const uchar* payload, size_t size, int width, int height,
+                    int bytesPerPixel, QImage::Format format) {
+    const qsizetype stride = static_cast<qsizetype>(width) * bytesPerPixel;
+    if (size < static_cast<size_t>(stride) * static_cast<size_t>(height)) {
+        return {};
+    }
+    return QImage(payload, width, height, stride, format).copy();
+}
+
+} // namespace
+
+QImage decodeSurface(const QByteArray& data) {
+    BufferCursor cursor(data);
+    uint32_t did = cursor.readUInt32();
+    cursor.readUInt32(); // unknown
+    uint32_t width = cursor.readUInt32();
+    uint32_t height = cursor.readUInt32();
+    auto format = static_cast<SurfaceFormat>(cursor.readUInt32());
+    uint32_t length = cursor.readUInt32();
+    if (!cursor.ok() || width == 0 || height == 0 || width > MAX_DIMENSION || height > MAX_DIMENSION) {
+        return {};
+    }
+
+    const auto* payload = reinterpret_cast<const uchar*>(cursor.current());
+    const size_t size = std::min<size_t>(length, cursor.remaining());
+    const int w = static_cast<int>(width);
+    const int h = static_cast<int>(height);
+
+    switch (format) {
+        case SurfaceFormat::A8R8G8B8:
+            return decodePacked(payload, size, w, h, 4, QImage::Format_ARGB32);
+        case SurfaceFormat::X8R8G8B8:
+            return decodePacked(payload, size, w, h, 4, QImage::Format_RGB32);
+        case SurfaceFormat::R8G8B8:
+            // Stored B, G, R in memory
+            return decodePacked(payload, size, w, h, 3, QImage::Format_BGR888);
+        case SurfaceFormat::A8:
+            return decodePacked(payload, size, w, h, 1, QImage::Format_Alpha8);
+        case SurfaceFormat::Jpeg:
+            return QImage::fromData(payload, static_cast<int>(size), "JPG");
+        case SurfaceFormat::Dxt1:
+        case SurfaceFormat::Dxt3:
+        case SurfaceFormat::Dxt5:
+            return decodeDxt(payload, size, w, h, format);
+    }
+
+    spdlog::debug("Surface {:08X}: unsupported format {}", did, static_cast<uint32_t>(format));
+    return {};
+}
+
+} // namespace lotro::dat
@@ -0,0 +1,46 @@
+/**
+ * @file SurfaceImage.hpp
+ * @brief Decoder for LOTRO render surfaces (icons and other UI images)
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QImage>
+#include <cstdint>
+
+namespace lotro::dat {
+
+/**
+ * @brief Pixel formats found in render surface entries
+ *
+ * Numeric values follow Direct3D's D3DFORMAT, which the client stores
+ * as-is; compressed formats use their FourCC.
+ */
+enum class SurfaceFormat : uint32_t {
+    R8G8B8 = 20,
+    A8R8G8B8 = 21,
+    X8R8G8B8 = 22,
+    A8 = 28,
+    Jpeg = 500,
+    Dxt1 = 0x31545844,  // "DXT1"
+    Dxt3 = 0x33545844,  // "DXT3"
+    Dxt5 = 0x35545844   // "DXT5"
+};
+
+/**
+ * @brief Decode a render surface entry into an image
+ *
+ * Entries start with the data ID, an unknown word, width, height, pixel
+ * format and payload length, followed by the payload. Uncompressed
+ * formats are converted directly, DXT blocks are expanded in software
+ * and JPEG payloads go through Qt's image readers.
+ *
+ * Safe to call from any thread.
+ * @param data Raw entry as returned by DataFacade::loadData
+ * @return The image, or a null image if the entry is truncated or the
+ *         format is not supported
+ */
+QImage decodeSurface(const QByteArray& data);
+
+} // namespace lotro::dat
@@ -0,0 +1,119 @@
+/**
+ * @file UringReader.cpp
+ * @brief Implementation of batched io_uring reads
+ */
+
+#include "UringReader.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace lotro::dat {
+
+UringReader::~UringReader() {
+#ifdef LOTRO_IO_URING
+    if (m_ready) {
+        io_uring_queue_exit(&m_ring);
+    }
+#endif
+}
+
+bool UringReader::init() {
+#ifdef LOTRO_IO_URING
+    int rc = io_uring_queue_init(QUEUE_DEPTH, &m_ring, 0);
+    if (rc < 0) {
+        spdlog::warn("io_uring unavailable: {}", std::strerror(-rc));
+        return false;
+    }
+    m_ready = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool UringReader::isAvailable() {
+    return forThisThread() != nullptr;
+}
+
+UringReader* UringReader::forThisThread() {
+    thread_local std::unique_ptr<UringReader> reader;
+    thread_local bool tried = false;
+    if (!tried) {
+        tried = true;
+        std::unique_ptr<UringReader> candidate(new UringReader());
+        if (candidate->init()) {
+            reader = std::move(candidate);
+        }
+    }
+    return reader.get();
+}
+
+bool UringReader::read(std::span<UringRead> reads) {
+#ifdef LOTRO_IO_URING
+    if (!m_ready) {
+        return false;
+    }
+    
+    // Reads still owing bytes; short reads go back on the queue
+    std::vector<size_t> queue;
+    queue.reserve(reads.size());
+    for (size_t i = 0; i < reads.size(); ++i) {
+        reads[i].result = 0;
+        if (reads[i].length > 0) {
+            queue.push_back(i);
+        }
+    }
+    
+    size_t next = 0;
+    unsigned inFlight = 0;
+    while (next < queue.size() || inFlight > 0) {
+        while (next < queue.size() && inFlight < QUEUE_DEPTH) {
+            io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+            if (!sqe) {
+                break;
+            }
+            UringRead& r = reads[queue[next]];
+            io_uring_prep_read(sqe, r.fd, r.dest + r.result, r.length - static_cast<uint32_t>(r.result),
+                               r.offset + static_cast<uint64_t>(r.result));
+            io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(static_cast<uintptr_t>(queue[next])));
+            ++next;
+            ++inFlight;
+        }
+        
+        int rc = io_uring_submit_and_wait(&m_ring, 1);
+        if (rc < 0 && rc != -EINTR) {
+            spdlog::error("io_uring submit failed: {}", std::strerror(-rc));
+            return false;
+        }
+        
+        io_uring_cqe* cqe = nullptr;
+        unsigned head = 0;
+        unsigned seen = 0;
+        io_uring_for_each_cqe(&m_ring, head, cqe) {
+            size_t index = static_cast<size_t>(reinterpret_cast<uintptr_t>(io_uring_cqe_get_data(cqe)));
+            UringRead& r = reads[index];
+            if (cqe->res < 0) {
+                r.result = cqe->res;
+            } else if (cqe->res > 0) {
+                r.result += cqe->res;
+                if (r.result < static_cast<qint64>(r.length)) {
+                    queue.push_back(index);
+                }
+            }
+            ++seen;
+        }
+        io_uring_cq_advance(&m_ring, seen);
+        inFlight -= seen;
+    }
+    return true;
+#else
+    (void)reads;
+    return false;
+#endif
+}
+
+} // namespace lotro::dat
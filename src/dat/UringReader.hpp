@@ -0,0 +1,76 @@
+/**
+ * @file UringReader.hpp
+ * @brief Batched positional reads through io_uring
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <cstdint>
+#include <span>
+
+#ifdef LOTRO_IO_URING
+#include <liburing.h>
+#endif
+
+namespace lotro::dat {
+
+/**
+ * @brief One read of a batch
+ */
+struct UringRead {
+    int fd = -1;
+    uint64_t offset = 0;
+    char* dest = nullptr;
+    uint32_t length = 0;
+    qint64 result = 0;      // Bytes read (short at end of file), or -errno
+};
+
+/**
+ * @class UringReader
+ * @brief Submits many reads at once and waits for all of them
+ * 
+ * Keeps up to QUEUE_DEPTH reads in flight, so a batch costs a handful of
+ * system calls instead of one per read and the device sees a deep queue.
+ * A ring is not thread-safe, so each thread gets its own through
+ * forThisThread(). Only built with ENABLE_IO_URING on Linux; elsewhere,
+ * or when the kernel refuses io_uring, isAvailable() is false.
+ */
+class UringReader {
+public:
+    ~UringReader();
+    
+    UringReader(const UringReader&) = delete;
+    UringReader& operator=(const UringReader&) = delete;
+    
+    /**
+     * @brief Whether io_uring works in this build and on this kernel
+     */
+    static bool isAvailable();
+    
+    /**
+     * @brief The calling thread's reader, or nullptr if io_uring is unavailable
+     */
+    static UringReader* forThisThread();
+    
+    /**
+     * @brief Run a batch of reads to completion
+     * 
+     * Short reads are resubmitted for the remainder until the end of file.
+     * @return false if the ring itself failed; per-read errors are in result
+     */
+    bool read(std::span<UringRead> reads);
+    
+private:
+    UringReader() = default;
+    bool init();
+
+#ifdef LOTRO_IO_URING
+    io_uring m_ring{};
+#endif
+    bool m_ready = false;
+    
+    static constexpr unsigned QUEUE_DEPTH = 128;
+};
+
+} // namespace lotro::dat
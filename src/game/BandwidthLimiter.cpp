@@ -0,0 +1,60 @@
+/**
+ * LOTRO Launcher - Bandwidth Limiter Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "BandwidthLimiter.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro {
+
+BandwidthLimiter& BandwidthLimiter::shared() {
+    static BandwidthLimiter limiter;
+    return limiter;
+}
+
+BandwidthLimiter::BandwidthLimiter() {
+    m_clock.start();
+}
+
+void BandwidthLimiter::setLimit(qint64 bytesPerSecond) {
+    bytesPerSecond = std::max<qint64>(0, bytesPerSecond);
+    if (bytesPerSecond == m_limit) {
+        return;
+    }
+    m_limit = bytesPerSecond;
+    m_tokens = 0.0;
+    m_refilledAt = m_clock.nsecsElapsed();
+    if (m_limit > 0) {
+        spdlog::info("Download bandwidth limited to {} KB/s", m_limit / 1024);
+    } else {
+        spdlog::info("Download bandwidth unlimited");
+    }
+}
+
+void BandwidthLimiter::refill() {
+    // Calls come far more often than once a millisecond, so time is kept
+    // in nanoseconds against a fixed origin; restarting a millisecond
+    // clock would drop each call's fraction and undershoot the limit
+    const qint64 now = m_clock.nsecsElapsed();
+    const qint64 elapsed = now - m_refilledAt;
+    m_refilledAt = now;
+    const double burst = std::max<double>(MIN_BURST, m_limit / 4.0);
+    m_tokens = std::min(burst, m_tokens + m_limit * (elapsed / 1e9));
+}
+
+qint64 BandwidthLimiter::acquire(qint64 wanted) {
+    if (m_limit <= 0 || wanted <= 0) {
+        return std::max<qint64>(0, wanted);
+    }
+    refill();
+    const qint64 granted = std::min(wanted, static_cast<qint64>(m_tokens));
+    m_tokens -= granted;
+    return granted;
+}
+
+} // namespace lotro
@@ -0,0 +1,56 @@
+/**
+ * LOTRO Launcher - Bandwidth Limiter
+ * 
+ * Token bucket shared by every download in the process.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+namespace lotro {
+
+/**
+ * Caps the combined read rate of all downloads
+ * 
+ * Downloads ask for the bytes they want to read and read only what they
+ * are granted; unread data stays in the socket, so TCP slows the sender
+ * down instead of the launcher buffering it. Tokens accrue with elapsed
+ * time up to a quarter second's worth, which keeps bursts short.
+ * 
+ * Not thread-safe: the bucket is unguarded, so every caller must be on
+ * the main thread, which is where the download sockets live.
+ */
+class BandwidthLimiter {
+public:
+    static BandwidthLimiter& shared();
+    
+    /**
+     * Bytes per second over all downloads, 0 for no limit
+     */
+    void setLimit(qint64 bytesPerSecond);
+    qint64 limit() const { return m_limit; }
+    bool isLimited() const { return m_limit > 0; }
+    
+    /**
+     * How many of the wanted bytes may be read now; may be 0
+     */
+    qint64 acquire(qint64 wanted);
+    
+    static constexpr qint64 MIN_BURST = 16 * 1024;
+
+private:
+    BandwidthLimiter();
+    
+    void refill();
+    
+    qint64 m_limit = 0;
+    double m_tokens = 0.0;
+    QElapsedTimer m_clock;
+    qint64 m_refilledAt = 0;            // m_clock time tokens were last added, in ns
+};
+
+} // namespace lotro
@@ -5,11 +5,16 @@
  */
 
 #include "DatFile.hpp"
+#include "dat/DatArchive.hpp"
+#include "dat/DatIndex.hpp"
 
 #include <spdlog/spdlog.h>
 
 #include <QDataStream>
 #include <QDir>
+#include <QtConcurrent>
+
+#include <algorithm>
 
 namespace lotro {
 
@@ -28,6 +33,7 @@ constexpr int SB_FREE_HEAD = 0x154;
 constexpr int SB_FREE_TAIL = 0x158;
 constexpr int SB_FREE_SIZE = 0x15C;
 constexpr int SB_DIRECTORY_OFFSET = 0x160;
+constexpr int SB_DATPACK_VERSION = 0x174;
 
 DatFile::DatFile(const std::filesystem::path& path)
     : m_path(path)
@@ -236,21 +242,91 @@ uint32_t DatFile::getMaxFileVersion() const {
     return maxVersion;
 }
 
-std::vector<DatVersionInfo> scanDatVersions(const std::filesystem::path& gameDirectory) {
-    std::vector<DatVersionInfo> results;
+std::optional<DatVersionInfo> probeDatVersion(const std::filesystem::path& datPath) {
+    QString path = QString::fromStdString(datPath.string());
+    
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+    
+    QByteArray buf = file.read(1024);
+    if (buf.size() < 1024) {
+        return std::nullopt;
+    }
+    
+    auto readDword = [&buf](int offset) {
+        return static_cast<uint32_t>(
+            (static_cast<uint8_t>(buf[offset])) |
+            (static_cast<uint8_t>(buf[offset + 1]) << 8) |
+            (static_cast<uint8_t>(buf[offset + 2]) << 16) |
+            (static_cast<uint8_t>(buf[offset + 3]) << 24));
+    };
+    
+    if (readDword(SB_MAGIC_LP) != MAGIC_LP || readDword(SB_MAGIC_TB) != MAGIC_TB) {
+        return std::nullopt;
+    }
+    
+    DatVersionInfo info;
+    info.datPath = datPath;
+    info.datName = QString::fromStdString(datPath.filename().string());
+    info.version = readDword(SB_VERSION);
+    info.maxFileVersion = 0;
+    info.fileCount = 0;
+    
+    auto summarize = [&info](const dat::DatIndex& index) {
+        for (const dat::DatIndexRecord& record : index.records()) {
+            info.maxFileVersion = std::max(info.maxFileVersion, record.version);
+        }
+        info.fileCount = index.size();
+    };
+    
+    dat::DatIndexKey key;
+    key.superblockVersion = info.version;
+    key.datPackVersion = readDword(SB_DATPACK_VERSION);
+    key.archiveSize = static_cast<uint64_t>(file.size());
+    file.close();
+    
+    QString indexDir = dat::DatIndex::defaultDirectory();
+    dat::DatIndex index;
+    if (index.open(dat::DatIndex::pathFor(indexDir, path), key)) {
+        summarize(index);
+        return info;
+    }
+    
+    // No usable index yet: let DatArchive walk the tree once and persist it
+    dat::DatArchive archive(path);
+    archive.setIndexDirectory(indexDir);
+    if (archive.open() && archive.index().isLoaded()) {
+        summarize(archive.index());
+        return info;
+    }
+    
+    // Fall back to the full directory walk
+    DatFile dat(datPath);
+    if (!dat.isValid()) {
+        return std::nullopt;
+    }
+    info.maxFileVersion = dat.getMaxFileVersion();
+    info.fileCount = dat.fileCount();
+    return info;
+}
 
+std::vector<DatVersionInfo> scanDatVersions(const std::filesystem::path& gameDirectory) {
+    std::vector<std::filesystem::path> datPaths;
     for (const auto& entry : std::filesystem::directory_iterator(gameDirectory)) {
         if (entry.is_regular_file() && entry.path().extension() == ".dat") {
-            DatFile dat(entry.path());
-            if (dat.isValid()) {
-                DatVersionInfo info;
-                info.datPath = entry.path();
-                info.datName = QString::fromStdString(entry.path().filename().string());
-                info.version = dat.currentVersion();
-                info.maxFileVersion = dat.getMaxFileVersion();
-                info.fileCount = dat.fileCount();
-                results.push_back(info);
-            }
+            datPaths.push_back(entry.path());
+        }
+    }
+    
+    QList<std::optional<DatVersionInfo>> probed = QtConcurrent::blockingMapped<QList<std::optional<DatVersionInfo>>>(
+        datPaths, [](const std::filesystem::path& datPath) { return probeDatVersion(datPath); });
+    
+    std::vector<DatVersionInfo> results;
+    for (const auto& info : probed) {
+        if (info) {
+            results.push_back(*info);
         }
     }
 
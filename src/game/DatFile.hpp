@@ -143,8 +143,20 @@ struct DatVersionInfo {
     size_t fileCount;
 };
 
+/**
+ * Get version info for a single .dat file without walking its directory
+ * 
+ * Reads only the superblock, then takes the per-file versions from the
+ * flat file index shared with dat::DatArchive. If no index exists yet it
+ * is built once, so later probes of the same archive take milliseconds.
+ * @return Version info, or nullopt if the file is not a valid archive
+ */
+std::optional<DatVersionInfo> probeDatVersion(const std::filesystem::path& datPath);
+
 /**
  * Scan game directory for .dat files and get their version info
+ * 
+ * Archives are probed in parallel with probeDatVersion().
  */
 std::vector<DatVersionInfo> scanDatVersions(const std::filesystem::path& gameDirectory);
 
@@ -0,0 +1,293 @@
+/**
+ * LOTRO Launcher - DAT Prewarmer Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "DatPrewarmer.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#ifdef PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace lotro {
+
+namespace {
+
+#ifdef PLATFORM_LINUX
+/**
+ * MemAvailable from /proc/meminfo in bytes, 0 if unknown
+ */
+qint64 availableMemory() {
+    QFile meminfo("/proc/meminfo");
+    if (!meminfo.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    while (!meminfo.atEnd()) {
+        QByteArray line = meminfo.readLine();
+        if (line.startsWith("MemAvailable:")) {
+            return line.mid(13).trimmed().split(' ').value(0).toLongLong() * 1024;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Read-only mapping of a whole file, for asking mincore about it
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+        m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (m_fd < 0) {
+            return;
+        }
+        m_size = static_cast<qint64>(::lseek(m_fd, 0, SEEK_END));
+        if (m_size > 0) {
+            m_data = ::mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_SHARED, m_fd, 0);
+            if (m_data == MAP_FAILED) {
+                m_data = nullptr;
+            }
+        }
+    }
+    
+    ~MappedFile() {
+        if (m_data) {
+            ::munmap(m_data, static_cast<size_t>(m_size));
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    bool isValid() const { return m_data != nullptr; }
+    int fd() const { return m_fd; }
+    qint64 size() const { return m_size; }
+    
+    /**
+     * Bytes of [offset, offset + length) that are in the page cache
+     */
+    qint64 residentBytes(qint64 offset, qint64 length) const {
+        static const qint64 pageSize = ::sysconf(_SC_PAGESIZE);
+        length = std::min(length, m_size - offset);
+        std::vector<unsigned char> pages(static_cast<size_t>((length + pageSize - 1) / pageSize));
+        if (::mincore(static_cast<char*>(m_data) + offset, static_cast<size_t>(length), pages.data()) != 0) {
+            return 0;
+        }
+        qint64 resident = 0;
+        for (unsigned char page : pages) {
+            resident += (page & 1) ? pageSize : 0;
+        }
+        return std::min(resident, length);
+    }
+    
+private:
+    int m_fd = -1;
+    qint64 m_size = 0;
+    void* m_data = nullptr;
+};
+#endif
+
+} // anonymous namespace
+
+DatPrewarmer::DatPrewarmer(const std::filesystem::path& gameDirectory)
+    : m_gameDirectory(gameDirectory)
+{
+}
+
+std::vector<std::filesystem::path> DatPrewarmer::datFiles() const {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(m_gameDirectory, ec)) {
+        if (entry.is_regular_file() &&
+            QString::fromStdString(entry.path().extension().string()).compare(".dat", Qt::CaseInsensitive) == 0) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::filesystem::path DatPrewarmer::profilePath() const {
+    QByteArray key = QCryptographicHash::hash(
+        QByteArray::fromStdString(m_gameDirectory.string()), QCryptographicHash::Sha1).toHex().left(16);
+    return Platform::getCachePath() / "dat-profiles" / (key.toStdString() + ".profile");
+}
+
+std::vector<DatPrewarmer::FileProfile> DatPrewarmer::loadProfile() const {
+    std::vector<FileProfile> profile;
+    QFile file(QString::fromStdString(profilePath().string()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return profile;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version >> count;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("DAT access profile {} is outdated, ignoring it", file.fileName().toStdString());
+        return profile;
+    }
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        FileProfile entry;
+        in >> entry.name >> entry.scores;
+        profile.push_back(std::move(entry));
+    }
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("DAT access profile {} is corrupt, ignoring it", file.fileName().toStdString());
+        profile.clear();
+    }
+    return profile;
+}
+
+bool DatPrewarmer::saveProfile(const std::vector<FileProfile>& profile) const {
+    QString path = QString::fromStdString(profilePath().string());
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write DAT access profile {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << static_cast<quint32>(profile.size());
+    for (const auto& entry : profile) {
+        out << entry.name << entry.scores;
+    }
+    return file.commit();
+}
+
+qint64 DatPrewarmer::defaultRate() const {
+    return Platform::isRotationalStorage(m_gameDirectory).value_or(false) ? HDD_RATE : SSD_RATE;
+}
+
+void DatPrewarmer::recordSession() {
+#ifdef PLATFORM_LINUX
+    std::vector<FileProfile> previous = loadProfile();
+    std::vector<FileProfile> profile;
+    qint64 residentTotal = 0;
+    
+    for (const auto& path : datFiles()) {
+        MappedFile dat(path);
+        if (!dat.isValid()) {
+            continue;
+        }
+        
+        FileProfile entry;
+        entry.name = QString::fromStdString(path.filename().string());
+        auto old = std::find_if(previous.begin(), previous.end(),
+                                [&](const FileProfile& p) { return p.name == entry.name; });
+        
+        const qint64 chunks = (dat.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        entry.scores.resize(chunks);
+        for (qint64 chunk = 0; chunk < chunks; ++chunk) {
+            // Patches move data around a little; a resized file keeps its
+            // history for the chunks both sizes have
+            quint8 score = (old != previous.end() && chunk < old->scores.size())
+                ? static_cast<quint8>(old->scores[chunk]) / 2 : 0;
+            qint64 resident = dat.residentBytes(chunk * CHUNK_SIZE, CHUNK_SIZE);
+            if (resident > 0) {
+                score += 128;
+                residentTotal += resident;
+            }
+            entry.scores[chunk] = static_cast<char>(score);
+        }
+        profile.push_back(std::move(entry));
+    }
+    
+    if (!profile.empty() && saveProfile(profile)) {
+        spdlog::info("Recorded DAT access profile: {} MiB cached across {} files",
+                     residentTotal >> 20, profile.size());
+    }
+#endif
+}
+
+PrewarmReport DatPrewarmer::warm(qint64 maxBytesPerSecond, qint64 timeBudgetMs) {
+    PrewarmReport report;
+#ifdef PLATFORM_LINUX
+    QElapsedTimer clock;
+    clock.start();
+    
+    const std::vector<FileProfile> profile = loadProfile();
+    if (profile.empty()) {
+        spdlog::info("No DAT access profile yet; it is recorded after the first session");
+        return report;
+    }
+    const qint64 memoryBudget = availableMemory() / 2;
+    
+    for (const auto& entry : profile) {
+        MappedFile dat(m_gameDirectory / entry.name.toStdString());
+        if (!dat.isValid()) {
+            continue;
+        }
+        ++report.files;
+        
+        const qint64 chunks = std::min<qint64>(entry.scores.size(), (dat.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+        for (qint64 chunk = 0; chunk < chunks; ++chunk) {
+            if (static_cast<quint8>(entry.scores[chunk]) < HOT_SCORE) {
+                continue;
+            }
+            const qint64 offset = chunk * CHUNK_SIZE;
+            const qint64 length = std::min(CHUNK_SIZE, dat.size() - offset);
+            report.hotBytes += length;
+            
+            const qint64 resident = dat.residentBytes(offset, length);
+            report.cachedBytes += resident;
+            if (resident == length || report.stoppedEarly) {
+                continue;
+            }
+            if (clock.elapsed() >= timeBudgetMs ||
+                (memoryBudget > 0 && report.warmedBytes + length > memoryBudget)) {
+                report.stoppedEarly = true;
+                continue;
+            }
+            
+            // readahead() waits for the read, which is what lets it be
+            // paced; filesystems without it still take the hint
+            if (::readahead(dat.fd(), offset, static_cast<size_t>(length)) != 0) {
+                ::posix_fadvise(dat.fd(), offset, length, POSIX_FADV_WILLNEED);
+            }
+            report.warmedBytes += length - resident;
+            
+            if (maxBytesPerSecond > 0) {
+                const qint64 due = report.warmedBytes * 1000 / maxBytesPerSecond;
+                if (due > clock.elapsed()) {
+                    QThread::msleep(static_cast<unsigned long>(due - clock.elapsed()));
+                }
+            }
+        }
+    }
+    
+    report.elapsedMs = clock.elapsed();
+    spdlog::info("Prewarmed {} MiB of {} MiB hot DAT data ({} MiB already cached) in {} ms{}",
+                 report.warmedBytes >> 20, report.hotBytes >> 20, report.cachedBytes >> 20,
+                 report.elapsedMs, report.stoppedEarly ? ", stopped at budget" : "");
+#else
+    (void)maxBytesPerSecond;
+    (void)timeBudgetMs;
+#endif
+    return report;
+}
+
+} // namespace lotro
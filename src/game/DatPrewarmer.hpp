@@ -0,0 +1,92 @@
+/**
+ * LOTRO Launcher - DAT Prewarmer
+ * 
+ * Loads the parts of the game's DAT files the client reads early into
+ * the page cache before it starts.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <filesystem>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * What a prewarm found and did
+ */
+struct PrewarmReport {
+    int files = 0;
+    qint64 hotBytes = 0;        // Regions the access profile marks as hot
+    qint64 cachedBytes = 0;     // Of those, already in the page cache
+    qint64 warmedBytes = 0;     // Read in by this run
+    qint64 elapsedMs = 0;
+    bool stoppedEarly = false;  // Ran out of time or memory budget
+};
+
+/**
+ * Page-cache prewarming driven by an access profile of past sessions
+ * 
+ * After a session, recordSession() asks the kernel (mincore) which 1 MiB
+ * chunks of each DAT file are still cached, which is what the client
+ * read, and folds that into a per-installation profile in which every
+ * session counts half as much as the one after it. warm() then reads the
+ * chunks that were hot in recent sessions with readahead(), skipping any
+ * already cached, no faster than the given rate, within a time budget
+ * and never more than half the available memory. Chunks only get warm
+ * by being in the profile, so prewarming can't grow its own profile.
+ * 
+ * Linux only; elsewhere both calls do nothing.
+ */
+class DatPrewarmer {
+public:
+    explicit DatPrewarmer(const std::filesystem::path& gameDirectory);
+    
+    /**
+     * Add the current page-cache contents of the DAT files to the profile
+     */
+    void recordSession();
+    
+    /**
+     * Read the profile's hot chunks into the page cache
+     * 
+     * @param maxBytesPerSecond Read rate limit, 0 for none
+     * @param timeBudgetMs Stop after this long
+     */
+    PrewarmReport warm(qint64 maxBytesPerSecond, qint64 timeBudgetMs);
+    
+    /**
+     * Rate that suits the disk the game is on
+     */
+    qint64 defaultRate() const;
+    
+    static constexpr qint64 CHUNK_SIZE = 1 << 20;
+    static constexpr qint64 TIME_BUDGET_MS = 20000;
+    static constexpr qint64 MIN_SESSION_MS = 2 * 60 * 1000;   // Shorter sessions aren't recorded
+    static constexpr qint64 HDD_RATE = 80ll << 20;
+    static constexpr qint64 SSD_RATE = 400ll << 20;
+    
+private:
+    struct FileProfile {
+        QString name;
+        QByteArray scores;      // One per chunk; halved each session, +128 if cached
+    };
+    
+    std::vector<std::filesystem::path> datFiles() const;
+    std::filesystem::path profilePath() const;
+    std::vector<FileProfile> loadProfile() const;
+    bool saveProfile(const std::vector<FileProfile>& profile) const;
+    
+    std::filesystem::path m_gameDirectory;
+    
+    static constexpr quint32 MAGIC = 0x44505750;     // "DPWP"
+    static constexpr quint32 VERSION = 1;
+    static constexpr quint8 HOT_SCORE = 96;          // Cached last session, or in two of the last three
+};
+
+} // namespace lotro
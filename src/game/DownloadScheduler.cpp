@@ -0,0 +1,543 @@
+/**
+ * LOTRO Launcher - Download Scheduler Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "DownloadScheduler.hpp"
+#include "BandwidthLimiter.hpp"
+#include "VerifyPool.hpp"
+#include "core/DownloadWriter.hpp"
+#include "core/Metrics.hpp"
+#include "network/HttpClient.hpp"
+#include "network/NetworkTrace.hpp"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSaveFile>
+#include <QTimer>
+#include <QtConcurrent>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace lotro {
+
+DownloadScheduler::DownloadScheduler(QNetworkAccessManager* manager, QObject* parent)
+    : QObject(parent)
+    , m_manager(manager)
+    , m_throttle(new QTimer(this))
+{
+    m_throttle->setInterval(THROTTLE_TICK_MS);
+    connect(m_throttle, &QTimer::timeout, this, &DownloadScheduler::throttleTick);
+}
+
+DownloadScheduler::~DownloadScheduler() {
+    cancel();
+}
+
+void DownloadScheduler::setMaxConnections(int connections) {
+    m_maxConnections = std::max(1, connections);
+    startJobs();
+}
+
+void DownloadScheduler::setMaxPerHost(int connections) {
+    m_maxPerHost = std::max(1, connections);
+    startJobs();
+}
+
+void DownloadScheduler::setTimeout(int milliseconds) {
+    m_timeout = milliseconds;
+}
+
+void DownloadScheduler::enqueue(DownloadJob job) {
+    auto after = std::find_if(m_queue.begin(), m_queue.end(), [&job](const DownloadJob& queued) {
+        return queued.priority > job.priority;
+    });
+    m_queue.insert(after, std::move(job));
+    m_busy = true;
+    startJobs();
+}
+
+void DownloadScheduler::setVerifyPool(VerifyPool* pool) {
+    m_verifyPool = pool;
+}
+
+QThreadPool* DownloadScheduler::hashThreads() const {
+    return m_verifyPool ? m_verifyPool->pool() : QThreadPool::globalInstance();
+}
+
+qint64 DownloadScheduler::bytesReceived() const {
+    return m_finishedBytes + activeBytes();
+}
+
+qint64 DownloadScheduler::activeBytes() const {
+    qint64 total = 0;
+    for (const auto& active : m_active) {
+        total += active.received;
+    }
+    return total;
+}
+
+void DownloadScheduler::startJobs() {
+    // First queued job whose host has room, until the connection budget is spent
+    for (auto it = m_queue.begin(); it != m_queue.end() && m_active.size() < m_maxConnections;) {
+        if (m_perHost.value(it->url.host()) >= m_maxPerHost) {
+            ++it;
+            continue;
+        }
+        DownloadJob job = std::move(*it);
+        it = m_queue.erase(it);
+        start(std::move(job));
+    }
+}
+
+std::filesystem::path DownloadScheduler::partPath(const std::filesystem::path& localPath) {
+    std::filesystem::path part = localPath;
+    part += ".part";
+    return part;
+}
+
+std::filesystem::path DownloadScheduler::metaPath(const std::filesystem::path& localPath) {
+    std::filesystem::path meta = localPath;
+    meta += ".part.meta";
+    return meta;
+}
+
+void DownloadScheduler::discardPart(const std::filesystem::path& localPath) {
+    QFile::remove(QString::fromStdString(partPath(localPath).string()));
+    QFile::remove(QString::fromStdString(metaPath(localPath).string()));
+}
+
+QString DownloadScheduler::readValidator(const DownloadJob& job) {
+    QFile file(QString::fromStdString(metaPath(job.localPath).string()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    const QJsonObject meta = QJsonDocument::fromJson(file.readAll()).object();
+    if (meta.value("url").toString() != job.url.toString() || meta.value("md5").toString() != job.md5) {
+        return {};
+    }
+    return meta.value("validator").toString();
+}
+
+void DownloadScheduler::writeValidator(const DownloadJob& job, const QString& validator) {
+    const QString path = QString::fromStdString(metaPath(job.localPath).string());
+    if (validator.isEmpty()) {
+        QFile::remove(path);
+        return;
+    }
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QJsonObject meta{{"url", job.url.toString()}, {"md5", job.md5}, {"validator", validator}};
+    file.write(QJsonDocument(meta).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit download state {}", path.toStdString());
+    }
+}
+
+void DownloadScheduler::start(DownloadJob job) {
+    spdlog::debug("Downloading: {} -> {}", job.url.toString().toStdString(), job.localPath.string());
+    
+    // Pick up a part file left by an earlier attempt, if the server can
+    // vouch that it is still the same file
+    const QString partName = QString::fromStdString(partPath(job.localPath).string());
+    QString validator;
+    qint64 offset = 0;
+    if (job.resume) {
+        validator = readValidator(job);
+        offset = validator.isEmpty() ? 0 : QFileInfo(partName).size();
+    }
+    if (offset == 0) {
+        discardPart(job.localPath);
+    }
+    
+    auto file = std::make_shared<DownloadWriter>(partName);
+    if (!file->open(offset > 0, job.expectedSize)) {
+        spdlog::error("Failed to open file for writing: {}", file->fileName().toStdString());
+        const int id = job.id;
+        const QString error = QString("Failed to write %1").arg(file->fileName());
+        // Reported once the caller is back in the event loop, like any other outcome
+        m_pendingReports++;
+        QMetaObject::invokeMethod(this, [this, id, error]() {
+            m_pendingReports--;
+            emit jobFinished(id, false, error);
+            startJobs();
+            checkIdle();
+        }, Qt::QueuedConnection);
+        return;
+    }
+    
+    // The job's own timer handles stalls
+    QNetworkRequest request = HttpClient::request(job.url, 0);
+    NetworkTrace::tag(request, "Patcher");
+    if (offset > 0) {
+        spdlog::info("Resuming {} at {} bytes", job.localPath.string(), offset);
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(offset) + "-");
+        request.setRawHeader("If-Range", validator.toUtf8());
+    }
+    QNetworkReply* reply = m_manager->get(request);
+    const BandwidthLimiter& limiter = BandwidthLimiter::shared();
+    reply->setReadBufferSize(limiter.isLimited()
+        ? std::clamp(limiter.limit(), MIN_READ_BUFFER_SIZE, READ_BUFFER_SIZE)
+        : READ_BUFFER_SIZE);
+    
+    Active active;
+    active.file = std::move(file);
+    if (!job.md5.isEmpty()) {
+        // The prefix already on disk is the first thing hashed
+        auto hash = std::make_shared<QCryptographicHash>(QCryptographicHash::Md5);
+        VerifyPool* pool = m_verifyPool;
+        active.hashing = QtConcurrent::run(hashThreads(), [hash, partName, offset, pool]() {
+            QFile prefix(partName);
+            if (offset == 0 || !prefix.open(QIODevice::ReadOnly)) {
+                return;
+            }
+            for (qint64 left = offset; left > 0;) {
+                const QByteArray chunk = prefix.read(std::min(left, READ_BUFFER_SIZE));
+                if (chunk.isEmpty()) {
+                    break;
+                }
+                hash->addData(chunk);
+                left -= chunk.size();
+            }
+            if (pool) {
+                pool->addVerified(offset);
+            }
+        });
+        active.hash = std::move(hash);
+    }
+    active.offset = offset;
+    active.received = offset;
+    active.host = job.url.host();
+    active.job = std::move(job);
+    active.clock.start();
+    active.timer = new QTimer(this);
+    active.timer->setSingleShot(true);
+    active.timer->start(m_timeout);
+    connect(active.timer, &QTimer::timeout, this, [this, reply]() { timedOut(reply); });
+    
+    connect(reply, &QNetworkReply::downloadProgress, this, [this, reply](qint64 received, qint64) {
+        auto it = m_active.find(reply);
+        if (it == m_active.end()) {
+            return;
+        }
+        it->received = it->offset + received;
+        it->timer->start(m_timeout);        // Timeout counts from the last data
+        emit progress(bytesReceived());
+    });
+    connect(reply, &QNetworkReply::readyRead, this, [this, reply]() { receive(reply); });
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { finish(reply); });
+    
+    m_perHost[active.host]++;
+    m_active.insert(reply, std::move(active));
+}
+
+bool DownloadScheduler::accept(QNetworkReply* reply, Active& active) {
+    active.accepted = true;
+    active.firstByteMs = active.clock.elapsed();
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    
+    if (active.offset > 0 && status == 206) {
+        // "bytes <first>-<last>/<total>" must pick up where the part file ends
+        const QByteArray range = reply->rawHeader("Content-Range");
+        const qsizetype dash = range.indexOf('-');
+        const qint64 first = dash > 6 ? range.mid(6, dash - 6).trimmed().toLongLong() : -1;
+        if (!range.startsWith("bytes ") || first != active.offset) {
+            spdlog::warn("Unexpected Content-Range \"{}\" resuming {}", range.toStdString(),
+                         active.job.localPath.string());
+            return false;
+        }
+    } else if (active.offset > 0) {
+        // Range ignored or the file changed: this response is the whole file
+        spdlog::info("Server sent all of {}, starting over", active.job.localPath.string());
+        active.file->truncate();
+        active.offset = 0;
+        active.received = 0;
+        if (active.hash) {
+            auto hash = active.hash;
+            active.hashing = active.hashing.then(hashThreads(), [hash]() { hash->reset(); });
+        }
+    }
+    
+    // Only strong validators may be used with If-Range
+    QString validator = QString::fromUtf8(reply->rawHeader("ETag"));
+    if (validator.startsWith("W/")) {
+        validator.clear();
+    }
+    if (validator.isEmpty()) {
+        validator = QString::fromUtf8(reply->rawHeader("Last-Modified"));
+    }
+    writeValidator(active.job, validator);
+    return true;
+}
+
+void DownloadScheduler::throttleTick() {
+    const auto replies = m_active.keys();
+    bool waiting = false;
+    const int count = static_cast<int>(replies.size());
+    m_throttleRound = count > 0 ? (m_throttleRound + 1) % count : 0;
+    for (int i = 0; i < count; ++i) {
+        QNetworkReply* reply = replies[(m_throttleRound + i) % count];
+        auto it = m_active.constFind(reply);
+        if (it == m_active.constEnd() || reply->bytesAvailable() == 0) {
+            continue;
+        }
+        const bool finishing = it->finishing;
+        receive(reply);
+        if (!m_active.contains(reply)) {
+            continue;
+        }
+        if (reply->bytesAvailable() > 0) {
+            waiting = true;
+        } else if (finishing) {
+            finish(reply);
+        }
+    }
+    if (!waiting) {
+        m_throttle->stop();
+    }
+}
+
+void DownloadScheduler::timedOut(QNetworkReply* reply) {
+    auto it = m_active.constFind(reply);
+    if (it == m_active.constEnd()) {
+        return;
+    }
+    spdlog::error("Download timeout: {}", it->job.url.toString().toStdString());
+    disconnect(reply, nullptr, this, nullptr);
+    reply->abort();
+    complete(reply, false, "Timed out", true);
+}
+
+void DownloadScheduler::receive(QNetworkReply* reply) {
+    auto it = m_active.find(reply);
+    if (it == m_active.end()) {
+        return;
+    }
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() >= 400) {
+        reply->readAll();               // Error page, not file data
+        return;
+    }
+    if (!it->accepted && !accept(reply, *it)) {
+        disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        restart(reply);
+        return;
+    }
+    
+    const qint64 wanted = reply->bytesAvailable();
+    const qint64 granted = BandwidthLimiter::shared().acquire(wanted);
+    if (granted < wanted && !m_throttle->isActive()) {
+        m_throttle->start();
+    }
+    if (granted <= 0) {
+        return;
+    }
+    const QByteArray chunk = reply->read(granted);
+    it->timer->start(m_timeout);
+    if (it->hash) {
+        // Chained, so chunks are hashed in order while the next ones arrive
+        auto hash = it->hash;
+        VerifyPool* pool = m_verifyPool;
+        it->hashing = it->hashing.then(hashThreads(), [hash, chunk, pool]() {
+            hash->addData(chunk);
+            if (pool) {
+                pool->addVerified(chunk.size());
+            }
+        });
+    }
+    if (!it->file->write(chunk)) {
+        spdlog::error("Failed to write {}: {}", it->file->fileName().toStdString(),
+                     it->file->errorString().toStdString());
+        const QString error = QString("Failed to write %1").arg(it->file->fileName());
+        disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        complete(reply, false, error);
+    }
+}
+
+void DownloadScheduler::finish(QNetworkReply* reply) {
+    auto it = m_active.constFind(reply);
+    if (it == m_active.constEnd()) {
+        return;
+    }
+    
+    if (reply->error() != QNetworkReply::NoError) {
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status == 416 && it->offset > 0) {
+            // The part file doesn't fit the file on the server any more
+            restart(reply);
+            return;
+        }
+        spdlog::error("Download error: {} - {}", it->job.url.toString().toStdString(),
+                     reply->errorString().toStdString());
+        complete(reply, false, reply->errorString(), true);
+        return;
+    }
+    
+    // Anything still buffered
+    receive(reply);
+    auto pending = m_active.find(reply);
+    if (pending == m_active.end()) {
+        return;
+    }
+    if (reply->bytesAvailable() > 0) {
+        pending->finishing = true;      // Completed by throttleTick()
+        return;
+    }
+    if (!pending->file->flush()) {
+        spdlog::error("Failed to write {}: {}", pending->file->fileName().toStdString(),
+                     pending->file->errorString().toStdString());
+        complete(reply, false, QString("Failed to write %1").arg(pending->file->fileName()));
+        return;
+    }
+    
+    // The connection is free for the next job while the hash catches up
+    Active active = release(reply);
+    if (!active.hash) {
+        finalize(std::move(active), {});
+        return;
+    }
+    // Counted now so progress doesn't dip while the hash catches up
+    m_finishedBytes += active.received;
+    active.received = 0;
+    m_verifying++;
+    const quint64 generation = m_generation;
+    QFuture<void> hashing = active.hashing;
+    hashing.then(this, [this, active = std::move(active), generation]() mutable {
+        m_verifying--;
+        if (generation != m_generation) {
+            checkIdle();                    // Cancelled meanwhile
+            return;
+        }
+        const QString actual = QString::fromLatin1(active.hash->result().toHex());
+        finalize(std::move(active), actual);
+    });
+    startJobs();
+}
+
+void DownloadScheduler::finalize(Active active, const QString& actualMd5) {
+    const DownloadJob& job = active.job;
+    if (active.hash && actualMd5.compare(job.md5, Qt::CaseInsensitive) != 0) {
+        spdlog::error("Hash mismatch for: {} (expected {}, got {})", job.localPath.string(),
+                     job.md5.toStdString(), actualMd5.toStdString());
+        report(std::move(active), false, "MD5 mismatch", false);
+        return;
+    }
+    
+    const QString target = QString::fromStdString(job.localPath.string());
+    QFile::remove(target);
+    if (!active.file->rename(target)) {
+        spdlog::error("Failed to move {} into place: {}", active.file->fileName().toStdString(),
+                     active.file->errorString().toStdString());
+        const QString error = QString("Failed to write %1").arg(target);
+        report(std::move(active), false, error, false);
+        return;
+    }
+    
+    spdlog::debug("Downloaded {} bytes to {}", QFileInfo(target).size(), job.localPath.string());
+    m_unsynced.append(target);
+    report(std::move(active), true, {}, false);
+}
+
+DownloadScheduler::Active DownloadScheduler::release(QNetworkReply* reply) {
+    Active active = m_active.take(reply);
+    if (--m_perHost[active.host] <= 0) {
+        m_perHost.remove(active.host);
+    }
+    active.timer->stop();
+    active.timer->deleteLater();        // May be the sender of timedOut()
+    active.file->close();
+    reply->deleteLater();
+    
+    TransferStats stats;
+    stats.host = active.host;
+    stats.bytes = active.received - active.offset;
+    stats.elapsedMs = active.clock.elapsed();
+    stats.firstByteMs = active.firstByteMs;
+    static metrics::Counter& bytes = metrics::counter("download.bytes");
+    static metrics::Histogram& transferTime = metrics::histogram("download.transfer_ms");
+    bytes.add(static_cast<uint64_t>(std::max<qint64>(0, stats.bytes)));
+    transferTime.record(static_cast<uint64_t>(stats.elapsedMs));
+    emit transferFinished(stats);
+    return active;
+}
+
+void DownloadScheduler::restart(QNetworkReply* reply) {
+    Active active = release(reply);
+    discardPart(active.job.localPath);
+    active.job.resume = false;
+    m_queue.push_front(std::move(active.job));
+    startJobs();
+}
+
+void DownloadScheduler::complete(QNetworkReply* reply, bool success, const QString& error, bool keepPart) {
+    report(release(reply), success, error, keepPart);
+}
+
+void DownloadScheduler::report(Active active, bool success, const QString& error, bool keepPart) {
+    m_finishedBytes += active.received;
+    static metrics::Counter& completed = metrics::counter("download.completed");
+    static metrics::Counter& failed = metrics::counter("download.failed");
+    (success ? completed : failed).add();
+    if (success) {
+        writeValidator(active.job, {});
+    } else if (!keepPart) {
+        discardPart(active.job.localPath);
+    }
+    
+    // The handler may queue more work or cancel everything
+    emit jobFinished(active.job.id, success, error);
+    startJobs();
+    checkIdle();
+}
+
+bool DownloadScheduler::syncFinished() {
+    const QStringList paths = std::exchange(m_unsynced, {});
+    if (paths.isEmpty()) {
+        return true;
+    }
+    QElapsedTimer clock;
+    clock.start();
+    const bool ok = DownloadWriter::sync(paths);
+    static metrics::Histogram& syncTime = metrics::histogram("download.sync_ms");
+    syncTime.record(static_cast<uint64_t>(clock.elapsed()));
+    spdlog::info("Synced {} downloaded files in {} ms", paths.size(), clock.elapsed());
+    return ok;
+}
+
+void DownloadScheduler::cancel() {
+    // Part files stay behind so the next attempt can resume them; jobs
+    // still being hashed are dropped when their hash completes
+    m_queue.clear();
+    m_generation++;
+    m_throttle->stop();
+    const auto replies = m_active.keys();
+    for (QNetworkReply* reply : replies) {
+        disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        release(reply);
+    }
+    m_perHost.clear();
+    checkIdle();
+}
+
+void DownloadScheduler::checkIdle() {
+    if (m_busy && isIdle()) {
+        m_busy = false;
+        emit idle();
+    }
+}
+
+} // namespace lotro
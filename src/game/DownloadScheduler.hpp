@@ -0,0 +1,231 @@
+/**
+ * LOTRO Launcher - Download Scheduler
+ * 
+ * Runs many HTTP downloads at once with bounded concurrency.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+
+#include <deque>
+#include <filesystem>
+#include <memory>
+
+class QCryptographicHash;
+class QNetworkAccessManager;
+class QNetworkReply;
+class QThreadPool;
+class QTimer;
+
+namespace lotro {
+
+class DownloadWriter;
+class VerifyPool;
+
+/**
+ * Queue order; jobs of equal priority keep the order they were queued in
+ */
+enum class DownloadPriority {
+    Critical,                           // Needed to launch at all
+    Normal,
+    Optional                            // Splash art and other extras
+};
+
+/**
+ * One file to fetch
+ */
+struct DownloadJob {
+    int id = 0;                         // Caller's handle, echoed in signals
+    QUrl url;
+    std::filesystem::path localPath;
+    qint64 expectedSize = 0;            // For progress and preallocation; 0 if unknown
+    QString md5;                        // Hex digest to verify, empty to skip
+    bool resume = true;                 // Continue a part file left by an earlier attempt
+    DownloadPriority priority = DownloadPriority::Normal;
+};
+
+/**
+ * How one transfer went, reported when its connection is released
+ */
+struct TransferStats {
+    QString host;
+    qint64 bytes = 0;                   // Received in this attempt, not counting a resumed prefix
+    qint64 elapsedMs = 0;               // Request sent to last byte
+    qint64 firstByteMs = -1;            // Request sent to first response data; -1 if none came
+};
+
+/**
+ * Queue of downloads run a few at a time
+ * 
+ * Jobs start by priority, then in the order they were queued, as long as
+ * fewer than maxConnections are running overall and fewer than maxPerHost are
+ * running against the job's host; a job whose host is saturated waits
+ * without holding back jobs for other hosts. A job that receives nothing
+ * for the timeout is aborted and fails.
+ * 
+ * Data is written to "<localPath>.part" as it arrives and hashed on the
+ * way, so memory use doesn't grow with the file and the file is never
+ * read back; on success the part file is renamed over localPath. Jobs
+ * report through jobFinished(). The part file's space is reserved up
+ * front when the expected size is known, and writes go out in large
+ * blocks (see DownloadWriter). Finished files aren't synced one by one;
+ * the caller syncs them together with syncFinished() at the end.
+ * 
+ * Hashing runs on the verify pool (or the global pool), one chained task
+ * per chunk so each file's chunks are hashed in order while downloads
+ * continue. A finished download gives up its connection straight away and
+ * is reported once its hash has caught up.
+ * 
+ * A job that fails on the network, times out or is cancelled leaves its
+ * part file behind, with the response's ETag (or Last-Modified) in
+ * "<localPath>.part.meta". The next attempt asks for the rest with Range
+ * and If-Range, rehashing the prefix already on disk; if the server
+ * sends the whole file instead, the part file is started over.
+ * 
+ * Reads go through the shared BandwidthLimiter. When it holds a reply
+ * back, the data waits in the socket and is picked up on a short timer,
+ * round robin over the throttled replies.
+ * 
+ * Everything runs on the thread the scheduler lives on, driven by the
+ * network manager's signals; callers wait for idle().
+ */
+class DownloadScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DownloadScheduler(QNetworkAccessManager* manager, QObject* parent = nullptr);
+    ~DownloadScheduler() override;
+    
+    void setMaxConnections(int connections);
+    void setMaxPerHost(int connections);
+    void setTimeout(int milliseconds);
+    
+    /**
+     * Threads to hash on, counting the bytes hashed; nullptr for the global pool
+     */
+    void setVerifyPool(VerifyPool* pool);
+    
+    int maxConnections() const { return m_maxConnections; }
+    int maxPerHost() const { return m_maxPerHost; }
+    
+    void enqueue(DownloadJob job);
+    
+    /**
+     * Abort running jobs and drop queued ones, without reporting them
+     */
+    void cancel();
+    
+    bool isIdle() const {
+        return m_queue.empty() && m_active.isEmpty() && m_pendingReports == 0 && m_verifying == 0;
+    }
+    int activeCount() const { return static_cast<int>(m_active.size()); }
+    int queuedCount() const { return static_cast<int>(m_queue.size()); }
+    
+    /**
+     * Write the files finished since the last call through to the disk
+     * @return false if any of them couldn't be synced
+     */
+    bool syncFinished();
+    
+    /**
+     * Bytes received by finished and running jobs
+     */
+    qint64 bytesReceived() const;
+    
+    /**
+     * Bytes received by running jobs only
+     */
+    qint64 activeBytes() const;
+    
+    static constexpr int DEFAULT_MAX_CONNECTIONS = 8;
+    static constexpr int DEFAULT_MAX_PER_HOST = 6;    // QNetworkAccessManager's own HTTP/1.1 limit
+    static constexpr int DEFAULT_TIMEOUT_MS = 60000;
+    static constexpr qint64 READ_BUFFER_SIZE = 1024 * 1024;
+    static constexpr qint64 MIN_READ_BUFFER_SIZE = 64 * 1024;
+    static constexpr int THROTTLE_TICK_MS = 50;
+    
+    /**
+     * Where a job's data goes until it is complete
+     */
+    static std::filesystem::path partPath(const std::filesystem::path& localPath);
+    
+    /**
+     * Remove a job's part file and its resume state
+     */
+    static void discardPart(const std::filesystem::path& localPath);
+
+signals:
+    void jobFinished(int id, bool success, const QString& error);
+    
+    // Bytes received so far, over all jobs
+    void progress(qint64 bytesReceived);
+    
+    // A connection finished with a job, whatever the outcome
+    void transferFinished(const TransferStats& stats);
+    
+    // Queue drained and nothing running
+    void idle();
+
+private:
+    struct Active {
+        DownloadJob job;
+        QString host;
+        QTimer* timer = nullptr;
+        qint64 received = 0;            // Including the resumed prefix
+        qint64 offset = 0;              // Size of the resumed prefix
+        bool accepted = false;          // Response headers checked
+        QElapsedTimer clock;            // Since the request was sent
+        qint64 firstByteMs = -1;
+        bool finishing = false;         // Reply done, data still held back by the limiter
+        std::shared_ptr<DownloadWriter> file;
+        std::shared_ptr<QCryptographicHash> hash;
+        QFuture<void> hashing;          // Last hashing task queued for this job
+    };
+    
+    void startJobs();
+    void start(DownloadJob job);
+    bool accept(QNetworkReply* reply, Active& active);
+    void receive(QNetworkReply* reply);
+    void finish(QNetworkReply* reply);
+    void timedOut(QNetworkReply* reply);
+    void throttleTick();
+    Active release(QNetworkReply* reply);
+    void restart(QNetworkReply* reply);
+    void complete(QNetworkReply* reply, bool success, const QString& error, bool keepPart = false);
+    void finalize(Active active, const QString& actualMd5);
+    void report(Active active, bool success, const QString& error, bool keepPart);
+    QThreadPool* hashThreads() const;
+    
+    static std::filesystem::path metaPath(const std::filesystem::path& localPath);
+    static QString readValidator(const DownloadJob& job);
+    static void writeValidator(const DownloadJob& job, const QString& validator);
+    void checkIdle();
+    
+    QNetworkAccessManager* m_manager;
+    std::deque<DownloadJob> m_queue;
+    QHash<QNetworkReply*, Active> m_active;
+    QHash<QString, int> m_perHost;
+    QTimer* m_throttle;
+    int m_throttleRound = 0;
+    qint64 m_finishedBytes = 0;
+    int m_maxConnections = DEFAULT_MAX_CONNECTIONS;
+    int m_maxPerHost = DEFAULT_MAX_PER_HOST;
+    int m_timeout = DEFAULT_TIMEOUT_MS;
+    VerifyPool* m_verifyPool = nullptr;
+    int m_pendingReports = 0;           // Failures to start, reported from the event loop
+    int m_verifying = 0;                // Downloaded, waiting for their hash
+    QStringList m_unsynced;             // Finished files not yet synced
+    quint64 m_generation = 0;           // Bumped by cancel()
+    bool m_busy = false;                // Work since the last idle()
+};
+
+} // namespace lotro
@@ -0,0 +1,196 @@
+/**
+ * LOTRO Launcher - File Hash Cache Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "FileHashCache.hpp"
+#include "VerifyPool.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro {
+
+FileHashCache::FileHashCache(const std::filesystem::path& gameDirectory)
+    : m_gameDirectory(gameDirectory)
+{
+    QString dir = QString::fromStdString(gameDirectory.string());
+    m_path = QDir(QString::fromStdString(Platform::getCachePath().string())).filePath(
+        QString("file-hashes-%1.cache").arg(qHash(QDir(dir).absolutePath()), 8, 16, QChar('0')));
+}
+
+QString FileHashCache::hashFile(const QString& path, VerifyPool* pool) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    if (!hash.addData(&file)) {
+        return {};
+    }
+    if (pool) {
+        pool->addVerified(file.size());
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString FileHashCache::filePath(const QString& relativePath) const {
+    return QString::fromStdString(m_gameDirectory.string()) + "/" + relativePath;
+}
+
+bool FileHashCache::lookup(FileState& state) const {
+    QFileInfo info(filePath(state.relativePath));
+    state.exists = info.isFile();
+    if (!state.exists) {
+        return true;
+    }
+    state.size = info.size();
+    state.mtime = info.lastModified().toMSecsSinceEpoch();
+    if (state.expectedSize >= 0 && state.size != state.expectedSize) {
+        return true;
+    }
+    
+    auto cached = m_entries.constFind(state.relativePath);
+    if (cached != m_entries.constEnd() && cached->size == state.size && cached->mtime == state.mtime) {
+        state.md5 = QString::fromLatin1(cached->md5.toHex());
+        return true;
+    }
+    return false;
+}
+
+void FileHashCache::scan(std::vector<FileState>& files, VerifyPool& pool,
+                         const std::function<void(int, int)>& progress) {
+    // Workers only read the cache; rehashed files are stored afterwards
+    std::vector<char> rehashed(files.size(), 0);
+    auto check = [&](FileState& state) {
+        if (lookup(state)) {
+            return;
+        }
+        state.md5 = hashFile(filePath(state.relativePath), &pool);
+        rehashed[static_cast<size_t>(&state - files.data())] = !state.md5.isEmpty();
+    };
+    
+    QFutureWatcher<void> watcher;
+    QEventLoop loop;
+    QObject::connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
+    if (progress) {
+        QObject::connect(&watcher, &QFutureWatcher<void>::progressValueChanged, &loop,
+                         [&progress, &files](int done) { progress(done, static_cast<int>(files.size())); });
+    }
+    watcher.setFuture(QtConcurrent::map(pool.pool(), files, check));
+    if (!watcher.isFinished()) {
+        loop.exec();
+    }
+    
+    int count = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (rehashed[i]) {
+            store(files[i]);
+            ++count;
+        }
+    }
+    spdlog::info("Checked {} game files, {} rehashed", files.size(), count);
+}
+
+void FileHashCache::store(const QString& relativePath, const QString& md5) {
+    QFileInfo info(filePath(relativePath));
+    if (!info.isFile()) {
+        return;
+    }
+    m_entries.insert(relativePath, {info.size(), info.lastModified().toMSecsSinceEpoch(),
+                                    QByteArray::fromHex(md5.toLatin1())});
+    m_dirty = true;
+}
+
+void FileHashCache::store(const FileState& state) {
+    if (!state.exists || state.md5.isEmpty()) {
+        return;
+    }
+    m_entries.insert(state.relativePath, {state.size, state.mtime, QByteArray::fromHex(state.md5.toLatin1())});
+    m_dirty = true;
+}
+
+void FileHashCache::forget(const QString& relativePath) {
+    if (m_entries.remove(relativePath)) {
+        m_dirty = true;
+    }
+}
+
+bool FileHashCache::save() {
+    if (!m_dirty) {
+        return true;
+    }
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write file hash cache {}: {}", m_path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << static_cast<quint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        out << it.key() << it->size << it->mtime << it->md5;
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit file hash cache {}", m_path.toStdString());
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool FileHashCache::load() {
+    m_entries.clear();
+    m_dirty = false;
+    
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version >> count;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("File hash cache {} is outdated, rebuilding", m_path.toStdString());
+        return false;
+    }
+    // The count is untrusted; an entry takes at least 24 bytes (two
+    // lengths and two qint64s), so the file's size bounds the reservation
+    constexpr qint64 MIN_ENTRY_BYTES = 24;
+    m_entries.reserve(static_cast<qsizetype>(std::min<qint64>(count, file.size() / MIN_ENTRY_BYTES)));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry entry;
+        in >> path >> entry.size >> entry.mtime >> entry.md5;
+        m_entries.insert(path, entry);
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("File hash cache {} is corrupt, rebuilding", m_path.toStdString());
+        m_entries.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace lotro
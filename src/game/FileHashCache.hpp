@@ -0,0 +1,103 @@
+/**
+ * LOTRO Launcher - File Hash Cache
+ * 
+ * Remembered MD5s of game files, keyed by size and modification time.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+namespace lotro {
+
+class VerifyPool;
+
+/**
+ * What a file on disk looks like
+ */
+struct FileState {
+    QString relativePath;
+    qint64 expectedSize = -1;       // Hash only if the size matches; -1 to always hash
+    bool exists = false;
+    qint64 size = 0;
+    qint64 mtime = 0;               // Milliseconds since epoch
+    QString md5;                    // Lowercase hex, empty if not hashed
+};
+
+/**
+ * MD5s of the files under a game directory, as of their last check
+ * 
+ * An entry stays valid while the file's size and modification time are
+ * unchanged, so checking an untouched install against a manifest reads
+ * no file data at all. Files whose metadata changed are rehashed on a
+ * VerifyPool. The cache is one small file per game directory
+ * under the platform cache path.
+ */
+class FileHashCache {
+public:
+    explicit FileHashCache(const std::filesystem::path& gameDirectory);
+    
+    /**
+     * Stat a file and take its MD5 from the cache if it is still valid
+     * @return false if the file has to be hashed to know its MD5
+     */
+    bool lookup(FileState& state) const;
+    
+    /**
+     * Stat every file and fill in its MD5, hashing only what changed
+     * @param progress Called on the calling thread with (done, total)
+     */
+    void scan(std::vector<FileState>& files, VerifyPool& pool,
+              const std::function<void(int, int)>& progress = nullptr);
+    
+    /**
+     * Record a file whose MD5 is already known, e.g. a verified download
+     */
+    void store(const QString& relativePath, const QString& md5);
+    
+    /**
+     * Record a file hashed after lookup() missed
+     */
+    void store(const FileState& state);
+    
+    /**
+     * Drop a file's entry so the next lookup hashes it again, e.g. after
+     * it was left half written
+     */
+    void forget(const QString& relativePath);
+    
+    QString filePath(const QString& relativePath) const;
+    
+    bool load();
+    bool save();
+    
+    /**
+     * Streaming MD5 of a file, empty if it can't be read
+     */
+    static QString hashFile(const QString& path, VerifyPool* pool = nullptr);
+
+private:
+    struct Entry {
+        qint64 size = 0;
+        qint64 mtime = 0;           // Milliseconds since epoch
+        QByteArray md5;             // Raw digest
+    };
+    
+    static constexpr quint32 MAGIC = 0x4348464C;    // "LFHC"
+    static constexpr quint32 VERSION = 1;
+    
+    std::filesystem::path m_gameDirectory;
+    QString m_path;
+    QHash<QString, Entry> m_entries;
+    bool m_dirty = false;
+};
+
+} // namespace lotro
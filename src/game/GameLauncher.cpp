@@ -7,30 +7,38 @@
  */
 
 #include "GameLauncher.hpp"
+#include "DatPrewarmer.hpp"
 #include "LaunchArguments.hpp"
+#include "LaunchTimeline.hpp"
 #include "UserPreferences.hpp"
+#include "addons/InstalledAddonIndex.hpp"
+#include "addons/StartupScriptRunner.hpp"
 #include "core/config/ConfigManager.hpp"
+#include "core/TaskScheduler.hpp"
+#include "network/HttpClient.hpp"
 
 #ifdef PLATFORM_LINUX
+#include "wine/ShaderCache.hpp"
 #include "wine/WineManager.hpp"
 #include "wine/WineProcessBuilder.hpp"
 #include "core/config/WineConfig.hpp"
 #include "steam/SteamIntegration.hpp"
 #endif
 
+#include <QElapsedTimer>
 #include <QProcess>
-#include <QTimer>
 #include <QFile>
 #include <QTextStream>
-#include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QUrlQuery>
-#include <QEventLoop>
 #include <QRegularExpression>
+#include <QTimer>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 // LOTRO public login queue URL (from OneLauncher's test data)
 static const QString LOTRO_LOGIN_QUEUE_URL = "https://gls.lotro.com/GLS.AuthServer/LoginQueue.aspx";
 
@@ -51,14 +59,9 @@ QString shellQuote(const QString& s) {
  * @param accountNumber The subscription/account name
  * @param ticket The GLS session ticket
  * @param worldQueueUrl The world's queue URL (private IP)
- * @return true if queue join succeeded, false otherwise
+ * @return The pending reply, to be checked with checkWorldQueueReply()
  */
-bool joinWorldQueue(const QString& accountNumber, const QString& ticket, const QString& worldQueueUrl) {
-    if (worldQueueUrl.isEmpty()) {
-        spdlog::debug("No queue URL provided, skipping queue join");
-        return true; // Assume no queue needed
-    }
-    
+QNetworkReply* postWorldQueueJoin(const QString& accountNumber, const QString& ticket, const QString& worldQueueUrl) {
     spdlog::info("Joining world login queue...");
     
     // Build POST parameters - based on OneLauncher's login_queue_params_template:
@@ -78,9 +81,7 @@ bool joinWorldQueue(const QString& accountNumber, const QString& ticket, const Q
                        "&ticket_type=GLS"
                        "&queue_url=" + encodedQueueUrl;
     
-    QNetworkAccessManager manager;
-    QUrl url{LOTRO_LOGIN_QUEUE_URL};
-    QNetworkRequest request{url};
+    QNetworkRequest request = lotro::HttpClient::request(QUrl{LOTRO_LOGIN_QUEUE_URL}, 15000);
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
     
     spdlog::info("POSTing to: {}", LOTRO_LOGIN_QUEUE_URL.toStdString());
@@ -88,34 +89,24 @@ bool joinWorldQueue(const QString& accountNumber, const QString& ticket, const Q
     spdlog::info("Queue URL param: {}", worldQueueUrl.toStdString());
     spdlog::info("Full POST body (first 200 chars): {}", postBody.left(200).toStdString());
     
-    QEventLoop loop;
-    QNetworkReply* reply = manager.post(request, postBody.toUtf8());
-    
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    
-    // Timeout after 15 seconds
-    QTimer timer;
-    timer.setSingleShot(true);
-    QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-    timer.start(15000);
-    
-    loop.exec();
-    
-    if (!timer.isActive()) {
+    return lotro::HttpClient::manager()->post(request, postBody.toUtf8());
+}
+
+/**
+ * Whether the login queue accepted us
+ */
+bool checkWorldQueueReply(const lotro::HttpResponse& reply) {
+    if (reply.timedOut()) {
         spdlog::error("Queue join timed out");
-        reply->deleteLater();
         return false;
     }
-    timer.stop();
     
-    if (reply->error() != QNetworkReply::NoError) {
-        spdlog::error("Queue join failed: {}", reply->errorString().toStdString());
-        reply->deleteLater();
+    if (!reply.ok()) {
+        spdlog::error("Queue join failed: {}", reply.errorString.toStdString());
         return false;
     }
     
-    QString response = QString::fromUtf8(reply->readAll());
-    reply->deleteLater();
+    QString response = QString::fromUtf8(reply.body);
     
     spdlog::debug("Queue response: {}", response.toStdString());
     
@@ -156,6 +147,39 @@ bool joinWorldQueue(const QString& accountNumber, const QString& ticket, const Q
     spdlog::warn("Could not parse queue response - treating as failure");
     return false;
 }
+
+#ifdef PLATFORM_LINUX
+bool setupWine(QString* error) {
+    auto& wineManager = lotro::WineManager::instance();
+    
+    // Always use builtin prefix mode (managed by umu-run)
+    lotro::WineConfig wineConfig = wineManager.config();
+    if (wineConfig.prefixMode != lotro::WinePrefixMode::User) {
+        wineConfig.prefixMode = lotro::WinePrefixMode::Builtin;
+        wineManager.setConfig(wineConfig);
+    }
+    
+    if (!wineManager.isSetup()) {
+        spdlog::info("Wine not set up, initializing...");
+        if (!wineManager.setup()) {
+            if (error) *error = "Failed to set up Wine environment";
+            return false;
+        }
+    }
+    return true;
+}
+
+void prepareShaderCache(const lotro::GameConfig& gameConfig) {
+    // DXVK wrote its state cache next to the game before the
+    // launcher managed it, and Steam keeps one of its own
+    std::vector<std::filesystem::path> shaderCacheSources = {gameConfig.gameDirectory};
+    if (gameConfig.gameDirectory.parent_path().filename() == "common") {
+        shaderCacheSources.push_back(gameConfig.gameDirectory.parent_path().parent_path() /
+                                     "shadercache" / "212500" / "DXVK_state_cache");
+    }
+    lotro::ShaderCache().prepare(shaderCacheSources);
+}
+#endif
 }
 
 namespace lotro {
@@ -165,7 +189,7 @@ public:
     explicit Impl(const GameConfig& gameConfig)
         : m_gameConfig(gameConfig)
         , m_process(new QProcess())
-        , m_runStartupScripts(true)
+        , m_runStartupScripts(ConfigManager::instance().programConfig().runStartupScripts)
         , m_updateUserPreferences(true)
     {
     }
@@ -184,42 +208,29 @@ public:
         const QString& loginServer,
         LaunchCallback callback
     ) {
+        if (m_launching) {
+            spdlog::warn("Launch already in progress");
+            LaunchResult result;
+            result.errorMessage = "A launch is already in progress";
+            if (callback) callback(result);
+            return;
+        }
         m_launching = true;
         
-        LaunchResult result;
+        auto state = std::make_shared<LaunchState>(world);
+        state->callback = std::move(callback);
         
         try {
             spdlog::info("Launching game for world: {}", world.name.toStdString());
             
-            // Update user preferences if enabled
-            if (m_updateUserPreferences) {
-                updateUserPreferences(world);
-            }
-            
             // Build launch arguments
-            auto clientPath = m_gameConfig.getClientExecutable();
-            if (!std::filesystem::exists(clientPath)) {
-                result.success = false;
-                result.errorMessage = "Game client not found: " + 
-                    QString::fromStdString(clientPath.string());
-                spdlog::error(result.errorMessage.toStdString());
-                m_launching = false;
-                if (callback) callback(result);
+            state->clientPath = m_gameConfig.getClientExecutable();
+            if (!std::filesystem::exists(state->clientPath)) {
+                fail(state, "Game client not found: " + 
+                    QString::fromStdString(state->clientPath.string()));
                 return;
             }
             
-            // Join the world login queue (REQUIRED - server rejects connections without this)
-            if (!world.queueUrl.isEmpty()) {
-                if (!joinWorldQueue(accountNumber, ticket, world.queueUrl)) {
-                    result.success = false;
-                    result.errorMessage = "Failed to join world login queue. Please try again.";
-                    spdlog::error(result.errorMessage.toStdString());
-                    m_launching = false;
-                    if (callback) callback(result);
-                    return;
-                }
-            }
-            
             LaunchArgumentBuilder argBuilder;
             // Map locale code to game language name expected by the LOTRO client
             // (e.g. "en" -> "English", "de" -> "DE", "fr" -> "FR")
@@ -246,140 +257,365 @@ public:
                       .setAuthServer("https://gls.lotro.com/gls.authserver/service.asmx")
                       .setGlsTicketLifetime("21600");
             
-            QStringList args = argBuilder.build();
+            state->args = argBuilder.build();
             
             spdlog::debug("Launch args: {}", argBuilder.buildString().toStdString());
-            
-#ifdef PLATFORM_LINUX
-            // Launch via Wine using launcher's own prefix
-            auto& wineManager = WineManager::instance();
-            
-            // Always use builtin prefix mode (managed by umu-run)
-            WineConfig wineConfig = wineManager.config();
-            if (wineConfig.prefixMode != WinePrefixMode::User) {
-                wineConfig.prefixMode = WinePrefixMode::Builtin;
-                wineManager.setConfig(wineConfig);
+        } catch (const std::exception& e) {
+            spdlog::error("Exception launching game: {}", e.what());
+            fail(state, QString::fromStdString(e.what()));
+            return;
+        }
+        
+        // The world queue join is a network round trip and everything else
+        // is local work, so they run side by side and the process starts
+        // once both are done
+        state->pending = 2;
+        joinQueue(state, accountNumber, ticket);
+        prepare(state);
+        
+        // Plugin startup scripts don't hold up the launch; they run while
+        // the queue is joined and the process (and Wine) starts
+        if (m_runStartupScripts) {
+            runStartupScripts();
+        }
+    }
+    
+    bool isLaunching() const { return m_launching; }
+    QProcess* process() const { return m_process.get(); }
+    
+    void setRunStartupScripts(bool enabled) { m_runStartupScripts = enabled; }
+    void setUpdateUserPreferences(bool enabled) { m_updateUserPreferences = enabled; }
+    void setEnvironmentPrepared(bool prepared) { m_environmentPrepared = prepared; }
+    
+private:
+    /**
+     * Everything one launch carries between its stages
+     */
+    struct LaunchState {
+        explicit LaunchState(const World& world) : world(world), timeline(world.name) {}
+        
+        World world;
+        LaunchTimeline timeline;
+        LaunchResult result;
+        LaunchCallback callback;
+        std::filesystem::path clientPath;
+        std::filesystem::path helperPath;
+        QStringList args;
+        int pending = 0;
+        bool done = false;
+        std::shared_ptr<LaunchTimeline::Span> startSpan;
+        std::vector<QMetaObject::Connection> connections;
+    };
+    
+    /**
+     * What the local preparation produced
+     */
+    struct PrepareResult {
+        QString errorMessage;
+        std::filesystem::path helperPath;
+        qint64 prewarmedBytes = 0;
+    };
+    
+    // Join the world login queue (REQUIRED - server rejects connections without this)
+    void joinQueue(const std::shared_ptr<LaunchState>& state, const QString& accountNumber,
+                   const QString& ticket) {
+        if (state->world.queueUrl.isEmpty()) {
+            spdlog::debug("No queue URL provided, skipping queue join");
+            stageDone(state);
+            return;
+        }
+        
+        auto span = std::make_shared<LaunchTimeline::Span>(state->timeline, "World queue join");
+        QNetworkReply* reply = postWorldQueueJoin(accountNumber, ticket, state->world.queueUrl);
+        QObject::connect(reply, &QNetworkReply::finished, &m_context, [this, state, reply, span]() {
+            span->end();
+            const HttpResponse response = HttpClient::collect(reply);
+            reply->deleteLater();
+            if (!checkWorldQueueReply(response) && state->result.errorMessage.isEmpty()) {
+                state->result.errorMessage = "Failed to join world login queue. Please try again.";
+                spdlog::error(state->result.errorMessage.toStdString());
             }
-            
-            if (!wineManager.isSetup()) {
-                spdlog::info("Wine not set up, initializing...");
-                if (!wineManager.setup()) {
-                    result.success = false;
-                    result.errorMessage = "Failed to set up Wine environment";
-                    m_launching = false;
-                    if (callback) callback(result);
-                    return;
+            stageDone(state);
+        });
+    }
+    
+    // Files, prefix and caches, on a worker so the UI stays responsive
+    void prepare(const std::shared_ptr<LaunchState>& state) {
+        QFuture<PrepareResult> future = TaskScheduler::instance().run(TaskPool::Io,
+            [state, gameConfig = m_gameConfig, updatePreferences = m_updateUserPreferences,
+             environmentPrepared = m_environmentPrepared]() {
+                PrepareResult prepared;
+                try {
+                    prepareLocally(*state, gameConfig, updatePreferences, environmentPrepared, prepared);
+                } catch (const std::exception& e) {
+                    spdlog::error("Exception preparing launch: {}", e.what());
+                    prepared.errorMessage = QString::fromStdString(e.what());
                 }
+                return prepared;
+            }, TaskPriority::High);
+        future.then(&m_context, [this, state](const PrepareResult& prepared) {
+            if (!prepared.errorMessage.isEmpty() && state->result.errorMessage.isEmpty()) {
+                state->result.errorMessage = prepared.errorMessage;
             }
-            
-            // Create helper batch file to ensure correct working directory
-            // This is the standard way to set working directory in Wine - QProcess.setWorkingDirectory
-            // only affects the Linux side, not the Wine internal working directory.
-            // The batch file runs INSIDE Wine and uses cd /d to set the correct path.
-            std::filesystem::path batPath = m_gameConfig.gameDirectory / "lotro-launcher-helper.bat";
-            
-            {
-                QFile batFile(QString::fromStdString(batPath.string()));
-                if (batFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-                    QTextStream out(&batFile);
-                    // Use CRLF for Windows compatibility
-                    out << "@echo off\r\n";
-                    out << "cd /d \"%~dp0\"\r\n";
-                    
-                    std::filesystem::path clientRel = std::filesystem::relative(clientPath, m_gameConfig.gameDirectory);
-                    QString clientRelWin = QString::fromStdString(clientRel.string()).replace("/", "\\");
-                    
-                    // Run the game executable with all arguments passed to batch file
-                    // Use "start /b" to run without showing a console window
-                    out << "start /b \"\" \"" << clientRelWin << "\" %*\r\n";
-                    batFile.close();
-                    
-                    // Ensure it's executable
-                    batFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner | 
-                                         QFile::ReadGroup | QFile::ExeGroup);
-                } else {
-                     spdlog::error("Failed to write batch helper: {}", batPath.string());
-                }
+            state->helperPath = prepared.helperPath;
+            state->result.prewarmedBytes = prepared.prewarmedBytes;
+            stageDone(state);
+        });
+    }
+    
+    static void prepareLocally(LaunchState& state, const GameConfig& gameConfig, bool updatePreferences,
+                               bool environmentPrepared, PrepareResult& prepared) {
+        // Update user preferences if enabled
+        if (updatePreferences) {
+            auto span = state.timeline.span("UserPreferences update");
+            updateUserPreferences(gameConfig, state.world);
+        }
+        
+#ifdef PLATFORM_LINUX
+        if (!environmentPrepared) {
+            auto span = state.timeline.span("Wine setup");
+            if (!setupWine(&prepared.errorMessage)) {
+                return;
             }
-
-            // Launch the batch file via umu-run
-            QStringList wineArgs = wineManager.buildWineArgs(batPath, args);
-            QProcessEnvironment env = wineManager.getWineEnvironment();
-            
-            // Set Steam App ID for Proton compatibility (LOTRO = 212500)
-            env.insert("SteamAppId", "212500");
-            env.insert("SteamGameId", "212500");
-            
-            m_process->setProcessEnvironment(env);
-            
-            QString wineExe = wineArgs.takeFirst();
-            
-            // Log launch details for debugging
-            spdlog::info("Wine executable: {}", wineExe.toStdString());
-            spdlog::info("Game client: {}", clientPath.string());
-            spdlog::info("Launch helper: {}", batPath.string());
-            spdlog::info("WINEPREFIX: {}", env.value("WINEPREFIX", "not set").toStdString());
-            
-            m_process->start(wineExe, wineArgs);
-            
-#else
-            // Windows native launch
-            m_process->setWorkingDirectory(
-                QString::fromStdString(m_gameConfig.gameDirectory.string()));
-            m_process->start(QString::fromStdString(clientPath.string()), args);
-#endif
-            
-            if (!m_process->waitForStarted(10000)) {
-                result.success = false;
-                result.errorMessage = "Failed to start game process: " + 
-                    m_process->errorString();
-                spdlog::error(result.errorMessage.toStdString());
-            } else {
-                result.success = true;
-                result.processId = m_process->processId();
-                spdlog::info("Game process started with PID: {}", result.processId);
+        }
+        
+        // Create helper batch file to ensure correct working directory
+        // This is the standard way to set working directory in Wine - QProcess.setWorkingDirectory
+        // only affects the Linux side, not the Wine internal working directory.
+        // The batch file runs INSIDE Wine and uses cd /d to set the correct path.
+        prepared.helperPath = gameConfig.gameDirectory / "lotro-launcher-helper.bat";
+        
+        {
+            auto span = state.timeline.span("Launch helper");
+            QFile batFile(QString::fromStdString(prepared.helperPath.string()));
+            if (batFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                QTextStream out(&batFile);
+                // Use CRLF for Windows compatibility
+                out << "@echo off\r\n";
+                out << "cd /d \"%~dp0\"\r\n";
                 
-#ifdef PLATFORM_LINUX
-                // Initialize Steam integration to show "Playing" status
-                auto& steam = SteamIntegration::instance();
-                if (steam.initialize()) {
-                    spdlog::info("Steam integration active - game shown as playing");
-                    
-                    // Connect process finished signal to shutdown Steam
-                    QObject::connect(m_process.get(), 
-                        QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-                        [](int exitCode, QProcess::ExitStatus) {
-                            spdlog::info("Game exited with code: {}", exitCode);
-                            SteamIntegration::instance().shutdown();
-                        });
-                }
-#endif
+                std::filesystem::path clientRel = std::filesystem::relative(state.clientPath, gameConfig.gameDirectory);
+                QString clientRelWin = QString::fromStdString(clientRel.string()).replace("/", "\\");
+                
+                // Run the game executable with all arguments passed to batch file
+                // Use "start /b" to run without showing a console window
+                out << "start /b \"\" \"" << clientRelWin << "\" %*\r\n";
+                batFile.close();
+                
+                // Ensure it's executable
+                batFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner | 
+                                     QFile::ReadGroup | QFile::ExeGroup);
+            } else {
+                 spdlog::error("Failed to write batch helper: {}", prepared.helperPath.string());
             }
-            
+        }
+        
+        if (!environmentPrepared) {
+            auto span = state.timeline.span("Shader cache");
+            prepareShaderCache(gameConfig);
+        }
+#else
+        (void)environmentPrepared;
+#endif
+        
+        const ProgramConfig programConfig = ConfigManager::instance().programConfig();
+        if (programConfig.prewarmDatFiles) {
+            auto span = state.timeline.span("DAT prewarm");
+            DatPrewarmer prewarmer(gameConfig.gameDirectory);
+            const qint64 rate = programConfig.prewarmRateMBps > 0
+                ? static_cast<qint64>(programConfig.prewarmRateMBps) << 20
+                : prewarmer.defaultRate();
+            prepared.prewarmedBytes = prewarmer.warm(rate, DatPrewarmer::TIME_BUDGET_MS).warmedBytes;
+        }
+    }
+    
+    void stageDone(const std::shared_ptr<LaunchState>& state) {
+        if (--state->pending > 0) {
+            return;
+        }
+        if (!state->result.errorMessage.isEmpty()) {
+            fail(state, state->result.errorMessage);
+            return;
+        }
+        try {
+            startProcess(state);
         } catch (const std::exception& e) {
-            result.success = false;
-            result.errorMessage = QString::fromStdString(e.what());
             spdlog::error("Exception launching game: {}", e.what());
+            fail(state, QString::fromStdString(e.what()));
+        }
+    }
+    
+    /**
+     * Run the plugins' startup scripts, as recorded in the installed addon
+     * index when they were installed
+     */
+    void runStartupScripts() {
+        auto future = TaskScheduler::instance().run(TaskPool::Io,
+            [settingsDir = m_gameConfig.settingsDirectory]() {
+                InstalledAddonIndex index(settingsDir);
+                index.load();
+                return index.startupScripts();
+            }, TaskPriority::High);
+        future.then(&m_context, [this](const std::vector<StartupScript>& scripts) {
+            if (scripts.empty()) {
+                return;
+            }
+            if (!m_scriptRunner) {
+                m_scriptRunner = std::make_unique<StartupScriptRunner>();
+                QObject::connect(m_scriptRunner.get(), &StartupScriptRunner::finished, &m_context,
+                    [](const std::vector<StartupScriptResult>& results) {
+                        auto failed = std::count_if(results.begin(), results.end(),
+                            [](const StartupScriptResult& result) { return !result.ok(); });
+                        spdlog::info("Startup scripts done: {} ran, {} failed", results.size(), failed);
+                    });
+            }
+            m_scriptRunner->start(scripts);
+        });
+    }
+    
+    void startProcess(const std::shared_ptr<LaunchState>& state) {
+#ifdef PLATFORM_LINUX
+        auto& wineManager = WineManager::instance();
+        
+        // Resolve the profile before building anything, so the command
+        // line and environment always agree on it
+        auto profile = LaunchProfile::find(wineManager.config().launchProfile);
+        if (!profile) {
+            spdlog::warn("Unknown launch profile '{}', using {}",
+                         wineManager.config().launchProfile, LaunchProfile::DEFAULT_NAME);
+            profile = LaunchProfile::find(LaunchProfile::DEFAULT_NAME);
         }
+        spdlog::info("Launch profile: {}", profile->name);
         
-        m_launching = false;
+        // Launch the batch file via umu-run
+        WineLaunch launch = wineManager.buildLaunch(state->helperPath, state->args, *profile);
+        QStringList wineArgs = launch.commandLine;
+        QProcessEnvironment env = launch.environment;
+        
+        // Set Steam App ID for Proton compatibility (LOTRO = 212500)
+        env.insert("SteamAppId", "212500");
+        env.insert("SteamGameId", "212500");
+        
+        m_process->setProcessEnvironment(env);
+        
+        QString wineExe = wineArgs.takeFirst();
+        
+        // Log launch details for debugging
+        spdlog::info("Wine executable: {}", wineExe.toStdString());
+        spdlog::info("Game client: {}", state->clientPath.string());
+        spdlog::info("Launch helper: {}", state->helperPath.string());
+        spdlog::info("WINEPREFIX: {}", env.value("WINEPREFIX", "not set").toStdString());
         
-        if (callback) {
-            callback(result);
+        state->startSpan = std::make_shared<LaunchTimeline::Span>(state->timeline, "Process start");
+        watchStart(state);
+        m_process->start(wineExe, wineArgs);
+#else
+        // Windows native launch
+        state->startSpan = std::make_shared<LaunchTimeline::Span>(state->timeline, "Process start");
+        watchStart(state);
+        m_process->setWorkingDirectory(
+            QString::fromStdString(m_gameConfig.gameDirectory.string()));
+        m_process->start(QString::fromStdString(state->clientPath.string()), state->args);
+#endif
+    }
+    
+    /**
+     * Finish the launch on whichever comes first: the process starting,
+     * failing to, or START_TIMEOUT_MS passing
+     */
+    void watchStart(const std::shared_ptr<LaunchState>& state) {
+        state->connections.push_back(QObject::connect(m_process.get(), &QProcess::started, &m_context,
+            [this, state]() { onStarted(state); }));
+        state->connections.push_back(QObject::connect(m_process.get(), &QProcess::errorOccurred, &m_context,
+            [this, state](QProcess::ProcessError error) {
+                if (error == QProcess::FailedToStart) {
+                    fail(state, "Failed to start game process: " + m_process->errorString());
+                }
+            }));
+        QTimer::singleShot(START_TIMEOUT_MS, &m_context, [this, state]() {
+            if (!state->done) {
+                fail(state, "Failed to start game process: timed out");
+            }
+        });
+    }
+    
+    void onStarted(const std::shared_ptr<LaunchState>& state) {
+        if (state->done) {
+            return;
+        }
+        state->result.success = true;
+        state->result.processId = m_process->processId();
+        spdlog::info("Game process started with PID: {}", state->result.processId);
+        
+        // What the session left in the page cache is what the next
+        // launch prewarms
+        if (ConfigManager::instance().programConfig().prewarmDatFiles) {
+            QElapsedTimer session;
+            session.start();
+            QObject::connect(m_process.get(),
+                QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                [session, gameDirectory = m_gameConfig.gameDirectory]() {
+                    if (session.elapsed() >= DatPrewarmer::MIN_SESSION_MS) {
+                        TaskScheduler::instance().run(TaskPool::Io, [gameDirectory]() {
+                            DatPrewarmer(gameDirectory).recordSession();
+                        }, TaskPriority::Low);
+                    }
+                });
         }
+        
+#ifdef PLATFORM_LINUX
+        // Initialize Steam integration to show "Playing" status, off the
+        // GUI thread since it may have to probe for the library first
+        TaskScheduler::instance().run(TaskPool::Io, []() {
+            if (SteamIntegration::instance().initialize()) {
+                spdlog::info("Steam integration active - game shown as playing");
+            }
+        });
+        
+        // Shutting down is a no-op when initialization failed
+        QObject::connect(m_process.get(), 
+            QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            [](int exitCode, QProcess::ExitStatus) {
+                spdlog::info("Game exited with code: {}", exitCode);
+                SteamIntegration::instance().shutdown();
+            });
+#endif
+        
+        finish(state);
     }
     
-    bool isLaunching() const { return m_launching; }
-    QProcess* process() const { return m_process.get(); }
+    void fail(const std::shared_ptr<LaunchState>& state, const QString& message) {
+        state->result.success = false;
+        state->result.errorMessage = message;
+        spdlog::error(message.toStdString());
+        finish(state);
+    }
     
-    void setRunStartupScripts(bool enabled) { m_runStartupScripts = enabled; }
-    void setUpdateUserPreferences(bool enabled) { m_updateUserPreferences = enabled; }
+    void finish(const std::shared_ptr<LaunchState>& state) {
+        if (state->done) {
+            return;
+        }
+        state->done = true;
+        for (const auto& connection : state->connections) {
+            QObject::disconnect(connection);
+        }
+        if (state->startSpan) {
+            state->startSpan->end();
+        }
+        
+        LaunchResult& result = state->result;
+        state->timeline.finish(result.success);
+        result.durationMs = state->timeline.elapsedMs();
+        result.stages = state->timeline.spans();
+        result.timingBreakdown = state->timeline.breakdown();
+        m_launching = false;
+        if (state->callback) state->callback(result);
+    }
     
-private:
-    void updateUserPreferences(const World& world) {
+    static void updateUserPreferences(const GameConfig& gameConfig, const World& world) {
         auto prefsPath = findUserPreferences(
-            m_gameConfig.settingsDirectory,
-            m_gameConfig.clientType == ClientType::Win64
+            gameConfig.settingsDirectory,
+            gameConfig.clientType == ClientType::Win64
         );
         
         if (!prefsPath) {
@@ -402,11 +638,16 @@ private:
         }
     }
     
+    static constexpr int START_TIMEOUT_MS = 10000;
+    
     GameConfig m_gameConfig;
     std::unique_ptr<QProcess> m_process;
+    QObject m_context;                  // Receiver for this launcher's continuations
+    std::unique_ptr<StartupScriptRunner> m_scriptRunner;
     bool m_launching = false;
     bool m_runStartupScripts;
     bool m_updateUserPreferences;
+    bool m_environmentPrepared = false;
 };
 
 GameLauncher::GameLauncher(const GameConfig& gameConfig)
@@ -442,4 +683,21 @@ void GameLauncher::setUpdateUserPreferences(bool enabled) {
     m_impl->setUpdateUserPreferences(enabled);
 }
 
+void GameLauncher::setEnvironmentPrepared(bool prepared) {
+    m_impl->setEnvironmentPrepared(prepared);
+}
+
+bool GameLauncher::prepareEnvironment(const GameConfig& gameConfig, QString* error) {
+#ifdef PLATFORM_LINUX
+    if (!setupWine(error)) {
+        return false;
+    }
+    prepareShaderCache(gameConfig);
+#else
+    (void)gameConfig;
+    (void)error;
+#endif
+    return true;
+}
+
 } // namespace lotro
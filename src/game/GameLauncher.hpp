@@ -13,10 +13,12 @@
 #include <functional>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <QProcess>
 #include <QString>
 
+#include "LaunchTimeline.hpp"
 #include "core/config/GameConfig.hpp"
 #include "network/WorldList.hpp"
 
@@ -29,6 +31,10 @@ struct LaunchResult {
     bool success = false;
     QString errorMessage;
     qint64 processId = 0;  // PID of launched game
+    qint64 durationMs = 0;
+    qint64 prewarmedBytes = 0;  // DAT data read into the page cache first
+    std::vector<LaunchSpan> stages;
+    QString timingBreakdown;  // One stage per line
 };
 
 /**
@@ -44,6 +50,11 @@ using LaunchCallback = std::function<void(const LaunchResult&)>;
  * 2. Set up environment (Wine on Linux)
  * 3. Run startup scripts
  * 4. Launch the game client
+ * 
+ * Nothing blocks the calling thread: the world queue join runs on the
+ * network while preferences, prefix, helper and caches are prepared on a
+ * worker, and the client starts as soon as both are done, so a launch
+ * takes as long as the slower of the two plus the process start.
  */
 class GameLauncher {
 public:
@@ -54,7 +65,10 @@ public:
     ~GameLauncher();
     
     /**
-     * Launch the game
+     * Start launching the game
+     * 
+     * Returns at once; the callback runs on this thread when the client
+     * has started or the launch has failed.
      * 
      * @param world World to connect to
      * @param ticket Session ticket from login
@@ -90,6 +104,21 @@ public:
      */
     void setUpdateUserPreferences(bool enabled);
     
+    /**
+     * Skip the Wine prefix and shader cache steps, because the caller
+     * already ran prepareEnvironment() for this launch
+     */
+    void setEnvironmentPrepared(bool prepared);
+    
+    /**
+     * Set up the Wine prefix and shader caches a launch needs
+     * 
+     * Done by launch() itself unless setEnvironmentPrepared() is set;
+     * callers starting several clients run it once for all of them.
+     * Nothing to do on Windows.
+     */
+    static bool prepareEnvironment(const GameConfig& gameConfig, QString* error = nullptr);
+    
 private:
     class Impl;
     std::unique_ptr<Impl> m_impl;
@@ -0,0 +1,205 @@
+/**
+ * LOTRO Launcher - Launch Timeline Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "LaunchTimeline.hpp"
+#include "core/Metrics.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro {
+
+namespace {
+
+QList<QByteArray> readHistory(const QString& path) {
+    QList<QByteArray> lines;
+    QFile file(path);
+    if (file.open(QIODevice::ReadOnly)) {
+        for (const QByteArray& line : file.readAll().split('\n')) {
+            if (!line.trimmed().isEmpty()) {
+                lines.append(line);
+            }
+        }
+    }
+    return lines;
+}
+
+QString csvField(QString value) {
+    if (value.contains(',') || value.contains('"')) {
+        value.replace("\"", "\"\"");
+        return "\"" + value + "\"";
+    }
+    return value;
+}
+
+} // namespace
+
+LaunchTimeline::Span::Span(LaunchTimeline& timeline, const QString& name)
+    : m_timeline(timeline)
+{
+    QMutexLocker lock(&timeline.m_mutex);
+    m_index = timeline.m_spans.size();
+    timeline.m_spans.push_back({name, timeline.m_clock.elapsed(), -1});
+}
+
+void LaunchTimeline::Span::end() {
+    QMutexLocker lock(&m_timeline.m_mutex);
+    LaunchSpan& span = m_timeline.m_spans[m_index];
+    if (span.durationMs < 0) {
+        span.durationMs = m_timeline.m_clock.elapsed() - span.startMs;
+    }
+}
+
+LaunchTimeline::LaunchTimeline(const QString& world)
+    : m_world(world)
+    , m_started(QDateTime::currentDateTimeUtc())
+{
+    m_clock.start();
+}
+
+const LaunchSpan* LaunchTimeline::slowest() const {
+    auto it = std::max_element(m_spans.begin(), m_spans.end(), [](const auto& a, const auto& b) {
+        return a.durationMs < b.durationMs;
+    });
+    return it != m_spans.end() ? &*it : nullptr;
+}
+
+QString LaunchTimeline::breakdown() const {
+    QStringList lines;
+    for (const auto& span : m_spans) {
+        lines << QString("%1: %2 ms").arg(span.name).arg(span.durationMs);
+    }
+    lines << QString("Total: %1 ms").arg(m_clock.elapsed());
+    return lines.join("\n");
+}
+
+QJsonObject LaunchTimeline::summary(bool success) const {
+    QJsonArray spans;
+    for (const auto& span : m_spans) {
+        spans.append(QJsonObject{
+            {"name", span.name},
+            {"startMs", span.startMs},
+            {"durationMs", span.durationMs}
+        });
+    }
+    return QJsonObject{
+        {"started", m_started.toString(Qt::ISODate)},
+        {"world", m_world},
+        {"success", success},
+        {"durationMs", m_clock.elapsed()},
+        {"spans", spans}
+    };
+}
+
+QString LaunchTimeline::historyPath() {
+    return QDir(QString::fromStdString(Platform::getDataPath().string())).filePath("launch-history.jsonl");
+}
+
+void LaunchTimeline::finish(bool success) {
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    const qint64 now = m_clock.elapsed();
+    {
+        QMutexLocker lock(&m_mutex);
+        for (auto& span : m_spans) {
+            if (span.durationMs < 0) {
+                span.durationMs = now - span.startMs;
+            }
+        }
+    }
+
+    static metrics::Histogram& launchTime = metrics::histogram("launch.duration_ms");
+    static metrics::Counter& launched = metrics::counter("launch.succeeded");
+    static metrics::Counter& failed = metrics::counter("launch.failed");
+    launchTime.record(static_cast<uint64_t>(now));
+    (success ? launched : failed).add();
+    
+    const QJsonObject launch = summary(success);
+    spdlog::info("Launch {} in {} ms", success ? "succeeded" : "failed", now);
+    std::vector<const LaunchSpan*> bySlowest;
+    for (const auto& span : m_spans) {
+        bySlowest.push_back(&span);
+    }
+    std::sort(bySlowest.begin(), bySlowest.end(), [](const auto* a, const auto* b) {
+        return a->durationMs > b->durationMs;
+    });
+    for (const auto* span : bySlowest) {
+        spdlog::info("  {}: {} ms", span->name.toStdString(), span->durationMs);
+    }
+
+    // One JSON object per line, newest last
+    const QString path = historyPath();
+    QList<QByteArray> lines = readHistory(path);
+    lines.append(QJsonDocument(launch).toJson(QJsonDocument::Compact));
+    while (lines.size() > MAX_LAUNCHES) {
+        lines.removeFirst();
+    }
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write launch history {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return;
+    }
+    for (const QByteArray& line : lines) {
+        file.write(line);
+        file.write("\n");
+    }
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit launch history {}", path.toStdString());
+    }
+}
+
+bool LaunchTimeline::exportHistory(const QString& path) {
+    QByteArray output;
+    if (path.endsWith(".csv", Qt::CaseInsensitive)) {
+        output = "started,world,success,total_ms,stage,stage_start_ms,stage_ms\n";
+        for (const QByteArray& line : readHistory(historyPath())) {
+            const QJsonObject launch = QJsonDocument::fromJson(line).object();
+            const QString prefix = QString("%1,%2,%3,%4")
+                .arg(launch.value("started").toString(), csvField(launch.value("world").toString()),
+                     launch.value("success").toBool() ? "true" : "false")
+                .arg(launch.value("durationMs").toInteger());
+            for (const auto& value : launch.value("spans").toArray()) {
+                const QJsonObject span = value.toObject();
+                output += QString("%1,%2,%3,%4\n")
+                    .arg(prefix, csvField(span.value("name").toString()))
+                    .arg(span.value("startMs").toInteger())
+                    .arg(span.value("durationMs").toInteger())
+                    .toUtf8();
+            }
+        }
+    } else {
+        QJsonArray launches;
+        for (const QByteArray& line : readHistory(historyPath())) {
+            launches.append(QJsonDocument::fromJson(line).object());
+        }
+        output = QJsonDocument(launches).toJson();
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to export launch history to {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    file.write(output);
+    return file.commit();
+}
+
+} // namespace lotro
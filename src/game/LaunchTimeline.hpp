@@ -0,0 +1,100 @@
+/**
+ * LOTRO Launcher - Launch Timeline
+ *
+ * Per-stage timing of a game launch, kept as a launch history.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+
+#include <vector>
+
+namespace lotro {
+
+/**
+ * One stage of a launch, relative to the start of the launch
+ */
+struct LaunchSpan {
+    QString name;
+    qint64 startMs = 0;
+    qint64 durationMs = -1;             // -1 while the stage is running
+};
+
+/**
+ * Times the stages of one launch
+ *
+ * Stages are opened with span(), which closes them again when the
+ * returned guard goes out of scope, so early returns are timed too.
+ * finish() closes whatever is still open, logs the stages slowest first
+ * and appends the launch to a small history file, like PatchTelemetry
+ * does for patch runs, so launches on one machine can be compared.
+ * Stages that run side by side may be timed from different threads.
+ */
+class LaunchTimeline {
+public:
+    class Span {
+    public:
+        Span(LaunchTimeline& timeline, const QString& name);
+        ~Span() { end(); }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        void end();
+
+    private:
+        LaunchTimeline& m_timeline;
+        size_t m_index = 0;
+    };
+
+    explicit LaunchTimeline(const QString& world);
+
+    [[nodiscard]] Span span(const QString& name) { return Span(*this, name); }
+
+    /**
+     * Close the timeline, log it and add it to the history
+     */
+    void finish(bool success);
+
+    qint64 elapsedMs() const { return m_clock.elapsed(); }
+    const std::vector<LaunchSpan>& spans() const { return m_spans; }
+
+    /**
+     * The longest stage, nullptr if there were none
+     */
+    const LaunchSpan* slowest() const;
+
+    /**
+     * Stages and their durations, one per line, for a tooltip
+     */
+    QString breakdown() const;
+
+    QJsonObject summary(bool success) const;
+
+    static QString historyPath();
+
+    /**
+     * Write the history as a JSON array, or as CSV with one row per stage
+     * if the path ends in .csv
+     */
+    static bool exportHistory(const QString& path);
+
+    static constexpr int MAX_LAUNCHES = 50;
+
+private:
+    QString m_world;
+    QDateTime m_started;
+    QElapsedTimer m_clock;
+    std::vector<LaunchSpan> m_spans;
+    QMutex m_mutex;
+    bool m_finished = false;
+};
+
+} // namespace lotro
@@ -0,0 +1,138 @@
+/**
+ * LOTRO Launcher - Manifest Database Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ManifestDatabase.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QNetworkReply>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+namespace lotro {
+
+ManifestDatabase::ManifestDatabase(const std::filesystem::path& gameDirectory) {
+    QString dir = QString::fromStdString(gameDirectory.string());
+    m_path = QDir(QString::fromStdString(Platform::getCachePath().string())).filePath(
+        QString("manifest-%1.db").arg(qHash(QDir(dir).absolutePath()), 8, 16, QChar('0')));
+}
+
+ManifestDatabase::Change ManifestDatabase::classify(const DownloadFile& file) const {
+    auto entry = m_entries.constFind(file.relativePath);
+    if (entry == m_entries.constEnd()) {
+        return Change::Added;
+    }
+    if (entry->size != file.size || entry->relativeUrl != file.relativeUrl
+        || entry->md5 != QByteArray::fromHex(file.md5Hash.toLatin1())) {
+        return Change::Changed;
+    }
+    return Change::Unchanged;
+}
+
+QStringList ManifestDatabase::removed(const QSet<QString>& seen) const {
+    QStringList gone;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        if (!seen.contains(it.key())) {
+            gone.append(it.key());
+        }
+    }
+    gone.sort();
+    return gone;
+}
+
+void ManifestDatabase::replace(const std::vector<DownloadFile>& files, const QString& validator,
+                               const QByteArray& digest) {
+    m_entries.clear();
+    m_entries.reserve(static_cast<qsizetype>(files.size()));
+    for (const auto& file : files) {
+        m_entries.insert(file.relativePath, {file.relativeUrl, file.size, QByteArray::fromHex(file.md5Hash.toLatin1())});
+    }
+    m_validator = validator;
+    m_digest = digest;
+    m_applied = true;
+}
+
+void ManifestDatabase::setPending() {
+    m_applied = false;
+}
+
+QString ManifestDatabase::validatorOf(const QNetworkReply* reply) {
+    QString validator = QString::fromUtf8(reply->rawHeader("ETag"));
+    if (validator.isEmpty()) {
+        validator = QString::fromUtf8(reply->rawHeader("Last-Modified"));
+    }
+    return validator;
+}
+
+bool ManifestDatabase::save() {
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write manifest database {}: {}", m_path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << m_applied << m_validator << m_digest
+        << static_cast<quint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        out << it.key() << it->relativeUrl << it->size << it->md5;
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit manifest database {}", m_path.toStdString());
+        return false;
+    }
+    return true;
+}
+
+bool ManifestDatabase::load() {
+    m_entries.clear();
+    m_validator.clear();
+    m_digest.clear();
+    m_applied = false;
+    
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("Manifest database {} is outdated, starting over", m_path.toStdString());
+        return false;
+    }
+    in >> m_applied >> m_validator >> m_digest >> count;
+    m_entries.reserve(count);
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry entry;
+        in >> path >> entry.relativeUrl >> entry.size >> entry.md5;
+        m_entries.insert(path, entry);
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Manifest database {} is corrupt, starting over", m_path.toStdString());
+        m_entries.clear();
+        m_validator.clear();
+        m_digest.clear();
+        m_applied = false;
+        return false;
+    }
+    return true;
+}
+
+} // namespace lotro
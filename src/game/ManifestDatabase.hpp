@@ -0,0 +1,98 @@
+/**
+ * LOTRO Launcher - Manifest Database
+ * 
+ * The game file manifest as of the last completed patch run.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "NativePatcher.hpp"
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <filesystem>
+#include <vector>
+
+class QNetworkReply;
+
+namespace lotro {
+
+/**
+ * Last applied manifest of a game directory, indexed by path
+ * 
+ * Each run diffs the new manifest against it file by file, so only
+ * added and changed entries are news; entries that are gone are listed
+ * once the new manifest is complete. The manifest's HTTP validator and
+ * digest are kept too, which answers "is there anything to patch?"
+ * with a HEAD request and without looking at the game directory.
+ * 
+ * The database is marked pending when a run starts and replaced when it
+ * succeeds, so an interrupted run never looks applied.
+ */
+class ManifestDatabase {
+public:
+    enum class Change {
+        Unchanged,
+        Added,
+        Changed
+    };
+    
+    explicit ManifestDatabase(const std::filesystem::path& gameDirectory);
+    
+    /**
+     * How a file of the new manifest differs from the applied one
+     */
+    Change classify(const DownloadFile& file) const;
+    
+    /**
+     * Applied files missing from a new manifest
+     */
+    QStringList removed(const QSet<QString>& seen) const;
+    
+    /**
+     * Make a new manifest the applied one
+     */
+    void replace(const std::vector<DownloadFile>& files, const QString& validator, const QByteArray& digest);
+    
+    /**
+     * Flag a run as started; the database is not applied until replace()
+     */
+    void setPending();
+    
+    bool isApplied() const { return m_applied; }
+    QString validator() const { return m_validator; }
+    QByteArray digest() const { return m_digest; }
+    int size() const { return static_cast<int>(m_entries.size()); }
+    
+    bool load();
+    bool save();
+    
+    /**
+     * ETag, or Last-Modified if there is none; empty if neither is sent
+     */
+    static QString validatorOf(const QNetworkReply* reply);
+
+private:
+    struct Entry {
+        QString relativeUrl;
+        qint64 size = 0;
+        QByteArray md5;             // Raw digest, empty if the manifest has none
+    };
+    
+    static constexpr quint32 MAGIC = 0x4E414D4C;    // "LMAN"
+    static constexpr quint32 VERSION = 1;
+    
+    QString m_path;
+    QHash<QString, Entry> m_entries;
+    QString m_validator;
+    QByteArray m_digest;            // MD5 of the manifest document
+    bool m_applied = false;
+};
+
+} // namespace lotro
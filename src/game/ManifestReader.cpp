@@ -0,0 +1,118 @@
+/**
+ * LOTRO Launcher - Manifest Reader Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ManifestReader.hpp"
+
+#include <utility>
+
+namespace lotro {
+
+ManifestReader::ManifestReader(Format format)
+    : m_format(format)
+{
+}
+
+void ManifestReader::addData(const QByteArray& data) {
+    if (data.isEmpty() || m_finished || hasError()) {
+        return;
+    }
+    m_xml.addData(data);
+    read();
+}
+
+std::vector<DownloadFile> ManifestReader::takeFiles() {
+    return std::exchange(m_files, {});
+}
+
+bool ManifestReader::hasError() const {
+    // Running out of data just means waiting for more
+    return m_xml.hasError() && m_xml.error() != QXmlStreamReader::PrematureEndOfDocumentError;
+}
+
+QString ManifestReader::errorString() const {
+    return hasError() ? m_xml.errorString() : QString();
+}
+
+void ManifestReader::read() {
+    while (!m_xml.atEnd()) {
+        const QXmlStreamReader::TokenType token = m_xml.readNext();
+        if (token == QXmlStreamReader::Invalid) {
+            return;                 // Incomplete input or a real error
+        }
+        
+        if (token == QXmlStreamReader::StartElement) {
+            if (m_depth > 0) {
+                if (++m_depth == 2) {
+                    m_field = m_xml.name().toString();
+                    m_text.clear();
+                }
+            } else if (m_xml.name() == QLatin1String("File")) {
+                m_depth = 1;
+                m_current = DownloadFile{};
+            }
+        } else if (token == QXmlStreamReader::Characters) {
+            if (m_depth >= 2) {
+                m_text += m_xml.text();
+            }
+        } else if (token == QXmlStreamReader::EndElement && m_depth > 0) {
+            if (m_depth == 2) {
+                assign(m_field, m_text);
+                m_field.clear();
+            } else if (m_depth == 1 && complete()) {
+                m_files.push_back(std::move(m_current));
+            }
+            --m_depth;
+        } else if (token == QXmlStreamReader::EndDocument) {
+            m_finished = true;
+        }
+    }
+}
+
+void ManifestReader::assign(const QString& field, const QString& text) {
+    if (m_format == Format::Patching) {
+        if (field == QLatin1String("From")) {
+            m_current.relativeUrl = QString(text).replace("\\", "/");
+        } else if (field == QLatin1String("To")) {
+            m_current.relativePath = QString(text).replace("\\", "/");
+        } else if (field == QLatin1String("Size")) {
+            m_current.size = text.toLongLong();
+        } else if (field == QLatin1String("MD5")) {
+            m_current.md5Hash = text;
+        } else if (field == QLatin1String("Iterations")) {
+            m_current.iterationsUrl = QString(text).replace("\\", "/");
+        }
+        return;
+    }
+    
+    if (field == QLatin1String("Description")) {
+        m_current.description = text;
+    } else if (field == QLatin1String("FileName")) {
+        m_current.relativePath = QString(text).replace("\\", "/");
+    } else if (field == QLatin1String("DownloadUrl")) {
+        m_current.downloadUrl = text;
+    }
+}
+
+bool ManifestReader::complete() const {
+    if (m_format == Format::Patching) {
+        return !m_current.relativeUrl.isEmpty() && !m_current.relativePath.isEmpty();
+    }
+    return !m_current.downloadUrl.isEmpty();
+}
+
+std::vector<DownloadFile> ManifestReader::parse(Format format, const QByteArray& xml, QString* error) {
+    ManifestReader reader(format);
+    reader.addData(xml);
+    if (!reader.atEnd() || reader.hasError()) {
+        if (error) {
+            *error = reader.hasError() ? reader.errorString() : QStringLiteral("Unexpected end of manifest");
+        }
+        return {};
+    }
+    return reader.takeFiles();
+}
+
+} // namespace lotro
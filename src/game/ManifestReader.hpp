@@ -0,0 +1,76 @@
+/**
+ * LOTRO Launcher - Manifest Reader
+ * 
+ * Incremental parser for the patch and splashscreen file manifests.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "NativePatcher.hpp"
+
+#include <QByteArray>
+#include <QString>
+#include <QXmlStreamReader>
+
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Turns manifest XML into DownloadFile records as it arrives
+ * 
+ * Data can be added in pieces of any size, e.g. straight from a network
+ * reply's readyRead(); every complete <File> element is available from
+ * takeFiles() as soon as its closing tag has been read. Nothing but the
+ * file being parsed is kept, so memory doesn't grow with the manifest.
+ */
+class ManifestReader {
+public:
+    enum class Format {
+        Patching,       // <From>, <To>, <Size>, <MD5>, optionally <Iterations>
+        Splashscreen    // <Description>, <FileName>, <DownloadUrl>
+    };
+    
+    explicit ManifestReader(Format format);
+    
+    /**
+     * Parse as far as the data received so far allows
+     */
+    void addData(const QByteArray& data);
+    
+    /**
+     * Files completed since the last call, in manifest order
+     */
+    std::vector<DownloadFile> takeFiles();
+    
+    /**
+     * The whole document has been read
+     */
+    bool atEnd() const { return m_finished; }
+    
+    bool hasError() const;
+    QString errorString() const;
+    
+    /**
+     * Parse a complete manifest in one go
+     */
+    static std::vector<DownloadFile> parse(Format format, const QByteArray& xml, QString* error = nullptr);
+
+private:
+    void read();
+    void assign(const QString& field, const QString& text);
+    bool complete() const;
+    
+    Format m_format;
+    QXmlStreamReader m_xml;
+    std::vector<DownloadFile> m_files;
+    DownloadFile m_current;
+    int m_depth = 0;                // Element depth inside the current <File>, 0 outside
+    QString m_field;                // Direct child of <File> being read
+    QString m_text;
+    bool m_finished = false;
+};
+
+} // namespace lotro
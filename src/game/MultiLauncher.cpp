@@ -0,0 +1,210 @@
+/**
+ * LOTRO Launcher - Multi-Client Launcher Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "MultiLauncher.hpp"
+#include "core/config/ConfigManager.hpp"
+#include "core/platform/Platform.hpp"
+
+#ifdef PLATFORM_LINUX
+#include "wine/WineManager.hpp"
+#endif
+
+#include <QFutureWatcher>
+#include <QProcess>
+#include <QTimer>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace lotro {
+
+MultiLauncher::MultiLauncher(const GameConfig& gameConfig, const QString& gameId,
+                             const QString& authServer, QObject* parent)
+    : QObject(parent)
+    , m_gameConfig(gameConfig)
+    , m_gameId(gameId)
+    , m_authServer(authServer)
+    , m_staggerMs(Platform::isRotationalStorage(gameConfig.gameDirectory).value_or(false)
+                      ? ROTATIONAL_STAGGER_MS : STAGGER_MS)
+{
+}
+
+MultiLauncher::~MultiLauncher() = default;
+
+void MultiLauncher::start(const std::vector<MultiLaunchAccount>& accounts, const World& world) {
+    if (m_launching) {
+        spdlog::warn("Multi-launch already in progress");
+        return;
+    }
+    
+    m_world = world;
+    m_clients.clear();
+    m_clients.resize(accounts.size());
+    m_pendingLogins = accounts.size();
+    m_nextLaunch = 0;
+    m_launching = true;
+    
+    if (accounts.empty()) {
+        finishLaunching();
+        return;
+    }
+    
+    spdlog::info("Multi-launching {} accounts on {}", accounts.size(), world.name.toStdString());
+    emit statusChanged(QString("Logging in %1 accounts...").arg(accounts.size()));
+    
+    // Logins run on the network threads while the environment is prepared here
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        m_clients[i].result.username = accounts[i].username;
+        auto* watcher = new QFutureWatcher<LoginResult>(this);
+        connect(watcher, &QFutureWatcher<LoginResult>::finished, this, [this, watcher, i]() {
+            onLoggedIn(i, watcher->result());
+            watcher->deleteLater();
+        });
+        watcher->setFuture(loginAccount(m_authServer, accounts[i].username, accounts[i].password));
+    }
+    
+    emit statusChanged("Preparing game environment...");
+    QString error;
+    m_environmentReady = GameLauncher::prepareEnvironment(m_gameConfig, &error);
+    if (!m_environmentReady) {
+        spdlog::error("Multi-launch environment setup failed: {}", error.toStdString());
+        for (auto& client : m_clients) {
+            client.result.errorMessage = error;
+        }
+    }
+
+#ifdef PLATFORM_LINUX
+    // Every client joins the same server instead of the first one starting it
+    if (m_environmentReady && ConfigManager::instance().programConfig().wineserverWarmStart) {
+        WineManager::instance().startWarmServer();
+    }
+#endif
+}
+
+void MultiLauncher::onLoggedIn(size_t index, const LoginResult& login) {
+    Client& client = m_clients[index];
+    if (!client.result.errorMessage.isEmpty()) {
+        // Environment setup already failed
+    } else if (!login.isSuccess()) {
+        client.result.errorMessage = login.errorMessage;
+        spdlog::warn("Login failed for {}: {}", client.result.username.toStdString(),
+                     login.errorMessage.toStdString());
+    } else {
+        auto subs = login.response->getGameSubscriptions(getDatacenterGameName(m_gameId));
+        if (subs.empty()) {
+            client.result.errorMessage = "No subscription for this game";
+        } else {
+            client.ticket = login.response->sessionTicket;
+            client.subscription = subs[0].name; // Use first subscription
+        }
+    }
+    
+    if (--m_pendingLogins == 0) {
+        launchNext();
+    }
+}
+
+size_t MultiLauncher::nextLaunchable(size_t from) const {
+    while (from < m_clients.size() && m_clients[from].ticket.isEmpty()) {
+        ++from;
+    }
+    return from;
+}
+
+bool MultiLauncher::hasLaunchable(size_t from) const {
+    return nextLaunchable(from) < m_clients.size();
+}
+
+void MultiLauncher::launchNext() {
+    size_t index = nextLaunchable(m_nextLaunch);
+    if (index >= m_clients.size()) {
+        finishLaunching();
+        return;
+    }
+    m_nextLaunch = index + 1;
+    
+    // The clients share one UserPreferences.ini, so only the first writes it
+    const bool first = std::none_of(m_clients.begin(), m_clients.end(),
+                                    [](const Client& c) { return c.launcher != nullptr; });
+    
+    Client& client = m_clients[index];
+    emit statusChanged(QString("Starting client for %1...").arg(client.result.username));
+    
+    // The session ticket isn't needed again
+    const QString ticket = std::exchange(client.ticket, QString());
+    
+    client.launcher = std::make_unique<GameLauncher>(m_gameConfig);
+    client.launcher->setEnvironmentPrepared(true);
+    client.launcher->setUpdateUserPreferences(first);
+    client.launcher->launch(m_world, ticket, client.subscription, m_world.loginServer,
+        [this, index](const LaunchResult& result) {
+            onClientLaunched(index, result);
+        });
+}
+
+void MultiLauncher::onClientLaunched(size_t index, const LaunchResult& launch) {
+    Client& client = m_clients[index];
+    client.result.success = launch.success;
+    client.result.errorMessage = launch.errorMessage;
+    client.result.processId = launch.processId;
+    
+    if (client.result.success) {
+        emit clientStarted(client.result.username, client.result.processId);
+        connect(client.launcher->process(),
+                QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [this]() {
+                    if (!m_launching && runningClients() == 0) {
+                        spdlog::info("All multi-launch clients have exited");
+                        emit allClientsExited();
+                    }
+                });
+    } else {
+        spdlog::warn("Client for {} failed to start: {}", client.result.username.toStdString(),
+                     client.result.errorMessage.toStdString());
+    }
+    
+    // The next client waits for this one to be up, and then some
+    if (hasLaunchable(m_nextLaunch)) {
+        QTimer::singleShot(m_staggerMs, this, &MultiLauncher::launchNext);
+    } else {
+        finishLaunching();
+    }
+}
+
+void MultiLauncher::finishLaunching() {
+    m_launching = false;
+    
+    std::vector<MultiLaunchResult> results;
+    int started = 0;
+    for (const auto& client : m_clients) {
+        results.push_back(client.result);
+        started += client.result.success ? 1 : 0;
+    }
+    spdlog::info("Multi-launch started {} of {} clients", started, results.size());
+    emit statusChanged(QString("Started %1 of %2 clients").arg(started).arg(results.size()));
+    emit finished(results);
+}
+
+int MultiLauncher::runningClients() const {
+    int running = 0;
+    for (const auto& client : m_clients) {
+        if (client.launcher && client.launcher->process()->state() != QProcess::NotRunning) {
+            ++running;
+        }
+    }
+    return running;
+}
+
+void MultiLauncher::terminateAll() {
+    for (const auto& client : m_clients) {
+        if (client.launcher && client.launcher->process()->state() != QProcess::NotRunning) {
+            client.launcher->process()->terminate();
+        }
+    }
+}
+
+} // namespace lotro
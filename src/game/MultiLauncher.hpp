@@ -0,0 +1,127 @@
+/**
+ * LOTRO Launcher - Multi-Client Launcher
+ * 
+ * Starts one game client per account on the same world.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "GameLauncher.hpp"
+#include "core/config/GameConfig.hpp"
+#include "network/LoginAccount.hpp"
+#include "network/WorldList.hpp"
+
+#include <QObject>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * An account to launch, with the password to log it in
+ */
+struct MultiLaunchAccount {
+    QString username;
+    QString password;
+};
+
+/**
+ * What became of one account's client
+ */
+struct MultiLaunchResult {
+    QString username;
+    bool success = false;
+    QString errorMessage;
+    qint64 processId = 0;
+};
+
+/**
+ * Launches several accounts as a group
+ * 
+ * Every account logs in at once while the Wine prefix, shader caches and
+ * wineserver are prepared a single time for all of them. Clients then
+ * start one after another, staggerMs() apart, so they don't all read the
+ * DAT files at the same moment; the gap is longer when the game lives on
+ * a spinning disk. The started clients are tracked until the last exits.
+ * Runs on the thread it lives on.
+ */
+class MultiLauncher : public QObject {
+    Q_OBJECT
+    
+public:
+    MultiLauncher(const GameConfig& gameConfig, const QString& gameId,
+                  const QString& authServer, QObject* parent = nullptr);
+    ~MultiLauncher() override;
+    
+    /**
+     * Log in and launch every account on the world
+     */
+    void start(const std::vector<MultiLaunchAccount>& accounts, const World& world);
+    
+    void setStaggerMs(int milliseconds) { m_staggerMs = milliseconds; }
+    int staggerMs() const { return m_staggerMs; }
+    
+    /**
+     * Whether accounts are still logging in or waiting to start
+     */
+    bool isLaunching() const { return m_launching; }
+    
+    /**
+     * Clients of the group that are still running
+     */
+    int runningClients() const;
+    
+    /**
+     * Ask every running client of the group to exit
+     */
+    void terminateAll();
+    
+    static constexpr int STAGGER_MS = 5000;
+    static constexpr int ROTATIONAL_STAGGER_MS = 20000;
+    
+signals:
+    void statusChanged(const QString& message);
+    void clientStarted(const QString& username, qint64 processId);
+    
+    /**
+     * Every account has been started or has failed
+     */
+    void finished(const std::vector<MultiLaunchResult>& results);
+    
+    /**
+     * The last running client of the group has exited
+     */
+    void allClientsExited();
+    
+private:
+    void onLoggedIn(size_t index, const LoginResult& login);
+    void launchNext();
+    void onClientLaunched(size_t index, const LaunchResult& launch);
+    size_t nextLaunchable(size_t from) const;
+    bool hasLaunchable(size_t from) const;
+    void finishLaunching();
+    
+    struct Client {
+        MultiLaunchResult result;
+        QString ticket;
+        QString subscription;
+        std::unique_ptr<GameLauncher> launcher;
+    };
+    
+    GameConfig m_gameConfig;
+    QString m_gameId;
+    QString m_authServer;
+    World m_world;
+    std::vector<Client> m_clients;
+    size_t m_pendingLogins = 0;
+    size_t m_nextLaunch = 0;
+    bool m_environmentReady = false;
+    bool m_launching = false;
+    int m_staggerMs;
+};
+
+} // namespace lotro
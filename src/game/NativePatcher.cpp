@@ -5,26 +5,61 @@
  */
 
 #include "NativePatcher.hpp"
+#include "DownloadScheduler.hpp"
+#include "FileHashCache.hpp"
+#include "ManifestDatabase.hpp"
+#include "ManifestReader.hpp"
+#include "PatchTelemetry.hpp"
+#include "VerifyPool.hpp"
+#include "core/DownloadStore.hpp"
+#include "core/platform/Platform.hpp"
+#include "dat/DatArchive.hpp"
+#include "dat/DatDelta.hpp"
+#include "dat/DatIndex.hpp"
+#include "network/HttpClient.hpp"
+#include "network/NetworkTrace.hpp"
 
 #include <QCryptographicHash>
 #include <QDir>
-#include <QDomDocument>
 #include <QEventLoop>
 #include <QFile>
 #include <QFileInfo>
+#include <QFutureWatcher>
 #include <QTimer>
+#include <QtConcurrent>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 namespace lotro {
 
+namespace {
+
+DownloadStore::Link storeLink(const QString& relativePath) {
+    // Archives are patched in place, here and by the game's own patcher,
+    // so they must never share an inode with the store
+    return relativePath.endsWith(".dat", Qt::CaseInsensitive) ? DownloadStore::Link::Private
+                                                               : DownloadStore::Link::Shared;
+}
+
+QNetworkRequest patchRequest(const QString& url, int timeoutMs = HttpClient::DEFAULT_TIMEOUT_MS) {
+    QNetworkRequest request = HttpClient::request(QUrl{url}, timeoutMs);
+    NetworkTrace::tag(request, "Patcher");
+    return request;
+}
+
+} // namespace
+
 NativePatcher::NativePatcher(
     const std::filesystem::path& gameDirectory,
     QObject* parent
 )
     : QObject(parent)
     , m_gameDirectory(gameDirectory)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_networkManager(HttpClient::manager())
+    , m_maxConnections(DownloadScheduler::DEFAULT_MAX_CONNECTIONS)
+    , m_maxConnectionsPerHost(DownloadScheduler::DEFAULT_MAX_PER_HOST)
 {
     spdlog::info("NativePatcher initialized for: {}", gameDirectory.string());
 }
@@ -59,7 +94,11 @@ bool NativePatcher::downloadSplashscreens(
     }
     
     // Parse manifest
-    auto files = parseSplashscreenManifest(manifestData);
+    QString parseError;
+    auto files = ManifestReader::parse(ManifestReader::Format::Splashscreen, manifestData, &parseError);
+    if (!parseError.isEmpty()) {
+        spdlog::error("Failed to parse splashscreen manifest XML: {}", parseError.toStdString());
+    }
     if (files.empty()) {
         spdlog::info("No splashscreen files to download");
         m_isPatching = false;
@@ -72,29 +111,51 @@ bool NativePatcher::downloadSplashscreens(
     m_progress.totalFiles = static_cast<int>(files.size());
     m_progress.currentFile = 0;
     
-    // Download each file
-    for (const auto& file : files) {
-        if (m_cancelled) {
-            m_lastError = "Cancelled by user";
-            m_isPatching = false;
-            return false;
+    // All of them at optional priority, so they never hold up game files
+    DownloadScheduler scheduler(m_networkManager);
+    scheduler.setMaxConnections(m_maxConnections);
+    scheduler.setMaxPerHost(m_maxConnectionsPerHost);
+    m_scheduler = &scheduler;
+    
+    QEventLoop loop;
+    connect(&scheduler, &DownloadScheduler::idle, &loop, &QEventLoop::quit);
+    connect(&scheduler, &DownloadScheduler::jobFinished, this,
+            [&](int id, bool success, const QString& error) {
+        const DownloadFile& file = files[static_cast<size_t>(id)];
+        if (!success) {
+            // Splashscreens are optional; carry on with the others
+            spdlog::warn("Failed to download: {} ({})", file.downloadUrl.toStdString(), error.toStdString());
         }
-        
         m_progress.currentFile++;
         m_progress.currentFileName = file.relativePath;
         m_progress.status = QString("Downloading: %1").arg(file.description);
         if (progress) progress(m_progress);
-        
+    });
+    
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& file = files[i];
         auto localPath = m_gameDirectory / file.relativePath.toStdString();
         
         // Create parent directories
         std::filesystem::create_directories(localPath.parent_path());
         
-        // Download file
-        if (!downloadFile(file.downloadUrl, localPath)) {
-            spdlog::warn("Failed to download: {}", file.downloadUrl.toStdString());
-            // Continue with other files, splashscreens are optional
-        }
+        DownloadJob job;
+        job.id = static_cast<int>(i);
+        job.url = QUrl(file.downloadUrl);
+        job.localPath = localPath;
+        job.priority = DownloadPriority::Optional;
+        scheduler.enqueue(std::move(job));
+    }
+    
+    if (!scheduler.isIdle()) {
+        loop.exec();
+    }
+    m_scheduler = nullptr;
+    
+    if (m_cancelled) {
+        m_lastError = "Cancelled by user";
+        m_isPatching = false;
+        return false;
     }
     
     m_progress.phase = NativePatchProgress::Complete;
@@ -126,101 +187,352 @@ bool NativePatcher::downloadGameFiles(
     
     spdlog::info("Fetching game manifest: {}", manifestUrl.toStdString());
     
-    // Fetch manifest
-    QByteArray manifestData = fetchUrl(manifestUrl);
-    if (manifestData.isEmpty()) {
-        m_lastError = "Failed to fetch game manifest";
-        m_isPatching = false;
-        return false;
-    }
-    
-    // Parse manifest
-    auto files = parsePatchingManifest(manifestData);
-    spdlog::info("Found {} game files in manifest", files.size());
+    // Files are checked, and queued if they need downloading, while the
+    // manifest is still streaming in. Only files whose size or mtime
+    // changed since the last run are hashed again.
+    FileHashCache hashCache(m_gameDirectory);
+    hashCache.load();
+    
+    // Entries unchanged since the last completed run are only stat'ed;
+    // the run is pending until it succeeds
+    ManifestDatabase manifestDb(m_gameDirectory);
+    manifestDb.load();
+    const bool trustApplied = manifestDb.isApplied() && !m_verifyAll;
+    manifestDb.setPending();
+    manifestDb.save();
+    QSet<QString> seen;
+    QCryptographicHash manifestDigest(QCryptographicHash::Md5);
+    QString manifestValidator;
+    int added = 0;
+    int changed = 0;
+    
+    // Shared by the checks and the downloads, sized for the disk underneath
+    VerifyPool verifyPool(m_gameDirectory);
+    PatchTelemetry telemetry("game-files");
+    telemetry.setRotational(verifyPool.rotational());
+    qint64 scanBytes = 0;                   // Existing files sent for rehashing
+    
+    QString base = baseDownloadUrl;
+    if (!base.endsWith('/')) base += '/';
+    
+    DownloadStore& store = DownloadStore::shared();
+    DownloadScheduler scheduler(m_networkManager);
+    scheduler.setMaxConnections(m_maxConnections);
+    scheduler.setMaxPerHost(m_maxConnectionsPerHost);
+    scheduler.setVerifyPool(&verifyPool);
+    m_scheduler = &scheduler;
+    
+    std::vector<DownloadFile> files;        // The manifest so far; job ids index it
+    std::vector<size_t> deltas;             // Outdated archives offering iteration data
+    int checked = 0;
+    int hashing = 0;                        // Files being hashed on the verify pool
+    bool manifestDone = false;
+    bool failed = false;
+    QEventLoop loop;
     
-    // Check which files need to be downloaded
-    m_progress.phase = NativePatchProgress::CheckingFiles;
-    m_progress.status = "Checking existing files...";
-    if (progress) progress(m_progress);
+    auto settled = [&]() { return manifestDone && hashing == 0 && scheduler.isIdle(); };
+    auto settle = [&]() {
+        if (settled()) loop.quit();
+    };
+    
+    auto report = [&]() {
+        // Downloads are hashed as they arrive, so they count as hashing work too
+        const qint64 received = scheduler.bytesReceived();
+        telemetry.setTotals(m_progress.totalBytes, scanBytes + m_progress.totalBytes);
+        telemetry.sample(received, verifyPool.verifiedBytes(), scanBytes + received);
+        m_progress.bytesDownloaded = std::min(m_progress.totalBytes, received);
+        m_progress.bytesVerified = verifyPool.verifiedBytes();
+        m_progress.downloadBytesPerSecond = telemetry.downloadRate();
+        m_progress.verifyBytesPerSecond = telemetry.verifyRate();
+        m_progress.etaSeconds = telemetry.etaSeconds();
+        if (progress) progress(m_progress);
+    };
     
-    std::vector<DownloadFile> filesToDownload;
-    m_progress.totalBytes = 0;
+    auto fail = [&](const QString& error) {
+        if (!failed) {
+            m_lastError = error;
+            failed = true;
+        }
+        scheduler.cancel();
+        if (m_manifestReply && m_manifestReply->isRunning()) {
+            m_manifestReply->abort();
+        }
+    };
     
-    for (const auto& file : files) {
+    auto download = [&](size_t index) {
+        const DownloadFile& file = files[index];
         auto localPath = m_gameDirectory / file.relativePath.toStdString();
+        std::filesystem::create_directories(localPath.parent_path());
         
-        if (!std::filesystem::exists(localPath)) {
-            filesToDownload.push_back(file);
-            m_progress.totalBytes += file.size;
-            spdlog::debug("Missing: {}", file.relativePath.toStdString());
-        }
-    }
-    
-    if (filesToDownload.empty()) {
-        spdlog::info("No game files need downloading");
-        m_progress.phase = NativePatchProgress::Complete;
-        m_progress.status = "Up to date";
-        if (progress) progress(m_progress);
-        m_isPatching = false;
-        emit finished(true);
-        return true;
-    }
-    
-    spdlog::info("Need to download {} files ({} bytes)", 
-        filesToDownload.size(), m_progress.totalBytes);
-    
-    // Download missing files
-    m_progress.phase = NativePatchProgress::DownloadingFiles;
-    m_progress.totalFiles = static_cast<int>(filesToDownload.size());
-    m_progress.currentFile = 0;
-    m_progress.bytesDownloaded = 0;
-    
-    for (const auto& file : filesToDownload) {
-        if (m_cancelled) {
-            m_lastError = "Cancelled by user";
-            m_isPatching = false;
-            return false;
+        // Another installation may have fetched these exact bytes already
+        if (!file.md5Hash.isEmpty()
+            && store.materialize(DownloadStore::key(QCryptographicHash::Md5, file.md5Hash), localPath,
+                                 storeLink(file.relativePath), file.size)) {
+            hashCache.store(file.relativePath, file.md5Hash.toLower());
+            m_progress.currentFile++;
+            m_progress.currentFileName = file.relativePath;
+            report();
+            return;
         }
         
-        m_progress.currentFile++;
-        m_progress.currentFileName = file.relativePath;
-        m_progress.status = QString("Downloading: %1").arg(file.relativePath);
-        if (progress) progress(m_progress);
+        DownloadJob job;
+        job.id = static_cast<int>(index);
+        job.url = QUrl(base + file.relativeUrl);
+        job.localPath = localPath;
+        job.expectedSize = file.size;
+        job.md5 = file.md5Hash;
+        job.priority = isLaunchCritical(file.relativePath) ? DownloadPriority::Critical
+                                                           : DownloadPriority::Normal;
+        scheduler.enqueue(std::move(job));
         
-        auto localPath = m_gameDirectory / file.relativePath.toStdString();
+        m_progress.totalBytes += file.size;
+        report();
+    };
+    
+    auto decide = [&](size_t index, const FileState& state) {
+        const DownloadFile& file = files[index];
+        checked++;
+        const char* reason = nullptr;
+        if (!state.exists) {
+            reason = "Missing";
+        } else if (file.size > 0 && state.size != file.size) {
+            reason = "Size differs";
+        } else if (!file.md5Hash.isEmpty() && state.md5.compare(file.md5Hash, Qt::CaseInsensitive) != 0) {
+            reason = "MD5 differs";
+        }
+        if (!reason) {
+            if (m_progress.totalFiles == 0 && checked % 100 == 0) {
+                m_progress.status = QString("Checking existing files... (%1 checked, %2 MB/s)")
+                                    .arg(checked)
+                                    .arg(telemetry.verifyRate() / (1024 * 1024), 0, 'f', 1);
+                report();
+            }
+            return;
+        }
+        SPDLOG_DEBUG("{}: {}", reason, file.relativePath.toStdString());
         
-        // Create parent directories
-        std::filesystem::create_directories(localPath.parent_path());
+        m_progress.phase = NativePatchProgress::DownloadingFiles;
+        m_progress.totalFiles++;
+        if (!file.iterationsUrl.isEmpty() && state.exists
+            && file.relativePath.endsWith(".dat", Qt::CaseInsensitive)) {
+            deltas.push_back(index);
+            report();
+            return;
+        }
+        download(index);
+    };
+    
+    auto check = [&](size_t index) {
+        const DownloadFile& file = files[index];
+        ManifestDatabase::Change change = manifestDb.classify(file);
+        if (change == ManifestDatabase::Change::Added) {
+            added++;
+        } else if (change == ManifestDatabase::Change::Changed) {
+            changed++;
+        }
         
-        // Build download URL
-        QString downloadUrl = baseDownloadUrl;
-        if (!downloadUrl.endsWith('/')) downloadUrl += '/';
-        downloadUrl += file.relativeUrl;
+        FileState state;
+        state.relativePath = file.relativePath;
+        state.expectedSize = file.size > 0 ? file.size : -1;
+        if (hashCache.lookup(state)) {
+            decide(index, state);
+            return;
+        }
+        if (trustApplied && change == ManifestDatabase::Change::Unchanged) {
+            // Present at the right size and verified by the last run; only
+            // its mtime moved
+            state.md5 = file.md5Hash;
+            decide(index, state);
+            return;
+        }
         
-        // Download file
-        if (!downloadFile(downloadUrl, localPath)) {
-            m_lastError = QString("Failed to download: %1").arg(file.relativePath);
-            m_isPatching = false;
-            return false;
+        hashing++;
+        scanBytes += state.size;
+        const QString path = hashCache.filePath(state.relativePath);
+        QtConcurrent::run(verifyPool.pool(), [path, &verifyPool]() {
+            return FileHashCache::hashFile(path, &verifyPool);
+        }).then(this, [&, index, state](const QString& md5) mutable {
+            hashing--;
+            state.md5 = md5;
+            hashCache.store(state);
+            if (!failed && !m_cancelled) {
+                decide(index, state);
+            }
+            settle();
+        });
+    };
+    
+    connect(&scheduler, &DownloadScheduler::idle, &loop, settle);
+    connect(&scheduler, &DownloadScheduler::progress, this, report);
+    connect(&scheduler, &DownloadScheduler::transferFinished, this, [&](const TransferStats& stats) {
+        telemetry.recordTransfer(stats);
+    });
+    
+    connect(&scheduler, &DownloadScheduler::jobFinished, this,
+            [&](int id, bool success, const QString& error) {
+        // Hashes are checked by the scheduler while the data streams in
+        const DownloadFile& file = files[static_cast<size_t>(id)];
+        if (!success) {
+            fail(error == "MD5 mismatch"
+                 ? QString("Hash verification failed: %1").arg(file.relativePath)
+                 : QString("Failed to download: %1 (%2)").arg(file.relativePath, error));
+            return;
         }
         
-        // Verify hash if provided
         if (!file.md5Hash.isEmpty()) {
-            if (!verifyMd5(localPath, file.md5Hash)) {
-                spdlog::error("Hash mismatch for: {}", file.relativePath.toStdString());
-                std::filesystem::remove(localPath);
-                m_lastError = QString("Hash verification failed: %1").arg(file.relativePath);
-                m_isPatching = false;
-                return false;
+            hashCache.store(file.relativePath, file.md5Hash.toLower());
+            store.insert(m_gameDirectory / file.relativePath.toStdString(),
+                         DownloadStore::key(QCryptographicHash::Md5, file.md5Hash), storeLink(file.relativePath));
+        }
+        m_progress.currentFile++;
+        m_progress.currentFileName = file.relativePath;
+        m_progress.status = QString("Downloading: %1 (%2 at a time)")
+                            .arg(file.relativePath).arg(scheduler.activeCount());
+        report();
+    });
+    
+    // Stream the manifest
+    // Timed by the drain below, which restarts on every chunk
+    QNetworkReply* reply = m_networkManager->get(patchRequest(manifestUrl, 0));
+    m_manifestReply = reply;
+    ManifestReader reader(ManifestReader::Format::Patching);
+    
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    timeout.setInterval(MANIFEST_TIMEOUT_MS);
+    connect(&timeout, &QTimer::timeout, reply, &QNetworkReply::abort);
+    
+    auto drain = [&]() {
+        timeout.start();
+        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() >= 400) {
+            reply->readAll();               // Error page, reported when the reply finishes
+            return;
+        }
+        const QByteArray data = reply->readAll();
+        manifestDigest.addData(data);
+        reader.addData(data);
+        for (DownloadFile& file : reader.takeFiles()) {
+            seen.insert(file.relativePath);
+            files.push_back(std::move(file));
+            if (failed || m_cancelled) {
+                continue;
+            }
+            if (m_progress.phase == NativePatchProgress::FetchingManifest) {
+                m_progress.phase = NativePatchProgress::CheckingFiles;
+                m_progress.status = "Checking existing files...";
+                report();
             }
+            check(files.size() - 1);
         }
-        
-        m_progress.bytesDownloaded += file.size;
-        if (progress) progress(m_progress);
+        if (reader.hasError() && !failed) {
+            spdlog::error("Failed to parse game manifest: {}", reader.errorString().toStdString());
+            fail("Failed to parse game manifest");
+        }
+    };
+    
+    connect(reply, &QNetworkReply::readyRead, this, drain);
+    connect(reply, &QNetworkReply::finished, this, [&]() {
+        timeout.stop();
+        if (!failed && !m_cancelled) {
+            if (reply->error() != QNetworkReply::NoError) {
+                spdlog::error("Fetch error: {} - {}", manifestUrl.toStdString(),
+                             reply->errorString().toStdString());
+                fail("Failed to fetch game manifest");
+            } else {
+                drain();
+                manifestValidator = ManifestDatabase::validatorOf(reply);
+                if (!failed && !reader.atEnd()) {
+                    spdlog::error("Game manifest ended early");
+                    fail("Failed to parse game manifest");
+                }
+            }
+        }
+        spdlog::info("Found {} game files in manifest", files.size());
+        if (!failed && !m_cancelled) {
+            const QStringList removed = manifestDb.removed(seen);
+            spdlog::info("Manifest changes since the last run: {} added, {} changed, {} removed",
+                         added, changed, removed.size());
+            for (const auto& path : removed) {
+                SPDLOG_DEBUG("No longer in the manifest: {}", path.toStdString());
+            }
+        }
+        manifestDone = true;
+        m_manifestReply = nullptr;
+        reply->deleteLater();
+        settle();
+    });
+    timeout.start();
+    
+    if (!settled()) {
+        loop.exec();
+    }
+    
+    // Archives with iteration data are patched entry by entry once the
+    // rest is in; any that can't be are downloaded whole after all
+    if (!failed && !m_cancelled && !deltas.empty()) {
+        for (size_t index : deltas) {
+            const DownloadFile& file = files[index];
+            if (m_cancelled) {
+                break;
+            }
+            m_progress.currentFileName = file.relativePath;
+            m_progress.status = QString("Patching: %1").arg(file.relativePath);
+            report();
+            bool damaged = false;
+            if (patchDatDelta(file, base, verifyPool, damaged)) {
+                hashCache.store(file.relativePath, file.md5Hash.toLower());
+                m_progress.currentFile++;
+                continue;
+            }
+            if (damaged) {
+                // The next run must hash it, find it wrong and download it,
+                // even if this one stops here
+                hashCache.forget(file.relativePath);
+            }
+            if (!m_cancelled) {
+                download(index);
+            } else if (damaged) {
+                spdlog::warn("{} was left partly patched and will be downloaded on the next run",
+                             file.relativePath.toStdString());
+            }
+        }
+        if (!settled()) {
+            loop.exec();
+        }
+    }
+    m_scheduler = nullptr;
+    hashCache.save();
+    store.trim();
+    report();
+    telemetry.finish(!failed && !m_cancelled);
+    
+    if (m_cancelled) {
+        m_lastError = "Cancelled by user";
+        m_isPatching = false;
+        return false;
+    }
+    if (failed) {
+        m_isPatching = false;
+        return false;
     }
     
+    // The manifest is only recorded as applied once the new files are on disk
+    if (!scheduler.syncFinished()) {
+        m_lastError = "Failed to write downloaded files to disk";
+        m_isPatching = false;
+        return false;
+    }
+    manifestDb.replace(files, manifestValidator, manifestDigest.result());
+    manifestDb.save();
+    
     m_progress.phase = NativePatchProgress::Complete;
-    m_progress.status = QString("Downloaded %1 files").arg(filesToDownload.size());
+    if (m_progress.totalFiles == 0) {
+        spdlog::info("All {} game files match the manifest", files.size());
+        m_progress.status = "Up to date";
+    } else {
+        spdlog::info("Downloaded {} files ({} bytes)", m_progress.totalFiles, m_progress.totalBytes);
+        m_progress.status = QString("Downloaded %1 files").arg(m_progress.totalFiles);
+    }
     if (progress) progress(m_progress);
     
     m_isPatching = false;
@@ -228,12 +540,51 @@ bool NativePatcher::downloadGameFiles(
     return true;
 }
 
+bool NativePatcher::needsPatching(const QString& manifestUrl) {
+    ManifestDatabase manifestDb(m_gameDirectory);
+    if (!manifestDb.load() || !manifestDb.isApplied()) {
+        return true;
+    }
+    
+    if (!manifestDb.validator().isEmpty()) {
+        const QString validator = fetchValidator(manifestUrl);
+        if (!validator.isEmpty()) {
+            return validator != manifestDb.validator();
+        }
+    }
+    
+    // Nothing to go by but the document itself
+    const QByteArray data = fetchUrl(manifestUrl);
+    if (data.isEmpty()) {
+        return true;
+    }
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5) != manifestDb.digest();
+}
+
+void NativePatcher::setVerifyAll(bool verifyAll) {
+    m_verifyAll = verifyAll;
+}
+
 bool NativePatcher::isPatching() const {
     return m_isPatching;
 }
 
+void NativePatcher::setMaxConnections(int connections) {
+    m_maxConnections = std::max(1, connections);
+}
+
+void NativePatcher::setMaxConnectionsPerHost(int connections) {
+    m_maxConnectionsPerHost = std::max(1, connections);
+}
+
 void NativePatcher::cancel() {
     m_cancelled = true;
+    if (m_scheduler) {
+        m_scheduler->cancel();
+    }
+    if (m_manifestReply) {
+        m_manifestReply->abort();
+    }
     spdlog::info("NativePatcher: cancel requested");
 }
 
@@ -241,136 +592,127 @@ QString NativePatcher::lastError() const {
     return m_lastError;
 }
 
-std::vector<DownloadFile> NativePatcher::parseSplashscreenManifest(const QByteArray& xml) {
-    std::vector<DownloadFile> files;
-    
-    QDomDocument doc;
-    if (!doc.setContent(xml)) {
-        spdlog::error("Failed to parse splashscreen manifest XML");
-        return files;
-    }
-    
-    QDomElement root = doc.documentElement();
-    QDomNodeList fileNodes = root.elementsByTagName("File");
-    
-    for (int i = 0; i < fileNodes.count(); i++) {
-        QDomElement fileElem = fileNodes.at(i).toElement();
-        
-        DownloadFile file;
-        file.description = fileElem.firstChildElement("Description").text();
-        file.relativePath = fileElem.firstChildElement("FileName").text().replace("\\", "/");
-        file.downloadUrl = fileElem.firstChildElement("DownloadUrl").text();
-        
-        if (!file.downloadUrl.isEmpty()) {
-            files.push_back(file);
-        }
-    }
-    
-    return files;
+bool NativePatcher::isLaunchCritical(const QString& relativePath) {
+    // The client binaries; without them nothing else matters
+    const QString suffix = QFileInfo(relativePath).suffix().toLower();
+    return suffix == "exe" || suffix == "dll";
 }
 
-std::vector<DownloadFile> NativePatcher::parsePatchingManifest(const QByteArray& xml) {
-    std::vector<DownloadFile> files;
-    
-    QDomDocument doc;
-    if (!doc.setContent(xml)) {
-        spdlog::error("Failed to parse patching manifest XML");
-        return files;
+bool NativePatcher::patchDatDelta(const DownloadFile& file, const QString& base, VerifyPool& verifyPool,
+                                  bool& damaged) {
+    damaged = false;
+    const QString path = QString::fromStdString((m_gameDirectory / file.relativePath.toStdString()).string());
+    const QString listingUrl = base + file.iterationsUrl;
+    const QByteArray listing = fetchUrl(listingUrl);
+    std::vector<dat::DatRemoteEntry> remote;
+    QString error;
+    if (listing.isEmpty() || !dat::DatDelta::parseListing(listing, remote, &error)) {
+        spdlog::warn("No usable iteration data for {}, downloading it whole: {}",
+                     file.relativePath.toStdString(), error.isEmpty() ? "fetch failed" : error.toStdString());
+        return false;
     }
     
-    QDomElement root = doc.documentElement();
-    QDomNodeList fileNodes = root.elementsByTagName("File");
-    
-    for (int i = 0; i < fileNodes.count(); i++) {
-        QDomElement fileElem = fileNodes.at(i).toElement();
-        
-        DownloadFile file;
-        file.relativeUrl = fileElem.firstChildElement("From").text().replace("\\", "/");
-        file.relativePath = fileElem.firstChildElement("To").text().replace("\\", "/");
-        file.size = fileElem.firstChildElement("Size").text().toLongLong();
-        file.md5Hash = fileElem.firstChildElement("MD5").text();
-        
-        if (!file.relativeUrl.isEmpty() && !file.relativePath.isEmpty()) {
-            files.push_back(file);
+    const QString indexDirectory = dat::DatIndex::defaultDirectory();
+    dat::DatDeltaPlan plan;
+    {
+        dat::DatArchive archive(path);
+        archive.setIndexDirectory(indexDirectory);
+        if (!archive.open()) {
+            return false;
         }
+        plan = dat::DatDelta::plan(archive, remote);
     }
-    
-    return files;
-}
-
-bool NativePatcher::downloadFile(const QString& url, const std::filesystem::path& localPath) {
-    spdlog::debug("Downloading: {} -> {}", url.toStdString(), localPath.string());
-    
-    QNetworkRequest request{QUrl{url}};
-    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, 
-                         QNetworkRequest::NoLessSafeRedirectPolicy);
-    
-    QNetworkReply* reply = m_networkManager->get(request);
-    
-    QEventLoop loop;
-    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    
-    // Timeout after 60 seconds
-    QTimer timer;
-    timer.setSingleShot(true);
-    connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-    timer.start(60000);
-    
-    loop.exec();
-    
-    if (!timer.isActive()) {
-        spdlog::error("Download timeout: {}", url.toStdString());
-        reply->abort();
-        reply->deleteLater();
+    if (!plan.inPlace() || plan.changed.empty()) {
+        spdlog::info("Downloading {} whole: {}", file.relativePath.toStdString(),
+                     plan.inPlace() ? "no entry is newer" : plan.fallback.toStdString());
         return false;
     }
-    
-    timer.stop();
-    
-    if (reply->error() != QNetworkReply::NoError) {
-        spdlog::error("Download error: {} - {}", url.toStdString(), 
-                     reply->errorString().toStdString());
-        reply->deleteLater();
-        return false;
+    spdlog::info("{}: {} of {} entries changed ({} bytes instead of {})", file.relativePath.toStdString(),
+                 plan.changed.size(), remote.size(), plan.bytes, file.size);
+    
+    // Entries are staged on disk through a scheduler of their own, so they
+    // get the same resume, verification and bandwidth limit as whole files
+    const auto staging = Platform::getCachePath() / "dat-delta" / QFileInfo(path).fileName().toStdString();
+    std::filesystem::create_directories(staging);
+    const QString listingBase = listingUrl.left(listingUrl.lastIndexOf('/') + 1);
+    auto stagedPath = [&](size_t i) {
+        return staging / QString::number(plan.changed[i].fileId, 16).toStdString();
+    };
+    
+    DownloadScheduler scheduler(m_networkManager);
+    scheduler.setMaxConnections(m_maxConnections);
+    scheduler.setMaxPerHost(m_maxConnectionsPerHost);
+    scheduler.setVerifyPool(&verifyPool);
+    DownloadScheduler* outer = m_scheduler;
+    m_scheduler = &scheduler;
+    
+    for (size_t i = 0; i < plan.changed.size(); ++i) {
+        DownloadJob job;
+        job.id = static_cast<int>(i);
+        job.url = QUrl(listingBase + plan.changed[i].url);
+        job.localPath = stagedPath(i);
+        job.expectedSize = plan.changed[i].size;
+        job.md5 = plan.changed[i].md5;
+        scheduler.enqueue(std::move(job));
     }
     
-    QByteArray data = reply->readAll();
-    reply->deleteLater();
+    bool fetched = true;
+    QEventLoop loop;
+    connect(&scheduler, &DownloadScheduler::idle, &loop, &QEventLoop::quit);
+    connect(&scheduler, &DownloadScheduler::jobFinished, this,
+            [&](int id, bool success, const QString& jobError) {
+        if (!success && fetched) {
+            spdlog::warn("Failed to fetch entry {:08x} of {}: {}", plan.changed[static_cast<size_t>(id)].fileId,
+                         file.relativePath.toStdString(), jobError.toStdString());
+            fetched = false;
+            scheduler.cancel();
+        }
+    });
+    if (!scheduler.isIdle()) {
+        loop.exec();
+    }
+    m_scheduler = outer;
     
-    // Write to file
-    QFile file(QString::fromStdString(localPath.string()));
-    if (!file.open(QIODevice::WriteOnly)) {
-        spdlog::error("Failed to open file for writing: {}", localPath.string());
+    bool patched = false;
+    if (fetched && !m_cancelled) {
+        auto load = [&](size_t i, QByteArray& data) {
+            QFile staged(QString::fromStdString(stagedPath(i).string()));
+            if (!staged.open(QIODevice::ReadOnly)) {
+                return false;
+            }
+            data = staged.readAll();
+            return true;
+        };
+        patched = dat::DatDelta::apply(path, plan, load, indexDirectory, &damaged, &error);
+        if (!patched) {
+            spdlog::warn("Failed to patch {} in place: {}", file.relativePath.toStdString(), error.toStdString());
+        }
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(staging, ec);
+    if (!patched) {
         return false;
     }
     
-    file.write(data);
-    file.close();
-    
-    spdlog::debug("Downloaded {} bytes to {}", data.size(), localPath.string());
-    return true;
-}
-
-bool NativePatcher::verifyMd5(const std::filesystem::path& path, const QString& expectedHash) {
-    QFile file(QString::fromStdString(path.string()));
-    if (!file.open(QIODevice::ReadOnly)) {
+    // The manifest's MD5 is still the final word on the archive
+    QFutureWatcher<QString> watcher;
+    connect(&watcher, &QFutureWatcher<QString>::finished, &loop, &QEventLoop::quit);
+    watcher.setFuture(QtConcurrent::run(verifyPool.pool(), [path, &verifyPool]() {
+        return FileHashCache::hashFile(path, &verifyPool);
+    }));
+    if (!watcher.isFinished()) {
+        loop.exec();
+    }
+    if (!file.md5Hash.isEmpty() && watcher.result().compare(file.md5Hash, Qt::CaseInsensitive) != 0) {
+        spdlog::warn("{} doesn't match the manifest after patching in place", file.relativePath.toStdString());
+        damaged = true;
         return false;
     }
-    
-    QCryptographicHash hash(QCryptographicHash::Md5);
-    hash.addData(&file);
-    file.close();
-    
-    QString actualHash = hash.result().toHex().toLower();
-    return actualHash == expectedHash.toLower();
+    return true;
 }
 
-QByteArray NativePatcher::fetchUrl(const QString& url) {
-    QNetworkRequest request{QUrl{url}};
-    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, 
-                         QNetworkRequest::NoLessSafeRedirectPolicy);
-    
-    QNetworkReply* reply = m_networkManager->get(request);
+QString NativePatcher::fetchValidator(const QString& url) {
+    QNetworkReply* reply = m_networkManager->head(patchRequest(url, 0));
     
     QEventLoop loop;
     connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
@@ -378,7 +720,7 @@ QByteArray NativePatcher::fetchUrl(const QString& url) {
     QTimer timer;
     timer.setSingleShot(true);
     connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-    timer.start(30000);
+    timer.start(MANIFEST_TIMEOUT_MS);
     
     loop.exec();
     
@@ -387,19 +729,27 @@ QByteArray NativePatcher::fetchUrl(const QString& url) {
         reply->deleteLater();
         return {};
     }
-    
     timer.stop();
     
-    if (reply->error() != QNetworkReply::NoError) {
-        spdlog::error("Fetch error: {} - {}", url.toStdString(), 
+    QString validator;
+    if (reply->error() == QNetworkReply::NoError) {
+        validator = ManifestDatabase::validatorOf(reply);
+    } else {
+        spdlog::warn("Manifest check failed: {} - {}", url.toStdString(), 
                      reply->errorString().toStdString());
-        reply->deleteLater();
-        return {};
     }
-    
-    QByteArray data = reply->readAll();
     reply->deleteLater();
-    return data;
+    return validator;
+}
+
+QByteArray NativePatcher::fetchUrl(const QString& url) {
+    const HttpResponse response = HttpClient::wait(m_networkManager->get(patchRequest(url)));
+    if (!response.ok()) {
+        spdlog::error("Fetch error: {} - {}", url.toStdString(), 
+                     response.errorString.toStdString());
+        return {};
+    }
+    return response.body;
 }
 
 } // namespace lotro
@@ -17,6 +17,9 @@
 
 namespace lotro {
 
+class DownloadScheduler;
+class VerifyPool;
+
 /**
  * Information about a file to download
  */
@@ -27,6 +30,7 @@ struct DownloadFile {
     qint64 size = 0;
     QString md5Hash;
     QString description;
+    QString iterationsUrl;    // Per-entry versions of a .dat archive, relative to base; empty if none
 };
 
 /**
@@ -48,6 +52,10 @@ struct NativePatchProgress {
     int totalFiles = 0;
     qint64 bytesDownloaded = 0;
     qint64 totalBytes = 0;
+    qint64 bytesVerified = 0;           // Hashed so far, by the scan and the downloads
+    double downloadBytesPerSecond = 0.0;    // Over the last few seconds
+    double verifyBytesPerSecond = 0.0;
+    qint64 etaSeconds = -1;             // -1 while unknown
     QString currentFileName;
     QString status;
     QString error;
@@ -92,7 +100,9 @@ public:
 
     /**
      * Download game files from Akamai CDN
-     * Only downloads files that don't exist (initial install)
+     * Only downloads files that are missing or don't match the manifest's
+     * size and MD5; up to maxConnections files are fetched at once,
+     * starting while the manifest is still being read
      */
     bool downloadGameFiles(
         const QString& manifestUrl,
@@ -100,6 +110,27 @@ public:
         NativePatchProgressCallback progress = nullptr
     );
 
+    /**
+     * Whether the game manifest changed since the last completed
+     * downloadGameFiles(); asks the server for the manifest's validator
+     * and doesn't look at the game directory
+     */
+    bool needsPatching(const QString& manifestUrl);
+    
+    /**
+     * Rehash files whose mtime changed even if their manifest entry didn't
+     */
+    void setVerifyAll(bool verifyAll);
+    bool verifyAll() const { return m_verifyAll; }
+    
+    /**
+     * Parallel downloads overall, and against any one host
+     */
+    void setMaxConnections(int connections);
+    void setMaxConnectionsPerHost(int connections);
+    int maxConnections() const { return m_maxConnections; }
+    int maxConnectionsPerHost() const { return m_maxConnectionsPerHost; }
+
     /**
      * Check if currently patching
      */
@@ -120,16 +151,17 @@ signals:
     void finished(bool success);
 
 private:
-    // Manifest parsing
-    std::vector<DownloadFile> parseSplashscreenManifest(const QByteArray& xml);
-    std::vector<DownloadFile> parsePatchingManifest(const QByteArray& xml);
-    
     // File operations
-    bool downloadFile(const QString& url, const std::filesystem::path& localPath);
-    bool verifyMd5(const std::filesystem::path& path, const QString& expectedHash);
+    static bool isLaunchCritical(const QString& relativePath);
+    
+    // Bring an outdated .dat archive up to date from its iteration listing,
+    // writing only the changed entries; false if it has to be downloaded whole.
+    // damaged is set if a failed patch had already written to the archive.
+    bool patchDatDelta(const DownloadFile& file, const QString& base, VerifyPool& verifyPool, bool& damaged);
     
     // Network
     QByteArray fetchUrl(const QString& url);
+    QString fetchValidator(const QString& url);
     
     std::filesystem::path m_gameDirectory;
     QNetworkAccessManager* m_networkManager;
@@ -137,6 +169,13 @@ private:
     bool m_cancelled = false;
     QString m_lastError;
     NativePatchProgress m_progress;
+    int m_maxConnections;
+    int m_maxConnectionsPerHost;
+    bool m_verifyAll = false;
+    DownloadScheduler* m_scheduler = nullptr;   // While downloadGameFiles() runs
+    QNetworkReply* m_manifestReply = nullptr;   // While the game manifest streams in
+    
+    static constexpr int MANIFEST_TIMEOUT_MS = 30000;
 };
 
 } // namespace lotro
@@ -12,15 +12,73 @@
 #include "wine/WineManager.hpp"
 #endif
 
-#include <QCoreApplication>
+#include <QEventLoop>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QTimer>
 #include <QUrl>
 
 #include <spdlog/spdlog.h>
 
 namespace lotro {
 
+namespace {
+
+/**
+ * Splits process output into lines as it arrives, keeping partial lines
+ * for the next read; "\r" counts as a line end too
+ */
+class LineSplitter {
+public:
+    QStringList feed(const QByteArray& data) {
+        m_buffer.append(data);
+        QStringList lines;
+        qsizetype start = 0;
+        for (qsizetype i = 0; i < m_buffer.size(); ++i) {
+            if (m_buffer[i] == '\n' || m_buffer[i] == '\r') {
+                QString line = QString::fromUtf8(m_buffer.constData() + start, i - start).trimmed();
+                if (!line.isEmpty()) {
+                    lines.append(std::move(line));
+                }
+                start = i + 1;
+            }
+        }
+        m_buffer.remove(0, start);
+        return lines;
+    }
+    
+    QString finish() {
+        QString rest = QString::fromUtf8(m_buffer).trimmed();
+        m_buffer.clear();
+        return rest;
+    }
+
+private:
+    QByteArray m_buffer;
+};
+
+/**
+ * Patterns for PatchClient.dll's progress lines, compiled once
+ */
+struct ProgressGrammar {
+    QRegularExpression bytes{R"(bytes to download:\s*(\d+))"};
+    QRegularExpression patches{R"((?:patches|files to patch):\s*(\d+))"};
+    QRegularExpression file{R"(Downloading\s+([\w_.-]+))"};
+    
+    ProgressGrammar() {
+        bytes.optimize();
+        patches.optimize();
+        file.optimize();
+    }
+};
+
+const ProgressGrammar& progressGrammar() {
+    static const ProgressGrammar grammar;
+    return grammar;
+}
+
+} // namespace
+
 class PatchClient::Impl {
 public:
     Impl(const std::filesystem::path& gameDirectory, const QString& patchClientFilename)
@@ -212,53 +270,62 @@ private:
             progress(currentProgress);
         }
         
-        // Wait for process with periodic output reading
-        while (m_process->state() == QProcess::Running && !m_cancelled) {
-            // Wait for output or timeout
-            m_process->waitForReadyRead(200);
-            
-            // Read stdout for progress info
-            while (m_process->canReadLine()) {
-                QByteArray rawLine = m_process->readLine();
-                QString line = QString::fromUtf8(rawLine).trimmed();
-                if (!line.isEmpty()) {
-                    spdlog::info("Patch output: {}", line.toStdString());
-                    parsePatchLine(line, currentProgress);
-                    if (progress) {
-                        progress(currentProgress);
-                    }
-                }
+        // Output is parsed as it arrives; the callback hears about it at
+        // most once a frame
+        LineSplitter stdoutLines;
+        QString stderrText;
+        bool dirty = false;
+        auto handleLine = [&](const QString& line) {
+            spdlog::info("Patch output: {}", line.toStdString());
+            parsePatchLine(line, currentProgress);
+            dirty = true;
+        };
+        
+        QEventLoop loop;
+        QObject::connect(m_process.get(), &QProcess::readyReadStandardOutput, &loop, [&]() {
+            for (const QString& line : stdoutLines.feed(m_process->readAllStandardOutput())) {
+                handleLine(line);
             }
-            
-            // Also read stderr for error messages
-            QByteArray stderrData = m_process->readAllStandardError();
-            if (!stderrData.isEmpty()) {
-                QString stderrStr = QString::fromUtf8(stderrData).trimmed();
-                if (!stderrStr.isEmpty()) {
-                    spdlog::warn("Patch stderr: {}", stderrStr.toStdString());
-                }
+        });
+        QObject::connect(m_process.get(), &QProcess::readyReadStandardError, &loop, [&]() {
+            QString stderrStr = QString::fromUtf8(m_process->readAllStandardError());
+            stderrText += stderrStr;
+            stderrStr = stderrStr.trimmed();
+            if (!stderrStr.isEmpty()) {
+                spdlog::warn("Patch stderr: {}", stderrStr.toStdString());
             }
-            
-            // Process Qt events so UI updates
-            QCoreApplication::processEvents();
+        });
+        QObject::connect(m_process.get(), &QProcess::finished, &loop, &QEventLoop::quit);
+        
+        QTimer frame;
+        frame.setInterval(PROGRESS_FRAME_MS);
+        QObject::connect(&frame, &QTimer::timeout, &loop, [&]() {
+            if (dirty && progress) {
+                progress(currentProgress);
+            }
+            dirty = false;
+        });
+        frame.start();
+        
+        if (m_process->state() != QProcess::NotRunning) {
+            loop.exec();
         }
+        frame.stop();
         
         if (m_cancelled) {
             spdlog::info("Patching cancelled by user");
             return false;
         }
         
-        // Read any remaining output
-        m_process->waitForFinished(30000);
-        
-        // Read any remaining stdout
-        while (m_process->canReadLine()) {
-            QString line = QString::fromUtf8(m_process->readLine()).trimmed();
-            if (!line.isEmpty()) {
-                spdlog::info("Patch output (final): {}", line.toStdString());
-                parsePatchLine(line, currentProgress);
-            }
+        // Anything the signals didn't get to, including an unterminated last line
+        for (const QString& line : stdoutLines.feed(m_process->readAllStandardOutput())) {
+            handleLine(line);
+        }
+        const QString lastLine = stdoutLines.finish();
+        if (!lastLine.isEmpty()) {
+            handleLine(lastLine);
         }
+        stderrText += QString::fromUtf8(m_process->readAllStandardError());
         
         // Exit code 0 means success
         int exitCode = m_process->exitCode();
@@ -266,9 +333,8 @@ private:
         
         if (exitCode != 0) {
             // Read any error output
-            QString stderrStr = QString::fromUtf8(m_process->readAllStandardError());
             m_lastError = QString("Patch phase %1 failed with exit code %2. %3")
-                .arg(phaseStr).arg(exitCode).arg(stderrStr);
+                .arg(phaseStr).arg(exitCode).arg(stderrText.trimmed());
             spdlog::error(m_lastError.toStdString());
             currentProgress.status = "Error: " + m_lastError;
             if (progress) {
@@ -314,15 +380,13 @@ private:
             progress.status = "Checking for updates...";
             
             // Parse "bytes to download: NNNN"
-            QRegularExpression bytesRe(R"(bytes to download:\s*(\d+))");
-            auto match = bytesRe.match(line);
+            auto match = progressGrammar().bytes.match(line);
             if (match.hasMatch()) {
                 progress.totalBytes = match.captured(1).toInt();
             }
             
             // Parse "patches: NNN" or "files to patch: NNN"
-            QRegularExpression patchesRe(R"((?:patches|files to patch):\s*(\d+))");
-            match = patchesRe.match(line);
+            match = progressGrammar().patches.match(line);
             if (match.hasMatch()) {
                 progress.totalFiles = match.captured(1).toInt();
             }
@@ -331,8 +395,7 @@ private:
             progress.status = "Downloading...";
             
             // Extract filename: "Downloading client_cell_1.dat-33186"
-            QRegularExpression fileRe(R"(Downloading\s+([\w_.-]+))");
-            auto match = fileRe.match(line);
+            auto match = progressGrammar().file.match(line);
             if (match.hasMatch()) {
                 progress.currentFileName = match.captured(1);
                 progress.currentFile++;
@@ -348,6 +411,8 @@ private:
         }
     }
     
+    static constexpr int PROGRESS_FRAME_MS = 1000 / 30;
+    
     std::filesystem::path m_gameDirectory;
     QString m_patchClientFilename;
     std::unique_ptr<QProcess> m_process;
@@ -12,6 +12,9 @@
 #include <QDir>
 #include <QEventLoop>
 #include <QTimer>
+#include <QtEndian>
+
+#include <utility>
 
 namespace lotro {
 
@@ -55,6 +58,14 @@ bool PatchServerClient::connectToServer() {
     }
 
     m_socket = new QSslSocket(this);
+    m_readBuffer.clear();
+    connect(m_socket, &QSslSocket::readyRead, this, &PatchServerClient::onReadyRead);
+    connect(m_socket, &QSslSocket::errorOccurred, this, [this]() {
+        failPending(QString("Connection failed: %1").arg(m_socket->errorString()));
+    });
+    connect(m_socket, &QSslSocket::disconnected, this, [this]() {
+        failPending("Disconnected from patch server");
+    });
     
     // Configure SSL
     m_socket->setPeerVerifyMode(QSslSocket::VerifyNone);  // LOTRO uses self-signed certs
@@ -95,53 +106,136 @@ bool PatchServerClient::connectToServer() {
 }
 
 void PatchServerClient::disconnectFromServer() {
+    failPending("Disconnected from patch server");
     if (m_socket) {
+        disconnect(m_socket, nullptr, this, nullptr);
         if (m_socket->isOpen()) {
             m_socket->close();
         }
         m_socket->deleteLater();
         m_socket = nullptr;
     }
+    m_readBuffer.clear();
 }
 
-QByteArray PatchServerClient::sendRequest(const QByteArray& request) {
+quint32 PatchServerClient::postRequest(const QByteArray& request, ResponseHandler handler) {
+    const quint32 sequence = m_nextSequence++;
     if (!m_socket || !m_socket->isEncrypted()) {
         m_lastError = "Not connected to server";
-        return {};
+        handler(false, {});
+        return sequence;
     }
-
-    // Send request
-    m_socket->write(request);
-    m_socket->flush();
-
-    // Wait for response
-    QEventLoop loop;
-    QTimer timer;
-    timer.setSingleShot(true);
     
-    connect(m_socket, &QSslSocket::readyRead, &loop, &QEventLoop::quit);
-    connect(m_socket, &QSslSocket::errorOccurred, &loop, &QEventLoop::quit);
-    connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-    
-    timer.start(30000);  // 30 second timeout
-    loop.exec();
-    
-    if (!timer.isActive()) {
+    m_pending.emplace(sequence, std::move(handler));
+    m_outbox.emplace_back(sequence, request);
+    QTimer::singleShot(REQUEST_TIMEOUT_MS, this, [this, sequence]() {
+        auto it = m_pending.find(sequence);
+        if (it == m_pending.end()) {
+            return;
+        }
+        ResponseHandler handler = std::move(it->second);
+        m_pending.erase(it);
+        m_inFlight.erase(sequence);
         m_lastError = "Response timeout";
-        return {};
+        spdlog::error("PatchServerClient: no response to request {}", sequence);
+        handler(false, {});
+    });
+    sendQueued();
+    return sequence;
+}
+
+void PatchServerClient::sendQueued() {
+    while (m_socket && !m_outbox.empty() && static_cast<int>(m_inFlight.size()) < MAX_IN_FLIGHT) {
+        auto [sequence, request] = std::move(m_outbox.front());
+        m_outbox.pop_front();
+        if (m_pending.find(sequence) == m_pending.end()) {
+            continue;                   // Timed out while queued
+        }
+        
+        m_socket->write(encodeFrame(sequence, encryptRequest(request)));
+        m_inFlight.insert(sequence);
     }
+}
+
+void PatchServerClient::onReadyRead() {
+    QSslSocket* socket = m_socket;
+    m_readBuffer.append(socket->readAll());
     
-    timer.stop();
-    
-    // Read all available data
-    QByteArray response = m_socket->readAll();
-    
-    // May need to read more
-    while (m_socket->waitForReadyRead(100)) {
-        response.append(m_socket->readAll());
+    // Responses may arrive in any order and several to a read
+    qsizetype pos = 0;
+    Frame frame;
+    while (m_socket == socket) {
+        const FrameStatus status = decodeFrame(m_readBuffer, pos, frame);
+        if (status == FrameStatus::Malformed) {
+            spdlog::error("PatchServerClient: oversized response frame, dropping the connection");
+            failPending("Malformed response from patch server");
+            m_socket->abort();
+            return;
+        }
+        if (status == FrameStatus::Incomplete) {
+            break;                      // Rest of the frame still on its way
+        }
+        const quint32 sequence = frame.sequence;
+        
+        m_inFlight.erase(sequence);
+        auto it = m_pending.find(sequence);
+        if (it == m_pending.end()) {
+            spdlog::warn("PatchServerClient: response to unknown request {}", sequence);
+            continue;
+        }
+        ResponseHandler handler = std::move(it->second);
+        m_pending.erase(it);
+        
+        // The handler may send more requests or disconnect
+        handler(true, decryptResponse(frame.payload));
+        sendQueued();
+    }
+    if (m_socket == socket) {
+        m_readBuffer.remove(0, pos);
+    }
+}
+
+void PatchServerClient::failPending(const QString& error) {
+    if (m_pending.empty()) {
+        return;
+    }
+    m_lastError = error;
+    auto pending = std::exchange(m_pending, {});
+    m_outbox.clear();
+    m_inFlight.clear();
+    for (auto& [sequence, handler] : pending) {
+        handler(false, {});
+    }
+}
+
+std::vector<QByteArray> PatchServerClient::sendRequests(const std::vector<QByteArray>& requests) {
+    std::vector<QByteArray> responses(requests.size());
+    if (!m_socket || !m_socket->isEncrypted()) {
+        m_lastError = "Not connected to server";
+        return responses;
     }
     
-    return response;
+    // All of them go out at once; the wait is one round trip, not one each
+    size_t remaining = requests.size();
+    QEventLoop loop;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        postRequest(requests[i], [&, i](bool ok, const QByteArray& response) {
+            if (ok) {
+                responses[i] = response;
+            }
+            if (--remaining == 0) {
+                loop.quit();
+            }
+        });
+    }
+    if (remaining > 0) {
+        loop.exec();
+    }
+    return responses;
+}
+
+QByteArray PatchServerClient::sendRequest(const QByteArray& request) {
+    return sendRequests({request}).front();
 }
 
 PatchCheckResult PatchServerClient::checkForPatches() {
@@ -160,8 +254,22 @@ PatchCheckResult PatchServerClient::checkForPatches() {
     
     // TODO: Implement actual patch server protocol
     // This requires capturing network traffic to understand the format
+    const QByteArray request = buildVersionCheckRequest();
+    if (request.isEmpty()) {
+        result.success = true;
+        return result;
+    }
     
-    result.success = true;
+    if (!connectToServer()) {
+        result.error = m_lastError;
+        return result;
+    }
+    const QByteArray response = sendRequest(request);
+    if (response.isEmpty()) {
+        result.error = m_lastError;
+        return result;
+    }
+    result.success = parseVersionCheckResponse(response, result);
     return result;
 }
 
@@ -199,6 +307,32 @@ bool PatchServerClient::applyPatches(PatchServerProgressCallback progress) {
     return true;
 }
 
+QByteArray PatchServerClient::encodeFrame(quint32 sequence, const QByteArray& payload) {
+    QByteArray frame(FRAME_HEADER_SIZE, Qt::Uninitialized);
+    qToBigEndian<quint32>(static_cast<quint32>(payload.size()), frame.data());
+    qToBigEndian<quint32>(sequence, frame.data() + 4);
+    frame.append(payload);
+    return frame;
+}
+
+PatchServerClient::FrameStatus PatchServerClient::decodeFrame(const QByteArray& buffer, qsizetype& pos,
+                                                              Frame& frame) {
+    if (buffer.size() - pos < FRAME_HEADER_SIZE) {
+        return FrameStatus::Incomplete;
+    }
+    const quint32 length = qFromBigEndian<quint32>(buffer.constData() + pos);
+    if (length > MAX_FRAME_SIZE) {
+        return FrameStatus::Malformed;
+    }
+    if (buffer.size() - pos < FRAME_HEADER_SIZE + static_cast<qsizetype>(length)) {
+        return FrameStatus::Incomplete;
+    }
+    frame.sequence = qFromBigEndian<quint32>(buffer.constData() + pos + 4);
+    frame.payload = buffer.mid(pos + FRAME_HEADER_SIZE, length);
+    pos += FRAME_HEADER_SIZE + length;
+    return FrameStatus::Complete;
+}
+
 QByteArray PatchServerClient::encryptRequest(const QByteArray& plaintext) {
     // TODO: Implement OEMinimalEnvelope encryption
     // This is proprietary and needs reverse engineering
@@ -15,9 +15,11 @@
 #include <QString>
 #include <QSslSocket>
 
+#include <deque>
 #include <functional>
 #include <map>
 #include <optional>
+#include <set>
 #include <vector>
 
 namespace lotro {
@@ -129,22 +131,64 @@ public:
      * Get last error message
      */
     QString lastError() const { return m_lastError; }
+    
+    /**
+     * One message on the wire, payload still encrypted
+     */
+    struct Frame {
+        quint32 sequence = 0;
+        QByteArray payload;
+    };
+    
+    enum class FrameStatus {
+        Complete,
+        Incomplete,     // More data needed
+        Malformed       // Length over MAX_FRAME_SIZE
+    };
+    
+    // Wire format and envelope; static so they can be exercised without a server
+    static QByteArray encodeFrame(quint32 sequence, const QByteArray& payload);
+    
+    /**
+     * Read the frame starting at pos, advancing pos past it when complete
+     */
+    static FrameStatus decodeFrame(const QByteArray& buffer, qsizetype& pos, Frame& frame);
+    
+    static QByteArray encryptRequest(const QByteArray& plaintext);
+    static QByteArray decryptResponse(const QByteArray& ciphertext);
+    static bool parseVersionCheckResponse(const QByteArray& response, PatchCheckResult& result);
 
 signals:
     void progressChanged(const PatchServerProgress& progress);
     void patchingComplete(bool success);
 
 private:
+    using ResponseHandler = std::function<void(bool ok, const QByteArray& response)>;
+    
     // Network communication
     bool connectToServer();
     void disconnectFromServer();
+    
+    /**
+     * Queue a request and return at once; the handler runs with the
+     * decrypted response, or ok == false on timeout or disconnect
+     * @return Sequence number the response is matched by
+     */
+    quint32 postRequest(const QByteArray& request, ResponseHandler handler);
+    
+    /**
+     * Send requests pipelined and wait for all of their responses;
+     * failed ones come back empty
+     */
+    std::vector<QByteArray> sendRequests(const std::vector<QByteArray>& requests);
     QByteArray sendRequest(const QByteArray& request);
     
+    void sendQueued();
+    void onReadyRead();
+    void failPending(const QString& error);
+    
     // Protocol implementation
-    QByteArray encryptRequest(const QByteArray& plaintext);
-    QByteArray decryptResponse(const QByteArray& ciphertext);
     QByteArray buildVersionCheckRequest();
-    bool parseVersionCheckResponse(const QByteArray& response, PatchCheckResult& result);
 
     std::filesystem::path m_gameDirectory;
     QString m_patchServer = "patch.lotro.com";
@@ -153,6 +197,19 @@ private:
     QSslSocket* m_socket = nullptr;
     QString m_lastError;
     
+    // Frames are [length][sequence][payload], big-endian u32s, with the
+    // payload passed through encryptRequest()/decryptResponse()
+    static constexpr int FRAME_HEADER_SIZE = 8;
+    static constexpr quint32 MAX_FRAME_SIZE = 64 * 1024 * 1024;
+    static constexpr int MAX_IN_FLIGHT = 8;
+    static constexpr int REQUEST_TIMEOUT_MS = 30000;
+    
+    std::map<quint32, ResponseHandler> m_pending;   // Sent or queued, by sequence
+    std::deque<std::pair<quint32, QByteArray>> m_outbox;
+    QByteArray m_readBuffer;
+    quint32 m_nextSequence = 1;
+    std::set<quint32> m_inFlight;                   // Written, awaiting a response
+    
     // Cached version info
     std::map<QString, DatVersionInfo> m_datVersions;
 };
@@ -0,0 +1,204 @@
+/**
+ * LOTRO Launcher - Patch Telemetry Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "PatchTelemetry.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace lotro {
+
+PatchTelemetry::PatchTelemetry(const QString& kind)
+    : m_kind(kind)
+    , m_started(QDateTime::currentDateTimeUtc())
+{
+    m_clock.start();
+    m_samples.push_back({});
+}
+
+void PatchTelemetry::setTotals(qint64 downloadBytes, qint64 verifyBytes) {
+    m_downloadTotal = downloadBytes;
+    m_verifyTotal = verifyBytes;
+}
+
+void PatchTelemetry::sample(qint64 downloadedBytes, qint64 verifiedBytes, qint64 verifyQueuedBytes) {
+    const qint64 now = m_clock.elapsed();
+    const Sample& last = m_samples.back();
+    const qint64 step = now - last.ms;
+    if (step <= 0) {
+        m_downloaded = downloadedBytes;
+        m_verified = verifiedBytes;
+        return;
+    }
+    
+    // Attribute the time since the last sample before the window moves on
+    const double rate = downloadRate();
+    if (downloadedBytes > last.downloaded) {
+        m_downloadingMs += step;
+    }
+    if (verifyQueuedBytes - verifiedBytes > std::max(rate, 1.0)) {
+        m_hashBoundMs += step;          // More than a second's worth waiting
+    }
+    
+    m_downloaded = downloadedBytes;
+    m_verified = verifiedBytes;
+    m_samples.push_back({now, downloadedBytes, verifiedBytes});
+    while (m_samples.size() > 2 && m_samples[1].ms < now - WINDOW_MS) {
+        m_samples.pop_front();
+    }
+    m_peakDownloadRate = std::max(m_peakDownloadRate, downloadRate());
+}
+
+void PatchTelemetry::recordTransfer(const TransferStats& stats) {
+    HostStats& host = m_hosts[stats.host];
+    host.transfers++;
+    host.bytes += stats.bytes;
+    host.busyMs += stats.elapsedMs;
+    if (stats.firstByteMs >= 0) {
+        host.firstByteMs += stats.firstByteMs;
+        host.responses++;
+    }
+}
+
+double PatchTelemetry::rate(qint64 Sample::*field) const {
+    const Sample& first = m_samples.front();
+    const Sample& last = m_samples.back();
+    const qint64 span = last.ms - first.ms;
+    return span > 0 ? (last.*field - first.*field) * 1000.0 / span : 0.0;
+}
+
+double PatchTelemetry::downloadRate() const {
+    return rate(&Sample::downloaded);
+}
+
+double PatchTelemetry::verifyRate() const {
+    return rate(&Sample::verified);
+}
+
+qint64 PatchTelemetry::etaSeconds() const {
+    double seconds = 0.0;
+    const qint64 toDownload = m_downloadTotal - m_downloaded;
+    if (toDownload > 0) {
+        const double rate = downloadRate();
+        if (rate <= 0.0) {
+            return -1;
+        }
+        seconds = toDownload / rate;
+    }
+    const qint64 toVerify = m_verifyTotal - m_verified;
+    if (toVerify > 0) {
+        const double rate = verifyRate();
+        if (rate <= 0.0) {
+            return -1;
+        }
+        seconds = std::max(seconds, toVerify / rate);
+    }
+    return static_cast<qint64>(std::ceil(seconds));
+}
+
+QString PatchTelemetry::bottleneck() const {
+    if (m_downloadingMs == 0 && m_hashBoundMs == 0) {
+        return "none";
+    }
+    if (m_hashBoundMs * 2 > m_downloadingMs) {
+        return m_rotational ? "disk" : "hashing";
+    }
+    return "network";
+}
+
+QJsonObject PatchTelemetry::summary(bool success) const {
+    const qint64 elapsed = m_clock.elapsed();
+    const double seconds = std::max<qint64>(elapsed, 1) / 1000.0;
+    
+    QJsonObject hosts;
+    for (auto it = m_hosts.constBegin(); it != m_hosts.constEnd(); ++it) {
+        hosts.insert(it.key(), QJsonObject{
+            {"transfers", it->transfers},
+            {"bytes", it->bytes},
+            {"bytesPerSecond", std::round(it->bytesPerSecond())},
+            {"averageFirstByteMs", std::round(it->averageFirstByteMs())}
+        });
+    }
+    
+    return QJsonObject{
+        {"kind", m_kind},
+        {"started", m_started.toString(Qt::ISODate)},
+        {"success", success},
+        {"durationMs", elapsed},
+        {"bytesDownloaded", m_downloaded},
+        {"bytesVerified", m_verified},
+        {"downloadBytesPerSecond", std::round(m_downloaded / seconds)},
+        {"peakDownloadBytesPerSecond", std::round(m_peakDownloadRate)},
+        {"verifyBytesPerSecond", std::round(m_verified / seconds)},
+        {"downloadingMs", m_downloadingMs},
+        {"hashBoundMs", m_hashBoundMs},
+        {"bottleneck", bottleneck()},
+        {"hosts", hosts}
+    };
+}
+
+QString PatchTelemetry::historyPath() {
+    return QDir(QString::fromStdString(Platform::getDataPath().string())).filePath("patch-sessions.jsonl");
+}
+
+void PatchTelemetry::finish(bool success) {
+    const QJsonObject session = summary(success);
+    spdlog::info("Patch session: {} in {:.1f}s, {} bytes downloaded ({:.1f} MB/s), "
+                 "{} bytes verified ({:.1f} MB/s), limited by {}",
+                 m_kind.toStdString(), session.value("durationMs").toDouble() / 1000.0,
+                 m_downloaded, session.value("downloadBytesPerSecond").toDouble() / (1024 * 1024),
+                 m_verified, session.value("verifyBytesPerSecond").toDouble() / (1024 * 1024),
+                 bottleneck().toStdString());
+    for (auto it = m_hosts.constBegin(); it != m_hosts.constEnd(); ++it) {
+        spdlog::info("  {}: {} transfers, {:.1f} MB/s per connection, {:.0f} ms to first byte",
+                     it.key().toStdString(), it->transfers, it->bytesPerSecond() / (1024 * 1024),
+                     it->averageFirstByteMs());
+    }
+    
+    // One JSON object per line, newest last
+    const QString path = historyPath();
+    QList<QByteArray> lines;
+    QFile existing(path);
+    if (existing.open(QIODevice::ReadOnly)) {
+        for (const QByteArray& line : existing.readAll().split('\n')) {
+            if (!line.trimmed().isEmpty()) {
+                lines.append(line);
+            }
+        }
+        existing.close();
+    }
+    lines.append(QJsonDocument(session).toJson(QJsonDocument::Compact));
+    while (lines.size() > MAX_SESSIONS) {
+        lines.removeFirst();
+    }
+    
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write patch session history {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return;
+    }
+    for (const QByteArray& line : lines) {
+        file.write(line);
+        file.write("\n");
+    }
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit patch session history {}", path.toStdString());
+    }
+}
+
+} // namespace lotro
@@ -0,0 +1,118 @@
+/**
+ * LOTRO Launcher - Patch Telemetry
+ * 
+ * Throughput, per-host statistics and ETA for a patch run.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "DownloadScheduler.hpp"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+#include <deque>
+
+namespace lotro {
+
+/**
+ * Transfers to one host over a run
+ */
+struct HostStats {
+    int transfers = 0;
+    qint64 bytes = 0;
+    qint64 busyMs = 0;                  // Summed over transfers, so parallel ones add up
+    qint64 firstByteMs = 0;             // Summed over transfers that got a response
+    int responses = 0;
+    
+    double bytesPerSecond() const { return busyMs > 0 ? bytes * 1000.0 / busyMs : 0.0; }
+    double averageFirstByteMs() const { return responses > 0 ? static_cast<double>(firstByteMs) / responses : -1.0; }
+};
+
+/**
+ * Measures a patch run as it goes
+ * 
+ * The caller samples the running totals of bytes downloaded and hashed,
+ * along with how many bytes are known to need hashing; rates come from
+ * the last WINDOW_MS of samples. Downloads and hashing overlap, so the
+ * ETA is whichever of the two is further from done.
+ * 
+ * Time spent with hashing more than a second behind the data counts
+ * against hashing (or the disk, when it is rotational); the rest of the
+ * time spent downloading counts against the network. finish() appends a
+ * summary to a small history file so runs can be compared.
+ */
+class PatchTelemetry {
+public:
+    explicit PatchTelemetry(const QString& kind);
+    
+    /**
+     * Bytes to download and to hash over the whole run, as known so far
+     */
+    void setTotals(qint64 downloadBytes, qint64 verifyBytes);
+    
+    /**
+     * The hashing threads read from rotational storage
+     */
+    void setRotational(bool rotational) { m_rotational = rotational; }
+    
+    void sample(qint64 downloadedBytes, qint64 verifiedBytes, qint64 verifyQueuedBytes);
+    void recordTransfer(const TransferStats& stats);
+    
+    double downloadRate() const;
+    double verifyRate() const;
+    
+    /**
+     * Seconds until done at current rates, -1 if there is nothing to go by
+     */
+    qint64 etaSeconds() const;
+    
+    /**
+     * "network", "hashing", "disk" or "none", whichever held the run back
+     */
+    QString bottleneck() const;
+    
+    const QHash<QString, HostStats>& hosts() const { return m_hosts; }
+    
+    QJsonObject summary(bool success) const;
+    
+    /**
+     * Log the summary and add it to the session history
+     */
+    void finish(bool success);
+    
+    static QString historyPath();
+    
+    static constexpr qint64 WINDOW_MS = 5000;
+    static constexpr int MAX_SESSIONS = 50;
+
+private:
+    struct Sample {
+        qint64 ms = 0;
+        qint64 downloaded = 0;
+        qint64 verified = 0;
+    };
+    
+    double rate(qint64 Sample::*field) const;
+    
+    QString m_kind;
+    QDateTime m_started;
+    QElapsedTimer m_clock;
+    std::deque<Sample> m_samples;
+    QHash<QString, HostStats> m_hosts;
+    qint64 m_downloadTotal = 0;
+    qint64 m_verifyTotal = 0;
+    qint64 m_downloaded = 0;
+    qint64 m_verified = 0;
+    double m_peakDownloadRate = 0.0;
+    qint64 m_downloadingMs = 0;         // Sampled time with data arriving
+    qint64 m_hashBoundMs = 0;           // Sampled time with hashing behind
+    bool m_rotational = false;
+};
+
+} // namespace lotro
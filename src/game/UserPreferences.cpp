@@ -6,8 +6,11 @@
 
 #include "UserPreferences.hpp"
 
-#include <fstream>
-#include <sstream>
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cctype>
 
 #include <spdlog/spdlog.h>
 
@@ -25,59 +28,133 @@ bool UserPreferences::load() {
         return false;
     }
     
-    std::ifstream file(m_path);
-    if (!file.is_open()) {
+    QFile file(QString::fromStdString(m_path.string()));
+    if (!file.open(QIODevice::ReadOnly)) {
         spdlog::error("Failed to open UserPreferences: {}", m_path.string());
         return false;
     }
     
-    m_data.clear();
-    QString currentSection;
-    std::string line;
+    m_content = file.readAll();
+    m_newline = m_content.contains("\r\n") || !m_content.contains('\n') ? "\r\n" : "\n";
+    m_firstChange = -1;
+    m_changeEnd = 0;
+    m_resized = false;
+    index();
+    
+    spdlog::debug("Loaded UserPreferences with {} sections", m_sections.size());
+    return true;
+}
+
+void UserPreferences::index() {
+    m_sections.clear();
+    Section* current = nullptr;
     
-    while (std::getline(file, line)) {
-        // Trim whitespace
-        QString qline = QString::fromStdString(line).trimmed();
+    qsizetype lineStart = 0;
+    while (lineStart < m_content.size()) {
+        qsizetype next = m_content.indexOf('\n', lineStart);
+        next = next < 0 ? m_content.size() : next + 1;
         
-        if (qline.isEmpty() || qline.startsWith(';') || qline.startsWith('#')) {
-            continue; // Skip comments and empty lines
+        // Trim whitespace and the line end
+        qsizetype start = lineStart;
+        qsizetype end = next;
+        while (start < end && std::isspace(static_cast<unsigned char>(m_content[start]))) {
+            ++start;
+        }
+        while (end > start && std::isspace(static_cast<unsigned char>(m_content[end - 1]))) {
+            --end;
         }
         
-        if (qline.startsWith('[') && qline.endsWith(']')) {
+        if (start == end || m_content[start] == ';' || m_content[start] == '#') {
+            // Skip comments and empty lines
+        } else if (m_content[start] == '[' && m_content[end - 1] == ']') {
             // Section header
-            currentSection = qline.mid(1, qline.length() - 2);
-        } else if (!currentSection.isEmpty()) {
+            const QString name = QString::fromUtf8(m_content.mid(start + 1, end - start - 2));
+            current = &m_sections[name];
+            current->end = next;
+        } else if (current) {
             // Key=Value pair
-            int eqPos = qline.indexOf('=');
-            if (eqPos > 0) {
-                QString key = qline.left(eqPos).trimmed();
-                QString value = qline.mid(eqPos + 1).trimmed();
-                m_data[currentSection][key] = value;
+            const qsizetype eqPos = m_content.indexOf('=', start);
+            if (eqPos > start && eqPos < end) {
+                const QString key = QString::fromUtf8(m_content.mid(start, eqPos - start)).trimmed();
+                qsizetype valueStart = eqPos + 1;
+                while (valueStart < end && std::isspace(static_cast<unsigned char>(m_content[valueStart]))) {
+                    ++valueStart;
+                }
+                current->keys[key] = {lineStart, valueStart, end};
+                current->end = next;
             }
         }
+        lineStart = next;
     }
+}
+
+void UserPreferences::patch(qsizetype start, qsizetype end, const QByteArray& bytes) {
+    m_content.replace(start, end - start, bytes);
+    m_firstChange = m_firstChange < 0 ? start : std::min(m_firstChange, start);
+    m_changeEnd = std::max(m_changeEnd, start + bytes.size());
     
-    spdlog::debug("Loaded UserPreferences with {} sections", m_data.size());
-    return true;
+    const qsizetype delta = bytes.size() - (end - start);
+    if (delta == 0) {
+        return;
+    }
+    m_resized = true;
+    // Offsets at an insertion point stay; callers adjust what they insert into
+    auto shift = [&](qsizetype& offset) {
+        if (offset >= end && offset > start) {
+            offset += delta;
+        }
+    };
+    for (auto& [name, section] : m_sections) {
+        shift(section.end);
+        for (auto& [key, entry] : section.keys) {
+            shift(entry.lineStart);
+            shift(entry.valueStart);
+            shift(entry.valueEnd);
+        }
+    }
 }
 
 bool UserPreferences::save() {
-    return saveAs(m_path);
+    if (m_firstChange < 0) {
+        spdlog::debug("UserPreferences unchanged, not writing: {}", m_path.string());
+        return true;
+    }
+    
+    QFile file(QString::fromStdString(m_path.string()));
+    if (!file.open(QIODevice::ReadWrite)) {
+        spdlog::error("Failed to open file for writing: {}", m_path.string());
+        return false;
+    }
+    
+    // Everything before the first edit is already on disk, and so is
+    // everything after the last one unless lines moved
+    const qsizetype start = std::min(m_firstChange, m_content.size());
+    const qsizetype end = m_resized ? m_content.size() : std::min(m_changeEnd, m_content.size());
+    if (!file.seek(start) ||
+        file.write(m_content.constData() + start, end - start) != end - start ||
+        (m_resized && !file.resize(m_content.size()))) {
+        spdlog::error("Failed to write UserPreferences: {}", file.errorString().toStdString());
+        return false;
+    }
+    
+    spdlog::debug("Saved UserPreferences to: {} ({} bytes at offset {})",
+                  m_path.string(), end - start, start);
+    m_firstChange = -1;
+    m_changeEnd = 0;
+    m_resized = false;
+    return true;
 }
 
 bool UserPreferences::saveAs(const std::filesystem::path& path) {
-    std::ofstream file(path);
-    if (!file.is_open()) {
+    QSaveFile file(QString::fromStdString(path.string()));
+    if (!file.open(QIODevice::WriteOnly)) {
         spdlog::error("Failed to open file for writing: {}", path.string());
         return false;
     }
-    
-    for (const auto& [section, keys] : m_data) {
-        file << "[" << section.toStdString() << "]\n";
-        for (const auto& [key, value] : keys) {
-            file << key.toStdString() << "=" << value.toStdString() << "\n";
-        }
-        file << "\n";
+    file.write(m_content);
+    if (!file.commit()) {
+        spdlog::error("Failed to write UserPreferences: {}", file.errorString().toStdString());
+        return false;
     }
     
     spdlog::debug("Saved UserPreferences to: {}", path.string());
@@ -88,17 +165,18 @@ std::optional<QString> UserPreferences::get(
     const QString& section,
     const QString& key
 ) const {
-    auto secIt = m_data.find(section);
-    if (secIt == m_data.end()) {
+    auto secIt = m_sections.find(section);
+    if (secIt == m_sections.end()) {
         return std::nullopt;
     }
     
-    auto keyIt = secIt->second.find(key);
-    if (keyIt == secIt->second.end()) {
+    auto keyIt = secIt->second.keys.find(key);
+    if (keyIt == secIt->second.keys.end()) {
         return std::nullopt;
     }
     
-    return keyIt->second;
+    const Entry& entry = keyIt->second;
+    return QString::fromUtf8(m_content.mid(entry.valueStart, entry.valueEnd - entry.valueStart));
 }
 
 void UserPreferences::set(
@@ -106,14 +184,74 @@ void UserPreferences::set(
     const QString& key,
     const QString& value
 ) {
-    m_data[section][key] = value;
+    const QByteArray bytes = value.toUtf8();
+    
+    auto secIt = m_sections.find(section);
+    if (secIt == m_sections.end()) {
+        // New section at the end, after a blank line
+        QByteArray block;
+        if (!m_content.isEmpty()) {
+            if (!m_content.endsWith('\n')) {
+                block += m_newline;
+            }
+            block += m_newline;
+        }
+        block += "[" + section.toUtf8() + "]" + m_newline;
+        const qsizetype lineStart = m_content.size() + block.size();
+        block += key.toUtf8() + "=";
+        const qsizetype valueStart = m_content.size() + block.size();
+        block += bytes + m_newline;
+        
+        patch(m_content.size(), m_content.size(), block);
+        Section& added = m_sections[section];
+        added.keys[key] = {lineStart, valueStart, valueStart + bytes.size()};
+        added.end = m_content.size();
+        return;
+    }
+    
+    Section& sec = secIt->second;
+    auto keyIt = sec.keys.find(key);
+    if (keyIt != sec.keys.end()) {
+        Entry& entry = keyIt->second;
+        if (m_content.mid(entry.valueStart, entry.valueEnd - entry.valueStart) == bytes) {
+            return;
+        }
+        patch(entry.valueStart, entry.valueEnd, bytes);
+        entry.valueEnd = entry.valueStart + bytes.size();
+        return;
+    }
+    
+    // New key after the section's last one
+    QByteArray line;
+    qsizetype at = sec.end;
+    if (at == m_content.size() && !m_content.isEmpty() && !m_content.endsWith('\n')) {
+        line += m_newline;
+    }
+    const qsizetype lineStart = at + line.size();
+    line += key.toUtf8() + "=";
+    const qsizetype valueStart = at + line.size();
+    line += bytes + m_newline;
+    
+    patch(at, at, line);
+    sec.keys[key] = {lineStart, valueStart, valueStart + bytes.size()};
+    sec.end = at + line.size();
 }
 
 void UserPreferences::remove(const QString& section, const QString& key) {
-    auto secIt = m_data.find(section);
-    if (secIt != m_data.end()) {
-        secIt->second.erase(key);
+    auto secIt = m_sections.find(section);
+    if (secIt == m_sections.end()) {
+        return;
     }
+    auto keyIt = secIt->second.keys.find(key);
+    if (keyIt == secIt->second.keys.end()) {
+        return;
+    }
+    
+    const qsizetype lineStart = keyIt->second.lineStart;
+    qsizetype lineEnd = m_content.indexOf('\n', keyIt->second.valueEnd);
+    lineEnd = lineEnd < 0 ? m_content.size() : lineEnd + 1;
+    secIt->second.keys.erase(keyIt);
+    patch(lineStart, lineEnd, {});
 }
 
 void UserPreferences::setAdapter(int adapterIndex) {
@@ -14,6 +14,7 @@
 #include <optional>
 #include <string>
 
+#include <QByteArray>
 #include <QString>
 
 namespace lotro {
@@ -23,6 +24,12 @@ namespace lotro {
  * 
  * Reads and modifies the game's UserPreferences.ini file which controls
  * graphics settings, audio, and other client options.
+ * 
+ * The file is kept as it was read, with the byte offsets of every key's
+ * value. Edits patch those bytes, so comments, order and line endings
+ * survive. Setting a value it already has is not an edit. save() writes
+ * nothing when there are no edits, and otherwise only the edited span,
+ * since the game writes this file too.
  */
 class UserPreferences {
 public:
@@ -67,10 +74,15 @@ public:
     void remove(const QString& section, const QString& key);
     
     /**
-     * Save preferences back to file
+     * Write the edits back to the file
      */
     bool save();
     
+    /**
+     * Whether there are edits save() hasn't written yet
+     */
+    bool isModified() const { return m_firstChange >= 0; }
+    
     /**
      * Save preferences to a different file
      */
@@ -116,13 +128,37 @@ public:
     void setLastWorld(const QString& world);
     
 private:
+    /**
+     * Where a key's line and value are in m_content
+     */
+    struct Entry {
+        qsizetype lineStart = 0;
+        qsizetype valueStart = 0;
+        qsizetype valueEnd = 0;         // Trailing spaces and line end excluded
+    };
+    
+    struct Section {
+        qsizetype end = 0;              // Just past the section's last key, or its header
+        std::map<QString, Entry> keys;
+    };
+    
     bool load();
+    void index();
+    
+    /**
+     * Replace m_content[start, end) and move the offsets that follow
+     */
+    void patch(qsizetype start, qsizetype end, const QByteArray& bytes);
     
     std::filesystem::path m_path;
     bool m_valid = false;
     
-    // Section -> (Key -> Value)
-    std::map<QString, std::map<QString, QString>> m_data;
+    QByteArray m_content;
+    QByteArray m_newline = "\r\n";
+    std::map<QString, Section> m_sections;
+    qsizetype m_firstChange = -1;       // Earliest edited offset, -1 when unchanged
+    qsizetype m_changeEnd = 0;          // Just past the last edited byte
+    bool m_resized = false;             // An edit moved the bytes after it
 };
 
 /**
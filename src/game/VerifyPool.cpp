@@ -0,0 +1,32 @@
+/**
+ * LOTRO Launcher - Verify Pool Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "VerifyPool.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QThread>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro {
+
+VerifyPool::VerifyPool(const std::filesystem::path& directory) {
+    m_rotational = Platform::isRotationalStorage(directory).value_or(false);
+    const int cores = std::max(1, QThread::idealThreadCount());
+    m_pool.setMaxThreadCount(m_rotational ? std::min(cores, ROTATIONAL_THREADS) : cores);
+    m_clock.start();
+    spdlog::info("Verifying with {} threads ({} storage)", m_pool.maxThreadCount(),
+                 m_rotational ? "rotational" : "solid-state");
+}
+
+double VerifyPool::bytesPerSecond() const {
+    const qint64 elapsed = m_clock.elapsed();
+    return elapsed > 0 ? verifiedBytes() * 1000.0 / elapsed : 0.0;
+}
+
+} // namespace lotro
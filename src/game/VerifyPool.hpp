@@ -0,0 +1,55 @@
+/**
+ * LOTRO Launcher - Verify Pool
+ * 
+ * Worker threads for hashing game files, sized to the disk they are on.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+#include <atomic>
+#include <filesystem>
+
+namespace lotro {
+
+/**
+ * Threads that hash file data
+ * 
+ * On solid-state storage hashing is CPU-bound, so there is one thread per
+ * core; on a spinning disk parallel readers only add seeks, so just two.
+ * Every hashed byte is counted, which gives the verification throughput.
+ */
+class VerifyPool {
+public:
+    explicit VerifyPool(const std::filesystem::path& directory);
+    
+    QThreadPool* pool() { return &m_pool; }
+    int threadCount() const { return m_pool.maxThreadCount(); }
+    bool rotational() const { return m_rotational; }
+    
+    /**
+     * Count hashed bytes; safe from any thread
+     */
+    void addVerified(qint64 bytes) { m_verified.fetch_add(bytes, std::memory_order_relaxed); }
+    
+    qint64 verifiedBytes() const { return m_verified.load(std::memory_order_relaxed); }
+    
+    /**
+     * Hashed bytes per second since the pool was created
+     */
+    double bytesPerSecond() const;
+    
+    static constexpr int ROTATIONAL_THREADS = 2;
+
+private:
+    QThreadPool m_pool;
+    std::atomic<qint64> m_verified{0};
+    QElapsedTimer m_clock;
+    bool m_rotational = false;
+};
+
+} // namespace lotro
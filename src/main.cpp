@@ -9,22 +9,40 @@
 #include <QCommandLineParser>
 #include <QFile>
 #include <QIcon>
+#include <QTimer>
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 
+#include "companion/CompanionDataLoader.hpp"
+#include "companion/CompanionService.hpp"
+#include "core/AllocationProfiler.hpp"
+#include "core/Metrics.hpp"
+#include "core/RepeatFilterSink.hpp"
+#include "core/StallWatchdog.hpp"
+#include "core/StartupProfiler.hpp"
+#include "core/TaskScheduler.hpp"
 #include "core/config/ConfigManager.hpp"
 #include "core/platform/Platform.hpp"
+#include "dat/DatExtractor.hpp"
+#include "dat/DatVerifier.hpp"
 #include "ui/MainWindow.hpp"
 #include "ui/SetupWizard.hpp"
 
+#include <cstdio>
+#include <cstring>
+
 #ifdef PLATFORM_LINUX
+#include "companion/ProcessMemory.hpp"
 #include "wine/WineManager.hpp"
 #include "steam/SteamIntegration.hpp"
 #endif
 
 namespace {
 
+constexpr size_t LOG_QUEUE_SIZE = 8192;
+
 void setupLogging() {
     auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
     console_sink->set_level(spdlog::level::info);
@@ -39,38 +57,122 @@ void setupLogging() {
         logPath.string(), 1024 * 1024 * 5, 3);
     file_sink->set_level(spdlog::level::debug);
     
-    auto logger = std::make_shared<spdlog::logger>(
-        "lotro", spdlog::sinks_init_list{console_sink, file_sink});
+    // The same warning from every sync tick or every file in a patch is
+    // written once per window, with a count when it next gets through
+    auto filter_sink = std::make_shared<lotro::RepeatFilterSink>(std::chrono::seconds(10));
+    filter_sink->add_sink(console_sink);
+    filter_sink->add_sink(file_sink);
+    
+    // Callers only format the message and queue it; the sinks run on one
+    // background thread. When the queue is full the oldest messages are
+    // dropped rather than blocking the sync worker or the patcher.
+    spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
+    auto logger = std::make_shared<spdlog::async_logger>(
+        "lotro", filter_sink, spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
     logger->set_level(spdlog::level::debug);
+    logger->flush_on(spdlog::level::warn);
     
     spdlog::set_default_logger(logger);
+    spdlog::flush_every(std::chrono::seconds(2));
     spdlog::info("LOTRO Launcher starting up...");
 }
 
+// No widgets: the companion's data and live sync behind a local socket
+int runHeadless(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("LOTRO Launcher");
+    app.setApplicationVersion("0.1.0");
+    app.setOrganizationName("lotro-launcher");
+    
+    setupLogging();
+    
+    QCommandLineParser parser;
+    parser.setApplicationDescription("LOTRO companion service");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    
+    QCommandLineOption headlessOption(QStringList() << "headless", "Run the companion service without a window");
+    parser.addOption(headlessOption);
+    QCommandLineOption configDirOption(QStringList() << "c" << "config-directory",
+                                       "Configuration directory path", "path");
+    parser.addOption(configDirOption);
+    QCommandLineOption gameOption(QStringList() << "g" << "game",
+                                  "Game to sync (lotro, lotro-preview)", "game", "lotro");
+    parser.addOption(gameOption);
+    QCommandLineOption socketOption(QStringList() << "socket", "Local socket name to serve queries on",
+                                    "name", lotro::CompanionService::DEFAULT_SOCKET_NAME);
+    parser.addOption(socketOption);
+    parser.process(app);
+    
+    std::filesystem::path configPath = parser.isSet(configDirOption)
+        ? std::filesystem::path(parser.value(configDirOption).toStdString())
+        : lotro::Platform::getConfigPath();
+    auto& configManager = lotro::ConfigManager::instance();
+    if (!configManager.initialize(configPath)) {
+        spdlog::error("Failed to initialize configuration");
+        return 1;
+    }
+    
+    QString gamePath;
+    if (auto gameConfig = configManager.getGameConfig(parser.value(gameOption).toStdString())) {
+        gamePath = QString::fromStdString(gameConfig->gameDirectory.string());
+    }
+    
+    lotro::metrics::Registry::instance().startPeriodicDump();
+    
+    lotro::CompanionService service;
+    if (!service.start(gamePath, parser.value(socketOption))) {
+        return 1;
+    }
+    
+    const int exitCode = app.exec();
+    spdlog::shutdown();
+    return exitCode;
+}
+
 } // anonymous namespace
 
 int main(int argc, char* argv[]) {
+    auto& profiler = lotro::StartupProfiler::instance();
+    profiler.start();
+    
+    // Decided before QApplication, which needs a display
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            return runHeadless(argc, argv);
+        }
+    }
+    
+    auto qtSpan = profiler.span("Qt");
+    lotro::allocation::setThreadTag(lotro::allocation::Tag::Ui);
     QApplication app(argc, argv);
     app.setApplicationName("LOTRO Launcher");
     app.setApplicationVersion("0.1.0");
     app.setOrganizationName("lotro-launcher");
+    qtSpan.end();
     
     // Setup logging
-    setupLogging();
+    {
+        auto span = profiler.span("Logging");
+        setupLogging();
+    }
     
     // Load and apply dark theme
-    QFile styleFile(":/dark_theme.qss");
-    if (styleFile.open(QFile::ReadOnly | QFile::Text)) {
-        QString styleSheet = QString::fromUtf8(styleFile.readAll());
-        app.setStyleSheet(styleSheet);
-        spdlog::info("Dark theme loaded successfully");
-    } else {
-        spdlog::warn("Failed to load dark theme stylesheet");
+    {
+        auto span = profiler.span("Theme");
+        QFile styleFile(":/dark_theme.qss");
+        if (styleFile.open(QFile::ReadOnly | QFile::Text)) {
+            QString styleSheet = QString::fromUtf8(styleFile.readAll());
+            app.setStyleSheet(styleSheet);
+            spdlog::info("Dark theme loaded successfully");
+        } else {
+            spdlog::warn("Failed to load dark theme stylesheet");
+        }
+        
+        // Set application icon
+        app.setWindowIcon(QIcon(":/icon.png"));
     }
     
-    // Set application icon
-    app.setWindowIcon(QIcon(":/icon.png"));
-    
     // Parse command line arguments
     QCommandLineParser parser;
     parser.setApplicationDescription("Cross-platform LOTRO Launcher");
@@ -92,8 +194,101 @@ int main(int argc, char* argv[]) {
     );
     parser.addOption(gameOption);
     
+    QCommandLineOption verifyDatOption(
+        QStringList() << "verify-dat",
+        "Verify the DAT files of a game installation and exit",
+        "game-directory"
+    );
+    parser.addOption(verifyDatOption);
+    
+    QCommandLineOption extractDatOption(
+        QStringList() << "dat-extract",
+        "Extract entries from the DAT files of a game installation and exit",
+        "game-directory"
+    );
+    parser.addOption(extractDatOption);
+    
+    QCommandLineOption selectOption(
+        QStringList() << "select",
+        "Entries for --dat-extract: data ID types (0x79), IDs or ranges (0x79000000-0x7900FFFF); repeatable",
+        "spec"
+    );
+    parser.addOption(selectOption);
+    
+    QCommandLineOption outputOption(
+        QStringList() << "output",
+        "Output of --dat-extract: a directory, or a file ending in .tar",
+        "path"
+    );
+    parser.addOption(outputOption);
+    
+    QCommandLineOption ioUringOption(
+        QStringList() << "io-uring",
+        "Read DAT files through io_uring for --verify-dat and --dat-extract (Linux builds with ENABLE_IO_URING)"
+    );
+    parser.addOption(ioUringOption);
+    
+    QCommandLineOption profileStartupOption(
+        QStringList() << "profile-startup",
+        "Print how long each startup stage took, up to the main window's first paint"
+    );
+    parser.addOption(profileStartupOption);
+    
+    // Handled before the GUI starts; listed here for --help
+    QCommandLineOption headlessOption(
+        QStringList() << "headless",
+        "Run the companion service without a window (see --headless --help)"
+    );
+    parser.addOption(headlessOption);
+    
     parser.process(app);
     
+    if (parser.isSet(verifyDatOption)) {
+        lotro::dat::DatVerifier verifier(parser.value(verifyDatOption));
+        verifier.setIoUring(parser.isSet(ioUringOption));
+        int lastPercent = -1;
+        auto report = verifier.run([&lastPercent](const lotro::dat::DatVerifyProgress& progress) {
+            if (progress.percentage() / 10 != lastPercent / 10) {
+                lastPercent = progress.percentage();
+                spdlog::info("Verifying {} ({}/{}): {}%", progress.archiveName.toStdString(),
+                             progress.currentArchive, progress.totalArchives, lastPercent);
+            }
+        });
+        for (const auto& issue : report.issues) {
+            spdlog::error("{}: entry 0x{:08X}: {}", issue.archiveName.toStdString(),
+                          issue.fileId, issue.reason.toStdString());
+        }
+        return report.isClean() ? 0 : 1;
+    }
+    
+    if (parser.isSet(extractDatOption)) {
+        QString badTerm;
+        auto selection = lotro::dat::DatExtractSelection::parse(parser.values(selectOption), &badTerm);
+        if (!selection) {
+            spdlog::error("Invalid --select term: {}", badTerm.toStdString());
+            return 1;
+        }
+        if (!parser.isSet(outputOption)) {
+            spdlog::error("--dat-extract needs --output");
+            return 1;
+        }
+        
+        lotro::dat::DatExtractOptions options;
+        options.outputPath = parser.value(outputOption);
+        options.ioUring = parser.isSet(ioUringOption);
+        lotro::dat::DatExtractor extractor(parser.value(extractDatOption));
+        int lastPercent = -1;
+        auto report = extractor.run(*selection, options, [&lastPercent](const lotro::dat::DatExtractProgress& progress) {
+            int percent = progress.totalEntries > 0
+                ? static_cast<int>(progress.entriesDone * 100 / progress.totalEntries) : 100;
+            if (percent / 10 != lastPercent / 10) {
+                lastPercent = percent;
+                spdlog::info("Extracting: {}/{} entries ({}%)", progress.entriesDone, progress.totalEntries, percent);
+            }
+        });
+        return report.isComplete() ? 0 : 1;
+    }
+    
     // Initialize configuration
     std::filesystem::path configPath;
     if (parser.isSet(configDirOption)) {
@@ -103,16 +298,19 @@ int main(int argc, char* argv[]) {
     }
     
     auto& configManager = lotro::ConfigManager::instance();
+    auto configSpan = profiler.span("Configuration");
     if (!configManager.initialize(configPath)) {
         spdlog::error("Failed to initialize configuration");
         return 1;
     }
+    configSpan.end();
     
     spdlog::info("Configuration loaded from: {}", configPath.string());
     
     // Check if first run - show setup wizard
     if (configManager.isFirstRun()) {
         spdlog::info("First run detected, showing setup wizard");
+        auto span = profiler.span("Setup wizard");
         lotro::SetupWizard wizard;
         if (wizard.exec() != QDialog::Accepted) {
             spdlog::info("Setup cancelled by user");
@@ -122,30 +320,83 @@ int main(int argc, char* argv[]) {
     
 #ifdef PLATFORM_LINUX
     // Initialize Wine on Linux
+    auto wineSpan = profiler.span("Wine");
     auto& wineManager = lotro::WineManager::instance();
+    if (auto wineConfig = configManager.getWineConfig("lotro")) {
+        wineManager.setConfig(*wineConfig);
+    }
     if (!wineManager.isSetup()) {
         spdlog::info("Wine environment needs setup");
         // This will be handled by the main window or wizard
     }
     
-    // Initialize Steam integration to show as "Playing" in Steam
-    if (configManager.programConfig().steamIntegrationEnabled) {
-        auto& steamIntegration = lotro::SteamIntegration::instance();
-        if (steamIntegration.initialize()) {
-            spdlog::info("Steam integration active - showing as Playing in Steam");
-        } else {
-            spdlog::debug("Steam integration not available or Steam not running");
-        }
-    } else {
-        spdlog::debug("Steam integration disabled in settings");
-    }
+    wineSpan.end();
 #endif
     
     // Show main window
+    auto windowSpan = profiler.span("Main window");
     lotro::MainWindow mainWindow;
     mainWindow.show();
+    windowSpan.end();
     
     spdlog::info("Main window displayed");
     
-    return app.exec();
+    // Nothing below is needed to show the window, so it waits for the
+    // first paint and then for the event loop to go idle
+    const bool printProfile = parser.isSet(profileStartupOption);
+    profiler.finishOnPaint(&mainWindow, [&]() {
+        if (printProfile) {
+            std::fprintf(stdout, "%s\n", qPrintable(profiler.report()));
+            std::fflush(stdout);
+        }
+        QTimer::singleShot(0, &mainWindow, [&]() {
+            lotro::metrics::Registry::instance().startPeriodicDump();
+            
+            if (configManager.programConfig().stallWatchdog) {
+                lotro::StallWatchdog::instance().start(configManager.programConfig().stallThresholdMs);
+            }
+            
+            // Most sessions never open the companion, so this waits behind other work
+            if (configManager.programConfig().preloadCompanionData) {
+                lotro::CompanionDataLoader::instance().start(lotro::TaskPriority::Low);
+            }
+            
+#ifdef PLATFORM_LINUX
+            // Have the prefix's server up before the first launch needs it
+            if (configManager.programConfig().wineserverWarmStart) {
+                wineManager.startWarmServer();
+            }
+            
+            // Initialize Steam integration to show as "Playing" in Steam; the
+            // library probe and SteamAPI_Init stay off the GUI thread
+            if (configManager.programConfig().steamIntegrationEnabled) {
+                lotro::TaskScheduler::instance().run(lotro::TaskPool::Io, []() {
+                    if (lotro::SteamIntegration::instance().initialize()) {
+                        spdlog::info("Steam integration active - showing as Playing in Steam");
+                    } else {
+                        spdlog::debug("Steam integration not available or Steam not running");
+                    }
+                }, lotro::TaskPriority::Low);
+            } else {
+                spdlog::debug("Steam integration disabled in settings");
+            }
+#endif
+        });
+    });
+    
+    const int exitCode = app.exec();
+    lotro::StallWatchdog::instance().stop();
+    
+#ifdef PLATFORM_LINUX
+    // A game still running needs its server; the next start takes it over
+    if (lotro::ProcessMemory::findLotroClient()) {
+        spdlog::info("Game still running, leaving wineserver up");
+    } else {
+        wineManager.stopWarmServer();
+    }
+#endif
+    
+    // Drain the log queue before the thread pool goes away
+    spdlog::shutdown();
+    return exitCode;
 }
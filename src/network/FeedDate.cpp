@@ -0,0 +1,273 @@
+/**
+ * LOTRO Launcher - Feed Date Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "FeedDate.hpp"
+
+#include <QDateTime>
+#include <QStringList>
+
+#include <chrono>
+
+namespace lotro {
+
+namespace {
+
+/**
+ * Cursor over a date string
+ */
+class DateScanner {
+public:
+    explicit DateScanner(QStringView text) : m_text(text.trimmed()) {}
+    
+    bool atEnd() const { return m_pos >= m_text.size(); }
+    QChar peek() const { return atEnd() ? QChar() : m_text[m_pos]; }
+    
+    bool skip(QChar c) {
+        if (peek() == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+    
+    void skipSpaces() {
+        while (!atEnd() && m_text[m_pos].isSpace()) {
+            ++m_pos;
+        }
+    }
+    
+    // Between minDigits and maxDigits decimal digits
+    bool number(int minDigits, int maxDigits, int& value) {
+        value = 0;
+        int digits = 0;
+        while (digits < maxDigits && !atEnd() && m_text[m_pos].isDigit()) {
+            value = value * 10 + m_text[m_pos].digitValue();
+            ++m_pos;
+            ++digits;
+        }
+        return digits >= minDigits;
+    }
+    
+    QStringView word() {
+        const qsizetype start = m_pos;
+        while (!atEnd() && m_text[m_pos].isLetter()) {
+            ++m_pos;
+        }
+        return m_text.sliced(start, m_pos - start);
+    }
+    
+private:
+    QStringView m_text;
+    qsizetype m_pos = 0;
+};
+
+/**
+ * Seconds since the epoch of a date and time, the time taken as UTC
+ */
+std::optional<qint64> toEpoch(int year, int month, int day, int hour, int minute, int second) {
+    const std::chrono::year_month_day date{std::chrono::year(year),
+                                           std::chrono::month(unsigned(month)),
+                                           std::chrono::day(unsigned(day))};
+    if (!date.ok() || hour > 23 || minute > 59 || second > 60) {
+        return std::nullopt;
+    }
+    return std::chrono::sys_days(date).time_since_epoch().count() * 86400LL +
+           hour * 3600LL + minute * 60LL + second;
+}
+
+/**
+ * UTC offset in seconds of "Z", "+hh:mm", "+hhmm" or an RFC 822 zone name
+ */
+std::optional<int> parseZone(DateScanner& in) {
+    const QChar sign = in.peek();
+    if (sign == u'+' || sign == u'-') {
+        in.skip(sign);
+        int hours = 0, minutes = 0;
+        if (!in.number(2, 2, hours)) {
+            return std::nullopt;
+        }
+        in.skip(u':');
+        in.number(2, 2, minutes);
+        const int offset = hours * 3600 + minutes * 60;
+        return sign == u'-' ? -offset : offset;
+    }
+    
+    static const struct { const char16_t* name; int hours; } ZONES[] = {
+        {u"Z", 0}, {u"UT", 0}, {u"UTC", 0}, {u"GMT", 0},
+        {u"EST", -5}, {u"EDT", -4}, {u"CST", -6}, {u"CDT", -5},
+        {u"MST", -7}, {u"MDT", -6}, {u"PST", -8}, {u"PDT", -7},
+    };
+    const QStringView name = in.word();
+    for (const auto& zone : ZONES) {
+        if (name.compare(QStringView(zone.name), Qt::CaseInsensitive) == 0) {
+            return zone.hours * 3600;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * Epoch seconds of a time given without a zone, which means local time
+ */
+qint64 localToEpoch(int year, int month, int day, int hour, int minute, int second) {
+    return QDateTime(QDate(year, month, day), QTime(hour, minute, second)).toSecsSinceEpoch();
+}
+
+/**
+ * The QDateTime formats the feeds were parsed with before, for anything
+ * the fast paths don't take
+ */
+std::optional<qint64> parseDateSlow(const QString& dateStr) {
+    QDateTime dt = QDateTime::fromString(dateStr, Qt::RFC2822Date);
+    if (!dt.isValid()) {
+        dt = QDateTime::fromString(dateStr, Qt::ISODate);
+    }
+    
+    static const QStringList formats = {
+        "yyyy-MM-ddTHH:mm:ss",
+        "yyyy-MM-dd HH:mm:ss",
+        "ddd, dd MMM yyyy HH:mm:ss",
+        "dd MMM yyyy HH:mm:ss"
+    };
+    for (int i = 0; !dt.isValid() && i < formats.size(); ++i) {
+        dt = QDateTime::fromString(dateStr, formats[i]);
+    }
+    
+    if (!dt.isValid()) {
+        return std::nullopt;
+    }
+    return dt.toSecsSinceEpoch();
+}
+
+std::optional<qint64> parseDateAs(FeedDateFormat format, QStringView text) {
+    switch (format) {
+        case FeedDateFormat::Rfc822:
+            return parseRfc822Date(text);
+        case FeedDateFormat::Iso8601:
+            return parseIso8601Date(text);
+        default:
+            return std::nullopt;
+    }
+}
+
+} // anonymous namespace
+
+FeedDateFormat detectFeedDateFormat(QStringView text) {
+    if (text.size() >= 5 && text[0].isDigit() && text[1].isDigit() &&
+        text[2].isDigit() && text[3].isDigit() && text[4] == u'-') {
+        return FeedDateFormat::Iso8601;
+    }
+    if (!text.isEmpty() && (text[0].isLetter() || text[0].isDigit())) {
+        return FeedDateFormat::Rfc822;
+    }
+    return FeedDateFormat::Unknown;
+}
+
+std::optional<qint64> parseRfc822Date(QStringView text) {
+    static const char16_t* MONTHS[] = {
+        u"Jan", u"Feb", u"Mar", u"Apr", u"May", u"Jun",
+        u"Jul", u"Aug", u"Sep", u"Oct", u"Nov", u"Dec"
+    };
+    
+    DateScanner in(text);
+    if (in.peek().isLetter()) {
+        in.word();              // Day name, not checked
+        in.skip(u',');
+        in.skipSpaces();
+    }
+    
+    int day = 0, month = 0, year = 0, hour = 0, minute = 0, second = 0;
+    if (!in.number(1, 2, day)) {
+        return std::nullopt;
+    }
+    in.skipSpaces();
+    const QStringView monthName = in.word();
+    for (int i = 0; i < 12 && month == 0; ++i) {
+        if (monthName.left(3).compare(QStringView(MONTHS[i]), Qt::CaseInsensitive) == 0) {
+            month = i + 1;
+        }
+    }
+    in.skipSpaces();
+    if (month == 0 || !in.number(2, 4, year)) {
+        return std::nullopt;
+    }
+    if (year < 100) {
+        year += year < 50 ? 2000 : 1900;
+    }
+    in.skipSpaces();
+    if (!in.number(1, 2, hour) || !in.skip(u':') || !in.number(2, 2, minute)) {
+        return std::nullopt;
+    }
+    if (in.skip(u':') && !in.number(2, 2, second)) {
+        return std::nullopt;
+    }
+    
+    in.skipSpaces();
+    if (in.atEnd()) {
+        return localToEpoch(year, month, day, hour, minute, second);
+    }
+    const auto zone = parseZone(in);
+    const auto epoch = toEpoch(year, month, day, hour, minute, second);
+    if (!zone || !epoch) {
+        return std::nullopt;
+    }
+    return *epoch - *zone;
+}
+
+std::optional<qint64> parseIso8601Date(QStringView text) {
+    DateScanner in(text);
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (!in.number(4, 4, year) || !in.skip(u'-') || !in.number(2, 2, month) ||
+        !in.skip(u'-') || !in.number(2, 2, day)) {
+        return std::nullopt;
+    }
+    
+    if (in.skip(u'T') || in.skip(u't') || in.skip(u' ')) {
+        if (!in.number(2, 2, hour) || !in.skip(u':') || !in.number(2, 2, minute)) {
+            return std::nullopt;
+        }
+        if (in.skip(u':') && !in.number(2, 2, second)) {
+            return std::nullopt;
+        }
+        if (in.skip(u'.') || in.skip(u',')) {
+            int fraction = 0;
+            in.number(1, 9, fraction);
+        }
+    }
+    
+    if (in.atEnd()) {
+        return localToEpoch(year, month, day, hour, minute, second);
+    }
+    const auto zone = parseZone(in);
+    const auto epoch = toEpoch(year, month, day, hour, minute, second);
+    if (!zone || !epoch || !in.atEnd()) {
+        return std::nullopt;
+    }
+    return *epoch - *zone;
+}
+
+std::optional<qint64> parseFeedDate(const QString& dateStr, FeedDateFormat& format) {
+    const QStringView text = QStringView(dateStr).trimmed();
+    
+    if (format == FeedDateFormat::Unknown) {
+        format = detectFeedDateFormat(text);
+    }
+    auto seconds = parseDateAs(format, text);
+    if (!seconds) {
+        const FeedDateFormat detected = detectFeedDateFormat(text);
+        if (detected != format) {
+            format = detected;
+            seconds = parseDateAs(format, text);
+        }
+    }
+    
+    if (!seconds) {
+        seconds = parseDateSlow(dateStr);
+    }
+    return seconds;
+}
+
+} // namespace lotro
@@ -0,0 +1,49 @@
+/**
+ * LOTRO Launcher - Feed Date
+ * 
+ * Publication dates of RSS and Atom items.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <optional>
+
+namespace lotro {
+
+/**
+ * Date layouts seen in feeds, told apart by their first characters
+ */
+enum class FeedDateFormat {
+    Unknown,
+    Rfc822,         // "Tue, 10 Jun 2025 14:00:00 GMT", day name optional
+    Iso8601         // "2025-06-10T14:00:00Z"
+};
+
+FeedDateFormat detectFeedDateFormat(QStringView text);
+
+/**
+ * Seconds since the epoch of an RFC 822 or ISO 8601 date
+ * 
+ * Numeric offsets, "Z" and the RFC 822 zone names are understood; a
+ * date without a zone is local time. Empty if the text isn't a valid
+ * date of that layout.
+ */
+std::optional<qint64> parseRfc822Date(QStringView text);
+std::optional<qint64> parseIso8601Date(QStringView text);
+
+/**
+ * Seconds since the epoch of a feed date
+ * 
+ * The format is recognised from the first date of a feed and kept in
+ * format for the rest, so each later date takes a single parse; a date
+ * that doesn't fit it is detected afresh. Anything neither reader takes
+ * goes through the QDateTime formats feeds were parsed with before.
+ */
+std::optional<qint64> parseFeedDate(const QString& dateStr, FeedDateFormat& format);
+
+} // namespace lotro
@@ -8,7 +8,8 @@
 #include "SoapClient.hpp"
 
 #include <QXmlStreamReader>
-#include <QtConcurrent>
+
+#include <algorithm>
 
 #include <spdlog/spdlog.h>
 
@@ -113,46 +114,40 @@ QFuture<std::optional<GameServicesInfo>> fetchGameServicesInfo(
     const QString& datacenterUrl,
     const QString& gameType
 ) {
-    return QtConcurrent::run([datacenterUrl, gameType]() -> std::optional<GameServicesInfo> {
-        try {
-            spdlog::info("Fetching game services info from: {}", datacenterUrl.toStdString());
-            
-            SoapClient client(datacenterUrl);
-            
-            // GetDatacenters SOAP operation
-            QString params = QString("<game>%1</game>").arg(gameType.toUpper());
-            
-            auto future = client.call("GetDatacenters", params);
-            future.waitForFinished();
-            
-            QString response = future.result();
-            
-            if (response.isEmpty()) {
-                spdlog::error("Empty response from datacenter service");
-                return std::nullopt;
-            }
-            
-            auto info = parseDatacenterResponse(response, datacenterUrl);
-            
-            if (!info.isValid()) {
-                spdlog::error("Invalid datacenter response - missing required fields");
-                return std::nullopt;
-            }
-            
-            spdlog::info("Game services info retrieved successfully");
-            spdlog::debug("  Auth server: {}", info.authServer.toStdString());
-            spdlog::debug("  Patch server: {}", info.patchServer.toStdString());
-            spdlog::info("  Found {} worlds", info.worlds.size());
-            
-            return info;
-            
-        } catch (const SoapError& e) {
-            spdlog::error("SOAP error fetching game services: {}", e.what());
+    spdlog::info("Fetching game services info from: {}", datacenterUrl.toStdString());
+    
+    SoapClient client(datacenterUrl);
+    
+    // GetDatacenters SOAP operation
+    return client.call("GetDatacenters", {
+        {"game", gameType.toUpper()},
+    }).then([datacenterUrl](const QString& response) -> std::optional<GameServicesInfo> {
+        if (response.isEmpty()) {
+            spdlog::error("Empty response from datacenter service");
             return std::nullopt;
-        } catch (const std::exception& e) {
-            spdlog::error("Error fetching game services: {}", e.what());
+        }
+        
+        auto info = parseDatacenterResponse(response, datacenterUrl);
+        
+        if (!info.isValid()) {
+            spdlog::error("Invalid datacenter response - missing required fields");
             return std::nullopt;
         }
+        
+        spdlog::info("Game services info retrieved successfully");
+        spdlog::debug("  Auth server: {}", info.authServer.toStdString());
+        spdlog::debug("  Patch server: {}", info.patchServer.toStdString());
+        spdlog::info("  Found {} worlds", info.worlds.size());
+        
+        return info;
+    }).onFailed([](const SoapError& e) -> std::optional<GameServicesInfo> {
+        spdlog::error("SOAP error fetching game services: {}", e.what());
+        return std::nullopt;
+    }).onFailed([](const std::exception& e) -> std::optional<GameServicesInfo> {
+        spdlog::error("Error fetching game services: {}", e.what());
+        return std::nullopt;
+    }).onCanceled([]() -> std::optional<GameServicesInfo> {
+        return std::nullopt;
     });
 }
 
@@ -0,0 +1,166 @@
+/**
+ * LOTRO Launcher - HTTP Cache Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "HttpCache.hpp"
+#include "core/Metrics.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QFile>
+#include <QNetworkRequest>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+namespace lotro {
+
+HttpCache& HttpCache::shared() {
+    static HttpCache cache(Platform::getCachePath() / "http");
+    return cache;
+}
+
+HttpCache::HttpCache(const std::filesystem::path& directory)
+    : m_directory(QString::fromStdString(directory.string()))
+{
+}
+
+QString HttpCache::entryPath(const QUrl& url) const {
+    const QByteArray digest = QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha1);
+    return QDir(m_directory).filePath(QString::fromLatin1(digest.toHex()) + ".entry");
+}
+
+void HttpCache::prepare(QNetworkRequest& request) const {
+    const auto entry = lookup(request.url());
+    if (!entry) {
+        return;
+    }
+    if (!entry->etag.isEmpty()) {
+        request.setRawHeader("If-None-Match", entry->etag);
+    }
+    if (!entry->lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", entry->lastModified);
+    }
+}
+
+void HttpCache::update(const QUrl& url, HttpResponse& response) {
+    if (!response.ok()) {
+        return;
+    }
+    
+    if (response.status == 304) {
+        auto entry = lookup(url);
+        if (!entry) {
+            // Removed since prepare(); the next request goes out unconditional
+            spdlog::warn("Cached copy of {} is gone", url.toString().toStdString());
+            response.error = QNetworkReply::UnknownContentError;
+            response.errorString = "Not modified, but no cached copy";
+            return;
+        }
+        spdlog::debug("Not modified, using cached copy: {}", url.toString().toStdString());
+        response.status = 200;
+        response.body = std::move(entry->body);
+        response.fromCache = true;
+        static metrics::Counter& hits = metrics::counter("http.cache_hits");
+        hits.add();
+        return;
+    }
+    
+    if (response.status < 200 || response.status >= 300) {
+        return;
+    }
+    static metrics::Counter& misses = metrics::counter("http.cache_misses");
+    misses.add();
+    Entry entry;
+    entry.body = response.body;
+    entry.etag = response.header("ETag");
+    entry.lastModified = response.header("Last-Modified");
+    entry.storedAt = QDateTime::currentMSecsSinceEpoch();
+    store(url, entry);
+}
+
+HttpResponse HttpCache::get(const QNetworkRequest& request) {
+    QNetworkRequest conditional = request;
+    prepare(conditional);
+    HttpResponse response = HttpClient::get(conditional);
+    update(request.url(), response);
+    if (response.status == 304 && !response.ok()) {
+        response = HttpClient::get(request);
+        update(request.url(), response);
+    }
+    return response;
+}
+
+std::optional<HttpCache::Entry> HttpCache::lookup(const QUrl& url) const {
+    QFile file(entryPath(url));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0;
+    QByteArray storedUrl;
+    Entry entry;
+    in >> magic >> version;
+    if (magic != MAGIC || version != VERSION) {
+        return std::nullopt;
+    }
+    in >> storedUrl >> entry.etag >> entry.lastModified >> entry.storedAt >> entry.body;
+    if (in.status() != QDataStream::Ok || storedUrl != url.toEncoded()) {
+        return std::nullopt;
+    }
+    return entry;
+}
+
+bool HttpCache::store(const QUrl& url, const Entry& entry) {
+    QDir().mkpath(m_directory);
+    
+    const QString path = entryPath(url);
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write HTTP cache entry {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << url.toEncoded() << entry.etag << entry.lastModified
+        << entry.storedAt << entry.body;
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit HTTP cache entry {}", path.toStdString());
+        return false;
+    }
+    return true;
+}
+
+void HttpCache::remove(const QUrl& url) {
+    QFile::remove(entryPath(url));
+}
+
+void HttpCache::trim(qint64 maxBytes) {
+    // Newest first; an entry's file time is when it was last stored
+    const QFileInfoList entries = QDir(m_directory).entryInfoList(
+        {"*.entry"}, QDir::Files, QDir::Time);
+    qint64 total = 0;
+    int removed = 0;
+    for (const QFileInfo& entry : entries) {
+        total += entry.size();
+        if (total > maxBytes && QFile::remove(entry.filePath())) {
+            ++removed;
+        }
+    }
+    if (removed > 0) {
+        spdlog::debug("Trimmed {} entries from {}", removed, m_directory.toStdString());
+    }
+}
+
+} // namespace lotro
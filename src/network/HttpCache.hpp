@@ -0,0 +1,95 @@
+/**
+ * LOTRO Launcher - HTTP Cache
+ * 
+ * Last responses of small, frequently refreshed documents, revalidated
+ * with conditional requests.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "HttpClient.hpp"
+
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+
+#include <filesystem>
+#include <optional>
+
+class QNetworkRequest;
+
+namespace lotro {
+
+/**
+ * On-disk copies of GET responses, keyed by URL
+ * 
+ * Each successful response is kept with its ETag and Last-Modified, one
+ * entry file per URL under the cache path. The next request for the URL
+ * carries If-None-Match / If-Modified-Since; a 304 is answered from the
+ * stored body, so callers see a normal 200 with fromCache set and parse
+ * it as usual. Entries are replaced atomically, so the cache can be used
+ * from any thread.
+ * 
+ * Meant for the feeds the launcher fetches at every start - the newsfeed,
+ * world status and addon lists - not for large downloads, which go
+ * through DownloadStore.
+ */
+class HttpCache {
+public:
+    struct Entry {
+        QByteArray body;
+        QByteArray etag;
+        QByteArray lastModified;
+        qint64 storedAt = 0;            // Milliseconds since epoch
+    };
+    
+    static HttpCache& shared();
+    
+    explicit HttpCache(const std::filesystem::path& directory);
+    
+    /**
+     * Add validators for the stored copy of the request's URL, if any
+     */
+    void prepare(QNetworkRequest& request) const;
+    
+    /**
+     * Fold a finished response into the cache
+     * 
+     * A 304 is replaced by the stored copy; any other 2xx response is
+     * stored for next time. A 304 whose copy has gone is turned into an
+     * error, keeping the status.
+     */
+    void update(const QUrl& url, HttpResponse& response);
+    
+    /**
+     * prepare(), HttpClient::get() and update() in one
+     * 
+     * Falls back to a plain request if the stored copy vanished in between.
+     */
+    HttpResponse get(const QNetworkRequest& request);
+    
+    /**
+     * Stored copy of a URL without touching the network
+     */
+    std::optional<Entry> lookup(const QUrl& url) const;
+    
+    void remove(const QUrl& url);
+    
+    /**
+     * Drop the least recently stored entries until the cache fits in maxBytes
+     */
+    void trim(qint64 maxBytes);
+
+private:
+    QString entryPath(const QUrl& url) const;
+    bool store(const QUrl& url, const Entry& entry);
+    
+    static constexpr quint32 MAGIC = 0x4348544C;    // "LTHC"
+    static constexpr quint32 VERSION = 1;
+    
+    QString m_directory;
+};
+
+} // namespace lotro
@@ -0,0 +1,117 @@
+/**
+ * LOTRO Launcher - HTTP Client Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "HttpClient.hpp"
+#include "NetworkTrace.hpp"
+#include "core/AllocationProfiler.hpp"
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QNetworkAccessManager>
+#include <QThread>
+
+#include <spdlog/spdlog.h>
+
+namespace lotro {
+
+namespace {
+    /**
+     * Network manager that hands every reply it creates to NetworkTrace
+     */
+    class TracedNetworkAccessManager : public QNetworkAccessManager {
+    protected:
+        QNetworkReply* createRequest(Operation op, const QNetworkRequest& request,
+                                     QIODevice* outgoingData) override {
+            QNetworkReply* reply = QNetworkAccessManager::createRequest(op, request, outgoingData);
+            const qint64 requestBytes = outgoingData && !outgoingData->isSequential()
+                ? outgoingData->size() : 0;
+            NetworkTrace::instance().attach(reply, requestBytes);
+            return reply;
+        }
+    };
+}
+
+QByteArray HttpResponse::header(const QByteArray& name) const {
+    for (const auto& [key, value] : headers) {
+        if (key.compare(name, Qt::CaseInsensitive) == 0) {
+            return value;
+        }
+    }
+    return {};
+}
+
+QNetworkAccessManager* HttpClient::manager() {
+    thread_local QNetworkAccessManager* manager = nullptr;
+    if (manager) {
+        return manager;
+    }
+    
+    manager = new TracedNetworkAccessManager();
+    manager->setRedirectPolicy(QNetworkRequest::NoLessSafeRedirectPolicy);
+    QObject::connect(manager, &QObject::destroyed, []() { manager = nullptr; });
+    
+    QThread* thread = QThread::currentThread();
+    QCoreApplication* app = QCoreApplication::instance();
+    if (app && thread == app->thread()) {
+        manager->setParent(app);
+    } else {
+        // Emitted on the exiting thread, which still processes the deferred delete
+        QObject::connect(thread, &QThread::finished, manager, &QObject::deleteLater,
+                         Qt::DirectConnection);
+    }
+    spdlog::debug("Created network manager for thread {}", static_cast<const void*>(thread));
+    return manager;
+}
+
+QNetworkRequest HttpClient::request(const QUrl& url, int timeoutMs) {
+    QNetworkRequest request(url);
+    request.setHeader(QNetworkRequest::UserAgentHeader, USER_AGENT);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
+                         QNetworkRequest::NoLessSafeRedirectPolicy);
+    request.setTransferTimeout(timeoutMs);
+    return request;
+}
+
+HttpResponse HttpClient::get(const QNetworkRequest& request) {
+    return wait(manager()->get(request));
+}
+
+HttpResponse HttpClient::post(const QNetworkRequest& request, const QByteArray& body) {
+    return wait(manager()->post(request, body));
+}
+
+HttpResponse HttpClient::head(const QNetworkRequest& request) {
+    return wait(manager()->head(request));
+}
+
+HttpResponse HttpClient::wait(QNetworkReply* reply) {
+    if (!reply->isFinished()) {
+        QEventLoop loop;
+        QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+    
+    HttpResponse response = collect(reply);
+    
+    // Workers rarely run an event loop, so a deferred delete could sit
+    // there indefinitely now that the manager outlives the request
+    delete reply;
+    return response;
+}
+
+HttpResponse HttpClient::collect(QNetworkReply* reply) {
+    allocation::Scope allocScope(allocation::Tag::Net);
+    HttpResponse response;
+    response.error = reply->error();
+    response.errorString = reply->errorString();
+    response.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    response.headers = reply->rawHeaderPairs();
+    response.body = reply->readAll();
+    return response;
+}
+
+} // namespace lotro
@@ -0,0 +1,104 @@
+/**
+ * LOTRO Launcher - HTTP Client
+ * 
+ * Shared network managers and request defaults for the whole launcher.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+#include <QUrl>
+
+class QNetworkAccessManager;
+
+namespace lotro {
+
+/**
+ * Outcome of a blocking request
+ */
+struct HttpResponse {
+    QNetworkReply::NetworkError error = QNetworkReply::NoError;
+    QString errorString;
+    int status = 0;                     // HTTP status, 0 if no response came
+    QByteArray body;
+    QList<QNetworkReply::RawHeaderPair> headers;
+    bool fromCache = false;             // Body is HttpCache's copy, revalidated by a 304
+    
+    bool ok() const { return error == QNetworkReply::NoError; }
+    
+    // A reply aborted by the transfer timeout
+    bool timedOut() const { return error == QNetworkReply::OperationCanceledError; }
+    
+    /**
+     * Value of a response header, matched case-insensitively; empty if absent
+     */
+    QByteArray header(const QByteArray& name) const;
+};
+
+/**
+ * One network manager per thread, shared by every request made on it
+ * 
+ * QNetworkAccessManager keeps idle keep-alive connections per host and
+ * negotiates HTTP/2 over TLS, but only for requests made through the same
+ * instance, and an instance may only be used on the thread it lives on.
+ * manager() hands out the calling thread's instance, creating it on first
+ * use: GUI code shares the main thread's, and the QtConcurrent workers the
+ * network module runs on keep theirs between tasks, so repeat requests to
+ * the same servers skip the TCP and TLS handshakes.
+ * 
+ * request() applies the launcher's defaults: the user agent, HTTP/2, safe
+ * redirects and a transfer timeout that aborts a reply once nothing has
+ * arrived for that long. Compressed responses are requested and inflated
+ * by the manager itself, so callers must not set Accept-Encoding.
+ * 
+ * Every request made through these managers is timed by NetworkTrace.
+ */
+class HttpClient {
+public:
+    /**
+     * Network manager for the calling thread
+     * 
+     * Owned by the application on the main thread and destroyed with the
+     * thread anywhere else; never delete it or hand it to another thread.
+     */
+    static QNetworkAccessManager* manager();
+    
+    /**
+     * Request with the launcher's defaults
+     * @param timeoutMs Inactivity timeout; 0 to wait forever
+     */
+    static QNetworkRequest request(const QUrl& url, int timeoutMs = DEFAULT_TIMEOUT_MS);
+    
+    /**
+     * Run a request to completion on the calling thread's manager
+     * 
+     * Spins a local event loop, so call it from worker threads or where
+     * the GUI is allowed to wait.
+     */
+    static HttpResponse get(const QNetworkRequest& request);
+    static HttpResponse post(const QNetworkRequest& request, const QByteArray& body);
+    static HttpResponse head(const QNetworkRequest& request);
+    
+    /**
+     * Wait for a reply another caller started and collect it
+     * 
+     * The reply is deleted afterwards.
+     */
+    static HttpResponse wait(QNetworkReply* reply);
+    
+    /**
+     * Read out a finished reply, leaving it to the caller to delete
+     */
+    static HttpResponse collect(QNetworkReply* reply);
+    
+    static constexpr int DEFAULT_TIMEOUT_MS = 30000;
+    static constexpr const char* USER_AGENT = "LOTRO-Launcher/1.0";
+};
+
+} // namespace lotro
@@ -10,7 +10,6 @@
 #include "SoapClient.hpp"
 
 #include <QXmlStreamReader>
-#include <QtConcurrent>
 
 #include <spdlog/spdlog.h>
 
@@ -144,95 +143,78 @@ QFuture<LoginResult> loginAccount(
     const QString& username,
     const QString& password
 ) {
-    return QtConcurrent::run([authServer, username, password]() -> LoginResult {
+    spdlog::info("Logging in user: {}", username.toStdString());
+    spdlog::debug("Auth server: {}", authServer.toStdString());
+    
+    SoapClient client(authServer);
+    
+    // LoginAccount SOAP operation
+    return client.call("LoginAccount", {
+        {"username", username},
+        {"password", password},
+        {"additionalInfo", QString()},
+    }).then([](const QString& response) -> LoginResult {
         LoginResult result;
         
-        try {
-            spdlog::info("Logging in user: {}", username.toStdString());
-            spdlog::debug("Auth server: {}", authServer.toStdString());
-            
-            SoapClient client(authServer);
-            
-            // LoginAccount SOAP operation
-            QString params = QString(
-                "<username>%1</username>"
-                "<password>%2</password>"
-                "<additionalInfo></additionalInfo>"
-            ).arg(username, password);
-            
-            auto future = client.call("LoginAccount", params);
-            future.waitForFinished();
-            
-            QString response = future.result();
-            
-            if (response.isEmpty()) {
-                result.error = LoginError::ServiceError;
-                result.errorMessage = "Empty response from authentication server";
-                spdlog::error("Empty login response");
-                return result;
-            }
-            
-            // Check for SOAP fault
-            if (response.contains("Fault") || response.contains("fault")) {
-                // Extract fault message
-                QXmlStreamReader reader(response);
-                QString faultMessage;
-                while (!reader.atEnd()) {
-                    reader.readNext();
-                    if (reader.isStartElement() && 
-                        (reader.name().toString() == "faultstring" ||
-                         reader.name().toString() == "Message")) {
-                        faultMessage = reader.readElementText();
-                        break;
-                    }
-                }
-                
-                result.error = parseLoginError(faultMessage);
-                result.errorMessage = faultMessage.isEmpty() ? 
-                    "Authentication failed" : faultMessage;
-                spdlog::warn("Login failed: {}", result.errorMessage.toStdString());
-                return result;
-            }
-            
-            auto loginResponse = parseLoginResponse(response);
-            
-            if (loginResponse.sessionTicket.isEmpty()) {
-                result.error = LoginError::ServiceError;
-                result.errorMessage = "No session ticket in response";
-                spdlog::error("Login response missing session ticket");
-                return result;
-            }
-            
-            result.response = loginResponse;
-            spdlog::info("Login successful, got {} subscriptions", 
-                        loginResponse.subscriptions.size());
-            
+        if (response.isEmpty()) {
+            result.error = LoginError::ServiceError;
+            result.errorMessage = "Empty response from authentication server";
+            spdlog::error("Empty login response");
             return result;
-            
-        } catch (const SoapError& e) {
-            std::string errorStr = e.what();
-            
-            // Check for common server errors
-            if (errorStr.find("503") != std::string::npos || 
-                errorStr.find("Service Unavailable") != std::string::npos) {
-                result.error = LoginError::ServiceError;
-                result.errorMessage = "LOTRO authentication service is temporarily unavailable. Please try again later.";
-            } else if (errorStr.find("500") != std::string::npos || 
-                       errorStr.find("Internal Server Error") != std::string::npos) {
-                result.error = LoginError::ServiceError;
-                result.errorMessage = "LOTRO authentication service encountered an error. Please try again later.";
-            } else {
-                result.error = LoginError::NetworkError;
-                result.errorMessage = QString::fromStdString(errorStr);
-            }
-            spdlog::error("SOAP error during login: {}", e.what());
+        }
+        
+        auto loginResponse = parseLoginResponse(response);
+        
+        if (loginResponse.sessionTicket.isEmpty()) {
+            result.error = LoginError::ServiceError;
+            result.errorMessage = "No session ticket in response";
+            spdlog::error("Login response missing session ticket");
             return result;
-        } catch (const std::exception& e) {
+        }
+        
+        result.response = loginResponse;
+        spdlog::info("Login successful, got {} subscriptions", 
+                    loginResponse.subscriptions.size());
+        
+        return result;
+    }).onFailed([](const SoapFault& fault) -> LoginResult {
+        LoginResult result;
+        const QString faultMessage = QString::fromStdString(fault.what());
+        result.error = parseLoginError(faultMessage);
+        result.errorMessage = faultMessage.isEmpty() ? 
+            "Authentication failed" : faultMessage;
+        spdlog::warn("Login failed: {}", result.errorMessage.toStdString());
+        return result;
+    }).onFailed([](const SoapError& e) -> LoginResult {
+        LoginResult result;
+        std::string errorStr = e.what();
+        
+        // Check for common server errors
+        if (errorStr.find("503") != std::string::npos || 
+            errorStr.find("Service Unavailable") != std::string::npos) {
+            result.error = LoginError::ServiceError;
+            result.errorMessage = "LOTRO authentication service is temporarily unavailable. Please try again later.";
+        } else if (errorStr.find("500") != std::string::npos || 
+                   errorStr.find("Internal Server Error") != std::string::npos) {
+            result.error = LoginError::ServiceError;
+            result.errorMessage = "LOTRO authentication service encountered an error. Please try again later.";
+        } else {
             result.error = LoginError::NetworkError;
-            result.errorMessage = QString::fromStdString(e.what());
-            spdlog::error("Error during login: {}", e.what());
-            return result;
+            result.errorMessage = QString::fromStdString(errorStr);
         }
+        spdlog::error("SOAP error during login: {}", e.what());
+        return result;
+    }).onFailed([](const std::exception& e) -> LoginResult {
+        LoginResult result;
+        result.error = LoginError::NetworkError;
+        result.errorMessage = QString::fromStdString(e.what());
+        spdlog::error("Error during login: {}", e.what());
+        return result;
+    }).onCanceled([]() -> LoginResult {
+        LoginResult result;
+        result.error = LoginError::NetworkError;
+        result.errorMessage = "Login was cancelled";
+        return result;
     });
 }
 
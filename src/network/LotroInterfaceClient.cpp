@@ -5,10 +5,15 @@
  */
 
 #include "LotroInterfaceClient.hpp"
+#include "HttpCache.hpp"
+#include "HttpClient.hpp"
+#include "NetworkTrace.hpp"
+#include "core/DownloadStore.hpp"
+#include "core/DownloadWriter.hpp"
+#include "core/TaskScheduler.hpp"
 
 #include <QDir>
 #include <QDateTime>
-#include <QEventLoop>
 #include <QFile>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
@@ -16,17 +21,17 @@
 #include <QSslConfiguration>
 #include <QStandardPaths>
 #include <QTemporaryFile>
-#include <QTimer>
 #include <QXmlStreamReader>
-#include <QtConcurrent>
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
+
 namespace lotro {
 
 class LotroInterfaceClient::Impl {
 public:
-    // Nothing needed for now - each request creates its own manager
+    // Nothing needed for now - requests share HttpClient's managers
 };
 
 LotroInterfaceClient::LotroInterfaceClient()
@@ -38,6 +43,8 @@ LotroInterfaceClient::~LotroInterfaceClient() = default;
 
 namespace {
 
+constexpr int DOWNLOAD_TIMEOUT_MS = 60000;
+
 QString getApiUrl(AddonType type) {
     switch (type) {
         case AddonType::Plugin:
@@ -137,55 +144,41 @@ std::vector<RemoteAddonInfo> parseAddonListXml(const QString& xml, AddonType typ
 
 } // anonymous namespace
 
+HttpResponse LotroInterfaceClient::fetchAddonListXml(AddonType type) {
+    QString url = getApiUrl(type);
+    spdlog::info("Fetching addon list from: {}", url.toStdString());
+    
+    QNetworkRequest request = HttpClient::request(QUrl(url));
+    NetworkTrace::tag(request, "Addons");
+    
+    // Configure SSL
+    QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
+    sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
+    request.setSslConfiguration(sslConfig);
+    
+    HttpResponse reply = HttpCache::shared().get(request);
+    
+    if (reply.timedOut()) {
+        spdlog::error("Addon list fetch timed out");
+    } else if (!reply.ok()) {
+        spdlog::error("Addon list fetch failed: {}", 
+                     reply.errorString.toStdString());
+    }
+    return reply;
+}
+
+std::vector<RemoteAddonInfo> LotroInterfaceClient::parseAddonList(const QByteArray& xml, AddonType type) {
+    return parseAddonListXml(QString::fromUtf8(xml), type);
+}
+
 QFuture<std::vector<RemoteAddonInfo>> LotroInterfaceClient::fetchAddonList(AddonType type) {
-    return QtConcurrent::run([type]() -> std::vector<RemoteAddonInfo> {
+    return TaskScheduler::instance().run(TaskPool::Io, [type]() -> std::vector<RemoteAddonInfo> {
         try {
-            QString url = getApiUrl(type);
-            spdlog::info("Fetching addon list from: {}", url.toStdString());
-            
-            QNetworkAccessManager manager;
-            QNetworkRequest request(url);
-            request.setHeader(QNetworkRequest::UserAgentHeader, "LOTRO-Launcher/1.0");
-            
-            // Configure SSL
-            QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
-            sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
-            request.setSslConfiguration(sslConfig);
-            
-            // Allow redirects
-            request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, 
-                                 QNetworkRequest::NoLessSafeRedirectPolicy);
-            
-            QEventLoop loop;
-            QNetworkReply* reply = manager.get(request);
-            
-            QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-            
-            QTimer timer;
-            timer.setSingleShot(true);
-            QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-            timer.start(30000); // 30 second timeout
-            
-            loop.exec();
-            
-            if (!timer.isActive()) {
-                spdlog::error("Addon list fetch timed out");
-                reply->deleteLater();
+            const HttpResponse reply = fetchAddonListXml(type);
+            if (!reply.ok()) {
                 return {};
             }
-            timer.stop();
-            
-            if (reply->error() != QNetworkReply::NoError) {
-                spdlog::error("Addon list fetch failed: {}", 
-                             reply->errorString().toStdString());
-                reply->deleteLater();
-                return {};
-            }
-            
-            QString content = QString::fromUtf8(reply->readAll());
-            reply->deleteLater();
-            
-            return parseAddonListXml(content, type);
+            return parseAddonList(reply.body, type);
             
         } catch (const std::exception& e) {
             spdlog::error("Exception fetching addon list: {}", e.what());
@@ -198,80 +191,103 @@ QFuture<QString> LotroInterfaceClient::downloadAddon(
     const QString& downloadUrl,
     std::function<void(qint64, qint64)> progressCallback
 ) {
-    return QtConcurrent::run([downloadUrl, progressCallback]() -> QString {
-        try {
-            spdlog::info("Downloading addon from: {}", downloadUrl.toStdString());
-            
-            QNetworkAccessManager manager;
-            QNetworkRequest request(downloadUrl);
-            request.setHeader(QNetworkRequest::UserAgentHeader, "LOTRO-Launcher/1.0");
-            
-            // Configure SSL
-            QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
-            sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
-            request.setSslConfiguration(sslConfig);
-            
-            // Allow redirects
-            request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, 
-                                 QNetworkRequest::NoLessSafeRedirectPolicy);
-            
-            QEventLoop loop;
-            QNetworkReply* reply = manager.get(request);
-            
-            if (progressCallback) {
-                QObject::connect(reply, &QNetworkReply::downloadProgress,
-                    [&progressCallback](qint64 received, qint64 total) {
-                        progressCallback(received, total);
-                    });
-            }
-            
-            QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-            
-            QTimer timer;
-            timer.setSingleShot(true);
-            QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-            timer.start(300000); // 5 minute timeout for downloads
-            
-            loop.exec();
-            
-            if (!timer.isActive()) {
-                spdlog::error("Addon download timed out");
-                reply->deleteLater();
-                return QString();
-            }
-            timer.stop();
-            
-            if (reply->error() != QNetworkReply::NoError) {
-                spdlog::error("Addon download failed: {}", 
-                             reply->errorString().toStdString());
-                reply->deleteLater();
-                return QString();
-            }
-            
-            // Save to temp file
-            QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-            QString tempPath = tempDir + "/lotro-launcher-addon-" + 
-                              QString::number(QDateTime::currentMSecsSinceEpoch()) + ".zip";
-            
-            QFile file(tempPath);
-            if (!file.open(QIODevice::WriteOnly)) {
-                spdlog::error("Failed to create temp file: {}", tempPath.toStdString());
-                reply->deleteLater();
-                return QString();
+    return TaskScheduler::instance().run(TaskPool::Io, [downloadUrl, progressCallback]() {
+        return downloadAddonFile(downloadUrl, progressCallback);
+    });
+}
+
+QString LotroInterfaceClient::downloadAddonFile(
+    const QString& downloadUrl,
+    const std::function<void(qint64, qint64)>& progressCallback
+) {
+    try {
+        spdlog::info("Downloading addon from: {}", downloadUrl.toStdString());
+        
+        // Archives can be large; only give up when the transfer stalls
+        QNetworkRequest request = HttpClient::request(QUrl(downloadUrl), DOWNLOAD_TIMEOUT_MS);
+        NetworkTrace::tag(request, "Addons");
+        
+        // Configure SSL
+        QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
+        sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
+        request.setSslConfiguration(sslConfig);
+        
+        // With a stored copy, only ask for the archive if it changed
+        DownloadStore& store = DownloadStore::shared();
+        const auto stored = store.alias(downloadUrl);
+        if (stored && !stored->validator.isEmpty()) {
+            const bool etag = stored->validator.startsWith('"') || stored->validator.startsWith("W/");
+            request.setRawHeader(etag ? "If-None-Match" : "If-Modified-Since", stored->validator.toUtf8());
+        }
+        
+        QNetworkReply* pending = HttpClient::manager()->get(request);
+        
+        if (progressCallback) {
+            QObject::connect(pending, &QNetworkReply::downloadProgress,
+                [&progressCallback](qint64 received, qint64 total) {
+                    progressCallback(received, total);
+                });
+        }
+        
+        const HttpResponse reply = HttpClient::wait(pending);
+        
+        if (reply.timedOut()) {
+            spdlog::error("Addon download timed out");
+            return QString();
+        }
+        
+        if (!reply.ok()) {
+            spdlog::error("Addon download failed: {}", 
+                         reply.errorString.toStdString());
+            return QString();
+        }
+        
+        // Save to temp file
+        QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+        // Several downloads can finish in the same millisecond
+        static std::atomic<int> sequence{0};
+        QString tempPath = tempDir + "/lotro-launcher-addon-" + 
+                          QString::number(QDateTime::currentMSecsSinceEpoch()) + "-" +
+                          QString::number(sequence.fetch_add(1)) + ".zip";
+        
+        if (stored && reply.status == 304) {
+            if (store.materialize(stored->key, tempPath.toStdString(), DownloadStore::Link::Shared)) {
+                spdlog::info("Addon unchanged, using stored copy: {}", tempPath.toStdString());
+                return tempPath;
             }
-            
-            file.write(reply->readAll());
-            file.close();
-            reply->deleteLater();
-            
-            spdlog::info("Addon downloaded to: {}", tempPath.toStdString());
-            return tempPath;
-            
-        } catch (const std::exception& e) {
-            spdlog::error("Exception downloading addon: {}", e.what());
+            spdlog::error("Stored addon archive is gone: {}", downloadUrl.toStdString());
             return QString();
         }
-    });
+        
+        DownloadWriter file(tempPath);
+        if (!file.open(false, reply.body.size())) {
+            spdlog::error("Failed to create temp file: {}", tempPath.toStdString());
+            return QString();
+        }
+        if (!file.write(reply.body) || !file.close()) {
+            spdlog::error("Failed to write {}: {}", tempPath.toStdString(), file.errorString().toStdString());
+            QFile::remove(tempPath);
+            return QString();
+        }
+        
+        QString validator = QString::fromUtf8(reply.header("ETag"));
+        if (validator.isEmpty()) {
+            validator = QString::fromUtf8(reply.header("Last-Modified"));
+        }
+        
+        const QString key = store.insertHashed(tempPath.toStdString(), DownloadStore::Link::Shared);
+        if (!key.isEmpty()) {
+            store.setAlias(downloadUrl, key, validator);
+            store.trim();
+        }
+        
+        spdlog::info("Addon downloaded to: {}", tempPath.toStdString());
+        return tempPath;
+        
+    } catch (const std::exception& e) {
+        spdlog::error("Exception downloading addon: {}", e.what());
+        return QString();
+    }
 }
 
 QString LotroInterfaceClient::getAddonPageUrl(const QString& interfaceId) {
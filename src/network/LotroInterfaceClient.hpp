@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 
+#include <QByteArray>
 #include <QFuture>
 #include <QString>
 
@@ -19,6 +20,8 @@
 
 namespace lotro {
 
+struct HttpResponse;
+
 /**
  * Remote addon information from lotrointerface.com
  */
@@ -64,6 +67,19 @@ public:
      */
     QFuture<std::vector<RemoteAddonInfo>> fetchAddonList(AddonType type);
     
+    /**
+     * Fetch the raw addon list, revalidating HttpCache's copy
+     * 
+     * Blocks; fromCache is set when the list hasn't changed since the
+     * copy was stored.
+     */
+    static HttpResponse fetchAddonListXml(AddonType type);
+    
+    /**
+     * Parse an addon list fetched by fetchAddonListXml
+     */
+    static std::vector<RemoteAddonInfo> parseAddonList(const QByteArray& xml, AddonType type);
+    
     /**
      * Download an addon archive to a temporary file
      * 
@@ -76,6 +92,16 @@ public:
         std::function<void(qint64, qint64)> progressCallback = nullptr
     );
     
+    /**
+     * Download an addon archive to a temporary file
+     * 
+     * Blocks; for callers already on a worker thread.
+     */
+    static QString downloadAddonFile(
+        const QString& downloadUrl,
+        const std::function<void(qint64, qint64)>& progressCallback = nullptr
+    );
+    
     /**
      * Get addon info page URL
      */
@@ -0,0 +1,235 @@
+/**
+ * LOTRO Launcher - Network Trace Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "NetworkTrace.hpp"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+#include <memory>
+
+namespace lotro {
+
+namespace {
+    /**
+     * Timestamps of one reply, in milliseconds since it was created
+     */
+    struct ReplyClock {
+        QElapsedTimer clock;
+        qint64 startedAt = 0;
+        qint64 connectingAt = -1;
+        qint64 encryptedAt = -1;
+        qint64 sentAt = -1;
+        qint64 headersAt = -1;
+        qint64 responseBytes = 0;
+        qint64 requestBytes = 0;
+    };
+    
+    QByteArray methodOf(const QNetworkReply* reply) {
+        switch (reply->operation()) {
+            case QNetworkAccessManager::HeadOperation: return "HEAD";
+            case QNetworkAccessManager::GetOperation: return "GET";
+            case QNetworkAccessManager::PutOperation: return "PUT";
+            case QNetworkAccessManager::PostOperation: return "POST";
+            case QNetworkAccessManager::DeleteOperation: return "DELETE";
+            default:
+                return reply->request().attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+        }
+    }
+    
+    qint64 between(qint64 from, qint64 to) {
+        return from >= 0 && to >= from ? to - from : -1;
+    }
+    
+    // HAR wants send, wait and receive present
+    qint64 harTiming(qint64 value) {
+        return value >= 0 ? value : 0;
+    }
+}
+
+NetworkTrace& NetworkTrace::instance() {
+    static NetworkTrace trace;
+    return trace;
+}
+
+void NetworkTrace::tag(QNetworkRequest& request, const QString& source) {
+    request.setAttribute(SOURCE_ATTRIBUTE, source);
+}
+
+void NetworkTrace::attach(QNetworkReply* reply, qint64 requestBytes) {
+    auto state = std::make_shared<ReplyClock>();
+    state->clock.start();
+    state->startedAt = QDateTime::currentMSecsSinceEpoch();
+    state->requestBytes = requestBytes;
+    
+    QObject::connect(reply, &QNetworkReply::socketStartedConnecting, reply, [state]() {
+        if (state->connectingAt < 0) {
+            state->connectingAt = state->clock.elapsed();
+        }
+    });
+    QObject::connect(reply, &QNetworkReply::encrypted, reply, [state]() {
+        state->encryptedAt = state->clock.elapsed();
+    });
+    QObject::connect(reply, &QNetworkReply::requestSent, reply, [state]() {
+        state->sentAt = state->clock.elapsed();
+    });
+    QObject::connect(reply, &QNetworkReply::metaDataChanged, reply, [state]() {
+        if (state->headersAt < 0) {
+            state->headersAt = state->clock.elapsed();
+        }
+    });
+    QObject::connect(reply, &QNetworkReply::downloadProgress, reply, [state](qint64 received, qint64) {
+        state->responseBytes = received;
+    });
+    QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply, state]() {
+        const qint64 finishedAt = state->clock.elapsed();
+        
+        NetworkTraceEntry entry;
+        entry.source = reply->request().attribute(SOURCE_ATTRIBUTE).toString();
+        if (entry.source.isEmpty()) {
+            entry.source = reply->url().host();
+        }
+        entry.method = methodOf(reply);
+        entry.url = reply->url();
+        entry.startedAt = state->startedAt;
+        entry.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (reply->error() != QNetworkReply::NoError) {
+            entry.error = reply->errorString();
+        }
+        entry.requestBytes = state->requestBytes;
+        entry.responseBytes = state->responseBytes;
+        entry.http2 = reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+        entry.reusedConnection = state->connectingAt < 0 && state->sentAt >= 0;
+        
+        if (state->connectingAt >= 0) {
+            // Plain HTTP has no handshake to end the connect, so it runs to the send
+            const qint64 connectedAt = state->encryptedAt >= 0 ? state->encryptedAt : state->sentAt;
+            entry.blocked = state->connectingAt;
+            entry.connect = between(state->connectingAt, connectedAt);
+            entry.send = between(connectedAt, state->sentAt);
+        } else {
+            entry.send = state->sentAt;
+        }
+        entry.wait = between(state->sentAt, state->headersAt);
+        entry.receive = between(state->headersAt, finishedAt);
+        entry.total = finishedAt;
+        
+        record(std::move(entry));
+    });
+}
+
+void NetworkTrace::record(NetworkTraceEntry entry) {
+    QMutexLocker lock(&m_mutex);
+    if (m_entries.size() < CAPACITY) {
+        m_entries.push_back(std::move(entry));
+        return;
+    }
+    m_entries[m_next] = std::move(entry);
+    m_next = (m_next + 1) % CAPACITY;
+}
+
+std::vector<NetworkTraceEntry> NetworkTrace::entries() const {
+    QMutexLocker lock(&m_mutex);
+    std::vector<NetworkTraceEntry> ordered;
+    ordered.reserve(m_entries.size());
+    ordered.insert(ordered.end(), m_entries.begin() + m_next, m_entries.end());
+    ordered.insert(ordered.end(), m_entries.begin(), m_entries.begin() + m_next);
+    return ordered;
+}
+
+void NetworkTrace::clear() {
+    QMutexLocker lock(&m_mutex);
+    m_entries.clear();
+    m_next = 0;
+}
+
+QByteArray NetworkTrace::toHar() const {
+    QJsonArray harEntries;
+    for (const auto& entry : entries()) {
+        const QString httpVersion = entry.http2 ? "HTTP/2" : "HTTP/1.1";
+        
+        QJsonObject request{
+            {"method", QString::fromLatin1(entry.method)},
+            {"url", entry.url.toString()},
+            {"httpVersion", httpVersion},
+            {"cookies", QJsonArray()},
+            {"headers", QJsonArray()},
+            {"queryString", QJsonArray()},
+            {"headersSize", -1},
+            {"bodySize", entry.requestBytes},
+        };
+        
+        QJsonObject response{
+            {"status", entry.status},
+            {"statusText", QString()},
+            {"httpVersion", httpVersion},
+            {"cookies", QJsonArray()},
+            {"headers", QJsonArray()},
+            {"content", QJsonObject{{"size", entry.responseBytes}, {"mimeType", QString()}}},
+            {"redirectURL", QString()},
+            {"headersSize", -1},
+            {"bodySize", entry.responseBytes},
+        };
+        if (!entry.error.isEmpty()) {
+            response.insert("_error", entry.error);
+        }
+        
+        QJsonObject timings{
+            {"blocked", entry.blocked},
+            {"dns", -1},
+            {"connect", entry.connect},
+            {"ssl", -1},
+            {"send", harTiming(entry.send)},
+            {"wait", harTiming(entry.wait)},
+            {"receive", harTiming(entry.receive)},
+        };
+        
+        harEntries.append(QJsonObject{
+            {"startedDateTime", QDateTime::fromMSecsSinceEpoch(entry.startedAt, Qt::UTC)
+                                    .toString(Qt::ISODateWithMs)},
+            {"time", entry.total},
+            {"request", request},
+            {"response", response},
+            {"cache", QJsonObject()},
+            {"timings", timings},
+            {"connection", entry.reusedConnection ? "reused" : "new"},
+            {"comment", entry.source},
+        });
+    }
+    
+    QJsonObject log{
+        {"version", "1.2"},
+        {"creator", QJsonObject{{"name", "LOTRO Launcher"}, {"version", "1.0"}}},
+        {"entries", harEntries},
+    };
+    return QJsonDocument(QJsonObject{{"log", log}}).toJson(QJsonDocument::Indented);
+}
+
+bool NetworkTrace::exportHar(const QString& path) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::error("Can't write network trace to {}: {}", path.toStdString(),
+                      file.errorString().toStdString());
+        return false;
+    }
+    file.write(toHar());
+    if (!file.commit()) {
+        spdlog::error("Can't write network trace to {}: {}", path.toStdString(),
+                      file.errorString().toStdString());
+        return false;
+    }
+    spdlog::info("Network trace exported to {}", path.toStdString());
+    return true;
+}
+
+} // namespace lotro
@@ -0,0 +1,99 @@
+/**
+ * LOTRO Launcher - Network Trace
+ * 
+ * Per-request timings of the launcher's network traffic.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+#include <QNetworkRequest>
+#include <QString>
+#include <QUrl>
+
+#include <vector>
+
+class QNetworkReply;
+
+namespace lotro {
+
+/**
+ * One finished request and where its time went
+ * 
+ * Phases are in milliseconds and -1 when they didn't happen, as on a
+ * reused connection. Qt resolves the host and runs the TLS handshake
+ * inside its connect, so connect covers DNS, TCP and TLS together.
+ */
+struct NetworkTraceEntry {
+    QString source;                     // SOAP, Worlds, Patcher, Addons, or the host
+    QByteArray method;
+    QUrl url;
+    qint64 startedAt = 0;               // Milliseconds since epoch
+    int status = 0;                     // HTTP status, 0 if no response came
+    QString error;                      // Empty on success
+    qint64 requestBytes = 0;
+    qint64 responseBytes = 0;
+    bool reusedConnection = false;
+    bool http2 = false;
+    
+    qint64 blocked = -1;                // Queued for a free connection
+    qint64 connect = -1;                // DNS, TCP and TLS
+    qint64 send = -1;
+    qint64 wait = -1;                   // Request sent to first response header
+    qint64 receive = -1;
+    qint64 total = 0;
+};
+
+/**
+ * Ring buffer of the last requests made through HttpClient's managers
+ * 
+ * Every reply from HttpClient::manager() is watched from creation to
+ * finish without the caller doing anything; callers only tag requests
+ * with a source so the list reads by subsystem. Recording is a handful
+ * of timestamps per request and one locked copy when it finishes, so it
+ * stays on in release builds. No headers or bodies are kept, as they
+ * carry credentials and session tickets. toHar() writes the entries in
+ * the HTTP Archive format so they open in browser devtools and HAR
+ * viewers.
+ */
+class NetworkTrace {
+public:
+    static NetworkTrace& instance();
+    
+    /**
+     * Name the subsystem a request comes from
+     */
+    static void tag(QNetworkRequest& request, const QString& source);
+    
+    /**
+     * Watch a reply until it finishes; called by the managers themselves
+     */
+    void attach(QNetworkReply* reply, qint64 requestBytes);
+    
+    /**
+     * Recorded requests, oldest first
+     */
+    std::vector<NetworkTraceEntry> entries() const;
+    void clear();
+    
+    QByteArray toHar() const;
+    bool exportHar(const QString& path) const;
+    
+    static constexpr size_t CAPACITY = 500;
+    static constexpr QNetworkRequest::Attribute SOURCE_ATTRIBUTE =
+        static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 1);
+    
+private:
+    NetworkTrace() = default;
+    
+    void record(NetworkTraceEntry entry);
+    
+    mutable QMutex m_mutex;
+    std::vector<NetworkTraceEntry> m_entries;
+    size_t m_next = 0;                  // Slot the next entry goes in once full
+};
+
+} // namespace lotro
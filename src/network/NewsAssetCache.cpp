@@ -0,0 +1,144 @@
+/**
+ * LOTRO Launcher - News Asset Cache Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "NewsAssetCache.hpp"
+#include "NewsfeedParser.hpp"
+#include "NetworkTrace.hpp"
+#include "core/Metrics.hpp"
+#include "core/TaskScheduler.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QNetworkRequest>
+#include <QUrl>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro {
+
+NewsAssetCache& NewsAssetCache::shared() {
+    static NewsAssetCache cache;
+    return cache;
+}
+
+NewsAssetCache::NewsAssetCache()
+    : m_disk(Platform::getCachePath() / "news-assets")
+{
+    m_memory.setMaxCost(MEMORY_BUDGET);
+    // Queued imageReady() connections need the receiver's thread, not ours
+    if (QCoreApplication::instance()) {
+        moveToThread(QCoreApplication::instance()->thread());
+    }
+}
+
+void NewsAssetCache::prefetch(const std::vector<NewsItem>& items) {
+    QStringList urls;
+    for (const NewsItem& item : items) {
+        if (!item.imageUrl.isEmpty()) {
+            urls << item.imageUrl;
+        }
+    }
+    prefetch(urls);
+}
+
+void NewsAssetCache::prefetch(const QStringList& urls) {
+    QMutexLocker lock(&m_mutex);
+    for (const QString& url : urls) {
+        if (url.isEmpty() || m_memory.contains(url) || m_pending.contains(url)) {
+            continue;
+        }
+        m_pending.insert(url);
+        m_queue.enqueue(url);
+    }
+    startNext();
+}
+
+std::optional<QImage> NewsAssetCache::image(const QString& url) const {
+    QMutexLocker lock(&m_mutex);
+    if (const QImage* image = m_memory.object(url)) {
+        return *image;
+    }
+    return std::nullopt;
+}
+
+void NewsAssetCache::startNext() {
+    while (!m_queue.isEmpty() && m_running < MAX_CONCURRENT) {
+        const QString url = m_queue.dequeue();
+        ++m_running;
+        TaskScheduler::instance().run(TaskPool::Io, [this, url]() {
+            QByteArray body = download(url);
+            downloadFinished();
+            if (body.isEmpty()) {
+                QMutexLocker lock(&m_mutex);
+                m_pending.remove(url);
+                return;
+            }
+            TaskScheduler::instance().run(TaskPool::Cpu, [this, url, body]() {
+                decode(url, body);
+            });
+        }, TaskPriority::Low);
+    }
+}
+
+QByteArray NewsAssetCache::download(const QString& url) {
+    const QUrl target(url);
+    auto stored = m_disk.lookup(target);
+    if (stored && QDateTime::currentMSecsSinceEpoch() - stored->storedAt < REVALIDATE_AFTER_MS) {
+        static metrics::Counter& diskHits = metrics::counter("news.asset_disk_hits");
+        diskHits.add();
+        return stored->body;
+    }
+    
+    QNetworkRequest request = HttpClient::request(target, 15000);
+    NetworkTrace::tag(request, "News");
+    HttpResponse response = m_disk.get(request);
+    if (!response.ok() || response.status != 200) {
+        spdlog::debug("News image {} unavailable: {}", url.toStdString(), response.errorString.toStdString());
+        // A stale copy still beats an empty card
+        return stored ? stored->body : QByteArray();
+    }
+    return response.body;
+}
+
+void NewsAssetCache::downloadFinished() {
+    bool drained = false;
+    {
+        QMutexLocker lock(&m_mutex);
+        --m_running;
+        startNext();
+        drained = m_running == 0 && m_queue.isEmpty();
+    }
+    if (drained) {
+        m_disk.trim(DISK_BUDGET);
+    }
+}
+
+void NewsAssetCache::decode(const QString& url, const QByteArray& body) {
+    QImage image = QImage::fromData(body);
+    if (!image.isNull() && image.width() > IMAGE_WIDTH) {
+        image = image.scaledToWidth(IMAGE_WIDTH, Qt::SmoothTransformation);
+    }
+    
+    {
+        QMutexLocker lock(&m_mutex);
+        m_pending.remove(url);
+        if (image.isNull()) {
+            spdlog::debug("News image {} could not be decoded", url.toStdString());
+            return;
+        }
+        m_memory.insert(url, new QImage(image), std::max<qint64>(1, image.sizeInBytes()));
+    }
+    
+    QMetaObject::invokeMethod(this, [this, url, image]() {
+        emit imageReady(url, image);
+    }, Qt::QueuedConnection);
+}
+
+} // namespace lotro
@@ -0,0 +1,90 @@
+/**
+ * LOTRO Launcher - News Asset Cache
+ * 
+ * Images referenced by the newsfeed, fetched ahead of the news cards.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "HttpCache.hpp"
+
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+#include <vector>
+
+namespace lotro {
+
+struct NewsItem;
+
+/**
+ * Prefetches and decodes newsfeed images
+ * 
+ * fetchNewsfeed() hands the image URLs over as soon as the feed is
+ * parsed, so downloads overlap the hop back to the GUI thread and the
+ * card layout. Up to MAX_CONCURRENT downloads run on the I/O pool; each
+ * body is decoded and scaled to card width on the CPU pool and kept in
+ * a memory cache bounded by decoded bytes. Bodies are also kept on disk
+ * in an HttpCache, keyed by URL and revalidated with their ETag once
+ * older than REVALIDATE_AFTER_MS, and the directory is trimmed to
+ * DISK_BUDGET when a batch finishes. All methods may be called from any
+ * thread; imageReady() is delivered on the GUI thread.
+ */
+class NewsAssetCache : public QObject {
+    Q_OBJECT
+    
+public:
+    static NewsAssetCache& shared();
+    
+    /**
+     * Queue the items' images that are neither cached in memory nor on their way
+     */
+    void prefetch(const std::vector<NewsItem>& items);
+    void prefetch(const QStringList& urls);
+    
+    /**
+     * Decoded image if it is in memory; otherwise wait for imageReady()
+     */
+    std::optional<QImage> image(const QString& url) const;
+    
+    static constexpr int MAX_CONCURRENT = 4;
+    static constexpr int IMAGE_WIDTH = 480;                 // Wider images are scaled down
+    static constexpr qint64 MEMORY_BUDGET = 16 * 1024 * 1024;
+    static constexpr qint64 DISK_BUDGET = 32 * 1024 * 1024;
+    static constexpr qint64 REVALIDATE_AFTER_MS = 6 * 60 * 60 * 1000;
+    
+signals:
+    void imageReady(const QString& url, const QImage& image);
+    
+private:
+    NewsAssetCache();
+    
+    // Start queued downloads while there is room; call with m_mutex held
+    void startNext();
+    
+    // Runs on the I/O pool: the stored body, revalidated if stale
+    QByteArray download(const QString& url);
+    void downloadFinished();
+    
+    // Runs on the CPU pool
+    void decode(const QString& url, const QByteArray& body);
+    
+    HttpCache m_disk;
+    
+    mutable QMutex m_mutex;
+    QCache<QString, QImage> m_memory;       // Cost in bytes
+    QQueue<QString> m_queue;
+    QSet<QString> m_pending;                // Queued, downloading or decoding
+    int m_running = 0;
+};
+
+} // namespace lotro
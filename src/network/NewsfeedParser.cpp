@@ -5,6 +5,11 @@
  */
 
 #include "NewsfeedParser.hpp"
+#include "FeedDate.hpp"
+#include "HttpCache.hpp"
+#include "HttpClient.hpp"
+#include "NewsAssetCache.hpp"
+#include "core/TaskScheduler.hpp"
 
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
@@ -13,51 +18,33 @@
 #include <QXmlStreamReader>
 #include <QDateTime>
 #include <QRegularExpression>
-#include <QtConcurrent>
-#include <QEventLoop>
-#include <QTimer>
 
 #include <spdlog/spdlog.h>
 
+#include <optional>
+
 namespace lotro {
 
 namespace {
 
-std::chrono::system_clock::time_point parseDate(const QString& dateStr) {
-    // Try various date formats
-    QDateTime dt;
-    
-    // RFC 2822 (common in RSS)
-    dt = QDateTime::fromString(dateStr, Qt::RFC2822Date);
-    if (dt.isValid()) {
-        return std::chrono::system_clock::from_time_t(dt.toSecsSinceEpoch());
-    }
-    
-    // ISO 8601 (common in Atom)
-    dt = QDateTime::fromString(dateStr, Qt::ISODate);
-    if (dt.isValid()) {
-        return std::chrono::system_clock::from_time_t(dt.toSecsSinceEpoch());
-    }
-    
-    // Custom formats
-    QStringList formats = {
-        "yyyy-MM-ddTHH:mm:ss",
-        "yyyy-MM-dd HH:mm:ss",
-        "ddd, dd MMM yyyy HH:mm:ss",
-        "dd MMM yyyy HH:mm:ss"
-    };
-    
-    for (const auto& format : formats) {
-        dt = QDateTime::fromString(dateStr, format);
-        if (dt.isValid()) {
-            return std::chrono::system_clock::from_time_t(dt.toSecsSinceEpoch());
-        }
+/**
+ * Parse a feed date, the current time if it can't be read
+ */
+std::chrono::system_clock::time_point parseDate(const QString& dateStr, FeedDateFormat& format) {
+    if (const auto seconds = parseFeedDate(dateStr, format)) {
+        return std::chrono::system_clock::from_time_t(*seconds);
     }
-    
-    // Return current time if parsing fails
     return std::chrono::system_clock::now();
 }
 
+// First <img src="..."> in an HTML description
+QString firstImageSource(const QString& html) {
+    static const QRegularExpression img(R"(<img\b[^>]*\bsrc\s*=\s*["']([^"']+)["'])",
+                                        QRegularExpression::CaseInsensitiveOption);
+    QRegularExpressionMatch match = img.match(html);
+    return match.hasMatch() ? match.captured(1).replace("&amp;", "&") : QString();
+}
+
 QString stripHtml(const QString& html) {
     QString result = html;
     
@@ -97,6 +84,7 @@ std::vector<NewsItem> parseNewsfeed(const QString& content, int maxItems) {
     NewsItem current;
     bool inItem = false;
     bool isAtom = false;
+    FeedDateFormat dateFormat = FeedDateFormat::Unknown;
     
     while (!reader.atEnd() && (maxItems == 0 || static_cast<int>(items.size()) < maxItems)) {
         reader.readNext();
@@ -150,7 +138,7 @@ std::vector<NewsItem> parseNewsfeed(const QString& content, int maxItems) {
                     }
                     current.author = authorText;
                 } else if (name == "pubdate" || name == "published" || name == "updated") {
-                    current.publishedDate = parseDate(reader.readElementText());
+                    current.publishedDate = parseDate(reader.readElementText(), dateFormat);
                 } else if (name == "enclosure" || name == "media:thumbnail") {
                     current.imageUrl = reader.attributes().value("url").toString();
                 }
@@ -159,6 +147,9 @@ std::vector<NewsItem> parseNewsfeed(const QString& content, int maxItems) {
             QString name = reader.name().toString().toLower();
             if (name == "item" || name == "entry") {
                 if (!current.title.isEmpty()) {
+                    if (current.imageUrl.isEmpty()) {
+                        current.imageUrl = firstImageSource(current.description);
+                    }
                     items.push_back(current);
                 }
                 inItem = false;
@@ -175,59 +166,54 @@ std::vector<NewsItem> parseNewsfeed(const QString& content, int maxItems) {
 }
 
 QFuture<std::vector<NewsItem>> fetchNewsfeed(const QString& feedUrl, int maxItems) {
-    return QtConcurrent::run([feedUrl, maxItems]() -> std::vector<NewsItem> {
+    return TaskScheduler::instance().run(TaskPool::Io, [feedUrl, maxItems]() -> std::vector<NewsItem> {
         try {
             spdlog::info("Fetching newsfeed from: {}", feedUrl.toStdString());
             
-            QNetworkAccessManager manager;
-            QNetworkRequest request(feedUrl);
-            request.setHeader(QNetworkRequest::UserAgentHeader, "LOTRO-Launcher/1.0");
+            QNetworkRequest request = HttpClient::request(QUrl(feedUrl), 15000);
             
             // Configure SSL to ignore certificate errors (common on Linux)
             QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
             sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
             request.setSslConfiguration(sslConfig);
             
-            // Allow all redirects unconditionally
+            // Follow redirects unconditionally, including HTTPS to HTTP
             request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, 
                                  QNetworkRequest::UserVerifiedRedirectPolicy);
+            HttpCache& cache = HttpCache::shared();
+            cache.prepare(request);
+            QNetworkReply* pending = HttpClient::manager()->get(request);
+            QObject::connect(pending, &QNetworkReply::redirected,
+                             pending, &QNetworkReply::redirectAllowed);
             
-            QEventLoop loop;
-            QNetworkReply* reply = manager.get(request);
-            
-            // Handle redirects manually (allows any redirect type)
-            QObject::connect(reply, &QNetworkReply::redirected,
-                [](const QUrl&) { /* Accept all redirects */ });
-            
-            QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+            HttpResponse reply = HttpClient::wait(pending);
+            cache.update(request.url(), reply);
             
-            QTimer timer;
-            timer.setSingleShot(true);
-            QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-            timer.start(15000);
-            
-            loop.exec();
-            
-            if (!timer.isActive()) {
+            if (reply.timedOut()) {
                 spdlog::warn("Newsfeed request timed out");
-                reply->deleteLater();
                 return {};
             }
-            timer.stop();
             
-            if (reply->error() != QNetworkReply::NoError) {
+            if (!reply.ok()) {
                 spdlog::warn("Newsfeed request failed: {}", 
-                            reply->errorString().toStdString());
-                reply->deleteLater();
+                            reply.errorString.toStdString());
                 return {};
             }
             
-            QString content = QString::fromUtf8(reply->readAll());
-            reply->deleteLater();
+            QString content = QString::fromUtf8(reply.body);
             
             auto items = parseNewsfeed(content, maxItems);
             spdlog::info("Parsed {} news items", items.size());
             
+            // Start on the images before the cards are even laid out
+            const QUrl base(feedUrl);
+            for (NewsItem& item : items) {
+                if (!item.imageUrl.isEmpty()) {
+                    item.imageUrl = base.resolved(QUrl(item.imageUrl)).toString();
+                }
+            }
+            NewsAssetCache::shared().prefetch(items);
+            
             return items;
             
         } catch (const std::exception& e) {
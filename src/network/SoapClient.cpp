@@ -5,11 +5,17 @@
  */
 
 #include "SoapClient.hpp"
+#include "HttpClient.hpp"
+#include "NetworkTrace.hpp"
 
+#include <QCoreApplication>
+#include <QHash>
+#include <QMutex>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
-#include <QtConcurrent>
+#include <QPromise>
+#include <QThread>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
@@ -20,136 +26,231 @@ namespace lotro {
 namespace {
     // SOAP envelope templates
     constexpr const char* SOAP_ENVELOPE_START = R"(<?xml version="1.0" encoding="utf-8"?>
-<soap:Envelope xmlns:soap="http://schemas.xmlsoap.org/soap/envelope/" 
-               xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance" 
+<soap:Envelope xmlns:soap="http://schemas.xmlsoap.org/soap/envelope/"
+               xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance"
                xmlns:xsd="http://www.w3.org/2001/XMLSchema">
 <soap:Body>
 )";
-    
+
     constexpr const char* SOAP_ENVELOPE_END = R"(
 </soap:Body>
 </soap:Envelope>)";
-    
+
     // GLS namespace
     constexpr const char* GLS_NAMESPACE = "http://www.turbine.com/SE/GLS";
+    
+    /**
+     * Everything in a request but the parameters, for one operation
+     */
+    struct Envelope {
+        QByteArray head;
+        QByteArray tail;
+        QByteArray action;
+    };
+    
+    Envelope envelopeFor(const QString& operation) {
+        static QMutex mutex;
+        static QHash<QString, Envelope> envelopes;
+        
+        QMutexLocker lock(&mutex);
+        auto it = envelopes.constFind(operation);
+        if (it != envelopes.constEnd()) {
+            return *it;
+        }
+        
+        const QByteArray name = operation.toUtf8();
+        Envelope envelope;
+        envelope.head = QByteArray(SOAP_ENVELOPE_START) + '<' + name + " xmlns=\"" + GLS_NAMESPACE + "\">";
+        envelope.tail = "</" + name + '>' + SOAP_ENVELOPE_END;
+        envelope.action = '"' + QByteArray(GLS_NAMESPACE) + '/' + name + '"';
+        envelopes.insert(operation, envelope);
+        return envelope;
+    }
+    
+    /**
+     * Incremental reader for a SOAP response
+     * 
+     * Fed as the reply arrives; finds the span of the Body's contents and
+     * any fault without building a tree or searching the text.
+     */
+    class ResponseParser {
+    public:
+        void addData(const QByteArray& data) {
+            if (data.isEmpty()) {
+                return;
+            }
+            m_data += data;
+            m_reader.addData(data);
+            
+            while (!m_reader.atEnd()) {
+                m_reader.readNext();
+                if (m_reader.isStartElement()) {
+                    ++m_depth;
+                    m_element = m_reader.name().toString();
+                    if (m_bodyDepth < 0 && m_element == "Body") {
+                        m_bodyDepth = m_depth;
+                        m_bodyStart = m_reader.characterOffset();
+                    } else if (m_depth == m_bodyDepth + 1 && m_element == "Fault") {
+                        m_fault = true;
+                    }
+                } else if (m_reader.isCharacters() && m_fault) {
+                    if (m_element == "faultstring") {
+                        m_faultString += m_reader.text();
+                    } else if (m_element == "Message") {
+                        m_faultMessage += m_reader.text();
+                    }
+                } else if (m_reader.isEndElement()) {
+                    if (m_depth == m_bodyDepth && m_bodyEnd < 0) {
+                        // The offset is past "</prefix:Body>"
+                        m_bodyEnd = m_reader.characterOffset() - m_reader.qualifiedName().size() - 3;
+                    }
+                    --m_depth;
+                    m_element.clear();
+                }
+            }
+        }
+        
+        bool isFault() const { return m_fault; }
+        
+        QString faultMessage() const {
+            if (!m_faultString.trimmed().isEmpty()) {
+                return m_faultString.trimmed();
+            }
+            return m_faultMessage.trimmed();
+        }
+        
+        /**
+         * Contents of the Body, or the whole response if it has none
+         */
+        QString body() const {
+            const QString text = QString::fromUtf8(m_data);
+            if (m_bodyStart < 0 || m_bodyEnd < m_bodyStart) {
+                if (!text.isEmpty()) {
+                    spdlog::warn("No SOAP Body found in response");
+                }
+                return text;
+            }
+            return text.mid(m_bodyStart, m_bodyEnd - m_bodyStart).trimmed();
+        }
+    
+    private:
+        QXmlStreamReader m_reader;
+        QByteArray m_data;
+        QString m_element;
+        QString m_faultString;
+        QString m_faultMessage;
+        int m_depth = 0;
+        int m_bodyDepth = -1;
+        qint64 m_bodyStart = -1;
+        qint64 m_bodyEnd = -1;
+        bool m_fault = false;
+    };
+    
+    /**
+     * Object on the thread every SOAP request is made from
+     * 
+     * Its network manager outlives the calls, so connections to the GLS
+     * servers stay open between them. Stopped when the application quits.
+     */
+    QObject* transport() {
+        static QObject* worker = []() {
+            auto* thread = new QThread;
+            thread->setObjectName("SoapTransport");
+            auto* object = new QObject;
+            object->moveToThread(thread);
+            QObject::connect(thread, &QThread::finished, object, &QObject::deleteLater);
+            if (QCoreApplication* app = QCoreApplication::instance()) {
+                QObject::connect(app, &QCoreApplication::aboutToQuit, thread, [thread]() {
+                    thread->quit();
+                    thread->wait();
+                }, Qt::DirectConnection);
+            }
+            thread->start();
+            return object;
+        }();
+        return worker;
+    }
+    
+    /**
+     * Post a request on the transport thread and resolve the promise from it
+     */
+    void post(const QNetworkRequest& request, const QByteArray& envelope,
+              const QString& operation, std::shared_ptr<QPromise<QString>> promise) {
+        QNetworkReply* reply = HttpClient::manager()->post(request, envelope);
+        auto parser = std::make_shared<ResponseParser>();
+        
+        QObject::connect(reply, &QNetworkReply::readyRead, reply, [reply, parser]() {
+            parser->addData(reply->readAll());
+        });
+        QObject::connect(reply, &QNetworkReply::finished, reply, [reply, parser, operation, promise]() {
+            reply->deleteLater();
+            parser->addData(reply->readAll());
+            
+            // A fault usually comes with a 500, so check for it first
+            if (parser->isFault()) {
+                const QString message = parser->faultMessage();
+                spdlog::warn("SOAP fault from {}: {}", operation.toStdString(), message.toStdString());
+                promise->setException(std::make_exception_ptr(SoapFault(message.toStdString())));
+            } else if (reply->error() == QNetworkReply::OperationCanceledError) {
+                spdlog::error("SOAP request timed out");
+                promise->setException(std::make_exception_ptr(SoapError("Request timed out")));
+            } else if (reply->error() != QNetworkReply::NoError) {
+                spdlog::error("SOAP request failed: {}", reply->errorString().toStdString());
+                promise->setException(std::make_exception_ptr(SoapError(reply->errorString().toStdString())));
+            } else {
+                const QString body = parser->body();
+                spdlog::debug("SOAP response to {} received, body length: {}",
+                              operation.toStdString(), body.length());
+                promise->addResult(body);
+            }
+            promise->finish();
+        });
+    }
 }
 
 class SoapClient::Impl {
 public:
-    explicit Impl(const QString& serviceUrl) 
+    explicit Impl(const QString& serviceUrl)
         : m_serviceUrl(serviceUrl)
-        , m_networkManager(new QNetworkAccessManager())
-        , m_timeout(30000) // 30 seconds default
+        , m_timeout(HttpClient::DEFAULT_TIMEOUT_MS)
     {
         spdlog::debug("SoapClient created for: {}", serviceUrl.toStdString());
     }
     
     ~Impl() = default;
     
-    QFuture<QString> call(const QString& operation, const QString& params) {
-        return QtConcurrent::run([this, operation, params]() -> QString {
-            return executeCall(operation, params);
-        });
-    }
-    
-    void setTimeout(int milliseconds) {
-        m_timeout = milliseconds;
-    }
-    
-private:
-    QString executeCall(const QString& operation, const QString& params) {
-        // Build SOAP request
-        QString soapBody = QString(SOAP_ENVELOPE_START);
-        soapBody += QString("<%1 xmlns=\"%2\">").arg(operation, GLS_NAMESPACE);
-        soapBody += params;
-        soapBody += QString("</%1>").arg(operation);
-        soapBody += SOAP_ENVELOPE_END;
+    QFuture<QString> call(const QString& operation, const QByteArray& params) {
+        const Envelope envelope = envelopeFor(operation);
+        QByteArray body;
+        body.reserve(envelope.head.size() + params.size() + envelope.tail.size());
+        body += envelope.head;
+        body += params;
+        body += envelope.tail;
         
-        spdlog::debug("SOAP Request to {}: {}", m_serviceUrl.toStdString(), 
+        spdlog::debug("SOAP Request to {}: {}", m_serviceUrl.toStdString(),
                       operation.toStdString());
         
-        // Create request
-        QNetworkRequest request(m_serviceUrl);
-        request.setHeader(QNetworkRequest::ContentTypeHeader, 
+        QNetworkRequest request = HttpClient::request(QUrl(m_serviceUrl), m_timeout);
+        request.setHeader(QNetworkRequest::ContentTypeHeader,
                          "text/xml; charset=utf-8");
-        request.setRawHeader("SOAPAction", 
-                            QString("\"%1/%2\"").arg(GLS_NAMESPACE, operation).toUtf8());
+        request.setRawHeader("SOAPAction", envelope.action);
+        NetworkTrace::tag(request, "SOAP");
         
-        // Execute request synchronously using event loop
-        QEventLoop loop;
-        QNetworkReply* reply = m_networkManager->post(request, soapBody.toUtf8());
-        
-        QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        
-        // Timeout handling
-        QTimer timer;
-        timer.setSingleShot(true);
-        QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-        timer.start(m_timeout);
-        
-        loop.exec();
-        
-        if (!timer.isActive()) {
-            spdlog::error("SOAP request timed out");
-            reply->deleteLater();
-            throw SoapError("Request timed out");
-        }
-        
-        timer.stop();
-        
-        if (reply->error() != QNetworkReply::NoError) {
-            QString errorMsg = reply->errorString();
-            spdlog::error("SOAP request failed: {}", errorMsg.toStdString());
-            reply->deleteLater();
-            throw SoapError(errorMsg.toStdString());
-        }
-        
-        QString response = QString::fromUtf8(reply->readAll());
-        reply->deleteLater();
-        
-        spdlog::debug("SOAP Response received, length: {}", response.length());
-        
-        // Extract body from SOAP envelope
-        return extractSoapBody(response);
+        auto promise = std::make_shared<QPromise<QString>>();
+        QFuture<QString> future = promise->future();
+        promise->start();
+        QMetaObject::invokeMethod(transport(), [request, body, operation, promise]() {
+            post(request, body, operation, promise);
+        });
+        return future;
     }
     
-    QString extractSoapBody(const QString& soapResponse) {
-        // Find the inner content of the SOAP Body
-        // We need to extract everything inside <soap:Body>...</soap:Body>
-        
-        // Simple regex-like approach using indexOf
-        int bodyStart = soapResponse.indexOf("<soap:Body>");
-        if (bodyStart == -1) {
-            bodyStart = soapResponse.indexOf("<Body>");
-        }
-        
-        if (bodyStart == -1) {
-            spdlog::warn("No SOAP Body found in response");
-            return soapResponse;
-        }
-        
-        // Move past the opening tag
-        int contentStart = soapResponse.indexOf(">", bodyStart) + 1;
-        
-        int bodyEnd = soapResponse.indexOf("</soap:Body>");
-        if (bodyEnd == -1) {
-            bodyEnd = soapResponse.indexOf("</Body>");
-        }
-        
-        if (bodyEnd == -1 || bodyEnd <= contentStart) {
-            spdlog::warn("Malformed SOAP Body");
-            return soapResponse;
-        }
-        
-        QString bodyContent = soapResponse.mid(contentStart, bodyEnd - contentStart).trimmed();
-        
-        spdlog::debug("Extracted SOAP body content length: {}", bodyContent.length());
-        
-        return bodyContent;
+    void setTimeout(int milliseconds) {
+        m_timeout = milliseconds;
     }
-    
+
+private:
     QString m_serviceUrl;
-    std::unique_ptr<QNetworkAccessManager> m_networkManager;
     int m_timeout;
 };
 
@@ -160,8 +261,17 @@ SoapClient::SoapClient(const QString& serviceUrl)
 
 SoapClient::~SoapClient() = default;
 
+QFuture<QString> SoapClient::call(const QString& operation, const Params& params) {
+    QByteArray xml;
+    QXmlStreamWriter writer(&xml);
+    for (const auto& [name, value] : params) {
+        writer.writeTextElement(name, value);
+    }
+    return m_impl->call(operation, xml);
+}
+
 QFuture<QString> SoapClient::call(const QString& operation, const QString& params) {
-    return m_impl->call(operation, params);
+    return m_impl->call(operation, params.toUtf8());
 }
 
 void SoapClient::setTimeout(int milliseconds) {
@@ -9,11 +9,15 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <QFuture>
+#include <QList>
 #include <QString>
 
 namespace lotro {
@@ -23,17 +27,40 @@ namespace lotro {
  */
 class SoapError : public std::runtime_error {
 public:
-    explicit SoapError(const std::string& message) 
+    explicit SoapError(const std::string& message)
         : std::runtime_error(message) {}
 };
 
+/**
+ * SOAP fault returned by the service
+ * 
+ * what() is the fault string, or the GLS detail message if it has none.
+ */
+class SoapFault : public SoapError {
+public:
+    explicit SoapFault(const std::string& message)
+        : SoapError(message) {}
+};
+
 /**
  * SOAP client for LOTRO/DDO authentication
  * 
  * Handles communication with Standing Stone Games' GLS (Game Launcher Service)
+ * 
+ * Calls don't block any thread: every client hands its requests to one
+ * transport thread whose network manager keeps the connections to the GLS
+ * servers open between calls, so any number of calls can be in flight at
+ * once and a follow-up call skips the TCP and TLS handshakes. Envelopes
+ * are built once per operation and only the parameters are written per
+ * call. Responses are parsed as they arrive; the future resolves with the
+ * contents of the soap:Body, or fails with SoapFault or SoapError.
+ * 
+ * A client can be destroyed while its calls are still running.
  */
 class SoapClient {
 public:
+    using Params = QList<std::pair<QString, QString>>;
+    
     /**
      * Create a SOAP client for the specified service URL
      * 
@@ -46,8 +73,13 @@ public:
      * Perform a SOAP call
      * 
      * @param operation SOAP operation name
-     * @param params Parameters as XML string
-     * @return Response XML string
+     * @param params Parameter elements, in order; their text is escaped
+     * @return Response XML inside the SOAP Body
+     */
+    QFuture<QString> call(const QString& operation, const Params& params);
+    
+    /**
+     * Perform a SOAP call with parameters given as raw XML
      */
     QFuture<QString> call(const QString& operation, const QString& params);
     
@@ -55,7 +87,7 @@ public:
      * Set timeout for requests
      */
     void setTimeout(int milliseconds);
-    
+
 private:
     class Impl;
     std::unique_ptr<Impl> m_impl;
@@ -0,0 +1,166 @@
+/**
+ * LOTRO Launcher - Startup Snapshot Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "StartupSnapshot.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+namespace lotro {
+
+namespace {
+
+void write(QDataStream& out, const WorldInfo& info) {
+    out << info.name << info.statusUrl << info.chatServerUrl
+        << qint32(info.order) << info.language;
+}
+
+void read(QDataStream& in, WorldInfo& info) {
+    qint32 order = 0;
+    in >> info.name >> info.statusUrl >> info.chatServerUrl >> order >> info.language;
+    info.order = order;
+}
+
+void write(QDataStream& out, const GameServicesInfo& info) {
+    out << info.authServer << info.patchServer << info.launcherConfigUrl
+        << info.newsUrl << info.supportUrl << info.datacenterName
+        << info.datacenterGameName << info.datacenterServiceUrl
+        << quint32(info.worlds.size());
+    for (const auto& world : info.worlds) {
+        write(out, world);
+    }
+}
+
+void read(QDataStream& in, GameServicesInfo& info) {
+    quint32 count = 0;
+    in >> info.authServer >> info.patchServer >> info.launcherConfigUrl
+       >> info.newsUrl >> info.supportUrl >> info.datacenterName
+       >> info.datacenterGameName >> info.datacenterServiceUrl >> count;
+    info.worlds.clear();
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        read(in, info.worlds.emplace_back());
+    }
+}
+
+void write(QDataStream& out, const World& world) {
+    out << world.name << world.displayName << world.statusUrl << world.queueUrl
+        << world.loginServer << qint32(world.status) << qint32(world.order)
+        << world.language << world.isPreferred;
+}
+
+void read(QDataStream& in, World& world) {
+    qint32 status = 0, order = 0;
+    in >> world.name >> world.displayName >> world.statusUrl >> world.queueUrl
+       >> world.loginServer >> status >> order >> world.language >> world.isPreferred;
+    world.status = (status >= 0 && status <= qint32(WorldStatus::Unknown))
+        ? static_cast<WorldStatus>(status) : WorldStatus::Unknown;
+    world.order = order;
+}
+
+void write(QDataStream& out, const NewsItem& item) {
+    const qint64 published = std::chrono::duration_cast<std::chrono::milliseconds>(
+        item.publishedDate.time_since_epoch()).count();
+    out << item.title << item.description << item.link << item.author
+        << published << item.imageUrl;
+}
+
+void read(QDataStream& in, NewsItem& item) {
+    qint64 published = 0;
+    in >> item.title >> item.description >> item.link >> item.author
+       >> published >> item.imageUrl;
+    item.publishedDate = std::chrono::system_clock::time_point(
+        std::chrono::milliseconds(published));
+}
+
+} // namespace
+
+QString StartupSnapshot::filePath(const QString& gameId) {
+    const QString directory = QString::fromStdString((Platform::getCachePath() / "startup").string());
+    return QDir(directory).filePath(gameId.toLower() + ".snapshot");
+}
+
+std::optional<StartupSnapshot> StartupSnapshot::load(const QString& gameId) {
+    const QString path = filePath(gameId);
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("Startup snapshot {} is outdated, ignoring it", path.toStdString());
+        return std::nullopt;
+    }
+    
+    StartupSnapshot snapshot;
+    bool hasServices = false;
+    quint32 worldCount = 0, newsCount = 0;
+    in >> snapshot.savedAt >> hasServices;
+    if (hasServices) {
+        read(in, snapshot.servicesInfo.emplace());
+    }
+    in >> worldCount;
+    for (quint32 i = 0; i < worldCount && in.status() == QDataStream::Ok; ++i) {
+        read(in, snapshot.worlds.emplace_back());
+    }
+    in >> newsCount;
+    for (quint32 i = 0; i < newsCount && in.status() == QDataStream::Ok; ++i) {
+        read(in, snapshot.news.emplace_back());
+    }
+    
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Startup snapshot {} is corrupt, ignoring it", path.toStdString());
+        return std::nullopt;
+    }
+    return snapshot;
+}
+
+bool StartupSnapshot::save(const QString& gameId) {
+    const QString path = filePath(gameId);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write startup snapshot {}: {}", path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    
+    savedAt = QDateTime::currentMSecsSinceEpoch();
+    
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << savedAt << servicesInfo.has_value();
+    if (servicesInfo) {
+        write(out, *servicesInfo);
+    }
+    out << quint32(worlds.size());
+    for (const auto& world : worlds) {
+        write(out, world);
+    }
+    out << quint32(news.size());
+    for (const auto& item : news) {
+        write(out, item);
+    }
+    
+    if (!file.commit()) {
+        spdlog::warn("Failed to commit startup snapshot {}", path.toStdString());
+        return false;
+    }
+    return true;
+}
+
+} // namespace lotro
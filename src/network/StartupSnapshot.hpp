@@ -0,0 +1,52 @@
+/**
+ * LOTRO Launcher - Startup Snapshot
+ * 
+ * Last-known game services info, world list and newsfeed, shown at
+ * startup while the live copies are fetched.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "GameServicesInfo.hpp"
+#include "NewsfeedParser.hpp"
+#include "WorldList.hpp"
+
+#include <QString>
+
+#include <optional>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * What the main window last showed for a game
+ * 
+ * Saved whenever fresh data arrives and loaded before anything goes out
+ * on the network, so the server list, news and the login endpoints are
+ * there at once and the live responses are only diffed in. Any part may
+ * be empty; a missing or outdated file loads as nothing. One small file
+ * per game under the platform cache path.
+ */
+struct StartupSnapshot {
+    std::optional<GameServicesInfo> servicesInfo;
+    std::vector<World> worlds;          // With their last-known status
+    std::vector<NewsItem> news;
+    qint64 savedAt = 0;                 // Milliseconds since epoch
+    
+    bool isEmpty() const {
+        return !servicesInfo && worlds.empty() && news.empty();
+    }
+    
+    static std::optional<StartupSnapshot> load(const QString& gameId);
+    bool save(const QString& gameId);
+
+private:
+    static QString filePath(const QString& gameId);
+    
+    static constexpr quint32 MAGIC = 0x4853534C;    // "LSSH"
+    static constexpr quint32 VERSION = 1;
+};
+
+} // namespace lotro
@@ -0,0 +1,163 @@
+/**
+ * LOTRO Launcher - World Latency Probe Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "WorldLatencyProbe.hpp"
+
+#include <QDateTime>
+#include <QMutex>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace lotro {
+
+namespace {
+
+struct CacheEntry {
+    int milliseconds = -1;
+    qint64 measuredAt = 0;              // Milliseconds since epoch
+};
+
+QMutex cacheMutex;
+QHash<QString, CacheEntry> latencyCache;
+
+} // anonymous namespace
+
+struct WorldLatencyProbe::Probe {
+    QString worldName;
+    QString loginServer;
+    QString host;
+    quint16 port = 0;
+    QTcpSocket* socket = nullptr;
+    QElapsedTimer clock;
+    int samples = 0;
+    int best = -1;
+};
+
+WorldLatencyProbe::WorldLatencyProbe(QObject* parent)
+    : QObject(parent)
+{
+}
+
+WorldLatencyProbe::~WorldLatencyProbe() {
+    cancel();
+}
+
+std::optional<int> WorldLatencyProbe::cached(const QString& loginServer) {
+    QMutexLocker lock(&cacheMutex);
+    auto it = latencyCache.constFind(loginServer);
+    if (it == latencyCache.constEnd() ||
+        QDateTime::currentMSecsSinceEpoch() - it->measuredAt > CACHE_TTL_MS) {
+        return std::nullopt;
+    }
+    return it->milliseconds;
+}
+
+void WorldLatencyProbe::start(const std::vector<World>& worlds) {
+    cancel();
+
+    for (const auto& world : worlds) {
+        if (world.loginServer.isEmpty()) {
+            continue;
+        }
+        if (const auto latency = cached(world.loginServer)) {
+            emit latencyMeasured(world.name, *latency);
+            continue;
+        }
+
+        // "address:port"
+        const int colon = world.loginServer.lastIndexOf(':');
+        bool ok = false;
+        const quint16 port = colon > 0 ? world.loginServer.mid(colon + 1).toUShort(&ok) : 0;
+        if (!ok) {
+            spdlog::warn("Can't probe login server of {}: {}", world.name.toStdString(),
+                         world.loginServer.toStdString());
+            emit latencyMeasured(world.name, -1);
+            continue;
+        }
+
+        auto* probe = new Probe;
+        probe->worldName = world.name;
+        probe->loginServer = world.loginServer;
+        probe->host = world.loginServer.left(colon);
+        probe->port = port;
+        m_probes.push_back(probe);
+    }
+
+    m_remaining = m_probes.size();
+    if (m_remaining == 0) {
+        emit finished();
+        return;
+    }
+    spdlog::debug("Probing latency of {} worlds", m_remaining);
+    for (Probe* probe : m_probes) {
+        sample(probe);
+    }
+}
+
+void WorldLatencyProbe::cancel() {
+    for (Probe* probe : m_probes) {
+        if (probe->socket) {
+            probe->socket->disconnect(this);
+            probe->socket->abort();
+            probe->socket->deleteLater();
+        }
+        delete probe;
+    }
+    m_probes.clear();
+    m_remaining = 0;
+}
+
+void WorldLatencyProbe::sample(Probe* probe) {
+    auto* socket = new QTcpSocket(this);
+    probe->socket = socket;
+
+    // Runs once per sample, whichever of connected, error or timeout comes first
+    auto done = [this, probe, socket](bool connected) {
+        if (probe->socket != socket) {
+            return;
+        }
+        if (connected) {
+            const int elapsed = static_cast<int>(probe->clock.elapsed());
+            probe->best = probe->best < 0 ? elapsed : std::min(probe->best, elapsed);
+        }
+        probe->socket = nullptr;
+        socket->disconnect(this);
+        socket->abort();
+        socket->deleteLater();
+
+        if (++probe->samples < SAMPLES) {
+            sample(probe);
+        } else {
+            complete(probe);
+        }
+    };
+
+    connect(socket, &QTcpSocket::connected, this, [done]() { done(true); });
+    connect(socket, &QAbstractSocket::errorOccurred, this, [done]() { done(false); });
+    QTimer::singleShot(CONNECT_TIMEOUT_MS, socket, [done]() { done(false); });
+
+    probe->clock.start();
+    socket->connectToHost(probe->host, probe->port);
+}
+
+void WorldLatencyProbe::complete(Probe* probe) {
+    if (probe->best >= 0) {
+        QMutexLocker lock(&cacheMutex);
+        latencyCache.insert(probe->loginServer, {probe->best, QDateTime::currentMSecsSinceEpoch()});
+    }
+    spdlog::debug("Latency of {}: {} ms", probe->worldName.toStdString(), probe->best);
+    emit latencyMeasured(probe->worldName, probe->best);
+
+    if (--m_remaining == 0) {
+        emit finished();
+    }
+}
+
+} // namespace lotro
@@ -0,0 +1,75 @@
+/**
+ * LOTRO Launcher - World Latency Probe
+ * 
+ * Round-trip time to each world's login server.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "WorldList.hpp"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+
+#include <optional>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Measures how far each world's login server is from here
+ * 
+ * The time to complete a TCP connect to the login server is one round
+ * trip, with no data exchanged. Every world is probed at once, each with
+ * a few connects one after another; the fastest sample is its latency,
+ * as queueing delays only ever add to it. Results are cached per login
+ * server for the process, so reopening the server list within the TTL
+ * costs nothing. Runs on the thread it lives on.
+ */
+class WorldLatencyProbe : public QObject {
+    Q_OBJECT
+
+public:
+    explicit WorldLatencyProbe(QObject* parent = nullptr);
+    ~WorldLatencyProbe() override;
+
+    /**
+     * Probe the worlds with a login server, abandoning any probe running
+     *
+     * Cached results are reported straight away, from this call.
+     */
+    void start(const std::vector<World>& worlds);
+    void cancel();
+
+    bool isRunning() const { return m_remaining > 0; }
+
+    /**
+     * Cached latency of a login server, if measured within the TTL
+     */
+    static std::optional<int> cached(const QString& loginServer);
+
+    static constexpr int SAMPLES = 3;
+    static constexpr int CONNECT_TIMEOUT_MS = 3000;
+    static constexpr qint64 CACHE_TTL_MS = 10 * 60 * 1000;
+
+signals:
+    /**
+     * A world's latency in milliseconds, or -1 if it could not be reached
+     */
+    void latencyMeasured(const QString& worldName, int milliseconds);
+    void finished();
+
+private:
+    struct Probe;
+
+    void sample(Probe* probe);
+    void complete(Probe* probe);
+
+    std::vector<Probe*> m_probes;
+    size_t m_remaining = 0;
+};
+
+} // namespace lotro
@@ -7,17 +7,25 @@
  */
 
 #include "WorldList.hpp"
+#include "HttpCache.hpp"
+#include "HttpClient.hpp"
+#include "NetworkTrace.hpp"
+#include "core/TaskScheduler.hpp"
 
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
-#include <QXmlStreamReader>
-#include <QtConcurrent>
-#include <QEventLoop>
+#include <QPromise>
+#include <QRandomGenerator>
 #include <QTimer>
+#include <QXmlStreamReader>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
 namespace lotro {
 
 namespace {
@@ -101,6 +109,48 @@ WorldStatusData parseWorldStatusXml(const QString& xml) {
     return data;
 }
 
+World worldFromInfo(const WorldInfo& worldInfo) {
+    World world;
+    world.name = worldInfo.name;
+    world.displayName = worldInfo.name;
+    world.statusUrl = worldInfo.statusUrl;
+    world.order = worldInfo.order;
+    world.language = worldInfo.language;
+    world.status = WorldStatus::Unknown;
+    return world;
+}
+
+// Fill in a world from its finished status reply
+void applyStatusReply(World& world, const HttpResponse& reply) {
+    if (!reply.ok()) {
+        spdlog::warn("Status request failed for {}: {}", 
+                    world.name.toStdString(),
+                    reply.errorString.toStdString());
+        world.status = WorldStatus::Offline;
+        return;
+    }
+    
+    QString response = QString::fromUtf8(reply.body);
+    if (response.isEmpty()) {
+        world.status = WorldStatus::Offline;
+        return;
+    }
+    
+    auto statusData = parseWorldStatusXml(response);
+    
+    if (statusData.available) {
+        world.status = WorldStatus::Online;
+        world.queueUrl = statusData.queueUrl;
+        world.loginServer = statusData.loginServer;
+    } else {
+        world.status = WorldStatus::Offline;
+    }
+    
+    spdlog::debug("  World {} status: {}", 
+                 world.name.toStdString(), 
+                 world.statusString().toStdString());
+}
+
 } // anonymous namespace
 
 QString World::statusString() const {
@@ -115,14 +165,8 @@ QString World::statusString() const {
 }
 
 QFuture<World> fetchWorldStatus(const WorldInfo& worldInfo) {
-    return QtConcurrent::run([worldInfo]() -> World {
-        World world;
-        world.name = worldInfo.name;
-        world.displayName = worldInfo.name;
-        world.statusUrl = worldInfo.statusUrl;
-        world.order = worldInfo.order;
-        world.language = worldInfo.language;
-        world.status = WorldStatus::Unknown;
+    return TaskScheduler::instance().run(TaskPool::Io, [worldInfo]() -> World {
+        World world = worldFromInfo(worldInfo);
         
         if (worldInfo.statusUrl.isEmpty()) {
             spdlog::warn("No status URL for world: {}", worldInfo.name.toStdString());
@@ -133,61 +177,18 @@ QFuture<World> fetchWorldStatus(const WorldInfo& worldInfo) {
         try {
             spdlog::debug("Fetching status for world: {}", worldInfo.name.toStdString());
             
-            QNetworkAccessManager manager;
-            QNetworkRequest request(worldInfo.statusUrl);
-            request.setHeader(QNetworkRequest::UserAgentHeader, "LOTRO-Launcher/1.0");
-            
-            QEventLoop loop;
-            QNetworkReply* reply = manager.get(request);
-            
-            QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+            QNetworkRequest request = HttpClient::request(QUrl(worldInfo.statusUrl),
+                                                          WorldStatusFetcher::DEFAULT_TIMEOUT_MS);
+            NetworkTrace::tag(request, "Worlds");
+            const HttpResponse response = HttpCache::shared().get(request);
             
-            QTimer timer;
-            timer.setSingleShot(true);
-            QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-            timer.start(10000); // 10 second timeout
-            
-            loop.exec();
-            
-            if (!timer.isActive()) {
+            if (response.timedOut()) {
                 spdlog::warn("Status request timed out for: {}", worldInfo.name.toStdString());
-                reply->deleteLater();
                 world.status = WorldStatus::Unknown;
                 return world;
             }
-            timer.stop();
-            
-            if (reply->error() != QNetworkReply::NoError) {
-                spdlog::warn("Status request failed for {}: {}", 
-                            worldInfo.name.toStdString(),
-                            reply->errorString().toStdString());
-                reply->deleteLater();
-                world.status = WorldStatus::Offline;
-                return world;
-            }
-            
-            QString response = QString::fromUtf8(reply->readAll());
-            reply->deleteLater();
-            
-            if (response.isEmpty()) {
-                world.status = WorldStatus::Offline;
-                return world;
-            }
-            
-            auto statusData = parseWorldStatusXml(response);
-            
-            if (statusData.available) {
-                world.status = WorldStatus::Online;
-                world.queueUrl = statusData.queueUrl;
-                world.loginServer = statusData.loginServer;
-            } else {
-                world.status = WorldStatus::Offline;
-            }
-            
-            spdlog::debug("  World {} status: {}", 
-                         world.name.toStdString(), 
-                         world.statusString().toStdString());
             
+            applyStatusReply(world, response);
             return world;
             
         } catch (const std::exception& e) {
@@ -199,44 +200,239 @@ QFuture<World> fetchWorldStatus(const WorldInfo& worldInfo) {
     });
 }
 
-QFuture<std::vector<World>> fetchWorldsWithStatus(const GameServicesInfo& servicesInfo) {
-    return QtConcurrent::run([servicesInfo]() -> std::vector<World> {
-        std::vector<World> worlds;
-        
-        spdlog::info("Fetching status for {} worlds", servicesInfo.worlds.size());
-        
-        // Fetch status for each world
-        // Note: We do this sequentially to avoid overwhelming the server
-        for (const auto& worldInfo : servicesInfo.worlds) {
-            auto future = fetchWorldStatus(worldInfo);
-            future.waitForFinished();
-            worlds.push_back(future.result());
+WorldStatusFetcher::WorldStatusFetcher(QObject* parent)
+    : QObject(parent)
+    , m_manager(HttpClient::manager())
+{
+}
+
+WorldStatusFetcher::~WorldStatusFetcher() {
+    cancel();
+}
+
+void WorldStatusFetcher::setMaxConcurrent(int requests) {
+    m_maxConcurrent = std::max(1, requests);
+}
+
+void WorldStatusFetcher::setTimeout(int milliseconds) {
+    m_timeout = milliseconds;
+}
+
+void WorldStatusFetcher::start(const std::vector<WorldInfo>& worlds) {
+    cancel();
+    m_infos = worlds;
+    m_results.clear();
+    m_results.reserve(worlds.size());
+    for (const auto& info : worlds) {
+        m_results.push_back(worldFromInfo(info));
+    }
+    m_next = 0;
+    m_remaining = worlds.size();
+    
+    spdlog::info("Fetching status for {} worlds, {} at a time", worlds.size(), m_maxConcurrent);
+    if (m_remaining == 0) {
+        emit finished(m_results);
+        return;
+    }
+    startNext();
+}
+
+void WorldStatusFetcher::cancel() {
+    // Detach first: abort() emits finished() synchronously
+    const auto running = std::exchange(m_running, {});
+    for (auto it = running.constBegin(); it != running.constEnd(); ++it) {
+        it.key()->disconnect(this);
+        it.key()->abort();
+        it.key()->deleteLater();
+    }
+    m_remaining = 0;
+}
+
+void WorldStatusFetcher::startNext() {
+    while (m_next < m_infos.size() && m_running.size() < m_maxConcurrent) {
+        const size_t index = m_next++;
+        const WorldInfo& info = m_infos[index];
+        if (info.statusUrl.isEmpty()) {
+            spdlog::warn("No status URL for world: {}", info.name.toStdString());
+            resolve(index, WorldStatus::Offline);
+            continue;
         }
         
-        // Sort by order
-        std::sort(worlds.begin(), worlds.end(), [](const World& a, const World& b) {
-            return a.order < b.order;
+        QNetworkRequest request = HttpClient::request(QUrl(info.statusUrl), m_timeout);
+        NetworkTrace::tag(request, "Worlds");
+        HttpCache::shared().prepare(request);
+        QNetworkReply* reply = m_manager->get(request);
+        m_running.insert(reply, index);
+        connect(reply, &QNetworkReply::finished, this, [this, reply, index]() {
+            if (m_running.remove(reply)) {
+                HttpResponse response = HttpClient::collect(reply);
+                HttpCache::shared().update(reply->request().url(), response);
+                resolve(index, WorldStatus::Unknown, &response);
+            }
+            reply->deleteLater();
         });
-        
-        spdlog::info("Fetched status for {} worlds, {} online", 
-                    worlds.size(),
-                    std::count_if(worlds.begin(), worlds.end(), 
-                                  [](const World& w) { return w.canLogin(); }));
-        
-        return worlds;
+    }
+}
+
+void WorldStatusFetcher::resolve(size_t index, WorldStatus status, const HttpResponse* response) {
+    World& world = m_results[index];
+    if (response && response->timedOut()) {
+        spdlog::warn("Status request timed out for: {}", world.name.toStdString());
+        world.status = WorldStatus::Unknown;
+    } else if (response) {
+        applyStatusReply(world, *response);
+    } else {
+        world.status = status;
+    }
+    emit worldResolved(world);
+    
+    if (--m_remaining > 0) {
+        startNext();
+        return;
+    }
+    
+    std::vector<World> worlds = m_results;
+    std::stable_sort(worlds.begin(), worlds.end(), [](const World& a, const World& b) {
+        return a.order < b.order;
     });
+    spdlog::info("Fetched status for {} worlds, {} online", 
+                worlds.size(),
+                std::count_if(worlds.begin(), worlds.end(), 
+                              [](const World& w) { return w.canLogin(); }));
+    emit finished(worlds);
+}
+
+WorldStatusMonitor::WorldStatusMonitor(QObject* parent)
+    : QObject(parent)
+    , m_fetcher(new WorldStatusFetcher(this))
+    , m_timer(new QTimer(this))
+{
+    m_fetcher->setTimeout(REQUEST_TIMEOUT_MS);
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &WorldStatusMonitor::poll);
+    connect(m_fetcher, &WorldStatusFetcher::worldResolved, this, &WorldStatusMonitor::onResolved);
+    connect(m_fetcher, &WorldStatusFetcher::finished, this, &WorldStatusMonitor::schedule);
+}
+
+void WorldStatusMonitor::setIntervals(int upMs, int downMs) {
+    m_upInterval = std::max(1000, upMs);
+    m_downInterval = std::max(1000, downMs);
+}
+
+void WorldStatusMonitor::start(const std::vector<WorldInfo>& worlds, const std::vector<World>& known) {
+    stop();
+    m_clock.start();
+    for (const auto& info : worlds) {
+        Tracked tracked;
+        tracked.info = info;
+        auto it = std::find_if(known.begin(), known.end(),
+                               [&](const World& w) { return w.name == info.name; });
+        tracked.world = it != known.end() ? *it : worldFromInfo(info);
+        tracked.dueAt = it != known.end() ? nextPoll(tracked.world) : 0;
+        m_worlds.push_back(std::move(tracked));
+    }
+    spdlog::debug("Monitoring status of {} worlds", m_worlds.size());
+    schedule();
+}
+
+void WorldStatusMonitor::stop() {
+    m_timer->stop();
+    m_fetcher->cancel();
+    m_worlds.clear();
+}
+
+qint64 WorldStatusMonitor::nextPoll(const World& world) const {
+    // Spread the requests out so the worlds don't all come due together
+    const int interval = world.canLogin() ? m_upInterval : m_downInterval;
+    const int jitter = interval / 5;
+    return m_clock.elapsed() + interval - jitter +
+           QRandomGenerator::global()->bounded(2 * jitter + 1);
+}
+
+void WorldStatusMonitor::schedule() {
+    if (m_worlds.empty() || m_fetcher->isRunning()) {
+        return;
+    }
+    qint64 next = std::numeric_limits<qint64>::max();
+    for (const auto& tracked : m_worlds) {
+        next = std::min(next, tracked.dueAt);
+    }
+    m_timer->start(static_cast<int>(std::max<qint64>(0, next - m_clock.elapsed())));
+}
+
+void WorldStatusMonitor::poll() {
+    const qint64 now = m_clock.elapsed();
+    std::vector<WorldInfo> due;
+    for (auto& tracked : m_worlds) {
+        if (tracked.dueAt <= now) {
+            due.push_back(tracked.info);
+        }
+    }
+    if (due.empty()) {
+        schedule();
+        return;
+    }
+    spdlog::debug("Polling status of {} worlds", due.size());
+    m_fetcher->start(due);
+}
+
+void WorldStatusMonitor::onResolved(const World& world) {
+    auto it = std::find_if(m_worlds.begin(), m_worlds.end(),
+                           [&](const Tracked& t) { return t.info.name == world.name; });
+    if (it == m_worlds.end()) {
+        return;
+    }
+    
+    // A failed poll says nothing about the world; ask again soon
+    if (world.status == WorldStatus::Unknown) {
+        it->dueAt = m_clock.elapsed() + m_downInterval;
+        return;
+    }
+    
+    const World previous = std::exchange(it->world, world);
+    it->dueAt = nextPoll(world);
+    if (previous.status != world.status || previous.queueUrl != world.queueUrl ||
+        previous.loginServer != world.loginServer) {
+        spdlog::info("World {} is now {} (was {})", world.name.toStdString(),
+                     world.statusString().toStdString(), previous.statusString().toStdString());
+        emit worldChanged(world, previous.status);
+    }
+}
+
+QFuture<std::vector<World>> fetchWorldsWithStatus(const GameServicesInfo& servicesInfo) {
+    // The fetcher is asynchronous already; it runs on the calling thread's
+    // event loop instead of holding a pool thread in a nested one
+    auto promise = std::make_shared<QPromise<std::vector<World>>>();
+    QFuture<std::vector<World>> future = promise->future();
+    promise->start();
+    
+    auto* fetcher = new WorldStatusFetcher();
+    auto complete = [promise, fetcher](const std::vector<World>& worlds) {
+        if (promise->future().isFinished()) {
+            return;
+        }
+        promise->addResult(worlds);
+        promise->finish();
+        fetcher->deleteLater();
+    };
+    QObject::connect(fetcher, &WorldStatusFetcher::finished, fetcher, complete);
+    fetcher->start(servicesInfo.worlds);
+    if (!fetcher->isRunning()) {
+        complete({});
+    }
+    return future;
 }
 
 // Legacy function - for backward compatibility
 QFuture<std::vector<World>> fetchWorldList(const QString& worldStatusUrl) {
-    return QtConcurrent::run([worldStatusUrl]() -> std::vector<World> {
+    return TaskScheduler::instance().run(TaskPool::Io, [worldStatusUrl]() -> std::vector<World> {
         spdlog::warn("Using deprecated fetchWorldList - use fetchWorldsWithStatus instead");
         return {}; // Return empty - caller should use new API
     });
 }
 
 QFuture<int> checkWorldQueue(const World& world, const QString& ticket) {
-    return QtConcurrent::run([world, ticket]() -> int {
+    return TaskScheduler::instance().run(TaskPool::Io, [world, ticket]() -> int {
         try {
             if (world.queueUrl.isEmpty()) {
                 spdlog::debug("No queue URL for world {}, assuming no queue", 
@@ -255,34 +451,16 @@ QFuture<int> checkWorldQueue(const World& world, const QString& ticket) {
             }
             url += QString("ticket=%1").arg(ticket);
             
-            QNetworkAccessManager manager;
-            QNetworkRequest request(url);
-            
-            QEventLoop loop;
-            QNetworkReply* reply = manager.get(request);
+            QNetworkRequest request = HttpClient::request(QUrl(url), 10000);
+            NetworkTrace::tag(request, "Worlds");
+            const HttpResponse reply = HttpClient::get(request);
             
-            QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-            
-            QTimer timer;
-            timer.setSingleShot(true);
-            QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-            timer.start(10000);
-            
-            loop.exec();
-            
-            if (!timer.isActive()) {
-                reply->deleteLater();
-                return 0; // Assume no queue on timeout
-            }
-            timer.stop();
-            
-            if (reply->error() != QNetworkReply::NoError) {
-                reply->deleteLater();
+            // Assume no queue on timeout or error
+            if (!reply.ok()) {
                 return 0;
             }
             
-            QString response = QString::fromUtf8(reply->readAll());
-            reply->deleteLater();
+            QString response = QString::fromUtf8(reply.body);
             
             // Parse queue position from response
             // Expected format: <QueuePosition>N</QueuePosition> or just a number
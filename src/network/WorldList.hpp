@@ -12,11 +12,18 @@
 #include <string>
 #include <vector>
 
+#include <QElapsedTimer>
 #include <QFuture>
+#include <QHash>
+#include <QObject>
 #include <QString>
 
 #include "GameServicesInfo.hpp"
 
+class QNetworkAccessManager;
+class QNetworkReply;
+class QTimer;
+
 namespace lotro {
 
 /**
@@ -58,10 +65,123 @@ struct World {
     QString statusString() const;
 };
 
+struct HttpResponse;
+
+/**
+ * Fetches the status of many worlds at once
+ * 
+ * Up to maxConcurrent status requests run in parallel over the thread's
+ * shared network manager, so the whole list takes about one round trip and
+ * a refresh reuses the connections of the last one. Each request
+ * has its own timeout. Every world is reported through worldResolved()
+ * as soon as its status is known, then finished() delivers them all,
+ * sorted by order. Runs on the thread it lives on, driven by its signals.
+ */
+class WorldStatusFetcher : public QObject {
+    Q_OBJECT
+
+public:
+    explicit WorldStatusFetcher(QObject* parent = nullptr);
+    ~WorldStatusFetcher() override;
+    
+    void setMaxConcurrent(int requests);
+    void setTimeout(int milliseconds);
+    int maxConcurrent() const { return m_maxConcurrent; }
+    
+    /**
+     * Start fetching, abandoning any fetch still running
+     */
+    void start(const std::vector<WorldInfo>& worlds);
+    
+    /**
+     * Abort outstanding requests without emitting finished()
+     */
+    void cancel();
+    
+    bool isRunning() const { return m_remaining > 0; }
+    
+    static constexpr int DEFAULT_MAX_CONCURRENT = 6;
+    static constexpr int DEFAULT_TIMEOUT_MS = 10000;
+
+signals:
+    void worldResolved(const World& world);
+    void finished(const std::vector<World>& worlds);
+
+private:
+    void startNext();
+    void resolve(size_t index, WorldStatus status, const HttpResponse* response = nullptr);
+    
+    QNetworkAccessManager* m_manager;
+    std::vector<WorldInfo> m_infos;
+    std::vector<World> m_results;
+    QHash<QNetworkReply*, size_t> m_running;
+    size_t m_next = 0;
+    size_t m_remaining = 0;
+    int m_maxConcurrent = DEFAULT_MAX_CONCURRENT;
+    int m_timeout = DEFAULT_TIMEOUT_MS;
+};
+
+/**
+ * Keeps polling world status in the background
+ * 
+ * Each world is polled on its own jittered schedule: every few seconds
+ * while it is down or unknown, so a server coming back up shows within
+ * seconds, and about once a minute while it is up. Only the worlds that
+ * are due go out, through a WorldStatusFetcher on the thread's shared
+ * network manager with the HttpCache validators, so an unchanged status
+ * costs a 304. worldChanged() is emitted only when a world's status,
+ * queue or login server actually changed; a request that fails or times
+ * out changes nothing and just polls the world again sooner.
+ */
+class WorldStatusMonitor : public QObject {
+    Q_OBJECT
+
+public:
+    explicit WorldStatusMonitor(QObject* parent = nullptr);
+    
+    /**
+     * Start polling, taking known as the current state
+     * 
+     * Worlds missing from known start out unknown and are polled first.
+     */
+    void start(const std::vector<WorldInfo>& worlds, const std::vector<World>& known = {});
+    void stop();
+    bool isActive() const { return !m_worlds.empty(); }
+    
+    void setIntervals(int upMs, int downMs);
+    
+    static constexpr int DEFAULT_UP_INTERVAL_MS = 60000;
+    static constexpr int DEFAULT_DOWN_INTERVAL_MS = 8000;
+    static constexpr int REQUEST_TIMEOUT_MS = 5000;
+
+signals:
+    void worldChanged(const World& world, WorldStatus previous);
+
+private:
+    struct Tracked {
+        WorldInfo info;
+        World world;
+        qint64 dueAt = 0;               // Milliseconds on m_clock
+    };
+    
+    void poll();
+    void schedule();
+    void onResolved(const World& world);
+    qint64 nextPoll(const World& world) const;
+    
+    std::vector<Tracked> m_worlds;
+    WorldStatusFetcher* m_fetcher;
+    QTimer* m_timer;
+    QElapsedTimer m_clock;
+    int m_upInterval = DEFAULT_UP_INTERVAL_MS;
+    int m_downInterval = DEFAULT_DOWN_INTERVAL_MS;
+};
+
 /**
  * Get worlds with status from GameServicesInfo
  * 
- * This fetches status for each world in the services info
+ * This fetches status for every world in the services info, several
+ * at a time, on the calling thread's event loop
  * 
  * @param servicesInfo Game services info containing world list
  * @return List of worlds with status
@@ -8,6 +8,10 @@
 
 #include "SteamIntegration.hpp"
 
+#include <QCoreApplication>
+#include <QTimer>
+
+#include <algorithm>
 #include <dlfcn.h>
 #include <fstream>
 #include <cstdlib>
@@ -16,9 +20,7 @@
 
 namespace lotro {
 
-SteamIntegration::SteamIntegration() {
-    m_available = loadSteamLibrary();
-}
+SteamIntegration::SteamIntegration() = default;
 
 SteamIntegration::~SteamIntegration() {
     if (m_initialized) {
@@ -32,6 +34,13 @@ SteamIntegration& SteamIntegration::instance() {
     return instance;
 }
 
+void SteamIntegration::ensureLoaded() {
+    if (!m_loadAttempted) {
+        m_loadAttempted = true;
+        m_available = loadSteamLibrary();
+    }
+}
+
 bool SteamIntegration::loadSteamLibrary() {
     // Try common paths for libsteam_api.so
     std::vector<std::string> searchPaths = {
@@ -72,7 +81,8 @@ bool SteamIntegration::loadSteamLibrary() {
     }
     
     for (const auto& path : searchPaths) {
-        m_steamLib = dlopen(path.c_str(), RTLD_NOW);
+        // Lazy binding: only the handful of functions we call get resolved
+        m_steamLib = dlopen(path.c_str(), RTLD_LAZY);
         if (m_steamLib) {
             spdlog::info("Loaded Steam API from: {}", path);
             break;
@@ -91,11 +101,8 @@ bool SteamIntegration::loadSteamLibrary() {
         dlsym(m_steamLib, "SteamAPI_Shutdown"));
     m_SteamAPI_IsSteamRunning = reinterpret_cast<SteamAPI_IsSteamRunning_t>(
         dlsym(m_steamLib, "SteamAPI_IsSteamRunning"));
-    m_SteamFriends = reinterpret_cast<SteamFriends_t>(
-        dlsym(m_steamLib, "SteamFriends"));
     
-    // These are methods on ISteamFriends interface - we'll handle differently
-    // For now, just check the basic functions
+    // The ISteamFriends functions wait for resolveFriends()
     if (!m_SteamAPI_Init || !m_SteamAPI_Shutdown) {
         spdlog::warn("Steam API library loaded but missing required functions");
         dlclose(m_steamLib);
@@ -116,6 +123,34 @@ void SteamIntegration::unloadSteamLibrary() {
     m_SteamAPI_Shutdown = nullptr;
     m_SteamAPI_IsSteamRunning = nullptr;
     m_SteamFriends = nullptr;
+    m_SetRichPresence = nullptr;
+    m_ClearRichPresence = nullptr;
+    m_friends = nullptr;
+    m_friendsResolved = false;
+}
+
+bool SteamIntegration::resolveFriends() {
+    if (!m_friendsResolved && m_steamLib) {
+        m_friendsResolved = true;
+        
+        // Flat API accessors are versioned; older SDKs only export SteamFriends()
+        for (const char* name : {"SteamAPI_SteamFriends_v017", "SteamAPI_SteamFriends_v015", "SteamFriends"}) {
+            m_SteamFriends = reinterpret_cast<SteamFriends_t>(dlsym(m_steamLib, name));
+            if (m_SteamFriends) {
+                break;
+            }
+        }
+        m_SetRichPresence = reinterpret_cast<SetRichPresence_t>(
+            dlsym(m_steamLib, "SteamAPI_ISteamFriends_SetRichPresence"));
+        m_ClearRichPresence = reinterpret_cast<ClearRichPresence_t>(
+            dlsym(m_steamLib, "SteamAPI_ISteamFriends_ClearRichPresence"));
+        m_friends = m_SteamFriends ? m_SteamFriends() : nullptr;
+        
+        if (!m_friends || !m_SetRichPresence || !m_ClearRichPresence) {
+            spdlog::debug("Steam API has no usable ISteamFriends, Rich Presence disabled");
+        }
+    }
+    return m_friends && m_SetRichPresence && m_ClearRichPresence;
 }
 
 bool SteamIntegration::createAppIdFile(uint32_t appId) {
@@ -157,11 +192,14 @@ void SteamIntegration::removeAppIdFile() {
 }
 
 bool SteamIntegration::initialize(uint32_t appId) {
+    QMutexLocker lock(&m_mutex);
     if (m_initialized) {
         spdlog::debug("Steam already initialized");
         return true;
     }
     
+    ensureLoaded();
+    
     if (!m_available) {
         spdlog::debug("Steam integration not available");
         return false;
@@ -191,12 +229,18 @@ bool SteamIntegration::initialize(uint32_t appId) {
 }
 
 void SteamIntegration::shutdown() {
+    QMutexLocker lock(&m_mutex);
     if (!m_initialized) {
         return;
     }
     
     // Clear rich presence before shutdown
-    clearRichPresence();
+    m_pendingStatus.clear();
+    if (resolveFriends()) {
+        m_ClearRichPresence(m_friends);
+    }
+    m_friends = nullptr;
+    m_friendsResolved = false;
     
     // Shutdown Steam API
     if (m_SteamAPI_Shutdown) {
@@ -211,32 +255,55 @@ void SteamIntegration::shutdown() {
 }
 
 bool SteamIntegration::setRichPresence(const std::string& status) {
+    QMutexLocker lock(&m_mutex);
     if (!m_initialized) {
         return false;
     }
     
-    // Rich Presence requires ISteamFriends interface
-    // For now, we just set the status via the environment
-    // The actual Rich Presence would require more complex interface handling
-    
-    // Note: Full Rich Presence implementation would need to:
-    // 1. Get ISteamFriends* via SteamFriends()
-    // 2. Call SetRichPresence("steam_display", "#Status")
-    // 3. Set up localized tokens in Steam partner backend
-    
-    // For this basic implementation, we rely on Steam showing "In Game"
-    // which happens automatically when SteamAPI_Init succeeds
+    // A flush already scheduled will carry this status
+    m_pendingStatus = status;
+    if (m_flushScheduled) {
+        return true;
+    }
+    m_flushScheduled = true;
     
-    spdlog::debug("Rich Presence status: {}", status);
+    qint64 delay = 0;
+    if (m_sinceLastPresence.isValid()) {
+        delay = std::max<qint64>(0, RICH_PRESENCE_INTERVAL_MS - m_sinceLastPresence.elapsed());
+    }
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        QTimer::singleShot(static_cast<int>(delay), app, [this]() { flushRichPresence(); });
+    } else {
+        lock.unlock();
+        flushRichPresence();
+    }
     return true;
 }
 
+void SteamIntegration::flushRichPresence() {
+    QMutexLocker lock(&m_mutex);
+    m_flushScheduled = false;
+    if (!m_initialized || m_pendingStatus.empty() || !resolveFriends()) {
+        return;
+    }
+    
+    // "status" is the key Steam shows under the game in the friends list
+    m_SetRichPresence(m_friends, "status", m_pendingStatus.c_str());
+    m_sinceLastPresence.start();
+    spdlog::debug("Rich Presence status: {}", m_pendingStatus);
+}
+
 void SteamIntegration::clearRichPresence() {
+    QMutexLocker lock(&m_mutex);
     if (!m_initialized) {
         return;
     }
     
-    // Would call ISteamFriends::ClearRichPresence() for full implementation
+    m_pendingStatus.clear();
+    if (resolveFriends()) {
+        m_ClearRichPresence(m_friends);
+        m_sinceLastPresence.start();
+    }
     spdlog::debug("Rich Presence cleared");
 }
 
@@ -5,7 +5,8 @@
  * in Steam friends list when launching the game through this launcher.
  * 
  * Uses dlopen/dlsym to dynamically load libsteam_api.so at runtime,
- * so there's no hard dependency on the Steamworks SDK.
+ * so there's no hard dependency on the Steamworks SDK. The library is
+ * only looked for when integration is first initialized.
  * 
  * SPDX-License-Identifier: GPL-3.0-or-later
  */
@@ -14,6 +15,10 @@
 
 #ifdef PLATFORM_LINUX
 
+#include <QElapsedTimer>
+#include <QMutex>
+
+#include <atomic>
 #include <filesystem>
 #include <string>
 
@@ -37,6 +42,11 @@ namespace SteamAppIds {
  * The Steam client must be running for this to work.
  * If Steam is not available, all methods gracefully return false/no-op.
  * 
+ * Nothing is loaded when the instance is created. The first initialize()
+ * probes for the library, so callers run it on the I/O pool rather than
+ * the GUI thread. The library is opened with RTLD_LAZY, and the rich
+ * presence functions are only looked up the first time they are needed.
+ * 
  * Usage:
  *   auto& steam = SteamIntegration::instance();
  *   if (steam.initialize()) {
@@ -57,7 +67,8 @@ public:
      * - libsteam_api.so was loaded successfully
      * - Required API functions were resolved
      * 
-     * Does NOT check if Steam client is running.
+     * Does NOT check if Steam client is running. False until the
+     * library has been probed.
      */
     bool isAvailable() const { return m_available; }
     
@@ -69,7 +80,9 @@ public:
     /**
      * Initialize Steam integration
      * 
-     * Creates steam_appid.txt and calls SteamAPI_Init().
+     * Loads the Steam API library on first use, then creates
+     * steam_appid.txt and calls SteamAPI_Init(). Both can block, so
+     * call this from a worker thread.
      * If successful, the game will appear as "Playing" in Steam.
      * 
      * @param appId Steam App ID (default: LOTRO)
@@ -88,8 +101,12 @@ public:
     /**
      * Set Rich Presence status text
      * 
+     * Updates are coalesced: Steam gets at most one per
+     * RICH_PRESENCE_INTERVAL_MS, carrying the latest status. Safe to call
+     * from any thread; the update is sent from the GUI thread.
+     * 
      * @param status Status text to show (e.g., "Exploring Middle-earth")
-     * @return true if set successfully
+     * @return true if the status was accepted
      */
     bool setRichPresence(const std::string& status);
     
@@ -106,9 +123,22 @@ private:
     
     bool loadSteamLibrary();
     void unloadSteamLibrary();
+    
+    // Probe for the library once; needs m_mutex
+    void ensureLoaded();
+    
+    // Look up the ISteamFriends functions on first use; needs m_mutex
+    bool resolveFriends();
+    
+    // Send the pending rich presence status (GUI thread)
+    void flushRichPresence();
     bool createAppIdFile(uint32_t appId);
     void removeAppIdFile();
     
+    // Guards everything below except the atomics
+    QMutex m_mutex;
+    bool m_loadAttempted = false;
+    
     // Dynamic library handle
     void* m_steamLib = nullptr;
     
@@ -116,7 +146,7 @@ private:
     using SteamAPI_Init_t = bool (*)();
     using SteamAPI_Shutdown_t = void (*)();
     using SteamAPI_IsSteamRunning_t = bool (*)();
-    using SteamFriends_t = void* (*)();
+    using SteamFriends_t = void* (*)();   // SteamAPI_SteamFriends_v0xx or SteamFriends
     using SetRichPresence_t = bool (*)(void*, const char*, const char*);
     using ClearRichPresence_t = void (*)(void*);
     
@@ -126,10 +156,19 @@ private:
     SteamFriends_t m_SteamFriends = nullptr;
     SetRichPresence_t m_SetRichPresence = nullptr;
     ClearRichPresence_t m_ClearRichPresence = nullptr;
+    void* m_friends = nullptr;
+    bool m_friendsResolved = false;
     
-    bool m_available = false;
-    bool m_initialized = false;
+    std::atomic<bool> m_available{false};
+    std::atomic<bool> m_initialized{false};
     std::filesystem::path m_appIdFilePath;
+    
+    // Rich presence coalescing
+    std::string m_pendingStatus;
+    bool m_flushScheduled = false;
+    QElapsedTimer m_sinceLastPresence;
+    
+    static constexpr int RICH_PRESENCE_INTERVAL_MS = 5000;
 };
 
 } // namespace lotro
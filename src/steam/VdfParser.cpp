@@ -0,0 +1,219 @@
+/**
+ * LOTRO Launcher - VDF Parser Implementation (Linux only)
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef PLATFORM_LINUX
+
+#include "VdfParser.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <strings.h>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace lotro {
+
+namespace {
+
+enum class TokenType { String, Open, Close, End };
+
+struct Token {
+    TokenType type;
+    std::string text;
+    bool bare = false;
+};
+
+class Tokenizer {
+public:
+    explicit Tokenizer(std::string_view text) : m_text(text) {}
+    
+    std::optional<Token> next(std::string* error) {
+        skipSpaceAndComments();
+        if (m_pos >= m_text.size()) {
+            return Token{TokenType::End, {}};
+        }
+        
+        char c = m_text[m_pos];
+        if (c == '{') {
+            ++m_pos;
+            return Token{TokenType::Open, {}};
+        }
+        if (c == '}') {
+            ++m_pos;
+            return Token{TokenType::Close, {}};
+        }
+        if (c == '"') {
+            return quoted(error);
+        }
+        
+        // Bare token, up to whitespace or a structural character
+        size_t start = m_pos;
+        while (m_pos < m_text.size() && !isspace(static_cast<unsigned char>(m_text[m_pos])) &&
+               m_text[m_pos] != '{' && m_text[m_pos] != '}' && m_text[m_pos] != '"') {
+            ++m_pos;
+        }
+        return Token{TokenType::String, std::string(m_text.substr(start, m_pos - start)), true};
+    }
+    
+    size_t line() const {
+        size_t count = 1;
+        for (size_t i = 0; i < m_pos && i < m_text.size(); ++i) {
+            count += m_text[i] == '\n';
+        }
+        return count;
+    }
+    
+private:
+    void skipSpaceAndComments() {
+        while (m_pos < m_text.size()) {
+            if (isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+                ++m_pos;
+            } else if (m_text.compare(m_pos, 2, "//") == 0) {
+                size_t end = m_text.find('\n', m_pos);
+                m_pos = end == std::string_view::npos ? m_text.size() : end;
+            } else {
+                break;
+            }
+        }
+    }
+    
+    std::optional<Token> quoted(std::string* error) {
+        std::string text;
+        ++m_pos;
+        while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+            char c = m_text[m_pos++];
+            if (c == '\\' && m_pos < m_text.size()) {
+                char escaped = m_text[m_pos++];
+                switch (escaped) {
+                    case 'n': text += '\n'; break;
+                    case 't': text += '\t'; break;
+                    default: text += escaped; break;
+                }
+            } else {
+                text += c;
+            }
+        }
+        if (m_pos >= m_text.size()) {
+            if (error) {
+                *error = "unterminated string at line " + std::to_string(line());
+            }
+            return std::nullopt;
+        }
+        ++m_pos;
+        return Token{TokenType::String, std::move(text)};
+    }
+    
+    std::string_view m_text;
+    size_t m_pos = 0;
+};
+
+bool isConditional(const Token& token) {
+    return token.type == TokenType::String && token.bare && token.text.size() > 2 &&
+           token.text.front() == '[' && token.text.back() == ']';
+}
+
+/**
+ * Read keys into block until its closing brace (or the end, for the root)
+ */
+bool parseBlock(Tokenizer& tokens, VdfNode& block, bool root, std::string* error) {
+    auto fail = [&](const std::string& message) {
+        if (error) {
+            *error = message + " at line " + std::to_string(tokens.line());
+        }
+        return false;
+    };
+    
+    std::optional<Token> pending;
+    auto next = [&]() -> std::optional<Token> {
+        if (pending) {
+            return std::exchange(pending, std::nullopt);
+        }
+        return tokens.next(error);
+    };
+    
+    while (true) {
+        auto key = next();
+        if (!key) {
+            return false;
+        }
+        if (key->type == TokenType::End) {
+            return root ? true : fail("missing closing brace");
+        }
+        if (key->type == TokenType::Close) {
+            return root ? fail("unexpected closing brace") : true;
+        }
+        if (key->type != TokenType::String) {
+            return fail("expected a key");
+        }
+        
+        auto value = next();
+        if (!value) {
+            return false;
+        }
+        VdfNode node;
+        if (value->type == TokenType::Open) {
+            if (!parseBlock(tokens, node, false, error)) {
+                return false;
+            }
+        } else if (value->type == TokenType::String) {
+            node.value = std::move(value->text);
+        } else {
+            return fail("expected a value for \"" + key->text + "\"");
+        }
+        
+        // A trailing [$WIN32]-style condition applies to the key before it
+        auto after = next();
+        if (!after) {
+            return false;
+        }
+        if (!isConditional(*after)) {
+            pending = std::move(after);
+        }
+        
+        block.children.emplace_back(std::move(key->text), std::move(node));
+    }
+}
+
+} // anonymous namespace
+
+const VdfNode* VdfNode::find(std::string_view key) const {
+    for (const auto& [name, node] : children) {
+        if (name.size() == key.size() && strncasecmp(name.data(), key.data(), key.size()) == 0) {
+            return &node;
+        }
+    }
+    return nullptr;
+}
+
+std::optional<VdfNode> parseVdf(std::string_view text, std::string* error) {
+    Tokenizer tokens(text);
+    VdfNode root;
+    if (!parseBlock(tokens, root, true, error)) {
+        return std::nullopt;
+    }
+    return root;
+}
+
+std::optional<VdfNode> parseVdfFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    
+    std::string error;
+    auto root = parseVdf(content, &error);
+    if (!root) {
+        spdlog::warn("Error parsing {}: {}", path.string(), error);
+    }
+    return root;
+}
+
+} // namespace lotro
+
+#endif // PLATFORM_LINUX
@@ -0,0 +1,55 @@
+/**
+ * LOTRO Launcher - VDF Parser (Linux only)
+ * 
+ * Reader for Valve's text KeyValues format, as used by libraryfolders.vdf,
+ * appmanifest_*.acf and config.vdf.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#ifdef PLATFORM_LINUX
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * One key's value: a string, or a block of further keys
+ * 
+ * Keys keep their file order and may repeat, as Steam writes them.
+ */
+struct VdfNode {
+    std::string value;
+    std::vector<std::pair<std::string, VdfNode>> children;
+    
+    /**
+     * First child with the given key, compared case-insensitively
+     * like Steam does; nullptr if there is none
+     */
+    const VdfNode* find(std::string_view key) const;
+};
+
+/**
+ * Parse KeyValues text into a root block holding its top-level keys
+ * 
+ * Handles quoted and bare tokens, escape sequences, // comments and
+ * [$PLATFORM] conditionals (which are skipped). Returns nullopt and
+ * fills error on malformed input.
+ */
+std::optional<VdfNode> parseVdf(std::string_view text, std::string* error = nullptr);
+
+/**
+ * Read and parse a file; nullopt if it can't be read or parsed
+ */
+std::optional<VdfNode> parseVdfFile(const std::filesystem::path& path);
+
+} // namespace lotro
+
+#endif // PLATFORM_LINUX
@@ -0,0 +1,228 @@
+/**
+ * LOTRO Launcher - Addon List Model Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "AddonListModel.hpp"
+#include "core/TaskScheduler.hpp"
+
+#include <QFutureWatcher>
+#include <QSize>
+#include <QStringList>
+
+#include <algorithm>
+
+namespace lotro {
+
+namespace {
+
+QString formatGridCardText(const QString& name, const QString& author, const QString& version,
+                           const QString& category, int downloads, const QString& status) {
+    // Build a multi-line card with visual hierarchy
+    QString text = name;
+    
+    if (!author.isEmpty()) {
+        text += "\n  by " + author;
+    }
+    
+    QStringList details;
+    if (!version.isEmpty()) details << "v" + version;
+    if (!category.isEmpty()) details << category;
+    if (!details.isEmpty()) {
+        text += "\n" + details.join("  •  ");
+    }
+    
+    QStringList meta;
+    if (downloads > 0) {
+        // Format with K/M suffixes
+        if (downloads >= 1000000)
+            meta << QString("%1M ↓").arg(downloads / 1000000.0, 0, 'f', 1);
+        else if (downloads >= 1000)
+            meta << QString("%1K ↓").arg(downloads / 1000.0, 0, 'f', 1);
+        else
+            meta << QString("%1 ↓").arg(downloads);
+    }
+    if (!status.isEmpty()) meta << status;
+    
+    if (!meta.isEmpty()) {
+        text += "\n" + meta.join("  •  ");
+    }
+    
+    return text;
+}
+
+} // anonymous namespace
+
+AddonListModel::AddonListModel(bool remote, QObject* parent)
+    : QAbstractTableModel(parent)
+    , m_remote(remote)
+{
+}
+
+void AddonListModel::setAddons(std::vector<AddonInfo> addons, QSet<QString> installedIds) {
+    auto rows = std::make_shared<Rows>();
+    rows->reserve(addons.size());
+    for (auto& addon : addons) {
+        const bool installed = !m_remote || installedIds.contains(addon.id);
+        rows->push_back({std::move(addon), installed});
+    }
+    m_rows = std::move(rows);
+    reorder();
+}
+
+void AddonListModel::setFilter(const QString& text) {
+    if (text == m_filter) {
+        return;
+    }
+    m_filter = text;
+    reorder();
+}
+
+void AddonListModel::sort(int column, Qt::SortOrder order) {
+    m_sortColumn = column;
+    m_sortOrder = order;
+    reorder();
+}
+
+void AddonListModel::reorder() {
+    const quint64 generation = ++m_generation;
+    auto rows = m_rows;
+    
+    auto* watcher = new QFutureWatcher<std::vector<int>>(this);
+    connect(watcher, &QFutureWatcher<std::vector<int>>::finished, this, [this, watcher, rows, generation]() {
+        watcher->deleteLater();
+        if (generation != m_generation) {
+            return;
+        }
+        beginResetModel();
+        m_shown = rows;
+        m_order = watcher->result();
+        m_fetched = std::min(static_cast<int>(m_order.size()), FETCH_BATCH);
+        endResetModel();
+    });
+    
+    watcher->setFuture(TaskScheduler::instance().run(TaskPool::Cpu,
+        [rows, filter = m_filter, column = m_sortColumn, order = m_sortOrder, remote = m_remote]() {
+            std::vector<int> indices;
+            indices.reserve(rows->size());
+            for (int i = 0; i < static_cast<int>(rows->size()); ++i) {
+                const auto& addon = (*rows)[i].addon;
+                if (filter.isEmpty() ||
+                    addon.name.contains(filter, Qt::CaseInsensitive) ||
+                    addon.author.contains(filter, Qt::CaseInsensitive) ||
+                    addon.category.contains(filter, Qt::CaseInsensitive)) {
+                    indices.push_back(i);
+                }
+            }
+            
+            auto text = [](const QString& a, const QString& b) {
+                return a.compare(b, Qt::CaseInsensitive);
+            };
+            auto compare = [&](int left, int right) -> int {
+                const Row& a = (*rows)[left];
+                const Row& b = (*rows)[right];
+                switch (column) {
+                    case AuthorColumn: return text(a.addon.author, b.addon.author);
+                    case VersionColumn:
+                        return remote ? text(a.addon.version, b.addon.version)
+                                      : text(a.addon.installedVersion, b.addon.installedVersion);
+                    case CategoryColumn: return text(a.addon.category, b.addon.category);
+                    case ReleasedColumn: return text(a.addon.releaseDate, b.addon.releaseDate);
+                    case DownloadsColumn: return a.addon.downloadCount - b.addon.downloadCount;
+                    case StatusColumn: return int(a.installed) - int(b.installed);
+                    case SizeColumn: return text(a.addon.fileSize, b.addon.fileSize);
+                    case IdColumn: return a.addon.id.toInt() - b.addon.id.toInt();
+                    default: return text(a.addon.name, b.addon.name);
+                }
+            };
+            std::stable_sort(indices.begin(), indices.end(), [&](int left, int right) {
+                return order == Qt::AscendingOrder ? compare(left, right) < 0 : compare(right, left) < 0;
+            });
+            return indices;
+        }));
+}
+
+int AddonListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : m_fetched;
+}
+
+int AddonListModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+bool AddonListModel::canFetchMore(const QModelIndex& parent) const {
+    return !parent.isValid() && m_fetched < static_cast<int>(m_order.size());
+}
+
+void AddonListModel::fetchMore(const QModelIndex& parent) {
+    if (parent.isValid()) {
+        return;
+    }
+    const int count = std::min(FETCH_BATCH, static_cast<int>(m_order.size()) - m_fetched);
+    if (count <= 0) {
+        return;
+    }
+    beginInsertRows(QModelIndex(), m_fetched, m_fetched + count - 1);
+    m_fetched += count;
+    endInsertRows();
+}
+
+QVariant AddonListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_fetched) {
+        return {};
+    }
+    const Row& row = rowAt(index.row());
+    const AddonInfo& addon = row.addon;
+    const QString& version = m_remote ? addon.version : addon.installedVersion;
+    
+    switch (role) {
+        case IdRole: return addon.id;
+        case NameRole: return addon.name;
+        case Qt::SizeHintRole:
+            return index.column() == CardColumn ? QVariant(QSize(250, 110)) : QVariant();
+        case Qt::DisplayRole: break;
+        default: return {};
+    }
+    
+    switch (index.column()) {
+        case NameColumn: return addon.name;
+        case AuthorColumn: return addon.author;
+        case VersionColumn: return version;
+        case CategoryColumn: return addon.category;
+        case ReleasedColumn: return addon.releaseDate;
+        case DownloadsColumn:
+            return addon.downloadCount > 0 ? QString::number(addon.downloadCount) : QString("-");
+        case StatusColumn:
+            if (m_remote) {
+                return row.installed ? "Installed" : "Available";
+            }
+            return addon.hasUpdate() ? "Update Available" : "Installed";
+        case SizeColumn: return addon.fileSize;
+        case IdColumn: return addon.id;
+        case CardColumn: {
+            QString status;
+            if (m_remote) {
+                status = row.installed ? "✓ Installed" : "";
+            } else if (addon.hasUpdate()) {
+                status = "⬆ Update Available";
+            }
+            return formatGridCardText(addon.name, addon.author, version,
+                                      addon.category, addon.downloadCount, status);
+        }
+    }
+    return {};
+}
+
+QVariant AddonListModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return {};
+    }
+    static const QStringList headers = {
+        "Name", "Author", "Version", "Category",
+        "Released", "Downloads", "Status", "Size", "ID", "Card"
+    };
+    return headers.value(section);
+}
+
+} // namespace lotro
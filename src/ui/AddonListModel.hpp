@@ -0,0 +1,104 @@
+/**
+ * LOTRO Launcher - Addon List Model
+ * 
+ * Item model behind the addon manager's grid and table views.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "addons/AddonManager.hpp"
+
+#include <QAbstractTableModel>
+#include <QSet>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Installed or remote addons of one type, filtered and sorted
+ * 
+ * Both views of a list share one model: the table shows the columns,
+ * the grid shows CardColumn. Cells are formatted in data() when a view
+ * asks for them, and rows are handed to the views in FETCH_BATCH
+ * chunks through fetchMore(), so a catalog of thousands of addons costs
+ * as much as the rows on screen.
+ * 
+ * Filtering and sorting happen inside the model rather than in a
+ * QSortFilterProxyModel, because a proxy does both on the GUI thread.
+ * The row order is computed on the global thread pool from a shared
+ * snapshot of the list and swapped in when done; results overtaken by
+ * a newer filter or sort are dropped.
+ */
+class AddonListModel : public QAbstractTableModel {
+    Q_OBJECT
+    
+public:
+    enum Column {
+        NameColumn, AuthorColumn, VersionColumn, CategoryColumn, ReleasedColumn,
+        DownloadsColumn, StatusColumn, SizeColumn, IdColumn,
+        CardColumn,                     // Multi-line text for the grid
+        ColumnCount
+    };
+    
+    enum Role {
+        IdRole = Qt::UserRole,
+        NameRole
+    };
+    
+    /**
+     * @param remote Rows come from lotrointerface.com rather than disk
+     */
+    explicit AddonListModel(bool remote, QObject* parent = nullptr);
+    
+    /**
+     * Replace the list; installedIds marks remote addons already installed
+     */
+    void setAddons(std::vector<AddonInfo> addons, QSet<QString> installedIds = {});
+    
+    /**
+     * Keep rows whose name, author or category contain the text
+     */
+    void setFilter(const QString& text);
+    
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+    
+    /**
+     * Rows matching the filter, including those not fetched yet
+     */
+    int matchCount() const { return static_cast<int>(m_order.size()); }
+    
+    static constexpr int FETCH_BATCH = 200;
+    
+private:
+    struct Row {
+        AddonInfo addon;
+        bool installed = false;
+    };
+    using Rows = std::vector<Row>;
+    
+    void reorder();
+    const Row& rowAt(int row) const { return (*m_shown)[m_order[row]]; }
+    
+    bool m_remote;
+    std::shared_ptr<const Rows> m_rows = std::make_shared<const Rows>();   // Latest list
+    std::shared_ptr<const Rows> m_shown = m_rows;                           // List m_order indexes
+    std::vector<int> m_order;           // Filtered and sorted rows of m_shown
+    int m_fetched = 0;                  // Rows of m_order the views know about
+    QString m_filter;
+    int m_sortColumn = NameColumn;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+    quint64 m_generation = 0;           // Bumped per reorder; stale results are dropped
+};
+
+} // namespace lotro
@@ -5,6 +5,7 @@
  */
 
 #include "AddonManagerWindow.hpp"
+#include "AddonListModel.hpp"
 #include "core/config/ConfigManager.hpp"
 #include "addons/AddonManager.hpp"
 
@@ -12,8 +13,7 @@
 #include <QHBoxLayout>
 #include <QPushButton>
 #include <QLineEdit>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTableView>
 #include <QTabWidget>
 #include <QTabBar>
 #include <QHeaderView>
@@ -26,32 +26,17 @@
 #include <QTimer>
 #include <QDesktopServices>
 #include <QUrl>
-#include <QListWidget>
-#include <QListWidgetItem>
+#include <QListView>
+#include <QItemSelectionModel>
+#include <QSet>
 #include <QComboBox>
+#include <QPointer>
 
 #include <spdlog/spdlog.h>
 
-namespace lotro {
+#include <algorithm>
 
-// ============================================================================
-// Custom QTableWidgetItem for numeric sorting
-// ============================================================================
-class NumericTableItem : public QTableWidgetItem {
-public:
-    using QTableWidgetItem::QTableWidgetItem;
-    
-    bool operator<(const QTableWidgetItem& other) const override {
-        // Try numeric comparison first
-        bool ok1, ok2;
-        int v1 = text().replace(",", "").toInt(&ok1);
-        int v2 = other.text().replace(",", "").toInt(&ok2);
-        if (ok1 && ok2) return v1 < v2;
-        if (ok1) return false;  // numbers sort after "-"
-        if (ok2) return true;
-        return text() < other.text();
-    }
-};
+namespace lotro {
 
 // ============================================================================
 // Impl
@@ -79,23 +64,31 @@ public:
     QStackedWidget* skinsListStack = nullptr;
     QStackedWidget* musicListStack = nullptr;
     
-    // Grid views for installed addons (using QListWidget in icon mode)
-    QListWidget* pluginsInstalledGrid = nullptr;
-    QListWidget* skinsInstalledGrid = nullptr;
-    QListWidget* musicInstalledGrid = nullptr;
+    // Models shared by each list's grid and table views
+    AddonListModel* pluginsInstalledModel = nullptr;
+    AddonListModel* skinsInstalledModel = nullptr;
+    AddonListModel* musicInstalledModel = nullptr;
+    AddonListModel* pluginsRemoteModel = nullptr;
+    AddonListModel* skinsRemoteModel = nullptr;
+    AddonListModel* musicRemoteModel = nullptr;
+    
+    // Grid views for installed addons (list views in icon mode)
+    QListView* pluginsInstalledGrid = nullptr;
+    QListView* skinsInstalledGrid = nullptr;
+    QListView* musicInstalledGrid = nullptr;
     
     // Grid views for remote addons
-    QListWidget* pluginsRemoteGrid = nullptr;
-    QListWidget* skinsRemoteGrid = nullptr;
-    QListWidget* musicRemoteGrid = nullptr;
+    QListView* pluginsRemoteGrid = nullptr;
+    QListView* skinsRemoteGrid = nullptr;
+    QListView* musicRemoteGrid = nullptr;
     
     // Table views for list mode
-    QTableWidget* pluginsInstalledTable = nullptr;
-    QTableWidget* skinsInstalledTable = nullptr;
-    QTableWidget* musicInstalledTable = nullptr;
-    QTableWidget* pluginsRemoteTable = nullptr;
-    QTableWidget* skinsRemoteTable = nullptr;
-    QTableWidget* musicRemoteTable = nullptr;
+    QTableView* pluginsInstalledTable = nullptr;
+    QTableView* skinsInstalledTable = nullptr;
+    QTableView* musicInstalledTable = nullptr;
+    QTableView* pluginsRemoteTable = nullptr;
+    QTableView* skinsRemoteTable = nullptr;
+    QTableView* musicRemoteTable = nullptr;
     
     // View mode stacks for each type (grid vs list)
     QStackedWidget* pluginsViewStack = nullptr;
@@ -146,6 +139,14 @@ AddonManagerWindow::AddonManagerWindow(const QString& gameId, QWidget* parent)
     
     // Load initial data
     refresh();
+    
+    // Pick up addons added or removed outside the launcher while open
+    if (m_impl->addonManager) {
+        m_impl->addonManager->watchInstalledAddons([this]() {
+            loadInstalledAddons(m_impl->currentType);
+            updateButtonStates();
+        });
+    }
 }
 
 AddonManagerWindow::~AddonManagerWindow() = default;
@@ -362,18 +363,22 @@ QWidget* AddonManagerWindow::createAddonTypeTab(AddonType type) {
     // View stack for grid vs list mode
     QStackedWidget* viewStack = new QStackedWidget();
     
+    // One model per source, shown by both the grid and the table
+    auto* installedModel = new AddonListModel(false, this);
+    auto* remoteModel = new AddonListModel(true, this);
+    
     // === GRID VIEW (index 0) ===
     QStackedWidget* gridSourceStack = new QStackedWidget();
-    QListWidget* installedGrid = createAddonGrid();
-    QListWidget* remoteGrid = createAddonGrid();
+    QListView* installedGrid = createAddonGrid(installedModel);
+    QListView* remoteGrid = createAddonGrid(remoteModel);
     gridSourceStack->addWidget(installedGrid);
     gridSourceStack->addWidget(remoteGrid);
     viewStack->addWidget(gridSourceStack);
     
     // === LIST VIEW (index 1) ===
     QStackedWidget* listSourceStack = new QStackedWidget();
-    QTableWidget* installedTable = createAddonTable();
-    QTableWidget* remoteTable = createAddonTable();
+    QTableView* installedTable = createAddonTable(installedModel);
+    QTableView* remoteTable = createAddonTable(remoteModel);
     listSourceStack->addWidget(installedTable);
     listSourceStack->addWidget(remoteTable);
     viewStack->addWidget(listSourceStack);
@@ -384,6 +389,8 @@ QWidget* AddonManagerWindow::createAddonTypeTab(AddonType type) {
     switch (type) {
         case AddonType::Plugin:
             m_impl->pluginsSourceBar = sourceBar;
+            m_impl->pluginsInstalledModel = installedModel;
+            m_impl->pluginsRemoteModel = remoteModel;
             m_impl->pluginsStack = gridSourceStack;
             m_impl->pluginsListStack = listSourceStack;
             m_impl->pluginsViewStack = viewStack;
@@ -394,6 +401,8 @@ QWidget* AddonManagerWindow::createAddonTypeTab(AddonType type) {
             break;
         case AddonType::Skin:
             m_impl->skinsSourceBar = sourceBar;
+            m_impl->skinsInstalledModel = installedModel;
+            m_impl->skinsRemoteModel = remoteModel;
             m_impl->skinsStack = gridSourceStack;
             m_impl->skinsListStack = listSourceStack;
             m_impl->skinsViewStack = viewStack;
@@ -404,6 +413,8 @@ QWidget* AddonManagerWindow::createAddonTypeTab(AddonType type) {
             break;
         case AddonType::Music:
             m_impl->musicSourceBar = sourceBar;
+            m_impl->musicInstalledModel = installedModel;
+            m_impl->musicRemoteModel = remoteModel;
             m_impl->musicStack = gridSourceStack;
             m_impl->musicListStack = listSourceStack;
             m_impl->musicViewStack = viewStack;
@@ -428,13 +439,9 @@ QWidget* AddonManagerWindow::createAddonTypeTab(AddonType type) {
     return widget;
 }
 
-QTableWidget* AddonManagerWindow::createAddonTable() {
-    QTableWidget* table = new QTableWidget();
-    table->setColumnCount(9);
-    table->setHorizontalHeaderLabels({
-        "Name", "Author", "Version", "Category", 
-        "Released", "Downloads", "Status", "Size", "ID"
-    });
+QTableView* AddonManagerWindow::createAddonTable(AddonListModel* model) {
+    QTableView* table = new QTableView();
+    table->setModel(model);
     table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);   // Name
     table->horizontalHeader()->setMinimumSectionSize(80);
     table->horizontalHeader()->setSectionResizeMode(1, QHeaderView::ResizeToContents); // Author
@@ -447,45 +454,47 @@ QTableWidget* AddonManagerWindow::createAddonTable() {
     table->horizontalHeader()->resizeSection(6, 85);
     table->horizontalHeader()->setSectionResizeMode(7, QHeaderView::Interactive);      // Size
     table->horizontalHeader()->resizeSection(7, 65);
-    table->setColumnHidden(8, true);  // Hide ID column
+    table->setColumnHidden(AddonListModel::IdColumn, true);
+    table->setColumnHidden(AddonListModel::CardColumn, true);  // Grid only
     table->setSelectionBehavior(QAbstractItemView::SelectRows);
     table->setSelectionMode(QAbstractItemView::SingleSelection);
     table->setAlternatingRowColors(true);
     table->setEditTriggers(QAbstractItemView::NoEditTriggers);
     table->setSortingEnabled(true);
+    table->sortByColumn(AddonListModel::NameColumn, Qt::AscendingOrder);
     table->verticalHeader()->setVisible(false);
     table->setShowGrid(false);
     table->setStyleSheet(R"(
-        QTableWidget {
+        QTableView {
             background-color: #0d0d15;
             border: 1px solid #3a3a5c;
             border-radius: 4px;
             color: #e0e0e0;
             gridline-color: transparent;
         }
-        QTableWidget::item {
+        QTableView::item {
             padding: 8px 6px;
             color: #e0e0e0;
             border-bottom: 1px solid #1a1a2e;
         }
-        QTableWidget::item:hover {
+        QTableView::item:hover {
             background-color: #1e1e38;
         }
-        QTableWidget::item:selected {
+        QTableView::item:selected {
             background-color: #1a6d63;
             color: #ffffff;
         }
-        QTableWidget::item:alternate {
+        QTableView::item:alternate {
             background-color: #111120;
         }
-        QTableWidget::item:alternate:selected {
+        QTableView::item:alternate:selected {
             background-color: #1a6d63;
             color: #ffffff;
         }
-        QTableWidget::item:alternate:hover {
+        QTableView::item:alternate:hover {
             background-color: #1e1e38;
         }
-        QTableWidget::item:alternate:selected:hover {
+        QTableView::item:alternate:selected:hover {
             background-color: #1f7d72;
             color: #ffffff;
         }
@@ -507,8 +516,11 @@ QTableWidget* AddonManagerWindow::createAddonTable() {
     return table;
 }
 
-QListWidget* AddonManagerWindow::createAddonGrid() {
-    QListWidget* grid = new QListWidget();
+QListView* AddonManagerWindow::createAddonGrid(AddonListModel* model) {
+    QListView* grid = new QListView();
+    grid->setModel(model);
+    grid->setModelColumn(AddonListModel::CardColumn);
+    grid->setUniformItemSizes(true);  // Lay out without asking every card its size
     grid->setViewMode(QListView::IconMode);
     grid->setIconSize(QSize(0, 0));  // No icon — we use rich text
     grid->setGridSize(QSize(260, 120));
@@ -519,12 +531,12 @@ QListWidget* AddonManagerWindow::createAddonGrid() {
     grid->setSelectionMode(QAbstractItemView::SingleSelection);
     grid->setWordWrap(true);
     grid->setStyleSheet(R"(
-        QListWidget {
+        QListView {
             background-color: #0d0d15;
             border: none;
             outline: none;
         }
-        QListWidget::item {
+        QListView::item {
             background-color: #151528;
             border: 2px solid #252545;
             border-radius: 8px;
@@ -532,16 +544,16 @@ QListWidget* AddonManagerWindow::createAddonGrid() {
             padding: 10px;
             margin: 2px;
         }
-        QListWidget::item:hover {
+        QListView::item:hover {
             background-color: #1e1e38;
             border-color: #454570;
         }
-        QListWidget::item:selected {
+        QListView::item:selected {
             background-color: #152e2b;
             border-color: #2a9d8f;
             border-width: 2px;
         }
-        QListWidget::item:selected:hover {
+        QListView::item:selected:hover {
             background-color: #1a3835;
             border-color: #34c4b3;
         }
@@ -574,74 +586,36 @@ void AddonManagerWindow::setupConnections() {
         updateButtonStates();
     });
     
-    // Double-click to install (remote) or open page (installed)
-    auto connectGridDoubleClick = [this](QListWidget* grid, bool isRemote) {
-        if (grid) {
-            connect(grid, &QListWidget::itemDoubleClicked, [this, isRemote](QListWidgetItem*) {
-                if (isRemote) {
-                    installSelected();
-                } else {
-                    openAddonPage();
-                }
-            });
+    // Double-click to install (remote) or open page (installed), and keep
+    // the buttons in step with the selection
+    auto connectView = [this](QAbstractItemView* view, bool isRemote) {
+        if (!view) {
+            return;
         }
+        connect(view, &QAbstractItemView::doubleClicked, [this, isRemote](const QModelIndex&) {
+            if (isRemote) {
+                installSelected();
+            } else {
+                openAddonPage();
+            }
+        });
+        connect(view->selectionModel(), &QItemSelectionModel::selectionChanged, [this]() {
+            updateButtonStates();
+        });
     };
     
-    connectGridDoubleClick(m_impl->pluginsInstalledGrid, false);
-    connectGridDoubleClick(m_impl->pluginsRemoteGrid, true);
-    connectGridDoubleClick(m_impl->skinsInstalledGrid, false);
-    connectGridDoubleClick(m_impl->skinsRemoteGrid, true);
-    connectGridDoubleClick(m_impl->musicInstalledGrid, false);
-    connectGridDoubleClick(m_impl->musicRemoteGrid, true);
-    
-    // Double-click on table rows
-    auto connectTableDoubleClick = [this](QTableWidget* table, bool isRemote) {
-        if (table) {
-            connect(table, &QTableWidget::itemDoubleClicked, [this, isRemote](QTableWidgetItem*) {
-                if (isRemote) {
-                    installSelected();
-                } else {
-                    openAddonPage();
-                }
-            });
-        }
-    };
-    
-    connectTableDoubleClick(m_impl->pluginsInstalledTable, false);
-    connectTableDoubleClick(m_impl->pluginsRemoteTable, true);
-    connectTableDoubleClick(m_impl->skinsInstalledTable, false);
-    connectTableDoubleClick(m_impl->skinsRemoteTable, true);
-    connectTableDoubleClick(m_impl->musicInstalledTable, false);
-    connectTableDoubleClick(m_impl->musicRemoteTable, true);
-    
-    // Selection change on grids and tables => update button states
-    auto connectSelection = [this](QListWidget* grid) {
-        if (grid) {
-            connect(grid, &QListWidget::itemSelectionChanged, [this]() {
-                updateButtonStates();
-            });
-        }
-    };
-    connectSelection(m_impl->pluginsInstalledGrid);
-    connectSelection(m_impl->pluginsRemoteGrid);
-    connectSelection(m_impl->skinsInstalledGrid);
-    connectSelection(m_impl->skinsRemoteGrid);
-    connectSelection(m_impl->musicInstalledGrid);
-    connectSelection(m_impl->musicRemoteGrid);
-    
-    auto connectTableSelection = [this](QTableWidget* table) {
-        if (table) {
-            connect(table, &QTableWidget::itemSelectionChanged, [this]() {
-                updateButtonStates();
-            });
-        }
-    };
-    connectTableSelection(m_impl->pluginsInstalledTable);
-    connectTableSelection(m_impl->pluginsRemoteTable);
-    connectTableSelection(m_impl->skinsInstalledTable);
-    connectTableSelection(m_impl->skinsRemoteTable);
-    connectTableSelection(m_impl->musicInstalledTable);
-    connectTableSelection(m_impl->musicRemoteTable);
+    connectView(m_impl->pluginsInstalledGrid, false);
+    connectView(m_impl->pluginsRemoteGrid, true);
+    connectView(m_impl->skinsInstalledGrid, false);
+    connectView(m_impl->skinsRemoteGrid, true);
+    connectView(m_impl->musicInstalledGrid, false);
+    connectView(m_impl->musicRemoteGrid, true);
+    connectView(m_impl->pluginsInstalledTable, false);
+    connectView(m_impl->pluginsRemoteTable, true);
+    connectView(m_impl->skinsInstalledTable, false);
+    connectView(m_impl->skinsRemoteTable, true);
+    connectView(m_impl->musicInstalledTable, false);
+    connectView(m_impl->musicRemoteTable, true);
     
     // View toggle button
     connect(m_impl->viewToggleBtn, &QPushButton::toggled, [this](bool listMode) {
@@ -657,22 +631,16 @@ void AddonManagerWindow::setupConnections() {
         updateButtonStates();
     });
     
-    // Sort combo
+    // Sort combo — sorting a table sorts its model, so the grid follows
     connect(m_impl->sortCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), [this](int index) {
-        QListWidget* grid = getCurrentGrid();
-        if (grid) {
-            sortGrid(grid, index);
-        }
-        
-        // Also sort table view
-        QTableWidget* table = getCurrentTable();
+        QTableView* table = getCurrentTable();
         if (table) {
             switch (index) {
-                case 0: table->sortByColumn(0, Qt::AscendingOrder); break;  // Name A-Z
-                case 1: table->sortByColumn(0, Qt::DescendingOrder); break; // Name Z-A
-                case 2: table->sortByColumn(1, Qt::AscendingOrder); break;  // Author
-                case 3: table->sortByColumn(5, Qt::DescendingOrder); break; // Downloads
-                case 4: table->sortByColumn(4, Qt::DescendingOrder); break; // Date
+                case 0: table->sortByColumn(AddonListModel::NameColumn, Qt::AscendingOrder); break;
+                case 1: table->sortByColumn(AddonListModel::NameColumn, Qt::DescendingOrder); break;
+                case 2: table->sortByColumn(AddonListModel::AuthorColumn, Qt::AscendingOrder); break;
+                case 3: table->sortByColumn(AddonListModel::DownloadsColumn, Qt::DescendingOrder); break;
+                case 4: table->sortByColumn(AddonListModel::ReleasedColumn, Qt::DescendingOrder); break;
             }
         }
     });
@@ -682,7 +650,7 @@ void AddonManagerWindow::setupConnections() {
 // Selection Helpers — work for both grid and table views
 // ============================================================================
 
-QListWidget* AddonManagerWindow::getCurrentGrid() const {
+QListView* AddonManagerWindow::getCurrentGrid() const {
     if (m_impl->showingRemote) {
         switch (m_impl->currentType) {
             case AddonType::Plugin: return m_impl->pluginsRemoteGrid;
@@ -699,7 +667,7 @@ QListWidget* AddonManagerWindow::getCurrentGrid() const {
     return nullptr;
 }
 
-QTableWidget* AddonManagerWindow::getCurrentTable() const {
+QTableView* AddonManagerWindow::getCurrentTable() const {
     if (m_impl->showingRemote) {
         switch (m_impl->currentType) {
             case AddonType::Plugin: return m_impl->pluginsRemoteTable;
@@ -716,129 +684,35 @@ QTableWidget* AddonManagerWindow::getCurrentTable() const {
     return nullptr;
 }
 
-QString AddonManagerWindow::getSelectedAddonId() const {
-    if (m_impl->isGridView) {
-        QListWidget* grid = getCurrentGrid();
-        if (grid) {
-            auto items = grid->selectedItems();
-            if (!items.isEmpty()) {
-                return items.first()->data(Qt::UserRole).toString();
-            }
-        }
-    } else {
-        QTableWidget* table = getCurrentTable();
-        if (table) {
-            int row = table->currentRow();
-            if (row >= 0) {
-                QTableWidgetItem* idItem = table->item(row, 8); // ID column
-                if (idItem) return idItem->text();
-            }
-        }
+AddonListModel* AddonManagerWindow::getModel(AddonType type, bool remote) const {
+    switch (type) {
+        case AddonType::Plugin:
+            return remote ? m_impl->pluginsRemoteModel : m_impl->pluginsInstalledModel;
+        case AddonType::Skin:
+            return remote ? m_impl->skinsRemoteModel : m_impl->skinsInstalledModel;
+        case AddonType::Music:
+            return remote ? m_impl->musicRemoteModel : m_impl->musicInstalledModel;
     }
-    return {};
+    return nullptr;
 }
 
-QString AddonManagerWindow::getSelectedAddonName() const {
-    if (m_impl->isGridView) {
-        QListWidget* grid = getCurrentGrid();
-        if (grid) {
-            auto items = grid->selectedItems();
-            if (!items.isEmpty()) {
-                return items.first()->data(Qt::UserRole + 1).toString();
-            }
-        }
-    } else {
-        QTableWidget* table = getCurrentTable();
-        if (table) {
-            int row = table->currentRow();
-            if (row >= 0) {
-                QTableWidgetItem* nameItem = table->item(row, 0); // Name column
-                if (nameItem) return nameItem->text();
-            }
-        }
+QModelIndex AddonManagerWindow::getSelectedIndex() const {
+    QAbstractItemView* view = m_impl->isGridView
+        ? static_cast<QAbstractItemView*>(getCurrentGrid())
+        : static_cast<QAbstractItemView*>(getCurrentTable());
+    if (!view) {
+        return {};
     }
-    return {};
+    const auto selected = view->selectionModel()->selectedIndexes();
+    return selected.isEmpty() ? QModelIndex() : selected.first();
 }
 
-// ============================================================================
-// Sorting
-// ============================================================================
+QString AddonManagerWindow::getSelectedAddonId() const {
+    return getSelectedIndex().data(AddonListModel::IdRole).toString();
+}
 
-void AddonManagerWindow::sortGrid(QListWidget* grid, int sortIndex) {
-    if (!grid || grid->count() == 0) return;
-    
-    // Extract all items into a sortable list
-    struct SortableItem {
-        QString name;
-        QString author;
-        int downloads;
-        QString date;
-        // Store all UserRole data to reconstruct
-        QMap<int, QVariant> data;
-        QString text;
-        QSize sizeHint;
-        Qt::Alignment alignment;
-    };
-    
-    std::vector<SortableItem> items;
-    for (int i = 0; i < grid->count(); ++i) {
-        QListWidgetItem* item = grid->item(i);
-        SortableItem si;
-        si.name = item->data(Qt::UserRole + 1).toString();
-        si.author = item->data(Qt::UserRole + 2).toString();
-        si.downloads = item->data(Qt::UserRole + 5).toInt();
-        si.date = item->data(Qt::UserRole + 6).toString();
-        si.text = item->text();
-        si.sizeHint = item->sizeHint();
-        si.alignment = Qt::Alignment(item->textAlignment());
-        // Copy all user data roles
-        for (int r = Qt::UserRole; r <= Qt::UserRole + 10; ++r) {
-            QVariant v = item->data(r);
-            if (v.isValid()) si.data[r] = v;
-        }
-        items.push_back(si);
-    }
-    
-    // Sort
-    switch (sortIndex) {
-        case 0: // Name A-Z
-            std::sort(items.begin(), items.end(), [](const SortableItem& a, const SortableItem& b) {
-                return a.name.compare(b.name, Qt::CaseInsensitive) < 0;
-            });
-            break;
-        case 1: // Name Z-A
-            std::sort(items.begin(), items.end(), [](const SortableItem& a, const SortableItem& b) {
-                return a.name.compare(b.name, Qt::CaseInsensitive) > 0;
-            });
-            break;
-        case 2: // Author
-            std::sort(items.begin(), items.end(), [](const SortableItem& a, const SortableItem& b) {
-                return a.author.compare(b.author, Qt::CaseInsensitive) < 0;
-            });
-            break;
-        case 3: // Downloads descending
-            std::sort(items.begin(), items.end(), [](const SortableItem& a, const SortableItem& b) {
-                return a.downloads > b.downloads;
-            });
-            break;
-        case 4: // Date descending
-            std::sort(items.begin(), items.end(), [](const SortableItem& a, const SortableItem& b) {
-                return a.date > b.date;
-            });
-            break;
-    }
-    
-    // Rebuild the grid
-    grid->clear();
-    for (const auto& si : items) {
-        QListWidgetItem* item = new QListWidgetItem(si.text);
-        for (auto it = si.data.begin(); it != si.data.end(); ++it) {
-            item->setData(it.key(), it.value());
-        }
-        item->setSizeHint(si.sizeHint);
-        item->setTextAlignment(si.alignment);
-        grid->addItem(item);
-    }
+QString AddonManagerWindow::getSelectedAddonName() const {
+    return getSelectedIndex().data(AddonListModel::NameRole).toString();
 }
 
 // ============================================================================
@@ -905,48 +779,6 @@ void AddonManagerWindow::refresh() {
     m_impl->statusLabel->setText("Addons refreshed");
 }
 
-// ============================================================================
-// Helper: format a grid card's text
-// ============================================================================
-namespace {
-
-QString formatGridCardText(const QString& name, const QString& author, const QString& version,
-                           const QString& category, int downloads, const QString& status) {
-    // Build a multi-line card with visual hierarchy
-    QString text = name;
-    
-    if (!author.isEmpty()) {
-        text += "\n  by " + author;
-    }
-    
-    QStringList details;
-    if (!version.isEmpty()) details << "v" + version;
-    if (!category.isEmpty()) details << category;
-    if (!details.isEmpty()) {
-        text += "\n" + details.join("  •  ");
-    }
-    
-    QStringList meta;
-    if (downloads > 0) {
-        // Format with K/M suffixes
-        if (downloads >= 1000000)
-            meta << QString("%1M ↓").arg(downloads / 1000000.0, 0, 'f', 1);
-        else if (downloads >= 1000)
-            meta << QString("%1K ↓").arg(downloads / 1000.0, 0, 'f', 1);
-        else
-            meta << QString("%1 ↓").arg(downloads);
-    }
-    if (!status.isEmpty()) meta << status;
-    
-    if (!meta.isEmpty()) {
-        text += "\n" + meta.join("  •  ");
-    }
-    
-    return text;
-}
-
-} // anonymous namespace
-
 // ============================================================================
 // Load Addons
 // ============================================================================
@@ -956,86 +788,14 @@ void AddonManagerWindow::loadInstalledAddons(AddonType type) {
         return;
     }
     
-    QListWidget* grid = nullptr;
-    QTableWidget* table = nullptr;
-    switch (type) {
-        case AddonType::Plugin: 
-            grid = m_impl->pluginsInstalledGrid; 
-            table = m_impl->pluginsInstalledTable;
-            break;
-        case AddonType::Skin:   
-            grid = m_impl->skinsInstalledGrid; 
-            table = m_impl->skinsInstalledTable;
-            break;
-        case AddonType::Music:  
-            grid = m_impl->musicInstalledGrid; 
-            table = m_impl->musicInstalledTable;
-            break;
-    }
-    
     auto addons = m_impl->addonManager->getInstalledAddons(type);
-    
-    // Populate grid view
-    if (grid) {
-        grid->clear();
-        for (const auto& addon : addons) {
-            QString statusText;
-            if (addon.hasUpdate()) statusText = "⬆ Update Available";
-            
-            QString itemText = formatGridCardText(
-                addon.name, addon.author, addon.installedVersion,
-                addon.category, addon.downloadCount, statusText
-            );
-            
-            QListWidgetItem* item = new QListWidgetItem(itemText);
-            item->setData(Qt::UserRole, addon.id);
-            item->setData(Qt::UserRole + 1, addon.name);
-            item->setData(Qt::UserRole + 2, addon.author);
-            item->setData(Qt::UserRole + 3, addon.installedVersion);
-            item->setData(Qt::UserRole + 4, addon.category);
-            item->setData(Qt::UserRole + 5, addon.downloadCount);
-            item->setData(Qt::UserRole + 6, addon.releaseDate);
-            
-            item->setSizeHint(QSize(250, 110));
-            
-            grid->addItem(item);
-        }
-        
-        // Apply current sort
-        sortGrid(grid, m_impl->sortCombo->currentIndex());
-    }
-    
-    // Populate table view
-    if (table) {
-        table->setSortingEnabled(false);
-        table->setRowCount(static_cast<int>(addons.size()));
-        
-        for (int row = 0; row < static_cast<int>(addons.size()); ++row) {
-            const auto& addon = addons[row];
-            
-            table->setItem(row, 0, new QTableWidgetItem(addon.name));
-            table->setItem(row, 1, new QTableWidgetItem(addon.author));
-            table->setItem(row, 2, new QTableWidgetItem(addon.installedVersion));
-            table->setItem(row, 3, new QTableWidgetItem(addon.category));
-            table->setItem(row, 4, new QTableWidgetItem(addon.releaseDate));
-            
-            // Use NumericTableItem for downloads so sorting works correctly
-            auto* dlItem = new NumericTableItem(
-                addon.downloadCount > 0 ? QString::number(addon.downloadCount) : "-"
-            );
-            table->setItem(row, 5, dlItem);
-            
-            QString statusText = addon.hasUpdate() ? "Update Available" : "Installed";
-            table->setItem(row, 6, new QTableWidgetItem(statusText));
-            table->setItem(row, 7, new QTableWidgetItem(addon.fileSize));
-            table->setItem(row, 8, new QTableWidgetItem(addon.id));
-        }
-        
-        table->setSortingEnabled(true);
+    const size_t count = addons.size();
+    if (AddonListModel* model = getModel(type, false)) {
+        model->setAddons(std::move(addons));
     }
     
     m_impl->statusLabel->setText(QString("Found %1 installed %2")
-        .arg(addons.size())
+        .arg(count)
         .arg(addonTypeToString(type).toLower() + "s"));
 }
 
@@ -1044,23 +804,6 @@ void AddonManagerWindow::loadRemoteAddons(AddonType type) {
         return;
     }
     
-    QListWidget* grid = nullptr;
-    QTableWidget* table = nullptr;
-    switch (type) {
-        case AddonType::Plugin: 
-            grid = m_impl->pluginsRemoteGrid; 
-            table = m_impl->pluginsRemoteTable;
-            break;
-        case AddonType::Skin:   
-            grid = m_impl->skinsRemoteGrid; 
-            table = m_impl->skinsRemoteTable;
-            break;
-        case AddonType::Music:  
-            grid = m_impl->musicRemoteGrid; 
-            table = m_impl->musicRemoteTable;
-            break;
-    }
-    
     m_impl->statusLabel->setText("Fetching addons from lotrointerface.com...");
     m_impl->progressBar->setVisible(true);
     m_impl->progressBar->setRange(0, 0);  // Indeterminate
@@ -1070,77 +813,26 @@ void AddonManagerWindow::loadRemoteAddons(AddonType type) {
     
     // Poll for completion
     QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, [this, future, grid, table, type, timer]() mutable {
+    connect(timer, &QTimer::timeout, [this, future, type, timer]() mutable {
         if (future.isFinished()) {
             timer->stop();
             timer->deleteLater();
             
             auto addons = future.result();
+            const size_t count = addons.size();
             
             m_impl->progressBar->setVisible(false);
             
-            // Populate grid view
-            if (grid) {
-                grid->clear();
-                for (const auto& addon : addons) {
-                    auto installed = m_impl->addonManager->getInstalledAddon(addon.id, type);
-                    QString statusText = installed ? "✓ Installed" : "";
-                    
-                    QString itemText = formatGridCardText(
-                        addon.name, addon.author, addon.version,
-                        addon.category, addon.downloadCount, statusText
-                    );
-                    
-                    QListWidgetItem* item = new QListWidgetItem(itemText);
-                    item->setData(Qt::UserRole, addon.id);
-                    item->setData(Qt::UserRole + 1, addon.name);
-                    item->setData(Qt::UserRole + 2, addon.author);
-                    item->setData(Qt::UserRole + 3, addon.version);
-                    item->setData(Qt::UserRole + 4, addon.category);
-                    item->setData(Qt::UserRole + 5, addon.downloadCount);
-                    item->setData(Qt::UserRole + 6, addon.releaseDate);
-                    
-                    item->setSizeHint(QSize(250, 110));
-                    
-                    grid->addItem(item);
-                }
-                
-                // Apply current sort
-                sortGrid(grid, m_impl->sortCombo->currentIndex());
+            QSet<QString> installedIds;
+            for (const auto& addon : m_impl->addonManager->getInstalledAddons(type)) {
+                installedIds.insert(addon.id);
             }
-            
-            // Populate table view
-            if (table) {
-                table->setSortingEnabled(false);
-                table->setRowCount(static_cast<int>(addons.size()));
-                
-                for (int row = 0; row < static_cast<int>(addons.size()); ++row) {
-                    const auto& addon = addons[row];
-                    
-                    table->setItem(row, 0, new QTableWidgetItem(addon.name));
-                    table->setItem(row, 1, new QTableWidgetItem(addon.author));
-                    table->setItem(row, 2, new QTableWidgetItem(addon.version));
-                    table->setItem(row, 3, new QTableWidgetItem(addon.category));
-                    table->setItem(row, 4, new QTableWidgetItem(addon.releaseDate));
-                    
-                    // Numeric sort for downloads
-                    auto* dlItem = new NumericTableItem(
-                        addon.downloadCount > 0 ? QString::number(addon.downloadCount) : "-"
-                    );
-                    table->setItem(row, 5, dlItem);
-                    
-                    auto installed = m_impl->addonManager->getInstalledAddon(addon.id, type);
-                    QString statusText = installed ? "Installed" : "Available";
-                    table->setItem(row, 6, new QTableWidgetItem(statusText));
-                    table->setItem(row, 7, new QTableWidgetItem(addon.fileSize));
-                    table->setItem(row, 8, new QTableWidgetItem(addon.id));
-                }
-                
-                table->setSortingEnabled(true);
+            if (AddonListModel* model = getModel(type, true)) {
+                model->setAddons(std::move(addons), std::move(installedIds));
             }
             
             m_impl->statusLabel->setText(QString("Found %1 available %2")
-                .arg(addons.size())
+                .arg(count)
                 .arg(addonTypeToString(type).toLower() + "s"));
         }
     });
@@ -1269,7 +961,22 @@ void AddonManagerWindow::updateAll() {
     m_impl->progressBar->setRange(0, 0);
     
     if (m_impl->addonManager) {
-        auto future = m_impl->addonManager->updateAllAddons(type, nullptr);
+        m_impl->addonManager->setMaxConcurrentUpdates(
+            ConfigManager::instance().programConfig().addonUpdateConcurrency);
+        
+        // Called from the update workers
+        QPointer<AddonManagerWindow> self(this);
+        auto progress = [self](int current, int total, const QString& status) {
+            QMetaObject::invokeMethod(self, [self, current, total, status]() {
+                if (!self || !self->m_impl->progressBar->isVisible()) {
+                    return;
+                }
+                self->m_impl->progressBar->setRange(0, std::max(total, 1));
+                self->m_impl->progressBar->setValue(current);
+                self->m_impl->statusLabel->setText(status);
+            });
+        };
+        auto future = m_impl->addonManager->updateAllAddons(type, progress);
         
         QTimer* timer = new QTimer(this);
         connect(timer, &QTimer::timeout, [this, future, timer]() mutable {
@@ -1330,39 +1037,16 @@ void AddonManagerWindow::openAddonPage() {
 }
 
 // ============================================================================
-// Search — filters BOTH grid and table views
+// Search — filters BOTH grid and table views through their shared model
 // ============================================================================
 
 void AddonManagerWindow::search(const QString& query) {
-    // Filter grid
-    QListWidget* grid = getCurrentGrid();
-    if (grid) {
-        for (int i = 0; i < grid->count(); ++i) {
-            QListWidgetItem* item = grid->item(i);
-            bool match = query.isEmpty() || 
-                item->text().contains(query, Qt::CaseInsensitive);
-            item->setHidden(!match);
-        }
-    }
-    
-    // Filter table
-    QTableWidget* table = getCurrentTable();
-    if (table) {
-        for (int row = 0; row < table->rowCount(); ++row) {
-            bool match = false;
-            if (query.isEmpty()) {
-                match = true;
-            } else {
-                // Search across name, author, category columns
-                for (int col : {0, 1, 3}) {
-                    QTableWidgetItem* item = table->item(row, col);
-                    if (item && item->text().contains(query, Qt::CaseInsensitive)) {
-                        match = true;
-                        break;
-                    }
-                }
+    // Filter every list, so switching tabs keeps the search
+    for (AddonType type : {AddonType::Plugin, AddonType::Skin, AddonType::Music}) {
+        for (bool remote : {false, true}) {
+            if (AddonListModel* model = getModel(type, remote)) {
+                model->setFilter(query);
             }
-            table->setRowHidden(row, !match);
         }
     }
 }
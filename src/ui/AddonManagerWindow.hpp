@@ -12,14 +12,18 @@
 #include <memory>
 
 #include <QDialog>
+#include <QModelIndex>
 #include <QString>
-#include <QTableWidget>
-#include <QListWidget>
+
+class QListView;
+class QTableView;
 
 #include "addons/AddonManager.hpp"
 
 namespace lotro {
 
+class AddonListModel;
+
 /**
  * Addon manager window
  * 
@@ -118,18 +122,17 @@ private:
     void loadRemoteAddons(AddonType type);
     void updateAddonList();
     void updateButtonStates();
-    QTableWidget* createAddonTable();
-    QListWidget* createAddonGrid();
+    QTableView* createAddonTable(AddonListModel* model);
+    QListView* createAddonGrid(AddonListModel* model);
     QWidget* createAddonTypeTab(AddonType type);
     
     // Selection helpers — work across both grid and table views
+    QModelIndex getSelectedIndex() const;
     QString getSelectedAddonId() const;
     QString getSelectedAddonName() const;
-    QListWidget* getCurrentGrid() const;
-    QTableWidget* getCurrentTable() const;
-    
-    // Sorting helper for grid
-    void sortGrid(QListWidget* grid, int sortIndex);
+    QListView* getCurrentGrid() const;
+    QTableView* getCurrentTable() const;
+    AddonListModel* getModel(AddonType type, bool remote) const;
     
     class Impl;
     std::unique_ptr<Impl> m_impl;
@@ -362,6 +362,7 @@ void CharacterDetailWidget::setCharacter(const Character& c) {
     
     // Gear
     m_gearTable->setRowCount(0);
+    const auto items = ItemDatabase::current();
     for (const auto& [slot, itemId] : c.equippedGear) {
         int row = m_gearTable->rowCount();
         m_gearTable->insertRow(row);
@@ -369,20 +370,20 @@ void CharacterDetailWidget::setCharacter(const Character& c) {
         auto* idItem = new QTableWidgetItem(QString::number(itemId));
         idItem->setTextAlignment(Qt::AlignCenter);
         m_gearTable->setItem(row, 1, idItem);
-        auto item = ItemDatabase::instance().getItem(QString::number(itemId));
+        const GearItem* item = items->findItem(itemId);
         m_gearTable->setItem(row, 2, new QTableWidgetItem(item ? item->name : tr("(Unknown)")));
     }
     
     // Titles
     m_titlesTable->setRowCount(0);
-    auto& db = GameDatabase::instance();
+    const auto db = GameDatabase::current();
     for (int titleId : c.titles) {
         int row = m_titlesTable->rowCount();
         m_titlesTable->insertRow(row);
         auto* idItem = new QTableWidgetItem(QString::number(titleId));
         idItem->setTextAlignment(Qt::AlignCenter);
         m_titlesTable->setItem(row, 0, idItem);
-        auto title = db.getTitle(QString::number(titleId));
+        const Title* title = db->findTitle(QString::number(titleId));
         m_titlesTable->setItem(row, 1, new QTableWidgetItem(title ? title->name : tr("(Unknown)")));
     }
     
@@ -394,7 +395,7 @@ void CharacterDetailWidget::setCharacter(const Character& c) {
         auto* idItem = new QTableWidgetItem(QString::number(emoteId));
         idItem->setTextAlignment(Qt::AlignCenter);
         m_emotesTable->setItem(row, 0, idItem);
-        auto emote = db.getEmote(QString::number(emoteId));
+        const Emote* emote = db->findEmote(QString::number(emoteId));
         m_emotesTable->setItem(row, 1, new QTableWidgetItem(emote ? emote->command : tr("(Unknown)")));
     }
 }
@@ -92,6 +92,12 @@ void CharacterListWidget::setupUi() {
     m_emptyLabel->setStyleSheet("color: #888; font-style: italic;");
     mainLayout->addWidget(m_emptyLabel);
     
+    // Roster totals
+    m_summaryLabel = new QLabel();
+    m_summaryLabel->setStyleSheet("color: #aaa;");
+    m_summaryLabel->hide();
+    mainLayout->addWidget(m_summaryLabel);
+    
     // Character list
     m_listWidget = new QListWidget();
     m_listWidget->setStyleSheet(R"(
@@ -133,6 +139,7 @@ void CharacterListWidget::refresh() {
     if (!m_tracker) {
         m_emptyLabel->show();
         m_listWidget->hide();
+        m_summaryLabel->hide();
         return;
     }
     
@@ -141,12 +148,22 @@ void CharacterListWidget::refresh() {
     if (characters.empty()) {
         m_emptyLabel->show();
         m_listWidget->hide();
+        m_summaryLabel->hide();
         return;
     }
     
     m_emptyLabel->hide();
     m_listWidget->show();
     
+    RosterSummary summary = m_tracker->summary();
+    m_summaryLabel->setText(tr("%n character(s) - highest level %1 - %2g %3s %4c in total", nullptr,
+                               summary.characterCount)
+        .arg(summary.highestLevel)
+        .arg(summary.totalCopper / 100000)
+        .arg(summary.totalCopper / 100 % 1000)
+        .arg(summary.totalCopper % 100));
+    m_summaryLabel->show();
+    
     // Sort by last played (most recent first)
     std::sort(characters.begin(), characters.end(), 
         [](const Character& a, const Character& b) {
@@ -63,6 +63,7 @@ private:
     CharacterTracker* m_tracker = nullptr;
     QListWidget* m_listWidget = nullptr;
     QLabel* m_emptyLabel = nullptr;
+    QLabel* m_summaryLabel = nullptr;
     QPushButton* m_deleteButton = nullptr;
     QPushButton* m_viewDetailsButton = nullptr;
     QPushButton* m_refreshButton = nullptr;
@@ -8,6 +8,7 @@
 
 #include "CharacterTrackerWindow.hpp"
 
+#include <QComboBox>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QHBoxLayout>
@@ -24,8 +25,10 @@
 #include <QVBoxLayout>
 
 #include "DataExportWindow.hpp"
+#include "ProgressChart.hpp"
 #include "companion/export/DataExporter.hpp"
 #include "companion/GameDatabase.hpp"
+#include "companion/LiveFeed.hpp"
 #include "companion/ItemDatabase.hpp"
 #include "dat/DataFacade.hpp"
 #include "companion/ProcessMemory.hpp"
@@ -35,6 +38,44 @@
 
 namespace lotro {
 
+namespace {
+
+// Set a cell's text, creating its item on first use so later syncs reuse it
+QTableWidgetItem* setCell(QTableWidget* table, int row, int column, const QString& text,
+                          Qt::Alignment alignment = Qt::AlignLeft | Qt::AlignVCenter) {
+    QTableWidgetItem* item = table->item(row, column);
+    if (!item) {
+        item = new QTableWidgetItem(text);
+        item->setTextAlignment(alignment);
+        table->setItem(row, column, item);
+    } else if (item->text() != text) {
+        item->setText(text);
+    }
+    return item;
+}
+
+// Size a table for rows of data, dropping the empty-state row if it is showing
+void prepareRows(QTableWidget* table, int rows) {
+    if (table->columnSpan(0, 0) > 1) {
+        table->clearSpans();
+        table->setRowCount(0);
+    }
+    table->setRowCount(rows);
+}
+
+void showPlaceholder(QTableWidget* table, const QString& text) {
+    table->clearSpans();
+    table->setRowCount(0);
+    table->setRowCount(1);
+    auto* emptyItem = new QTableWidgetItem(text);
+    emptyItem->setFlags(Qt::NoItemFlags);
+    emptyItem->setForeground(QColor("#888"));
+    table->setItem(0, 0, emptyItem);
+    table->setSpan(0, 0, 1, table->columnCount());
+}
+
+} // namespace
+
 CharacterTrackerWindow::CharacterTrackerWindow(const QString& gamePath, QWidget* parent)
     : QDialog(parent)
     , m_gamePath(gamePath)
@@ -139,11 +180,17 @@ void CharacterTrackerWindow::setupUi() {
     // === Tab widget ===
     m_tabWidget = new QTabWidget();
     m_tabWidget->addTab(createOverviewTab(), tr("Overview"));
-    m_tabWidget->addTab(createVirtuesTab(), tr("Virtues"));
-    m_tabWidget->addTab(createReputationTab(), tr("Reputation"));
-    m_tabWidget->addTab(createCraftingTab(), tr("Crafting"));
-    m_tabWidget->addTab(createGearTab(), tr("Gear"));
-    m_tabWidget->addTab(createTitlesEmotesTab(), tr("Titles & Emotes"));
+    m_sectionTabs[VirtuesSection] = createVirtuesTab();
+    m_tabWidget->addTab(m_sectionTabs[VirtuesSection], tr("Virtues"));
+    m_sectionTabs[ReputationSection] = createReputationTab();
+    m_tabWidget->addTab(m_sectionTabs[ReputationSection], tr("Reputation"));
+    m_sectionTabs[CraftingSection] = createCraftingTab();
+    m_tabWidget->addTab(m_sectionTabs[CraftingSection], tr("Crafting"));
+    m_sectionTabs[GearSection] = createGearTab();
+    m_tabWidget->addTab(m_sectionTabs[GearSection], tr("Gear"));
+    m_sectionTabs[TitlesEmotesSection] = createTitlesEmotesTab();
+    m_tabWidget->addTab(m_sectionTabs[TitlesEmotesSection], tr("Titles & Emotes"));
+    m_tabWidget->addTab(createProgressTab(), tr("Progress"));
     
     mainLayout->addWidget(m_tabWidget, 1);
 }
@@ -381,6 +428,37 @@ QWidget* CharacterTrackerWindow::createTitlesEmotesTab() {
     return widget;
 }
 
+QWidget* CharacterTrackerWindow::createProgressTab() {
+    auto* widget = new QWidget();
+    auto* layout = new QVBoxLayout(widget);
+    
+    auto* infoLabel = new QLabel(tr("Progression recorded each time the character is saved."));
+    infoLabel->setStyleSheet("color: #888; margin-bottom: 6px;");
+    layout->addWidget(infoLabel);
+    
+    auto* controls = new QHBoxLayout();
+    m_progressSeriesCombo = new QComboBox();
+    controls->addWidget(m_progressSeriesCombo, 1);
+    
+    m_progressRangeCombo = new QComboBox();
+    m_progressRangeCombo->addItem(tr("Last 7 days"), 7);
+    m_progressRangeCombo->addItem(tr("Last 30 days"), 30);
+    m_progressRangeCombo->addItem(tr("Last 90 days"), 90);
+    m_progressRangeCombo->addItem(tr("Last year"), 365);
+    m_progressRangeCombo->addItem(tr("All time"), 0);
+    m_progressRangeCombo->setCurrentIndex(1);
+    controls->addWidget(m_progressRangeCombo);
+    layout->addLayout(controls);
+    
+    m_progressChart = new ProgressChart();
+    layout->addWidget(m_progressChart, 1);
+    
+    m_progressSummaryLabel = new QLabel();
+    m_progressSummaryLabel->setStyleSheet("color: #888;");
+    layout->addWidget(m_progressSummaryLabel);
+    return widget;
+}
+
 // ============ Connections ============
 
 void CharacterTrackerWindow::setupConnections() {
@@ -393,11 +471,17 @@ void CharacterTrackerWindow::setupConnections() {
     });
     
     connect(m_refreshButton, &QPushButton::clicked, this, &CharacterTrackerWindow::refresh);
+    connect(m_tabWidget, &QTabWidget::currentChanged, this, [this]() {
+        renderCurrentTab();
+        updateProgress();
+    });
+    connect(m_progressSeriesCombo, &QComboBox::activated, this, [this]() { updateProgress(); });
+    connect(m_progressRangeCombo, &QComboBox::activated, this, [this]() { updateProgress(); });
     connect(m_autoRefreshTimer, &QTimer::timeout, this, &CharacterTrackerWindow::onAutoRefresh);
     
     connect(m_exportButton, &QPushButton::clicked, this, [this]() {
         if (!m_exportWindow) {
-            auto facade = new dat::DataFacade(m_gamePath);
+            auto facade = dat::DataFacade::shared(m_gamePath);
             auto mem = new ProcessMemory();
             auto proc = ProcessMemory::findLotroClient();
             if (proc && mem->open(proc->pid)) {
@@ -436,7 +520,7 @@ void CharacterTrackerWindow::setupConnections() {
         character.gold = info.gold;
         character.silver = info.silver;
         character.copper = info.copper;
-
+        
         character.lastPlayed = std::chrono::system_clock::now();
         
         // Populate extended data from full extraction
@@ -492,6 +576,7 @@ void CharacterTrackerWindow::setupConnections() {
         m_characterTracker->saveCharacter(character);
         setStatus(tr("Character saved: %1 (%2)").arg(character.name)
                   .arg(hasExtended ? tr("full data") : tr("basic")));
+        updateProgress();
     });
 }
 
@@ -538,15 +623,27 @@ void CharacterTrackerWindow::refresh() {
     // Try full data extraction first
     auto fullData = m_extractor->extractFullData();
     if (fullData) {
-        m_lastCharacterData = *fullData;
-        m_saveButton->setEnabled(fullData->basic.isValid());
+        // Stamp the sections this snapshot changed; the first one fills every tab
+        ++m_snapshotVersion;
+        auto stamp = [this](Section section, bool changed) {
+            if (changed || m_sectionVersion[section] == 0) {
+                m_sectionVersion[section] = m_snapshotVersion;
+            }
+        };
+        const auto& last = m_lastCharacterData;
+        stamp(VirtuesSection, fullData->virtues != last.virtues);
+        stamp(ReputationSection, fullData->factions != last.factions);
+        stamp(CraftingSection, fullData->crafting != last.crafting);
+        stamp(GearSection, fullData->equippedGear != last.equippedGear);
+        stamp(TitlesEmotesSection, fullData->titles != last.titles || fullData->emotes != last.emotes);
+        
+        LiveFeed::instance().publish(*fullData);
+        m_lastCharacterData = std::move(*fullData);
+        m_saveButton->setEnabled(m_lastCharacterData.basic.isValid());
         
-        updateOverview(fullData->basic);
-        updateVirtues(fullData->virtues);
-        updateReputation(fullData->factions);
-        updateCrafting(fullData->crafting);
-        updateGear(fullData->equippedGear);
-        updateTitlesEmotes(fullData->titles, fullData->emotes);
+        updateOverview(m_lastCharacterData.basic);
+        renderCurrentTab();
+        updateProgress();
         
         setStatus(tr("Full sync: %1").arg(QTime::currentTime().toString("hh:mm:ss")));
     } else {
@@ -615,38 +712,24 @@ void CharacterTrackerWindow::updateOverview(const CharacterInfo& info) {
 }
 
 void CharacterTrackerWindow::updateVirtues(const std::vector<VirtueStatus>& virtues) {
-    m_virtuesTable->setRowCount(0);
-    
-    for (const auto& v : virtues) {
-        int row = m_virtuesTable->rowCount();
-        m_virtuesTable->insertRow(row);
-        
-        QString displayName = v.name.isEmpty() ? v.key : v.name;
-        m_virtuesTable->setItem(row, 0, new QTableWidgetItem(displayName));
-        
-        auto* rankItem = new QTableWidgetItem(QString::number(v.rank));
-        rankItem->setTextAlignment(Qt::AlignCenter);
-        m_virtuesTable->setItem(row, 1, rankItem);
-        
-        auto* xpItem = new QTableWidgetItem(QString::number(v.xp));
-        xpItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        m_virtuesTable->setItem(row, 2, xpItem);
+    if (virtues.empty()) {
+        showPlaceholder(m_virtuesTable, tr("No virtue data available"));
+        return;
     }
     
-    if (virtues.empty()) {
-        m_virtuesTable->setRowCount(1);
-        auto* emptyItem = new QTableWidgetItem(tr("No virtue data available"));
-        emptyItem->setFlags(Qt::NoItemFlags);
-        emptyItem->setForeground(QColor("#888"));
-        m_virtuesTable->setItem(0, 0, emptyItem);
-        m_virtuesTable->setSpan(0, 0, 1, 3);
+    prepareRows(m_virtuesTable, static_cast<int>(virtues.size()));
+    for (int row = 0; row < static_cast<int>(virtues.size()); ++row) {
+        const auto& v = virtues[row];
+        setCell(m_virtuesTable, row, 0, v.name.isEmpty() ? v.key : v.name);
+        setCell(m_virtuesTable, row, 1, QString::number(v.rank), Qt::AlignCenter);
+        setCell(m_virtuesTable, row, 2, QString::number(v.xp), Qt::AlignRight | Qt::AlignVCenter);
     }
 }
 
 void CharacterTrackerWindow::updateReputation(const std::vector<FactionStatus>& factions) {
-    m_reputationTree->clear();
-    
     if (factions.empty()) {
+        m_reputationTree->clear();
+        m_factionItems.clear();
         auto* emptyItem = new QTreeWidgetItem(m_reputationTree);
         emptyItem->setText(0, tr("No reputation data available"));
         emptyItem->setForeground(0, QColor("#888"));
@@ -669,164 +752,237 @@ void CharacterTrackerWindow::updateReputation(const std::vector<FactionStatus>&
             default: return QString("Tier %1").arg(tier);
         }
     };
+    auto categoryOf = [this](const FactionStatus& f) {
+        return f.category.isEmpty() ? tr("Other") : f.category;
+    };
     
-    // Group factions by category
-    std::map<QString, std::vector<const FactionStatus*>> categorized;
-    for (const auto& f : factions) {
-        QString cat = f.category.isEmpty() ? tr("Other") : f.category;
-        categorized[cat].push_back(&f);
+    // Rebuild the tree only when factions come or go or change category;
+    // otherwise the existing rows are updated in place below
+    bool sameLayout = factions.size() == static_cast<size_t>(m_factionItems.size());
+    for (size_t i = 0; sameLayout && i < factions.size(); ++i) {
+        QTreeWidgetItem* item = m_factionItems.value(factions[i].factionId);
+        sameLayout = item && item->parent() && item->parent()->text(0) == categoryOf(factions[i]);
     }
     
-    for (const auto& [category, categoryFactions] : categorized) {
-        auto* categoryItem = new QTreeWidgetItem(m_reputationTree);
-        categoryItem->setText(0, category);
-        categoryItem->setExpanded(true);
-        QFont bold = categoryItem->font(0);
-        bold.setBold(true);
-        categoryItem->setFont(0, bold);
+    if (!sameLayout) {
+        m_reputationTree->clear();
+        m_factionItems.clear();
         
-        for (const auto* f : categoryFactions) {
-            auto* factionItem = new QTreeWidgetItem(categoryItem);
-            factionItem->setText(0, f->name.isEmpty() ? f->key : f->name);
-            factionItem->setText(1, tierName(f->tier));
-            factionItem->setText(2, QString::number(f->reputation));
-            
-            // Color-code tier
-            QColor tierColor;
-            if (f->tier >= 7) tierColor = QColor("#4a8");      // Kindred = green
-            else if (f->tier >= 6) tierColor = QColor("#48a");  // Ally = blue
-            else if (f->tier >= 5) tierColor = QColor("#8a4");  // Friend = lime
-            else if (f->tier <= 2) tierColor = QColor("#a44");  // Enemy = red
-            else tierColor = QColor("#aaa");
+        // Group factions by category
+        std::map<QString, std::vector<const FactionStatus*>> categorized;
+        for (const auto& f : factions) {
+            categorized[categoryOf(f)].push_back(&f);
+        }
+        
+        for (const auto& [category, categoryFactions] : categorized) {
+            auto* categoryItem = new QTreeWidgetItem(m_reputationTree);
+            categoryItem->setText(0, category);
+            categoryItem->setExpanded(true);
+            QFont bold = categoryItem->font(0);
+            bold.setBold(true);
+            categoryItem->setFont(0, bold);
             
-            factionItem->setForeground(1, tierColor);
+            for (const auto* f : categoryFactions) {
+                m_factionItems.insert(f->factionId, new QTreeWidgetItem(categoryItem));
+            }
         }
     }
+    
+    for (const auto& f : factions) {
+        QTreeWidgetItem* factionItem = m_factionItems.value(f.factionId);
+        factionItem->setText(0, f.name.isEmpty() ? f.key : f.name);
+        factionItem->setText(1, tierName(f.tier));
+        factionItem->setText(2, QString::number(f.reputation));
+        
+        // Color-code tier
+        QColor tierColor;
+        if (f.tier >= 7) tierColor = QColor("#4a8");      // Kindred = green
+        else if (f.tier >= 6) tierColor = QColor("#48a");  // Ally = blue
+        else if (f.tier >= 5) tierColor = QColor("#8a4");  // Friend = lime
+        else if (f.tier <= 2) tierColor = QColor("#a44");  // Enemy = red
+        else tierColor = QColor("#aaa");
+        
+        factionItem->setForeground(1, tierColor);
+    }
 }
 
 void CharacterTrackerWindow::updateCrafting(const CraftingStatus& crafting) {
-    m_craftingTable->setRowCount(0);
-    
     if (crafting.professions.empty()) {
-        m_craftingTable->setRowCount(1);
-        auto* emptyItem = new QTableWidgetItem(tr("No crafting data available"));
-        emptyItem->setFlags(Qt::NoItemFlags);
-        emptyItem->setForeground(QColor("#888"));
-        m_craftingTable->setItem(0, 0, emptyItem);
-        m_craftingTable->setSpan(0, 0, 1, 5);
+        showPlaceholder(m_craftingTable, tr("No crafting data available"));
         return;
     }
     
-    for (const auto& prof : crafting.professions) {
-        int row = m_craftingTable->rowCount();
-        m_craftingTable->insertRow(row);
+    const auto& professions = crafting.professions;
+    prepareRows(m_craftingTable, static_cast<int>(professions.size()));
+    for (int row = 0; row < static_cast<int>(professions.size()); ++row) {
+        const auto& prof = professions[row];
+        setCell(m_craftingTable, row, 0, prof.name);
+        setCell(m_craftingTable, row, 1, QString::number(prof.tier), Qt::AlignCenter);
+        setCell(m_craftingTable, row, 2, QString::number(prof.proficiency), Qt::AlignRight | Qt::AlignVCenter);
+        setCell(m_craftingTable, row, 3, QString::number(prof.mastery), Qt::AlignRight | Qt::AlignVCenter);
         
-        m_craftingTable->setItem(row, 0, new QTableWidgetItem(prof.name));
-        
-        // Resolve tier name from GameDatabase
-        auto* tierItem = new QTableWidgetItem(QString::number(prof.tier));
-        tierItem->setTextAlignment(Qt::AlignCenter);
-        m_craftingTable->setItem(row, 1, tierItem);
-        
-        auto* profItem = new QTableWidgetItem(QString::number(prof.proficiency));
-        profItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        m_craftingTable->setItem(row, 2, profItem);
-        
-        auto* mastItem = new QTableWidgetItem(QString::number(prof.mastery));
-        mastItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        m_craftingTable->setItem(row, 3, mastItem);
-        
-        auto* masteredItem = new QTableWidgetItem(prof.hasMastered ? "✓" : "✗");
-        masteredItem->setTextAlignment(Qt::AlignCenter);
+        auto* masteredItem = setCell(m_craftingTable, row, 4, prof.hasMastered ? "✓" : "✗", Qt::AlignCenter);
         masteredItem->setForeground(prof.hasMastered ? QColor("#4a8") : QColor("#888"));
-        m_craftingTable->setItem(row, 4, masteredItem);
     }
 }
 
 void CharacterTrackerWindow::updateGear(const std::map<QString, int>& gear) {
-    m_gearTable->setRowCount(0);
-    
     if (gear.empty()) {
-        m_gearTable->setRowCount(1);
-        auto* emptyItem = new QTableWidgetItem(tr("No gear data available"));
-        emptyItem->setFlags(Qt::NoItemFlags);
-        emptyItem->setForeground(QColor("#888"));
-        m_gearTable->setItem(0, 0, emptyItem);
-        m_gearTable->setSpan(0, 0, 1, 3);
+        showPlaceholder(m_gearTable, tr("No gear data available"));
         return;
     }
     
+    prepareRows(m_gearTable, static_cast<int>(gear.size()));
+    int row = 0;
     for (const auto& [slot, itemId] : gear) {
-        int row = m_gearTable->rowCount();
-        m_gearTable->insertRow(row);
-        
-        m_gearTable->setItem(row, 0, new QTableWidgetItem(slot));
+        const QString id = QString::number(itemId);
+        setCell(m_gearTable, row, 0, slot);
         
-        auto* idItem = new QTableWidgetItem(QString::number(itemId));
-        idItem->setTextAlignment(Qt::AlignCenter);
-        m_gearTable->setItem(row, 1, idItem);
+        // Same item as last time: the name is already right
+        QTableWidgetItem* idItem = m_gearTable->item(row, 1);
+        if (idItem && idItem->text() == id) {
+            ++row;
+            continue;
+        }
+        setCell(m_gearTable, row, 1, id, Qt::AlignCenter);
         
-        // Try to resolve item name from ItemDatabase
-        auto item = ItemDatabase::instance().getItem(QString::number(itemId));
-        QString itemName = item ? item->name : tr("(Unknown item)");
-        m_gearTable->setItem(row, 2, new QTableWidgetItem(itemName));
+        // Try to resolve item name from ItemDatabase, once per known item
+        QString itemName = m_itemNames.value(itemId);
+        if (itemName.isEmpty()) {
+            if (const GearItem* item = ItemDatabase::current()->findItem(itemId)) {
+                itemName = item->name;
+                m_itemNames.insert(itemId, itemName);
+            } else {
+                itemName = tr("(Unknown item)");
+            }
+        }
+        setCell(m_gearTable, row, 2, itemName);
+        ++row;
     }
 }
 
 void CharacterTrackerWindow::updateTitlesEmotes(const std::vector<int>& titles, const std::vector<int>& emotes) {
     // Titles
-    m_titlesTable->setRowCount(0);
-    
     if (titles.empty()) {
-        m_titlesTable->setRowCount(1);
-        auto* emptyItem = new QTableWidgetItem(tr("No titles data available"));
-        emptyItem->setFlags(Qt::NoItemFlags);
-        emptyItem->setForeground(QColor("#888"));
-        m_titlesTable->setItem(0, 0, emptyItem);
-        m_titlesTable->setSpan(0, 0, 1, 2);
+        showPlaceholder(m_titlesTable, tr("No titles data available"));
     } else {
-        auto& db = GameDatabase::instance();
-        for (int titleId : titles) {
-            int row = m_titlesTable->rowCount();
-            m_titlesTable->insertRow(row);
-            
-            auto* idItem = new QTableWidgetItem(QString::number(titleId));
-            idItem->setTextAlignment(Qt::AlignCenter);
-            m_titlesTable->setItem(row, 0, idItem);
+        const auto db = GameDatabase::current();
+        prepareRows(m_titlesTable, static_cast<int>(titles.size()));
+        for (int row = 0; row < static_cast<int>(titles.size()); ++row) {
+            const QString id = QString::number(titles[row]);
+            QTableWidgetItem* idItem = m_titlesTable->item(row, 0);
+            if (idItem && idItem->text() == id) {
+                continue;
+            }
+            setCell(m_titlesTable, row, 0, id, Qt::AlignCenter);
             
-            auto title = db.getTitle(QString::number(titleId));
-            QString titleName = title ? title->name : tr("(Unknown title)");
-            m_titlesTable->setItem(row, 1, new QTableWidgetItem(titleName));
+            const Title* title = db->findTitle(id);
+            setCell(m_titlesTable, row, 1, title ? title->name : tr("(Unknown title)"));
         }
     }
     
     // Emotes
-    m_emotesTable->setRowCount(0);
-    
     if (emotes.empty()) {
-        m_emotesTable->setRowCount(1);
-        auto* emptyItem = new QTableWidgetItem(tr("No emote data available"));
-        emptyItem->setFlags(Qt::NoItemFlags);
-        emptyItem->setForeground(QColor("#888"));
-        m_emotesTable->setItem(0, 0, emptyItem);
-        m_emotesTable->setSpan(0, 0, 1, 2);
+        showPlaceholder(m_emotesTable, tr("No emote data available"));
     } else {
-        auto& db = GameDatabase::instance();
-        for (int emoteId : emotes) {
-            int row = m_emotesTable->rowCount();
-            m_emotesTable->insertRow(row);
-            
-            auto* idItem = new QTableWidgetItem(QString::number(emoteId));
-            idItem->setTextAlignment(Qt::AlignCenter);
-            m_emotesTable->setItem(row, 0, idItem);
+        const auto db = GameDatabase::current();
+        prepareRows(m_emotesTable, static_cast<int>(emotes.size()));
+        for (int row = 0; row < static_cast<int>(emotes.size()); ++row) {
+            const QString id = QString::number(emotes[row]);
+            QTableWidgetItem* idItem = m_emotesTable->item(row, 0);
+            if (idItem && idItem->text() == id) {
+                continue;
+            }
+            setCell(m_emotesTable, row, 0, id, Qt::AlignCenter);
             
-            auto emote = db.getEmote(QString::number(emoteId));
-            QString emoteName = emote ? emote->command : tr("(Unknown emote)");
-            m_emotesTable->setItem(row, 1, new QTableWidgetItem(emoteName));
+            const Emote* emote = db->findEmote(id);
+            setCell(m_emotesTable, row, 1, emote ? emote->command : tr("(Unknown emote)"));
+        }
+    }
+}
+
+void CharacterTrackerWindow::renderCurrentTab() {
+    QWidget* current = m_tabWidget->currentWidget();
+    for (int section = 0; section < SectionCount; ++section) {
+        if (m_sectionTabs[section] != current || m_renderedVersion[section] >= m_sectionVersion[section]) {
+            continue;
+        }
+        switch (section) {
+            case VirtuesSection: updateVirtues(m_lastCharacterData.virtues); break;
+            case ReputationSection: updateReputation(m_lastCharacterData.factions); break;
+            case CraftingSection: updateCrafting(m_lastCharacterData.crafting); break;
+            case GearSection: updateGear(m_lastCharacterData.equippedGear); break;
+            case TitlesEmotesSection:
+                updateTitlesEmotes(m_lastCharacterData.titles, m_lastCharacterData.emotes);
+                break;
         }
+        m_renderedVersion[section] = m_sectionVersion[section];
     }
 }
 
+void CharacterTrackerWindow::updateProgress() {
+    if (m_tabWidget->currentWidget() != m_progressChart->parentWidget()) {
+        return;
+    }
+    const auto& info = m_lastCharacterData.basic;
+    if (info.name.isEmpty() || !m_characterTracker) {
+        m_progressChart->clear();
+        m_progressSummaryLabel->setText(tr("Connect to the game to see a character's progress"));
+        return;
+    }
+    
+    const auto& history = m_characterTracker->history();
+    
+    // Keep the selected series across refreshes
+    QString selected = m_progressSeriesCombo->currentData().toString();
+    if (selected.isEmpty()) {
+        selected = "level";
+    }
+    QStringList series = history.seriesNames(info.name, info.server);
+    m_progressSeriesCombo->clear();
+    for (const auto& key : series) {
+        QString label = key;
+        if (key == "level") label = tr("Level");
+        else if (key == "money") label = tr("Money (gold)");
+        else if (key == "destinyPoints") label = tr("Destiny Points");
+        else if (key == "lotroPoints") label = tr("LOTRO Points");
+        else {
+            QStringList parts = key.split('.');
+            if (parts.size() == 3) {
+                label = QString("%1: %2 (%3)").arg(parts[0].at(0).toUpper() + parts[0].mid(1), parts[1], parts[2]);
+            }
+        }
+        m_progressSeriesCombo->addItem(label, key);
+    }
+    int index = m_progressSeriesCombo->findData(selected);
+    m_progressSeriesCombo->setCurrentIndex(index >= 0 ? index : 0);
+    if (series.isEmpty()) {
+        m_progressChart->clear();
+        m_progressSummaryLabel->setText(tr("No history yet - save the character to start recording"));
+        return;
+    }
+    
+    QString key = m_progressSeriesCombo->currentData().toString();
+    int days = m_progressRangeCombo->currentData().toInt();
+    auto to = std::chrono::system_clock::now();
+    auto from = days > 0 ? to - std::chrono::hours(24 * days) : std::chrono::system_clock::time_point{};
+    auto points = history.query(info.name, info.server, key, from, to);
+    
+    ProgressChart::Formatter format;
+    if (key == "money") {
+        format = [](int64_t copper) { return QString::number(copper / 100000.0, 'f', 1) + "g"; };
+    }
+    if (points.empty()) {
+        m_progressSummaryLabel->setText(tr("No samples in this range"));
+    } else {
+        int64_t change = points.back().value - points.front().value;
+        QString changeText = format ? format(change) : QString::number(change);
+        m_progressSummaryLabel->setText(tr("%1 samples, change %2%3")
+            .arg(points.size()).arg(change >= 0 ? "+" : "").arg(changeText));
+    }
+    m_progressChart->setPoints(std::move(points), std::move(format));
+}
+
 void CharacterTrackerWindow::clearDisplay() {
     // Overview
     m_nameLabel->setText("-");
@@ -844,12 +1000,28 @@ void CharacterTrackerWindow::clearDisplay() {
     m_destinyLabel->setText("-");
     
     // Tables
+    m_virtuesTable->clearSpans();
     m_virtuesTable->setRowCount(0);
     m_reputationTree->clear();
+    m_factionItems.clear();
+    m_craftingTable->clearSpans();
     m_craftingTable->setRowCount(0);
+    m_gearTable->clearSpans();
     m_gearTable->setRowCount(0);
+    m_titlesTable->clearSpans();
     m_titlesTable->setRowCount(0);
+    m_emotesTable->clearSpans();
     m_emotesTable->setRowCount(0);
+    
+    // Forget the snapshot so the next sync fills every tab again
+    m_lastCharacterData = CharacterData();
+    m_sectionVersion.fill(0);
+    m_renderedVersion.fill(0);
+    
+    // Progress
+    m_progressSeriesCombo->clear();
+    m_progressChart->clear();
+    m_progressSummaryLabel->clear();
 }
 
 void CharacterTrackerWindow::setStatus(const QString& status, bool isError) {
@@ -13,10 +13,13 @@
 #include "../companion/CharacterTracker.hpp"
 
 #include <QDialog>
+#include <QHash>
 #include <QTimer>
 
+#include <array>
 #include <memory>
 
+class QComboBox;
 class QLabel;
 class QProgressBar;
 class QPushButton;
@@ -24,6 +27,7 @@ class QGroupBox;
 class QTabWidget;
 class QTableWidget;
 class QTreeWidget;
+class QTreeWidgetItem;
 
 namespace lotro {
 
@@ -32,23 +36,29 @@ namespace lotro {
  * 
  * Shows live character data extracted from the running LOTRO game client.
  * Provides a tabbed interface with Overview, Virtues, Reputation, Crafting,
- * Gear, and Titles & Emotes tabs.
+ * Gear, Titles & Emotes, and Progress tabs.
+ * 
+ * Data tabs are filled when first shown rather than on every sync. Each
+ * sync bumps a snapshot version and stamps it on the sections whose data
+ * differs from the previous snapshot; a tab is redrawn only when it is
+ * current and its section is newer than what it shows. Redraws reuse the
+ * existing cells, so only rows whose values changed are touched.
  */
 class CharacterTrackerWindow : public QDialog {
     Q_OBJECT
-
+    
 public:
     explicit CharacterTrackerWindow(const QString& gamePath = QString(), QWidget* parent = nullptr);
     ~CharacterTrackerWindow() override;
-
+    
 public slots:
     void connectToGame();
     void disconnectFromGame();
     void refresh();
-
+    
 private slots:
     void onAutoRefresh();
-
+    
 private:
     void setupUi();
     void setupConnections();
@@ -60,6 +70,7 @@ private:
     QWidget* createCraftingTab();
     QWidget* createGearTab();
     QWidget* createTitlesEmotesTab();
+    QWidget* createProgressTab();
     
     // Display updates
     void updateOverview(const CharacterInfo& info);
@@ -68,6 +79,8 @@ private:
     void updateCrafting(const CraftingStatus& crafting);
     void updateGear(const std::map<QString, int>& gear);
     void updateTitlesEmotes(const std::vector<int>& titles, const std::vector<int>& emotes);
+    void updateProgress();
+    void renderCurrentTab();
     void clearDisplay();
     void setStatus(const QString& status, bool isError = false);
     
@@ -115,6 +128,25 @@ private:
     QTableWidget* m_titlesTable;
     QTableWidget* m_emotesTable;
     
+    // Progress tab
+    QComboBox* m_progressSeriesCombo;
+    QComboBox* m_progressRangeCombo;
+    class ProgressChart* m_progressChart;
+    QLabel* m_progressSummaryLabel;
+    
+    // Sections of CharacterData shown on their own tab
+    enum Section {
+        VirtuesSection, ReputationSection, CraftingSection, GearSection, TitlesEmotesSection,
+        SectionCount
+    };
+    
+    std::array<QWidget*, SectionCount> m_sectionTabs{};
+    std::array<uint64_t, SectionCount> m_sectionVersion{};     // Snapshot that last changed each section
+    std::array<uint64_t, SectionCount> m_renderedVersion{};    // Snapshot each tab shows
+    uint64_t m_snapshotVersion = 0;
+    QHash<int, QTreeWidgetItem*> m_factionItems;               // Faction ID -> row in m_reputationTree
+    QHash<int, QString> m_itemNames;                           // Resolved gear names by item ID
+    
     // State
     QString m_gamePath;
     std::unique_ptr<CharacterExtractor> m_extractor;
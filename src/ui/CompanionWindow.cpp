@@ -12,10 +12,11 @@
 #include "SyncStatusWidget.hpp"
 #include "GearSimulatorWidget.hpp"
 #include "DataExportWindow.hpp"
+#include "LoadingSpinner.hpp"
 #include "companion/CharacterTracker.hpp"
-#include "companion/GameDatabase.hpp"
-#include "companion/ItemDatabase.hpp"
+#include "companion/CompanionDataLoader.hpp"
 #include "companion/LiveSyncService.hpp"
+#include "core/config/ConfigManager.hpp"
 
 #include <QTabWidget>
 #include <QVBoxLayout>
@@ -23,8 +24,8 @@
 #include <QPushButton>
 #include <QGroupBox>
 #include <QGridLayout>
+#include <QStackedWidget>
 #include <QStandardPaths>
-#include <QCoreApplication>
 
 #include <spdlog/spdlog.h>
 
@@ -46,21 +47,27 @@ CompanionWindow::CompanionWindow(const QString& gamePath, QWidget* parent)
     
     // Initialize live sync service
     m_syncService = std::make_unique<LiveSyncService>(this);
+    const auto& programConfig = ConfigManager::instance().programConfig();
+    m_syncService->setSyncIntervalBounds(programConfig.liveSyncMinIntervalMs,
+                                         programConfig.liveSyncMaxIntervalMs);
+    m_syncService->setSaveDelay(programConfig.liveSyncSaveDelayMs);
+    m_syncService->setDirtyPageTracking(programConfig.liveSyncDirtyTracking);
+    m_syncService->setLiveFeed(programConfig.liveFeedEnabled);
     connect(m_syncService.get(), &LiveSyncService::characterSaved,
             this, &CompanionWindow::onCharacterSaved);
     
-    // Initialize game database with bundled data
-    auto appDir = QCoreApplication::applicationDirPath();
-    GameDatabase::instance().initialize(
-        std::filesystem::path(appDir.toStdString()) / "data"
-    );
-    
-    // Initialize item database
-    ItemDatabase::instance().initialize(
-        std::filesystem::path(appDir.toStdString()) / "data"
-    );
-    
     setupUi();
+    
+    // Tabs fill in as their data arrives; stages done before the window
+    // opened (the launcher preloads when idle) fill in straight away
+    auto& loader = CompanionDataLoader::instance();
+    connect(&loader, &CompanionDataLoader::stageReady, this, &CompanionWindow::onStageReady);
+    loader.start();
+    for (int i = 0; i < CompanionDataLoader::STAGE_COUNT; ++i) {
+        if (loader.isReady(static_cast<CompanionStage>(i))) {
+            onStageReady(static_cast<CompanionStage>(i));
+        }
+    }
 }
 
 CompanionWindow::~CompanionWindow() = default;
@@ -73,7 +80,62 @@ void CompanionWindow::setupUi() {
     // Create tab widget
     m_tabWidget = new QTabWidget();
     
-    // === TAB 1: Character Tracker (embedded) ===
+    m_tabWidget->addTab(createPendingTab(CompanionStage::Characters, tr("Loading classes and races...")),
+                        tr("Character"));
+    m_tabWidget->addTab(createPendingTab(CompanionStage::GameDatabase, tr("Opening game database...")),
+                        tr("Saved"));
+    m_tabWidget->addTab(createPendingTab(CompanionStage::Deeds, tr("Loading deeds...")), tr("Deeds"));
+    m_tabWidget->addTab(createPendingTab(CompanionStage::Recipes, tr("Loading recipes...")), tr("Recipes"));
+    m_tabWidget->addTab(createPendingTab(CompanionStage::Items, tr("Loading items...")), tr("Gear Sim"));
+    m_tabWidget->addTab(createExportTab(), tr("Export"));
+    
+    mainLayout->addWidget(m_tabWidget);
+    
+    spdlog::info("Companion window initialized");
+}
+
+QWidget* CompanionWindow::createPendingTab(CompanionStage stage, const QString& loadingText) {
+    auto* stack = new QStackedWidget();
+    
+    auto* loadingPage = new QWidget();
+    auto* loadingLayout = new QVBoxLayout(loadingPage);
+    loadingLayout->addStretch();
+    auto* loading = new LoadingLabel(loadingText);
+    loadingLayout->addWidget(loading, 0, Qt::AlignCenter);
+    loadingLayout->addStretch();
+    loading->start();
+    stack->addWidget(loadingPage);
+    
+    m_pendingTabs[static_cast<size_t>(stage)] = stack;
+    return stack;
+}
+
+void CompanionWindow::onStageReady(CompanionStage stage) {
+    QStackedWidget*& stack = m_pendingTabs[static_cast<size_t>(stage)];
+    if (!stack) {
+        return;
+    }
+    
+    QWidget* content = nullptr;
+    switch (stage) {
+        case CompanionStage::Characters: content = createTrackerTab(); break;
+        case CompanionStage::GameDatabase: content = createSavedTab(); break;
+        case CompanionStage::Deeds: content = createDeedsTab(); break;
+        case CompanionStage::Recipes: content = createRecipesTab(); break;
+        case CompanionStage::Items: content = createGearTab(); break;
+        case CompanionStage::Count: return;
+    }
+    
+    // Swap the loading page for the real one
+    QWidget* loadingPage = stack->widget(0);
+    stack->addWidget(content);
+    stack->setCurrentWidget(content);
+    stack->removeWidget(loadingPage);
+    loadingPage->deleteLater();
+    stack = nullptr;
+}
+
+QWidget* CompanionWindow::createTrackerTab() {
     auto* trackerWidget = new QWidget();
     auto* trackerLayout = new QVBoxLayout(trackerWidget);
     trackerLayout->setContentsMargins(8, 8, 8, 8);
@@ -101,9 +163,10 @@ void CompanionWindow::setupUi() {
     m_trackerWindow->setWindowFlags(Qt::Widget);  // Make it a normal widget
     trackerLayout->addWidget(m_trackerWindow, 1);
     
-    m_tabWidget->addTab(trackerWidget, tr("Character"));
-    
-    // === TAB 2: Saved Characters ===
+    return trackerWidget;
+}
+
+QWidget* CompanionWindow::createSavedTab() {
     auto* savedWidget = new QWidget();
     auto* savedLayout = new QVBoxLayout(savedWidget);
     savedLayout->setContentsMargins(16, 16, 16, 16);
@@ -120,29 +183,36 @@ void CompanionWindow::setupUi() {
     m_characterList->setCharacterTracker(m_characterTracker.get());
     savedLayout->addWidget(m_characterList, 1);
     
-    m_tabWidget->addTab(savedWidget, tr("Saved"));
-    
-    // === TAB 3: Deeds Browser ===
+    return savedWidget;
+}
+
+QWidget* CompanionWindow::createDeedsTab() {
     auto* deedsWidget = new QWidget();
     auto* deedsLayout = new QVBoxLayout(deedsWidget);
     deedsLayout->setContentsMargins(16, 16, 16, 16);
     
     m_deedBrowser = new DeedBrowserWidget();
     deedsLayout->addWidget(m_deedBrowser, 1);
+    connect(&CompanionDataLoader::instance(), &CompanionDataLoader::reloaded,
+            m_deedBrowser, &DeedBrowserWidget::refresh);
     
-    m_tabWidget->addTab(deedsWidget, tr("Deeds"));
-    
-    // === TAB 4: Recipes Browser ===
+    return deedsWidget;
+}
+
+QWidget* CompanionWindow::createRecipesTab() {
     auto* recipesWidget = new QWidget();
     auto* recipesLayout = new QVBoxLayout(recipesWidget);
     recipesLayout->setContentsMargins(16, 16, 16, 16);
     
     m_recipeBrowser = new RecipeBrowserWidget();
     recipesLayout->addWidget(m_recipeBrowser, 1);
+    connect(&CompanionDataLoader::instance(), &CompanionDataLoader::reloaded,
+            m_recipeBrowser, &RecipeBrowserWidget::refresh);
     
-    m_tabWidget->addTab(recipesWidget, tr("Recipes"));
-    
-    // === TAB 5: Gear Simulator ===
+    return recipesWidget;
+}
+
+QWidget* CompanionWindow::createGearTab() {
     auto* gearWidget = new QWidget();
     auto* gearLayout = new QVBoxLayout(gearWidget);
     gearLayout->setContentsMargins(8, 8, 8, 8);
@@ -150,9 +220,10 @@ void CompanionWindow::setupUi() {
     m_gearSimulator = new GearSimulatorWidget();
     gearLayout->addWidget(m_gearSimulator, 1);
     
-    m_tabWidget->addTab(gearWidget, tr("Gear Sim"));
-    
-    // === TAB 6: Export ===
+    return gearWidget;
+}
+
+QWidget* CompanionWindow::createExportTab() {
     auto* exportWidget = new QWidget();
     auto* exportLayout = new QVBoxLayout(exportWidget);
     exportLayout->setContentsMargins(16, 16, 16, 16);
@@ -175,11 +246,7 @@ void CompanionWindow::setupUi() {
     exportLayout->addWidget(openExportBtn);
     
     exportLayout->addStretch();
-    m_tabWidget->addTab(exportWidget, tr("Export"));
-    
-    mainLayout->addWidget(m_tabWidget);
-    
-    spdlog::info("Companion window initialized");
+    return exportWidget;
 }
 
 void CompanionWindow::onSyncToggled() {
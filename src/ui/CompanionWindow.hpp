@@ -8,9 +8,14 @@
 
 #pragma once
 
+#include "companion/CompanionDataLoader.hpp"
+
 #include <QDialog>
+
+#include <array>
 #include <memory>
 
+class QStackedWidget;
 class QTabWidget;
 
 namespace lotro {
@@ -35,6 +40,9 @@ class GearSimulatorWidget;
  * - Recipe browser
  * - Gear simulator
  * - Data export
+ * 
+ * The window opens at once; each tab shows a spinner until
+ * CompanionDataLoader has the data it needs and is built only then.
  */
 class CompanionWindow : public QDialog {
     Q_OBJECT
@@ -51,10 +59,20 @@ public:
 private slots:
     void onSyncToggled();
     void onCharacterSaved(const QString& name, const QString& server);
+    void onStageReady(CompanionStage stage);
 
 private:
     void setupUi();
     
+    // A loading page that onStageReady() replaces with the tab's content
+    QWidget* createPendingTab(CompanionStage stage, const QString& loadingText);
+    QWidget* createTrackerTab();
+    QWidget* createSavedTab();
+    QWidget* createDeedsTab();
+    QWidget* createRecipesTab();
+    QWidget* createGearTab();
+    QWidget* createExportTab();
+    
     QString m_gamePath;
     QTabWidget* m_tabWidget = nullptr;
     std::unique_ptr<CharacterTracker> m_characterTracker;
@@ -66,6 +84,7 @@ private:
     SyncStatusWidget* m_syncStatus = nullptr;
     CharacterTrackerWindow* m_trackerWindow = nullptr;
     QPushButton* m_syncButton = nullptr;
+    std::array<QStackedWidget*, CompanionDataLoader::STAGE_COUNT> m_pendingTabs{};   // Still loading
 };
 
 } // namespace lotro
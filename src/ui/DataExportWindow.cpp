@@ -3,15 +3,22 @@
 #include <QHBoxLayout>
 #include <QGridLayout>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QTextEdit>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QLabel>
 #include <QGroupBox>
 #include <QScrollArea>
 #include <QDesktopServices>
+#include <QFileDialog>
 #include <QUrl>
 #include <QStandardPaths>
 #include <QDir>
+#include <algorithm>
+#include <filesystem>
+
+#include "companion/CharacterTracker.hpp"
 
 namespace lotro {
     
@@ -22,6 +29,8 @@ DataExportWindow::DataExportWindow(DataExporter* exporter, QWidget* parent)
     
     connect(m_exporter, &DataExporter::logMessage, this, &DataExportWindow::onLogMessage);
     connect(m_exporter, &DataExporter::extractionFinished, this, &DataExportWindow::onExtractionFinished);
+    connect(m_exporter, &DataExporter::progress, this, &DataExportWindow::onProgress);
+    connect(m_exporter, &DataExporter::batchProgress, this, &DataExportWindow::onBatchProgress);
 }
 
 void DataExportWindow::setupUi() {
@@ -86,6 +95,12 @@ void DataExportWindow::setupUi() {
     connect(m_startButton, &QPushButton::clicked, this, &DataExportWindow::onStartClicked);
     actionLayout->addWidget(m_startButton);
     
+    m_exportSavedButton = new QPushButton(tr("Export Saved Characters"));
+    m_exportSavedButton->setMinimumHeight(40);
+    m_exportSavedButton->setToolTip(tr("Export every character stored by the tracker, without the game running"));
+    connect(m_exportSavedButton, &QPushButton::clicked, this, &DataExportWindow::onExportSavedClicked);
+    actionLayout->addWidget(m_exportSavedButton);
+    
     auto openFolderBtn = new QPushButton(tr("Open Export Folder"));
     openFolderBtn->setMinimumHeight(40);
     connect(openFolderBtn, &QPushButton::clicked, this, []() {
@@ -96,10 +111,39 @@ void DataExportWindow::setupUi() {
     });
     actionLayout->addWidget(openFolderBtn);
     
+    m_formatCombo = new QComboBox();
+    m_formatCombo->addItem(tr("JSON"), static_cast<int>(ExportFormat::Json));
+    m_formatCombo->addItem(tr("CBOR (compact)"), static_cast<int>(ExportFormat::Cbor));
+    m_formatCombo->setToolTip(tr("CBOR holds the same data in a smaller binary file"));
+    m_formatCombo->setCurrentIndex(m_formatCombo->findData(static_cast<int>(m_exporter->format())));
+    connect(m_formatCombo, &QComboBox::currentIndexChanged, this, [this]() {
+        m_exporter->setFormat(static_cast<ExportFormat>(m_formatCombo->currentData().toInt()));
+    });
+    actionLayout->addWidget(new QLabel(tr("Format:")));
+    actionLayout->addWidget(m_formatCombo);
+    
+    m_incrementalCheck = new QCheckBox(tr("Only changes since last export"));
+    m_incrementalCheck->setToolTip(tr("Write a delta against the previous export of the same character"));
+    m_incrementalCheck->setChecked(m_exporter->incremental());
+    connect(m_incrementalCheck, &QCheckBox::toggled, m_exporter, &DataExporter::setIncremental);
+    actionLayout->addWidget(m_incrementalCheck);
+    
+    auto rebuildBtn = new QPushButton(tr("Rebuild Full Export..."));
+    rebuildBtn->setMinimumHeight(40);
+    rebuildBtn->setToolTip(tr("Combine a full export and the deltas after it into one full export"));
+    connect(rebuildBtn, &QPushButton::clicked, this, &DataExportWindow::onRebuildClicked);
+    actionLayout->addWidget(rebuildBtn);
+    
     actionLayout->addStretch();
     
     rightLayout->addWidget(actionContainer);
     
+    m_progressBar = new QProgressBar();
+    m_progressBar->setRange(0, 1);
+    m_progressBar->setValue(0);
+    m_progressBar->setTextVisible(true);
+    rightLayout->addWidget(m_progressBar);
+    
     // Results Group
     auto resultsGroup = new QGroupBox(tr("Extraction Log"));
     auto resultsLayout = new QVBoxLayout(resultsGroup);
@@ -113,24 +157,67 @@ void DataExportWindow::setupUi() {
     mainLayout->addLayout(rightLayout, 2);
 }
 
-void DataExportWindow::onStartClicked() {
-    m_startButton->setEnabled(false);
-    m_logView->clear();
-    
+std::vector<ExtractableElement> DataExportWindow::selectedElements() const {
     std::vector<ExtractableElement> toExport;
     for(auto const& [id, chk] : m_checkBoxes) {
         if(chk->isChecked()) toExport.push_back(id);
     }
+    return toExport;
+}
+
+void DataExportWindow::onStartClicked() {
+    m_startButton->setEnabled(false);
+    m_exportSavedButton->setEnabled(false);
+    m_logView->clear();
     
+    auto toExport = selectedElements();
     if (toExport.empty()) {
         m_logView->append("No elements selected! Please select at least one data type to export.");
         m_startButton->setEnabled(true);
+        m_exportSavedButton->setEnabled(true);
         return;
     }
 
     m_exporter->extract(toExport);
 }
 
+void DataExportWindow::onExportSavedClicked() {
+    m_logView->clear();
+    
+    auto toExport = selectedElements();
+    if (toExport.empty()) {
+        m_logView->append("No elements selected! Please select at least one data type to export.");
+        return;
+    }
+    
+    auto dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    CharacterTracker tracker(std::filesystem::path(dataDir.toStdString()) / "companion");
+    auto characters = tracker.getCharacters();
+    if (characters.empty()) {
+        m_logView->append("No saved characters. Save a character from the Character Tracker first.");
+        return;
+    }
+    
+    m_startButton->setEnabled(false);
+    m_exportSavedButton->setEnabled(false);
+    m_exporter->exportStoredCharacters(characters, toExport);
+}
+
+void DataExportWindow::onRebuildClicked() {
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) 
+                  + "/lotro-launcher/exports";
+    QStringList files = QFileDialog::getOpenFileNames(this, tr("Select a Full Export and Its Deltas"), dir,
+                                                      tr("Exports (*.json *.cbor)"));
+    if (files.isEmpty()) {
+        return;
+    }
+    
+    m_logView->clear();
+    m_startButton->setEnabled(false);
+    m_exportSavedButton->setEnabled(false);
+    m_exporter->rebuildExport(files);
+}
+
 void DataExportWindow::onSelectAllClicked() {
     for(auto const& [id, chk] : m_checkBoxes) chk->setChecked(true);
 }
@@ -145,6 +232,20 @@ void DataExportWindow::onLogMessage(const QString& msg) {
 
 void DataExportWindow::onExtractionFinished() {
     m_startButton->setEnabled(true);
+    m_exportSavedButton->setEnabled(true);
+}
+
+void DataExportWindow::onProgress(int elementsDone, int elementsTotal, qint64 bytesWritten) {
+    m_progressBar->setRange(0, std::max(elementsTotal, 1));
+    m_progressBar->setValue(elementsDone);
+    m_progressBar->setFormat(tr("%1 of %2 elements, %3 KB written")
+                             .arg(elementsDone).arg(elementsTotal).arg(bytesWritten / 1024));
+}
+
+void DataExportWindow::onBatchProgress(int done, int total) {
+    m_progressBar->setRange(0, std::max(total, 1));
+    m_progressBar->setValue(done);
+    m_progressBar->setFormat(tr("%1 of %2 characters").arg(done).arg(total));
 }
 
 } // namespace lotro
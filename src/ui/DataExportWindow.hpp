@@ -5,7 +5,9 @@
 #include "companion/export/DataExporter.hpp"
 
 class QCheckBox;
+class QComboBox;
 class QTextEdit;
+class QProgressBar;
 class QPushButton;
 
 namespace lotro {
@@ -21,18 +23,27 @@ public:
     
 private slots:
     void onStartClicked();
+    void onExportSavedClicked();
+    void onRebuildClicked();
     void onSelectAllClicked();
     void onUnselectAllClicked();
     void onLogMessage(const QString& msg);
     void onExtractionFinished();
+    void onProgress(int elementsDone, int elementsTotal, qint64 bytesWritten);
+    void onBatchProgress(int done, int total);
 
 private:
     void setupUi();
+    std::vector<ExtractableElement> selectedElements() const;
 
     DataExporter* m_exporter;
     std::map<ExtractableElement, QCheckBox*> m_checkBoxes;
     QTextEdit* m_logView;
     QPushButton* m_startButton;
+    QPushButton* m_exportSavedButton;
+    QComboBox* m_formatCombo;
+    QCheckBox* m_incrementalCheck;
+    QProgressBar* m_progressBar;
 };
 
 } // namespace lotro
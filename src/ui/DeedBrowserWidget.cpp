@@ -5,13 +5,15 @@
  */
 
 #include "DeedBrowserWidget.hpp"
+#include "DeedListModel.hpp"
 #include "companion/GameDatabase.hpp"
+#include "core/StallWatchdog.hpp"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLineEdit>
 #include <QComboBox>
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
 #include <QLabel>
 #include <QTextEdit>
@@ -22,21 +24,6 @@
 
 namespace lotro {
 
-// Category name helper
-static QString categoryName(DeedCategory cat) {
-    switch (cat) {
-        case DeedCategory::Class: return "Class";
-        case DeedCategory::Race: return "Race";
-        case DeedCategory::Social: return "Social";
-        case DeedCategory::Exploration: return "Exploration";
-        case DeedCategory::Quest: return "Quest";
-        case DeedCategory::Reputation: return "Reputation";
-        case DeedCategory::Slayer: return "Slayer";
-        case DeedCategory::Lore: return "Lore";
-        default: return "Unknown";
-    }
-}
-
 DeedBrowserWidget::DeedBrowserWidget(QWidget* parent)
     : QWidget(parent)
 {
@@ -85,17 +72,27 @@ void DeedBrowserWidget::setupUi() {
     auto* splitter = new QSplitter(Qt::Vertical);
     
     // Deed table
-    m_deedTable = new QTableWidget();
-    m_deedTable->setColumnCount(5);
-    m_deedTable->setHorizontalHeaderLabels({tr("Name"), tr("Category"), tr("Region"), tr("Level"), tr("LP")});
+    m_model = new DeedListModel(this);
+    connect(m_model, &DeedListModel::queryFinished, this, [this](int matches) {
+        m_countLabel->setText(tr("%1 deeds").arg(matches));
+        m_detailsView->clear();
+    });
+    
+    m_deedTable = new QTableView();
+    m_deedTable->setModel(m_model);
     m_deedTable->horizontalHeader()->setStretchLastSection(true);
-    m_deedTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_deedTable->horizontalHeader()->setSectionResizeMode(DeedListModel::NameColumn, QHeaderView::Stretch);
     m_deedTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_deedTable->setSelectionMode(QAbstractItemView::SingleSelection);
     m_deedTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     m_deedTable->setAlternatingRowColors(true);
     m_deedTable->verticalHeader()->setVisible(false);
-    connect(m_deedTable, &QTableWidget::itemSelectionChanged,
+    // Fixed row heights, so scrolling never measures rows off screen
+    m_deedTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    // No sort indicator until a header is clicked: search results stay in rank order
+    m_deedTable->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    m_deedTable->setSortingEnabled(true);
+    connect(m_deedTable->selectionModel(), &QItemSelectionModel::currentRowChanged,
             this, &DeedBrowserWidget::onDeedSelected);
     splitter->addWidget(m_deedTable);
     
@@ -111,58 +108,15 @@ void DeedBrowserWidget::setupUi() {
 }
 
 void DeedBrowserWidget::refresh() {
-    auto& db = GameDatabase::instance();
-    
-    if (!db.isLoaded()) {
+    StallScope stallScope("DeedBrowserWidget::refresh");
+    if (!GameDatabase::current()->isLoaded()) {
         m_countLabel->setText(tr("Database not loaded"));
-        m_deedTable->setRowCount(0);
+        m_model->clear();
         return;
     }
     
-    // Get deeds based on current filter
-    int categoryIndex = m_categoryCombo->currentData().toInt();
-    QString searchText = m_searchEdit->text();
-    
-    if (categoryIndex >= 0 && searchText.isEmpty()) {
-        // Filter by category only
-        m_currentDeeds = db.getDeedsByCategory(static_cast<DeedCategory>(categoryIndex));
-    } else if (!searchText.isEmpty()) {
-        // Search 
-        auto results = db.searchDeeds(searchText);
-        
-        // Also filter by category if selected
-        if (categoryIndex >= 0) {
-            DeedCategory cat = static_cast<DeedCategory>(categoryIndex);
-            m_currentDeeds.clear();
-            for (const auto& deed : results) {
-                if (deed.category == cat) {
-                    m_currentDeeds.push_back(deed);
-                }
-            }
-        } else {
-            m_currentDeeds = results;
-        }
-    } else {
-        // Show all deeds (use search with empty for all)
-        m_currentDeeds = db.searchDeeds("");
-    }
-    
-    populateDeeds(m_currentDeeds);
-}
-
-void DeedBrowserWidget::populateDeeds(const std::vector<Deed>& deeds) {
-    m_deedTable->setRowCount(static_cast<int>(deeds.size()));
-    m_countLabel->setText(tr("%1 deeds").arg(deeds.size()));
-    
-    int row = 0;
-    for (const auto& deed : deeds) {
-        m_deedTable->setItem(row, 0, new QTableWidgetItem(deed.name));
-        m_deedTable->setItem(row, 1, new QTableWidgetItem(categoryName(deed.category)));
-        m_deedTable->setItem(row, 2, new QTableWidgetItem(deed.region));
-        m_deedTable->setItem(row, 3, new QTableWidgetItem(deed.level > 0 ? QString::number(deed.level) : "-"));
-        m_deedTable->setItem(row, 4, new QTableWidgetItem(deed.lotroPoints > 0 ? QString::number(deed.lotroPoints) : "-"));
-        row++;
-    }
+    // Runs off the GUI thread; the count label follows when it is done
+    m_model->setQuery(m_searchEdit->text(), m_categoryCombo->currentData().toInt());
 }
 
 void DeedBrowserWidget::onSearchChanged(const QString& /*text*/) {
@@ -174,19 +128,19 @@ void DeedBrowserWidget::onCategoryChanged(int /*index*/) {
 }
 
 void DeedBrowserWidget::onDeedSelected() {
-    int row = m_deedTable->currentRow();
-    if (row < 0 || row >= static_cast<int>(m_currentDeeds.size())) {
+    const Deed* deed = m_model->deedAt(m_deedTable->currentIndex().row());
+    if (!deed) {
         m_detailsView->clear();
         return;
     }
     
-    showDeedDetails(m_currentDeeds[row]);
+    showDeedDetails(*deed);
 }
 
 void DeedBrowserWidget::showDeedDetails(const Deed& deed) {
     QString html = QString("<h3>%1</h3>").arg(deed.name.toHtmlEscaped());
     
-    html += QString("<p><b>Category:</b> %1</p>").arg(categoryName(deed.category));
+    html += QString("<p><b>Category:</b> %1</p>").arg(DeedListModel::categoryName(deed.category));
     
     if (!deed.region.isEmpty()) {
         html += QString("<p><b>Region:</b> %1</p>").arg(deed.region.toHtmlEscaped());
@@ -13,12 +13,14 @@
 
 class QLineEdit;
 class QComboBox;
-class QTableWidget;
+class QTableView;
 class QLabel;
 class QTextEdit;
 
 namespace lotro {
 
+class DeedListModel;
+
 /**
  * Widget for browsing deeds
  */
@@ -41,16 +43,14 @@ private slots:
 
 private:
     void setupUi();
-    void populateDeeds(const std::vector<Deed>& deeds);
     void showDeedDetails(const Deed& deed);
     
     QLineEdit* m_searchEdit = nullptr;
     QComboBox* m_categoryCombo = nullptr;
-    QTableWidget* m_deedTable = nullptr;
+    QTableView* m_deedTable = nullptr;
+    DeedListModel* m_model = nullptr;
     QTextEdit* m_detailsView = nullptr;
     QLabel* m_countLabel = nullptr;
-    
-    std::vector<Deed> m_currentDeeds;
 };
 
 } // namespace lotro
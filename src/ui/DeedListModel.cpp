@@ -0,0 +1,161 @@
+/**
+ * LOTRO Launcher - Deed List Model Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "DeedListModel.hpp"
+
+#include <QStringList>
+
+#include <algorithm>
+
+namespace lotro {
+
+DeedListModel::DeedListModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+DeedListModel::~DeedListModel() {
+    m_query.cancel();
+}
+
+QString DeedListModel::categoryName(DeedCategory category) {
+    switch (category) {
+        case DeedCategory::Class: return "Class";
+        case DeedCategory::Race: return "Race";
+        case DeedCategory::Social: return "Social";
+        case DeedCategory::Exploration: return "Exploration";
+        case DeedCategory::Quest: return "Quest";
+        case DeedCategory::Reputation: return "Reputation";
+        case DeedCategory::Slayer: return "Slayer";
+        case DeedCategory::Lore: return "Lore";
+        default: return "Unknown";
+    }
+}
+
+void DeedListModel::setQuery(const QString& text, int category) {
+    m_text = text;
+    m_category = category;
+    requery();
+}
+
+void DeedListModel::clear() {
+    m_query.cancel();
+    beginResetModel();
+    m_db.reset();
+    m_deeds = {};
+    m_order.clear();
+    endResetModel();
+}
+
+void DeedListModel::sort(int column, Qt::SortOrder order) {
+    m_sortColumn = column;
+    m_sortOrder = order;
+    requery();
+}
+
+void DeedListModel::requery() {
+    m_query.cancel();
+    m_query = CancellationToken();
+    const CancellationToken token = m_query;
+    
+    auto future = TaskScheduler::instance().run(TaskPool::Cpu, token,
+        [token, text = m_text, category = m_category, column = m_sortColumn, order = m_sortOrder,
+         generation = GameDatabase::current()]() {
+            const auto& db = *generation;
+            Result result;
+            result.db = generation;
+            result.deeds = db.deedsView();
+            
+            if (!text.isEmpty()) {
+                result.order = db.searchDeedPositions(text);
+                if (category >= 0) {
+                    std::erase_if(result.order, [&](uint32_t i) {
+                        return static_cast<int>(result.deeds[i].category) != category;
+                    });
+                }
+            } else if (category >= 0) {
+                auto positions = db.deedPositionsByCategory(static_cast<DeedCategory>(category));
+                result.order.assign(positions.begin(), positions.end());
+            } else {
+                result.order.resize(result.deeds.size());
+                for (uint32_t i = 0; i < result.order.size(); ++i) {
+                    result.order[i] = i;
+                }
+            }
+            
+            if (column < 0 || token.isCancelled()) {
+                return result;
+            }
+            auto compare = [&](uint32_t left, uint32_t right) -> int {
+                const Deed& a = result.deeds[left];
+                const Deed& b = result.deeds[right];
+                switch (column) {
+                    case CategoryColumn:
+                        return categoryName(a.category).compare(categoryName(b.category));
+                    case RegionColumn: return a.region.compare(b.region, Qt::CaseInsensitive);
+                    case LevelColumn: return a.level - b.level;
+                    case PointsColumn: return a.lotroPoints - b.lotroPoints;
+                    default: return a.name.compare(b.name, Qt::CaseInsensitive);
+                }
+            };
+            std::stable_sort(result.order.begin(), result.order.end(), [&](uint32_t left, uint32_t right) {
+                return order == Qt::AscendingOrder ? compare(left, right) < 0 : compare(right, left) < 0;
+            });
+            return result;
+        });
+    
+    TaskScheduler::then(future, this, token, [this](Result result) {
+        beginResetModel();
+        m_db = std::move(result.db);
+        m_deeds = result.deeds;
+        m_order = std::move(result.order);
+        endResetModel();
+        emit queryFinished(static_cast<int>(m_order.size()));
+    });
+}
+
+const Deed* DeedListModel::deedAt(int row) const {
+    if (row < 0 || row >= static_cast<int>(m_order.size())) {
+        return nullptr;
+    }
+    return &m_deeds[m_order[row]];
+}
+
+int DeedListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_order.size());
+}
+
+int DeedListModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant DeedListModel::data(const QModelIndex& index, int role) const {
+    const Deed* deed = index.isValid() ? deedAt(index.row()) : nullptr;
+    if (!deed || role != Qt::DisplayRole) {
+        return {};
+    }
+    
+    switch (index.column()) {
+        case NameColumn: return deed->name;
+        case CategoryColumn: return categoryName(deed->category);
+        case RegionColumn: return deed->region;
+        case LevelColumn: return deed->level > 0 ? QString::number(deed->level) : QString("-");
+        case PointsColumn: return deed->lotroPoints > 0 ? QString::number(deed->lotroPoints) : QString("-");
+    }
+    return {};
+}
+
+QVariant DeedListModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return {};
+    }
+    static const QStringList headers = {
+        tr("Name"), tr("Category"), tr("Region"), tr("Level"), tr("LP")
+    };
+    return headers.value(section);
+}
+
+} // namespace lotro
@@ -0,0 +1,93 @@
+/**
+ * LOTRO Launcher - Deed List Model
+ * 
+ * Item model behind the deed browser's table.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "companion/GameDatabase.hpp"
+#include "core/TaskScheduler.hpp"
+
+#include <QAbstractTableModel>
+#include <QString>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Deeds matching a search and category, by position in the database
+ * 
+ * Rows are positions into the deedsView() of the database generation the
+ * query ran against, which the model holds on to, and cells are
+ * formatted in data() when the view asks, so only rows on screen cost
+ * anything. Searching, filtering and sorting run on the CPU pool; a new
+ * query cancels the one before it, whose result is dropped if it was
+ * already running. Without a sort column rows keep search rank order.
+ */
+class DeedListModel : public QAbstractTableModel {
+    Q_OBJECT
+    
+public:
+    enum Column {
+        NameColumn, CategoryColumn, RegionColumn, LevelColumn, PointsColumn,
+        ColumnCount
+    };
+    
+    explicit DeedListModel(QObject* parent = nullptr);
+    ~DeedListModel() override;
+    
+    /**
+     * Show deeds matching the text, in one category or all when category < 0
+     */
+    void setQuery(const QString& text, int category);
+    
+    /**
+     * Drop all rows and any query still running
+     */
+    void clear();
+    
+    /**
+     * The deed shown in a row, nullptr if out of range
+     */
+    const Deed* deedAt(int row) const;
+    
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+    
+    static QString categoryName(DeedCategory category);
+    
+signals:
+    /**
+     * A query's rows are in place
+     */
+    void queryFinished(int matches);
+    
+private:
+    struct Result {
+        std::shared_ptr<const GameDatabase> db;
+        std::span<const Deed> deeds;
+        std::vector<uint32_t> order;
+    };
+    
+    void requery();
+    
+    std::shared_ptr<const GameDatabase> m_db;   // Generation m_deeds belongs to
+    std::span<const Deed> m_deeds;
+    std::vector<uint32_t> m_order;      // Matching positions in m_deeds, in display order
+    QString m_text;
+    int m_category = -1;
+    int m_sortColumn = -1;              // -1 keeps search rank order
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+    CancellationToken m_query;
+};
+
+} // namespace lotro
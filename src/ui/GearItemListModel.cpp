@@ -0,0 +1,133 @@
+/**
+ * LOTRO Launcher - Gear Item List Model Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "GearItemListModel.hpp"
+#include "companion/TextSearchIndex.hpp"
+
+#include <QColor>
+
+#include <algorithm>
+#include <array>
+
+namespace lotro {
+
+GearItemListModel::GearItemListModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+GearItemListModel::~GearItemListModel() {
+    m_query.cancel();
+}
+
+void GearItemListModel::setQuery(EquipSlot slot, const QString& text, const QString& characterClass,
+                                 std::shared_ptr<const UpgradeRanker> ranker) {
+    m_query.cancel();
+    m_query = CancellationToken();
+    const CancellationToken token = m_query;
+    
+    // Rows already filtered for this slot and class, if this search narrows
+    // them and the database hasn't been reloaded since
+    auto generation = ItemDatabase::current();
+    std::shared_ptr<const Positions> previous;
+    if (m_order && generation == m_db && slot == m_slot && characterClass == m_characterClass &&
+        TextSearchIndex::narrows(m_text, text)) {
+        previous = m_order;
+    }
+    
+    auto future = TaskScheduler::instance().run(TaskPool::Cpu, token,
+        [slot, text, characterClass, previous, ranker, generation]() {
+            const auto& db = *generation;
+            Result result;
+            result.db = generation;
+            result.items = db.itemsView();
+            
+            auto usable = [&](uint32_t i) {
+                const GearItem& item = result.items[i];
+                return characterClass.isEmpty() || item.requiredClass.isEmpty() ||
+                       item.requiredClass == characterClass;
+            };
+            
+            Positions order;
+            if (previous) {
+                order = db.refineItemPositions(text, *previous);
+            } else if (!text.isEmpty()) {
+                order = db.searchItemPositions(text);
+                std::erase_if(order, [&](uint32_t i) {
+                    return result.items[i].slot != slot || !usable(i);
+                });
+            } else {
+                auto positions = db.itemPositionsBySlot(slot);
+                order.reserve(positions.size());
+                std::copy_if(positions.begin(), positions.end(), std::back_inserter(order), usable);
+            }
+            if (ranker) {
+                Values values;
+                ranker->rank(db, order, values);
+                result.values = std::make_shared<const Values>(std::move(values));
+            }
+            result.order = std::make_shared<const Positions>(std::move(order));
+            return result;
+        });
+    
+    TaskScheduler::then(future, this, token, [this, slot, text, characterClass](Result result) {
+        m_slot = slot;
+        m_text = text;
+        m_characterClass = characterClass;
+        
+        beginResetModel();
+        m_db = std::move(result.db);
+        m_items = result.items;
+        m_order = std::move(result.order);
+        m_values = std::move(result.values);
+        endResetModel();
+        emit queryFinished(rowCount());
+    });
+}
+
+const GearItem* GearItemListModel::itemAt(int row) const {
+    if (!m_order || row < 0 || row >= static_cast<int>(m_order->size())) {
+        return nullptr;
+    }
+    return &m_items[(*m_order)[row]];
+}
+
+int GearItemListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() || !m_order ? 0 : static_cast<int>(m_order->size());
+}
+
+QVariant GearItemListModel::data(const QModelIndex& index, int role) const {
+    const GearItem* item = index.isValid() ? itemAt(index.row()) : nullptr;
+    if (!item) {
+        return {};
+    }
+    
+    switch (role) {
+        case Qt::DisplayRole:
+            if (m_values) {
+                float value = (*m_values)[static_cast<size_t>(index.row())];
+                return QString("%1  (%2%3)").arg(item->name)
+                                            .arg(value >= 0.0f ? QStringLiteral("+") : QString())
+                                            .arg(value, 0, 'f', 0);
+            }
+            return item->name;
+        case Qt::ForegroundRole: {
+            static const auto colors = [] {
+                std::array<QColor, static_cast<size_t>(ItemQuality::Unknown) + 1> result;
+                for (size_t i = 0; i < result.size(); ++i) {
+                    result[i] = QColor(qualityColor(static_cast<ItemQuality>(i)));
+                }
+                return result;
+            }();
+            return colors[static_cast<size_t>(item->quality)];
+        }
+        case Qt::ToolTipRole:
+            return QString("iLvl %1 - %2").arg(item->itemLevel).arg(qualityName(item->quality));
+    }
+    return {};
+}
+
+} // namespace lotro
@@ -0,0 +1,89 @@
+/**
+ * LOTRO Launcher - Gear Item List Model
+ * 
+ * Item model behind the gear simulator's item list.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "companion/ItemDatabase.hpp"
+#include "companion/StatCalculator.hpp"
+#include "core/TaskScheduler.hpp"
+
+#include <QAbstractListModel>
+#include <QString>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Items for one slot matching a search and class, by position in the database
+ * 
+ * Rows are positions into the itemsView() of the database generation the
+ * query ran against, which the model holds on to, and are formatted in
+ * data(), so only rows on screen cost anything. An empty search lists the
+ * slot's index in table order; otherwise the item search index supplies
+ * the matches, word prefixes for short text and trigrams past that,
+ * against names it folded at load time. Queries run on the CPU pool and a
+ * new one cancels the one before it. When the next search in the same
+ * slot only extends the text, the current rows are ranked again instead.
+ * Given an UpgradeRanker, the matches are ordered by upgrade value
+ * instead, and each row shows its value.
+ */
+class GearItemListModel : public QAbstractListModel {
+    Q_OBJECT
+    
+public:
+    explicit GearItemListModel(QObject* parent = nullptr);
+    ~GearItemListModel() override;
+    
+    /**
+     * Show items for a slot matching the text, usable by a class or any when empty
+     * @param ranker Orders the rows by upgrade value when set
+     */
+    void setQuery(EquipSlot slot, const QString& text, const QString& characterClass,
+                  std::shared_ptr<const UpgradeRanker> ranker = nullptr);
+    
+    /**
+     * The item shown in a row, nullptr if out of range
+     */
+    const GearItem* itemAt(int row) const;
+    
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    
+signals:
+    /**
+     * A query's rows are in place
+     */
+    void queryFinished(int matches);
+    
+private:
+    using Positions = std::vector<uint32_t>;
+    
+    using Values = std::vector<float>;
+    
+    struct Result {
+        std::shared_ptr<const ItemDatabase> db;
+        std::span<const GearItem> items;
+        std::shared_ptr<const Positions> order;
+        std::shared_ptr<const Values> values;
+    };
+    
+    std::shared_ptr<const ItemDatabase> m_db;   // Generation m_items belongs to
+    std::span<const GearItem> m_items;
+    std::shared_ptr<const Positions> m_order;   // Matching positions in m_items, in display order
+    std::shared_ptr<const Values> m_values;     // Upgrade value per row, when ranked
+    // Query that m_order answers
+    EquipSlot m_slot = EquipSlot::Unknown;
+    QString m_text;
+    QString m_characterClass;
+    CancellationToken m_query;
+};
+
+} // namespace lotro
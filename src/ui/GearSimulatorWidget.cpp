@@ -5,7 +5,9 @@
  */
 
 #include "GearSimulatorWidget.hpp"
+#include "GearItemListModel.hpp"
 #include "companion/ItemDatabase.hpp"
+#include "core/TaskScheduler.hpp"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -13,10 +15,14 @@
 #include <QGroupBox>
 #include <QLabel>
 #include <QPushButton>
+#include <QListView>
 #include <QListWidget>
 #include <QLineEdit>
+#include <QCheckBox>
 #include <QComboBox>
+#include <QEvent>
 #include <QScrollArea>
+#include <QSignalBlocker>
 
 namespace lotro {
 
@@ -27,11 +33,17 @@ GearSimulatorWidget::GearSimulatorWidget(QWidget* parent)
     setupUi();
 }
 
-GearSimulatorWidget::~GearSimulatorWidget() = default;
+GearSimulatorWidget::~GearSimulatorWidget() {
+    if (m_optimizer) {
+        m_optimizer->cancel();
+    }
+    m_optimizerRun.waitForFinished();
+}
 
 void GearSimulatorWidget::setLevel(int level) {
     m_build.level = level;
-    recalculateStats();
+    m_liveStats.setLevel(level);
+    displayStats(m_liveStats.stats());
 }
 
 void GearSimulatorWidget::setCharacterClass(const QString& className) {
@@ -76,6 +88,8 @@ void GearSimulatorWidget::setupUi() {
     connect(clearBtn, &QPushButton::clicked, this, &GearSimulatorWidget::onClearAll);
     leftLayout->addWidget(clearBtn);
     
+    leftLayout->addWidget(createOptimizerPanel());
+    
     mainLayout->addWidget(leftPanel);
     
     // Center: Item selection
@@ -88,9 +102,23 @@ void GearSimulatorWidget::setupUi() {
             this, &GearSimulatorWidget::onSearchChanged);
     centerLayout->addWidget(m_searchEdit);
     
-    m_itemList = new QListWidget();
-    connect(m_itemList, &QListWidget::currentRowChanged,
-            this, &GearSimulatorWidget::onItemSelected);
+    m_rankUpgrades = new QCheckBox(tr("Sort by upgrade value"));
+    m_rankUpgrades->setToolTip(tr("Order items by how much they raise the stat chosen under Best Gear, "
+                                  "set bonuses included, compared with what is equipped"));
+    connect(m_rankUpgrades, &QCheckBox::toggled, this, [this]() { populateItemList(m_activeSlot); });
+    centerLayout->addWidget(m_rankUpgrades);
+    
+    m_itemModel = new GearItemListModel(this);
+    m_itemList = new QListView();
+    m_itemList->setModel(m_itemModel);
+    m_itemList->setUniformItemSizes(true);
+    m_itemList->setMouseTracking(true);
+    m_itemListViewport = m_itemList->viewport();
+    m_itemListViewport->installEventFilter(this);
+    connect(m_itemList->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, [this](const QModelIndex& current) { onItemSelected(current.row()); });
+    connect(m_itemList, &QListView::entered,
+            this, &GearSimulatorWidget::onItemHovered);
     centerLayout->addWidget(m_itemList);
     
     mainLayout->addWidget(m_itemSelectGroup, 1);
@@ -144,6 +172,41 @@ void GearSimulatorWidget::createSlotButtons() {
     }
 }
 
+QWidget* GearSimulatorWidget::createOptimizerPanel() {
+    auto* group = new QGroupBox(tr("Best Gear"));
+    auto* layout = new QVBoxLayout(group);
+    
+    m_optimizeStatCombo = new QComboBox();
+    const std::vector<StatType> focusStats = {
+        StatType::Might, StatType::Agility, StatType::Will, StatType::Vitality,
+        StatType::Fate, StatType::PhysicalMastery, StatType::TacticalMastery,
+        StatType::CriticalRating, StatType::Finesse, StatType::Morale,
+        StatType::PhysicalMitigation, StatType::TacticalMitigation,
+        StatType::OutgoingHealing
+    };
+    for (StatType type : focusStats) {
+        m_optimizeStatCombo->addItem(statName(type), static_cast<int>(type));
+    }
+    connect(m_optimizeStatCombo, &QComboBox::currentIndexChanged, this, &GearSimulatorWidget::rerankItemList);
+    layout->addWidget(m_optimizeStatCombo);
+    
+    m_optimizeButton = new QPushButton(tr("Find Best Gear"));
+    connect(m_optimizeButton, &QPushButton::clicked, this, &GearSimulatorWidget::onOptimize);
+    layout->addWidget(m_optimizeButton);
+    
+    m_optimizeStatus = new QLabel();
+    m_optimizeStatus->setWordWrap(true);
+    layout->addWidget(m_optimizeStatus);
+    
+    m_optimizedList = new QListWidget();
+    m_optimizedList->setToolTip(tr("Click a build to equip it"));
+    connect(m_optimizedList, &QListWidget::currentRowChanged,
+            this, &GearSimulatorWidget::onOptimizedBuildSelected);
+    layout->addWidget(m_optimizedList);
+    
+    return group;
+}
+
 void GearSimulatorWidget::createStatDisplay() {
     int row = 0;
     
@@ -218,14 +281,32 @@ void GearSimulatorWidget::onSlotClicked(int slot) {
 }
 
 void GearSimulatorWidget::onItemSelected(int row) {
-    if (row < 0 || row >= static_cast<int>(m_visibleItems.size())) {
+    const GearItem* item = m_itemModel->itemAt(row);
+    if (!item) {
         return;
     }
     
-    const auto& item = m_visibleItems[row];
-    m_build.equip(item);
-    updateSlotButton(item.slot);
-    recalculateStats();
+    m_build.equip(*item);
+    m_liveStats.equip(*item);
+    updateSlotButton(item->slot);
+    displayStats(m_liveStats.stats());
+}
+
+void GearSimulatorWidget::onItemHovered(const QModelIndex& index) {
+    const GearItem* item = m_itemModel->itemAt(index.row());
+    if (!item) {
+        return;
+    }
+    
+    // Show the stats with the hovered item in place of the equipped one
+    displayStats(m_liveStats.preview(*item));
+}
+
+bool GearSimulatorWidget::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == m_itemListViewport && event->type() == QEvent::Leave) {
+        displayStats(m_liveStats.stats());
+    }
+    return QWidget::eventFilter(watched, event);
 }
 
 void GearSimulatorWidget::onSearchChanged(const QString& text) {
@@ -244,8 +325,85 @@ void GearSimulatorWidget::onClearAll() {
 }
 
 void GearSimulatorWidget::recalculateStats() {
-    auto stats = m_calculator.calculate(m_build);
-    displayStats(stats);
+    m_liveStats.reset(m_build);
+    displayStats(m_liveStats.stats());
+    rerankItemList();
+}
+
+void GearSimulatorWidget::onOptimize() {
+    if (m_optimizer) {
+        m_optimizer->cancel();
+        return;
+    }
+    
+    OptimizerRequest request;
+    request.characterClass = m_build.characterClass;
+    request.level = m_build.level;
+    request.topN = OPTIMIZER_TOP_BUILDS;
+    request.setWeight(static_cast<StatType>(m_optimizeStatCombo->currentData().toInt()), 1.0);
+    for (const auto& [type, value] : m_build.baseStats) {
+        if (type != StatType::Unknown) {
+            request.baseStats[type] = value;
+        }
+    }
+    
+    m_optimizer = std::make_unique<GearOptimizer>(std::move(request));
+    GearOptimizer* optimizer = m_optimizer.get();
+    m_optimizeButton->setText(tr("Stop"));
+    m_optimizeStatus->setText(tr("Searching..."));
+    
+    auto progressCallback = [this](const OptimizerProgress& progress) {
+        QMetaObject::invokeMethod(this, [this, progress]() {
+            showOptimizerProgress(progress);
+        }, Qt::QueuedConnection);
+    };
+    
+    m_optimizerRun = TaskScheduler::instance().run(TaskPool::Cpu, [this, optimizer, progressCallback]() {
+        optimizer->run(progressCallback);
+        QMetaObject::invokeMethod(this, &GearSimulatorWidget::optimizerFinished, Qt::QueuedConnection);
+    });
+}
+
+void GearSimulatorWidget::showOptimizerProgress(const OptimizerProgress& progress) {
+    m_optimizeStatus->setText(tr("%1 builds checked, %2 branches pruned (%3%)")
+        .arg(progress.buildsEvaluated)
+        .arg(progress.branchesPruned)
+        .arg(progress.percentage()));
+    
+    m_optimizedBuilds = progress.best;
+    QSignalBlocker blocker(m_optimizedList);
+    m_optimizedList->clear();
+    for (size_t i = 0; i < m_optimizedBuilds.size(); ++i) {
+        const auto& result = m_optimizedBuilds[i];
+        m_optimizedList->addItem(tr("#%1: %2 %3")
+            .arg(i + 1)
+            .arg(result.score, 0, 'f', 0)
+            .arg(m_optimizeStatCombo->currentText()));
+    }
+}
+
+void GearSimulatorWidget::optimizerFinished() {
+    m_optimizerRun.waitForFinished();
+    m_optimizer.reset();
+    m_optimizeButton->setText(tr("Find Best Gear"));
+    if (m_optimizedBuilds.empty()) {
+        m_optimizeStatus->setText(tr("No items found for this class and level"));
+    }
+}
+
+void GearSimulatorWidget::onOptimizedBuildSelected(int row) {
+    if (row < 0 || row >= static_cast<int>(m_optimizedBuilds.size())) {
+        return;
+    }
+    
+    m_build.clearGear();
+    for (const auto& [slot, item] : m_optimizedBuilds[row].build.equipment) {
+        m_build.equip(item);
+    }
+    for (auto& [slot, btn] : m_slotButtons) {
+        updateSlotButton(slot);
+    }
+    recalculateStats();
 }
 
 void GearSimulatorWidget::updateSlotButton(EquipSlot slot) {
@@ -269,34 +427,18 @@ void GearSimulatorWidget::updateSlotButton(EquipSlot slot) {
 }
 
 void GearSimulatorWidget::populateItemList(EquipSlot slot) {
-    m_itemList->clear();
-    m_visibleItems.clear();
-    
-    auto& itemDb = ItemDatabase::instance();
-    auto items = itemDb.getItemsBySlot(slot);
-    
-    QString filter = m_searchEdit->text().toLower();
-    
-    for (const auto& item : items) {
-        // Filter by search
-        if (!filter.isEmpty() && 
-            !item.name.toLower().contains(filter)) {
-            continue;
-        }
-        
-        // Filter by class if set
-        if (!m_build.characterClass.isEmpty() &&
-            !item.requiredClass.isEmpty() &&
-            item.requiredClass != m_build.characterClass) {
-            continue;
-        }
-        
-        m_visibleItems.push_back(item);
-        
-        auto* listItem = new QListWidgetItem(item.name);
-        listItem->setForeground(QColor(qualityColor(item.quality)));
-        listItem->setToolTip(QString("iLvl %1 - %2").arg(item.itemLevel).arg(qualityName(item.quality)));
-        m_itemList->addItem(listItem);
+    std::shared_ptr<const UpgradeRanker> ranker;
+    if (m_rankUpgrades->isChecked() && m_optimizeStatCombo) {
+        UpgradeRanker::Weights weights{};
+        weights[static_cast<size_t>(m_optimizeStatCombo->currentData().toInt())] = 1.0;
+        ranker = std::make_shared<const UpgradeRanker>(m_liveStats.ranker(slot, weights));
+    }
+    m_itemModel->setQuery(slot, m_searchEdit->text(), m_build.characterClass, std::move(ranker));
+}
+
+void GearSimulatorWidget::rerankItemList() {
+    if (m_rankUpgrades && m_rankUpgrades->isChecked()) {
+        populateItemList(m_activeSlot);
     }
 }
 
@@ -8,14 +8,20 @@
 
 #pragma once
 
+#include <QFuture>
 #include <QWidget>
+#include <memory>
+#include "companion/GearOptimizer.hpp"
 #include "companion/StatCalculator.hpp"
 
+class QCheckBox;
 class QComboBox;
 class QLabel;
 class QPushButton;
+class QListView;
 class QListWidget;
 class QGroupBox;
+class QModelIndex;
 class QGridLayout;
 class QLineEdit;
 
@@ -28,6 +34,7 @@ namespace lotro {
  * - Select items for each equipment slot
  * - View calculated total stats
  * - Compare different equipment setups
+ * - Search for the best gear for a chosen stat (GearOptimizer)
  */
 class GearSimulatorWidget : public QWidget {
     Q_OBJECT
@@ -45,13 +52,19 @@ public:
      * Set character class for filtering
      */
     void setCharacterClass(const QString& className);
+    
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
 
 private slots:
     void onSlotClicked(int slot);
     void onItemSelected(int row);
+    void onItemHovered(const QModelIndex& index);
     void onSearchChanged(const QString& text);
     void onClearAll();
     void recalculateStats();
+    void onOptimize();
+    void onOptimizedBuildSelected(int row);
 
 private:
     void setupUi();
@@ -59,10 +72,16 @@ private:
     void createStatDisplay();
     void updateSlotButton(EquipSlot slot);
     void populateItemList(EquipSlot slot);
+    
+    // Refill the item list if its order depends on the loadout
+    void rerankItemList();
     void displayStats(const CalculatedStats& stats);
+    QWidget* createOptimizerPanel();
+    void showOptimizerProgress(const OptimizerProgress& progress);
+    void optimizerFinished();
     
     CharacterBuild m_build;
-    StatCalculator m_calculator;
+    IncrementalStatCalculator m_liveStats;
     EquipSlot m_activeSlot = EquipSlot::Head;
     
     // Slot buttons
@@ -71,12 +90,25 @@ private:
     // Item selection
     QGroupBox* m_itemSelectGroup = nullptr;
     QLineEdit* m_searchEdit = nullptr;
-    QListWidget* m_itemList = nullptr;
-    std::vector<GearItem> m_visibleItems;
+    QCheckBox* m_rankUpgrades = nullptr;     // Order by upgrade value for the optimizer's stat
+    QListView* m_itemList = nullptr;
+    class GearItemListModel* m_itemModel = nullptr;
+    QWidget* m_itemListViewport = nullptr;   // Hover previews end when the mouse leaves it
     
     // Stats display
     QGridLayout* m_statsGrid = nullptr;
     std::map<QString, QLabel*> m_statLabels;
+    
+    // Optimizer
+    QComboBox* m_optimizeStatCombo = nullptr;
+    QPushButton* m_optimizeButton = nullptr;
+    QLabel* m_optimizeStatus = nullptr;
+    QListWidget* m_optimizedList = nullptr;
+    std::vector<OptimizedBuild> m_optimizedBuilds;
+    std::unique_ptr<GearOptimizer> m_optimizer;
+    QFuture<void> m_optimizerRun;
+    
+    static constexpr size_t OPTIMIZER_TOP_BUILDS = 10;
 };
 
 } // namespace lotro
@@ -0,0 +1,171 @@
+/**
+ * LOTRO Launcher - Icon Cache Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "IconCache.hpp"
+#include "core/platform/Platform.hpp"
+#include "dat/DataFacade.hpp"
+#include "dat/SurfaceImage.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QPainter>
+#include <QSaveFile>
+
+namespace lotro {
+
+namespace {
+
+// Bytes fetched by the I/O stage: a saved thumbnail or a raw DAT entry
+struct Fetched {
+    QByteArray data;
+    bool thumbnail = false;
+};
+
+void saveThumbnail(const QString& path, const QImage& image) {
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly) && image.save(&file, "PNG")) {
+        file.commit();
+    }
+}
+
+} // namespace
+
+IconCache::IconCache(dat::DataFacade* facade, QObject* parent)
+    : QObject(parent)
+    , m_facade(facade)
+    , m_thumbnailDir(QDir(QString::fromStdString(Platform::getCachePath().string())).filePath("icons"))
+    , m_pixmaps(PIXMAP_CACHE_SIZE)
+{
+    QDir().mkpath(m_thumbnailDir);
+}
+
+IconCache::~IconCache() {
+    m_loads.cancel();
+}
+
+bool IconCache::paint(QPainter* painter, const QRect& target, int iconId) {
+    auto it = m_cells.constFind(iconId);
+    if (it == m_cells.constEnd()) {
+        request(iconId, TaskPriority::Normal);
+        return false;
+    }
+    painter->drawPixmap(target, m_pages[it->page], cellRect(it->index));
+    return true;
+}
+
+QPixmap IconCache::pixmap(int iconId) {
+    if (const QPixmap* cached = m_pixmaps.object(iconId)) {
+        return *cached;
+    }
+    auto it = m_cells.constFind(iconId);
+    if (it == m_cells.constEnd()) {
+        request(iconId, TaskPriority::Normal);
+        return {};
+    }
+    QPixmap pixmap = m_pages[it->page].copy(cellRect(it->index));
+    m_pixmaps.insert(iconId, new QPixmap(pixmap));
+    return pixmap;
+}
+
+void IconCache::prefetch(std::span<const int> iconIds) {
+    for (int iconId : iconIds) {
+        if (!m_cells.contains(iconId)) {
+            request(iconId, TaskPriority::Low);
+        }
+    }
+}
+
+void IconCache::request(int iconId, TaskPriority priority) {
+    if (iconId <= 0 || m_pending.contains(iconId) || m_missing.contains(iconId)) {
+        return;
+    }
+    m_pending.insert(iconId);
+    
+    auto& scheduler = TaskScheduler::instance();
+    const QString path = thumbnailPath(iconId);
+    dat::DataFacade* facade = m_facade;
+    
+    auto fetched = scheduler.run(TaskPool::Io, m_loads, [facade, path, iconId]() {
+        Fetched result;
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly)) {
+            result.data = file.readAll();
+            result.thumbnail = true;
+        } else {
+            result.data = facade->loadData(static_cast<uint32_t>(iconId));
+        }
+        return result;
+    }, priority);
+    
+    auto decoded = fetched.then(scheduler.pool(TaskPool::Cpu), [path](Fetched result) {
+        if (result.thumbnail) {
+            return QImage::fromData(result.data, "PNG");
+        }
+        QImage image = dat::decodeSurface(result.data);
+        if (image.isNull()) {
+            return image;
+        }
+        if (image.width() != ICON_SIZE || image.height() != ICON_SIZE) {
+            image = image.scaled(ICON_SIZE, ICON_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        TaskScheduler::instance().run(TaskPool::Io, [path, image]() {
+            saveThumbnail(path, image);
+        }, TaskPriority::Low);
+        return image;
+    });
+    
+    TaskScheduler::then(decoded, this, m_loads, [this, iconId](QImage image) {
+        m_pending.remove(iconId);
+        if (image.isNull()) {
+            m_missing.insert(iconId);
+            return;
+        }
+        store(iconId, image);
+        emit iconReady(iconId);
+    });
+}
+
+void IconCache::store(int iconId, const QImage& thumbnail) {
+    if (m_nextCell == MAX_PAGES * CELLS_PER_PAGE) {
+        m_nextCell = 0;
+    }
+    Cell cell{m_nextCell / CELLS_PER_PAGE, m_nextCell % CELLS_PER_PAGE};
+    ++m_nextCell;
+    
+    if (cell.page == static_cast<int>(m_pages.size())) {
+        QPixmap page(PAGE_SIZE, PAGE_SIZE);
+        page.fill(Qt::transparent);
+        m_pages.push_back(std::move(page));
+        m_pageIcons.emplace_back(CELLS_PER_PAGE, 0);
+    } else if (int evicted = m_pageIcons[cell.page][cell.index]) {
+        // Pages are full: the oldest icon gives up its cell
+        m_cells.remove(evicted);
+    }
+    
+    // Center icons that were scaled to keep their aspect ratio
+    const QRect rect = cellRect(cell.index);
+    QPainter painter(&m_pages[cell.page]);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(rect, Qt::transparent);
+    painter.drawImage(rect.x() + (ICON_SIZE - thumbnail.width()) / 2,
+                      rect.y() + (ICON_SIZE - thumbnail.height()) / 2, thumbnail);
+    
+    m_pageIcons[cell.page][cell.index] = iconId;
+    m_cells.insert(iconId, cell);
+}
+
+QRect IconCache::cellRect(int index) const {
+    return QRect((index % CELLS_PER_ROW) * ICON_SIZE, (index / CELLS_PER_ROW) * ICON_SIZE,
+                 ICON_SIZE, ICON_SIZE);
+}
+
+QString IconCache::thumbnailPath(int iconId) const {
+    return QDir(m_thumbnailDir).filePath(QString("%1.png").arg(iconId, 8, 16, QChar('0')));
+}
+
+} // namespace lotro
@@ -0,0 +1,109 @@
+/**
+ * LOTRO Launcher - Icon Cache
+ * 
+ * Game icons decoded from the DAT files for item views.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "core/TaskScheduler.hpp"
+
+#include <QCache>
+#include <QHash>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+#include <QString>
+
+#include <span>
+#include <vector>
+
+class QPainter;
+
+namespace lotro {
+
+namespace dat { class DataFacade; }
+
+/**
+ * Icons by data ID (the iconId of skills, traits, classes and so on)
+ * 
+ * A miss queues a load and returns straight away; iconReady() fires when
+ * the icon can be drawn, so a delegate paints what it has and the view
+ * repaints its viewport on that signal. Loads read a thumbnail saved by
+ * an earlier session, or else the DAT entry, on the I/O pool, and decode
+ * and scale on the CPU pool; new thumbnails are written back to disk.
+ * 
+ * Loaded icons are packed into atlas pages, large pixmaps of fixed-size
+ * cells, so painting a row is one drawPixmap from a shared page rather
+ * than a pixmap per icon. Cells are reused oldest first once the pages
+ * are full. pixmap() hands out standalone copies, kept in a small LRU.
+ * 
+ * Lives on the GUI thread. The facade must be initialized and outlive
+ * the cache.
+ */
+class IconCache : public QObject {
+    Q_OBJECT
+    
+public:
+    explicit IconCache(dat::DataFacade* facade, QObject* parent = nullptr);
+    ~IconCache() override;
+    
+    /**
+     * Draw an icon into a rectangle
+     * @return false if the icon is not loaded yet (a load is queued) or has none
+     */
+    bool paint(QPainter* painter, const QRect& target, int iconId);
+    
+    /**
+     * The icon as its own pixmap, null until loaded (a load is queued)
+     */
+    QPixmap pixmap(int iconId);
+    
+    /**
+     * Load icons ahead of need, such as rows just outside the viewport
+     */
+    void prefetch(std::span<const int> iconIds);
+    
+    static constexpr int ICON_SIZE = 32;
+    
+signals:
+    /**
+     * An icon asked for earlier can now be drawn
+     */
+    void iconReady(int iconId);
+    
+private:
+    struct Cell {
+        int page = 0;
+        int index = 0;
+    };
+    
+    void request(int iconId, TaskPriority priority);
+    void store(int iconId, const QImage& thumbnail);
+    QRect cellRect(int index) const;
+    QString thumbnailPath(int iconId) const;
+    
+    dat::DataFacade* m_facade;
+    QString m_thumbnailDir;
+    
+    // Atlas
+    std::vector<QPixmap> m_pages;
+    std::vector<std::vector<int>> m_pageIcons;  // Icon in each cell of each page, 0 if free
+    int m_nextCell = 0;                         // Next cell to fill, across all pages
+    QHash<int, Cell> m_cells;
+    
+    QCache<int, QPixmap> m_pixmaps;
+    QSet<int> m_pending;
+    QSet<int> m_missing;                        // No entry or an undecodable one
+    CancellationToken m_loads;
+    
+    static constexpr int PAGE_SIZE = 1024;
+    static constexpr int CELLS_PER_ROW = PAGE_SIZE / ICON_SIZE;
+    static constexpr int CELLS_PER_PAGE = CELLS_PER_ROW * CELLS_PER_ROW;
+    static constexpr int MAX_PAGES = 4;         // 4096 icons, 16 MB
+    static constexpr int PIXMAP_CACHE_SIZE = 256;
+};
+
+} // namespace lotro
@@ -13,9 +13,40 @@
 #include <QLabel>
 #include <QMessageBox>
 #include <QGroupBox>
+#include <QSignalBlocker>
+#include <QTextCursor>
+#include <QTextDocument>
+
+#include <algorithm>
 
 namespace lotro {
 
+namespace {
+
+// Rich text for a search result line with its matches in bold
+QString highlightedHtml(const QString& text, const TextHighlights& highlights) {
+    QString html;
+    int pos = 0;
+    for (const auto& [start, length] : highlights) {
+        html += text.mid(pos, start - pos).toHtmlEscaped();
+        html += "<b style=\"color: #c9a227;\">" + text.mid(start, length).toHtmlEscaped() + "</b>";
+        pos = start + length;
+    }
+    html += text.mid(pos).toHtmlEscaped();
+    return html;
+}
+
+// Length of the next chunk from offset, never splitting a surrogate pair
+int chunkLength(const QString& text, int offset, int maxChars) {
+    int length = std::min(maxChars, static_cast<int>(text.size()) - offset);
+    if (length > 1 && offset + length < text.size() && text.at(offset + length - 1).isHighSurrogate()) {
+        --length;
+    }
+    return length;
+}
+
+} // anonymous namespace
+
 JournalWindow::JournalWindow(QWidget* parent)
     : QDialog(parent)
 {
@@ -25,6 +56,10 @@ JournalWindow::JournalWindow(QWidget* parent)
     refreshEntryList();
 }
 
+JournalWindow::~JournalWindow() {
+    saveCurrentEntry();
+}
+
 void JournalWindow::setupUi() {
     auto* mainLayout = new QHBoxLayout(this);
     
@@ -39,6 +74,11 @@ void JournalWindow::setupUi() {
     auto* listLabel = new QLabel("Entries");
     leftLayout->addWidget(listLabel);
     
+    m_searchEdit = new QLineEdit();
+    m_searchEdit->setPlaceholderText("Search entries...");
+    m_searchEdit->setClearButtonEnabled(true);
+    leftLayout->addWidget(m_searchEdit);
+    
     m_entryList = new QListWidget();
     m_entryList->setMinimumWidth(200);
     m_entryList->setStyleSheet(R"(
@@ -107,12 +147,12 @@ void JournalWindow::setupUi() {
     auto* contentLabel = new QLabel("Content:");
     rightLayout->addWidget(contentLabel);
     
-    m_contentEdit = new QTextEdit();
+    m_contentEdit = new QPlainTextEdit();
     m_contentEdit->setObjectName("journalContent");
     m_contentEdit->setPlaceholderText("Write your notes, plans, and goals here...");
     m_contentEdit->setMinimumWidth(400);
     m_contentEdit->setStyleSheet(R"(
-        QTextEdit {
+        QPlainTextEdit {
             background-color: #0a0a12;
             border: 2px solid #3a3a5c;
             border-radius: 4px;
@@ -120,7 +160,7 @@ void JournalWindow::setupUi() {
             color: #ffffff;
             font-size: 13px;
         }
-        QTextEdit:focus { border-color: #c9a227; }
+        QPlainTextEdit:focus { border-color: #c9a227; }
     )");
     rightLayout->addWidget(m_contentEdit, 1);
     
@@ -145,10 +185,18 @@ void JournalWindow::setupUi() {
     connect(m_saveBtn, &QPushButton::clicked, this, &JournalWindow::onSaveEntry);
     connect(m_entryList, &QListWidget::currentItemChanged, 
             this, &JournalWindow::onEntrySelected);
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &JournalWindow::refreshEntryList);
     
     // Track modifications
-    connect(m_titleEdit, &QLineEdit::textChanged, [this]() { m_modified = true; });
-    connect(m_contentEdit, &QTextEdit::textChanged, [this]() { m_modified = true; });
+    m_autosaveTimer.setSingleShot(true);
+    m_autosaveTimer.setInterval(AUTOSAVE_MS);
+    connect(&m_autosaveTimer, &QTimer::timeout, this, &JournalWindow::onAutosave);
+    connect(m_titleEdit, &QLineEdit::textChanged, [this]() {
+        m_modified = true;
+        m_autosaveTimer.start();
+    });
+    connect(m_contentEdit->document(), &QTextDocument::contentsChange,
+            this, &JournalWindow::onContentsChange);
     
     // Disable editor until entry selected
     m_titleEdit->setEnabled(false);
@@ -158,21 +206,48 @@ void JournalWindow::setupUi() {
 }
 
 void JournalWindow::refreshEntryList() {
+    // Rebuilding must not look like the user deselecting the open entry
+    QSignalBlocker blocker(m_entryList);
     m_entryList->clear();
     
     auto& manager = JournalManager::instance();
-    for (const auto& entry : manager.entries()) {
-        auto* item = new QListWidgetItem(entry.title);
-        item->setData(Qt::UserRole, entry.id);
-        m_entryList->addItem(item);
+    const QString query = m_searchEdit->text().trimmed();
+    if (query.isEmpty()) {
+        for (const auto& entry : manager.entries()) {
+            auto* item = new QListWidgetItem(entry.title);
+            item->setData(Qt::UserRole, entry.id);
+            m_entryList->addItem(item);
+        }
+    } else {
+        for (const auto& hit : manager.search(query)) {
+            auto* item = new QListWidgetItem();
+            item->setData(Qt::UserRole, hit.id);
+            item->setToolTip(hit.snippet);
+            
+            auto* label = new QLabel(highlightedHtml(hit.title, hit.titleHighlights)
+                + "<br><span style=\"color: #888; font-size: 11px;\">"
+                + highlightedHtml(hit.snippet, hit.snippetHighlights) + "</span>");
+            label->setTextFormat(Qt::RichText);
+            label->setWordWrap(true);
+            label->setAttribute(Qt::WA_TransparentForMouseEvents);
+            
+            item->setSizeHint(label->sizeHint());
+            m_entryList->addItem(item);
+            m_entryList->setItemWidget(item, label);
+        }
+    }
+    
+    for (int i = 0; i < m_entryList->count(); ++i) {
+        if (m_entryList->item(i)->data(Qt::UserRole).toString() == m_currentEntryId) {
+            m_entryList->setCurrentRow(i);
+            break;
+        }
     }
 }
 
 void JournalWindow::onNewEntry() {
     // Save current entry if modified
-    if (m_modified && !m_currentEntryId.isEmpty()) {
-        saveCurrentEntry();
-    }
+    saveCurrentEntry();
     
     auto& manager = JournalManager::instance();
     JournalEntry entry = manager.createEntry("New Entry");
@@ -202,15 +277,7 @@ void JournalWindow::onDeleteEntry() {
         auto& manager = JournalManager::instance();
         manager.deleteEntry(m_currentEntryId);
         
-        m_currentEntryId.clear();
-        m_titleEdit->clear();
-        m_contentEdit->clear();
-        m_titleEdit->setEnabled(false);
-        m_contentEdit->setEnabled(false);
-        m_saveBtn->setEnabled(false);
-        m_deleteBtn->setEnabled(false);
-        m_modified = false;
-        
+        clearEditor();
         refreshEntryList();
     }
 }
@@ -219,17 +286,61 @@ void JournalWindow::onSaveEntry() {
     saveCurrentEntry();
 }
 
+void JournalWindow::onAutosave() {
+    saveCurrentEntry();
+}
+
+void JournalWindow::onContentsChange(int position, int removed, int added) {
+    if (m_loading || m_currentEntryId.isEmpty()) {
+        return;
+    }
+    m_autosaveTimer.start();
+    
+    if (m_diffEdits) {
+        QTextCursor cursor(m_contentEdit->document());
+        cursor.setPosition(position);
+        cursor.setPosition(position + added, QTextCursor::KeepAnchor);
+        QString inserted = cursor.selectedText();
+        inserted.replace(QChar::ParagraphSeparator, QLatin1Char('\n'));
+        if (JournalManager::instance().applyEdit(m_currentEntryId, position, removed, inserted)) {
+            return;
+        }
+        m_diffEdits = false;
+    }
+    m_contentModified = true;
+}
+
 void JournalWindow::saveCurrentEntry() {
+    m_autosaveTimer.stop();
     if (m_currentEntryId.isEmpty()) return;
     
     auto& manager = JournalManager::instance();
     JournalEntry* entry = manager.getEntry(m_currentEntryId);
     
+    // Content edits are already in the manager, unless the editor's
+    // positions stopped matching the stored body
+    if (entry && m_contentModified && !m_loading) {
+        entry->content = m_contentEdit->toPlainText();
+        m_contentModified = false;
+        m_modified = true;
+    }
+    if (entry && !m_modified) {
+        manager.save();
+        return;
+    }
+    
     if (entry) {
         entry->title = m_titleEdit->text();
-        entry->content = m_contentEdit->toPlainText();
         manager.updateEntry(*entry);
         
+        // Search results may have changed along with the text; rebuilt
+        // later since this can run inside a selection change
+        if (!m_searchEdit->text().trimmed().isEmpty()) {
+            m_modified = false;
+            QTimer::singleShot(0, this, &JournalWindow::refreshEntryList);
+            return;
+        }
+        
         // Update list item title
         for (int i = 0; i < m_entryList->count(); ++i) {
             auto* item = m_entryList->item(i);
@@ -247,18 +358,10 @@ void JournalWindow::onEntrySelected(QListWidgetItem* current, QListWidgetItem* p
     Q_UNUSED(previous);
     
     // Save previous entry if modified
-    if (m_modified && !m_currentEntryId.isEmpty()) {
-        saveCurrentEntry();
-    }
+    saveCurrentEntry();
     
     if (!current) {
-        m_currentEntryId.clear();
-        m_titleEdit->clear();
-        m_contentEdit->clear();
-        m_titleEdit->setEnabled(false);
-        m_contentEdit->setEnabled(false);
-        m_saveBtn->setEnabled(false);
-        m_deleteBtn->setEnabled(false);
+        clearEditor();
         return;
     }
     
@@ -271,16 +374,79 @@ void JournalWindow::loadEntry(const QString& id) {
     JournalEntry* entry = manager.getEntry(id);
     
     if (entry) {
+        const quint64 load = ++m_load;
+        m_loading = true;
         m_currentEntryId = id;
         m_titleEdit->setText(entry->title);
-        m_contentEdit->setPlainText(entry->content);
+        
+        // First chunk now, so the entry shows at once; the rest follows
+        const int first = chunkLength(entry->content, 0, LOAD_CHUNK_CHARS);
+        m_pendingContent = first < entry->content.size() ? entry->content : QString();
+        m_pendingOffset = first;
+        m_contentEdit->setUndoRedoEnabled(false);
+        m_contentEdit->setPlainText(entry->content.left(first));
         
         m_titleEdit->setEnabled(true);
         m_contentEdit->setEnabled(true);
         m_saveBtn->setEnabled(true);
         m_deleteBtn->setEnabled(true);
         m_modified = false;
+        m_contentModified = false;
+        m_autosaveTimer.stop();
+        
+        if (m_pendingContent.isEmpty()) {
+            finishLoading();
+        } else {
+            m_contentEdit->setReadOnly(true);
+            QTimer::singleShot(0, this, [this, load]() { appendNextChunk(load); });
+        }
+    }
+}
+
+void JournalWindow::appendNextChunk(quint64 load) {
+    if (load != m_load) {
+        return;
+    }
+    
+    const int length = chunkLength(m_pendingContent, m_pendingOffset, LOAD_CHUNK_CHARS);
+    QTextCursor cursor(m_contentEdit->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(m_pendingContent.mid(m_pendingOffset, length));
+    m_pendingOffset += length;
+    
+    if (m_pendingOffset < m_pendingContent.size()) {
+        QTimer::singleShot(0, this, [this, load]() { appendNextChunk(load); });
+        return;
     }
+    m_pendingContent.clear();
+    finishLoading();
+}
+
+void JournalWindow::finishLoading() {
+    m_loading = false;
+    m_contentEdit->setReadOnly(false);
+    m_contentEdit->setUndoRedoEnabled(true);
+    
+    // Line breaks other than \n turn into block breaks in the editor,
+    // after which its positions no longer index the stored body
+    const JournalEntry* entry = JournalManager::instance().getEntry(m_currentEntryId);
+    m_diffEdits = entry && m_contentEdit->document()->characterCount() - 1 == entry->content.size();
+}
+
+void JournalWindow::clearEditor() {
+    ++m_load;
+    m_loading = false;
+    m_pendingContent.clear();
+    m_currentEntryId.clear();
+    m_titleEdit->clear();
+    m_contentEdit->clear();
+    m_contentEdit->setReadOnly(false);
+    m_titleEdit->setEnabled(false);
+    m_contentEdit->setEnabled(false);
+    m_saveBtn->setEnabled(false);
+    m_deleteBtn->setEnabled(false);
+    m_modified = false;
+    m_contentModified = false;
 }
 
 } // namespace lotro
@@ -11,8 +11,9 @@
 #include <QDialog>
 #include <QListWidget>
 #include <QLineEdit>
-#include <QTextEdit>
+#include <QPlainTextEdit>
 #include <QPushButton>
+#include <QTimer>
 
 namespace lotro {
 
@@ -20,13 +21,21 @@ namespace lotro {
  * Journal window for managing player notes and plans
  * 
  * Features a list of entries on the left and an editor on the right.
+ * Typing in the search box narrows the list to matching entries, ranked,
+ * with the matched words highlighted.
+ * 
+ * Bodies open in a QPlainTextEdit, which lays out only the blocks on
+ * screen. Long ones are filled in LOAD_CHUNK_CHARS at a time from the
+ * event loop, read-only until the last chunk is in. Edits go to
+ * JournalManager as they happen, as the changed range, and are written
+ * AUTOSAVE_MS after typing stops.
  */
 class JournalWindow : public QDialog {
     Q_OBJECT
     
 public:
     explicit JournalWindow(QWidget* parent = nullptr);
-    ~JournalWindow() = default;
+    ~JournalWindow();
     
 private slots:
     void onNewEntry();
@@ -34,21 +43,38 @@ private slots:
     void onSaveEntry();
     void onEntrySelected(QListWidgetItem* current, QListWidgetItem* previous);
     void refreshEntryList();
+    void onContentsChange(int position, int removed, int added);
+    void onAutosave();
     
 private:
     void setupUi();
     void loadEntry(const QString& id);
     void saveCurrentEntry();
+    void appendNextChunk(quint64 load);
+    void finishLoading();
+    void clearEditor();
     
+    QLineEdit* m_searchEdit;
     QListWidget* m_entryList;
     QLineEdit* m_titleEdit;
-    QTextEdit* m_contentEdit;
+    QPlainTextEdit* m_contentEdit;
     QPushButton* m_newBtn;
     QPushButton* m_deleteBtn;
     QPushButton* m_saveBtn;
     
+    QTimer m_autosaveTimer;
+    
     QString m_currentEntryId;
-    bool m_modified = false;
+    bool m_modified = false;            // Title changed; content edits go straight to the manager
+    QString m_pendingContent;           // Body still to be appended to the editor
+    int m_pendingOffset = 0;
+    quint64 m_load = 0;                 // Bumped per loaded entry, to drop stale chunks
+    bool m_loading = false;
+    bool m_diffEdits = true;            // Editor positions match the stored body
+    bool m_contentModified = false;     // Edits not passed on as diffs
+    
+    static constexpr int LOAD_CHUNK_CHARS = 64 * 1024;
+    static constexpr int AUTOSAVE_MS = 2000;
 };
 
 } // namespace lotro
@@ -13,11 +13,17 @@
 #include "LoadingSpinner.hpp"
 #include "core/config/ConfigManager.hpp"
 #include "core/credentials/CredentialStore.hpp"
+#include "core/StartupGraph.hpp"
 #include "network/GameServicesInfo.hpp"
 #include "network/LoginAccount.hpp"
 #include "network/WorldList.hpp"
+#include "network/WorldLatencyProbe.hpp"
+#include "network/NewsAssetCache.hpp"
 #include "network/NewsfeedParser.hpp"
+#include "network/StartupSnapshot.hpp"
 #include "game/GameLauncher.hpp"
+#include "game/LaunchTimeline.hpp"
+#include "game/MultiLauncher.hpp"
 
 #ifdef PLATFORM_LINUX
 #include "wine/WineManager.hpp"
@@ -39,15 +45,50 @@
 #include <QGroupBox>
 #include <QScrollArea>
 #include <QDesktopServices>
-#include <QTimer>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QListWidget>
+#include <QPointer>
+#include <QFileDialog>
+#include <QFutureWatcher>
 #include <QUrl>
 #include <QEvent>
 #include <QDateTime>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace lotro {
 
+namespace {
+
+void clearNewsfeed(QVBoxLayout* layout) {
+    // Keep the stretch at the end
+    while (layout->count() > 1) {
+        QLayoutItem* item = layout->takeAt(0);
+        if (item->widget()) {
+            delete item->widget();
+        }
+        delete item;
+    }
+}
+
+bool sameNews(const std::vector<NewsItem>& a, const std::vector<NewsItem>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const NewsItem& x, const NewsItem& y) {
+                          return x.link == y.link && x.title == y.title &&
+                                 x.publishedDate == y.publishedDate &&
+                                 x.description == y.description;
+                      });
+}
+
+} // namespace
+
 class MainWindow::Impl {
 public:
     QString currentGameId;
@@ -72,6 +113,18 @@ public:
     
     std::unique_ptr<CredentialStore> credentialStore;
     std::unique_ptr<GameLauncher> gameLauncher;
+    QPointer<MultiLauncher> multiLauncher;
+    WorldStatusFetcher* worldFetcher = nullptr;
+    WorldStatusMonitor* worldMonitor = nullptr;
+    WorldLatencyProbe* latencyProbe = nullptr;
+    StartupGraph* startup = nullptr;
+    
+    // World name -> login server latency in ms, -1 if unreachable
+    QHash<QString, int> latencies;
+    bool worldPickedByUser = false;
+    
+    // Last-known data for the current game, shown until fresh data arrives
+    StartupSnapshot snapshot;
     
     bool isLoggedIn = false;
 };
@@ -217,6 +270,17 @@ void MainWindow::setupUi() {
     m_impl->newsfeedLayout->addStretch();
     
     m_impl->newsfeedScrollArea->setWidget(m_impl->newsfeedContainer);
+    
+    // Card images that were still downloading when the cards went up
+    connect(&NewsAssetCache::shared(), &NewsAssetCache::imageReady, this,
+            [this](const QString& url, const QImage& image) {
+        for (QLabel* label : m_impl->newsfeedContainer->findChildren<QLabel*>("newsImage")) {
+            if (label->property("imageUrl").toString() == url) {
+                label->setPixmap(QPixmap::fromImage(image));
+                label->show();
+            }
+        }
+    });
     newsPanelLayout->addWidget(m_impl->newsfeedScrollArea);
     
     contentLayout->addWidget(newsPanel, 1);  // Stretch to fill remaining space
@@ -235,6 +299,18 @@ void MainWindow::setupUi() {
     // Status on left
     m_impl->statusLabel = new QLabel("Ready");
     m_impl->statusLabel->setStyleSheet("color: #b0b0b0; font-size: 12px;");
+    m_impl->statusLabel->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(m_impl->statusLabel, &QLabel::customContextMenuRequested, this, [this](const QPoint& pos) {
+        QMenu menu;
+        menu.addAction("Export Launch History...", this, [this]() {
+            QString path = QFileDialog::getSaveFileName(this, "Export Launch History",
+                "launch-history.json", "JSON (*.json);;CSV (*.csv)");
+            if (!path.isEmpty() && !LaunchTimeline::exportHistory(path)) {
+                QMessageBox::warning(this, "Export Failed", "Could not write " + path);
+            }
+        });
+        menu.exec(m_impl->statusLabel->mapToGlobal(pos));
+    });
     footerLayout->addWidget(m_impl->statusLabel);
     
     m_impl->progressBar = new QProgressBar();
@@ -250,6 +326,12 @@ void MainWindow::setupUi() {
     m_impl->launchButton->setFixedSize(180, 45);
     m_impl->launchButton->setCursor(Qt::PointingHandCursor);
     m_impl->launchButton->setEnabled(false);
+    m_impl->launchButton->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(m_impl->launchButton, &QPushButton::customContextMenuRequested, this, [this](const QPoint& pos) {
+        QMenu menu;
+        menu.addAction("Launch Multiple Accounts...", this, &MainWindow::launchMultiple);
+        menu.exec(m_impl->launchButton->mapToGlobal(pos));
+    });
     
     footerLayout->addWidget(m_impl->launchButton);
     
@@ -257,11 +339,71 @@ void MainWindow::setupUi() {
 }
 
 void MainWindow::setupConnections() {
+    m_impl->worldFetcher = new WorldStatusFetcher(this);
+    connect(m_impl->worldFetcher, &WorldStatusFetcher::worldResolved,
+            this, &MainWindow::onWorldResolved);
+    connect(m_impl->worldFetcher, &WorldStatusFetcher::finished,
+            this, [this](const std::vector<World>& worlds) {
+                // Keep a choice made while the last-known list was up
+                const QString selected = m_impl->worldSelector->isEnabled()
+                    ? m_impl->worldSelector->currentData().toString() : QString();
+                
+                m_impl->loadingLabel->stop();
+                m_impl->worlds = worlds;
+                updateWorldList(m_impl->worlds);
+                onWorldsLoaded();
+                
+                int index = m_impl->worldSelector->findData(selected);
+                if (!selected.isEmpty() && index >= 0) {
+                    m_impl->worldSelector->setCurrentIndex(index);
+                }
+                
+                m_impl->snapshot.worlds = worlds;
+                m_impl->snapshot.save(m_impl->currentGameId);
+                
+                if (m_impl->servicesInfo) {
+                    m_impl->worldMonitor->start(m_impl->servicesInfo->worlds, worlds);
+                }
+                m_impl->latencyProbe->start(worlds);
+            });
+    
+    m_impl->worldMonitor = new WorldStatusMonitor(this);
+    connect(m_impl->worldMonitor, &WorldStatusMonitor::worldChanged,
+            this, [this](const World& world) {
+                onWorldChanged(world);
+                
+                auto& known = m_impl->snapshot.worlds;
+                auto it = std::find_if(known.begin(), known.end(),
+                                       [&](const World& w) { return w.name == world.name; });
+                if (it != known.end()) {
+                    *it = world;
+                    m_impl->snapshot.save(m_impl->currentGameId);
+                }
+            });
+    
+    m_impl->latencyProbe = new WorldLatencyProbe(this);
+    connect(m_impl->latencyProbe, &WorldLatencyProbe::latencyMeasured,
+            this, [this](const QString& worldName, int milliseconds) {
+                m_impl->latencies.insert(worldName, milliseconds);
+                auto it = std::find_if(m_impl->worlds.begin(), m_impl->worlds.end(),
+                                       [&](const World& w) { return w.name == worldName; });
+                int index = m_impl->worldSelector->findData(worldName);
+                if (it != m_impl->worlds.end() && index >= 0) {
+                    updateWorldEntry(index, *it, worldPlayTimes());
+                }
+            });
+    connect(m_impl->latencyProbe, &WorldLatencyProbe::finished,
+            this, &MainWindow::onLatenciesMeasured);
+    
+    // Only picks made by the user, not the ones made for them
+    connect(m_impl->worldSelector, &QComboBox::activated,
+            this, [this]() { m_impl->worldPickedByUser = true; });
+    
     connect(m_impl->loginWidget, &LoginWidget::loginRequested,
             this, &MainWindow::login);
             
     connect(m_impl->loginWidget, &LoginWidget::accountSelected,
-            this, &MainWindow::loadAccount);
+            this, [this](const QString& username) { loadAccount(username); });
             
     connect(m_impl->loginWidget, &LoginWidget::deleteAccountRequested,
             [this](const QString& username) {
@@ -288,7 +430,12 @@ void MainWindow::setupConnections() {
                 // Clear login state
                 m_impl->isLoggedIn = false;
                 m_impl->loginResponse.reset();
+                m_impl->worldFetcher->cancel();
+                m_impl->worldMonitor->stop();
+                m_impl->latencyProbe->cancel();
+                m_impl->loadingLabel->stop();
                 m_impl->worlds.clear();
+                m_impl->worldPickedByUser = false;
                 
                 // Reset UI
                 m_impl->loginWidget->setLoggingIn(false);
@@ -307,34 +454,113 @@ void MainWindow::setupConnections() {
 void MainWindow::setGame(const QString& gameId) {
     m_impl->currentGameId = gameId;
     m_impl->isLoggedIn = false;
+    m_impl->worldFetcher->cancel();
+    m_impl->worldMonitor->stop();
+    m_impl->latencyProbe->cancel();
+    m_impl->latencies.clear();
     m_impl->worlds.clear();
+    m_impl->worldPickedByUser = false;
     m_impl->worldSelector->clear();
     m_impl->worldSelector->addItem("Select a server...");
     m_impl->worldSelector->setEnabled(false);
     m_impl->launchButton->setEnabled(false);
     
-    // Fetch game services info
-    m_impl->statusLabel->setText("Connecting to game services...");
-    
-    QString datacenterUrl = getDatacenterUrl(gameId);
-    auto future = fetchGameServicesInfo(datacenterUrl, gameId);
-    
-    // TODO: Handle async properly with QFutureWatcher
-    future.waitForFinished();
-    auto result = future.result();
+    // Show what we had last time straight away; the live copies are diffed
+    // in as they arrive, so logging in doesn't wait on the datacenter
+    m_impl->snapshot = StartupSnapshot::load(gameId).value_or(StartupSnapshot{});
+    m_impl->servicesInfo = m_impl->snapshot.servicesInfo;
+    if (!m_impl->snapshot.news.empty()) {
+        updateNewsfeed(m_impl->snapshot.news);
+    } else {
+        clearNewsfeed(m_impl->newsfeedLayout);
+    }
     
-    if (result) {
-        m_impl->servicesInfo = *result;
-        m_impl->statusLabel->setText("Connected. Please log in.");
-        spdlog::info("Game services loaded for: {}", gameId.toStdString());
+    if (m_impl->servicesInfo) {
+        m_impl->statusLabel->setText("Please log in.");
+        spdlog::info("Using last-known game services for: {}", gameId.toStdString());
     } else {
-        m_impl->statusLabel->setText("Failed to connect to game services");
-        spdlog::error("Failed to load game services for: {}", gameId.toStdString());
+        m_impl->statusLabel->setText("Connecting to game services...");
     }
     
-    refreshNewsfeed();
+    // Every startup request goes out at once. Only what needs the services
+    // info waits for it, and only if there was no last-known copy to use
+    const bool hadServicesInfo = m_impl->servicesInfo.has_value();
+    const QStringList needsServices = hadServicesInfo ? QStringList() : QStringList{"services"};
+    
+    delete m_impl->startup;
+    m_impl->startup = new StartupGraph("Startup", this);
+    m_impl->startup->add("services", {}, [this, gameId](StartupGraph::Done done) {
+        fetchGameServicesInfo(getDatacenterUrl(gameId), gameId)
+            .then(this, [this, gameId, done](const std::optional<GameServicesInfo>& result) {
+                if (gameId == m_impl->currentGameId) {
+                    onServicesInfoLoaded(result);
+                }
+                done();
+            });
+    });
+    m_impl->startup->add("news", needsServices, [this](StartupGraph::Done done) {
+        loadNewsfeed(done);
+    });
+    m_impl->startup->add("worlds", needsServices, [this](StartupGraph::Done done) {
+        if (!m_impl->servicesInfo) {
+            done();
+            return;
+        }
+        connect(m_impl->worldFetcher, &WorldStatusFetcher::finished,
+                m_impl->startup, [done]() { done(); }, Qt::SingleShotConnection);
+        if (!m_impl->worldFetcher->isRunning()) {
+            refreshWorldList();
+        }
+    });
+    m_impl->startup->start();
+    
     loadSavedAccounts();
-    autoLogin();
+    if (hadServicesInfo) {
+        autoLogin();
+    }
+}
+
+void MainWindow::onServicesInfoLoaded(const std::optional<GameServicesInfo>& result) {
+    const QString& gameId = m_impl->currentGameId;
+    if (!result) {
+        if (m_impl->servicesInfo) {
+            spdlog::warn("Failed to refresh game services for {}, using last-known copy",
+                         gameId.toStdString());
+        } else {
+            m_impl->statusLabel->setText("Failed to connect to game services");
+            spdlog::error("Failed to load game services for: {}", gameId.toStdString());
+        }
+        return;
+    }
+    
+    // Redo whatever was started from a last-known copy that is now wrong
+    const auto& known = m_impl->servicesInfo;
+    const bool hadServicesInfo = known.has_value();
+    const bool worldsChanged = hadServicesInfo &&
+        !std::equal(result->worlds.begin(), result->worlds.end(),
+                    known->worlds.begin(), known->worlds.end(),
+                    [](const WorldInfo& a, const WorldInfo& b) {
+                        return a.name == b.name && a.statusUrl == b.statusUrl;
+                    });
+    const bool newsChanged = hadServicesInfo && result->newsUrl != known->newsUrl;
+    
+    m_impl->servicesInfo = *result;
+    m_impl->snapshot.servicesInfo = *result;
+    m_impl->snapshot.save(gameId);
+    spdlog::info("Game services loaded for: {}", gameId.toStdString());
+    
+    if (!m_impl->isLoggedIn) {
+        m_impl->statusLabel->setText("Connected. Please log in.");
+    }
+    if (worldsChanged) {
+        refreshWorldList();
+    }
+    if (newsChanged) {
+        refreshNewsfeed();
+    }
+    if (!hadServicesInfo) {
+        autoLogin();
+    }
 }
 
 QString MainWindow::currentGame() const {
@@ -358,23 +584,26 @@ void MainWindow::login() {
     m_impl->loginWidget->setLoggingIn(true);
     m_impl->statusLabel->setText("Logging in...");
     
-    auto future = loginAccount(
+    auto* watcher = new QFutureWatcher<LoginResult>(this);
+    connect(watcher, &QFutureWatcher<LoginResult>::finished, this, [this, watcher, username, password]() {
+        watcher->deleteLater();
+        onLoginResult(watcher->result(), username, password);
+    });
+    watcher->setFuture(loginAccount(
         m_impl->servicesInfo->authServer,
         username,
         password
-    );
-    
-    // TODO: Use QFutureWatcher for proper async
-    future.waitForFinished();
-    auto result = future.result();
-    
+    ));
+}
+
+void MainWindow::onLoginResult(const LoginResult& result, const QString& username, const QString& password) {
     if (result.isSuccess()) {
         m_impl->loginResponse = result.response;
         m_impl->isLoggedIn = true;
         
         // Always save password on successful login
         if (m_impl->credentialStore) {
-            m_impl->credentialStore->storePassword(
+            m_impl->credentialStore->storePasswordAsync(
                 LOTRO_CREDENTIAL_SERVICE,
                 username.toStdString(),
                 password.toStdString()
@@ -396,8 +625,14 @@ void MainWindow::onLoginComplete() {
     m_impl->logoutButton->setVisible(true);
     spdlog::info("Login successful");
     
-    // Fetch world list
-    refreshWorldList();
+    // World status is fetched at startup; PLAY needs it, or a last-known copy
+    if (m_impl->worlds.empty()) {
+        refreshWorldList();
+    } else if (!m_impl->worldFetcher->isRunning() ||
+               std::any_of(m_impl->worlds.begin(), m_impl->worlds.end(),
+                           [](const World& w) { return w.canLogin(); })) {
+        onWorldsLoaded();
+    }
 }
 
 void MainWindow::onLoginFailed(const QString& error) {
@@ -414,17 +649,48 @@ void MainWindow::refreshWorldList() {
     // Show loading indicator
     m_impl->loadingLabel->start("Fetching server status...");
     m_impl->worldSelector->setEnabled(false);
+    m_impl->worldMonitor->stop();
     
-    // Use the new API that gets worlds from GameServicesInfo and fetches status
-    auto future = fetchWorldsWithStatus(*m_impl->servicesInfo);
-    future.waitForFinished();
+    // List every world straight away with its last-known status and fill
+    // in the live one as it arrives
+    m_impl->worlds.clear();
+    bool anyKnown = false;
+    for (const auto& info : m_impl->servicesInfo->worlds) {
+        const auto& known = m_impl->snapshot.worlds;
+        auto it = std::find_if(known.begin(), known.end(),
+                               [&](const World& w) { return w.name == info.name; });
+        if (it != known.end()) {
+            World world = *it;
+            world.statusUrl = info.statusUrl;
+            world.order = info.order;
+            world.language = info.language;
+            anyKnown = anyKnown || world.canLogin();
+            m_impl->worlds.push_back(world);
+            continue;
+        }
+        
+        World world;
+        world.name = info.name;
+        world.displayName = info.name;
+        world.order = info.order;
+        world.language = info.language;
+        m_impl->worlds.push_back(world);
+    }
+    std::stable_sort(m_impl->worlds.begin(), m_impl->worlds.end(),
+                     [](const World& a, const World& b) { return a.order < b.order; });
+    updateWorldList(m_impl->worlds);
     
-    // Hide loading indicator
-    m_impl->loadingLabel->stop();
+    // Last-known login servers are good enough to launch with; the selector
+    // stays live while the statuses refresh
+    if (anyKnown) {
+        onWorldsLoaded();
+    }
     
-    m_impl->worlds = future.result();
-    updateWorldList(m_impl->worlds);
-    onWorldsLoaded();
+    m_impl->worldFetcher->start(m_impl->servicesInfo->worlds);
+}
+
+void MainWindow::onWorldResolved(const World& world) {
+    onWorldChanged(world);
 }
 
 void MainWindow::onWorldsLoaded() {
@@ -459,91 +725,183 @@ void MainWindow::onWorldsLoaded() {
                 break;
             }
         }
+        if (lastUsedWorld().isEmpty()) {
+            selectFastestWorld();
+        }
+        
+        m_impl->statusLabel->setText("Ready to play");
+    }
+}
+
+void MainWindow::onLatenciesMeasured() {
+    const auto& programConfig = ConfigManager::instance().programConfig();
+    
+    if (programConfig.sortWorldsByLatency && !m_impl->worlds.empty()) {
+        // The selector and worlds share an order, so sort the worlds and relist
+        const QString selected = m_impl->worldSelector->currentData().toString();
+        auto latency = [this](const World& world) {
+            const int ms = m_impl->latencies.value(world.name, -1);
+            return ms < 0 ? std::numeric_limits<int>::max() : ms;
+        };
+        std::stable_sort(m_impl->worlds.begin(), m_impl->worlds.end(),
+                         [&](const World& a, const World& b) { return latency(a) < latency(b); });
+        updateWorldList(m_impl->worlds);
+        
+        int index = m_impl->worldSelector->findData(selected);
+        if (index >= 0) {
+            m_impl->worldSelector->setCurrentIndex(index);
+        }
     }
     
-    m_impl->statusLabel->setText("Ready to play");
+    if (m_impl->isLoggedIn && !m_impl->worldPickedByUser && lastUsedWorld().isEmpty()) {
+        selectFastestWorld();
+    }
+}
+
+void MainWindow::selectFastestWorld() {
+    if (!ConfigManager::instance().programConfig().autoSelectFastestWorld) {
+        return;
+    }
+    
+    const World* fastest = nullptr;
+    int fastestMs = -1;
+    for (const auto& world : m_impl->worlds) {
+        const int ms = m_impl->latencies.value(world.name, -1);
+        if (world.canLogin() && ms >= 0 && (!fastest || ms < fastestMs)) {
+            fastest = &world;
+            fastestMs = ms;
+        }
+    }
+    if (!fastest) {
+        return;
+    }
+    
+    int index = m_impl->worldSelector->findData(fastest->name);
+    if (index >= 0) {
+        m_impl->worldSelector->setCurrentIndex(index);
+        spdlog::info("Selected fastest world: {} ({} ms)", fastest->name.toStdString(), fastestMs);
+    }
+}
+
+QString MainWindow::lastUsedWorld() const {
+    const std::string username = m_impl->loginWidget->username().toStdString();
+    for (const auto& account : ConfigManager::instance().getAccounts(m_impl->currentGameId.toStdString())) {
+        if (account.username == username) {
+            return QString::fromStdString(account.lastUsedWorld);
+        }
+    }
+    return {};
 }
 
 void MainWindow::updateWorldList(const std::vector<World>& worlds) {
     m_impl->worldSelector->clear();
     
+    const auto playTimes = worldPlayTimes();
+    for (const auto& world : worlds) {
+        m_impl->worldSelector->addItem(QString(), world.name);
+        updateWorldEntry(m_impl->worldSelector->count() - 1, world, playTimes);
+    }
+}
+
+std::map<std::string, int64_t> MainWindow::worldPlayTimes() const {
     // Get current account's play times
-    std::map<std::string, int64_t> playTimes;
     QString currentUsername = m_impl->loginWidget->username();
     if (!currentUsername.isEmpty()) {
         auto& config = ConfigManager::instance();
         auto accounts = config.getAccounts(m_impl->currentGameId.toStdString());
         for (const auto& account : accounts) {
             if (account.username == currentUsername.toStdString()) {
-                playTimes = account.worldPlayTimes;
-                break;
+                return account.worldPlayTimes;
             }
         }
     }
+    return {};
+}
+
+void MainWindow::updateWorldEntry(int index, const World& world,
+                                  const std::map<std::string, int64_t>& playTimes) {
+    QString displayText = world.displayName.isEmpty() ? world.name : world.displayName;
+    
+    // Add status indicator using Unicode circles with color styling
+    QString statusIcon;
+    switch (world.status) {
+        case WorldStatus::Online:
+            statusIcon = "🟢";  // Green circle
+            break;
+        case WorldStatus::Busy:
+            statusIcon = "🟡";  // Yellow circle
+            break;
+        case WorldStatus::Full:
+            statusIcon = "🟠";  // Orange circle
+            break;
+        case WorldStatus::Locked:
+        case WorldStatus::Offline:
+            statusIcon = "🔴";  // Red circle
+            break;
+        default:
+            statusIcon = "⚪";  // White circle
+            break;
+    }
     
-    for (const auto& world : worlds) {
-        QString displayText = world.displayName.isEmpty() ? world.name : world.displayName;
-        
-        // Add status indicator using Unicode circles with color styling
-        QString statusIcon;
-        switch (world.status) {
-            case WorldStatus::Online:
-                statusIcon = "🟢";  // Green circle
-                break;
-            case WorldStatus::Busy:
-                statusIcon = "🟡";  // Yellow circle
-                break;
-            case WorldStatus::Full:
-                statusIcon = "🟠";  // Orange circle
-                break;
-            case WorldStatus::Locked:
-            case WorldStatus::Offline:
-                statusIcon = "🔴";  // Red circle
-                break;
-            default:
-                statusIcon = "⚪";  // White circle
-                break;
-        }
-        
-        // Check if this world was played before
-        QString lastPlayedInfo;
-        auto it = playTimes.find(world.name.toStdString());
-        if (it != playTimes.end() && it->second > 0) {
-            QDateTime playTime = QDateTime::fromSecsSinceEpoch(it->second);
-            QDateTime now = QDateTime::currentDateTime();
-            qint64 secsAgo = playTime.secsTo(now);
-            
-            if (secsAgo < 60) {
-                lastPlayedInfo = " - Last played: just now";
-            } else if (secsAgo < 3600) {
-                int mins = secsAgo / 60;
-                lastPlayedInfo = QString(" - Last played: %1 min ago").arg(mins);
-            } else if (secsAgo < 86400) {
-                int hours = secsAgo / 3600;
-                lastPlayedInfo = QString(" - Last played: %1h ago").arg(hours);
-            } else {
-                int days = secsAgo / 86400;
-                lastPlayedInfo = QString(" - Last played: %1d ago").arg(days);
-            }
-        }
-        
-        QString itemText = QString("%1 %2 (%3)%4")
-            .arg(statusIcon)
-            .arg(displayText)
-            .arg(world.statusString())
-            .arg(lastPlayedInfo);
+    // Check if this world was played before
+    QString lastPlayedInfo;
+    auto it = playTimes.find(world.name.toStdString());
+    if (it != playTimes.end() && it->second > 0) {
+        QDateTime playTime = QDateTime::fromSecsSinceEpoch(it->second);
+        QDateTime now = QDateTime::currentDateTime();
+        qint64 secsAgo = playTime.secsTo(now);
         
-        m_impl->worldSelector->addItem(itemText, world.name);
-        
-        // Disable if not online
-        if (!world.canLogin()) {
-            m_impl->worldSelector->setItemData(
-                m_impl->worldSelector->count() - 1,
-                false,
-                Qt::UserRole - 1  // Enable role
-            );
+        if (secsAgo < 60) {
+            lastPlayedInfo = " - Last played: just now";
+        } else if (secsAgo < 3600) {
+            int mins = secsAgo / 60;
+            lastPlayedInfo = QString(" - Last played: %1 min ago").arg(mins);
+        } else if (secsAgo < 86400) {
+            int hours = secsAgo / 3600;
+            lastPlayedInfo = QString(" - Last played: %1h ago").arg(hours);
+        } else {
+            int days = secsAgo / 86400;
+            lastPlayedInfo = QString(" - Last played: %1d ago").arg(days);
         }
     }
+    
+    // Round trip to the login server, once probed
+    QString latencyInfo;
+    const int latency = m_impl->latencies.value(world.name, -1);
+    if (latency >= 0) {
+        latencyInfo = QString(" - %1 ms").arg(latency);
+    }
+    
+    QString itemText = QString("%1 %2 (%3)%4%5")
+        .arg(statusIcon)
+        .arg(displayText)
+        .arg(world.statusString())
+        .arg(latencyInfo)
+        .arg(lastPlayedInfo);
+    
+    m_impl->worldSelector->setItemText(index, itemText);
+    
+    // Disable if not online; no flags means the default, enabled ones
+    m_impl->worldSelector->setItemData(
+        index,
+        world.canLogin() ? QVariant() : QVariant(false),
+        Qt::UserRole - 1  // Enable role
+    );
+}
+
+void MainWindow::onWorldChanged(const World& world) {
+    auto it = std::find_if(m_impl->worlds.begin(), m_impl->worlds.end(),
+                           [&](const World& w) { return w.name == world.name; });
+    if (it == m_impl->worlds.end()) {
+        return;
+    }
+    *it = world;
+    
+    // Touch only this world's entry; the selection stays where it is
+    int index = m_impl->worldSelector->findData(world.name);
+    if (index >= 0) {
+        updateWorldEntry(index, world, worldPlayTimes());
+    }
 }
 
 void MainWindow::launchGame() {
@@ -598,12 +956,27 @@ void MainWindow::launchGame() {
         accountNumber,
         loginServer,
         [this](const LaunchResult& result) {
+            // Total and slowest stage in the footer, every stage on hover
+            auto slowest = std::max_element(result.stages.begin(), result.stages.end(),
+                [](const LaunchSpan& a, const LaunchSpan& b) { return a.durationMs < b.durationMs; });
+            const QString timing = slowest != result.stages.end()
+                ? QString(" in %1 s (slowest: %2, %3 s)")
+                      .arg(result.durationMs / 1000.0, 0, 'f', 1)
+                      .arg(slowest->name)
+                      .arg(slowest->durationMs / 1000.0, 0, 'f', 1)
+                : QString();
+            QString tooltip = result.timingBreakdown;
+            if (result.prewarmedBytes > 0) {
+                tooltip += QString("\nPrewarmed %1 MiB of game data").arg(result.prewarmedBytes >> 20);
+            }
+            m_impl->statusLabel->setToolTip(tooltip);
+            
             if (result.success) {
-                m_impl->statusLabel->setText("Game launched");
+                m_impl->statusLabel->setText("Game launched" + timing);
                 emit gameStarted(result.processId);
                 spdlog::info("Game launched with PID: {}", result.processId);
             } else {
-                m_impl->statusLabel->setText("Launch failed");
+                m_impl->statusLabel->setText("Launch failed" + timing);
                 QMessageBox::critical(this, "Launch Failed", result.errorMessage);
             }
             m_impl->launchButton->setEnabled(true);
@@ -611,6 +984,154 @@ void MainWindow::launchGame() {
     );
 }
 
+void MainWindow::launchMultiple() {
+    if (m_impl->multiLauncher && m_impl->multiLauncher->isLaunching()) {
+        QMessageBox::information(this, "Multi-Launch", "Accounts are already being launched");
+        return;
+    }
+    
+    int worldIndex = m_impl->worldSelector->currentIndex();
+    if (worldIndex < 0 || worldIndex >= static_cast<int>(m_impl->worlds.size())) {
+        QMessageBox::warning(this, "Launch Error", "Please select a server");
+        return;
+    }
+    const World selectedWorld = m_impl->worlds[worldIndex];
+    
+    auto& configManager = ConfigManager::instance();
+    auto gameConfig = configManager.getGameConfig(m_impl->currentGameId.toStdString());
+    if (!gameConfig) {
+        QMessageBox::warning(this, "Launch Error", 
+            "Game not configured. Please run setup.");
+        return;
+    }
+    if (!m_impl->servicesInfo) {
+        QMessageBox::warning(this, "Launch Error", "Game services not available");
+        return;
+    }
+    
+    auto accounts = configManager.getAccounts(m_impl->currentGameId.toStdString());
+    if (accounts.size() < 2) {
+        QMessageBox::information(this, "Multi-Launch",
+            "Save at least two accounts to launch them together.");
+        return;
+    }
+    
+    // Pick the accounts; all of them unless told otherwise
+    QDialog dialog(this);
+    dialog.setWindowTitle("Launch Multiple Accounts");
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+    layout->addWidget(new QLabel("Accounts to launch on " + selectedWorld.name + ":"));
+    QListWidget* accountList = new QListWidget();
+    for (const auto& account : accounts) {
+        QListWidgetItem* item = new QListWidgetItem(QString::fromStdString(
+            account.displayName.empty() ? account.username : account.displayName));
+        item->setData(Qt::UserRole, QString::fromStdString(account.username));
+        item->setCheckState(Qt::Checked);
+        accountList->addItem(item);
+    }
+    layout->addWidget(accountList);
+    QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    layout->addWidget(buttons);
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+    
+    QStringList usernames;
+    for (int i = 0; i < accountList->count(); ++i) {
+        if (accountList->item(i)->checkState() == Qt::Checked) {
+            usernames << accountList->item(i)->data(Qt::UserRole).toString();
+        }
+    }
+    if (usernames.isEmpty()) {
+        return;
+    }
+    if (!m_impl->credentialStore) {
+        startMultiLaunch(*gameConfig, selectedWorld, usernames, {});
+        return;
+    }
+    
+    // Launch once every password has come back from the keyring
+    struct Lookup {
+        std::vector<std::optional<std::string>> passwords;
+        int pending = 0;
+    };
+    auto lookup = std::make_shared<Lookup>();
+    lookup->passwords.resize(usernames.size());
+    lookup->pending = usernames.size();
+    for (int i = 0; i < usernames.size(); ++i) {
+        m_impl->credentialStore->getPasswordAsync(
+            LOTRO_CREDENTIAL_SERVICE,
+            usernames[i].toStdString(),
+            this,
+            [this, lookup, i, usernames, gameConfig = *gameConfig, selectedWorld](
+                    std::optional<std::string> password) {
+                lookup->passwords[i] = std::move(password);
+                if (--lookup->pending == 0) {
+                    startMultiLaunch(gameConfig, selectedWorld, usernames, lookup->passwords);
+                }
+            }
+        );
+    }
+}
+
+void MainWindow::startMultiLaunch(const GameConfig& gameConfig, const World& selectedWorld,
+                                  const QStringList& usernames,
+                                  const std::vector<std::optional<std::string>>& passwords) {
+    if (!m_impl->servicesInfo) {
+        QMessageBox::warning(this, "Launch Error", "Game services not available");
+        return;
+    }
+    
+    std::vector<MultiLaunchAccount> selected;
+    QStringList missingPasswords;
+    for (int i = 0; i < usernames.size(); ++i) {
+        if (i < static_cast<int>(passwords.size()) && passwords[i]) {
+            selected.push_back({usernames[i], QString::fromStdString(*passwords[i])});
+        } else {
+            missingPasswords << usernames[i];
+        }
+    }
+    if (!missingPasswords.isEmpty()) {
+        QMessageBox::warning(this, "Multi-Launch",
+            "No saved password for " + missingPasswords.join(", ") +
+            ". Log in with these accounts once to include them.");
+    }
+    if (selected.empty()) {
+        return;
+    }
+    
+    // A group lives until its last client exits; a new one may start meanwhile
+    auto* group = new MultiLauncher(gameConfig, m_impl->currentGameId,
+                                    m_impl->servicesInfo->authServer, this);
+    m_impl->multiLauncher = group;
+    connect(group, &MultiLauncher::statusChanged, m_impl->statusLabel, &QLabel::setText);
+    connect(group, &MultiLauncher::clientStarted, this, [this](const QString&, qint64 processId) {
+        emit gameStarted(processId);
+    });
+    connect(group, &MultiLauncher::finished, this,
+            [this, group](const std::vector<MultiLaunchResult>& results) {
+                QStringList failures;
+                for (const auto& result : results) {
+                    if (!result.success) {
+                        failures << result.username + ": " + result.errorMessage;
+                    }
+                }
+                if (!failures.isEmpty()) {
+                    QMessageBox::warning(this, "Multi-Launch", 
+                        "Some accounts could not be launched:\n\n" + failures.join("\n"));
+                }
+                if (group->runningClients() == 0) {
+                    group->deleteLater();
+                }
+            });
+    connect(group, &MultiLauncher::allClientsExited, group, &QObject::deleteLater);
+    
+    saveCurrentAccount();
+    group->start(selected, selectedWorld);
+}
+
 void MainWindow::openSettings() {
     SettingsWindow settings(m_impl->currentGameId, this);
     if (settings.exec() == QDialog::Accepted) {
@@ -638,6 +1159,10 @@ void MainWindow::openCharacterTracker() {
 }
 
 void MainWindow::refreshNewsfeed() {
+    loadNewsfeed(nullptr);
+}
+
+void MainWindow::loadNewsfeed(std::function<void()> done) {
     // Determine news URL - use configured URL or fallback to known LOTRO feed
     QString newsUrl;
     if (m_impl->servicesInfo && !m_impl->servicesInfo->newsUrl.isEmpty()) {
@@ -651,119 +1176,141 @@ void MainWindow::refreshNewsfeed() {
             newsUrl = "https://www.ddo.com/en/launcher-feed.xml";
         } else {
             spdlog::warn("No news URL available for game: {}", gameType.toStdString());
+            if (done) {
+                done();
+            }
             return;
         }
     }
     
-    // Clear existing news items (but keep the stretch at the end)
-    while (m_impl->newsfeedLayout->count() > 1) {
-        QLayoutItem* item = m_impl->newsfeedLayout->takeAt(0);
-        if (item->widget()) {
-            delete item->widget();
-        }
-        delete item;
+    // Last-known news stays up until the fresh copy is in
+    if (m_impl->snapshot.news.empty()) {
+        clearNewsfeed(m_impl->newsfeedLayout);
+        QLabel* loadingLabel = new QLabel("Loading news...");
+        loadingLabel->setAlignment(Qt::AlignCenter);
+        loadingLabel->setStyleSheet("color: #6a6a8a; font-style: italic;");
+        m_impl->newsfeedLayout->insertWidget(0, loadingLabel);
     }
     
-    // Add loading indicator
-    QLabel* loadingLabel = new QLabel("Loading news...");
-    loadingLabel->setAlignment(Qt::AlignCenter);
-    loadingLabel->setStyleSheet("color: #6a6a8a; font-style: italic;");
-    m_impl->newsfeedLayout->insertWidget(0, loadingLabel);
-    
     // Fetch news asynchronously
-    auto future = fetchNewsfeed(newsUrl, 10);
+    const QString gameId = m_impl->currentGameId;
+    fetchNewsfeed(newsUrl, 10).then(this, [this, gameId, done](const std::vector<NewsItem>& items) {
+        if (gameId == m_impl->currentGameId) {
+            if (items.empty() && !m_impl->snapshot.news.empty()) {
+                spdlog::warn("Newsfeed unavailable, keeping last-known news");
+            } else if (!items.empty() && sameNews(items, m_impl->snapshot.news)) {
+                spdlog::debug("Newsfeed unchanged");
+            } else {
+                updateNewsfeed(items);
+                if (!items.empty()) {
+                    m_impl->snapshot.news = items;
+                    m_impl->snapshot.save(gameId);
+                }
+            }
+        }
+        if (done) {
+            done();
+        }
+    });
+}
+
+void MainWindow::updateNewsfeed(const std::vector<NewsItem>& items) {
+    clearNewsfeed(m_impl->newsfeedLayout);
+    
+    if (items.empty()) {
+        QLabel* noNewsLabel = new QLabel("No news available");
+        noNewsLabel->setAlignment(Qt::AlignCenter);
+        noNewsLabel->setStyleSheet("color: #6a6a8a;");
+        m_impl->newsfeedLayout->insertWidget(0, noNewsLabel);
+        return;
+    }
     
-    // Use QFutureWatcher for proper async handling
-    // For simplicity, we'll do a blocking call in a timer to avoid blocking UI
-    QTimer::singleShot(100, [this, future]() mutable {
-        future.waitForFinished();
-        auto items = future.result();
+    // Usually already under way from fetchNewsfeed(); last-known news
+    // shown at startup starts its images here
+    NewsAssetCache::shared().prefetch(items);
+    
+    // Create news cards
+    int index = 0;
+    for (const auto& newsItem : items) {
+        QFrame* card = new QFrame();
+        card->setFrameShape(QFrame::StyledPanel);
+        card->setStyleSheet(R"(
+            QFrame {
+                background-color: #252542;
+                border: 1px solid #3a3a5c;
+                border-left: 3px solid #c9a227;
+                border-radius: 4px;
+                padding: 8px;
+            }
+            QFrame:hover {
+                background-color: #2d2d50;
+                border-color: #4a4a6c;
+                border-left-color: #e6c96a;
+            }
+        )");
+        card->setCursor(Qt::PointingHandCursor);
         
-        // Clear loading indicator
-        while (m_impl->newsfeedLayout->count() > 1) {
-            QLayoutItem* item = m_impl->newsfeedLayout->takeAt(0);
-            if (item->widget()) {
-                delete item->widget();
+        QVBoxLayout* cardLayout = new QVBoxLayout(card);
+        cardLayout->setSpacing(6);
+        cardLayout->setContentsMargins(12, 10, 12, 10);
+        
+        // Title
+        QLabel* titleLabel = new QLabel(newsItem.title);
+        titleLabel->setWordWrap(true);
+        titleLabel->setStyleSheet("font-weight: bold; font-size: 13px; color: #c9a227;");
+        cardLayout->addWidget(titleLabel);
+        
+        // Date
+        QLabel* dateLabel = new QLabel(newsItem.publishedDateString());
+        dateLabel->setStyleSheet("font-size: 11px; color: #6a6a8a; margin-bottom: 4px;");
+        cardLayout->addWidget(dateLabel);
+        
+        // Image, shown now if prefetched or once NewsAssetCache has it
+        if (!newsItem.imageUrl.isEmpty()) {
+            QLabel* imageLabel = new QLabel();
+            imageLabel->setObjectName("newsImage");
+            imageLabel->setProperty("imageUrl", newsItem.imageUrl);
+            imageLabel->setAlignment(Qt::AlignCenter);
+            imageLabel->setStyleSheet("border: none; padding: 0;");
+            if (auto image = NewsAssetCache::shared().image(newsItem.imageUrl)) {
+                imageLabel->setPixmap(QPixmap::fromImage(*image));
+            } else {
+                imageLabel->hide();
             }
-            delete item;
+            cardLayout->addWidget(imageLabel);
         }
         
-        if (items.empty()) {
-            QLabel* noNewsLabel = new QLabel("No news available");
-            noNewsLabel->setAlignment(Qt::AlignCenter);
-            noNewsLabel->setStyleSheet("color: #6a6a8a;");
-            m_impl->newsfeedLayout->insertWidget(0, noNewsLabel);
-            return;
+        // Description - store both full and truncated text
+        QString fullDesc = newsItem.plainDescription();
+        QString truncatedDesc = fullDesc;
+        bool isTruncated = fullDesc.length() > 150;
+        if (isTruncated) {
+            truncatedDesc = fullDesc.left(147) + "...";
         }
         
-        // Create news cards
-        int index = 0;
-        for (const auto& newsItem : items) {
-            QFrame* card = new QFrame();
-            card->setFrameShape(QFrame::StyledPanel);
-            card->setStyleSheet(R"(
-                QFrame {
-                    background-color: #252542;
-                    border: 1px solid #3a3a5c;
-                    border-left: 3px solid #c9a227;
-                    border-radius: 4px;
-                    padding: 8px;
-                }
-                QFrame:hover {
-                    background-color: #2d2d50;
-                    border-color: #4a4a6c;
-                    border-left-color: #e6c96a;
-                }
-            )");
-            card->setCursor(Qt::PointingHandCursor);
-            
-            QVBoxLayout* cardLayout = new QVBoxLayout(card);
-            cardLayout->setSpacing(6);
-            cardLayout->setContentsMargins(12, 10, 12, 10);
-            
-            // Title
-            QLabel* titleLabel = new QLabel(newsItem.title);
-            titleLabel->setWordWrap(true);
-            titleLabel->setStyleSheet("font-weight: bold; font-size: 13px; color: #c9a227;");
-            cardLayout->addWidget(titleLabel);
-            
-            // Date
-            QLabel* dateLabel = new QLabel(newsItem.publishedDateString());
-            dateLabel->setStyleSheet("font-size: 11px; color: #6a6a8a; margin-bottom: 4px;");
-            cardLayout->addWidget(dateLabel);
-            
-            // Description - store both full and truncated text
-            QString fullDesc = newsItem.plainDescription();
-            QString truncatedDesc = fullDesc;
-            bool isTruncated = fullDesc.length() > 150;
-            if (isTruncated) {
-                truncatedDesc = fullDesc.left(147) + "...";
-            }
+        if (!fullDesc.isEmpty()) {
+            QLabel* descLabel = new QLabel(truncatedDesc);
+            descLabel->setWordWrap(true);
+            descLabel->setStyleSheet("font-size: 12px; color: #b0b0c0;");
+            descLabel->setObjectName("descLabel");
+            cardLayout->addWidget(descLabel);
             
-            if (!fullDesc.isEmpty()) {
-                QLabel* descLabel = new QLabel(truncatedDesc);
-                descLabel->setWordWrap(true);
-                descLabel->setStyleSheet("font-size: 12px; color: #b0b0c0;");
-                descLabel->setObjectName("descLabel");
-                cardLayout->addWidget(descLabel);
-                
-                // Store full description for expansion
-                card->setProperty("fullDescription", fullDesc);
-                card->setProperty("truncatedDescription", truncatedDesc);
-                card->setProperty("isExpanded", false);
-                card->setProperty("isTruncated", isTruncated);
-            }
-            
-            // Store link for click handling
-            QString link = newsItem.link;
-            card->setProperty("link", link);
-            card->installEventFilter(this);
-            
-            m_impl->newsfeedLayout->insertWidget(index++, card);
+            // Store full description for expansion
+            card->setProperty("fullDescription", fullDesc);
+            card->setProperty("truncatedDescription", truncatedDesc);
+            card->setProperty("isExpanded", false);
+            card->setProperty("isTruncated", isTruncated);
         }
         
-        spdlog::info("Displayed {} news items", items.size());
-    });
+        // Store link for click handling
+        QString link = newsItem.link;
+        card->setProperty("link", link);
+        card->installEventFilter(this);
+        
+        m_impl->newsfeedLayout->insertWidget(index++, card);
+    }
+    
+    spdlog::info("Displayed {} news items", items.size());
 }
 
 void MainWindow::loadSavedAccounts() {
@@ -786,7 +1333,7 @@ void MainWindow::loadSavedAccounts() {
     }
 }
 
-void MainWindow::loadAccount(const QString& username) {
+void MainWindow::loadAccount(const QString& username, std::function<void()> onLoaded) {
     auto& config = ConfigManager::instance();
     auto accounts = config.getAccounts(m_impl->currentGameId.toStdString());
     
@@ -795,18 +1342,29 @@ void MainWindow::loadAccount(const QString& username) {
             m_impl->loginWidget->setUsername(QString::fromStdString(account.username));
             m_impl->loginWidget->setAutoLoginEnabled(account.autoLogin);
             
+            m_impl->loginWidget->setPassword("");
+            
             // Always try to get password from keyring (passwords are always saved)
             if (m_impl->credentialStore) {
-                auto password = m_impl->credentialStore->getPassword(
+                m_impl->credentialStore->getPasswordAsync(
                     LOTRO_CREDENTIAL_SERVICE,
-                    account.username
+                    account.username,
+                    this,
+                    [this, username, onLoaded](std::optional<std::string> password) {
+                        // Another account may have been picked meanwhile
+                        if (m_impl->loginWidget->username() != username) {
+                            return;
+                        }
+                        if (password) {
+                            m_impl->loginWidget->setPassword(QString::fromStdString(*password));
+                        }
+                        if (onLoaded) {
+                            onLoaded();
+                        }
+                    }
                 );
-                
-                if (password) {
-                    m_impl->loginWidget->setPassword(QString::fromStdString(*password));
-                } else {
-                    m_impl->loginWidget->setPassword("");
-                }
+            } else if (onLoaded) {
+                onLoaded();
             }
             break;
         }
@@ -869,14 +1427,14 @@ void MainWindow::autoLogin() {
     for (const auto& account : accounts) {
         if (account.autoLogin) {
             // Found auto-login account. Load it and login.
-            loadAccount(QString::fromStdString(account.username));
-            
-            // Login relies on UI state (username/password getters)
-            // loadAccount sets the UI state, so calling login() immediately should work.
-            if (!m_impl->loginWidget->username().isEmpty() && 
-                !m_impl->loginWidget->password().isEmpty()) {
-                login();
-            }
+            // Login relies on UI state (username/password getters), which
+            // is complete once the password has come from the keyring
+            loadAccount(QString::fromStdString(account.username), [this]() {
+                if (!m_impl->loginWidget->username().isEmpty() && 
+                    !m_impl->loginWidget->password().isEmpty()) {
+                    login();
+                }
+            });
             break;
         }
     }
@@ -885,7 +1443,7 @@ void MainWindow::autoLogin() {
 void MainWindow::deleteAccount(const QString& username) {
     // Delete from credential store
     if (m_impl->credentialStore) {
-        m_impl->credentialStore->deletePassword(
+        m_impl->credentialStore->deletePasswordAsync(
             LOTRO_CREDENTIAL_SERVICE,
             username.toStdString()
         );
@@ -9,7 +9,12 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include <QMainWindow>
 #include <QString>
@@ -19,6 +24,9 @@
 
 namespace lotro {
 
+struct LoginResult;
+struct NewsItem;
+
 /**
  * Main application window
  * 
@@ -83,6 +91,11 @@ public slots:
      */
     void launchGame();
     
+    /**
+     * Launch several saved accounts on the selected world
+     */
+    void launchMultiple();
+    
     /**
      * Open the settings window
      */
@@ -113,19 +126,33 @@ protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
     
 private slots:
+    void onLoginResult(const LoginResult& result, const QString& username, const QString& password);
     void onLoginComplete();
     void onLoginFailed(const QString& error);
     void onWorldsLoaded();
+    void onWorldResolved(const World& world);
+    void onLatenciesMeasured();
     
 private:
+    void onServicesInfoLoaded(const std::optional<GameServicesInfo>& result);
+    void loadNewsfeed(std::function<void()> done);
     void setupUi();
     void setupConnections();
     void loadSavedAccounts();
-    void loadAccount(const QString& username);
+    void loadAccount(const QString& username, std::function<void()> onLoaded = {});
+    void startMultiLaunch(const GameConfig& gameConfig, const World& selectedWorld,
+                          const QStringList& usernames,
+                          const std::vector<std::optional<std::string>>& passwords);
     void saveCurrentAccount();
     void autoLogin();
     void updateWorldList(const std::vector<World>& worlds);
-    void updateNewsfeed();
+    void updateWorldEntry(int index, const World& world,
+                          const std::map<std::string, int64_t>& playTimes);
+    void onWorldChanged(const World& world);
+    std::map<std::string, int64_t> worldPlayTimes() const;
+    void selectFastestWorld();
+    QString lastUsedWorld() const;
+    void updateNewsfeed(const std::vector<NewsItem>& items);
     void deleteAccount(const QString& username);
     
     class Impl;
@@ -7,19 +7,50 @@
  */
 
 #include "PatchDialog.hpp"
+#include "companion/CompanionDataLoader.hpp"
+#include "core/config/ConfigManager.hpp"
+#include "game/BandwidthLimiter.hpp"
+#include "core/TaskScheduler.hpp"
+#include "network/HttpClient.hpp"
 
 #include <QApplication>
 #include <QDomDocument>
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QScrollBar>
-#include <QDateTime>
-#include <QEventLoop>
 
 #include <spdlog/spdlog.h>
 
+#include <type_traits>
+
 namespace lotro {
 
+namespace {
+
+QString formatBytes(qint64 current, qint64 total) {
+    if (total > 1024 * 1024) {
+        return QString("%1 / %2 MB").arg(current / (1024 * 1024)).arg(total / (1024 * 1024));
+    }
+    if (total > 1024) {
+        return QString("%1 / %2 KB").arg(current / 1024).arg(total / 1024);
+    }
+    return QString("%1 / %2 bytes").arg(current).arg(total);
+}
+
+QString formatRate(double bytesPerSecond, qint64 etaSeconds) {
+    QString text;
+    if (bytesPerSecond > 0) {
+        text += QString(" at %1 MB/s").arg(bytesPerSecond / (1024 * 1024), 0, 'f', 1);
+    }
+    if (etaSeconds >= 0) {
+        text += QString(", %1:%2 left")
+            .arg(etaSeconds / 60)
+            .arg(etaSeconds % 60, 2, 10, QChar('0'));
+    }
+    return text;
+}
+
+} // namespace
+
 PatchDialog::PatchDialog(const std::filesystem::path& gameDirectory,
                          const QString& patchServerUrl,
                          const QString& launcherConfigUrl,
@@ -35,15 +66,25 @@ PatchDialog::PatchDialog(const std::filesystem::path& gameDirectory,
 {
     setupUi();
     
+    m_progress = new PatchProgressAggregator(this);
+    connect(m_progress, &PatchProgressAggregator::progressReady, this, &PatchDialog::renderProgress);
+    connect(m_progress, &PatchProgressAggregator::logReady, this, &PatchDialog::renderLog);
+    
     // Create patch client and native patcher
     m_patchClient = std::make_unique<PatchClient>(m_gameDirectory);
     m_nativePatcher = std::make_unique<NativePatcher>(m_gameDirectory);
+    BandwidthLimiter::shared().setLimit(
+        static_cast<qint64>(ConfigManager::instance().programConfig().downloadLimitKBps) * 1024);
 }
 
 PatchDialog::~PatchDialog() {
     if (m_patchClient && m_patchClient->isPatching()) {
         m_patchClient->cancel();
     }
+    if (m_verifier) {
+        m_verifier->cancel();
+        m_verifyRun.waitForFinished();
+    }
 }
 
 void PatchDialog::setupUi() {
@@ -77,6 +118,7 @@ void PatchDialog::setupUi() {
     m_logView = new QTextEdit();
     m_logView->setReadOnly(true);
     m_logView->setMinimumHeight(250);
+    m_logView->document()->setMaximumBlockCount(MAX_LOG_LINES);
     m_logView->setStyleSheet(R"(
         QTextEdit {
             background-color: #0d0d15;
@@ -153,6 +195,13 @@ void PatchDialog::setupUi() {
     
     // Button row
     auto* buttonLayout = new QHBoxLayout();
+    
+    m_verifyButton = new QPushButton("Verify game data");
+    m_verifyButton->setMinimumHeight(36);
+    m_verifyButton->setEnabled(false);
+    m_verifyButton->setToolTip("Read and decompress every entry of the game's DAT files");
+    connect(m_verifyButton, &QPushButton::clicked, this, &PatchDialog::runVerification);
+    buttonLayout->addWidget(m_verifyButton);
     buttonLayout->addStretch();
     
     m_actionButton = new QPushButton("Abort");
@@ -175,6 +224,7 @@ void PatchDialog::setupUi() {
             background-color: #2a2a4c;
         }
     )");
+    m_verifyButton->setStyleSheet(m_actionButton->styleSheet());
     connect(m_actionButton, &QPushButton::clicked, this, &PatchDialog::onCancelClicked);
     buttonLayout->addWidget(m_actionButton);
     
@@ -184,20 +234,34 @@ void PatchDialog::setupUi() {
 }
 
 void PatchDialog::appendLog(const QString& message, const QString& color) {
-    // Format with timestamp
-    QString timestamp = QDateTime::currentDateTime().toString("HH:mm:ss");
-    QString formattedMsg = QString("<span style='color: #666666;'>[%1]</span> <span style='color: %2;'>%3</span>")
-        .arg(timestamp)
-        .arg(color)
-        .arg(message.toHtmlEscaped());
-    
-    m_logView->append(formattedMsg);
+    m_progress->log(message, color);
+}
+
+void PatchDialog::renderLog(const QStringList& lines) {
+    m_logView->setUpdatesEnabled(false);
+    for (const QString& line : lines) {
+        m_logView->append(line);
+    }
+    m_logView->setUpdatesEnabled(true);
     
     // Auto-scroll to bottom
     QScrollBar* scrollBar = m_logView->verticalScrollBar();
     scrollBar->setValue(scrollBar->maximum());
 }
 
+void PatchDialog::renderProgress(const PatchProgressAggregator::Progress& progress) {
+    std::visit([this](const auto& report) {
+        using Report = std::decay_t<decltype(report)>;
+        if constexpr (std::is_same_v<Report, PatchProgress>) {
+            updateProgress(report);
+        } else if constexpr (std::is_same_v<Report, NativePatchProgress>) {
+            updateNativeProgress(report);
+        } else {
+            updateVerifyProgress(report);
+        }
+    }, progress);
+}
+
 void PatchDialog::updatePhaseDisplay(int currentPhase, int totalPhases) {
     m_currentPhase = currentPhase;
     m_totalPhases = totalPhases;
@@ -214,6 +278,105 @@ bool PatchDialog::startPatching() {
     return m_success;
 }
 
+bool PatchDialog::startVerification() {
+    setWindowTitle("Verify Game Data");
+    m_titleLabel->setText("Verify Game Data");
+    QTimer::singleShot(100, this, &PatchDialog::runVerification);
+    
+    exec();
+    
+    return m_success;
+}
+
+void PatchDialog::runVerification() {
+    if (m_patching || m_verifying) {
+        return;
+    }
+    
+    m_verifying = true;
+    m_success = false;
+    m_verifyButton->setEnabled(false);
+    m_actionButton->setText("Abort");
+    m_actionButton->setEnabled(true);
+    m_phaseLabel->setText("Verification");
+    m_statusLabel->setText("Verifying game data...");
+    m_detailLabel->clear();
+    m_progressBar->setValue(0);
+    appendLog("*** Verifying game data ***", "#2a9d8f");
+    
+    m_verifier = std::make_unique<dat::DatVerifier>(QString::fromStdString(m_gameDirectory.string()));
+    dat::DatVerifier* verifier = m_verifier.get();
+    
+    PatchProgressAggregator* aggregator = m_progress;
+    auto progressCallback = [aggregator](const dat::DatVerifyProgress& progress) {
+        aggregator->post(progress);
+    };
+    
+    m_verifyRun = TaskScheduler::instance().run(TaskPool::Io, [verifier, progressCallback]() {
+        return verifier->run(progressCallback);
+    }, TaskPriority::High);
+    TaskScheduler::then(m_verifyRun, this, [this](const dat::DatVerifyReport& report) {
+        finishVerification(report);
+    });
+}
+
+void PatchDialog::updateVerifyProgress(const dat::DatVerifyProgress& progress) {
+    m_statusLabel->setText(QString("Verifying %1 (%2/%3)")
+        .arg(progress.archiveName)
+        .arg(progress.currentArchive)
+        .arg(progress.totalArchives));
+    m_detailLabel->setText(QString("%1 MB read, %2 problems found")
+        .arg(progress.bytesRead / (1024 * 1024))
+        .arg(progress.issues));
+    m_progressBar->setValue(progress.percentage());
+    m_progressBar->setFormat(QString("%1/%2 entries (%p%)")
+        .arg(progress.entriesChecked)
+        .arg(progress.totalEntries));
+}
+
+void PatchDialog::finishVerification(const dat::DatVerifyReport& report) {
+    m_verifying = false;
+    m_progress->flush();
+    m_success = report.isClean();
+    
+    constexpr size_t maxLoggedIssues = 200;
+    for (size_t i = 0; i < report.issues.size() && i < maxLoggedIssues; ++i) {
+        const auto& issue = report.issues[i];
+        appendLog(QString("%1: entry 0x%2: %3")
+            .arg(issue.archiveName)
+            .arg(issue.fileId, 8, 16, QChar('0'))
+            .arg(issue.reason), "#ff6b6b");
+    }
+    if (report.issues.size() > maxLoggedIssues) {
+        appendLog(QString("... and %1 more").arg(report.issues.size() - maxLoggedIssues), "#ff6b6b");
+    }
+    
+    appendLog(QString("Checked %1 entries in %2 archives: %3 MB in %4 s (%5 MB/s)")
+        .arg(report.entriesChecked)
+        .arg(report.archivesChecked)
+        .arg(report.bytesRead / (1024 * 1024))
+        .arg(report.elapsedMs / 1000.0, 0, 'f', 1)
+        .arg(report.throughputMBps(), 0, 'f', 1), "#aaaaaa");
+    
+    if (report.cancelled) {
+        m_statusLabel->setText("Verification aborted");
+        appendLog("*** Verification aborted ***", "#c9a227");
+    } else if (m_success) {
+        m_statusLabel->setText("Game data is intact");
+        m_progressBar->setValue(100);
+        appendLog("*** Game data is intact ***", "#2a9d8f");
+    } else {
+        m_lastError = QString("%1 damaged entries found").arg(report.issues.size());
+        m_statusLabel->setText("Game data is damaged");
+        m_detailLabel->setText("Run Repair Game to re-download the damaged files");
+        appendLog("*** " + m_lastError + " ***", "#ff6b6b");
+    }
+    
+    m_actionButton->setText("Close");
+    m_actionButton->setEnabled(true);
+    m_verifyButton->setEnabled(true);
+}
+
 void PatchDialog::runPatch() {
     m_patching = true;
     appendLog("*** Started ***", "#2a9d8f");
@@ -250,32 +413,32 @@ void PatchDialog::runPatch() {
             if (progress.phase == PatchPhase::FilesOnly) {
                 if (progress.status.contains("Initializing")) {
                     phaseNum++;
+                    if (phaseNum == 2) {
+                        appendLog("Starting file check (Phase 2)...", "#c9a227");
+                    } else {
+                        appendLog("Starting file re-check (Phase 3)...", "#c9a227");
+                    }
                     QMetaObject::invokeMethod(this, [this, phaseNum]() {
                         updatePhaseDisplay(phaseNum, 4);
-                        if (phaseNum == 2) {
-                            appendLog("Starting file check (Phase 2)...", "#c9a227");
-                        } else {
-                            appendLog("Starting file re-check (Phase 3)...", "#c9a227");
-                        }
                     }, Qt::QueuedConnection);
                 }
             } else if (progress.phase == PatchPhase::DataOnly) {
                 if (progress.status.contains("Initializing") || progress.status.contains("Checking")) {
+                    appendLog("Starting data patch (Phase 4)...", "#c9a227");
                     QMetaObject::invokeMethod(this, [this]() {
                         updatePhaseDisplay(4, 4);
-                        appendLog("Starting data patch (Phase 4)...", "#c9a227");
                     }, Qt::QueuedConnection);
                 }
             }
             
-            // Update UI on main thread
-            QMetaObject::invokeMethod(this, [this, progress]() {
-                updateProgress(progress);
-            }, Qt::QueuedConnection);
+            logPatchProgress(progress);
+            m_progress->post(progress);
         }
     );
     
     m_patching = false;
+    m_progress->flush();
+    m_clientTelemetry.reset();
     
     if (m_success) {
         m_statusLabel->setText("Update complete!");
@@ -284,6 +447,9 @@ void PatchDialog::runPatch() {
         m_actionButton->setText("Close");
         appendLog("*** Finished ***", "#2a9d8f");
         spdlog::info("Patching completed successfully");
+        
+        // Tables extracted from the DAT may have changed
+        CompanionDataLoader::instance().reload();
     } else {
         m_lastError = m_patchClient->lastError();
         m_statusLabel->setText("Update failed!");
@@ -292,6 +458,7 @@ void PatchDialog::runPatch() {
         appendLog("*** Failed: " + m_lastError + " ***", "#ff6b6b");
         spdlog::error("Patching failed: {}", m_lastError.toStdString());
     }
+    m_verifyButton->setEnabled(true);
     
     emit patchingFinished(m_success);
 }
@@ -303,35 +470,24 @@ void PatchDialog::updateProgress(const PatchProgress& progress) {
     // Update detail (current file being processed)
     if (!progress.currentFileName.isEmpty()) {
         m_detailLabel->setText(progress.currentFileName);
-        appendLog("Downloading: " + progress.currentFileName, "#8888ff");
     }
     
     // Update progress bar
     if (progress.totalBytes > 0) {
-        // Byte-based progress
-        int percentage = static_cast<int>((progress.currentBytes * 100) / progress.totalBytes);
-        m_progressBar->setValue(percentage);
-        
-        // Format: Downloaded / Total (percentage)
-        QString bytesStr;
-        if (progress.totalBytes > 1024 * 1024) {
-            bytesStr = QString("%1 / %2 MB")
-                .arg(progress.currentBytes / (1024 * 1024))
-                .arg(progress.totalBytes / (1024 * 1024));
-        } else if (progress.totalBytes > 1024) {
-            bytesStr = QString("%1 / %2 KB")
-                .arg(progress.currentBytes / 1024)
-                .arg(progress.totalBytes / 1024);
-        } else {
-            bytesStr = QString("%1 / %2 bytes")
-                .arg(progress.currentBytes)
-                .arg(progress.totalBytes);
+        // Byte-based progress, with rates over the frames drawn so far this phase
+        if (!m_clientTelemetry || progress.currentBytes == 0) {
+            m_clientTelemetry.emplace("patchclient");
         }
-        m_progressBar->setFormat(QString("%1 (%p%)").arg(bytesStr));
+        m_clientTelemetry->setTotals(progress.totalBytes, 0);
+        m_clientTelemetry->sample(progress.currentBytes, 0, 0);
+        
+        m_progressBar->setValue(progress.percentage());
+        m_progressBar->setFormat(QString("%1%2 (%p%)")
+            .arg(formatBytes(progress.currentBytes, progress.totalBytes))
+            .arg(formatRate(m_clientTelemetry->downloadRate(), m_clientTelemetry->etaSeconds())));
     } else if (progress.totalFiles > 0) {
         // File count-based progress
-        int percentage = (progress.currentFile * 100) / progress.totalFiles;
-        m_progressBar->setValue(percentage);
+        m_progressBar->setValue(progress.percentage());
         m_progressBar->setFormat(QString("%1/%2 files (%p%)")
             .arg(progress.currentFile)
             .arg(progress.totalFiles));
@@ -339,6 +495,12 @@ void PatchDialog::updateProgress(const PatchProgress& progress) {
         // Indeterminate - show activity
         m_progressBar->setFormat(progress.status);
     }
+}
+
+void PatchDialog::logPatchProgress(const PatchProgress& progress) {
+    if (!progress.currentFileName.isEmpty()) {
+        appendLog("Downloading: " + progress.currentFileName, "#8888ff");
+    }
     
     // Log important status changes
     if (progress.status.contains("Checking") && !progress.status.contains("...")) {
@@ -352,7 +514,33 @@ void PatchDialog::updateProgress(const PatchProgress& progress) {
     }
 }
 
+void PatchDialog::updateNativeProgress(const NativePatchProgress& progress) {
+    m_statusLabel->setText(progress.status);
+    if (!progress.currentFileName.isEmpty()) {
+        m_detailLabel->setText(progress.currentFileName);
+    }
+    const int pct = progress.percentage();
+    if (pct > 0) {
+        m_progressBar->setValue(pct);
+    }
+    if (progress.totalBytes > 0) {
+        m_progressBar->setFormat(QString("%1%2 (%p%)")
+            .arg(formatBytes(progress.bytesDownloaded, progress.totalBytes))
+            .arg(formatRate(progress.downloadBytesPerSecond, progress.etaSeconds)));
+    } else if (progress.totalFiles > 0) {
+        m_progressBar->setFormat(QString("%1/%2 files (%p%)")
+            .arg(progress.currentFile)
+            .arg(progress.totalFiles));
+    }
+}
+
 void PatchDialog::onCancelClicked() {
+    if (m_verifying) {
+        m_verifier->cancel();
+        m_statusLabel->setText("Aborting...");
+        m_actionButton->setEnabled(false);
+        return;
+    }
     if (m_patching) {
         if (m_patchClient && m_patchClient->isPatching()) {
             m_patchClient->cancel();
@@ -378,37 +566,19 @@ void PatchDialog::runAkamaiPhase() {
     appendLog("Fetching launcher configuration...", "#aaaaaa");
     
     // Fetch launcher config XML
-    QNetworkAccessManager networkManager;
-    QNetworkRequest request{QUrl{m_launcherConfigUrl}};
-    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, 
-                         QNetworkRequest::NoLessSafeRedirectPolicy);
-    
-    QNetworkReply* reply = networkManager.get(request);
-    
-    QEventLoop loop;
-    QTimer timer;
-    timer.setSingleShot(true);
-    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-    timer.start(30000);
-    loop.exec();
-    
-    if (!timer.isActive()) {
+    const HttpResponse reply = HttpClient::get(HttpClient::request(QUrl{m_launcherConfigUrl}));
+    
+    if (reply.timedOut()) {
         appendLog("Launcher config fetch timeout, skipping Akamai phase", "#c9a227");
-        reply->abort();
-        reply->deleteLater();
         return;
     }
-    timer.stop();
     
-    if (reply->error() != QNetworkReply::NoError) {
-        appendLog("Failed to fetch launcher config: " + reply->errorString(), "#c9a227");
-        reply->deleteLater();
+    if (!reply.ok()) {
+        appendLog("Failed to fetch launcher config: " + reply.errorString, "#c9a227");
         return;
     }
     
-    QString configXml = QString::fromUtf8(reply->readAll());
-    reply->deleteLater();
+    QString configXml = QString::fromUtf8(reply.body);
     
     // Parse appSettings XML to extract akamai URLs
     // Format: <appSettings><add key="..." value="..."/></appSettings>
@@ -448,22 +618,11 @@ void PatchDialog::runAkamaiPhase() {
         bool splashResult = m_nativePatcher->downloadSplashscreens(
             downloadFilesListUrl,
             [this](const NativePatchProgress& progress) {
-                QMetaObject::invokeMethod(this, [this, progress]() {
-                    m_statusLabel->setText(progress.status);
-                    if (!progress.currentFileName.isEmpty()) {
-                        m_detailLabel->setText(progress.currentFileName);
-                    }
-                    if (progress.totalFiles > 0) {
-                        int pct = (progress.currentFile * 100) / progress.totalFiles;
-                        m_progressBar->setValue(pct);
-                        m_progressBar->setFormat(QString("%1/%2 files (%p%)")
-                            .arg(progress.currentFile)
-                            .arg(progress.totalFiles));
-                    }
-                }, Qt::QueuedConnection);
-                QApplication::processEvents();
+                m_progress->post(progress);
+                m_progress->keepResponsive();
             }
         );
+        m_progress->flush();
         
         if (splashResult) {
             appendLog("Splashscreen download complete", "#2a9d8f");
@@ -488,36 +647,11 @@ void PatchDialog::runAkamaiPhase() {
             manifestUrl,
             akamaiDownloadUrl,
             [this](const NativePatchProgress& progress) {
-                QMetaObject::invokeMethod(this, [this, progress]() {
-                    m_statusLabel->setText(progress.status);
-                    if (!progress.currentFileName.isEmpty()) {
-                        m_detailLabel->setText(progress.currentFileName);
-                    }
-                    int pct = progress.percentage();
-                    if (pct > 0) {
-                        m_progressBar->setValue(pct);
-                    }
-                    if (progress.totalBytes > 0) {
-                        QString bytesStr;
-                        if (progress.totalBytes > 1024 * 1024) {
-                            bytesStr = QString("%1 / %2 MB")
-                                .arg(progress.bytesDownloaded / (1024 * 1024))
-                                .arg(progress.totalBytes / (1024 * 1024));
-                        } else {
-                            bytesStr = QString("%1 / %2 KB")
-                                .arg(progress.bytesDownloaded / 1024)
-                                .arg(progress.totalBytes / 1024);
-                        }
-                        m_progressBar->setFormat(QString("%1 (%p%)").arg(bytesStr));
-                    } else if (progress.totalFiles > 0) {
-                        m_progressBar->setFormat(QString("%1/%2 files (%p%)")
-                            .arg(progress.currentFile)
-                            .arg(progress.totalFiles));
-                    }
-                }, Qt::QueuedConnection);
-                QApplication::processEvents();
+                m_progress->post(progress);
+                m_progress->keepResponsive();
             }
         );
+        m_progress->flush();
         
         if (filesResult) {
             appendLog("Game file check complete", "#2a9d8f");
@@ -11,8 +11,12 @@
 
 #include "game/PatchClient.hpp"
 #include "game/NativePatcher.hpp"
+#include "dat/DatVerifier.hpp"
+#include "game/PatchTelemetry.hpp"
+#include "PatchProgressAggregator.hpp"
 
 #include <QDialog>
+#include <QFuture>
 #include <QLabel>
 #include <QProgressBar>
 #include <QPushButton>
@@ -20,6 +24,8 @@
 #include <QVBoxLayout>
 #include <QTimer>
 
+#include <optional>
+
 namespace lotro {
 
 /**
@@ -27,6 +33,8 @@ namespace lotro {
  * 
  * Shows progress of the patching operation with cancel support.
  * Features a detailed log view and precise progress tracking.
+ * Progress and log lines go through a PatchProgressAggregator and are
+ * drawn at its refresh rate, not once per patcher callback.
  * 
  * Patching phases (matching OneLauncher):
  *   Phase 1: Akamai CDN - download missing game files and splashscreens
@@ -52,6 +60,12 @@ public:
      */
     bool startPatching();
     
+    /**
+     * Verify the game's DAT archives instead of patching
+     * @return true if every entry could be read and decoded
+     */
+    bool startVerification();
+    
     /**
      * Check if patching was successful
      */
@@ -68,12 +82,19 @@ signals:
 private slots:
     void onCancelClicked();
     void updateProgress(const PatchProgress& progress);
+    void updateNativeProgress(const NativePatchProgress& progress);
+    void updateVerifyProgress(const dat::DatVerifyProgress& progress);
+    void renderProgress(const PatchProgressAggregator::Progress& progress);
+    void renderLog(const QStringList& lines);
     
 private:
     void setupUi();
     void runPatch();
     void runAkamaiPhase();
+    void runVerification();
+    void finishVerification(const dat::DatVerifyReport& report);
     void appendLog(const QString& message, const QString& color = "#aaaaaa");
+    void logPatchProgress(const PatchProgress& progress);
     void updatePhaseDisplay(int currentPhase, int totalPhases);
     
     std::filesystem::path m_gameDirectory;
@@ -83,6 +104,10 @@ private:
     QString m_locale;
     std::unique_ptr<PatchClient> m_patchClient;
     std::unique_ptr<NativePatcher> m_nativePatcher;
+    std::unique_ptr<dat::DatVerifier> m_verifier;
+    QFuture<dat::DatVerifyReport> m_verifyRun;
+    PatchProgressAggregator* m_progress = nullptr;
+    std::optional<PatchTelemetry> m_clientTelemetry;  // Rates for patchclient.dll's byte counts
     
     // UI elements
     QLabel* m_titleLabel = nullptr;
@@ -91,14 +116,18 @@ private:
     QLabel* m_detailLabel = nullptr;
     QTextEdit* m_logView = nullptr;
     QProgressBar* m_progressBar = nullptr;
+    QPushButton* m_verifyButton = nullptr;
     QPushButton* m_actionButton = nullptr;
     
     // State
     bool m_success = false;
     bool m_patching = false;
+    bool m_verifying = false;
     QString m_lastError;
     int m_currentPhase = 0;
     int m_totalPhases = 4;  // Akamai, FilesOnly, FilesOnly, DataOnly
+    
+    static constexpr int MAX_LOG_LINES = 5000;
 };
 
 } // namespace lotro
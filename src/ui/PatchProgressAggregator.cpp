@@ -0,0 +1,64 @@
+/**
+ * LOTRO Launcher - Patch Progress Aggregator Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "PatchProgressAggregator.hpp"
+
+#include <QApplication>
+#include <QDateTime>
+#include <QThread>
+
+namespace lotro {
+
+PatchProgressAggregator::PatchProgressAggregator(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setInterval(REFRESH_MS);
+    connect(&m_timer, &QTimer::timeout, this, &PatchProgressAggregator::flush);
+    m_timer.start();
+    m_sincePump.start();
+}
+
+void PatchProgressAggregator::post(Progress progress) {
+    std::lock_guard lock(m_mutex);
+    m_latest = std::move(progress);
+}
+
+void PatchProgressAggregator::log(const QString& message, const QString& color) {
+    const QString line = QString("<span style='color: #666666;'>[%1]</span> <span style='color: %2;'>%3</span>")
+        .arg(QDateTime::currentDateTime().toString("HH:mm:ss"))
+        .arg(color)
+        .arg(message.toHtmlEscaped());
+    
+    std::lock_guard lock(m_mutex);
+    m_lines.append(line);
+}
+
+void PatchProgressAggregator::flush() {
+    std::optional<Progress> latest;
+    QStringList lines;
+    {
+        std::lock_guard lock(m_mutex);
+        latest.swap(m_latest);
+        lines.swap(m_lines);
+    }
+    
+    if (!lines.isEmpty()) {
+        emit logReady(lines);
+    }
+    if (latest) {
+        emit progressReady(*latest);
+    }
+}
+
+void PatchProgressAggregator::keepResponsive() {
+    if (QThread::currentThread() != thread() || m_sincePump.elapsed() < REFRESH_MS) {
+        return;
+    }
+    m_sincePump.restart();
+    QApplication::processEvents();
+}
+
+} // namespace lotro
@@ -0,0 +1,86 @@
+/**
+ * LOTRO Launcher - Patch Progress Aggregator
+ * 
+ * Collects patch and verification progress for the patch dialog to draw
+ * at a fixed rate.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "game/PatchClient.hpp"
+#include "game/NativePatcher.hpp"
+#include "dat/DatVerifier.hpp"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+#include <mutex>
+#include <optional>
+#include <variant>
+
+namespace lotro {
+
+/**
+ * Latest progress of a run plus the log lines written since the last frame
+ * 
+ * Patchers report after every file, which over thousands of small files
+ * is far more often than anyone can read a label. post() and log() only
+ * store the report and queue the line, from any thread; every REFRESH_MS
+ * the GUI thread takes the newest report and all queued lines and emits
+ * them once, so the dialog repaints at most that often however fast the
+ * run goes.
+ */
+class PatchProgressAggregator : public QObject {
+    Q_OBJECT
+    
+public:
+    using Progress = std::variant<PatchProgress, NativePatchProgress, dat::DatVerifyProgress>;
+    
+    explicit PatchProgressAggregator(QObject* parent = nullptr);
+    
+    /**
+     * Replace the report to draw next; earlier undrawn ones are dropped
+     */
+    void post(Progress progress);
+    
+    /**
+     * Queue a log line, stamped with the time it was written
+     */
+    void log(const QString& message, const QString& color);
+    
+    /**
+     * Emit whatever is pending now, before drawing a final state
+     */
+    void flush();
+    
+    /**
+     * Let the GUI thread handle events if a frame is due
+     * 
+     * For callbacks that run on the GUI thread between event loops, in
+     * place of processing events after every one. Does nothing elsewhere.
+     */
+    void keepResponsive();
+    
+    static constexpr int REFRESH_MS = 33;
+    
+signals:
+    void progressReady(const PatchProgressAggregator::Progress& progress);
+    
+    /**
+     * Queued lines as HTML, one per line, oldest first
+     */
+    void logReady(const QStringList& lines);
+    
+private:
+    QTimer m_timer;
+    QElapsedTimer m_sincePump;
+    std::mutex m_mutex;
+    std::optional<Progress> m_latest;
+    QStringList m_lines;
+};
+
+} // namespace lotro
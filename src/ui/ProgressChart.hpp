@@ -0,0 +1,135 @@
+/**
+ * LOTRO Launcher - Progress Chart Widget
+ * 
+ * Step chart of one character history series over time.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QPainter>
+#include <QPainterPath>
+#include <QWidget>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "companion/CharacterHistory.hpp"
+
+namespace lotro {
+
+/**
+ * Chart of HistoryPoints, value held until the next sample
+ * 
+ * Samples landing on the same pixel column are merged, so a series of
+ * any length costs at most a few points per pixel to draw.
+ * 
+ * Note: Header-only implementation, no Q_OBJECT to avoid MOC complexity.
+ */
+class ProgressChart : public QWidget {
+public:
+    using Formatter = std::function<QString(int64_t)>;
+    
+    explicit ProgressChart(QWidget* parent = nullptr)
+        : QWidget(parent)
+    {
+        setMinimumHeight(220);
+    }
+    
+    void setPoints(std::vector<HistoryPoint> points, Formatter format = nullptr) {
+        m_points = std::move(points);
+        m_format = std::move(format);
+        update();
+    }
+    
+    void clear() {
+        m_points.clear();
+        update();
+    }
+
+protected:
+    void paintEvent(QPaintEvent*) override {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.fillRect(rect(), QColor("#1a1a2e"));
+        
+        if (m_points.empty()) {
+            painter.setPen(QColor("#888888"));
+            painter.drawText(rect(), Qt::AlignCenter, tr("No history recorded for this range"));
+            return;
+        }
+        
+        const QRectF plot = QRectF(rect()).adjusted(64, 12, -12, -28);
+        auto [minIt, maxIt] = std::minmax_element(m_points.begin(), m_points.end(),
+            [](const HistoryPoint& a, const HistoryPoint& b) { return a.value < b.value; });
+        double minValue = static_cast<double>(minIt->value);
+        double maxValue = static_cast<double>(maxIt->value);
+        if (maxValue == minValue) {
+            maxValue += 1.0;
+        }
+        double minTime = seconds(m_points.front());
+        double maxTime = seconds(m_points.back());
+        if (maxTime == minTime) {
+            maxTime += 1.0;
+        }
+        
+        auto xFor = [&](const HistoryPoint& p) {
+            return plot.left() + (seconds(p) - minTime) / (maxTime - minTime) * plot.width();
+        };
+        auto yFor = [&](int64_t value) {
+            return plot.bottom() - (static_cast<double>(value) - minValue) / (maxValue - minValue) * plot.height();
+        };
+        
+        // Axes and labels
+        painter.setPen(QColor("#3a3a5c"));
+        painter.drawLine(plot.bottomLeft(), plot.bottomRight());
+        painter.drawLine(plot.bottomLeft(), plot.topLeft());
+        painter.setPen(QColor("#888888"));
+        painter.drawText(QRectF(0, plot.top() - 6, plot.left() - 6, 14), Qt::AlignRight, label(maxIt->value));
+        painter.drawText(QRectF(0, plot.bottom() - 8, plot.left() - 6, 14), Qt::AlignRight, label(minIt->value));
+        painter.drawText(QRectF(plot.left(), plot.bottom() + 6, plot.width() / 2, 16), Qt::AlignLeft,
+                         date(m_points.front()));
+        painter.drawText(QRectF(plot.center().x(), plot.bottom() + 6, plot.width() / 2, 16), Qt::AlignRight,
+                         date(m_points.back()));
+        
+        QPainterPath path;
+        path.moveTo(xFor(m_points.front()), yFor(m_points.front().value));
+        double lastX = path.currentPosition().x();
+        for (size_t i = 1; i < m_points.size(); ++i) {
+            double x = xFor(m_points[i]);
+            double y = yFor(m_points[i].value);
+            if (x - lastX < 1.0 && i + 1 < m_points.size()) {
+                continue;
+            }
+            path.lineTo(x, path.currentPosition().y());
+            path.lineTo(x, y);
+            lastX = x;
+        }
+        path.lineTo(plot.right(), path.currentPosition().y());
+        
+        painter.setPen(QPen(QColor("#c9a227"), 2));
+        painter.drawPath(path);
+    }
+
+private:
+    static double seconds(const HistoryPoint& point) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::seconds>(
+            point.time.time_since_epoch()).count());
+    }
+    
+    static QString date(const HistoryPoint& point) {
+        return QDateTime::fromSecsSinceEpoch(static_cast<qint64>(seconds(point))).toString("yyyy-MM-dd hh:mm");
+    }
+    
+    QString label(int64_t value) const {
+        return m_format ? m_format(value) : QString::number(value);
+    }
+    
+    std::vector<HistoryPoint> m_points;
+    Formatter m_format;
+};
+
+} // namespace lotro
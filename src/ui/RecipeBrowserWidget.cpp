@@ -5,22 +5,84 @@
  */
 
 #include "RecipeBrowserWidget.hpp"
+#include "RecipeListModel.hpp"
 #include "companion/GameDatabase.hpp"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLineEdit>
 #include <QComboBox>
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
 #include <QLabel>
 #include <QTextEdit>
 #include <QSplitter>
+#include <QTimer>
 
 #include <spdlog/spdlog.h>
 
 namespace lotro {
 
+namespace {
+
+QString recipeSummaryHtml(const Recipe& recipe) {
+    QString html = QString("<h3>%1</h3>").arg(recipe.name.toHtmlEscaped());
+    
+    html += QString("<p><b>Profession:</b> %1 (Tier %2)</p>")
+        .arg(recipe.profession.toHtmlEscaped())
+        .arg(recipe.tier);
+    
+    if (!recipe.category.isEmpty()) {
+        html += QString("<p><b>Category:</b> %1</p>").arg(recipe.category.toHtmlEscaped());
+    }
+    
+    // Output
+    html += QString("<p><b>Creates:</b> %1")
+        .arg(recipe.outputItemName.toHtmlEscaped());
+    if (recipe.outputQuantity > 1) {
+        html += QString(" x%1").arg(recipe.outputQuantity);
+    }
+    html += "</p>";
+    
+    // Ingredients
+    if (!recipe.ingredients.empty()) {
+        html += "<p><b>Ingredients:</b></p><ul>";
+        for (const auto& ing : recipe.ingredients) {
+            html += QString("<li>%1 x%2</li>")
+                .arg(ing.name.toHtmlEscaped())
+                .arg(ing.quantity);
+        }
+        html += "</ul>";
+    }
+    return html;
+}
+
+// Full tree, only worth showing when some ingredient is itself crafted
+QString billOfMaterialsHtml(const BillOfMaterials& bom) {
+    if (bom.steps.size() <= 1) {
+        return {};
+    }
+    QString html = "<p><b>Crafting steps:</b></p><ol>";
+    for (const auto& step : bom.steps) {
+        html += QString("<li>%1 x%2</li>")
+            .arg(step.recipe->name.toHtmlEscaped())
+            .arg(step.crafts);
+    }
+    html += "</ol>";
+    
+    html += "<p><b>Raw materials:</b></p><ul>";
+    for (const auto& material : bom.materials) {
+        QString name = material.name.isEmpty() ? material.itemId : material.name;
+        html += QString("<li>%1 x%2</li>")
+            .arg(name.toHtmlEscaped())
+            .arg(material.quantity);
+    }
+    html += "</ul>";
+    return html;
+}
+
+} // anonymous namespace
+
 RecipeBrowserWidget::RecipeBrowserWidget(QWidget* parent)
     : QWidget(parent)
 {
@@ -28,7 +90,9 @@ RecipeBrowserWidget::RecipeBrowserWidget(QWidget* parent)
     refresh();
 }
 
-RecipeBrowserWidget::~RecipeBrowserWidget() = default;
+RecipeBrowserWidget::~RecipeBrowserWidget() {
+    m_detailsQuery.cancel();
+}
 
 void RecipeBrowserWidget::setupUi() {
     auto* mainLayout = new QVBoxLayout(this);
@@ -44,6 +108,11 @@ void RecipeBrowserWidget::setupUi() {
     connect(m_searchEdit, &QLineEdit::textChanged, this, &RecipeBrowserWidget::onSearchChanged);
     searchLayout->addWidget(m_searchEdit, 1);
     
+    m_searchTimer = new QTimer(this);
+    m_searchTimer->setSingleShot(true);
+    m_searchTimer->setInterval(SEARCH_DELAY_MS);
+    connect(m_searchTimer, &QTimer::timeout, this, &RecipeBrowserWidget::refresh);
+    
     m_professionCombo = new QComboBox();
     m_professionCombo->addItem(tr("All Professions"), QString());
     m_professionCombo->addItem(tr("Cook"), "Cook");
@@ -71,17 +140,24 @@ void RecipeBrowserWidget::setupUi() {
     auto* splitter = new QSplitter(Qt::Vertical);
     
     // Recipe table
-    m_recipeTable = new QTableWidget();
-    m_recipeTable->setColumnCount(4);
-    m_recipeTable->setHorizontalHeaderLabels({tr("Name"), tr("Profession"), tr("Tier"), tr("Output")});
+    m_model = new RecipeListModel(this);
+    connect(m_model, &RecipeListModel::queryFinished, this, [this](int matches) {
+        m_countLabel->setText(tr("%1 recipes").arg(matches));
+        m_detailsQuery.cancel();
+        m_detailsView->clear();
+    });
+    
+    m_recipeTable = new QTableView();
+    m_recipeTable->setModel(m_model);
     m_recipeTable->horizontalHeader()->setStretchLastSection(true);
-    m_recipeTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_recipeTable->horizontalHeader()->setSectionResizeMode(RecipeListModel::NameColumn, QHeaderView::Stretch);
     m_recipeTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_recipeTable->setSelectionMode(QAbstractItemView::SingleSelection);
     m_recipeTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     m_recipeTable->setAlternatingRowColors(true);
     m_recipeTable->verticalHeader()->setVisible(false);
-    connect(m_recipeTable, &QTableWidget::itemSelectionChanged,
+    m_recipeTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    connect(m_recipeTable->selectionModel(), &QItemSelectionModel::currentRowChanged,
             this, &RecipeBrowserWidget::onRecipeSelected);
     splitter->addWidget(m_recipeTable);
     
@@ -97,55 +173,20 @@ void RecipeBrowserWidget::setupUi() {
 }
 
 void RecipeBrowserWidget::refresh() {
-    auto& db = GameDatabase::instance();
-    
-    if (!db.isLoaded()) {
+    m_searchTimer->stop();
+    if (!GameDatabase::current()->isLoaded()) {
         m_countLabel->setText(tr("Database not loaded"));
-        m_recipeTable->setRowCount(0);
+        m_model->clear();
         return;
     }
     
-    QString profession = m_professionCombo->currentData().toString();
-    QString searchText = m_searchEdit->text();
-    
-    if (!profession.isEmpty() && searchText.isEmpty()) {
-        m_currentRecipes = db.getRecipesByProfession(profession);
-    } else if (!searchText.isEmpty()) {
-        auto results = db.searchRecipes(searchText);
-        
-        if (!profession.isEmpty()) {
-            m_currentRecipes.clear();
-            for (const auto& recipe : results) {
-                if (recipe.profession == profession) {
-                    m_currentRecipes.push_back(recipe);
-                }
-            }
-        } else {
-            m_currentRecipes = results;
-        }
-    } else {
-        m_currentRecipes = db.searchRecipes("");
-    }
-    
-    populateRecipes(m_currentRecipes);
-}
-
-void RecipeBrowserWidget::populateRecipes(const std::vector<Recipe>& recipes) {
-    m_recipeTable->setRowCount(static_cast<int>(recipes.size()));
-    m_countLabel->setText(tr("%1 recipes").arg(recipes.size()));
-    
-    int row = 0;
-    for (const auto& recipe : recipes) {
-        m_recipeTable->setItem(row, 0, new QTableWidgetItem(recipe.name));
-        m_recipeTable->setItem(row, 1, new QTableWidgetItem(recipe.profession));
-        m_recipeTable->setItem(row, 2, new QTableWidgetItem(QString("Tier %1").arg(recipe.tier)));
-        m_recipeTable->setItem(row, 3, new QTableWidgetItem(recipe.outputItemName));
-        row++;
-    }
+    // Runs off the GUI thread; the count label follows when it is done
+    m_model->setQuery(m_searchEdit->text(), m_professionCombo->currentData().toString());
 }
 
 void RecipeBrowserWidget::onSearchChanged(const QString& /*text*/) {
-    refresh();
+    // Wait for a pause in typing rather than searching per keystroke
+    m_searchTimer->start();
 }
 
 void RecipeBrowserWidget::onProfessionChanged(int /*index*/) {
@@ -153,46 +194,35 @@ void RecipeBrowserWidget::onProfessionChanged(int /*index*/) {
 }
 
 void RecipeBrowserWidget::onRecipeSelected() {
-    int row = m_recipeTable->currentRow();
-    if (row < 0 || row >= static_cast<int>(m_currentRecipes.size())) {
+    m_detailsQuery.cancel();
+    const Recipe* recipe = m_model->recipeAt(m_recipeTable->currentIndex().row());
+    if (!recipe) {
         m_detailsView->clear();
         return;
     }
     
-    showRecipeDetails(m_currentRecipes[row]);
+    showRecipeDetails(*recipe);
 }
 
 void RecipeBrowserWidget::showRecipeDetails(const Recipe& recipe) {
-    QString html = QString("<h3>%1</h3>").arg(recipe.name.toHtmlEscaped());
-    
-    html += QString("<p><b>Profession:</b> %1 (Tier %2)</p>")
-        .arg(recipe.profession.toHtmlEscaped())
-        .arg(recipe.tier);
-    
-    if (!recipe.category.isEmpty()) {
-        html += QString("<p><b>Category:</b> %1</p>").arg(recipe.category.toHtmlEscaped());
-    }
-    
-    // Output
-    html += QString("<p><b>Creates:</b> %1")
-        .arg(recipe.outputItemName.toHtmlEscaped());
-    if (recipe.outputQuantity > 1) {
-        html += QString(" x%1").arg(recipe.outputQuantity);
+    // The recipe itself shows at once; the crafting tree walks the recipe
+    // graph, so it is worked out on the CPU pool and added when ready
+    const QString summary = recipeSummaryHtml(recipe);
+    m_detailsView->setHtml(summary);
+    if (recipe.ingredients.empty()) {
+        return;
     }
-    html += "</p>";
     
-    // Ingredients
-    if (!recipe.ingredients.empty()) {
-        html += "<p><b>Ingredients:</b></p><ul>";
-        for (const auto& ing : recipe.ingredients) {
-            html += QString("<li>%1 x%2</li>")
-                .arg(ing.name.toHtmlEscaped())
-                .arg(ing.quantity);
+    m_detailsQuery = CancellationToken();
+    auto future = TaskScheduler::instance().run(TaskPool::Cpu, m_detailsQuery,
+        [id = recipe.id, db = GameDatabase::current()]() {
+            return billOfMaterialsHtml(db->getRecipeBillOfMaterials(id));
+        });
+    TaskScheduler::then(future, this, m_detailsQuery, [this, summary](QString tree) {
+        if (!tree.isEmpty()) {
+            m_detailsView->setHtml(summary + tree);
         }
-        html += "</ul>";
-    }
-    
-    m_detailsView->setHtml(html);
+    });
 }
 
 } // namespace lotro
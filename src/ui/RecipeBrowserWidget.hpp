@@ -10,15 +10,19 @@
 
 #include <QWidget>
 #include "companion/GameDatabase.hpp"
+#include "core/TaskScheduler.hpp"
 
 class QLineEdit;
 class QComboBox;
-class QTableWidget;
+class QTableView;
 class QLabel;
 class QTextEdit;
+class QTimer;
 
 namespace lotro {
 
+class RecipeListModel;
+
 /**
  * Widget for browsing recipes
  */
@@ -38,16 +42,19 @@ private slots:
 
 private:
     void setupUi();
-    void populateRecipes(const std::vector<Recipe>& recipes);
     void showRecipeDetails(const Recipe& recipe);
     
     QLineEdit* m_searchEdit = nullptr;
     QComboBox* m_professionCombo = nullptr;
-    QTableWidget* m_recipeTable = nullptr;
+    QTableView* m_recipeTable = nullptr;
+    RecipeListModel* m_model = nullptr;
     QTextEdit* m_detailsView = nullptr;
     QLabel* m_countLabel = nullptr;
+    QTimer* m_searchTimer = nullptr;
+    CancellationToken m_detailsQuery;
     
-    std::vector<Recipe> m_currentRecipes;
+    // Quiet time after a keystroke before searching
+    static constexpr int SEARCH_DELAY_MS = 150;
 };
 
 } // namespace lotro
@@ -0,0 +1,128 @@
+/**
+ * LOTRO Launcher - Recipe List Model Implementation
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "RecipeListModel.hpp"
+#include "companion/TextSearchIndex.hpp"
+
+#include <QStringList>
+
+namespace lotro {
+
+RecipeListModel::RecipeListModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+RecipeListModel::~RecipeListModel() {
+    m_query.cancel();
+}
+
+void RecipeListModel::setQuery(const QString& text, const QString& profession) {
+    m_query.cancel();
+    m_query = CancellationToken();
+    const CancellationToken token = m_query;
+    
+    // Hits of the last search, if this one can be answered from them and
+    // the database hasn't been reloaded since
+    auto generation = GameDatabase::current();
+    std::shared_ptr<const Positions> previous;
+    if (m_hits && generation == m_db && TextSearchIndex::narrows(m_hitsText, text)) {
+        previous = m_hits;
+    }
+    
+    auto future = TaskScheduler::instance().run(TaskPool::Cpu, token, [text, profession, previous, generation]() {
+        const auto& db = *generation;
+        Result result;
+        result.db = generation;
+        result.recipes = db.recipesView();
+        
+        if (!text.isEmpty()) {
+            result.hits = std::make_shared<const Positions>(previous
+                ? db.refineRecipePositions(text, *previous)
+                : db.searchRecipePositions(text));
+            if (profession.isEmpty()) {
+                result.order = *result.hits;
+            } else {
+                for (uint32_t i : *result.hits) {
+                    if (result.recipes[i].profession == profession) {
+                        result.order.push_back(i);
+                    }
+                }
+            }
+        } else if (!profession.isEmpty()) {
+            auto positions = db.recipePositionsByProfession(profession);
+            result.order.assign(positions.begin(), positions.end());
+        } else {
+            result.order = db.searchRecipePositions({});
+        }
+        return result;
+    });
+    
+    TaskScheduler::then(future, this, token, [this, text](Result result) {
+        m_hitsText = text;
+        m_hits = std::move(result.hits);
+        
+        beginResetModel();
+        m_db = std::move(result.db);
+        m_recipes = result.recipes;
+        m_order = std::move(result.order);
+        endResetModel();
+        emit queryFinished(static_cast<int>(m_order.size()));
+    });
+}
+
+void RecipeListModel::clear() {
+    m_query.cancel();
+    m_hitsText.clear();
+    m_hits.reset();
+    beginResetModel();
+    m_db.reset();
+    m_recipes = {};
+    m_order.clear();
+    endResetModel();
+}
+
+const Recipe* RecipeListModel::recipeAt(int row) const {
+    if (row < 0 || row >= static_cast<int>(m_order.size())) {
+        return nullptr;
+    }
+    return &m_recipes[m_order[row]];
+}
+
+int RecipeListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_order.size());
+}
+
+int RecipeListModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant RecipeListModel::data(const QModelIndex& index, int role) const {
+    const Recipe* recipe = index.isValid() ? recipeAt(index.row()) : nullptr;
+    if (!recipe || role != Qt::DisplayRole) {
+        return {};
+    }
+    
+    switch (index.column()) {
+        case NameColumn: return recipe->name;
+        case ProfessionColumn: return recipe->profession;
+        case TierColumn: return QString("Tier %1").arg(recipe->tier);
+        case OutputColumn: return recipe->outputItemName;
+    }
+    return {};
+}
+
+QVariant RecipeListModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return {};
+    }
+    static const QStringList headers = {
+        tr("Name"), tr("Profession"), tr("Tier"), tr("Output")
+    };
+    return headers.value(section);
+}
+
+} // namespace lotro
@@ -0,0 +1,90 @@
+/**
+ * LOTRO Launcher - Recipe List Model
+ * 
+ * Item model behind the recipe browser's table.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "companion/GameDatabase.hpp"
+#include "core/TaskScheduler.hpp"
+
+#include <QAbstractTableModel>
+#include <QString>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Recipes matching a search and profession, by position in the database
+ * 
+ * Rows are positions into the recipesView() of the database generation
+ * the query ran against, which the model holds on to, and cells are
+ * formatted in data(), so only rows on screen cost anything. Queries run
+ * on the CPU pool and a new one cancels the one before it. The uncapped
+ * hits of the last search are kept: when the next search only extends
+ * the text, as typing does, it ranks those hits again instead of going
+ * through the index.
+ */
+class RecipeListModel : public QAbstractTableModel {
+    Q_OBJECT
+    
+public:
+    enum Column {
+        NameColumn, ProfessionColumn, TierColumn, OutputColumn,
+        ColumnCount
+    };
+    
+    explicit RecipeListModel(QObject* parent = nullptr);
+    ~RecipeListModel() override;
+    
+    /**
+     * Show recipes matching the text, of one profession or all when empty
+     */
+    void setQuery(const QString& text, const QString& profession);
+    
+    /**
+     * Drop all rows, remembered hits and any query still running
+     */
+    void clear();
+    
+    /**
+     * The recipe shown in a row, nullptr if out of range
+     */
+    const Recipe* recipeAt(int row) const;
+    
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    
+signals:
+    /**
+     * A query's rows are in place
+     */
+    void queryFinished(int matches);
+    
+private:
+    using Positions = std::vector<uint32_t>;
+    
+    struct Result {
+        std::shared_ptr<const GameDatabase> db;
+        std::span<const Recipe> recipes;
+        std::shared_ptr<const Positions> hits;      // Search hits before the profession filter
+        Positions order;
+    };
+    
+    std::shared_ptr<const GameDatabase> m_db;   // Generation m_recipes belongs to
+    std::span<const Recipe> m_recipes;
+    Positions m_order;                  // Matching positions in m_recipes, best first
+    QString m_hitsText;                 // Search that m_hits answers
+    std::shared_ptr<const Positions> m_hits;
+    CancellationToken m_query;
+};
+
+} // namespace lotro
@@ -6,9 +6,13 @@
 
 #include "SettingsWindow.hpp"
 #include "PatchDialog.hpp"
+#include "core/Metrics.hpp"
+#include "core/TaskScheduler.hpp"
 #include "core/config/ConfigManager.hpp"
 #include "core/platform/Platform.hpp"
 #include "network/GameServicesInfo.hpp"
+#include "network/NetworkTrace.hpp"
+#include "wine/LaunchProfile.hpp"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -23,6 +27,12 @@
 #include <QFileDialog>
 #include <QDialogButtonBox>
 #include <QMessageBox>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QDateTime>
+#include <QLocale>
+#include <QJsonObject>
+#include <QTimer>
 
 #include <spdlog/spdlog.h>
 
@@ -38,6 +48,10 @@ public:
     QComboBox* clientTypeCombo = nullptr;
     QComboBox* localeCombo = nullptr;
     QCheckBox* highResCheck = nullptr;
+    QCheckBox* sortByLatencyCheck = nullptr;
+    QCheckBox* autoSelectWorldCheck = nullptr;
+    QCheckBox* prewarmCheck = nullptr;
+    QCheckBox* startupScriptsCheck = nullptr;
     
 #ifdef PLATFORM_LINUX
     // Wine settings
@@ -47,9 +61,18 @@ public:
     QCheckBox* dxvkCheck = nullptr;
     QCheckBox* esyncCheck = nullptr;
     QCheckBox* fsyncCheck = nullptr;
+    QCheckBox* warmStartCheck = nullptr;
+    QComboBox* launchProfileCombo = nullptr;
     QCheckBox* steamIntegrationCheck = nullptr;
 #endif
     
+    // Network trace
+    QTableWidget* networkTable = nullptr;
+    
+    // Metrics
+    QTableWidget* metricsTable = nullptr;
+    QTimer* metricsTimer = nullptr;
+    
     QDialogButtonBox* buttonBox = nullptr;
 };
 
@@ -122,7 +145,35 @@ void SettingsWindow::setupUi() {
     m_impl->highResCheck->setChecked(true);
     clientLayout->addRow("", m_impl->highResCheck);
     
+    m_impl->prewarmCheck = new QCheckBox("Preload game data before launch");
+    m_impl->prewarmCheck->setToolTip(
+        "Reads the parts of the game data recent sessions used into memory first,\n"
+        "so loading into the world is faster. Takes effect after one session.");
+    clientLayout->addRow("", m_impl->prewarmCheck);
+    
+    m_impl->startupScriptsCheck = new QCheckBox("Run plugin startup scripts");
+    m_impl->startupScriptsCheck->setToolTip(
+        "Runs the Python startup scripts that installed plugins declare, each time\n"
+        "the game is launched. Only enable this for plugins you trust.");
+    clientLayout->addRow("", m_impl->startupScriptsCheck);
+    
     gameLayout->addWidget(clientGroup);
+    
+    // Server list
+    QGroupBox* serversGroup = new QGroupBox("Servers");
+    QVBoxLayout* serversLayout = new QVBoxLayout(serversGroup);
+    
+    m_impl->sortByLatencyCheck = new QCheckBox("Sort servers by latency");
+    m_impl->sortByLatencyCheck->setToolTip(
+        "List the servers that respond fastest from here first");
+    serversLayout->addWidget(m_impl->sortByLatencyCheck);
+    
+    m_impl->autoSelectWorldCheck = new QCheckBox("Select the fastest server for new accounts");
+    m_impl->autoSelectWorldCheck->setToolTip(
+        "Accounts that have not played on any server yet start on the one with the lowest latency");
+    serversLayout->addWidget(m_impl->autoSelectWorldCheck);
+    
+    gameLayout->addWidget(serversGroup);
     gameLayout->addStretch();
     
     tabs->addTab(gameTab, "Game");
@@ -180,6 +231,25 @@ void SettingsWindow::setupUi() {
     m_impl->fsyncCheck->setChecked(true);
     wineOptionsLayout->addWidget(m_impl->fsyncCheck);
     
+    m_impl->warmStartCheck = new QCheckBox("Start wineserver when the launcher opens");
+    m_impl->warmStartCheck->setChecked(true);
+    m_impl->warmStartCheck->setToolTip(
+        "Keeps the Wine prefix's server running so the game starts faster.\n"
+        "Only applies to a user-provided Wine; takes effect on the next start.");
+    wineOptionsLayout->addWidget(m_impl->warmStartCheck);
+    
+    QHBoxLayout* profileLayout = new QHBoxLayout();
+    profileLayout->addWidget(new QLabel("Launch profile:"));
+    m_impl->launchProfileCombo = new QComboBox();
+    for (const auto& profile : LaunchProfile::builtin()) {
+        QString name = QString::fromStdString(profile.name);
+        m_impl->launchProfileCombo->addItem(name, name);
+        m_impl->launchProfileCombo->setItemData(m_impl->launchProfileCombo->count() - 1,
+            QString::fromStdString(profile.description), Qt::ToolTipRole);
+    }
+    profileLayout->addWidget(m_impl->launchProfileCombo, 1);
+    wineOptionsLayout->addLayout(profileLayout);
+    
     wineLayout->addWidget(wineOptionsGroup);
     
     // Steam integration
@@ -217,7 +287,7 @@ void SettingsWindow::setupUi() {
     
     QPushButton* checkUpdatesBtn = new QPushButton("Check for Updates");
     checkUpdatesBtn->setFixedWidth(180);
-    connect(checkUpdatesBtn, &QPushButton::clicked, this, [this]() {
+    connect(checkUpdatesBtn, &QPushButton::clicked, this, [this, checkUpdatesBtn]() {
         // Get game config for path
         auto& configManager = ConfigManager::instance();
         auto gameConfig = configManager.getGameConfig(m_impl->gameId.toStdString());
@@ -228,18 +298,20 @@ void SettingsWindow::setupUi() {
         
         // Get patch server URL from services info
         QString datacenterUrl = getDatacenterUrl(m_impl->gameId);
-        auto future = fetchGameServicesInfo(datacenterUrl, m_impl->gameId);
-        future.waitForFinished();
-        auto servicesInfo = future.result();
-        if (!servicesInfo) {
-            QMessageBox::warning(this, "Error", "Could not get patch server info");
-            return;
-        }
-        
-        PatchDialog dialog(gameConfig->gameDirectory, servicesInfo->patchServer, 
-                           servicesInfo->launcherConfigUrl, gameConfig->highResEnabled,
-                           QString::fromStdString(gameConfig->locale), this);
-        dialog.startPatching();
+        checkUpdatesBtn->setEnabled(false);
+        TaskScheduler::then(fetchGameServicesInfo(datacenterUrl, m_impl->gameId), this,
+            [this, checkUpdatesBtn, gameConfig](const std::optional<GameServicesInfo>& servicesInfo) {
+                checkUpdatesBtn->setEnabled(true);
+                if (!servicesInfo) {
+                    QMessageBox::warning(this, "Error", "Could not get patch server info");
+                    return;
+                }
+                
+                PatchDialog dialog(gameConfig->gameDirectory, servicesInfo->patchServer, 
+                                   servicesInfo->launcherConfigUrl, gameConfig->highResEnabled,
+                                   QString::fromStdString(gameConfig->locale), this);
+                dialog.startPatching();
+            });
     });
     updateLayout->addWidget(checkUpdatesBtn);
     
@@ -253,7 +325,7 @@ void SettingsWindow::setupUi() {
     
     QPushButton* repairBtn = new QPushButton("Repair Game");
     repairBtn->setFixedWidth(180);
-    connect(repairBtn, &QPushButton::clicked, this, [this]() {
+    connect(repairBtn, &QPushButton::clicked, this, [this, repairBtn]() {
         // Get game config for path
         auto& configManager = ConfigManager::instance();
         auto gameConfig = configManager.getGameConfig(m_impl->gameId.toStdString());
@@ -287,28 +359,135 @@ void SettingsWindow::setupUi() {
         
         // Now run patcher
         QString datacenterUrl = getDatacenterUrl(m_impl->gameId);
-        auto future = fetchGameServicesInfo(datacenterUrl, m_impl->gameId);
-        future.waitForFinished();
-        auto servicesInfo = future.result();
-        if (!servicesInfo) {
-            QMessageBox::warning(this, "Error", "Could not get patch server info");
+        repairBtn->setEnabled(false);
+        TaskScheduler::then(fetchGameServicesInfo(datacenterUrl, m_impl->gameId), this,
+            [this, repairBtn, gameConfig](const std::optional<GameServicesInfo>& servicesInfo) {
+                repairBtn->setEnabled(true);
+                if (!servicesInfo) {
+                    QMessageBox::warning(this, "Error", "Could not get patch server info");
+                    return;
+                }
+                
+                PatchDialog dialog(gameConfig->gameDirectory, servicesInfo->patchServer,
+                                   servicesInfo->launcherConfigUrl, gameConfig->highResEnabled,
+                                   QString::fromStdString(gameConfig->locale), this);
+                if (dialog.startPatching()) {
+                    QMessageBox::information(this, "Repair Complete", "Game files have been repaired");
+                }
+            });
+    });
+    repairLayout->addWidget(repairBtn);
+    
+    QPushButton* verifyBtn = new QPushButton("Verify Game Data");
+    verifyBtn->setFixedWidth(180);
+    verifyBtn->setToolTip("Check every DAT file entry without launching the game");
+    connect(verifyBtn, &QPushButton::clicked, this, [this]() {
+        auto& configManager = ConfigManager::instance();
+        auto gameConfig = configManager.getGameConfig(m_impl->gameId.toStdString());
+        if (!gameConfig) {
+            QMessageBox::warning(this, "Error", "Game not configured");
             return;
         }
         
-        PatchDialog dialog(gameConfig->gameDirectory, servicesInfo->patchServer,
-                           servicesInfo->launcherConfigUrl, gameConfig->highResEnabled,
+        PatchDialog dialog(gameConfig->gameDirectory, QString(), QString(),
+                           gameConfig->highResEnabled,
                            QString::fromStdString(gameConfig->locale), this);
-        if (dialog.startPatching()) {
-            QMessageBox::information(this, "Repair Complete", "Game files have been repaired");
-        }
+        dialog.startVerification();
     });
-    repairLayout->addWidget(repairBtn);
+    repairLayout->addWidget(verifyBtn);
     
     maintenanceLayout->addWidget(repairGroup);
     maintenanceLayout->addStretch();
     
     tabs->addTab(maintenanceTab, "Maintenance");
     
+    // Network tab
+    QWidget* networkTab = new QWidget();
+    QVBoxLayout* networkLayout = new QVBoxLayout(networkTab);
+    
+    QLabel* networkLabel = new QLabel(
+        "Recent requests and where their time went, in milliseconds. "
+        "Connect includes the DNS lookup and TLS handshake.");
+    networkLabel->setWordWrap(true);
+    networkLayout->addWidget(networkLabel);
+    
+    m_impl->networkTable = new QTableWidget(0, 11);
+    m_impl->networkTable->setHorizontalHeaderLabels({
+        "Time", "Source", "Request", "Status", "Queued", "Connect",
+        "Send", "Wait", "Receive", "Total", "Size"});
+    m_impl->networkTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_impl->networkTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_impl->networkTable->verticalHeader()->setVisible(false);
+    m_impl->networkTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
+    networkLayout->addWidget(m_impl->networkTable);
+    
+    QHBoxLayout* networkButtons = new QHBoxLayout();
+    QPushButton* refreshTraceBtn = new QPushButton("Refresh");
+    connect(refreshTraceBtn, &QPushButton::clicked, this, &SettingsWindow::updateNetworkTrace);
+    networkButtons->addWidget(refreshTraceBtn);
+    
+    QPushButton* clearTraceBtn = new QPushButton("Clear");
+    connect(clearTraceBtn, &QPushButton::clicked, this, [this]() {
+        NetworkTrace::instance().clear();
+        updateNetworkTrace();
+    });
+    networkButtons->addWidget(clearTraceBtn);
+    networkButtons->addStretch();
+    
+    QPushButton* exportTraceBtn = new QPushButton("Export HAR...");
+    connect(exportTraceBtn, &QPushButton::clicked, this, [this]() {
+        const QString path = QFileDialog::getSaveFileName(this, "Export Network Trace",
+            QString("lotro-launcher-%1.har").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")),
+            "HTTP Archive (*.har)");
+        if (!path.isEmpty() && !NetworkTrace::instance().exportHar(path)) {
+            QMessageBox::warning(this, "Export Failed", "Could not write " + path);
+        }
+    });
+    networkButtons->addWidget(exportTraceBtn);
+    networkLayout->addLayout(networkButtons);
+    
+    tabs->addTab(networkTab, "Network");
+    
+    // Metrics tab
+    QWidget* metricsTab = new QWidget();
+    QVBoxLayout* metricsLayout = new QVBoxLayout(metricsTab);
+    
+    QLabel* metricsLabel = new QLabel(
+        QString("Counters, gauges and timings since the launcher started. Times are in the "
+                "unit their name ends with; percentiles are within about 6%. Also written "
+                "to %1 every minute.").arg(metrics::Registry::dumpPath()));
+    metricsLabel->setWordWrap(true);
+    metricsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    metricsLayout->addWidget(metricsLabel);
+    
+    m_impl->metricsTable = new QTableWidget(0, 7);
+    m_impl->metricsTable->setHorizontalHeaderLabels({
+        "Metric", "Value", "Mean", "p50", "p90", "p99", "Max"});
+    m_impl->metricsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_impl->metricsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_impl->metricsTable->verticalHeader()->setVisible(false);
+    m_impl->metricsTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    metricsLayout->addWidget(m_impl->metricsTable);
+    
+    tabs->addTab(metricsTab, "Metrics");
+    
+    // Live while the tab is showing, idle otherwise
+    m_impl->metricsTimer = new QTimer(this);
+    m_impl->metricsTimer->setInterval(METRICS_REFRESH_MS);
+    connect(m_impl->metricsTimer, &QTimer::timeout, this, &SettingsWindow::updateMetrics);
+    
+    connect(tabs, &QTabWidget::currentChanged, this, [this, tabs, networkTab, metricsTab](int index) {
+        if (tabs->widget(index) == networkTab) {
+            updateNetworkTrace();
+        }
+        if (tabs->widget(index) == metricsTab) {
+            updateMetrics();
+            m_impl->metricsTimer->start();
+        } else {
+            m_impl->metricsTimer->stop();
+        }
+    });
+    
     // Buttons
     m_impl->buttonBox = new QDialogButtonBox(
         QDialogButtonBox::Ok | QDialogButtonBox::Cancel | QDialogButtonBox::Apply);
@@ -347,6 +526,11 @@ void SettingsWindow::loadSettings() {
         m_impl->highResCheck->setChecked(gameConfig->highResEnabled);
     }
     
+    m_impl->sortByLatencyCheck->setChecked(configManager.programConfig().sortWorldsByLatency);
+    m_impl->autoSelectWorldCheck->setChecked(configManager.programConfig().autoSelectFastestWorld);
+    m_impl->prewarmCheck->setChecked(configManager.programConfig().prewarmDatFiles);
+    m_impl->startupScriptsCheck->setChecked(configManager.programConfig().runStartupScripts);
+    
 #ifdef PLATFORM_LINUX
     auto wineConfig = configManager.getWineConfig(m_impl->gameId.toStdString());
     if (wineConfig) {
@@ -357,12 +541,16 @@ void SettingsWindow::loadSettings() {
         m_impl->dxvkCheck->setChecked(wineConfig->dxvkEnabled);
         m_impl->esyncCheck->setChecked(wineConfig->esyncEnabled);
         m_impl->fsyncCheck->setChecked(wineConfig->fsyncEnabled);
+        int profileIndex = m_impl->launchProfileCombo->findData(
+            QString::fromStdString(wineConfig->launchProfile));
+        m_impl->launchProfileCombo->setCurrentIndex(profileIndex >= 0 ? profileIndex : 0);
     }
     updateWineSection();
     
     // Steam integration setting (global, not per-game)
     auto& programConfig = configManager.programConfig();
     m_impl->steamIntegrationCheck->setChecked(programConfig.steamIntegrationEnabled);
+    m_impl->warmStartCheck->setChecked(programConfig.wineserverWarmStart);
 #endif
 }
 
@@ -384,6 +572,15 @@ void SettingsWindow::saveSettings() {
     
     configManager.setGameConfig(m_impl->gameId.toStdString(), gameConfig);
     
+    {
+        auto programConfig = configManager.programConfig();
+        programConfig.sortWorldsByLatency = m_impl->sortByLatencyCheck->isChecked();
+        programConfig.autoSelectFastestWorld = m_impl->autoSelectWorldCheck->isChecked();
+        programConfig.prewarmDatFiles = m_impl->prewarmCheck->isChecked();
+        programConfig.runStartupScripts = m_impl->startupScriptsCheck->isChecked();
+        configManager.setProgramConfig(programConfig);
+    }
+    
 #ifdef PLATFORM_LINUX
     WineConfig wineConfig;
     wineConfig.prefixMode = m_impl->wineModeCombo->currentIndex() == 0 ? 
@@ -393,21 +590,96 @@ void SettingsWindow::saveSettings() {
     wineConfig.dxvkEnabled = m_impl->dxvkCheck->isChecked();
     wineConfig.esyncEnabled = m_impl->esyncCheck->isChecked();
     wineConfig.fsyncEnabled = m_impl->fsyncCheck->isChecked();
+    wineConfig.launchProfile = m_impl->launchProfileCombo->currentData().toString().toStdString();
     
     configManager.setWineConfig(m_impl->gameId.toStdString(), wineConfig);
     
     // Steam integration setting (global)
     auto programConfig = configManager.programConfig();
     programConfig.steamIntegrationEnabled = m_impl->steamIntegrationCheck->isChecked();
+    programConfig.wineserverWarmStart = m_impl->warmStartCheck->isChecked();
     configManager.setProgramConfig(programConfig);
 #endif
     
-    configManager.save();
     emit settingsChanged();
     
     spdlog::info("Settings saved");
 }
 
+void SettingsWindow::updateNetworkTrace() {
+    const auto entries = NetworkTrace::instance().entries();
+    QTableWidget* table = m_impl->networkTable;
+    table->setRowCount(static_cast<int>(entries.size()));
+    
+    auto phase = [](qint64 ms) {
+        return new QTableWidgetItem(ms >= 0 ? QString::number(ms) : QString("-"));
+    };
+    
+    // Newest first
+    int row = 0;
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it, ++row) {
+        const NetworkTraceEntry& entry = *it;
+        table->setItem(row, 0, new QTableWidgetItem(
+            QDateTime::fromMSecsSinceEpoch(entry.startedAt).toString("HH:mm:ss.zzz")));
+        table->setItem(row, 1, new QTableWidgetItem(entry.source));
+        
+        auto* request = new QTableWidgetItem(
+            QString("%1 %2").arg(QString::fromLatin1(entry.method), entry.url.toDisplayString()));
+        request->setToolTip(entry.error.isEmpty() ? entry.url.toDisplayString() : entry.error);
+        table->setItem(row, 2, request);
+        
+        table->setItem(row, 3, new QTableWidgetItem(
+            entry.error.isEmpty() ? QString::number(entry.status) : QString("Error")));
+        table->setItem(row, 4, phase(entry.blocked));
+        table->setItem(row, 5, phase(entry.reusedConnection ? -1 : entry.connect));
+        table->setItem(row, 6, phase(entry.send));
+        table->setItem(row, 7, phase(entry.wait));
+        table->setItem(row, 8, phase(entry.receive));
+        table->setItem(row, 9, phase(entry.total));
+        table->setItem(row, 10, new QTableWidgetItem(
+            QLocale().formattedDataSize(entry.responseBytes)));
+    }
+    table->resizeColumnsToContents();
+    table->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
+}
+
+void SettingsWindow::updateMetrics() {
+    const QJsonObject snapshot = metrics::Registry::instance().snapshot();
+    const QJsonObject counters = snapshot.value("counters").toObject();
+    const QJsonObject gauges = snapshot.value("gauges").toObject();
+    const QJsonObject histograms = snapshot.value("histograms").toObject();
+    
+    QTableWidget* table = m_impl->metricsTable;
+    table->setRowCount(counters.size() + gauges.size() + histograms.size());
+    
+    auto number = [](const QJsonValue& value) {
+        auto* item = new QTableWidgetItem(QLocale().toString(value.toInteger()));
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    };
+    
+    int row = 0;
+    for (const QJsonObject& values : {counters, gauges}) {
+        for (auto it = values.begin(); it != values.end(); ++it, ++row) {
+            table->setItem(row, 0, new QTableWidgetItem(it.key()));
+            table->setItem(row, 1, number(it.value()));
+            for (int column = 2; column < table->columnCount(); ++column) {
+                table->setItem(row, column, new QTableWidgetItem());
+            }
+        }
+    }
+    for (auto it = histograms.begin(); it != histograms.end(); ++it, ++row) {
+        const QJsonObject histogram = it.value().toObject();
+        table->setItem(row, 0, new QTableWidgetItem(it.key()));
+        table->setItem(row, 1, number(histogram.value("count")));
+        table->setItem(row, 2, number(qRound64(histogram.value("mean").toDouble())));
+        table->setItem(row, 3, number(histogram.value("p50")));
+        table->setItem(row, 4, number(histogram.value("p90")));
+        table->setItem(row, 5, number(histogram.value("p99")));
+        table->setItem(row, 6, number(histogram.value("max")));
+    }
+}
+
 void SettingsWindow::browseGameDirectory() {
     QString dir = QFileDialog::getExistingDirectory(this, "Select Game Directory",
         m_impl->gamePathEdit->text());
@@ -471,6 +743,8 @@ void SettingsWindow::resetToDefaults() {
     m_impl->clientTypeCombo->setCurrentIndex(0);
     m_impl->localeCombo->setCurrentIndex(0);
     m_impl->highResCheck->setChecked(true);
+    m_impl->prewarmCheck->setChecked(false);
+    m_impl->startupScriptsCheck->setChecked(false);
     
 #ifdef PLATFORM_LINUX
     m_impl->wineModeCombo->setCurrentIndex(0);
@@ -479,6 +753,8 @@ void SettingsWindow::resetToDefaults() {
     m_impl->dxvkCheck->setChecked(true);
     m_impl->esyncCheck->setChecked(true);
     m_impl->fsyncCheck->setChecked(true);
+    m_impl->warmStartCheck->setChecked(true);
+    m_impl->launchProfileCombo->setCurrentIndex(0);
 #endif
 }
 
@@ -95,12 +95,16 @@ private:
     void setupUi();
     void loadSettings();
     void saveSettings();
+    void updateNetworkTrace();
+    void updateMetrics();
 #ifdef PLATFORM_LINUX
     void updateWineSection();
 #endif
     
     class Impl;
     std::unique_ptr<Impl> m_impl;
+    
+    static constexpr int METRICS_REFRESH_MS = 1000;
 };
 
 } // namespace lotro
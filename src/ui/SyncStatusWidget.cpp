@@ -13,6 +13,8 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QCheckBox>
+#include <QFileDialog>
+#include <QMessageBox>
 
 namespace lotro {
 
@@ -53,6 +55,19 @@ void SyncStatusWidget::setupUi() {
     m_autoSaveCheck->setChecked(true);
     m_autoSaveCheck->setEnabled(false);  // Always enabled for now
     mainLayout->addWidget(m_autoSaveCheck);
+    
+    // Sync cost
+    auto* metricsRow = new QHBoxLayout();
+    m_metricsLabel = new QLabel(tr("No syncs yet"));
+    m_metricsLabel->setStyleSheet("color: #666; font-size: 11px;");
+    metricsRow->addWidget(m_metricsLabel, 1);
+    
+    m_exportMetricsButton = new QPushButton(tr("Export Timings..."));
+    m_exportMetricsButton->setEnabled(false);
+    connect(m_exportMetricsButton, &QPushButton::clicked, this, &SyncStatusWidget::exportMetrics);
+    metricsRow->addWidget(m_exportMetricsButton);
+    
+    mainLayout->addLayout(metricsRow);
 }
 
 void SyncStatusWidget::setSyncService(LiveSyncService* service) {
@@ -69,6 +84,8 @@ void SyncStatusWidget::setSyncService(LiveSyncService* service) {
                 this, &SyncStatusWidget::onCharacterUpdated);
         connect(m_syncService, &LiveSyncService::statusChanged,
                 this, &SyncStatusWidget::onStatusChanged);
+        connect(m_syncService, &LiveSyncService::metricsUpdated,
+                this, &SyncStatusWidget::onMetricsUpdated);
         
         // Update initial state
         updateIndicator(m_syncService->isConnected());
@@ -97,6 +114,27 @@ void SyncStatusWidget::onStatusChanged(const QString& status) {
     m_statusLabel->setText(status);
 }
 
+void SyncStatusWidget::onMetricsUpdated() {
+    m_metricsLabel->setText(SyncMetrics::summary(m_syncService->metrics().snapshot()));
+    m_exportMetricsButton->setEnabled(true);
+}
+
+void SyncStatusWidget::exportMetrics() {
+    if (!m_syncService) {
+        return;
+    }
+    
+    QString path = QFileDialog::getSaveFileName(this, tr("Export Sync Timings"),
+                                                "sync-metrics.json", tr("JSON (*.json)"));
+    if (path.isEmpty()) {
+        return;
+    }
+    
+    if (!m_syncService->metrics().saveJson(path)) {
+        QMessageBox::warning(this, tr("Export Failed"), tr("Could not write %1").arg(path));
+    }
+}
+
 void SyncStatusWidget::onSyncStopped() {
     m_characterLabel->setText(tr("No character"));
     m_characterLabel->setStyleSheet("color: #666; font-style: italic;");
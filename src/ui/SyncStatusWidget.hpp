@@ -44,6 +44,8 @@ private slots:
     void onConnectionChanged(bool connected);
     void onCharacterUpdated(const CharacterInfo& info);
     void onStatusChanged(const QString& status);
+    void onMetricsUpdated();
+    void exportMetrics();
 
 private:
     void setupUi();
@@ -55,6 +57,8 @@ private:
     QLabel* m_statusLabel = nullptr;
     QLabel* m_characterLabel = nullptr;
     QCheckBox* m_autoSaveCheck = nullptr;
+    QLabel* m_metricsLabel = nullptr;
+    QPushButton* m_exportMetricsButton = nullptr;
 };
 
 } // namespace lotro
@@ -0,0 +1,57 @@
+/**
+ * LOTRO Launcher - Launch Profile Implementation (Linux only)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef PLATFORM_LINUX
+
+#include "LaunchProfile.hpp"
+
+namespace lotro {
+
+const std::vector<LaunchProfile>& LaunchProfile::builtin() {
+    static const std::vector<LaunchProfile> profiles = [] {
+        LaunchProfile standard;
+        standard.name = DEFAULT_NAME;
+        standard.description = "No tuning beyond esync and fsync";
+
+        LaunchProfile performance;
+        performance.name = "Performance";
+        performance.description = "gamemode, huge pages and the lowest input latency";
+        performance.hugePages = true;
+        performance.dxvkMaxFrameLatency = 1;
+        performance.gamemode = true;
+
+        LaunchProfile lowEnd;
+        lowEnd.name = "Low-end";
+        lowEnd.description = "gamemode and a 60 FPS cap for even frame pacing on slower machines";
+        lowEnd.hugePages = true;
+        lowEnd.dxvkFrameRate = 60;
+        lowEnd.dxvkMaxFrameLatency = 1;
+        lowEnd.gamemode = true;
+
+        LaunchProfile background;
+        background.name = "Background";
+        background.description = "Four CPUs, low priority and 30 FPS, for extra clients and idling";
+        background.cpuLimit = 4;
+        background.niceLevel = 10;
+        background.dxvkFrameRate = 30;
+
+        return std::vector<LaunchProfile>{standard, performance, lowEnd, background};
+    }();
+    return profiles;
+}
+
+std::optional<LaunchProfile> LaunchProfile::find(const std::string& name) {
+    for (const auto& profile : builtin()) {
+        if (profile.name == name) {
+            return profile;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace lotro
+
+#endif // PLATFORM_LINUX
@@ -0,0 +1,51 @@
+/**
+ * LOTRO Launcher - Launch Profile (Linux only)
+ *
+ * Named sets of performance settings for the game process.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#ifdef PLATFORM_LINUX
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lotro {
+
+/**
+ * Performance settings applied to the game process as one unit
+ *
+ * CPU limits and priority are applied by wrapping the Wine command in
+ * taskset and nice, gamemode by gamemoderun; the rest are environment
+ * variables read by Wine, glibc and DXVK. Wrappers that aren't installed
+ * are left out with a warning rather than failing the launch.
+ */
+struct LaunchProfile {
+    std::string name;
+    std::string description;
+
+    int cpuLimit = 0;                   // Run on the first N CPUs and report N to the game; 0 for all
+    int niceLevel = 0;                  // Scheduling priority; raising it needs no privileges
+    bool largeAddressAware = true;      // WINE_LARGE_ADDRESS_AWARE for the 32-bit client
+    bool hugePages = false;             // Transparent huge pages for malloc (glibc 2.35+)
+    int dxvkFrameRate = 0;              // DXVK frame rate cap, 0 for none
+    int dxvkMaxFrameLatency = 0;        // Frames queued ahead of the GPU, 0 for DXVK's default
+    bool gamemode = false;              // Run under Feral gamemode
+
+    static const std::vector<LaunchProfile>& builtin();
+
+    /**
+     * A built-in profile by name, nullopt if there is none
+     */
+    static std::optional<LaunchProfile> find(const std::string& name);
+
+    static constexpr const char* DEFAULT_NAME = "Default";
+};
+
+} // namespace lotro
+
+#endif // PLATFORM_LINUX
@@ -0,0 +1,201 @@
+/**
+ * LOTRO Launcher - Shader Cache Implementation (Linux only)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef PLATFORM_LINUX
+
+#include "ShaderCache.hpp"
+#include "WineProcessBuilder.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QCryptographicHash>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace lotro {
+
+namespace {
+
+std::string readSmallFile(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+bool isStateCache(const std::filesystem::path& path) {
+    const auto name = path.filename().string();
+    return path.extension() == ".dxvk-cache" || name.rfind("vkd3d-proton.cache", 0) == 0;
+}
+
+uint64_t directorySize(const std::filesystem::path& directory, size_t* files = nullptr) {
+    uint64_t bytes = 0;
+    std::error_code error;
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, error);
+         !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (it->is_regular_file(error)) {
+            bytes += it->file_size(error);
+            if (files) {
+                ++*files;
+            }
+        }
+    }
+    return bytes;
+}
+
+} // anonymous namespace
+
+ShaderCache::ShaderCache(std::filesystem::path root)
+    : m_root(std::move(root))
+{
+}
+
+std::filesystem::path ShaderCache::defaultRoot() {
+    return Platform::getCachePath() / "shadercache";
+}
+
+std::string ShaderCache::deviceKey() {
+    static const std::string key = [] {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        auto add = [&hash](const std::string& value) {
+            hash.addData(QByteArrayView(value.data(), static_cast<qsizetype>(value.size())));
+            hash.addData(QByteArrayView("\n"));
+        };
+        std::error_code error;
+
+        // One entry per GPU: PCI vendor and device, and the kernel driver
+        std::vector<std::string> gpus;
+        for (const auto& entry : std::filesystem::directory_iterator("/sys/class/drm", error)) {
+            const auto name = entry.path().filename().string();
+            if (name.rfind("card", 0) != 0 || name.find('-') != std::string::npos) {
+                continue;
+            }
+            const auto device = entry.path() / "device";
+            std::error_code linkError;
+            const auto driver = std::filesystem::read_symlink(device / "driver", linkError);
+            gpus.push_back(readSmallFile(device / "vendor") + readSmallFile(device / "device") +
+                           driver.filename().string());
+        }
+
+        // Driver builds. Mesa and other userspace drivers have no version
+        // to read without loading them, but their ICD manifests are
+        // rewritten by every package update
+        std::vector<std::string> drivers;
+        for (const char* icdDir : {"/usr/share/vulkan/icd.d", "/etc/vulkan/icd.d"}) {
+            for (const auto& entry : std::filesystem::directory_iterator(icdDir, error)) {
+                std::error_code timeError;
+                const auto mtime = std::filesystem::last_write_time(entry.path(), timeError);
+                drivers.push_back(entry.path().string() + "@" +
+                                  std::to_string(mtime.time_since_epoch().count()));
+            }
+        }
+
+        std::sort(gpus.begin(), gpus.end());
+        std::sort(drivers.begin(), drivers.end());
+        for (const auto& value : gpus) add(value);
+        for (const auto& value : drivers) add(value);
+        add(readSmallFile("/proc/driver/nvidia/version"));
+        add(readSmallFile("/proc/sys/kernel/osrelease"));
+
+        return hash.result().toHex().left(16).toStdString();
+    }();
+    return key;
+}
+
+void ShaderCache::prepare(const std::vector<std::filesystem::path>& importFrom) {
+    std::error_code error;
+    for (const auto& directory : {statePath(), driverPath()}) {
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            break;
+        }
+    }
+    if (error) {
+        spdlog::warn("Can't create shader cache in {}: {}", m_root.string(), error.message());
+        return;
+    }
+
+    prune();
+    for (const auto& directory : importFrom) {
+        import(directory);
+    }
+
+    const auto current = usage();
+    spdlog::info("Shader cache: {} files, {} KB pipeline state, {} KB driver shaders for GPU {}",
+                 current.files, current.stateBytes / 1024, current.driverBytes / 1024, deviceKey());
+}
+
+uint64_t ShaderCache::prune() {
+    uint64_t freed = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_root / "driver", error)) {
+        if (entry.path().filename() == deviceKey()) {
+            continue;
+        }
+        freed += directorySize(entry.path());
+        std::filesystem::remove_all(entry.path(), error);
+        if (error) {
+            spdlog::warn("Can't remove stale shader cache {}: {}", entry.path().string(), error.message());
+        }
+    }
+    if (freed > 0) {
+        spdlog::info("GPU or driver changed, removed {} KB of stale driver shaders", freed / 1024);
+    }
+    return freed;
+}
+
+size_t ShaderCache::import(const std::filesystem::path& directory) {
+    size_t imported = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (!entry.is_regular_file() || !isStateCache(entry.path())) {
+            continue;
+        }
+        const auto target = statePath() / entry.path().filename();
+        std::error_code sizeError;
+        const auto existing = std::filesystem::file_size(target, sizeError);
+        if (!sizeError && existing >= entry.file_size()) {
+            continue;
+        }
+        std::error_code copyError;
+        std::filesystem::copy_file(entry.path(), target,
+                                   std::filesystem::copy_options::overwrite_existing, copyError);
+        if (copyError) {
+            spdlog::warn("Can't import shader cache {}: {}", entry.path().string(), copyError.message());
+            continue;
+        }
+        ++imported;
+    }
+    if (imported > 0) {
+        spdlog::info("Imported {} shader state caches from {}", imported, directory.string());
+    }
+    return imported;
+}
+
+ShaderCache::Usage ShaderCache::usage() const {
+    Usage result;
+    result.stateBytes = directorySize(statePath(), &result.files);
+    result.driverBytes = directorySize(driverPath(), &result.files);
+    return result;
+}
+
+void ShaderCache::applyTo(WineProcessBuilder& builder) const {
+    const auto state = statePath().string();
+    const auto driver = driverPath().string();
+    builder.setEnvironment("DXVK_STATE_CACHE_PATH", state)
+           .setEnvironment("VKD3D_SHADER_CACHE_PATH", state)
+           .setEnvironment("MESA_SHADER_CACHE_DIR", driver)
+           .setEnvironment("__GL_SHADER_DISK_CACHE", "1")
+           .setEnvironment("__GL_SHADER_DISK_CACHE_PATH", driver)
+           .setEnvironment("__GL_SHADER_DISK_CACHE_SKIP_CLEANUP", "1");
+}
+
+} // namespace lotro
+
+#endif // PLATFORM_LINUX
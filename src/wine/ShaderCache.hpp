@@ -0,0 +1,101 @@
+/**
+ * LOTRO Launcher - Shader Cache (Linux only)
+ *
+ * Launcher-managed DXVK/VKD3D state caches and GPU driver shader caches.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#ifdef PLATFORM_LINUX
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace lotro {
+
+class WineProcessBuilder;
+
+/**
+ * Shader caches kept in the launcher's cache directory
+ *
+ * Two kinds of cache are kept apart because they age differently:
+ *
+ * - state/ holds DXVK and VKD3D-Proton pipeline state caches. They
+ *   describe the game's pipelines, not compiled code, so they stay valid
+ *   across GPUs and drivers and are shared by every prefix. DXVK
+ *   compiles the pipelines they list in the background while the game
+ *   starts, which is what takes the stutter out of the first minutes.
+ * - driver/<key>/ holds the GPU driver's own compiled shaders (Mesa and
+ *   NVIDIA). Those are only good for the GPU and driver build that made
+ *   them, so the directory is keyed by a fingerprint of both and the
+ *   other keys are deleted once a driver update changes it.
+ *
+ * Caches DXVK wrote elsewhere before, next to the game or in Steam's
+ * shader cache, are imported into state/ keeping the larger copy of each
+ * file. DXVK can't merge two state caches entry by entry, so the larger
+ * one is taken as the more complete.
+ */
+class ShaderCache {
+public:
+    struct Usage {
+        uint64_t stateBytes = 0;
+        uint64_t driverBytes = 0;
+        size_t files = 0;
+    };
+
+    explicit ShaderCache(std::filesystem::path root = defaultRoot());
+
+    static std::filesystem::path defaultRoot();
+
+    /**
+     * Fingerprint of the GPUs and their driver builds
+     *
+     * Taken from the DRM devices' PCI IDs and kernel drivers, the NVIDIA
+     * driver version, the kernel release and the Vulkan ICD manifests,
+     * which are replaced whenever Mesa or another userspace driver is
+     * updated. Computed once per run.
+     */
+    static std::string deviceKey();
+
+    std::filesystem::path statePath() const { return m_root / "state"; }
+    std::filesystem::path driverPath() const { return m_root / "driver" / deviceKey(); }
+
+    /**
+     * Create the directories, prune stale driver caches and import state
+     * caches from the given directories
+     */
+    void prepare(const std::vector<std::filesystem::path>& importFrom = {});
+
+    /**
+     * Delete driver caches made for another GPU or driver build
+     *
+     * @return Bytes freed
+     */
+    uint64_t prune();
+
+    /**
+     * Copy DXVK/VKD3D state caches from a directory where the managed
+     * copy is missing or smaller
+     *
+     * @return Number of files imported
+     */
+    size_t import(const std::filesystem::path& directory);
+
+    Usage usage() const;
+
+    /**
+     * Point DXVK, VKD3D-Proton and the GPU driver at the managed caches
+     */
+    void applyTo(WineProcessBuilder& builder) const;
+
+private:
+    std::filesystem::path m_root;
+};
+
+} // namespace lotro
+
+#endif // PLATFORM_LINUX
@@ -9,23 +9,108 @@
 #ifdef PLATFORM_LINUX
 
 #include "WineManager.hpp"
+#include "ShaderCache.hpp"
 #include "WinePrefixSetup.hpp"
+#include "WineProbeCache.hpp"
 #include "WineProcessBuilder.hpp"
+#include "core/DownloadStore.hpp"
 #include "core/platform/Platform.hpp"
 
 #include <QCoreApplication>
+#include <QCryptographicHash>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QProcess>
 #include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QtConcurrent>
 
+#include <atomic>
+#include <cstdio>
 #include <fstream>
 #include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <spdlog/spdlog.h>
 
 namespace lotro {
 
+namespace {
+
+// tar flags for an archive, by its name
+QString tarExtractFlags(const std::string &name) {
+  if (name.find(".tar.xz") != std::string::npos) {
+    return "-xJf";
+  }
+  if (name.find(".tar.gz") != std::string::npos ||
+      name.find(".tgz") != std::string::npos) {
+    return "-xzf";
+  }
+  return "-xf";
+}
+
+// Content-Length of the final response in a curl -D header dump, 0 if not
+// there yet
+size_t contentLength(const std::filesystem::path &headers) {
+  QFile file(QString::fromStdString(headers.string()));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return 0;
+  }
+  size_t length = 0;
+  for (const QByteArray &line : file.readAll().split('\n')) {
+    if (line.toLower().startsWith("content-length:")) {
+      length = line.mid(15).trimmed().toULongLong();
+    }
+  }
+  return length;
+}
+
+// An executable found on PATH or in one of the usual places. The answer
+// is cached against PATH, and a cached hit only costs a stat to confirm.
+std::filesystem::path
+findExecutable(const QString &name,
+               const std::vector<std::filesystem::path> &commonPaths) {
+  auto &cache = WineProbeCache::shared();
+  const QString key = "executable:" + name;
+  const QString stamp = qEnvironmentVariable("PATH");
+  if (auto cached = cache.get(key, stamp); cached && !cached->isEmpty()) {
+    std::filesystem::path path = cached->toStdString();
+    if (std::filesystem::exists(path)) {
+      return path;
+    }
+  }
+
+  std::filesystem::path found;
+  QString onPath = QStandardPaths::findExecutable(name);
+  if (!onPath.isEmpty()) {
+    found = onPath.toStdString();
+  } else {
+    for (const auto &path : commonPaths) {
+      if (std::filesystem::exists(path)) {
+        found = path;
+        break;
+      }
+    }
+  }
+  if (!found.empty()) {
+    spdlog::debug("Found {} at: {}", name.toStdString(), found.string());
+  }
+  cache.put(key, stamp, QString::fromStdString(found.string()));
+  return found;
+}
+
+std::filesystem::path findUmuRun() {
+  const char *home = std::getenv("HOME");
+  return findExecutable(
+      "umu-run", {"/usr/bin/umu-run", "/usr/local/bin/umu-run",
+                  std::filesystem::path(home ? home : "") / ".local/bin/umu-run"});
+}
+
+} // namespace
+
 WineManager::WineManager() {
   m_dataPath = Platform::getDataPath();
   m_cachePath = Platform::getCachePath();
@@ -46,28 +131,11 @@ void WineManager::setConfig(const WineConfig &config) {
 }
 
 bool WineManager::isUmuAvailable() {
-  // Check if umu-run is in PATH
-  QString umuPath = QStandardPaths::findExecutable("umu-run");
-  if (!umuPath.isEmpty()) {
-    spdlog::debug("Found umu-run at: {}", umuPath.toStdString());
-    return true;
-  }
-
-  // Check common installation paths
-  std::vector<std::filesystem::path> commonPaths = {
-      "/usr/bin/umu-run", "/usr/local/bin/umu-run",
-      std::filesystem::path(std::getenv("HOME") ? std::getenv("HOME") : "") /
-          ".local/bin/umu-run"};
-
-  for (const auto &path : commonPaths) {
-    if (std::filesystem::exists(path)) {
-      spdlog::debug("Found umu-run at: {}", path.string());
-      return true;
-    }
+  if (findUmuRun().empty()) {
+    spdlog::warn("umu-run not found. Please install umu-launcher.");
+    return false;
   }
-
-  spdlog::warn("umu-run not found. Please install umu-launcher.");
-  return false;
+  return true;
 }
 
 std::filesystem::path
@@ -119,6 +187,20 @@ WineManager::detectSteamPrefix(const std::filesystem::path &gameDirectory,
   std::filesystem::path compatdataPath =
       steamappsPath / "compatdata" / std::to_string(appId);
 
+  // Remembered until Proton creates or removes the prefix, which touches
+  // one of these two directories
+  const QString prefix = WineProbeCache::shared().getOrProbe(
+      "steam-prefix:" + QString::fromStdString(compatdataPath.string()),
+      WineProbeCache::fileStamp(compatdataPath) + "/" +
+          WineProbeCache::fileStamp(compatdataPath / "pfx"),
+      [&compatdataPath]() {
+        return QString::fromStdString(findProtonPrefix(compatdataPath).string());
+      });
+  return prefix.toStdString();
+}
+
+std::filesystem::path
+WineManager::findProtonPrefix(const std::filesystem::path &compatdataPath) {
   // Proton uses pfx subdirectory
   std::filesystem::path prefixPath = compatdataPath / "pfx";
   if (std::filesystem::exists(prefixPath / "drive_c")) {
@@ -155,8 +237,24 @@ bool WineManager::setup(DownloadProgressCallback progress,
     if (statusCb)
       statusCb("Found umu-run.");
 
+    // DXVK only needs the prefix to install into, so fetch it while umu-run
+    // downloads Proton and boots the prefix. Progress is reported from here
+    // once the prefix is done, as the callback drives the UI.
+    const bool prefixValid = isPrefixValid();
+    std::atomic<size_t> dxvkReceived{0};
+    std::atomic<size_t> dxvkTotal{0};
+    QFuture<bool> dxvkFetch;
+    if (m_config.dxvkEnabled && (!prefixValid || !isDxvkInstalled())) {
+      dxvkFetch = QtConcurrent::run([this, &dxvkReceived, &dxvkTotal]() {
+        return fetchDxvk([&](size_t current, size_t total) {
+          dxvkReceived = current;
+          dxvkTotal = total;
+        });
+      });
+    }
+
     // Initialize prefix if needed
-    if (!isPrefixValid()) {
+    if (!prefixValid) {
       spdlog::info("Initializing Wine prefix...");
       if (statusCb)
         statusCb("Initializing Wine prefix...");
@@ -164,6 +262,7 @@ bool WineManager::setup(DownloadProgressCallback progress,
         spdlog::error("Failed to initialize Wine prefix");
         if (statusCb)
           statusCb("Wine prefix initialization failed.");
+        dxvkFetch.waitForFinished();
         return false;
       }
     } else {
@@ -173,11 +272,17 @@ bool WineManager::setup(DownloadProgressCallback progress,
 
     // Set up DXVK if enabled (umu-run usually handles this, but we can force
     // it)
-    if (m_config.dxvkEnabled && !isDxvkInstalled()) {
+    if (dxvkFetch.isValid() && !isDxvkInstalled()) {
       spdlog::info("Setting up DXVK...");
       if (statusCb)
         statusCb("Setting up DXVK...");
-      if (!setupDxvk(progress)) {
+      while (!dxvkFetch.isFinished()) {
+        if (progress)
+          progress(dxvkReceived, dxvkTotal);
+        QCoreApplication::processEvents();
+        QThread::msleep(50);
+      }
+      if (!dxvkFetch.result() || !installDxvk()) {
         spdlog::warn("Failed to set up DXVK, continuing without it");
         if (statusCb)
           statusCb("DXVK setup failed, continuing without it.");
@@ -185,6 +290,8 @@ bool WineManager::setup(DownloadProgressCallback progress,
         if (statusCb)
           statusCb("DXVK installed successfully.");
       }
+    } else {
+      dxvkFetch.waitForFinished();
     }
   } else {
     // Validate user-provided Wine
@@ -228,22 +335,9 @@ std::filesystem::path WineManager::getWineExecutable() const {
   }
 
   // For builtin mode, return umu-run
-  QString umuPath = QStandardPaths::findExecutable("umu-run");
-  if (!umuPath.isEmpty()) {
-    return std::filesystem::path(umuPath.toStdString());
-  }
-
-  // Fallback paths
-  if (std::filesystem::exists("/usr/bin/umu-run")) {
-    return "/usr/bin/umu-run";
-  }
-
-  const char *home = std::getenv("HOME");
-  if (home) {
-    auto localPath = std::filesystem::path(home) / ".local/bin/umu-run";
-    if (std::filesystem::exists(localPath)) {
-      return localPath;
-    }
+  auto umuPath = findUmuRun();
+  if (!umuPath.empty()) {
+    return umuPath;
   }
 
   return "umu-run"; // Hope it's in PATH
@@ -258,6 +352,74 @@ std::filesystem::path WineManager::getWineServer() const {
   return {};
 }
 
+bool WineManager::isServerRunning() const {
+  // Wine names the server's socket after the prefix's device and inode
+  struct stat prefixStat {};
+  if (stat(getPrefixPath().c_str(), &prefixStat) != 0) {
+    return false;
+  }
+  char serverDir[64];
+  std::snprintf(serverDir, sizeof(serverDir), "server-%llx-%llx",
+                static_cast<unsigned long long>(prefixStat.st_dev),
+                static_cast<unsigned long long>(prefixStat.st_ino));
+  auto socket = std::filesystem::path("/tmp") /
+                (".wine-" + std::to_string(getuid())) / serverDir / "socket";
+  return std::filesystem::exists(socket);
+}
+
+bool WineManager::startWarmServer() {
+  auto server = getWineServer();
+  if (server.empty() || !std::filesystem::exists(server)) {
+    spdlog::debug("No wineserver to warm start");
+    return false;
+  }
+  if (!isPrefixValid()) {
+    spdlog::debug("Wine prefix not set up yet, not starting wineserver");
+    return false;
+  }
+
+  m_warmServerEnvironment = getWineEnvironment();
+  if (isServerRunning()) {
+    spdlog::info("wineserver already running for {}", getPrefixPath().string());
+    m_warmServer = server;
+    return true;
+  }
+
+  // -p keeps it running with no Wine processes; it forks into the
+  // background once its socket is up
+  QProcess process;
+  process.setProgram(QString::fromStdString(server.string()));
+  process.setArguments({"-p"});
+  process.setProcessEnvironment(m_warmServerEnvironment);
+  if (!process.startDetached()) {
+    spdlog::warn("Failed to start wineserver: {}",
+                 process.errorString().toStdString());
+    return false;
+  }
+
+  m_warmServer = server;
+  spdlog::info("Started persistent wineserver for {}",
+               getPrefixPath().string());
+  return true;
+}
+
+void WineManager::stopWarmServer() {
+  if (m_warmServer.empty()) {
+    return;
+  }
+
+  QProcess process;
+  process.setProcessEnvironment(m_warmServerEnvironment);
+  process.start(QString::fromStdString(m_warmServer.string()), {"-k"});
+  if (!process.waitForFinished(5000)) {
+    spdlog::warn("wineserver did not stop in time");
+  } else {
+    spdlog::info("Stopped wineserver for {}",
+                 m_warmServerEnvironment.value("WINEPREFIX").toStdString());
+  }
+  m_warmServer.clear();
+}
+
 std::filesystem::path WineManager::getPrefixPath() const {
   switch (m_config.prefixMode) {
   case WinePrefixMode::User:
@@ -275,9 +437,18 @@ std::filesystem::path WineManager::getPrefixPath() const {
 }
 
 bool WineManager::isPrefixValid() const {
+  // Creating or removing system.reg or drive_c touches the prefix
+  // directory, so its mtime tells whether the last answer still holds
   auto prefixPath = getPrefixPath();
-  return std::filesystem::exists(prefixPath / "system.reg") &&
-         std::filesystem::exists(prefixPath / "drive_c");
+  const QString valid = WineProbeCache::shared().getOrProbe(
+      "prefix:" + QString::fromStdString(prefixPath.string()),
+      WineProbeCache::fileStamp(prefixPath), [&prefixPath]() {
+        return std::filesystem::exists(prefixPath / "system.reg") &&
+                       std::filesystem::exists(prefixPath / "drive_c")
+                   ? QString("1")
+                   : QString("0");
+      });
+  return valid == "1";
 }
 
 std::filesystem::path
@@ -393,20 +564,22 @@ bool WineManager::initializePrefix(StatusCallback statusCb) {
 }
 
 bool WineManager::setupDxvk(DownloadProgressCallback progress) {
-  auto cacheFile = m_cachePath / "dxvk.tar.gz";
+  return fetchDxvk(progress) && installDxvk();
+}
+
+bool WineManager::fetchDxvk(DownloadProgressCallback progress) {
   auto dxvkPath = getDxvkCachePath();
+  if (std::filesystem::exists(dxvkPath / "x64" / "d3d11.dll")) {
+    return true;
+  }
 
   spdlog::info("Downloading DXVK from: {}", DxvkVersions::DXVK_URL);
+  return fetchAndExtract(DxvkVersions::DXVK_URL, dxvkPath.parent_path(),
+                         progress);
+}
 
-  if (!downloadFile(DxvkVersions::DXVK_URL, cacheFile, progress)) {
-    return false;
-  }
-
-  // Extract DXVK
-  std::filesystem::create_directories(dxvkPath.parent_path());
-  if (!extractArchive(cacheFile, dxvkPath.parent_path())) {
-    return false;
-  }
+bool WineManager::installDxvk() {
+  auto dxvkPath = getDxvkCachePath();
 
   // Install DLLs to prefix
   auto prefixPath = getPrefixPath();
@@ -417,35 +590,34 @@ bool WineManager::setupDxvk(DownloadProgressCallback progress) {
   std::vector<std::string> dxvkDlls = {"d3d9.dll", "d3d10core.dll", "d3d11.dll",
                                        "dxgi.dll"};
 
+  // Copies and overrides go in one batch: parallel copies, one regedit run
+  WinePrefixChanges changes;
   for (const auto &dll : dxvkDlls) {
     // 64-bit
     auto src64 = dxvkPath / "x64" / dll;
     if (std::filesystem::exists(src64)) {
-      std::filesystem::copy_file(
-          src64, system32 / dll,
-          std::filesystem::copy_options::overwrite_existing);
+      changes.installDll(src64, system32 / dll);
     }
 
     // 32-bit
     auto src32 = dxvkPath / "x32" / dll;
     if (std::filesystem::exists(src32) && std::filesystem::exists(syswow64)) {
-      std::filesystem::copy_file(
-          src32, syswow64 / dll,
-          std::filesystem::copy_options::overwrite_existing);
+      changes.installDll(src32, syswow64 / dll);
     }
   }
 
   // Set DLL overrides (only needed for user mode, umu handles this)
   if (m_config.prefixMode == WinePrefixMode::User) {
-    auto wineExe = getWineExecutable();
     for (const auto &dll : dxvkDlls) {
       std::string dllName = std::filesystem::path(dll).stem().string();
-      WinePrefixSetup::setDllOverride(prefixPath, wineExe, dllName, "native");
+      changes.setDllOverride(dllName, "native");
     }
   }
 
-  // Clean up
-  std::filesystem::remove(cacheFile);
+  if (!changes.apply(prefixPath, getWineExecutable())) {
+    spdlog::error("DXVK installation failed");
+    return false;
+  }
 
   spdlog::info("DXVK installed successfully");
   return true;
@@ -456,13 +628,10 @@ bool WineManager::isDxvkInstalled() const {
   return std::filesystem::exists(system32 / "d3d11.dll");
 }
 
-QStringList WineManager::buildWineArgs(const std::filesystem::path &executable,
-                                       const QStringList &args) const {
+WineProcessBuilder WineManager::gameProcessBuilder() const {
   WineProcessBuilder builder;
   builder.setWineExecutable(getWineExecutable())
       .setPrefix(getPrefixPath())
-      .setExecutable(executable)
-      .addArguments(args)
       .setEsync(m_config.esyncEnabled && checkEsyncSupport())
       .setFsync(m_config.fsyncEnabled && checkFsyncSupport());
 
@@ -476,9 +645,25 @@ QStringList WineManager::buildWineArgs(const std::filesystem::path &executable,
     builder.setDebugLevel(m_config.debugLevel);
   }
 
+  ShaderCache().applyTo(builder);
+  return builder;
+}
+
+QStringList WineManager::buildWineArgs(const std::filesystem::path &executable,
+                                       const QStringList &args) const {
+  WineProcessBuilder builder = gameProcessBuilder();
+  builder.setExecutable(executable).addArguments(args);
   return builder.buildCommandLine();
 }
 
+WineLaunch WineManager::buildLaunch(const std::filesystem::path &executable,
+                                    const QStringList &args,
+                                    const LaunchProfile &profile) const {
+  WineProcessBuilder builder = gameProcessBuilder();
+  builder.setExecutable(executable).addArguments(args).setProfile(profile);
+  return {builder.buildCommandLine(), builder.buildEnvironment()};
+}
+
 std::filesystem::path WineManager::getPlainWineExecutable() const {
   // For user mode, use their Wine directly
   if (m_config.prefixMode == WinePrefixMode::User) {
@@ -487,22 +672,11 @@ std::filesystem::path WineManager::getPlainWineExecutable() const {
 
   // Look for plain Wine (not umu-run) for console app support
   // Wine installed from packages usually resides in /usr/bin/wine
-  QString winePath = QStandardPaths::findExecutable("wine");
-  if (!winePath.isEmpty()) {
-    spdlog::debug("Found plain wine at: {}", winePath.toStdString());
-    return std::filesystem::path(winePath.toStdString());
-  }
-
-  // Check common paths
-  std::vector<std::filesystem::path> commonPaths = {
-      "/usr/bin/wine", "/usr/local/bin/wine", "/opt/wine/bin/wine",
-      "/opt/wine-stable/bin/wine"};
-
-  for (const auto &path : commonPaths) {
-    if (std::filesystem::exists(path)) {
-      spdlog::debug("Found plain wine at: {}", path.string());
-      return path;
-    }
+  auto winePath = findExecutable(
+      "wine", {"/usr/bin/wine", "/usr/local/bin/wine", "/opt/wine/bin/wine",
+               "/opt/wine-stable/bin/wine"});
+  if (!winePath.empty()) {
+    return winePath;
   }
 
   // Fallback - hope it's in PATH
@@ -530,23 +704,7 @@ WineManager::buildWineArgsForConsoleApp(const std::filesystem::path &executable,
 }
 
 QProcessEnvironment WineManager::getWineEnvironment() const {
-  WineProcessBuilder builder;
-  builder.setWineExecutable(getWineExecutable())
-      .setPrefix(getPrefixPath())
-      .setEsync(m_config.esyncEnabled && checkEsyncSupport())
-      .setFsync(m_config.fsyncEnabled && checkFsyncSupport());
-
-  // Set umu-specific environment
-  if (m_config.prefixMode == WinePrefixMode::Builtin) {
-    builder.setEnvironment("GAMEID", UmuConfig::LOTRO_GAME_ID);
-    builder.setEnvironment("PROTONPATH", UmuConfig::PROTON_VERSION);
-  }
-
-  if (!m_config.debugLevel.empty()) {
-    builder.setDebugLevel(m_config.debugLevel);
-  }
-
-  return builder.buildEnvironment();
+  return gameProcessBuilder().buildEnvironment();
 }
 
 bool WineManager::checkEsyncSupport() {
@@ -558,6 +716,16 @@ bool WineManager::checkEsyncSupport() {
 }
 
 bool WineManager::checkFsyncSupport() {
+  // The kernel can't change without a reboot
+  static const bool supported =
+      WineProbeCache::shared().getOrProbe(
+          "fsync", WineProbeCache::bootStamp(),
+          []() { return probeFsyncSupport() ? QString("1") : QString("0"); }) ==
+      "1";
+  return supported;
+}
+
+bool WineManager::probeFsyncSupport() {
   // Check for kernel futex_waitv support (Linux 5.16+)
   std::ifstream procVersion("/proc/version");
   if (!procVersion.is_open()) {
@@ -602,36 +770,148 @@ std::filesystem::path WineManager::getDxvkCachePath() const {
   return m_cachePath / "dxvk" / DxvkVersions::DXVK_VERSION;
 }
 
-bool WineManager::downloadFile(const std::string &url,
-                               const std::filesystem::path &destination,
-                               DownloadProgressCallback progress) {
-  // Ensure parent directory exists
-  std::filesystem::create_directories(destination.parent_path());
-
-  // Use curl for downloading (more reliable for large files)
-  QProcess process;
-  QStringList args;
+bool WineManager::fetchAndExtract(const std::string &url,
+                                  const std::filesystem::path &destination,
+                                  DownloadProgressCallback progress) {
+  std::filesystem::create_directories(destination);
+  const auto archiveName = std::filesystem::path(url).filename();
+
+  // Release URLs are versioned, so a stored copy never goes stale; other
+  // prefixes and installations reuse it
+  DownloadStore &store = DownloadStore::shared();
+  const QString storeUrl = QString::fromStdString(url);
+  if (auto alias = store.alias(storeUrl)) {
+    const auto archive = m_cachePath / archiveName;
+    if (store.materialize(alias->key, archive, DownloadStore::Link::Shared)) {
+      spdlog::info("Using stored download of {}", url);
+      const bool extracted = extractArchive(archive, destination);
+      std::error_code ec;
+      std::filesystem::remove(archive, ec);
+      return extracted;
+    }
+  }
 
-  args << "-L" // Follow redirects
-       << "-o" << QString::fromStdString(destination.string())
-       << "--progress-bar"
-       << "-f" // Fail on HTTP errors
-       << QString::fromStdString(url);
+  // Everything lands in a staging directory first, so a failed download
+  // leaves no half-extracted tree behind
+  QTemporaryDir staging(
+      QString::fromStdString((destination / ".fetch-XXXXXX").string()));
+  if (!staging.isValid()) {
+    spdlog::error("Can't create staging directory in {}",
+                  destination.string());
+    return false;
+  }
+  const std::filesystem::path stagingPath = staging.path().toStdString();
+  const auto archivePath = stagingPath / archiveName;
+  const auto headersPath = stagingPath / "headers";
+  const auto contentsPath = stagingPath / "contents";
+  std::filesystem::create_directories(contentsPath);
 
-  process.start("curl", args);
+  QFile archive(QString::fromStdString(archivePath.string()));
+  if (!archive.open(QIODevice::WriteOnly)) {
+    spdlog::error("Can't write {}", archivePath.string());
+    return false;
+  }
 
-  if (!process.waitForFinished(600000)) { // 10 minute timeout
-    spdlog::error("Download timed out");
+  // curl's output is hashed, kept for the download store and fed to tar as
+  // it arrives, so extraction finishes with the download
+  QProcess tar;
+  tar.start("tar", {tarExtractFlags(archiveName.string()), "-", "-C",
+                    QString::fromStdString(contentsPath.string())});
+  QProcess curl;
+  curl.start("curl", {"-L", "-f", "-sS", "-D",
+                      QString::fromStdString(headersPath.string()),
+                      QString::fromStdString(url)});
+  if (!tar.waitForStarted() || !curl.waitForStarted()) {
+    spdlog::error("Failed to start curl or tar");
+    curl.kill();
+    tar.kill();
+    curl.waitForFinished();
+    tar.waitForFinished();
     return false;
   }
 
-  if (process.exitCode() != 0) {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  size_t received = 0;
+  size_t total = 0;
+  bool written = true;
+  auto pump = [&]() {
+    const QByteArray chunk = curl.readAllStandardOutput();
+    if (chunk.isEmpty()) {
+      return;
+    }
+    hash.addData(chunk);
+    written = written && archive.write(chunk) == chunk.size();
+    tar.write(chunk);
+    // Hand tar each chunk before reading more; a slow disk holds the
+    // download back instead of piling up in memory
+    while (tar.bytesToWrite() > 0 && tar.waitForBytesWritten(1000)) {
+    }
+    received += chunk.size();
+    if (total == 0) {
+      total = contentLength(headersPath);
+    }
+    if (progress) {
+      progress(received, total);
+    }
+  };
+
+  QElapsedTimer timer;
+  timer.start();
+  while (curl.state() != QProcess::NotRunning) {
+    if (timer.elapsed() > 600000) { // 10 minute timeout
+      spdlog::error("Download timed out");
+      curl.kill();
+      tar.kill();
+      curl.waitForFinished();
+      tar.waitForFinished();
+      return false;
+    }
+    curl.waitForReadyRead(100);
+    pump();
+  }
+  pump();
+  tar.closeWriteChannel();
+  tar.waitForFinished(300000);
+  archive.close();
+
+  if (curl.exitStatus() != QProcess::NormalExit || curl.exitCode() != 0) {
     spdlog::error("Download failed: {}",
-                  process.readAllStandardError().toStdString());
+                  curl.readAllStandardError().toStdString());
+    return false;
+  }
+  if (tar.exitStatus() != QProcess::NormalExit || tar.exitCode() != 0) {
+    spdlog::error("Extraction failed: {}",
+                  tar.readAllStandardError().toStdString());
+    return false;
+  }
+  if (!written) {
+    spdlog::error("Failed to write {}", archivePath.string());
     return false;
   }
 
-  return std::filesystem::exists(destination);
+  // tar checked the compressed stream's checksum; move the tree into place
+  std::error_code ec;
+  for (const auto &entry :
+       std::filesystem::directory_iterator(contentsPath, ec)) {
+    const auto target = destination / entry.path().filename();
+    std::filesystem::remove_all(target, ec);
+    std::filesystem::rename(entry.path(), target, ec);
+    if (ec) {
+      spdlog::error("Can't move {} into place: {}", target.string(),
+                    ec.message());
+      return false;
+    }
+  }
+
+  // The digest was taken on the way in, so storing needs no second pass
+  const QString key = DownloadStore::key(QCryptographicHash::Sha256,
+                                         QString::fromLatin1(hash.result().toHex()));
+  if (store.insert(archivePath, key, DownloadStore::Link::Shared)) {
+    store.setAlias(storeUrl, key);
+    store.trim();
+  }
+  spdlog::info("Fetched {} ({} bytes, {})", url, received, key.toStdString());
+  return true;
 }
 
 bool WineManager::extractArchive(const std::filesystem::path &archive,
@@ -21,10 +21,13 @@
 #include <QProcessEnvironment>
 #include <QStringList>
 
+#include "LaunchProfile.hpp"
 #include "core/config/WineConfig.hpp"
 
 namespace lotro {
 
+class WineProcessBuilder;
+
 /**
  * Progress callback for download operations
  *
@@ -41,6 +44,14 @@ using DownloadProgressCallback =
  */
 using StatusCallback = std::function<void(const QString &)>;
 
+/**
+ * Command line and environment for one game process, built together
+ */
+struct WineLaunch {
+  QStringList commandLine;
+  QProcessEnvironment environment;
+};
+
 /**
  * Wine manager singleton
  *
@@ -120,6 +131,27 @@ public:
    */
   std::filesystem::path getWineServer() const;
 
+  /**
+   * Start a persistent wineserver for the prefix ahead of the first launch
+   *
+   * A game launched while the prefix's server runs skips starting it.
+   * Only user mode has a wineserver of its own to start; umu-run brings
+   * up Proton's inside its runtime container. A server already running
+   * for the prefix, e.g. one a game kept alive past the last session, is
+   * taken over instead.
+   *
+   * @return true if a server is running for the prefix
+   */
+  bool startWarmServer();
+
+  /**
+   * Stop the server startWarmServer() started or took over
+   *
+   * This ends every Wine process in the prefix, so don't call it while
+   * the game runs.
+   */
+  void stopWarmServer();
+
   // ==================
   // WINEPREFIX methods
   // ==================
@@ -180,6 +212,16 @@ public:
   QStringList buildWineArgs(const std::filesystem::path &executable,
                             const QStringList &args = {}) const;
 
+  /**
+   * Build the command line and environment for the game under a profile
+   *
+   * Both come from one builder, so the profile's wrappers and variables
+   * are applied together or not at all.
+   */
+  WineLaunch buildLaunch(const std::filesystem::path &executable,
+                         const QStringList &args,
+                         const LaunchProfile &profile) const;
+
   /**
    * Build Wine command line for console applications
    *
@@ -228,6 +270,11 @@ public:
   static std::optional<size_t> getOpenFileLimit();
 
 private:
+  WineProcessBuilder gameProcessBuilder() const;
+  static bool probeFsyncSupport();
+  static std::filesystem::path
+  findProtonPrefix(const std::filesystem::path &compatdataPath);
+
   WineManager();
   ~WineManager() = default;
   WineManager(const WineManager &) = delete;
@@ -236,17 +283,27 @@ private:
   // Internal paths
   std::filesystem::path getBuiltinPrefixPath() const;
   std::filesystem::path getDxvkCachePath() const;
+  bool isServerRunning() const;
+
+  // DXVK setup, split so the download can overlap prefix creation
+  bool fetchDxvk(DownloadProgressCallback progress);
+  bool installDxvk();
 
   // Download helpers
-  bool downloadFile(const std::string &url,
-                    const std::filesystem::path &destination,
-                    DownloadProgressCallback progress);
+  bool fetchAndExtract(const std::string &url,
+                       const std::filesystem::path &destination,
+                       DownloadProgressCallback progress);
   bool extractArchive(const std::filesystem::path &archive,
                       const std::filesystem::path &destination);
 
   WineConfig m_config;
   bool m_isSetup = false;
 
+  // Server started by startWarmServer(), kept apart from m_config in case
+  // the prefix is changed meanwhile
+  std::filesystem::path m_warmServer;
+  QProcessEnvironment m_warmServerEnvironment;
+
   // Cached paths
   std::filesystem::path m_dataPath;
   std::filesystem::path m_cachePath;
@@ -11,11 +11,229 @@
 
 #include <QProcess>
 #include <QDir>
+#include <QStringEncoder>
+#include <QTemporaryFile>
+#include <QtConcurrent>
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
+#include <cstdio>
+#include <optional>
+#include <set>
+
 namespace lotro {
 
+namespace {
+
+bool runWine(
+    const std::filesystem::path& prefixPath,
+    const std::filesystem::path& wineExecutable,
+    const QStringList& args,
+    int timeoutMs
+) {
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert("WINEPREFIX", QString::fromStdString(prefixPath.string()));
+    env.insert("WINEDEBUG", "-all");
+    
+    QProcess process;
+    process.setProcessEnvironment(env);
+    process.start(QString::fromStdString(wineExecutable.string()), args);
+    
+    if (!process.waitForFinished(timeoutMs)) {
+        spdlog::warn("wine {} timed out", args.value(0).toStdString());
+        return false;
+    }
+    return process.exitCode() == 0;
+}
+
+// .reg files want full root key names
+std::string regFileKey(const std::string& key) {
+    static const std::pair<const char*, const char*> roots[] = {
+        {"HKCU", "HKEY_CURRENT_USER"},
+        {"HKLM", "HKEY_LOCAL_MACHINE"},
+        {"HKCR", "HKEY_CLASSES_ROOT"},
+        {"HKU", "HKEY_USERS"},
+    };
+    for (const auto& [shortName, longName] : roots) {
+        const std::string prefix = std::string(shortName) + "\\";
+        if (key.rfind(prefix, 0) == 0) {
+            return longName + key.substr(std::string(shortName).size());
+        }
+    }
+    return key;
+}
+
+std::string regFileString(const std::string& text) {
+    std::string escaped = "\"";
+    for (char c : text) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped + '"';
+}
+
+std::optional<uint32_t> parseDword(const std::string& text) {
+    try {
+        size_t used = 0;
+        unsigned long value = std::stoul(text, &used, 0);
+        if (used == text.size() && value <= 0xFFFFFFFFul) {
+            return static_cast<uint32_t>(value);
+        }
+    } catch (const std::exception&) {
+    }
+    return std::nullopt;
+}
+
+// REG_EXPAND_SZ as hex(2): the UTF-16LE bytes, terminator included
+std::string regFileExpandString(const std::string& text) {
+    std::string out = "hex(2):";
+    const QString string = QString::fromStdString(text);
+    char byte[4];
+    for (qsizetype i = 0; i <= string.size(); ++i) {
+        const char16_t unit = i < string.size() ? string.at(i).unicode() : 0;
+        std::snprintf(byte, sizeof(byte), "%02x", unit & 0xFF);
+        out += std::string(i > 0 ? "," : "") + byte;
+        std::snprintf(byte, sizeof(byte), "%02x", unit >> 8);
+        out += std::string(",") + byte;
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+WinePrefixChanges& WinePrefixChanges::setDllOverride(const std::string& dllName, const std::string& mode) {
+    return setRegistryValue("HKEY_CURRENT_USER\\Software\\Wine\\DllOverrides", dllName, mode);
+}
+
+WinePrefixChanges& WinePrefixChanges::setRegistryValue(
+    const std::string& key,
+    const std::string& valueName,
+    const std::string& value,
+    const std::string& type
+) {
+    m_values.push_back({key, valueName, value, type});
+    return *this;
+}
+
+WinePrefixChanges& WinePrefixChanges::installDll(
+    const std::filesystem::path& source,
+    const std::filesystem::path& target
+) {
+    m_dlls.emplace_back(source, target);
+    return *this;
+}
+
+bool WinePrefixChanges::apply(
+    const std::filesystem::path& prefixPath,
+    const std::filesystem::path& wineExecutable
+) const {
+    return copyDlls() && writeRegistry(prefixPath, wineExecutable);
+}
+
+bool WinePrefixChanges::copyDlls() const {
+    std::atomic<bool> ok = true;
+    auto copies = m_dlls;
+    QtConcurrent::blockingMap(copies, [&ok](const auto& copy) {
+        const auto& [source, target] = copy;
+        std::error_code error;
+        std::filesystem::copy_file(source, target,
+            std::filesystem::copy_options::overwrite_existing, error);
+        if (error) {
+            spdlog::error("Failed to install DLL {}: {}", target.filename().string(), error.message());
+            ok = false;
+            return;
+        }
+        spdlog::debug("Installed DLL: {}", target.filename().string());
+    });
+    return ok;
+}
+
+bool WinePrefixChanges::isRegFileType(const std::string& type) {
+    return type == "REG_SZ" || type == "REG_EXPAND_SZ" || type == "REG_DWORD";
+}
+
+std::string WinePrefixChanges::toRegFile() const {
+    std::string out = "Windows Registry Editor Version 5.00\r\n";
+    std::vector<std::string> keys;
+    std::set<std::string> seen;
+    for (const auto& value : m_values) {
+        if (seen.insert(value.key).second) {
+            keys.push_back(value.key);
+        }
+    }
+    
+    for (const auto& key : keys) {
+        out += "\r\n[" + regFileKey(key) + "]\r\n";
+        for (const auto& value : m_values) {
+            if (value.key != key || !isRegFileType(value.type)) {
+                continue;
+            }
+            std::string data;
+            if (value.type == "REG_DWORD") {
+                auto number = parseDword(value.data);
+                if (!number) {
+                    continue;
+                }
+                char hex[16];
+                std::snprintf(hex, sizeof(hex), "dword:%08x", *number);
+                data = hex;
+            } else if (value.type == "REG_EXPAND_SZ") {
+                data = regFileExpandString(value.data);
+            } else {
+                data = regFileString(value.data);
+            }
+            out += (value.name.empty() ? std::string("@") : regFileString(value.name)) + "=" + data + "\r\n";
+        }
+    }
+    return out;
+}
+
+bool WinePrefixChanges::writeRegistry(
+    const std::filesystem::path& prefixPath,
+    const std::filesystem::path& wineExecutable
+) const {
+    bool ok = true;
+    bool anyInFile = false;
+    for (const auto& value : m_values) {
+        // What the file can't say goes through wine reg, one call each
+        if (isRegFileType(value.type) && (value.type != "REG_DWORD" || parseDword(value.data))) {
+            anyInFile = true;
+            continue;
+        }
+        QStringList args;
+        args << "reg" << "add"
+             << QString::fromStdString(value.key)
+             << "/v" << QString::fromStdString(value.name)
+             << "/t" << QString::fromStdString(value.type)
+             << "/d" << QString::fromStdString(value.data)
+             << "/f";
+        ok = runWine(prefixPath, wineExecutable, args, 30000) && ok;
+    }
+    if (!anyInFile) {
+        return ok;
+    }
+    
+    // regedit reads UTF-16 with a BOM, which keeps non-ASCII values intact
+    QTemporaryFile regFile(QDir::tempPath() + "/lotro-prefix-XXXXXX.reg");
+    if (!regFile.open()) {
+        spdlog::error("Could not create registry file: {}", regFile.errorString().toStdString());
+        return false;
+    }
+    QStringEncoder encoder(QStringConverter::Utf16LE, QStringConverter::Flag::WriteBom);
+    regFile.write(encoder.encode(QString::fromStdString(toRegFile())));
+    regFile.close();
+    
+    if (!runWine(prefixPath, wineExecutable, {"regedit", "/S", regFile.fileName()}, 60000)) {
+        spdlog::error("regedit failed to import {} registry values", m_values.size());
+        return false;
+    }
+    spdlog::debug("Imported {} registry values with regedit", m_values.size());
+    return ok;
+}
+
 bool WinePrefixSetup::createPrefix(
     const std::filesystem::path& prefixPath,
     const std::filesystem::path& wineExecutable,
@@ -107,20 +325,11 @@ bool WinePrefixSetup::installDlls(
     const std::vector<std::pair<std::string, std::filesystem::path>>& dlls,
     const std::filesystem::path& targetDir
 ) {
+    WinePrefixChanges changes;
     for (const auto& [name, source] : dlls) {
-        auto target = targetDir / name;
-        
-        try {
-            std::filesystem::copy_file(source, target,
-                std::filesystem::copy_options::overwrite_existing);
-            spdlog::debug("Installed DLL: {}", name);
-        } catch (const std::exception& e) {
-            spdlog::error("Failed to install DLL {}: {}", name, e.what());
-            return false;
-        }
+        changes.installDll(source, targetDir / name);
     }
-    
-    return true;
+    return changes.apply(prefixPath, {});
 }
 
 bool WinePrefixSetup::setDllOverride(
@@ -129,29 +338,7 @@ bool WinePrefixSetup::setDllOverride(
     const std::string& dllName,
     const std::string& mode
 ) {
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-    env.insert("WINEPREFIX", QString::fromStdString(prefixPath.string()));
-    env.insert("WINEDEBUG", "-all");
-    
-    QProcess process;
-    process.setProcessEnvironment(env);
-    
-    // Use wine reg to set the override
-    QStringList args;
-    args << "reg" << "add" 
-         << "HKEY_CURRENT_USER\\Software\\Wine\\DllOverrides"
-         << "/v" << QString::fromStdString(dllName)
-         << "/d" << QString::fromStdString(mode)
-         << "/f";
-    
-    process.start(QString::fromStdString(wineExecutable.string()), args);
-    
-    if (!process.waitForFinished(30000)) {
-        spdlog::warn("DLL override setting timed out for: {}", dllName);
-        return false;
-    }
-    
-    return process.exitCode() == 0;
+    return WinePrefixChanges().setDllOverride(dllName, mode).apply(prefixPath, wineExecutable);
 }
 
 bool WinePrefixSetup::setRegistryValue(
@@ -162,28 +349,7 @@ bool WinePrefixSetup::setRegistryValue(
     const std::string& value,
     const std::string& type
 ) {
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-    env.insert("WINEPREFIX", QString::fromStdString(prefixPath.string()));
-    env.insert("WINEDEBUG", "-all");
-    
-    QProcess process;
-    process.setProcessEnvironment(env);
-    
-    QStringList args;
-    args << "reg" << "add" 
-         << QString::fromStdString(key)
-         << "/v" << QString::fromStdString(valueName)
-         << "/t" << QString::fromStdString(type)
-         << "/d" << QString::fromStdString(value)
-         << "/f";
-    
-    process.start(QString::fromStdString(wineExecutable.string()), args);
-    
-    if (!process.waitForFinished(30000)) {
-        return false;
-    }
-    
-    return process.exitCode() == 0;
+    return WinePrefixChanges().setRegistryValue(key, valueName, value, type).apply(prefixPath, wineExecutable);
 }
 
 bool WinePrefixSetup::symlinkDocuments(
@@ -17,8 +17,65 @@
 
 namespace lotro {
 
+/**
+ * A batch of changes to a prefix, applied together
+ * 
+ * Each wine reg call boots Wine, which takes a couple of seconds, so
+ * collecting every override and value first and writing them as one .reg
+ * file through a single regedit run makes configuration cost one boot.
+ * DLL copies are independent of each other and run in parallel. Values
+ * of types a .reg file can't express here fall back to a wine reg call
+ * each.
+ */
+class WinePrefixChanges {
+public:
+    WinePrefixChanges& setDllOverride(const std::string& dllName, const std::string& mode);
+    
+    WinePrefixChanges& setRegistryValue(
+        const std::string& key,
+        const std::string& valueName,
+        const std::string& value,
+        const std::string& type = "REG_SZ"
+    );
+    
+    WinePrefixChanges& installDll(const std::filesystem::path& source, const std::filesystem::path& target);
+    
+    bool isEmpty() const { return m_values.empty() && m_dlls.empty(); }
+    
+    /**
+     * Copy the DLLs, then write the registry values
+     * 
+     * Stops before touching the registry if a copy failed.
+     */
+    bool apply(const std::filesystem::path& prefixPath, const std::filesystem::path& wineExecutable) const;
+    
+    /**
+     * The registry values as a regedit file, keys in first-use order
+     */
+    std::string toRegFile() const;
+    
+private:
+    struct Value {
+        std::string key;
+        std::string name;
+        std::string data;
+        std::string type;
+    };
+    
+    bool copyDlls() const;
+    bool writeRegistry(const std::filesystem::path& prefixPath, const std::filesystem::path& wineExecutable) const;
+    
+    static bool isRegFileType(const std::string& type);
+    
+    std::vector<Value> m_values;
+    std::vector<std::pair<std::filesystem::path, std::filesystem::path>> m_dlls;  // Source, target
+};
+
 /**
  * Wine prefix setup and configuration utilities
+ * 
+ * The single-value setters below each apply a one-item
+ * WinePrefixChanges; batch several changes into one instead.
  */
 class WinePrefixSetup {
 public:
@@ -0,0 +1,140 @@
+/**
+ * LOTRO Launcher - Wine Probe Cache Implementation (Linux only)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef PLATFORM_LINUX
+
+#include "WineProbeCache.hpp"
+#include "core/platform/Platform.hpp"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <spdlog/spdlog.h>
+
+#include <sys/stat.h>
+
+namespace lotro {
+
+namespace {
+
+QString readLine(const char* path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return QString::fromUtf8(file.readLine()).trimmed();
+}
+
+} // namespace
+
+WineProbeCache& WineProbeCache::shared() {
+    static WineProbeCache cache(Platform::getCachePath() / "wine-probes.cache");
+    return cache;
+}
+
+WineProbeCache::WineProbeCache(const std::filesystem::path& path)
+    : m_path(QString::fromStdString(path.string()))
+{
+    load();
+}
+
+std::optional<QString> WineProbeCache::get(const QString& key, const QString& stamp) const {
+    QMutexLocker lock(&m_mutex);
+    auto it = m_entries.constFind(key);
+    if (it == m_entries.constEnd() || it->stamp != stamp) {
+        return std::nullopt;
+    }
+    return it->value;
+}
+
+void WineProbeCache::put(const QString& key, const QString& stamp, const QString& value) {
+    QMutexLocker lock(&m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end() && it->stamp == stamp && it->value == value) {
+        return;
+    }
+    m_entries.insert(key, {stamp, value});
+    save();
+}
+
+QString WineProbeCache::getOrProbe(const QString& key, const QString& stamp,
+                                   const std::function<QString()>& probe) {
+    if (auto cached = get(key, stamp)) {
+        return *cached;
+    }
+    const QString value = probe();
+    put(key, stamp, value);
+    return value;
+}
+
+const QString& WineProbeCache::bootStamp() {
+    static const QString stamp = readLine("/proc/sys/kernel/random/boot_id") + "/" +
+                                 readLine("/proc/sys/kernel/osrelease");
+    return stamp;
+}
+
+QString WineProbeCache::fileStamp(const std::filesystem::path& path) {
+    struct stat info {};
+    if (stat(path.c_str(), &info) != 0) {
+        return "missing";
+    }
+    return QString("%1:%2.%3")
+        .arg(static_cast<qint64>(info.st_size))
+        .arg(static_cast<qint64>(info.st_mtim.tv_sec))
+        .arg(static_cast<qint64>(info.st_mtim.tv_nsec));
+}
+
+bool WineProbeCache::load() {
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version >> count;
+    if (magic != MAGIC || version != VERSION) {
+        spdlog::info("Wine probe cache {} is outdated, ignoring it", m_path.toStdString());
+        return false;
+    }
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString key;
+        Entry entry;
+        in >> key >> entry.stamp >> entry.value;
+        m_entries.insert(key, entry);
+    }
+    if (in.status() != QDataStream::Ok) {
+        spdlog::warn("Wine probe cache {} is corrupt, ignoring it", m_path.toStdString());
+        m_entries.clear();
+        return false;
+    }
+    return true;
+}
+
+bool WineProbeCache::save() const {
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        spdlog::warn("Failed to write Wine probe cache {}: {}", m_path.toStdString(),
+                     file.errorString().toStdString());
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MAGIC << VERSION << static_cast<quint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        out << it.key() << it->stamp << it->value;
+    }
+    return file.commit();
+}
+
+} // namespace lotro
+
+#endif // PLATFORM_LINUX
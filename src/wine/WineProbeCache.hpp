@@ -0,0 +1,77 @@
+/**
+ * LOTRO Launcher - Wine Probe Cache (Linux only)
+ *
+ * Remembers system and prefix probe results between runs.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#ifdef PLATFORM_LINUX
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+
+namespace lotro {
+
+/**
+ * Probe results, each stored with the stamp it was taken under
+ *
+ * A stamp is whatever changes when the result could: bootStamp() for
+ * kernel features and limits, fileStamp() of a binary or directory for
+ * lookups and prefix checks. A result is returned only while its stamp
+ * still matches, so invalidation costs one stat or nothing at all.
+ * Kept in the cache directory and written when a result changes. Safe to
+ * use from several threads.
+ */
+class WineProbeCache {
+public:
+    static WineProbeCache& shared();
+
+    explicit WineProbeCache(const std::filesystem::path& path);
+
+    std::optional<QString> get(const QString& key, const QString& stamp) const;
+    void put(const QString& key, const QString& stamp, const QString& value);
+
+    /**
+     * The cached value, or the probe's result stored in its place
+     */
+    QString getOrProbe(const QString& key, const QString& stamp, const std::function<QString()>& probe);
+
+    /**
+     * Boot ID and kernel release; changes with every reboot
+     */
+    static const QString& bootStamp();
+
+    /**
+     * Size and modification time, "missing" if the path doesn't exist.
+     * Stands in for a content hash of binaries at the cost of one stat.
+     */
+    static QString fileStamp(const std::filesystem::path& path);
+
+private:
+    struct Entry {
+        QString stamp;
+        QString value;
+    };
+
+    bool load();
+    bool save() const;
+
+    QString m_path;
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+
+    static constexpr quint32 MAGIC = 0x57505243;    // "WPRC"
+    static constexpr quint32 VERSION = 1;
+};
+
+} // namespace lotro
+
+#endif // PLATFORM_LINUX
@@ -8,8 +8,13 @@
 
 #include "WineProcessBuilder.hpp"
 
+#include <QStandardPaths>
+
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace lotro {
 
 WineProcessBuilder& WineProcessBuilder::setWineExecutable(const std::filesystem::path& path) {
@@ -67,8 +72,37 @@ WineProcessBuilder& WineProcessBuilder::setDxvkHud(const std::string& config) {
     return *this;
 }
 
+WineProcessBuilder& WineProcessBuilder::setProfile(const LaunchProfile& profile) {
+    m_profile = profile;
+    return *this;
+}
+
+QStringList WineProcessBuilder::profileWrappers() const {
+    QStringList wrappers;
+    auto wrap = [&wrappers](const char* tool, const QStringList& args) {
+        const QString path = QStandardPaths::findExecutable(tool);
+        if (path.isEmpty()) {
+            spdlog::warn("{} not found, launching without it", tool);
+            return;
+        }
+        wrappers << path << args;
+    };
+    
+    if (m_profile.gamemode) {
+        wrap("gamemoderun", {});
+    }
+    if (m_profile.cpuLimit > 0) {
+        const int cpus = std::min<int>(m_profile.cpuLimit, std::max(1u, std::thread::hardware_concurrency()));
+        wrap("taskset", {"-c", QString("0-%1").arg(cpus - 1)});
+    }
+    if (m_profile.niceLevel != 0) {
+        wrap("nice", {"-n", QString::number(m_profile.niceLevel)});
+    }
+    return wrappers;
+}
+
 QStringList WineProcessBuilder::buildCommandLine() const {
-    QStringList args;
+    QStringList args = profileWrappers();
     
     // Wine executable
     args << QString::fromStdString(m_wineExecutable.string());
@@ -119,7 +153,29 @@ QProcessEnvironment WineProcessBuilder::buildEnvironment() const {
     }
     
     // Large address aware for 32-bit games
-    env.insert("WINE_LARGE_ADDRESS_AWARE", "1");
+    env.insert("WINE_LARGE_ADDRESS_AWARE", m_profile.largeAddressAware ? "1" : "0");
+    
+    // Performance profile
+    if (m_profile.cpuLimit > 0) {
+        // Matches the taskset mask, so the game sizes its threads to it
+        const int cpus = std::min<int>(m_profile.cpuLimit, std::max(1u, std::thread::hardware_concurrency()));
+        QStringList ids;
+        for (int cpu = 0; cpu < cpus; ++cpu) {
+            ids << QString::number(cpu);
+        }
+        env.insert("WINE_CPU_TOPOLOGY", QString("%1:%2").arg(cpus).arg(ids.join(",")));
+    }
+    if (m_profile.hugePages) {
+        const QString tunables = env.value("GLIBC_TUNABLES");
+        env.insert("GLIBC_TUNABLES", (tunables.isEmpty() ? "" : tunables + ":") + "glibc.malloc.hugetlb=1");
+    }
+    if (m_profile.dxvkFrameRate > 0) {
+        env.insert("DXVK_FRAME_RATE", QString::number(m_profile.dxvkFrameRate));
+    }
+    if (m_profile.dxvkMaxFrameLatency > 0) {
+        env.insert("DXVK_CONFIG", QString("dxgi.maxFrameLatency = %1; d3d9.maxFrameLatency = %1")
+                                      .arg(m_profile.dxvkMaxFrameLatency));
+    }
     
     // WINEDLLOVERRIDES
     // Match OneLauncher's configuration
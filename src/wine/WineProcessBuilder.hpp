@@ -18,6 +18,7 @@
 #include <QProcessEnvironment>
 #include <QStringList>
 
+#include "LaunchProfile.hpp"
 #include "core/config/WineConfig.hpp"
 
 namespace lotro {
@@ -91,11 +92,20 @@ public:
      */
     WineProcessBuilder& setDxvkHud(const std::string& config);
     
+    /**
+     * Apply a performance profile
+     * 
+     * Its wrappers go in front of the Wine executable in the command line
+     * and its variables into the environment; setEnvironment() still
+     * overrides them.
+     */
+    WineProcessBuilder& setProfile(const LaunchProfile& profile);
+    
     /**
      * Build the command line arguments for QProcess
      * 
-     * The first element is the Wine executable, followed by
-     * the Windows executable and its arguments.
+     * The first element is the Wine executable, or the profile's first
+     * wrapper, followed by the Windows executable and its arguments.
      */
     QStringList buildCommandLine() const;
     
@@ -110,6 +120,8 @@ public:
     QString workingDirectory() const;
     
 private:
+    QStringList profileWrappers() const;
+    
     std::filesystem::path m_wineExecutable;
     std::filesystem::path m_prefix;
     std::filesystem::path m_executable;
@@ -120,6 +132,7 @@ private:
     bool m_fsyncEnabled = true;
     std::string m_debugLevel = "-all";
     std::string m_dxvkHud;
+    LaunchProfile m_profile;
     
     std::vector<std::pair<std::string, std::string>> m_customEnv;
 };
@@ -0,0 +1,499 @@
+/**
+ * LOTRO Launcher - Core Benchmarks
+ * 
+ * Google Benchmark suite over the launcher's hot paths: DAT reads,
+ * property and string decoding, game database loading, memory pattern
+ * scans, stat calculation and patch manifest parsing.
+ * 
+ * Benchmarks that need game files read them from the directories in
+ * LOTRO_BENCH_GAME_DIR (the installation, for the DAT archives) and
+ * LOTRO_BENCH_DATA_DIR (the companion data directory holding lore/), and
+ * are skipped when those are not set. The rest use synthetic input; the
+ * synthetic DAT archive is LOTRO_BENCH_SYNTHETIC_MB megabytes (64 if not
+ * set), so the archive paths can also be run at multi-GB scale.
+ * Character extraction replays the memory capture in LOTRO_BENCH_CAPTURE,
+ * written by running the launcher with LOTRO_MEMORY_CAPTURE set.
+ * 
+ * Usage: lotro-launcher-bench [--benchmark_filter=...]
+ *        [--benchmark_out=results.json --benchmark_out_format=json]
+ * The bench-json target runs the suite with JSON output.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "companion/CharacterExtractor.hpp"
+#include "companion/GameDatabase.hpp"
+#include "companion/PatternScanner.hpp"
+#include "companion/StatCalculator.hpp"
+#include "dat/DatArchive.hpp"
+#include "dat/DatGenerator.hpp"
+#include "dat/DataFacade.hpp"
+#include "dat/PropertyDefinitionsLoader.hpp"
+#include "dat/StringTable.hpp"
+#include "game/ManifestReader.hpp"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QString>
+#include <QTemporaryDir>
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include <zlib.h>
+
+#ifdef PLATFORM_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace lotro;
+
+namespace {
+
+constexpr uint64_t MASTER_PROPERTY_ID = 0x34000000;
+constexpr uint32_t STRING_TABLE_CLASS = 0x25;
+constexpr size_t DAT_SAMPLE_ENTRIES = 256;
+
+QString envPath(const char* name) {
+    const char* value = std::getenv(name);
+    return value ? QDir::cleanPath(QString::fromLocal8Bit(value)) : QString();
+}
+
+QString gameDir() {
+    return envPath("LOTRO_BENCH_GAME_DIR");
+}
+
+QString gamelogicPath() {
+    return gameDir() + "/client_gamelogic.dat";
+}
+
+// Drop the file's pages from the page cache, so the next read goes to disk
+void evictFromPageCache(const QString& path) {
+#ifdef PLATFORM_LINUX
+    int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY);
+    if (fd >= 0) {
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+#else
+    Q_UNUSED(path);
+#endif
+}
+
+// Entries spread evenly over the archive, so reads touch many blocks
+std::vector<uint64_t> sampleEntries(dat::DatArchive& archive, size_t count) {
+    const std::vector<dat::FileEntry> entries = archive.listEntries();
+    std::vector<uint64_t> ids;
+    if (entries.empty()) {
+        return ids;
+    }
+    const size_t step = std::max<size_t>(entries.size() / count, 1);
+    for (size_t i = 0; i < entries.size() && ids.size() < count; i += step) {
+        ids.push_back(entries[i].fileId());
+    }
+    return ids;
+}
+
+// One facade for the whole run, as the companion keeps one
+dat::DataFacade* sharedFacade() {
+    static std::unique_ptr<dat::DataFacade> facade = []() -> std::unique_ptr<dat::DataFacade> {
+        if (gameDir().isEmpty()) {
+            return nullptr;
+        }
+        auto created = std::make_unique<dat::DataFacade>(gameDir());
+        created->setPrewarmEnabled(false);
+        return created->initialize() ? std::move(created) : nullptr;
+    }();
+    return facade.get();
+}
+
+// Generated once per run, with every block layout and half the entries compressed
+const dat::DatGenerator* syntheticArchive(QString* path) {
+    static QTemporaryDir scratch;
+    static std::unique_ptr<dat::DatGenerator> generator = []() -> std::unique_ptr<dat::DatGenerator> {
+        const char* megabytes = std::getenv("LOTRO_BENCH_SYNTHETIC_MB");
+        dat::DatGeneratorOptions options;
+        options.entryCount = 0;
+        options.targetSize = (megabytes ? std::atoll(megabytes) : 64) * 1024 * 1024;
+        options.oldFormatFraction = 0.2;
+        options.extraBlockFraction = 0.2;
+        
+        auto created = std::make_unique<dat::DatGenerator>(options);
+        if (!scratch.isValid() || !created->write(scratch.filePath("synthetic.dat"))) {
+            return nullptr;
+        }
+        return created;
+    }();
+    *path = scratch.filePath("synthetic.dat");
+    return generator.get();
+}
+
+// =================
+// DAT archives
+// =================
+
+void BM_DatLoadDataCold(benchmark::State& state) {
+    if (gameDir().isEmpty()) {
+        state.SkipWithError("LOTRO_BENCH_GAME_DIR not set");
+        return;
+    }
+    std::vector<uint64_t> ids;
+    {
+        dat::DatArchive archive(gamelogicPath());
+        if (!archive.open()) {
+            state.SkipWithError("client_gamelogic.dat could not be opened");
+            return;
+        }
+        ids = sampleEntries(archive, DAT_SAMPLE_ENTRIES);
+    }
+    
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        evictFromPageCache(gamelogicPath());
+        state.ResumeTiming();
+        
+        // A fresh archive has no directory blocks loaded either
+        dat::DatArchive archive(gamelogicPath());
+        archive.open();
+        for (uint64_t id : ids) {
+            QByteArray data = archive.loadData(id);
+            bytes += data.size();
+            benchmark::DoNotOptimize(data);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ids.size()));
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_DatLoadDataCold)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_DatLoadDataWarm(benchmark::State& state) {
+    if (gameDir().isEmpty()) {
+        state.SkipWithError("LOTRO_BENCH_GAME_DIR not set");
+        return;
+    }
+    dat::DatArchive archive(gamelogicPath());
+    if (!archive.open()) {
+        state.SkipWithError("client_gamelogic.dat could not be opened");
+        return;
+    }
+    const std::vector<uint64_t> ids = sampleEntries(archive, DAT_SAMPLE_ENTRIES);
+    for (uint64_t id : ids) {
+        archive.loadData(id);
+    }
+    
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        for (uint64_t id : ids) {
+            QByteArray data = archive.loadData(id);
+            bytes += data.size();
+            benchmark::DoNotOptimize(data);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ids.size()));
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_DatLoadDataWarm)->Unit(benchmark::kMillisecond);
+
+// Arg 0 reads through the file, 1 through a mapping
+void BM_DatLoadDataSynthetic(benchmark::State& state) {
+    QString path;
+    const dat::DatGenerator* generator = syntheticArchive(&path);
+    if (!generator) {
+        state.SkipWithError("synthetic archive could not be generated");
+        return;
+    }
+    dat::DatArchive archive(path);
+    archive.setMemoryMapped(state.range(0) != 0);
+    if (!archive.open()) {
+        state.SkipWithError("synthetic archive could not be opened");
+        return;
+    }
+    
+    // Sampled evenly, and checked once so a broken reader fails loudly
+    const auto& entries = generator->result().entries;
+    std::vector<uint64_t> ids;
+    const size_t step = std::max<size_t>(entries.size() / DAT_SAMPLE_ENTRIES, 1);
+    for (size_t i = 0; i < entries.size(); i += step) {
+        const QByteArray data = archive.loadData(entries[i].fileId);
+        const auto crc = static_cast<uint32_t>(crc32(0, reinterpret_cast<const Bytef*>(data.constData()),
+                                                     static_cast<uInt>(data.size())));
+        if (crc != entries[i].crc) {
+            state.SkipWithError("synthetic entry read back wrong");
+            return;
+        }
+        ids.push_back(entries[i].fileId);
+    }
+    
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        for (uint64_t id : ids) {
+            QByteArray data = archive.loadData(id);
+            bytes += data.size();
+            benchmark::DoNotOptimize(data);
+        }
+    }
+    state.SetLabel(QString("%1 entries, depth %2")
+        .arg(entries.size()).arg(generator->result().directoryDepth).toStdString());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ids.size()));
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_DatLoadDataSynthetic)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// =================
+// Properties and strings
+// =================
+
+void BM_DecodeMasterProperty(benchmark::State& state) {
+    dat::DataFacade* facade = sharedFacade();
+    if (!facade) {
+        state.SkipWithError("LOTRO_BENCH_GAME_DIR not set or unreadable");
+        return;
+    }
+    const QByteArray data = facade->loadData(MASTER_PROPERTY_ID);
+    if (data.isEmpty()) {
+        state.SkipWithError("master property entry not found");
+        return;
+    }
+    
+    dat::PropertyDefinitionsLoader loader;
+    for (auto _ : state) {
+        auto registry = loader.decodeMasterProperty(data);
+        benchmark::DoNotOptimize(registry);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_DecodeMasterProperty)->Unit(benchmark::kMillisecond);
+
+void BM_ResolveString(benchmark::State& state) {
+    dat::DataFacade* facade = sharedFacade();
+    if (!facade) {
+        state.SkipWithError("LOTRO_BENCH_GAME_DIR not set or unreadable");
+        return;
+    }
+    
+    // The first string table in the English archive with enough tokens
+    dat::DatArchive local(gameDir() + "/client_local_English.dat");
+    uint32_t tableId = 0;
+    std::vector<uint32_t> tokens;
+    if (local.open()) {
+        for (const auto& entry : local.listEntries()) {
+            if ((entry.fileId() >> 24) != STRING_TABLE_CLASS) {
+                continue;
+            }
+            dat::StringTablePtr table = facade->getStringTable(static_cast<uint32_t>(entry.fileId()));
+            if (table && table->size() >= 64) {
+                tableId = static_cast<uint32_t>(entry.fileId());
+                tokens = table->tokenIds();
+                break;
+            }
+        }
+    }
+    if (tokens.empty()) {
+        state.SkipWithError("no string table found in client_local_English.dat");
+        return;
+    }
+    
+    for (auto _ : state) {
+        for (uint32_t token : tokens) {
+            QString text = facade->resolveString(tableId, token);
+            benchmark::DoNotOptimize(text);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tokens.size()));
+}
+BENCHMARK(BM_ResolveString)->Unit(benchmark::kMicrosecond);
+
+// =================
+// Game database
+// =================
+// Tables load once per process, so these run a single iteration each. With
+// a snapshot next to the data, initialize() only opens it and each table
+// is decoded by its own benchmark; without one, initialize() parses every
+// table's XML and writes the snapshot for the next run.
+
+constexpr std::array<const char*, static_cast<size_t>(GameTable::Count)> TABLE_NAMES = {
+    "Deeds", "Recipes", "Titles", "Emotes", "Skills", "Traits", "Quests", "Collections",
+    "Cosmetics", "Factions", "Landmarks", "GeoAreas", "Professions", "Virtues", "Classes", "Races"
+};
+
+// Loaded by the initialize benchmark for the table benchmarks
+std::shared_ptr<GameDatabase> benchGameDatabase;
+
+void BM_GameDatabaseInitialize(benchmark::State& state) {
+    const QString dataDir = envPath("LOTRO_BENCH_DATA_DIR");
+    if (dataDir.isEmpty()) {
+        state.SkipWithError("LOTRO_BENCH_DATA_DIR not set");
+        return;
+    }
+    for (auto _ : state) {
+        benchGameDatabase = GameDatabase::create(dataDir.toStdString(), QString());
+        benchmark::DoNotOptimize(benchGameDatabase);
+    }
+}
+BENCHMARK(BM_GameDatabaseInitialize)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_GameDatabaseTable(benchmark::State& state) {
+    if (!benchGameDatabase) {
+        state.SkipWithError("game database not initialized");
+        return;
+    }
+    const auto table = static_cast<GameTable>(state.range(0));
+    state.SetLabel(TABLE_NAMES[static_cast<size_t>(table)]);
+    for (auto _ : state) {
+        benchGameDatabase->preload({table}).waitForFinished();
+    }
+}
+BENCHMARK(BM_GameDatabaseTable)
+    ->DenseRange(0, static_cast<int>(GameTable::Count) - 1)
+    ->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// =================
+// Character extraction
+// =================
+
+void BM_ExtractCharacterReplay(benchmark::State& state) {
+    const QString capture = envPath("LOTRO_BENCH_CAPTURE");
+    if (capture.isEmpty()) {
+        state.SkipWithError("LOTRO_BENCH_CAPTURE not set");
+        return;
+    }
+    CharacterExtractor extractor(gameDir());
+    if (!extractor.connectRecording(capture)) {
+        state.SkipWithError("capture could not be opened");
+        return;
+    }
+    
+    // The replay has to decode what the live client showed
+    auto info = extractor.extractCharacter();
+    auto expected = extractor.capturedCharacter();
+    if (!info || !expected || info->name != expected->name || info->level != expected->level
+        || info->totalCopper() != expected->totalCopper()) {
+        state.SkipWithError("replayed character differs from the captured one");
+        return;
+    }
+    
+    const ProcessMemory::ReadStats before = extractor.readStats();
+    for (auto _ : state) {
+        auto character = extractor.extractCharacter();
+        benchmark::DoNotOptimize(character);
+    }
+    const ProcessMemory::ReadStats& after = extractor.readStats();
+    const auto perSync = [](uint64_t total) {
+        return benchmark::Counter(static_cast<double>(total), benchmark::Counter::kAvgIterations);
+    };
+    state.counters["syscalls"] = perSync(after.syscalls - before.syscalls);
+    state.counters["remote_bytes"] = perSync(after.remoteBytes - before.remoteBytes);
+    state.counters["page_fetches"] = perSync(after.pageFetches - before.pageFetches);
+    state.SetLabel(info->name.toStdString());
+}
+BENCHMARK(BM_ExtractCharacterReplay)->Unit(benchmark::kMicrosecond);
+
+// =================
+// Pattern scanning
+// =================
+
+void BM_PatternScannerFind(benchmark::State& state) {
+    // Random bytes with the pattern planted near the end, like a signature
+    // deep in the client's code section
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)));
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (auto& b : data) {
+        b = static_cast<uint8_t>(byte(rng));
+    }
+    const std::vector<uint8_t> planted = {0x48, 0x83, 0xEC, 0x28, 0xBA, 0x02, 0x00, 0x00, 0x00, 0x48, 0x8D, 0x0D};
+    std::copy(planted.begin(), planted.end(), data.end() - 4096);
+    constexpr auto pattern = "4883EC28BA02000000488D0D?3"_pattern;
+    
+    for (auto _ : state) {
+        auto offset = PatternScanner::find(data, pattern);
+        benchmark::DoNotOptimize(offset);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+BENCHMARK(BM_PatternScannerFind)->Arg(16 << 20)->Arg(64 << 20)->Unit(benchmark::kMillisecond);
+
+// =================
+// Stat calculation
+// =================
+
+void BM_StatCalculatorCalculate(benchmark::State& state) {
+    CharacterBuild build;
+    build.level = 150;
+    build.characterClass = "Champion";
+    build.baseStats[StatType::Might] = 1200;
+    build.baseStats[StatType::Vitality] = 900;
+    
+    // A full set of gear carrying several stats per piece
+    for (int slot = 0; slot < static_cast<int>(EquipSlot::Unknown); ++slot) {
+        GearItem item;
+        item.id = QString::number(slot);
+        item.slot = static_cast<EquipSlot>(slot);
+        item.itemLevel = 500;
+        for (int stat = 0; stat < 6; ++stat) {
+            item.stats.push_back({static_cast<StatType>((slot + stat) % static_cast<int>(StatType::Unknown)),
+                                  1000 + slot * 10 + stat});
+        }
+        build.equip(item);
+    }
+    
+    StatCalculator calculator;
+    for (auto _ : state) {
+        CalculatedStats stats = calculator.calculate(build);
+        benchmark::DoNotOptimize(stats);
+    }
+}
+BENCHMARK(BM_StatCalculatorCalculate);
+
+// =================
+// Patch manifests
+// =================
+
+QByteArray syntheticManifest(int files) {
+    QByteArray xml = "<?xml version=\"1.0\"?>\n<ArrayOfFile>\n";
+    for (int i = 0; i < files; ++i) {
+        xml += QString("  <File><From>files/%1/data_%2.bin</From><To>data\\%1\\data_%2.bin</To>"
+                       "<Size>%3</Size><MD5>%4</MD5></File>\n")
+                   .arg(i % 64).arg(i).arg(4096 + i)
+                   .arg(QString("%1").arg(i, 32, 16, QChar('0'))).toUtf8();
+    }
+    xml += "</ArrayOfFile>\n";
+    return xml;
+}
+
+void BM_ManifestParse(benchmark::State& state) {
+    const QByteArray xml = syntheticManifest(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto files = ManifestReader::parse(ManifestReader::Format::Patching, xml);
+        benchmark::DoNotOptimize(files);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * xml.size());
+}
+BENCHMARK(BM_ManifestParse)->Arg(1000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    spdlog::set_level(spdlog::level::warn);
+    
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    // Recorded in the JSON context so results can be matched to builds
+    benchmark::AddCustomContext("launcher_version", LAUNCHER_VERSION);
+    benchmark::AddCustomContext("launcher_revision", LAUNCHER_REVISION);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
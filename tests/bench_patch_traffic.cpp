@@ -0,0 +1,356 @@
+/**
+ * LOTRO Launcher - Patch Traffic Replay Benchmark
+ * 
+ * Replays captured patch traffic through the patch server client's
+ * envelope, framing and parsing code and the native patcher's manifest
+ * and hashing stages, against a loopback mock server, and reports the
+ * throughput of each stage.
+ * 
+ * Usage: lotro-patch-replay [--iterations N] [--window N] [capture...]
+ * Captures are socat -v logs (patch_capture_*.txt) or raw client streams
+ * (*.bin); without arguments the ones under tools/ are used.
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "game/FileHashCache.hpp"
+#include "game/ManifestReader.hpp"
+#include "game/PatchServerClient.hpp"
+#include "game/VerifyPool.hpp"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QtConcurrent>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using lotro::PatchServerClient;
+
+namespace {
+
+struct StageResult {
+    const char* name;
+    qint64 items = 0;
+    qint64 bytes = 0;
+    qint64 nanoseconds = 0;
+};
+
+std::vector<StageResult> g_results;
+
+template <typename Fn>
+void stage(const char* name, Fn&& body) {
+    StageResult result{name};
+    QElapsedTimer clock;
+    clock.start();
+    body(result);
+    result.nanoseconds = clock.nsecsElapsed();
+    g_results.push_back(result);
+}
+
+void printResults() {
+    std::printf("%-18s %10s %12s %12s %14s\n", "stage", "items", "MB", "MB/s", "items/s");
+    for (const StageResult& r : g_results) {
+        const double seconds = std::max<qint64>(r.nanoseconds, 1) / 1e9;
+        std::printf("%-18s %10lld %12.2f %12.1f %14.0f\n", r.name, static_cast<long long>(r.items),
+                    r.bytes / 1e6, r.bytes / 1e6 / seconds, r.items / seconds);
+    }
+}
+
+// socat -v escapes CR and a few controls and prints other unprintables as
+// '.'; the length field in each header says how many bytes there were
+QByteArray decodeSocatRecord(const QByteArray& text, int length) {
+    QByteArray bytes;
+    bytes.reserve(length);
+    for (qsizetype i = 0; i < text.size() && bytes.size() < length; ++i) {
+        char c = text[i];
+        if (c == '\\' && i + 1 < text.size()) {
+            const char next = text[i + 1];
+            const char* escapes = "r\rn\nt\ta\ab\bf\fv\v\\\\";
+            for (const char* e = escapes; *e; e += 2) {
+                if (*e == next) {
+                    c = e[1];
+                    ++i;
+                    break;
+                }
+            }
+        }
+        bytes.append(c);
+    }
+    if (bytes.size() < length) {
+        bytes.append(length - bytes.size(), '\n');  // The log's own line breaks
+    }
+    return bytes;
+}
+
+// Client-to-server bytes of a capture, in order
+QByteArray loadCapture(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        spdlog::warn("Cannot open capture {}", path.toStdString());
+        return {};
+    }
+    const QByteArray data = file.readAll();
+    if (!path.endsWith(".txt")) {
+        return data;
+    }
+    
+    static const QRegularExpression header(
+        R"(([<>]) \d{4}/\d\d/\d\d \d\d:\d\d:\d\d\.\d+\s+length=(\d+) from=\d+ to=\d+\n)");
+    QByteArray stream;
+    const QString text = QString::fromLatin1(data);
+    QRegularExpressionMatch previous;
+    auto it = header.globalMatch(text);
+    auto flush = [&](qsizetype end) {
+        if (previous.hasMatch() && previous.captured(1) == ">") {
+            const qsizetype start = previous.capturedEnd();
+            stream.append(decodeSocatRecord(data.mid(start, end - start), previous.captured(2).toInt()));
+        }
+    };
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        flush(match.capturedStart());
+        previous = match;
+    }
+    flush(data.size());
+    return stream;
+}
+
+// Bodies of the HTTP requests in a client stream
+std::vector<QByteArray> splitRequests(const QByteArray& stream) {
+    std::vector<QByteArray> bodies;
+    qsizetype pos = 0;
+    while (pos < stream.size()) {
+        const qsizetype headerEnd = stream.indexOf("\r\n\r\n", pos);
+        if (headerEnd < 0) {
+            break;
+        }
+        qsizetype length = 0;
+        const QByteArray headers = stream.mid(pos, headerEnd - pos);
+        for (const QByteArray& line : headers.split('\n')) {
+            if (line.toLower().startsWith("content-length:")) {
+                length = line.mid(line.indexOf(':') + 1).trimmed().toLongLong();
+            }
+        }
+        const qsizetype bodyStart = headerEnd + 4;
+        bodies.push_back(stream.mid(bodyStart, length));
+        pos = bodyStart + length;
+    }
+    return bodies;
+}
+
+// Echoes every complete frame back, as a server answering each request would
+class EchoServer : public QObject {
+public:
+    EchoServer() {
+        connect(&m_server, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, socket, [socket, buffer = QByteArray()]() mutable {
+                    buffer.append(socket->readAll());
+                    qsizetype pos = 0;
+                    PatchServerClient::Frame frame;
+                    while (PatchServerClient::decodeFrame(buffer, pos, frame)
+                           == PatchServerClient::FrameStatus::Complete) {
+                        socket->write(PatchServerClient::encodeFrame(frame.sequence, frame.payload));
+                    }
+                    buffer.remove(0, pos);
+                });
+            }
+        });
+        m_server.listen(QHostAddress::LocalHost);
+    }
+    
+    quint16 port() const { return m_server.serverPort(); }
+
+private:
+    QTcpServer m_server;
+};
+
+QByteArray syntheticManifest(const std::vector<QByteArray>& bodies, int copies) {
+    QByteArray xml = "<?xml version=\"1.0\"?>\n<ArrayOfFile>\n";
+    for (int copy = 0; copy < copies; ++copy) {
+        for (size_t i = 0; i < bodies.size(); ++i) {
+            const QByteArray md5 = QCryptographicHash::hash(bodies[i], QCryptographicHash::Md5).toHex();
+            xml += QString("  <File><From>files/%1/%2.bin</From><To>replay\\%1\\%2.bin</To>"
+                           "<Size>%3</Size><MD5>%4</MD5></File>\n")
+                       .arg(copy).arg(i).arg(bodies[i].size()).arg(QString::fromLatin1(md5)).toUtf8();
+        }
+    }
+    xml += "</ArrayOfFile>\n";
+    return xml;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    spdlog::set_level(spdlog::level::warn);
+    
+    int iterations = 20;
+    int window = 8;                     // PatchServerClient's in-flight limit
+    QStringList captures;
+    const QStringList args = app.arguments().mid(1);
+    for (int i = 0; i < args.size(); ++i) {
+        if (args[i] == "--iterations" && i + 1 < args.size()) {
+            iterations = std::max(1, args[++i].toInt());
+        } else if (args[i] == "--window" && i + 1 < args.size()) {
+            window = std::max(1, args[++i].toInt());
+        } else {
+            captures << args[i];
+        }
+    }
+    if (captures.isEmpty()) {
+        QDir tools(PATCH_TRAFFIC_DIR);
+        for (const QString& name : tools.entryList({"patch_traffic.bin", "patch_capture_*.txt"}, QDir::Files)) {
+            captures << tools.filePath(name);
+        }
+    }
+    
+    // Capture decoding
+    QByteArray stream;
+    stage("capture decode", [&](StageResult& r) {
+        for (const QString& path : captures) {
+            const QByteArray bytes = loadCapture(path);
+            r.items += bytes.isEmpty() ? 0 : 1;
+            r.bytes += QFileInfo(path).size();
+            stream.append(bytes);
+        }
+    });
+    std::vector<QByteArray> bodies;
+    stage("http split", [&](StageResult& r) {
+        bodies = splitRequests(stream);
+        r.items = static_cast<qint64>(bodies.size());
+        r.bytes = stream.size();
+    });
+    if (bodies.empty()) {
+        std::fprintf(stderr, "No requests found in %lld capture(s)\n", static_cast<long long>(captures.size()));
+        return 1;
+    }
+    
+    // Envelope and framing, in memory
+    std::vector<QByteArray> frames(bodies.size());
+    stage("encrypt", [&](StageResult& r) {
+        for (int n = 0; n < iterations; ++n) {
+            for (size_t i = 0; i < bodies.size(); ++i) {
+                frames[i] = PatchServerClient::encryptRequest(bodies[i]);
+                r.bytes += bodies[i].size();
+            }
+        }
+        r.items = static_cast<qint64>(bodies.size()) * iterations;
+    });
+    stage("frame encode", [&](StageResult& r) {
+        for (int n = 0; n < iterations; ++n) {
+            for (size_t i = 0; i < frames.size(); ++i) {
+                const QByteArray frame = PatchServerClient::encodeFrame(static_cast<quint32>(i), frames[i]);
+                r.bytes += frame.size();
+            }
+        }
+        r.items = static_cast<qint64>(frames.size()) * iterations;
+    });
+    
+    // Pipelined round trips through the mock server
+    std::vector<QByteArray> responses;
+    stage("loopback replay", [&](StageResult& r) {
+        EchoServer server;
+        QTcpSocket socket;
+        QEventLoop loop;
+        const qint64 total = static_cast<qint64>(frames.size()) * iterations;
+        qint64 sent = 0;
+        qint64 received = 0;
+        QByteArray buffer;
+        
+        auto send = [&]() {
+            while (sent < total && sent - received < window) {
+                const size_t i = static_cast<size_t>(sent % static_cast<qint64>(frames.size()));
+                socket.write(PatchServerClient::encodeFrame(static_cast<quint32>(sent), frames[i]));
+                r.bytes += frames[i].size();
+                ++sent;
+            }
+        };
+        QObject::connect(&socket, &QTcpSocket::connected, &loop, send);
+        QObject::connect(&socket, &QTcpSocket::readyRead, &loop, [&]() {
+            buffer.append(socket.readAll());
+            qsizetype pos = 0;
+            PatchServerClient::Frame frame;
+            while (PatchServerClient::decodeFrame(buffer, pos, frame) == PatchServerClient::FrameStatus::Complete) {
+                const QByteArray plain = PatchServerClient::decryptResponse(frame.payload);
+                if (responses.size() < frames.size()) {
+                    responses.push_back(plain);
+                }
+                r.bytes += frame.payload.size();
+                ++received;
+            }
+            buffer.remove(0, pos);
+            if (received == total) {
+                loop.quit();
+            }
+            send();
+        });
+        QObject::connect(&socket, &QTcpSocket::errorOccurred, &loop, &QEventLoop::quit);
+        QTimer::singleShot(120000, &loop, &QEventLoop::quit);
+        socket.connectToHost(QHostAddress::LocalHost, server.port());
+        loop.exec();
+        r.items = received;
+    });
+    
+    stage("parse response", [&](StageResult& r) {
+        for (int n = 0; n < iterations; ++n) {
+            for (const QByteArray& response : responses) {
+                lotro::PatchCheckResult result;
+                PatchServerClient::parseVersionCheckResponse(response, result);
+                r.bytes += response.size();
+            }
+        }
+        r.items = static_cast<qint64>(responses.size()) * iterations;
+    });
+    
+    // NativePatcher's stages: the streamed manifest read, then the hashing
+    const QByteArray manifest = syntheticManifest(bodies, std::max(1, iterations / 4));
+    stage("manifest parse", [&](StageResult& r) {
+        for (int n = 0; n < iterations; ++n) {
+            lotro::ManifestReader reader(lotro::ManifestReader::Format::Patching);
+            for (qsizetype pos = 0; pos < manifest.size(); pos += 16 * 1024) {
+                reader.addData(manifest.mid(pos, 16 * 1024));
+                r.items += static_cast<qint64>(reader.takeFiles().size());
+            }
+            r.bytes += manifest.size();
+        }
+    });
+    
+    QTemporaryDir scratch;
+    QStringList paths;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        const QString path = scratch.filePath(QString("%1.bin").arg(i));
+        QFile file(path);
+        if (file.open(QIODevice::WriteOnly)) {
+            for (int n = 0; n < iterations; ++n) {
+                file.write(bodies[i]);
+            }
+            paths << path;
+        }
+    }
+    stage("hash", [&](StageResult& r) {
+        lotro::VerifyPool pool(scratch.path().toStdString());
+        QtConcurrent::blockingMap(pool.pool(), paths, [&pool](const QString& path) {
+            lotro::FileHashCache::hashFile(path, &pool);
+        });
+        r.items = paths.size();
+        r.bytes = pool.verifiedBytes();
+    });
+    
+    printResults();
+    return 0;
+}
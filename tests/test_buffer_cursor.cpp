@@ -0,0 +1,225 @@
+/**
+ * LOTRO Launcher - Buffer Cursor Tests
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "dat/BufferUtils.hpp"
+
+#include <QByteArray>
+#include <QString>
+
+#include <array>
+#include <cstring>
+
+using namespace lotro::dat;
+
+namespace {
+
+QByteArray bytes(std::initializer_list<uint8_t> values) {
+    QByteArray out;
+    for (uint8_t value : values) {
+        out.append(static_cast<char>(value));
+    }
+    return out;
+}
+
+// VLE length prefix followed by length bytes of 'a'
+QByteArray pascalString(int length) {
+    QByteArray out = length < 0x80
+        ? bytes({static_cast<uint8_t>(length)})
+        : bytes({static_cast<uint8_t>(0x80 | (length >> 8)), static_cast<uint8_t>(length & 0xFF)});
+    return out + QByteArray(length, 'a');
+}
+
+} // namespace
+
+TEST(BufferCursorTest, ReadsLittleEndianValues) {
+    const QByteArray data = bytes({0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                   0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F});
+    BufferCursor cursor(data);
+    EXPECT_EQ(cursor.readUInt8(), 0x01);
+    EXPECT_EQ(cursor.readUInt16(), 0x0302);
+    EXPECT_EQ(cursor.readUInt32(), 0x07060504u);
+    EXPECT_EQ(cursor.readUInt64(), 0x0F0E0D0C0B0A0908ull);
+    EXPECT_TRUE(cursor.ok());
+    EXPECT_TRUE(cursor.atEnd());
+    EXPECT_EQ(cursor.position(), 15u);
+    EXPECT_EQ(cursor.remaining(), 0u);
+}
+
+TEST(BufferCursorTest, ReadsFloatingPoint) {
+    QByteArray data(12, '\0');
+    const float f = 1.5f;
+    const double d = -0.25;
+    std::memcpy(data.data(), &f, sizeof(f));
+    std::memcpy(data.data() + 4, &d, sizeof(d));
+    
+    BufferCursor cursor(data);
+    EXPECT_EQ(cursor.readFloat(), 1.5f);
+    EXPECT_EQ(cursor.readDouble(), -0.25);
+    EXPECT_TRUE(cursor.ok());
+}
+
+TEST(BufferCursorTest, ShortReadFailsAndStaysFailed) {
+    const QByteArray data = bytes({0xAA, 0xBB, 0xCC});
+    BufferCursor cursor(data);
+    EXPECT_EQ(cursor.readUInt16(), 0xBBAA);
+    EXPECT_EQ(cursor.readUInt16(), 0);
+    EXPECT_FALSE(cursor.ok());
+    EXPECT_TRUE(cursor.atEnd());
+    EXPECT_EQ(cursor.position(), 3u);
+    
+    // Later reads return nothing even where one byte would have been left
+    EXPECT_EQ(cursor.readUInt8(), 0);
+    EXPECT_FALSE(cursor.ok());
+}
+
+TEST(BufferCursorTest, SkipChecksRemainingLength) {
+    const QByteArray data(8, 'x');
+    BufferCursor cursor(data);
+    EXPECT_TRUE(cursor.skip(8));
+    EXPECT_TRUE(cursor.ok());
+    EXPECT_TRUE(cursor.skip(0));
+    
+    BufferCursor past(data);
+    EXPECT_FALSE(past.skip(9));
+    EXPECT_FALSE(past.ok());
+    EXPECT_TRUE(past.atEnd());
+}
+
+TEST(BufferCursorTest, ReadsUInt32ArrayOnlyWhenWhole) {
+    const QByteArray data = bytes({1, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0});
+    std::array<uint32_t, 3> out{};
+    
+    BufferCursor cursor(data);
+    ASSERT_TRUE(cursor.readUInt32Array(out.data(), 2));
+    EXPECT_EQ(out[0], 1u);
+    EXPECT_EQ(out[1], 2u);
+    
+    out.fill(0xFFFFFFFF);
+    BufferCursor truncated(data);
+    EXPECT_FALSE(truncated.readUInt32Array(out.data(), 3));
+    EXPECT_FALSE(truncated.ok());
+    EXPECT_EQ(out[0], 0xFFFFFFFFu);
+}
+
+TEST(BufferCursorTest, ReadsVariableLengthIntegers) {
+    const QByteArray data = bytes({0x7F,
+                                   0x81, 0x02,
+                                   0xC1, 0x02, 0x04, 0x03,
+                                   0xE0, 0x78, 0x56, 0x34, 0x12,
+                                   0xFF, 0x05});
+    BufferCursor cursor(data);
+    EXPECT_EQ(cursor.readVle(), 0x7F);
+    EXPECT_EQ(cursor.readVle(), 0x0102);
+    EXPECT_EQ(cursor.readVle(), 0x01020304);
+    EXPECT_EQ(cursor.readVle(), 0x12345678);
+    EXPECT_EQ(cursor.readTSize(), 5);
+    EXPECT_TRUE(cursor.ok());
+    EXPECT_TRUE(cursor.atEnd());
+}
+
+TEST(BufferCursorTest, TruncatedVariableLengthIntegerFails) {
+    for (const QByteArray& data : {bytes({0x81}), bytes({0xC1, 0x02, 0x04}), bytes({0xE0, 0x01, 0x02})}) {
+        BufferCursor cursor(data);
+        cursor.readVle();
+        EXPECT_FALSE(cursor.ok()) << data.toHex().toStdString();
+        EXPECT_TRUE(cursor.atEnd());
+    }
+}
+
+TEST(BufferCursorTest, ReadsPascalStrings) {
+    const QByteArray data = bytes({0x05, 'H', 'e', 'l', 'l', 'o', 0x00, 0x02, 0xE9, 't'});
+    BufferCursor cursor(data);
+    EXPECT_EQ(cursor.readPascalString(), QString("Hello"));
+    EXPECT_EQ(cursor.readPascalString(), QString());
+    EXPECT_EQ(cursor.readPascalString(), QString::fromLatin1("\xE9t"));
+    EXPECT_TRUE(cursor.ok());
+    EXPECT_TRUE(cursor.atEnd());
+}
+
+TEST(BufferCursorTest, TruncatedPascalStringFails) {
+    const QByteArray data = bytes({0x0A, 'a', 'b', 'c'});
+    BufferCursor cursor(data);
+    EXPECT_EQ(cursor.readPascalString(), QString());
+    EXPECT_FALSE(cursor.ok());
+    
+    BufferCursor skipped(data);
+    EXPECT_FALSE(skipped.skipPascalString());
+    EXPECT_FALSE(skipped.ok());
+}
+
+TEST(BufferCursorTest, PascalStringLengthIsLimited) {
+    const int limit = BufferCursor::MAX_PASCAL_STRING_LENGTH;
+    
+    // At the limit the string is read in full
+    const QByteArray longest = pascalString(limit) + bytes({0x2A});
+    BufferCursor cursor(longest);
+    EXPECT_EQ(cursor.readPascalString().size(), limit);
+    EXPECT_EQ(cursor.readUInt8(), 0x2A);
+    EXPECT_TRUE(cursor.ok());
+    
+    BufferCursor skipped(longest);
+    EXPECT_TRUE(skipped.skipPascalString());
+    EXPECT_EQ(skipped.position(), static_cast<size_t>(limit) + 2);
+    
+    // One past it the record is corrupt, even though the bytes are there
+    const QByteArray tooLong = pascalString(limit + 1);
+    BufferCursor rejected(tooLong);
+    EXPECT_EQ(rejected.readPascalString(), QString());
+    EXPECT_FALSE(rejected.ok());
+    EXPECT_TRUE(rejected.atEnd());
+    
+    BufferCursor rejectedSkip(tooLong);
+    EXPECT_FALSE(rejectedSkip.skipPascalString());
+    EXPECT_FALSE(rejectedSkip.ok());
+    
+    // A four-byte length that reads as negative is corrupt as well
+    const QByteArray negative = bytes({0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 'a'});
+    BufferCursor negativeRead(negative);
+    EXPECT_EQ(negativeRead.readPascalString(), QString());
+    EXPECT_FALSE(negativeRead.ok());
+    
+    BufferCursor negativeSkip(negative);
+    EXPECT_FALSE(negativeSkip.skipPascalString());
+    EXPECT_FALSE(negativeSkip.ok());
+}
+
+TEST(BufferCursorTest, ReadsPrefixedUtf16Strings) {
+    const QByteArray data = bytes({0x02, 0, 0, 0, 'h', 0, 'i', 0,
+                                   0x00, 0, 0, 0,
+                                   0x01, 0, 0, 0, 0xAC, 0x20});
+    BufferCursor cursor(data);
+    EXPECT_EQ(cursor.readPrefixedUtf16String(), QString("hi"));
+    
+    QString out = "x";
+    EXPECT_TRUE(cursor.appendPrefixedUtf16String(out));
+    EXPECT_TRUE(cursor.appendPrefixedUtf16String(out));
+    EXPECT_EQ(out, QString("x") + QChar(0x20AC));
+    EXPECT_TRUE(cursor.ok());
+    EXPECT_TRUE(cursor.atEnd());
+}
+
+TEST(BufferCursorTest, TruncatedUtf16StringFails) {
+    // Three code units claimed, two present
+    const QByteArray data = bytes({0x03, 0, 0, 0, 'h', 0, 'i', 0});
+    
+    QString out = "kept";
+    BufferCursor cursor(data);
+    EXPECT_FALSE(cursor.appendPrefixedUtf16String(out));
+    EXPECT_FALSE(cursor.ok());
+    EXPECT_EQ(out, QString("kept"));
+    
+    BufferCursor skipped(data);
+    EXPECT_FALSE(skipped.skipPrefixedUtf16String());
+    EXPECT_FALSE(skipped.ok());
+    
+    // A length prefix cut short
+    const QByteArray cut = data.left(2);
+    BufferCursor prefix(cut);
+    EXPECT_EQ(prefix.readPrefixedUtf16String(), QString());
+    EXPECT_FALSE(prefix.ok());
+}
@@ -0,0 +1,111 @@
+/**
+ * LOTRO Launcher - Feed Date Tests
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "network/FeedDate.hpp"
+
+#include <QDate>
+#include <QDateTime>
+#include <QTime>
+
+using namespace lotro;
+
+namespace {
+
+// 2025-06-10 14:00:00 UTC
+constexpr qint64 JUNE_10 = 1749564000;
+
+} // namespace
+
+TEST(FeedDateTest, DetectsFormatFromFirstCharacters) {
+    EXPECT_EQ(detectFeedDateFormat(u"2025-06-10T14:00:00Z"), FeedDateFormat::Iso8601);
+    EXPECT_EQ(detectFeedDateFormat(u"Tue, 10 Jun 2025 14:00:00 GMT"), FeedDateFormat::Rfc822);
+    EXPECT_EQ(detectFeedDateFormat(u"10 Jun 2025 14:00:00 GMT"), FeedDateFormat::Rfc822);
+    EXPECT_EQ(detectFeedDateFormat(u""), FeedDateFormat::Unknown);
+    EXPECT_EQ(detectFeedDateFormat(u"<2025>"), FeedDateFormat::Unknown);
+}
+
+TEST(FeedDateTest, ReadsRfc822Zones) {
+    EXPECT_EQ(parseRfc822Date(u"Tue, 10 Jun 2025 14:00:00 GMT"), JUNE_10);
+    EXPECT_EQ(parseRfc822Date(u"10 Jun 2025 14:00:00 +0000"), JUNE_10);
+    EXPECT_EQ(parseRfc822Date(u"10 Jun 2025 16:00:00 +02:00"), JUNE_10);
+    EXPECT_EQ(parseRfc822Date(u"10 Jun 2025 10:00:00 EDT"), JUNE_10);
+    EXPECT_EQ(parseRfc822Date(u"10 Jun 2025 09:00:00 -0500"), JUNE_10);
+    EXPECT_EQ(parseRfc822Date(u"  tue, 10 june 2025 14:00:00 utc  "), JUNE_10);
+}
+
+TEST(FeedDateTest, ReadsRfc822ShortForms) {
+    // Seconds are optional, and two-digit years split at 50
+    EXPECT_EQ(parseRfc822Date(u"10 Jun 2025 14:00 GMT"), JUNE_10);
+    EXPECT_EQ(parseRfc822Date(u"10 Jun 25 14:00:00 GMT"), JUNE_10);
+    EXPECT_EQ(parseRfc822Date(u"31 Dec 99 23:59 GMT"), 946684740);
+    EXPECT_EQ(parseRfc822Date(u"Thu, 29 Feb 2024 00:00:00 GMT"), 1709164800);
+}
+
+TEST(FeedDateTest, RejectsMalformedRfc822) {
+    EXPECT_FALSE(parseRfc822Date(u""));
+    EXPECT_FALSE(parseRfc822Date(u"Tue, 10 Jun 2025"));
+    EXPECT_FALSE(parseRfc822Date(u"10 Foo 2025 14:00:00 GMT"));
+    EXPECT_FALSE(parseRfc822Date(u"10 Jun 2025 14:00:00 XYZ"));
+    EXPECT_FALSE(parseRfc822Date(u"10 Jun 2025 14:0 GMT"));
+    EXPECT_FALSE(parseRfc822Date(u"10 Jun 2025 14:00: GMT"));
+    EXPECT_FALSE(parseRfc822Date(u"10 Jun 2025 24:00:00 GMT"));
+    EXPECT_FALSE(parseRfc822Date(u"10 Jun 2025 14:60:00 GMT"));
+    EXPECT_FALSE(parseRfc822Date(u"29 Feb 2023 00:00:00 GMT"));
+    EXPECT_FALSE(parseRfc822Date(u"31 Apr 2025 00:00:00 GMT"));
+    EXPECT_FALSE(parseRfc822Date(u"10 Jun 2025 14:00:00 +"));
+}
+
+TEST(FeedDateTest, ReadsIso8601) {
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10T14:00:00Z"), JUNE_10);
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10t14:00:00z"), JUNE_10);
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10 14:00:00Z"), JUNE_10);
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10T14:00Z"), JUNE_10);
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10T14:00:30.123456Z"), JUNE_10 + 30);
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10T16:00:00+02:00"), JUNE_10);
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10T16:30:00+0230"), JUNE_10);
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10T13:00:00-01"), JUNE_10);
+}
+
+TEST(FeedDateTest, RejectsMalformedIso8601) {
+    EXPECT_FALSE(parseIso8601Date(u""));
+    EXPECT_FALSE(parseIso8601Date(u"2025-6-10T14:00:00Z"));
+    EXPECT_FALSE(parseIso8601Date(u"2025-13-10T14:00:00Z"));
+    EXPECT_FALSE(parseIso8601Date(u"2025-02-30T14:00:00Z"));
+    EXPECT_FALSE(parseIso8601Date(u"2025-06-10T14Z"));
+    EXPECT_FALSE(parseIso8601Date(u"2025-06-10T25:00:00Z"));
+    EXPECT_FALSE(parseIso8601Date(u"2025-06-10T14:00:00Zjunk"));
+    EXPECT_FALSE(parseIso8601Date(u"2025-06-10T14:00:00+2"));
+}
+
+TEST(FeedDateTest, DatesWithoutZoneAreLocalTime) {
+    const qint64 local = QDateTime(QDate(2025, 6, 10), QTime(14, 0)).toSecsSinceEpoch();
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10T14:00:00"), local);
+    EXPECT_EQ(parseRfc822Date(u"Tue, 10 Jun 2025 14:00:00"), local);
+    
+    const qint64 midnight = QDateTime(QDate(2025, 6, 10), QTime(0, 0)).toSecsSinceEpoch();
+    EXPECT_EQ(parseIso8601Date(u"2025-06-10"), midnight);
+}
+
+TEST(FeedDateTest, KeepsFormatAcrossFeed) {
+    FeedDateFormat format = FeedDateFormat::Unknown;
+    EXPECT_EQ(parseFeedDate("2025-06-10T14:00:00Z", format), JUNE_10);
+    EXPECT_EQ(format, FeedDateFormat::Iso8601);
+    EXPECT_EQ(parseFeedDate("2025-06-10T14:00:30Z", format), JUNE_10 + 30);
+    EXPECT_EQ(format, FeedDateFormat::Iso8601);
+    
+    // A date in the other layout is detected afresh
+    EXPECT_EQ(parseFeedDate("Tue, 10 Jun 2025 14:00:00 GMT", format), JUNE_10);
+    EXPECT_EQ(format, FeedDateFormat::Rfc822);
+}
+
+TEST(FeedDateTest, UnreadableDatesHaveNoValue) {
+    for (const char* text : {"", "   ", "not a date", "sometime in June", "<pubDate/>"}) {
+        FeedDateFormat format = FeedDateFormat::Unknown;
+        EXPECT_FALSE(parseFeedDate(text, format)) << text;
+    }
+}
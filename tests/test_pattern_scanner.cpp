@@ -0,0 +1,156 @@
+/**
+ * LOTRO Launcher - Pattern Scanner Tests
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "companion/PatternScanner.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace lotro;
+
+namespace {
+
+// Filler that holds none of the pattern bytes below
+constexpr uint8_t FILLER = 0x90;
+
+// What the scanner must agree with: a byte-by-byte search
+std::optional<size_t> naiveFind(const std::vector<uint8_t>& data, const BytePattern& pattern) {
+    const size_t size = pattern.entries.size();
+    for (size_t start = 0; size > 0 && start + size <= data.size(); ++start) {
+        bool match = true;
+        for (size_t i = 0; i < size && match; ++i) {
+            match = pattern.entries[i].isWildcard || data[start + i] == pattern.entries[i].byte;
+        }
+        if (match) {
+            return start;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<uint8_t> bufferWith(size_t size, size_t offset, const std::vector<uint8_t>& bytes) {
+    std::vector<uint8_t> data(size, FILLER);
+    std::copy(bytes.begin(), bytes.end(), data.begin() + static_cast<std::ptrdiff_t>(offset));
+    return data;
+}
+
+} // namespace
+
+class PatternScannerTest : public ::testing::Test {
+protected:
+    // 48 8B 05 ?? ?? ?? ?? 48 85 C0
+    const std::string signature = "488B05?34885C0";
+    const std::vector<uint8_t> occurrence = {0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x48, 0x85, 0xC0};
+};
+
+TEST_F(PatternScannerTest, ParsesWildcardHoles) {
+    const BytePattern pattern = BytePattern::fromString("48?18B?005");
+    ASSERT_EQ(pattern.entries.size(), 6u);
+    EXPECT_FALSE(pattern.entries[0].isWildcard);
+    EXPECT_TRUE(pattern.entries[1].isWildcard);
+    EXPECT_TRUE(pattern.entries[2].isWildcard);
+    EXPECT_EQ(pattern.entries[3].byte, 0x8B);
+    EXPECT_TRUE(pattern.entries[4].isWildcard);
+    EXPECT_EQ(pattern.entries[5].byte, 0x05);
+    
+    constexpr auto literal = "4883EC28?3488D0D"_pattern;
+    static_assert(literal.size() == 11);
+    EXPECT_EQ(literal.fixedOffsets.size(), 7u);
+    EXPECT_EQ(literal.mask[4], 0);
+    EXPECT_EQ(literal.bytes[9], 0x8D);
+}
+
+TEST_F(PatternScannerTest, FindsMatchAtEveryOffset) {
+    // Sizes around the 16 and 32 byte compares put matches across vector
+    // boundaries and in the scalar tail after the last full vector
+    const BytePattern pattern = BytePattern::fromString(signature);
+    for (size_t size : {10u, 15u, 16u, 17u, 31u, 32u, 33u, 47u, 63u, 64u, 65u, 100u}) {
+        for (size_t offset = 0; offset + occurrence.size() <= size; ++offset) {
+            const auto data = bufferWith(size, offset, occurrence);
+            const auto found = PatternScanner::find(data, pattern);
+            ASSERT_EQ(found, naiveFind(data, pattern)) << "size " << size << ", offset " << offset;
+            EXPECT_EQ(found, offset) << "size " << size << ", offset " << offset;
+        }
+    }
+}
+
+TEST_F(PatternScannerTest, ReportsFirstOfSeveralMatches) {
+    auto data = bufferWith(96, 70, occurrence);
+    std::copy(occurrence.begin(), occurrence.end(), data.begin() + 29);
+    EXPECT_EQ(PatternScanner::find(data, signature), 29u);
+}
+
+TEST_F(PatternScannerTest, RejectsNearMissesAndShortData) {
+    auto data = bufferWith(64, 28, occurrence);
+    data[28 + 9] = 0xC1;
+    EXPECT_FALSE(PatternScanner::find(data, signature));
+    
+    // The anchor byte at the very end, with the rest of the pattern cut off
+    const std::vector<uint8_t> cut = bufferWith(33, 30, {0x48, 0x8B, 0x05});
+    EXPECT_FALSE(PatternScanner::find(cut, signature));
+    EXPECT_FALSE(PatternScanner::find(std::vector<uint8_t>{}, signature));
+}
+
+TEST_F(PatternScannerTest, ScansSeveralPatternsInOnePass) {
+    // Three anchors take the multi-byte vector compare, twelve the table
+    for (size_t count : {3u, 12u}) {
+        PatternScanner scanner;
+        std::vector<std::vector<uint8_t>> patterns;
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t first = static_cast<uint8_t>(0x10 + i);
+            patterns.push_back({first, 0xE8, static_cast<uint8_t>(0x40 + i)});
+            char text[16];
+            std::snprintf(text, sizeof(text), "%02XE8?0%02X", first, 0x40 + static_cast<unsigned>(i));
+            scanner.addPattern(std::string(text));
+        }
+        
+        // Pattern i sits at 7 * i + 3, with a byte between its E8 and its last byte
+        std::vector<uint8_t> data(7 * count + 40, FILLER);
+        for (size_t i = 0; i < count; ++i) {
+            const size_t at = 7 * i + 3;
+            data[at] = patterns[i][0];
+            data[at + 1] = patterns[i][1];
+            data[at + 2] = 0x00;
+            data[at + 3] = patterns[i][2];
+        }
+        
+        const auto results = scanner.scan(data);
+        ASSERT_EQ(results.size(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(results[i], 7 * i + 3) << count << " patterns, pattern " << i;
+        }
+    }
+}
+
+TEST_F(PatternScannerTest, StreamFindsMatchesAcrossChunks) {
+    PatternScanner scanner;
+    scanner.addPattern(signature);
+    scanner.addPattern("C3CC?1CC");
+    
+    std::vector<uint8_t> data(1000, FILLER);
+    std::copy(occurrence.begin(), occurrence.end(), data.begin() + 507);
+    const std::vector<uint8_t> ret = {0xC3, 0xCC, 0x00, 0x00, 0xCC};
+    std::copy(ret.begin(), ret.end(), data.begin() + 62);
+    
+    auto read = [&data](size_t offset, std::span<uint8_t> out) {
+        std::memcpy(out.data(), data.data() + offset, out.size());
+        return true;
+    };
+    
+    // Chunks of 64 put a boundary inside both matches, 512 inside the first
+    for (size_t chunkSize : {64u, 512u, 4096u}) {
+        const auto results = scanner.scanStream(data.size(), read, chunkSize);
+        ASSERT_EQ(results.size(), 2u);
+        EXPECT_EQ(results[0], 507u) << "chunk size " << chunkSize;
+        EXPECT_EQ(results[1], 62u) << "chunk size " << chunkSize;
+    }
+    EXPECT_EQ(scanner.scan(data), scanner.scanStream(data.size(), read, 64));
+}
@@ -0,0 +1,136 @@
+/**
+ * LOTRO Launcher - Text Search Index Tests
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "companion/TextSearchIndex.hpp"
+
+#include <QString>
+
+#include <algorithm>
+#include <vector>
+
+using namespace lotro;
+
+namespace {
+
+struct Record {
+    QString name;
+    QString description;
+};
+
+// Ranked by "orc" in the order listed, followed by records without it
+const std::vector<Record> RECORDS = {
+    {"Orc", "Kill one"},
+    {"Orc Slayer", "Defeat orcs in Eriador"},
+    {"Slayer of Orcs", "Defeat more of them"},
+    {"Scorched Earth", "Burn the fields"},
+    {"Island Explorer", "Visit every orc camp on the coast"},
+    {"Ered Luin Lore", "Read the stones of the Blue Mountains"},
+    {"Slow and Steady", ""},
+    {"Orc-hunter", "Ambush the war-bands"},
+    {"Lore-master of Bree", "Study in the Prancing Pony"},
+    {"The Old Forest", "Walk among the trees"},
+};
+
+} // namespace
+
+class TextSearchIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        index.reserve(RECORDS.size());
+        for (const auto& record : RECORDS) {
+            index.add(record.name, {record.description});
+        }
+    }
+    
+    // What the linear scan the index replaced returned, in record order
+    static std::vector<uint32_t> substringMatches(const QString& query) {
+        std::vector<uint32_t> matches;
+        for (size_t i = 0; i < RECORDS.size(); ++i) {
+            if (RECORDS[i].name.contains(query, Qt::CaseInsensitive) ||
+                RECORDS[i].description.contains(query, Qt::CaseInsensitive)) {
+                matches.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        return matches;
+    }
+    
+    static std::vector<uint32_t> sorted(std::vector<uint32_t> positions) {
+        std::sort(positions.begin(), positions.end());
+        return positions;
+    }
+    
+    TextSearchIndex index;
+};
+
+TEST_F(TextSearchIndexTest, LongQueriesMatchLikeSubstringScan) {
+    for (const QString query : {"orc", "ORCS", "slayer", "lore", "the", "ere",
+                                "of the", "mountains", "war-b", "xyz", "orc slayer"}) {
+        EXPECT_EQ(sorted(index.search(query)), substringMatches(query)) << query.toStdString();
+    }
+}
+
+TEST_F(TextSearchIndexTest, ShortQueriesMatchWordPrefixes) {
+    // "Island Explorer" contains "sl", but not at the start of a word
+    EXPECT_EQ(sorted(index.search("sl")), (std::vector<uint32_t>{1, 2, 6}));
+    EXPECT_EQ(sorted(index.search("Sl")), (std::vector<uint32_t>{1, 2, 6}));
+    
+    // Word prefixes in secondary fields count as well
+    EXPECT_EQ(sorted(index.search("bl")), (std::vector<uint32_t>{5}));
+    
+    // Single characters: "Scorched Earth" has no word starting with "o"
+    const auto o = sorted(index.search("o"));
+    EXPECT_TRUE(std::binary_search(o.begin(), o.end(), 0u));
+    EXPECT_TRUE(std::binary_search(o.begin(), o.end(), 9u));
+    EXPECT_FALSE(std::binary_search(o.begin(), o.end(), 3u));
+    
+    EXPECT_TRUE(index.search("qz").empty());
+}
+
+TEST_F(TextSearchIndexTest, RanksNameMatchesFirst) {
+    // Exact name, name prefix (ties in record order), word prefix,
+    // substring, then secondary fields only
+    EXPECT_EQ(index.search("orc"), (std::vector<uint32_t>{0, 1, 7, 2, 3, 4}));
+    
+    // A limit keeps the best results
+    EXPECT_EQ(index.search("orc", 3), (std::vector<uint32_t>{0, 1, 7}));
+}
+
+TEST_F(TextSearchIndexTest, EmptyQueryListsEveryRecord) {
+    const auto all = index.search("");
+    ASSERT_EQ(all.size(), RECORDS.size());
+    for (size_t i = 0; i < all.size(); ++i) {
+        EXPECT_EQ(all[i], i);
+    }
+    EXPECT_EQ(index.search("", 4).size(), 4u);
+}
+
+TEST_F(TextSearchIndexTest, NarrowsOnlyWhenRefiningIsExact) {
+    EXPECT_TRUE(TextSearchIndex::narrows("orc", "orcs"));
+    EXPECT_TRUE(TextSearchIndex::narrows("Lor", "lore-m"));
+    EXPECT_TRUE(TextSearchIndex::narrows("-", "-h"));
+    
+    // Short word queries match prefixes, which a longer query doesn't
+    EXPECT_FALSE(TextSearchIndex::narrows("sl", "sla"));
+    EXPECT_FALSE(TextSearchIndex::narrows("", "orc"));
+    EXPECT_FALSE(TextSearchIndex::narrows("orcs", "orc"));
+    EXPECT_FALSE(TextSearchIndex::narrows("orc", "lore"));
+}
+
+TEST_F(TextSearchIndexTest, RefineMatchesFreshSearch) {
+    const std::vector<std::pair<QString, QString>> steps = {
+        {"orc", "orcs"}, {"ore", "ored"}, {"the", "the "}, {"Lor", "lore-m"},
+        {"sla", "slayer"}, {"ere", "ered l"},
+    };
+    for (const auto& [previous, query] : steps) {
+        ASSERT_TRUE(TextSearchIndex::narrows(previous, query))
+            << previous.toStdString() << " -> " << query.toStdString();
+        const auto candidates = index.search(previous);
+        EXPECT_EQ(index.refine(query, candidates), index.search(query)) << query.toStdString();
+        EXPECT_EQ(index.refine(query, candidates, 2), index.search(query, 2)) << query.toStdString();
+    }
+}
@@ -0,0 +1,186 @@
+/**
+ * LOTRO Launcher - User Preferences Tests
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "game/UserPreferences.hpp"
+
+#include <QByteArray>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <filesystem>
+
+using namespace lotro;
+
+namespace {
+
+const QByteArray SAMPLE =
+    "; Written by the game\r\n"
+    "[Display]\r\n"
+    "Adapter=0\r\n"
+    "FullscreenWidth = 1920  \r\n"
+    "FullscreenHeight=1080\r\n"
+    "\r\n"
+    "[General]\r\n"
+    "LastWorld=Arkenstone\r\n"
+    "Empty=\r\n";
+
+} // namespace
+
+class UserPreferencesTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(tempDir.isValid());
+        path = std::filesystem::path(tempDir.path().toStdString()) / "UserPreferences.ini";
+    }
+    
+    void write(const QByteArray& bytes) {
+        QFile file(QString::fromStdString(path.string()));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(bytes);
+    }
+    
+    QByteArray read() const {
+        QFile file(QString::fromStdString(path.string()));
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+    
+    QTemporaryDir tempDir;
+    std::filesystem::path path;
+};
+
+TEST_F(UserPreferencesTest, ReadsValues) {
+    write(SAMPLE);
+    UserPreferences prefs(path);
+    ASSERT_TRUE(prefs.isValid());
+    
+    EXPECT_EQ(prefs.get("Display", "Adapter"), QString("0"));
+    EXPECT_EQ(prefs.get("Display", "FullscreenWidth"), QString("1920"));
+    EXPECT_EQ(prefs.getLastWorld(), QString("Arkenstone"));
+    EXPECT_EQ(prefs.get("General", "Empty"), QString());
+    EXPECT_FALSE(prefs.get("General", "Missing"));
+    EXPECT_FALSE(prefs.get("Sound", "Volume"));
+    EXPECT_FALSE(prefs.isModified());
+}
+
+TEST_F(UserPreferencesTest, MissingFileIsInvalid) {
+    UserPreferences prefs(path);
+    EXPECT_FALSE(prefs.isValid());
+}
+
+TEST_F(UserPreferencesTest, EditsKeepLayout) {
+    write(SAMPLE);
+    UserPreferences prefs(path);
+    prefs.setResolution(2560, 1440);
+    prefs.setLastWorld("Glamdring");
+    prefs.set("General", "Empty", "x");
+    ASSERT_TRUE(prefs.isModified());
+    ASSERT_TRUE(prefs.save());
+    EXPECT_FALSE(prefs.isModified());
+    
+    // Comments, spacing around values and line ends are kept
+    EXPECT_EQ(read(),
+              "; Written by the game\r\n"
+              "[Display]\r\n"
+              "Adapter=0\r\n"
+              "FullscreenWidth = 2560  \r\n"
+              "FullscreenHeight=1440\r\n"
+              "\r\n"
+              "[General]\r\n"
+              "LastWorld=Glamdring\r\n"
+              "Empty=x\r\n");
+    
+    UserPreferences reloaded(path);
+    EXPECT_EQ(reloaded.get("Display", "FullscreenWidth"), QString("2560"));
+    EXPECT_EQ(reloaded.get("Display", "FullscreenHeight"), QString("1440"));
+    EXPECT_EQ(reloaded.getLastWorld(), QString("Glamdring"));
+    EXPECT_EQ(reloaded.get("General", "Empty"), QString("x"));
+}
+
+TEST_F(UserPreferencesTest, AddsAndRemovesKeys) {
+    write(SAMPLE);
+    UserPreferences prefs(path);
+    prefs.setFullscreen(true);
+    prefs.setGraphicsQuality(3);
+    prefs.remove("Display", "Adapter");
+    prefs.remove("General", "Missing");
+    prefs.setAdapter(1);
+    ASSERT_TRUE(prefs.save());
+    
+    // New keys follow the section's last key, new sections go at the end
+    EXPECT_EQ(read(),
+              "; Written by the game\r\n"
+              "[Display]\r\n"
+              "FullscreenWidth = 1920  \r\n"
+              "FullscreenHeight=1080\r\n"
+              "Fullscreen=1\r\n"
+              "Adapter=1\r\n"
+              "\r\n"
+              "[General]\r\n"
+              "LastWorld=Arkenstone\r\n"
+              "Empty=\r\n"
+              "\r\n"
+              "[Graphics]\r\n"
+              "Quality=3\r\n");
+    
+    UserPreferences reloaded(path);
+    EXPECT_EQ(reloaded.get("Display", "Fullscreen"), QString("1"));
+    EXPECT_EQ(reloaded.get("Display", "Adapter"), QString("1"));
+    EXPECT_EQ(reloaded.get("Graphics", "Quality"), QString("3"));
+    EXPECT_EQ(reloaded.getLastWorld(), QString("Arkenstone"));
+}
+
+TEST_F(UserPreferencesTest, KeepsUnixLineEnds) {
+    write("[General]\nLastWorld=Arkenstone");
+    UserPreferences prefs(path);
+    prefs.set("General", "Region", "EU");
+    prefs.set("Display", "Adapter", "0");
+    ASSERT_TRUE(prefs.save());
+    
+    EXPECT_EQ(read(), "[General]\nLastWorld=Arkenstone\nRegion=EU\n\n[Display]\nAdapter=0\n");
+    EXPECT_EQ(UserPreferences(path).get("General", "Region"), QString("EU"));
+}
+
+TEST_F(UserPreferencesTest, UnchangedValuesAreNotWritten) {
+    write(SAMPLE);
+    UserPreferences prefs(path);
+    prefs.setLastWorld("Arkenstone");
+    prefs.setAdapter(0);
+    EXPECT_FALSE(prefs.isModified());
+    
+    // The game rewrote the file meanwhile; saving must not undo that
+    const QByteArray rewritten = QByteArray(SAMPLE).replace("Adapter=0", "Adapter=2");
+    write(rewritten);
+    ASSERT_TRUE(prefs.save());
+    EXPECT_EQ(read(), rewritten);
+}
+
+TEST_F(UserPreferencesTest, SaveWritesOnlyEditedSpan) {
+    write(SAMPLE);
+    UserPreferences prefs(path);
+    prefs.setLastWorld("Brandywine");
+    
+    // Same length, so nothing after the value moves and only it is written
+    const QByteArray rewritten = QByteArray(SAMPLE).replace("Adapter=0", "Adapter=2");
+    write(rewritten);
+    ASSERT_TRUE(prefs.save());
+    EXPECT_EQ(read(), QByteArray(rewritten).replace("Arkenstone", "Brandywine"));
+}
+
+TEST_F(UserPreferencesTest, SaveAsWritesFullCopy) {
+    write(SAMPLE);
+    UserPreferences prefs(path);
+    prefs.setLastWorld("Landroval");
+    
+    const auto copy = path.parent_path() / "Copy.ini";
+    ASSERT_TRUE(prefs.saveAs(copy));
+    EXPECT_EQ(UserPreferences(copy).getLastWorld(), QString("Landroval"));
+    
+    // The original is left alone until save()
+    EXPECT_EQ(read(), SAMPLE);
+    EXPECT_TRUE(prefs.isModified());
+}
@@ -0,0 +1,197 @@
+/**
+ * LOTRO Launcher - ZIP Archive Tests
+ * 
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtest/gtest.h>
+
+#include "addons/ZipArchive.hpp"
+
+#include <QByteArray>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include <zlib.h>
+
+#include <filesystem>
+#include <vector>
+
+using namespace lotro;
+
+namespace {
+
+struct TestEntry {
+    QByteArray name;
+    QByteArray data;
+    bool deflate = false;
+    quint32 declaredSize = 0;   // Overrides data.size() when non-zero
+};
+
+void put16(QByteArray& out, quint16 value) {
+    char bytes[2];
+    qToLittleEndian<quint16>(value, bytes);
+    out.append(bytes, 2);
+}
+
+void put32(QByteArray& out, quint32 value) {
+    char bytes[4];
+    qToLittleEndian<quint32>(value, bytes);
+    out.append(bytes, 4);
+}
+
+QByteArray rawDeflate(const QByteArray& data) {
+    z_stream stream{};
+    deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    QByteArray out(static_cast<qsizetype>(deflateBound(&stream, data.size())), Qt::Uninitialized);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+    deflate(&stream, Z_FINISH);
+    out.resize(static_cast<qsizetype>(stream.total_out));
+    deflateEnd(&stream);
+    return out;
+}
+
+// A minimal archive: local headers and data, the central directory, then
+// the end record, with no comment
+QByteArray buildArchive(const std::vector<TestEntry>& entries) {
+    QByteArray archive;
+    QByteArray directory;
+    for (const auto& entry : entries) {
+        const QByteArray payload = entry.deflate ? rawDeflate(entry.data) : entry.data;
+        const quint16 method = entry.deflate ? 8 : 0;
+        const quint32 crc = crc32(0L, reinterpret_cast<const Bytef*>(entry.data.constData()),
+                                  static_cast<uInt>(entry.data.size()));
+        const quint32 size = entry.declaredSize ? entry.declaredSize : static_cast<quint32>(entry.data.size());
+        const quint32 offset = static_cast<quint32>(archive.size());
+        
+        put32(archive, 0x04034b50);
+        put16(archive, 20);
+        put16(archive, 0);
+        put16(archive, method);
+        put32(archive, 0);
+        put32(archive, crc);
+        put32(archive, static_cast<quint32>(payload.size()));
+        put32(archive, size);
+        put16(archive, static_cast<quint16>(entry.name.size()));
+        put16(archive, 0);
+        archive += entry.name;
+        archive += payload;
+        
+        put32(directory, 0x02014b50);
+        put16(directory, 20);
+        put16(directory, 20);
+        put16(directory, 0);
+        put16(directory, method);
+        put32(directory, 0);
+        put32(directory, crc);
+        put32(directory, static_cast<quint32>(payload.size()));
+        put32(directory, size);
+        put16(directory, static_cast<quint16>(entry.name.size()));
+        put16(directory, 0);
+        put16(directory, 0);
+        put16(directory, 0);
+        put16(directory, 0);
+        put32(directory, 0);
+        put32(directory, offset);
+        directory += entry.name;
+    }
+    
+    const quint32 directoryOffset = static_cast<quint32>(archive.size());
+    archive += directory;
+    put32(archive, 0x06054b50);
+    put16(archive, 0);
+    put16(archive, 0);
+    put16(archive, static_cast<quint16>(entries.size()));
+    put16(archive, static_cast<quint16>(entries.size()));
+    put32(archive, static_cast<quint32>(directory.size()));
+    put32(archive, directoryOffset);
+    put16(archive, 0);
+    return archive;
+}
+
+} // namespace
+
+class ZipArchiveTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(tempDir.isValid());
+        root = tempDir.path().toStdString();
+    }
+    
+    std::filesystem::path writeArchive(const QByteArray& bytes) {
+        const auto path = root / "test.zip";
+        QFile file(QString::fromStdString(path.string()));
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(bytes);
+        return path;
+    }
+    
+    QByteArray readExtracted(const std::filesystem::path& relative) {
+        QFile file(QString::fromStdString((root / "out" / relative).string()));
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+    
+    QTemporaryDir tempDir;
+    std::filesystem::path root;
+    
+    // Compressible, and larger than one inflate chunk
+    const QByteArray largeText = QByteArray("Plugins load in dependency order. ").repeated(20000);
+};
+
+TEST_F(ZipArchiveTest, ExtractsStoredEntry) {
+    ZipArchive archive;
+    ASSERT_TRUE(archive.open(writeArchive(buildArchive({{"Author/Plugin.plugin", "<Plugin/>"}}))));
+    ASSERT_EQ(archive.entries().size(), 1u);
+    EXPECT_EQ(archive.entries()[0].name, "Author/Plugin.plugin");
+    EXPECT_EQ(archive.entries()[0].method, 0);
+    
+    ASSERT_TRUE(archive.extract({{0, "Author/Plugin.plugin"}}, root / "out"));
+    EXPECT_EQ(readExtracted("Author/Plugin.plugin"), "<Plugin/>");
+}
+
+TEST_F(ZipArchiveTest, ExtractsDeflatedEntry) {
+    ZipArchive archive;
+    ASSERT_TRUE(archive.open(writeArchive(buildArchive({{"Author/Main.lua", largeText, true}}))));
+    ASSERT_EQ(archive.entries().size(), 1u);
+    EXPECT_EQ(archive.entries()[0].method, 8);
+    EXPECT_LT(archive.entries()[0].compressedSize, archive.entries()[0].size);
+    
+    ASSERT_TRUE(archive.extract({{0, "Main.lua"}}, root / "out"));
+    EXPECT_EQ(readExtracted("Main.lua"), largeText);
+}
+
+TEST_F(ZipArchiveTest, RejectsTruncatedArchive) {
+    const QByteArray bytes = buildArchive({{"Author/Main.lua", largeText, true}});
+    
+    ZipArchive archive;
+    EXPECT_FALSE(archive.open(writeArchive(bytes.left(bytes.size() / 2))));
+    EXPECT_TRUE(archive.entries().empty());
+}
+
+TEST_F(ZipArchiveTest, RejectsBadLocalHeaderOffset) {
+    QByteArray bytes = buildArchive({{"Author/Plugin.plugin", "<Plugin/>"}});
+    
+    // The central header's local header offset sits 42 bytes in; point it
+    // at the very end of the address range
+    const qsizetype directoryOffset = qFromLittleEndian<quint32>(bytes.constData() + bytes.size() - 6);
+    qToLittleEndian<quint32>(0xFFFFFFF0, bytes.data() + directoryOffset + 42);
+    
+    ZipArchive archive;
+    ASSERT_TRUE(archive.open(writeArchive(bytes)));
+    EXPECT_FALSE(archive.extract({{0, "Plugin.plugin"}}, root / "out"));
+    EXPECT_FALSE(std::filesystem::exists(root / "out" / "Plugin.plugin"));
+}
+
+TEST_F(ZipArchiveTest, RejectsEntryLargerThanDeclared) {
+    TestEntry entry{"Author/Main.lua", largeText, true};
+    entry.declaredSize = 1024;
+    
+    ZipArchive archive;
+    ASSERT_TRUE(archive.open(writeArchive(buildArchive({entry}))));
+    EXPECT_FALSE(archive.extract({{0, "Main.lua"}}, root / "out"));
+    EXPECT_FALSE(std::filesystem::exists(root / "out" / "Main.lua"));
+}